@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(_M_AMD64)
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Hints the CPU to start loading the cache lines of [address, address + size) ahead of reading them.
+// Useful when the next addresses are known but irregular, e.g. gathering rows of a large table.
+inline void PrefetchForRead(const void* address, size_t size) {
+  constexpr size_t kCacheLineSize = 64;
+  const char* p = static_cast<const char*>(address);
+  for (size_t offset = 0; offset < size; offset += kCacheLineSize) {
+#if defined(_M_AMD64) || defined(__x86_64__)
+    _mm_prefetch(p + offset, _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p + offset, 0, 3);
+#else
+    (void)p;
+#endif
+  }
+}
+
+}  // namespace onnxruntime
@@ -16,6 +16,7 @@ enum EventCategory {
   NODE_EVENT,
   KERNEL_EVENT,
   API_EVENT,
+  MEMORY_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -24,7 +25,8 @@ static constexpr const char* event_category_names_[EVENT_CATEGORY_MAX] = {
     "Session",
     "Node",
     "Kernel",
-    "Api"};
+    "Api",
+    "Memory"};
 
 // Timing record for all events.
 struct EventRecord {
@@ -71,6 +73,9 @@ struct EventRecord {
   long long ts = 0;
   long long dur = 0;
   std::unordered_map<std::string, std::string> args{};
+  // The phase of the event in the Chrome trace format, 'X' for a complete event or 'C' for a counter event, whose
+  // numeric args are the values of the counters.
+  char phase = 'X';
 };
 
 using Events = std::vector<EventRecord>;
@@ -83,6 +88,7 @@ class EpProfiler {
   virtual void EndProfiling(TimePoint start_time, Events& events) = 0;  // called when profiling ends, save all captures numbers to "events"
   virtual void Start(uint64_t) {}                                       // called before op start, accept an id as argument to identify the op
   virtual void Stop(uint64_t) {}                                        // called after op stop, accept an id as argument to identify the op
+  virtual void EnableKernelMetrics() {}                                 // called before profiling starts to also collect the hardware metrics of the kernels of the ops, if supported
 };
 
 // Demangle C++ symbols
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,12 +17,40 @@
 #include "core/session/environment.h"
 #include "core/graph/basic_types.h"
 #include "core/graph/model.h"
+#include "core/optimizer/optimizer_execution_frame.h"
 
 namespace onnxruntime {
 #ifdef __GNUC__
 #pragma GCC diagnostic push
 #endif
 
+// The kernel of an op created by ORTInvoker::CreateKernel, which runs the op on the inputs it was created with
+// without building its graph again, e.g. to benchmark the kernel.
+class ORTInvokerKernel {
+ public:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ORTInvokerKernel);
+
+  const OpKernel& Kernel() const { return *kernel_; }
+
+  // Runs the kernel on thread_pool, on the calling thread if null. compute_duration, if given, receives the duration
+  // of the Compute call alone.
+  common::Status Run(std::vector<OrtValue>& outputs, concurrency::ThreadPool* thread_pool = nullptr,
+                     std::chrono::nanoseconds* compute_duration = nullptr) const;
+
+ private:
+  friend class ORTInvoker;
+
+  explicit ORTInvokerKernel(const logging::Logger& logger) : logger_(logger) {}
+
+  const logging::Logger& logger_;
+  std::unique_ptr<Model> model_;
+  // referenced by info_
+  std::function<bool(const std::string&)> is_sparse_initializer_func_;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info_;
+  std::unique_ptr<const OpKernel> kernel_;
+  std::vector<int> fetch_mlvalue_idxs_;
+};
+
 class ORTInvoker {
  public:
   ORTInvoker(std::shared_ptr<IExecutionProvider> execution_provider,
@@ -45,6 +76,15 @@ class ORTInvoker {
                         const std::string& domain = kOnnxDomain,
                         const int version = -1);
 
+  // Creates the kernel of the op for the given inputs and number of outputs.
+  common::Status CreateKernel(const std::string& op_name,
+                              const std::vector<OrtValue>& inputs,
+                              size_t num_outputs,
+                              const NodeAttributes* attributes,
+                              std::unique_ptr<ORTInvokerKernel>& kernel,
+                              const std::string& domain = kOnnxDomain,
+                              const int version = -1);
+
  private:
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
@@ -20,7 +20,8 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  max_cached_chunk_size_bytes(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
               int64_t max_power_of_two_extend_bytes)
@@ -29,7 +30,8 @@ struct OrtArenaCfg {
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        max_cached_chunk_size_bytes(-1) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -37,6 +39,7 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t max_cached_chunk_size_bytes;    // use -1 to allow ORT to choose the default (0 = chunk cache disabled)
 };
 
 namespace onnxruntime {
@@ -101,6 +104,17 @@ class IAllocator {
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* /*stats*/) { return; }
 
+  // A stream-ordered allocator, such as one backed by a CUDA memory pool, returns true and orders the memory
+  // allocated by AllocOnStream() on the given stream: it is ready for the work of that stream and is not handed out
+  // again when freed before that work is done. The arena based stream aware allocators are not reported here.
+  virtual bool IsStreamAware() const { return false; }
+
+  // Allocate memory ordered on stream. By default, the base implementation just calls Alloc().
+  virtual void* AllocOnStream(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
+  // Called when stream is released, for the allocations of AllocOnStream() that are still in use.
+  virtual void ReleaseStreamAllocations(Stream* /*stream*/) {}
+
   static bool CalcMemSizeForArray(size_t nmemb, size_t size, size_t* out) noexcept {
     return CalcMemSizeForArrayWithAlignment(nmemb, size, 0, out);
   }
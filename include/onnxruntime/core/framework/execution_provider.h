@@ -177,6 +177,14 @@ class IExecutionProvider {
    */
   virtual ProviderOptions GetProviderOptions() const { return {}; }
 
+  /**
+     Whether the result of GetCapability only depends on the graph (nodes, assignments, types and shapes) and on the
+     provider options, so that the graph partitioner can store it in the partitioning cache enabled with
+     kOrtSessionOptionsPartitioningCacheDir and skip GetCapability in later sessions.
+     Providers that set state in GetCapability which Compile relies on must not opt in.
+   */
+  virtual bool CanCacheCapabilities() const { return false; }
+
   /**
      Get provider specific custom op domain list.
      Provider has the responsibility to release OrtCustomOpDomain instances it creates.
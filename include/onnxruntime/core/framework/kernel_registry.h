@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <string_view>
 
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -126,8 +128,19 @@ class KernelRegistry {
   static std::string GetMapKey(const KernelDef& kernel_def) {
     return GetMapKey(kernel_def.OpName(), kernel_def.Domain(), kernel_def.Provider());
   }
+
+  // The kernel matched for a node only depends on the op, its version, the provider, and the arg counts and types of
+  // the node, which make up the key of kernel_lookup_cache_.
+  static std::string GetLookupCacheKey(const Node& node, std::string_view provider);
+
   // Kernel create function map from op name to kernel creation info.
   // key is opname+domain_name+provider_name
   KernelCreateMap kernel_creator_fn_map_;
+
+  // Kernels found by TryFindKernel with a kernel_type_str_resolver, so that the nodes with the same signature are
+  // only matched once. The registries of the execution providers are usually shared by all their instances, so the
+  // lookups are also reused across sessions. Cleared when a kernel is registered.
+  mutable std::mutex kernel_lookup_cache_mutex_;
+  mutable InlinedHashMap<std::string, const KernelCreateInfo*> kernel_lookup_cache_;
 };
 }  // namespace onnxruntime
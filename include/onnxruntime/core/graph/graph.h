@@ -258,15 +258,20 @@ class Node {
   /** Gets a modifiable count of arguments for each of the Node's explicit inputs.
   @todo This should be removed in favor of a method that updates the input args and the count.
         Currently these operations are separate which is not a good setup. */
-  std::vector<int>& MutableInputArgsCount() { return definitions_.input_arg_count; }
+  std::vector<int>& MutableInputArgsCount() {
+    type_inference_needed_ = true;
+    return definitions_.input_arg_count;
+  }
 
   /** Gets a modifiable collection of the Node's input definitions. */
   std::vector<NodeArg*>& MutableInputDefs() noexcept {
+    type_inference_needed_ = true;
     return definitions_.input_defs;
   }
 
   /** Gets a modifiable collection of the Node's output definitions. */
   std::vector<NodeArg*>& MutableOutputDefs() noexcept {
+    type_inference_needed_ = true;
     return definitions_.output_defs;
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -397,7 +402,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    type_inference_needed_ = true;
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -682,6 +690,12 @@ class Node {
 
   // Can be saved? The node cannot be saved anymore if removable attributes have been cleared.
   bool can_be_saved_;
+
+  // Set when the attributes or definitions are modified, so that Graph::Resolve runs the type and shape inferencing
+  // of the node again. Otherwise it is skipped if the types of the inputs and outputs are those it last inferred,
+  // which are identified by inferred_types_hash_.
+  bool type_inference_needed_ = true;
+  size_t inferred_types_hash_ = 0;
 };
 
 /**
@@ -1290,6 +1304,7 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   }
 
   void UpdateProducerNode(const std::string& node_arg_name, NodeIndex node_index) {
+    ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
     auto iter = node_arg_to_producer_node_.find(node_arg_name);
 
     if (iter != node_arg_to_producer_node_.end()) {
@@ -1305,13 +1320,23 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   // Without removing the existing consumers, add a consumer to the give node arg name.
   void AddConsumerNode(const std::string& node_arg_name, Node* consumer) {
+    ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
     node_arg_to_consumer_nodes_[node_arg_name].insert(consumer->Index());
   }
 
   // Remove a consumer from the set
   void RemoveConsumerNode(const std::string& node_arg_name, Node* consumer) {
+    ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
     node_arg_to_consumer_nodes_[node_arg_name].erase(consumer->Index());
   }
+
+  /** Reduces the memory of a graph that is not modified anymore, e.g. once the session is initialized, for this graph
+      and its subgraphs. The producer and consumer lookups keyed by NodeArg name are replaced with compact arrays of
+      node indexes sorted by NodeArg, and the doc strings of the nodes are released.
+      The lookups by name still work, but the graph can not be modified or resolved anymore. */
+  void CompactForExecution();
+
+  bool IsCompacted() const noexcept { return compact_lookups_ != nullptr; }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -1320,6 +1345,7 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   }
 
   void UpdateConsumerNodes(const std::string& node_arg_name, gsl::span<Node* const> nodes) {
+    ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
     // Replace nodes for the arg
     auto& nodes_for_arg = node_arg_to_consumer_nodes_[node_arg_name];
     if (!nodes_for_arg.empty()) {
@@ -1344,6 +1370,7 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // Options to control Graph::Resolve.
   struct ResolveOptions {
     // Whether to override existing types with inferred types.
+    // Type and shape inferencing runs for all the nodes if set, not only the ones affected by changes to the Graph.
     bool override_types = false;
     // Names of initializers to keep even if unused (optional).
     const std::unordered_set<std::string>* initializer_names_to_preserve = nullptr;
@@ -1371,6 +1398,16 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     return Resolve(default_options);
   }
 
+  /** Statistics of the type and shape inferencing done by Resolve() on the nodes of this Graph since it was created.
+  Resolve() only infers the nodes affected by the changes to the Graph since it last ran: the new and modified nodes,
+  and those whose inputs have a different type or shape or are constant initializers that were replaced. */
+  struct ResolveStats {
+    size_t num_nodes_inferred = 0;
+    size_t num_nodes_reused = 0;
+  };
+
+  const ResolveStats& GetResolveStats() const noexcept { return resolve_stats_; }
+
   const std::unordered_set<std::string>& GetOuterScopeNodeArgNames() const noexcept {
     return outer_scope_node_arg_names_;
   }
@@ -1673,6 +1710,12 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   static auto GetConsumerNodesImpl(
       TInstance& instance, const std::string& node_arg_name) -> std::vector<decltype(instance.GetNode(0))> {
     std::vector<decltype(instance.GetNode(0))> results;
+    if (instance.compact_lookups_) {
+      for (auto node_index : instance.compact_lookups_->FindConsumers(instance.GetNodeArg(node_arg_name))) {
+        results.push_back(instance.GetNode(node_index));
+      }
+      return results;
+    }
     auto iter = instance.node_arg_to_consumer_nodes_.find(node_arg_name);
     if (iter != instance.node_arg_to_consumer_nodes_.end()) {
       results.reserve(iter->second.size());
@@ -1686,6 +1729,10 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   template <typename TInstance>
   static auto GetProducerNodeImpl(
       TInstance& instance, const std::string& node_arg_name) -> decltype(instance.GetNode(0)) {
+    if (instance.compact_lookups_) {
+      const auto node_index = instance.compact_lookups_->FindProducer(instance.GetNodeArg(node_arg_name));
+      return node_index.has_value() ? instance.GetNode(*node_index) : nullptr;
+    }
     auto iter = instance.node_arg_to_producer_node_.find(node_arg_name);
     if (iter != instance.node_arg_to_producer_node_.end()) {
       auto node_index = iter->second;
@@ -1832,6 +1879,19 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   // node arg to its consumer nodes
   std::unordered_map<std::string, std::unordered_set<NodeIndex>> node_arg_to_consumer_nodes_;
+
+  // The producer and consumer lookups of a compacted graph, which replace the ones above. Both are sorted by NodeArg.
+  struct CompactLookups {
+    std::vector<std::pair<const NodeArg*, NodeIndex>> producers;
+    // the consumers of consumer_args[i] are consumer_nodes from consumer_offsets[i] to consumer_offsets[i + 1]
+    std::vector<const NodeArg*> consumer_args;
+    std::vector<size_t> consumer_offsets;
+    std::vector<NodeIndex> consumer_nodes;
+
+    std::optional<NodeIndex> FindProducer(const NodeArg* node_arg) const;
+    gsl::span<const NodeIndex> FindConsumers(const NodeArg* node_arg) const;
+  };
+  std::unique_ptr<CompactLookups> compact_lookups_;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
   std::unordered_map<std::string, int> domain_to_version_;
@@ -1853,6 +1913,14 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+  // names of the initializers added, removed or replaced since Resolve last ran. the type and shape inferencing of
+  // their consumers may read their values.
+  InlinedHashSet<std::string> initializers_modified_since_resolve_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  ResolveStats resolve_stats_;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   const logging::Logger& logger_;
 
   // If true, all inconsistencies encountered during shape and type inference
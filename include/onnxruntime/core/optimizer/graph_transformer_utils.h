@@ -29,6 +29,16 @@ class IExecutionProvider;
 
 namespace optimizer_utils {
 
+/** The objective of the graph optimizations, set with kOrtSessionOptionsGraphOptimizationObjective. */
+enum class OptimizationObjective {
+  kSpeed,
+  kBalanced,
+  kMemory,
+};
+
+/** Gets the optimization objective of the session. Throws if the configured value is not supported. */
+OptimizationObjective GetOptimizationObjective(const ConfigOptions& config_options);
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 /** Generates all predefined rules for this level.
@@ -39,7 +39,9 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <chrono>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -52,6 +54,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -336,8 +339,20 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
+
+  // Alternative to RunInParallel for a loop started from within the
+  // work of another loop, by its caller or by a worker thread, or from
+  // within a parallel section.  The loop is run in a parallel section
+  // of its own, without modifying the state of the enclosing one.
+  // Work items that no thread picks up because the workers are busy
+  // with the enclosing loops are revoked and run by the caller, so
+  // nested loops share the workers cooperatively instead of waiting
+  // for them.
+  virtual void RunNestedInParallel(std::function<void(unsigned idx)> fn,
+                                   unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
+  virtual void GetStatistics(ThreadPoolStatistics& stats) const = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -729,6 +744,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  void GetStatistics(ThreadPoolStatistics& stats) const override {
+    stats.workers.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      const WorkerData& td = worker_data_[i];
+      auto& worker = stats.workers[i];
+      worker.queue_depth = td.queue.Size();
+      worker.tasks_run = td.stats.tasks_run.load(std::memory_order_relaxed);
+      worker.steal_attempts = td.stats.steal_attempts.load(std::memory_order_relaxed);
+      worker.steals = td.stats.steals.load(std::memory_order_relaxed);
+      worker.spin_ns = td.stats.spin_ns.load(std::memory_order_relaxed);
+      worker.blocked_ns = td.stats.blocked_ns.load(std::memory_order_relaxed);
+    }
+    stats.rejected_pushes = rejected_pushes_.load(std::memory_order_relaxed);
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -789,6 +819,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    // Partition the workers by NUMA node. Work is scheduled on, and stolen from, the workers of the node of the
+    // calling thread first.
+    if (thread_options.numa_nodes.size() >= num_threads_) {
+      for (auto i = 0u; i < num_threads_; ++i) {
+        const int numa_node = thread_options.numa_nodes[i];
+        if (numa_node >= 0) {
+          if (numa_node_workers_.size() <= static_cast<size_t>(numa_node)) {
+            numa_node_workers_.resize(static_cast<size_t>(numa_node) + 1);
+          }
+          numa_node_workers_[numa_node].push_back(i);
+        }
+        worker_numa_nodes_.push_back(numa_node);
+      }
+    }
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -817,7 +862,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   void Schedule(std::function<void()> fn) override {
     PerThread* pt = GetPerThread();
-    int q_idx = Rand(&pt->rand) % num_threads_;
+    const int numa_node = CurrentNumaNode(*pt);
+    int q_idx = numa_node == -1
+                    ? Rand(&pt->rand) % num_threads_
+                    : numa_node_workers_[numa_node][Rand(&pt->rand) % numa_node_workers_[numa_node].size()];
     WorkerData& td = worker_data_[q_idx];
     Queue& q = td.queue;
     fn = q.PushBack(std::move(fn));
@@ -826,6 +874,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       td.EnsureAwake();
     } else {
       // Run the work directly if the queue rejected the work
+      rejected_pushes_.fetch_add(1, std::memory_order_relaxed);
       fn();
     }
   }
@@ -1064,6 +1113,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
     // preferred_workers maps from a par_idx to a q_idx, hence we
     // initialize slots in the range [0,num_threads_]
+    const int numa_node = CurrentNumaNode(*GetPerThread());
+    if (numa_node != -1 && preferred_workers.size() == 1) {
+      // With NUMA partitioning, the first hints are the workers of the node of the calling thread, so loops with a
+      // degree of parallelism up to the size of the node stay on the node.
+      const auto& local_workers = numa_node_workers_[numa_node];
+      const unsigned first = next_worker++;
+      for (size_t i = 0; i < local_workers.size(); ++i) {
+        preferred_workers.push_back(local_workers[(first + i) % local_workers.size()]);
+      }
+      for (auto q_idx = 0u; q_idx < num_threads_; ++q_idx) {
+        if (worker_numa_nodes_[q_idx] != numa_node) {
+          preferred_workers.push_back(q_idx);
+        }
+      }
+    }
     while (preferred_workers.size() <= num_threads_) {
       preferred_workers.push_back(next_worker++ % num_threads_);
     }
@@ -1079,9 +1143,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     preferred_workers[par_idx] = ran_on_idx;
   }
 
-  // Schedule [par_idx_start,par_idx_end) across the preferred workers
+  // Schedule [par_idx_start,par_idx_end) across the preferred workers.
+  // pt is the state of the calling thread, and tag the tag of the
+  // thread leading the parallel section.
 
   void ScheduleOnPreferredWorkers(PerThread& pt,
+                                  Tag tag,
                                   ThreadPoolParallelSection& ps,
                                   InlinedVector<int>& preferred_workers,
                                   unsigned par_idx_start,
@@ -1106,7 +1173,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         worker_fn(par_idx);
         ps.tasks_finished++;
       },
-                                           pt.tag, w_idx);
+                                           tag, w_idx);
 
       // Queue accepted the task; wake the thread that owns the queue.
       // In addition, if the queue was non-empty, attempt to wake
@@ -1117,6 +1184,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         if (push_status == PushResult::ACCEPTED_BUSY) {
           worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
         }
+      } else {
+        rejected_pushes_.fetch_add(1, std::memory_order_relaxed);
       }
     }
   }
@@ -1156,13 +1225,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
                              unsigned new_dop,
                              bool dispatch_async,
                              std::function<void(unsigned)> worker_fn) {
+    RunInParallelInternal(pt, ps, pt.preferred_workers, new_dop, dispatch_async, std::move(worker_fn));
+  }
+
+  void RunInParallelInternal(PerThread& pt,
+                             ThreadPoolParallelSection& ps,
+                             InlinedVector<int>& preferred_workers,
+                             unsigned new_dop,
+                             bool dispatch_async,
+                             std::function<void(unsigned)> worker_fn) {
     // Ensure that the vector of preferred workers is sufficient for the
     // size of the loop we are entering.  We do this before dispatching
     // tasks for the loop in order to avoid any races between changes to
     // the size of the vector and recording the locations that tasks run
     // in as they complete.
     assert(new_dop <= (unsigned)(num_threads_ + 1));
-    auto& preferred_workers = pt.preferred_workers;
     InitializePreferredWorkers(preferred_workers);
 
     // current_dop is the degree of parallelism via any workers already
@@ -1180,7 +1257,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         assert(current_dop == 1);
 
         // Task for dispatching work asynchronously.
-        Task dispatch_task = [current_dop, new_dop, worker_fn, &preferred_workers, &ps, &pt, this]() {
+        // The dispatcher uses the tag the leading thread has now: a
+        // nested loop of the leading thread may change pt.tag while
+        // the dispatcher runs.
+        Task dispatch_task = [current_dop, new_dop, worker_fn, &preferred_workers, &ps, tag = pt.tag, this]() {
           // Record that dispatch work has started.  This must occur
           // prior to scheduling tasks, in order to synchronize with
           // EndParallelSectionInternal.  [ If EndParallelSection
@@ -1191,7 +1271,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           ps.dispatch_started.store(true, std::memory_order_seq_cst);
 
           // Schedule tasks par_idx=[current_dop+1,new_dop)
-          ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop + 1, new_dop, worker_fn);
+          ScheduleOnPreferredWorkers(*GetPerThread(), tag, ps, preferred_workers, current_dop + 1, new_dop, worker_fn);
           ps.dispatch_done.store(true, std::memory_order_release);
 
           // Record the worker thread that actually runs this task.
@@ -1222,11 +1302,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           }
         } else {
           ps.dispatch_q_idx = -1;  // failed to enqueue dispatch_task
+          rejected_pushes_.fetch_add(1, std::memory_order_relaxed);
         }
         profiler_.LogEnd(ThreadPoolProfiler::DISTRIBUTION_ENQUEUE);
       } else {
         // Synchronous dispatch
-        ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop, new_dop, std::move(worker_fn));
+        ScheduleOnPreferredWorkers(pt, pt.tag, ps, preferred_workers, current_dop, new_dop, std::move(worker_fn));
       }
       ps.current_dop = new_dop;
     }
@@ -1311,6 +1392,31 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
   }
 
+  // Run a loop nested in the work of another loop or in a parallel
+  // section.  The tasks of the enclosing loop or section may still be
+  // in the work queues, or running and recording where they ran in the
+  // preferred workers of this thread, so the nested loop uses a fresh
+  // tag, its own preferred workers, and its own parallel section.
+  void RunNestedInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
+    ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
+    ORT_UNUSED_PARAMETER(block_size);
+    PerThread* pt = GetPerThread();
+    const Tag enclosing_tag = pt->tag;
+    const bool enclosing_leading_par_section = pt->leading_par_section;
+    pt->tag = Tag::GetNext();
+    pt->leading_par_section = false;
+
+    InlinedVector<int> preferred_workers;
+    ThreadPoolParallelSection ps;
+    StartParallelSectionInternal(*pt, ps);
+    RunInParallelInternal(*pt, ps, preferred_workers, n, true, fn);
+    fn(0);
+    EndParallelSectionInternal(*pt, ps);
+
+    pt->tag = enclosing_tag;
+    pt->leading_par_section = enclosing_leading_par_section;
+  }
+
   int NumThreads() const final {
     return num_threads_;
   }
@@ -1388,11 +1494,27 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 #pragma warning(pop)
 #endif  // _MSC_VER
 
+  // Counters of a worker, see ThreadPoolStatistics.  They are only
+  // updated by the worker itself, hence without read-modify-write
+  // operations, and may be read concurrently by any thread.
+  struct WorkerStats {
+    std::atomic<uint64_t> tasks_run{0};
+    std::atomic<uint64_t> steal_attempts{0};
+    std::atomic<uint64_t> steals{0};
+    std::atomic<uint64_t> spin_ns{0};
+    std::atomic<uint64_t> blocked_ns{0};
+
+    static void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+      counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+  };
+
   struct WorkerData {
     constexpr WorkerData() : thread(), queue() {
     }
     std::unique_ptr<Thread> thread;
     Queue queue;
+    WorkerStats stats;
 
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
@@ -1498,8 +1620,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+  // NUMA node of each worker, and workers of each NUMA node. Empty if the workers are not partitioned by NUMA node.
+  std::vector<int> worker_numa_nodes_;
+  std::vector<std::vector<unsigned>> numa_node_workers_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
+  std::atomic<uint64_t> rejected_pushes_{0};  // Tasks rejected by a full queue
 
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
@@ -1546,9 +1672,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       Task t = q.PopFront();
       if (!t) {
         // Spin waiting for work.
+        const auto spin_start = std::chrono::steady_clock::now();
         for (int i = 0; i < spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
-            t = Steal(StealAttemptKind::TRY_ONE);
+            t = TrySteal(td.stats, StealAttemptKind::TRY_ONE);
           } else {
             t = q.PopFront();
           }
@@ -1559,6 +1686,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           }
           onnxruntime::concurrency::SpinPause();
         }
+        const auto block_start = std::chrono::steady_clock::now();
+        WorkerStats::Add(td.stats.spin_ns, ElapsedNs(spin_start, block_start));
 
         // Attempt to block
         if (!t) {
@@ -1622,11 +1751,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
             should_exit = true;
             break;
           }
+          WorkerStats::Add(td.stats.blocked_ns, ElapsedNs(block_start, std::chrono::steady_clock::now()));
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) t = TrySteal(td.stats, StealAttemptKind::TRY_ALL);
         }
       }
 
@@ -1634,6 +1764,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         td.SetActive();
         t();
         profiler_.LogRun(thread_id);
+        WorkerStats::Add(td.stats.tasks_run, 1);
         td.SetSpinning();
       }
     }
@@ -1652,18 +1783,49 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // "snatching" work from a thread which is just about to notice the
   // work itself.
 
+  //
+  // With NUMA partitioning, the workers of the node of the calling
+  // thread are tried first, and the other workers only with TRY_ALL.
+
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
-    unsigned size = num_threads_;
+    const int numa_node = CurrentNumaNode(*pt);
+    if (numa_node != -1) {
+      const auto& local_workers = numa_node_workers_[numa_node];
+      Task t = StealFrom(*pt, steal_kind, static_cast<unsigned>(local_workers.size()), local_workers.data());
+      if (t || steal_kind == StealAttemptKind::TRY_ONE) {
+        return t;
+      }
+    }
+    return StealFrom(*pt, steal_kind, num_threads_, nullptr);
+  }
+
+  // Steal, counting the attempt in the statistics of the calling worker.
+  Task TrySteal(WorkerStats& stats, StealAttemptKind steal_kind) {
+    Task t = Steal(steal_kind);
+    WorkerStats::Add(stats.steal_attempts, 1);
+    if (t) {
+      WorkerStats::Add(stats.steals, 1);
+    }
+    return t;
+  }
+
+  static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  // Steals from a random walk over size victims. victims maps the walk to worker indices, nullptr for the identity.
+  Task StealFrom(PerThread& pt, StealAttemptKind steal_kind, unsigned size, const unsigned* victims) {
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
-    unsigned r = Rand(&pt->rand);
+    unsigned r = Rand(&pt.rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
 
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+      WorkerData& td = worker_data_[victims == nullptr ? victim : victims[victim]];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.queue.PopBack();
         if (t) {
           return t;
         }
@@ -1679,13 +1841,25 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
-    const unsigned size = static_cast<unsigned>(worker_data_.size());
-    unsigned r = Rand(&pt->rand);
+    const int numa_node = CurrentNumaNode(*pt);
+    if (numa_node != -1) {
+      const auto& local_workers = numa_node_workers_[numa_node];
+      const int q_idx = NonEmptyQueueIndexIn(*pt, static_cast<unsigned>(local_workers.size()), local_workers.data());
+      if (q_idx != -1) {
+        return q_idx;
+      }
+    }
+    return NonEmptyQueueIndexIn(*pt, static_cast<unsigned>(worker_data_.size()), nullptr);
+  }
+
+  int NonEmptyQueueIndexIn(PerThread& pt, unsigned size, const unsigned* victims) {
+    unsigned r = Rand(&pt.rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      if (!worker_data_[victim].queue.Empty()) {
-        return victim;
+      const unsigned q_idx = victims == nullptr ? victim : victims[victim];
+      if (!worker_data_[q_idx].queue.Empty()) {
+        return static_cast<int>(q_idx);
       }
       victim += inc;
       if (victim >= size) {
@@ -1695,6 +1869,20 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return -1;
   }
 
+  // Returns the NUMA node of the calling thread, or -1 if the workers are not partitioned by NUMA node or if the
+  // node is unknown or has no workers.
+  int CurrentNumaNode(const PerThread& pt) const {
+    if (numa_node_workers_.size() <= 1) {
+      return -1;
+    }
+    int numa_node = pt.pool == this ? worker_numa_nodes_[pt.thread_id] : env_.GetCurrentNumaNode();
+    if (numa_node < 0 || static_cast<size_t>(numa_node) >= numa_node_workers_.size() ||
+        numa_node_workers_[numa_node].empty()) {
+      return -1;
+    }
+    return numa_node;
+  }
+
   static EIGEN_STRONG_INLINE uint64_t GlobalThreadIdHash() {
     return std::hash<std::thread::id>()(std::this_thread::get_id());
   }
@@ -16,10 +16,12 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include "core/common/common.h"
 #include "core/platform/env.h"
 
@@ -136,6 +138,30 @@ class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// Counters of a thread pool, cumulative since its creation. They are always collected, with relaxed atomic updates
+// made by each worker to its own counters.
+struct ThreadPoolStatistics {
+  struct Worker {
+    // number of tasks in the queue of the worker when the statistics were read
+    unsigned queue_depth = 0;
+    uint64_t tasks_run = 0;
+    // attempts at stealing a task from the queues of the other workers, and the successful ones
+    uint64_t steal_attempts = 0;
+    uint64_t steals = 0;
+    // time spent spinning waiting for work, and blocked waiting for work
+    uint64_t spin_ns = 0;
+    uint64_t blocked_ns = 0;
+  };
+  std::vector<Worker> workers;
+
+  // Number of tasks that a full queue rejected. Tasks scheduled with Schedule are then run by the thread scheduling
+  // them, work items of parallel loops are run by the other threads of the loop.
+  uint64_t rejected_pushes = 0;
+
+  // Returns the statistics as a JSON object.
+  std::string ToJson() const;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -192,12 +218,24 @@ class ThreadPool {
   // Parallel sections are only implemented with the Eigen threadpool.
   // They have no effect when using OpenMP.
   //
-  // Parallel sections may not be nested, and may not be used inside
-  // parallel loops.
+  // Parallel sections may be nested, and may be used inside parallel
+  // loops, but only the outermost section of a thread has an effect.
+  // A parallel loop started from within the body of another parallel
+  // loop, on the calling thread or on a worker, runs as a nested loop: it
+  // enlists the workers that are idle, and its caller runs the work
+  // items that no worker picked up.  It never waits for a busy worker,
+  // so nested loops can not deadlock, and the pool is not
+  // oversubscribed.
+  //
+  // On hybrid CPUs, a latency-critical section can set
+  // performance_cores_only so that its loops run only on the threads
+  // the pool has measured to be fast (i.e., running on performance
+  // cores) and on the calling thread.  Until those measurements are
+  // available all the threads take part.
 
   class ParallelSection {
    public:
-    explicit ParallelSection(ThreadPool* tp);
+    explicit ParallelSection(ThreadPool* tp, bool performance_cores_only = false);
     ~ParallelSection();
 
    private:
@@ -213,6 +251,31 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Priority of a run using the pool.  A session run enters its intra-op pool
+  // with a RunPriorityScope from the "run.priority" run option.  While a run
+  // of higher priority is in progress on a pool, the parallel loops of the
+  // runs of lower priority on the same pool run on their calling thread only,
+  // so that the threads of the pool are left to the higher priority run.
+  // This lets the latency-critical sessions sharing the global thread pools
+  // with batch-scoring ones keep their latency under load.
+  enum class RunPriority : int {
+    kLow = 0,
+    kNormal = 1,
+    kHigh = 2,
+  };
+
+  class RunPriorityScope {
+   public:
+    RunPriorityScope(ThreadPool* tp, RunPriority priority);
+    ~RunPriorityScope();
+
+   private:
+    ThreadPool* tp_;
+    RunPriority priority_;
+    RunPriority previous_priority_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunPriorityScope);
+  };
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -221,6 +284,13 @@ class ThreadPool {
 
   void DisableSpinning();
 
+  // Creates new threads for the pool in a process forked after the threads were started, where only the
+  // forking thread exists.  The state of the previous threads is leaked, as it cannot be destroyed without
+  // them.  It does nothing in the process that started the threads, so every user of a pool shared across a
+  // fork can call it before its first use of the pool in the child.  No work may be in progress on the pool
+  // when the process forks.
+  void RecreateThreadsAfterFork();
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -362,6 +432,9 @@ class ThreadPool {
 
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
+  // Returns the counters of the pool, or empty statistics for a null tp or a pool without threads.
+  static ThreadPoolStatistics GetStatistics(const concurrency::ThreadPool* tp);
+
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
@@ -377,6 +450,9 @@ class ThreadPool {
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
 
+  // Returns true if a run of higher priority than the one of the calling thread is in progress on the pool.
+  bool YieldsToHigherPriorityRun() const;
+
   // Run fn with up to n degree-of-parallelism enlisting the thread pool for
   // help.  The degree-of-parallelism includes the caller, and so if n==1
   // then the function will run directly in the caller.  The fork-join
@@ -417,6 +493,16 @@ class ThreadPool {
 
   ThreadOptions thread_options_;
 
+  // What the threads of the pool are created with, to create them again after a fork.
+  Env* env_ = nullptr;
+  std::basic_string<NAME_CHAR_TYPE> name_;
+  bool low_latency_hint_ = false;
+  int threads_to_create_ = 0;
+
+  // The process in which the threads of the pool were started.
+  std::atomic<PIDType> threads_pid_{0};
+  std::mutex fork_mutex_;
+
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
   // EigenThreadPool is used to create OS threads and handle work distribution to them.
   // If degree_of_parallelism == 1 then underlying_threadpool_ is left as nullptr
@@ -428,6 +514,23 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Number of runs in progress on the pool, indexed by RunPriority.
+  std::atomic<int> active_runs_by_priority_[3] = {};
+
+  // In hybrid mode, the speed of each thread relative to the fastest one, in (0, 1], learned from the loops it took
+  // part in.  Index 0 is shared by the threads outside the pool, index i + 1 is the i-th thread of the pool.  The
+  // threads claim iterations in blocks sized in proportion to their speed, so the slower ones do not become
+  // stragglers at the end of a loop.
+  std::unique_ptr<std::atomic<float>[]> thread_speeds_;
+
+  // Updates thread_speeds_ with the iterations each work item of a loop ran and the time it took.
+  struct WorkItemTiming {
+    size_t thread_slot = 0;
+    uint64_t iterations = 0;
+    int64_t duration_ns = 0;
+  };
+  void UpdateThreadSpeeds(const WorkItemTiming* timings, size_t num_timings);
 };
 
 }  // namespace concurrency
@@ -74,6 +74,10 @@ static const char* const kCoremlProviderOption_AllowLowPrecisionAccumulationOnGP
 //    3. Hash of the input/output names of the model
 // Please find out how to set metadata_props in the onnxruntime API documentation. https://onnxruntime.ai/docs/execution-providers/CoreML-ExecutionProvider.html#configuration-options
 static const char* const kCoremlProviderOption_ModelCacheDirectory = "ModelCacheDirectory";
+// Load the CoreML model for the compute units other than the CPU on a background queue, which can take seconds as
+// CoreML specializes the model for the GPU/Neural Engine. Until it's loaded, the model runs on the CPU only.
+// Has no effect with MLComputeUnits CPUOnly.
+static const char* const kCoremlProviderOption_LoadModelInBackground = "LoadModelInBackground";
 
 // User provided cache-key in metadata_props.
 static const char* const kCOREML_CACHE_KEY = "COREML_CACHE_KEY";
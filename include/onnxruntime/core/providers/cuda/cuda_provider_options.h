@@ -40,4 +40,8 @@ struct OrtCUDAProviderOptionsV2 {
   int use_tf32 = 1;                                                                                            // use TF32
   int fuse_conv_bias = 0;                                                                                      // Enable CUDNN Frontend kernel fusing, results in JIT compiles
   int sdpa_kernel = 0;                                                                                         // Scaled Dot Product Attention kernel option
+  int max_num_cuda_graphs = 0;                                                                                 // Max number of captured CUDA graphs, the least recently used is evicted. 0 for no limit.
+  int use_cuda_mem_pool = 0;                                                                                   // flag specifying if the device memory is allocated from a CUDA memory pool instead of an arena.
+  size_t cuda_mem_pool_release_threshold = std::numeric_limits<size_t>::max();                                 // Idle memory in bytes the CUDA memory pool keeps on synchronization.
+  int compute_stream_pool_size = 0;                                                                            // Number of compute streams shared round-robin by concurrent runs. 0 for a stream per run.
 };
@@ -89,4 +89,11 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_engine_cache_prefix{nullptr};  // specify engine cache prefix
   int trt_engine_hw_compatible{0};               // Enable hardware compatibility. Default 0 = false, nonzero = true
   const char* trt_op_types_to_exclude{};         // Exclude specific ops from running on TRT.
+  int trt_engine_sharing_enable{0};              // Share the engines built for the same subgraph with the same options
+                                                 // on the same GPU across the sessions of the process.
+                                                 // Default 0 = false, nonzero = true
+  int trt_profile_auto_expand{0};                // When an input shape falls outside the implicit optimization profile,
+                                                 // widen the profile to power-of-two bounds around the observed shapes
+                                                 // so traffic with growing shapes triggers fewer engine rebuilds.
+                                                 // Default 0 = false, nonzero = true
 };
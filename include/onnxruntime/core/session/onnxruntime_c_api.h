@@ -2822,6 +2822,9 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "max_cached_chunk_size_bytes": Chunks up to this size that are freed are kept in a small cache, sharded by thread, in
+   *  front of the arena so that they can be handed out again without taking the arena lock.
+   *  Use 0 or -1 to disable the cache (default).
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3717,6 +3720,11 @@ struct OrtApi {
    *      be available.
    *      - "0": Default. Disabled.
    *      - "1": Enabled.
+   *   "context_load_mode": When the QNN contexts of an EPContext model are loaded.
+   *      - "eager": Default. During session initialization.
+   *      - "lazy": On the first Run. Session initialization only reads the context binaries.
+   *      - "background": On a background thread started during session initialization, which the first Run waits for.
+   *      Ignored, i.e. "eager", if the EP contexts are shared across sessions.
    *   "dump_json_qnn_graph": Set to "1" to dump QNN graphs generated by QNN EP as JSON files. Each graph partition
    *      assigned to QNN EP is dumped to a separate file.
    *   "json_qnn_graph_dir": Directory in which to dump QNN JSON graphs. If not specified, QNN graphs are dumped in the
@@ -3740,6 +3748,8 @@ struct OrtApi {
    * XNNPACK supported keys:
    *   "intra_op_num_threads": number of thread-pool size to use for XNNPACK execution provider.
    *      default value is 0, which means to use the session thread-pool size.
+   *   "shared_weights_cache": set to 1 to share the packed weights of the XNNPACK kernels with the other sessions of
+   *      the process that use the same weights. Disabled by default.
    *
    * \since Version 1.12.
    */
@@ -4898,6 +4908,134 @@ struct OrtApi {
                   _In_ const int64_t* shape, size_t shape_len,
                   ONNXTensorElementDataType type,
                   _Outptr_ OrtValue** out);
+
+  /** \brief Get the kernel latency statistics gathered by the sampling profiler
+   *
+   * The sampling profiler is enabled with the "session.sampling_profiler_interval" session config entry. It records
+   * the latency of the kernels of one run out of N and can be queried at any time while the session is running.
+   *
+   * The statistics are returned as a JSON object with the number of sampled runs and, per node and per op type,
+   * the number of samples and the mean, min, p50, p90, p99 and max latencies in microseconds.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionGetSampledLatencyStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the queue and work stealing statistics of the thread pools used by the session
+   *
+   * The statistics are always collected and are cumulative since the creation of the thread pools. Sessions using
+   * the global thread pools of the environment share them.
+   *
+   * The statistics are returned as a JSON object with an "intra_op" and an "inter_op" member, null if the session
+   * runs without that thread pool. Each contains the number of tasks rejected by a full queue and, per worker, the
+   * current queue depth, the number of tasks run, the number of steal attempts and successful steals, and the time
+   * spent spinning and blocked waiting for work in nanoseconds.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionGetThreadPoolStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the statistics of the allocators used by the session
+   *
+   * The statistics are cumulative since the creation of the allocators. Allocators registered with the environment
+   * are shared by the sessions using them.
+   *
+   * The statistics are returned as a JSON array with an element per allocator, holding its name, device and the
+   * counters of onnxruntime::AllocatorStats, e.g. the number of allocations, reserves and arena extensions and the
+   * bytes in use. Allocators that don't collect statistics report zeros.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionGetAllocatorStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the time spent in the phases of the creation of the session
+   *
+   * The time is always recorded, whether profiling is enabled or not. It is returned as a JSON array with an element
+   * per phase and name within the phase, in the order the phases started, e.g.
+   * `[{"phase": "graph_transformer", "name": "ConstantFolding", "count": 2, "duration_us": 1234.5}, ...]`.
+   * The phases are "model_load", "graph_transformer" per transformer, "partitioning", "get_capability" and "compile"
+   * per execution provider, "allocation_planning", "initializer_load", "kernel_creation", "prepack" and
+   * "session_initialization". Phases nest, e.g. "partitioning" includes "get_capability". "initializer_load" and
+   * "prepack" are also broken down per initializer of at least
+   * kOrtSessionOptionsInitializationStatsMinInitializerBytes bytes.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionGetInitializationStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the metrics of a session for production monitoring, in OpenMetrics text format
+   *
+   * The metrics, labelled with the id of the session, can be exported as is to Prometheus or OpenMetrics scrapers:
+   * the number of runs, the histograms of the run durations and of the queue wait of RunAsync, the bytes in use and
+   * reserved by the allocators, the tasks and idle times of the thread pools, the number of nodes assigned to the CPU
+   * execution provider while other execution providers are registered, the graph replays and the hit counts of the
+   * memory patterns and arena chunk caches. The run counters are read without taking a lock.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated OpenMetrics text. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionGetMetrics, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Warm up a session before it serves requests
+   *
+   * So that the first requests do not pay for the arena growth, the memory patterns, TunableOp tuning, graph capture,
+   * lazy compilation of execution providers and page faults on the weights, a byte of every page of the initializers
+   * in CPU memory is read, then the model runs twice with zeroed inputs of each set of shapes, the second time with
+   * the outputs of the first run pre-allocated so that graphs can be captured. The arenas keep the regions they grew
+   * to during the runs.
+   *
+   * The report is a JSON object, e.g. `{"initializer_bytes_read": 123, "runs": [{"inputs": "input_ids:1x128",
+   * "first_run_us": 5000, "second_run_us": 800}], "allocators": [...], "ready": true}`, where "allocators" is the
+   * array returned by OrtApi::SessionGetAllocatorStats after the warm-up.
+   *
+   * \param[in] session
+   * \param[in] shape_specs The shapes of the inputs of each warm-up, e.g.
+   *   "input_ids:1x128,attention_mask:1x128;input_ids:8x512,attention_mask:8x512", with sets separated by ';'. The
+   *   dimensions that are not given are the ones of the model, with 1 for the symbolic dimensions. If nullptr or
+   *   empty, the session warms up once with these default shapes.
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.22.
+   */
+  ORT_API2_STATUS(SessionWarmUp, _Inout_ OrtSession* session, _In_opt_z_ const char* shape_specs,
+                  _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
 };
 
 /*
@@ -1108,6 +1108,16 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  /** \brief Returns the kernel latency statistics of the sampling profiler as a JSON string.
+   *
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr GetSampledLatencyStatsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetSampledLatencyStats
+  AllocatedStringPtr GetThreadPoolStatsAllocated(OrtAllocator* allocator) const;      ///< Wraps OrtApi::SessionGetThreadPoolStats
+  AllocatedStringPtr GetAllocatorStatsAllocated(OrtAllocator* allocator) const;       ///< Wraps OrtApi::SessionGetAllocatorStats
+  AllocatedStringPtr GetInitializationStatsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetInitializationStats
+  AllocatedStringPtr GetMetricsAllocated(OrtAllocator* allocator) const;              ///< Wraps OrtApi::SessionGetMetrics
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1184,6 +1194,14 @@ struct SessionImpl : ConstSessionImpl<T> {
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
 
+  /** \brief Warm up the session before it serves requests, and return the report. Wraps OrtApi::SessionWarmUp
+   *
+   * \param shape_specs the shapes of the inputs of each warm-up, e.g. "input_ids:1x128;input_ids:8x512", or nullptr
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr WarmUpAllocated(const char* shape_specs, OrtAllocator* allocator);
+
   /** \brief Set DynamicOptions for EPs (Execution Providers)
    *
    * Wraps OrtApi::SetEpDynamicOptions
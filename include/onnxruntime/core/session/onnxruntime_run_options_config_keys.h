@@ -52,3 +52,9 @@ static const char* const kOrtRunOptionsConfigQnnLoraConfig = "qnn.lora_config";
 // If the value is set to -1, cuda graph capture/replay is disabled in that run.
 // User are not expected to set the value to 0 as it is reserved for internal use.
 static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Priority of the run on the intra-op thread pool, which the runs of other sessions share when the global thread pools
+// are used. One of "low", "normal" and "high". Default to "normal".
+// While a run of higher priority is in progress on the pool, the parallel loops of the runs of lower priority run on
+// their calling thread only, leaving the threads of the pool to the higher priority run.
+static const char* const kOrtRunOptionsConfigRunPriority = "run.priority";
@@ -67,6 +67,12 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable fusing chains of elementwise operators into FusedElementwise on CPU in the level 3 graph
+// optimizations. "0": disable; "1": enable. The default is "0".
+// The fused kernel computes Sigmoid, Tanh, Exp and Erf with the MLAS approximations, so the results may differ
+// slightly from the unfused operators.
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion = "optimization.enable_elementwise_chain_fusion";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -107,6 +113,26 @@ static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimiz
 // Default is an empty string which means no optimizers are disabled.
 static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimization.disable_specified_optimizers";
 
+// Maximum size in bytes of the outputs of a node that is constant folded. Nodes producing larger outputs, e.g. the
+// Expand of an attention mask, are not folded so that constant folding does not grow the model and the peak memory
+// usage of the optimization beyond it.
+// Option values:
+// - "0": no maximum. [DEFAULT]
+// - a positive integer: the maximum size in bytes.
+static const char* const kOrtSessionOptionsConstantFoldingMaxOutputSize =
+    "optimization.constant_folding_max_output_size";
+
+// The objective of the graph optimizations. The transformers that trade memory for speed check it and skip the
+// rewrites which would grow the initializers or the peak memory usage of the session. The change in the size of the
+// initializers made by each transformer is logged at the INFO level.
+// Option values:
+// - "speed": optimize for speed only. [DEFAULT]
+// - "balanced": constant folding does not fold the nodes whose outputs are larger than their inputs, e.g. Expand.
+// - "memory": as "balanced", and the NCHWc layout transformer, which pads the channels, and the pre-packing of the
+//   weights, which keeps a second copy of them, are disabled. Pre-packing is still enabled if
+//   kOrtSessionOptionsConfigDisablePrepacking is explicitly set to "0".
+static const char* const kOrtSessionOptionsGraphOptimizationObjective = "optimization.objective";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -117,6 +143,19 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether the per session intra_op thread pool and the CPU arena are NUMA aware. "0": default, disabled.
+// "1": when the process can run on more than one NUMA node, the intra_op threads are distributed across the nodes and
+// bound to them, work is scheduled on and stolen from the threads of the node of the calling thread first, and the
+// CPU execution provider uses one arena per node, allocating from the arena of the node of the calling thread.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
+// Configure whether the CPU execution provider allocates on large (2 MB) pages. "0": default, disabled.
+// "1": the allocations of at least one large page, i.e. the arena regions and the initializers, use large pages:
+// the hugetlbfs pool or transparent huge pages on Linux, and large pages on Windows if the user has the
+// "Lock pages in memory" privilege. Where they are not available the regular pages are used, which is reported
+// by the large page statistics of the allocator, see OrtApi::SessionGetAllocatorStats.
+static const char* const kOrtSessionOptionsConfigUseLargePages = "session.use_large_pages";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -332,11 +371,423 @@ static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFil
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Gemm fastmath mode on x64 processors with AVX512_BF16, using AMX-BF16 tiles when available.
+// Option values:
+// - "0": Gemm FastMath mode is not enabled. [DEFAULT]
+// - "1": Gemm FastMath mode is enabled.
+static const char* const kOrtSessionOptionsMlasGemmFastMathAmd64Bfloat16 = "mlas.enable_gemm_fastmath_amd64_bfloat16";
+
+// The fp32 CPU Conv computes 3x3 convolutions with enough channels with the Winograd F(4x4, 3x3) algorithm, which
+// has a slightly larger numerical error than the direct convolution. This option disables the Winograd algorithm.
+// Option values:
+// - "0": Winograd convolution is enabled. [DEFAULT]
+// - "1": Winograd convolution is disabled.
+static const char* const kOrtSessionOptionsMlasDisableConvWinograd = "mlas.disable_conv_winograd";
+
+// The fp32 CPU MatMul compresses a constant weight with 2:4 structured sparsity, where every group of four
+// consecutive elements along the reduced dimension holds at most two non-zero values, to its non-zero values and
+// their 2-bit indices, and only multiplies the non-zero values. This option keeps such weights dense.
+// Option values:
+// - "0": 2:4 sparse weights are compressed. [DEFAULT]
+// - "1": 2:4 sparse weights are packed as dense weights.
+static const char* const kOrtSessionOptionsMlasDisableGemmSparse24 = "mlas.disable_gemm_sparse_2_4";
+
+// The fp32 CPU MatMul compresses a constant weight whose fraction of non-zero values is at most this density to a
+// blocked CSR format, and multiplies it with a sparse kernel that only reads the stored values.
+// Option values:
+// - "0": sparse weights are packed as dense weights.
+// - A density in (0, 1]: weights with at most this fraction of non-zero values are compressed. The default is "0.1".
+static const char* const kOrtSessionOptionsMlasGemmSparseCsrMaxDensity = "mlas.gemm_sparse_csr_max_density";
+
+// A ZipMap node that produces a graph output converts a dense [N, C] probability tensor to a sequence of N maps,
+// which allocates a map entry per value and is slow to convert to Python dictionaries. This option replaces such a
+// ZipMap with its dense input: the graph output keeps its name and becomes the float tensor, and a new graph output
+// named "<output name>_labels" holds the class labels as a 1D string or int64 tensor. The values are the same, so
+// the value of class labels[j] in row i is output[i, j], but the output types change.
+// Requires the basic graph optimization level or higher.
+// Option values:
+// - "0": the ZipMap outputs are sequences of maps. [DEFAULT]
+// - "1": the ZipMap outputs are replaced by dense tensors and label tensors.
+static const char* const kOrtSessionOptionsZipMapColumnarOutput = "session.zipmap_columnar_output";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
 static const char* const kOrtSessionOptionsQDQMatMulNBitsAccuracyLevel = "session.qdq_matmulnbits_accuracy_level";
 
+// Maximum number of input shape signatures whose memory patterns are cached by a session. When the cache is full,
+// the least recently used memory pattern is evicted. Models with a few recurring input shapes can bound the memory
+// held by the cache without disabling memory patterns.
+// Option values:
+// - "0": the cache is unbounded. [DEFAULT]
+// - a positive integer: the maximum number of cached memory patterns.
+static const char* const kOrtSessionOptionsMemoryPatternCacheCapacity = "session.memory_pattern_cache_capacity";
+
+// Path of a snapshot file of the session state that is otherwise rebuilt by every session of the model: the memory
+// patterns generated for the input shapes seen by the runs. The snapshot is loaded when the session is initialized,
+// if it was generated with the same execution plan, and rewritten whenever a run generates a new memory pattern, so
+// that the first runs of later sessions use the memory patterns right away. Only used with memory patterns enabled.
+// Prepacked weights can be saved with kOrtSessionOptionsSavePrePackedConstantInitializers.
+// Option values:
+// - "": no snapshot. [DEFAULT]
+// - a file path: the snapshot file, created if it does not exist.
+static const char* const kOrtSessionOptionsSessionStateSnapshotFile = "session.state_snapshot_file";
+
+// Generate the memory patterns of models with symbolic input dimensions, e.g. a dynamic sequence length, from the
+// shapes of the graph: the size of every activation is compiled as a product of the symbolic dimensions of the graph
+// inputs when the session is initialized, and the memory pattern of a run is generated from the shapes of its feeds.
+// Every run then allocates the activations in a single block, including the first run with new input shapes, and the
+// memory patterns are not cached per input shape. Activations whose shapes depend on data are allocated separately.
+// Only used with memory patterns enabled, and for the main graph when it runs on a single stream.
+// Option values:
+// - "0": the memory patterns are recorded by the first run with each set of input shapes. [DEFAULT]
+// - "1": the memory patterns are generated from the symbolic shapes.
+static const char* const kOrtSessionOptionsSymbolicMemoryPatterns = "session.symbolic_memory_patterns";
+
+// Load the initializers stored in external data files when the nodes consuming them first run instead of when the
+// session is initialized, so that models with initializers that are seldom used, e.g. in the branches of If nodes,
+// or larger than the memory can run. Lazy initializers are not pre-packed.
+// Initializers on CPU are memory mapped and released, least recently used first, when they exceed the budget set
+// with kOrtSessionOptionsLazyInitializersMemoryBudget. Initializers on other devices are kept once loaded.
+// Option values:
+// - "0": load all the initializers when the session is initialized. [DEFAULT]
+// - "1": load the initializers with external data on first use.
+static const char* const kOrtSessionOptionsLazyInitializerLoading = "session.lazy_initializer_loading";
+
+// Maximum number of bytes of the lazy initializers loaded on CPU. The budget is exceeded while more are used by the
+// running nodes. Only used if kOrtSessionOptionsLazyInitializerLoading is "1".
+// Option values:
+// - "0": unbounded, the initializers are kept once loaded. [DEFAULT]
+// - a number of bytes.
+static const char* const kOrtSessionOptionsLazyInitializersMemoryBudget = "session.lazy_initializers_memory_budget";
+
+// Minimum size in bytes of the initializers loaded lazily. Smaller ones, e.g. shapes read by the kernels when they are
+// created, are loaded when the session is initialized. Only used if kOrtSessionOptionsLazyInitializerLoading is "1".
+// Option values:
+// - a number of bytes. Default is "1048576".
+static const char* const kOrtSessionOptionsLazyInitializersMinSize = "session.lazy_initializers_min_size";
+
+// Stream the lazy initializers layer by layer: while a node runs, the lazy initializers of the given number of next
+// nodes consuming lazy initializers in the execution order are loaded on a background thread. With a memory budget
+// set with kOrtSessionOptionsLazyInitializersMemoryBudget, the initializers already used are released first, so that
+// only the weights of a few layers are loaded at any time. Only used if kOrtSessionOptionsLazyInitializerLoading
+// is "1".
+// Option values:
+// - "0": no prefetching, the initializers are loaded when their consumers run. [DEFAULT]
+// - a number of nodes.
+static const char* const kOrtSessionOptionsLazyInitializersPrefetchDistance =
+    "session.lazy_initializers_prefetch_distance";
+
+// Share the memory mappings of external initializer data between all sessions in the process.
+// CPU initializers with external data are backed directly by the mapped file. With this option the mappings are kept in
+// a process-wide registry keyed by file path, offset and length, so sessions loading the same model reuse the same
+// read-only pages instead of creating their own. Initializers backed by a shared mapping must not be modified.
+// Option values:
+// - "0": each session maps the external data itself. [DEFAULT]
+// - "1": external data mappings are shared across sessions.
+static const char* const kOrtSessionOptionsShareExternalInitializerMappings =
+    "session.share_external_initializer_mappings";
+
+// Deserialize initializers and pre-pack constant initializers over the intra-op thread pool during session creation.
+// Each node is pre-packed on a single thread so kernels see their inputs pre-packed in order, and initializers that
+// need a copy to a non-CPU device are still deserialized sequentially.
+// Option values:
+// - "0": initializers are loaded and pre-packed sequentially. [DEFAULT]
+// - "1": initializers are loaded and pre-packed in parallel.
+static const char* const kOrtSessionOptionsLoadInitializersInParallel = "session.load_initializers_in_parallel";
+
+// In ORT_PARALLEL execution mode, run every node on the inter-op thread pool as soon as all of its producers have
+// completed, instead of executing the logic streams of the plan. Nodes made ready by a node continue on the same
+// thread and idle threads steal the rest. Only applies when all nodes of the graph are assigned to CPU.
+// Option values:
+// - "0": nodes are executed by logic stream. [DEFAULT]
+// - "1": nodes are scheduled dynamically.
+static const char* const kOrtSessionOptionsDynamicInterOpScheduling = "session.dynamic_inter_op_scheduling";
+
+// Gather concurrent Run/RunAsync calls whose inputs only differ in their first dimension into a single batched run,
+// and split the outputs back to the callers. The value is the maximum number of rows (sum of the first dimension of
+// the inputs) of a batched run. Only calls with CPU tensor inputs and no pre-allocated outputs are batched.
+// Option values:
+// - "0" or "1": calls are not batched. [DEFAULT]
+// - "N" > 1: calls are batched up to N rows.
+static const char* const kOrtSessionOptionsMicroBatchingMaxBatchSize = "session.micro_batching_max_batch_size";
+
+// Maximum time in microseconds a call waits for other calls to be batched with, when micro batching is enabled.
+// Default is "1000".
+static const char* const kOrtSessionOptionsMicroBatchingMaxDelayMicroseconds = "session.micro_batching_max_delay_us";
+
+// Maximum number of RunAsync calls of the session running at the same time on the intra-op thread pool. The other
+// calls wait in a queue of the session, and a thread finishing a run continues with the next one, instead of each
+// call taking a thread of the pool, or running on the calling thread once the queues of the pool are full.
+// This lets many requests in flight share a small pool, and leaves threads of the pool to the parallel loops of the
+// runs.
+// Option values:
+// - "0": the number of RunAsync calls running at the same time is not limited. [DEFAULT]
+// - "N" > 0: at most N calls run at the same time.
+static const char* const kOrtSessionOptionsRunAsyncMaxConcurrentRuns = "session.run_async_max_concurrent_runs";
+
+// Makes the session usable in processes forked after it was initialized, e.g. the workers of a pre-fork server that
+// loads the model in its master process, with the weights shared by the workers as copy-on-write pages:
+// - the initializers and the pre-packed weights are allocated outside of the memory arenas, so the pages holding
+//   them are not written by the runs,
+// - the thread pools used by the session get new threads in a forked process on its first run, as only the forking
+//   thread exists there. The global thread pools are recreated as well if all the sessions using them in the forked
+//   process set this option.
+// No run may be in progress when the process forks.
+// Option values:
+// - "0": disabled. [DEFAULT]
+// - "1": enabled.
+static const char* const kOrtSessionOptionsPreforkSafe = "session.prefork_safe";
+
+// Shrink the memory arenas of the session from a background thread, returning their free regions to the OS, when
+// no run is in progress and either no run ended for the given time, or the bytes reserved by an arena exceed the
+// given multiple of its bytes in use. The arenas are shrunk at most once between two runs, so unlike
+// kOrtRunOptionsConfigEnableMemoryArenaShrinkage the runs pay nothing while the load is steady. Only the regions
+// without any chunk in use are released, which the kSameAsRequested arena extend strategy makes more likely.
+// Not used with graph capture, whose replays need the captured memory.
+// Option values:
+// - "0": no idle timeout. [DEFAULT]
+// - "N" > 0: shrink the arenas after N milliseconds without runs.
+static const char* const kOrtSessionOptionsArenaTrimIdleTimeoutMs = "session.arena_trim_idle_timeout_ms";
+// Option values:
+// - "0": no ratio. [DEFAULT]
+// - a number > 0, e.g. "4": shrink an arena between runs when it reserves more than 4 times its bytes in use.
+static const char* const kOrtSessionOptionsArenaTrimMaxReservedRatio = "session.arena_trim_max_reserved_ratio";
+
+// Build a session specialized for the input shapes that dominate the runs. Once the same values of the symbolic
+// input dimensions were seen in N runs, and in more than half of all the runs, a second session with those dimensions
+// fixed as free dimension overrides is created from the model in the background. Its graph is optimized for the
+// static shapes, so shape computations are constant folded and memory patterns and kernels are planned for them.
+// Later runs with the same dimension values use it, all the other runs the session itself. Only applies to sessions
+// that only use the CPU execution provider and are loaded from an ONNX model.
+// Option values:
+// - "0": no specialized session is built. [DEFAULT]
+// - "N" > 0: the number of runs with the same dimension values before the specialized session is built.
+static const char* const kOrtSessionOptionsShapeSpecializationMinRuns = "session.shape_specialization_min_runs";
+
+// Share the large constant initializers of the session by content with the other sessions of the environment that
+// enable this option, such as the models of an ensemble that use the same embedding table. An initializer of at least
+// the given size that is only used by nodes assigned to the CPU execution provider is kept once per environment for
+// all the sessions with an initializer of the same data type, shape and content, and freed with the last of them. If
+// the session has no pre-packed weights container, the pre-packed forms of the shared initializers are shared through
+// a container of the environment.
+// Option values:
+// - "0": initializers are not shared. [DEFAULT]
+// - "N" > 0: initializers of at least N bytes are shared.
+static const char* const kOrtSessionOptionsShareInitializersMinBytes = "session.share_initializers_min_bytes";
+
+// Compacts the graph once the session is initialized, to reduce the memory of very large graphs. The lookups of the
+// producer and consumers of a value by name, which take several copies of each value name, are replaced with arrays of
+// node indexes sorted by value, and the doc strings of the nodes are released. The nodes themselves are kept as the
+// kernels use them.
+// Option values:
+// - "0": the graph is kept as it is. [DEFAULT]
+// - "1": the graph is compacted.
+static const char* const kOrtSessionOptionsCompactGraphAfterInitialization =
+    "session.compact_graph_after_initialization";
+
+// Parses a model loaded from a file in parallel over the intra-op thread pool. The file is memory mapped, and the
+// nodes and initializers of the main graph are parsed concurrently. The raw data of large initializers is referenced
+// in the mapping instead of being copied. Only applies to ONNX models loaded from a file path.
+// Option values:
+// - "0": the model is parsed sequentially. [DEFAULT]
+// - "1": the model is parsed in parallel.
+static const char* const kOrtSessionOptionsParallelModelParsing = "session.parallel_model_parsing";
+
+// Enables predictive output allocation for IOBinding objects created from the session.
+// Outputs bound only to a device are then allocated from a pool of buffers owned by the IOBinding. The IOBinding
+// remembers the output shapes of the last N runs for each set of input shapes and, before each run, prepares buffers
+// for the most likely output shapes. A buffer returns to the pool once the output value using it has been released,
+// so steady-state runs with the same input shapes do not allocate output buffers. Outputs that do not match a pooled
+// buffer are allocated as usual.
+// Option values:
+// - "0": disabled. [DEFAULT]
+// - "N" > 0: remember the output shapes of the last N runs per set of input shapes.
+static const char* const kOrtSessionOptionsIOBindingOutputPredictionHistory =
+    "session.io_binding_output_prediction_history";
+
+// Maximum number of idle execution frames a session keeps for reuse by later runs.
+// An execution frame holds the values of a run. A pooled frame is reset instead of rebuilt when a later run has the
+// same input shapes, and keeps the memory pattern buffers of its previous run. This reduces the per-run overhead for
+// small models. Frames are not pooled in builds with memory profiling enabled.
+// Option values:
+// - "0": frames are created for every run. [DEFAULT]
+// - "N" > 0: keep up to N idle frames.
+static const char* const kOrtSessionOptionsExecutionFramePoolSize = "session.execution_frame_pool_size";
+
+// Allocate the temporary buffers of the CPU kernels (OpKernelContext::GetTempSpaceAllocator) from a block per run
+// with a lock-free bump allocator, instead of from the arena. The block is reused from the start whenever all the
+// buffers allocated from it are freed, e.g. at the end of each node, and is sized from the largest amount of
+// scratch memory of the previous runs. The buffers that do not fit are allocated from the arena, so the first run
+// allocates all of them from the arena. The block is kept across runs by the pooled execution frames, see
+// kOrtSessionOptionsExecutionFramePoolSize.
+// Option values:
+// - "0": the temporary buffers are allocated from the arena. [DEFAULT]
+// - "1": the temporary buffers are allocated from a scratch block.
+static const char* const kOrtSessionOptionsUseScratchAllocator = "session.use_scratch_allocator";
+
+// Enables the always-on sampling profiler: the latency of every kernel of one run out of N is recorded in
+// per-node and per-op-type histograms, which can be queried at any time with SessionGetSampledLatencyStats.
+// Unlike enable_profiling, nothing is written to a file and the runs that are not sampled have no profiling overhead.
+// Only the nodes of the main graph are sampled.
+// Option values:
+// - "0": the sampling profiler is disabled. [DEFAULT]
+// - "N" > 0: sample one run out of N.
+static const char* const kOrtSessionOptionsSamplingProfilerInterval = "session.sampling_profiler_interval";
+
+// Records the hardware performance counters of the kernels in the node events of the profiler: cycles, instructions,
+// retired instructions per cycle, LLC misses, bytes read from memory (LLC read misses times the cache line size) and
+// data TLB misses, e.g. to compare kernels with and without kOrtSessionOptionsConfigUseLargePages.
+// The counters are summed over all the threads of the process, so they include the work of the intra-op thread pool.
+// The totals per op type are added as session events when profiling ends.
+// Only available on Linux, through perf_event_open, and when profiling is enabled.
+// Option values:
+// - "0": hardware counters are not recorded. [DEFAULT]
+// - "1": hardware counters are recorded.
+static const char* const kOrtSessionOptionsProfilingHardwareCounters = "session.profiling_hardware_counters";
+
+// Directory of a persistent cache of the capabilities returned by the execution providers during graph partitioning.
+// The capabilities of a provider for a graph are stored in a file named after a hash of the graph, the provider
+// type, the provider options and the ORT version, so that later sessions created for the same model skip the
+// GetCapability queries. Only the providers whose capabilities depend on nothing else are cached, see
+// IExecutionProvider::CanCacheCapabilities. Compiled partitions can be cached with the EP context model options
+// (kOrtSessionOptionEpContextEnable) or the engine caches of the providers.
+// Option values:
+// - "": capabilities are not cached. [DEFAULT]
+// - a directory path: the cache directory, created if it does not exist.
+static const char* const kOrtSessionOptionsPartitioningCacheDir = "session.partitioning_cache_dir";
+
+// Enable the TunableOp of the CPU execution provider. The CPU kernels that have tunable implementations, such as
+// the float MatMul which tunes the thread count and the split dimension of the SGEMM, use the tuning results that
+// were loaded with SetTuningResults or from the "tuning_results" model metadata. Tuning results are only valid on
+// the CPU model they were produced on.
+// Option values:
+// - "0": TunableOp is disabled. [DEFAULT]
+// - "1": TunableOp is enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Enable the online tuning of the CPU TunableOp. The problem sizes that have no tuning result are timed with every
+// candidate implementation the first time they run, and the fastest one is recorded. The results can be read
+// with GetTuningResults and saved, to be loaded by later sessions. Requires kOrtSessionOptionsCpuTunableOpEnable.
+// Option values:
+// - "0": tuning is disabled. [DEFAULT]
+// - "1": tuning is enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Maximum time in milliseconds spent tuning a single problem size of the CPU TunableOp.
+// Option values:
+// - "0": no limit. [DEFAULT]
+// - a positive integer: the limit in milliseconds.
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// The CPU RandomNormal, RandomUniform, RandomNormalLike, RandomUniformLike, Multinomial and Dropout kernels generate
+// their values with the counter-based Philox4x32-10 generator instead of std::default_random_engine. Each value is
+// derived from a counter reserved per call, so the values are generated in parallel on the intra-op thread pool,
+// concurrent runs do not serialize on a lock and the results do not depend on the number of threads. The values
+// differ from the ones generated with std::default_random_engine for the same seed.
+// Option values:
+// - "0": std::default_random_engine is used. [DEFAULT]
+// - "1": the counter-based generator is used.
+static const char* const kOrtSessionOptionsCpuRandomCounterBased = "session.cpu_random_counter_based";
+
+// A profile file written by an earlier run of the model with profiling enabled. The average kernel time recorded for
+// each node is used to run the nodes that are too short to benefit from the intra-op thread pool on a single thread,
+// which saves the cost of dispatching them to the pool. The nodes are matched by name, so the profile should come from
+// a session with the same graph optimization settings.
+// - "full path to file": there is no default for this option. A file that can not be read is ignored with a warning.
+static const char* const kOrtSessionOptionsProfileGuidedNodeTimingsFile = "session.profile_guided_node_timings_file";
+
+// The average kernel time in microseconds below which a node recorded in the profile of
+// kOrtSessionOptionsProfileGuidedNodeTimingsFile runs on a single thread.
+// Option values:
+// - a non-negative integer: the threshold in microseconds. The default is "20".
+static const char* const kOrtSessionOptionsProfileGuidedSingleThreadThresholdUs =
+    "session.profile_guided_single_thread_threshold_us";
+
+// Capture a graph per set of input shapes when the execution provider captures graphs, e.g. the CUDA EP with
+// enable_cuda_graph=1, instead of the single graph of the default annotation id. The runs without a graph annotation id
+// in their run options ("gpu_graph_id") are given one for their input and output shapes and addresses, so the first
+// run with a new set captures a graph and the later runs with the same set replay it. As a replay reads and writes the
+// addresses of the captured run, only runs with all outputs pre-allocated, e.g. bound with IOBinding, are captured,
+// and the other runs execute as usual. Inputs with many distinct shapes can be padded to a few bucket sizes by the
+// caller to bound the number of graphs, which the CUDA EP option max_num_cuda_graphs limits with LRU eviction.
+// Option values:
+// - "0": graphs are captured by annotation id only. [DEFAULT]
+// - "1": graphs are captured per set of input shapes.
+static const char* const kOrtSessionOptionsGraphCaptureByInputShapes = "session.graph_capture_by_input_shapes";
+
+// Run the model as a pipeline over several CUDA devices. The graph is split in topological order into one contiguous
+// stage per device, balanced by the size of the initializers and outputs of the nodes, and each stage runs in its own
+// session on its device with a CUDA execution provider created from the options of the one registered with the
+// session. The values passed between stages are copied from device to device, over peer access when the devices
+// support it. Every stage works on its own micro-batch or run, so concurrent runs and the micro-batches of
+// kOrtSessionOptionsPipelineNumMicroBatches overlap on the devices. Only applies to sessions that use the CUDA
+// execution provider alone and are loaded from an ONNX model. IOBinding and Clone are not supported by such sessions.
+// Option values:
+// - "": the session runs on the devices of its execution providers. [DEFAULT]
+// - a comma separated list of CUDA device ids, e.g. "0,1,2,3": the devices of the stages in order.
+static const char* const kOrtSessionOptionsPipelineDeviceIds = "session.pipeline_device_ids";
+
+// The number of micro-batches the runs of a pipelined session (see kOrtSessionOptionsPipelineDeviceIds) are split
+// into along the first dimension of their inputs. A run is only split when all its inputs are tensors with the same
+// first dimension, and its outputs are concatenated along their first dimension, so the model must be batch-major.
+// Option values:
+// - "1": runs are not split. [DEFAULT]
+// - "N" > 1: runs are split into up to N micro-batches.
+static const char* const kOrtSessionOptionsPipelineNumMicroBatches = "session.pipeline_num_micro_batches";
+
+// Records the hardware metrics of the GPU kernels of each node in its event of the profiler: the achieved occupancy,
+// SM efficiency, DRAM throughput and tensor core utilization, in percent of the peak and averaged over the kernels
+// weighted by their GPU time. The metrics per op type are added as session events when profiling ends.
+// The kernels are replayed to collect the metrics, so the nodes run much slower while profiling.
+// Only available with the CUDA execution provider built with ENABLE_CUDA_PROFILING and CUDA 12.6 or later, with the
+// permission to access the GPU performance counters, and when profiling is enabled.
+// Option values:
+// - "0": GPU kernel metrics are not recorded. [DEFAULT]
+// - "1": GPU kernel metrics are recorded.
+static const char* const kOrtSessionOptionsProfilingGpuKernelMetrics = "session.profiling_gpu_kernel_metrics";
+
+// A file of tuning results shared by the sessions and processes of a host, e.g. the TunableOp results of the CUDA and
+// ROCm execution providers. The file holds the results of every library and device combination that wrote to it, as
+// identified by the validators of the tuning results. When the session is created, the results that pass the
+// validation of its execution providers are loaded, as with SetTuningResults. When the session is released, the
+// results of the execution providers with tuning enabled are merged into the file, which is replaced atomically so
+// that concurrent readers never see a partially written file.
+// Option values:
+// - "": no tuning results file. [DEFAULT]
+// - "full path to file": the file is created on the first save if it does not exist.
+static const char* const kOrtSessionOptionsTuningResultsFile = "session.tuning_results_file";
+
+// Records a memory timeline in the profile when profiling is enabled. Each allocation and free of a tensor by the
+// execution frame is recorded as an event tagged with the node producing the tensor, along with a counter track of
+// the bytes allocated by the runs per device, so the nodes causing the peak can be found. Snapshots of the
+// fragmentation of the arenas used, i.e. the occupancy of their bins and their largest free chunk, are recorded at
+// the start of each run and every N allocations, to help right-size the arenas.
+// Option values:
+// - "0": no memory timeline. [DEFAULT]
+// - "N" > 0: record the memory timeline, with a snapshot of the arenas every N allocations.
+static const char* const kOrtSessionOptionsProfilingMemoryTimeline = "session.profiling_memory_timeline";
+
+// The time spent initializing the session is always recorded per phase, e.g. per graph transformer and per call of
+// GetCapability and Compile of each execution provider, see OrtApi::SessionGetInitializationStats. The time spent
+// loading and pre-packing initializers is only broken down for the initializers of at least this size in bytes.
+// Option values:
+// - "1048576": break down the initializers of 1 MiB or more. [DEFAULT]
+// - "N": break down the initializers of N bytes or more.
+static const char* const kOrtSessionOptionsInitializationStatsMinInitializerBytes =
+    "session.initialization_stats_min_initializer_bytes";
+
+// The memory budget in bytes of the prompt prefix cache of the GreedySearch and Sampling nodes on CPU. Each node
+// keeps the past state of the GPT decoder for the prompts of its previous runs, in blocks of 16 tokens, and a run
+// whose prompt starts with cached blocks (like a common system prompt) only runs the decoder on the remaining tokens.
+// The least recently used blocks are evicted beyond the budget. The cache is only used for runs with a batch size
+// and num_beams of 1, no padding in the prompt and without past_present_share_buffer or a draft decoder.
+// Option values:
+// - "0": no prefix cache. [DEFAULT]
+// - "N" > 0: cache up to N bytes of past state per node.
+static const char* const kOrtSessionOptionsGenerationPrefixCacheBytes = "session.generation_prefix_cache_bytes";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // Specify the type of workload for this session.
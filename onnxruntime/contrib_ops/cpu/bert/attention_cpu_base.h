@@ -39,7 +39,8 @@ class AttentionCPUBase : public AttentionBase {
                         const Tensor* attn_bias,   // additive bias applied on scaled QK.
                         OpKernelContext* context,
                         int past_sequence_length = 0,  // sequence length of past state
-                        bool past_present_share_buffer = false) const {
+                        bool past_present_share_buffer = false,
+                        int kv_beam_width = 1) const {  // number of beams that share each K and V (B / W x N x L x H)
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
@@ -58,9 +59,11 @@ class AttentionCPUBase : public AttentionBase {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
     // Merge causal mask with padding mask, and convert values from 0/1 to -inf/0, then broadcast to 3D (BxSxT).
+    // Without padding mask, the softmax applies the causal mask unless the scaled Q*K' is output with the mask.
     bool causal = (is_unidirectional_ && sequence_length > 1);
+    const bool softmax_causal = causal && mask_index == nullptr && output_qk == nullptr;
     void* mask_data = nullptr;
-    if (mask_index != nullptr || causal) {
+    if (mask_index != nullptr || (causal && !softmax_causal)) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
       mask_data = allocator->Alloc(mask_data_bytes);
       memset(mask_data, 0, mask_data_bytes);
@@ -110,7 +113,7 @@ class AttentionCPUBase : public AttentionBase {
                              batch_size, sequence_length, kv_sequence_length, past_sequence_length,
                              qk_head_size == 0 ? v_head_size : qk_head_size, past_data, past_key_data, present_data,
                              present_key_data, output_qk_data, tp, scale, attn_bias_data, attn_bias_dims,
-                             past_present_share_buffer, max_sequence_length);
+                             softmax_causal, past_present_share_buffer, max_sequence_length, kv_beam_width);
 
     // Compute the attentionScore * Value: out_tmp(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
     auto out_tmp_data =
@@ -120,7 +123,7 @@ class AttentionCPUBase : public AttentionBase {
     ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs),
                             V, batch_size, sequence_length, kv_sequence_length, past_sequence_length, v_head_size,
                             v_hidden_size, past_data, past_value_data, present_data, present_value_data, tp,
-                            past_present_share_buffer, max_sequence_length);
+                            past_present_share_buffer, max_sequence_length, kv_beam_width);
 
     return Status::OK();
   }
@@ -189,6 +192,8 @@ class AttentionCPUBase : public AttentionBase {
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
+  // Unless the scaled Q*K' is an output, the softmax of each head adds the bias and the mask right after its
+  // GEMM, while the scores are still in the cache.
   template <typename T>
   void ComputeAttentionProbs(T* attention_probs,                       // output buffer with size BxNxSxT
                              const T* Q,                               // Q data. Its size is BxNxSxH
@@ -208,8 +213,10 @@ class AttentionCPUBase : public AttentionBase {
                              float scale,                              // scale factor
                              const T* attn_bias_data,                  // attention bias
                              gsl::span<const int64_t> attn_bias_dims,  // attention bias shape
+                             bool causal,                              // apply the causal mask in the softmax
                              bool past_present_share_buffer = false,
-                             int max_sequence_length = 0) const {
+                             int max_sequence_length = 0,
+                             int kv_beam_width = 1) const {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;               // T = P + L
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;    // P x H
     const size_t q_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
@@ -222,6 +229,8 @@ class AttentionCPUBase : public AttentionBase {
     DUMP_CPU_TENSOR("K", K, batch_size, num_heads_, total_sequence_length, head_size);
     DUMP_CPU_TENSOR("Attn_Bias", attn_bias_data, attn_bias_dims);
 
+    const bool fused_softmax = output_qk == nullptr;
+
     {
       const int loop_len = batch_size * num_heads_;
       const float alpha = scale;
@@ -236,7 +245,7 @@ class AttentionCPUBase : public AttentionBase {
 
       if (mask_data != nullptr) {
         unit_cost.bytes_loaded += static_cast<double>(probs_matrix_bytes);
-        unit_cost.bytes_stored += static_cast<double>(probs_matrix_bytes);
+        unit_cost.bytes_stored += fused_softmax ? 0.0 : static_cast<double>(probs_matrix_bytes);
       }
 
       if (present || present_key) {
@@ -248,8 +257,13 @@ class AttentionCPUBase : public AttentionBase {
 
       if (attn_bias_data != nullptr) {
         unit_cost.compute_cycles += static_cast<double>(probs_matrix_size);
-        unit_cost.bytes_loaded += probs_matrix_bytes * 2;
-        unit_cost.bytes_stored += probs_matrix_bytes;
+        unit_cost.bytes_loaded += fused_softmax ? probs_matrix_bytes : probs_matrix_bytes * 2;
+        unit_cost.bytes_stored += fused_softmax ? 0 : probs_matrix_bytes;
+      }
+
+      if (fused_softmax) {
+        // Exponential and normalization of the probabilities.
+        unit_cost.compute_cycles += static_cast<double>(SafeInt<ptrdiff_t>(8) * probs_matrix_size);
       }
 
       ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
@@ -262,17 +276,19 @@ class AttentionCPUBase : public AttentionBase {
 
           T* output = attention_probs + output_offset;
 
+          // Attention bias has shape (B or 1, N or 1, S, T)
+          // Here we handle the broadcast of batch_size and num_heads dimensions.
+          ptrdiff_t attn_bias_offset = 0;
           if (attn_bias_data != nullptr) {
-            // Attention bias has shape (B or 1, N or 1, S, T)
-            // Here we handle the broadcast of batch_size and num_heads dimensions.
-            ptrdiff_t attn_bias_offset = 0;
             if (attn_bias_dims[0] != 1) {
               attn_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attn_bias_dims[1] * probs_matrix_size;
             }
             if (attn_bias_dims[1] != 1) {
               attn_bias_offset += head_index * probs_matrix_size;
             }
+          }
 
+          if (!fused_softmax && attn_bias_data != nullptr) {
             memcpy(output, attn_bias_data + attn_bias_offset, probs_matrix_bytes);
 
             if (mask_data != nullptr) {
@@ -281,12 +297,14 @@ class AttentionCPUBase : public AttentionBase {
                 output[j] += mask_data[mask_offset + j];
               }
             }
-          } else if (mask_data != nullptr) {
+          } else if (!fused_softmax && mask_data != nullptr) {
             // Broadcast mask data: (Bx)SxT -> (BxNx)SxT
             memcpy(output, mask_data + mask_offset, probs_matrix_bytes);
           }
 
-          const T* k = K + kv_input_chunk_length * i;
+          // The beams of a batch share K when it is not expanded for beam search.
+          const std::ptrdiff_t kv_index = (batch_index / kv_beam_width) * num_heads_ + head_index;
+          const T* k = K + kv_input_chunk_length * kv_index;
           if (nullptr != present) {
             // Concatenate past_K and K : (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
             k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
@@ -306,12 +324,28 @@ class AttentionCPUBase : public AttentionBase {
           // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
           math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_sequence_length, head_size, alpha,
                                     Q + q_input_chunk_length * i, k,
-                                    (mask_data != nullptr || attn_bias_data != nullptr) ? 1.0f : 0.0f,
+                                    (!fused_softmax && (mask_data != nullptr || attn_bias_data != nullptr)) ? 1.0f : 0.0f,
                                     output, nullptr);
+
+          if (fused_softmax) {
+            // attention_probs(S, T) = Softmax(attention_probs + attn_bias + mask_data) with the causal mask if any.
+            MLAS_ATTENTION_SOFTMAX_PARAMS<T> softmax_params;
+            softmax_params.Bias = attn_bias_data != nullptr ? attn_bias_data + attn_bias_offset : nullptr;
+            softmax_params.Mask = mask_data != nullptr ? mask_data + mask_offset : nullptr;
+            softmax_params.Causal = causal;
+            softmax_params.CausalOffset = static_cast<size_t>(past_sequence_length);
+            MlasComputeAttentionSoftmax(output, output, static_cast<size_t>(sequence_length),
+                                        static_cast<size_t>(total_sequence_length), softmax_params, nullptr);
+          }
         }
       });
     }
 
+    if (fused_softmax) {
+      DUMP_CPU_TENSOR("Softmax(QK)", attention_probs, batch_size, num_heads_, sequence_length, total_sequence_length);
+      return;
+    }
+
     if (output_qk != nullptr) {
       // Output the scaled Q*K^T if needed.
       memcpy(output_qk, attention_probs,
@@ -347,7 +381,8 @@ class AttentionCPUBase : public AttentionBase {
                                T* present_value,          // present value only (if not using present state)
                                ThreadPool* tp,
                                bool past_present_share_buffer = false,
-                               int max_sequence_length = 0) const {
+                               int max_sequence_length = 0,
+                               int kv_beam_width = 1) const {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;                   // T = P + L
     const ptrdiff_t past_chunk_length = SafeInt<ptrdiff_t>(past_sequence_length) * v_head_size;    // P x H_v
     const ptrdiff_t q_input_chunk_length = SafeInt<ptrdiff_t>(sequence_length) * v_head_size;      // S x H_v
@@ -386,7 +421,12 @@ class AttentionCPUBase : public AttentionBase {
     ThreadPool::TryParallelFor(
         tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
           for (std::ptrdiff_t i = begin; i != end; ++i) {
-            const T* v = V + kv_input_chunk_length * i;
+            const int batch_index = static_cast<int>(i / num_heads_);
+            const int head_index = static_cast<int>(i % num_heads_);
+
+            // The beams of a batch share V when it is not expanded for beam search.
+            const std::ptrdiff_t kv_index = (batch_index / kv_beam_width) * num_heads_ + head_index;
+            const T* v = V + kv_input_chunk_length * kv_index;
             if (nullptr != present) {
               // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
               v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
@@ -405,8 +445,6 @@ class AttentionCPUBase : public AttentionBase {
                             attention_probs + attention_probs_offset, v, current_tmp_data, nullptr);
 
             // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
-            const int batch_index = static_cast<int>(i / num_heads_);
-            const int head_index = static_cast<int>(i % num_heads_);
             T* src = current_tmp_data;
             ptrdiff_t dest_offset =
                 (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
@@ -85,7 +85,8 @@ Status DecoderMaskedMultiHeadAttention<T>::Compute(OpKernelContext* context) con
                                                                       scale_,
                                                                       is_unidirectional,
                                                                       past_present_share_buffer_,
-                                                                      kDecoderMaskedMultiHeadAttention));
+                                                                      kDecoderMaskedMultiHeadAttention,
+                                                                      true /* allow_kv_shared_by_beams */));
 
   int batch_size = parameters.batch_size;
   int sequence_length = parameters.sequence_length;
@@ -187,12 +188,15 @@ Status DecoderMaskedMultiHeadAttention<T>::Compute(OpKernelContext* context) con
 
   // Cross-attention case
   if (parameters.is_cross_attention) {
+    // Key and value are shared by the beams of a batch when they are not expanded for beam search.
+    const int kv_beam_width = batch_size / static_cast<int>(key->Shape()[0]);
     return ApplyAttention(Q.GetMutable<Tensor>()->MutableData<T>(),
                           key->Data<T>(),
                           value->Data<T>(),
                           mask_index, nullptr /* past */, past_key, past_value, output, present_key, present_value, output_qk,
                           batch_size, 1 /* sequence_length */, parameters.kv_sequence_length,
-                          head_size, v_head_size, v_hidden_size, attention_bias, context);
+                          head_size, v_head_size, v_hidden_size, attention_bias, context,
+                          0 /* past_sequence_length */, false /* past_present_share_buffer */, kv_beam_width);
   }
 
   OrtValue K, V;
@@ -60,7 +60,9 @@ class GQAAttentionBase {
                         const Tensor* seqlens_k,                    // past sequence lengths tensor
                         GroupQueryAttentionParameters& parameters,  // attention parameters
                         AllocatorPtr allocator,                     // allocator for temporary tensors
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,                   // kernel context
+                        const Tensor* block_table = nullptr,        // block table of the paged KV cache (if any)
+                        bool present_kv_updated = false) const {    // whether K and V are already in present KV
     const bool is_prompt = parameters.is_first_prompt;
     const int batch_size = parameters.batch_size;
     const int sequence_length = parameters.sequence_length;
@@ -76,14 +78,6 @@ class GQAAttentionBase {
     }
     int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
 
-    // Compute the attention score.
-    bool gqa_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
-                              MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache *
-                   (gqa_mlas_supported ? sizeof(T) : sizeof(float));
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
     const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
     T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
     const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
@@ -95,39 +89,382 @@ class GQAAttentionBase {
     bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
 
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    // With a paged KV cache, present_key and present_value are the updated page pools. The new tokens are written
+    // into the pages of their sequence, and K/V of each sequence are gathered into a contiguous scratch buffer that
+    // is only as long as the longest sequence in the batch, so the attention below runs as with a shared buffer.
+    BufferUniquePtr paged_key_buffer;
+    BufferUniquePtr paged_value_buffer;
+    if (block_table != nullptr) {
+      const size_t block_size = static_cast<size_t>(seqlen_present_kv_cache);
+      const size_t pool_bytes = SafeInt<size_t>(present_key->SizeInBytes());
+      if (!past_present_share_buffer) {
+        memcpy(present_key_data, past_key_data, pool_bytes);
+        memcpy(present_value_data, past_value_data, pool_bytes);
+      }
+
+      seqlen_present_kv_cache = parameters.total_sequence_length;
+      seqlen_past_kv_cache = seqlen_present_kv_cache;
+      const size_t gathered_bytes =
+          SafeInt<size_t>(batch_size) * kv_num_heads_ * seqlen_present_kv_cache * head_size * sizeof(T);
+      paged_key_buffer = BufferUniquePtr(allocator->Alloc(gathered_bytes), BufferDeleter(allocator));
+      paged_value_buffer = BufferUniquePtr(allocator->Alloc(gathered_bytes), BufferDeleter(allocator));
+
+      const size_t max_blocks_per_sequence = static_cast<size_t>(block_table->Shape()[1]);
+      UpdatePagedKVCache(present_key_data, static_cast<T*>(paged_key_buffer.get()), k, block_table->Data<int32_t>(),
+                         seqlens_k->Data<int32_t>(), batch_size, sequence_length, max_blocks_per_sequence, block_size,
+                         seqlen_present_kv_cache, head_size, packed_qkv, is_prompt, tp);
+      UpdatePagedKVCache(present_value_data, static_cast<T*>(paged_value_buffer.get()), v,
+                         block_table->Data<int32_t>(), seqlens_k->Data<int32_t>(), batch_size, sequence_length,
+                         max_blocks_per_sequence, block_size, seqlen_present_kv_cache, head_size, packed_qkv,
+                         is_prompt, tp);
+
+      present_key_data = static_cast<T*>(paged_key_buffer.get());
+      present_value_data = static_cast<T*>(paged_value_buffer.get());
+      past_key_data = present_key_data;
+      past_value_data = present_value_data;
+      past_present_share_buffer = true;
+    }
+
+    // Compute the attention score.
+    bool gqa_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
+                              MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache *
+                   (gqa_mlas_supported ? sizeof(T) : sizeof(float));
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
     if (gqa_mlas_supported) {
       ComputeAttentionProbs(static_cast<T*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), attention_bias_data,
                             batch_size, sequence_length, attention_bias_shape, seqlen_past_kv_cache, seqlen_present_kv_cache,
                             head_size, past_key_data, present_key_data, past_present_share_buffer, packed_qkv, is_prompt,
-                            tp, allocator);
+                            present_kv_updated, tp, allocator);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
                               hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                              is_prompt, tp, allocator);
+                              is_prompt, present_kv_updated, tp, allocator);
     } else {
       ComputeAttentionProbs(static_cast<float*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), attention_bias_data,
                             batch_size, sequence_length, attention_bias_shape, seqlen_past_kv_cache, seqlen_present_kv_cache,
                             head_size, past_key_data, present_key_data, past_present_share_buffer, packed_qkv, is_prompt,
-                            tp, allocator);
+                            present_kv_updated, tp, allocator);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<float*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
                               hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                              is_prompt, tp, allocator);
+                              is_prompt, present_kv_updated, tp, allocator);
     }
 
     return Status::OK();
   }
 
+  // Attention with an int8 KV cache. Every token of a kv head is quantized symmetrically in blocks of channels with
+  // one float scale per block, and K and V are dequantized while Q x K' and the probs x V are accumulated, so decoding
+  // reads a quarter of the bytes of a float KV cache.
+  Status ApplyQuantizedKVAttention(const float* Q,                             // Q data with shape BxNxSxH
+                                   const float* K,                             // K data with shape BxN_kvxSxH
+                                   const float* V,                             // V data with shape BxN_kvxSxH
+                                   const Tensor* attention_bias,               // Attention bias to add to QxK'
+                                   const Tensor* past_key,                     // int8 past K input tensor
+                                   const Tensor* past_value,                   // int8 past V input tensor
+                                   const Tensor* past_key_scale,               // scales of past K
+                                   const Tensor* past_value_scale,             // scales of past V
+                                   Tensor* output,                             // output tensor
+                                   Tensor* present_key,                        // int8 present K output tensor
+                                   Tensor* present_value,                      // int8 present V output tensor
+                                   Tensor* present_key_scale,                  // scales of present K
+                                   Tensor* present_value_scale,                // scales of present V
+                                   const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                   GroupQueryAttentionParameters& parameters,  // attention parameters
+                                   AllocatorPtr allocator,                     // allocator for temporary tensors
+                                   OpKernelContext* context) const {           // kernel context
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const size_t past_buffer_sequence_length = static_cast<size_t>(past_key->Shape()[2]);
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape()[2]);
+    const size_t num_scale_blocks = static_cast<size_t>(present_key_scale->Shape()[3]);
+    const size_t quant_block_size = head_size / num_scale_blocks;
+
+    const float* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const float* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    // Quantize the new tokens into the cache before any head of Q reads it.
+    int8_t* present_key_data = present_key->MutableData<int8_t>();
+    int8_t* present_value_data = present_value->MutableData<int8_t>();
+    float* present_key_scale_data = present_key_scale->MutableData<float>();
+    float* present_value_scale_data = present_value_scale->MutableData<float>();
+    UpdateQuantizedKVCache(past_key->Data<int8_t>(), past_key_scale->Data<float>(), present_key_data,
+                           present_key_scale_data, k, seqlens_k_data, batch_size, sequence_length,
+                           past_buffer_sequence_length, present_buffer_sequence_length, head_size, quant_block_size,
+                           packed_qkv, is_prompt, tp);
+    UpdateQuantizedKVCache(past_value->Data<int8_t>(), past_value_scale->Data<float>(), present_value_data,
+                           present_value_scale_data, v, seqlens_k_data, batch_size, sequence_length,
+                           past_buffer_sequence_length, present_buffer_sequence_length, head_size, quant_block_size,
+                           packed_qkv, is_prompt, tp);
+
+    const float* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<float>() : nullptr;
+    auto attention_bias_shape =
+        attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * present_buffer_sequence_length *
+                   sizeof(float);
+    auto attention_probs = static_cast<float*>(allocator->Alloc(bytes));
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+    float* output_data = output->MutableData<float>();
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = sequence_length * head_size;                      // S x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+    const size_t present_scale_chunk_length = present_buffer_sequence_length * num_scale_blocks;
+    const size_t loop_len = batch_size * num_heads_;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(2) * present_buffer_sequence_length *
+                                                 (head_size + num_scale_blocks * sizeof(float)));
+    unit_cost.bytes_loaded += static_cast<double>(sequence_length * head_size * sizeof(float));
+    unit_cost.bytes_stored =
+        static_cast<double>(sequence_length * (present_buffer_sequence_length + head_size) * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / num_heads_;
+        const size_t head_index = i % num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+        const size_t kv_index = i / kv_num_heads_factor;
+
+        const int8_t* k_cache = present_key_data + kv_index * present_buff_chunk_length;
+        const float* k_scale = present_key_scale_data + kv_index * present_scale_chunk_length;
+        const int8_t* v_cache = present_value_data + kv_index * present_buff_chunk_length;
+        const float* v_scale = present_value_scale_data + kv_index * present_scale_chunk_length;
+
+        const float* q;
+        if (packed_qkv) {
+          q = Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index;
+        } else {
+          q = Q + q_input_chunk_length * i;
+        }
+
+        // Q x K' of the causal tokens of each row. The scale of each block is applied to its partial dot product.
+        float* probs = attention_probs + SafeInt<ptrdiff_t>(i) * sequence_length * present_buffer_sequence_length;
+        for (size_t seq = 0; seq < sequence_length; seq++) {
+          const float* q_row = q + seq * head_size;
+          float* scores = probs + seq * present_buffer_sequence_length;
+          const size_t seq_causal_length = past_seqlen + seq + 1;
+          for (size_t j = 0; j < seq_causal_length; j++) {
+            const int8_t* k_row = k_cache + j * head_size;
+            const float* k_row_scale = k_scale + j * num_scale_blocks;
+            float score = 0.0f;
+            for (size_t blk = 0; blk < num_scale_blocks; blk++) {
+              const size_t offset = blk * quant_block_size;
+              float dot = 0.0f;
+              for (size_t c = 0; c < quant_block_size; c++) {
+                dot += q_row[offset + c] * static_cast<float>(k_row[offset + c]);
+              }
+              score += dot * k_row_scale[blk];
+            }
+            scores[j] = alpha * score;
+          }
+        }
+
+        ptrdiff_t attention_total_seqlen = 0;
+        const float* attention_bias_thread = GetAttentionBiasOfHead(attention_bias_data, attention_bias_shape,
+                                                                    batch_index, head_index, sequence_length,
+                                                                    attention_total_seqlen);
+        ComputeAttentionSoftmaxRows(probs, attention_bias_thread, attention_total_seqlen, sequence_length, past_seqlen,
+                                    total_seqlen, present_buffer_sequence_length, allocator);
+
+        // probs x V, where the probs of a token are scaled by the scale of each block of V once.
+        float* output_current = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+        for (size_t seq = 0; seq < sequence_length; seq++) {
+          const float* probs_row = probs + seq * present_buffer_sequence_length;
+          float* output_row = output_current + seq * hidden_size;
+          std::fill_n(output_row, head_size, 0.0f);
+          const size_t seq_causal_length = past_seqlen + seq + 1;
+          for (size_t j = 0; j < seq_causal_length; j++) {
+            const float prob = probs_row[j];
+            if (prob == 0.0f) {
+              continue;
+            }
+            const int8_t* v_row = v_cache + j * head_size;
+            const float* v_row_scale = v_scale + j * num_scale_blocks;
+            for (size_t blk = 0; blk < num_scale_blocks; blk++) {
+              const size_t offset = blk * quant_block_size;
+              const float weight = prob * v_row_scale[blk];
+              for (size_t c = 0; c < quant_block_size; c++) {
+                output_row[offset + c] += weight * static_cast<float>(v_row[offset + c]);
+              }
+            }
+          }
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
  private:
+  // Helper function for the int8 KV cache. For every (batch, kv head) pair it copies the past tokens to present unless
+  // they share the buffer, and quantizes the new tokens of `chunk` behind them with one scale per block of channels.
+  void UpdateQuantizedKVCache(const int8_t* past,                           // past K or V with size BxN_kvxLxH
+                              const float* past_scale,                      // scales of past with size BxN_kvxLxC
+                              int8_t* present,                              // present K or V with size BxN_kvxTxH
+                              float* present_scale,                         // scales of present with size BxN_kvxTxC
+                              const float* chunk,                           // new K or V data in BNSH (or packed QKV)
+                              const int32_t* seqlens_k,                     // total - 1 sequence lengths tensor
+                              const size_t batch_size,                      // batch size
+                              const size_t sequence_length,                 // sequence length of new tokens (S)
+                              const size_t past_buffer_sequence_length,     // sequence length of past state (L)
+                              const size_t present_buffer_sequence_length,  // sequence length of present state (T)
+                              const size_t head_size,                       // head size of K and V
+                              const size_t quant_block_size,                // number of channels per scale
+                              const bool packed_qkv,                        // whether Q, K, V are packed
+                              const bool is_prompt,                         // whether it is prompt
+                              ThreadPool* tp) const {
+    const size_t num_scale_blocks = head_size / quant_block_size;
+    const size_t chunk_batch_stride =
+        SafeInt<size_t>(packed_qkv ? num_heads_ + 2 * kv_num_heads_ : kv_num_heads_) * sequence_length * head_size;
+    const size_t loop_len = batch_size * kv_num_heads_;
+    const bool copy_past = past != present;
+    const bool copy_past_scale = past_scale != present_scale;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(3) * sequence_length * head_size);
+    unit_cost.bytes_loaded = static_cast<double>(sequence_length * head_size * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(sequence_length * (head_size + num_scale_blocks * sizeof(float)));
+    if (copy_past) {
+      const double bytes_to_copy = static_cast<double>(past_buffer_sequence_length *
+                                                       (head_size + num_scale_blocks * sizeof(float)));
+      unit_cost.bytes_loaded += bytes_to_copy;
+      unit_cost.bytes_stored += bytes_to_copy;
+    }
+
+    ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+        int8_t* dst = present + SafeInt<size_t>(i) * present_buffer_sequence_length * head_size;
+        float* dst_scale = present_scale + SafeInt<size_t>(i) * present_buffer_sequence_length * num_scale_blocks;
+        if (copy_past && past_seqlen > 0) {
+          memcpy(dst, past + SafeInt<size_t>(i) * past_buffer_sequence_length * head_size, past_seqlen * head_size);
+        }
+        if (copy_past_scale && past_seqlen > 0) {
+          memcpy(dst_scale, past_scale + SafeInt<size_t>(i) * past_buffer_sequence_length * num_scale_blocks,
+                 past_seqlen * num_scale_blocks * sizeof(float));
+        }
+
+        const float* src = chunk + batch_index * chunk_batch_stride + head_index * sequence_length * head_size;
+        for (size_t s = 0; s < sequence_length; s++) {
+          for (size_t blk = 0; blk < num_scale_blocks; blk++) {
+            const float* x = src + s * head_size + blk * quant_block_size;
+            float min_value = 0.0f;
+            float max_value = 0.0f;
+            MlasFindMinMaxElement(x, &min_value, &max_value, quant_block_size);
+            const float scale = std::max(std::abs(min_value), std::abs(max_value)) / 127.0f;
+            dst_scale[(past_seqlen + s) * num_scale_blocks + blk] = scale;
+            MlasQuantizeLinear<int8_t>(x, dst + (past_seqlen + s) * head_size + blk * quant_block_size,
+                                       quant_block_size, scale == 0.0f ? 1.0f : scale, 0);
+          }
+        }
+
+        // Keep the unused tail of a separate present buffer deterministic.
+        const size_t used_seqlen = past_seqlen + sequence_length;
+        if (copy_past && used_seqlen < present_buffer_sequence_length) {
+          memset(dst + used_seqlen * head_size, 0, (present_buffer_sequence_length - used_seqlen) * head_size);
+        }
+        if (copy_past_scale && used_seqlen < present_buffer_sequence_length) {
+          memset(dst_scale + used_seqlen * num_scale_blocks, 0,
+                 (present_buffer_sequence_length - used_seqlen) * num_scale_blocks * sizeof(float));
+        }
+      }
+    });
+  }
+
+  // Helper function for the paged KV cache. For every (batch, kv head) pair it copies the past tokens of the sequence
+  // from the page pool into `gathered` (BxN_kvxTxH), and writes the new tokens of `chunk` into the pages of the
+  // sequence. The new tokens are appended to `gathered` later by ConcatStateChunkGQA.
+  template <typename T>
+  void UpdatePagedKVCache(T* pages,                                     // page pool with size num_blocks x N_kv x block_size x H
+                          T* gathered,                                  // gathered K or V with size BxN_kvxTxH
+                          const T* chunk,                               // new K or V data in BNSH (or packed QKV)
+                          const int32_t* block_table,                   // block table with size B x max_blocks_per_sequence
+                          const int32_t* seqlens_k,                     // total - 1 sequence lengths tensor
+                          const size_t batch_size,                      // batch size
+                          const size_t sequence_length,                 // sequence length of new tokens (S)
+                          const size_t max_blocks_per_sequence,         // number of logical blocks per sequence
+                          const size_t block_size,                      // number of tokens per page
+                          const size_t present_buffer_sequence_length,  // sequence length of gathered buffer (T)
+                          const size_t head_size,                       // head size of K and V
+                          const bool packed_qkv,                        // whether Q, K, V are packed
+                          const bool is_prompt,                         // whether it is prompt
+                          ThreadPool* tp) const {
+    const size_t chunk_batch_stride =
+        SafeInt<size_t>(packed_qkv ? num_heads_ + 2 * kv_num_heads_ : kv_num_heads_) * sequence_length * head_size;
+    const size_t page_stride = SafeInt<size_t>(kv_num_heads_) * block_size * head_size;
+    const size_t loop_len = batch_size * kv_num_heads_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = 0;
+    unit_cost.bytes_loaded = static_cast<double>(present_buffer_sequence_length * head_size * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>((present_buffer_sequence_length + sequence_length) * head_size *
+                                                 sizeof(T));
+
+    ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+        const size_t new_seqlen = std::min(sequence_length, total_seqlen - past_seqlen);
+        const int32_t* blocks = block_table + batch_index * max_blocks_per_sequence;
+
+        // Gather the past tokens one page at a time.
+        T* dst = gathered + SafeInt<size_t>(i) * present_buffer_sequence_length * head_size;
+        for (size_t token = 0; token < past_seqlen;) {
+          const size_t offset = token % block_size;
+          const size_t count = std::min(block_size - offset, past_seqlen - token);
+          const T* src = pages + blocks[token / block_size] * page_stride + (head_index * block_size + offset) * head_size;
+          memcpy(dst + token * head_size, src, count * head_size * sizeof(T));
+          token += count;
+        }
+
+        // Append the new tokens to the pages of this sequence.
+        const T* src = chunk + batch_index * chunk_batch_stride + head_index * sequence_length * head_size;
+        for (size_t s = 0; s < new_seqlen;) {
+          const size_t token = past_seqlen + s;
+          const size_t offset = token % block_size;
+          const size_t count = std::min(block_size - offset, new_seqlen - s);
+          T* page = pages + blocks[token / block_size] * page_stride + (head_index * block_size + offset) * head_size;
+          memcpy(page, src + s * head_size, count * head_size * sizeof(T));
+          s += count;
+        }
+      }
+    });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -149,6 +486,7 @@ class GQAAttentionBase {
                              const bool past_present_share_buffer,                 // whether present key and value share the same buffer
                              const bool packed_qkv,                                // whether Q, K, V are packed
                              const bool is_prompt,                                 // whether it is prompt
+                             const bool present_kv_updated,                        // whether K is already in present
                              ThreadPool* tp,                                       // thread pool
                              AllocatorPtr allocator) const {                       // allocator for temporary buffer
     const ptrdiff_t packed_batch_stride =
@@ -160,7 +498,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
     const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && !present_kv_updated) {
       memset((void*)present_key,
              0,
              batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
@@ -198,34 +536,24 @@ class GQAAttentionBase {
         const ptrdiff_t output_offset = SafeInt<ptrdiff_t>(i) * sequence_length * present_buffer_sequence_length;
         U* output = attention_probs + output_offset;
 
-        // Compute attention bias offset based on the batch and head indexes
-        // Attention bias is of shape (B or 1, H or 1, S, T) so handle broadcasting
-        const T* attention_bias_thread = nullptr;
         ptrdiff_t attention_total_seqlen = 0;
-        if (attention_bias != nullptr) {
-          ptrdiff_t attention_bias_offset = 0;
-          attention_total_seqlen = static_cast<ptrdiff_t>(attention_bias_shape[3]);
-          const ptrdiff_t attention_matrix_size = sequence_length * attention_total_seqlen;
-          if (attention_bias_shape[0] != 1) {
-            attention_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attention_bias_shape[1] * attention_matrix_size;
-          }
-          if (attention_bias_shape[1] != 1) {
-            attention_bias_offset += SafeInt<ptrdiff_t>(head_index) * attention_matrix_size;
-          }
-
-          attention_bias_thread = attention_bias + attention_bias_offset;
-        }
+        const T* attention_bias_thread = GetAttentionBiasOfHead(attention_bias, attention_bias_shape, batch_index,
+                                                                head_index, sequence_length, attention_total_seqlen);
 
         const T* k;
-        if (packed_qkv) {
-          k = K + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
+        if (present_kv_updated) {
+          k = present_key + present_buff_chunk_length * (i / kv_num_heads_factor);
         } else {
-          k = K + kv_input_chunk_length * (i / kv_num_heads_factor);
-        }
-        if (nullptr != present_key) {
-          k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
-                                  past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                  i / kv_num_heads_factor);
+          if (packed_qkv) {
+            k = K + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
+          } else {
+            k = K + kv_input_chunk_length * (i / kv_num_heads_factor);
+          }
+          if (nullptr != present_key) {
+            k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
+                                    past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
+                                    i / kv_num_heads_factor);
+          }
         }
 
         // Compute Q*K' + AttentionMask
@@ -266,73 +594,114 @@ class GQAAttentionBase {
         }
 
         // compute Softmax
-        U* output_softmax = output;
-        for (size_t seq = 0; seq < sequence_length; seq++) {
-          size_t seq_causal_length = past_seqlen + seq + 1;
-
-          // local_window_size does not include the current query token, while window_size includes it.
-          const bool should_apply_local_window = local_window_size_ >= 0 &&
-                                                 seq_causal_length > static_cast<size_t>(local_window_size_) + 1;
-
-          const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ - 1 : 0;
-          const size_t window_size = should_apply_local_window ? local_window_size_ + 1 : seq_causal_length;
-
-          // Mask everything before local window, if local window should be applied
-          if (should_apply_local_window) {
-            for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
-              if constexpr (std::is_same<U, float>::value) {
-                output_softmax[total_seq_id] = 0.f;
-              } else {
-                output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
-              }
-            }
-          }
+        ComputeAttentionSoftmaxRows(output, attention_bias_thread, attention_total_seqlen, sequence_length, past_seqlen,
+                                    total_seqlen, present_buffer_sequence_length, allocator);
+      }
+    });
+  }
 
-          if (softcap_ > 0.f) {
-            ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
-                                           static_cast<U>(softcap_));
-          }
+  // Helper function to compute attention bias offset based on the batch and head indexes.
+  // Attention bias is of shape (B or 1, H or 1, S, T) so handle broadcasting.
+  template <typename T>
+  static const T* GetAttentionBiasOfHead(const T* attention_bias,
+                                         const gsl::span<const int64_t> attention_bias_shape,
+                                         const size_t batch_index,
+                                         const size_t head_index,
+                                         const size_t sequence_length,
+                                         ptrdiff_t& attention_total_seqlen) {
+    attention_total_seqlen = 0;
+    if (attention_bias == nullptr) {
+      return nullptr;
+    }
 
-          // Add attention bias to QxK' if provided
-          // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
-          if (attention_bias_thread != nullptr) {
-            if constexpr (std::is_same_v<U, T>) {
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
-                                 static_cast<int>(window_size));
-            } else {
-              static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
-              size_t bytes = window_size * sizeof(float);
-              auto attention_bias_thread_fp32 = static_cast<float*>(allocator->Alloc(bytes));
-              BufferUniquePtr scratch_buffer(attention_bias_thread_fp32, BufferDeleter(allocator));
-
-              MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
-            }
-          }
+    ptrdiff_t attention_bias_offset = 0;
+    attention_total_seqlen = static_cast<ptrdiff_t>(attention_bias_shape[3]);
+    const ptrdiff_t attention_matrix_size = sequence_length * attention_total_seqlen;
+    if (attention_bias_shape[0] != 1) {
+      attention_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attention_bias_shape[1] * attention_matrix_size;
+    }
+    if (attention_bias_shape[1] != 1) {
+      attention_bias_offset += SafeInt<ptrdiff_t>(head_index) * attention_matrix_size;
+    }
 
-          if (use_smooth_softmax_) {
-            ComputeSmoothSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+    return attention_bias + attention_bias_offset;
+  }
+
+  // Helper function to turn the scores Q x K' (S x T) of a (batch, head) pair into the attention probs in place. Each
+  // row is masked outside of the local window, gets the softcap and the attention bias, and then the softmax.
+  template <typename T, typename U>
+  void ComputeAttentionSoftmaxRows(U* output_softmax,                            // scores of the pair with size SxT
+                                   const T* attention_bias_thread,               // attention bias of the pair (if any)
+                                   const ptrdiff_t attention_total_seqlen,       // row stride of the attention bias
+                                   const size_t sequence_length,                 // sequence length of Q (S)
+                                   const size_t past_seqlen,                     // past sequence length of the batch
+                                   const size_t total_seqlen,                    // total sequence length of the batch
+                                   const size_t present_buffer_sequence_length,  // row stride of the scores (T)
+                                   AllocatorPtr allocator) const {
+    for (size_t seq = 0; seq < sequence_length; seq++) {
+      size_t seq_causal_length = past_seqlen + seq + 1;
+
+      // local_window_size does not include the current query token, while window_size includes it.
+      const bool should_apply_local_window = local_window_size_ >= 0 &&
+                                             seq_causal_length > static_cast<size_t>(local_window_size_) + 1;
+
+      const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ - 1 : 0;
+      const size_t window_size = should_apply_local_window ? local_window_size_ + 1 : seq_causal_length;
+
+      // Mask everything before local window, if local window should be applied
+      if (should_apply_local_window) {
+        for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
+          if constexpr (std::is_same<U, float>::value) {
+            output_softmax[total_seq_id] = 0.f;
           } else {
-            ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+            output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
           }
+        }
+      }
 
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            if constexpr (std::is_same<U, float>::value) {
-              output_softmax[total_seq_id] = 0.f;
-            } else {
-              output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
-            }
-          }
+      if (softcap_ > 0.f) {
+        ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
+                                       static_cast<U>(softcap_));
+      }
 
-          output_softmax += present_buffer_sequence_length;
+      // Add attention bias to QxK' if provided
+      // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
+      if (attention_bias_thread != nullptr) {
+        if constexpr (std::is_same_v<U, T>) {
+          ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
+                             static_cast<int>(window_size));
+        } else {
+          static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
+          size_t bytes = window_size * sizeof(float);
+          auto attention_bias_thread_fp32 = static_cast<float*>(allocator->Alloc(bytes));
+          BufferUniquePtr scratch_buffer(attention_bias_thread_fp32, BufferDeleter(allocator));
 
-          if (attention_bias_thread != nullptr) {
-            attention_bias_thread += attention_total_seqlen;
-          }
+          MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
+          ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
         }
       }
-    });
+
+      if (use_smooth_softmax_) {
+        ComputeSmoothSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+      } else {
+        ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+      }
+
+      // set causal [seq_causal_length, total_seqlen) to 0.f
+      for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+        if constexpr (std::is_same<U, float>::value) {
+          output_softmax[total_seq_id] = 0.f;
+        } else {
+          output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
+        }
+      }
+
+      output_softmax += present_buffer_sequence_length;
+
+      if (attention_bias_thread != nullptr) {
+        attention_bias_thread += attention_total_seqlen;
+      }
+    }
   }
 
   template <typename T, typename U>
@@ -351,6 +720,7 @@ class GQAAttentionBase {
                                const bool past_present_share_buffer,         // whether present key and value share the same buffer
                                const bool packed_qkv,                        // whether Q, K, V are packed
                                const bool is_prompt,                         // whether it is prompt
+                               const bool present_kv_updated,                // whether V is already in present
                                ThreadPool* tp,
                                AllocatorPtr allocator) const {
     const ptrdiff_t packed_batch_stride =
@@ -361,7 +731,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
     const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && !present_kv_updated) {
       memset((void*)present_value,
              0,
              batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
@@ -404,15 +774,19 @@ class GQAAttentionBase {
         const size_t past_chunk_length = past_seqlen * head_size;
 
         const T* v;
-        if (packed_qkv) {
-          v = V + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
+        if (present_kv_updated) {
+          v = present_value + present_buff_chunk_length * (i / kv_num_heads_factor);
         } else {
-          v = V + kv_input_chunk_length * (i / kv_num_heads_factor);
-        }
-        if (nullptr != present_value) {
-          v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
-                                  past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                  i / kv_num_heads_factor);
+          if (packed_qkv) {
+            v = V + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
+          } else {
+            v = V + kv_input_chunk_length * (i / kv_num_heads_factor);
+          }
+          if (nullptr != present_value) {
+            v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
+                                    past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
+                                    i / kv_num_heads_factor);
+          }
         }
 
         ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length * i;
@@ -22,21 +22,56 @@ namespace onnxruntime {
 namespace contrib {
 
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                              \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                              \
+      GroupQueryAttention,                                                    \
+      kMSDomain,                                                              \
+      1,                                                                      \
+      T,                                                                      \
+      kCpuExecutionProvider,                                                  \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())              \
+          .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<T>(),       \
+                                      DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),       \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(MLFloat16)
 
+// Copy the past tokens of every (batch, kv head) into present when they do not share the buffer. The rest of present is
+// zeroed out, and the new tokens are written into it later.
+template <typename T>
+static void CopyPastKVCache(ThreadPool* tp, const Tensor* past, Tensor* present, const std::vector<int>& past_seqlens) {
+  T* present_data = present->MutableData<T>();
+  if (past != nullptr && past->DataRaw() == present->DataRaw()) {
+    return;
+  }
+
+  memset(present_data, 0, present->SizeInBytes());
+  if (past == nullptr) {
+    return;
+  }
+
+  const auto& present_dims = present->Shape().GetDims();
+  const size_t num_chunks = SafeInt<size_t>(present_dims[0]) * present_dims[1];
+  const size_t kv_num_heads = static_cast<size_t>(present_dims[1]);
+  const size_t head_size = static_cast<size_t>(present_dims[3]);
+  const size_t present_chunk_length = static_cast<size_t>(present_dims[2]) * head_size;
+  const size_t past_chunk_length = static_cast<size_t>(past->Shape()[2]) * head_size;
+  const T* past_data = past->Data<T>();
+
+  const double cost = static_cast<double>(past_chunk_length * sizeof(T));
+  ThreadPool::TryParallelFor(tp, static_cast<std::ptrdiff_t>(num_chunks), cost,
+                             [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                               for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                 const size_t past_seqlen = static_cast<size_t>(past_seqlens[i / kv_num_heads]);
+                                 memcpy(present_data + i * present_chunk_length, past_data + i * past_chunk_length,
+                                        past_seqlen * head_size * sizeof(T));
+                               }
+                             });
+}
+
 template <typename T>
 GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
     : OpKernel(info), GQAAttentionBase(info, true) {}
@@ -54,13 +89,20 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* sin_cache = context->Input<Tensor>(8);
   const Tensor* position_ids = context->Input<Tensor>(9);
   const Tensor* attention_bias = context->Input<Tensor>(10);
+  const Tensor* block_table = context->Input<Tensor>(11);
+  const Tensor* past_key_scale = context->Input<Tensor>(12);
+  const Tensor* past_value_scale = context->Input<Tensor>(13);
+  const bool use_paged_kv_cache = block_table != nullptr;
+  const bool use_quantized_kv_cache = past_key != nullptr && past_key->IsDataType<int8_t>();
 
+  // In paged mode past_key and past_value are a page pool rather than per-sequence buffers, so they are validated
+  // separately after the common checks.
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
                                                                 key,
                                                                 value,
-                                                                past_key,
-                                                                past_value,
+                                                                use_paged_kv_cache ? nullptr : past_key,
+                                                                use_paged_kv_cache ? nullptr : past_value,
                                                                 cos_cache,
                                                                 sin_cache,
                                                                 &parameters,
@@ -75,6 +117,34 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                                attention_bias,
                                                                                parameters));
 
+  if (use_paged_kv_cache) {
+    int block_size = 0;
+    int num_blocks = 0;
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckPagedKVCacheInputs(past_key,
+                                                                              past_value,
+                                                                              block_table,
+                                                                              seqlens_k,
+                                                                              parameters,
+                                                                              &block_size,
+                                                                              &num_blocks));
+  }
+
+  int num_scale_blocks = 0;
+  if (use_quantized_kv_cache) {
+    if constexpr (!std::is_same_v<T, float>) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "int8 KV cache is only supported for float query.");
+    }
+    if (use_paged_kv_cache) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "int8 KV cache does not support 'block_table'.");
+    }
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckQuantizedKVCacheInputs(past_key,
+                                                                                  past_value,
+                                                                                  past_key_scale,
+                                                                                  past_value_scale,
+                                                                                  parameters,
+                                                                                  &num_scale_blocks));
+  }
+
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
   const int present_kv_seqlen = parameters.seqlen_present_kv_cache;
@@ -90,17 +160,43 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
 
   std::vector<int64_t> present_k_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
   std::vector<int64_t> present_v_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
+  if (use_paged_kv_cache) {
+    // The present outputs are the updated page pools, so they keep the shape of the past page pools.
+    const auto& page_pool_dims = past_key->Shape().GetDims();
+    present_k_shape.assign(page_pool_dims.begin(), page_pool_dims.end());
+    present_v_shape.assign(page_pool_dims.begin(), page_pool_dims.end());
+  }
   Tensor* present_k = context->Output(1, present_k_shape);
   Tensor* present_v = context->Output(2, present_v_shape);
 
+  Tensor* present_k_scale = nullptr;
+  Tensor* present_v_scale = nullptr;
+  if (use_quantized_kv_cache) {
+    std::vector<int64_t> present_scale_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_),
+                                              static_cast<int64_t>(present_kv_seqlen),
+                                              static_cast<int64_t>(num_scale_blocks)});
+    present_k_scale = context->Output(3, present_scale_shape);
+    present_v_scale = context->Output(4, present_scale_shape);
+    if (present_k_scale == nullptr || present_v_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Output 'present_key_scale' and 'present_value_scale' are required for an int8 KV cache.");
+    }
+  }
+
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
+  // With rotary embedding, Q, K and V are split out of the inputs and rotated in one pass that writes K and V straight
+  // into the KV cache. The paged and int8 KV caches take the unfused path below.
+  const bool use_fused_rotary = do_rotary_ && !use_paged_kv_cache && !use_quantized_kv_cache;
+
   auto element_type = DataTypeImpl::GetType<T>();
   OrtValue Q;
   OrtValue K;
   OrtValue V;
-  if (packed_qkv) {
+  if (use_fused_rotary) {
+    // Q, K and V are read from the inputs directly.
+  } else if (packed_qkv) {
     ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
         allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
   } else {
@@ -115,9 +211,55 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue RotaryQKV;
   OrtValue RotaryQ;
   OrtValue RotaryK;
-  T* q_rotary = Q.GetMutable<Tensor>()->MutableData<T>();
-  T* k_rotary = packed_qkv ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
-  if (do_rotary_) {
+  T* q_rotary = use_fused_rotary ? nullptr : Q.GetMutable<Tensor>()->MutableData<T>();
+  T* k_rotary = (use_fused_rotary || packed_qkv) ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
+  if (use_fused_rotary) {
+    const int pos_ids_size = parameters.is_first_prompt ? 1 : batch_size * sequence_length;
+    std::vector<int64_t> default_pos_ids(pos_ids_size);
+    std::vector<int> past_seqlens(batch_size);
+    for (int b = 0; b < batch_size; b++) {
+      const int total_seqlen = seqlens_k->Data<int32_t>()[b] + 1;
+      past_seqlens[b] = parameters.is_first_prompt ? 0 : total_seqlen - sequence_length;
+      if (!parameters.is_first_prompt) {
+        for (int s = 0; s < sequence_length; s++) {
+          default_pos_ids[b * sequence_length + s] = static_cast<int64_t>(past_seqlens[b]) + s;
+        }
+      }
+    }
+    const int64_t* pos_ids_data = position_ids != nullptr ? position_ids->Data<int64_t>() : default_pos_ids.data();
+
+    CopyPastKVCache<T>(context->GetOperatorThreadPool(), past_key, present_k, past_seqlens);
+    CopyPastKVCache<T>(context->GetOperatorThreadPool(), past_value, present_v, past_seqlens);
+
+    Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_, sequence_length, head_size}), allocator, Q);
+    q_rotary = Q.GetMutable<Tensor>()->MutableData<T>();
+    ORT_RETURN_IF_ERROR(rotary_helper::RotaryQKVIntoKVCache<T>(context->GetOperatorThreadPool(),
+                                                               batch_size,
+                                                               sequence_length,
+                                                               num_heads_,
+                                                               kv_num_heads_,
+                                                               head_size,
+                                                               parameters.rotary_dim,
+                                                               rotary_interleaved_,
+                                                               query->Data<T>(),
+                                                               packed_qkv ? nullptr : key->Data<T>(),
+                                                               packed_qkv ? nullptr : value->Data<T>(),
+                                                               pos_ids_data,
+                                                               parameters.is_first_prompt ? 0 : 1,
+                                                               cos_cache->Data<T>(),
+                                                               sin_cache->Data<T>(),
+                                                               past_seqlens.data(),
+                                                               present_kv_seqlen,
+                                                               q_rotary,
+                                                               present_k->MutableData<T>(),
+                                                               present_v->MutableData<T>()));
+
+    // Q is no longer packed with K and V, which are already in present_key and present_value.
+    parameters.is_packed_qkv = false;
+    return ApplyAttention<T>(q_rotary, nullptr, nullptr, attention_bias, past_key, past_value, output, present_k,
+                             present_v, seqlens_k, parameters, allocator, context, nullptr,
+                             true /* present_kv_updated */);
+  } else if (do_rotary_) {
     // Initialize rotary parameters
     rotary_embedding_helper::RotaryParameters rotary_params = {};
     rotary_params.batch_size = batch_size;
@@ -205,9 +347,19 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
   // Compute the attention score and apply the score to V
+  if constexpr (std::is_same_v<T, float>) {
+    if (use_quantized_kv_cache) {
+      return ApplyQuantizedKVAttention(q_rotary, packed_qkv ? nullptr : k_rotary,
+                                       packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), attention_bias,
+                                       past_key, past_value, past_key_scale, past_value_scale, output,
+                                       present_k, present_v, present_k_scale, present_v_scale,
+                                       seqlens_k, parameters, allocator, context);
+    }
+  }
+
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         attention_bias, past_key, past_value, output, present_k, present_v,
-                        seqlens_k, parameters, allocator, context);
+                        seqlens_k, parameters, allocator, context, block_table);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
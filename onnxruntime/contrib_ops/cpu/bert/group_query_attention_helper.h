@@ -333,6 +333,107 @@ Status CheckCustomAttentionInputs(const T* position_ids,
   return Status::OK();
 }
 
+// Validate the paged KV cache inputs. In paged mode past_key and past_value are not per-sequence buffers but a
+// fixed-size pool of pages shared by all sequences of the batch, and block_table maps the logical blocks of each
+// sequence onto physical pages of that pool:
+//     past_key/past_value        : (num_blocks, N_k, block_size, H)
+//     block_table                : (B, max_blocks_per_sequence)
+template <typename T = Tensor>
+Status CheckPagedKVCacheInputs(const T* past_key,
+                               const T* past_value,
+                               const T* block_table,
+                               const T* seqlens_k,
+                               const GroupQueryAttentionParameters& parameters,
+                               int* block_size,
+                               int* num_blocks) {
+  if (past_key == nullptr || past_value == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be present when 'block_table' is given.");
+  }
+
+  const auto& past_key_dims = past_key->Shape().GetDims();
+  const auto& past_value_dims = past_value->Shape().GetDims();
+  if (past_key_dims.size() != 4 || past_key_dims != past_value_dims) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Paged 'past_key' and 'past_value' shall both have shape "
+                           "(num_blocks, kv_num_heads, block_size, head_size).");
+  }
+  if (past_key_dims[1] != parameters.kv_num_heads || past_key_dims[3] != parameters.head_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Paged 'past_key' dimension 1 shall be kv_num_heads and dimension 3 shall be head_size.");
+  }
+
+  const auto& block_table_dims = block_table->Shape().GetDims();
+  if (block_table_dims.size() != 2 || block_table_dims[0] != parameters.batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'block_table' is expected to have shape (batch_size, max_blocks_per_sequence).");
+  }
+
+  *num_blocks = static_cast<int>(past_key_dims[0]);
+  *block_size = static_cast<int>(past_key_dims[2]);
+  const int64_t max_blocks_per_sequence = block_table_dims[1];
+
+  const int32_t* seqlens_k_data = seqlens_k->template Data<int32_t>();
+  const int32_t* block_table_data = block_table->template Data<int32_t>();
+  for (int b = 0; b < parameters.batch_size; b++) {
+    const int64_t total_seqlen = static_cast<int64_t>(seqlens_k_data[b]) + 1;
+    const int64_t used_blocks = (total_seqlen + *block_size - 1) / *block_size;
+    if (used_blocks > max_blocks_per_sequence) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'block_table' has ", max_blocks_per_sequence, " blocks per sequence but batch ",
+                             b, " requires ", used_blocks, " blocks.");
+    }
+    for (int64_t blk = 0; blk < used_blocks; blk++) {
+      const int32_t page = block_table_data[b * max_blocks_per_sequence + blk];
+      if (page < 0 || page >= *num_blocks) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'block_table' contains page index ", page, " which is out of range [0, ",
+                               *num_blocks, ").");
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+// Validate the int8 KV cache inputs. Every token of a kv head is quantized in num_scale_blocks blocks of channels with
+// one scale per block:
+//     past_key/past_value              : (B, N_k, S*, H) of int8
+//     past_key_scale/past_value_scale  : (B, N_k, S*, num_scale_blocks) of float
+template <typename T = Tensor>
+Status CheckQuantizedKVCacheInputs(const T* past_key,
+                                   const T* past_value,
+                                   const T* past_key_scale,
+                                   const T* past_value_scale,
+                                   const GroupQueryAttentionParameters& parameters,
+                                   int* num_scale_blocks) {
+  if (past_value == nullptr || !past_value->template IsDataType<int8_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_value' shall be int8 when 'past_key' is int8.");
+  }
+  if (past_key_scale == nullptr || past_value_scale == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key_scale' and 'past_value_scale' shall be present for an int8 KV cache.");
+  }
+
+  const auto& past_key_dims = past_key->Shape().GetDims();
+  const auto& scale_dims = past_key_scale->Shape().GetDims();
+  if (scale_dims.size() != 4 || scale_dims != past_value_scale->Shape().GetDims() ||
+      !std::equal(scale_dims.begin(), scale_dims.begin() + 3, past_key_dims.begin())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key_scale' and 'past_value_scale' shall both have shape "
+                           "(batch_size, kv_num_heads, past_sequence_length, num_scale_blocks).");
+  }
+  if (scale_dims[3] <= 0 || parameters.head_size % scale_dims[3] != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key_scale' dimension 3 shall divide head_size ", parameters.head_size,
+                           ", got ", scale_dims[3]);
+  }
+
+  *num_scale_blocks = static_cast<int>(scale_dims[3]);
+  return Status::OK();
+}
+
 }  // namespace group_query_attention_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -95,7 +95,8 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
                                                                       scale_,
                                                                       is_unidirectional_,
                                                                       past_present_share_buffer,
-                                                                      kMultiHeadAttention));
+                                                                      kMultiHeadAttention,
+                                                                      true /* allow_kv_shared_by_beams */));
   DUMP_CPU_STRING_INIT();
   DUMP_CPU_STRING("Batch size = ", parameters.batch_size);
   DUMP_CPU_STRING("Sequence length = ", parameters.sequence_length);
@@ -180,13 +181,16 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
       parameters.max_sequence_length = parameters.kv_sequence_length;
     }
 
+    // Key and value are shared by the beams of a batch when they are not expanded for beam search.
+    const int kv_beam_width = batch_size / static_cast<int>(key->Shape()[0]);
     return ApplyAttention(Q.GetMutable<Tensor>()->MutableData<T>(),
                           key->Data<T>(),
                           value->Data<T>(),
                           key_padding_mask, nullptr /* past */, past_key, past_value,
                           output, present_key, present_value, output_qk,
                           batch_size, q_sequence_length, kv_sequence_length,
-                          qk_head_size, v_head_size, v_hidden_size, attn_bias, context);
+                          qk_head_size, v_head_size, v_hidden_size, attn_bias, context,
+                          0 /* past_sequence_length */, false /* past_present_share_buffer */, kv_beam_width);
   }
 
   OrtValue K;
@@ -198,7 +202,6 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
 
   if (std::is_same_v<T, float> &&
       !disable_flash_ &&
-      !is_unidirectional_ &&
       key_padding_mask == nullptr &&
       attn_bias == nullptr &&
       past_key == nullptr &&
@@ -217,6 +220,8 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
     args.qk_head_size = qk_head_size;
     args.v_head_size = v_head_size;
     args.scale = (scale_ == 0.0f) ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+    // Same as the causal mask of the unfused path (see PrepareMask), which is not applied to a single token.
+    args.is_causal = is_unidirectional_ && q_sequence_length > 1;
     /*
       q_block_size, kv_block_size correspond to Br, Bc in the FlashAttention paper.
       Let M = l2_cache_size / sizeof(float)
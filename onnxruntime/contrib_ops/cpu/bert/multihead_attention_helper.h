@@ -64,7 +64,8 @@ Status Check_Q_KV(const T* query, const T* packed_kv, int num_heads, int head_si
 
 template <typename T>
 Status Check_Q_K_V(const T* query, const T* key, const T* value, int num_heads, int head_size,
-                   AttentionQkvFormat& qkv_format, int& kv_sequence_length, int& v_hidden_size) {
+                   AttentionQkvFormat& qkv_format, int& kv_sequence_length, int& v_hidden_size,
+                   bool allow_kv_shared_by_beams) {
   const auto& query_dims = query->Shape().GetDims();
   const auto& key_dims = key->Shape().GetDims();
   const auto& value_dims = value->Shape().GetDims();
@@ -78,7 +79,11 @@ Status Check_Q_K_V(const T* query, const T* key, const T* value, int num_heads,
                            "Expect rank of key and value be same, and either 3 or 4");
   }
 
-  if (key_dims[0] != query_dims[0] || value_dims[0] != query_dims[0]) {
+  // Key and value of cross attention in BNSH format can have batch_size / beam_width rows, when they are not expanded
+  // for beam search and the rows of the beams of a batch share them.
+  const bool is_kv_shared_by_beams = allow_kv_shared_by_beams && key_dims.size() == 4 && key_dims[0] > 0 &&
+                                     key_dims[0] == value_dims[0] && query_dims[0] % key_dims[0] == 0;
+  if (!is_kv_shared_by_beams && (key_dims[0] != query_dims[0] || value_dims[0] != query_dims[0])) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Input 'query', 'key' and 'value' shall have same dim 0 (batch_size)");
   }
@@ -281,7 +286,8 @@ Status CheckInputs(const T* query,
                    float scale,
                    bool is_unidirectional,
                    bool past_present_share_buffer,
-                   AttentionType operator_type) {
+                   AttentionType operator_type,
+                   bool allow_kv_shared_by_beams = false) {
   // ---------------------------------------------------------------
   // Notations:
   //    B: batch_size
@@ -305,8 +311,8 @@ Status CheckInputs(const T* query,
   //     value            (V)       : (B, L, D_v)
   //  Q_K_V_BSNH_BNSH_BNSH - cross attention (kv cache is not used, L == T, D == D_v):
   //     query            (Q)       : (B, S, D)
-  //     key              (K)       : (B, N, L, H)
-  //     value            (V)       : (B, N, L, H_v)
+  //     key              (K)       : (B, N, L, H), or (B / W, N, L, H) when allow_kv_shared_by_beams is True
+  //     value            (V)       : (B, N, L, H_v), or (B / W, N, L, H_v) when allow_kv_shared_by_beams is True
   //  Q_KV_BSNH_BSN2H - packed kv (kv cache is not used, bias is not allowed for packed kv):
   //     query            (Q)       : (B, S, D)
   //     key              (K/V)     : (B, L, N, 2, H)
@@ -378,7 +384,7 @@ Status CheckInputs(const T* query,
       ORT_RETURN_IF_ERROR(Check_Q_KV<T>(query, key, num_heads, head_size, qkv_format, kv_sequence_length));
     } else {
       ORT_RETURN_IF_ERROR(Check_Q_K_V<T>(query, key, value, num_heads, head_size,
-                                         qkv_format, kv_sequence_length, v_hidden_size));
+                                         qkv_format, kv_sequence_length, v_hidden_size, allow_kv_shared_by_beams));
     }
   } else if (value == nullptr) {  // no key and value
     ORT_RETURN_IF_ERROR(Check_QKV<T>(query, qkv_format));
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -41,6 +42,88 @@ Status PackVIntoRotaryQKV(concurrency::ThreadPool* tp,
   return Status::OK();
 }
 
+// Splits Q, K and V out of the BSNH inputs and applies rotary embedding to Q and K in a single pass. Q is written to
+// q_output in BNSH, and K and V of the new tokens go straight into the KV cache after the past tokens:
+//   query          (B, S, N * H), or packed QKV with shape (B, S, (N + 2 * N_kv) * H) when key is nullptr
+//   key, value     (B, S, N_kv * H)
+//   q_output       (B, N, S, H)
+//   present_key    (B, N_kv, T, H), where the new tokens of batch b start at row past_seqlens[b]
+//   present_value  (B, N_kv, T, H)
+template <typename T>
+Status RotaryQKVIntoKVCache(concurrency::ThreadPool* tp,
+                            int batch_size,
+                            int sequence_length,
+                            int num_heads,
+                            int kv_num_heads,
+                            int head_size,
+                            int rotary_embedding_dim,
+                            bool interleaved,
+                            const T* query,
+                            const T* key,
+                            const T* value,
+                            const int64_t* position_ids,
+                            int position_ids_format,
+                            const T* cos_cache,
+                            const T* sin_cache,
+                            const int* past_seqlens,
+                            int present_buffer_sequence_length,
+                            T* q_output,
+                            T* present_key,
+                            T* present_value) {
+  const bool packed_qkv = key == nullptr;
+  const int total_heads = num_heads + 2 * kv_num_heads;
+  const int q_token_stride = (packed_qkv ? total_heads : num_heads) * head_size;
+  const int kv_token_stride = (packed_qkv ? total_heads : kv_num_heads) * head_size;
+  const T* k_input = packed_qkv ? query + num_heads * head_size : key;
+  const T* v_input = packed_qkv ? query + (num_heads + kv_num_heads) * head_size : value;
+  const int half_rotary_emb_dim = rotary_embedding_dim / 2;
+
+  const int loop_len = batch_size * sequence_length * total_heads;
+  const double cost = static_cast<double>(head_size);
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t ptr = begin; ptr != end; ++ptr) {
+      const int b = static_cast<int>((ptr / total_heads) / sequence_length);
+      const int s = static_cast<int>((ptr / total_heads) % sequence_length);
+      const int n = static_cast<int>(ptr % total_heads);
+      const ptrdiff_t token = static_cast<ptrdiff_t>(b) * sequence_length + s;
+
+      const T* input_data;
+      T* output_data;
+      if (n < num_heads) {
+        input_data = query + token * q_token_stride + n * head_size;
+        output_data = q_output + ((static_cast<ptrdiff_t>(b) * num_heads + n) * sequence_length + s) * head_size;
+      } else {
+        const bool is_key = n < num_heads + kv_num_heads;
+        const int kv_head = n - (is_key ? num_heads : num_heads + kv_num_heads);
+        const ptrdiff_t cache_row = (static_cast<ptrdiff_t>(b) * kv_num_heads + kv_head) *
+                                        present_buffer_sequence_length +
+                                    past_seqlens[b] + s;
+        input_data = (is_key ? k_input : v_input) + token * kv_token_stride + kv_head * head_size;
+        output_data = (is_key ? present_key : present_value) + cache_row * head_size;
+        if (!is_key) {
+          std::memcpy(output_data, input_data, head_size * sizeof(T));
+          continue;
+        }
+      }
+
+      // Cache is (M, H/2) or (M, rotary_embedding_dim/2)
+      const int position_id = (position_ids_format == 0)
+                                  ? static_cast<int>(position_ids[0]) + s
+                                  : static_cast<int>(position_ids[b * sequence_length + s]);
+      const int cache_offset = position_id * half_rotary_emb_dim;
+      MlasRotaryEmbedOneRow<T>(input_data, sin_cache + cache_offset, cos_cache + cache_offset, rotary_embedding_dim,
+                               interleaved, output_data);
+
+      if (rotary_embedding_dim < head_size) {
+        std::memcpy(output_data + rotary_embedding_dim,
+                    input_data + rotary_embedding_dim,
+                    (head_size - rotary_embedding_dim) * sizeof(T));
+      }
+    }
+  });
+  return Status::OK();
+}
+
 }  // namespace rotary_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 using onnxruntime::narrow;
 namespace onnxruntime {
 namespace contrib {
@@ -18,8 +19,65 @@ namespace contrib {
 DEFINE_KERNEL(float);
 DEFINE_KERNEL(double);
 
+// Computes sum_k(Xik**2) for each row of the {rows, k} matrix x, or its square root when `root` is true
 template <typename T>
-static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
+static std::vector<T> RowSquaredNorms(const T* x, int64_t rows, int64_t k, bool root,
+                                      concurrency::ThreadPool* threadpool) {
+  std::vector<T> norms(narrow<size_t>(rows));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, narrow<std::ptrdiff_t>(rows),
+      TensorOpCost{static_cast<double>(k * sizeof(T)), static_cast<double>(sizeof(T)), static_cast<double>(k * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          T norm = ConstEigenVectorMap<T>(x + i * k, narrow<size_t>(k)).squaredNorm();
+          norms[narrow<size_t>(i)] = root ? std::sqrt(norm) : norm;
+        }
+      });
+  return norms;
+}
+
+// Computes alpha * A * B^T into the {m, n} output
+template <typename T>
+static void GemmABTranspose(const T* a_data, const T* b_data, T* c_data, int64_t m, int64_t n, int64_t k, T alpha,
+                            concurrency::ThreadPool* threadpool) {
+// use MLAS on 64-bit (no 32-bit dgemm)
+#if defined(_M_AMD64) || defined(__x86_64__)
+  math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                m, n, k,
+                alpha, a_data, b_data, static_cast<T>(0.),
+                c_data,
+                threadpool);
+#else
+  // the performance of this isn't great as the eigen matmul is single threaded by default
+  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimizing this
+  // we can look into it in the future.
+  ORT_UNUSED_PARAMETER(threadpool);
+
+  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
+  auto out_map = EigenMatrixMapRowMajor<T>(c_data, SafeInt<size_t>(m), SafeInt<size_t>(n));
+  out_map.noalias() = alpha *
+                      (ConstEigenMatrixMapRowMajor<T>(a_data, SafeInt<size_t>(m), SafeInt<size_t>(k)) *
+                       ConstEigenMatrixMapRowMajor<T>(b_data, SafeInt<size_t>(n), SafeInt<size_t>(k)).transpose());
+#endif
+}
+
+// Applies `epilogue(row, out_row)` to each row of the {m, n} output in parallel
+template <typename T, typename Epilogue>
+static void ForEachOutputRow(T* c_data, int64_t m, int64_t n, concurrency::ThreadPool* threadpool,
+                             const Epilogue& epilogue) {
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, narrow<std::ptrdiff_t>(m),
+      TensorOpCost{static_cast<double>(n * sizeof(T)), static_cast<double>(n * sizeof(T)), static_cast<double>(n * 4)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          epilogue(narrow<size_t>(i), c_data + i * n);
+        }
+      });
+}
+
+template <typename T>
+static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, bool euclidean,
+                                 concurrency::ThreadPool* threadpool) {
   // input shapes have already been validated
   const auto& shape_a = a.Shape().GetDims();  // {m, k}
   const auto& shape_b = b.Shape().GetDims();  // {n, k}
@@ -34,60 +92,57 @@ static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, co
   const auto* b_data = b.Data<T>();
   auto* c_data = c.MutableData<T>();
 
-  // ReduceSumSquare for A
-  std::vector<T> a_ss;
-  a_ss.resize(narrow<size_t>(m));
-  const auto* cur_a = a_data;
-  for (int64_t i = 0; i < m; ++i) {
-    a_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_a, narrow<size_t>(k)).squaredNorm();
-    cur_a += k;
-  }
-
-  // ReduceSumSquare for B
-  std::vector<T> b_ss;
-  b_ss.resize(narrow<size_t>(n));
-  const auto* cur_b = b_data;
-  for (int64_t i = 0; i < n; ++i) {
-    b_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_b, narrow<size_t>(k)).squaredNorm();
-    cur_b += k;
-  }
+  // ReduceSumSquare for A and B
+  const std::vector<T> a_ss = RowSquaredNorms(a_data, m, k, false, threadpool);
+  const std::vector<T> b_ss = RowSquaredNorms(b_data, n, k, false, threadpool);
 
   // NOTE: We want to avoid subtracting two numbers that are very close to each other as that can lead to
   // 'catastrophic cancellation'. (sum_k(Xik**2) + sum_k(Yjk**2)) would be close to 2*sum_k(Xik*Yjk) if the values
   // in Xij and Yjk are very similar, so subtracting can be problematic.
   // Due to that we calculate -2*sum_k(Xik*Yjk) using GEMM, add sum_k(Xik**2) next, and add sum_k(Yjk**2) last.
 
-// use MLAS on 64-bit (no 32-bit dgemm)
-#if defined(_M_AMD64) || defined(__x86_64__)
   // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
-  math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                m, n, k,
-                static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
-                c_data,
-                threadpool);
-#else
-  // the performance of this isn't great as the eigen matmul is single threaded by default
-  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimizing this
-  // we can look into it in the future.
-  ORT_UNUSED_PARAMETER(threadpool);
+  GemmABTranspose(a_data, b_data, c_data, m, n, k, static_cast<T>(-2.), threadpool);
 
-  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-  auto out_map = EigenMatrixMapRowMajor<T>(c_data, SafeInt<size_t>(m), SafeInt<size_t>(n));
-  out_map.noalias() = static_cast<T>(-2.) *
-                      (ConstEigenMatrixMapRowMajor<T>(a_data, SafeInt<size_t>(m), SafeInt<size_t>(k)) *
-                       ConstEigenMatrixMapRowMajor<T>(b_data, SafeInt<size_t>(n), SafeInt<size_t>(k)).transpose());
-#endif
+  // add a_ss and b_ss, with broadcast, in a single pass over the output that also finishes the distance.
+  // because we use GEMM there's a slight chance a number extremely close to zero could be negative,
+  // so we need to run abs() to avoid NaN's in the results.
+  ForEachOutputRow(c_data, m, n, threadpool, [&](size_t i, T* cur_out) {
+    T a_val = a_ss[i];
+    for (int64_t j = 0; j < n; ++j) {
+      T value = std::abs((cur_out[j] + a_val) + b_ss[narrow<size_t>(j)]);
+      cur_out[j] = euclidean ? std::sqrt(value) : value;
+    }
+  });
+}
+
+template <typename T>
+static void CalculateCosine(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
+  // input shapes have already been validated
+  const auto& shape_a = a.Shape().GetDims();  // {m, k}
+  const auto& shape_b = b.Shape().GetDims();  // {n, k}
+  int64_t m = shape_a[0];
+  int64_t n = shape_b[0];
+  int64_t k = shape_a[1];
+
+  // dist(Xi,Yj) = 1 - sum_k(Xik*Yjk) / (sqrt(sum_k(Xik**2)) * sqrt(sum_k(Yjk**2)))
+  // As in scipy, the distance is NaN when either vector is all zeros.
+
+  const auto* a_data = a.Data<T>();
+  const auto* b_data = b.Data<T>();
+  auto* c_data = c.MutableData<T>();
+
+  const std::vector<T> a_norm = RowSquaredNorms(a_data, m, k, true, threadpool);
+  const std::vector<T> b_norm = RowSquaredNorms(b_data, n, k, true, threadpool);
 
-  // add a_ss and b_ss, with broadcast
-  // output shape is {m, n}
-  auto* cur_out = c_data;
-  for (int64_t i = 0; i < m; ++i) {
-    T a_val = a_ss[narrow<size_t>(i)];
+  GemmABTranspose(a_data, b_data, c_data, m, n, k, static_cast<T>(1.), threadpool);
+
+  ForEachOutputRow(c_data, m, n, threadpool, [&](size_t i, T* cur_out) {
+    T a_val = a_norm[i];
     for (int64_t j = 0; j < n; ++j) {
-      *cur_out = (*cur_out + a_val) + b_ss[narrow<size_t>(j)];
-      ++cur_out;
+      cur_out[j] = static_cast<T>(1.) - cur_out[j] / (a_val * b_norm[narrow<size_t>(j)]);
     }
-  }
+  });
 }
 
 template <typename T>
@@ -112,17 +167,14 @@ common::Status CDist<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_shape = {shape_a[0], shape_b[0]};
   Tensor* C = context->Output(0, output_shape);
-  T* output = C->MutableData<T>();
-
-  CalculateSqeuclidean<T>(*A, *B, *C, tp);
-  auto map_out = EigenVectorArrayMap<T>(output, narrow<size_t>(output_shape.Size()));
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  // because we use GEMM in CalculateSqeuclidean there's a slight chance a number extremely close to zero
-  // could be negative, so we need to run abs() to avoid NaN's in the results.
-  if (mode_ == Mode::EUCLIDEAN) {
-    map_out = map_out.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
-  } else if (mode_ == Mode::SQEUCLIDEAN) {
-    map_out = map_out.abs();
+  if (mode_ == Mode::COSINE) {
+    CalculateCosine<T>(*A, *B, *C, tp);
+  } else {
+    CalculateSqeuclidean<T>(*A, *B, *C, mode_ == Mode::EUCLIDEAN, tp);
   }
 
   return Status::OK();
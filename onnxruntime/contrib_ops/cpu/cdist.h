@@ -15,7 +15,8 @@ class CDist final : public OpKernel {
   typedef void (*DistFunc)(const T* a, const T* b, T* dest, size_t ma, size_t mb, size_t n,
                            concurrency::ThreadPool* tp);
   enum class Mode { EUCLIDEAN,
-                    SQEUCLIDEAN } mode_;
+                    SQEUCLIDEAN,
+                    COSINE } mode_;
 
  public:
   CDist(const OpKernelInfo& info) : OpKernel(info) {
@@ -25,6 +26,8 @@ class CDist final : public OpKernel {
       mode_ = Mode::SQEUCLIDEAN;
     else if (metric.compare("euclidean") == 0) {
       mode_ = Mode::EUCLIDEAN;
+    } else if (metric.compare("cosine") == 0) {
+      mode_ = Mode::COSINE;
     } else
       ORT_NOT_IMPLEMENTED();
   }
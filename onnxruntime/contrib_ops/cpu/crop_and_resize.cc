@@ -16,7 +16,10 @@ limitations under the License.
 
 #include "contrib_ops/cpu/crop_and_resize.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
+
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
@@ -46,6 +49,47 @@ namespace contrib {
 
 ADD_TYPED_CROPANDRESIZE_OP(float);
 
+namespace {
+// Where a row or column of the crop samples the input: the two input rows/columns it interpolates between,
+// the interpolation weight and the nearest row/column. 'valid' is false when it falls outside the input.
+struct CropSample {
+  bool valid;
+  int low;
+  int high;
+  int nearest;
+  float lerp;
+};
+
+// Samples of 'crop_size' rows or columns from 'roi_start' to 'roi_end', given relative to an input dimension of 'size'.
+template <typename T>
+void ComputeCropSamples(T roi_start, T roi_end, int64_t crop_size, int64_t size, std::vector<CropSample>& samples) {
+  const T scale = (crop_size > 1) ? (roi_end - roi_start) * (size - 1) / (crop_size - 1) : 0;
+
+  samples.resize(onnxruntime::narrow<size_t>(crop_size));
+  for (int64_t i = 0; i < crop_size; i++) {
+    T in = static_cast<T>((crop_size > 1) ? roi_start * (size - 1) + i * scale
+                                          : 0.5 * (roi_start + roi_end) * (size - 1));
+    if (i == crop_size - 1) {
+      in = static_cast<T>((crop_size > 1) ? roi_end * (size - 1) : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+    if (i == 0) {
+      in = static_cast<T>((crop_size > 1) ? roi_start * (size - 1) : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+
+    auto& sample = samples[onnxruntime::narrow<size_t>(i)];
+    sample.valid = !(in < 0 || in > size - 1);
+    if (sample.valid) {
+      sample.low = static_cast<int>(floorf(static_cast<float>(in)));
+      sample.high = static_cast<int>(ceilf(static_cast<float>(in)));
+      sample.nearest = static_cast<int>(roundf(static_cast<float>(in)));
+      sample.lerp = static_cast<float>(in - sample.low);
+    } else {
+      sample = CropSample{false, 0, 0, 0, 0.0f};
+    }
+  }
+}
+}  // namespace
+
 template <typename T>
 void CropAndResizeForward(const TensorShape& output_shape,
                           const T* bottom_data,
@@ -62,120 +106,69 @@ void CropAndResizeForward(const TensorShape& output_shape,
   int64_t channels = output_shape[1];
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
-
-  ThreadPool::TryBatchParallelFor(
-      ttp, static_cast<int32_t>(n_rois),
-      [&](ptrdiff_t n) {
-        int64_t index_n = n * channels * pooled_width * pooled_height;
-
-        const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-        const auto roi_batch_ind = batch_indices_ptr[n];
-
-        T roi_start_w = offset_bottom_rois[1];
-        T roi_start_h = offset_bottom_rois[0];
-        T roi_end_w = offset_bottom_rois[3];
-        T roi_end_h = offset_bottom_rois[2];
-
-        T height_scale = (pooled_height > 1)
-                             ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
-                             : 0;
-        T width_scale = (pooled_width > 1)
-                            ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
-                            : 0;
-
-        for (auto ph = 0; ph < pooled_height; ph++) {
-          T in_y = static_cast<T>((pooled_height > 1)
-                                      ? roi_start_h * (height - 1) + ph * height_scale
-                                      : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-          if (ph == pooled_height - 1) {
-            in_y = static_cast<T>((pooled_height > 1)
-                                      ? roi_end_h * (height - 1)
-                                      : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-          }
-          if (ph == 0) {
-            in_y = static_cast<T>((pooled_height > 1)
-                                      ? roi_start_h * (height - 1)
-                                      : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-          }
-          if (in_y < 0 || in_y > height - 1) {
-            for (int64_t pw = 0; pw < pooled_width; pw++) {
-              for (int64_t c = 0; c < channels; c++) {
-                int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-                int64_t index = index_n_c + ph * pooled_width + pw;
-                top_data[index] = extrapolation_value;
-              }
-            }
-            continue;
+  const bool bilinear = mode == "bilinear";
+
+  // the sampled rows and columns only depend on the ROI, so they are computed once per ROI in each range of the work,
+  // which is split by (roi, channel) so that each output channel of a ROI is written contiguously.
+  // 10 is a rough cost of interpolating an output value
+  const double cost = static_cast<double>(pooled_height * pooled_width * 10);
+  ThreadPool::TryParallelFor(
+      ttp, static_cast<ptrdiff_t>(n_rois * channels), cost, [&](ptrdiff_t first, ptrdiff_t last) {
+        std::vector<CropSample> y_samples;
+        std::vector<CropSample> x_samples;
+        int64_t samples_roi = -1;
+
+        for (ptrdiff_t item = first; item != last; ++item) {
+          const int64_t n = item / channels;
+          const int64_t c = item % channels;
+
+          if (n != samples_roi) {
+            const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+            ComputeCropSamples(offset_bottom_rois[0], offset_bottom_rois[2], pooled_height, height, y_samples);
+            ComputeCropSamples(offset_bottom_rois[1], offset_bottom_rois[3], pooled_width, width, x_samples);
+            samples_roi = n;
           }
 
-          const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
-          const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
-          const float y_lerp = static_cast<float>(in_y - top_y_index);
-
-          for (auto pw = 0; pw < pooled_width; pw++) {
-            T in_x = static_cast<T>((pooled_width > 1)
-                                        ? roi_start_w * (width - 1) + pw * width_scale
-                                        : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-            if (pw == pooled_width - 1) {
-              in_x = static_cast<T>((pooled_width > 1)
-                                        ? roi_end_w * (width - 1)
-                                        : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-            }
-            if (pw == 0) {
-              in_x = static_cast<T>((pooled_width > 1)
-                                        ? roi_start_w * (width - 1)
-                                        : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-            }
-            if (in_x < 0 || in_x > width - 1) {
-              for (int64_t c = 0; c < channels; c++) {
-                int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-                int64_t index = index_n_c + ph * pooled_width + pw;
-                top_data[index] = extrapolation_value;
-              }
+          const auto roi_batch_ind = batch_indices_ptr[n];
+          const T* offset_bottom_data =
+              bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+          T* output = top_data + (n * channels + c) * pooled_height * pooled_width;
+
+          for (int64_t ph = 0; ph < pooled_height; ph++, output += pooled_width) {
+            const CropSample& y_sample = y_samples[onnxruntime::narrow<size_t>(ph)];
+            if (!y_sample.valid) {
+              std::fill_n(output, pooled_width, extrapolation_value);
               continue;
             }
 
-            T output_val = extrapolation_value;
-            if (mode == "bilinear") {
-              const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
-              const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
-              const float x_lerp = static_cast<float>(in_x - left_x_index);
-              auto top_left_index = top_y_index * width + left_x_index;
-              auto top_right_index = top_y_index * width + right_x_index;
-              auto bottom_left_index = bottom_y_index * width + left_x_index;
-              auto bottom_right_index = bottom_y_index * width + right_x_index;
-
-              for (auto c = 0; c < channels; c++) {
-                int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-                int64_t index = index_n_c + ph * pooled_width + pw;
-                const T* offset_bottom_data =
-                    bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-                const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
-                const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
-                const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
-                const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
-                const float top = top_left + (top_right - top_left) * x_lerp;
-                const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-                output_val = top + (bottom - top) * y_lerp;
-                top_data[index] = output_val;
+            if (bilinear) {
+              const T* top_row = offset_bottom_data + y_sample.low * width;
+              const T* bottom_row = offset_bottom_data + y_sample.high * width;
+              const float y_lerp = y_sample.lerp;
+              for (int64_t pw = 0; pw < pooled_width; pw++) {
+                const CropSample& x_sample = x_samples[onnxruntime::narrow<size_t>(pw)];
+                if (!x_sample.valid) {
+                  output[pw] = extrapolation_value;
+                  continue;
+                }
+                const float top_left(static_cast<float>(top_row[x_sample.low]));
+                const float top_right(static_cast<float>(top_row[x_sample.high]));
+                const float bottom_left(static_cast<float>(bottom_row[x_sample.low]));
+                const float bottom_right(static_cast<float>(bottom_row[x_sample.high]));
+                const float top = top_left + (top_right - top_left) * x_sample.lerp;
+                const float bottom = bottom_left + (bottom_right - bottom_left) * x_sample.lerp;
+                output[pw] = top + (bottom - top) * y_lerp;
               }
             } else {  // mode == "nearest"
-              const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
-              const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
-              auto closest_index = closest_y_index * width + closest_x_index;
-
-              for (auto c = 0; c < channels; c++) {
-                int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-                int64_t index = index_n_c + ph * pooled_width + pw;
-                const T* offset_bottom_data =
-                    bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-                top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
+              const T* row = offset_bottom_data + y_sample.nearest * width;
+              for (int64_t pw = 0; pw < pooled_width; pw++) {
+                const CropSample& x_sample = x_samples[onnxruntime::narrow<size_t>(pw)];
+                output[pw] = x_sample.valid ? static_cast<float>(row[x_sample.nearest]) : extrapolation_value;
               }
             }
-          }  // for pw
-        }  // for ph
-      },
-      0);  // for n
+          }  // for ph
+        }  // for n, c
+      });
 }
 
 template <typename T>
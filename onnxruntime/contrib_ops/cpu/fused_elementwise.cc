@@ -0,0 +1,288 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates a chain of elementwise operators tile by tile, so the intermediate values stay in cache instead of being
+// written to and read back from memory by a kernel per operator.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> ops = info.GetAttrsOrDefault<std::string>("ops");
+    std::vector<int64_t> operands = info.GetAttrsOrDefault<int64_t>("operands");
+    ORT_ENFORCE(!ops.empty(), "FusedElementwise needs at least one step.");
+    ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise needs two operands per step.");
+
+    const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+    steps_.reserve(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+      Step step;
+      ORT_ENFORCE(TryParseOperation(ops[i], step.operation, step.is_binary),
+                  "FusedElementwise does not support ", ops[i]);
+      // a step can use the inputs and the results of the previous steps
+      const int64_t num_values = num_inputs + static_cast<int64_t>(i);
+      const int64_t a = operands[2 * i];
+      const int64_t b = operands[2 * i + 1];
+      ORT_ENFORCE(a >= 0 && a < num_values, "Invalid operand ", a, " of step ", i);
+      ORT_ENFORCE(step.is_binary ? (b >= 0 && b < num_values) : b == -1, "Invalid operand ", b, " of step ", i);
+      step.a = static_cast<int>(a);
+      step.b = static_cast<int>(b);
+      steps_.push_back(step);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class Operation {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Exp,
+    Log,
+    Neg,
+    Abs,
+    Sqrt,
+    Reciprocal,
+    Erf,
+  };
+
+  struct Step {
+    Operation operation;
+    bool is_binary;
+    int a;
+    int b;
+  };
+
+  // Where the values of an operand come from for the current tile.
+  struct Operand {
+    const float* data;  // nullptr for a single value
+    float value;
+  };
+
+  static bool TryParseOperation(const std::string& op, Operation& operation, bool& is_binary) {
+    static const std::pair<const char*, Operation> kBinary[] = {
+        {"Add", Operation::Add}, {"Sub", Operation::Sub}, {"Mul", Operation::Mul}, {"Div", Operation::Div}};
+    static const std::pair<const char*, Operation> kUnary[] = {
+        {"Relu", Operation::Relu}, {"Sigmoid", Operation::Sigmoid}, {"Tanh", Operation::Tanh},
+        {"Exp", Operation::Exp}, {"Log", Operation::Log}, {"Neg", Operation::Neg}, {"Abs", Operation::Abs},
+        {"Sqrt", Operation::Sqrt}, {"Reciprocal", Operation::Reciprocal}, {"Erf", Operation::Erf}};
+    for (const auto& entry : kBinary) {
+      if (op == entry.first) {
+        operation = entry.second;
+        is_binary = true;
+        return true;
+      }
+    }
+    for (const auto& entry : kUnary) {
+      if (op == entry.first) {
+        operation = entry.second;
+        is_binary = false;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Op>
+  static void Binary(const Operand& a, const Operand& b, float* output, size_t count, Op op) {
+    if (a.data != nullptr && b.data != nullptr) {
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = op(a.data[i], b.data[i]);
+      }
+    } else if (a.data != nullptr) {
+      const float b_value = b.value;
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = op(a.data[i], b_value);
+      }
+    } else if (b.data != nullptr) {
+      const float a_value = a.value;
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = op(a_value, b.data[i]);
+      }
+    } else {
+      std::fill_n(output, count, op(a.value, b.value));
+    }
+  }
+
+  template <typename Op>
+  static void Unary(const float* input, float* output, size_t count, Op op) {
+    for (size_t i = 0; i < count; ++i) {
+      output[i] = op(input[i]);
+    }
+  }
+
+  static void Evaluate(const Step& step, const Operand& a, const Operand& b, float* output, size_t count);
+
+  InlinedVector<Step> steps_;
+};
+
+void FusedElementwise::Evaluate(const Step& step, const Operand& a, const Operand& b, float* output, size_t count) {
+  if (step.is_binary) {
+    switch (step.operation) {
+      case Operation::Add:
+        Binary(a, b, output, count, [](float x, float y) { return x + y; });
+        break;
+      case Operation::Sub:
+        Binary(a, b, output, count, [](float x, float y) { return x - y; });
+        break;
+      case Operation::Mul:
+        Binary(a, b, output, count, [](float x, float y) { return x * y; });
+        break;
+      case Operation::Div:
+        Binary(a, b, output, count, [](float x, float y) { return x / y; });
+        break;
+      default:
+        ORT_THROW("Unexpected binary operation.");
+    }
+    return;
+  }
+
+  // unary operators always read a tile, a single value is expanded first
+  const float* input = a.data;
+  if (input == nullptr) {
+    std::fill_n(output, count, a.value);
+    input = output;
+  }
+
+  switch (step.operation) {
+    case Operation::Relu:
+      Unary(input, output, count, [](float x) { return std::max(x, 0.0f); });
+      break;
+    case Operation::Sigmoid:
+      MlasComputeLogistic(input, output, count);
+      break;
+    case Operation::Tanh:
+      MlasComputeTanh(input, output, count);
+      break;
+    case Operation::Exp:
+      MlasComputeExp(input, output, count);
+      break;
+    case Operation::Log:
+      Unary(input, output, count, [](float x) { return std::log(x); });
+      break;
+    case Operation::Neg:
+      Unary(input, output, count, [](float x) { return -x; });
+      break;
+    case Operation::Abs:
+      Unary(input, output, count, [](float x) { return std::abs(x); });
+      break;
+    case Operation::Sqrt:
+      Unary(input, output, count, [](float x) { return std::sqrt(x); });
+      break;
+    case Operation::Reciprocal:
+      Unary(input, output, count, [](float x) { return 1.0f / x; });
+      break;
+    case Operation::Erf:
+      MlasComputeErf(input, output, count);
+      break;
+    default:
+      ORT_THROW("Unexpected unary operation.");
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const TensorShape& output_shape = X->Shape();
+  const auto output_dims = output_shape.GetDims();
+  const size_t output_size = narrow<size_t>(output_shape.Size());
+
+  // Every other input is a single value or, after dropping its leading 1s, has the trailing dims of the first input,
+  // so it repeats every input_sizes[i] elements of the output.
+  const int num_inputs = context->InputCount();
+  InlinedVector<const float*> inputs(num_inputs);
+  InlinedVector<size_t> input_sizes(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    const Tensor* input = context->Input<Tensor>(i);
+    const auto dims = input->Shape().GetDims();
+    size_t first = 0;
+    while (first < dims.size() && dims[first] == 1) {
+      ++first;
+    }
+    ORT_RETURN_IF_NOT(dims.size() <= output_dims.size() &&
+                          std::equal(dims.begin() + first, dims.end(), output_dims.end() - (dims.size() - first)),
+                      "FusedElementwise input ", i, " with shape ", input->Shape(),
+                      " does not broadcast to the shape of the first input ", output_shape);
+    inputs[i] = input->Data<float>();
+    input_sizes[i] = narrow<size_t>(input->Shape().Size());
+  }
+
+  Tensor* Y = context->Output(0, output_shape);
+  float* output = Y->MutableData<float>();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  constexpr size_t kTileSize = 1024;
+  const size_t num_steps = steps_.size();
+  const size_t num_tiles = (output_size + kTileSize - 1) / kTileSize;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_tiles),
+      TensorOpCost{static_cast<double>(num_inputs * kTileSize * sizeof(float)),
+                   static_cast<double>(kTileSize * sizeof(float)), static_cast<double>(num_steps * kTileSize * 4)},
+      [&](std::ptrdiff_t first_tile, std::ptrdiff_t last_tile) {
+        // One tile per step result, plus one per input that has to be repeated into a tile.
+        InlinedVector<float> buffer((num_steps + num_inputs) * kTileSize);
+        float* step_tiles = buffer.data();
+        float* input_tiles = step_tiles + num_steps * kTileSize;
+        InlinedVector<Operand> values(num_inputs + num_steps);
+
+        for (std::ptrdiff_t tile = first_tile; tile < last_tile; ++tile) {
+          const size_t offset = static_cast<size_t>(tile) * kTileSize;
+          const size_t count = std::min(kTileSize, output_size - offset);
+
+          for (int i = 0; i < num_inputs; ++i) {
+            const size_t size = input_sizes[i];
+            if (size == output_size) {
+              values[i] = Operand{inputs[i] + offset, 0.0f};
+            } else if (size == 1) {
+              values[i] = Operand{nullptr, inputs[i][0]};
+            } else {
+              float* input_tile = input_tiles + i * kTileSize;
+              for (size_t j = 0, k = offset % size; j < count; ++j) {
+                input_tile[j] = inputs[i][k];
+                if (++k == size) {
+                  k = 0;
+                }
+              }
+              values[i] = Operand{input_tile, 0.0f};
+            }
+          }
+
+          for (size_t s = 0; s < num_steps; ++s) {
+            const Step& step = steps_[s];
+            float* result = s + 1 == num_steps ? output + offset : step_tiles + s * kTileSize;
+            Evaluate(step, values[step.a], step.is_binary ? values[step.b] : Operand{nullptr, 0.0f}, result, count);
+            values[num_inputs + s] = Operand{result, 0.0f};
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -21,6 +21,36 @@ class FusedGemm final : public Gemm<T> {
       }
     }
     ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
+
+    // Let MLAS apply the activations it supports to each block of the output instead of in a separate pass.
+    MLAS_ACTIVATION mlas_activation;
+    if (TryGetMlasActivation(activation, mlas_activation)) {
+      this->mlas_activation_ = mlas_activation;
+      this->activation_.reset();
+    }
+  }
+
+ private:
+  bool TryGetMlasActivation(const std::string& activation, MLAS_ACTIVATION& mlas_activation) const {
+    if (activation == "Relu") {
+      mlas_activation.ActivationKind = MlasReluActivation;
+    } else if (activation == "Tanh") {
+      mlas_activation.ActivationKind = MlasTanhActivation;
+    } else if (activation == "Sigmoid") {
+      mlas_activation.ActivationKind = MlasLogisticActivation;
+    } else if (activation == "LeakyRelu") {
+      mlas_activation.ActivationKind = MlasLeakyReluActivation;
+      mlas_activation.Parameters.LeakyRelu.alpha =
+          static_cast<const functors::LeakyRelu<T>&>(*this->activation_).alpha;
+    } else if (activation == "HardSigmoid") {
+      const auto& hard_sigmoid = static_cast<const functors::HardSigmoid<T>&>(*this->activation_);
+      mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+      mlas_activation.Parameters.HardSigmoid.alpha = hard_sigmoid.alpha;
+      mlas_activation.Parameters.HardSigmoid.beta = hard_sigmoid.beta;
+    } else {
+      return false;
+    }
+    return true;
   }
 };
 
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// The gated MLP block Y = (activation(X * W_gate) * (X * W_up)) * W_down, where W_gate_up holds the gate columns
+// followed by the up columns. The rows of X are computed in blocks: one GEMM produces the gate and up values of the
+// block, the gated activation is written over the gate values, and the down GEMM reads them from there.
+class GatedMLP final : public OpKernel {
+ public:
+  explicit GatedMLP(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string activation = info.GetAttrOrDefault<std::string>("activation", "Silu");
+    ORT_ENFORCE(activation == "Silu" || activation == "Gelu", "Unsupported activation: ", activation);
+    is_gelu_ = activation == "Gelu";
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // The number of rows of X whose gate and up values are kept at a time.
+  static constexpr size_t kRowBlockSize = 64;
+
+  // Replace the gate values of a row of the gate and up GEMM with activation(gate) * up.
+  void ApplyGatedActivation(float* gate, const float* up, size_t hidden_size) const;
+
+  bool is_gelu_;
+};
+
+void GatedMLP::ApplyGatedActivation(float* gate, const float* up, size_t hidden_size) const {
+  constexpr size_t kChunkSize = 64;
+  float buffer[kChunkSize];
+  for (size_t offset = 0; offset < hidden_size; offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, hidden_size - offset);
+    float* x = gate + offset;
+    const float* u = up + offset;
+    if (is_gelu_) {
+      for (size_t i = 0; i < count; ++i) {
+        buffer[i] = x[i] * static_cast<float>(M_SQRT1_2);
+      }
+      MlasComputeErf(buffer, buffer, count);
+      for (size_t i = 0; i < count; ++i) {
+        x[i] = 0.5f * x[i] * (1.0f + buffer[i]) * u[i];
+      }
+    } else {
+      MlasComputeLogistic(x, buffer, count);
+      for (size_t i = 0; i < count; ++i) {
+        x[i] = x[i] * buffer[i] * u[i];
+      }
+    }
+  }
+}
+
+Status GatedMLP::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W_gate_up = context->Input<Tensor>(1);
+  const Tensor* W_down = context->Input<Tensor>(2);
+
+  const auto& x_shape = X->Shape();
+  ORT_RETURN_IF_NOT(x_shape.NumDimensions() >= 1, "Input X is expected to have at least 1 dimension");
+  const size_t K = narrow<size_t>(x_shape[x_shape.NumDimensions() - 1]);
+  const size_t M = narrow<size_t>(x_shape.SizeToDimension(x_shape.NumDimensions() - 1));
+
+  const auto& gate_up_shape = W_gate_up->Shape();
+  ORT_RETURN_IF_NOT(gate_up_shape.NumDimensions() == 2 && narrow<size_t>(gate_up_shape[0]) == K &&
+                        gate_up_shape[1] % 2 == 0,
+                    "Input W_gate_up is expected to have shape (", K, ", 2 * hidden_size), got ", gate_up_shape);
+  const size_t hidden_size = narrow<size_t>(gate_up_shape[1]) / 2;
+
+  const auto& down_shape = W_down->Shape();
+  ORT_RETURN_IF_NOT(down_shape.NumDimensions() == 2 && narrow<size_t>(down_shape[0]) == hidden_size,
+                    "Input W_down is expected to have shape (", hidden_size, ", N), got ", down_shape);
+  const size_t N = narrow<size_t>(down_shape[1]);
+
+  TensorShapeVector y_dims = x_shape.AsShapeVector();
+  y_dims.back() = down_shape[1];
+  Tensor* Y = context->Output(0, y_dims);
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  float* y_data = Y->MutableData<float>();
+  if (hidden_size == 0 || K == 0) {
+    std::fill_n(y_data, M * N, 0.0f);
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const size_t block_size = std::min(kRowBlockSize, M);
+  auto gate_up = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(block_size) * 2 * hidden_size);
+
+  const float* x_data = X->Data<float>();
+  const float* gate_up_data = W_gate_up->Data<float>();
+  const float* down_data = W_down->Data<float>();
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const TensorOpCost cost{static_cast<double>(hidden_size * sizeof(float) * 2),
+                          static_cast<double>(hidden_size * sizeof(float)),
+                          static_cast<double>(hidden_size) * 16.0};
+
+  for (size_t first_row = 0; first_row < M; first_row += block_size) {
+    const size_t num_rows = std::min(block_size, M - first_row);
+    float* block = gate_up.get();
+
+    MlasGemm(CblasNoTrans, CblasNoTrans, num_rows, 2 * hidden_size, K, 1.0f, x_data + first_row * K, K,
+             gate_up_data, 2 * hidden_size, 0.0f, block, 2 * hidden_size, tp);
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_rows), cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t row = begin; row != end; ++row) {
+            float* gate = block + static_cast<size_t>(row) * 2 * hidden_size;
+            ApplyGatedActivation(gate, gate + hidden_size, hidden_size);
+          }
+        });
+
+    MlasGemm(CblasNoTrans, CblasNoTrans, num_rows, N, hidden_size, 1.0f, block, 2 * hidden_size,
+             down_data, N, 0.0f, y_data + first_row * N, N, tp);
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    GatedMLP,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    GatedMLP);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/group_norm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                                                \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                \
+      GroupNorm,                                                                                \
+      kMSDomain,                                                                                \
+      1,                                                                                        \
+      T,                                                                                        \
+      kCpuExecutionProvider,                                                                    \
+      KernelDefBuilder()                                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                                \
+          .TypeConstraint("M", BuildKernelDefConstraints<float, MLFloat16>()),                  \
+      GroupNorm<T>);                                                                            \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                \
+      SkipGroupNorm,                                                                            \
+      kMSDomain,                                                                                \
+      1,                                                                                        \
+      T,                                                                                        \
+      kCpuExecutionProvider,                                                                    \
+      KernelDefBuilder()                                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                                \
+          .TypeConstraint("M", BuildKernelDefConstraints<float, MLFloat16>()),                  \
+      GroupNorm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+template <typename T>
+void LoadFloats(const T* source, float* destination, size_t count);
+
+template <>
+void LoadFloats(const float* source, float* destination, size_t count) {
+  std::copy_n(source, count, destination);
+}
+
+template <>
+void LoadFloats(const MLFloat16* source, float* destination, size_t count) {
+  MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(source), destination, count);
+}
+
+template <typename T>
+void StoreFloats(const float* source, T* destination, size_t count);
+
+template <>
+void StoreFloats(const float* source, float* destination, size_t count) {
+  std::copy_n(source, count, destination);
+}
+
+template <>
+void StoreFloats(const float* source, MLFloat16* destination, size_t count) {
+  MlasConvertFloatToHalfBuffer(source, reinterpret_cast<MLAS_FP16*>(destination), count);
+}
+
+// gamma and beta may be float or float16
+std::vector<float> LoadParameter(const Tensor& parameter) {
+  std::vector<float> values(static_cast<size_t>(parameter.Shape().Size()));
+  if (parameter.IsDataType<float>()) {
+    LoadFloats(parameter.Data<float>(), values.data(), values.size());
+  } else {
+    LoadFloats(parameter.Data<MLFloat16>(), values.data(), values.size());
+  }
+  return values;
+}
+
+template <typename T>
+struct GroupNormParams {
+  const T* input;
+  // skip is either of the shape of the input, or broadcast with one value per (batch, channel)
+  const T* skip;
+  bool broadcast_skip;
+  const float* bias;
+  const float* gamma;
+  const float* beta;
+  T* output;
+  T* add_out;
+  int64_t num_channels;
+  int64_t spatial_size;
+  int64_t channels_per_group;
+  bool channels_last;
+  bool use_swish_activation;
+  float epsilon;
+};
+
+// Normalizes the group g of the batch n. The group is made of contiguous spans: a span per pixel of the channels of
+// the group in NHWC, and a span per channel of the group of all the pixels in NCHW.
+template <typename T>
+void ComputeGroup(const GroupNormParams<T>& p, int64_t n, int64_t g, std::vector<float>& scratch) {
+  const int64_t channels_per_group = p.channels_per_group;
+  const int64_t first_channel = g * channels_per_group;
+  const int64_t num_spans = p.channels_last ? p.spatial_size : channels_per_group;
+  const size_t span_length = static_cast<size_t>(p.channels_last ? channels_per_group : p.spatial_size);
+  const auto span_offset = [&](int64_t i) {
+    return p.channels_last ? (n * p.spatial_size + i) * p.num_channels + first_channel
+                           : (n * p.num_channels + first_channel + i) * p.spatial_size;
+  };
+
+  scratch.resize(2 * span_length + 3 * static_cast<size_t>(channels_per_group));
+  float* values = scratch.data();
+  float* temp = values + span_length;
+  float* channel_add = temp + span_length;
+  float* scale = channel_add + channels_per_group;
+  float* shift = scale + channels_per_group;
+
+  const bool has_skip = p.skip != nullptr;
+  if (has_skip) {
+    for (int64_t c = 0; c < channels_per_group; ++c) {
+      const int64_t channel = first_channel + c;
+      channel_add[c] = p.bias != nullptr ? p.bias[channel] : 0.0f;
+      if (p.broadcast_skip) {
+        channel_add[c] += static_cast<float>(p.skip[n * p.num_channels + channel]);
+      }
+    }
+  }
+
+  // First pass: the sum of the input, skip and bias, and its statistics. The sum is written to add_out, or to the
+  // output if there is no add_out, for the second pass.
+  T* sum_out = p.add_out != nullptr ? p.add_out : p.output;
+  double count = 0;
+  double mean = 0;
+  double m2 = 0;
+  for (int64_t i = 0; i < num_spans; ++i) {
+    const int64_t offset = span_offset(i);
+    LoadFloats(p.input + offset, values, span_length);
+    if (has_skip) {
+      if (!p.broadcast_skip) {
+        LoadFloats(p.skip + offset, temp, span_length);
+        for (size_t j = 0; j < span_length; ++j) {
+          values[j] += temp[j];
+        }
+      }
+      if (p.channels_last) {
+        for (size_t j = 0; j < span_length; ++j) {
+          values[j] += channel_add[j];
+        }
+      } else {
+        const float add = channel_add[i];
+        for (size_t j = 0; j < span_length; ++j) {
+          values[j] += add;
+        }
+      }
+      StoreFloats(values, sum_out + offset, span_length);
+    }
+
+    float span_sum = 0;
+    for (size_t j = 0; j < span_length; ++j) {
+      span_sum += values[j];
+    }
+    const float span_mean = span_sum / static_cast<float>(span_length);
+    float span_m2 = 0;
+    for (size_t j = 0; j < span_length; ++j) {
+      const float deviation = values[j] - span_mean;
+      span_m2 += deviation * deviation;
+    }
+
+    // Chan et al.: merge the mean and the sum of squared deviations of the span with those of the previous spans
+    const double span_count = static_cast<double>(span_length);
+    const double delta = static_cast<double>(span_mean) - mean;
+    const double merged_count = count + span_count;
+    mean += delta * span_count / merged_count;
+    m2 += static_cast<double>(span_m2) + delta * delta * count * span_count / merged_count;
+    count = merged_count;
+  }
+
+  const float variance = static_cast<float>(m2 / count);
+  const float inverse_std_dev = 1.0f / std::sqrt(variance + p.epsilon);
+  for (int64_t c = 0; c < channels_per_group; ++c) {
+    scale[c] = p.gamma[first_channel + c] * inverse_std_dev;
+    shift[c] = p.beta[first_channel + c] - static_cast<float>(mean) * scale[c];
+  }
+
+  // Second pass: normalize, apply the affine transform and the activation.
+  const T* source = has_skip ? sum_out : p.input;
+  for (int64_t i = 0; i < num_spans; ++i) {
+    const int64_t offset = span_offset(i);
+    LoadFloats(source + offset, values, span_length);
+    if (p.channels_last) {
+      for (size_t j = 0; j < span_length; ++j) {
+        values[j] = values[j] * scale[j] + shift[j];
+      }
+    } else {
+      const float span_scale = scale[i];
+      const float span_shift = shift[i];
+      for (size_t j = 0; j < span_length; ++j) {
+        values[j] = values[j] * span_scale + span_shift;
+      }
+    }
+    if (p.use_swish_activation) {
+      MlasComputeLogistic(values, temp, span_length);
+      for (size_t j = 0; j < span_length; ++j) {
+        values[j] *= temp[j];
+      }
+    }
+    StoreFloats(values, p.output + offset, span_length);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+GroupNorm<T>::GroupNorm(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
+  has_skip_ = op_kernel_info.GetKernelDef().OpName() == "SkipGroupNorm";
+
+  epsilon_ = op_kernel_info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  ORT_ENFORCE(epsilon_ >= 0);
+
+  ORT_ENFORCE(op_kernel_info.GetAttr("groups", &num_groups_).IsOK());
+  ORT_ENFORCE(num_groups_ > 0, "groups must be positive, got ", num_groups_);
+
+  int64_t activation;
+  ORT_ENFORCE(op_kernel_info.GetAttr("activation", &activation).IsOK());
+  ORT_ENFORCE(activation == 0 || activation == 1, "activation must be 0 (None) or 1 (SiLU), got ", activation);
+  use_swish_activation_ = activation == 1;
+
+  channels_last_ = op_kernel_info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(1)) != 0;
+}
+
+template <typename T>
+Status GroupNorm<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* gamma = context->Input<Tensor>(1);
+  const Tensor* beta = context->Input<Tensor>(2);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 4 dimensions, got ", input_dims.size());
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t num_channels = channels_last_ ? input_dims[3] : input_dims[1];
+  const int64_t spatial_size = channels_last_ ? input_dims[1] * input_dims[2] : input_dims[2] * input_dims[3];
+  if (num_channels % num_groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "number of channels ", num_channels, " should be divisible by groups ", num_groups_);
+  }
+
+  for (const Tensor* parameter : {gamma, beta}) {
+    const auto& dims = parameter->Shape().GetDims();
+    if (dims.size() != 1 || dims[0] != num_channels) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "gamma and beta are expected to have the shape (", num_channels, "), got ",
+                             parameter->Shape());
+    }
+  }
+
+  const Tensor* skip = nullptr;
+  const Tensor* bias = nullptr;
+  Tensor* add_out = nullptr;
+  bool broadcast_skip = false;
+  if (has_skip_) {
+    skip = context->Input<Tensor>(3);
+    bias = context->Input<Tensor>(4);
+    add_out = context->Output(1, input->Shape());
+
+    if (bias != nullptr) {
+      const auto& bias_dims = bias->Shape().GetDims();
+      if (bias_dims.size() != 1 || bias_dims[0] != num_channels) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "bias is expected to have the shape (", num_channels, "), got ", bias->Shape());
+      }
+    }
+
+    if (skip->Shape() != input->Shape()) {
+      // the skip of each (batch, channel) is broadcast: (N, C), or (N, 1, 1, C) in NHWC and (N, C, 1, 1) in NCHW
+      const auto& dims = skip->Shape().GetDims();
+      const bool b2 = dims.size() == 2 && dims[0] == batch_size && dims[1] == num_channels;
+      const bool b4 = dims.size() == 4 && dims[0] == batch_size &&
+                      (channels_last_ ? dims[1] == 1 && dims[2] == 1 && dims[3] == num_channels
+                                      : dims[1] == num_channels && dims[2] == 1 && dims[3] == 1);
+      broadcast_skip = b2 || b4;
+      if (!broadcast_skip) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "skip shape is expected to be the input shape, (N, C), or (N, 1, 1, C) in the NHWC "
+                               "layout and (N, C, 1, 1) in the NCHW layout, got ",
+                               skip->Shape());
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const std::vector<float> gamma_data = LoadParameter(*gamma);
+  const std::vector<float> beta_data = LoadParameter(*beta);
+  std::vector<float> bias_data;
+  if (bias != nullptr) {
+    bias_data = LoadParameter(*bias);
+  }
+
+  GroupNormParams<T> params{input->Data<T>(),
+                            skip != nullptr ? skip->Data<T>() : nullptr,
+                            broadcast_skip,
+                            bias != nullptr ? bias_data.data() : nullptr,
+                            gamma_data.data(),
+                            beta_data.data(),
+                            output->MutableData<T>(),
+                            add_out != nullptr ? add_out->MutableData<T>() : nullptr,
+                            num_channels,
+                            spatial_size,
+                            num_channels / num_groups_,
+                            channels_last_,
+                            use_swish_activation_,
+                            epsilon_};
+
+  const double group_size = static_cast<double>(params.channels_per_group * spatial_size);
+  const double bytes_loaded = group_size * sizeof(T) * (skip != nullptr ? 3 : 2);
+  const double bytes_stored = group_size * sizeof(T) * (skip != nullptr ? 2 : 1);
+  const double compute_cycles = group_size * (use_swish_activation_ ? 16 : 6);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size * num_groups_),
+      TensorOpCost{bytes_loaded, bytes_stored, compute_cycles},
+      [&params, this](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> scratch;
+        for (std::ptrdiff_t task = begin; task < end; ++task) {
+          ComputeGroup(params, task / num_groups_, task % num_groups_, scratch);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// GroupNorm and SkipGroupNorm, in the NHWC and NCHW layouts.
+// The (batch, group) pairs are computed in parallel. The statistics of a group are computed in a single pass over the
+// input, merging the mean and the sum of squared deviations of its contiguous spans with Chan's parallel update of
+// Welford's algorithm. A second pass normalizes, applies the affine transform and the optional SiLU.
+template <typename T>
+class GroupNorm final : public OpKernel {
+ public:
+  explicit GroupNorm(const OpKernelInfo& op_kernel_info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  int64_t num_groups_;
+  bool use_swish_activation_;
+  bool channels_last_;
+  bool has_skip_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/framework/sparse_tensor.h"
 #include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math.h"
@@ -125,6 +126,40 @@ struct SparseToDenseCsr {
   }
 };
 
+// Handle the float CSR format of a non-transposed A with the MLAS sparse kernel, which is vectorized along the
+// columns of B and uses the thread pool
+Status SparseToDenseCsrMlas(const ComputeCtx& ctx, const SparseTensor& A, const Tensor& B, Tensor& output,
+                            OpKernelContext& kernel_ctx) {
+  const auto& a_dims = A.DenseShape().GetDims();
+  const auto& out_dims = output.Shape().GetDims();
+  const size_t M = narrow<size_t>(a_dims[0]);
+  const size_t K = narrow<size_t>(a_dims[1]);
+  const size_t N = narrow<size_t>(out_dims[1]);
+  auto csr_view = A.AsCsr();
+
+  MLAS_SPARSE_CSR_GEMM_DATA_PARAMS data;
+  data.RowOffsets = csr_view.Outer().Data<int64_t>();
+  data.ColumnIndices = csr_view.Inner().Data<int64_t>();
+  data.Values = A.Values().Data<float>();
+  data.B = B.Data<float>();
+  data.ldb = N;
+  data.C = output.MutableData<float>();
+  data.ldc = N;
+  data.alpha = ctx.alpha;
+
+  IAllocatorUniquePtr<float> b_transposed;
+  if (ctx.trans_B) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(kernel_ctx.GetTempSpaceAllocator(&alloc));
+    b_transposed = IAllocator::MakeUniquePtr<float>(alloc, K * N);
+    MlasTranspose(B.Data<float>(), b_transposed.get(), N, K);
+    data.B = b_transposed.get();
+  }
+
+  MlasSparseCsrGemm(M, N, 1, &data, kernel_ctx.GetOperatorThreadPool());
+  return Status::OK();
+}
+
 template <typename T>
 inline T Mul(T a_value, float, T b_value) {
   return a_value * b_value;
@@ -223,7 +258,11 @@ Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_NOT(A->Values().Shape().Size() == csr_view.Inner().Shape().Size(),
                       "Expecting the same number NNZ == size of Inner indices");
     ORT_RETURN_IF_NOT((A_shape.GetDims()[0] + 1) == csr_view.Outer().Shape().Size(), "Outer size must be M + 1");
-    t_disp.Invoke<SparseToDenseCsr>(compute_ctx, *A, *B, *output);
+    if (A->IsDataType<float>() && !compute_ctx.trans_A) {
+      ORT_RETURN_IF_ERROR(SparseToDenseCsrMlas(compute_ctx, *A, *B, *output, *ctx));
+    } else {
+      t_disp.Invoke<SparseToDenseCsr>(compute_ctx, *A, *B, *output);
+    }
   } else {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Currently support only COO and CSR(x64) formats");
   }
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// MatMul of a batch with a base weight plus a low-rank adapter per batch entry. The adapters of all the entries are
+// stacked in lora_a and lora_b, and the entries that select the same adapter one after the other are computed
+// together as one segment, so there is a pair of small GEMMs per segment instead of a Run per adapter.
+class MultiLoRAMatMul final : public OpKernel {
+ public:
+  explicit MultiLoRAMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Consecutive rows of the output that use the same adapter.
+  struct Segment {
+    size_t first_row;
+    size_t num_rows;
+    size_t adapter;
+  };
+};
+
+Status MultiLoRAMatMul::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* lora_a = context->Input<Tensor>(2);
+  const Tensor* lora_b = context->Input<Tensor>(3);
+  const Tensor* adapter_indices = context->Input<Tensor>(4);
+
+  const auto& x_shape = X->Shape();
+  ORT_RETURN_IF_NOT(x_shape.NumDimensions() == 3, "Input X is expected to have 3 dimensions, got ",
+                    x_shape.NumDimensions());
+  const size_t batch_size = narrow<size_t>(x_shape[0]);
+  const size_t sequence_length = narrow<size_t>(x_shape[1]);
+  const size_t K = narrow<size_t>(x_shape[2]);
+
+  const auto& w_shape = W->Shape();
+  ORT_RETURN_IF_NOT(w_shape.NumDimensions() == 2 && narrow<size_t>(w_shape[0]) == K,
+                    "Input W is expected to have shape (", K, ", N), got ", w_shape);
+  const size_t N = narrow<size_t>(w_shape[1]);
+
+  const auto& a_shape = lora_a->Shape();
+  const auto& b_shape = lora_b->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() == 3 && narrow<size_t>(a_shape[1]) == K,
+                    "Input lora_a is expected to have shape (num_adapters, ", K, ", rank), got ", a_shape);
+  const size_t num_adapters = narrow<size_t>(a_shape[0]);
+  const size_t rank = narrow<size_t>(a_shape[2]);
+  ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 3 && narrow<size_t>(b_shape[0]) == num_adapters &&
+                        narrow<size_t>(b_shape[1]) == rank && narrow<size_t>(b_shape[2]) == N,
+                    "Input lora_b is expected to have shape (", num_adapters, ", ", rank, ", ", N, "), got ",
+                    b_shape);
+  ORT_RETURN_IF_NOT(adapter_indices->Shape().NumDimensions() == 1 &&
+                        narrow<size_t>(adapter_indices->Shape()[0]) == batch_size,
+                    "Input adapter_indices is expected to have shape (", batch_size, "), got ",
+                    adapter_indices->Shape());
+
+  Tensor* Y = context->Output(0, {x_shape[0], x_shape[1], w_shape[1]});
+  const size_t M = batch_size * sequence_length;
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  float* y_data = Y->MutableData<float>();
+  const float* x_data = X->Data<float>();
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // Every row goes through the base weight in a single GEMM.
+  MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, x_data, K, W->Data<float>(), N, 0.0f, y_data, N, tp);
+
+  // A negative index leaves the rows of the batch entry with the base weight only.
+  const int32_t* indices = adapter_indices->Data<int32_t>();
+  InlinedVector<Segment> segments;
+  for (size_t b = 0; b < batch_size; ++b) {
+    const int32_t index = indices[b];
+    ORT_RETURN_IF_NOT(index < static_cast<int32_t>(num_adapters), "adapter_indices[", b, "] = ", index,
+                      " is out of range, there are ", num_adapters, " adapters");
+    if (index < 0) {
+      continue;
+    }
+    const size_t adapter = static_cast<size_t>(index);
+    if (!segments.empty() && segments.back().adapter == adapter &&
+        segments.back().first_row + segments.back().num_rows == b * sequence_length) {
+      segments.back().num_rows += sequence_length;
+    } else {
+      segments.push_back(Segment{b * sequence_length, sequence_length, adapter});
+    }
+  }
+
+  if (segments.empty() || rank == 0 || K == 0) {
+    return Status::OK();
+  }
+
+  // The low-rank activations of the longest segment, reused by every segment.
+  size_t max_rows = 0;
+  for (const auto& segment : segments) {
+    max_rows = std::max(max_rows, segment.num_rows);
+  }
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto xa = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(max_rows) * rank);
+
+  const float* a_data = lora_a->Data<float>();
+  const float* b_data = lora_b->Data<float>();
+  for (const auto& segment : segments) {
+    const float* x_segment = x_data + segment.first_row * K;
+    float* y_segment = y_data + segment.first_row * N;
+    MlasGemm(CblasNoTrans, CblasNoTrans, segment.num_rows, rank, K, 1.0f, x_segment, K,
+             a_data + segment.adapter * K * rank, rank, 0.0f, xa.get(), rank, tp);
+    MlasGemm(CblasNoTrans, CblasNoTrans, segment.num_rows, N, rank, 1.0f, xa.get(), rank,
+             b_data + segment.adapter * rank * N, N, 1.0f, y_segment, N, tp);
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MultiLoRAMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>()),
+    MultiLoRAMatMul);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cpu/quantization/matmul_integer_base.h"
@@ -11,6 +12,7 @@
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace onnxruntime {
 namespace contrib {
@@ -35,6 +37,70 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// The zero point of every row of A quantized per row. The rows are quantized symmetrically, so the GEMM has a single
+// zero point of A and only the scales differ between the rows.
+constexpr uint8_t kRowZeroPoint = 128;
+
+// Quantize each row of A with its own scale. The min/max and the quantization of a row are done one after the other,
+// while the row is still in the cache.
+void QuantizeRows(const float* a_data, size_t num_rows, size_t K, uint8_t* a_quant, float* row_scales,
+                  concurrency::ThreadPool* thread_pool) {
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_rows),
+      [&](std::ptrdiff_t row) {
+        const float* a_row = a_data + row * K;
+        float min = 0.0f;
+        float max = 0.0f;
+        if (K > 0) {
+          MlasFindMinMaxElement(a_row, &min, &max, K);
+        }
+        const float abs_max = std::max(std::abs(min), std::abs(max));
+        const float scale = abs_max > 0.0f ? abs_max / 127.0f : 1.0f;
+        row_scales[row] = scale;
+        MlasQuantizeLinear(a_row, a_quant + row * K, K, scale, kRowZeroPoint);
+      },
+      0);
+}
+
+// Converts a tile of the QGEMM output with the scales of B, then applies the scales of the rows of A and the bias
+// while the tile is still in the cache.
+class RowScaleBiasOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  RowScaleBiasOutputProcessor(float* output, size_t ldo, const float* row_scales, const float* column_scales,
+                              const float* bias, MLAS_QUANTIZATION_GRANULARITY column_granularity)
+      : column_processor_(output, ldo, column_scales, nullptr, MLAS_QGEMM_OUTPUT_MODE::ZeroMode, column_granularity),
+        output_(output),
+        ldo_(ldo),
+        row_scales_(row_scales),
+        bias_(bias) {
+  }
+
+  void Process(const int32_t* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n,
+               size_t ldc) const override {
+    column_processor_.Process(C, start_m, start_n, count_m, count_n, ldc);
+    for (size_t m = start_m; m < start_m + count_m; m++) {
+      float* y_row = output_ + m * ldo_ + start_n;
+      const float row_scale = row_scales_[m];
+      if (bias_ != nullptr) {
+        for (size_t n = 0; n < count_n; n++) {
+          y_row[n] = y_row[n] * row_scale + bias_[start_n + n];
+        }
+      } else {
+        for (size_t n = 0; n < count_n; n++) {
+          y_row[n] *= row_scale;
+        }
+      }
+    }
+  }
+
+ private:
+  MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR column_processor_;
+  float* output_;
+  size_t ldo_;
+  const float* row_scales_;
+  const float* bias_;
+};
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -54,7 +120,8 @@ class MatMulIntegerToFloatBase : public MatMulIntegerBase {
                        const Tensor* b_tensor,
                        const Tensor* b_scale,
                        const Tensor* b_zp,
-                       const Tensor* bias_tensor) const;
+                       const Tensor* bias_tensor,
+                       const float* a_row_scales = nullptr) const;
 };
 
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
@@ -66,7 +133,8 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
                                                const Tensor* b_tensor,
                                                const Tensor* b_scale_tensor,
                                                const Tensor* b_zp_tensor,
-                                               const Tensor* bias_tensor) const {
+                                               const Tensor* bias_tensor,
+                                               const float* a_row_scales) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape,
                                      b_tensor ? b_tensor->Shape() : b_shape_,
@@ -126,18 +194,32 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
   const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
+  std::vector<RowScaleBiasOutputProcessor> gemm_row_scale_procs;
   gemm_scale_procs.reserve(num_gemms);
+  gemm_row_scale_procs.reserve(a_row_scales != nullptr ? num_gemms : 0);
   std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
+  const MLAS_QUANTIZATION_GRANULARITY b_scale_granularity =
+      is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix;
 
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
-    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
-                                  gemm_shape.N,
-                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
-                                  bias_data,
-                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
     auto& params = gemm_data_vec[gemm_idx];
-    params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    if (a_row_scales != nullptr) {
+      gemm_row_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                        gemm_shape.N,
+                                        a_row_scales + helper.LeftOffsets()[gemm_idx] / gemm_shape.K,
+                                        b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                        bias_data,
+                                        b_scale_granularity);
+      params.OutputProcessor = &(gemm_row_scale_procs[gemm_idx]);
+    } else {
+      gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                    gemm_shape.N,
+                                    b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                    bias_data,
+                                    MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                    b_scale_granularity);
+      params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    }
     params.A = a_data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
@@ -157,7 +239,9 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    per_row_quantization_ = info.GetAttrOrDefault<int64_t>("per_row_quantization", 0) != 0;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +255,10 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // quantize each row of A with its own scale instead of a single scale for the whole tensor
+  bool per_row_quantization_{false};
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -205,20 +293,29 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
 
-  // calculate quantization parameter of a
   const float* a_data = a->Data<float>();
   int64_t num_of_elements = a->Shape().Size();
-
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  const size_t K = a->Shape().NumDimensions() > 0 ? narrow<size_t>(a->Shape()[a->Shape().NumDimensions() - 1]) : 1;
+  const bool quantize_per_row = per_row_quantization_ && K > 0;
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
   uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
-  BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(std::move(allocator)));
-
-  ParQuantizeLinearStd(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(allocator));
+
+  float a_scale = 1.0f;
+  uint8_t a_zero_point = kRowZeroPoint;
+  IAllocatorUniquePtr<float> a_row_scales;
+  if (quantize_per_row) {
+    const size_t num_rows = narrow<size_t>(num_of_elements) / K;
+    a_row_scales = IAllocator::MakeUniquePtr<float>(allocator, num_rows);
+    QuantizeRows(a_data, num_rows, K, a_data_quant, a_row_scales.get(), ctx->GetOperatorThreadPool());
+  } else {
+    // calculate quantization parameter of a
+    GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+    ParQuantizeLinearStd(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point,
+                         ctx->GetOperatorThreadPool());
+  }
 
   bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
   ORT_RETURN_IF_ERROR(ComputeCommon(
@@ -231,7 +328,8 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
       b,
       is_b_scale_supported ? b_scale_tensor : nullptr,
       b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+      ctx->Input<Tensor>(IN_BIAS),
+      a_row_scales.get()));
 
   if (!is_b_scale_supported) {
     ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
@@ -1,15 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/common/narrow.h"
+#include "core/common/prefetch.h"
 #include "core/common/safeint.h"
 #include "core/framework/float16.h"
 #include "core/framework/int4.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 
@@ -65,6 +69,20 @@ class GatherBlockQuantized : public OpKernel {
                                const int64_t quantize_N,
                                concurrency::ThreadPool* tp) const;
 
+  // Fast path for an embedding table of shape [..., gather_axis_dim, row_size] quantized along its last axis, so
+  // that every gathered row is contiguous and is dequantized block by block.
+  template <typename T2>
+  Status GatherRowsAndDequantize(const T1* data_ptr,
+                                 const Tind* indices_ptr,
+                                 const T2* scales_ptr,
+                                 const T1* zero_points_ptr,
+                                 T2* output_ptr,
+                                 const int64_t gather_M,
+                                 const int64_t gather_N,
+                                 const int64_t gather_axis_dim,
+                                 const int64_t row_size,
+                                 concurrency::ThreadPool* tp) const;
+
  private:
   int64_t gather_axis_;
   int64_t quantize_axis_;
@@ -201,6 +219,88 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
   return Status::OK();
 }
 
+template <typename T1, typename Tind>
+template <typename T2>
+Status GatherBlockQuantized<T1, Tind>::GatherRowsAndDequantize(const T1* data_ptr,
+                                                               const Tind* indices_ptr,
+                                                               const T2* scales_ptr,
+                                                               const T1* zero_points_ptr,
+                                                               T2* output_ptr,
+                                                               const int64_t gather_M,
+                                                               const int64_t gather_N,
+                                                               const int64_t gather_axis_dim,
+                                                               const int64_t row_size,
+                                                               concurrency::ThreadPool* tp) const {
+  for (int64_t i = 0; i < gather_N; ++i) {
+    const auto indices_val = static_cast<int64_t>(indices_ptr[i]);
+    ORT_RETURN_IF_NOT(indices_val >= -gather_axis_dim && indices_val < gather_axis_dim,
+                      "indices element out of data bounds, idx=", indices_val,
+                      " must be within the inclusive range [", -gather_axis_dim, ",", gather_axis_dim - 1, "]");
+  }
+
+  const int64_t blocks_per_row = (row_size + block_size_ - 1) / block_size_;
+
+  auto get_row = [&](int64_t gather_MN_idx) {
+    int64_t indices_val = static_cast<int64_t>(indices_ptr[gather_MN_idx % gather_N]);
+    indices_val = indices_val < 0 ? indices_val + gather_axis_dim : indices_val;
+    return gather_MN_idx / gather_N * gather_axis_dim + indices_val;
+  };
+
+  // the rows are scattered over a table much larger than the cache. prefetch the row a few indices ahead so its
+  // load overlaps with dequantizing the current rows.
+  constexpr int64_t kPrefetchDistance = 4;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp,
+      SafeInt<ptrdiff_t>(gather_M) * gather_N,
+      static_cast<double>(row_size * 3),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        // MLFloat16 rows are dequantized to float and converted in one pass
+        std::vector<float> row_buffer(std::is_same_v<T2, float> ? 0 : narrow<size_t>(row_size));
+
+        for (int64_t index = first, end = last; index < end; ++index) {
+          if (index + kPrefetchDistance < end) {
+            const int64_t next_row = get_row(index + kPrefetchDistance);
+            PrefetchForRead(data_ptr + next_row * row_size / 2, narrow<size_t>(row_size / 2));
+            PrefetchForRead(scales_ptr + next_row * blocks_per_row, narrow<size_t>(blocks_per_row * sizeof(T2)));
+          }
+
+          const int64_t row = get_row(index);
+          const T1* row_data = data_ptr + row * row_size / 2;
+          const T2* row_scales = scales_ptr + row * blocks_per_row;
+          float* row_output;
+          if constexpr (std::is_same_v<T2, float>) {
+            row_output = output_ptr + index * row_size;
+          } else {
+            row_output = row_buffer.data();
+          }
+
+          for (int64_t b = 0; b < blocks_per_row; ++b) {
+            const float scale = static_cast<float>(row_scales[b]);
+            const int64_t zp_idx = row * blocks_per_row + b;
+            const float zp = static_cast<float>(
+                zero_points_ptr ? zero_points_ptr[zp_idx >> 1].GetElem(narrow<size_t>(zp_idx & 1)) : 0);
+
+            // row_size and block_size_ are even, so a block holds whole bytes
+            const T1* block_data = row_data + b * block_size_ / 2;
+            float* block_output = row_output + b * block_size_;
+            const int64_t pair_count = std::min(block_size_, row_size - b * block_size_) / 2;
+            for (int64_t j = 0; j < pair_count; ++j) {
+              block_output[2 * j] = (static_cast<float>(block_data[j].GetElem(0)) - zp) * scale;
+              block_output[2 * j + 1] = (static_cast<float>(block_data[j].GetElem(1)) - zp) * scale;
+            }
+          }
+
+          if constexpr (!std::is_same_v<T2, float>) {
+            MlasConvertFloatToHalfBuffer(row_output, reinterpret_cast<MLAS_FP16*>(output_ptr + index * row_size),
+                                         narrow<size_t>(row_size));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
 template <typename T1, typename Tind>
 Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
   Prepare p;
@@ -238,10 +338,20 @@ Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
   const auto* zero_points_ptr = p.zero_points_tensor ? p.zero_points_tensor->template Data<T1>() : nullptr;
   const auto dequantized_type = p.scales_tensor->GetElementType();
 
+  // gathering whole rows of a table quantized along its rows, e.g. an embedding table
+  const auto data_rank = static_cast<int64_t>(data_shape.NumDimensions());
+  const bool gather_rows = p.gather_axis == data_rank - 2 && p.quantize_axis == data_rank - 1 &&
+                           gather_block % 2 == 0;
+
   if (dequantized_type == ONNX_NAMESPACE::TensorProto::FLOAT) {
     const auto* scales_ptr = p.scales_tensor->template Data<float>();
     auto* output_ptr = p.output_tensor->template MutableData<float>();
 
+    if (gather_rows) {
+      return GatherRowsAndDequantize<float>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr, output_ptr,
+                                           gather_M, gather_N, gather_axis_dim, gather_block, tp);
+    }
+
     return CopyDataAndDequantize<float>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr,
                                         output_ptr, gather_M, gather_N, gather_axis_dim, gather_block,
                                         quantize_axis_dim, quantize_N,
@@ -250,6 +360,11 @@ Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
     const auto* scales_ptr = p.scales_tensor->template Data<MLFloat16>();
     auto* output_ptr = p.output_tensor->template MutableData<MLFloat16>();
 
+    if (gather_rows) {
+      return GatherRowsAndDequantize<MLFloat16>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr, output_ptr,
+                                               gather_M, gather_N, gather_axis_dim, gather_block, tp);
+    }
+
     return CopyDataAndDequantize<MLFloat16>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr,
                                             output_ptr, gather_M, gather_N, gather_axis_dim, gather_block,
                                             quantize_axis_dim, quantize_N,
@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+#include "core/common/safeint.h"
+#include "core/framework/float8.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+ * @brief MatMul with a constant float8 weight of shape [K, N] and a per-tensor or
+ * per-column scale. The weight is packed once and decoded by the MLAS kernel
+ * while computing, so it is never expanded into a float initializer.
+ */
+class MatMulFloat8 final : public OpKernel {
+ public:
+  MatMulFloat8(const OpKernelInfo& info)
+      : OpKernel(info),
+        K_{narrow<size_t>(info.GetAttr<int64_t>("K"))},
+        N_{narrow<size_t>(info.GetAttr<int64_t>("N"))},
+        b_type_{info.node().InputDefs()[1]->TypeAsProto()->tensor_type().elem_type() ==
+                        ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2
+                    ? MlasFp8E5M2
+                    : MlasFp8E4M3FN} {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  const size_t K_;
+  const size_t N_;
+  const MLAS_FP8_TYPE b_type_;
+  IAllocatorUniquePtr<void> packed_b_{};
+};
+
+Status MatMulFloat8::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                             /*out*/ bool& is_packed,
+                             /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    const auto& b_shape = tensor.Shape();
+    ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2 && static_cast<size_t>(b_shape[0]) == K_ &&
+                          static_cast<size_t>(b_shape[1]) == N_,
+                      "MatMulFloat8: B must have the shape [", K_, ", ", N_, "]. Got: ", b_shape);
+
+    const size_t packed_b_size = MlasFp8GemmPackBSize(N_, K_);
+    if (packed_b_size == 0) {
+      return Status::OK();
+    }
+
+    packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+    MlasFp8GemmPackB(N_, K_, static_cast<const uint8_t*>(tensor.DataRaw()), N_, packed_b_.get());
+    is_packed = true;
+
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status MatMulFloat8::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulFloat8::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const Tensor* b_scale = ctx->Input<Tensor>(2);
+
+  TensorShape b_shape({static_cast<int64_t>(K_), static_cast<int64_t>(N_)});
+  if (b != nullptr) {
+    ORT_RETURN_IF_NOT(b->Shape() == b_shape, "MatMulFloat8: B must have the shape ", b_shape, ". Got: ", b->Shape());
+  }
+
+  const size_t scale_count = static_cast<size_t>(b_scale->Shape().Size());
+  ORT_RETURN_IF_NOT(b_scale->Shape().NumDimensions() <= 1 && (scale_count == 1 || scale_count == N_),
+                    "MatMulFloat8: B_scale must be a scalar or a 1D tensor of size N. Got: ", b_scale->Shape());
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0) return Status::OK();
+
+  // pack B here when it was not a constant initializer
+  IAllocatorUniquePtr<void> packed_b_buffer;
+  const void* packed_b = packed_b_.get();
+  if (packed_b == nullptr) {
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+    packed_b_buffer = IAllocator::MakeUniquePtr<void>(allocator, MlasFp8GemmPackBSize(N_, K_), true);
+    MlasFp8GemmPackB(N_, K_, static_cast<const uint8_t*>(b->DataRaw()), N_, packed_b_buffer.get());
+    packed_b = packed_b_buffer.get();
+  }
+
+  const auto* a_data = a->Data<float>();
+  auto* y_data = y->MutableData<float>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t lda = helper.Lda(false);
+
+  std::vector<MLAS_FP8_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = lda;
+    data[i].PackedB = packed_b;
+    data[i].Scale = b_scale->Data<float>();
+    data[i].PerColumnScale = scale_count != 1;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasFp8GemmBatch(b_type_, M, N, K, data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulFloat8,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<Float8E4M3FN>(),
+                               DataTypeImpl::GetTensorType<Float8E5M2>()}),
+    MatMulFloat8);
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
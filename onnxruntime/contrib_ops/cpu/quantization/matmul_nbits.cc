@@ -3,6 +3,7 @@
 
 #include "contrib_ops/cpu/quantization/matmul_nbits_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <type_traits>
 
@@ -11,6 +12,7 @@
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_gemm_postprocessor.h"
 #include "core/mlas/inc/mlas_qnbit.h"
 #include "core/mlas/inc/mlas_q4.h"
 #include "core/providers/cpu/math/matmul_helper.h"
@@ -29,7 +31,9 @@ constexpr size_t A = 0,
                  scales = 2,
                  zero_points = 3,
                  g_idx = 4,
-                 bias = 5;
+                 bias = 5,
+                 gate = 6,
+                 skip = 7;
 };
 
 typedef enum {
@@ -73,6 +77,141 @@ GetComputeType<MLFloat16>(size_t nbits, size_t block_size, int64_t accuracy_leve
 }
 #endif  // !MLAS_F16VEC_INTRINSICS_SUPPORTED || !MLAS_TARGET_ARM64
 
+// The activation that MatMulNBitsFusion folds into the node from the node that consumed its output.
+enum class Activation {
+  None,
+  Gelu,
+  Silu,
+};
+
+Activation ParseActivation(const std::string& activation) {
+  if (activation.empty()) {
+    return Activation::None;
+  }
+
+  if (activation == "Gelu") {
+    return Activation::Gelu;
+  }
+
+  if (activation == "Silu") {
+    return Activation::Silu;
+  }
+
+  ORT_THROW("Unsupported activation for MatMulNBits: ", activation);
+}
+
+// Y = activation(Y) * gate + skip for `count` consecutive values of a row of the output. gate and skip are optional.
+void ApplyEpilogue(Activation activation, float* y, const float* gate, const float* skip, size_t count) {
+  constexpr size_t kChunkSize = 64;
+  constexpr float kSqrt1_2 = 0.70710678118654752440f;
+  float buffer[kChunkSize];
+  for (size_t i = 0; i < count; i += kChunkSize) {
+    const size_t chunk_size = std::min(kChunkSize, count - i);
+    float* values = y + i;
+    if (activation == Activation::Gelu) {
+      for (size_t j = 0; j < chunk_size; ++j) {
+        buffer[j] = values[j] * kSqrt1_2;
+      }
+      MlasComputeErf(buffer, buffer, chunk_size);
+      for (size_t j = 0; j < chunk_size; ++j) {
+        values[j] = 0.5f * values[j] * (buffer[j] + 1.0f);
+      }
+    } else if (activation == Activation::Silu) {
+      MlasComputeLogistic(values, buffer, chunk_size);
+      for (size_t j = 0; j < chunk_size; ++j) {
+        values[j] *= buffer[j];
+      }
+    }
+
+    if (gate != nullptr) {
+      for (size_t j = 0; j < chunk_size; ++j) {
+        values[j] *= gate[i + j];
+      }
+    }
+
+    if (skip != nullptr) {
+      for (size_t j = 0; j < chunk_size; ++j) {
+        values[j] += skip[i + j];
+      }
+    }
+  }
+}
+
+// The epilogue of the output of one GEMM of the batch. MlasQNBitGemmBatch applies it to each output tile right after
+// the tile is computed, so the output is not read again by separate activation, Mul and Add nodes. gate and skip have
+// the same layout as the output.
+template <typename T>
+class MatMulNBitsEpilogue final : public MLAS_GEMM_POSTPROCESSOR<T> {
+ public:
+  MatMulNBitsEpilogue(Activation activation, const T* gate, const T* skip)
+      : activation_{activation}, gate_{gate}, skip_{skip} {}
+
+  void Process(T* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n, size_t ldc) const override;
+
+ private:
+  const Activation activation_;
+  const T* gate_;
+  const T* skip_;
+};
+
+template <>
+void MatMulNBitsEpilogue<float>::Process(float* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n,
+                                         size_t ldc) const {
+  for (size_t m = start_m; m < start_m + count_m; ++m) {
+    const size_t offset = m * ldc + start_n;
+    ApplyEpilogue(activation_, C + offset, gate_ == nullptr ? nullptr : gate_ + offset,
+                  skip_ == nullptr ? nullptr : skip_ + offset, count_n);
+  }
+}
+
+template <>
+void MatMulNBitsEpilogue<MLFloat16>::Process(MLFloat16* C, size_t start_m, size_t start_n, size_t count_m,
+                                             size_t count_n, size_t ldc) const {
+  constexpr size_t kChunkSize = 64;
+  float values[kChunkSize];
+  float gate[kChunkSize];
+  float skip[kChunkSize];
+  for (size_t m = start_m; m < start_m + count_m; ++m) {
+    for (size_t n = 0; n < count_n; n += kChunkSize) {
+      const size_t chunk_size = std::min(kChunkSize, count_n - n);
+      const size_t offset = m * ldc + start_n + n;
+      MlasConvertHalfToFloatBuffer(C + offset, values, chunk_size);
+      if (gate_ != nullptr) {
+        MlasConvertHalfToFloatBuffer(gate_ + offset, gate, chunk_size);
+      }
+      if (skip_ != nullptr) {
+        MlasConvertHalfToFloatBuffer(skip_ + offset, skip, chunk_size);
+      }
+      ApplyEpilogue(activation_, values, gate_ == nullptr ? nullptr : gate, skip_ == nullptr ? nullptr : skip,
+                    chunk_size);
+      MlasConvertFloatToHalfBuffer(values, C + offset, chunk_size);
+    }
+  }
+}
+
+// Applies the epilogue to the whole output of a GEMM that does not take a post processor.
+template <typename T>
+void ApplyEpilogueToOutput(const MatMulNBitsEpilogue<T>& epilogue, T* C, size_t M, size_t N,
+                           concurrency::ThreadPool* thread_pool) {
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(M), static_cast<double>(N) * 8.0,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        epilogue.Process(C, static_cast<size_t>(begin), 0, static_cast<size_t>(end - begin), N, N);
+      });
+}
+
+// A float copy of a float16 gate or skip input, or nullptr if the input is missing.
+IAllocatorUniquePtr<float> ConvertToFloat(const Tensor* tensor, AllocatorPtr& allocator) {
+  if (tensor == nullptr) {
+    return {};
+  }
+
+  const size_t size = static_cast<size_t>(tensor->Shape().Size());
+  auto result = IAllocator::MakeUniquePtr<float>(allocator, size, true);
+  MlasConvertHalfToFloatBuffer(tensor->Data<MLFloat16>(), result.get(), size);
+  return result;
+}
+
 }  // namespace
 
 bool GetType(const NodeArg& node_arg, int32_t& type) {
@@ -99,7 +238,8 @@ class MatMulNBits final : public OpKernel {
         nbits_{narrow<size_t>(info.GetAttr<int64_t>("bits"))},
         has_g_idx_{info.GetInputCount() > InputIndex::g_idx && info.node().InputDefs()[InputIndex::g_idx]->Exists()},
         has_bias_{info.GetInputCount() > InputIndex::bias && info.node().InputDefs()[InputIndex::bias]->Exists()},
-        compute_type_{GetComputeType<T1>(nbits_, block_size_, info.GetAttr<int64_t>("accuracy_level"))} {
+        compute_type_{GetComputeType<T1>(nbits_, block_size_, info.GetAttr<int64_t>("accuracy_level"))},
+        activation_{ParseActivation(info.GetAttrOrDefault<std::string>("activation", ""))} {
     const auto& node = info.node();
     auto input_defs = node.InputDefs();
     const NodeArg* zero_point_arg =
@@ -111,8 +251,8 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4,
-                "Only 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(nbits_ >= 2 && nbits_ <= 4,
+                "Only 2b, 3b and 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
   }
@@ -141,9 +281,14 @@ class MatMulNBits final : public OpKernel {
   size_t packed_b_size_{0};
   IAllocatorUniquePtr<float> scales_fp32_{};
   IAllocatorUniquePtr<float> bias_fp32_{};
+  const Activation activation_;
 
   bool has_zp_input_{false};
 
+  bool HasEpilogue(const Tensor* gate, const Tensor* skip) const {
+    return activation_ != Activation::None || gate != nullptr || skip != nullptr;
+  }
+
   // dequantize B first and then compute float gemm
   Status ComputeBUnpacked(const Tensor* a,
                           const Tensor* b,
@@ -151,6 +296,8 @@ class MatMulNBits final : public OpKernel {
                           const Tensor* zero_points,
                           const Tensor* reorder_idx,
                           const Tensor* bias,
+                          const Tensor* gate,
+                          const Tensor* skip,
                           Tensor* y,
                           AllocatorPtr& allocator,
                           concurrency::ThreadPool* thread_pool,
@@ -162,6 +309,8 @@ class MatMulNBits final : public OpKernel {
                         const Tensor* scales,
                         const Tensor* zero_points,
                         const Tensor* bias,
+                        const Tensor* gate,
+                        const Tensor* skip,
                         Tensor* y,
                         AllocatorPtr& allocator,
                         concurrency::ThreadPool* thread_pool,
@@ -305,6 +454,8 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
                                        const Tensor* scales,
                                        const Tensor* zero_points,
                                        const Tensor* bias,
+                                       const Tensor* gate,
+                                       const Tensor* skip,
                                        Tensor* y,
                                        AllocatorPtr& allocator,
                                        concurrency::ThreadPool* thread_pool,
@@ -329,6 +480,18 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
     workspace = IAllocator::MakeUniquePtr<std::byte>(allocator, workspace_size, true);
   }
 
+  const auto* gate_data = gate == nullptr ? nullptr : gate->Data<T1>();
+  const auto* skip_data = skip == nullptr ? nullptr : skip->Data<T1>();
+  InlinedVector<MatMulNBitsEpilogue<T1>> epilogues;
+  if (HasEpilogue(gate, skip)) {
+    epilogues.reserve(batch_count);
+    for (size_t i = 0; i < batch_count; ++i) {
+      const size_t offset = helper.OutputOffsets()[i];
+      epilogues.emplace_back(activation_, gate_data == nullptr ? nullptr : gate_data + offset,
+                             skip_data == nullptr ? nullptr : skip_data + offset);
+    }
+  }
+
   InlinedVector<MLAS_QNBIT_GEMM_DATA_PARAMS<T1>> data(batch_count);
   for (size_t i = 0; i < batch_count; ++i) {
     data[i].A = a_data + helper.LeftOffsets()[i];
@@ -342,6 +505,7 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
     data[i].Bias = bias_data;
     data[i].C = y_data + helper.OutputOffsets()[i];
     data[i].ldc = N;
+    data[i].PostProcessor = epilogues.empty() ? nullptr : &epilogues[i];
   }
   MlasQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type_, data.data(), workspace.get(),
                      thread_pool);
@@ -354,6 +518,8 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
                                               const Tensor* scales,
                                               const Tensor* zero_points,
                                               const Tensor* bias,
+                                              const Tensor* gate,
+                                              const Tensor* skip,
                                               Tensor* y,
                                               AllocatorPtr& allocator,
                                               concurrency::ThreadPool* thread_pool,
@@ -405,6 +571,18 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
   size_t c_size = static_cast<size_t>(y->Shape().Size());
   std::vector<float> c_v(c_size);
 
+  const auto gate_fp32 = ConvertToFloat(gate, allocator);
+  const auto skip_fp32 = ConvertToFloat(skip, allocator);
+  InlinedVector<MatMulNBitsEpilogue<float>> epilogues;
+  if (HasEpilogue(gate, skip)) {
+    epilogues.reserve(batch_count);
+    for (size_t i = 0; i < batch_count; ++i) {
+      const size_t offset = helper.OutputOffsets()[i];
+      epilogues.emplace_back(activation_, gate_fp32 ? gate_fp32.get() + offset : nullptr,
+                             skip_fp32 ? skip_fp32.get() + offset : nullptr);
+    }
+  }
+
   InlinedVector<MLAS_QNBIT_GEMM_DATA_PARAMS<float>> data(batch_count);
   for (size_t i = 0; i < batch_count; ++i) {
     data[i].A = tmp_a_data_ptr.get() + helper.LeftOffsets()[i];
@@ -420,6 +598,7 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
     data[i].Bias = bias ? bias_ptr : nullptr;
     data[i].C = c_v.data() + helper.OutputOffsets()[i];
     data[i].ldc = N;
+    data[i].PostProcessor = epilogues.empty() ? nullptr : &epilogues[i];
   }
   MlasQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type_, data.data(), workspace.get(),
                      thread_pool);
@@ -435,6 +614,8 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
                                             const Tensor* zero_points,
                                             const Tensor* reorder_idx,
                                             const Tensor* bias,
+                                            const Tensor* gate,
+                                            const Tensor* skip,
                                             Tensor* y,
                                             AllocatorPtr& allocator,
                                             concurrency::ThreadPool* thread_pool,
@@ -456,7 +637,34 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
+  if (nbits_ != 4) {
+    // 2b and 3b weights are not handled by MlasQNBitGemm, dequantize them with the generic bit stream decoder
+    if (zero_points && zero_points->IsDataType<float>()) {
+      DequantizeBlockwiseNBits<float, float>(
+          tmp_b_data_ptr.get(),                         // dequantized output
+          b_data,                                       // quantized input
+          scales_data,                                  // quantization scales
+          static_cast<const float*>(zero_points_data),  // quantization zero points
+          reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
+          static_cast<int32_t>(block_size_),  // quantization block size
+          static_cast<int32_t>(K_),           // number of rows in quantized input
+          static_cast<int32_t>(N_),           // number of columns in quantized input
+          thread_pool);
+    } else {
+      DequantizeBlockwiseNBits<float, uint8_t>(
+          tmp_b_data_ptr.get(),                           // dequantized output
+          b_data,                                         // quantized input
+          scales_data,                                    // quantization scales
+          static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
+          reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
+          static_cast<int32_t>(block_size_),  // quantization block size
+          static_cast<int32_t>(K_),           // number of rows in quantized input
+          static_cast<int32_t>(N_),           // number of columns in quantized input
+          thread_pool);
+    }
+  } else if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
     // dequantize b, only 4b quantization is supported for now
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
@@ -533,6 +741,17 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
   MlasGemmBatch(CblasNoTrans, CblasTrans,
                 M, N, K, data.data(), batch_count, thread_pool);
 
+  if (HasEpilogue(gate, skip)) {
+    const auto* gate_data = gate == nullptr ? nullptr : gate->Data<float>();
+    const auto* skip_data = skip == nullptr ? nullptr : skip->Data<float>();
+    for (size_t i = 0; i < batch_count; ++i) {
+      const size_t offset = helper.OutputOffsets()[i];
+      MatMulNBitsEpilogue<float> epilogue(activation_, gate_data == nullptr ? nullptr : gate_data + offset,
+                                          skip_data == nullptr ? nullptr : skip_data + offset);
+      ApplyEpilogueToOutput(epilogue, data[i].C, M, N, thread_pool);
+    }
+  }
+
   return Status::OK();
 }
 
@@ -543,6 +762,8 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
                                                 const Tensor* zero_points,
                                                 const Tensor* reorder_idx,
                                                 const Tensor* bias,
+                                                const Tensor* gate,
+                                                const Tensor* skip,
                                                 Tensor* y,
                                                 AllocatorPtr& allocator,
                                                 concurrency::ThreadPool* thread_pool,
@@ -575,7 +796,34 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
+  if (nbits_ != 4) {
+    // 2b and 3b weights are not handled by MlasQNBitGemm, dequantize them with the generic bit stream decoder
+    if (zero_points && zero_points->IsDataType<MLFloat16>()) {
+      DequantizeBlockwiseNBits<float, MLFloat16>(
+          tmp_b_data_ptr.get(),                             // dequantized output
+          b_data,                                           // quantized input
+          scales_ptr,                                       // quantization scales
+          static_cast<const MLFloat16*>(zero_points_data),  // quantization zero points
+          reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
+          static_cast<int32_t>(block_size_),  // quantization block size
+          static_cast<int32_t>(K_),           // number of rows in quantized input
+          static_cast<int32_t>(N_),           // number of columns in quantized input
+          thread_pool);
+    } else {
+      DequantizeBlockwiseNBits<float, uint8_t>(
+          tmp_b_data_ptr.get(),                           // dequantized output
+          b_data,                                         // quantized input
+          scales_ptr,                                     // quantization scales
+          static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
+          reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
+          static_cast<int32_t>(block_size_),  // quantization block size
+          static_cast<int32_t>(K_),           // number of rows in quantized input
+          static_cast<int32_t>(N_),           // number of columns in quantized input
+          thread_pool);
+    }
+  } else if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
     // dequantize b, only 4b quantization is supported for now
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
@@ -666,6 +914,18 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
   }
 
   MlasGemmBatch(CblasNoTrans, CblasTrans, M, N, K, data.data(), batch_count, thread_pool);
+
+  if (HasEpilogue(gate, skip)) {
+    const auto gate_fp32 = ConvertToFloat(gate, allocator);
+    const auto skip_fp32 = ConvertToFloat(skip, allocator);
+    for (size_t i = 0; i < batch_count; ++i) {
+      const size_t offset = helper.OutputOffsets()[i];
+      MatMulNBitsEpilogue<float> epilogue(activation_, gate_fp32 ? gate_fp32.get() + offset : nullptr,
+                                          skip_fp32 ? skip_fp32.get() + offset : nullptr);
+      ApplyEpilogueToOutput(epilogue, data[i].C, M, N, thread_pool);
+    }
+  }
+
   MlasConvertFloatToHalfBuffer(tmp_c_ptr.get(), y_data, c_size);
   return Status::OK();
 }
@@ -678,12 +938,18 @@ Status MatMulNBits<T1>::Compute(OpKernelContext* ctx) const {
   const Tensor* zero_points = ctx->Input<Tensor>(InputIndex::zero_points);
   const Tensor* reorder_idx = ctx->Input<Tensor>(InputIndex::g_idx);
   const Tensor* bias = ctx->Input<Tensor>(InputIndex::bias);
+  const Tensor* gate = ctx->Input<Tensor>(InputIndex::gate);
+  const Tensor* skip = ctx->Input<Tensor>(InputIndex::skip);
 
   TensorShape b_shape({static_cast<int64_t>(N_), static_cast<int64_t>(K_)});
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, false, true));
 
   Tensor* y = ctx->Output(0, helper.OutputShape());
+  ORT_RETURN_IF(gate != nullptr && gate->Shape() != y->Shape(),
+                "Input gate is expected to have the output shape ", y->Shape(), ", got ", gate->Shape());
+  ORT_RETURN_IF(skip != nullptr && skip->Shape() != y->Shape(),
+                "Input skip is expected to have the output shape ", y->Shape(), ", got ", skip->Shape());
 
   // Bail out early if the output is going to be empty
   if (y->Shape().Size() == 0) {
@@ -706,13 +972,14 @@ Status MatMulNBits<T1>::Compute(OpKernelContext* ctx) const {
                     // MlasQNBitGemmPackQuantBDataSize() returns 0, we can consider calling MlasQNBitGemmBatch()
                     // with B directly too.
     if (MlasIsQNBitGemmAvailable(nbits_, block_size_, compute_type_)) {
-      return ComputeBPacked(a, scales, zero_points, bias, y, allocator, thread_pool, helper);
+      return ComputeBPacked(a, scales, zero_points, bias, gate, skip, y, allocator, thread_pool, helper);
     }
   }
 
   // If B is prepacked, B would have been removed from the context
   const Tensor* b = ctx->Input<Tensor>(InputIndex::B);
-  return ComputeBUnpacked(a, b, scales, zero_points, reorder_idx, bias, y, allocator, thread_pool, helper);
+  return ComputeBUnpacked(a, b, scales, zero_points, reorder_idx, bias, gate, skip, y, allocator, thread_pool,
+                          helper);
 }
 
 #define REGISTER_MatMulNBits(T1)                                            \
@@ -102,6 +102,70 @@ void DequantizeBlockwise(
       });
 }
 
+namespace {
+
+// Extract the value at bit offset `bit_offset` of a little-endian bit stream.
+inline int ExtractBits(const uint8_t* data, size_t bit_offset, int bits) {
+  const size_t byte_idx = bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  uint32_t value = data[byte_idx] >> shift;
+  if (shift + bits > 8) {
+    value |= static_cast<uint32_t>(data[byte_idx + 1]) << (8 - shift);
+  }
+  return static_cast<int>(value & ((1u << bits) - 1));
+}
+
+}  // namespace
+
+template <typename inputT, typename zeroT>
+void DequantizeBlockwiseNBits(
+    inputT* output,              // dequantized output
+    const uint8_t* quant_data,   // quantized input
+    const inputT* scales_data,   // quantization scales
+    const zeroT* zero_points,    // quantization zero points
+    const int32_t* reorder_idx,  // reorder_idx for groupwise quantization
+    int32_t bits,                // number of bits per quantized value
+    int32_t block_size,          // quantization block size
+    int32_t K,                   // number of rows in quantized input
+    int32_t N,                   // number of columns in quantized input
+    onnxruntime::concurrency::ThreadPool* pool) {
+  assert(bits >= 2 && bits <= 4);
+  const size_t blocks_per_col = (static_cast<size_t>(K) + block_size - 1) / block_size;
+  const size_t blob_size = (static_cast<size_t>(block_size) * bits + 7) / 8;
+  const size_t zp_bytes_per_col = (blocks_per_col * bits + 7) / 8;
+  const float default_zp = static_cast<float>(1 << (bits - 1));
+
+  const double cost = static_cast<double>(K) * 4.0;
+  concurrency::ThreadPool::TryParallelFor(
+      pool, static_cast<std::ptrdiff_t>(N), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t n = begin; n < end; n++) {
+          const uint8_t* col_data = quant_data + n * blocks_per_col * blob_size;
+          const inputT* col_scales = scales_data + n * blocks_per_col;
+          inputT* col_output = output + n * static_cast<size_t>(K);
+
+          for (int32_t k = 0; k < K; k++) {
+            const size_t blk = static_cast<size_t>(k) / block_size;
+            const size_t rid = reorder_idx ? static_cast<size_t>(reorder_idx[k]) : blk;
+
+            float zp = default_zp;
+            if (zero_points) {
+              if constexpr (std::is_same_v<zeroT, uint8_t>) {
+                zp = static_cast<float>(ExtractBits(zero_points + n * zp_bytes_per_col, rid * bits, bits));
+              } else {
+                zp = static_cast<float>(zero_points[n * blocks_per_col + rid]);
+              }
+            }
+
+            const size_t bit_offset = static_cast<size_t>(k % block_size) * bits;
+            const float q = static_cast<float>(ExtractBits(col_data + blk * blob_size, bit_offset, bits));
+            const float scale = static_cast<float>(col_scales[rid]);
+            col_output[k] = static_cast<inputT>((q - zp) * scale);
+          }
+        }
+      });
+}
+
 template void DequantizeBlockwise<float, uint8_t>(
     float* output, const uint8_t* quant_data, const float* scales_data,
     const uint8_t* zero_points, const int32_t* reorder_idx, int32_t block_size,
@@ -117,5 +181,20 @@ template void DequantizeBlockwise<float, MLFloat16>(
     const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t block_size,
     bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
+template void DequantizeBlockwiseNBits<float, uint8_t>(
+    float* output, const uint8_t* quant_data, const float* scales_data,
+    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
+    int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+
+template void DequantizeBlockwiseNBits<float, float>(
+    float* output, const uint8_t* quant_data, const float* scales_data,
+    const float* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
+    int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+
+template void DequantizeBlockwiseNBits<float, MLFloat16>(
+    float* output, const uint8_t* quant_data, const float* scales_data,
+    const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
+    int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -59,6 +59,12 @@ void ComputeJob(
   T* p_output = output_data + offset;
   T* p_skip_input_bias_add_output = skip_input_bias_add_output_data == nullptr ? nullptr : skip_input_bias_add_output_data + offset;
 
+  if constexpr (std::is_same_v<T, float>) {
+    MlasLayerNormOneRow(p_input, p_skip, bias_data, gamma_data, beta_data, static_cast<size_t>(hidden_size), epsilon,
+                        simplified, p_output, p_skip_input_bias_add_output, nullptr, nullptr);
+    return;
+  }
+
   T mean(0.0f);
   T mean_square(0.0f);
 
@@ -162,39 +168,22 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   const int64_t skip_size = skip ? skip->Shape().Size() : prepacked_skip_fp32_size_;
 
   if constexpr (std::is_same_v<T, MLFloat16>) {
-    const size_t total_data_size = static_cast<size_t>(input->Shape().Size());
-
     AllocatorPtr alloc;
     ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-    IAllocatorUniquePtr<float> input_fp32;
-    IAllocatorUniquePtr<float> output_fp32;
-    IAllocatorUniquePtr<float> skip_input_bias_add_output_fp32;
+    // The input and the outputs stay in fp16, the MLAS kernel normalizes each row in fp32.
     IAllocatorUniquePtr<float> skip_fp32;
     IAllocatorUniquePtr<float> gamma_fp32;
     IAllocatorUniquePtr<float> beta_fp32;
     IAllocatorUniquePtr<float> bias_fp32;
 
-    const float* input_data_f = nullptr;
     const float* skip_data_f = nullptr;
     const float* gamma_data_f = nullptr;
     const float* beta_data_f = nullptr;
     const float* bias_data_f = nullptr;
-    float* output_data_f = nullptr;
-    float* skip_input_bias_add_output_data_f = nullptr;
 
     const size_t num_elems = static_cast<size_t>(hidden_size);
 
-    input_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    MlasConvertHalfToFloatBuffer(input_data, input_fp32.get(), total_data_size);
-    input_data_f = input_fp32.get();
-
-    output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    output_data_f = output_fp32.get();
-
-    skip_input_bias_add_output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    skip_input_bias_add_output_data_f = skip_input_bias_add_output_fp32.get();
-
     if (skip_data) {
       skip_fp32 = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(skip_size));
       MlasConvertHalfToFloatBuffer(skip_data, skip_fp32.get(), static_cast<size_t>(skip_size));
@@ -230,13 +219,13 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
     concurrency::ThreadPool::TryBatchParallelFor(
         p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
         [&](ptrdiff_t task_idx) {
-          ComputeJob(input_data_f, skip_data_f, gamma_data_f, beta_data_f, bias_data_f, task_idx, hidden_size, skip_size,
-                     epsilon_, simplified, output_data_f, skip_input_bias_add_output_data_f);
+          const int64_t offset = task_idx * hidden_size;
+          MlasLayerNormOneRow(input_data + offset, skip_data_f + (offset % skip_size), bias_data_f, gamma_data_f,
+                              beta_data_f, num_elems, epsilon_, simplified, output_data + offset,
+                              skip_input_bias_add_output_data == nullptr ? nullptr : skip_input_bias_add_output_data + offset,
+                              nullptr, nullptr);
         },
         0);
-    MlasConvertFloatToHalfBuffer(output_data_f, output_data, total_data_size);
-    if (skip_input_bias_add_output_data != nullptr)
-      MlasConvertFloatToHalfBuffer(skip_input_bias_add_output_data_f, skip_input_bias_add_output_data, total_data_size);
   } else {
     concurrency::ThreadPool::TryBatchParallelFor(
         p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
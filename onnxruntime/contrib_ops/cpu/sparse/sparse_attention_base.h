@@ -66,14 +66,6 @@ class SparseAttentionBase {
     int past_buffer_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
     int present_buffer_sequence_length = static_cast<int>(present_key->Shape().GetDims()[2]);
 
-    // Allocate a buffer to store Softmax(QK)
-    bool attention_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
-                                    MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * parameters.total_sequence_length *
-                   (attention_mlas_supported ? sizeof(T) : sizeof(float));
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
     bool past_present_share_buffer = parameters.past_present_share_buffer;
     assert(past_present_share_buffer);
 
@@ -82,6 +74,23 @@ class SparseAttentionBase {
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
     const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
 
+    if constexpr (std::is_same<T, float>::value) {
+      ComputeBlockSparseAttention(
+          output->MutableData<T>(), Q, k, v, total_key_lengths->Data<int32_t>(),
+          batch_size, sequence_length, parameters.total_sequence_length, present_buffer_sequence_length, head_size,
+          parameters.hidden_size, present_key->MutableData<T>(), present_value->MutableData<T>(), packed_qkv,
+          block_row_indices->Data<int32_t>(), block_col_indices->Data<int32_t>(), parameters, tp);
+      return Status::OK();
+    }
+
+    // Allocate a buffer to store Softmax(QK)
+    bool attention_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
+                                    MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * parameters.total_sequence_length *
+                   (attention_mlas_supported ? sizeof(T) : sizeof(float));
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
     if (attention_mlas_supported) {
       ComputeAttentionProbs(
           static_cast<T*>(attention_probs), Q, k, total_key_lengths->Data<int32_t>(),
@@ -116,6 +125,205 @@ class SparseAttentionBase {
   }
 
  private:
+  // Block sparse attention for float. The work is split into (batch, head, row block) items, where a row block is
+  // the query rows within one block row of the sparse layout. An item computes Q x K' only for the active blocks of
+  // its block row, with one batched GEMM for the full blocks, so the scores are a compact M x (active blocks x
+  // block size) matrix. After the causal mask and softmax of those scores, P x V is accumulated block by block.
+  // Items are sorted by their number of active blocks, so the thread pool hands out the heaviest items first.
+  template <typename T>
+  void ComputeBlockSparseAttention(
+      T* output,                              // buffer for the result with size BxSxNxH
+      const T* Q,                             // query start pointer
+      const T* K,                             // key start pointer
+      const T* V,                             // value start pointer
+      const int32_t* total_key_lengths,       // total key sequence lengths (past + new)
+      int batch_size,                         // batch size
+      int sequence_length,                    // sequence length of query or new key
+      int total_sequence_length,              // maximum past_sequence_length + sequence_length
+      int present_buffer_sequence_length,     // sequence length of present_key or present_value
+      int head_size,                          // head size of Q, K, V
+      int hidden_size,                        // hidden size of Output
+      T* present_key,                         // present key that shares buffer with past key
+      T* present_value,                       // present value that shares buffer with past value
+      bool packed_qkv,                        // whether Q, K, V are packed
+      const int32_t* block_row_indices,       // block row indices
+      const int32_t* block_col_indices,       // block column indices
+      SparseAttentionParameters& parameters,  // parameters
+      ThreadPool* tp) const {                 // thread pool
+    const bool is_prompt = (total_sequence_length == sequence_length);
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;
+    const int block_size = parameters.sparse_block_size;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    auto past_seq_len_of = [&](int batch_index) {
+      return is_prompt ? 0 : static_cast<int>(total_key_lengths[batch_index]) - sequence_length;
+    };
+
+    // Append the new key and value to the cache once per kv head, before any head of Q reads them.
+    TensorOpCost copy_cost;
+    copy_cost.compute_cycles = 0;
+    copy_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(2) * input_chunk_length * sizeof(T));
+    copy_cost.bytes_stored = copy_cost.bytes_loaded;
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, copy_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / kv_num_heads_);
+            const int head_index = static_cast<int>(i % kv_num_heads_);
+            const size_t offset = i * present_buff_chunk_length +
+                                  static_cast<size_t>(past_seq_len_of(batch_index)) * head_size;
+            const ptrdiff_t chunk_offset = packed_qkv
+                                               ? packed_batch_stride * batch_index + input_chunk_length * head_index
+                                               : SafeInt<ptrdiff_t>(input_chunk_length) * i;
+            memcpy(present_key + offset, K + chunk_offset, input_chunk_length * sizeof(T));
+            memcpy(present_value + offset, V + chunk_offset, input_chunk_length * sizeof(T));
+          }
+        });
+
+    struct WorkItem {
+      int batch_index;
+      int head_index;
+      int row_block;
+      int active_blocks;
+    };
+
+    // Build the work items from the block rows that the new query tokens of each batch fall into.
+    std::vector<WorkItem> items;
+    for (int batch_index = 0; batch_index < batch_size; batch_index++) {
+      const int past_seq_len = past_seq_len_of(batch_index);
+      const int first_row_block = past_seq_len / block_size;
+      const int last_row_block = (past_seq_len + sequence_length - 1) / block_size;
+      for (int head_index = 0; head_index < num_heads_; head_index++) {
+        const int32_t* layout_row_indices =
+            block_row_indices + (head_index % parameters.num_sparse_layout) * parameters.stride_row_indices;
+        for (int row_block = first_row_block; row_block <= last_row_block; row_block++) {
+          const int active_blocks = layout_row_indices[row_block + 1] - layout_row_indices[row_block];
+          items.push_back({batch_index, head_index, row_block, active_blocks});
+        }
+      }
+    }
+    std::stable_sort(items.begin(), items.end(), [](const WorkItem& a, const WorkItem& b) {
+      return a.active_blocks > b.active_blocks;
+    });
+
+    size_t total_active_blocks = 0;
+    for (const auto& item : items) {
+      total_active_blocks += static_cast<size_t>(item.active_blocks);
+    }
+    const double average_active_blocks =
+        items.empty() ? 0.0 : static_cast<double>(total_active_blocks) / static_cast<double>(items.size());
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = 4.0 * block_size * block_size * head_size * average_active_blocks;
+    unit_cost.bytes_loaded = (2.0 * block_size * head_size * average_active_blocks + block_size * head_size) *
+                             sizeof(T);
+    unit_cost.bytes_stored = static_cast<double>(block_size) * head_size * sizeof(T);
+
+    DUMP_CPU_TENSOR_INIT();
+    DUMP_CPU_STRING("block_sparse_items=", items.size(), ",average_active_blocks=", average_active_blocks);
+
+    ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(items.size()), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          std::vector<float> scores;
+          std::vector<int> active_cols;
+          std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params;
+
+          for (std::ptrdiff_t item_index = begin; item_index != end; ++item_index) {
+            const WorkItem& item = items[item_index];
+            const int batch_index = item.batch_index;
+            const int head_index = item.head_index;
+            const int past_seq_len = past_seq_len_of(batch_index);
+            const int layout_id = head_index % parameters.num_sparse_layout;
+            const int32_t* layout_row_indices = block_row_indices + layout_id * parameters.stride_row_indices;
+            const int32_t* layout_col_indices = block_col_indices + layout_id * parameters.stride_col_indices;
+
+            // Query rows [q_begin, q_end) of this block row, and the causal length of its last row.
+            const int q_begin = std::max(item.row_block * block_size, past_seq_len) - past_seq_len;
+            const int q_end =
+                std::min((item.row_block + 1) * block_size, past_seq_len + sequence_length) - past_seq_len;
+            const int rows = q_end - q_begin;
+            const int max_causal_length = past_seq_len + q_end;
+
+            active_cols.clear();
+            for (int j = layout_row_indices[item.row_block]; j < layout_row_indices[item.row_block + 1]; j++) {
+              if (layout_col_indices[j] * block_size < max_causal_length) {
+                active_cols.push_back(layout_col_indices[j]);
+              }
+            }
+            if (active_cols.empty()) {
+              continue;
+            }
+
+            const size_t ld_scores = active_cols.size() * block_size;
+            scores.resize(static_cast<size_t>(rows) * ld_scores);
+
+            const int kv_index = batch_index * kv_num_heads_ + head_index / kv_num_heads_factor;
+            const T* k = present_key + kv_index * present_buff_chunk_length;
+            const T* v = present_value + kv_index * present_buff_chunk_length;
+            const T* q;
+            if (packed_qkv) {
+              q = Q + packed_batch_stride * batch_index + input_chunk_length * head_index;
+            } else {
+              q = Q + input_chunk_length * (batch_index * num_heads_ + head_index);
+            }
+            q += static_cast<size_t>(q_begin) * head_size;
+
+            // Q x K' of the full blocks in one batch, and of the block cut by the causal length on its own.
+            gemm_params.clear();
+            for (size_t a = 0; a < active_cols.size(); a++) {
+              const int col_begin = active_cols[a] * block_size;
+              const int cols = std::min(block_size, max_causal_length - col_begin);
+              MLAS_SGEMM_DATA_PARAMS params;
+              params.A = q;
+              params.lda = head_size;
+              params.B = k + static_cast<size_t>(col_begin) * head_size;
+              params.ldb = head_size;
+              params.C = scores.data() + a * block_size;
+              params.ldc = ld_scores;
+              params.alpha = alpha;
+              params.beta = 0.0f;
+              if (cols == block_size) {
+                gemm_params.push_back(params);
+              } else {
+                MlasGemm(CblasNoTrans, CblasTrans, rows, cols, head_size, params, nullptr);
+              }
+            }
+            if (!gemm_params.empty()) {
+              MlasGemmBatch(CblasNoTrans, CblasTrans, rows, block_size, head_size, gemm_params.data(),
+                            gemm_params.size(), nullptr);
+            }
+
+            // Mask the columns after the causal length of each row, then softmax.
+            for (int m = 0; m < rows; m++) {
+              const int causal_length = past_seq_len + q_begin + m + 1;
+              float* row_scores = scores.data() + m * ld_scores;
+              for (size_t a = 0; a < active_cols.size(); a++) {
+                const int col_begin = active_cols[a] * block_size;
+                const int valid = std::clamp(causal_length - col_begin, 0, block_size);
+                std::fill(row_scores + a * block_size + valid, row_scores + (a + 1) * block_size,
+                          std::numeric_limits<float>::lowest());
+              }
+            }
+            ComputeAttentionSoftmaxInplace(scores.data(), rows, static_cast<int>(ld_scores), nullptr);
+
+            // P x V accumulated over the active blocks.
+            T* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size +
+                                static_cast<size_t>(q_begin) * hidden_size;
+            for (size_t a = 0; a < active_cols.size(); a++) {
+              const int col_begin = active_cols[a] * block_size;
+              const int cols = std::min(block_size, max_causal_length - col_begin);
+              MlasGemm(CblasNoTrans, CblasNoTrans, rows, head_size, cols, 1.0f, scores.data() + a * block_size,
+                       ld_scores, v + static_cast<size_t>(col_begin) * head_size, head_size, a == 0 ? 0.0f : 1.0f,
+                       output_current, hidden_size, nullptr);
+            }
+          }
+        });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -8,23 +8,17 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/providers/cpu/text/string_slices.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
 
-#ifdef _MSC_VER
-#include <memory_resource>
-#define ORT_PMR_ALLOCATOR_SUPPORTED
-#endif
-
-#include <optional>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
-#ifdef ORT_PMR_ALLOCATOR_SUPPORTED
-using SlicesVector = std::pmr::vector<re2::StringPiece>;
-#else
-using SlicesVector = std::vector<re2::StringPiece>;
-#endif
-
 namespace onnxruntime {
 namespace contrib {
 
@@ -45,14 +39,21 @@ class Tokenizer final : public OpKernel {
   Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
                       gsl::span<const int64_t> input_dims) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      gsl::span<const int64_t> input_dims) const;
+  // Appends one row of tokens to rows for every string of input_span
+  using TokenizeBlockFn = Status (Tokenizer::*)(gsl::span<const std::string> input_span, StringSlices& rows) const;
+
+  // Runs tokenize_block over blocks of the input on the intra-op thread pool and writes the output.
+  Status TokenizeInParallel(OpKernelContext* ctx, gsl::span<const int64_t> input_dims,
+                            TokenizeBlockFn tokenize_block) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         gsl::span<const int64_t> input_dims) const;
+  Status SeparatorExpressionTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const;
 
-  void OutputData(gsl::span<const SlicesVector> rows,
+  // Used instead of SeparatorExpressionTokenize when every separator is a single ASCII character.
+  Status ByteSeparatorTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const;
+
+  Status TokenExpressionTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const;
+
+  void OutputData(const StringSlices& rows,
                   size_t max_tokens, size_t max_output_index, std::string* output_data) const;
 
   bool mark_{false};
@@ -61,6 +62,13 @@ class Tokenizer final : public OpKernel {
   bool char_tokenezation_{false};
   InlinedVector<std::unique_ptr<re2::RE2>> separators_;
   std::unique_ptr<re2::RE2> regex_;
+  // Set when all the separators are single ASCII characters
+  std::array<bool, 256> separator_bytes_{};
+  size_t separator_byte_count_{0};
+  char single_separator_byte_{0};
+
+  // Inputs of less bytes than this are tokenized by a single thread
+  static constexpr size_t kMinBytesPerBlock = 16 * 1024;
 };
 
 using namespace utf8_util;
@@ -76,6 +84,21 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 constexpr char kStartMarker = 0x2;
 constexpr char kEndMarker = 0x3;
+
+// Returns the character matched by a separator made of one ASCII character, escaped or not, and -1 for
+// the other regular expressions.
+int GetSeparatorByte(const std::string& separator) {
+  constexpr std::string_view kRegexSpecialChars = "\\.^$|?*+()[]{}";
+  if (separator.size() == 1 && static_cast<unsigned char>(separator[0]) < 0x80 &&
+      kRegexSpecialChars.find(separator[0]) == std::string_view::npos) {
+    return separator[0];
+  }
+  if (separator.size() == 2 && separator[0] == '\\' &&
+      kRegexSpecialChars.find(separator[1]) != std::string_view::npos) {
+    return separator[1];
+  }
+  return -1;
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -126,6 +149,17 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
         }
         separators_.push_back(std::move(regex));
       }
+      separator_byte_count_ = separators.size();
+      for (const auto& sep : separators) {
+        const int byte = GetSeparatorByte(sep);
+        if (byte < 0) {
+          separator_bytes_.fill(false);
+          separator_byte_count_ = 0;
+          break;
+        }
+        separator_bytes_[byte] = true;
+        single_separator_byte_ = static_cast<char>(byte);
+      }
     } else {
       // Use tokenexp
       assert(!tokenexp.empty());
@@ -169,8 +203,10 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   auto const input_data = X->Data<std::string>();
   auto curr_input = input_data;
   auto const last = input_data + N * C;
+  size_t total_bytes = 0;
   while (curr_input != last) {
     const auto& s = *curr_input;
+    total_bytes += s.size();
     size_t tokens = 0;  // length in utf8 chars
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        tokens)) {
@@ -199,127 +235,54 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      output_data[output_index].assign(&kStartMarker, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      assert(token_idx + tlen <= str_len);
-      output_data[output_index] = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      output_data[output_index].assign(&kEndMarker, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      output_data[output_index] = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
-  }
+
+  // Every string fills its own row of the output so the rows are written in parallel
+  const double average_bytes = static_cast<double>(total_bytes) / static_cast<double>(N * C);
+  const TensorOpCost cost{average_bytes, static_cast<double>(max_tokens * sizeof(std::string)),
+                          static_cast<double>(max_tokens) * 4.0};
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(N * C), cost,
+      [&](std::ptrdiff_t first_row, std::ptrdiff_t last_row) {
+        for (std::ptrdiff_t row = first_row; row < last_row; ++row) {
+          const auto& s = input_data[row];
+          size_t output_index = static_cast<size_t>(row) * max_tokens;
+          if (mark_) {
+            output_data[output_index].assign(&kStartMarker, 1);
+            ++output_index;
+          }
+          size_t tokens = 0;
+          const size_t str_len = s.size();
+          for (size_t token_idx = 0; token_idx < str_len;) {
+            size_t tlen = 0;
+            [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+            assert(result);
+            assert(token_idx + tlen <= str_len);
+            output_data[output_index].assign(s.data() + token_idx, tlen);
+            ++output_index;
+            token_idx += tlen;
+            ++tokens;
+          }
+          if (mark_) {
+            output_data[output_index].assign(&kEndMarker, 1);
+            ++output_index;
+          }
+          // Padding strings
+          assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
+          const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
+          for (size_t p = 0; p < pads; ++p) {
+            output_data[output_index] = pad_value_;
+            ++output_index;
+          }
+        }
+      });
   return Status::OK();
 }
 
-namespace {
-
-// We use std::vector in this case, because InlinedVector::clear() is incompatible
-// with std::vector. It also deallocates memory, which is not what we want.
-
-// The compiler we are using GCC on Linux and Clang on MacOS does not
-// have the library that support C++17 PMR. So we are only using it on Windows
-// since the problem is acute on the platform.
-
-#ifdef ORT_PMR_ALLOCATOR_SUPPORTED
-/// <summary>
-/// This class provides a thin abstraction over the std::pmr::monotonic_buffer_resource
-/// If the allocated buffer is not enough, additional allocations are done using
-/// new/delete.
-/// </summary>
-class MonotonicAllocatorWithDefault : public std::pmr::monotonic_buffer_resource {
- public:
-  MonotonicAllocatorWithDefault(void* ptr, size_t size_in_bytes)
-      : monotonic_buffer_resource(ptr, size_in_bytes, std::pmr::get_default_resource()) {}
-  MonotonicAllocatorWithDefault(void* ptr, size_t size_in_bytes, std::pmr::memory_resource* upstream)
-      : monotonic_buffer_resource(ptr, size_in_bytes, upstream) {}
-};
-
-class MemoryAllocator {
- public:
-  explicit MemoryAllocator(size_t num_of_slices) {
-    size_t allocated_size = 0;
-    void* ptr = AlignedAllocate(num_of_slices, allocated_size);
-    resource_.emplace(ptr, allocated_size);
-  }
-
-  SlicesVector CreateVectorWithAllocator() {
-    return SlicesVector(&resource_.value());
-  }
-
-  SlicesVector& EmplaceBack(std::vector<SlicesVector>& rows) {
-    return rows.emplace_back(&resource_.value());
-  }
-
- private:
-  /// <summary>
-  /// Pre-allocate memory for the tokens to reduce a number of individual
-  /// allocations and thus memory contention.
-  /// Used in conjunction with PMR memory allocatior
-  /// </summary>
-  /// <param name="num">number of objects of T</param>
-  /// <param name="buf">buffer holder</param>
-  /// <param name="allocated_size">aligned allocated size</param>
-  /// <returns>pointer to the buffer</returns>
-  void* AlignedAllocate(size_t num, size_t& allocated_size) {
-    constexpr size_t alignment = alignof(re2::StringPiece);
-    const size_t size_bytes = SafeInt<size_t>(num) * sizeof(re2::StringPiece) + alignment;
-    buf_holder_ = std::make_unique<uint8_t[]>(size_bytes);
-    void* ptr = buf_holder_.get();
-    allocated_size = size_bytes;
-    return std::align(alignment, size_bytes, ptr, allocated_size);
-  }
-
-  std::unique_ptr<uint8_t[]> buf_holder_;
-  std::optional<MonotonicAllocatorWithDefault> resource_;
-};
-
-#else
-
-class MemoryAllocator {
- public:
-  explicit MemoryAllocator(size_t /* num_of_slices */) {
-  }
-
-  SlicesVector CreateVectorWithAllocator() const {
-    return SlicesVector{};
-  }
-
-  SlicesVector& EmplaceBack(std::vector<SlicesVector>& rows) const {
-    return rows.emplace_back();
-  }
-};
-
-#endif
-}  // namespace
-
-void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
+void Tokenizer::OutputData(const StringSlices& rows,
                            size_t max_tokens, [[maybe_unused]] size_t max_output_index, std::string* output_data) const {
   size_t output_index = 0;
-  for (const auto& row : rows) {
+  for (size_t row_index = 0; row_index < rows.NumRows(); ++row_index) {
+    const auto row = rows.Row(row_index);
     [[maybe_unused]] size_t c_idx = output_index;
     if (mark_) {
       output_data[output_index++].assign(&kStartMarker, 1);
@@ -340,13 +303,72 @@ void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
   }
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               gsl::span<const int64_t> input_dims) const {
-  using namespace re2;
-
+Status Tokenizer::TokenizeInParallel(OpKernelContext* ctx, gsl::span<const int64_t> input_dims,
+                                     TokenizeBlockFn tokenize_block) const {
   auto X = ctx->Input<Tensor>(0);
   const auto input_span = X->DataAsSpan<std::string>();
+  auto* thread_pool = ctx->GetOperatorThreadPool();
+
+  // Cut the input in blocks of consecutive strings so that every thread collects the tokens of a block.
+  // Short inputs stay in one block as the work would not pay for the scheduling.
+  size_t total_bytes = 0;
+  for (const auto& s : input_span) {
+    total_bytes += s.size();
+  }
+  const std::ptrdiff_t num_rows = narrow<std::ptrdiff_t>(input_span.size());
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>({num_rows,
+                                   static_cast<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool)),
+                                   static_cast<std::ptrdiff_t>(total_bytes / kMinBytesPerBlock)}));
+  auto block_first_row = [num_rows, num_blocks](std::ptrdiff_t block) {
+    return static_cast<size_t>(num_rows * block / num_blocks);
+  };
+
+  std::vector<StringSlices> block_rows(num_blocks);
+  std::vector<Status> block_status(num_blocks);
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    const size_t first = block_first_row(block);
+    const size_t last = block_first_row(block + 1);
+    block_status[block] = (this->*tokenize_block)(input_span.subspan(first, last - first), block_rows[block]);
+  });
+
+  size_t max_tokens = 0;
+  for (std::ptrdiff_t block = 0; block < num_blocks; ++block) {
+    ORT_RETURN_IF_ERROR(block_status[block]);
+    max_tokens = std::max(max_tokens, block_rows[block].MaxRowSize());
+  }
+
+  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
+  // Check if we have no output due to either empty input
+  // or everything is a separator
+  if (max_tokens == 0) {
+    output_dims.push_back(0);
+    TensorShape output_shape(output_dims);
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  if (mark_) {
+    max_tokens += 2;  // Start/end markers as separate tokens
+  }
+
+  output_dims.push_back(max_tokens);
+  TensorShape output_shape(output_dims);
+
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->MutableData<std::string>();
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    const size_t first = block_first_row(block);
+    const size_t last = block_first_row(block + 1);
+    OutputData(block_rows[block], max_tokens, (last - first) * max_tokens, output_data + first * max_tokens);
+  });
+
+  return Status::OK();
+}
+
+Status Tokenizer::SeparatorExpressionTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const {
+  using namespace re2;
 
   // Let's estimate maximum number of tokens
   // It is hard to estimate the number of separate characters that would not appear in the
@@ -354,20 +376,12 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
   size_t total_tokens_estimate = 0;
   size_t max_tokens_per_row = 0;
   ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
-  // Add a scratch token vector allocation
-  total_tokens_estimate += max_tokens_per_row;
+  rows.Reserve(input_span.size(), total_tokens_estimate);
 
-  // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
-
-  // Re-use the same vector for each tokenization round
-  SlicesVector tokens = allocator.CreateVectorWithAllocator();
+  // Re-use the same vectors for each tokenization round
+  std::vector<StringPiece> row;
+  std::vector<StringPiece> tokens;
+  row.reserve(max_tokens_per_row);
   tokens.reserve(max_tokens_per_row);
 
   // We do not constraint the search to match
@@ -376,18 +390,9 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 
   // Scan all strings and attempt to find separators in them
   // collect all the output tokens here
-  size_t max_tokens = 0;
   for (const auto& s : input_span) {
     size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                  utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    const auto expected_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-    auto& row = allocator.EmplaceBack(rows);
-    row.reserve(expected_tokens);
+    row.clear();
     row.emplace_back(s);
 
     for (const auto& sep : separators_) {
@@ -438,10 +443,9 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
         } while (match);
       }  // row
 
-      // We want to preserve the buffer for the next separator
-      // copying slices is cheaper than allocating new memory
+      // Both buffers are kept for the next separator and the next row
       if (!tokens.empty()) {
-        row = tokens;
+        row.swap(tokens);
         tokens.clear();
         continue;
       }
@@ -451,58 +455,66 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
       tokens.clear();
       break;
     }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-  }
-
-  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // or everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+    for (const auto& token : row) {
+      rows.Add(std::string_view(token.data(), token.length()));
+    }
+    rows.EndRow();
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
+  return Status::OK();
+}
 
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
+Status Tokenizer::ByteSeparatorTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const {
+  size_t total_tokens_estimate = 0;
+  size_t max_tokens_per_row = 0;
+  ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
+  rows.Reserve(input_span.size(), total_tokens_estimate);
 
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
+  // Splitting on every separator at once gives the same tokens as splitting on one separator after the other:
+  // a piece dropped for being shorter than mincharnum would only be cut into shorter pieces by the next ones.
+  // The separators are ASCII so they never match a byte inside of a multi-byte utf8 character.
+  const bool single_separator = separator_byte_count_ == 1;
+  for (const auto& s : input_span) {
+    const char* token = s.data();
+    const char* const end = token + s.size();
+    for (;;) {
+      const char* next = end;
+      if (single_separator) {
+        next = static_cast<const char*>(std::memchr(token, single_separator_byte_, end - token));
+        if (next == nullptr) {
+          next = end;
+        }
+      } else {
+        next = std::find_if(token, end, [this](char c) { return separator_bytes_[static_cast<unsigned char>(c)]; });
+      }
+      const size_t token_len = next - token;
+      // a utf8 character takes at least one byte, so a shorter token can not have enough characters
+      if (token_len >= mincharnum_) {
+        size_t utf8_chars = 0;
+        utf8_len(reinterpret_cast<const unsigned char*>(token), token_len, utf8_chars);
+        if (utf8_chars >= mincharnum_) {
+          rows.Add(std::string_view(token, token_len));
+        }
+      }
+      if (next == end) {
+        break;
+      }
+      token = next + 1;
+    }
+    rows.EndRow();
+  }
 
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  gsl::span<const int64_t> input_dims) const {
+Status Tokenizer::TokenExpressionTokenize(gsl::span<const std::string> input_span, StringSlices& rows) const {
   using namespace re2;
 
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  const auto input_span = X->DataAsSpan<std::string>();
-
   // Let's estimate maximum number of tokens
   size_t total_tokens_estimate = 0;
   size_t max_tokens_per_row = 0;
   ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
-
-  // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  // We use std::vector in this case, because InlinedVector::clear() is incompatible
-  // with std::vector. It also deallocates memory, which is not what we want.
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
+  rows.Reserve(input_span.size(), total_tokens_estimate);
 
   // We do not constraint the search to match
   // on the beginning or end of the string
@@ -512,12 +524,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
     size_t utf8_chars = 0;
     utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars);
 
-    auto& row = allocator.EmplaceBack(rows);
-
     if (utf8_chars >= mincharnum_) {
-      auto estimated_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-      row.reserve(estimated_tokens);
-
       StringPiece text(s);
       const auto end_pos = s.length();
       size_t start_pos = 0;
@@ -540,7 +547,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                           "Match contains invalid utf8 chars: " + std::string{submatch});
           }
           if (utf8_chars >= mincharnum_) {
-            row.push_back(submatch);
+            rows.Add(std::string_view(submatch.data(), submatch.length()));
             start_pos = match_pos + token_len;
           } else {
             size_t bytes = 0;
@@ -550,32 +557,9 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
         }
       } while (match);
     }
-    max_tokens = std::max(max_tokens, row.size());
+    rows.EndRow();
   }
 
-  // Check for empty output
-  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
-
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
-
   return Status::OK();
 }
 
@@ -620,11 +604,13 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
   if (char_tokenezation_) {
     s = CharTokenize(ctx, N, C, input_dims);
   } else {
-    if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
+    if (separator_byte_count_ > 0) {
+      s = TokenizeInParallel(ctx, input_dims, &Tokenizer::ByteSeparatorTokenize);
+    } else if (!separators_.empty()) {
+      s = TokenizeInParallel(ctx, input_dims, &Tokenizer::SeparatorExpressionTokenize);
     } else {
       assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
+      s = TokenizeInParallel(ctx, input_dims, &Tokenizer::TokenExpressionTokenize);
     }
   }
   return s;
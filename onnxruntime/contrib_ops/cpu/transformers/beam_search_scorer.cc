@@ -170,10 +170,11 @@ void BeamSearchScorer::Process(ISequences& sequences,
     if (static_cast<size_t>(beam_hyp.beams_used_) < num_beams_)
       continue;
 
+    // The batch is done when no candidate can beat the worst finished hypothesis. The candidates of the batch are
+    // sorted by score, so the first one has the best sum of log probabilities.
     if (!early_stopping_) {
-      gsl::span<const float> topk_scores = next_scores.subspan(batch * num_beams_, top_k);
-      const auto best_sum_logprobs = std::max_element(topk_scores.begin(), topk_scores.end());
-      if (beam_hyp.CanImprove(*best_sum_logprobs, sequence_length))
+      const float best_sum_logprobs = next_scores[batch * top_k];
+      if (beam_hyp.CanImprove(best_sum_logprobs, sequence_length))
         continue;
     }
 
@@ -277,6 +277,58 @@ void InitGreedyState(transformers::IGreedySearchState<T>* greedy_state,
   gsl::copy(sequence_lengths, greedy_state->next_positions);
 }
 
+// Select the top_k candidates of one batch entry, where the score of a candidate is the score of its token plus
+// the score of its beam, like the following:
+//   next_token_scores = (next_token_scores + beam_scores[:, None]).view(num_beams * vocab_size)
+//   topk_scores, topk_indices = torch.topk(next_token_scores, top_k, largest=True, sorted=True)
+// The candidate scores are not materialized. Each row is scanned in blocks, and a block is skipped when its maximum
+// cannot enter the current top_k. Ties are broken by the lower index like TopK.
+static void SelectBeamSearchTopK(gsl::span<const float> next_token_scores,  // shape (num_beams, vocab_size)
+                                 gsl::span<const float> beam_scores,        // shape (num_beams)
+                                 int vocab_size,
+                                 int top_k,
+                                 float* topk_scores,                        // shape (top_k)
+                                 int32_t* topk_indices) {                   // shape (top_k)
+  constexpr int block_size = 64;
+
+  int count = 0;
+  for (size_t beam = 0; beam < beam_scores.size(); beam++) {
+    const float* row = next_token_scores.data() + beam * vocab_size;
+    const float beam_score = beam_scores[beam];
+
+    for (int start = 0; start < vocab_size; start += block_size) {
+      const int end = std::min(start + block_size, vocab_size);
+
+      if (count == top_k) {
+        float block_max = row[start];
+        for (int k = start + 1; k < end; k++) {
+          block_max = std::max(block_max, row[k]);
+        }
+        if (!(block_max + beam_score > topk_scores[top_k - 1])) {
+          continue;
+        }
+      }
+
+      for (int k = start; k < end; k++) {
+        const float score = row[k] + beam_score;
+        if (count == top_k && !(score > topk_scores[top_k - 1])) {
+          continue;
+        }
+
+        // Insert after the candidates with equal or greater score to keep the sorted order.
+        int position = (count == top_k) ? top_k - 1 : count++;
+        while (position > 0 && topk_scores[position - 1] < score) {
+          topk_scores[position] = topk_scores[position - 1];
+          topk_indices[position] = topk_indices[position - 1];
+          position--;
+        }
+        topk_scores[position] = score;
+        topk_indices[position] = static_cast<int32_t>(beam * vocab_size + k);
+      }
+    }
+  }
+}
+
 template <typename T>
 Status ProcessLogits(const OrtValue& logits,                                 // logits output of subgraph
                      transformers::IBeamSearchState<T>* beam_state,          // state
@@ -289,6 +341,8 @@ Status ProcessLogits(const OrtValue& logits,                                 //
                      int step,                                               // iteration counter
                      Stream* stream,                                         // cuda stream (for CUDA only)
                      const IConsoleDumper* dumper) {                         // tensor dumper
+  ORT_UNUSED_PARAMETER(allocator);
+  ORT_UNUSED_PARAMETER(stream);
 #ifndef DEBUG_GENERATION
   ORT_UNUSED_PARAMETER(dumper);
 #endif
@@ -359,66 +413,55 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 
   // Add beam score to next token scores. Corresponding python code is like:
   //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
-  // TODO(tianleiwu): use thread pool to parallel
-  int offset = 0;
-  int batch_beam_index = 0;
-  for (int i = 0; i < batch_size; i++) {
-    for (int j = 0; j < num_beams; j++, batch_beam_index++) {
-      for (int k = 0; k < vocab_size; k++, offset++) {
-        next_token_scores[offset] += beam_state->beam_scores[batch_beam_index];
-      }
-    }
-  }
+  // The sum is only written when the scores are output, and is otherwise computed during top-k selection below.
+  if (output_scores) {
+    // Append next token scores to the scores output.
+    gsl::span<float> target_scores = beam_state->remaining_scores.subspan(0, next_token_scores.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, batch_beam_size,
+        [&](std::ptrdiff_t batch_beam_index) {
+          const float beam_score = beam_state->beam_scores[batch_beam_index];
+          const float* source = next_token_scores.data() + batch_beam_index * vocab_size;
+          float* target = target_scores.data() + batch_beam_index * vocab_size;
+          for (int k = 0; k < vocab_size; k++) {
+            target[k] = source[k] + beam_score;
+          }
+        });
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("next_token_scores adding beam_scores", next_token_scores.data(), batch_size, num_beams, vocab_size);
+    dumper->Print("next_token_scores adding beam_scores", target_scores.data(), batch_size, num_beams, vocab_size);
 #endif
 
-  if (output_scores) {
-    // Append next token scores to the scores output.
-    gsl::copy(next_token_scores, beam_state->remaining_scores);
     beam_state->remaining_scores = beam_state->remaining_scores.subspan(next_token_scores.size());
   }
 
   // Apply top-k selection like the following:
   //   next_token_scores = next_token_scores.view(batch_size, num_beams * vocab_size)
   //   next_token_scores, next_tokens = torch.topk(next_token_scores, 2 * num_beams, dim=1, largest=True, sorted=True)
-  int64_t next_token_scores_dims[] = {static_cast<int64_t>(batch_size), SafeInt<int64_t>(num_beams) * vocab_size};
-  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<T>();
-  OrtValue next_token_scores_value;
-  Tensor::InitOrtValue(element_type, next_token_scores_shape, next_token_scores.data(), allocator->Info(),
-                       next_token_scores_value);
-  const Tensor& input = next_token_scores_value.Get<Tensor>();
-
-  constexpr int axis = 1;
-  const unsigned top_k = static_cast<unsigned>(2 * num_beams);
-  constexpr bool largest = true;
-  constexpr bool sorted = true;  // results returned in sorted order.
-
-  Tensor topk_scores;
-  Tensor topk_indices;
-  ORT_RETURN_IF_ERROR(TopK(&input, axis, top_k, largest, sorted, allocator, stream, thread_pool,
-                           topk_scores, topk_indices));
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("topk_scores", topk_scores);
-  dumper->Print("topk_indices", topk_indices);
-#endif
+  const int top_k = 2 * num_beams;
+  gsl::span<float>& topk_scores = beam_state->next_scores;
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, batch_size,
+      [&](std::ptrdiff_t batch) {
+        SelectBeamSearchTopK(next_token_scores.subspan(SafeInt<size_t>(batch) * num_beams * vocab_size,
+                                                       SafeInt<size_t>(num_beams) * vocab_size),
+                             beam_state->beam_scores.subspan(SafeInt<size_t>(batch) * num_beams, num_beams),
+                             vocab_size,
+                             top_k,
+                             topk_scores.data() + batch * top_k,
+                             beam_state->next_indices.data() + batch * top_k);
+      });
 
   // Convert indices in range [0, num_beams * vocab_size) to token ID of range [0, vocab_size) like the following:
   //   next_indices = (next_tokens / vocab_size).long()
   //   next_tokens = next_tokens % vocab_size
-  gsl::span<const int64_t> next_token_indices = topk_indices.DataAsSpan<int64_t>();
-  offset = 0;
-  for (int i = 0; i < batch_size; i++) {
-    for (unsigned int j = 0; j < top_k; j++, offset++) {
-      beam_state->next_indices[offset] = gsl::narrow_cast<int32_t>(next_token_indices[offset] / vocab_size);
-      beam_state->next_tokens[offset] = gsl::narrow_cast<int32_t>(next_token_indices[offset] % vocab_size);
-    }
+  for (int i = 0; i < batch_size * top_k; i++) {
+    const int32_t index = beam_state->next_indices[i];
+    beam_state->next_indices[i] = index / vocab_size;
+    beam_state->next_tokens[i] = index % vocab_size;
   }
 
-  gsl::span<const T> next_scores = topk_scores.DataAsSpan<T>();
+  gsl::span<const float> next_scores = topk_scores.subspan(0, SafeInt<size_t>(batch_size) * top_k);
   gsl::span<const int32_t> next_tokens(beam_state->next_tokens.data(), beam_state->next_tokens.size());
   gsl::span<const int32_t> next_indices(beam_state->next_indices.data(), beam_state->next_indices.size());
 
@@ -596,6 +639,32 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
   }
 }
 
+// Updates the cache indirection used by DecoderMaskedMultiHeadAttention with beams: for each beam, the entry of
+// a time step is the beam whose past state holds that step. This replaces the gather of the past state by beam.
+static void UpdateCacheIndirection(int32_t* tgt_indir_cache,
+                                   const int32_t* src_indir_cache,
+                                   gsl::span<const int32_t> beam_indices,
+                                   int batch_size,
+                                   int num_beams,
+                                   int input_sequence_length,
+                                   int max_sequence_length,
+                                   int current_length) {
+  for (int batch = 0; batch < batch_size; batch++) {
+    for (int beam = 0; beam < num_beams; beam++) {
+      const int src_beam = beam_indices[static_cast<size_t>(batch) * num_beams + beam] % num_beams;
+      int32_t* tgt = tgt_indir_cache + (static_cast<ptrdiff_t>(batch) * num_beams + beam) * max_sequence_length;
+      const int32_t* src =
+          src_indir_cache + (static_cast<ptrdiff_t>(batch) * num_beams + src_beam) * max_sequence_length;
+
+      // Time steps of the input sequence always come from beam 0, and the newly generated one from this beam.
+      const int input_length = std::min(input_sequence_length, current_length - 1);
+      std::fill_n(tgt, input_length, 0);
+      std::copy(src + input_length, src + current_length - 1, tgt + input_length);
+      tgt[current_length - 1] = beam;
+    }
+  }
+}
+
 template <typename T>
 Status UpdateGptFeeds(
     AllocatorPtr allocator,
@@ -619,8 +688,6 @@ Status UpdateGptFeeds(
   // next_inputs: input_ids, position_id, attention_mask, past_0, past_1
   ORT_UNUSED_PARAMETER(stream);
   ORT_UNUSED_PARAMETER(beam_indices_gpu);
-  ORT_UNUSED_PARAMETER(input_sequence_len);
-  ORT_UNUSED_PARAMETER(need_cache_indir);
 
   // The following updates inputs for subgraph
 
@@ -664,8 +731,33 @@ Status UpdateGptFeeds(
   next_inputs[2] = attention_mask;
 
   if (past_present_share_buffer) {
-    int32_t* past_seq_len_data = const_cast<int32_t*>(next_inputs.back().Get<Tensor>().Data<int32_t>());
-    *past_seq_len_data = past_sequence_len;
+    // Update past sequence length input
+    const ptrdiff_t past_sequence_length_idx =
+        (static_cast<ptrdiff_t>(last_outputs.size()) - gpt_subgraph_first_present_output_idx) +
+        gpt_subgraph_first_past_input_idx;
+    *(next_inputs[past_sequence_length_idx].GetMutable<Tensor>()->MutableData<int32_t>()) = past_sequence_len;
+
+    // With DecoderMaskedMultiHeadAttention, beams keep their past state in place and read it through the cache
+    // indirection, which comes 2 feeds after the `past_sequence_length` feed.
+    if (need_cache_indir) {
+      ORT_ENFORCE(!beam_indices_cpu.empty(),
+                  "Beam indices must be present while using DecoderMaskedMultiHeadAttention with BeamSearch");
+
+      const OrtValue& old_cache_indirection = next_inputs[past_sequence_length_idx + 2];
+      const TensorShape& cache_indirection_shape = old_cache_indirection.Get<Tensor>().Shape();
+      OrtValue cache_indirection;
+      Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), cache_indirection_shape, allocator, cache_indirection);
+
+      UpdateCacheIndirection(cache_indirection.GetMutable<Tensor>()->MutableData<int32_t>(),
+                             old_cache_indirection.Get<Tensor>().Data<int32_t>(),
+                             beam_indices_cpu,
+                             batch_beam_size / num_beams,
+                             num_beams,
+                             input_sequence_len,
+                             static_cast<int>(cache_indirection_shape[2]),
+                             current_length);
+      next_inputs[past_sequence_length_idx + 2] = cache_indirection;
+    }
     return Status::OK();
   }
 
@@ -90,7 +90,6 @@ struct ISamplingState {
   size_t temp_storage_bytes;
   std::default_random_engine generator;
 
-  gsl::span<T> sorted_scores;
   gsl::span<T> cumulative_probs;
 };
 
@@ -101,6 +100,8 @@ struct ISequences {
   virtual gsl::span<int32_t> GetNextDeviceSequences() = 0;                 // Get all next beam_index sequences in one continuous block (to pass to CUDA)
   virtual int GetSequenceLength() const = 0;
   virtual int GetMaxLength() const = 0;
+  // Index of the sequence that beam_index was copied from before its last token was appended, or -1 if unknown.
+  virtual int GetPreviousBeamIndex(int beam_index) const = 0;
 };
 
 struct ILogitsProcessorList {
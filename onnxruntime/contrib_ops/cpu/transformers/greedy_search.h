@@ -19,6 +19,8 @@ class FeedsFetchesManager;
 namespace contrib {
 namespace transformers {
 
+class PrefixKVCache;
+
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
 class GreedySearch : public IControlFlowKernel {
@@ -113,6 +115,10 @@ class GreedySearch : public IControlFlowKernel {
   std::unique_ptr<GptSubgraph> init_run_gpt_subgraph_;
   std::unique_ptr<GptSubgraph> gpt_subgraph_;
 
+  // The draft_gpt_subgraph_ (if the `draft_decoder` attribute is present) proposes tokens
+  // that gpt_subgraph_ verifies in speculative decoding.
+  std::unique_ptr<GptSubgraph> draft_gpt_subgraph_;
+
   // Relevant only for T5
   // Same concept as above.
   // The encoder will be used for the first run and the decoder will
@@ -123,12 +129,19 @@ class GreedySearch : public IControlFlowKernel {
   // FeedsFetchesManager* encoder_feeds_fetches_manager_;
   FeedsFetchesManager* decoder_feeds_fetches_manager_;
   FeedsFetchesManager* init_run_decoder_feeds_fetches_manager_;
+  FeedsFetchesManager* draft_decoder_feeds_fetches_manager_ = nullptr;
 
   IConsoleDumper* dumper_;
 
   GreedySearchParameters parameters_;
 
   bool has_init_decoder_ = false;
+
+  bool has_draft_decoder_ = false;
+
+  // The past state of the prompt prefixes of previous runs, if kOrtSessionOptionsGenerationPrefixCacheBytes is set.
+  // A shared_ptr carries its deleter, so the kernels of the CUDA provider library only need the declaration.
+  std::shared_ptr<PrefixKVCache> prefix_cache_;
 };
 
 }  // namespace transformers
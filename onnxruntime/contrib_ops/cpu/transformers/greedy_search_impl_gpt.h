@@ -3,10 +3,13 @@
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
+#include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 #include "contrib_ops/cpu/transformers/greedy_search_impl_base.h"
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -21,6 +24,56 @@ std::pair<Status, std::unique_ptr<GptSubgraph>> CreateGptSubgraphAndUpdateParame
     const std::string& attribute_name,
     const SessionState& subgraph_session_state,
     /*out*/ BeamSearchParameters& parameters);
+
+// Gather the rows `batch_rows` of dimension `batch_dim` of `input` into a new tensor allocated from `allocator`.
+inline void GatherBatchRows(const Tensor& input,
+                            size_t batch_dim,
+                            gsl::span<const int32_t> batch_rows,
+                            AllocatorPtr allocator,
+                            OrtValue& output) {
+  const TensorShape& input_shape = input.Shape();
+  const size_t outer_size = narrow<size_t>(input_shape.SizeToDimension(batch_dim));
+  const size_t batch_size = narrow<size_t>(input_shape[batch_dim]);
+  const size_t row_bytes = narrow<size_t>(input_shape.SizeFromDimension(batch_dim + 1)) * input.DataType()->Size();
+
+  TensorShapeVector output_dims = input_shape.AsShapeVector();
+  output_dims[batch_dim] = static_cast<int64_t>(batch_rows.size());
+  Tensor::InitOrtValue(input.DataType(), TensorShape(output_dims), std::move(allocator), output);
+
+  const char* source = static_cast<const char*>(input.DataRaw());
+  char* target = static_cast<char*>(output.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t outer = 0; outer < outer_size; ++outer) {
+    for (int32_t row : batch_rows) {
+      memcpy(target, source + (outer * batch_size + static_cast<size_t>(row)) * row_bytes, row_bytes);
+      target += row_bytes;
+    }
+  }
+}
+
+// Keep the first `length` steps of `present` with shape (2, batch_size, num_heads, sequence_length, head_size) in
+// `past`. The tensor is shared when there is nothing to remove.
+inline void TruncatePastState(const OrtValue& present, int64_t length, AllocatorPtr allocator, OrtValue& past) {
+  const Tensor& input = present.Get<Tensor>();
+  const TensorShape& input_shape = input.Shape();
+  if (input_shape[3] == length) {
+    past = present;
+    return;
+  }
+
+  TensorShapeVector output_dims = input_shape.AsShapeVector();
+  output_dims[3] = length;
+  Tensor::InitOrtValue(input.DataType(), TensorShape(output_dims), std::move(allocator), past);
+
+  const size_t num_blocks = narrow<size_t>(input_shape.SizeToDimension(3));
+  const size_t step_bytes = narrow<size_t>(input_shape[4]) * input.DataType()->Size();
+  const size_t input_block_bytes = narrow<size_t>(input_shape[3]) * step_bytes;
+  const size_t output_block_bytes = narrow<size_t>(length) * step_bytes;
+  const char* source = static_cast<const char*>(input.DataRaw());
+  char* target = static_cast<char*>(past.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t block = 0; block < num_blocks; ++block) {
+    memcpy(target + block * output_block_bytes, source + block * input_block_bytes, output_block_bytes);
+  }
+}
 }  // namespace gpt_details
 
 // Greedy search implementation for GPT-2 model.
@@ -79,6 +132,30 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // Use the draft decoder to propose tokens, so that each run of the decoder can verify and generate several tokens.
+  Status InitializeSpeculative(const SessionState& draft_decoder_session_state,
+                               GptSubgraph& draft_gpt_subgraph,
+                               const FeedsFetchesManager& draft_feeds_fetches_manager) {
+    ORT_RETURN_IF(this->IsCuda(), "Speculative decoding with draft_decoder is only supported on CPU");
+    ORT_RETURN_IF(std::is_same<ParametersT, SamplingParameters>::value,
+                  "Speculative decoding with draft_decoder does not support sampling");
+    ORT_RETURN_IF(gpt_subgraph_.past_present_share_buffer_ || draft_gpt_subgraph.past_present_share_buffer_,
+                  "Speculative decoding with draft_decoder does not support past_present_share_buffer");
+    ORT_RETURN_IF_NOT(draft_gpt_subgraph.vocab_size == this->parameters_->vocab_size,
+                      "draft_decoder shall have the same vocab_size as decoder. Got ", draft_gpt_subgraph.vocab_size,
+                      " and ", this->parameters_->vocab_size);
+    draft_decoder_session_state_ = &draft_decoder_session_state;
+    draft_gpt_subgraph_ = &draft_gpt_subgraph;
+    draft_feeds_fetches_manager_ = &draft_feeds_fetches_manager;
+    return Status::OK();
+  }
+
+  // Reuse the past state of the prompt prefixes of previous runs. The cache is only used on CPU, for a single
+  // sequence without padding and without past_present_share_buffer.
+  void SetPrefixCache(PrefixKVCache* prefix_cache) {
+    prefix_cache_ = prefix_cache;
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -101,10 +178,48 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Replace the inputs of the first run of the decoder by the tokens of the prompt after its longest cached prefix, and
+  // the past state by the cached one.
+  Status ApplyPrefixCache(gsl::span<const int32_t> prompt, std::vector<OrtValue>& feeds);
+
+  // Remove the sequences that have met EOS from the decoder inputs, so that following iterations of the subgraph
+  // only run on live sequences. live_batch_ids maps each row of the decoder inputs to its batch index.
+  Status RemoveFinishedSequences(std::vector<OrtValue>& feeds,
+                                 OrtValue& position_ids,
+                                 GreedySearchState<T>& greedy_state,
+                                 std::vector<int32_t>& live_batch_ids);
+
+  // Scatter logits of the live sequences into logits of the whole batch.
+  Status ExpandLiveLogits(const OrtValue& live_logits,
+                          gsl::span<const int32_t> live_batch_ids,
+                          OrtValue& batch_logits);
+
+  // A decoder in speculative decoding. Its past state holds the first past_length tokens of the sequences.
+  struct SpeculativeDecoder {
+    const SessionState* session_state;
+    const FeedsFetchesManager* feeds_fetches_manager;
+    const GptSubgraph* subgraph;
+    std::vector<OrtValue> feeds;
+    std::vector<OrtValue> fetches;
+    int past_length;
+  };
+
+  // Greedy search where the draft decoder proposes up to num_speculative_tokens tokens, and one run of the decoder
+  // scores all of them. The proposed tokens are kept while they match the tokens the decoder selects, so the
+  // sequences are the same as those of Execute without a draft decoder.
+  Status ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                            const FeedsFetchesManager& feeds_fetches_manager);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
 
+  const SessionState* draft_decoder_session_state_ = nullptr;
+  GptSubgraph* draft_gpt_subgraph_ = nullptr;
+  const FeedsFetchesManager* draft_feeds_fetches_manager_ = nullptr;
+
+  PrefixKVCache* prefix_cache_ = nullptr;
+
   // Device specific functions
   GenerationDeviceHelper::CreateGptInputsFunc create_inputs_func_;
   GenerationDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
@@ -187,9 +302,127 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ApplyPrefixCache(gsl::span<const int32_t> prompt,
+                                                         std::vector<OrtValue>& feeds) {
+  // The last token of the prompt always runs to get the logits of the first generated token.
+  std::vector<OrtValue> past;
+  const size_t prefix_length = prefix_cache_->Lookup(prompt, prompt.size() - 1, this->temp_space_allocator_, past);
+  if (prefix_length == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF_NOT(past.size() == static_cast<size_t>(gpt_subgraph_.num_layers),
+                    "The prefix cache has ", past.size(), " layers, but the decoder has ", gpt_subgraph_.num_layers);
+
+  const int64_t num_tokens = static_cast<int64_t>(prompt.size() - prefix_length);
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+  OrtValue input_ids_value;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, num_tokens}), this->temp_space_allocator_, input_ids_value);
+  OrtValue position_ids_value;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, num_tokens}), this->temp_space_allocator_, position_ids_value);
+
+  // The prompt has no padding, so the position of a token is its index. The attention mask covers the past and the
+  // new tokens, so it is the one of the whole prompt.
+  int32_t* input_ids_data = input_ids_value.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* position_data = position_ids_value.GetMutable<Tensor>()->MutableData<int32_t>();
+  std::copy(prompt.begin() + prefix_length, prompt.end(), input_ids_data);
+  std::iota(position_data, position_data + num_tokens, static_cast<int32_t>(prefix_length));
+
+  feeds[0] = input_ids_value;
+  feeds[1] = position_ids_value;
+  const int first_past_input_index = gpt_subgraph_.GetFirstPastInputIndex();
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    feeds[first_past_input_index + layer] = past[layer];
+  }
+
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::RemoveFinishedSequences(std::vector<OrtValue>& feeds,
+                                                                OrtValue& position_ids,
+                                                                GreedySearchState<T>& greedy_state,
+                                                                std::vector<int32_t>& live_batch_ids) {
+  std::vector<int32_t> kept_rows;
+  kept_rows.reserve(live_batch_ids.size());
+  for (size_t row = 0; row < live_batch_ids.size(); ++row) {
+    if (!greedy_state.eos_meet[live_batch_ids[row]]) {
+      kept_rows.push_back(static_cast<int32_t>(row));
+    }
+  }
+
+  if (kept_rows.empty() || kept_rows.size() == live_batch_ids.size()) {
+    return Status::OK();
+  }
+
+  // input_ids and attention_mask have batch in dimension 0, past state has shape (2, batch_size, ...).
+  OrtValue compacted;
+  gpt_details::GatherBatchRows(feeds[0].Get<Tensor>(), 0, kept_rows, this->temp_space_allocator_, compacted);
+  feeds[0] = compacted;
+  gpt_details::GatherBatchRows(feeds[2].Get<Tensor>(), 0, kept_rows, this->temp_space_allocator_, compacted);
+  feeds[2] = compacted;
+  const int first_past_input_index = gpt_subgraph_.GetFirstPastInputIndex();
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    gpt_details::GatherBatchRows(feeds[first_past_input_index + layer].Get<Tensor>(), 1, kept_rows,
+                                 this->temp_space_allocator_, compacted);
+    feeds[first_past_input_index + layer] = compacted;
+  }
+
+  // Position ids are kept in next_positions, so compact them in place.
+  gsl::span<int32_t> positions = greedy_state.next_positions;
+  for (size_t i = 0; i < kept_rows.size(); ++i) {
+    positions[i] = positions[kept_rows[i]];
+    live_batch_ids[i] = live_batch_ids[kept_rows[i]];
+  }
+  live_batch_ids.resize(kept_rows.size());
+
+  int64_t dims[] = {static_cast<int64_t>(kept_rows.size()), 1};
+  TensorShape shape(&dims[0], 2);
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(),
+                       shape,
+                       positions.data(),
+                       this->temp_space_allocator_->Info(),
+                       position_ids);
+  feeds[1] = position_ids;
+
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ExpandLiveLogits(const OrtValue& live_logits,
+                                                         gsl::span<const int32_t> live_batch_ids,
+                                                         OrtValue& batch_logits) {
+  // logits has shape (live_batch_size, sequence_length, vocab_size).
+  const Tensor& live = live_logits.Get<Tensor>();
+  const TensorShape& live_shape = live.Shape();
+  ORT_RETURN_IF_NOT(live_shape.NumDimensions() == 3 && live_shape[0] == static_cast<int64_t>(live_batch_ids.size()),
+                    "logits shall have shape (live_batch_size, sequence_length, vocab_size)");
+
+  const int64_t batch_size = this->parameters_->BatchBeamSize();
+  if (!batch_logits.IsAllocated() || batch_logits.Get<Tensor>().Shape()[1] != live_shape[1]) {
+    // Rows of finished sequences are never read for token selection, but keep them finite for logits processors.
+    Tensor::InitOrtValue(live.DataType(), TensorShape({batch_size, live_shape[1], live_shape[2]}),
+                         this->temp_space_allocator_, batch_logits);
+    memset(batch_logits.GetMutable<Tensor>()->MutableDataRaw(), 0, batch_logits.Get<Tensor>().SizeInBytes());
+  }
+
+  const size_t row_bytes = narrow<size_t>(live_shape.SizeFromDimension(1)) * live.DataType()->Size();
+  const char* source = static_cast<const char*>(live.DataRaw());
+  char* target = static_cast<char*>(batch_logits.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t row = 0; row < live_batch_ids.size(); ++row) {
+    memcpy(target + static_cast<size_t>(live_batch_ids[row]) * row_bytes, source + row * row_bytes, row_bytes);
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
+  if (draft_gpt_subgraph_ != nullptr) {
+    return ExecuteSpeculative(init_run_feeds_fetches_manager, feeds_fetches_manager);
+  }
+
   auto status = Status::OK();
   const ParametersT* parameters = this->parameters_;
 
@@ -254,6 +487,16 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                            parameters->max_length,
                            parameters->sequence_length);
 
+  bool use_prefix_cache = prefix_cache_ != nullptr && !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_ &&
+                          parameters->BatchBeamSize() == 1;
+  if (use_prefix_cache) {
+    gsl::span<const int32_t> attention_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+    use_prefix_cache = std::all_of(attention_mask.begin(), attention_mask.end(), [](int32_t m) { return m == 1; });
+  }
+  if (use_prefix_cache) {
+    ORT_RETURN_IF_ERROR(ApplyPrefixCache(input_ids, feeds));
+  }
+
 #ifdef DEBUG_GENERATION
   const IConsoleDumper* dumper = this->GetConsoleDumper();
 #endif
@@ -268,6 +511,15 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // On CPU, sequences that have met EOS leave the batch between decoder steps. The decoder inputs then only hold
+  // the live sequences, and live_batch_ids maps their rows back to the batch; logits are scattered back to the
+  // batch so that token selection and the logits processors work on Sequences unchanged.
+  const bool remove_finished_sequences = !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_;
+  std::vector<int32_t> live_batch_ids(static_cast<size_t>(parameters->BatchBeamSize()));
+  std::iota(live_batch_ids.begin(), live_batch_ids.end(), 0);
+  std::vector<int32_t> live_next_tokens;
+  OrtValue batch_logits;
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -312,7 +564,20 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    // The present state after the first run holds the whole prompt.
+    if (iteration_counter == 1 && use_prefix_cache) {
+      prefix_cache_->Insert(input_ids,
+                            gsl::make_span(fetches).subspan(
+                                static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()),
+                                static_cast<size_t>(gpt_subgraph_.num_layers)),
+                            this->cpu_allocator_);
+    }
+
+    const bool has_finished_sequences = live_batch_ids.size() < static_cast<size_t>(parameters->BatchBeamSize());
+    if (has_finished_sequences) {
+      ORT_RETURN_IF_ERROR(ExpandLiveLogits(fetches[0], live_batch_ids, batch_logits));
+    }
+    const OrtValue& logits = has_finished_sequences ? batch_logits : fetches[0];
     gsl::span<int32_t> next_tokens;
 
     ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
@@ -361,10 +626,23 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      gsl::span<const int32_t> feed_tokens = ReinterpretAsSpan<const int32_t>(next_tokens);
+      if (has_finished_sequences) {
+        live_next_tokens.resize(live_batch_ids.size());
+        for (size_t row = 0; row < live_batch_ids.size(); ++row) {
+          live_next_tokens[row] = next_tokens[live_batch_ids[row]];
+        }
+        feed_tokens = live_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      feed_tokens,
                                       current_length - 1));
+
+      if (remove_finished_sequences) {
+        ORT_RETURN_IF_ERROR(RemoveFinishedSequences(feeds, position_ids, greedy_state, live_batch_ids));
+      }
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
       // clear fetched values before presents[]
@@ -410,6 +688,240 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   return status;
 }
 
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                                                           const FeedsFetchesManager& feeds_fetches_manager) {
+  const ParametersT* parameters = this->parameters_;
+  const int batch_size = static_cast<int>(parameters->BatchBeamSize());
+  const int sequence_length = parameters->sequence_length;
+  const int max_length = parameters->max_length;
+
+  // Allocate output tensors.
+  int64_t sequences_dims[] = {parameters->batch_size, max_length};
+  TensorShape sequences_shape(&sequences_dims[0], sizeof(sequences_dims) / sizeof(sequences_dims[0]));
+  Tensor* output_sequences = this->context_.Output(0, sequences_shape);
+
+  GreedySearchState<T> greedy_state;
+  greedy_state.Init(this->cpu_allocator_,
+                    this->temp_space_allocator_,
+                    batch_size,
+                    static_cast<int>(parameters->vocab_size),
+                    sequence_length,
+                    max_length,
+                    static_cast<int>(parameters->num_heads),
+                    static_cast<int>(parameters->head_size),
+                    gpt_subgraph_.has_decoder_masked_attention_,
+                    this->IsCuda(),
+                    this->ort_stream_);
+
+  // Speculative decoding does not sample, so the sampling state is not initialized.
+  SamplingState<T> sampling_state;
+
+  SpeculativeDecoder decoder{init_run_decoder_session_state_ != nullptr ? init_run_decoder_session_state_
+                                                                        : &this->decoder_session_state_,
+                             init_run_decoder_session_state_ != nullptr ? init_run_feeds_fetches_manager
+                                                                        : &feeds_fetches_manager,
+                             &gpt_subgraph_, {}, {}, 0};
+  SpeculativeDecoder draft_decoder{draft_decoder_session_state_, draft_feeds_fetches_manager_, draft_gpt_subgraph_,
+                                   {}, {}, 0};
+
+  IAllocatorUniquePtr<char> buffer;
+  OrtValue expanded_input_ids_in_cpu;
+  ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, decoder.feeds,
+                                         buffer));
+
+  std::vector<int32_t> draft_sequence_lengths(static_cast<size_t>(batch_size));
+  gsl::span<int32_t> draft_sequence_lengths_span(draft_sequence_lengths);
+  IAllocatorUniquePtr<char> draft_buffer;
+  OrtValue draft_expanded_input_ids;
+  ORT_RETURN_IF_ERROR(draft_gpt_subgraph_->CreateInitialFeeds(this->context_.GetInputOrtValue(0)->Get<Tensor>(),
+                                                              this->implicit_inputs_,
+                                                              parameters->num_beams,
+                                                              parameters->pad_token_id,
+                                                              draft_sequence_lengths_span,
+                                                              draft_expanded_input_ids,
+                                                              this->context_.GetInputOrtValue(6),
+                                                              draft_decoder.feeds,
+                                                              this->create_inputs_func_,
+                                                              this->add_to_feeds_func_,
+                                                              draft_buffer,
+                                                              this->ort_stream_));
+
+  init_greedy_state_func_(&greedy_state,
+                          greedy_state.sequence_lengths,
+                          this->ort_stream_);
+
+  gsl::span<const int32_t> input_ids = expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>();
+  greedy_state.SetSequence(input_ids,
+                           static_cast<size_t>(batch_size),
+                           max_length,
+                           sequence_length);
+
+  // The accepted tokens of each sequence, followed by the tokens proposed by the draft decoder.
+  std::vector<int32_t> tokens(SafeInt<size_t>(batch_size) * max_length, parameters->pad_token_id);
+  for (int i = 0; i < batch_size; i++) {
+    std::copy_n(input_ids.begin() + static_cast<size_t>(i) * sequence_length, sequence_length,
+                tokens.begin() + static_cast<size_t>(i) * max_length);
+  }
+
+  // The attention mask of the prompt is kept for the following runs, whose inputs are not padded.
+  gsl::span<const int32_t> prompt_mask = decoder.feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  std::vector<int32_t> prompt_attention_mask(prompt_mask.begin(), prompt_mask.end());
+
+  // Runs the decoder on the tokens from its past length up to `length`.
+  auto run_decoder = [&](SpeculativeDecoder& speculative_decoder, int length) -> Status {
+    const int past_length = speculative_decoder.past_length;
+    const int num_tokens = length - past_length;
+
+    // The initial feeds hold the prompt.
+    if (past_length > 0) {
+      auto int32_type = DataTypeImpl::GetType<int32_t>();
+      OrtValue input_ids_value;
+      Tensor::InitOrtValue(int32_type, TensorShape({batch_size, num_tokens}), this->temp_space_allocator_,
+                           input_ids_value);
+      OrtValue position_ids_value;
+      Tensor::InitOrtValue(int32_type, TensorShape({batch_size, num_tokens}), this->temp_space_allocator_,
+                           position_ids_value);
+      OrtValue attention_mask_value;
+      Tensor::InitOrtValue(int32_type, TensorShape({batch_size, length}), this->temp_space_allocator_,
+                           attention_mask_value);
+
+      int32_t* input_ids_data = input_ids_value.GetMutable<Tensor>()->MutableData<int32_t>();
+      int32_t* position_data = position_ids_value.GetMutable<Tensor>()->MutableData<int32_t>();
+      int32_t* mask_data = attention_mask_value.GetMutable<Tensor>()->MutableData<int32_t>();
+      for (int i = 0; i < batch_size; i++) {
+        // The first generated token is at position sequence_lengths[i].
+        const int32_t first_position = greedy_state.sequence_lengths[i] - sequence_length;
+        for (int j = past_length; j < length; j++) {
+          *input_ids_data++ = tokens[static_cast<size_t>(i) * max_length + j];
+          *position_data++ = first_position + j;
+        }
+        mask_data = std::copy_n(prompt_attention_mask.begin() + static_cast<size_t>(i) * sequence_length,
+                                sequence_length, mask_data);
+        mask_data = std::fill_n(mask_data, length - sequence_length, 1);
+      }
+
+      std::vector<OrtValue>& feeds = speculative_decoder.feeds;
+      feeds[0] = input_ids_value;
+      feeds[1] = position_ids_value;
+      feeds[2] = attention_mask_value;
+      const int first_past_input_index = speculative_decoder.subgraph->GetFirstPastInputIndex();
+      const int first_present_output_index = speculative_decoder.subgraph->GetFirstPresentOutputIndex();
+      for (int layer = 0; layer < speculative_decoder.subgraph->num_layers; layer++) {
+        gpt_details::TruncatePastState(speculative_decoder.fetches[first_present_output_index + layer], past_length,
+                                       this->temp_space_allocator_, feeds[first_past_input_index + layer]);
+      }
+    }
+
+    speculative_decoder.fetches.clear();
+#ifdef DEBUG_NODE_INPUTS_OUTPUTS
+    const_cast<SessionState*>(speculative_decoder.session_state)->IncrementGraphExecutionCounter();
+#endif
+    ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(*speculative_decoder.session_state,
+                                               *speculative_decoder.feeds_fetches_manager,
+                                               speculative_decoder.feeds,
+                                               speculative_decoder.fetches,
+                                               {},
+                                               ExecutionMode::ORT_SEQUENTIAL,
+                                               this->context_.GetTerminateFlag(),
+                                               this->context_.Logger(),
+                                               this->ort_stream_));
+    speculative_decoder.past_length = length;
+    return Status::OK();
+  };
+
+  // Both decoders first run on the prompt. The init_run_decoder subgraph (if present) is only used for it.
+  ORT_RETURN_IF_ERROR(run_decoder(decoder, sequence_length));
+  decoder.session_state = &this->decoder_session_state_;
+  decoder.feeds_fetches_manager = &feeds_fetches_manager;
+  ORT_RETURN_IF_ERROR(run_decoder(draft_decoder, sequence_length));
+
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  gsl::span<bool>& eos_meet = greedy_state.eos_meet;
+  OrtValue step_logits;
+  int current_length = sequence_length;
+  int iteration_counter = 0;
+  bool is_done = false;
+  while (!is_done) {
+    // The logits of the decoder for the tokens it was last run on. Logits at `position` select the token at
+    // current_length, and the following ones are valid while the tokens fed to the decoder are accepted.
+    const Tensor& logits = decoder.fetches[0].Get<Tensor>();
+    const int num_logits = static_cast<int>(logits.Shape()[1]);
+    for (int position = current_length - (decoder.past_length - num_logits + 1); position < num_logits; position++) {
+      const int32_t logits_row = position;
+      gpt_details::GatherBatchRows(logits, 1, gsl::make_span(&logits_row, 1), this->temp_space_allocator_,
+                                   step_logits);
+
+      gsl::span<int32_t> next_tokens;
+      ORT_RETURN_IF_ERROR(this->GenerateNextToken(step_logits,
+                                                  next_tokens,
+                                                  greedy_state,
+                                                  sampling_state,
+                                                  ++iteration_counter,
+                                                  parameters->eos_token_id));
+
+      // The token fed to the decoder after this one was proposed by the draft decoder. It is accepted when it is
+      // the selected token for all sequences that are not finished.
+      bool is_accepted = true;
+      for (int i = 0; i < batch_size; i++) {
+        int32_t& token = tokens[static_cast<size_t>(i) * max_length + current_length];
+        if (!eos_meet[i] && token != next_tokens[i]) {
+          is_accepted = false;
+        }
+        token = next_tokens[i];
+      }
+      ++current_length;
+
+      is_done = std::all_of(eos_meet.begin(), eos_meet.end(), [](bool finished) { return finished; }) ||
+                current_length >= max_length;
+      if (is_done || !is_accepted) {
+        break;
+      }
+    }
+
+    if (is_done) {
+      break;
+    }
+
+    // Only the tokens before the last accepted token are in the past state of both decoders.
+    decoder.past_length = std::min(decoder.past_length, current_length - 1);
+    draft_decoder.past_length = std::min(draft_decoder.past_length, current_length - 1);
+
+    // The draft decoder proposes tokens one by one. The decoder can select one more token after the proposed ones.
+    const int num_proposed_tokens = std::min(parameters->num_speculative_tokens, max_length - current_length - 1);
+    for (int i = 0; i < num_proposed_tokens; i++) {
+      const int length = current_length + i;
+      ORT_RETURN_IF_ERROR(run_decoder(draft_decoder, length));
+
+      const Tensor& draft_logits = draft_decoder.fetches[0].Get<Tensor>();
+      const size_t draft_num_logits = narrow<size_t>(draft_logits.Shape()[1]);
+      const size_t draft_logits_stride = narrow<size_t>(draft_logits.Shape()[2]);
+      const T* draft_logits_data = draft_logits.Data<T>();
+      for (int j = 0; j < batch_size; j++) {
+        const T* next_token_logits = draft_logits_data + ((j + 1) * draft_num_logits - 1) * draft_logits_stride;
+        tokens[static_cast<size_t>(j) * max_length + length] =
+            eos_meet[j] ? parameters->pad_token_id
+                        : static_cast<int32_t>(std::max_element(next_token_logits, next_token_logits + vocab_size) -
+                                               next_token_logits);
+      }
+    }
+
+    ORT_RETURN_IF_ERROR(run_decoder(decoder, current_length + num_proposed_tokens));
+  }
+
+  // Copy the sequences to output
+  gsl::span<int32_t> output = output_sequences->MutableDataAsSpan<int32_t>();
+  for (int batch_id = 0; batch_id < parameters->batch_size; ++batch_id) {
+    auto batch_output = output.subspan(
+        static_cast<size_t>(batch_id) * max_length,
+        max_length);
+    gsl::span<const int32_t> sequence_source = greedy_state.sequences.GetSequence(batch_id);
+    gsl::copy(sequence_source, batch_output);
+  }
+
+  return Status::OK();
+}
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -13,6 +13,9 @@ namespace transformers {
 struct GreedySearchParameters : public BeamSearchParameters {
   int BatchBeamSize() const { return batch_size; }
 
+  // Number of tokens proposed by the draft decoder in speculative decoding.
+  int num_speculative_tokens = 0;
+
   void ParseFromAttributes(const OpKernelInfo& info) override;
 
   void ParseFromInputs(OpKernelContext* context);
@@ -62,15 +62,51 @@ template <typename T>
 NoRepeatNGramLogitsProcessor<T>::NoRepeatNGramLogitsProcessor(int ngram_size) : ngram_size_(ngram_size) {
 }
 
+// FNV-1a hash of the token ids.
+static uint64_t HashTokens(gsl::span<const int32_t> tokens) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const int32_t token : tokens) {
+    hash = (hash ^ static_cast<uint32_t>(token)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+template <typename T>
+void NoRepeatNGramLogitsProcessor<T>::Extend(NGramIndex& index, gsl::span<const int32_t> sequence) const {
+  const int sequence_length = static_cast<int>(sequence.size());
+  const size_t prefix_length = static_cast<size_t>(ngram_size_) - 1;
+  for (int j = std::max(index.sequence_length - ngram_size_ + 1, 0); j <= sequence_length - ngram_size_; j++) {
+    index.starts[HashTokens(sequence.subspan(j, prefix_length))].push_back(j);
+  }
+  index.sequence_length = sequence_length;
+}
+
 template <typename T>
 void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
                                               NextTokenScores<T>& next_token_scores) {
-  if (ngram_size_ == 0 || ngram_size_ > sequences->GetSequenceLength()) {
+  const int sequence_length = sequences->GetSequenceLength();
+  if (ngram_size_ == 0 || ngram_size_ > sequence_length) {
     return;
   }
 
   const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
   int batch_beam_size = next_token_scores.batch_beam_size;
+  indices_.resize(batch_beam_size);
+
+  // The index of a beam is updated with the n-gram ending at its last token. A beam selected from another beam starts
+  // from a copy of that beam's index, and the index is rebuilt when the previous beams are not known.
+  std::vector<std::pair<int, NGramIndex>> copied_indices;
+  for (int i = 0; i < batch_beam_size; i++) {
+    const int previous = sequences->GetPreviousBeamIndex(i);
+    if (previous < 0 || indices_[previous].sequence_length != sequence_length - 1) {
+      copied_indices.emplace_back(i, NGramIndex{});
+    } else if (previous != i) {
+      copied_indices.emplace_back(i, indices_[previous]);
+    }
+  }
+  for (auto& [i, index] : copied_indices) {
+    indices_[i] = std::move(index);
+  }
 
   for (int i = 0; i < batch_beam_size; i++) {
     gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
@@ -79,18 +115,17 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
     gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
     ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
 
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
-      }
+    NGramIndex& index = indices_[i];
+    Extend(index, sequence);
+    auto it = index.starts.find(HashTokens(prefix));
+    if (it == index.starts.end()) {
+      continue;
     }
 
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
+    for (const int j : it->second) {
+      if (SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+        beam_token_scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = std::numeric_limits<T>::lowest();
+      }
     }
   }
 }
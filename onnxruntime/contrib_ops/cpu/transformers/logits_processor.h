@@ -87,7 +87,19 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
                NextTokenScores<T>& next_token_scores) override;
 
  private:
+  // The n-grams of a sequence by the hash of their prefix of ngram_size - 1 tokens. The positions where they start are
+  // kept to tell a hash collision from a repeated prefix.
+  struct NGramIndex {
+    InlinedHashMap<uint64_t, InlinedVector<int>> starts;
+    int sequence_length = 0;  // the n-grams of this many first tokens of the sequence are indexed
+  };
+
+  // Adds the n-grams of the sequence that are not indexed yet.
+  void Extend(NGramIndex& index, gsl::span<const int32_t> sequence) const;
+
   int ngram_size_;
+  // One index per beam, kept across the steps of a generation.
+  std::vector<NGramIndex> indices_;
 };
 
 template <typename T>
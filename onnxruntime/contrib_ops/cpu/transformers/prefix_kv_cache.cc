@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+namespace {
+
+// Copies `num_tokens` steps of each (key or value, head) row of a past state with shape
+// (2, 1, num_heads, sequence_length, head_size), between offsets of two such states.
+void CopySteps(const Tensor& source, size_t source_offset, Tensor& target, size_t target_offset, size_t num_tokens) {
+  const TensorShape& source_shape = source.Shape();
+  const TensorShape& target_shape = target.Shape();
+  const size_t num_rows = narrow<size_t>(source_shape.SizeToDimension(3));
+  const size_t step_bytes = narrow<size_t>(source_shape[4]) * source.DataType()->Size();
+  const size_t source_row_bytes = narrow<size_t>(source_shape[3]) * step_bytes;
+  const size_t target_row_bytes = narrow<size_t>(target_shape[3]) * step_bytes;
+  const char* source_data = static_cast<const char*>(source.DataRaw());
+  char* target_data = static_cast<char*>(target.MutableDataRaw());
+  for (size_t row = 0; row < num_rows; ++row) {
+    memcpy(target_data + row * target_row_bytes + target_offset * step_bytes,
+           source_data + row * source_row_bytes + source_offset * step_bytes,
+           num_tokens * step_bytes);
+  }
+}
+
+}  // namespace
+
+PrefixKVCache::PrefixKVCache(size_t block_size, size_t max_bytes)
+    : block_size_(block_size), max_bytes_(max_bytes) {
+  ORT_ENFORCE(block_size_ > 0, "The block size of the prefix cache shall be positive");
+}
+
+std::unique_ptr<PrefixKVCache> PrefixKVCache::Create(const ConfigOptions& config_options) {
+  const std::string max_bytes_string =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsGenerationPrefixCacheBytes, "0");
+  size_t max_bytes = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(max_bytes_string, max_bytes),
+              "Invalid value of ", kOrtSessionOptionsGenerationPrefixCacheBytes, ": ", max_bytes_string);
+  if (max_bytes == 0) {
+    return nullptr;
+  }
+  return std::make_unique<PrefixKVCache>(kDefaultBlockSize, max_bytes);
+}
+
+size_t PrefixKVCache::Lookup(gsl::span<const int32_t> tokens, size_t max_length, AllocatorPtr allocator,
+                             std::vector<OrtValue>& past) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<const Block*> blocks;
+  Block* block = &root_;
+  const size_t end = std::min(tokens.size(), max_length) / block_size_ * block_size_;
+  for (size_t offset = 0; offset < end; offset += block_size_) {
+    std::vector<int32_t> key(tokens.begin() + offset, tokens.begin() + offset + block_size_);
+    auto it = block->children.find(key);
+    if (it == block->children.end()) {
+      break;
+    }
+    block = it->second.get();
+    blocks.push_back(block);
+  }
+
+  if (blocks.empty()) {
+    return 0;
+  }
+  Touch(block);
+
+  const size_t length = blocks.size() * block_size_;
+  const size_t num_layers = blocks.front()->past.size();
+  past.resize(num_layers);
+  for (size_t layer = 0; layer < num_layers; ++layer) {
+    const Tensor& first = blocks.front()->past[layer].Get<Tensor>();
+    TensorShapeVector past_dims = first.Shape().AsShapeVector();
+    past_dims[3] = static_cast<int64_t>(length);
+    Tensor::InitOrtValue(first.DataType(), TensorShape(past_dims), allocator, past[layer]);
+    Tensor& target = *past[layer].GetMutable<Tensor>();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      CopySteps(blocks[i]->past[layer].Get<Tensor>(), 0, target, i * block_size_, block_size_);
+    }
+  }
+
+  return length;
+}
+
+void PrefixKVCache::Insert(gsl::span<const int32_t> tokens, gsl::span<const OrtValue> present,
+                           AllocatorPtr allocator) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Block* block = &root_;
+  const size_t end = tokens.size() / block_size_ * block_size_;
+  for (size_t offset = 0; offset < end; offset += block_size_) {
+    std::vector<int32_t> key(tokens.begin() + offset, tokens.begin() + offset + block_size_);
+    auto it = block->children.find(key);
+    if (it != block->children.end()) {
+      block = it->second.get();
+      continue;
+    }
+
+    auto child = std::make_unique<Block>();
+    child->tokens = key;
+    child->parent = block;
+    child->past.resize(present.size());
+    for (size_t layer = 0; layer < present.size(); ++layer) {
+      const Tensor& source = present[layer].Get<Tensor>();
+      TensorShapeVector block_dims = source.Shape().AsShapeVector();
+      block_dims[3] = static_cast<int64_t>(block_size_);
+      Tensor::InitOrtValue(source.DataType(), TensorShape(block_dims), allocator, child->past[layer]);
+      Tensor& target = *child->past[layer].GetMutable<Tensor>();
+      CopySteps(source, offset, target, 0, block_size_);
+      child->bytes += target.SizeInBytes();
+    }
+
+    bytes_ += child->bytes;
+    child->lru_position = lru_.insert(lru_.end(), child.get());
+    block = child.get();
+    block->parent->children.emplace(std::move(key), std::move(child));
+  }
+
+  if (block != &root_) {
+    Touch(block);
+  }
+  Evict();
+}
+
+size_t PrefixKVCache::SizeInBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+size_t PrefixKVCache::NumBlocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lru_.size();
+}
+
+void PrefixKVCache::Touch(Block* block) {
+  for (; block != &root_; block = block->parent) {
+    lru_.splice(lru_.begin(), lru_, block->lru_position);
+  }
+}
+
+void PrefixKVCache::Evict() {
+  while (bytes_ > max_bytes_ && !lru_.empty()) {
+    Block* block = lru_.back();
+    ORT_ENFORCE(block->children.empty(), "The least recently used block of the prefix cache shall be a leaf");
+    lru_.pop_back();
+    bytes_ -= block->bytes;
+    // the key is copied since erasing the block frees its tokens
+    const std::vector<int32_t> key = block->tokens;
+    block->parent->children.erase(key);
+  }
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gsl/gsl>
+#include "core/framework/allocator.h"
+#include "core/framework/config_options.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// A cache of the past state of the GPT decoder for the prompts of previous runs, shared by the runs of a generation
+// node, so that a prompt that starts with a cached prefix (like a common system prompt) only runs the decoder on the
+// remaining tokens.
+//
+// The prefixes are kept in blocks of block_size tokens in a prefix tree keyed by token ids. A block holds its tokens
+// and the past state of all the layers for them, and its children are the blocks that follow it in the cached
+// prompts. Blocks are never modified once inserted, so the prompts with a common prefix share its blocks. When the
+// blocks take more than max_bytes, the least recently used blocks are evicted. A block is always used more recently
+// than its children, so only blocks without children are evicted.
+//
+// The past state of a layer has the shape (2, 1, num_heads, sequence_length, head_size) of the GPT subgraph.
+class PrefixKVCache {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16;
+
+  PrefixKVCache(size_t block_size, size_t max_bytes);
+
+  // Creates the cache with the memory budget of kOrtSessionOptionsGenerationPrefixCacheBytes, or returns nullptr if
+  // the option is not set.
+  static std::unique_ptr<PrefixKVCache> Create(const ConfigOptions& config_options);
+
+  // Finds the longest cached prefix of `tokens` of at most max_length tokens. The past state of each layer for the
+  // prefix is allocated from `allocator` in `past`. Returns the length of the prefix, a multiple of block_size.
+  size_t Lookup(gsl::span<const int32_t> tokens, size_t max_length, AllocatorPtr allocator,
+                std::vector<OrtValue>& past);
+
+  // Caches the whole blocks of `tokens`. `present` is the present state of each layer after running the decoder on
+  // the tokens, whose sequence length is at least the number of tokens.
+  void Insert(gsl::span<const int32_t> tokens, gsl::span<const OrtValue> present, AllocatorPtr allocator);
+
+  size_t BlockSize() const { return block_size_; }
+  size_t SizeInBytes() const;
+  size_t NumBlocks() const;
+
+ private:
+  struct Block {
+    std::vector<int32_t> tokens;
+    // past state of each layer with shape (2, 1, num_heads, block_size, head_size)
+    std::vector<OrtValue> past;
+    size_t bytes = 0;
+    Block* parent = nullptr;
+    std::map<std::vector<int32_t>, std::unique_ptr<Block>> children;
+    std::list<Block*>::iterator lru_position;
+  };
+
+  // Moves the blocks from `block` up to the root to the front of the LRU list, children first.
+  void Touch(Block* block);
+  void Evict();
+
+  const size_t block_size_;
+  const size_t max_bytes_;
+
+  mutable std::mutex mutex_;
+  Block root_;
+  // most recently used first
+  std::list<Block*> lru_;
+  size_t bytes_ = 0;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -17,6 +17,8 @@ class FeedsFetchesManager;
 namespace contrib {
 namespace transformers {
 
+class PrefixKVCache;
+
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
 class Sampling : public IControlFlowKernel {
@@ -111,6 +113,10 @@ class Sampling : public IControlFlowKernel {
   SamplingParameters parameters_;
 
   bool has_init_decoder_ = false;
+
+  // The past state of the prompt prefixes of previous runs, if kOrtSessionOptionsGenerationPrefixCacheBytes is set.
+  // A shared_ptr carries its deleter, so the kernels of the CUDA provider library only need the declaration.
+  std::shared_ptr<PrefixKVCache> prefix_cache_;
 };
 
 }  // namespace transformers
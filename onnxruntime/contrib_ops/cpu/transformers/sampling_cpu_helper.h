@@ -6,51 +6,48 @@ namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
-template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
-}
+// The number of the highest scores of a row that are ordered at first. It grows while top_p keeps all of them.
+constexpr size_t kInitialCandidateCount = 64;
 
-template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
-      }
-    }
+// Whether top_p keeps the token at `rank` of the scores in descending order, and `higher_probs` is the probability
+// of the tokens before it.
+inline bool IsKeptByTopP(size_t rank, float higher_probs, const transformers::IGenerationParameters* parameters) {
+  if (parameters->custom_sampling) {
+    return rank == 0 || higher_probs <= parameters->top_p;
   }
+
+  return rank < static_cast<size_t>(parameters->min_tokens_to_keep) || higher_probs < parameters->top_p;
 }
 
+// Order the candidates of a row by descending score, and return the number of them that top_p keeps. Only the kept
+// candidates and the next one are ordered, instead of the whole vocabulary.
 template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
+size_t SelectCandidates(gsl::span<const T> scores,
+                        gsl::span<const T> probs,
+                        gsl::span<size_t> candidates,
+                        const transformers::IGenerationParameters* parameters) {
+  const size_t vocab_size = scores.size();
+  std::iota(candidates.begin(), candidates.end(), size_t{0});
+  auto greater = [&scores](size_t i1, size_t i2) { return scores[i1] > scores[i2]; };
+
+  size_t ordered_count = 0;
+  size_t count = std::min(kInitialCandidateCount, vocab_size);
+  size_t rank = 0;
+  float higher_probs = 0.0f;
+  while (true) {
+    std::partial_sort(candidates.begin() + ordered_count, candidates.begin() + count, candidates.end(), greater);
+    ordered_count = count;
+    for (; rank < ordered_count; rank++) {
+      if (!IsKeptByTopP(rank, higher_probs, parameters)) {
+        return rank;
       }
+      higher_probs += probs[candidates[rank]];
+    }
+
+    if (ordered_count == vocab_size) {
+      return vocab_size;
     }
+    count = std::min(4 * count, vocab_size);
   }
 }
 
@@ -64,97 +61,102 @@ Status Sample(AllocatorPtr& allocator,
               const IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
-#endif
-
-  gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
+  const size_t batch_size = static_cast<size_t>(parameters->batch_size);
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
 
-  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
-                                    parameters->vocab_size,
-                                    sorted_scores.data(),
-                                    cumulative_probs.data(),
+  // The probabilities of the tokens. The tokens removed by top_p do not need their own softmax of the kept scores,
+  // since the sampling below only uses the ratios of the kept probabilities.
+  gsl::span<T>& probs = sampling_state->cumulative_probs;
+  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(batch_size,
+                                    vocab_size,
+                                    next_token_scores.data(),
+                                    probs.data(),
                                     false,
                                     thread_pool));
 
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  }
+  std::vector<size_t> sorted_indices(batch_size * vocab_size);
+  std::vector<size_t> kept_counts(batch_size);
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size),
+      [&](std::ptrdiff_t batch_index) {
+        const size_t offset = static_cast<size_t>(batch_index) * vocab_size;
+        kept_counts[batch_index] = SelectCandidates<T>(next_token_scores.subspan(offset, vocab_size),
+                                                       probs.subspan(offset, vocab_size),
+                                                       gsl::make_span(sorted_indices).subspan(offset, vocab_size),
+                                                       parameters);
+      },
+      0);
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
+  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
-  // torch.multinomial()
-  int64_t next_token_probs_dims[] = {static_cast<int64_t>(parameters->batch_size), parameters->vocab_size};
-  TensorShape next_token_probs_shape(&next_token_probs_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<T>();
-  OrtValue next_token_probs_value;
-  Tensor::InitOrtValue(element_type,
-                       next_token_probs_shape,
-                       next_token_scores.data(),
-                       allocator->Info(),
-                       next_token_probs_value);
-  const Tensor& input = next_token_probs_value.Get<Tensor>();
-
+  // torch.multinomial() of the scores where the tokens removed by top_p are set to filter_value. The samples are
+  // drawn row by row from the same generator, so they do not depend on how each row is sampled.
   std::default_random_engine& generator = sampling_state->generator;
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  gsl::span<int32_t>& next_token_idx = greedy_state->next_tokens;
+  std::vector<double> cdf;
+  for (size_t i = 0; i < batch_size; i++) {
+    const size_t offset = i * vocab_size;
+    gsl::span<T> scores = next_token_scores.subspan(offset, vocab_size);
+    gsl::span<size_t> kept = gsl::make_span(sorted_indices).subspan(offset, kept_counts[i]);
+
+    // Tokens set to filter_value have no weight when it is far below the other scores, so only the kept tokens are
+    // sampled. Otherwise the whole row is sampled like before.
+    const double max_score = std::max(kept.empty() ? std::numeric_limits<double>::lowest()
+                                                   : static_cast<double>(scores[kept[0]]),
+                                      static_cast<double>(parameters->filter_value));
+    if (!kept.empty() && std::exp(static_cast<double>(parameters->filter_value) - max_score) == 0.0) {
+      std::sort(kept.begin(), kept.end());
+      cdf.resize(kept.size());
+      double running_total = 0;
+      for (size_t j = 0; j < kept.size(); j++) {
+        const T score = scores[kept[j]];
+        if (std::isfinite(score)) {
+          running_total += std::exp(static_cast<double>(score) - max_score);
+        }
+        cdf[j] = running_total;
+      }
+
+      const double to_find = dist(generator) * running_total;
+      const size_t found = static_cast<size_t>(std::upper_bound(cdf.begin(), cdf.end(), to_find) - cdf.begin());
+      next_token_idx[i] = static_cast<int32_t>(kept[std::min(found, kept.size() - 1)]);
+      continue;
+    }
 
-  int64_t sampled_idx_dims[] = {static_cast<int64_t>(parameters->batch_size), 1};
-  TensorShape sampled_idx_shape(&sampled_idx_dims[0], 2);
+    for (size_t j = kept.size(); j < vocab_size; j++) {
+      scores[sorted_indices[offset + j]] = (T)parameters->filter_value;
+    }
 
-  gsl::span<int32_t>& next_token_idx = greedy_state->next_tokens;
+    int64_t row_dims[] = {1, parameters->vocab_size};
+    TensorShape row_shape(&row_dims[0], 2);
+    OrtValue row_value;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), row_shape, scores.data(), allocator->Info(), row_value);
+
+    int64_t sampled_idx_dims[] = {1, 1};
+    TensorShape sampled_idx_shape(&sampled_idx_dims[0], 2);
+    OrtValue sampled_idx_ov;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(),
+                         sampled_idx_shape,
+                         next_token_idx.data() + i,
+                         allocator->Info(),
+                         sampled_idx_ov);
+
+    // Copy the allocator because MultinomialComputeShared() uses move(allocator)
+    AllocatorPtr allocatortemp = allocator;
+    ORT_RETURN_IF_ERROR(MultinomialComputeShared<int32_t>(allocatortemp,
+                                                          row_value.Get<Tensor>(),
+                                                          1,
+                                                          parameters->vocab_size,
+                                                          1,
+                                                          generator,
+                                                          *sampled_idx_ov.GetMutable<Tensor>()));
+  }
 
-  OrtValue sampled_idx_ov;
-  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(),
-                       sampled_idx_shape,
-                       next_token_idx.data(),
-                       allocator->Info(),
-                       sampled_idx_ov);
-  Tensor* sampled_idx = sampled_idx_ov.GetMutable<Tensor>();
-
-  // Copy the allocator because MultinomialComputeShared() uses move(allocator)
-  AllocatorPtr allocatortemp = allocator;
-  ORT_RETURN_IF_ERROR(MultinomialComputeShared<int32_t>(allocatortemp,
-                                                        input,
-                                                        parameters->batch_size,
-                                                        parameters->vocab_size,
-                                                        1,
-                                                        generator,
-                                                        *sampled_idx));
   // TODO: update presence_mask()
 #ifdef DEBUG_GENERATION
-  dumper->Print("sampled_idx", *sampled_idx);
+  dumper->Print("sampled_idx", next_token_idx.data(), parameters->batch_size, 1);
 #endif
 
   return Status::OK();
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/common/safeint.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 
@@ -20,6 +23,7 @@ void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequenc
   batch_beam_size_ = batch_beam_size;
   max_length_ = max_length;
   current_length_ = sequence_length;
+  previous_beam_indices_.assign(batch_beam_size, -1);
 }
 
 void Sequences::InitDevice(gsl::span<int32_t> buffer) {
@@ -40,6 +44,10 @@ int Sequences::GetMaxLength() const {
   return max_length_;
 }
 
+int Sequences::GetPreviousBeamIndex(int beam_index) const {
+  return previous_beam_indices_[beam_index];
+}
+
 #ifdef DEBUG_GENERATION
 void Sequences::PrintSequences(const IConsoleDumper* dumper) const {
   for (int i = 0; i < batch_beam_size_; i++) {
@@ -67,6 +75,7 @@ void Sequences::AppendNextTokenToSequences(
     // Append next token to each beam.
     output[SafeInt<size_t>(i) * max_length_ + current_length_] = beam_next_tokens[i];
   }
+  std::copy_n(beam_indices.begin(), batch_beam_size_, previous_beam_indices_.begin());
 
   ++current_length_;
 
@@ -81,11 +90,13 @@ void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
   for (int i = 0; i < batch_beam_size_; i++) {
     output[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
   }
+  std::iota(previous_beam_indices_.begin(), previous_beam_indices_.end(), 0);
 
   ++current_length_;
 }
 
 void Sequences::AfterDeviceAppendedNextToken() {
+  std::fill(previous_beam_indices_.begin(), previous_beam_indices_.end(), -1);
   ++current_length_;
   current_sequences_buffer ^= 1;
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <gsl/gsl>
+#include "core/common/inlined_containers.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 #include "contrib_ops/cpu/utils/console_dumper.h"
 
@@ -29,6 +30,9 @@ class Sequences : public ISequences {
   // Returns max sequence length.
   int GetMaxLength() const override;
 
+  // Returns the beam index selected for a given beam index when the last token was appended.
+  int GetPreviousBeamIndex(int beam_index) const override;
+
 #ifdef DEBUG_GENERATION
   // Print the sequences to StdOut in debug mode
   void PrintSequences(const IConsoleDumper* dumper) const;
@@ -57,6 +61,9 @@ class Sequences : public ISequences {
   int batch_beam_size_;
   int max_length_;
   int current_length_;
+
+  // Beam indices of the last AppendNextTokenToSequences, -1 when not known like after the device appended them.
+  InlinedVector<int32_t> previous_beam_indices_;
 };
 
 }  // namespace transformers
@@ -184,6 +184,8 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
 
   int batch_beam_size = static_cast<int>(encoder_fetches[0].Get<Tensor>().Shape()[0]) * num_beam;
 
+  ORT_RETURN_IF(share_cross_kv_ && use_cuda, "decoder_share_cross_kv is only supported on CPU");
+
   // Copy beam next tokens in CPU to input_ids in provider device (CPU for CPU EP, or GPU for CUDA EP).
   int sequence_length = !copy_sequence_to_input_ids ? 1 : sequences.GetSequenceLength();
   int64_t dims[] = {batch_beam_size, sequence_length};
@@ -311,6 +313,10 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
 
     // Add cross inputs from encoder output.
     for (size_t j = 0; j < encoder_fetches.size(); j++) {
+      if (share_cross_kv_) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
       ADD_DECODER_FEED(encoder_fetches[j], false);
     }
   } else {
@@ -318,6 +324,10 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
     for (size_t j = 2; j < encoder_fetches.size(); j++) {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool is_dynamic_kv_cache = (j - first_past_input_index_) < 2 * static_cast<size_t>(num_layers);
+      if (share_cross_kv_ && !is_dynamic_kv_cache) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
       ADD_DECODER_FEED(encoder_fetches[j], is_dynamic_kv_cache);
     }
   }
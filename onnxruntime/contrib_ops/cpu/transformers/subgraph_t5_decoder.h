@@ -28,6 +28,9 @@ class T5DecoderSubgraph : public Subgraph {
       auto& attr = attributes.at("decoder_output_cross_qk");
       output_cross_qk_ = (attr.i() != 0LL);
     }
+    if (attributes.find("decoder_share_cross_kv") != attributes.end()) {
+      share_cross_kv_ = (attributes.at("decoder_share_cross_kv").i() != 0LL);
+    }
   }
 
   // Create inputs for first inference of decoder subgraph.
@@ -81,6 +84,9 @@ class T5DecoderSubgraph : public Subgraph {
   bool has_hidden_state_;
   bool has_encoder_input_ids_;
   bool use_sequence_as_input_ids_;
+
+  // Whether the cross attention key and value are fed without expanding them for the beams.
+  bool share_cross_kv_ = false;
 };
 
 }  // namespace transformers
@@ -157,6 +157,8 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
 
   // Allocate subgraph inputs from same device as inputs of encoder subgraph.
   AllocatorPtr allocator = session_state_->GetAllocator(encoder_feeds[0].Get<Tensor>().Location());
+  ORT_RETURN_IF(share_cross_kv_ && allocator->Info().device.Type() != OrtDevice::CPU,
+                "decoder_share_cross_kv is only supported on CPU");
 
   // Copy beam next tokens in CPU to input_ids in provider device (CPU for CPU EP, or GPU for CUDA EP).
   int batch_beam_size = static_cast<int>(beam_next_tokens.size());
@@ -228,6 +230,9 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
                                                      0 /*max_sequence_length*/));
       }
       decoder_feeds.push_back(expanded_hidden_states);
+    } else if (share_cross_kv_ && j >= 2 + 2 * static_cast<size_t>(num_layers)) {
+      // The cross attention key and value are shared by the beams.
+      decoder_feeds.push_back(encoder_fetches[j]);
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
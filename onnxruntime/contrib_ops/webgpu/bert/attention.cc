@@ -241,23 +241,49 @@ Status InPlaceSoftmaxProgram::GenerateShaderCode(ShaderHelper& shader) const {
                             << "for (var i: u32 = 0; i < uniforms.elements_per_thread && i + local_offset < seq_causal_length; i++) {\n"
                             << "  thread_max_vector = max(f32_val_t(x[offset + i]), thread_max_vector);\n"
                             << "}\n"
-                            << "thread_max[local_idx] = " << (components_ == 4 ? "max(max(thread_max_vector.x, thread_max_vector.y), max(thread_max_vector.z, thread_max_vector.w))" : (components_ == 2 ? "max(thread_max_vector.x, thread_max_vector.y)" : "thread_max_vector")) << ";\n"
-                            << "workgroupBarrier();\n"
-                            << "var max_value =  f32(-3.402823e+38f);\n"
-                            << "for (var i = 0u; i < " << work_group_size_ << "; i++) {\n"
-                            << "  max_value = max(thread_max[i], max_value);\n"
-                            << "}\n"
-                            << "var sum_vector = f32_val_t(0);\n"
+                            << "let thread_max_value = " << (components_ == 4 ? "max(max(thread_max_vector.x, thread_max_vector.y), max(thread_max_vector.z, thread_max_vector.w))" : (components_ == 2 ? "max(thread_max_vector.x, thread_max_vector.y)" : "thread_max_vector")) << ";\n";
+  if (use_subgroup_) {
+    // Reduce within each subgroup first, so that only the results of the subgroups go through the shared memory.
+    shader.MainFunctionBody() << "var max_value = subgroupMax(thread_max_value);\n"
+                              << "if (sg_id == 0u) {\n"
+                              << "  thread_max[local_idx / sg_size] = max_value;\n"
+                              << "}\n"
+                              << "workgroupBarrier();\n"
+                              << "for (var i = 0u; i < (" << work_group_size_ << " + sg_size - 1) / sg_size; i++) {\n"
+                              << "  max_value = max(thread_max[i], max_value);\n"
+                              << "}\n";
+  } else {
+    shader.MainFunctionBody() << "thread_max[local_idx] = thread_max_value;\n"
+                              << "workgroupBarrier();\n"
+                              << "var max_value =  f32(-3.402823e+38f);\n"
+                              << "for (var i = 0u; i < " << work_group_size_ << "; i++) {\n"
+                              << "  max_value = max(thread_max[i], max_value);\n"
+                              << "}\n";
+  }
+  shader.MainFunctionBody() << "var sum_vector = f32_val_t(0);\n"
                             << "for (var i: u32 = 0; i < uniforms.elements_per_thread && i + local_offset < seq_causal_length; i++) {\n"
                             << "  sum_vector += exp(f32_val_t(x[offset + i]) - max_value);\n"
                             << "}\n"
-                            << "thread_sum[local_idx] = " << (components_ == 4 ? "sum_vector.x + sum_vector.y + sum_vector.z + sum_vector.w" : (components_ == 2 ? "sum_vector.x + sum_vector.y" : "sum_vector")) << ";\n"
-                            << "workgroupBarrier();\n"
-                            << "var sum: f32 = 0;\n"
-                            << "for (var i = 0u; i < " << work_group_size_ << "; i++) {\n"
-                            << "  sum += thread_sum[i]\n;"
-                            << "}\n"
-                            << "if (sum == 0) {\n"
+                            << "let thread_sum_value = " << (components_ == 4 ? "sum_vector.x + sum_vector.y + sum_vector.z + sum_vector.w" : (components_ == 2 ? "sum_vector.x + sum_vector.y" : "sum_vector")) << ";\n";
+  if (use_subgroup_) {
+    shader.MainFunctionBody() << "let subgroup_sum = subgroupAdd(thread_sum_value);\n"
+                              << "if (sg_id == 0u) {\n"
+                              << "  thread_sum[local_idx / sg_size] = subgroup_sum;\n"
+                              << "}\n"
+                              << "workgroupBarrier();\n"
+                              << "var sum: f32 = 0;\n"
+                              << "for (var i = 0u; i < (" << work_group_size_ << " + sg_size - 1) / sg_size; i++) {\n"
+                              << "  sum += thread_sum[i];\n"
+                              << "}\n";
+  } else {
+    shader.MainFunctionBody() << "thread_sum[local_idx] = thread_sum_value;\n"
+                              << "workgroupBarrier();\n"
+                              << "var sum: f32 = 0;\n"
+                              << "for (var i = 0u; i < " << work_group_size_ << "; i++) {\n"
+                              << "  sum += thread_sum[i]\n;"
+                              << "}\n";
+  }
+  shader.MainFunctionBody() << "if (sum == 0) {\n"
                             << "  for (var i: u32 = 0; i < uniforms.elements_per_thread && i + local_offset < seq_causal_length; i++) {\n"
                             << "    x[offset + i] = x_value_t(x_element_t(1.0)/x_element_t(seq_causal_length));\n"
                             << "  }\n"
@@ -286,12 +312,13 @@ Status ComputeInPlaceSoftmax(onnxruntime::webgpu::ComputeContext& context, Tenso
   }
   const int elementsPerThread = (total_sequence_length_comp + work_group_size - 1) / work_group_size;
 
-  InPlaceSoftmaxProgram program{"InPlaceSoftmax", work_group_size, components, seqlen_k};
+  const bool use_subgroup = context.Device().HasFeature(wgpu::FeatureName::Subgroups);
+  InPlaceSoftmaxProgram program{"InPlaceSoftmax", work_group_size, components, seqlen_k, use_subgroup};
   if (seqlen_k != nullptr) {
     program.AddInput({seqlen_k, ProgramTensorMetadataDependency::TypeAndRank});
   }
   program.AddOutputs({{probs, ProgramTensorMetadataDependency::TypeAndRank, components}})
-      .CacheHint(work_group_size)
+      .CacheHint(work_group_size, use_subgroup)
       .SetDispatchGroupSize(1, sequence_length, batch_size * num_heads)
       .SetWorkgroupSize(work_group_size)
       .AddUniformVariables({{static_cast<uint32_t>(batch_size)},
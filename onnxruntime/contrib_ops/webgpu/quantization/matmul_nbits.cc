@@ -339,6 +339,20 @@ Status MatMulNBitsProgram::GenerateShaderCode(ShaderHelper& shader) const {
                                    "    workgroupBarrier();\n"
                                    "  }\n";
       if (tile_m_ == 1) {
+        if (use_subgroup_) {
+          // When a subgroup holds whole rows of inter_results, reduce each row with shuffles across its lanes
+          // instead of a serial loop over the shared memory.
+          shader.MainFunctionBody() << "  if (sg_size >= " << WorkgroupSizeX() << "u) {\n"
+                                    << "    var output_value = inter_results[local_id.y][local_id.x];\n";
+          for (uint32_t lane_mask = WorkgroupSizeX() / 2; lane_mask > 0; lane_mask /= 2) {
+            shader.MainFunctionBody() << "    output_value += subgroupShuffleXor(output_value, " << lane_mask << "u);\n";
+          }
+          shader.MainFunctionBody() << "    if (local_id.x == 0u && col + local_id.y < uniforms.output_shape[2]) {\n"
+                                    << "      " << y.SetByIndices("output_indices_t(batch, row, col + local_id.y)", "output_value") << ";\n"
+                                    << "    }\n"
+                                       "    return;\n"
+                                       "  }\n";
+        }
         shader.MainFunctionBody() << "  if (local_idx < " << WorkgroupSizeY() << ") {\n"
                                   << "    var output_value = output_value_t(0);\n"
                                   << "    for (var b = 0u; b < " << WorkgroupSizeX() << "; b++) {\n"
@@ -573,7 +587,10 @@ Status MatMulNBits::ComputeInternal(onnxruntime::webgpu::ComputeContext& context
   constexpr uint32_t output_number = 1;
   const uint32_t tile_m = M > kMinMForTileOptimization ? 4 : 1;
   const bool has_subgroup = context.Device().HasFeature(wgpu::FeatureName::Subgroups);
-  const bool use_subgroup = has_subgroup && context.AdapterInfo().vendor == std::string_view{"intel"} && components_a == 4 && block_size == 32;
+  // With tile_m of 1 the subgroups reduce the rows of 16 partial results, so the workgroup must be 16 x 8.
+  const bool use_subgroup = has_subgroup && block_size == 32 &&
+                            (tile_m == 1 ? N % 8 == 0
+                                         : context.AdapterInfo().vendor == std::string_view{"intel"} && components_a == 4);
   MatMulNBitsProgram program{output_number, block_size, tile_m, static_cast<int>(components_b), has_zero_points, use_subgroup};
   if (M > kMinMForTileOptimization && block_size == 32) {
     components = 1;
@@ -593,7 +610,7 @@ Status MatMulNBits::ComputeInternal(onnxruntime::webgpu::ComputeContext& context
     const uint32_t workgroup_x = workgroup_size / workgroup_y;
     program.SetWorkgroupSize(workgroup_x, workgroup_y, 1);
     program.SetDispatchGroupSize(data_size / components / workgroup_y);
-    program.CacheHint("T_M" + std::to_string(tile_m));
+    program.CacheHint("T_M" + std::to_string(tile_m) + "Subgroup" + std::to_string(use_subgroup));
   } else {
     program.SetDispatchGroupSize(data_size / components / output_number);
     program.CacheHint("O_N" + std::to_string(output_number));
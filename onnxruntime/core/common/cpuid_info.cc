@@ -22,6 +22,14 @@
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
 
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1 << 1)
+#endif
+
 #ifndef HWCAP2_I8MM
 #define HWCAP2_I8MM (1 << 13)
 #endif
@@ -139,6 +147,19 @@ void CPUIDInfo::X86Init() {
       }
     }
   }
+
+  // the processor brand string is held by the extended leaves 0x80000002 to 0x80000004
+  GetCPUID(static_cast<int>(0x80000000), data);
+  if (static_cast<uint32_t>(data[0]) >= 0x80000004) {
+    char brand[49] = {};
+    for (int i = 0; i < 3; i++) {
+      GetCPUID(static_cast<int>(0x80000002 + i), data);
+      memcpy(brand + 16 * i, data, 16);
+    }
+    model_name_ = brand;
+    // the brand string may be padded with leading spaces
+    model_name_.erase(0, model_name_.find_first_not_of(' '));
+  }
 }
 
 #endif  // defined(CPUIDINFO_ARCH_X86)
@@ -155,6 +176,8 @@ void CPUIDInfo::ArmLinuxInit() {
     has_arm_neon_dot_ = cpuinfo_has_arm_neon_dot();
     has_fp16_ = cpuinfo_has_arm_neon_fp16_arith();
     has_arm_neon_i8mm_ = cpuinfo_has_arm_i8mm();
+    has_arm_sve_ = cpuinfo_has_arm_sve();
+    has_arm_sve2_ = cpuinfo_has_arm_sve2();
     has_arm_sve_i8mm_ = cpuinfo_has_arm_sve() && cpuinfo_has_arm_i8mm();
     has_arm_neon_bf16_ = cpuinfo_has_arm_neon_bf16();
 
@@ -185,6 +208,8 @@ void CPUIDInfo::ArmLinuxInit() {
     has_fp16_ |= has_arm_neon_dot_;
 
     has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+    has_arm_sve_ = ((getauxval(AT_HWCAP) & HWCAP_SVE) != 0);
+    has_arm_sve2_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVE2) != 0);
     has_arm_sve_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVEI8MM) != 0);
 
     has_arm_neon_bf16_ = ((getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0);
@@ -255,6 +280,8 @@ void CPUIDInfo::ArmWindowsInit() {
   if (pytorch_cpuinfo_init_) {
     has_fp16_ = cpuinfo_has_arm_neon_fp16_arith();
     has_arm_neon_i8mm_ = cpuinfo_has_arm_i8mm();
+    has_arm_sve_ = cpuinfo_has_arm_sve();
+    has_arm_sve2_ = cpuinfo_has_arm_sve2();
     has_arm_sve_i8mm_ = cpuinfo_has_arm_sve() && cpuinfo_has_arm_i8mm();
     has_arm_neon_bf16_ = cpuinfo_has_arm_neon_bf16();
   } else
@@ -262,6 +289,8 @@ void CPUIDInfo::ArmWindowsInit() {
   {
     has_fp16_ = false;
     has_arm_neon_i8mm_ = false;
+    has_arm_sve_ = false;
+    has_arm_sve2_ = false;
     has_arm_sve_i8mm_ = false;
     has_arm_neon_bf16_ = false;
   }
@@ -276,6 +305,8 @@ void CPUIDInfo::ArmAppleInit() {
     has_arm_neon_dot_ = cpuinfo_has_arm_neon_dot();
     has_fp16_ = cpuinfo_has_arm_neon_fp16_arith();
     has_arm_neon_i8mm_ = cpuinfo_has_arm_i8mm();
+    has_arm_sve_ = cpuinfo_has_arm_sve();
+    has_arm_sve2_ = cpuinfo_has_arm_sve2();
     has_arm_sve_i8mm_ = cpuinfo_has_arm_sve() && cpuinfo_has_arm_i8mm();
     has_arm_neon_bf16_ = cpuinfo_has_arm_neon_bf16();
 
@@ -327,6 +358,11 @@ CPUIDInfo::CPUIDInfo() {
 #elif defined(__APPLE__)
   ArmAppleInit();
 #endif
+#if defined(CPUINFO_SUPPORTED)
+  if (pytorch_cpuinfo_init_ && cpuinfo_get_packages_count() > 0) {
+    model_name_ = cpuinfo_get_package(0)->name;
+  }
+#endif  // defined(CPUINFO_SUPPORTED)
 #endif  // defined(CPUIDINFO_ARCH_ARM)
 }
 }  // namespace onnxruntime
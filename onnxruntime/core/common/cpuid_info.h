@@ -29,6 +29,8 @@ class CPUIDInfo {
   // ARM
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
   bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
+  bool HasArmSVE() const { return has_arm_sve_; }
+  bool HasArmSVE2() const { return has_arm_sve2_; }
   bool HasArmSVE_I8MM() const { return has_arm_sve_i8mm_; }
   bool HasArmNeon_BF16() const { return has_arm_neon_bf16_; }
 
@@ -92,6 +94,9 @@ class CPUIDInfo {
     return has_fp16_;
   }
 
+  // Name of the processor model, e.g. the x86 brand string. Empty if it is unknown.
+  const std::string& GetCPUModelName() const { return model_name_; }
+
  private:
   CPUIDInfo();
   bool has_amx_bf16_{false};
@@ -104,6 +109,7 @@ class CPUIDInfo {
   bool has_sse3_{false};
   bool has_sse4_1_{false};
   bool is_hybrid_{false};
+  std::string model_name_;
 
   std::vector<uint32_t> core_uarchs_;  // micro-arch of each core
 
@@ -115,6 +121,8 @@ class CPUIDInfo {
   bool has_arm_neon_dot_{false};
   bool has_fp16_{false};
   bool has_arm_neon_i8mm_{false};
+  bool has_arm_sve_{false};
+  bool has_arm_sve2_{false};
   bool has_arm_sve_i8mm_{false};
   bool has_arm_neon_bf16_{false};
 
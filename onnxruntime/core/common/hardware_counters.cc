@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+HardwareCounterValues& HardwareCounterValues::operator+=(const HardwareCounterValues& other) {
+  cycles += other.cycles;
+  instructions += other.instructions;
+  llc_misses += other.llc_misses;
+  llc_read_misses += other.llc_read_misses;
+  dtlb_misses += other.dtlb_misses;
+  return *this;
+}
+
+HardwareCounterValues HardwareCounterValues::operator-(const HardwareCounterValues& other) const {
+  // counters of the same thread only increase, but threads may be attached between two reads
+  const auto diff = [](uint64_t a, uint64_t b) { return a > b ? a - b : 0; };
+  HardwareCounterValues result;
+  result.cycles = diff(cycles, other.cycles);
+  result.instructions = diff(instructions, other.instructions);
+  result.llc_misses = diff(llc_misses, other.llc_misses);
+  result.llc_read_misses = diff(llc_read_misses, other.llc_read_misses);
+  result.dtlb_misses = diff(dtlb_misses, other.dtlb_misses);
+  return result;
+}
+
+std::string HardwareCounterValues::ToJson(bool has_cache_counters, bool has_tlb_counter) const {
+  std::ostringstream out;
+  out << "{\"cycles\": " << cycles << ", \"instructions\": " << instructions << ", \"ipc\": " << std::fixed
+      << std::setprecision(3) << (cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles));
+  if (has_cache_counters) {
+    out << ", \"llc_misses\": " << llc_misses << ", \"bytes_read\": " << BytesRead();
+  }
+  if (has_tlb_counter) {
+    out << ", \"dtlb_misses\": " << dtlb_misses;
+  }
+  out << "}";
+  return out.str();
+}
+
+#if defined(__linux__)
+
+namespace {
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr CounterConfig kCoreCounters[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+};
+
+constexpr CounterConfig kCacheCounters[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+constexpr CounterConfig kTlbCounters[] = {
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+int OpenCounter(const CounterConfig& counter, int thread_id, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = counter.type;
+  attr.size = sizeof(attr);
+  attr.config = counter.config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // user space only, so the counters are available with the default perf_event_paranoid level of 2
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, thread_id, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+// Opens a counter group for the thread and appends the file descriptors of its counters to fds, the group leader
+// first. The TLB counter is only opened with the cache counters. Returns false, after closing the counters it opened,
+// on failure.
+bool OpenCounterGroup(int thread_id, bool with_cache_counters, bool with_tlb_counter, std::vector<int>& fds) {
+  const size_t first_fd = fds.size();
+  const auto open_counters = [&](const auto& counters) {
+    for (const auto& counter : counters) {
+      const int fd = OpenCounter(counter, thread_id, fds.size() == first_fd ? -1 : fds[first_fd]);
+      if (fd < 0) {
+        return false;
+      }
+      fds.push_back(fd);
+    }
+    return true;
+  };
+
+  if (!open_counters(kCoreCounters) || (with_cache_counters && !open_counters(kCacheCounters)) ||
+      (with_cache_counters && with_tlb_counter && !open_counters(kTlbCounters))) {
+    const int open_errno = errno;
+    for (size_t i = first_fd; i < fds.size(); ++i) {
+      close(fds[i]);
+    }
+    fds.resize(first_fd);
+    errno = open_errno;
+    return false;
+  }
+  return true;
+}
+
+std::vector<int> GetProcessThreadIds() {
+  std::vector<int> thread_ids;
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return thread_ids;
+  }
+  while (const dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      thread_ids.push_back(std::atoi(entry->d_name));
+    }
+  }
+  closedir(dir);
+  return thread_ids;
+}
+}  // namespace
+
+std::unique_ptr<HardwareCounters> HardwareCounters::Create(const logging::Logger& logger) {
+  const int thread_id = static_cast<int>(syscall(SYS_gettid));
+  std::vector<int> fds;
+  bool has_tlb_counter = OpenCounterGroup(thread_id, true, true, fds);
+  bool has_cache_counters = has_tlb_counter || OpenCounterGroup(thread_id, true, false, fds);
+  if (!has_cache_counters && !OpenCounterGroup(thread_id, false, false, fds)) {
+    LOGS(logger, WARNING) << "Hardware performance counters are not available: perf_event_open failed with errno "
+                          << errno << ". Check /proc/sys/kernel/perf_event_paranoid.";
+    return nullptr;
+  }
+  for (const int fd : fds) {
+    close(fd);
+  }
+
+  std::unique_ptr<HardwareCounters> counters(new HardwareCounters(logger, has_cache_counters, has_tlb_counter));
+  counters->AttachToNewThreads();
+  return counters;
+}
+
+HardwareCounters::HardwareCounters(const logging::Logger& logger, bool has_cache_counters, bool has_tlb_counter)
+    : logger_(logger), has_cache_counters_(has_cache_counters), has_tlb_counter_(has_tlb_counter) {
+}
+
+HardwareCounters::~HardwareCounters() {
+  for (const int fd : counter_fds_) {
+    close(fd);
+  }
+}
+
+void HardwareCounters::AttachToNewThreads() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const int thread_id : GetProcessThreadIds()) {
+    if (thread_ids_.count(thread_id) == 0 && AttachToThread(thread_id)) {
+      thread_ids_.insert(thread_id);
+    }
+  }
+}
+
+bool HardwareCounters::AttachToThread(int thread_id) {
+  const size_t leader_fd_index = counter_fds_.size();
+  if (!OpenCounterGroup(thread_id, has_cache_counters_, has_tlb_counter_, counter_fds_)) {
+    LOGS(logger_, VERBOSE) << "Could not open the hardware performance counters of thread " << thread_id
+                           << ", errno " << errno;
+    return false;
+  }
+  group_fds_.push_back(counter_fds_[leader_fd_index]);
+  return true;
+}
+
+HardwareCounterValues HardwareCounters::Read() const {
+  constexpr size_t kNumCounters = std::size(kCoreCounters) + std::size(kCacheCounters) + std::size(kTlbCounters);
+  // PERF_FORMAT_GROUP layout: number of counters followed by their values
+  uint64_t buffer[1 + kNumCounters];
+
+  HardwareCounterValues total;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const int fd : group_fds_) {
+    const ssize_t bytes_read = read(fd, buffer, sizeof(buffer));
+    if (bytes_read < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+      continue;
+    }
+    HardwareCounterValues values;
+    values.cycles = buffer[1];
+    values.instructions = buffer[2];
+    if (has_cache_counters_ && buffer[0] >= 4) {
+      values.llc_misses = buffer[3];
+      values.llc_read_misses = buffer[4];
+    }
+    if (has_tlb_counter_ && buffer[0] >= kNumCounters) {
+      values.dtlb_misses = buffer[5];
+    }
+    total += values;
+  }
+  return total;
+}
+
+#else
+
+std::unique_ptr<HardwareCounters> HardwareCounters::Create(const logging::Logger& logger) {
+  LOGS(logger, WARNING) << "Hardware performance counters are only available on Linux.";
+  return nullptr;
+}
+
+HardwareCounters::HardwareCounters(const logging::Logger& logger, bool has_cache_counters, bool has_tlb_counter)
+    : logger_(logger), has_cache_counters_(has_cache_counters), has_tlb_counter_(has_tlb_counter) {
+}
+
+HardwareCounters::~HardwareCounters() = default;
+
+void HardwareCounters::AttachToNewThreads() {
+}
+
+bool HardwareCounters::AttachToThread(int /*thread_id*/) {
+  return false;
+}
+
+HardwareCounterValues HardwareCounters::Read() const {
+  return {};
+}
+
+#endif  // defined(__linux__)
+
+void HardwareCounters::RecordOpType(const std::string& op_type, const HardwareCounterValues& values) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  op_type_totals_[op_type] += values;
+}
+
+std::map<std::string, HardwareCounterValues> HardwareCounters::TakeOpTypeTotals() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, HardwareCounterValues> totals;
+  totals.swap(op_type_totals_);
+  return totals;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  // LLC read misses, i.e. cache lines read from memory
+  uint64_t llc_read_misses = 0;
+  // data TLB load misses, which large pages reduce
+  uint64_t dtlb_misses = 0;
+
+  HardwareCounterValues& operator+=(const HardwareCounterValues& other);
+  HardwareCounterValues operator-(const HardwareCounterValues& other) const;
+
+  uint64_t BytesRead() const { return llc_read_misses * kCacheLineSize; }
+
+  // Returns the values as a JSON object, e.g. {"cycles": 1, "instructions": 2, "ipc": 2.000, ...}.
+  // Only the counters that are available are included.
+  std::string ToJson(bool has_cache_counters, bool has_tlb_counter = false) const;
+
+  static constexpr uint64_t kCacheLineSize = 64;
+};
+
+/**
+ * Hardware performance counters of the threads of the process: cycles, instructions, LLC misses, LLC read misses and
+ * data TLB misses.
+ * Only available on Linux through perf_event_open, which requires a perf_event_paranoid level of 2 or less.
+ *
+ * The counters of every thread of the process are opened, so the difference between two reads includes the work
+ * done by the intra-op thread pool for a kernel, but also the work done meanwhile by kernels of concurrent runs.
+ * Threads started after Create or the last call to AttachToNewThreads are not counted.
+ */
+class HardwareCounters {
+ public:
+  // Returns nullptr, after logging the reason, if the counters are not available.
+  static std::unique_ptr<HardwareCounters> Create(const logging::Logger& logger);
+
+  ~HardwareCounters();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HardwareCounters);
+
+  // Opens the counters of the threads of the process that are not counted yet.
+  void AttachToNewThreads();
+
+  // Whether the LLC counters are available. Cycles and instructions always are.
+  bool HasCacheCounters() const noexcept { return has_cache_counters_; }
+
+  // Whether the data TLB counter is available. Only when the LLC counters are.
+  bool HasTlbCounter() const noexcept { return has_tlb_counter_; }
+
+  // Returns the sum of the counters of all the threads.
+  HardwareCounterValues Read() const;
+
+  // Adds the counters of a kernel to the totals of its op type.
+  void RecordOpType(const std::string& op_type, const HardwareCounterValues& values);
+
+  // Returns the totals per op type and clears them.
+  std::map<std::string, HardwareCounterValues> TakeOpTypeTotals();
+
+ private:
+  HardwareCounters(const logging::Logger& logger, bool has_cache_counters, bool has_tlb_counter);
+
+  // Opens the counter group of a thread. Returns false on failure. Requires mutex_.
+  bool AttachToThread(int thread_id);
+
+  const logging::Logger& logger_;
+  const bool has_cache_counters_;
+  const bool has_tlb_counter_;
+
+  mutable std::mutex mutex_;
+  // file descriptors of all the counters, and of the group leader of each thread
+  std::vector<int> counter_fds_;
+  std::vector<int> group_fds_;
+  std::unordered_set<int> thread_ids_;
+  std::map<std::string, HardwareCounterValues> op_type_totals_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
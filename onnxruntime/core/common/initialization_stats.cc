@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/initialization_stats.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+void WriteJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+}  // namespace
+
+void InitializationStats::Add(const char* phase, const std::string& name, Clock::duration duration) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto [it, inserted] = phase_indices_.try_emplace(std::make_pair(std::string(phase), name), phases_.size());
+  if (inserted) {
+    Phase& entry = phases_.emplace_back();
+    entry.phase = phase;
+    entry.name = name;
+  }
+
+  Phase& entry = phases_[it->second];
+  ++entry.count;
+  entry.duration += duration;
+}
+
+std::string InitializationStats::GetStatsJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "[";
+  for (size_t i = 0; i < phases_.size(); ++i) {
+    const Phase& entry = phases_[i];
+    out << (i > 0 ? ", " : "") << "{\"phase\": ";
+    WriteJsonString(out, entry.phase);
+    out << ", \"name\": ";
+    WriteJsonString(out, entry.name);
+    out << ", \"count\": " << entry.count << ", \"duration_us\": "
+        << std::chrono::duration<double, std::micro>(entry.duration).count() << "}";
+  }
+  out << "]";
+  return out.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Always-on breakdown of the time spent initializing a session, see InferenceSession::GetInitializationStats.
+ *
+ * The time is accumulated per phase, e.g. "graph_transformer", and per name within the phase, e.g. the name of the
+ * transformer or the type of the execution provider. Phases nest: the time of "partitioning" includes the time of
+ * the "get_capability" and "compile" phases of the execution providers. Initializers are loaded and pre-packed per
+ * initializer, whose time is only broken down for the initializers of at least min_initializer_bytes.
+ *
+ * Thread-safe, as initializers may be loaded and pre-packed concurrently.
+ */
+class InitializationStats {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit InitializationStats(size_t min_initializer_bytes = kDefaultMinInitializerBytes)
+      : min_initializer_bytes_(min_initializer_bytes) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InitializationStats);
+
+  static constexpr size_t kDefaultMinInitializerBytes = 1024 * 1024;
+
+  void Add(const char* phase, const std::string& name, Clock::duration duration);
+
+  // Adds the time spent on an initializer in phase, if it holds at least min_initializer_bytes.
+  void AddInitializer(const char* phase, const std::string& name, size_t size_in_bytes, Clock::duration duration) {
+    if (size_in_bytes >= min_initializer_bytes_) {
+      Add(phase, name, duration);
+    }
+  }
+
+  // Returns the phases in the order they started, as a JSON array of
+  // {"phase": ..., "name": ..., "count": ..., "duration_us": ...}.
+  std::string GetStatsJson() const;
+
+  // Adds the time from its construction to its destruction to a phase. Does nothing if stats is nullptr.
+  class ScopedPhase {
+   public:
+    ScopedPhase(InitializationStats* stats, const char* phase, std::string name = {})
+        : stats_(stats), phase_(phase), name_(std::move(name)), start_(stats ? Clock::now() : Clock::time_point{}) {}
+
+    ~ScopedPhase() {
+      if (stats_ != nullptr) {
+        stats_->Add(phase_, name_, Clock::now() - start_);
+      }
+    }
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedPhase);
+
+   private:
+    InitializationStats* const stats_;
+    const char* const phase_;
+    const std::string name_;
+    const Clock::time_point start_;
+  };
+
+ private:
+  struct Phase {
+    std::string phase;
+    std::string name;
+    size_t count = 0;
+    Clock::duration duration{};
+  };
+
+  const size_t min_initializer_bytes_;
+
+  mutable std::mutex mutex_;
+  std::vector<Phase> phases_;
+  // index in phases_ by phase and name
+  std::map<std::pair<std::string, std::string>, size_t> phase_indices_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -75,16 +75,44 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::string& event_name,
                                      const TimePoint& start_time,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
+                                     bool sync_gpu) {
+  EndTimeAndRecordEvent(category, event_name, start_time,
+                        std::unordered_map<std::string, std::string>{event_args.begin(), event_args.end()}, sync_gpu);
+}
+
+void Profiler::EndTimeAndRecordEvent(EventCategory category,
+                                     const std::string& event_name,
+                                     const TimePoint& start_time,
+                                     std::unordered_map<std::string, std::string>&& event_args,
                                      bool /*sync_gpu*/) {
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
   EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+                    logging::GetThreadId(), event_name, ts, dur, std::move(event_args));
+  // TODO: sync_gpu if needed.
+  RecordEvent(std::move(event));
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordCounterEvent(EventCategory category,
+                                  const std::string& event_name,
+                                  std::unordered_map<std::string, std::string>&& counters) {
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+
+  EventRecord event(category, logging::GetProcessId(),
+                    logging::GetThreadId(), event_name, ts, 0, std::move(counters));
+  event.phase = 'C';
+  RecordEvent(std::move(event));
+}
+
+void Profiler::RecordEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
-    // TODO: sync_gpu if needed.
     std::lock_guard<std::mutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
       events_.emplace_back(std::move(event));
@@ -96,10 +124,6 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
       }
     }
   }
-
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
-  }
 }
 
 std::string Profiler::EndProfiling() {
@@ -129,13 +153,14 @@ std::string Profiler::EndProfiling() {
     profile_stream_ << "\"tid\" :" << rec.tid << ",";
     profile_stream_ << "\"dur\" :" << rec.dur << ",";
     profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
+    profile_stream_ << R"("ph" : ")" << rec.phase << "\",";
     profile_stream_ << R"("name" :")" << rec.name << "\",";
     profile_stream_ << "\"args\" : {";
     bool is_first_arg = true;
     for (std::pair<std::string, std::string> event_arg : rec.args) {
       if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
+      if (rec.phase == 'C' ||
+          (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '['))) {
         profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
       } else {
         profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
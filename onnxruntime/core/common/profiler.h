@@ -8,6 +8,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
@@ -80,6 +81,24 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record a single event with arguments built at runtime. Time is measured till the call of this function from
+  the start_time.
+  */
+  void EndTimeAndRecordEvent(EventCategory category,
+                             const std::string& event_name,
+                             const TimePoint& start_time,
+                             std::unordered_map<std::string, std::string>&& event_args,
+                             bool sync_gpu = false);
+
+  /*
+  Record a counter event at the current time, shown as a counter track named event_name in the Chrome trace viewer.
+  The values of counters must be numbers.
+  */
+  void RecordCounterEvent(EventCategory category,
+                          const std::string& event_name,
+                          std::unordered_map<std::string, std::string>&& counters);
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -122,6 +141,8 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void RecordEvent(EventRecord&& event);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
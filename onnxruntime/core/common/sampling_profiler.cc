@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+int FloorLog2(uint64_t value) {
+  int result = 0;
+  while (value >>= 1) {
+    ++result;
+  }
+  return result;
+}
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+void WriteJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void WriteHistogramStats(std::ostream& out, const LatencyHistogram& histogram) {
+  const auto to_us = [](uint64_t value_ns) { return static_cast<double>(value_ns) / 1000.0; };
+  out << "\"count\": " << histogram.Count()
+      << ", \"mean_us\": " << histogram.Mean() / 1000.0
+      << ", \"min_us\": " << to_us(histogram.Min())
+      << ", \"p50_us\": " << to_us(histogram.Quantile(0.5))
+      << ", \"p90_us\": " << to_us(histogram.Quantile(0.9))
+      << ", \"p99_us\": " << to_us(histogram.Quantile(0.99))
+      << ", \"max_us\": " << to_us(histogram.Max());
+}
+}  // namespace
+
+size_t LatencyHistogram::BucketIndex(uint64_t value_ns) {
+  if (value_ns < static_cast<uint64_t>(kSubBuckets)) {
+    return static_cast<size_t>(value_ns);
+  }
+  const int exponent = FloorLog2(value_ns);
+  if (exponent >= kMaxExponent) {
+    return kNumBuckets - 1;
+  }
+  const size_t sub_bucket = static_cast<size_t>(value_ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return static_cast<size_t>(exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+  if (index < static_cast<size_t>(kSubBuckets)) {
+    return index;
+  }
+  const int shift = static_cast<int>(index / kSubBuckets) - 1;
+  const uint64_t lower_bound = static_cast<uint64_t>(kSubBuckets + index % kSubBuckets) << shift;
+  return lower_bound + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::Add(uint64_t value_ns) {
+  ++counts_[BucketIndex(value_ns)];
+  ++count_;
+  sum_ += value_ns;
+  min_ = std::min(min_, value_ns);
+  max_ = std::max(max_, value_ns);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::Quantile(double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const double clamped_q = std::min(std::max(q, 0.0), 1.0);
+  const uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(clamped_q * static_cast<double>(count_))), 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::min(std::max(BucketUpperBound(i), min_), max_);
+    }
+  }
+  return max_;
+}
+
+SamplingProfiler::SamplingProfiler(std::vector<NodeInfo> nodes, uint32_t sampling_interval,
+                                   size_t min_ring_buffer_size)
+    : nodes_(std::move(nodes)),
+      sampling_interval_(sampling_interval),
+      ring_buffer_mask_(RoundUpToPowerOfTwo(std::max(min_ring_buffer_size, 2 * nodes_.size())) - 1),
+      ring_buffer_(std::make_unique<Slot[]>(ring_buffer_mask_ + 1)),
+      node_histograms_(nodes_.size()) {
+  ORT_ENFORCE(sampling_interval_ > 0, "The sampling interval must be positive.");
+}
+
+bool SamplingProfiler::ShouldSampleRun() noexcept {
+  if (run_counter_.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ != 0) {
+    return false;
+  }
+  sampled_runs_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void SamplingProfiler::RecordNode(size_t node_index, std::chrono::nanoseconds latency) noexcept {
+  const uint64_t index = write_index_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = ring_buffer_[index & ring_buffer_mask_];
+  // the slot is marked as being written first so the reader can detect a sample overwritten while reading it
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.node_index.store(node_index, std::memory_order_relaxed);
+  slot.latency_ns.store(static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0)), std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void SamplingProfiler::EndSampledRun() {
+  std::unique_lock<std::mutex> lock(drain_mutex_, std::try_to_lock);
+  if (lock.owns_lock()) {
+    DrainLocked();
+  }
+}
+
+void SamplingProfiler::DrainLocked() {
+  const uint64_t write_index = write_index_.load(std::memory_order_acquire);
+  const uint64_t ring_buffer_size = ring_buffer_mask_ + 1;
+  if (write_index - read_index_ > ring_buffer_size) {
+    dropped_samples_ += write_index - read_index_ - ring_buffer_size;
+    read_index_ = write_index - ring_buffer_size;
+  }
+
+  for (; read_index_ < write_index; ++read_index_) {
+    const Slot& slot = ring_buffer_[read_index_ & ring_buffer_mask_];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || sequence < read_index_ + 1) {
+      // the sample is still being written, it is read by the next drain
+      break;
+    }
+    const uint64_t node_index = slot.node_index.load(std::memory_order_relaxed);
+    const uint64_t latency_ns = slot.latency_ns.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence != read_index_ + 1 || slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      // overwritten by a more recent sample
+      ++dropped_samples_;
+      continue;
+    }
+    if (node_index >= nodes_.size() || nodes_[node_index].op_type.empty()) {
+      continue;
+    }
+    auto& histogram = node_histograms_[node_index];
+    if (!histogram) {
+      histogram = std::make_unique<LatencyHistogram>();
+    }
+    histogram->Add(latency_ns);
+  }
+}
+
+std::string SamplingProfiler::GetStatsJson() {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  DrainLocked();
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"sampling_interval\": " << sampling_interval_
+      << ", \"sampled_runs\": " << sampled_runs_.load(std::memory_order_relaxed)
+      << ", \"dropped_samples\": " << dropped_samples_
+      << ", \"nodes\": [";
+
+  std::map<std::string, LatencyHistogram> op_type_histograms;
+  bool first = true;
+  for (size_t i = 0; i < node_histograms_.size(); ++i) {
+    const auto& histogram = node_histograms_[i];
+    if (!histogram) {
+      continue;
+    }
+    out << (first ? "" : ", ") << "{\"node_index\": " << i << ", \"name\": ";
+    WriteJsonString(out, nodes_[i].name);
+    out << ", \"op_type\": ";
+    WriteJsonString(out, nodes_[i].op_type);
+    out << ", ";
+    WriteHistogramStats(out, *histogram);
+    out << "}";
+    first = false;
+    op_type_histograms[nodes_[i].op_type].Merge(*histogram);
+  }
+
+  out << "], \"op_types\": [";
+  first = true;
+  for (const auto& [op_type, histogram] : op_type_histograms) {
+    out << (first ? "" : ", ") << "{\"op_type\": ";
+    WriteJsonString(out, op_type);
+    out << ", ";
+    WriteHistogramStats(out, histogram);
+    out << "}";
+    first = false;
+  }
+  out << "]}";
+  return out.str();
+}
+
+void SamplingProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  DrainLocked();
+  for (auto& histogram : node_histograms_) {
+    histogram.reset();
+  }
+  dropped_samples_ = 0;
+  sampled_runs_.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram SamplingProfiler::GetNodeHistogram(size_t node_index) {
+  std::lock_guard<std::mutex> lock(drain_mutex_);
+  DrainLocked();
+  if (node_index >= node_histograms_.size() || !node_histograms_[node_index]) {
+    return LatencyHistogram();
+  }
+  return *node_histograms_[node_index];
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
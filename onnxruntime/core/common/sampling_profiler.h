@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Log-linear histogram of latencies in nanoseconds.
+ * Each power of two is split in kSubBuckets buckets, so quantiles are within 1/kSubBuckets of the recorded values.
+ * Values above 2^kMaxExponent ns (~68 seconds) are counted in the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  void Add(uint64_t value_ns);
+  void Merge(const LatencyHistogram& other);
+
+  uint64_t Count() const { return count_; }
+  uint64_t Min() const { return count_ == 0 ? 0 : min_; }
+  uint64_t Max() const { return max_; }
+  double Mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+  // Returns an upper bound of the value at quantile q in [0, 1]. Returns 0 if the histogram is empty.
+  uint64_t Quantile(double q) const;
+
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxExponent = 36;
+  static constexpr size_t kNumBuckets = (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+  static size_t BucketIndex(uint64_t value_ns);
+  // Largest value counted in the bucket at index.
+  static uint64_t BucketUpperBound(size_t index);
+
+ private:
+  std::array<uint64_t, kNumBuckets> counts_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+};
+
+/**
+ * Always-on, low-overhead kernel latency profiler.
+ *
+ * One run out of every sampling_interval runs is sampled. The kernels of a sampled run record their latency in a fixed
+ * size lock-free ring buffer, so recording never blocks nor allocates. The ring buffer is drained into per-node and
+ * per-op-type histograms at the end of the sampled runs and when the statistics are queried. Samples overwritten
+ * before being drained are counted as dropped.
+ */
+class SamplingProfiler {
+ public:
+  struct NodeInfo {
+    std::string name;
+    std::string op_type;
+  };
+
+  // nodes are indexed by node index. Nodes with an empty op type are not recorded.
+  // The ring buffer holds at least min_ring_buffer_size samples and two runs worth of samples.
+  SamplingProfiler(std::vector<NodeInfo> nodes, uint32_t sampling_interval, size_t min_ring_buffer_size = 4096);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SamplingProfiler);
+
+  uint32_t SamplingInterval() const noexcept { return sampling_interval_; }
+
+  // Called once per run. Returns true if the kernels of the run should be recorded.
+  bool ShouldSampleRun() noexcept;
+
+  // Records the latency of a kernel of a sampled run. Thread-safe and lock-free.
+  void RecordNode(size_t node_index, std::chrono::nanoseconds latency) noexcept;
+
+  // Called at the end of a sampled run. Drains the ring buffer unless another thread is already doing so.
+  void EndSampledRun();
+
+  // Returns the latency statistics gathered so far as a JSON object:
+  // {"sampling_interval": N, "sampled_runs": N, "dropped_samples": N,
+  //  "nodes": [{"node_index": N, "name": "...", "op_type": "...", "count": N,
+  //             "mean_us": X, "min_us": X, "p50_us": X, "p90_us": X, "p99_us": X, "max_us": X}, ...],
+  //  "op_types": [{"op_type": "...", "count": N, "mean_us": X, ...}, ...]}
+  std::string GetStatsJson();
+
+  // Clears the statistics gathered so far.
+  void Reset();
+
+  // Returns a copy of the histogram of the latencies of a node.
+  LatencyHistogram GetNodeHistogram(size_t node_index);
+
+ private:
+  struct Slot {
+    // index + 1 of the sample stored in the slot, 0 while it is being written
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> node_index{0};
+    std::atomic<uint64_t> latency_ns{0};
+  };
+
+  // Moves the samples of the ring buffer into the histograms. Requires drain_mutex_.
+  void DrainLocked();
+
+  const std::vector<NodeInfo> nodes_;
+  const uint32_t sampling_interval_;
+  const size_t ring_buffer_mask_;
+  std::unique_ptr<Slot[]> ring_buffer_;
+
+  std::atomic<uint64_t> run_counter_{0};
+  std::atomic<uint64_t> sampled_runs_{0};
+  std::atomic<uint64_t> write_index_{0};
+
+  std::mutex drain_mutex_;
+  uint64_t read_index_ = 0;
+  uint64_t dropped_samples_ = 0;
+  std::vector<std::unique_ptr<LatencyHistogram>> node_histograms_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/session_metrics.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+// Returns the label set of a sample, e.g. {session_id="1",le="0.001"}, or an empty string if there are no labels.
+std::string LabelSet(const std::string& labels, const std::string& extra_label = {}) {
+  if (labels.empty() && extra_label.empty()) {
+    return std::string();
+  }
+  return "{" + labels + (labels.empty() || extra_label.empty() ? "" : ",") + extra_label + "}";
+}
+
+double ToSeconds(uint64_t value_us) { return static_cast<double>(value_us) / 1e6; }
+}  // namespace
+
+void SessionMetrics::Histogram::Add(uint64_t value_us) {
+  const auto bound = std::lower_bound(kLatencyBucketBoundsUs.begin(), kLatencyBucketBoundsUs.end(), value_us);
+  buckets_[static_cast<size_t>(bound - kLatencyBucketBoundsUs.begin())].fetch_add(1, std::memory_order_relaxed);
+  sum_us_.fetch_add(value_us, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SessionMetrics::Histogram::Write(std::ostream& out, const char* name, const char* help,
+                                      const std::string& labels) const {
+  WriteFamily(out, name, "histogram", help);
+  // the buckets of the OpenMetrics histograms are cumulative
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    cumulative_count += buckets_[i].load(std::memory_order_relaxed);
+    const std::string le = i < kLatencyBucketBoundsUs.size()
+                               ? MakeString("le=\"", ToSeconds(kLatencyBucketBoundsUs[i]), "\"")
+                               : std::string("le=\"+Inf\"");
+    out << name << "_bucket" << LabelSet(labels, le) << " " << cumulative_count << "\n";
+  }
+  // the buckets and the count are read separately, keep them consistent for the scrapers
+  const double sum_seconds = ToSeconds(sum_us_.load(std::memory_order_relaxed));
+  out << name << "_sum" << LabelSet(labels) << " " << std::to_string(sum_seconds) << "\n"
+      << name << "_count" << LabelSet(labels) << " " << cumulative_count << "\n";
+}
+
+void SessionMetrics::RecordConcurrentRuns(int num_runs) {
+  int max_runs = max_concurrent_runs_.load(std::memory_order_relaxed);
+  while (num_runs > max_runs &&
+         !max_concurrent_runs_.compare_exchange_weak(max_runs, num_runs, std::memory_order_relaxed)) {
+  }
+}
+
+void SessionMetrics::WriteFamily(std::ostream& out, const char* name, const char* type, const char* help) {
+  out << "# TYPE " << name << " " << type << "\n"
+      << "# HELP " << name << " " << help << "\n";
+}
+
+void SessionMetrics::WriteOpenMetrics(std::ostream& out, const std::string& labels) const {
+  const std::string label_set = LabelSet(labels);
+
+  WriteFamily(out, "onnxruntime_session_runs", "counter", "Number of completed runs of the session.");
+  out << "onnxruntime_session_runs_total" << label_set << " " << run_duration_.Count() << "\n";
+  WriteFamily(out, "onnxruntime_session_failed_runs", "counter", "Number of runs of the session that failed.");
+  out << "onnxruntime_session_failed_runs_total" << label_set << " "
+      << failed_runs_.load(std::memory_order_relaxed) << "\n";
+  run_duration_.Write(out, "onnxruntime_session_run_duration_seconds", "Duration of the runs of the session.",
+                      labels);
+  queue_wait_.Write(out, "onnxruntime_session_queue_wait_seconds",
+                    "Time the RunAsync requests waited for a thread of the intra-op thread pool.", labels);
+  WriteFamily(out, "onnxruntime_session_max_concurrent_runs", "gauge",
+              "Largest number of runs of the session in progress at the same time.");
+  out << "onnxruntime_session_max_concurrent_runs" << label_set << " "
+      << max_concurrent_runs_.load(std::memory_order_relaxed) << "\n";
+  WriteFamily(out, "onnxruntime_session_graph_replays", "counter",
+              "Number of runs that replayed a captured graph, e.g. a CUDA graph.");
+  out << "onnxruntime_session_graph_replays_total" << label_set << " "
+      << graph_replays_.load(std::memory_order_relaxed) << "\n";
+  WriteFamily(out, "onnxruntime_session_cpu_fallback_nodes", "gauge",
+              "Number of nodes assigned to the CPU execution provider while other execution providers are registered.");
+  out << "onnxruntime_session_cpu_fallback_nodes" << label_set << " "
+      << cpu_fallback_nodes_.load(std::memory_order_relaxed) << "\n";
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
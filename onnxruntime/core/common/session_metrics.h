@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Always-on counters of the runs of a session for production monitoring, see InferenceSession::GetMetrics.
+ *
+ * The counters are relaxed atomics, so recording a run and polling the metrics never take a lock.
+ */
+class SessionMetrics {
+ public:
+  SessionMetrics() = default;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionMetrics);
+
+  // Upper bounds of the buckets of the latency histograms, in microseconds.
+  // Larger values are counted in the +Inf bucket.
+  static constexpr std::array<uint64_t, 16> kLatencyBucketBoundsUs = {
+      100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+      1000000, 2500000, 5000000, 10000000};
+
+  void RecordRun(bool succeeded, uint64_t duration_us) {
+    run_duration_.Add(duration_us);
+    if (!succeeded) {
+      failed_runs_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Time a RunAsync request waited in the intra-op thread pool queue before it started.
+  void RecordQueueWait(uint64_t wait_us) { queue_wait_.Add(wait_us); }
+
+  void RecordConcurrentRuns(int num_runs);
+
+  void RecordGraphReplay() { graph_replays_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Number of nodes assigned to the CPU execution provider while other execution providers are registered.
+  void SetNumCpuFallbackNodes(size_t num_nodes) { cpu_fallback_nodes_.store(num_nodes, std::memory_order_relaxed); }
+
+  // Writes the metrics of the runs in OpenMetrics text format, labelled with labels, e.g. session_id="1".
+  void WriteOpenMetrics(std::ostream& out, const std::string& labels) const;
+
+  // Writes the TYPE and HELP lines of a metric family in OpenMetrics text format.
+  static void WriteFamily(std::ostream& out, const char* name, const char* type, const char* help);
+
+ private:
+  class Histogram {
+   public:
+    void Add(uint64_t value_us);
+    void Write(std::ostream& out, const char* name, const char* help, const std::string& labels) const;
+    uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+   private:
+    std::array<std::atomic<uint64_t>, kLatencyBucketBoundsUs.size() + 1> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_us_{0};
+  };
+
+  Histogram run_duration_;
+  Histogram queue_wait_;
+  std::atomic<uint64_t> failed_runs_{0};
+  std::atomic<int> max_concurrent_runs_{0};
+  std::atomic<uint64_t> graph_replays_{0};
+  std::atomic<size_t> cpu_fallback_nodes_{0};
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -13,14 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <sstream>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
+#include "core/platform/trace_points.h"
 #include <mutex>
 #if !defined(ORT_MINIMAL_BUILD)
 #ifdef _WIN32
@@ -261,6 +265,12 @@ static constexpr unsigned MAX_SHARDS = 8;
 
 static constexpr int TaskGranularityFactor = 4;
 
+// Bounds of the relative thread speeds learned in hybrid mode, and the weight of the speed measured in one loop
+static constexpr float kMinThreadSpeed = 0.125f;
+static constexpr float kThreadSpeedUpdateWeight = 0.125f;
+// Threads slower than this, relative to the fastest thread, are considered to run on efficiency cores
+static constexpr float kPerformanceCoreMinSpeed = 0.75f;
+
 struct alignas(CACHE_LINE_BYTES) LoopCounterShard {
   ::std::atomic<uint64_t> _next{0};
   uint64_t _end{0};
@@ -376,7 +386,7 @@ ThreadPool::ThreadPool(Env* env,
                        int degree_of_parallelism,
                        bool low_latency_hint,
                        bool force_hybrid)
-    : thread_options_(thread_options), force_hybrid_(force_hybrid) {
+    : thread_options_(thread_options), env_(env), low_latency_hint_(low_latency_hint), force_hybrid_(force_hybrid) {
   // In the current implementation, a thread pool with degree_of_parallelism==1 uses
   // the caller as one of the threads for executing work.  Hence we only create
   // additional thread(s) for degree_of_parallelism>=2.
@@ -389,7 +399,15 @@ ThreadPool::ThreadPool(Env* env,
       thread_options_.affinities.erase(thread_options_.affinities.begin());
       assert(thread_options_.affinities.size() >= size_t(threads_to_create));
     }
+    if (!thread_options_.numa_nodes.empty()) {
+      // Remove first NUMA node element as designated for the caller thread
+      thread_options_.numa_nodes.erase(thread_options_.numa_nodes.begin());
+    }
 
+    if (name != nullptr) {
+      name_ = name;
+    }
+    threads_to_create_ = threads_to_create;
     extended_eigen_threadpool_ =
         std::make_unique<ThreadPoolTempl<Env> >(name,
                                                 threads_to_create,
@@ -397,11 +415,45 @@ ThreadPool::ThreadPool(Env* env,
                                                 *env,
                                                 thread_options_);
     underlying_threadpool_ = extended_eigen_threadpool_.get();
+    threads_pid_.store(env->GetSelfPid(), std::memory_order_release);
+
+    if (force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
+      thread_speeds_ = std::make_unique<std::atomic<float>[]>(static_cast<size_t>(degree_of_parallelism));
+      for (int i = 0; i < degree_of_parallelism; ++i) {
+        thread_speeds_[i].store(1.0f, std::memory_order_relaxed);
+      }
+    }
   }
 }
 
 ThreadPool::~ThreadPool() = default;
 
+namespace {
+thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+// Whether the loops of the current parallel section only run on the threads measured to be fast, on hybrid CPUs
+thread_local bool current_section_performance_cores_only = false;
+// Number of parallel loops whose work the current thread is running
+thread_local unsigned current_loop_depth = 0;
+// Priority of the run the current thread is running
+thread_local ThreadPool::RunPriority current_run_priority = ThreadPool::RunPriority::kNormal;
+
+struct LoopDepthScope {
+  LoopDepthScope() { ++current_loop_depth; }
+  ~LoopDepthScope() { --current_loop_depth; }
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LoopDepthScope);
+};
+
+// Runs the work of a loop with the priority of the run that started the loop
+struct WorkPriorityScope {
+  explicit WorkPriorityScope(ThreadPool::RunPriority priority) : previous_priority_(current_run_priority) {
+    current_run_priority = priority;
+  }
+  ~WorkPriorityScope() { current_run_priority = previous_priority_; }
+  ThreadPool::RunPriority previous_priority_;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkPriorityScope);
+};
+}  // namespace
+
 // Base case for parallel loops, running iterations 0..total, divided into blocks
 // of block_size iterations, and calling into a function that takes a start..end
 // range of indices to run.
@@ -411,7 +463,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   if (total <= 0)
     return;
 
-  if (total <= block_size) {
+  if (total <= block_size || YieldsToHigherPriorityRun()) {
     fn(0, total);
     return;
   }
@@ -426,6 +478,41 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     assert(num_work_items > 0);
 
     LoopCounter lc(total, d_of_p, block_size);
+    if (thread_speeds_) {
+      // Hybrid CPU: each thread claims blocks sized in proportion to its speed, so all the threads finish at about
+      // the same time, and measures its speed in this loop for the next ones.
+      const bool performance_cores_only = current_section_performance_cores_only;
+      InlinedVector<WorkItemTiming, 16> timings(static_cast<size_t>(num_work_items));
+      std::function<void(unsigned)> run_work = [&](unsigned idx) {
+        const size_t thread_slot = static_cast<size_t>(CurrentThreadId() + 1);
+        const float speed = thread_speeds_[thread_slot].load(std::memory_order_relaxed);
+        // the calling thread runs work item 0, it always takes part so the loop completes
+        if (performance_cores_only && idx != 0 && speed < kPerformanceCoreMinSpeed) {
+          return;
+        }
+        const auto claim_size = static_cast<uint64_t>(
+            std::max<std::ptrdiff_t>(1, std::llround(static_cast<double>(block_size) * speed)));
+        unsigned my_home_shard = lc.GetHomeShard(idx);
+        unsigned my_shard = my_home_shard;
+        uint64_t my_iter_start, my_iter_end;
+        uint64_t iterations = 0;
+        const auto start_time = std::chrono::steady_clock::now();
+        while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, claim_size)) {
+          fn(static_cast<std::ptrdiff_t>(my_iter_start),
+             static_cast<std::ptrdiff_t>(my_iter_end));
+          iterations += my_iter_end - my_iter_start;
+        }
+        auto& timing = timings[idx];
+        timing.thread_slot = thread_slot;
+        timing.iterations = iterations;
+        timing.duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - start_time)
+                                 .count();
+      };
+      RunInParallel(run_work, num_work_items, block_size);
+      UpdateThreadSpeeds(timings.data(), timings.size());
+      return;
+    }
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
@@ -464,6 +551,33 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   }
 }
 
+void ThreadPool::UpdateThreadSpeeds(const WorkItemTiming* timings, size_t num_timings) {
+  // iterations per nanosecond of each work item, relative to the fastest one
+  double max_rate = 0.0;
+  size_t num_measured = 0;
+  for (size_t i = 0; i < num_timings; ++i) {
+    if (timings[i].iterations > 0 && timings[i].duration_ns > 0) {
+      max_rate = std::max(max_rate, static_cast<double>(timings[i].iterations) / timings[i].duration_ns);
+      ++num_measured;
+    }
+  }
+  if (num_measured < 2) {
+    return;
+  }
+  for (size_t i = 0; i < num_timings; ++i) {
+    const auto& timing = timings[i];
+    if (timing.iterations == 0 || timing.duration_ns <= 0) {
+      continue;
+    }
+    const double relative_speed = static_cast<double>(timing.iterations) / timing.duration_ns / max_rate;
+    auto& speed = thread_speeds_[timing.thread_slot];
+    // concurrent loops may update the same thread slot, losing one of the measurements is fine
+    const float updated_speed = (1.0f - kThreadSpeedUpdateWeight) * speed.load(std::memory_order_relaxed) +
+                                kThreadSpeedUpdateWeight * static_cast<float>(relative_speed);
+    speed.store(std::min(std::max(updated_speed, kMinThreadSpeed), 1.0f), std::memory_order_relaxed);
+  }
+}
+
 void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn) {
   ParallelForFixedBlockSizeScheduling(total, 1, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
     for (std::ptrdiff_t idx = first; idx < last; idx++) {
@@ -494,36 +608,72 @@ std::string ThreadPool::StopProfiling() {
   }
 }
 
-namespace {
-thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+ThreadPool::RunPriorityScope::RunPriorityScope(ThreadPool* tp, RunPriority priority)
+    : tp_(tp), priority_(priority), previous_priority_(current_run_priority) {
+  current_run_priority = priority_;
+  if (tp_) {
+    tp_->active_runs_by_priority_[static_cast<int>(priority_)].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ThreadPool::RunPriorityScope::~RunPriorityScope() {
+  if (tp_) {
+    tp_->active_runs_by_priority_[static_cast<int>(priority_)].fetch_sub(1, std::memory_order_relaxed);
+  }
+  current_run_priority = previous_priority_;
 }
 
-ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
-  ORT_ENFORCE(!current_parallel_section.has_value(), "Nested parallelism not supported");
+bool ThreadPool::YieldsToHigherPriorityRun() const {
+  for (int priority = static_cast<int>(current_run_priority) + 1;
+       priority <= static_cast<int>(RunPriority::kHigh); ++priority) {
+    if (active_runs_by_priority_[priority].load(std::memory_order_relaxed) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp, bool performance_cores_only) {
   ORT_ENFORCE(!ps_);
   tp_ = tp;
-  if (tp && tp->underlying_threadpool_) {
+  // A section nested in another section, or in the work of a parallel loop, has no effect of its own.  Its loops
+  // run in the enclosing section, or as nested loops.
+  if (tp && tp->underlying_threadpool_ && !current_parallel_section.has_value() && current_loop_depth == 0) {
     current_parallel_section.emplace();
     ps_ = &*current_parallel_section;
+    current_section_performance_cores_only = performance_cores_only;
     tp_->underlying_threadpool_->StartParallelSection(*ps_);
+    ORT_TRACE_PARALLEL_SECTION_START(static_cast<const void*>(tp_));
   }
 }
 
 ThreadPool::ParallelSection::~ParallelSection() {
-  if (current_parallel_section) {
+  if (ps_) {
+    ORT_TRACE_PARALLEL_SECTION_END(static_cast<const void*>(tp_));
     tp_->underlying_threadpool_->EndParallelSection(*ps_);
     current_parallel_section.reset();
+    current_section_performance_cores_only = false;
   }
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
-    if (current_parallel_section.has_value()) {
+    // Track the loops whose work the threads run, so loops started from within that work run as nested loops
+    const RunPriority run_priority = current_run_priority;
+    std::function<void(unsigned idx)> run_work = [&fn, run_priority](unsigned idx) {
+      LoopDepthScope loop_depth_scope;
+      WorkPriorityScope work_priority_scope(run_priority);
+      fn(idx);
+    };
+    if (current_loop_depth > 0) {
+      underlying_threadpool_->RunNestedInParallel(std::move(run_work),
+                                                  n, block_size);
+    } else if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
-                                                   std::move(fn),
+                                                   std::move(run_work),
                                                    n, block_size);
     } else {
-      underlying_threadpool_->RunInParallel(std::move(fn),
+      underlying_threadpool_->RunInParallel(std::move(run_work),
                                             n, block_size);
     }
   } else {
@@ -640,6 +790,9 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // When not using OpenMP, we parallelize over the N threads created by the pool
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
+    if (tp->YieldsToHigherPriorityRun()) {
+      return 1;
+    }
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
       return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
     } else {
@@ -664,6 +817,28 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+ThreadPoolStatistics ThreadPool::GetStatistics(const concurrency::ThreadPool* tp) {
+  ThreadPoolStatistics stats;
+  if (tp && tp->underlying_threadpool_) {
+    tp->underlying_threadpool_->GetStatistics(stats);
+  }
+  return stats;
+}
+
+std::string ThreadPoolStatistics::ToJson() const {
+  std::ostringstream out;
+  out << "{\"rejected_pushes\": " << rejected_pushes << ", \"workers\": [";
+  for (size_t i = 0; i < workers.size(); ++i) {
+    const auto& worker = workers[i];
+    out << (i == 0 ? "" : ", ") << "{\"queue_depth\": " << worker.queue_depth
+        << ", \"tasks_run\": " << worker.tasks_run << ", \"steal_attempts\": " << worker.steal_attempts
+        << ", \"steals\": " << worker.steals << ", \"spin_ns\": " << worker.spin_ns
+        << ", \"blocked_ns\": " << worker.blocked_ns << "}";
+  }
+  out << "]}";
+  return out.str();
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -676,6 +851,33 @@ void ThreadPool::DisableSpinning() {
   }
 }
 
+void ThreadPool::RecreateThreadsAfterFork() {
+  if (!extended_eigen_threadpool_) {
+    return;
+  }
+
+  const PIDType pid = env_->GetSelfPid();
+  if (threads_pid_.load(std::memory_order_acquire) == pid) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(fork_mutex_);
+  if (threads_pid_.load(std::memory_order_relaxed) == pid) {
+    return;
+  }
+
+  // The destructor would wait for threads that do not exist in this process.
+  ORT_IGNORE_RETURN_VALUE(extended_eigen_threadpool_.release());
+  extended_eigen_threadpool_ =
+      std::make_unique<ThreadPoolTempl<Env> >(name_.empty() ? nullptr : name_.c_str(),
+                                              threads_to_create_,
+                                              low_latency_hint_,
+                                              *env_,
+                                              thread_options_);
+  underlying_threadpool_ = extended_eigen_threadpool_.get();
+  threads_pid_.store(pid, std::memory_order_release);
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
@@ -246,7 +246,7 @@ OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor) {
   OrtMemoryInfo info(GetOrtDeviceName(device), OrtDeviceAllocator, device, device.Id());
   std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(
       data_type, TensorShape(dlpack->dl_tensor.shape, static_cast<size_t>(dlpack->dl_tensor.ndim)),
-      dlpack->dl_tensor.data, info);
+      static_cast<char*>(dlpack->dl_tensor.data) + dlpack->dl_tensor.byte_offset, info);
 
   OrtValue ort_value;
   std::function<void(void*)> deleter = [dlpack](void* p) {
@@ -5,6 +5,7 @@
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/model.h"
+#include "core/framework/config_options.h"
 #include "core/framework/op_kernel.h"
 #include "core/session/ort_env.h"
 #include "core/graph/constants.h"
@@ -13,6 +14,21 @@ namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
+common::Status ORTInvokerKernel::Run(std::vector<OrtValue>& outputs, concurrency::ThreadPool* thread_pool,
+                                     std::chrono::nanoseconds* compute_duration) const {
+  OptimizerExecutionFrame frame(*info_, fetch_mlvalue_idxs_, outputs);
+  OpKernelContext op_kernel_context(&frame, kernel_.get(), nullptr, thread_pool, logger_);
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  ORT_RETURN_IF_ERROR(kernel_->Compute(&op_kernel_context));
+  if (compute_duration) {
+    *compute_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+  }
+
+  return frame.GetOutputs(outputs);
+}
+
 common::Status ORTInvoker::Invoke(const std::string& op_name,
                                   // optional inputs / outputs?
                                   const std::vector<OrtValue>& inputs,
@@ -20,25 +36,38 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
                                   const NodeAttributes* attributes,
                                   const std::string& domain,
                                   const int version) {
+  std::unique_ptr<ORTInvokerKernel> kernel;
+  ORT_RETURN_IF_ERROR(CreateKernel(op_name, inputs, outputs.size(), attributes, kernel, domain, version));
+  return kernel->Run(outputs);
+}
+
+common::Status ORTInvoker::CreateKernel(const std::string& op_name,
+                                        const std::vector<OrtValue>& inputs,
+                                        size_t num_outputs,
+                                        const NodeAttributes* attributes,
+                                        std::unique_ptr<ORTInvokerKernel>& kernel,
+                                        const std::string& domain,
+                                        const int version) {
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  std::unique_ptr<ORTInvokerKernel> invoker_kernel(new ORTInvokerKernel(logger_));
   // create a graph
-  Model model("test",
-              false,
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  invoker_kernel->model_ = std::make_unique<Model>("test",
+                                                   false,
+                                                   ModelMetaData(),
+                                                   ORT_TSTR(""),
+                                                   custom_op_registries_,
+                                                   domain_version_map,
+                                                   std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                                   logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(num_outputs);
 
-  Graph& graph = model.MainGraph();
+  Graph& graph = invoker_kernel->model_->MainGraph();
   std::unordered_map<std::string, OrtValue> initializer_map;
   size_t i = 0;
 
@@ -52,7 +81,7 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
     initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < num_outputs; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -61,9 +90,12 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const&) { return false; });
+  invoker_kernel->is_sparse_initializer_func_ = [](std::string const&) { return false; };
+  invoker_kernel->info_ = std::make_unique<OptimizerExecutionFrame::Info>(
+      std::vector<const Node*>{&node}, initializer_map, graph.ModelPath(), *execution_provider_,
+      invoker_kernel->is_sparse_initializer_func_, logger_);
+  const auto& info = *invoker_kernel->info_;
   const KernelCreateInfo* kernel_create_info = nullptr;
   ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
   if (!kernel_create_info) {
@@ -78,21 +110,17 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
       ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  invoker_kernel->kernel_ = info.CreateKernel(&node, ConfigOptions{});
+  if (!invoker_kernel->kernel_) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    invoker_kernel->fetch_mlvalue_idxs_.push_back(info.GetMLValueIndex(node_out->Name()));
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
-
-  return frame.GetOutputs(outputs);
+  kernel = std::move(invoker_kernel);
+  return Status::OK();
 }
 
 }  // namespace onnxruntime
@@ -98,6 +98,28 @@ class TensorSeq {
     Add(std::move(value));
   }
 
+  // Inserts the tensor before position i. Inserting at Size() appends.
+  // The existing elements are moved, not copied, so growing a sequence that is updated in place
+  // is amortized constant time when appending.
+  void Insert(size_t i, OrtValue&& tensor) {
+    ORT_ENFORCE(i <= tensors_.size());
+    ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()),
+                "TensorSeq: tensor to be inserted has a different data type.");
+    tensors_.insert(tensors_.begin() + i, std::move(tensor));
+  }
+
+  void Insert(size_t i, Tensor&& tensor) {
+    OrtValue value;
+    Tensor::InitOrtValue(std::move(tensor), value);
+    Insert(i, std::move(value));
+  }
+
+  // Removes the element at position i, releasing this sequence's reference to it.
+  void Erase(size_t i) {
+    ORT_ENFORCE(i < tensors_.size());
+    tensors_.erase(tensors_.begin() + i);
+  }
+
   static void InitOrtValue(const TensorSeq& source_tensor_seq, std::shared_ptr<IAllocator> allocator, OrtValue& ort_value) {
     auto target_tensor_seq = std::make_unique<TensorSeq>(source_tensor_seq.DataType());
     target_tensor_seq->Reserve(source_tensor_seq.Size());
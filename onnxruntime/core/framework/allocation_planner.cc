@@ -5,6 +5,9 @@
 #include <list>
 #include <algorithm>
 #include <deque>
+#include <fstream>
+#include <limits>
+#include <set>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
@@ -19,6 +22,7 @@
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/session_state_utils.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -400,7 +404,7 @@ class PlannerImpl {
 #endif
 
               if (!need_skip) {
-                if (SameSize(*p_input_arg, *p_output_arg)) {
+                if (SameSize(*p_input_arg, *p_output_arg) || SameSequenceType(*p_input_arg, *p_output_arg)) {
                   // we can reuse this input since it is its last use and permitted for in-place update
                   *reusable_input = input_arg_index;  // or original; both should be okay
                   return true;
@@ -532,6 +536,29 @@ class PlannerImpl {
     */
   }
 
+  // Returns true with the size of the buffer of a tensor in size_in_bytes if all its dimensions are known.
+  static bool KnownSizeInBytes(const TensorShapeProto& shape, const onnxruntime::NodeArg& arg, size_t& size_in_bytes) {
+    const auto* type_proto = arg.TypeAsProto();
+    if (type_proto == nullptr || !utils::HasTensorType(*type_proto) ||
+        type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+
+    TensorShapeVector dims;
+    for (const auto& dim : shape.dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+        return false;
+      }
+      dims.push_back(dim.dim_value());
+    }
+
+    const TensorTypeBase* tensor_type = DataTypeImpl::TypeFromProto(*type_proto)->AsTensorType();
+    return tensor_type != nullptr &&
+           Tensor::CalculateTensorStorageSize(tensor_type->GetElementType(), TensorShape(dims), /*alignment*/ 0,
+                                              size_in_bytes)
+               .IsOK();
+  }
+
   static bool OutputHasConsumerNode(const Node& node, int output_idx) {
     // there will be an edge to all consumer nodes.
     // if consumed in a subgraph the edge will be to an implicit input of the node containing the subgraph.
@@ -550,7 +577,10 @@ class PlannerImpl {
     return SameSize(*p_shape1, arg1, *p_shape2, arg2);
   }
 
-  // Find if freelist contains a buffer of the same size as output_arg
+  // Find if freelist contains a buffer of the same size as output_arg.
+  // If the sizes of output_arg and of the freed buffers are known, a buffer of another shape or element type that is
+  // large enough can also be reused. The smallest one is picked, and only if it is less than twice the size of
+  // output_arg so that the large buffers remain available for the large outputs.
   bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, OrtValueIndex* reusable_tensor) {
     if (!context_->GetEnableMemoryReuse()) {
       return false;
@@ -559,6 +589,12 @@ class PlannerImpl {
     if (nullptr == p_required_buffer_shape || p_required_buffer_shape->dim_size() == 0) return false;
     auto& required_memory_info = AllocPlan(output_arg.Name()).location;
 
+    size_t required_size = 0;
+    const bool required_size_known = KnownSizeInBytes(*p_required_buffer_shape, output_arg, required_size) &&
+                                     required_size > 0;
+    auto best_fit = freelist_.end();
+    size_t best_fit_size = std::numeric_limits<size_t>::max();
+
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       size_t reusable = static_cast<size_t>(it->ml_value);
       const onnxruntime::NodeArg* p_node_arg = ort_value_info_.at(reusable).p_def_site;
@@ -586,8 +622,22 @@ class PlannerImpl {
           freelist_.erase(it);
           return true;
         }
+
+        size_t available_size = 0;
+        if (required_size_known && KnownSizeInBytes(*p_available_buffer_shape, *p_node_arg, available_size) &&
+            available_size >= required_size && available_size / 2 < required_size &&
+            available_size < best_fit_size) {
+          best_fit = it;
+          best_fit_size = available_size;
+        }
       }
     }
+
+    if (best_fit != freelist_.end()) {
+      *reusable_tensor = best_fit->ml_value;
+      freelist_.erase(best_fit);
+      return true;
+    }
     return false;
   }
 
@@ -2247,6 +2297,15 @@ class PlannerImpl {
   }
 #endif
 
+  // A sequence has no shape, and it owns no buffer of its own: its elements are shared OrtValues.
+  // An input sequence can be updated in place for an output sequence of the same type.
+  static bool SameSequenceType(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2) {
+    const auto* type_proto = arg1.TypeAsProto();
+    return type_proto != nullptr &&
+           type_proto->value_case() == ONNX_NAMESPACE::TypeProto::kSequenceType &&
+           arg1.Type() == arg2.Type();
+  }
+
   static bool IsNonTensor(const onnxruntime::NodeArg& nodearg) {
     // TODO: unclear why we should go through a string-representation of type
     auto ptype = nodearg.Type();
@@ -2548,6 +2607,266 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CriticalPathPartitioner stores config in json format:
+------------------------------------------------------
+{
+"type":"CriticalPathPartitioner",
+"streams_per_device":2,
+"profile_file":"onnxruntime_profile.json",
+"node_costs":{"node_1":10.5, "node_2":3},
+"max_activation_bytes":67108864
+}
+------------------------------------------------------
+All fields but "type" are optional.
+"streams_per_device" is the number of logic streams created for each device type, 2 by default;
+"profile_file" is the output of a previous profiling run, whose average kernel time is used as cost of each node;
+"node_costs" gives the cost of nodes by name and takes precedence over the profile;
+"max_activation_bytes" bounds the estimated size of the live node outputs, 0 (unbounded) by default.
+Nodes without a known cost are estimated by the number of elements of their outputs with static shapes.
+
+Nodes are list scheduled: the ready node with the longest remaining path to the graph outputs is picked first and
+placed on the stream of its device where it can start the earliest. While the live outputs are above
+max_activation_bytes, the ready node that grows them the least is picked instead.
+*/
+class CriticalPathPartitioner : public IGraphPartitioner {
+ public:
+  CriticalPathPartitioner(const logging::Logger& logger,
+                          const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+    Initialize();
+  }
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CriticalPathPartitioner"; }
+  size_t Streams() const override { return num_streams_; }
+
+ private:
+  void Initialize();
+  void LoadProfile(const PathString& profile_file);
+  static size_t StaticOutputBytes(const Node& node);
+
+  size_t streams_per_device_ = 2;
+  size_t max_activation_bytes_ = 0;
+  InlinedHashMap<std::string, double> node_costs_;
+  size_t num_streams_ = 0;
+};
+
+void CriticalPathPartitioner::Initialize() {
+  if (config_file_.empty()) {
+    return;
+  }
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Failed to open partition config file, using default CriticalPathPartitioner settings";
+    return;
+  }
+  ORT_TRY {
+    json json_config = json::parse(if_stream);
+    if (json_config.contains("streams_per_device")) {
+      streams_per_device_ = std::max<size_t>(json_config["streams_per_device"].get<size_t>(), 1);
+    }
+    if (json_config.contains("max_activation_bytes")) {
+      max_activation_bytes_ = json_config["max_activation_bytes"].get<size_t>();
+    }
+    if (json_config.contains("profile_file")) {
+      LoadProfile(ToPathString(json_config["profile_file"].get<std::string>()));
+    }
+    if (json_config.contains("node_costs")) {
+      for (const auto& node_cost : json_config["node_costs"].items()) {
+        node_costs_[node_cost.key()] = node_cost.value().get<double>();
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      LOGS(logger_, WARNING) << "Caught exception when reading CriticalPathPartitioner config: " << ex.what();
+    });
+  }
+}
+
+void CriticalPathPartitioner::LoadProfile(const PathString& profile_file) {
+  const auto status = session_state_utils::LoadAverageNodeKernelTimes(profile_file, node_costs_);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << status.ErrorMessage() << ", node costs will be estimated";
+  }
+}
+
+size_t CriticalPathPartitioner::StaticOutputBytes(const Node& node) {
+  size_t total_bytes = 0;
+  for (const auto* output : node.OutputDefs()) {
+    if (!output->Exists() || output->Shape() == nullptr || output->TypeAsProto() == nullptr ||
+        !output->TypeAsProto()->has_tensor_type() ||
+        output->TypeAsProto()->tensor_type().elem_type() == TensorProto_DataType_UNDEFINED) {
+      continue;
+    }
+    const auto* element_type =
+        DataTypeImpl::TensorTypeFromONNXEnum(output->TypeAsProto()->tensor_type().elem_type())->GetElementType();
+    const auto shape = utils::GetTensorShapeFromTensorShapeProto(*output->Shape());
+    if (element_type != nullptr && shape.Size() >= 0) {
+      total_bytes = SafeInt<size_t>(shape.Size()) * element_type->Size() + total_bytes;
+    }
+  }
+  return total_bytes;
+}
+
+Status CriticalPathPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                               const ExecutionProviders& execution_providers,
+                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                               ExecutionOrder execution_order) {
+  const auto& topo_order = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t max_node_index = graph_viewer.MaxNodeIndex();
+
+  // per node state, indexed by NodeIndex
+  std::vector<size_t> topo_position(max_node_index);
+  std::vector<double> cost(max_node_index);
+  std::vector<double> path_cost(max_node_index);  // cost of the most expensive path from the node to an output
+  std::vector<size_t> output_bytes(max_node_index);
+  std::vector<size_t> pending_inputs(max_node_index);
+  std::vector<size_t> pending_consumers(max_node_index);
+  std::vector<double> ready_time(max_node_index);
+  std::vector<size_t> first_stream(max_node_index);  // first stream of the device of the node
+
+  auto in_graph = [&graph_viewer](const Node& node) { return graph_viewer.GetNode(node.Index()) != nullptr; };
+
+  InlinedHashMap<OrtDevice::DeviceType, size_t> device_to_first_stream;
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    const auto* node = graph_viewer.GetNode(topo_order[i]);
+    const auto node_index = node->Index();
+    topo_position[node_index] = i;
+    output_bytes[node_index] = StaticOutputBytes(*node);
+    auto cost_it = node_costs_.find(node->Name());
+    cost[node_index] = cost_it != node_costs_.end() ? cost_it->second
+                                                    : std::max<double>(1.0, static_cast<double>(output_bytes[node_index]));
+
+    const auto device_type = execution_providers.Get(*node)->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+    auto device_it = device_to_first_stream.find(device_type);
+    if (device_it == device_to_first_stream.end()) {
+      device_it = device_to_first_stream.emplace(device_type, device_to_first_stream.size() * streams_per_device_).first;
+    }
+    first_stream[node_index] = device_it->second;
+
+    for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+      if (in_graph(it->GetNode())) {
+        ++pending_inputs[node_index];
+      }
+    }
+    for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+      if (in_graph(it->GetNode())) {
+        ++pending_consumers[node_index];
+      }
+    }
+  }
+
+  for (auto it = topo_order.rbegin(); it != topo_order.rend(); ++it) {
+    const auto* node = graph_viewer.GetNode(*it);
+    double max_successor_path_cost = 0.0;
+    for (auto edge = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); edge != end; ++edge) {
+      if (in_graph(edge->GetNode())) {
+        max_successor_path_cost = std::max(max_successor_path_cost, path_cost[edge->GetNode().Index()]);
+      }
+    }
+    path_cost[*it] = cost[*it] + max_successor_path_cost;
+  }
+
+  // estimated growth of the live outputs if node_index were the next node to run
+  auto memory_delta = [&](NodeIndex node_index) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    InlinedHashMap<NodeIndex, size_t> edges_from_producer;
+    for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+      if (in_graph(it->GetNode())) {
+        ++edges_from_producer[it->GetNode().Index()];
+      }
+    }
+    int64_t delta = static_cast<int64_t>(output_bytes[node_index]);
+    for (const auto& [producer, num_edges] : edges_from_producer) {
+      if (pending_consumers[producer] == num_edges) {
+        delta -= static_cast<int64_t>(output_bytes[producer]);
+      }
+    }
+    return delta;
+  };
+
+  // ready nodes ordered by decreasing path cost, then by topological order
+  using ReadyKey = std::pair<double, size_t>;
+  std::set<ReadyKey> ready;
+  auto make_key = [&](NodeIndex node_index) { return ReadyKey{-path_cost[node_index], topo_position[node_index]}; };
+  for (auto node_index : topo_order) {
+    if (pending_inputs[node_index] == 0) {
+      ready.insert(make_key(node_index));
+    }
+  }
+
+  const size_t num_streams = device_to_first_stream.size() * streams_per_device_;
+  std::vector<double> stream_available_time(num_streams, 0.0);
+  stream_nodes.clear();
+  stream_nodes.resize(num_streams);
+  size_t live_bytes = 0;
+  size_t num_scheduled = 0;
+
+  while (!ready.empty()) {
+    auto picked = ready.begin();
+    if (max_activation_bytes_ > 0 && live_bytes > max_activation_bytes_) {
+      int64_t min_delta = std::numeric_limits<int64_t>::max();
+      for (auto it = ready.begin(); it != ready.end(); ++it) {
+        const int64_t delta = memory_delta(topo_order[it->second]);
+        if (delta < min_delta) {
+          min_delta = delta;
+          picked = it;
+        }
+      }
+    }
+
+    const NodeIndex node_index = topo_order[picked->second];
+    ready.erase(picked);
+    const auto* node = graph_viewer.GetNode(node_index);
+
+    // place the node on the stream of its device where it starts the earliest
+    size_t stream = first_stream[node_index];
+    double start_time = std::numeric_limits<double>::max();
+    for (size_t s = first_stream[node_index]; s < first_stream[node_index] + streams_per_device_; ++s) {
+      const double stream_start_time = std::max(stream_available_time[s], ready_time[node_index]);
+      if (stream_start_time < start_time) {
+        start_time = stream_start_time;
+        stream = s;
+      }
+    }
+    const double finish_time = start_time + cost[node_index];
+    stream_available_time[stream] = finish_time;
+    stream_nodes[stream].push_back(node_index);
+    ++num_scheduled;
+
+    live_bytes += output_bytes[node_index];
+    for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+      const auto producer = it->GetNode().Index();
+      if (in_graph(it->GetNode()) && --pending_consumers[producer] == 0) {
+        live_bytes -= std::min(live_bytes, output_bytes[producer]);
+      }
+    }
+    for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+      if (!in_graph(it->GetNode())) {
+        continue;
+      }
+      const auto consumer = it->GetNode().Index();
+      ready_time[consumer] = std::max(ready_time[consumer], finish_time);
+      if (--pending_inputs[consumer] == 0) {
+        ready.insert(make_key(consumer));
+      }
+    }
+  }
+  ORT_RETURN_IF_NOT(num_scheduled == topo_order.size(), "CriticalPathPartitioner failed to schedule all nodes");
+
+  // drop the streams left without nodes, e.g. when a device has fewer nodes than streams
+  stream_nodes.erase(std::remove_if(stream_nodes.begin(), stream_nodes.end(),
+                                    [](const InlinedVector<NodeIndex>& nodes) { return nodes.empty(); }),
+                     stream_nodes.end());
+  num_streams_ = stream_nodes.size();
+  return Status::OK();
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
                                                                              const PathString& config_file) {
   // use device based partitioner by default
@@ -2562,6 +2881,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CriticalPathPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2573,6 +2894,9 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition) {
+    LOGS(logger, INFO) << "Use CriticalPathPartition";
+    return std::make_unique<CriticalPathPartitioner>(logger, config_file);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -82,9 +82,11 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // CriticalPathPartitioner splits the nodes of each device over several streams, ordering them by the length of
+  // the most expensive path from the node to the graph outputs, based on estimated or profiled per-node costs.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CriticalPathPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
@@ -114,6 +114,9 @@ void CPUAllocator::Free(void* p) {
 void* AllocateBufferWithOptions(IAllocator& alloc, size_t size, bool use_reserve, Stream* stream, WaitNotificationFn wait_fn) {
   if (use_reserve)
     return alloc.Reserve(size);
+  if (stream && alloc.IsStreamAware()) {
+    return alloc.AllocOnStream(size, stream);
+  }
   if (stream && alloc.Info().alloc_type == OrtArenaAllocator) {
 #ifdef ORT_ENABLE_STREAM
     auto* stream_aware_alloc = StreamAwareArena::FromBFCArena(static_cast<BFCArena&>(alloc));
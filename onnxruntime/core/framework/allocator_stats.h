@@ -22,6 +22,10 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_chunk_cache_hits;    // Number of allocations served from the arena chunk cache (if enabled).
+  int64_t num_chunk_cache_misses;  // Number of cacheable allocations that had to go to the arena.
+  int64_t large_page_bytes;          // Number of bytes allocated on large pages (if enabled).
+  int64_t num_large_page_fallbacks;  // Number of allocations that were to use large pages but could not.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +39,10 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_chunk_cache_hits = 0;
+    this->num_chunk_cache_misses = 0;
+    this->large_page_bytes = 0;
+    this->num_large_page_fallbacks = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +55,11 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumChunkCacheHits:        " << this->num_chunk_cache_hits << "\n"
+       << "NumChunkCacheMisses:      " << this->num_chunk_cache_misses << "\n"
+       << "LargePageBytes:           " << this->large_page_bytes << "\n"
+       << "NumLargePageFallbacks:    " << this->num_large_page_fallbacks << "\n";
     return ss.str();
   }
 };
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/arena_trimmer.h"
+
+#include <algorithm>
+
+#include "core/framework/bfc_arena.h"
+
+namespace onnxruntime {
+
+namespace {
+// How often the background thread checks the policy by default: often enough for the idle timeout to be observed within a
+// quarter of its duration, without waking up more than 100 times a second.
+std::chrono::milliseconds CheckInterval(const ArenaTrimPolicy& policy) {
+  using std::chrono::milliseconds;
+  if (policy.check_interval.count() > 0) {
+    return policy.check_interval;
+  }
+  if (policy.idle_timeout.count() == 0) {
+    return milliseconds(100);
+  }
+  return std::clamp(policy.idle_timeout / 4, milliseconds(10), milliseconds(1000));
+}
+}  // namespace
+
+ArenaTrimmer::ArenaTrimmer(std::vector<AllocatorPtr> arenas, const ArenaTrimPolicy& policy,
+                           const std::atomic<int>& num_active_runs, const logging::Logger& logger)
+    : arenas_(std::move(arenas)),
+      policy_(policy),
+      num_active_runs_(num_active_runs),
+      logger_(logger),
+      last_run_end_(std::chrono::steady_clock::now().time_since_epoch().count()) {
+  for (const auto& arena : arenas_) {
+    ORT_ENFORCE(arena->Info().alloc_type == OrtArenaAllocator, "Not an arena: ", arena->Info().ToString());
+  }
+  trimming_thread_ = std::thread(&ArenaTrimmer::TrimmingLoop, this);
+}
+
+ArenaTrimmer::~ArenaTrimmer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  trimming_thread_.join();
+}
+
+void ArenaTrimmer::NotifyRunEnd() {
+  last_run_end_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+  run_epoch_.fetch_add(1, std::memory_order_release);
+}
+
+size_t ArenaTrimmer::TrimIfNeeded(std::chrono::steady_clock::time_point now) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t run_epoch = run_epoch_.load(std::memory_order_acquire);
+  if (num_active_runs_.load(std::memory_order_relaxed) != 0 || run_epoch == trimmed_epoch_) {
+    return 0;
+  }
+
+  const std::chrono::steady_clock::time_point last_run_end{
+      std::chrono::steady_clock::duration(last_run_end_.load(std::memory_order_relaxed))};
+  const bool idle = policy_.idle_timeout.count() > 0 && now - last_run_end >= policy_.idle_timeout;
+
+  size_t num_shrunk = 0;
+  for (const auto& arena : arenas_) {
+    AllocatorStats stats;
+    arena->GetStats(&stats);
+    const bool over_ratio =
+        policy_.max_reserved_to_in_use_ratio > 0.0 &&
+        static_cast<double>(stats.total_allocated_bytes) >
+            policy_.max_reserved_to_in_use_ratio * static_cast<double>(std::max<int64_t>(stats.bytes_in_use, 1));
+    if (!idle && !over_ratio) {
+      continue;
+    }
+
+    // a run starting meanwhile is safe, as the arena only releases the regions without chunks in use
+    auto status = static_cast<BFCArena*>(arena.get())->Shrink();
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "Unable to shrink arena: " << arena->Info().ToString()
+                             << " error message: " << status.ErrorMessage();
+      continue;
+    }
+    ++num_shrunk;
+    LOGS(logger_, VERBOSE) << "Shrunk arena " << arena->Info().ToString() << (idle ? " after idle timeout" : "")
+                           << (over_ratio ? " above the reserved to in use ratio" : "") << ", reserved bytes were "
+                           << stats.total_allocated_bytes << " with " << stats.bytes_in_use << " in use";
+  }
+
+  if (idle || num_shrunk > 0) {
+    trimmed_epoch_ = run_epoch;
+  }
+  num_trims_.fetch_add(num_shrunk, std::memory_order_relaxed);
+  return num_shrunk;
+}
+
+void ArenaTrimmer::TrimmingLoop() {
+  const auto check_interval = CheckInterval(policy_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!cv_.wait_for(lock, check_interval, [this]() { return shutdown_; })) {
+    lock.unlock();
+    TrimIfNeeded(std::chrono::steady_clock::now());
+    lock.lock();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// When the arenas of a session are shrunk by ArenaTrimmer. Both conditions are only checked while no run is in
+// progress, and the arenas are shrunk at most once between two runs.
+struct ArenaTrimPolicy {
+  // shrink the arenas when no run started or ended for this long. 0 disables the condition.
+  std::chrono::milliseconds idle_timeout{0};
+  // shrink an arena when its reserved bytes exceed this multiple of its bytes in use. 0 disables the condition.
+  double max_reserved_to_in_use_ratio = 0.0;
+  // how often the background thread checks the conditions. 0 to derive it from idle_timeout.
+  std::chrono::milliseconds check_interval{0};
+
+  bool IsEnabled() const noexcept { return idle_timeout.count() > 0 || max_reserved_to_in_use_ratio > 0.0; }
+};
+
+// Shrinks arenas (BFCArena::Shrink) from a background thread according to an ArenaTrimPolicy, so that the regions a
+// burst of large requests made the arenas reserve are returned once the load drops, without shrinking after every
+// run as kOrtRunOptionsConfigEnableMemoryArenaShrinkage does.
+//
+// Shrinking only releases regions without any chunk in use, so it pairs best with the kSameAsRequested extend
+// strategy, whose regions match the requests that needed them; with kNextPowerOfTwo the regions are fewer and
+// larger and are only released when completely free.
+class ArenaTrimmer {
+ public:
+  // arenas: allocators of type OrtArenaAllocator, which must be BFCArena instances.
+  // num_active_runs: number of runs in progress, which must outlive the trimmer.
+  ArenaTrimmer(std::vector<AllocatorPtr> arenas, const ArenaTrimPolicy& policy,
+               const std::atomic<int>& num_active_runs, const logging::Logger& logger);
+  ~ArenaTrimmer();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ArenaTrimmer);
+
+  // Called when a run ended.
+  void NotifyRunEnd();
+
+  // Shrinks the arenas if the policy requires it at `now`. Returns the number of arenas shrunk.
+  // Called by the background thread, exposed for tests.
+  size_t TrimIfNeeded(std::chrono::steady_clock::time_point now);
+
+  // Number of times arenas were shrunk by the trimmer.
+  uint64_t NumTrims() const noexcept { return num_trims_.load(std::memory_order_relaxed); }
+
+ private:
+  void TrimmingLoop();
+
+  const std::vector<AllocatorPtr> arenas_;
+  const ArenaTrimPolicy policy_;
+  const std::atomic<int>& num_active_runs_;
+  const logging::Logger& logger_;
+
+  // steady clock time of the end of the last run, in its duration units
+  std::atomic<std::chrono::steady_clock::rep> last_run_end_;
+  // incremented by each run, to shrink at most once between two runs
+  std::atomic<uint64_t> run_epoch_{0};
+  uint64_t trimmed_epoch_ = 0;
+  std::atomic<uint64_t> num_trims_{0};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;
+  std::thread trimming_thread_;
+};
+
+}  // namespace onnxruntime
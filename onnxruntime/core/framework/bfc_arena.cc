@@ -3,6 +3,9 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include "core/platform/trace_points.h"
+#include <array>
+#include <thread>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +15,8 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int64_t max_cached_chunk_size_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -31,6 +35,7 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " max_cached_chunk_size_bytes: " << max_cached_chunk_size_bytes
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -43,6 +48,12 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 
   arena_extend_strategy_ = arena_extend_strategy;
 
+  if (max_cached_chunk_size_bytes > 0) {
+    max_cached_chunk_size_bytes_ = RoundedBytes(static_cast<size_t>(max_cached_chunk_size_bytes));
+    chunk_cache_shards_ = std::make_unique<ChunkCacheShard[]>(kNumChunkCacheShards);
+    chunk_size_shards_ = std::make_unique<ChunkSizeShard[]>(kNumChunkCacheShards);
+  }
+
   // We never want to shrink the initial allocation if the arena extend strategy is kNextPowerOfTwo.
   // This could seem confusingly arbitrary but the rationale is as follows:
   // The user selected initial allocation chunk is only valid for the arena extend strategy kNextPowerOfTwo
@@ -213,6 +224,7 @@ Status BFCArena::Extend(size_t rounded_bytes) {
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
   region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
   stats_.num_arena_extensions += 1;
+  ORT_TRACE_ARENA_EXTEND(Info().name, bytes, stats_.total_allocated_bytes);
 
   // Create one large chunk for the whole memory space that will
   // be chunked later.
@@ -269,9 +281,103 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (max_cached_chunk_size_bytes_ > 0 && size > 0 && size <= max_cached_chunk_size_bytes_) {
+    return AllocateThroughChunkCache(size);
+  }
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
+size_t BFCArena::ChunkCacheShardForThread() {
+  thread_local const size_t shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumChunkCacheShards;
+  return shard;
+}
+
+void* BFCArena::AllocateThroughChunkCache(size_t num_bytes) {
+  size_t rounded_bytes = RoundedBytes(num_bytes);
+  void* ptr = nullptr;
+  size_t chunk_size = 0;
+
+  {
+    ChunkCacheShard& shard = chunk_cache_shards_[ChunkCacheShardForThread()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // All the cached chunks in a bin are within a factor of two of rounded_bytes.
+    // Prefer the most recently freed one as it is the most likely to still be in the cache.
+    auto& entries = shard.bins[BinNumForSize(rounded_bytes)];
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+      if (it->second >= rounded_bytes) {
+        ptr = it->first;
+        chunk_size = it->second;
+        entries.erase(std::next(it).base());
+        break;
+      }
+    }
+  }
+
+  if (ptr != nullptr) {
+    ++num_chunk_cache_hits_;
+  } else {
+    ++num_chunk_cache_misses_;
+    ptr = AllocateRawInternal(num_bytes, false, nullptr, false, nullptr, &chunk_size);
+    // The arena may give back a chunk larger than the caller asked for. Only track the ones we are willing to cache.
+    if (chunk_size > max_cached_chunk_size_bytes_) {
+      return ptr;
+    }
+  }
+
+  ChunkSizeShard& size_shard = chunk_size_shards_[ChunkSizeShardFor(ptr)];
+  std::lock_guard<std::mutex> lock(size_shard.mutex);
+  size_shard.sizes[ptr] = chunk_size;
+  return ptr;
+}
+
+bool BFCArena::FreeIntoChunkCache(void* p) {
+  size_t chunk_size = 0;
+  {
+    ChunkSizeShard& size_shard = chunk_size_shards_[ChunkSizeShardFor(p)];
+    std::lock_guard<std::mutex> lock(size_shard.mutex);
+    auto it = size_shard.sizes.find(p);
+    if (it == size_shard.sizes.end()) {
+      return false;
+    }
+    chunk_size = it->second;
+    size_shard.sizes.erase(it);
+  }
+
+  {
+    ChunkCacheShard& shard = chunk_cache_shards_[ChunkCacheShardForThread()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& entries = shard.bins[BinNumForSize(chunk_size)];
+    if (entries.size() < kChunkCacheEntriesPerBin) {
+      entries.emplace_back(p, chunk_size);
+      return true;
+    }
+  }
+
+  // The cache bin is full so hand the chunk back to the arena.
+  std::lock_guard<std::mutex> lock(lock_);
+  DeallocateRawInternal(p);
+  return true;
+}
+
+void BFCArena::FlushChunkCache() {
+  InlinedVector<void*> cached_ptrs;
+  for (size_t i = 0; i < kNumChunkCacheShards; ++i) {
+    ChunkCacheShard& shard = chunk_cache_shards_[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& entries : shard.bins) {
+      for (const auto& entry : entries) {
+        cached_ptrs.push_back(entry.first);
+      }
+      entries.clear();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (void* p : cached_ptrs) {
+    DeallocateRawInternal(p);
+  }
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -312,7 +418,8 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
                                     bool dump_log_on_failure,
                                     Stream* stream,
                                     bool enable_cross_stream_reusing,
-                                    WaitNotificationFn wait_fn) {
+                                    WaitNotificationFn wait_fn,
+                                    size_t* chunk_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -341,6 +448,9 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (stream)
         chunk->stream_timestamp = stream->GetCurrentTimestamp();
     }
+    if (chunk_size != nullptr) {
+      *chunk_size = chunk->size;
+    }
     return chunk->ptr;
   }
 
@@ -356,6 +466,9 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (chunk->stream == nullptr && stream) {
         chunk->stream = stream;
       }
+      if (chunk_size != nullptr) {
+        *chunk_size = chunk->size;
+      }
       return chunk->ptr;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -379,6 +492,48 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  // allocations served by the chunk cache never reach the arena, but they are still allocations.
+  stats->num_chunk_cache_hits = num_chunk_cache_hits_;
+  stats->num_chunk_cache_misses = num_chunk_cache_misses_;
+  stats->num_allocs += stats->num_chunk_cache_hits;
+  // the regions and the reserved chunks come from the device allocator, which reports the ones on large pages.
+  AllocatorStats device_stats;
+  device_allocator_->GetStats(&device_stats);
+  stats->large_page_bytes = device_stats.large_page_bytes;
+  stats->num_large_page_fallbacks = device_stats.num_large_page_fallbacks;
+}
+
+BFCArena::FragmentationStats BFCArena::GetFragmentationStats() {
+  std::lock_guard<std::mutex> lock(lock_);
+  FragmentationStats stats;
+  std::array<BinOccupancy, kNumBins> bins{};
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    while (h != kInvalidChunkHandle) {
+      const Chunk* c = ChunkFromHandle(h);
+      BinOccupancy& bin = bins[BinNumForSize(c->size)];
+      if (c->in_use()) {
+        stats.bytes_in_use += c->size;
+        bin.bytes_in_use += c->size;
+        bin.chunks_in_use++;
+      } else {
+        stats.free_bytes += c->size;
+        stats.largest_free_chunk = std::max(stats.largest_free_chunk, c->size);
+        bin.free_bytes += c->size;
+        bin.free_chunks++;
+      }
+      h = c->next;
+    }
+  }
+
+  for (BinNum bin_num = 0; bin_num < kNumBins; bin_num++) {
+    if (bins[bin_num].chunks_in_use + bins[bin_num].free_chunks > 0) {
+      bins[bin_num].bin_size = BinNumToSize(bin_num);
+      stats.bins.push_back(bins[bin_num]);
+    }
+  }
+
+  return stats;
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -496,6 +651,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (max_cached_chunk_size_bytes_ > 0 && FreeIntoChunkCache(p)) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -509,6 +667,10 @@ void BFCArena::Free(void* p) {
 }
 
 Status BFCArena::Shrink() {
+  if (max_cached_chunk_size_bytes_ > 0) {
+    FlushChunkCache();
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
@@ -16,13 +16,16 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/logging/severity.h"
 #include "core/common/safeint.h"
@@ -61,6 +64,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const int64_t DEFAULT_MAX_CACHED_CHUNK_SIZE_BYTES = 0;  // chunk cache disabled
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +77,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t max_cached_chunk_size_bytes = DEFAULT_MAX_CACHED_CHUNK_SIZE_BYTES);
 
   ~BFCArena() override;
 
@@ -86,6 +91,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // Chunks held by the chunk cache are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -97,6 +103,28 @@ class BFCArena : public IAllocator {
 
   void GetStats(AllocatorStats* stats) override;
 
+  // The occupancy of a bin of the arena, i.e. of its chunks of the bin size up to twice the bin size.
+  struct BinOccupancy {
+    size_t bin_size = 0;
+    size_t chunks_in_use = 0;
+    size_t bytes_in_use = 0;
+    size_t free_chunks = 0;
+    size_t free_bytes = 0;
+  };
+
+  // A snapshot of the fragmentation of the arena.
+  struct FragmentationStats {
+    size_t bytes_in_use = 0;
+    size_t free_bytes = 0;
+    size_t largest_free_chunk = 0;
+    // the bins holding chunks
+    std::vector<BinOccupancy> bins;
+  };
+
+  FragmentationStats GetFragmentationStats();
+
+  // Note: for a chunk handed out by the chunk cache this is the size requested when the chunk was
+  // first allocated from the arena.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -112,7 +140,8 @@ class BFCArena : public IAllocator {
                             bool dump_log_on_failure,
                             Stream* stream,
                             bool enable_cross_stream_reusing,
-                            WaitNotificationFn wait_fn);
+                            WaitNotificationFn wait_fn,
+                            size_t* chunk_size = nullptr);
 #ifdef ORT_ENABLE_STREAM
   // for any chunk that associated with target stream, reset it to default (nullptr in stream, timestamp 0)
   // perform coalesce if coalesce_flag is true
@@ -223,6 +252,40 @@ class BFCArena : public IAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // The chunk cache is an optional front end that keeps recently freed chunks of up to
+  // max_cached_chunk_size_bytes_ out of the arena so that they can be handed out again without
+  // taking lock_. Cached chunks stay 'in use' as far as the arena is concerned.
+  // Free lists are sharded by the calling thread, and the sizes of the chunks handed out
+  // are tracked in tables sharded by address, so each shard has its own small lock.
+  static const size_t kNumChunkCacheShards = 8;
+  static const size_t kChunkCacheEntriesPerBin = 16;
+
+  struct ChunkCacheShard {
+    std::mutex mutex;
+    // (ptr, chunk size) of free chunks, per bin number of the chunk size.
+    std::array<InlinedVector<std::pair<void*, size_t>>, kNumBins> bins;
+  };
+
+  struct ChunkSizeShard {
+    std::mutex mutex;
+    // chunk size of every chunk handed out through the chunk cache path.
+    InlinedHashMap<void*, size_t> sizes;
+  };
+
+  void* AllocateThroughChunkCache(size_t num_bytes);
+
+  // Returns false if p was not handed out through the chunk cache path.
+  bool FreeIntoChunkCache(void* p);
+
+  // Returns all the chunks held by the chunk cache to the arena.
+  void FlushChunkCache();
+
+  static size_t ChunkCacheShardForThread();
+
+  static size_t ChunkSizeShardFor(const void* p) {
+    return (reinterpret_cast<std::uintptr_t>(p) >> kMinAllocationBits) % kNumChunkCacheShards;
+  }
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -509,6 +572,13 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  // 0 if the chunk cache is disabled.
+  size_t max_cached_chunk_size_bytes_ = 0;
+  std::unique_ptr<ChunkCacheShard[]> chunk_cache_shards_;
+  std::unique_ptr<ChunkSizeShard[]> chunk_size_shards_;
+  std::atomic<int64_t> num_chunk_cache_hits_{0};
+  std::atomic<int64_t> num_chunk_cache_misses_{0};
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -526,7 +596,8 @@ class StreamAwareArena : public BFCArena {
                    int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
                    int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
                    int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t max_cached_chunk_size_bytes = DEFAULT_MAX_CACHED_CHUNK_SIZE_BYTES);
 
   // If size is 0, then this function returns either NULL,
   // or a unique pointer value that can later be successfully
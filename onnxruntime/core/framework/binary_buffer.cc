@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/binary_buffer.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+
+#include "core/framework/murmurhash3.h"
+
+namespace onnxruntime {
+
+std::string BinaryBufferWriter::HashToHex() const {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(buffer_.data(), buffer_.size(), 0, hash);
+  std::ostringstream hex;
+  hex << std::hex << std::setfill('0');
+  for (const auto part : hash) {
+    hex << std::setw(8) << part;
+  }
+  return hex.str();
+}
+
+bool ReadBinaryFile(const std::filesystem::path& file_path, std::string& contents) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+Status WriteBinaryFileAtomically(const std::filesystem::path& file_path, const std::string& contents) {
+  std::filesystem::path temp_path = file_path;
+  temp_path += "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    ORT_RETURN_IF(!file, "Failed to write ", temp_path.string());
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, file_path, error);
+  if (error) {
+    std::error_code remove_error;
+    std::filesystem::remove(temp_path, remove_error);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", file_path.string(), ": ", error.message());
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
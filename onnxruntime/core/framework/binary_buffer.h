@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+// Writes length prefixed values to a buffer. Used for the files of the caches kept across sessions and the keys
+// hashed to name them. Values are stored in the byte order of the machine.
+class BinaryBufferWriter {
+ public:
+  void Write(uint64_t value) {
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void Write(const std::string& value) {
+    Write(static_cast<uint64_t>(value.size()));
+    buffer_.append(value);
+  }
+
+  void Write(const std::vector<std::string>& values) {
+    Write(static_cast<uint64_t>(values.size()));
+    for (const auto& value : values) {
+      Write(value);
+    }
+  }
+
+  const std::string& Buffer() const noexcept { return buffer_; }
+
+  // Returns the 128-bit MurmurHash3 of the buffer as a hexadecimal string.
+  std::string HashToHex() const;
+
+ private:
+  std::string buffer_;
+};
+
+// Reads the values written by BinaryBufferWriter. Every Read returns false, without reading past the end of the
+// buffer, if the buffer is too short.
+class BinaryBufferReader {
+ public:
+  explicit BinaryBufferReader(const std::string& buffer) : buffer_(buffer) {}
+
+  bool Read(uint64_t& value) {
+    if (buffer_.size() - offset_ < sizeof(value)) {
+      return false;
+    }
+    std::copy_n(buffer_.data() + offset_, sizeof(value), reinterpret_cast<char*>(&value));
+    offset_ += sizeof(value);
+    return true;
+  }
+
+  bool Read(std::string& value) {
+    uint64_t size = 0;
+    if (!Read(size) || buffer_.size() - offset_ < size) {
+      return false;
+    }
+    value.assign(buffer_.data() + offset_, static_cast<size_t>(size));
+    offset_ += static_cast<size_t>(size);
+    return true;
+  }
+
+  bool Read(std::vector<std::string>& values) {
+    uint64_t count = 0;
+    if (!ReadCount(count)) {
+      return false;
+    }
+    values.resize(static_cast<size_t>(count));
+    return std::all_of(values.begin(), values.end(), [this](std::string& value) { return Read(value); });
+  }
+
+  // Reads the number of elements of a sequence, rejecting counts larger than the buffer as corrupted.
+  bool ReadCount(uint64_t& count) {
+    return Read(count) && count <= buffer_.size();
+  }
+
+  bool AtEnd() const noexcept { return offset_ == buffer_.size(); }
+
+ private:
+  const std::string& buffer_;
+  size_t offset_ = 0;
+};
+
+// Reads a whole file. Returns false if it cannot be read.
+bool ReadBinaryFile(const std::filesystem::path& file_path, std::string& contents);
+
+// Writes a file through a temporary file renamed over it, so that concurrent readers, e.g. other sessions, never
+// read a partially written file.
+Status WriteBinaryFileAtomically(const std::filesystem::path& file_path, const std::string& contents);
+
+}  // namespace onnxruntime
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/capability_cache.h"
+
+#include <algorithm>
+#include <map>
+#include <system_error>
+
+#include "core/framework/binary_buffer.h"
+#include "core/framework/execution_provider.h"
+#include "core/graph/graph_viewer.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kFileMagic[] = "ORTCAPS1";
+constexpr const char* kFileExtension = ".capabilities";
+
+// attributes sorted by name, as NodeAttributes is unordered
+void WriteAttributes(BinaryBufferWriter& writer, const NodeAttributes& attributes) {
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> sorted_attributes;
+  for (const auto& [name, attribute] : attributes) {
+    sorted_attributes.emplace(name, &attribute);
+  }
+  writer.Write(static_cast<uint64_t>(sorted_attributes.size()));
+  for (const auto& [name, attribute] : sorted_attributes) {
+    writer.Write(name);
+    writer.Write(attribute->SerializeAsString());
+  }
+}
+
+bool ReadAttributes(BinaryBufferReader& reader, NodeAttributes& attributes) {
+  uint64_t count = 0;
+  if (!reader.ReadCount(count)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string name, serialized_attribute;
+    ONNX_NAMESPACE::AttributeProto attribute;
+    if (!reader.Read(name) || !reader.Read(serialized_attribute) ||
+        !attribute.ParseFromString(serialized_attribute)) {
+      return false;
+    }
+    attributes.emplace(std::move(name), std::move(attribute));
+  }
+  return true;
+}
+
+void WriteNodeArg(BinaryBufferWriter& writer, const NodeArg* node_arg) {
+  if (node_arg == nullptr || !node_arg->Exists()) {
+    writer.Write(std::string());
+    return;
+  }
+  writer.Write(node_arg->Name());
+  const auto* type = node_arg->TypeAsProto();
+  writer.Write(type != nullptr ? type->SerializeAsString() : std::string());
+}
+
+template <typename NodeArgs>
+void WriteNodeArgs(BinaryBufferWriter& writer, const NodeArgs& node_args) {
+  writer.Write(static_cast<uint64_t>(node_args.size()));
+  for (const auto* node_arg : node_args) {
+    WriteNodeArg(writer, node_arg);
+  }
+}
+
+// Whether the capabilities can be stored, i.e. they have no functions attached.
+bool CanSave(const std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+  return std::all_of(capabilities.begin(), capabilities.end(), [](const std::unique_ptr<ComputeCapability>& capability) {
+    const auto* meta_def = capability->sub_graph->GetMetaDef();
+    return capability->nodes_to_optimize.empty() && !capability->optimization_func &&
+           (meta_def == nullptr || !meta_def->type_and_shape_inference_function);
+  });
+}
+
+}  // namespace
+
+CapabilityCache::CapabilityCache(std::filesystem::path directory, const logging::Logger& logger)
+    : directory_(std::move(directory)), logger_(logger) {
+}
+
+Status CapabilityCache::Create(const std::filesystem::path& directory, const logging::Logger& logger,
+                               std::unique_ptr<CapabilityCache>& cache) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  ORT_RETURN_IF(error, "Failed to create the partitioning cache directory ", directory.string(), ": ",
+                error.message());
+  cache.reset(new CapabilityCache(directory, logger));
+  return Status::OK();
+}
+
+std::string CapabilityCache::ComputeKey(const GraphViewer& graph_viewer, const IExecutionProvider& ep) {
+  BinaryBufferWriter writer;
+  writer.Write(std::string(ORT_VERSION));
+  writer.Write(ep.Type());
+  const ProviderOptions provider_options = ep.GetProviderOptions();
+  for (const auto& [name, value] : std::map<std::string, std::string>(provider_options.begin(),
+                                                                      provider_options.end())) {
+    writer.Write(name);
+    writer.Write(value);
+  }
+
+  const auto& domain_to_version = graph_viewer.DomainToVersionMap();
+  for (const auto& [domain, version] : std::map<std::string, int>(domain_to_version.begin(),
+                                                                  domain_to_version.end())) {
+    writer.Write(domain);
+    writer.Write(static_cast<uint64_t>(version));
+  }
+  WriteNodeArgs(writer, graph_viewer.GetInputsIncludingInitializers());
+  WriteNodeArgs(writer, graph_viewer.GetOutputs());
+
+  std::map<std::string, const ONNX_NAMESPACE::TensorProto*> initializers;
+  for (const auto& [name, initializer] : graph_viewer.GetAllInitializedTensors()) {
+    initializers.emplace(name, initializer);
+  }
+  for (const auto& [name, initializer] : initializers) {
+    writer.Write(name);
+    writer.Write(static_cast<uint64_t>(initializer->data_type()));
+    writer.Write(static_cast<uint64_t>(initializer->dims_size()));
+    for (const auto dim : initializer->dims()) {
+      writer.Write(static_cast<uint64_t>(dim));
+    }
+  }
+
+  // the capabilities refer to the nodes by index, so the indices are part of the key
+  writer.Write(static_cast<uint64_t>(graph_viewer.MaxNodeIndex()));
+  for (const auto& node : graph_viewer.Nodes()) {
+    writer.Write(static_cast<uint64_t>(node.Index()));
+    writer.Write(node.Name());
+    writer.Write(node.OpType());
+    writer.Write(node.Domain());
+    writer.Write(static_cast<uint64_t>(node.SinceVersion()));
+    writer.Write(node.GetExecutionProviderType());
+    WriteAttributes(writer, node.GetAttributes());
+    WriteNodeArgs(writer, node.InputDefs());
+    WriteNodeArgs(writer, node.ImplicitInputDefs());
+    WriteNodeArgs(writer, node.OutputDefs());
+  }
+
+  return writer.HashToHex();
+}
+
+std::vector<std::unique_ptr<ComputeCapability>> CapabilityCache::GetCapabilities(
+    const GraphViewer& graph_viewer, const IExecutionProvider& ep, const GetCapabilitiesFn& get_capabilities) const {
+  const std::filesystem::path file_path = directory_ / (ep.Type() + "_" + ComputeKey(graph_viewer, ep) + kFileExtension);
+
+  std::vector<std::unique_ptr<ComputeCapability>> capabilities;
+  if (Load(file_path, graph_viewer, capabilities)) {
+    LOGS(logger_, VERBOSE) << "Loaded " << capabilities.size() << " capabilities of " << ep.Type()
+                           << " from the partitioning cache " << file_path.string();
+    return capabilities;
+  }
+
+  capabilities = get_capabilities();
+  if (CanSave(capabilities)) {
+    Save(file_path, capabilities);
+  } else {
+    LOGS(logger_, VERBOSE) << "The capabilities of " << ep.Type() << " cannot be stored in the partitioning cache.";
+  }
+  return capabilities;
+}
+
+bool CapabilityCache::Load(const std::filesystem::path& file_path, const GraphViewer& graph_viewer,
+                           std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const {
+  std::string buffer;
+  if (!ReadBinaryFile(file_path, buffer)) {
+    return false;
+  }
+
+  BinaryBufferReader reader(buffer);
+  std::string magic;
+  uint64_t num_capabilities = 0;
+  bool valid = reader.Read(magic) && magic == kFileMagic && reader.ReadCount(num_capabilities);
+
+  for (uint64_t i = 0; valid && i < num_capabilities; ++i) {
+    auto sub_graph = std::make_unique<IndexedSubGraph>();
+    uint64_t num_nodes = 0, schema_source = 0, has_meta_def = 0;
+    valid = reader.ReadCount(num_nodes);
+    for (uint64_t j = 0; valid && j < num_nodes; ++j) {
+      uint64_t node_index = 0;
+      valid = reader.Read(node_index) && graph_viewer.GetNode(static_cast<NodeIndex>(node_index)) != nullptr;
+      sub_graph->nodes.push_back(static_cast<NodeIndex>(node_index));
+    }
+    valid = valid && reader.Read(schema_source) && reader.Read(has_meta_def);
+    sub_graph->schema_source = static_cast<IndexedSubGraph::SourceOfSchema>(schema_source);
+
+    if (valid && has_meta_def != 0) {
+      auto meta_def = std::make_unique<IndexedSubGraph::MetaDef>();
+      uint64_t since_version = 0, status = 0;
+      valid = reader.Read(meta_def->name) && reader.Read(meta_def->domain) && reader.Read(since_version) &&
+              reader.Read(status) && reader.Read(meta_def->inputs) && reader.Read(meta_def->outputs) &&
+              reader.Read(meta_def->constant_initializers) && ReadAttributes(reader, meta_def->attributes) &&
+              reader.Read(meta_def->doc_string);
+      meta_def->since_version = static_cast<int>(since_version);
+      meta_def->status = static_cast<ONNX_NAMESPACE::OperatorStatus>(status);
+      sub_graph->SetMetaDef(std::move(meta_def));
+    }
+    capabilities.push_back(std::make_unique<ComputeCapability>(std::move(sub_graph)));
+  }
+
+  if (!valid || !reader.AtEnd()) {
+    LOGS(logger_, WARNING) << "Ignoring the invalid partitioning cache file " << file_path.string();
+    capabilities.clear();
+    return false;
+  }
+  return true;
+}
+
+void CapabilityCache::Save(const std::filesystem::path& file_path,
+                           const std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const {
+  BinaryBufferWriter writer;
+  writer.Write(std::string(kFileMagic));
+  writer.Write(static_cast<uint64_t>(capabilities.size()));
+  for (const auto& capability : capabilities) {
+    const IndexedSubGraph& sub_graph = *capability->sub_graph;
+    writer.Write(static_cast<uint64_t>(sub_graph.nodes.size()));
+    for (const auto node_index : sub_graph.nodes) {
+      writer.Write(static_cast<uint64_t>(node_index));
+    }
+    writer.Write(static_cast<uint64_t>(sub_graph.schema_source));
+
+    const auto* meta_def = sub_graph.GetMetaDef();
+    writer.Write(static_cast<uint64_t>(meta_def != nullptr));
+    if (meta_def != nullptr) {
+      writer.Write(meta_def->name);
+      writer.Write(meta_def->domain);
+      writer.Write(static_cast<uint64_t>(meta_def->since_version));
+      writer.Write(static_cast<uint64_t>(meta_def->status));
+      writer.Write(meta_def->inputs);
+      writer.Write(meta_def->outputs);
+      writer.Write(meta_def->constant_initializers);
+      WriteAttributes(writer, meta_def->attributes);
+      writer.Write(meta_def->doc_string);
+    }
+  }
+
+  const Status status = WriteBinaryFileAtomically(file_path, writer.Buffer());
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Failed to write the partitioning cache: " << status.ErrorMessage();
+  }
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/compute_capability.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class IExecutionProvider;
+
+/**
+ * Persistent cache of the capabilities returned by the execution providers during graph partitioning, enabled with
+ * kOrtSessionOptionsPartitioningCacheDir. Not available in minimal builds.
+ *
+ * The capabilities of a provider for a graph are stored in a file of the cache directory named after a hash of the
+ * graph (nodes, assignments, types and shapes of the values, initializer names, types and shapes), the provider type,
+ * the provider options and the ORT version. Initializer values are not part of the key.
+ *
+ * Only providers that opt in with IExecutionProvider::CanCacheCapabilities are cached, and only capabilities that
+ * can be stored: the ones with EP optimizations (nodes_to_optimize) or with a type and shape inference function in
+ * their MetaDef are always queried.
+ */
+class CapabilityCache {
+ public:
+  using GetCapabilitiesFn = std::function<std::vector<std::unique_ptr<ComputeCapability>>()>;
+
+  // Creates the cache directory if it does not exist.
+  static Status Create(const std::filesystem::path& directory, const logging::Logger& logger,
+                       std::unique_ptr<CapabilityCache>& cache);
+
+  // Returns the capabilities of the provider for the graph from the cache. If they are not in it, calls
+  // get_capabilities and stores its result in the cache.
+  std::vector<std::unique_ptr<ComputeCapability>> GetCapabilities(const GraphViewer& graph_viewer,
+                                                                  const IExecutionProvider& ep,
+                                                                  const GetCapabilitiesFn& get_capabilities) const;
+
+  // Returns the hash identifying the capabilities of the provider for the graph, as a hexadecimal string.
+  static std::string ComputeKey(const GraphViewer& graph_viewer, const IExecutionProvider& ep);
+
+ private:
+  CapabilityCache(std::filesystem::path directory, const logging::Logger& logger);
+
+  bool Load(const std::filesystem::path& file_path, const GraphViewer& graph_viewer,
+            std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const;
+  void Save(const std::filesystem::path& file_path,
+            const std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const;
+
+  const std::filesystem::path directory_;
+  const logging::Logger& logger_;
+};
+
+}  // namespace onnxruntime
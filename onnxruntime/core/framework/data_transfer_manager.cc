@@ -2,8 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/framework/data_transfer_manager.h"
+
+#include <algorithm>
+#include <iterator>
+
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
+#include "core/platform/trace_points.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -37,6 +42,8 @@ Status DataTransferManager::CopyTensor(const Tensor& src, Tensor& dst) const {
       continue;
     }
 
+    ORT_TRACE_MEMCPY(static_cast<int>(src.Location().device.Type()), static_cast<int>(dst.Location().device.Type()),
+                     src.SizeInBytes());
     return data_transfer->CopyTensor(src, dst);
   }
 
@@ -58,6 +65,8 @@ Status DataTransferManager::CopyTensorAsync(const Tensor& src, Tensor& dst, Stre
       continue;
     }
 
+    ORT_TRACE_MEMCPY(static_cast<int>(src.Location().device.Type()), static_cast<int>(dst.Location().device.Type()),
+                     src.SizeInBytes());
     return data_transfer->CopyTensorAsync(src, dst, stream);
   }
 
@@ -129,16 +138,36 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
     return first_dt->CopyTensors(src_dst_pairs);
   }
 
-  // there are a mix of devices requiring copies. we don't expect this to happen, so just iterate the pairs
-  // copying one at a time. if this becomes expected we could create a list for each IDataTransfer instance so we
-  // batch as much as possible.
+  // there are a mix of devices requiring copies, e.g. the inputs of a model partitioned between several EPs.
+  // create a list for each IDataTransfer instance so the copies are batched as much as possible.
+  std::vector<std::pair<const IDataTransfer*, std::vector<IDataTransfer::SrcDstPair>>> batches;
+  for (const auto& pair : src_dst_pairs) {
+    if (pair.src.get().Shape().Size() != pair.dst.get().Shape().Size()) {
+      return Status(ONNXRUNTIME, FAIL, "Tensor size mismatch");
+    }
 
-  // copy the first one as we already did the IDataTransfer lookup
-  ORT_RETURN_IF_ERROR(first_pair.src_stream ? first_dt->CopyTensorAsync(first_pair.src.get(), first_pair.dst.get(), *(first_pair.src_stream))
-                                            : first_dt->CopyTensor(first_pair.src.get(), first_pair.dst.get()));
+    const IDataTransfer* data_transfer = GetDataTransfer(pair.src.get().Location().device,
+                                                         pair.dst.get().Location().device);
+    if (data_transfer == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME,
+                             FAIL,
+                             "There's no data transfer registered for copying tensors from ",
+                             pair.src.get().Location().device.ToString(),
+                             " to ",
+                             pair.dst.get().Location().device.ToString());
+    }
 
-  for (auto cur_pair = src_dst_pairs.cbegin() + 1, end_pair = src_dst_pairs.cend(); cur_pair != end_pair; ++cur_pair) {
-    ORT_RETURN_IF_ERROR(!cur_pair->src_stream ? CopyTensor(cur_pair->src, cur_pair->dst) : CopyTensorAsync(cur_pair->src, cur_pair->dst, *(cur_pair->src_stream)));
+    auto batch = std::find_if(batches.begin(), batches.end(),
+                              [data_transfer](const auto& b) { return b.first == data_transfer; });
+    if (batch == batches.end()) {
+      batches.push_back({data_transfer, {}});
+      batch = std::prev(batches.end());
+    }
+    batch->second.push_back(pair);
+  }
+
+  for (const auto& [data_transfer, pairs] : batches) {
+    ORT_RETURN_IF_ERROR(data_transfer->CopyTensors(pairs));
   }
 
   return Status::OK();
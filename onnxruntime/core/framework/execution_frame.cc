@@ -14,6 +14,7 @@
 #include "core/framework/sparse_utils.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/scratch_allocator.h"
 #include "core/framework/session_state.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/utils.h"
@@ -204,13 +205,15 @@ AllocatorPtr IExecutionFrame::GetAllocator(const OrtDevice& info) const {
 
 Status IExecutionFrame::ReleaseMLValue(int ort_value_idx) { return ReleaseMLValueImpl(ort_value_idx); }
 
-#ifdef ENABLE_TRAINING
 void IExecutionFrame::ReleaseAllMLValues() {
   for (size_t ort_value_idx = 0; ort_value_idx < all_values_.size(); ort_value_idx++) {
     all_values_[ort_value_idx] = OrtValue();
   }
 }
-#endif
+
+void IExecutionFrame::SetFetchIndices(gsl::span<const int> fetch_mlvalue_idxs) {
+  fetch_mlvalue_idxs_.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+}
 
 Status IExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   if (ort_value_idx == NodeIndexInfo::kInvalidEntry || static_cast<size_t>(ort_value_idx) >= all_values_size_) {
@@ -375,11 +378,64 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #endif
       fetches);
 
+  InitForRun(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetch_allocators);
+}
+
+void ExecutionFrame::Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                           gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+                           ,
+                           const DeviceStreamCollection* device_streams
+#endif
+) {
+#ifdef ORT_ENABLE_STREAM
+  device_streams_ = device_streams;
+#endif
+  planner_.reset();
+#if !defined(ORT_MINIMAL_BUILD)
+  ort_value_to_dynamic_allocations_size_.clear();
+#endif
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
-  session_state.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
+  static_activation_memory_sizes_in_byte_.clear();
+  dynamic_activation_memory_sizes_in_byte_.clear();
 #endif
 
+  SetFetchIndices(fetch_mlvalue_idxs);
+  Init(
+      feed_mlvalue_idxs, feeds, session_state_.GetInitializedTensors(),
+#if !defined(DISABLE_SPARSE_TENSORS)
+      [this](const std::string& name) -> bool {
+        int idx = -1;
+        if (session_state_.GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
+          return session_state_.IsSparseInitializer(idx);
+        }
+        return false;
+      },
+#else
+      [&](const std::string& /*name*/) -> bool {
+        return false;
+      },
+#endif
+      fetches);
+
+  InitForRun(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetch_allocators);
+}
+
+void ExecutionFrame::InitForRun(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                gsl::span<const int> fetch_mlvalue_idxs,
+                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  session_state_.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
+#endif
+
+  if (MemoryTimeline* memory_timeline = session_state_.GetMemoryTimeline();
+      memory_timeline != nullptr && memory_timeline->IsEnabled()) {
+    memory_timeline->StartRun();
+  }
+
   // map the custom allocators to ort_value_idx entries
+  custom_allocators_.clear();
   if (!fetch_allocators.empty()) {
     custom_allocators_.reserve(fetch_allocators.size());
     const auto idx_size = fetch_mlvalue_idxs.size();
@@ -391,10 +447,27 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
     }
   }
 
+  if (session_state_.GetUseScratchAllocator()) {
+    if (scratch_allocator_ != nullptr) {
+      session_state_.RecordScratchHighWaterMark(scratch_allocator_->HighWaterMark());
+    }
+    const size_t capacity = session_state_.GetScratchHighWaterMark();
+    if (scratch_allocator_ == nullptr || scratch_allocator_->Capacity() < capacity) {
+      AllocatorPtr cpu_allocator = GetAllocator(OrtDevice());
+      scratch_allocator_ = cpu_allocator ? std::make_shared<ScratchAllocator>(std::move(cpu_allocator), capacity)
+                                         : nullptr;
+    }
+  }
+
+  // a reset frame only keeps the memory pattern buffers of its previous run if the patterns are the same
+  auto previous_mem_patterns = std::move(mem_patterns_);
+  mem_patterns_ = nullptr;
+  inferred_shapes_ = nullptr;
+
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
+  if (session_state_.GetEnableMemoryPattern() && session_state_.GetExecutionPlan()) {
     bool all_tensors = true;
     // Reserve mem to avoid re-allocation.
     for (const auto& feed : feeds) {
@@ -406,11 +479,15 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_patterns_ = session_state_.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
-        planner_.emplace(*session_state.GetExecutionPlan());
+        planner_.emplace(*session_state_.GetExecutionPlan());
+      } else if (mem_patterns_ == previous_mem_patterns && !buffers_.empty() && !buffers_allocated_on_stream_) {
+        // the frame is reused for the same input shapes, keep the big chunks allocated by the previous run
       } else {
+        buffers_.clear();
+        buffers_allocated_on_stream_ = false;
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
@@ -445,6 +522,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
               if (stream_aware_alloc && device_streams_) {
                 Stream* mem_pattern_stream = device_streams_->GetRootStream();
                 buffer = stream_aware_alloc->AllocOnStream(peak_size, mem_pattern_stream, nullptr);
+                buffers_allocated_on_stream_ = true;
                 for (size_t j = 0; j < device_streams_->NumStreams(); j++) {
                   stream_aware_alloc->SecureTheChunk(mem_pattern_stream, device_streams_->GetStream(j), nullptr);
                 }
@@ -473,7 +551,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
             }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
             // Record activation memory pattern
-            auto mem_profier_ptr = session_state.GetMemoryProfiler();
+            auto mem_profier_ptr = session_state_.GetMemoryProfiler();
             mem_profier_ptr->GetMemoryInfo().ClearMemoryInfoPerExecution();
             if (mem_patterns_ && buffer != nullptr) {
               mem_profier_ptr->GetMemoryInfo().RecordPatternInfo(*mem_patterns_, MemoryInfo::MapType::StaticActivation);
@@ -490,9 +568,24 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       }
     }
   }
+
+  if (mem_patterns_ == nullptr) {
+    buffers_.clear();
+  }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  if (scratch_allocator_ != nullptr) {
+    session_state_.RecordScratchHighWaterMark(scratch_allocator_->HighWaterMark());
+  }
+}
+
+AllocatorPtr ExecutionFrame::GetTempSpaceAllocator(const OrtDevice& device) const {
+  if (scratch_allocator_ != nullptr && device == scratch_allocator_->Info().device) {
+    return scratch_allocator_;
+  }
+  return GetAllocator(device);
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -575,6 +668,13 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!alloc) alloc = GetAllocator(location);
   ORT_ENFORCE(alloc && alloc.get() != nullptr, "Failed to get allocator for ", location.ToString());
 
+  MemoryTimeline* memory_timeline = session_state_.GetMemoryTimeline();
+  if (memory_timeline != nullptr && !memory_timeline->IsEnabled()) {
+    memory_timeline = nullptr;
+  }
+  // alloc is moved to the tensor
+  AllocatorPtr timeline_alloc = memory_timeline != nullptr ? alloc : nullptr;
+
   Stream* current_stream = GetValueStream(ort_value_index);
   if (current_stream) {
 #ifdef ORT_ENABLE_STREAM
@@ -586,6 +686,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamAware()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->AllocOnStream(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -603,6 +707,17 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     TraceAllocate(ort_value_index, size);
   }
 
+  if (memory_timeline != nullptr) {
+    std::string value_name;
+    std::string node_name;
+    if (session_state_.GetOrtValueNameIdxMap().GetName(ort_value_index, value_name).IsOK()) {
+      const Node* producer = session_state_.GetGraphViewer().GetProducerNode(value_name);
+      node_name = producer != nullptr ? producer->Name() : std::string();
+    }
+    memory_timeline->RecordAllocation(ort_value.Get<Tensor>().DataRaw(), size, timeline_alloc, value_name,
+                                      node_name);
+  }
+
   {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // This code block is not thread-safe.
@@ -637,28 +752,20 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
   ORT_ENFORCE(!is_strided_tensor);
 #endif  // ENABLE_STRIDED_TENSORS
   if (!is_strided_tensor) {
-    auto buffer_num_elements = reuse_tensor->Shape().Size();
-    auto required_num_elements = shape.Size();
+    const size_t buffer_size = reuse_tensor->SizeInBytes();
+    size_t required_size = 0;
+    ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(element_type, shape, /*alignment*/ 0, required_size));
 
-    // check number of elements matches. shape may not be an exact match (e.g. Reshape op)
-    if (buffer_num_elements != required_num_elements) {
+    // check the buffer is large enough. shape and element type may not be an exact match (e.g. Reshape op), and the
+    // planner reuses freed buffers of known size that are larger than the value.
+    if (buffer_size < required_size) {
       // could be an allocation planner bug (less likely) or the model incorrectly uses something like 'None'
       // as a dim_param, or -1 in dim_value in multiple places making the planner think those shapes are equal.
-      auto message = onnxruntime::MakeString(
-          "Shape mismatch attempting to re-use buffer. ", reuse_tensor->Shape(), " != ", shape,
-          ". Validate usage of dim_value (values should be > 0) and "
-          "dim_param (all values with the same string should equate to the same size) in shapes in the model.");
-
-      // be generous and use the buffer if it's large enough. log a warning though as it indicates a bad model
-      if (buffer_num_elements >= required_num_elements) {
-        // View Operator is reusing the buffer bigger than the required size.
-        // Disabling warning message for now. The op is in the process of being deprecated.
-#ifndef ENABLE_TRAINING
-        LOGS(session_state_.Logger(), WARNING) << message;
-#endif  // ENABLE_TRAINING
-      } else {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, message);
-      }
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "Shape mismatch attempting to re-use buffer. ", reuse_tensor->Shape(), " != ", shape,
+                             ". Validate usage of dim_value (values should be > 0) and "
+                             "dim_param (all values with the same string should equate to the same size) in shapes "
+                             "in the model.");
     }
   }
 
@@ -881,8 +988,21 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 
 // do not call this in ParallExecutionPlan
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
+  MemoryTimeline* memory_timeline = session_state_.GetMemoryTimeline();
+  const void* released_data = nullptr;
+  if (memory_timeline != nullptr && memory_timeline->IsEnabled() && ort_value_idx >= 0 &&
+      ort_value_idx <= GetOrtValueNameIdxMap().MaxIdx()) {
+    const OrtValue& ort_value = GetMutableMLValue(ort_value_idx);
+    if (ort_value.IsAllocated() && ort_value.IsTensor()) {
+      released_data = ort_value.Get<Tensor>().DataRaw();
+    }
+  }
+
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  if (released_data != nullptr) {
+    memory_timeline->RecordFree(released_data);
+  }
   return Status::OK();
 }
 
@@ -20,6 +20,7 @@
 namespace onnxruntime {
 
 class DataTransferManager;
+class ScratchAllocator;
 class SessionState;
 class OrtValueNameIdxMap;
 struct MemoryPatternGroup;
@@ -67,10 +68,12 @@ class IExecutionFrame {
 
                      const std::unordered_map<int, OrtValue>& initializers);
   Status GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches);
-  // if OOM happens, then release all values, so session can run next batch.
-  void ReleaseAllMLValues();
 #endif
 
+  // Release all values held by the frame. Used if OOM happens so that the session can run the next batch, and
+  // before a frame is pooled for reuse.
+  void ReleaseAllMLValues();
+
   // TO DO: make it thread safe
   // This method is not thread safe!
   // Return S_OK and nullptr if index map to an value that is an unused optional input/output
@@ -90,6 +93,9 @@ class IExecutionFrame {
 
   AllocatorPtr GetAllocator(const OrtDevice& info) const;
 
+  // The allocator of the temporary buffers of the kernels on the device. The allocator of the device by default.
+  virtual AllocatorPtr GetTempSpaceAllocator(const OrtDevice& device) const { return GetAllocator(device); }
+
   Status ReleaseMLValue(int ort_value_idx);
 
   // get the ort_value_idx from NodeIndexInfo
@@ -105,6 +111,9 @@ class IExecutionFrame {
 
   const OrtValueNameIdxMap& GetOrtValueNameIdxMap() const noexcept { return ort_value_idx_map_; }
 
+  // Replace the fetch indices. Used by derived classes that are reset for another run before calling Init.
+  void SetFetchIndices(gsl::span<const int> fetch_mlvalue_idxs);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IExecutionFrame);
 
@@ -151,6 +160,18 @@ class ExecutionFrame final : public IExecutionFrame {
                  const SessionState& session_state);
   ~ExecutionFrame() override;
 
+  // Prepare the frame for another run, as if it was constructed with these arguments. All values must have been
+  // released with ReleaseAllMLValues. The buffers allocated for the memory patterns of the previous run are kept if
+  // the input shapes have the same memory patterns.
+  void Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+             gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+             ,
+             const DeviceStreamCollection* device_streams
+#endif
+  );
+
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
   // Fix the unit tests so they set an execution plan that results in these methods being called by
   // GetOrCreateNodeOutputMLValue instead
@@ -182,6 +203,9 @@ class ExecutionFrame final : public IExecutionFrame {
   // If the retrival is successful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
 
+  // The scratch allocator of the frame for the CPU kernels if kOrtSessionOptionsUseScratchAllocator is set.
+  AllocatorPtr GetTempSpaceAllocator(const OrtDevice& device) const override;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Return the size of virtual memory allocated in runtime.
   // The memory is usually used for activations in forward and backward passes.
@@ -224,6 +248,11 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtDevice& location, const TensorShape& shape);
 
+  // Set up the custom allocators and the memory patterns for a run with the given feeds and fetches.
+  void InitForRun(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  gsl::span<const int> fetch_mlvalue_idxs,
+                  const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
@@ -243,7 +272,7 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -251,13 +280,19 @@ class ExecutionFrame final : public IExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
+  // true if buffers_ were allocated on a device stream, in which case they are not kept by Reset
+  bool buffers_allocated_on_stream_ = false;
+
+  // Bump allocator of the temporary buffers of the CPU kernels. Kept by Reset unless the previous runs needed a
+  // larger block.
+  std::shared_ptr<ScratchAllocator> scratch_allocator_;
 
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
   // inferred_shapes_ is generated together with mem_patterns_.
   // It is never updated after creation
-  const InlinedHashMap<int, TensorShape>* inferred_shapes_{nullptr};
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes_;
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Size of virtual memory allocated before any kernel execution.
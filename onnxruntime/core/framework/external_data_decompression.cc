@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/external_data_decompression.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+
+#if defined(USE_ZSTD)
+#include <zstd.h>
+#endif
+#if defined(USE_LZ4)
+#include <lz4.h>
+#endif
+
+namespace onnxruntime {
+namespace utils {
+
+namespace {
+
+using Compression = ExternalDataInfo::Compression;
+
+Status DecompressChunk(Compression compression, gsl::span<const char> input, gsl::span<char> output) {
+  switch (compression) {
+#if defined(USE_ZSTD)
+    case Compression::kZstd: {
+      const size_t result = ZSTD_decompress(output.data(), output.size(), input.data(), input.size());
+      ORT_RETURN_IF(ZSTD_isError(result), "zstd decompression failed: ", ZSTD_getErrorName(result));
+      ORT_RETURN_IF(result != output.size(), "zstd decompressed ", result, " bytes, expected ", output.size());
+      return Status::OK();
+    }
+#endif
+#if defined(USE_LZ4)
+    case Compression::kLz4: {
+      const int result = LZ4_decompress_safe(input.data(), output.data(), narrow<int>(input.size()),
+                                             narrow<int>(output.size()));
+      ORT_RETURN_IF(result < 0, "lz4 decompression failed with error ", result);
+      ORT_RETURN_IF(static_cast<size_t>(result) != output.size(),
+                    "lz4 decompressed ", result, " bytes, expected ", output.size());
+      return Status::OK();
+    }
+#endif
+    default:
+      ORT_UNUSED_PARAMETER(input);
+      ORT_UNUSED_PARAMETER(output);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "The external data compression is not supported in this build.");
+  }
+}
+
+}  // namespace
+
+bool IsExternalDataCompressionAvailable(Compression compression) {
+  switch (compression) {
+    case Compression::kNone:
+      return true;
+#if defined(USE_ZSTD)
+    case Compression::kZstd:
+      return true;
+#endif
+#if defined(USE_LZ4)
+    case Compression::kLz4:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+Status DecompressExternalData(const Env& env, const ORTCHAR_T* file_path, FileOffsetType file_offset,
+                              const ExternalDataInfo::CompressionInfo& compression_info,
+                              gsl::span<char> output, concurrency::ThreadPool* thread_pool) {
+  ORT_RETURN_IF_NOT(IsExternalDataCompressionAvailable(compression_info.compression),
+                    "The external data compression is not supported in this build.");
+  const size_t chunk_size = compression_info.chunk_size;
+  const auto& chunk_lengths = compression_info.chunk_lengths;
+  ORT_RETURN_IF(chunk_size == 0, "The chunk size of compressed external data is 0.");
+  const size_t num_chunks = (output.size() + chunk_size - 1) / chunk_size;
+  ORT_RETURN_IF_NOT(chunk_lengths.size() == num_chunks, "Compressed external data has ", chunk_lengths.size(),
+                    " chunks, expected ", num_chunks, " chunks of ", chunk_size, " bytes for ", output.size(),
+                    " bytes.");
+
+  std::vector<FileOffsetType> chunk_offsets(num_chunks);
+  SafeInt<FileOffsetType> chunk_offset = file_offset;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    chunk_offsets[i] = chunk_offset;
+    chunk_offset += chunk_lengths[i];
+  }
+
+  std::vector<Status> statuses(num_chunks);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_chunks),
+      [&](std::ptrdiff_t i) {
+        const size_t begin = static_cast<size_t>(i) * chunk_size;
+        auto chunk_output = output.subspan(begin, std::min(chunk_size, output.size() - begin));
+        ORT_TRY {
+          auto input = std::make_unique<char[]>(chunk_lengths[i]);
+          auto input_span = gsl::make_span(input.get(), chunk_lengths[i]);
+          statuses[i] = env.ReadFileIntoBuffer(file_path, chunk_offsets[i], chunk_lengths[i], input_span);
+          if (statuses[i].IsOK()) {
+            statuses[i] = DecompressChunk(compression_info.compression, input_span, chunk_output);
+          }
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
+}  // namespace utils
+}  // namespace onnxruntime
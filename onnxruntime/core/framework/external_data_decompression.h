@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace concurrency {
+class ThreadPool;
+}
+
+namespace utils {
+
+// Whether the codec of `compression` is part of the build: zstd with USE_ZSTD and lz4 with USE_LZ4.
+bool IsExternalDataCompressionAvailable(ExternalDataInfo::Compression compression);
+
+// Decompresses the chunks of compressed external data stored from file_offset in file_path into `output`, whose size
+// is the uncompressed size of the tensor. The chunks are processed in parallel over thread_pool, which may be null,
+// and a worker reads its next chunk while the others decompress, so the reads of a slow disk overlap the
+// decompression. Each chunk is decompressed directly into its range of the output.
+common::Status DecompressExternalData(const Env& env, const ORTCHAR_T* file_path, FileOffsetType file_offset,
+                                      const ExternalDataInfo::CompressionInfo& compression_info,
+                                      gsl::span<char> output, concurrency::ThreadPool* thread_pool);
+
+}  // namespace utils
+}  // namespace onnxruntime
@@ -6,11 +6,13 @@
 #include "core/framework/fallback_cpu_capability.h"
 #include "core/common/inlined_containers.h"
 
+#include <algorithm>
 #include <queue>
 
 #include "onnx/defs/data_type_utils.h"
 
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 
 using namespace ONNX_NAMESPACE::Utils;
@@ -39,6 +41,25 @@ static bool IsSmallInitializer(const onnxruntime::GraphViewer& graph, const Node
 
   return size <= kSmallInitializerThreshold;
 }
+
+// Returns true if the shape of the tensor is statically known and it is small enough that copying it between
+// devices costs less than the round trip of the other inputs and outputs of its consumer.
+static bool IsSmallStaticTensor(const NodeArg* arg) {
+  const auto* shape = arg->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  int64_t size = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    size *= dim.dim_value();
+  }
+
+  return size <= kSmallInitializerThreshold;
+}
 }  // namespace
 
 std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewer& graph,
@@ -127,6 +148,8 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
     }
 
     bool place_in_cpu = true;
+    // whether placing the node on CPU requires copying a small input from the target EP
+    bool copies_input_to_cpu = false;
     for (size_t i = 0; i < node->InputDefs().size(); ++i) {
       auto* input = node->InputDefs()[i];
 
@@ -149,6 +172,12 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
 
       // the input is not a CPU tensor
       if (cpu_output_args.find(input) == cpu_output_args.end()) {
+        // a small input is cheaper to copy to CPU than the CPU inputs are to copy to the target EP,
+        // which avoids splitting the CPU subgraph with a node on the target EP
+        if (IsSmallStaticTensor(input)) {
+          copies_input_to_cpu = true;
+          continue;
+        }
         place_in_cpu = false;
         break;
       }
@@ -160,6 +189,13 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
       }
     }
 
+    // when an input has to be copied to CPU, the outputs must be small too in case they are consumed on the target EP,
+    // so that the copies of the node on CPU are never larger than the ones it avoids
+    if (place_in_cpu && copies_input_to_cpu) {
+      place_in_cpu = std::all_of(node->OutputDefs().begin(), node->OutputDefs().end(),
+                                 [](const NodeArg* output) { return IsSmallStaticTensor(output); });
+    }
+
     if (place_in_cpu) {
       cpu_nodes.insert(cur);
       LOGS(logger, INFO) << "ORT optimization- Force fallback to CPU execution for node: " << node->Name()
@@ -7,7 +7,9 @@
 #include <functional>
 
 #include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
 #include "core/common/string_utils.h"
+#include "core/framework/capability_cache.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/func_kernel.h"
@@ -63,6 +65,8 @@ struct PartitionParams {
   std::reference_wrapper<const layout_transformation::TransformLayoutFunction> transform_layout_function;
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  // nullptr if the initialization time is not recorded
+  profiling::InitializationStats* initialization_stats;
 };
 }  // namespace
 
@@ -143,6 +147,10 @@ struct GetCapabilityForEPParams {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   IResourceAccountant* resource_accountant;
   std::reference_wrapper<const GraphOptimizerRegistry> graph_optimizer_registry;
+  // nullptr if the capabilities are not cached
+  const CapabilityCache* capability_cache;
+  // nullptr if the initialization time is not recorded
+  profiling::InitializationStats* initialization_stats;
 };
 
 auto get_capabilities = [](const IExecutionProvider& ep,
@@ -161,6 +169,29 @@ auto get_capabilities = [](const IExecutionProvider& ep,
 
   return capabilities;
 };
+
+// get_capabilities through the partitioning cache, if the capabilities of the EP can be cached.
+// With resource accounting or custom kernel registries, the capabilities depend on more than the graph.
+auto get_capabilities_cached = [](const CapabilityCache* capability_cache,
+                                  const IExecutionProvider& ep,
+                                  const GraphViewer& graph_viewer,
+                                  const IExecutionProvider::IKernelLookup& kernel_lookup,
+                                  size_t num_kernel_registries,
+                                  IResourceAccountant* resource_accountant,
+                                  const GraphOptimizerRegistry& graph_optimizer_registry) {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (capability_cache != nullptr && ep.CanCacheCapabilities() && resource_accountant == nullptr &&
+      num_kernel_registries <= 1) {
+    return capability_cache->GetCapabilities(graph_viewer, ep, [&]() {
+      return get_capabilities(ep, graph_viewer, kernel_lookup, resource_accountant, graph_optimizer_registry);
+    });
+  }
+#else
+  ORT_UNUSED_PARAMETER(capability_cache);
+  ORT_UNUSED_PARAMETER(num_kernel_registries);
+#endif  // !defined(ORT_MINIMAL_BUILD)
+  return get_capabilities(ep, graph_viewer, kernel_lookup, resource_accountant, graph_optimizer_registry);
+};
 }  // namespace
 
 static Status GetCapabilityForEP(const GetCapabilityForEPParams& params, const logging::Logger& logger) {
@@ -188,7 +219,11 @@ static Status GetCapabilityForEP(const GetCapabilityForEPParams& params, const l
 
   {
     const GraphViewer graph_viewer(graph);
-    capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, params.resource_accountant, graph_optimizer_registry);
+    profiling::InitializationStats::ScopedPhase get_capability_phase(params.initialization_stats, "get_capability",
+                                                                     ep_type);
+    capabilities = get_capabilities_cached(params.capability_cache, current_ep, graph_viewer, kernel_lookup,
+                                           kernel_registries_for_ep.size(), params.resource_accountant,
+                                           graph_optimizer_registry);
 
     if (capabilities.empty()) {
       return Status::OK();
@@ -226,7 +261,13 @@ static Status GetCapabilityForEP(const GetCapabilityForEPParams& params, const l
     capabilities.clear();
 
     const GraphViewer graph_viewer(graph);
-    capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, params.resource_accountant, graph_optimizer_registry);
+    {
+      profiling::InitializationStats::ScopedPhase get_capability_phase(params.initialization_stats,
+                                                                       "get_capability", ep_type);
+      capabilities = get_capabilities_cached(params.capability_cache, current_ep, graph_viewer, kernel_lookup,
+                                             kernel_registries_for_ep.size(), params.resource_accountant,
+                                             graph_optimizer_registry);
+    }
 
     // all nodes with an index >= first_new_node with domain of kMSInternalNHWCDomain should be in the capabilities
     InlinedHashSet<NodeIndex> new_nodes_in_capabilities;
@@ -406,7 +447,9 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            const layout_transformation::TransformLayoutFunction& transform_layout_fn,
                                            const layout_transformation::DebugGraphFn& debug_graph_fn,
                                            const logging::Logger& logger, IResourceAccountant* resource_accountant,
-                                           const GraphOptimizerRegistry& graph_optimizer_registry) {
+                                           const GraphOptimizerRegistry& graph_optimizer_registry,
+                                           const CapabilityCache* capability_cache,
+                                           profiling::InitializationStats* initialization_stats) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -420,7 +463,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       // we pass through the FuncManager from the top level graph
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(*subgraph, func_mgr, kernel_registry_mgr,
                                                        fused_kernel_registry, current_ep, mode, fused_node_unique_id,
-                                                       transform_layout_fn, debug_graph_fn, logger, resource_accountant, graph_optimizer_registry));
+                                                       transform_layout_fn, debug_graph_fn, logger, resource_accountant, graph_optimizer_registry,
+                                                       capability_cache, initialization_stats));
     }
   }
 
@@ -445,7 +489,9 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::cref(transform_layout_fn),
       std::cref(debug_graph_fn),
       resource_accountant,
-      std::ref(graph_optimizer_registry)};
+      std::ref(graph_optimizer_registry),
+      capability_cache,
+      initialization_stats};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params, logger));
   if (capabilities.empty()) {
@@ -531,7 +577,10 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
         nodes_and_viewers.push_back(IExecutionProvider::FusedNodeAndGraph{*node, *viewers.back()});
       }
 
-      ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      {
+        profiling::InitializationStats::ScopedPhase compile_phase(initialization_stats, "compile", type);
+        ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      }
 
       if (node_compute_funcs.size() != nodes_to_compile.size()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, type, " did not return correct number of compiled functions");
@@ -838,6 +887,7 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
                                        KernelRegistryManager& kernel_registry_manager,
                                        const std::optional<ResourceAccountantMap>& acc_map,
                                        const GraphOptimizerRegistry& graph_optimizer_registry,
+                                       const CapabilityCache* capability_cache,
                                        const logging::Logger& logger) {
   bool modified_graph = false;
 
@@ -861,7 +911,8 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
                                                        transform_layout_function,
                                                        partition_params.debug_graph_fn,
-                                                       logger, resource_accountant, graph_optimizer_registry));
+                                                       logger, resource_accountant, graph_optimizer_registry,
+                                                       capability_cache, partition_params.initialization_stats));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -915,7 +966,9 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
       std::cref(partition_params.debug_graph_fn),
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
       nullptr,
-      std::ref(graph_optimizer_registry)
+      std::ref(graph_optimizer_registry),
+      nullptr,
+      partition_params.initialization_stats
   };
   // clang-format on
 
@@ -970,8 +1023,12 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
     const bool acc_enabled = compilation_entry.capability.get().sub_graph->IsAccountingEnabled();
     Node& node = compilation_entry.fused_node;
     std::vector<NodeComputeInfo> single_node_compute_func;
-    ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
-                                           single_node_compute_func));
+    {
+      profiling::InitializationStats::ScopedPhase compile_phase(partition_params.initialization_stats, "compile",
+                                                                type);
+      ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
+                                             single_node_compute_func));
+    }
 
     ORT_RETURN_IF(single_node_compute_func.empty(), "single_node_compute_func should have 1 element.");
     auto& func_mgr = partition_params.func_mgr.get();
@@ -1096,7 +1153,8 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
       std::ref(*fused_kernel_registry),
       std::ref(fused_node_unique_id),
       std::cref(transform_layout_function),
-      std::cref(debug_graph_fn)};
+      std::cref(debug_graph_fn),
+      initialization_stats_};
 
 #else  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -1105,6 +1163,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   ORT_UNUSED_PARAMETER(debug_graph_fn);
   PartitionParams partition_params{
       std::ref(graph),
+      initialization_stats_,
   };
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1124,8 +1183,16 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
     std::optional<ResourceAccountantMap> ep_acc_map;
     ORT_RETURN_IF_ERROR(NodeStatsRecorder::CreateAccountants(config_options, graph.ModelPath(), ep_acc_map));
 
+    std::unique_ptr<CapabilityCache> capability_cache;
+    const std::string capability_cache_dir =
+        config_options.GetConfigOrDefault(kOrtSessionOptionsPartitioningCacheDir, "");
+    if (!capability_cache_dir.empty()) {
+      ORT_RETURN_IF_ERROR(CapabilityCache::Create(ToPathString(capability_cache_dir), logger, capability_cache));
+    }
+
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode, providers_, kernel_registry_mgr_,
-                                                 ep_acc_map, *graph_optimizer_registry_, logger));
+                                                 ep_acc_map, *graph_optimizer_registry_, capability_cache.get(),
+                                                 logger));
 
     if (ep_context_enabled) {
       std::string ep_context_path = config_options.GetConfigOrDefault(kOrtSessionOptionEpContextFilePath, "");
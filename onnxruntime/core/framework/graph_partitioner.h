@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/initialization_stats.h"
 #include "core/graph/graph.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/transform_layout_functions.h"
@@ -25,12 +26,16 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
+  // The time spent in the GetCapability and Compile calls of each provider is added to initialization_stats,
+  // if not nullptr.
   GraphPartitioner(KernelRegistryManager& kernel_registry_mgr,
                    const ExecutionProviders& providers,
-                   std::unique_ptr<GraphOptimizerRegistry> graph_optimizer_registry)
+                   std::unique_ptr<GraphOptimizerRegistry> graph_optimizer_registry,
+                   profiling::InitializationStats* initialization_stats = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
         providers_(providers),
-        graph_optimizer_registry_(std::move(graph_optimizer_registry)) {
+        graph_optimizer_registry_(std::move(graph_optimizer_registry)),
+        initialization_stats_(initialization_stats) {
   }
 
   // Run partitioning.
@@ -69,6 +74,7 @@ class GraphPartitioner {
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
   std::unique_ptr<GraphOptimizerRegistry> graph_optimizer_registry_;
+  profiling::InitializationStats* initialization_stats_;
 };
 
 }  // namespace onnxruntime
@@ -179,6 +179,29 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
 // if this function is called before graph partition, then node.provider is not set.
 // In this case, the kernel's provider must equal to exec_provider
 // otherwise, kernel_def.provider must equal to node.provider. exec_provider is ignored.
+std::string KernelRegistry::GetLookupCacheKey(const Node& node, std::string_view provider) {
+  std::string key = GetMapKey(node.OpType(), node.Domain(), provider);
+  auto append = [&key](const auto& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  append(node.SinceVersion());
+  for (const int arg_count : node.InputArgCount()) {
+    append(arg_count);
+  }
+  append(-1);
+
+  // the data types are interned strings so their address identifies them
+  for (const auto* input : node.InputDefs()) {
+    append(input->Exists() ? input->Type() : nullptr);
+  }
+  append(-1);
+  for (const auto* output : node.OutputDefs()) {
+    append(output->Exists() ? output->Type() : nullptr);
+  }
+  return key;
+}
+
 Status KernelRegistry::TryFindKernelImpl(const Node& node,
                                          ProviderType exec_provider,
                                          const IKernelTypeStrResolver* kernel_type_str_resolver,
@@ -188,9 +211,27 @@ Status KernelRegistry::TryFindKernelImpl(const Node& node,
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
 
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
   if (out) *out = nullptr;
 
+  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+  if (range.first == range.second) {
+    return Status(common::ONNXRUNTIME, common::FAIL, "Kernel not found");
+  }
+
+  // the explicit type constraints are only used for the nodes created by custom ops, which are not cached
+  std::string cache_key;
+  if (kernel_type_str_resolver != nullptr) {
+    cache_key = GetLookupCacheKey(node, expected_provider);
+    std::lock_guard<std::mutex> lock(kernel_lookup_cache_mutex_);
+    const auto cached = kernel_lookup_cache_.find(cache_key);
+    if (cached != kernel_lookup_cache_.end()) {
+      if (out) {
+        *out = cached->second;
+      }
+      return Status::OK();
+    }
+  }
+
   std::vector<std::string> verify_kernel_def_error_strs;
 
   for (auto i = range.first; i != range.second; ++i) {
@@ -199,6 +240,10 @@ Status KernelRegistry::TryFindKernelImpl(const Node& node,
       if (out) {
         *out = &i->second;
       }
+      if (kernel_type_str_resolver != nullptr) {
+        std::lock_guard<std::mutex> lock(kernel_lookup_cache_mutex_);
+        kernel_lookup_cache_.insert_or_assign(std::move(cache_key), &i->second);
+      }
       return Status::OK();
     }
 
@@ -327,6 +372,10 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
   // Register the kernel.
   // Ownership of the KernelDef is transferred to kernel_creator_fn_map_.
   kernel_creator_fn_map_.emplace(key, std::move(create_info));
+
+  // the new kernel may match nodes that were matched with another one
+  std::lock_guard<std::mutex> lock(kernel_lookup_cache_mutex_);
+  kernel_lookup_cache_.clear();
   return Status::OK();
 }
 
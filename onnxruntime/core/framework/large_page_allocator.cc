@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/large_page_allocator.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/mlas/inc/mlas.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+
+#if defined(__linux__)
+
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+// Whether the transparent huge pages are enabled for the mappings advised with MADV_HUGEPAGE, i.e. the mode in
+// /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise".
+bool TransparentHugePagesEnabled() {
+  std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+  std::string modes;
+  if (!std::getline(file, modes)) {
+    return false;
+  }
+  return modes.find("[never]") == std::string::npos;
+}
+
+size_t GetLargePageSize() {
+  return kHugePageSize;
+}
+
+// Maps `size` bytes, a multiple of the large page size, on large pages. Returns nullptr when none are available.
+void* AllocateLargePages(size_t size) {
+  // the pages of the hugetlbfs pool are only available if the administrator reserved some
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED) {
+    return p;
+  }
+
+  static const bool transparent_huge_pages = TransparentHugePagesEnabled();
+  if (!transparent_huge_pages) {
+    return nullptr;
+  }
+
+  // the kernel only backs the huge page aligned parts of a mapping with transparent huge pages, so the mapping is
+  // over-allocated by a page and trimmed to an aligned range
+  const size_t mapped_size = size + kHugePageSize;
+  char* base = static_cast<char*>(mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                       -1, 0));
+  if (base == MAP_FAILED) {
+    return nullptr;
+  }
+  char* aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(base) + kHugePageSize - 1) &
+                                          ~(uintptr_t{kHugePageSize} - 1));
+  if (aligned != base) {
+    munmap(base, static_cast<size_t>(aligned - base));
+  }
+  const size_t tail_size = static_cast<size_t>((base + mapped_size) - (aligned + size));
+  if (tail_size != 0) {
+    munmap(aligned + size, tail_size);
+  }
+
+  if (madvise(aligned, size, MADV_HUGEPAGE) != 0) {
+    munmap(aligned, size);
+    return nullptr;
+  }
+  return aligned;
+}
+
+void FreeLargePages(void* p, size_t size) {
+  munmap(p, size);
+}
+
+#elif defined(_WIN32) && WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+
+// Large pages can only be allocated by a process whose token has the SeLockMemoryPrivilege enabled. The privilege
+// is granted to the user by the "Lock pages in memory" policy, but it still has to be enabled.
+bool EnableLockMemoryPrivilege() {
+  HANDLE token = nullptr;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+    return false;
+  }
+  TOKEN_PRIVILEGES privileges{};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  bool enabled = LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                 AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                 // AdjustTokenPrivileges succeeds without enabling privileges the user does not have
+                 GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  return enabled;
+}
+
+size_t GetLargePageSize() {
+  static const bool privilege_enabled = EnableLockMemoryPrivilege();
+  return privilege_enabled ? GetLargePageMinimum() : 0;
+}
+
+void* AllocateLargePages(size_t size) {
+  return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+}
+
+void FreeLargePages(void* p, size_t /*size*/) {
+  VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#else
+
+size_t GetLargePageSize() {
+  return 0;
+}
+
+void* AllocateLargePages(size_t /*size*/) {
+  return nullptr;
+}
+
+void FreeLargePages(void* /*p*/, size_t /*size*/) {
+}
+
+#endif
+
+}  // namespace
+
+LargePageCPUAllocator::LargePageCPUAllocator(const OrtMemoryInfo& memory_info)
+    : IAllocator(memory_info), large_page_size_(GetLargePageSize()) {
+  if (large_page_size_ == 0) {
+    LOGS_DEFAULT(WARNING) << "Large pages are not available, the CPU allocator uses regular pages.";
+  }
+}
+
+LargePageCPUAllocator::LargePageCPUAllocator()
+    : LargePageCPUAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {
+}
+
+void* LargePageCPUAllocator::Alloc(size_t size) {
+  // same overrun allowance as AllocatorDefaultAlloc for the kernels that read past the end of their buffers
+  const size_t padded_size = size + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+  if (size == 0 || large_page_size_ == 0 || padded_size < large_page_size_) {
+    return AllocatorDefaultAlloc(size);
+  }
+
+  const size_t mapped_size = (padded_size + large_page_size_ - 1) / large_page_size_ * large_page_size_;
+  void* p = AllocateLargePages(mapped_size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (p == nullptr) {
+    ++num_large_page_fallbacks_;
+    return AllocatorDefaultAlloc(size);
+  }
+  large_page_allocations_.emplace(p, mapped_size);
+  large_page_bytes_ += static_cast<int64_t>(mapped_size);
+  return p;
+}
+
+void LargePageCPUAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = large_page_allocations_.find(p);
+    if (it != large_page_allocations_.end()) {
+      const size_t mapped_size = it->second;
+      large_page_allocations_.erase(it);
+      large_page_bytes_ -= static_cast<int64_t>(mapped_size);
+      FreeLargePages(p, mapped_size);
+      return;
+    }
+  }
+  AllocatorDefaultFree(p);
+}
+
+void LargePageCPUAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats->large_page_bytes = large_page_bytes_;
+  stats->num_large_page_fallbacks = num_large_page_fallbacks_;
+}
+
+}  // namespace onnxruntime
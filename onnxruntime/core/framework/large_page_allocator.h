@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// A CPU allocator that backs the allocations of at least one large page with large (2 MB) pages, to reduce the TLB
+// misses of kernels going through multi-GB weights and activations. Used as the device allocator of the CPU arena,
+// it backs the arena regions and the initializers reserved in the arena.
+//
+// - Linux: pages of the hugetlbfs pool (MAP_HUGETLB) when the administrator reserved some, otherwise an aligned
+//   mapping advised with MADV_HUGEPAGE for transparent huge pages, unless they are disabled.
+// - Windows: VirtualAlloc with MEM_LARGE_PAGES, which requires the SeLockMemoryPrivilege of the user.
+//
+// The allocations that are smaller than a large page, or for which large pages are not available, are made like
+// the ones of CPUAllocator. The latter are counted in AllocatorStats::num_large_page_fallbacks.
+class LargePageCPUAllocator : public IAllocator {
+ public:
+  explicit LargePageCPUAllocator(const OrtMemoryInfo& memory_info);
+  LargePageCPUAllocator();
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  // The size of the large pages, or 0 if the platform does not support them.
+  size_t LargePageSize() const noexcept { return large_page_size_; }
+
+ private:
+  size_t large_page_size_;
+
+  std::mutex mutex_;
+  // mapped size of each allocation backed by large pages
+  std::unordered_map<void*, size_t> large_page_allocations_;
+  int64_t large_page_bytes_ = 0;
+  int64_t num_large_page_fallbacks_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/lazy_initializers.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_state.h"
+#include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+LazyInitializers::LazyInitializers(const SessionState& session_state, size_t memory_budget, size_t min_size_in_bytes,
+                                   size_t prefetch_distance)
+    : session_state_{session_state},
+      memory_budget_{memory_budget},
+      min_size_in_bytes_{min_size_in_bytes},
+      prefetch_distance_{prefetch_distance} {
+  if (prefetch_distance_ > 0) {
+    prefetch_thread_ = std::thread([this]() { PrefetchLoop(); });
+  }
+}
+
+LazyInitializers::~LazyInitializers() {
+  if (prefetch_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    prefetch_cv_.notify_all();
+    prefetch_thread_.join();
+  }
+}
+
+bool LazyInitializers::IsCandidate(const ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+  if (!utils::HasExternalData(tensor_proto) ||
+      tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  std::basic_string<ORTCHAR_T> external_file_path;
+  FileOffsetType file_offset = 0;
+  SafeInt<size_t> size_in_bytes = 0;
+  if (!utils::GetExternalDataInfo(tensor_proto, std::filesystem::path(), external_file_path, file_offset,
+                                  size_in_bytes)
+           .IsOK()) {
+    return false;
+  }
+
+  // data already in memory, e.g. external initializers added by the user, is not loaded from anywhere
+  return external_file_path != utils::kTensorProtoMemoryAddressTag &&
+         static_cast<size_t>(size_in_bytes) >= min_size_in_bytes_;
+}
+
+Status LazyInitializers::Add(const GraphViewer& graph_viewer, const std::basic_string<PATH_CHAR_TYPE>& graph_location,
+                             int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                             const OrtDevice& device, OrtValue& ort_value) {
+  auto entry = std::make_unique<Entry>();
+  entry->tensor_proto = tensor_proto;
+  entry->graph_location = graph_location;
+  entry->allocator = session_state_.GetAllocator(device);
+  ORT_RETURN_IF(entry->allocator == nullptr, "No allocator for lazy initializer ", tensor_proto.name(), " on ",
+                device.ToString());
+
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  auto placeholder = std::make_unique<Tensor>(type, utils::GetTensorShapeFromTensorProto(tensor_proto), nullptr,
+                                              entry->allocator->Info());
+  ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(type, placeholder->Shape(), /*alignment*/ 0,
+                                                         entry->size_in_bytes));
+  entry->placeholder = placeholder.get();
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  ort_value.Init(placeholder.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+
+  graph_entries_[&graph_viewer].by_ort_value_index[ort_value_index] = entry.get();
+  entries_.push_back(std::move(entry));
+  return Status::OK();
+}
+
+void LazyInitializers::AddConsumers(const GraphViewer& graph_viewer,
+                                    const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                    ExecutionOrder execution_order) {
+  const auto graph_entries_iter = graph_entries_.find(&graph_viewer);
+  if (graph_entries_iter == graph_entries_.end()) {
+    return;
+  }
+
+  GraphEntries& graph_entries = graph_entries_iter->second;
+  auto add_consumer = [&](const Node& node, const NodeArg* arg) {
+    int ort_value_index = -1;
+    if (!arg->Exists() || !ort_value_name_idx_map.GetIdx(arg->Name(), ort_value_index).IsOK()) {
+      return;
+    }
+    const auto entry = graph_entries.by_ort_value_index.find(ort_value_index);
+    if (entry != graph_entries.by_ort_value_index.end()) {
+      auto& consumed = graph_entries.by_node[node.Index()];
+      if (std::find(consumed.begin(), consumed.end(), entry->second) == consumed.end()) {
+        consumed.push_back(entry->second);
+      }
+    }
+  };
+
+  for (const NodeIndex node_index : graph_viewer.GetNodesInTopologicalOrder(execution_order)) {
+    const Node& node = *graph_viewer.GetNode(node_index);
+    for (const auto* arg : node.InputDefs()) {
+      add_consumer(node, arg);
+    }
+    // the subgraphs of control flow nodes read them while the node runs
+    for (const auto* arg : node.ImplicitInputDefs()) {
+      add_consumer(node, arg);
+    }
+
+    if (graph_entries.by_node.count(node_index) != 0) {
+      graph_entries.consumer_position[node_index] = graph_entries.consumers.size();
+      graph_entries.consumers.push_back(node_index);
+    }
+  }
+}
+
+Status LazyInitializers::Pin(const GraphViewer& graph_viewer, NodeIndex node_index) {
+  const auto graph_entries = graph_entries_.find(&graph_viewer);
+  if (graph_entries == graph_entries_.end()) {
+    return Status::OK();
+  }
+  const auto node_entries = graph_entries->second.by_node.find(node_index);
+  if (node_entries == graph_entries->second.by_node.end()) {
+    return Status::OK();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  const uint64_t use = ++use_count_;
+  for (size_t i = 0; i < node_entries->second.size(); ++i) {
+    Entry& entry = *node_entries->second[i];
+    loaded_cv_.wait(lock, [&entry]() { return entry.state != State::kLoading; });
+    if (entry.state != State::kLoaded) {
+      if (entry.state == State::kQueued) {
+        prefetch_queue_.erase(std::find(prefetch_queue_.begin(), prefetch_queue_.end(), &entry));
+      }
+      OrtValue loaded;
+      Status status = LoadInto(entry, loaded);
+      if (!status.IsOK()) {
+        entry.state = State::kReleased;
+        for (size_t j = 0; j < i; ++j) {
+          --node_entries->second[j]->pin_count;
+        }
+        return status;
+      }
+      SetLoaded(entry, std::move(loaded));
+    }
+    ++entry.pin_count;
+    entry.last_use = use;
+  }
+
+  Prefetch(graph_entries->second, node_index);
+  return Status::OK();
+}
+
+void LazyInitializers::Unpin(const GraphViewer& graph_viewer, NodeIndex node_index) {
+  const auto graph_entries = graph_entries_.find(&graph_viewer);
+  if (graph_entries == graph_entries_.end()) {
+    return;
+  }
+  const auto node_entries = graph_entries->second.by_node.find(node_index);
+  if (node_entries == graph_entries->second.by_node.end()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Entry* entry : node_entries->second) {
+    --entry->pin_count;
+  }
+  ReleaseOverBudget();
+}
+
+size_t LazyInitializers::LoadedSizeInBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return loaded_size_in_bytes_;
+}
+
+Status LazyInitializers::LoadInto(const Entry& entry, OrtValue& loaded) const {
+  return session_state_utils::LoadInitializer(Env::Default(), entry.graph_location, entry.tensor_proto,
+                                              entry.allocator, session_state_.GetAllocator(OrtDevice()),
+                                              session_state_.GetDataTransferMgr(),
+                                              session_state_.GetExternalDataLoaderMgr(), loaded);
+}
+
+void LazyInitializers::SetLoaded(Entry& entry, OrtValue loaded) {
+  // the kernels hold the placeholder, not the loaded value, so the data is moved into the placeholder
+  entry.loaded = std::move(loaded);
+  Tensor& tensor = *entry.loaded.GetMutable<Tensor>();
+  *entry.placeholder = Tensor(tensor.DataType(), tensor.Shape(), tensor.MutableDataRaw(), tensor.Location());
+  entry.state = State::kLoaded;
+  if (entry.allocator->Info().device.Type() == OrtDevice::CPU) {
+    loaded_size_in_bytes_ += entry.size_in_bytes;
+  }
+  LOGS(session_state_.Logger(), VERBOSE) << "Loaded lazy initializer " << entry.tensor_proto.name();
+}
+
+void LazyInitializers::Release(Entry& entry) {
+  *entry.placeholder = Tensor(entry.placeholder->DataType(), entry.placeholder->Shape(), nullptr,
+                              entry.allocator->Info());
+  entry.loaded = OrtValue();
+  entry.state = State::kReleased;
+  loaded_size_in_bytes_ -= entry.size_in_bytes;
+  LOGS(session_state_.Logger(), VERBOSE) << "Released lazy initializer " << entry.tensor_proto.name();
+}
+
+void LazyInitializers::ReleaseOverBudget() {
+  while (memory_budget_ != 0 && loaded_size_in_bytes_ > memory_budget_) {
+    Entry* least_recently_used = nullptr;
+    for (const auto& entry : entries_) {
+      if (entry->state == State::kLoaded && entry->pin_count == 0 &&
+          entry->allocator->Info().device.Type() == OrtDevice::CPU &&
+          (least_recently_used == nullptr || entry->last_use < least_recently_used->last_use)) {
+        least_recently_used = entry.get();
+      }
+    }
+    if (least_recently_used == nullptr) {
+      // everything loaded is in use, the budget is exceeded until the running nodes complete
+      return;
+    }
+    Release(*least_recently_used);
+  }
+}
+
+void LazyInitializers::Prefetch(const GraphEntries& graph_entries, NodeIndex node_index) {
+  if (prefetch_distance_ == 0) {
+    return;
+  }
+
+  bool queued = false;
+  const size_t position = graph_entries.consumer_position.at(node_index);
+  const size_t end = std::min(graph_entries.consumers.size(), position + 1 + prefetch_distance_);
+  for (size_t i = position + 1; i < end; ++i) {
+    for (Entry* entry : graph_entries.by_node.at(graph_entries.consumers[i])) {
+      if (entry->state == State::kReleased) {
+        entry->state = State::kQueued;
+        prefetch_queue_.push_back(entry);
+        queued = true;
+      }
+    }
+  }
+
+  if (queued) {
+    prefetch_cv_.notify_one();
+  }
+}
+
+void LazyInitializers::PrefetchLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    prefetch_cv_.wait(lock, [this]() { return shutdown_ || !prefetch_queue_.empty(); });
+    if (shutdown_) {
+      return;
+    }
+
+    Entry& entry = *prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    entry.state = State::kLoading;
+
+    // the other entries may be pinned, released or queued while this one is loaded
+    lock.unlock();
+    OrtValue loaded;
+    const Status status = LoadInto(entry, loaded);
+    lock.lock();
+
+    if (status.IsOK()) {
+      // prefetched initializers are the most recently used so that the budget releases the ones already used first
+      SetLoaded(entry, std::move(loaded));
+      entry.last_use = ++use_count_;
+      ReleaseOverBudget();
+    } else {
+      // the consumer loads it again and reports the error
+      LOGS(session_state_.Logger(), WARNING) << "Failed to prefetch lazy initializer " << entry.tensor_proto.name()
+                                             << ": " << status.ErrorMessage();
+      entry.state = State::kReleased;
+    }
+    loaded_cv_.notify_all();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+class OrtValueNameIdxMap;
+class SessionState;
+
+/**
+ * Initializers with external data that are loaded on first use instead of when the session is initialized, enabled
+ * with kOrtSessionOptionsLazyInitializerLoading. It is owned by the main graph SessionState and shared with the
+ * subgraphs, which are identified by their GraphViewer.
+ *
+ * The SessionState of a lazy initializer holds a placeholder tensor without data. Before a node runs, the lazy
+ * initializers it consumes (including the implicit inputs of control flow nodes) are loaded into their placeholders
+ * and pinned. The initializers are loaded through the IExternalDataLoader of their device if one is registered,
+ * memory mapped on CPU otherwise. Once the node completes they are unpinned and, if the CPU initializers exceed the
+ * memory budget, the least recently used unpinned ones are released. Initializers on other devices are kept once
+ * loaded as the kernels consuming them may still be running on a device stream.
+ *
+ * With a prefetch distance set with kOrtSessionOptionsLazyInitializersPrefetchDistance, the initializers are streamed:
+ * when a node runs, the lazy initializers of the next consumers of lazy initializers in the execution order, e.g. the
+ * next layers of the model, are loaded on a background thread while it executes. Together with the memory budget
+ * only the weights of a few layers are then loaded at any time.
+ *
+ * Lazy initializers are not constant initializers of the kernels: they are not pre-packed and the kernels read them
+ * as regular inputs.
+ */
+class LazyInitializers {
+ public:
+  LazyInitializers(const SessionState& session_state, size_t memory_budget, size_t min_size_in_bytes,
+                   size_t prefetch_distance);
+  ~LazyInitializers();
+
+  // Returns true if the initializer has external data in a file and is large enough to be loaded lazily.
+  bool IsCandidate(const ONNX_NAMESPACE::TensorProto& tensor_proto) const;
+
+  // Adds a lazy initializer of the graph located on device. The placeholder value is returned in ort_value, to be
+  // saved as the initialized tensor.
+  Status Add(const GraphViewer& graph_viewer, const std::basic_string<PATH_CHAR_TYPE>& graph_location,
+             int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtDevice& device,
+             OrtValue& ort_value);
+
+  // Records the nodes of the graph consuming its lazy initializers, in execution order. Called once all of them are
+  // added.
+  void AddConsumers(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                    ExecutionOrder execution_order);
+
+  // Loads and pins the lazy initializers consumed by the node, and starts prefetching those of the next consumers.
+  Status Pin(const GraphViewer& graph_viewer, NodeIndex node_index);
+
+  // Unpins the lazy initializers consumed by the node and releases the least recently used ones over the budget.
+  void Unpin(const GraphViewer& graph_viewer, NodeIndex node_index);
+
+  // Number of bytes of the lazy initializers currently loaded on CPU.
+  size_t LoadedSizeInBytes() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LazyInitializers);
+
+  enum class State {
+    kReleased,
+    kQueued,   // in prefetch_queue_
+    kLoading,  // being loaded by the prefetch thread
+    kLoaded,
+  };
+
+  struct Entry {
+    ONNX_NAMESPACE::TensorProto tensor_proto;  // copy, the Graph may remove its initializers
+    std::basic_string<PATH_CHAR_TYPE> graph_location;
+    AllocatorPtr allocator;
+    size_t size_in_bytes = 0;
+    Tensor* placeholder = nullptr;  // owned by the OrtValue saved in the SessionState
+    OrtValue loaded;                // owns the data pointed to by placeholder when loaded
+    State state = State::kReleased;
+    size_t pin_count = 0;
+    uint64_t last_use = 0;
+  };
+
+  // the lazy initializers of a graph
+  struct GraphEntries {
+    InlinedHashMap<int, Entry*> by_ort_value_index;
+    // the lazy initializers consumed by each node, and the nodes consuming some in execution order
+    InlinedHashMap<NodeIndex, InlinedVector<Entry*>> by_node;
+    InlinedHashMap<NodeIndex, size_t> consumer_position;
+    std::vector<NodeIndex> consumers;
+  };
+
+  Status LoadInto(const Entry& entry, OrtValue& loaded) const;
+  // Makes the loaded value the data of the placeholder. Requires mutex_.
+  void SetLoaded(Entry& entry, OrtValue loaded);
+  void Release(Entry& entry);
+  void ReleaseOverBudget();
+  void Prefetch(const GraphEntries& graph_entries, NodeIndex node_index);
+  void PrefetchLoop();
+
+  const SessionState& session_state_;
+  const size_t memory_budget_;  // 0 means unbounded
+  const size_t min_size_in_bytes_;
+  const size_t prefetch_distance_;  // 0 means no prefetching
+
+  std::vector<std::unique_ptr<Entry>> entries_;
+  // only modified while the session is initialized so they can be read without the lock
+  InlinedHashMap<const GraphViewer*, GraphEntries> graph_entries_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable loaded_cv_;    // an entry loaded by the prefetch thread is kLoaded or kReleased
+  std::condition_variable prefetch_cv_;  // prefetch_queue_ is not empty or shutdown_ is set
+  std::deque<Entry*> prefetch_queue_;
+  bool shutdown_ = false;
+  size_t loaded_size_in_bytes_ = 0;
+  uint64_t use_count_ = 0;
+
+  std::thread prefetch_thread_;
+};
+
+}  // namespace onnxruntime
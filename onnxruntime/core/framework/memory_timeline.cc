@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_timeline.h"
+
+#include <sstream>
+
+#include "core/framework/bfc_arena.h"
+
+namespace onnxruntime {
+
+namespace {
+
+std::string DeviceCounterName(const OrtDevice& device) {
+  return MakeString("memory_in_use_device_", static_cast<int>(device.Type()), "_", static_cast<int>(device.MemType()),
+                    "_", device.Id());
+}
+
+}  // namespace
+
+void MemoryTimeline::StartRun() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RecordArenaSnapshots();
+}
+
+void MemoryTimeline::RecordAllocation(const void* p, size_t size, const AllocatorPtr& allocator,
+                                      const std::string& value_name, const std::string& node_name) {
+  const OrtDevice& device = allocator->Info().device;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  allocations_.insert_or_assign(p, Allocation{size, device, value_name});
+  const int64_t bytes_in_use = bytes_in_use_[device] += static_cast<int64_t>(size);
+
+  profiler_.EndTimeAndRecordEvent(profiling::MEMORY_EVENT, value_name + "_allocate", profiler_.Start(),
+                                  {{"node", node_name},
+                                   {"size", std::to_string(size)},
+                                   {"allocator", allocator->Info().name},
+                                   {"bytes_in_use", std::to_string(bytes_in_use)}});
+  RecordBytesInUse(device, bytes_in_use);
+
+  if (allocator->Info().alloc_type == OrtArenaAllocator) {
+    arenas_.try_emplace(allocator->Info().name, allocator);
+  }
+
+  if (++num_allocations_ % snapshot_interval_ == 0) {
+    RecordArenaSnapshots();
+  }
+}
+
+void MemoryTimeline::RecordFree(const void* p) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = allocations_.find(p);
+  if (it == allocations_.end()) {
+    return;
+  }
+
+  const Allocation& allocation = it->second;
+  const int64_t bytes_in_use = bytes_in_use_[allocation.device] -= static_cast<int64_t>(allocation.size);
+  profiler_.EndTimeAndRecordEvent(profiling::MEMORY_EVENT, allocation.value_name + "_free", profiler_.Start(),
+                                  {{"size", std::to_string(allocation.size)},
+                                   {"bytes_in_use", std::to_string(bytes_in_use)}});
+  RecordBytesInUse(allocation.device, bytes_in_use);
+  allocations_.erase(it);
+}
+
+void MemoryTimeline::RecordBytesInUse(const OrtDevice& device, int64_t bytes_in_use) {
+  profiler_.RecordCounterEvent(profiling::MEMORY_EVENT, DeviceCounterName(device),
+                               {{"bytes", std::to_string(bytes_in_use)}});
+}
+
+void MemoryTimeline::RecordArenaSnapshots() {
+  for (const auto& [name, allocator] : arenas_) {
+    const auto stats = static_cast<BFCArena*>(allocator.get())->GetFragmentationStats();
+
+    std::ostringstream bins;
+    bins << "[";
+    for (size_t i = 0; i < stats.bins.size(); ++i) {
+      const auto& bin = stats.bins[i];
+      bins << (i > 0 ? ", " : "") << "{\"bin_size\": " << bin.bin_size
+           << ", \"chunks_in_use\": " << bin.chunks_in_use << ", \"bytes_in_use\": " << bin.bytes_in_use
+           << ", \"free_chunks\": " << bin.free_chunks << ", \"free_bytes\": " << bin.free_bytes << "}";
+    }
+    bins << "]";
+
+    profiler_.EndTimeAndRecordEvent(profiling::MEMORY_EVENT, name + "_arena_snapshot", profiler_.Start(),
+                                    {{"bytes_in_use", std::to_string(stats.bytes_in_use)},
+                                     {"free_bytes", std::to_string(stats.free_bytes)},
+                                     {"largest_free_chunk", std::to_string(stats.largest_free_chunk)},
+                                     {"bins", bins.str()}});
+    profiler_.RecordCounterEvent(profiling::MEMORY_EVENT, name + "_arena_fragmentation",
+                                 {{"free_bytes", std::to_string(stats.free_bytes)},
+                                  {"largest_free_chunk", std::to_string(stats.largest_free_chunk)}});
+  }
+}
+
+}  // namespace onnxruntime
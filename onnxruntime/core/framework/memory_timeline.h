@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/profiler.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+/**
+ * Records the memory timeline of the runs of a session in its profile, see kOrtSessionOptionsProfilingMemoryTimeline.
+ *
+ * Each allocation and free of a tensor by the execution frames is recorded as a "Memory" event tagged with the value
+ * and the node producing it, and as a counter event of the bytes allocated on the device by the runs, which is
+ * shown as a counter track by the Chrome trace viewer. The fragmentation of the arenas that served the allocations is
+ * recorded every snapshot_interval allocations and when StartRun is called.
+ *
+ * The execution frames of the concurrent runs and of the subgraphs of a session share its timeline.
+ */
+class MemoryTimeline {
+ public:
+  MemoryTimeline(profiling::Profiler& profiler, size_t snapshot_interval)
+      : profiler_(profiler), snapshot_interval_(snapshot_interval) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryTimeline);
+
+  // The timeline is recorded while profiling.
+  bool IsEnabled() const { return profiler_.IsEnabled(); }
+
+  void StartRun();
+
+  // Records the allocation of size bytes at p from allocator, for the value produced by node_name.
+  void RecordAllocation(const void* p, size_t size, const AllocatorPtr& allocator, const std::string& value_name,
+                        const std::string& node_name);
+
+  // Records the free of p, if its allocation was recorded.
+  void RecordFree(const void* p);
+
+ private:
+  struct Allocation {
+    size_t size;
+    OrtDevice device;
+    std::string value_name;
+  };
+
+  void RecordBytesInUse(const OrtDevice& device, int64_t bytes_in_use);
+  // Records a snapshot of the fragmentation of the arenas. mutex_ must be held.
+  void RecordArenaSnapshots();
+
+  profiling::Profiler& profiler_;
+  const size_t snapshot_interval_;
+
+  std::mutex mutex_;
+  std::unordered_map<const void*, Allocation> allocations_;
+  std::map<OrtDevice, int64_t> bytes_in_use_;
+  // the arenas that served the recorded allocations, by name
+  std::map<std::string, AllocatorPtr> arenas_;
+  size_t num_allocations_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_arena.h"
+
+#include <algorithm>
+
+#include "core/framework/allocator_stats.h"
+
+namespace onnxruntime {
+
+namespace {
+OrtMemoryInfo NumaArenaInfo(const std::vector<AllocatorPtr>& node_arenas) {
+  ORT_ENFORCE(!node_arenas.empty(), "NumaArena requires at least one node arena.");
+  const OrtMemoryInfo& info = node_arenas.front()->Info();
+  return OrtMemoryInfo(info.name, OrtAllocatorType::OrtDeviceAllocator, info.device, info.id, info.mem_type);
+}
+}  // namespace
+
+NumaArena::NumaArena(std::vector<AllocatorPtr> node_arenas, std::function<int()> get_current_node)
+    : IAllocator(NumaArenaInfo(node_arenas)),
+      node_arenas_(std::move(node_arenas)),
+      get_current_node_(std::move(get_current_node)) {
+}
+
+size_t NumaArena::CurrentNode() const {
+  const int node = get_current_node_ ? get_current_node_() : -1;
+  return node >= 0 && static_cast<size_t>(node) < node_arenas_.size() ? static_cast<size_t>(node) : 0;
+}
+
+void* NumaArena::Track(void* p, size_t node) {
+  if (p != nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    allocation_nodes_[p] = node;
+  }
+  return p;
+}
+
+void* NumaArena::Alloc(size_t size) {
+  const size_t node = CurrentNode();
+  return Track(node_arenas_[node]->Alloc(size), node);
+}
+
+void* NumaArena::Reserve(size_t size) {
+  const size_t node = CurrentNode();
+  return Track(node_arenas_[node]->Reserve(size), node);
+}
+
+void NumaArena::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+  size_t node;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = allocation_nodes_.find(p);
+    ORT_ENFORCE(it != allocation_nodes_.end(), "Freeing a pointer that was not allocated by this NumaArena.");
+    node = it->second;
+    allocation_nodes_.erase(it);
+  }
+  node_arenas_[node]->Free(p);
+}
+
+void NumaArena::GetStats(AllocatorStats* stats) {
+  stats->Clear();
+  for (auto& arena : node_arenas_) {
+    AllocatorStats node_stats;
+    arena->GetStats(&node_stats);
+    stats->num_allocs += node_stats.num_allocs;
+    stats->num_reserves += node_stats.num_reserves;
+    stats->num_arena_extensions += node_stats.num_arena_extensions;
+    stats->num_arena_shrinkages += node_stats.num_arena_shrinkages;
+    stats->bytes_in_use += node_stats.bytes_in_use;
+    stats->total_allocated_bytes += node_stats.total_allocated_bytes;
+    // the arenas reach their maximums at different times, so this is an upper bound
+    stats->max_bytes_in_use += node_stats.max_bytes_in_use;
+    stats->max_alloc_size = std::max(stats->max_alloc_size, node_stats.max_alloc_size);
+    stats->bytes_limit += node_stats.bytes_limit;
+    stats->num_chunk_cache_hits += node_stats.num_chunk_cache_hits;
+    stats->num_chunk_cache_misses += node_stats.num_chunk_cache_misses;
+    stats->large_page_bytes += node_stats.large_page_bytes;
+    stats->num_large_page_fallbacks += node_stats.num_large_page_fallbacks;
+  }
+}
+
+}  // namespace onnxruntime
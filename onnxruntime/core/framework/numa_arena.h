@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// An allocator with one arena per NUMA node. Allocations are made from the arena of the node of the calling thread,
+// so with the default first-touch policy of the OS the memory of each arena ends up on its node.
+// The memory can be freed from any thread.
+//
+// The allocator reports itself as an OrtDeviceAllocator as it is not a BFCArena, so the arena specific features
+// (stream aware allocations, shrinking) are not available.
+class NumaArena : public IAllocator {
+ public:
+  // node_arenas: the arena of each NUMA node.
+  // get_current_node: returns the NUMA node of the calling thread, as an index in node_arenas, or -1 if it is unknown.
+  // Allocations made from threads of unknown nodes use the first arena.
+  NumaArena(std::vector<AllocatorPtr> node_arenas, std::function<int()> get_current_node);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void* Reserve(size_t size) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  size_t NumNodes() const noexcept { return node_arenas_.size(); }
+
+ private:
+  size_t CurrentNode() const;
+  void* Track(void* p, size_t node);
+
+  std::vector<AllocatorPtr> node_arenas_;
+  std::function<int()> get_current_node_;
+
+  std::mutex mutex_;
+  // node of each allocation
+  std::unordered_map<void*, size_t> allocation_nodes_;
+};
+
+}  // namespace onnxruntime
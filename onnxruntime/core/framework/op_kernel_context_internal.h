@@ -23,7 +23,7 @@ class OpKernelContextInternal : public OpKernelContext {
                                    const logging::Logger& logger,
                                    const bool& terminate_flag,
                                    Stream* stream)
-      : OpKernelContext(&frame, &kernel, stream, session_state.GetThreadPool(), logger),
+      : OpKernelContext(&frame, &kernel, stream, session_state.GetThreadPool(kernel.Node().Index()), logger),
         session_state_(session_state),
         terminate_flag_(terminate_flag) {
     const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <stdint.h>
 #include <utility>
@@ -84,4 +85,61 @@ class PhiloxGenerator {
   uint64_t offset_;
 };
 
+/**
+ * Philox4x32-10 counter-based random engine for the CPU, compatible with the CUDA Philox_4x32_10 generator for the
+ * same key and counter.  Each counter value is mapped to four independent 32-bit random values without any state,
+ * so a range of counters reserved with PhiloxGenerator::NextPhiloxSeeds() can be generated in any order, or in
+ * parallel, with the same result.
+ */
+class PhiloxEngine {
+ public:
+  using ResultType = std::array<uint32_t, 4>;
+
+  explicit PhiloxEngine(uint64_t seed)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+  /**
+   * Gets the four random values of the specified counter.
+   */
+  ResultType operator()(uint64_t counter) const {
+    ResultType state{static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0};
+    uint32_t key0 = key_[0];
+    uint32_t key1 = key_[1];
+
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * state[0];
+      const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * state[2];
+      state = {static_cast<uint32_t>(product1 >> 32) ^ state[1] ^ key0, static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ state[3] ^ key1, static_cast<uint32_t>(product0)};
+      key0 += kWeyl0;
+      key1 += kWeyl1;
+    }
+
+    return state;
+  }
+
+  /**
+   * Converts a random value to a float uniformly distributed in [0, 1).
+   */
+  static float ToUniformFloat(uint32_t value) {
+    return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /**
+   * Converts a pair of random values to a double uniformly distributed in [0, 1).
+   */
+  static double ToUniformDouble(uint32_t value0, uint32_t value1) {
+    const uint64_t value = (static_cast<uint64_t>(value0) << 32) | value1;
+    return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+ private:
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  uint32_t key_[2];
+};
+
 }  // namespace onnxruntime
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/scratch_allocator.h"
+
+#include <utility>
+
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+namespace {
+// the memory info of the fallback allocator as a device allocator, since the scratch allocator is not a BFCArena
+OrtMemoryInfo ScratchMemoryInfo(const OrtMemoryInfo& fallback_info) {
+  OrtMemoryInfo info = fallback_info;
+  info.alloc_type = OrtDeviceAllocator;
+  return info;
+}
+
+void UpdateMax(std::atomic<size_t>& max_value, size_t value) {
+  size_t current = max_value.load(std::memory_order_relaxed);
+  while (current < value && !max_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+ScratchAllocator::ScratchAllocator(AllocatorPtr fallback, size_t capacity)
+    : IAllocator(ScratchMemoryInfo(fallback->Info())),
+      fallback_(std::move(fallback)),
+      capacity_(capacity),
+      alignment_(MlasGetPreferredBufferAlignment()) {
+  ORT_ENFORCE(capacity_ <= kOffsetMask, "Scratch block too large: ", capacity_);
+  if (capacity_ > 0) {
+    // the kernels may read past the end of the last buffer, as with AllocatorDefaultAlloc
+    block_ = static_cast<char*>(fallback_->Alloc(capacity_ + MLAS_SYMM_QGEMM_BUF_OVERRUN));
+    if (block_ == nullptr) {
+      capacity_ = 0;
+    }
+  }
+}
+
+ScratchAllocator::~ScratchAllocator() {
+  if (block_ != nullptr) {
+    fallback_->Free(block_);
+  }
+}
+
+void* ScratchAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+
+  const size_t aligned_size = (size + MLAS_SYMM_QGEMM_BUF_OVERRUN + alignment_ - 1) / alignment_ * alignment_;
+  uint64_t state = state_.load(std::memory_order_relaxed);
+  for (;;) {
+    const uint64_t num_live_buffers = state >> kOffsetBits;
+    const size_t offset = static_cast<size_t>(state & kOffsetMask);
+    const size_t end = offset + aligned_size;
+    if (end > capacity_ || num_live_buffers == kMaxLiveBuffers) {
+      UpdateMax(high_water_mark_, end);
+      return fallback_->Alloc(size);
+    }
+
+    const uint64_t desired = ((num_live_buffers + 1) << kOffsetBits) | end;
+    if (state_.compare_exchange_weak(state, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+      UpdateMax(high_water_mark_, end);
+      return block_ + offset;
+    }
+  }
+}
+
+void ScratchAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+  if (!InBlock(p)) {
+    fallback_->Free(p);
+    return;
+  }
+
+  uint64_t state = state_.load(std::memory_order_relaxed);
+  for (;;) {
+    // the block is reset when its last live buffer is freed
+    const uint64_t desired = (state >> kOffsetBits) == 1 ? 0 : state - (uint64_t{1} << kOffsetBits);
+    if (state_.compare_exchange_weak(state, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+void ScratchAllocator::GetStats(AllocatorStats* stats) {
+  stats->Clear();
+  stats->num_allocs = num_allocs_.load(std::memory_order_relaxed);
+  stats->bytes_in_use = static_cast<int64_t>(state_.load(std::memory_order_relaxed) & kOffsetMask);
+  stats->total_allocated_bytes = static_cast<int64_t>(capacity_);
+  stats->max_bytes_in_use = static_cast<int64_t>(HighWaterMark());
+  stats->bytes_limit = static_cast<int64_t>(capacity_);
+}
+
+}  // namespace onnxruntime
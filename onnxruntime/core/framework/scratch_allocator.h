@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// A linear (bump) allocator for the temporary buffers of the kernels of a run, see
+// kOrtSessionOptionsUseScratchAllocator. The buffers are carved out of one block allocated from the fallback
+// allocator, without locks: an allocation is an atomic increment of the offset of the next buffer, and a free an
+// atomic decrement of the number of live buffers. When the last live buffer is freed, e.g. at the end of each node,
+// the whole block is available again.
+//
+// The allocations that do not fit in the block are made from the fallback allocator. HighWaterMark() is the size
+// the block would have needed for all of them, so that the next block can be sized from previous runs.
+class ScratchAllocator : public IAllocator {
+ public:
+  // capacity: size of the block, 0 for none, in which case all the allocations are made from `fallback`.
+  ScratchAllocator(AllocatorPtr fallback, size_t capacity);
+  ~ScratchAllocator() override;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScratchAllocator);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  size_t Capacity() const noexcept { return capacity_; }
+
+  // Largest offset reached, including the allocations made from the fallback allocator.
+  size_t HighWaterMark() const noexcept { return high_water_mark_.load(std::memory_order_relaxed); }
+
+ private:
+  // the state packs the number of live buffers in the high bits and the offset of the next buffer in the low bits,
+  // so that both are updated by a single compare and swap
+  static constexpr int kOffsetBits = 48;
+  static constexpr uint64_t kOffsetMask = (uint64_t{1} << kOffsetBits) - 1;
+  static constexpr uint64_t kMaxLiveBuffers = (uint64_t{1} << (64 - kOffsetBits)) - 1;
+
+  bool InBlock(const void* p) const noexcept {
+    return block_ != nullptr && p >= block_ && p < block_ + capacity_;
+  }
+
+  AllocatorPtr fallback_;
+  size_t capacity_;
+  char* block_ = nullptr;
+  const size_t alignment_;
+
+  std::atomic<uint64_t> state_{0};
+  std::atomic<size_t> high_water_mark_{0};
+  std::atomic<int64_t> num_allocs_{0};
+};
+
+}  // namespace onnxruntime
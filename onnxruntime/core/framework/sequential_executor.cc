@@ -3,7 +3,10 @@
 
 #include "core/framework/sequential_executor.h"
 
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
@@ -11,11 +14,14 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/lazy_initializers.h"
 #include "core/framework/resource_accountant.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
+#include "core/platform/trace_points.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
@@ -156,7 +162,8 @@ class SessionScope {
  public:
   friend class KernelScope;
   SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+      : session_state_(session_state),
+        sampling_profiler_(session_state.GetSamplingProfiler())
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -181,6 +188,10 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    if (sampling_profiler_ != nullptr && !sampling_profiler_->ShouldSampleRun()) {
+      sampling_profiler_ = nullptr;
+    }
+
     auto& logger = session_state_.Logger();
     VLOGS(logger, 0) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -225,6 +236,10 @@ class SessionScope {
     }
 #endif
 
+    if (sampling_profiler_ != nullptr) {
+      sampling_profiler_->EndSampledRun();
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
@@ -255,6 +270,8 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // The sampling profiler when this run is sampled, nullptr otherwise.
+  profiling::SamplingProfiler* sampling_profiler_;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
 #endif
@@ -344,6 +361,10 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (session_scope_.sampling_profiler_ != nullptr) {
+      sampled_begin_time_ = std::chrono::steady_clock::now();
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -353,36 +374,61 @@ class KernelScope {
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      hardware_counters_ = session_state_.GetHardwareCounters();
+      if (hardware_counters_ != nullptr) {
+        hardware_counters_begin_ = hardware_counters_->Read();
+      }
     }
+
+    ORT_TRACE_NODE_START(kernel_.Node().Index(), kernel_.Node().OpType().c_str(), kernel_.Node().Name().c_str());
   }
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelScope);
 
   ~KernelScope() {
+    ORT_TRACE_NODE_END(kernel_.Node().Index(), kernel_.Node().OpType().c_str());
+
 #ifdef ENABLE_NVTX_PROFILE
     node_compute_range_.End();
 #endif
 
+    if (session_scope_.sampling_profiler_ != nullptr) {
+      session_scope_.sampling_profiler_->RecordNode(
+          kernel_.Node().Index(),
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sampled_begin_time_));
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
+      // read the counters first to leave the profiling overhead out
+      profiling::HardwareCounterValues hardware_counters;
+      if (hardware_counters_ != nullptr) {
+        hardware_counters = hardware_counters_->Read() - hardware_counters_begin_;
+      }
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
+      // Log additional operation args / info.
+      std::unordered_map<std::string, std::string> event_args{
+          {"op_name", kernel_.KernelDef().OpName()},
+          {"provider", kernel_.KernelDef().Provider()},
+          {"node_index", std::to_string(kernel_.Node().Index())},
+          {"activation_size", std::to_string(input_activation_sizes_)},
+          {"parameter_size", std::to_string(input_parameter_sizes_)},
+          {"output_size", std::to_string(total_output_sizes_)},
+          {"input_type_shape", input_type_shape_},
+          {"output_type_shape", output_type_shape_},
+          {"thread_scheduling_stats",
+           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
+      };
+      if (hardware_counters_ != nullptr) {
+        hardware_counters_->RecordOpType(kernel_.Node().OpType(), hardware_counters);
+        event_args.emplace("hardware_counters", hardware_counters.ToJson(hardware_counters_->HasCacheCounters(),
+                                                                           hardware_counters_->HasTlbCounter()));
+      }
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_kernel_time",
                                      kernel_begin_time_,
-                                     // Log additional operation args / info.
-                                     {
-                                         {"op_name", kernel_.KernelDef().OpName()},
-                                         {"provider", kernel_.KernelDef().Provider()},
-                                         {"node_index", std::to_string(kernel_.Node().Index())},
-                                         {"activation_size", std::to_string(input_activation_sizes_)},
-                                         {"parameter_size", std::to_string(input_parameter_sizes_)},
-                                         {"output_size", std::to_string(total_output_sizes_)},
-                                         {"input_type_shape", input_type_shape_},
-                                         {"output_type_shape", output_type_shape_},
-                                         {"thread_scheduling_stats",
-                                          concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
-                                     });
+                                     std::move(event_args));
     }
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
@@ -406,6 +452,9 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  std::chrono::steady_clock::time_point sampled_begin_time_;
+  profiling::HardwareCounters* hardware_counters_ = nullptr;
+  profiling::HardwareCounterValues hardware_counters_begin_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -445,6 +494,19 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+
+  // the lazy initializers consumed by the node are loaded and can't be released until it completes
+  LazyInitializers* lazy_initializers = ctx.GetSessionState().GetLazyInitializers();
+  const GraphViewer& graph_viewer = ctx.GetSessionState().GetGraphViewer();
+  if (lazy_initializers != nullptr) {
+    ORT_RETURN_IF_ERROR(lazy_initializers->Pin(graph_viewer, idx));
+  }
+  const auto unpin_lazy_initializers = gsl::finally([lazy_initializers, &graph_viewer, idx]() {
+    if (lazy_initializers != nullptr) {
+      lazy_initializers->Unpin(graph_viewer, idx);
+    }
+  });
+
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -578,6 +640,134 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
   return Status::OK();
 }
 
+namespace {
+// State shared by the tasks of a dynamically scheduled run. See ExecuteNodesDynamically.
+struct DynamicScheduleState {
+  StreamExecutionContext& ctx;
+  const GraphViewer& graph_viewer;
+  const SequentialExecutionPlan& plan;
+  concurrency::ThreadPool* tp;
+  const bool& terminate_flag;
+  SessionScope& session_scope;
+  // number of input edges of each node whose producer has not completed yet
+  std::unique_ptr<std::atomic_int[]> pending_inputs;
+};
+
+// Runs node_index and then, on the same thread, one of the successors it made ready. Any other successor that
+// became ready is scheduled on the thread pool. As the thread pool pushes work scheduled from a worker onto that
+// worker's own queue, the successors stay local unless an idle worker steals them.
+void RunNodeAndReadySuccessors(DynamicScheduleState& state, NodeIndex node_index) {
+  auto& ctx = state.ctx;
+  for (;;) {
+    if (!ctx.TaskStatus().IsOK()) {
+      // already in bad status, terminate it
+      ctx.CompleteTask();
+      return;
+    }
+    if (state.terminate_flag) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status_made);
+      ctx.CompleteTask();
+      return;
+    }
+
+    Status status;
+    ORT_TRY {
+      status = ExecuteKernel(ctx, node_index, state.plan.node_stream_map_[node_index], state.terminate_flag,
+                             state.session_scope);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      ctx.CompleteTask();
+      return;
+    }
+
+    const Node* node = state.graph_viewer.GetNode(node_index);
+    std::optional<NodeIndex> next;
+    for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+      const NodeIndex successor = it->GetNode().Index();
+      if (state.graph_viewer.GetNode(successor) == nullptr ||
+          state.pending_inputs[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        continue;
+      }
+      if (!next.has_value()) {
+        next = successor;
+      } else {
+        ctx.AddTask();
+        concurrency::ThreadPool::Schedule(state.tp, [&state, successor]() {
+          RunNodeAndReadySuccessors(state, successor);
+        });
+      }
+    }
+
+    if (!next.has_value()) {
+      ctx.CompleteTask();
+      return;
+    }
+    node_index = *next;
+  }
+}
+
+// Number of input edges of node coming from nodes of graph_viewer.
+int CountProducersInGraph(const GraphViewer& graph_viewer, const Node& node) {
+  int num_producers = 0;
+  for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+    if (graph_viewer.GetNode(it->GetNode().Index()) != nullptr) {
+      ++num_producers;
+    }
+  }
+  return num_producers;
+}
+
+// Returns true if the nodes of the plan can be scheduled dynamically instead of running the logic streams.
+// This requires a CPU only plan: nodes are then only ordered by their data dependencies, which is safe as the
+// planner does not reuse buffers in parallel execution mode and values are released by reference count.
+bool UseDynamicScheduling(const SessionState& session_state, const concurrency::ThreadPool* tp,
+                          bool only_execute_path_to_fetches) {
+  const auto& session_options = session_state.GetSessionOptions();
+  if (tp == nullptr || only_execute_path_to_fetches ||
+      session_options.execution_mode != ExecutionMode::ORT_PARALLEL ||
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicInterOpScheduling, "0") != "1") {
+    return false;
+  }
+
+  for (const auto& logic_stream : session_state.GetExecutionPlan()->execution_plan) {
+    if (!logic_stream->steps_.empty() && logic_stream->device_.Type() != OrtDevice::CPU) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Schedules every node as soon as all of its producers have completed, using per-node readiness counters.
+Status ExecuteNodesDynamically(const SessionState& session_state, StreamExecutionContext& ctx,
+                               concurrency::ThreadPool* tp, const bool& terminate_flag,
+                               SessionScope& session_scope, gsl::span<const NodeIndex> ready_nodes) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  DynamicScheduleState state{ctx, graph_viewer, *session_state.GetExecutionPlan(), tp, terminate_flag,
+                             session_scope, std::make_unique<std::atomic_int[]>(graph_viewer.MaxNodeIndex())};
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    state.pending_inputs[node.Index()].store(CountProducersInGraph(graph_viewer, node), std::memory_order_relaxed);
+  }
+
+  // the execution context is created with one task per ready node
+  for (NodeIndex node_index : ready_nodes) {
+    concurrency::ThreadPool::Schedule(tp, [&state, node_index]() {
+      RunNodeAndReadySuccessors(state, node_index);
+    });
+  }
+
+  ctx.WaitAll();
+  return ctx.TaskStatus();
+}
+}  // namespace
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -597,6 +787,21 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
       valid_streams++;
   }
 
+  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+
+  // with dynamic scheduling there is one initial task per node without producers instead of one per stream
+  const bool dynamic_scheduling = UseDynamicScheduling(session_state, tp, only_execute_path_to_fetches);
+  InlinedVector<NodeIndex> ready_nodes;
+  if (dynamic_scheduling) {
+    const auto& graph_viewer = session_state.GetGraphViewer();
+    for (const auto& node : graph_viewer.Nodes()) {
+      if (CountProducersInGraph(graph_viewer, node) == 0) {
+        ready_nodes.push_back(node.Index());
+      }
+    }
+    valid_streams = narrow<int32_t>(ready_nodes.size());
+  }
+
   // prepare the execution context, notifications got initialized.
 #ifdef ORT_ENABLE_STREAM
   StreamExecutionContext ctx(session_state,
@@ -610,7 +815,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              fetches,
                              fetch_allocators,
                              logger,
-                             single_thread_mode);
+                             single_thread_mode,
+                             session_state.AcquireExecutionFrame(feeds));
 #else
   StreamExecutionContext ctx(session_state,
                              valid_streams,
@@ -620,7 +826,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              fetches,
                              fetch_allocators,
                              logger,
-                             single_thread_mode);
+                             single_thread_mode,
+                             session_state.AcquireExecutionFrame(feeds));
 #endif
 #ifdef ENABLE_TRAINING
   if (only_execute_path_to_fetches) {
@@ -633,9 +840,7 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
-
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+  for (size_t i = 0; !dynamic_scheduling && i < execution_plan->execution_plan.size(); ++i) {
     if (execution_plan->execution_plan[i]->steps_.empty()) {
       // execution context is initialized with number of valid streams
       // for invalid stream (0 steps), it doesn't count in number of tasks
@@ -648,6 +853,10 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     }
   }
 
+  if (dynamic_scheduling) {
+    ORT_RETURN_IF_ERROR(ExecuteNodesDynamically(session_state, ctx, tp, terminate_flag, session_scope, ready_nodes));
+  }
+
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
@@ -667,6 +876,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     }
   }
 
+  // all the tasks completed so the frame can be used by another run. failed runs don't recycle it.
+  session_state.RecycleExecutionFrame(feeds, ctx.ReleaseExecutionFrame());
   return Status::OK();
 }
 
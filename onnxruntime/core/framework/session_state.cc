@@ -3,10 +3,13 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <mutex>
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/path_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
@@ -14,6 +17,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/session_state_snapshot.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
@@ -90,6 +94,22 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  const std::string mem_patterns_cache_capacity =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternCacheCapacity, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(mem_patterns_cache_capacity, mem_patterns_cache_capacity_),
+              "Invalid value for ", kOrtSessionOptionsMemoryPatternCacheCapacity, ": ", mem_patterns_cache_capacity);
+  use_scratch_allocator_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsUseScratchAllocator, "0") == "1";
+  if (sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPreforkSafe, "0") == "1") {
+    prepacked_weights_cpu_allocator_ = std::make_shared<CPUAllocator>();
+  }
+#if defined(ORT_MINIMAL_BUILD) || !defined(ORT_MEMORY_PROFILE)
+  // the memory profiler reads the statistics of a frame after its run, so frames are not pooled when it is enabled
+  const std::string execution_frame_pool_size =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsExecutionFramePoolSize, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(execution_frame_pool_size, execution_frame_pool_size_),
+              "Invalid value for ", kOrtSessionOptionsExecutionFramePoolSize, ": ", execution_frame_pool_size);
+#endif
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -405,222 +425,296 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    concurrency::ThreadPool* thread_pool) {
+  // Nodes are pre-packed independently of each other, so when a thread pool is provided they are spread over it.
+  // A node's inputs are always pre-packed in order on a single thread as kernels may depend on the pre-packed state
+  // of a previous input. Only the PrePack() calls run concurrently; the lookups and updates of the shared containers
+  // and counters are done under prepack_mutex. Constant initializers that are no longer needed are released once all
+  // the nodes are done.
+  std::mutex prepack_mutex;
+  InlinedVector<std::pair<SessionState*, int>> initializers_to_release;
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &prepack_mutex, &initializers_to_release](
+                                        const Node& node,
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
+    std::unique_lock<std::mutex> lock(prepack_mutex);
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        auto* prepacked_for_graph = &graph_.GetPrepacked();
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            if (constant_initialized_tensors.count(ort_value_idx)) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensors.at(ort_value_idx).Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  node.GetExecutionProviderType() == kCpuExecutionProvider) {
+                // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+                // because other static properties of the node like node attributes could play a role in the
+                // pre-packed weights' contents.
+                lock.unlock();
+                const auto prepack_start = profiling::InitializationStats::Clock::now();
+                Status pre_pack_status = kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                         is_packed,
+                                                         &weights_to_be_filled_in);
+                if (auto* initialization_stats = GetInitializationStats(); initialization_stats != nullptr) {
+                  initialization_stats->AddInitializer("prepack", input_name, const_initialized_tensor.SizeInBytes(),
+                                                       profiling::InitializationStats::Clock::now() - prepack_start);
+                }
+                lock.lock();
+                ORT_RETURN_IF_ERROR(pre_pack_status);
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                  // to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                              "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
+                  const auto& op_type = node.OpType();
+
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
 
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                  const std::string prepacked_weights_container_key =
+                      GenerateKeyForPrepackedWeightsMap(op_type,
+                                                        weights_to_be_filled_in);
+
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                      prepacked_weights_container_key);
+
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                        << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+
+                    const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
                         prepacked_weights_container_key);
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_shared,
+                                                                        node.Name()));
+
+                    ++used_shared_pre_packed_weights_counter_;
+
+                    // Write references to what is stored in the shared container
+                    // and release memory mapped entries this container may have loaded from disk
+                    std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                    prepacked_weights_container_key,
+                                                                                    prepacked_shared);
+
+                  } else {
+                    // container doesn't contain the pre-packed weight - so write into it for sharing across
+                    // kernel instances
+
+                    // Check if we loaded it from disk, then put it into the shared container so
+                    // everybody can share the same memory mapped entry
+                    // the shared container takes ownership of the memory mapped entries
+
+                    // The next line replaces the existing entry with references to it
+                    // and returns the container that holds the memory mapped entries
+                    // so we can transfer it to shared container.
+                    // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                    // in saving mode and return std::nullopt
+                    auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                        input_name,
+                        prepacked_weights_container_key,
+                        weights_to_be_filled_in);
+
+                    if (prepacked_from_disk.has_value()) {
+                      weights_to_be_filled_in = std::move(*prepacked_from_disk);
+                    }
 
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                   std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(
+                          ONNXRUNTIME, FAIL,
+                          "Unable to write the provided PrePackedWeights instance into the container");
                     }
 
+                    const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                        prepacked_weights_container_key);
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
+                                                                        shared_prepacked,
                                                                         node.Name()));
                   }
                 }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
+              } else {
+                // cross session caching of pre-packed weights' turned OFF
+                // we use serialization container to share weights loaded from disk
+                // within this session. Or if the weight is not present on disk,
+                // we store the newly minted pre-packed data.
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                if (prepacked_weights_cpu_allocator_ && session_cpu_alloc->Info().device.Type() == OrtDevice::CPU) {
+                  // keep the pre-packed weights of a prefork safe session out of the pages of the arena
+                  session_cpu_alloc = prepacked_weights_cpu_allocator_;
+                }
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+                // other static properties of the node like node attributes could play a role in the pre-packed
+                // weights' contents.
+                lock.unlock();
+                const auto prepack_start = profiling::InitializationStats::Clock::now();
+                Status pre_pack_status = kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                         is_packed,
+                                                         &weights_to_be_filled_in);
+                if (auto* initialization_stats = GetInitializationStats(); initialization_stats != nullptr) {
+                  initialization_stats->AddInitializer("prepack", input_name, const_initialized_tensor.SizeInBytes(),
+                                                       profiling::InitializationStats::Clock::now() - prepack_start);
+                }
+                lock.lock();
+                ORT_RETURN_IF_ERROR(pre_pack_status);
+
+                // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+                // even though they set is_packed = true so we leave it up to them.
+                // We can change their behavior if we wish do so in a separate PR
+                // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+                // produce them.
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  const auto& op_type = node.OpType();
+                  const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                      op_type,
+                      weights_to_be_filled_in);
+
+                  // See if we can use pre-packed data from disk
+                  const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                      prepacked_weights_container_key);
+
+                  if (weights_to_use == nullptr) {
+                    // In this case pre-packed container owns the data
+                    prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in));
+                    weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                    assert(weights_to_use != nullptr);
                   }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      *weights_to_use,
+                                                                      node.Name()));
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+
+              if (is_packed) {
+                ++number_of_prepacks_counter_;
+
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor once all the nodes are pre-packed
+                  initializers_to_release.emplace_back(st, ort_value_idx);
+                }
               }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
-        }
-        input_idx++;
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+          prepacked_for_graph = &st->graph_.GetPrepacked();
+        } while (st);
+      }
+      input_idx++;
+    }
+
+    return Status::OK();
+  };
+
+  auto prepack_all_nodes = [this, &prepacked_constant_weights, thread_pool](
+                               bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    if (thread_pool == nullptr) {
+      for (auto& node : GetGraphViewer().Nodes()) {
+        ORT_RETURN_IF_ERROR(prepacked_constant_weights(node, should_cache_prepacked_weights_for_shared_initializers));
       }
+      return Status::OK();
+    }
+
+    InlinedVector<const Node*> nodes;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      nodes.push_back(&node);
     }
 
+    InlinedVector<Status> node_status(nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(nodes.size()),
+        [&](std::ptrdiff_t i) {
+          ORT_TRY {
+            node_status[i] = prepacked_constant_weights(*nodes[i],
+                                                        should_cache_prepacked_weights_for_shared_initializers);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              node_status[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+
+    for (const auto& status : node_status) {
+      ORT_RETURN_IF_ERROR(status);
+    }
     return Status::OK();
   };
 
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
+  Status status;
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    status = prepack_all_nodes(true);
   } else {
-    return prepacked_constant_weights(false);
+    status = prepack_all_nodes(false);
+  }
+
+  for (const auto& [st, ort_value_idx] : initializers_to_release) {
+    st->initialized_tensors_.erase(ort_value_idx);
+    st->constant_initialized_tensors_.erase(ort_value_idx);
   }
+
+  return status;
 }
 
-static int64_t
+static InlinedVector<int64_t>
 CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
+  InlinedVector<int64_t> key;
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    auto dims = input.Get<Tensor>().Shape().GetDims();
+    key.push_back(static_cast<int64_t>(dims.size()));
+    key.insert(key.end(), dims.begin(), dims.end());
   }
   return key;
 }
@@ -859,26 +953,51 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+SessionState::MemoryPatternsCacheEntry& SessionState::InsertMemoryPatternsCacheEntry(
+    MemoryPatternsKey key, MemoryPatternsCacheEntry entry) const {
+  if (mem_patterns_cache_capacity_ > 0 && mem_patterns_.size() >= mem_patterns_cache_capacity_ &&
+      mem_patterns_.find(key) == mem_patterns_.end()) {
+    auto lru = std::min_element(mem_patterns_.begin(), mem_patterns_.end(),
+                                [](const auto& a, const auto& b) { return a.second.last_use < b.second.last_use; });
+    mem_patterns_.erase(lru);
+  }
+
+  entry.last_use = ++mem_patterns_use_counter_;
+  auto insert = mem_patterns_.insert_or_assign(std::move(key), std::move(entry));
+  return insert.first->second;
+}
+
+// MemoryPatternGroup is cached. It only inserted upon creation and is not updated if already present.
+// The returned pointers keep the entry alive if it is evicted while in use.
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>>& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  if (symbolic_mem_pattern_) {
+    // the patterns recorded by the runs whose dimensions can't be resolved are cached as usual
+    auto patterns = GetSymbolicMemoryPatternGroup(tensor_inputs, feed_mlvalue_idxs);
+    if (patterns) {
+      mem_patterns_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      return patterns;
+    }
+  }
+
+  auto key = CalculateMemoryPatternsKey(tensor_inputs);
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
+    mem_patterns_cache_misses_.fetch_add(1, std::memory_order_relaxed);
 #ifdef ENABLE_TRAINING
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+      MemoryPatternsCacheEntry entry;
+      entry.patterns = std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns));
+      entry.inferred_shapes = std::make_shared<const InlinedHashMap<int, TensorShape>>(std::move(inferred_shapes));
+      const auto& inserted = InsertMemoryPatternsCacheEntry(std::move(key), std::move(entry));
+      out_inferred_shapes = inserted.inferred_shapes;
+      return inserted.patterns;
     }
 #else
     ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
@@ -886,11 +1005,88 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+  mem_patterns_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  it->second.last_use = ++mem_patterns_use_counter_;
+  out_inferred_shapes = it->second.inferred_shapes;
+  return it->second.patterns;
+}
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetSymbolicMemoryPatternGroup(
+    gsl::span<const OrtValue> tensor_inputs, gsl::span<const int> feed_mlvalue_idxs) const {
+  InlinedVector<int64_t> dim_values;
+  Status status = symbolic_mem_pattern_->ResolveDimParams(tensor_inputs, feed_mlvalue_idxs, dim_values);
+  if (!status.IsOK()) {
+    LOGS(logger_, VERBOSE) << "Could not resolve the symbolic dimensions of the memory pattern: "
+                           << status.ErrorMessage();
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+    if (symbolic_mem_patterns_ && symbolic_mem_pattern_dim_values_ == dim_values) {
+      return symbolic_mem_patterns_;
+    }
+  }
+
+  // generated outside of the lock, concurrent runs with other dimensions don't wait for each other
+  MemoryPatternGroup mem_patterns;
+  status = symbolic_mem_pattern_->GeneratePatterns(dim_values, mem_patterns);
+  if (!status.IsOK()) {
+    LOGS(logger_, VERBOSE) << "Could not generate the memory pattern from the symbolic shapes: "
+                           << status.ErrorMessage();
+    return nullptr;
+  }
+
+  auto patterns = std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns));
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  symbolic_mem_pattern_dim_values_ = std::move(dim_values);
+  symbolic_mem_patterns_ = patterns;
+  return patterns;
+}
+
+std::unique_ptr<ExecutionFrame> SessionState::AcquireExecutionFrame(gsl::span<const OrtValue> feeds) const {
+  if (execution_frame_pool_size_ == 0 ||
+      !std::all_of(feeds.begin(), feeds.end(), [](const OrtValue& feed) { return feed.IsTensor(); })) {
+    return nullptr;
+  }
+
+  const auto key = CalculateMemoryPatternsKey(feeds);
+  std::lock_guard<std::mutex> lock(execution_frame_pool_mutex_);
+  for (auto it = execution_frame_pool_.rbegin(); it != execution_frame_pool_.rend(); ++it) {
+    if (it->first == key) {
+      auto frame = std::move(it->second);
+      execution_frame_pool_.erase(std::next(it).base());
+      return frame;
+    }
+  }
+  return nullptr;
+}
+
+void SessionState::RecycleExecutionFrame(gsl::span<const OrtValue> feeds,
+                                         std::unique_ptr<ExecutionFrame> frame) const {
+  if (execution_frame_pool_size_ == 0 || frame == nullptr ||
+      !std::all_of(feeds.begin(), feeds.end(), [](const OrtValue& feed) { return feed.IsTensor(); })) {
+    return;
+  }
+
+  // release the outputs and any remaining value outside of the lock
+  frame->ReleaseAllMLValues();
+  auto key = CalculateMemoryPatternsKey(feeds);
+
+  std::unique_ptr<ExecutionFrame> evicted;
+  std::lock_guard<std::mutex> lock(execution_frame_pool_mutex_);
+  if (execution_frame_pool_.size() >= execution_frame_pool_size_) {
+    evicted = std::move(execution_frame_pool_.front().second);
+    execution_frame_pool_.erase(execution_frame_pool_.begin());
+  }
+  execution_frame_pool_.emplace_back(std::move(key), std::move(frame));
+}
+
+void SessionState::RecordScratchHighWaterMark(size_t high_water_mark) const noexcept {
+  size_t current = scratch_high_water_mark_.load(std::memory_order_relaxed);
+  while (current < high_water_mark &&
+         !scratch_high_water_mark_.compare_exchange_weak(current, high_water_mark, std::memory_order_relaxed)) {
   }
-  return &it->second;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -941,11 +1137,89 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  auto key = CalculateMemoryPatternsKey(tensor_inputs);
+
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  // Do not update if present, as the existing one may be in use
+  if (mem_patterns_.find(key) == mem_patterns_.end()) {
+    MemoryPatternsCacheEntry entry;
+    entry.patterns = std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns));
+    InsertMemoryPatternsCacheEntry(std::move(key), std::move(entry));
+    if (!state_snapshot_path_.empty()) {
+      SaveStateSnapshot();
+    }
+  }
+  return Status::OK();
+}
+
+void SessionState::LoadStateSnapshot(const SessionOptions& session_options) {
+  const std::string snapshot_path =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsSessionStateSnapshotFile, "");
+  if (snapshot_path.empty() || !enable_mem_pattern_) {
+    return;
+  }
+
+  state_snapshot_path_ = ToPathString(snapshot_path);
+  state_snapshot_fingerprint_ = SessionStateSnapshot::ComputeFingerprint(*graph_viewer_, ort_value_name_idx_map_,
+                                                                         *p_seq_exec_plan_);
+  SessionStateSnapshot snapshot;
+  if (!snapshot.Load(state_snapshot_path_, state_snapshot_fingerprint_)) {
+    LOGS(logger_, INFO) << "No session state snapshot matching the execution plan was found in " << snapshot_path;
+    return;
+  }
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  for (auto& entry : snapshot.memory_patterns) {
+    MemoryPatternsCacheEntry cache_entry;
+    cache_entry.patterns = std::move(entry.patterns);
+    InsertMemoryPatternsCacheEntry(std::move(entry.key), std::move(cache_entry));
+  }
+  LOGS(logger_, INFO) << "Loaded " << snapshot.memory_patterns.size()
+                      << " memory patterns from the session state snapshot " << snapshot_path;
+}
+
+void SessionState::SaveStateSnapshot() const {
+  SessionStateSnapshot snapshot;
+  snapshot.memory_patterns.reserve(mem_patterns_.size());
+  for (const auto& [key, entry] : mem_patterns_) {
+    snapshot.memory_patterns.push_back({key, entry.patterns});
+  }
+  const Status status = snapshot.Save(state_snapshot_path_, state_snapshot_fingerprint_);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Failed to save the session state snapshot: " << status.ErrorMessage();
+  }
+}
+
+Status SessionState::LoadProfileGuidedNodeTimings(const SessionOptions& session_options) {
+  const std::string profile_path =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsProfileGuidedNodeTimingsFile, "");
+  if (profile_path.empty() || thread_pool_ == nullptr) {
+    return Status::OK();
+  }
+
+  const std::string threshold =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsProfileGuidedSingleThreadThresholdUs, "20");
+  size_t threshold_us = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(threshold, threshold_us),
+                    "Invalid value for ", kOrtSessionOptionsProfileGuidedSingleThreadThresholdUs, ": ", threshold);
+
+  InlinedHashMap<std::string, double> node_kernel_times;
+  const auto status = session_state_utils::LoadAverageNodeKernelTimes(ToPathString(profile_path), node_kernel_times);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << status.ErrorMessage() << ", the profile guided node timings are ignored";
+    return Status::OK();
+  }
+
+  // Nodes that are not in the profile keep the thread pool.
+  single_threaded_nodes_.clear();
+  for (const auto& node : graph_viewer_->Nodes()) {
+    const auto entry = node_kernel_times.find(node.Name());
+    if (entry != node_kernel_times.end() && entry->second < static_cast<double>(threshold_us)) {
+      single_threaded_nodes_.insert(node.Index());
+    }
+  }
+  LOGS(logger_, INFO) << single_threaded_nodes_.size() << " of " << graph_viewer_->NumberOfNodes()
+                      << " nodes run on a single thread from the kernel times in " << profile_path;
   return Status::OK();
 }
 
@@ -1146,6 +1420,14 @@ Status SessionState::CreateSubgraphSessionState() {
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
 
+#if defined(ORT_MINIMAL_BUILD) || !defined(ORT_MEMORY_PROFILE)
+      // the body of a Loop runs once per iteration. keep its frame between the iterations so that every iteration
+      // resets it instead of creating a new one.
+      if (node.OpType() == "Loop") {
+        subgraph_session_state->execution_frame_pool_size_ = std::max<size_t>(execution_frame_pool_size_, 1);
+      }
+#endif
+
       // recurse
       ORT_RETURN_IF_ERROR(subgraph_session_state->CreateSubgraphSessionState());
 
@@ -1515,17 +1797,22 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  profiling::InitializationStats* initialization_stats = GetInitializationStats();
+  Status status;
+  {
+    profiling::InitializationStats::ScopedPhase planning_phase(initialization_stats, "allocation_planning");
+    status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                           execution_providers_, kernel_create_info_map_,
+                                           subgraphs_kernel_create_info_maps,
+                                           outer_scope_node_arg_to_location_map,
+                                           ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                           GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
+                                           partition_config_file,
+                                           Logger(),
+                                           p_seq_exec_plan_);
+  }
   ORT_RETURN_IF_ERROR(status);
 
   // Record the allocation plan
@@ -1539,8 +1826,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   // Note: For Training Prepacking should be always disabled.
   // For inference it is enabled by default, but users can choose to disable it via session options.
+  // It is disabled by default when optimizing for memory, as the packed weights may be kept next to the original ones.
+  const bool optimize_for_memory =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsGraphOptimizationObjective, "speed") ==
+      "memory";
   const bool disable_prepacking =
-      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") == "1";
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking,
+                                                        optimize_for_memory ? "1" : "0") == "1";
   // Memory pattern tracer allocates all initializers on a single contiguous
   // buffer. This has the effect of reducing memory fragmentation.
   // Further more, in training scenarios NCCL kernels require initializers to be allocated
@@ -1594,20 +1886,50 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
-  ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
-      Env::Default(), graph_location, *graph_viewer_,
-      GetAllocator(OrtDevice()),
-      ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
-      [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
-                                  bool constant, bool sparse) -> Status {
-        ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
-        if (remove_initializers) {
-          graph_.RemoveInitializedTensor(name);
-        }
-        return Status::OK();
-      },
-      logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked()));
+  // initializers are deserialized and pre-packed over the intra-op thread pool if requested
+  concurrency::ThreadPool* initializers_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLoadInitializersInParallel, "0") == "1"
+          ? thread_pool_
+          : nullptr;
+
+  if (parent_node == nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializerLoading, "0") == "1") {
+    const std::string memory_budget =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializersMemoryBudget, "0");
+    const std::string min_size =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializersMinSize, "1048576");
+    const std::string prefetch_distance =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializersPrefetchDistance, "0");
+    size_t memory_budget_in_bytes = 0, min_size_in_bytes = 0, prefetch_distance_in_nodes = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(memory_budget, memory_budget_in_bytes),
+                      "Invalid value for ", kOrtSessionOptionsLazyInitializersMemoryBudget, ": ", memory_budget);
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(min_size, min_size_in_bytes),
+                      "Invalid value for ", kOrtSessionOptionsLazyInitializersMinSize, ": ", min_size);
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(prefetch_distance, prefetch_distance_in_nodes),
+                      "Invalid value for ", kOrtSessionOptionsLazyInitializersPrefetchDistance, ": ",
+                      prefetch_distance);
+    lazy_initializers_ = std::make_unique<LazyInitializers>(*this, memory_budget_in_bytes, min_size_in_bytes,
+                                                            prefetch_distance_in_nodes);
+  }
+
+  {
+    profiling::InitializationStats::ScopedPhase initializer_load_phase(initialization_stats, "initializer_load");
+    ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
+        Env::Default(), graph_location, *graph_viewer_,
+        GetAllocator(OrtDevice()),
+        ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
+        [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
+                                    bool constant, bool sparse) -> Status {
+          ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+          if (remove_initializers) {
+            graph_.RemoveInitializedTensor(name);
+          }
+          return Status::OK();
+        },
+        logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
+        memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked(), initializers_thread_pool,
+        GetLazyInitializers(), initialization_stats));
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1621,16 +1943,39 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  {
+    profiling::InitializationStats::ScopedPhase kernel_creation_phase(initialization_stats, "kernel_creation");
+    ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  }
 
   if (!disable_prepacking) {
+    profiling::InitializationStats::ScopedPhase prepack_phase(initialization_stats, "prepack");
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          initializers_thread_pool));
   }
 
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
+  if (parent_node == nullptr) {
+    LoadStateSnapshot(session_options);
+
+    if (enable_mem_pattern_ &&
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsSymbolicMemoryPatterns, "0") == "1") {
+      symbolic_mem_pattern_ = SymbolicMemoryPattern::Create(*graph_viewer_, ort_value_name_idx_map_,
+                                                            *p_seq_exec_plan_, session_options.execution_order);
+      if (symbolic_mem_pattern_) {
+        LOGS(logger_, INFO) << "Memory patterns are generated from the symbolic shapes of "
+                            << symbolic_mem_pattern_->NumPlannedValues() << " activations.";
+      } else {
+        LOGS(logger_, INFO) << "Memory patterns can't be generated from the symbolic shapes of the graph.";
+      }
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(LoadProfileGuidedNodeTimings(session_options));
+
   // Need to recurse into subgraph session state instances to finalize them and add the execution info
 
   // Currently all subgraphs need to be executed using the sequential EP due to potential deadlock with the current
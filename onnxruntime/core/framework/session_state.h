@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -16,7 +17,11 @@
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/common/hardware_counters.h"
+#include "core/common/initialization_stats.h"
 #include "core/common/profiler.h"
+#include "core/common/sampling_profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_transfer_manager.h"
@@ -28,11 +33,14 @@
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/lazy_initializers.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/memory_timeline.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include <mutex>
@@ -216,6 +224,69 @@ class SessionState {
   }
 #endif
 
+  /**
+  Get the sampling profiler recording the kernel latencies of the nodes of this graph.
+  nullptr if it is not enabled. Subgraphs have no sampling profiler.
+  */
+  profiling::SamplingProfiler* GetSamplingProfiler() const noexcept { return sampling_profiler_.get(); }
+
+  void SetSamplingProfiler(std::unique_ptr<profiling::SamplingProfiler> sampling_profiler) noexcept {
+    sampling_profiler_ = std::move(sampling_profiler);
+  }
+
+  /**
+  Get the hardware performance counters recorded with the node events of the profiler.
+  nullptr if they are not enabled. The object is only present at the root SessionState object.
+  */
+  profiling::HardwareCounters* GetHardwareCounters() const noexcept {
+    if (parent_ != nullptr) {
+      return parent_->GetHardwareCounters();
+    }
+    return hardware_counters_.get();
+  }
+
+  void SetHardwareCounters(std::unique_ptr<profiling::HardwareCounters> hardware_counters) noexcept {
+    hardware_counters_ = std::move(hardware_counters);
+  }
+
+  /**
+  Get the memory timeline recording the allocations of the execution frames in the profile.
+  nullptr if it is not enabled. The object is only present at the root SessionState object.
+  */
+  MemoryTimeline* GetMemoryTimeline() const noexcept {
+    if (parent_ != nullptr) {
+      return parent_->GetMemoryTimeline();
+    }
+    return memory_timeline_.get();
+  }
+
+  void SetMemoryTimeline(std::unique_ptr<MemoryTimeline> memory_timeline) noexcept {
+    memory_timeline_ = std::move(memory_timeline);
+  }
+
+  /**
+  Get the stats recording the time spent in the phases of the initialization of the session, e.g. kernel creation.
+  nullptr if they are not recorded. The stats are owned by the session and set at the root SessionState object.
+  */
+  profiling::InitializationStats* GetInitializationStats() const noexcept {
+    if (parent_ != nullptr) {
+      return parent_->GetInitializationStats();
+    }
+    return initialization_stats_;
+  }
+
+  void SetInitializationStats(profiling::InitializationStats* initialization_stats) noexcept {
+    initialization_stats_ = initialization_stats;
+  }
+
+  // Number of lookups of the memory patterns of a run that found cached patterns, and of those that did not.
+  uint64_t GetMemoryPatternsCacheHits() const noexcept {
+    return mem_patterns_cache_hits_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetMemoryPatternsCacheMisses() const noexcept {
+    return mem_patterns_cache_misses_.load(std::memory_order_relaxed);
+  }
+
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
@@ -225,10 +296,10 @@ class SessionState {
   it is not mutable, we do not obtain a lock and simply get a pointer
   w/o copying a hashtable
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      std::shared_ptr<const InlinedHashMap<int, TensorShape>>& inferred_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -238,6 +309,39 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the memory pattern compiled from the symbolic shapes of the graph if kOrtSessionOptionsSymbolicMemoryPatterns
+  is set, or nullptr.
+  */
+  const SymbolicMemoryPattern* GetSymbolicMemoryPattern() const noexcept { return symbolic_mem_pattern_.get(); }
+
+  /**
+  Take an idle execution frame whose last run had the same input shapes as feeds, or nullptr if there is none.
+  Always nullptr unless kOrtSessionOptionsExecutionFramePoolSize is set or this is the SessionState of a Loop body.
+  The frame must be reset with ExecutionFrame::Reset before use.
+  */
+  std::unique_ptr<ExecutionFrame> AcquireExecutionFrame(gsl::span<const OrtValue> feeds) const;
+
+  /**
+  Return the frame of a successful run with the given feeds to the pool, releasing the values it holds.
+  The least recently used frame is dropped if the pool is full.
+  */
+  void RecycleExecutionFrame(gsl::span<const OrtValue> feeds, std::unique_ptr<ExecutionFrame> frame) const;
+
+  /**
+  Whether the temporary buffers of the CPU kernels are allocated by a ScratchAllocator per execution frame,
+  see kOrtSessionOptionsUseScratchAllocator.
+  */
+  bool GetUseScratchAllocator() const noexcept { return use_scratch_allocator_; }
+
+  /**
+  Largest scratch block needed by the runs so far, used to size the scratch block of the next runs.
+  */
+  size_t GetScratchHighWaterMark() const noexcept {
+    return scratch_high_water_mark_.load(std::memory_order_relaxed);
+  }
+  void RecordScratchHighWaterMark(size_t high_water_mark) const noexcept;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -293,6 +397,11 @@ class SessionState {
   const SessionState* GetSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
 
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
+  // The intra-op thread pool for the kernel of a node. It is nullptr for the nodes that the profile set with
+  // kOrtSessionOptionsProfileGuidedNodeTimingsFile recorded as too short to benefit from running on multiple threads.
+  concurrency::ThreadPool* GetThreadPool(NodeIndex node_index) const noexcept {
+    return single_threaded_nodes_.empty() || single_threaded_nodes_.count(node_index) == 0 ? thread_pool_ : nullptr;
+  }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
@@ -393,6 +502,17 @@ class SessionState {
   }
 #endif
 
+  /**
+   * Returns the initializers loaded on first use if kOrtSessionOptionsLazyInitializerLoading is enabled, nullptr
+   * otherwise. The object is owned by the root SessionState.
+   */
+  LazyInitializers* GetLazyInitializers() const {
+    if (parent_ != nullptr) {
+      return parent_->GetLazyInitializers();
+    }
+    return lazy_initializers_.get();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
@@ -411,7 +531,8 @@ class SessionState {
    * The original constant initialized tensors will be removed to save memory.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool = nullptr);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -520,6 +641,11 @@ class SessionState {
   MemoryProfiler* memory_profiler_;
 #endif
 
+  std::unique_ptr<profiling::SamplingProfiler> sampling_profiler_;
+  std::unique_ptr<profiling::HardwareCounters> hardware_counters_;
+  std::unique_ptr<MemoryTimeline> memory_timeline_;
+  profiling::InitializationStats* initialization_stats_ = nullptr;
+
 #if !defined(ORT_MINIMAL_BUILD)
   NodeStatsRecorder* node_stats_recorder_ = nullptr;
 #endif
@@ -527,18 +653,78 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // Key of the memory pattern cache: the rank followed by the dims of every input, so that different input shapes
+  // never share an entry.
+  using MemoryPatternsKey = InlinedVector<int64_t>;
+
+  struct MemoryPatternsCacheEntry {
+    // Execution frames hold a reference while running, so an entry can be evicted while a Run is using it.
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    // Shapes of activations resolved from the input shapes. Only generated in training scenarios.
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+    // Value of mem_patterns_use_counter_ when the entry was last looked up. Used for LRU eviction.
+    uint64_t last_use = 0;
+  };
+
+  // Insert an entry into mem_patterns_, evicting the least recently used entry if the cache is full.
+  // Must be called with mem_patterns_lock_ held.
+  MemoryPatternsCacheEntry& InsertMemoryPatternsCacheEntry(MemoryPatternsKey key,
+                                                           MemoryPatternsCacheEntry entry) const;
+
+  // Generate the memory patterns of a run with symbolic_mem_pattern_, or reuse those of the last run.
+  std::shared_ptr<const MemoryPatternGroup> GetSymbolicMemoryPatternGroup(gsl::span<const OrtValue> tensor_inputs,
+                                                                          gsl::span<const int> feed_mlvalue_idxs) const;
+
+  // Load the memory patterns of the snapshot file set with kOrtSessionOptionsSessionStateSnapshotFile, if it matches
+  // the execution plan. Main graph only.
+  void LoadStateSnapshot(const SessionOptions& session_options);
+
+  // Write the memory patterns to the snapshot file. Must be called with mem_patterns_lock_ held.
+  void SaveStateSnapshot() const;
+
+  // Find the nodes to run on a single thread from the kernel times of the profile set with
+  // kOrtSessionOptionsProfileGuidedNodeTimingsFile.
+  Status LoadProfileGuidedNodeTimings(const SessionOptions& session_options);
+
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  mutable InlinedHashMap<MemoryPatternsKey, MemoryPatternsCacheEntry> mem_patterns_;
+  mutable uint64_t mem_patterns_use_counter_ = 0;
+  // lookups of the memory patterns of a run that found cached patterns, and those that did not
+  mutable std::atomic<uint64_t> mem_patterns_cache_hits_{0};
+  mutable std::atomic<uint64_t> mem_patterns_cache_misses_{0};
+  // Maximum number of entries in mem_patterns_. 0 means unbounded.
+  size_t mem_patterns_cache_capacity_ = 0;
+  // Snapshot file of the memory patterns and fingerprint of the execution plan, see SessionStateSnapshot.
+  // Empty if snapshots are disabled.
+  PathString state_snapshot_path_;
+  std::string state_snapshot_fingerprint_;
+
+  // Nodes whose kernels are given no intra-op thread pool, see GetThreadPool(NodeIndex).
+  InlinedHashSet<NodeIndex> single_threaded_nodes_;
+
+  // Generates the memory patterns from the symbolic input dimensions instead of mem_patterns_, if set.
+  std::unique_ptr<SymbolicMemoryPattern> symbolic_mem_pattern_;
+  // The memory patterns generated for the last run and its symbolic dimension values, guarded by mem_patterns_lock_.
+  // Successive runs with the same dimensions share them, so that pooled frames keep their buffers.
+  mutable InlinedVector<int64_t> symbolic_mem_pattern_dim_values_;
+  mutable std::shared_ptr<const MemoryPatternGroup> symbolic_mem_patterns_;
+
+  std::unique_ptr<LazyInitializers> lazy_initializers_;
+
+  // lock for the execution_frame_pool_
+  mutable std::mutex execution_frame_pool_mutex_;
+  // idle execution frames with the input shapes of their last run. the most recently recycled frame is last.
+  mutable std::vector<std::pair<MemoryPatternsKey, std::unique_ptr<ExecutionFrame>>> execution_frame_pool_;
+  // Maximum number of frames in execution_frame_pool_. 0 disables the pool.
+  size_t execution_frame_pool_size_ = 0;
+
+  bool use_scratch_allocator_ = false;
+
+  // The non-arena allocator of the pre-packed weights on CPU when the session is prefork safe.
+  AllocatorPtr prepacked_weights_cpu_allocator_;
+  mutable std::atomic<size_t> scratch_high_water_mark_{0};
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
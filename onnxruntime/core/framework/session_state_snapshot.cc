@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_state_snapshot.h"
+
+#include <map>
+
+#include "core/framework/binary_buffer.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/graph/graph_viewer.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr char kFileMagic[] = "ORTSNAP1";
+
+void WriteDevice(BinaryBufferWriter& writer, const OrtDevice& device) {
+  writer.Write(static_cast<uint64_t>(device.Type()));
+  writer.Write(static_cast<uint64_t>(device.MemType()));
+  writer.Write(static_cast<uint64_t>(device.Id()));
+}
+
+bool ReadDevice(BinaryBufferReader& reader, OrtDevice& device) {
+  uint64_t type = 0, mem_type = 0, id = 0;
+  if (!reader.Read(type) || !reader.Read(mem_type) || !reader.Read(id)) {
+    return false;
+  }
+  device = OrtDevice(static_cast<OrtDevice::DeviceType>(type), static_cast<OrtDevice::MemoryType>(mem_type),
+                     static_cast<OrtDevice::DeviceId>(id));
+  return true;
+}
+}  // namespace
+
+std::string SessionStateSnapshot::ComputeFingerprint(const GraphViewer& graph_viewer,
+                                                     const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                     const SequentialExecutionPlan& plan) {
+  BinaryBufferWriter writer;
+  writer.Write(std::string(ORT_VERSION));
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    writer.Write(static_cast<uint64_t>(node.Index()));
+    writer.Write(node.OpType());
+    writer.Write(node.Domain());
+    writer.Write(node.GetExecutionProviderType());
+  }
+
+  // the memory patterns refer to the values by index
+  writer.Write(static_cast<uint64_t>(plan.allocation_plan.size()));
+  for (size_t idx = 0; idx < plan.allocation_plan.size(); ++idx) {
+    std::string name;
+    ORT_IGNORE_RETURN_VALUE(ort_value_name_idx_map.GetName(static_cast<int>(idx), name));
+    const auto& value_plan = plan.allocation_plan[idx];
+    writer.Write(name);
+    writer.Write(static_cast<uint64_t>(value_plan.alloc_kind));
+    writer.Write(static_cast<uint64_t>(value_plan.reused_buffer));
+    WriteDevice(writer, value_plan.location);
+  }
+
+  return writer.HashToHex();
+}
+
+Status SessionStateSnapshot::Save(const std::filesystem::path& file_path, const std::string& fingerprint) const {
+  BinaryBufferWriter writer;
+  writer.Write(std::string(kFileMagic));
+  writer.Write(fingerprint);
+
+  writer.Write(static_cast<uint64_t>(memory_patterns.size()));
+  for (const auto& entry : memory_patterns) {
+    writer.Write(static_cast<uint64_t>(entry.key.size()));
+    for (const auto value : entry.key) {
+      writer.Write(static_cast<uint64_t>(value));
+    }
+
+    const MemoryPatternGroup& group = *entry.patterns;
+    writer.Write(static_cast<uint64_t>(group.locations.size()));
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      WriteDevice(writer, group.locations[i]);
+      const MemoryPattern& pattern = group.patterns[i];
+      writer.Write(static_cast<uint64_t>(pattern.PeakSize()));
+      // sorted, so that the same patterns always produce the same file
+      const std::map<int, MemoryBlock> blocks(pattern.GetPatternsMap().begin(), pattern.GetPatternsMap().end());
+      writer.Write(static_cast<uint64_t>(blocks.size()));
+      for (const auto& [ml_value_idx, block] : blocks) {
+        writer.Write(static_cast<uint64_t>(ml_value_idx));
+        writer.Write(static_cast<uint64_t>(block.offset_));
+        writer.Write(static_cast<uint64_t>(block.size_));
+      }
+    }
+  }
+
+  return WriteBinaryFileAtomically(file_path, writer.Buffer());
+}
+
+bool SessionStateSnapshot::Load(const std::filesystem::path& file_path, const std::string& fingerprint) {
+  memory_patterns.clear();
+
+  std::string buffer;
+  if (!ReadBinaryFile(file_path, buffer)) {
+    return false;
+  }
+
+  BinaryBufferReader reader(buffer);
+  std::string magic, file_fingerprint;
+  uint64_t num_entries = 0;
+  bool valid = reader.Read(magic) && magic == kFileMagic && reader.Read(file_fingerprint) &&
+               file_fingerprint == fingerprint && reader.ReadCount(num_entries);
+
+  for (uint64_t i = 0; valid && i < num_entries; ++i) {
+    MemoryPatternsEntry entry;
+    uint64_t key_size = 0;
+    valid = reader.ReadCount(key_size);
+    for (uint64_t j = 0; valid && j < key_size; ++j) {
+      uint64_t value = 0;
+      valid = reader.Read(value);
+      entry.key.push_back(static_cast<int64_t>(value));
+    }
+
+    MemoryPatternGroup group;
+    uint64_t num_locations = 0;
+    valid = valid && reader.ReadCount(num_locations);
+    for (uint64_t j = 0; valid && j < num_locations; ++j) {
+      OrtDevice location;
+      uint64_t peak_size = 0, num_blocks = 0;
+      valid = ReadDevice(reader, location) && reader.Read(peak_size) && reader.ReadCount(num_blocks);
+      InlinedHashMap<int, MemoryBlock> blocks;
+      for (uint64_t k = 0; valid && k < num_blocks; ++k) {
+        uint64_t ml_value_idx = 0, offset = 0, size = 0;
+        valid = reader.Read(ml_value_idx) && reader.Read(offset) && reader.Read(size);
+        blocks.emplace(static_cast<int>(ml_value_idx),
+                       MemoryBlock(static_cast<size_t>(offset), static_cast<size_t>(size)));
+      }
+      group.locations.push_back(location);
+      group.patterns.emplace_back(std::move(blocks), static_cast<size_t>(peak_size));
+    }
+
+    entry.patterns = std::make_shared<const MemoryPatternGroup>(std::move(group));
+    memory_patterns.push_back(std::move(entry));
+  }
+
+  if (!valid || !reader.AtEnd()) {
+    memory_patterns.clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace onnxruntime
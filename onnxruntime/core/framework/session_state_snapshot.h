@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+/**
+ * Snapshot of the state of a finalized SessionState that is rebuilt by every session otherwise, enabled with
+ * kOrtSessionOptionsSessionStateSnapshotFile: the memory patterns generated for the input shapes seen by the runs.
+ *
+ * A snapshot records the fingerprint of the execution plan it was generated with and is only loaded by sessions
+ * with the same plan, i.e. the same model, execution providers and session options affecting the plan.
+ */
+struct SessionStateSnapshot {
+  struct MemoryPatternsEntry {
+    // key of the memory pattern cache of SessionState: the rank followed by the dims of every input
+    InlinedVector<int64_t> key;
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+  };
+  std::vector<MemoryPatternsEntry> memory_patterns;
+
+  // Returns a hash of the nodes of the graph with their execution providers and of the allocation plan of the values.
+  static std::string ComputeFingerprint(const GraphViewer& graph_viewer,
+                                        const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                        const SequentialExecutionPlan& plan);
+
+  Status Save(const std::filesystem::path& file_path, const std::string& fingerprint) const;
+
+  // Returns false, leaving the snapshot empty, if the file does not exist, is invalid or has another fingerprint.
+  bool Load(const std::filesystem::path& file_path, const std::string& fingerprint);
+};
+
+}  // namespace onnxruntime
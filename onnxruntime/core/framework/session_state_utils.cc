@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
@@ -13,10 +15,13 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/graph_viewer.h"
+#include "core/platform/threadpool.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
+#include "core/framework/lazy_initializers.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
@@ -31,6 +36,7 @@
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
+#include "nlohmann/json.hpp"
 
 namespace onnxruntime {
 namespace session_state_utils {
@@ -73,14 +79,19 @@ static common::Status ExtDataTensorProtoToTensor(const Env& env,
                                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                                  Tensor& tensor, OrtCallback& ext_data_deleter,
                                                  PrepackedWeightsForGraph& prepacked_for_graph,
-                                                 Tensor* buffered_tensor = nullptr) {
+                                                 Tensor* buffered_tensor = nullptr,
+                                                 bool share_external_data_mappings = false,
+                                                 concurrency::ThreadPool* thread_pool = nullptr) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
 
   void* ext_data_buf = nullptr;
   SafeInt<size_t> ext_data_len = 0;
+  // the data is converted in place on big endian platforms so the mapping can't be shared there
+  const bool use_shared_mapping = share_external_data_mappings && endian::native == endian::little;
   ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path.c_str(), tensor_proto,
                                                        ext_data_buf, ext_data_len, ext_data_deleter,
-                                                       buffered_tensor, &prepacked_for_graph));
+                                                       buffered_tensor, &prepacked_for_graph,
+                                                       use_shared_mapping, thread_pool));
   if constexpr (endian::native != endian::little) {
     if (!proto_path.empty() && (proto_path.compare(onnxruntime::utils::kTensorProtoMemoryAddressTag) != 0)) {
       utils::ConvertRawDataInTensorProto(const_cast<ONNX_NAMESPACE::TensorProto*>(&tensor_proto), ext_data_buf, ext_data_len);
@@ -108,7 +119,9 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                                              const ExternalDataLoaderManager& external_data_loader_mgr,
                                              PrepackedWeightsForGraph& prepacked_for_graph,
                                              bool use_device_allocator_for_initializers = false,
-                                             Tensor* buffered_tensor = nullptr) {
+                                             Tensor* buffered_tensor = nullptr,
+                                             bool share_external_data_mappings = false,
+                                             concurrency::ThreadPool* thread_pool = nullptr) {
   if (bool(alloc) == (m != nullptr)) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -146,7 +159,7 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       OrtCallback ext_data_deleter;
       ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor,
                                                      ext_data_deleter, prepacked_for_graph,
-                                                     buffered_tensor));
+                                                     buffered_tensor, share_external_data_mappings, thread_pool));
 
       ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
       MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
@@ -171,7 +184,7 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       std::optional<ScopedOrtCallbackInvoker> scoped_ort_callback_invoker;
       ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_deserialize_tensor,
                                                      ext_data_deleter, prepacked_for_graph,
-                                                     buffered_tensor));
+                                                     buffered_tensor, share_external_data_mappings, thread_pool));
       scoped_ort_callback_invoker.emplace(ext_data_deleter);
       // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
@@ -280,7 +293,10 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool,
+    LazyInitializers* lazy_initializers,
+    profiling::InitializationStats* initialization_stats) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -330,6 +346,33 @@ common::Status SaveInitializedTensors(
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
 
+  // lazy initializers are neither planned nor deserialized here, they are loaded when the nodes consuming them run.
+  // initializers returned as graph outputs or requiring a specific allocation order are always loaded.
+  InlinedHashSet<int> lazy_initializer_ids;
+  if (lazy_initializers != nullptr) {
+    InlinedHashSet<std::string_view> graph_outputs;
+    for (const auto* output : graph.GetOutputs()) {
+      graph_outputs.insert(output->Name());
+    }
+
+    for (const auto& entry : id_to_initialized_tensor) {
+      const std::string& name = entry.second->name();
+      OrtValue ort_value;
+      if (user_supplied_initializer_ids.count(entry.first) == 0 && graph_outputs.count(name) == 0 &&
+          buffered_tensors.count(name) == 0 && !graph.GetOrtValueInitializer(name, ort_value) &&
+#if !defined(DISABLE_SPARSE_TENSORS)
+          !graph.GetGraph().IsSparseInitializer(name) &&
+#endif
+          lazy_initializers->IsCandidate(*entry.second)) {
+        lazy_initializer_ids.insert(entry.first);
+      }
+    }
+
+    for (int ort_value_index : initializer_allocation_order) {
+      lazy_initializer_ids.erase(ort_value_index);
+    }
+  }
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
   // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
@@ -352,6 +395,9 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       continue;
     }
+    if (lazy_initializer_ids.find(entry.first) != lazy_initializer_ids.end()) {
+      continue;
+    }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       // do not trace string tensor
       continue;
@@ -377,6 +423,33 @@ common::Status SaveInitializedTensors(
   OrtCallback deleter{nullptr, nullptr};
 
   // 3. create weight tensors based on weights buffer
+  // The planner is not thread safe, so the buffers of all the initializers are obtained first. The initializers are
+  // then deserialized, in parallel over thread_pool for the ones that live on CPU, and finally saved in order.
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    OrtValue ort_value;
+    // the following are only used if the initializer has to be deserialized from tensor_proto
+    bool deserialize = false;
+    bool on_cpu = false;
+    bool lazy = false;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    Tensor* buffered_tensor = nullptr;
+    Status status;
+  };
+
+  // the initializers of a prefork safe session are kept out of the arenas, whose pages are written by the runs
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1" ||
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsPreforkSafe, "0") == "1";
+  const bool share_external_data_mappings =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsShareExternalInitializerMappings, "0") == "1";
+
+  InlinedVector<InitializerToSave> initializers_to_save;
+  initializers_to_save.reserve(id_to_initialized_tensor.size());
+  size_t num_to_deserialize_in_parallel = 0;
+
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -386,42 +459,118 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    InitializerToSave& initializer = initializers_to_save.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+    if (lazy_initializer_ids.find(entry.first) != lazy_initializer_ids.end()) {
+      ORT_RETURN_IF_ERROR(lazy_initializers->Add(graph, graph_loc, ort_value_index, *entry.second,
+                                                 exec_plan.GetLocation(ort_value_index), initializer.ort_value));
+      initializer.lazy = true;
+      VLOGS(logger, 1) << "Initializer " << name << " will be loaded on first use.";
+
+    } else if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
 
-    } else if (graph.GetOrtValueInitializer(name, ort_value)) {
+    } else if (graph.GetOrtValueInitializer(name, initializer.ort_value)) {
       // populated OrtValue from the Graph instance
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
 
-      Tensor* p_tensor = nullptr;
       auto buffered_tensors_iter = buffered_tensors.find(name);
       if (buffered_tensors_iter != buffered_tensors.end()) {
-        p_tensor = buffered_tensors_iter->second.get();
+        initializer.buffered_tensor = buffered_tensors_iter->second.get();
       }
 
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
-                                         prepacked_for_graph,
-                                         use_device_allocator_for_initializers, p_tensor);
+      const auto& memory_info = initializer.alloc ? initializer.alloc->Info() : initializer.m->GetAllocInfo();
+      initializer.deserialize = true;
+      initializer.on_cpu = memory_info.device.Type() == OrtDevice::CPU &&
+                           external_data_loader_mgr.GetExternalDataLoader(memory_info) == nullptr;
+      if (initializer.on_cpu) {
+        ++num_to_deserialize_in_parallel;
+      }
+    }
+  }
+
+  // the chunks of compressed external data are decompressed over chunk_thread_pool, which is only used when the
+  // initializers are not already deserialized in parallel
+  auto deserialize = [&](InitializerToSave& initializer, PrepackedWeightsForGraph& prepacked,
+                         concurrency::ThreadPool* chunk_thread_pool) {
+    const auto start = profiling::InitializationStats::Clock::now();
+    initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                                (initializer.m.has_value()) ? &*initializer.m : nullptr,
+                                                initializer.alloc, default_cpu_alloc, initializer.ort_value,
+                                                data_transfer_mgr, external_data_loader_mgr, prepacked,
+                                                use_device_allocator_for_initializers, initializer.buffered_tensor,
+                                                share_external_data_mappings, chunk_thread_pool);
+    if (initialization_stats != nullptr && initializer.status.IsOK() && initializer.ort_value.IsTensor()) {
+      initialization_stats->AddInitializer("initializer_load", initializer.tensor_proto->name(),
+                                           initializer.ort_value.Get<Tensor>().SizeInBytes(),
+                                           profiling::InitializationStats::Clock::now() - start);
+    }
+  };
+
+  if (thread_pool != nullptr && num_to_deserialize_in_parallel > 1) {
+    // pre-packed blobs found in the external data are collected per initializer and merged afterwards
+    InlinedVector<InitializerToSave*> cpu_initializers;
+    cpu_initializers.reserve(num_to_deserialize_in_parallel);
+    for (auto& initializer : initializers_to_save) {
+      if (initializer.deserialize && initializer.on_cpu) {
+        cpu_initializers.push_back(&initializer);
+      }
+    }
+
+    InlinedVector<PrepackedKeyToBlobMap> prepacked_blobs(cpu_initializers.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(cpu_initializers.size()),
+        [&](std::ptrdiff_t i) {
+          InitializerToSave& initializer = *cpu_initializers[i];
+          PrepackedWeightsForGraph prepacked(prepacked_blobs[i], prepacked_for_graph.IsSaveModeOn());
+          ORT_TRY {
+            deserialize(initializer, prepacked, nullptr);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              initializer.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+
+    for (auto& blobs : prepacked_blobs) {
+      for (auto& [key, prepacked_weights] : blobs) {
+        prepacked_for_graph.InsertPrepackedWeights(key, std::move(prepacked_weights));
+      }
+    }
+
+    for (auto& initializer : initializers_to_save) {
+      if (initializer.deserialize && !initializer.on_cpu) {
+        deserialize(initializer, prepacked_for_graph, thread_pool);
+      }
+    }
+  } else {
+    for (auto& initializer : initializers_to_save) {
+      if (initializer.deserialize) {
+        deserialize(initializer, prepacked_for_graph, thread_pool);
+      }
+    }
+  }
+
+  for (auto& initializer : initializers_to_save) {
+    const std::string& name = initializer.tensor_proto->name();
+
+    if (initializer.deserialize) {
+      const Status& st = initializer.status;
       if (!st.IsOK()) {
         std::ostringstream oss;
         oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
         return Status(st.Category(), st.Code(), oss.str());
       }
 
-      if (p_tensor != nullptr) {
-        // p_tensor was wrapped in a deleter by DeserializeTensorProto so we can simply release it here.
+      if (initializer.buffered_tensor != nullptr) {
+        // buffered_tensor was wrapped in a deleter by DeserializeTensorProto so we can simply release it here.
+        auto buffered_tensors_iter = buffered_tensors.find(name);
         ORT_IGNORE_RETURN_VALUE(buffered_tensors_iter->second.release());
         buffered_tensors.erase(buffered_tensors_iter);
       }
@@ -429,23 +578,42 @@ common::Status SaveInitializedTensors(
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
     // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << initializer.ort_value_index;
 
     // any outer scope value is shadowed by a local value and can't override it.
     // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+    // lazy initializers are not constant for the kernels so that they are read when they run and not pre-packed
+    const bool constant = !initializer.lazy && graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter,
+                                         constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter,
+                                         constant, false));
 #endif
   }
 
+  if (!lazy_initializer_ids.empty()) {
+    lazy_initializers->AddConsumers(graph, ort_value_name_idx_map, session_options.execution_order);
+    LOGS(logger, INFO) << lazy_initializer_ids.size() << " initializers will be loaded on first use";
+  }
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
 
+common::Status LoadInitializer(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                               const ONNX_NAMESPACE::TensorProto& tensor_proto, const AllocatorPtr& alloc,
+                               const AllocatorPtr& default_cpu_alloc, const DataTransferManager& data_transfer_mgr,
+                               const ExternalDataLoaderManager& external_data_loader_mgr, OrtValue& ort_value) {
+  // pre-packed blobs stored with the external data are not used as the initializer is not pre-packed
+  PrepackedKeyToBlobMap prepacked_blobs;
+  PrepackedWeightsForGraph prepacked_for_graph(prepacked_blobs, false);
+  return DeserializeTensorProto(env, proto_path, tensor_proto, nullptr, alloc, default_cpu_alloc, ort_value,
+                                data_transfer_mgr, external_data_loader_mgr, prepacked_for_graph);
+}
+
 template <typename T>  // T is container of const NodeArg* or NodeArg*
 static bool IsArgNameInInputsOutputs(const std::string& name,
                                      const T& graph_args) {
@@ -574,5 +742,44 @@ common::Status SaveInputOutputNamesToNodeMapping(const onnxruntime::GraphViewer&
   return Status::OK();
 }
 
+common::Status LoadAverageNodeKernelTimes(const PathString& profile_file,
+                                          InlinedHashMap<std::string, double>& node_kernel_times) {
+  std::ifstream if_stream(profile_file);
+  ORT_RETURN_IF_NOT(if_stream.is_open(), "Failed to open profile file ", ToUTF8String(profile_file));
+
+  // The kernel time of a node is recorded as a "Node" event named "<node name>_kernel_time" for every run.
+  constexpr std::string_view kernel_time_suffix = "_kernel_time";
+  InlinedHashMap<std::string, std::pair<double, size_t>> total_kernel_time;
+  ORT_TRY {
+    const auto profile = nlohmann::json::parse(if_stream);
+    for (const auto& event : profile) {
+      if (!event.contains("cat") || event["cat"] != "Node" || !event.contains("name") || !event.contains("dur")) {
+        continue;
+      }
+      const std::string name = event["name"];
+      if (name.size() <= kernel_time_suffix.size() ||
+          name.compare(name.size() - kernel_time_suffix.size(), kernel_time_suffix.size(), kernel_time_suffix) != 0) {
+        continue;
+      }
+      auto& time_and_count = total_kernel_time[name.substr(0, name.size() - kernel_time_suffix.size())];
+      time_and_count.first += event["dur"].get<double>();
+      ++time_and_count.second;
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    Status status;
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to parse profile file ", ToUTF8String(profile_file), ": ",
+                               ex.what());
+    });
+    return status;
+  }
+
+  for (const auto& [node_name, time_and_count] : total_kernel_time) {
+    node_kernel_times[node_name] = time_and_count.first / static_cast<double>(time_and_count.second);
+  }
+  return Status::OK();
+}
+
 }  // namespace session_state_utils
 }  // namespace onnxruntime
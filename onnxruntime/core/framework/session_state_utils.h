@@ -8,6 +8,7 @@
 #include <unordered_map>
 
 #include "core/common/const_pointer_container.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/tensor.h"
@@ -25,6 +26,7 @@ class GraphViewer;
 class OrtValueNameIdxMap;
 class DataTransferManager;
 class ExternalDataLoaderManager;
+class LazyInitializers;
 class NodeArg;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
@@ -34,6 +36,14 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
+namespace profiling {
+class InitializationStats;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
@@ -52,7 +62,16 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool = nullptr,
+    LazyInitializers* lazy_initializers = nullptr,
+    profiling::InitializationStats* initialization_stats = nullptr);
+
+// Deserializes an initializer into a buffer allocated with alloc. Used to load the lazy initializers on first use.
+common::Status LoadInitializer(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                               const ONNX_NAMESPACE::TensorProto& tensor_proto, const AllocatorPtr& alloc,
+                               const AllocatorPtr& default_cpu_alloc, const DataTransferManager& data_transfer_mgr,
+                               const ExternalDataLoaderManager& external_data_loader_mgr, OrtValue& ort_value);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* m,
@@ -78,5 +97,10 @@ common::Status CopyTensorFromCPUToDevice(
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
                                                  gsl::span<const NodeArg* const> implicit_inputs);
+
+// Reads the average kernel time in microseconds of each node, keyed by node name, from a profile file written by
+// a session with profiling enabled.
+common::Status LoadAverageNodeKernelTimes(const PathString& profile_file,
+                                          InlinedHashMap<std::string, double>& node_kernel_times);
 }  // namespace session_state_utils
 }  // namespace onnxruntime
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_cache.h"
+
+#include <cstring>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+uint64_t SharedInitializerCache::HashContent(const Tensor& tensor) {
+  uint64_t hash[2] = {0, 0};
+  MurmurHash3::x86_128(tensor.DataRaw(), tensor.SizeInBytes(), static_cast<uint32_t>(tensor.GetElementType()), hash);
+  return hash[0];
+}
+
+std::shared_ptr<const OrtValue> SharedInitializerCache::GetOrInsert(OrtValue value) {
+  const Tensor& tensor = value.Get<Tensor>();
+  ORT_ENFORCE(tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString(),
+              "Only CPU tensors of numeric types can be shared");
+  const uint64_t hash = HashContent(tensor);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second;) {
+    auto entry = it->second.lock();
+    if (entry == nullptr) {
+      it = entries_.erase(it);
+      continue;
+    }
+    const Tensor& shared = entry->value.Get<Tensor>();
+    if (shared.DataType() == tensor.DataType() && shared.Shape() == tensor.Shape() &&
+        std::memcmp(shared.DataRaw(), tensor.DataRaw(), tensor.SizeInBytes()) == 0) {
+      return std::shared_ptr<const OrtValue>(entry, &entry->value);
+    }
+    ++it;
+  }
+
+  auto entry = std::make_shared<Entry>();
+  entry->owner = std::move(value);
+  Tensor& owned = *entry->owner.GetMutable<Tensor>();
+  Tensor::InitOrtValue(owned.DataType(), owned.Shape(), owned.MutableDataRaw(), owned.Location(), entry->value);
+  entries_.emplace(hash, entry);
+  return std::shared_ptr<const OrtValue>(entry, &entry->value);
+}
+
+size_t SharedInitializerCache::NumberOfValues() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto& [hash, entry] : entries_) {
+    ORT_UNUSED_PARAMETER(hash);
+    count += entry.expired() ? 0 : 1;
+  }
+  return count;
+}
+
+}  // namespace onnxruntime
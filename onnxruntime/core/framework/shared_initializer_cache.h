@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights_container.h"
+
+namespace onnxruntime {
+
+/**
+ * Deduplicates the constant initializers of the sessions of an environment by content. A session that enables
+ * session.share_initializers_min_bytes looks up each of its large CPU initializers, and uses the value of an earlier
+ * session's initializer with the same data type, shape and content instead of its own copy. A value is freed once no
+ * session references it.
+ *
+ * The pre-packed forms of the shared initializers are shared through the PrepackedWeightsContainer of the cache.
+ */
+class SharedInitializerCache {
+ public:
+  SharedInitializerCache() = default;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerCache);
+
+  // Returns the shared value of a tensor with the data type, shape and content of value, which must be a dense CPU
+  // tensor that owns its buffer. value becomes the shared value if there is none. The returned tensor does not own
+  // its buffer, so it can be added to SessionOptions::initializers_to_share_map.
+  std::shared_ptr<const OrtValue> GetOrInsert(OrtValue value);
+
+  // Returns the number of values that are referenced by a session.
+  size_t NumberOfValues() const;
+
+  PrepackedWeightsContainer& GetPrepackedWeightsContainer() noexcept { return prepacked_weights_container_; }
+
+ private:
+  struct Entry {
+    // owns the buffer of value
+    OrtValue owner;
+    OrtValue value;
+  };
+
+  static uint64_t HashContent(const Tensor& tensor);
+
+  mutable std::mutex mutex_;
+  std::unordered_multimap<uint64_t, std::weak_ptr<const Entry>> entries_;
+  PrepackedWeightsContainer prepacked_weights_container_;
+};
+
+}  // namespace onnxruntime
@@ -8,6 +8,36 @@
 #include "core/common/spin_pause.h"
 
 namespace onnxruntime {
+namespace {
+std::unique_ptr<ExecutionFrame> CreateOrResetExecutionFrame(std::unique_ptr<ExecutionFrame> frame,
+                                                            gsl::span<const int> feed_mlvalue_idxs,
+                                                            gsl::span<const OrtValue> feeds,
+                                                            gsl::span<const int> fetch_mlvalue_idxs,
+                                                            gsl::span<const OrtValue> fetches,
+                                                            const std::unordered_map<size_t, IExecutor::CustomAllocator>&
+                                                                fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                                                            const DeviceStreamCollection* device_streams,
+#endif
+                                                            const SessionState& sess_state) {
+  if (frame == nullptr) {
+    return std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                                            device_streams,
+#endif
+                                            sess_state);
+  }
+
+  frame->Reset(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+               ,
+               device_streams
+#endif
+  );
+  return frame;
+}
+}  // namespace
+
 #ifdef ORT_ENABLE_STREAM
 StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                int32_t num_streams,
@@ -20,15 +50,17 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const std::unordered_map<size_t, IExecutor::CustomAllocator>&
                                                    fetch_allocators,
                                                const logging::Logger& sess_logger,
-                                               bool single_thread_mode)
+                                               bool single_thread_mode,
+                                               std::unique_ptr<ExecutionFrame> frame)
     : session_state_(&sess_state),
-      frame_(feed_mlvalue_idxs,
-             feeds,
-             fetch_mlvalue_idxs,
-             fetches,
-             fetch_allocators,
-             device_stream_map,
-             sess_state),
+      frame_(CreateOrResetExecutionFrame(std::move(frame),
+                                         feed_mlvalue_idxs,
+                                         feeds,
+                                         fetch_mlvalue_idxs,
+                                         fetches,
+                                         fetch_allocators,
+                                         device_stream_map,
+                                         sess_state)),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode),
       device_stream_map_(device_stream_map),
@@ -88,14 +120,16 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const std::unordered_map<size_t, IExecutor::CustomAllocator>&
                                                    fetch_allocators,
                                                const logging::Logger& sess_logger,
-                                               bool single_thread_mode)
+                                               bool single_thread_mode,
+                                               std::unique_ptr<ExecutionFrame> frame)
     : session_state_(&sess_state),
-      frame_(feed_mlvalue_idxs,
-             feeds,
-             fetch_mlvalue_idxs,
-             fetches,
-             fetch_allocators,
-             sess_state),
+      frame_(CreateOrResetExecutionFrame(std::move(frame),
+                                         feed_mlvalue_idxs,
+                                         feeds,
+                                         fetch_mlvalue_idxs,
+                                         fetches,
+                                         fetch_allocators,
+                                         sess_state)),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode) {
 #ifdef _WIN32
@@ -133,7 +167,7 @@ const SessionState& StreamExecutionContext ::GetSessionState() const { return *s
 
 const logging::Logger& StreamExecutionContext ::GetLogger() const { return *logger_; }
 
-ExecutionFrame& StreamExecutionContext ::GetExecutionFrame() { return frame_; }
+ExecutionFrame& StreamExecutionContext ::GetExecutionFrame() { return *frame_; }
 
 const Status& StreamExecutionContext ::TaskStatus() const {
   return task_status_;
@@ -167,7 +201,7 @@ void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index
   auto* execution_plan = session_state_->GetExecutionPlan();
   for (auto idx : execution_plan->node_release_list[node_index]) {
     if (--release_plan_[idx] == 0) {
-      ORT_ENFORCE(frame_.ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
+      ORT_ENFORCE(frame_->ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
       VLOGS(*logger_, 0) << "ort value " << execution_plan->release_actions[idx].value_index << " released";
     }
   }
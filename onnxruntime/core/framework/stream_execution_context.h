@@ -70,7 +70,9 @@ class StreamExecutionContext {
                          std::vector<OrtValue>& fetches,
                          const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                          const logging::Logger& sess_logger,
-                         bool single_thread_mode);
+                         bool single_thread_mode,
+                         // optional frame from a previous run to reset and use instead of creating a new one
+                         std::unique_ptr<ExecutionFrame> frame = nullptr);
 
   const SessionState& GetSessionState() const;
 
@@ -78,6 +80,10 @@ class StreamExecutionContext {
 
   ExecutionFrame& GetExecutionFrame();
 
+  // Take the execution frame out of the context so it can be reused by another run. The context must not be used
+  // afterwards.
+  std::unique_ptr<ExecutionFrame> ReleaseExecutionFrame() { return std::move(frame_); }
+
   synchronize::Notification* GetNotification(size_t idx);
 
   void SetLogger(const logging::Logger& current_logger) {
@@ -150,7 +156,7 @@ class StreamExecutionContext {
  private:
   const SessionState* session_state_;
 
-  ExecutionFrame frame_;
+  std::unique_ptr<ExecutionFrame> frame_;
 
   const logging::Logger* logger_;
 
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_mem_pattern.h"
+
+#include <algorithm>
+#include <string>
+
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<SymbolicMemoryPattern> SymbolicMemoryPattern::Create(
+    const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+    const SequentialExecutionPlan& plan, ExecutionOrder execution_order) {
+  // with several streams the order of the allocations and frees depends on the execution, and the activations
+  // allocated contiguously are only traced with program counters
+  if (plan.NumberOfValidStreams() != 1 || !plan.activation_allocation_order.empty()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<SymbolicMemoryPattern> pattern{new SymbolicMemoryPattern(plan)};
+
+  InlinedHashMap<std::string, size_t> dim_param_indices;
+  for (const auto* input : graph_viewer.GetInputs()) {
+    int ort_value_idx = -1;
+    const auto* shape = input->Shape();
+    if (shape == nullptr || !ort_value_name_idx_map.GetIdx(input->Name(), ort_value_idx).IsOK()) {
+      continue;
+    }
+    const size_t rank = static_cast<size_t>(shape->dim_size());
+    for (size_t axis = 0; axis < rank; ++axis) {
+      const auto& dim = shape->dim(static_cast<int>(axis));
+      if (dim.has_dim_param()) {
+        auto [it, inserted] = dim_param_indices.emplace(dim.dim_param(), pattern->dim_param_sources_.size());
+        if (inserted) {
+          pattern->dim_param_sources_.emplace_back();
+        }
+        pattern->dim_param_sources_[it->second].push_back({ort_value_idx, rank, axis});
+      }
+    }
+  }
+
+  // the sizes of the activations as products of dim_values and dim_params of the graph inputs
+  InlinedHashMap<int, size_t> planned_value_indices;
+  auto add_planned_value = [&](const NodeArg& arg, int ort_value_idx) {
+    const auto& value_plan = plan.allocation_plan[ort_value_idx];
+    if (value_plan.alloc_kind != AllocKind::kAllocate || value_plan.value_type == nullptr ||
+        !value_plan.value_type->IsTensorType() || arg.Shape() == nullptr) {
+      return;
+    }
+    const auto* element_type = static_cast<const TensorTypeBase*>(value_plan.value_type)->GetElementType();
+    if (element_type == DataTypeImpl::GetType<std::string>()) {
+      return;
+    }
+
+    PlannedValue planned_value{ort_value_idx, element_type, {}};
+    for (const auto& dim : arg.Shape()->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() >= 0) {
+        planned_value.dims.push_back(dim.dim_value());
+      } else if (dim.has_dim_param() && dim_param_indices.count(dim.dim_param()) != 0) {
+        planned_value.dims.push_back(-1 - static_cast<int64_t>(dim_param_indices[dim.dim_param()]));
+      } else {
+        // the size depends on data
+        return;
+      }
+    }
+
+    planned_value_indices.emplace(ort_value_idx, pattern->planned_values_.size());
+    pattern->events_.push_back({false, pattern->planned_values_.size()});
+    pattern->planned_values_.push_back(std::move(planned_value));
+  };
+
+  // the frame allocates the outputs of a node while it runs and frees the values released once it completes
+  for (const NodeIndex node_index : graph_viewer.GetNodesInTopologicalOrder(execution_order)) {
+    const Node* node = graph_viewer.GetNode(node_index);
+    for (const auto* arg : node->OutputDefs()) {
+      int ort_value_idx = -1;
+      if (arg->Exists() && ort_value_name_idx_map.GetIdx(arg->Name(), ort_value_idx).IsOK()) {
+        add_planned_value(*arg, ort_value_idx);
+      }
+    }
+
+    if (node_index >= plan.node_release_list.size()) {
+      continue;
+    }
+    for (const size_t release_idx : plan.node_release_list[node_index]) {
+      const auto& action = plan.release_actions[release_idx];
+      const auto it = planned_value_indices.find(static_cast<int>(action.value_index));
+      if (action.ref_count == 1 && it != planned_value_indices.end()) {
+        pattern->events_.push_back({true, it->second});
+      }
+    }
+  }
+
+  if (pattern->planned_values_.empty()) {
+    return nullptr;
+  }
+  return pattern;
+}
+
+Status SymbolicMemoryPattern::ResolveDimParams(gsl::span<const OrtValue> feeds, gsl::span<const int> feed_mlvalue_idxs,
+                                               InlinedVector<int64_t>& dim_values) const {
+  dim_values.clear();
+  dim_values.reserve(dim_param_sources_.size());
+  for (const auto& sources : dim_param_sources_) {
+    int64_t dim_value = -1;
+    for (const auto& source : sources) {
+      const auto feed = std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), source.ort_value_idx);
+      ORT_RETURN_IF(feed == feed_mlvalue_idxs.end(), "Graph input with a symbolic dimension is not fed.");
+      const OrtValue& value = feeds[static_cast<size_t>(feed - feed_mlvalue_idxs.begin())];
+      ORT_RETURN_IF_NOT(value.IsTensor(), "Graph input with a symbolic dimension is not a tensor.");
+      const auto& shape = value.Get<Tensor>().Shape();
+      ORT_RETURN_IF(shape.NumDimensions() != source.rank, "Rank of the feed doesn't match the graph input: ",
+                    shape.NumDimensions(), " != ", source.rank);
+      const int64_t value_dim = shape[source.axis];
+      ORT_RETURN_IF(dim_value != -1 && dim_value != value_dim,
+                    "The feeds have different values for the same symbolic dimension: ", dim_value, " != ",
+                    value_dim);
+      dim_value = value_dim;
+    }
+    dim_values.push_back(dim_value);
+  }
+  return Status::OK();
+}
+
+Status SymbolicMemoryPattern::GeneratePatterns(gsl::span<const int64_t> dim_values, MemoryPatternGroup& out) const {
+  ORT_RETURN_IF_NOT(dim_values.size() == dim_param_sources_.size(), "Expected ", dim_param_sources_.size(),
+                    " symbolic dimension values, got ", dim_values.size());
+
+  OrtValuePatternPlanner mem_planner(plan_);
+  TensorShapeVector dims;
+  for (const auto& event : events_) {
+    const PlannedValue& planned_value = planned_values_[event.planned_value];
+    if (event.is_free) {
+      ORT_RETURN_IF_ERROR(mem_planner.TraceFree(planned_value.ort_value_idx));
+      continue;
+    }
+
+    dims.clear();
+    for (const int64_t dim : planned_value.dims) {
+      dims.push_back(dim >= 0 ? dim : dim_values[static_cast<size_t>(-1 - dim)]);
+    }
+    // the same size as the one the frame allocates, so that the blocks are used
+    size_t size = 0;
+    ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(planned_value.element_type, TensorShape(dims),
+                                                           kAllocAlignment, size));
+    ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(planned_value.ort_value_idx, size));
+  }
+
+  return mem_planner.GeneratePatterns(out);
+}
+
+}  // namespace onnxruntime
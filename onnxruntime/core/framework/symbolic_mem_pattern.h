@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+/**
+ * Memory pattern of the activations of a graph whose shapes are known up to the symbolic dimensions of the graph
+ * inputs, e.g. the sequence length of NLP models, enabled with kOrtSessionOptionsSymbolicMemoryPatterns.
+ *
+ * The allocations and frees of a run are compiled once from the execution plan: the size of every activation is a
+ * product of its fixed dimensions and of the dim_params of the graph inputs. Generating the memory pattern of a run
+ * only resolves the dim_params from the shapes of the feeds and replays the allocations and frees with the resulting
+ * sizes, so a run with new input shapes gets a memory pattern right away instead of recording one in a first run.
+ *
+ * The activations whose shapes depend on data, e.g. the output of NonZero, are not planned and are allocated when
+ * they are produced.
+ */
+class SymbolicMemoryPattern {
+ public:
+  // Compiles the memory pattern of the execution plan created with execution_order. Returns nullptr if the plan
+  // can't be replayed statically, e.g. it has several streams, or if no activation has a size that depends only on
+  // the graph inputs.
+  static std::unique_ptr<SymbolicMemoryPattern> Create(const GraphViewer& graph_viewer,
+                                                       const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                       const SequentialExecutionPlan& plan,
+                                                       ExecutionOrder execution_order);
+
+  // Resolves the dim_params of the graph inputs from the feeds into dim_values.
+  Status ResolveDimParams(gsl::span<const OrtValue> feeds, gsl::span<const int> feed_mlvalue_idxs,
+                          InlinedVector<int64_t>& dim_values) const;
+
+  // Generates the memory pattern of a run with the dim_values returned by ResolveDimParams.
+  Status GeneratePatterns(gsl::span<const int64_t> dim_values, MemoryPatternGroup& out) const;
+
+  size_t NumPlannedValues() const { return planned_values_.size(); }
+
+ private:
+  explicit SymbolicMemoryPattern(const SequentialExecutionPlan& plan) : plan_{plan} {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SymbolicMemoryPattern);
+
+  // where the value of a dim_param is read from
+  struct DimParamSource {
+    int ort_value_idx;  // graph input
+    size_t rank;
+    size_t axis;
+  };
+
+  struct PlannedValue {
+    int ort_value_idx;
+    MLDataType element_type;
+    // dim_value, or -1 - index of the dim_param in dim_param_sources_
+    InlinedVector<int64_t> dims;
+  };
+
+  struct Event {
+    bool is_free;
+    size_t planned_value;  // index in planned_values_
+  };
+
+  const SequentialExecutionPlan& plan_;
+  // every source of a dim_param must have the same value
+  InlinedVector<InlinedVector<DimParamSource, 1>> dim_param_sources_;
+  std::vector<PlannedValue> planned_values_;
+  // the allocations and frees in execution order
+  std::vector<Event> events_;
+};
+
+}  // namespace onnxruntime
@@ -9,6 +9,7 @@
 #include "core/common/string_utils.h"
 #include "core/platform/path_lib.h"
 
+#include <numeric>
 #include <vector>
 
 #ifdef _WIN32
@@ -40,6 +41,23 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
       ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(stringmap.value(), external_data_info->length_));
     } else if (stringmap.key() == "checksum" && !stringmap.value().empty()) {
       external_data_info->checksum_ = stringmap.value();
+    } else if (stringmap.key() == "compression" && !stringmap.value().empty()) {
+      if (stringmap.value() == "zstd") {
+        external_data_info->compression_info_.compression = Compression::kZstd;
+      } else if (stringmap.value() == "lz4") {
+        external_data_info->compression_info_.compression = Compression::kLz4;
+      } else {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Unknown external data compression: ",
+                               stringmap.value());
+      }
+    } else if (stringmap.key() == "compression_chunk_size" && !stringmap.value().empty()) {
+      ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(stringmap.value(),
+                                                       external_data_info->compression_info_.chunk_size));
+    } else if (stringmap.key() == "compression_chunk_lengths" && !stringmap.value().empty()) {
+      auto& chunk_lengths = external_data_info->compression_info_.chunk_lengths;
+      for (const auto& chunk_length : utils::SplitString(stringmap.value(), ";", false)) {
+        ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(chunk_length, chunk_lengths.emplace_back()));
+      }
     } else if (stringmap.key().find("prepacked", 0) == 0) {
       // Starts with 'prepacked', each has its own key.
       // Each prepacked entry may have multiple blobs with the same key
@@ -79,6 +97,23 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Missing 'location'");
   }
 
+  if (external_data_info->IsCompressed()) {
+    const auto& compression_info = external_data_info->compression_info_;
+    if (compression_info.chunk_size == 0 || compression_info.chunk_lengths.empty()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "model format error! Compressed external data needs 'compression_chunk_size' and "
+                             "'compression_chunk_lengths'");
+    }
+    const size_t compressed_length = std::accumulate(compression_info.chunk_lengths.begin(),
+                                                     compression_info.chunk_lengths.end(), SafeInt<size_t>(0));
+    if (external_data_info->length_ != 0 && external_data_info->length_ != compressed_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! The 'length' ", external_data_info->length_,
+                             " of compressed external data does not match the total chunk length ",
+                             compressed_length);
+    }
+    external_data_info->length_ = compressed_length;
+  }
+
   if (!prepacked_infos.empty()) {
     external_data_info->prepacked_infos_ = std::move(prepacked_infos);
   }
@@ -104,6 +139,32 @@ void ExternalDataInfo::SetExternalLocationToProto(const std::filesystem::path& e
   length->set_value(std::to_string(tensor_bytes_size));
 }
 
+void ExternalDataInfo::SetCompressionInfoToProto(const CompressionInfo& compression_info,
+                                                 ::ONNX_NAMESPACE::TensorProto& proto) {
+  if (compression_info.compression == Compression::kNone) {
+    return;
+  }
+
+  auto* compression = proto.add_external_data();
+  compression->set_key("compression");
+  compression->set_value(compression_info.compression == Compression::kZstd ? "zstd" : "lz4");
+
+  auto* chunk_size = proto.add_external_data();
+  chunk_size->set_key("compression_chunk_size");
+  chunk_size->set_value(std::to_string(compression_info.chunk_size));
+
+  std::string chunk_lengths_value;
+  for (size_t i = 0; i < compression_info.chunk_lengths.size(); ++i) {
+    if (i > 0) {
+      chunk_lengths_value.append(";");
+    }
+    chunk_lengths_value.append(std::to_string(compression_info.chunk_lengths[i]));
+  }
+  auto* chunk_lengths = proto.add_external_data();
+  chunk_lengths->set_key("compression_chunk_lengths");
+  chunk_lengths->set_value(std::move(chunk_lengths_value));
+}
+
 std::ostream& ExternalDataInfo::WritePrepackedToFileAndAddToProto(
     const PrepackedWeightsForGraph& prepacked_for_graph,
     const InlinedHashSet<std::string>& blob_keys, bool align,
@@ -7,6 +7,7 @@
 #include <ostream>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <core/common/inlined_containers_fwd.h>
 #include "core/common/path_string.h"
@@ -32,6 +33,29 @@ class ExternalDataInfo {
 
   const std::string& GetChecksum() const { return checksum_; }
 
+  enum class Compression {
+    kNone,
+    kZstd,
+    kLz4,
+  };
+
+  // The data of a compressed tensor is split into chunks of chunk_size uncompressed bytes, the last one possibly
+  // smaller, which are compressed independently and stored one after the other from the offset, so that they can be
+  // decompressed in parallel. The length is the total compressed size.
+  //
+  // Recorded in the external data with the keys
+  //   compression:               "zstd" or "lz4"
+  //   compression_chunk_size:    chunk_size
+  //   compression_chunk_lengths: the compressed size of each chunk, separated by ';'
+  struct CompressionInfo {
+    Compression compression = Compression::kNone;
+    size_t chunk_size = 0;
+    std::vector<size_t> chunk_lengths;
+  };
+
+  bool IsCompressed() const noexcept { return compression_info_.compression != Compression::kNone; }
+  const CompressionInfo& GetCompressionInfo() const noexcept { return compression_info_; }
+
   static common::Status Create(
       const ::google::protobuf::RepeatedPtrField<::ONNX_NAMESPACE::StringStringEntryProto>& input,
       std::unique_ptr<ExternalDataInfo>& out);
@@ -78,6 +102,9 @@ class ExternalDataInfo {
 
   PrepackedInfos&& TakePrepackedInfos() { return std::move(prepacked_infos_); }
 
+  static void SetCompressionInfoToProto(const CompressionInfo& compression_info,
+                                        ::ONNX_NAMESPACE::TensorProto& proto);
+
  private:
   PathString rel_path_;
   OFFSET_TYPE offset_ = 0;
@@ -89,5 +116,7 @@ class ExternalDataInfo {
   // Pre-packed blobs found associated with this TensorProto if present
   // format key, offset, length, checksum
   PrepackedInfos prepacked_infos_;
+
+  CompressionInfo compression_info_;
 };
 }  // namespace onnxruntime
@@ -6,8 +6,12 @@
 #include <memory>
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <filesystem>
+#include <tuple>
 #if defined(__wasm__)
 #include <emscripten.h>
 #endif
@@ -24,6 +28,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_types.h"
+#include "core/framework/external_data_decompression.h"
 #include "core/platform/path_lib.h"
 #include "core/framework/to_tensor_proto_element_type.h"
 #include "core/session/ort_apis.h"
@@ -175,10 +180,21 @@ Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
-  ORT_RETURN_IF_ERROR(
-      GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_file_path, file_offset, tensor_byte_size));
+  ExternalDataInfo::CompressionInfo compression_info;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_file_path, file_offset,
+                                          tensor_byte_size, nullptr, &compression_info));
 
   unpacked_tensor.resize(tensor_byte_size);
+  if (external_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    // the value in location is the memory address of the data
+    std::memcpy(unpacked_tensor.data(), reinterpret_cast<const void*>(file_offset), tensor_byte_size);
+    return Status::OK();
+  }
+  if (compression_info.compression != ExternalDataInfo::Compression::kNone) {
+    return DecompressExternalData(
+        onnxruntime::Env::Default(), external_file_path.c_str(), file_offset, compression_info,
+        gsl::make_span(reinterpret_cast<char*>(unpacked_tensor.data()), tensor_byte_size), nullptr);
+  }
   ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
       external_file_path.c_str(),
       file_offset,
@@ -235,7 +251,8 @@ Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                            std::basic_string<ORTCHAR_T>& external_file_path,
                            onnxruntime::FileOffsetType& file_offset,
                            SafeInt<size_t>& tensor_byte_size,
-                           ExternalDataInfo::PrepackedInfos* prepacked_infos) {
+                           ExternalDataInfo::PrepackedInfos* prepacked_infos,
+                           ExternalDataInfo::CompressionInfo* compression_info) {
   ORT_RETURN_IF_NOT(onnxruntime::utils::HasExternalData(tensor_proto),
                     "Tensor does not have external data to read from.");
 
@@ -251,7 +268,19 @@ Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                                                                     : (tensor_proto_dir / location);
 
   ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
-  const size_t external_data_length = external_data_info->GetLength();
+
+  if (external_data_info->IsCompressed()) {
+    ORT_RETURN_IF(compression_info == nullptr, "TensorProto: ", tensor_proto.name(),
+                  " has compressed external data, which is not supported here.");
+    ORT_RETURN_IF(location == onnxruntime::utils::kTensorProtoMemoryAddressTag,
+                  "TensorProto: ", tensor_proto.name(), " external data in memory can not be compressed.");
+    *compression_info = external_data_info->GetCompressionInfo();
+  } else if (compression_info != nullptr) {
+    *compression_info = ExternalDataInfo::CompressionInfo{};
+  }
+
+  // the length of compressed data is its compressed size
+  const size_t external_data_length = external_data_info->IsCompressed() ? 0 : external_data_info->GetLength();
   ORT_RETURN_IF_NOT(external_data_length == 0 || external_data_length == tensor_byte_size,
                     "TensorProto: ", tensor_proto.name(),
                     " external data size mismatch. Computed size: ", *&tensor_byte_size,
@@ -1030,13 +1059,82 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
   raw_buffer = buffer.release();
   return Status::OK();
 }
+
+namespace {
+// Process-wide registry of external data file mappings. Sessions that load the same external initializers get the
+// same mapped pages instead of mapping (or copying) the data once per session.
+// The registry only holds weak references; a mapping is unmapped once the last initializer using it is released.
+class SharedExternalDataMappings {
+ public:
+  static SharedExternalDataMappings& Instance() {
+    static SharedExternalDataMappings instance;
+    return instance;
+  }
+
+  Status GetFileContent(const Env& env, const std::filesystem::path& file_path, FileOffsetType offset,
+                        size_t length, void*& raw_buffer, OrtCallback& deleter) {
+    std::error_code error_code;
+    std::filesystem::path canonical_path = std::filesystem::weakly_canonical(file_path, error_code);
+    Key key{error_code ? file_path.native() : canonical_path.native(), offset, length};
+
+    std::shared_ptr<char> mapping;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = mappings_.find(key);
+      if (it != mappings_.end()) {
+        mapping = it->second.lock();
+      }
+
+      if (!mapping) {
+        Env::MappedMemoryPtr mapped_memory{};
+        ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path.native().c_str(), offset, length, mapped_memory));
+        ORT_RETURN_IF(mapped_memory == nullptr, "Failed to map external data file: ", file_path);
+
+        OrtCallback unmap = mapped_memory.get_deleter().callback;
+        mapping = std::shared_ptr<char>(mapped_memory.release(), [this, key, unmap](char*) {
+          if (unmap.f != nullptr) {
+            unmap.f(unmap.param);
+          }
+          Erase(key);
+        });
+        mappings_[key] = mapping;
+      }
+    }
+
+    raw_buffer = mapping.get();
+    deleter = OrtCallback{ReleaseMapping, new std::shared_ptr<char>(std::move(mapping))};
+    return Status::OK();
+  }
+
+ private:
+  using Key = std::tuple<std::filesystem::path::string_type, FileOffsetType, size_t>;
+
+  static void ReleaseMapping(void* param) noexcept {
+    delete reinterpret_cast<std::shared_ptr<char>*>(param);
+  }
+
+  void Erase(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mappings_.find(key);
+    // the same data may have been mapped again since the last reference was dropped
+    if (it != mappings_.end() && it->second.expired()) {
+      mappings_.erase(it);
+    }
+  }
+
+  std::mutex mutex_;
+  std::map<Key, std::weak_ptr<char>> mappings_;
+};
+}  // namespace
 #endif
 
 Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& model_path,
                                  const ONNX_NAMESPACE::TensorProto& tensor_proto, void*& ext_data_buf,
                                  SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter,
                                  Tensor* buffered_tensor,
-                                 PrepackedWeightsForGraph* prepacked_info) {
+                                 PrepackedWeightsForGraph* prepacked_info,
+                                 bool use_shared_mapping,
+                                 concurrency::ThreadPool* thread_pool) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
   std::basic_string<ORTCHAR_T> tensor_proto_dir;
   if (!model_path.empty()) {
@@ -1049,9 +1147,12 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
   if (prepacked_info != nullptr) {
     prepacked_infos.emplace();
   }
+  ExternalDataInfo::CompressionInfo compression_info;
   ORT_RETURN_IF_ERROR(
       GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_data_file_path, file_offset,
-                          raw_data_safe_len, (prepacked_info != nullptr) ? &*prepacked_infos : nullptr));
+                          raw_data_safe_len, (prepacked_info != nullptr) ? &*prepacked_infos : nullptr,
+                          &compression_info));
+  const bool is_compressed = compression_info.compression != ExternalDataInfo::Compression::kNone;
 
   if (external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
     // the value in location is the memory address of the data
@@ -1065,6 +1166,10 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
     }
   } else {
 #if defined(__wasm__)
+    ORT_UNUSED_PARAMETER(use_shared_mapping);
+    ORT_UNUSED_PARAMETER(thread_pool);
+    ORT_RETURN_IF(is_compressed, "External initializer: ", tensor_proto.name(),
+                  " compressed external data is not supported in WebAssembly.");
     ORT_RETURN_IF(file_offset < 0 || file_offset + raw_data_safe_len >= 4294967296,
                   "External initializer: ", tensor_proto.name(), " offset: ", file_offset,
                   " size to read: ", static_cast<size_t>(raw_data_safe_len),
@@ -1086,14 +1191,32 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
     // manually check file size first.
     std::uintmax_t file_length = std::filesystem::file_size(external_data_file_path);
 
+    // compressed data is stored in the file as the sum of its chunks
+    const size_t size_to_read = is_compressed
+                                    ? static_cast<size_t>(std::accumulate(compression_info.chunk_lengths.begin(),
+                                                                          compression_info.chunk_lengths.end(),
+                                                                          SafeInt<size_t>(0)))
+                                    : static_cast<size_t>(raw_data_safe_len);
     SafeInt<FileOffsetType> end_of_read(file_offset);
-    end_of_read += raw_data_safe_len;
+    end_of_read += size_to_read;
     ORT_RETURN_IF(file_offset < 0 || static_cast<std::uintmax_t>(end_of_read) > file_length,
                   "External initializer: ", tensor_proto.name(), " offset: ", file_offset,
-                  " size to read: ", static_cast<size_t>(raw_data_safe_len), " given file_length: ", file_length,
+                  " size to read: ", size_to_read, " given file_length: ", file_length,
                   " are out of bounds or can not be read in full.");
-    ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
-                                       ext_data_buf, ext_data_deleter));
+    if (is_compressed) {
+      // the decompressed data can't be mapped, so it is never shared
+      auto buffer = std::make_unique<char[]>(raw_data_safe_len);
+      ORT_RETURN_IF_ERROR(DecompressExternalData(env, external_data_file_path.c_str(), file_offset, compression_info,
+                                                 gsl::make_span(buffer.get(), raw_data_safe_len), thread_pool));
+      ext_data_deleter = OrtCallback{DeleteCharArray, buffer.get()};
+      ext_data_buf = buffer.release();
+    } else if (use_shared_mapping && raw_data_safe_len > 0) {
+      ORT_RETURN_IF_ERROR(SharedExternalDataMappings::Instance().GetFileContent(
+          env, external_data_file_path.c_str(), file_offset, raw_data_safe_len, ext_data_buf, ext_data_deleter));
+    } else {
+      ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
+                                         ext_data_buf, ext_data_deleter));
+    }
     ext_data_len = raw_data_safe_len;
 
     if (prepacked_info != nullptr && !prepacked_infos->empty()) {
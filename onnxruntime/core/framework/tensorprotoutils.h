@@ -23,6 +23,10 @@
 #include "core/platform/env.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace utils {
 /**
  * This function is used to get the external data info from the given tensor proto.
@@ -31,6 +35,10 @@ namespace utils {
  * @param external_file_path output external file path
  * @param file_offset        output tensor offset
  * @param tensor_byte_size   output tensor byte size
+ * @param prepacked_infos    optional output pre-packed blobs stored with the tensor
+ * @param compression_info   optional output compression of the data. If the data is compressed, tensor_byte_size is
+ *                           its uncompressed size, and the caller must decompress it with DecompressExternalData.
+ *                           Fails for compressed data if null.
  * @returns                  Status::OK() if the function is executed successfully
  */
 Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
@@ -38,7 +46,8 @@ Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                            std::basic_string<ORTCHAR_T>& external_file_path,
                            onnxruntime::FileOffsetType& file_offset,
                            SafeInt<size_t>& tensor_byte_size,
-                           ExternalDataInfo::PrepackedInfos* prepacked_infos = nullptr);
+                           ExternalDataInfo::PrepackedInfos* prepacked_infos = nullptr,
+                           ExternalDataInfo::CompressionInfo* compression_info = nullptr);
 /**
  * This function is used to convert the endianess of Tensor data.
  * If ext_data_buf is provided, then this buffer content's endianess
@@ -179,12 +188,19 @@ constexpr const ORTCHAR_T* kTensorProtoMemoryAddressTag = ORT_TSTR("*/_ORT_MEM_A
 // buffered_tensor is not null, buffered_tensor holds the real buffer pointed
 // by tensor_proto. buffered_tensor must be the owner of the buffer and deleter
 // should release the buffer when tensor_proto is released.
+// If use_shared_mapping is true the data is served from a process-wide registry of file mappings keyed by
+// file path, offset and length, so every caller asking for the same external data gets the same read-only pages.
+// The caller must not write to the returned buffer in that case.
+// Compressed external data is decompressed into a buffer owned by ext_data_deleter, in parallel over thread_pool if
+// not null, and is never shared.
 common::Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& model_path,
                                          const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                          void*& ext_data_buf, SafeInt<size_t>& ext_data_len,
                                          OrtCallback& ext_data_deleter,
                                          Tensor* buffered_tensor = nullptr,
-                                         PrepackedWeightsForGraph* prepacked_for_graph = nullptr);
+                                         PrepackedWeightsForGraph* prepacked_for_graph = nullptr,
+                                         bool use_shared_mapping = false,
+                                         concurrency::ThreadPool* thread_pool = nullptr);
 
 // Given a tensor proto with external data obtain a tensor using the specified custom external data loader.
 common::Status LoadExtDataToTensorFromTensorProto(const Env& env, const std::filesystem::path& model_path,
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include "core/framework/copy.h"
-#include "core/framework/element_type_lists.h"
 #include "core/framework/transpose_helper.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -57,6 +55,210 @@ typename std::enable_if<has_mlas_transpose<T>::value, void>::type SimpleTranspos
   }
 }
 
+namespace {
+
+// Tile of the two innermost axes moved by a permutation. The tile of the input and the tile of the output both fit
+// in the L1 cache for elements of up to 4 bytes.
+constexpr size_t kTransposeTileSize = 64;
+
+// Transposes a M x N tile of elements of an arbitrary size.
+template <typename T>
+void TransposeTile(const T* input, size_t input_stride, T* output, size_t output_stride, size_t M, size_t N) {
+  for (size_t n = 0; n < N; ++n) {
+    const T* s = input + n;
+    T* d = output + n * output_stride;
+    for (size_t m = 0; m < M; ++m) {
+      d[m] = *s;
+      s += input_stride;
+    }
+  }
+}
+
+template <>
+void TransposeTile<uint8_t>(const uint8_t* input, size_t input_stride, uint8_t* output, size_t output_stride,
+                            size_t M, size_t N) {
+  MlasTranspose(input, input_stride, output, output_stride, M, N);
+}
+
+template <>
+void TransposeTile<uint16_t>(const uint16_t* input, size_t input_stride, uint16_t* output, size_t output_stride,
+                             size_t M, size_t N) {
+  MlasTranspose(input, input_stride, output, output_stride, M, N);
+}
+
+template <>
+void TransposeTile<uint32_t>(const uint32_t* input, size_t input_stride, uint32_t* output, size_t output_stride,
+                             size_t M, size_t N) {
+  MlasTranspose(input, input_stride, output, output_stride, M, N);
+}
+
+void TransposeTileBytes(const uint8_t* input, size_t input_stride, uint8_t* output, size_t output_stride,
+                        size_t M, size_t N, size_t element_size) {
+  switch (element_size) {
+    case sizeof(uint8_t):
+      TransposeTile(input, input_stride, output, output_stride, M, N);
+      break;
+    case sizeof(uint16_t):
+      TransposeTile(reinterpret_cast<const uint16_t*>(input), input_stride,
+                    reinterpret_cast<uint16_t*>(output), output_stride, M, N);
+      break;
+    case sizeof(uint32_t):
+      TransposeTile(reinterpret_cast<const uint32_t*>(input), input_stride,
+                    reinterpret_cast<uint32_t*>(output), output_stride, M, N);
+      break;
+    case sizeof(uint64_t):
+      TransposeTile(reinterpret_cast<const uint64_t*>(input), input_stride,
+                    reinterpret_cast<uint64_t*>(output), output_stride, M, N);
+      break;
+    default:
+      for (size_t n = 0; n < N; ++n) {
+        for (size_t m = 0; m < M; ++m) {
+          memcpy(output + (n * output_stride + m) * element_size,
+                 input + (m * input_stride + n) * element_size, element_size);
+        }
+      }
+      break;
+  }
+}
+
+// Computes the input offset of the output position `index` over the axes in `dims`.
+size_t ComputeInputOffset(size_t index, gsl::span<const size_t> dims, gsl::span<const size_t> input_strides) {
+  size_t offset = 0;
+  for (size_t axis = dims.size(); axis-- > 0;) {
+    offset += (index % dims[axis]) * input_strides[axis];
+    index /= dims[axis];
+  }
+  return offset;
+}
+
+}  // namespace
+
+//  `input_shape_override` overrides the shape of `input` for compute purposes.
+void BlockedTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
+  const auto input_dims = input_shape.GetDims();
+  const size_t rank = input_dims.size();
+
+  const size_t element_size = input.DataType()->Size();
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+
+  // Describe the transpose in the order of the output axes: the size of the axis and the stride of the matching
+  // input axis. The axes of size 1 are dropped and the output axes that are also adjacent in the input are merged.
+  InlinedVector<size_t> input_pitches(rank);
+  for (size_t i = rank, pitch = 1; i-- > 0;) {
+    input_pitches[i] = pitch;
+    pitch *= narrow<size_t>(input_dims[i]);
+  }
+
+  InlinedVector<size_t> dims;
+  InlinedVector<size_t> input_strides;
+  for (size_t i = 0; i < rank; ++i) {
+    const size_t dim = narrow<size_t>(input_dims[permutations[i]]);
+    const size_t stride = input_pitches[permutations[i]];
+    if (dim == 1) {
+      continue;
+    }
+    if (!dims.empty() && input_strides.back() == stride * dim) {
+      dims.back() *= dim;
+      input_strides.back() = stride;
+    } else {
+      dims.push_back(dim);
+      input_strides.push_back(stride);
+    }
+  }
+
+  const size_t num_axes = dims.size();
+
+  if (num_axes <= 1) {
+    memcpy(output_data, input_data, narrow<size_t>(input_shape.Size()) * element_size);
+    return;
+  }
+
+  const size_t inner_axis = num_axes - 1;
+
+  if (input_strides[inner_axis] == 1) {
+    // The innermost axis is not moved: copy contiguous blocks of the innermost axis.
+    const size_t block_size = dims[inner_axis] * element_size;
+    const size_t num_blocks = narrow<size_t>(input_shape.Size()) / dims[inner_axis];
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_blocks),
+        {static_cast<double>(block_size), static_cast<double>(block_size), static_cast<double>(block_size) / 16},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t block = first; block < last; ++block) {
+            const size_t offset = ComputeInputOffset(static_cast<size_t>(block),
+                                                     gsl::make_span(dims).first(inner_axis),
+                                                     gsl::make_span(input_strides).first(inner_axis));
+            memcpy(output_data + static_cast<size_t>(block) * block_size, input_data + offset * element_size,
+                   block_size);
+          }
+        });
+    return;
+  }
+
+  // The innermost axis of the output is read with a stride, and the innermost axis of the input is the output axis
+  // with an input stride of 1. These two axes are transposed in tiles, and the tiles of the other axes are
+  // partitioned among the threads.
+  size_t input_inner_axis = 0;
+  while (input_strides[input_inner_axis] != 1) {
+    ++input_inner_axis;
+  }
+
+  InlinedVector<size_t> output_pitches(num_axes);
+  for (size_t i = num_axes, pitch = 1; i-- > 0;) {
+    output_pitches[i] = pitch;
+    pitch *= dims[i];
+  }
+
+  const size_t M = dims[inner_axis];
+  const size_t N = dims[input_inner_axis];
+  const size_t input_stride = input_strides[inner_axis];
+  const size_t output_stride = output_pitches[input_inner_axis];
+
+  const size_t tile_size = element_size <= sizeof(uint32_t) ? kTransposeTileSize : kTransposeTileSize / 2;
+  const size_t tiles_m = (M + tile_size - 1) / tile_size;
+  const size_t tiles_n = (N + tile_size - 1) / tile_size;
+  const size_t num_outer = narrow<size_t>(input_shape.Size()) / (M * N);
+  const size_t num_tiles = num_outer * tiles_n * tiles_m;
+
+  const double tile_bytes = static_cast<double>(std::min(M, tile_size) * std::min(N, tile_size) * element_size);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_tiles), {tile_bytes, tile_bytes, tile_bytes / 4},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+          const size_t tile_m = static_cast<size_t>(tile) % tiles_m;
+          const size_t tile_n = (static_cast<size_t>(tile) / tiles_m) % tiles_n;
+          const size_t outer = static_cast<size_t>(tile) / (tiles_m * tiles_n);
+
+          // the output offset of the outer axes is recovered from the input offset of the same position
+          size_t input_offset = 0;
+          size_t output_offset = 0;
+          size_t index = outer;
+          for (size_t axis = num_axes; axis-- > 0;) {
+            if (axis == inner_axis || axis == input_inner_axis) {
+              continue;
+            }
+            const size_t i = index % dims[axis];
+            input_offset += i * input_strides[axis];
+            output_offset += i * output_pitches[axis];
+            index /= dims[axis];
+          }
+
+          const size_t m = tile_m * tile_size;
+          const size_t n = tile_n * tile_size;
+          input_offset += m * input_stride + n;
+          output_offset += n * output_stride + m;
+
+          TransposeTileBytes(input_data + input_offset * element_size, input_stride,
+                             output_data + output_offset * element_size, output_stride,
+                             std::min(M - m, tile_size), std::min(N - n, tile_size), element_size);
+        }
+      });
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 void TransposeSingleAxisOutwards(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
                                  size_t from, size_t to, const TensorShape* input_shape_override = nullptr,
@@ -104,20 +306,8 @@ void TransposeSingleAxisOutwards(gsl::span<const size_t> permutations, const Ten
       break;
     }
     default: {
-      TensorPitches src_strides(input_dims);
-
-      TensorPitches contig_dst_strides(output);
-
-      const auto dims = input_dims.size();
-      TensorShapeVector dst_strides(dims);
-      for (size_t dim = 0; dim < dims; ++dim) {
-        dst_strides[permutations[dim]] = contig_dst_strides[dim];
-      }
-
-      ORT_THROW_IF_ERROR(DispatchStridedCopy<element_type_lists::All>(tp,
-                                                                      output, 0, dst_strides,
-                                                                      input_shape,
-                                                                      input, 0, src_strides));
+      // copy the blocks with multiple threads
+      BlockedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 }
@@ -162,7 +352,8 @@ typename std::enable_if<has_mlas_transpose<T>::value, void>::type SimpleTranspos
 // moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 void TransposeSingleAxisInwards(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to, const TensorShape* input_shape_override = nullptr) {
+                                size_t from, size_t to, const TensorShape* input_shape_override = nullptr,
+                                concurrency::ThreadPool* tp = nullptr) {
   ORT_UNUSED_PARAMETER(permutations);
 
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
@@ -206,26 +397,8 @@ void TransposeSingleAxisInwards(gsl::span<const size_t> permutations, const Tens
       break;
     }
     default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (int64_t rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
-
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
-
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
-          }
-
-          input_for_first_reader += bytes_per_read;
-        }
-
-        input_data += reads_per_loop * bytes_per_read;
-      }
+      // copy the blocks with multiple threads
+      BlockedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 }
@@ -236,7 +409,7 @@ void SingleAxisTranspose(gsl::span<const size_t> permutations, const Tensor& inp
   if (from > to) {
     TransposeSingleAxisOutwards(permutations, input, output, from, to, input_shape_override, tp);
   } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to, input_shape_override);
+    TransposeSingleAxisInwards(permutations, input, output, from, to, input_shape_override, tp);
   }
 }
 
@@ -27,6 +27,12 @@ We use simple pointer arithmetic if the size of each read/write is a power of 2
 We use memcpy if the block size is larger.
 
 We fall back to the default implementation in all other cases, and if the input is std::string.
+
+BlockedTranspose handles any permutation of a tensor that is not std::string. The axes of size 1 are dropped and the
+axes that stay adjacent are merged first. If the innermost axis is not moved, contiguous blocks are copied. Otherwise
+the innermost axis of the input and the innermost axis of the output are transposed in tiles that fit in the cache,
+with the vectorized MLAS kernels for elements of 1, 2 and 4 bytes. The blocks or tiles are partitioned among the
+threads of the thread pool.
 */
 
 #include <sstream>
@@ -44,4 +50,6 @@ bool IsTransposeMovingSingleAxis(gsl::span<const size_t> permutations, size_t& f
 void SingleAxisTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output, size_t from,
                          size_t to, const TensorShape* input_shape_override = nullptr,
                          concurrency::ThreadPool* tp = nullptr);
+void BlockedTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override = nullptr, concurrency::ThreadPool* tp = nullptr);
 }  // namespace onnxruntime
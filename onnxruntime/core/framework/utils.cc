@@ -104,6 +104,13 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
                              p_data,
                              allocator, target_mlvalue);
       }
+    } else if (target_stream && allocator->IsStreamAware()) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      void* p_data = allocator->AllocOnStream(len, target_stream);
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           p_data,
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -732,36 +739,57 @@ ExecuteGraphImpl(const SessionState& session_state,
   return Status::OK();
 }
 
-common::Status ExecuteGraph(const SessionState& session_state,
-                            FeedsFetchesManager& feeds_fetches_manager,
-                            gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
-                            ExecutionMode execution_mode, const bool& terminate_flag,
-                            const logging::Logger& logger,
+static common::Status
+ExecuteMainGraph(const SessionState& session_state,
+                 FeedsFetchesManager& feeds_fetches_manager,
+                 gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                 const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                 ExecutionMode execution_mode, const bool& terminate_flag,
+                 const logging::Logger& logger,
 #ifdef ORT_ENABLE_STREAM
-                            DeviceStreamCollectionHolder& device_stream_collection_holder,
+                 DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            bool only_execute_path_to_fetches,
-                            Stream* parent_stream) {
+                 bool only_execute_path_to_fetches,
+                 Stream* parent_stream) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
-  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
                                  parent_stream);
   return retval;
 #else
-  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
                           parent_stream);
 #endif
 }
 
+common::Status ExecuteGraph(const SessionState& session_state,
+                            FeedsFetchesManager& feeds_fetches_manager,
+                            gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                            ExecutionMode execution_mode, const bool& terminate_flag,
+                            const logging::Logger& logger,
+#ifdef ORT_ENABLE_STREAM
+                            DeviceStreamCollectionHolder& device_stream_collection_holder,
+#endif
+                            bool only_execute_path_to_fetches,
+                            Stream* parent_stream) {
+  return ExecuteMainGraph(session_state, feeds_fetches_manager, feeds, fetches, {},
+                          execution_mode, terminate_flag, logger,
+#ifdef ORT_ENABLE_STREAM
+                          device_stream_collection_holder,
+#endif
+                          only_execute_path_to_fetches,
+                          parent_stream);
+}
+
 common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
@@ -782,6 +810,29 @@ common::Status ExecuteGraph(const SessionState& session_state,
                       run_options.only_execute_path_to_fetches);
 }
 
+common::Status ExecuteGraph(const SessionState& session_state,
+                            FeedsFetchesManager& feeds_fetches_manager,
+                            gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                            ExecutionMode execution_mode, const RunOptions& run_options,
+#ifdef ORT_ENABLE_STREAM
+                            DeviceStreamCollectionHolder& device_stream_collection_holder,
+#endif
+                            const logging::Logger& logger) {
+  return ExecuteMainGraph(session_state,
+                          feeds_fetches_manager,
+                          feeds, fetches,
+                          fetch_allocators,
+                          execution_mode,
+                          run_options.terminate,
+                          logger,
+#ifdef ORT_ENABLE_STREAM
+                          device_stream_collection_holder,
+#endif
+                          run_options.only_execute_path_to_fetches,
+                          nullptr);
+}
+
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraphImpl(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                                        std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
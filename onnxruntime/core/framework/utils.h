@@ -98,6 +98,17 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
 #endif
                             const logging::Logger& logger);
 
+// Same as above, with custom allocators for some of the fetches, keyed by the index of the fetch.
+// See IExecutor::CustomAllocator.
+common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
+                            gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                            ExecutionMode execution_mode, const RunOptions& run_options,
+#ifdef ORT_ENABLE_STREAM
+                            DeviceStreamCollectionHolder& device_stream_collection_holder,
+#endif
+                            const logging::Logger& logger);
+
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                                    std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
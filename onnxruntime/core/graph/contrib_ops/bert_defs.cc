@@ -278,11 +278,21 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
   }
 
   if (ctx.getNumOutputs() > 1) {  // has present output
-    // copy the type from query to present key
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+    // The KV cache of GroupQueryAttention may be int8, so the type of present state comes from past state if any.
+    const size_t past_key_input = static_cast<size_t>(past_key_index);
+    const bool has_past = past_key_index >= 0 && ctx.hasInput(past_key_input);
 
-    // copy the type from query to present value
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+    // copy the type from past key (or query) to present key
+    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, has_past ? past_key_input : 0, 1);
+
+    // copy the type from past value (or query) to present value
+    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, has_past ? past_key_input + 1 : 0, 2);
+
+    // scales of an int8 KV cache
+    if (ctx.getNumOutputs() > 4 && ctx.hasInput(12) && ctx.hasInput(13)) {
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 12, 3);
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 13, 4);
+    }
 
     if (past_key_index >= 0 && hasInputShape(ctx, past_key_index)) {
       auto& past_shape = getInputShape(ctx, past_key_index);
@@ -293,7 +303,9 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
         fail_shape_inference("The past_key input shall be 4 dimensions");
       }
 
-      if (use_max_past_present_buffer == 1) {
+      // GroupQueryAttention with a paged KV cache (input 11 is block_table) updates the page pools in place.
+      const bool is_paged_kv_cache = past_key_index == 3 && ctx.hasInput(11);
+      if (use_max_past_present_buffer == 1 || is_paged_kv_cache) {
         // When past and present use max buffer, they have the same shape
         ONNX_NAMESPACE::propagateShapeFromInputToOutput(ctx, past_key_index, 1);
         ONNX_NAMESPACE::propagateShapeFromInputToOutput(ctx, static_cast<size_t>(past_key_index) + 1, 2);
@@ -1094,6 +1106,9 @@ Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
 Supports continuous decoding for batch_size == 1 for CPU and CUDA.
+Supports paged KV cache through the block_table input for CPU.
+Supports int8 KV cache for CPU: when past_key and past_value are int8, every token of a kv head is quantized in
+blocks of head_size / (the last dimension of past_key_scale) channels with one float scale per block.
 
 )DOC";
 
@@ -1146,13 +1161,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1184,6 +1199,26 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "additional add to QxK' with shape (batch_size or 1, num_heads or 1, sequence_length, total_sequence_length)",
                "T",
                OpSchema::Optional)
+        .Input(11,
+               "block_table",
+               "2D tensor with shape (batch_size, max_blocks_per_sequence) that maps the logical blocks of each sequence "
+               "to pages of a paged KV cache. When given, past_key and past_value are page pools with shape "
+               "(num_blocks, kv_num_heads, block_size, head_size) shared by all sequences, and present_key and "
+               "present_value are the updated page pools with the same shape. Currently only supported on CPU.",
+               "M",
+               OpSchema::Optional)
+        .Input(12,
+               "past_key_scale",
+               "Scales of an int8 past_key with shape (batch_size, kv_num_heads, past_sequence_length, "
+               "num_scale_blocks), where head_size is a multiple of num_scale_blocks. Required when past_key is int8. "
+               "Currently only supported on CPU.",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(13,
+               "past_value_scale",
+               "Scales of an int8 past_value with the same shape as past_key_scale. Required when past_value is int8.",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1193,14 +1228,27 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
+        .Output(3,
+                "present_key_scale",
+                "Scales of an int8 present_key with shape (batch_size, kv_num_heads, present_sequence_length, "
+                "num_scale_blocks). It may use the same tensor as past_key_scale.",
+                "tensor(float)",
+                OpSchema::Optional)
+        .Output(4,
+                "present_value_scale",
+                "Scales of an int8 present_value with the same shape as present_key_scale.",
+                "tensor(float)",
+                OpSchema::Optional)
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"},
+                        "Constrain KV cache to the type of query, or int8 for a quantized KV cache.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
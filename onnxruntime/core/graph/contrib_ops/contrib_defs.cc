@@ -631,6 +631,98 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a chain of elementwise operators in a single pass over the data.
+Step i applies ops[i] to the values operands[2 * i] and operands[2 * i + 1]. Values 0 to N - 1 are the N inputs and
+value N + i is the result of step i. The second operand of a unary operator is -1. The output is the result of the
+last step. The first input has the shape of the output. Every other input either holds a single element or, without
+its leading dimensions of 1, has the trailing dimensions of the first input.
+)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops",
+              "The operator of every step: Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, Neg, Abs, Sqrt, "
+              "Reciprocal or Erf.",
+              AttributeProto::STRINGS)
+        .Attr("operands", "The indices of the two values every step applies its operator to.", AttributeProto::INTS)
+        .Input(0, "inputs", "The inputs of the chain. The first one has the shape of the output.", "T",
+               OpSchema::Variadic)
+        .Output(0, "Y", "The result of the last step.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* MultiLoRAMatMul_ver1_doc = R"DOC(
+MatMul of a batch with a base weight, where every batch entry adds the low-rank update of its own LoRA adapter:
+Y[b] = X[b] * W + (X[b] * lora_a[i]) * lora_b[i] with i = adapter_indices[b]. The entries with a negative index only
+use the base weight. The adapters are stacked along the first dimension of lora_a and lora_b, and consecutive entries
+that select the same adapter are computed together.
+)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MultiLoRAMatMul, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(MultiLoRAMatMul_ver1_doc)
+        .Input(0, "X", "The input with shape (batch_size, sequence_length, K).", "T")
+        .Input(1, "W", "The base weight with shape (K, N).", "T")
+        .Input(2, "lora_a", "The stacked A matrices of the adapters with shape (num_adapters, K, rank).", "T")
+        .Input(3, "lora_b", "The stacked B matrices of the adapters with shape (num_adapters, rank, N).", "T")
+        .Input(4, "adapter_indices", "The adapter of every batch entry with shape (batch_size), or -1 for none.", "T1")
+        .Output(0, "Y", "The output with shape (batch_size, sequence_length, N).", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("T1", {"tensor(int32)"}, "Constrain adapter_indices to int32 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (hasInputShape(ctx, 0) && hasInputShape(ctx, 1)) {
+            const auto& x_shape = getInputShape(ctx, 0);
+            const auto& w_shape = getInputShape(ctx, 1);
+            if (x_shape.dim_size() != 3 || w_shape.dim_size() != 2) {
+              fail_shape_inference("X is expected to have 3 dimensions and W 2 dimensions.");
+            }
+            ONNX_NAMESPACE::TensorShapeProto output_shape;
+            *output_shape.add_dim() = x_shape.dim(0);
+            *output_shape.add_dim() = x_shape.dim(1);
+            *output_shape.add_dim() = w_shape.dim(1);
+            updateOutputShape(ctx, 0, output_shape);
+          }
+        }));
+
+constexpr const char* GatedMLP_ver1_doc = R"DOC(
+The gated MLP block of SwiGLU and GeGLU models: Y = (activation(X * W_gate) * (X * W_up)) * W_down. W_gate and W_up
+are concatenated along their columns into W_gate_up, so both projections are one GEMM. The rows of X are processed in
+blocks, and the activation and the gating are applied in place, so only the gate and up values of the current block
+are kept instead of four intermediate tensors of the full hidden size.
+)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    GatedMLP, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(GatedMLP_ver1_doc)
+        .Attr("activation", "The activation of the gate: Silu or Gelu.", AttributeProto::STRING, std::string("Silu"))
+        .Input(0, "X", "The input with shape (..., K).", "T")
+        .Input(1, "W_gate_up", "The gate and up weights with shape (K, 2 * hidden_size), the gate columns first.", "T")
+        .Input(2, "W_down", "The down weight with shape (hidden_size, N).", "T")
+        .Output(0, "Y", "The output with shape (..., N).", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (hasInputShape(ctx, 0) && hasInputShape(ctx, 2)) {
+            const auto& x_shape = getInputShape(ctx, 0);
+            const auto& w_down_shape = getInputShape(ctx, 2);
+            if (x_shape.dim_size() < 1 || w_down_shape.dim_size() != 2) {
+              fail_shape_inference("X is expected to have at least 1 dimension and W_down 2 dimensions.");
+            }
+            ONNX_NAMESPACE::TensorShapeProto output_shape = x_shape;
+            *output_shape.mutable_dim(x_shape.dim_size() - 1) = w_down_shape.dim(1);
+            updateOutputShape(ctx, 0, output_shape);
+          }
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -1155,6 +1247,12 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("decoder_share_cross_kv",
+                                      "If nonzero, the cross attention key and value from the encoder are not expanded for the beams, "
+                                      "so inputs past_key_cross_* and past_value_cross_* of the decoder subgraph have shape "
+                                      "(batch_size, num_heads, encode_sequence_length, head_size), and the MultiHeadAttention or "
+                                      "DecoderMaskedMultiHeadAttention nodes using them share them across beams. Only supported on CPU. Default 0.",
+                                      AttributeProto::INT, OPTIONAL_VALUE)
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation in the encoder subgraph. Shape is (batch_size, sequence_length)", "F")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1214,6 +1312,12 @@ ONNX_MS_OPERATOR_SET_SCHEMA(WhisperBeamSearch, 1,
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
                                 .Attr("decoder_output_cross_qk", "If nozero, decoder subgraph contains output Q*K from cross attentions. Default 0.", AttributeProto::INT, OPTIONAL_VALUE)
+                                .Attr("decoder_share_cross_kv",
+                                      "If nonzero, the cross attention key and value from the encoder are not expanded for the beams, "
+                                      "so inputs past_key_cross_* and past_value_cross_* of the decoder subgraph have shape "
+                                      "(batch_size, num_heads, encode_sequence_length, head_size), and the MultiHeadAttention or "
+                                      "DecoderMaskedMultiHeadAttention nodes using them share them across beams. Only supported on CPU. Default 0.",
+                                      AttributeProto::INT, OPTIONAL_VALUE)
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation in the encoder subgraph. Shape is (batch_size, sequence_length)", "F")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1321,6 +1425,14 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "This is relevant only for the GPT2 model. If this attribute is missing, the `decoder` subgraph will be used for all decoding runs",
                                       AttributeProto::GRAPH, OPTIONAL_VALUE)
                                 .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Attr("draft_decoder",
+                                      "A smaller decoder subgraph with the same vocabulary as `decoder` for speculative decoding. "
+                                      "It proposes `num_speculative_tokens` tokens that `decoder` verifies in one run, so each run of "
+                                      "`decoder` can generate several tokens. The generated sequences are the same as without it. "
+                                      "This is relevant only for the GPT2 model on CPU.",
+                                      AttributeProto::GRAPH, OPTIONAL_VALUE)
+                                .Attr("num_speculative_tokens", "The number of tokens proposed by `draft_decoder` for each run of `decoder`.",
+                                      AttributeProto::INT, static_cast<int64_t>(4))
                                 .Attr("vocab_size",
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
@@ -3451,6 +3563,10 @@ Input scales is stored in same type as original type of B(float32, float16) with
 Input zero_points is stored as uint8_t or same as type(A). It has the same packing method as input B.
   - [N * CeilDiv(n_blocks_per_col * bits, 8)]
   If zero_points has same type as A, it's not packed and has the same shape as Scales.
+
+The optional epilogue computes Y = activation(A * B + bias) * gate + skip, where activation is set by attribute
+'activation', and gate and skip are optional inputs with the same shape as Y. It lets the SwiGLU gate multiply and
+residual adds that follow the MatMul be computed with the output tile.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
@@ -3468,12 +3584,20 @@ Input zero_points is stored as uint8_t or same as type(A). It has the same packi
             "computation. 4 means input A can be quantized with the same block_size to int8 internally from "
             "type T1.",
             AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("activation",
+            "Activation applied to A * B + bias before gate and skip, can be: Gelu, Silu, or empty for none "
+            "(default empty).",
+            AttributeProto::STRING, std::string(""))
       .Input(0, "A", "The input tensor, not quantized", "T1")
       .Input(1, "B", "1 or 2 dimensional data blob", "T2")
       .Input(2, "scales", "quantization scale", "T1")
       .Input(3, "zero_points", "quantization zero points", "T3", OpSchema::Optional)
       .Input(4, "g_idx", "group_idx", "T4", OpSchema::Optional)
       .Input(5, "bias", "Bias to add to result. It should have shape [N].", "T1", OpSchema::Optional)
+      .Input(6, "gate", "Multiplied with the activation result. It should have the shape of Y.", "T1",
+             OpSchema::Optional)
+      .Input(7, "skip", "Added to the result last, e.g. the residual. It should have the shape of Y.", "T1",
+             OpSchema::Optional)
       .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
       .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float/half_float tensors.")
       .TypeConstraint("T2", {"tensor(uint8)", "tensor(int32)"}, "Constrain quantized weight types to uint8/int32.")
@@ -3566,6 +3690,43 @@ MatMulBnb4 is a MatMul with weight quantized with 4 bits using either FP4 or NF4
         MatmulWithQuantWeightShapeInference(ctx, in_features, out_features, transB);
       });
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+  static const char* MatMulFloat8_ver1_doc = R"DOC(
+MatMulFloat8 is a MatMul with weight stored as float 8. It does Matrix Multiplication like MatMul (https://github.com/onnx/onnx/blob/main/docs/Operators.md#matmul) with differences:
+  1. Input B is a 2D constant Matrix of shape [K, N]. Its input feature count and output feature count are specified by attribute 'K' and 'N'.
+  2. Input B is quantized to float8e4m3fn or float8e5m2, per tensor or per output feature.
+  3. Input B's scale is specified by input 'B_scale', either a scalar or a 1D tensor of shape [N].
+
+  The computation math:
+    dequant_B = B * B_scale
+    output = A @ dequant_B
+
+  It replaces the pattern DequantizeLinear(B, B_scale) -> MatMul, so the weight is not dequantized
+  into a float initializer. The products are accumulated in float.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulFloat8)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MatMulFloat8_ver1_doc)
+      .Attr("K", "size of each input feature", AttributeProto::INT)
+      .Attr("N", "size of each output feature", AttributeProto::INT)
+      .Input(0, "A", "The input tensor, not quantized", "T1")
+      .Input(1, "B", "2-dimensional float8 weight of shape [K, N]", "T2")
+      .Input(2, "B_scale", "Scale of the weight, a scalar or a 1D tensor of shape [N]", "T1")
+      .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("T2", {"tensor(float8e4m3fn)", "tensor(float8e5m2)"}, "Constrain the weight types to float 8.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // Type inference
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        // Shape inference
+        int64_t in_features = getAttribute(ctx, "K", -1);
+        int64_t out_features = getAttribute(ctx, "N", -1);
+        MatmulWithQuantWeightShapeInference(ctx, in_features, out_features, true);
+      });
+#endif
+
   static const char* GatherBlockQuantized_ver1_doc = R"DOC(
 GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (https://github.com/onnx/onnx/blob/main/docs/Operators.md#gather) with differences:
   1. Input `data` is a constant. It is quantized block-wise along attribute `quantize_axis` with block size specified by attribute `block_size`.
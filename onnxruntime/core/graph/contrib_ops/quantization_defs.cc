@@ -385,6 +385,10 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeMatMul, 1,
     OpSchema()
+        .Attr("per_row_quantization",
+              "Whether to quantize each row of 'A' with its own scale, instead of a single scale and zero point for "
+              "the whole tensor. Default value is 0.",
+              AttributeProto::INT, static_cast<int64_t>(0))
         .Input(0, "A", "N-dimensional matrix A", "T1")
         .Input(1, "B", "N-dimensional matrix B", "T2")
         .Input(2, "b_scale",
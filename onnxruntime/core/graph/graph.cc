@@ -964,6 +964,7 @@ void Node::Init(std::string_view name,
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 Node::Definitions& Node::MutableDefinitions() noexcept {
   // someone fetching these is going to change something
+  type_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   return definitions_;
@@ -993,6 +994,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  type_inference_needed_ = true;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1041,6 +1043,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 bool Node::ClearAttribute(const std::string& attr_name) {
+  type_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   return attributes_.erase(attr_name) > 0;
@@ -1049,6 +1052,7 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
+  type_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   int n_removed = 0;
@@ -3102,6 +3106,36 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+// Hash of what the type and shape inferencing of the node depends on besides the node itself: the types of its inputs
+// and outputs (as inferencing merges into the existing output types), and which inputs are constant initializers.
+static size_t InferredTypesHash(const Graph& graph, const Node& node) {
+  std::string buffer;
+  auto append = [&buffer](const void* value, size_t size) {
+    buffer.append(static_cast<const char*>(value), size);
+  };
+
+  auto append_node_arg = [&](const NodeArg* node_arg, const void* constant_initializer) {
+    append(&node_arg, sizeof(node_arg));
+    append(&constant_initializer, sizeof(constant_initializer));
+    const TypeProto* type = node_arg->TypeAsProto();
+    const size_t size_before = buffer.size();
+    if (type != nullptr) {
+      type->AppendToString(&buffer);
+    }
+    const size_t type_size = buffer.size() - size_before;
+    append(&type_size, sizeof(type_size));
+  };
+
+  for (const NodeArg* input : node.InputDefs()) {
+    append_node_arg(input, input->Exists() ? graph.GetConstantInitializer(input->Name(), true) : nullptr);
+  }
+  for (const NodeArg* output : node.OutputDefs()) {
+    append_node_arg(output, nullptr);
+  }
+
+  return std::hash<std::string>{}(buffer);
+}
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
@@ -3134,12 +3168,31 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // the nodes of the main graph that are unaffected by the changes since the last Resolve keep the types they
+  // inferred. the nodes of the subgraphs are inferred from the subgraph inputs, which may change on every call.
+  const bool reuse_inferred_types = parent_graph_ == nullptr && !options.override_types;
+  auto has_modified_initializer_input = [this](const Node& node) {
+    return std::any_of(node.InputDefs().cbegin(), node.InputDefs().cend(), [this](const NodeArg* input) {
+      return initializers_modified_since_resolve_.count(input->Name()) != 0;
+    });
+  };
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
     const auto& node_name = node.Name();
 
+    if (reuse_inferred_types && node.Op() && !node.type_inference_needed_ && !node.ContainsSubgraph() &&
+        (initializers_modified_since_resolve_.empty() || !has_modified_initializer_input(node)) &&
+        InferredTypesHash(*this, node) == node.inferred_types_hash_) {
+      ++resolve_stats_.num_nodes_reused;
+      for (const auto& output : node.OutputDefs()) {
+        lsc.output_names.insert(output->Name());
+      }
+      continue;
+    }
+
     if (!node.Op()) {
       {
         auto status = Status::OK();
@@ -3225,6 +3278,13 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
+    ++resolve_stats_.num_nodes_inferred;
+    if (reuse_inferred_types) {
+      // cleared last as the inferencing updates the node definitions
+      node.inferred_types_hash_ = InferredTypesHash(*this, node);
+      node.type_inference_needed_ = false;
+    }
+
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
       lsc.output_names.insert(output->Name());
@@ -3312,6 +3372,8 @@ Status Graph::PerformTypeAndShapeInferencing(const ResolveOptions& options) {
 }
 
 Status Graph::Resolve(const ResolveOptions& options) {
+  ORT_RETURN_IF(IsCompacted(), "A compacted graph can not be resolved.");
+
   if (parent_graph_) {
     // Resolve must start at the top level graph in-order to handle outer scope
     // connections correctly, so recurse up to that level to start
@@ -3359,6 +3421,7 @@ Status Graph::Resolve(const ResolveOptions& options) {
             graph.resolve_context_.Clear();
 
             graph.CleanUnusedInitializersAndNodeArgs(options.initializer_names_to_preserve);
+            graph.initializers_modified_since_resolve_.clear();
             graph.GraphResolveNeeded(false);
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
@@ -3413,6 +3476,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   const gsl::not_null<TensorProto*> tensor_added{graph_proto_->add_initializer()};
   *(tensor_added) = tensor;
   name_to_initial_tensor_.emplace(tensor.name(), tensor_added);
+  initializers_modified_since_resolve_.insert(tensor.name());
   SetGraphResolveNeeded();
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
@@ -3508,6 +3572,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
 
+    initializers_modified_since_resolve_.insert(tensor_name);
     SetGraphResolveNeeded();
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -3564,6 +3629,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
   ORT_ENFORCE(existing_entry != mutable_initializers.pointer_end(),
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
+  initializers_modified_since_resolve_.insert(initializer_name);
   **existing_entry = std::move(new_initializer);
 
   return Status::OK();
@@ -4107,8 +4173,11 @@ ONNX_NAMESPACE::GraphProto Graph::ToGraphProto() const {
       std::basic_string<ORTCHAR_T> location;
       onnxruntime::FileOffsetType file_offset;
       SafeInt<size_t> tensor_byte_size;
+      // only data in memory is copied, which is never compressed
+      ExternalDataInfo::CompressionInfo ignored_compression_info;
 
-      ORT_THROW_IF_ERROR(utils::GetExternalDataInfo(initializer, ignored, location, file_offset, tensor_byte_size));
+      ORT_THROW_IF_ERROR(utils::GetExternalDataInfo(initializer, ignored, location, file_offset, tensor_byte_size,
+                                                    nullptr, &ignored_compression_info));
 
       if (location == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
         // file_offset is address
@@ -4728,9 +4797,89 @@ Status Graph::PopulateNodeArgToProducerConsumerLookupsFromNodes() {
   return Status::OK();
 }
 
+std::optional<NodeIndex> Graph::CompactLookups::FindProducer(const NodeArg* node_arg) const {
+  if (node_arg == nullptr) {
+    return std::nullopt;
+  }
+  auto iter = std::lower_bound(producers.begin(), producers.end(), node_arg,
+                               [](const auto& producer, const NodeArg* arg) { return producer.first < arg; });
+  if (iter == producers.end() || iter->first != node_arg) {
+    return std::nullopt;
+  }
+  return iter->second;
+}
+
+gsl::span<const NodeIndex> Graph::CompactLookups::FindConsumers(const NodeArg* node_arg) const {
+  if (node_arg == nullptr) {
+    return {};
+  }
+  auto iter = std::lower_bound(consumer_args.begin(), consumer_args.end(), node_arg);
+  if (iter == consumer_args.end() || *iter != node_arg) {
+    return {};
+  }
+  const auto i = static_cast<size_t>(iter - consumer_args.begin());
+  return gsl::make_span(consumer_nodes.data() + consumer_offsets[i], consumer_offsets[i + 1] - consumer_offsets[i]);
+}
+
+void Graph::CompactForExecution() {
+  for (auto& node : nodes_) {
+    if (node == nullptr) {
+      continue;
+    }
+    std::string().swap(node->description_);
+    for (auto& subgraph : node->MutableSubgraphs()) {
+      subgraph->CompactForExecution();
+    }
+  }
+
+  if (IsCompacted()) {
+    return;
+  }
+
+  // the names are not needed anymore as the NodeArg is found from the name in node_args_
+  auto compact_lookups = std::make_unique<CompactLookups>();
+  compact_lookups->producers.reserve(node_arg_to_producer_node_.size());
+  for (const auto& [name, node_index] : node_arg_to_producer_node_) {
+    if (const NodeArg* node_arg = GetNodeArg(name); node_arg != nullptr) {
+      compact_lookups->producers.emplace_back(node_arg, node_index);
+    }
+  }
+  std::sort(compact_lookups->producers.begin(), compact_lookups->producers.end());
+
+  std::vector<std::pair<const NodeArg*, const std::unordered_set<NodeIndex>*>> consumers;
+  consumers.reserve(node_arg_to_consumer_nodes_.size());
+  for (const auto& [name, node_indexes] : node_arg_to_consumer_nodes_) {
+    if (const NodeArg* node_arg = GetNodeArg(name); node_arg != nullptr && !node_indexes.empty()) {
+      consumers.emplace_back(node_arg, &node_indexes);
+    }
+  }
+  std::sort(consumers.begin(), consumers.end());
+
+  compact_lookups->consumer_args.reserve(consumers.size());
+  compact_lookups->consumer_offsets.reserve(consumers.size() + 1);
+  compact_lookups->consumer_offsets.push_back(0);
+  for (const auto& [node_arg, node_indexes] : consumers) {
+    compact_lookups->consumer_args.push_back(node_arg);
+    // sorted so the consumers are returned in a deterministic order
+    const size_t begin = compact_lookups->consumer_nodes.size();
+    compact_lookups->consumer_nodes.insert(compact_lookups->consumer_nodes.end(), node_indexes->begin(),
+                                           node_indexes->end());
+    std::sort(compact_lookups->consumer_nodes.begin() + begin, compact_lookups->consumer_nodes.end());
+    compact_lookups->consumer_offsets.push_back(compact_lookups->consumer_nodes.size());
+  }
+  compact_lookups->consumer_nodes.shrink_to_fit();
+
+  std::unordered_map<std::string, NodeIndex>().swap(node_arg_to_producer_node_);
+  std::unordered_map<std::string, std::unordered_set<NodeIndex>>().swap(node_arg_to_consumer_nodes_);
+  compact_lookups_ = std::move(compact_lookups);
+}
+
 // calling private ctor
 GSL_SUPPRESS(r .11)
 gsl::not_null<Node*> Graph::AllocateNode() {
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
+#endif
   ORT_ENFORCE(nodes_.size() < static_cast<unsigned int>(std::numeric_limits<int>::max()));
   std::unique_ptr<Node> new_node(new Node(nodes_.size(), *this));
   Node* node{new_node.get()};
@@ -4744,6 +4893,9 @@ gsl::not_null<Node*> Graph::AllocateNode() {
 
 // TODO(s): Does this need (and maybe AllocateNode) to be threadsafe so nodes_ and num_of_nodes_ managed more carefully?
 bool Graph::ReleaseNode(NodeIndex index) {
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  ORT_ENFORCE(!IsCompacted(), "A compacted graph can not be modified.");
+#endif
   if (index >= nodes_.size()) {
     return false;
   }
@@ -4924,6 +5076,7 @@ Status Graph::AddConstantProtoAsInitializer(const ONNX_NAMESPACE::NodeProto& nod
   auto insert_result = name_to_initial_tensor_.emplace(tensor->name(), tensor);
   ORT_ENFORCE(insert_result.second, "Constant node name: ", tensor->name(),
               " conflicts with graph initializer. Check that the node names have been made unique.");
+  initializers_modified_since_resolve_.insert(tensor->name());
   if (GetNodeArg(tensor->name()) == nullptr) {
     TypeProto t{TypeProtoFromTensorProto(*tensor)};
     ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor->name(), &t));
@@ -5057,6 +5210,7 @@ Status Graph::InlineIfSubgraph(bool condition_value, Node& if_node, const loggin
     auto insert_result = name_to_initial_tensor_.emplace(tensor->name(), tensor);
     ORT_ENFORCE(insert_result.second, "Initializer name: ", tensor->name(), " from graph: ",
                 graph_to_inline.Name(), " conflicts with graph initializer. Check name generation above.");
+    initializers_modified_since_resolve_.insert(tensor->name());
 
 #if !defined(DISABLE_SPARSE_TENSORS)
     if (has_sparse_origin) {
@@ -5375,6 +5529,7 @@ Status Graph::InlineFunction(Node& callnode) {
       auto insert_result = name_to_initial_tensor_.emplace(tensor->name(), tensor);
       ORT_ENFORCE(insert_result.second, "Initializer name: ", tensor->name(), " in inlined subgraph: ",
                   subgraph.Name(), " conflicts with graph initializer. Check Specializing code.");
+      initializers_modified_since_resolve_.insert(tensor->name());
       if (GetNodeArg(tensor->name()) == nullptr) {
         TypeProto t{TypeProtoFromTensorProto(*tensor)};
         ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor->name(), &t));
@@ -28,6 +28,7 @@
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/schema_registry.h"
 #include "core/graph/function_utils.h"
+#include "core/graph/parallel_model_proto_parser.h"
 #endif
 
 #if defined(__wasm__)
@@ -640,6 +641,52 @@ Status Model::Load(const PathString& file_path, std::shared_ptr<Model>& p_model,
   return LoadModel(file_path, p_model, local_registries, logger, options);
 }
 
+Status Model::LoadInParallel(const PathString& file_path, std::shared_ptr<Model>& p_model,
+                             const IOnnxRuntimeOpSchemaRegistryList* local_registries,
+                             const logging::Logger& logger, const ModelOptions& options,
+                             concurrency::ThreadPool* thread_pool) {
+  // the raw data of smaller initializers is copied, as referencing it would not save much
+  constexpr size_t kMinReferencedInitializerDataSize = 4096;
+
+  const auto& env = Env::Default();
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path.c_str(), file_length));
+  if (file_length == 0) {
+    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed. The model file is empty.");
+  }
+
+  // the mapping is copy-on-write, the initializers referencing it can be modified in place
+  Env::MappedMemoryPtr mapping;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path.c_str(), 0, file_length, mapping));
+
+  ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(ParseModelProtoInParallel(
+      gsl::make_span(reinterpret_cast<const uint8_t*>(mapping.get()), file_length), model_proto, thread_pool,
+      kMinReferencedInitializerDataSize));
+
+  if (!utils::HasGraph(model_proto)) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT, "No graph was found in the protobuf.");
+  }
+
+  auto status = Status::OK();
+  ORT_TRY {
+    p_model = std::make_shared<Model>(std::move(model_proto), file_path, local_registries, logger, options);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = Status(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to load model with error: " + std::string(ex.what()));
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+  p_model->model_file_mapping_ = std::move(mapping);
+
+  Graph::ResolveOptions resolve_options;
+  resolve_options.no_proto_sync_required = true;
+  ORT_RETURN_IF_ERROR(p_model->MainGraph().Resolve(resolve_options));
+
+  return Status::OK();
+}
+
 Status Model::SaveWithExternalInitializers(Model& model, const std::filesystem::path& file_path,
                                            const std::filesystem::path& external_file_name,
                                            const ModelSavingOptions& save_options) {
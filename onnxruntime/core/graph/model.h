@@ -16,12 +16,17 @@
 #include "core/session/onnxruntime_c_api.h"
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/function_template.h"
+#include "core/platform/env.h"
 #endif
 
 namespace onnxruntime {
 
 class PrepackedShareableWeightsContainer;
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace fbs {
 struct Model;
 }  // namespace fbs
@@ -223,6 +228,16 @@ class Model {
                              const logging::Logger& logger,
                              const ModelOptions& options = {});
 
+  // Loads the model like Load(file_path, ...), with the file memory mapped and the nodes and initializers of the main
+  // graph parsed in parallel over thread_pool, which may be null. The raw data of the large initializers is not
+  // copied, the initializers reference it in the mapping, which is owned by the model.
+  static common::Status LoadInParallel(const PathString& file_path,
+                                       /*out*/ std::shared_ptr<Model>& p_model,
+                                       const IOnnxRuntimeOpSchemaRegistryList* local_registries,
+                                       const logging::Logger& logger,
+                                       const ModelOptions& options,
+                                       concurrency::ThreadPool* thread_pool);
+
   static common::Status Load(int fd, /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
 
   static common::Status Load(int fd, /*out*/ std::shared_ptr<Model>& p_model,
@@ -311,6 +326,9 @@ class Model {
  private:
   // Model data.
 #if !defined(ORT_MINIMAL_BUILD)
+  // Memory mapped model file of LoadInParallel, referenced by the initializers. Declared first to outlive them.
+  Env::MappedMemoryPtr model_file_mapping_;
+
   ONNX_NAMESPACE::ModelProto model_proto_;
   // map from function id to pointer of model local function proto
   // FunctionProto is hosted in ModelProto.
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/parallel_model_proto_parser.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "core/common/common.h"
+#include "core/common/narrow.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
+
+using ::google::protobuf::io::CodedInputStream;
+
+namespace onnxruntime {
+
+namespace {
+
+// field numbers of onnx.proto
+constexpr uint32_t kModelProtoGraph = 7;
+constexpr uint32_t kGraphProtoNode = 1;
+constexpr uint32_t kGraphProtoInitializer = 5;
+constexpr uint32_t kTensorProtoRawData = 9;
+
+constexpr uint32_t kWireTypeVarint = 0;
+constexpr uint32_t kWireTypeFixed64 = 1;
+constexpr uint32_t kWireTypeLengthDelimited = 2;
+constexpr uint32_t kWireTypeFixed32 = 5;
+
+struct Field {
+  uint32_t number;
+  uint32_t wire_type;
+  // the whole field, including its tag
+  gsl::span<const uint8_t> bytes;
+  // the value of a length-delimited field
+  gsl::span<const uint8_t> payload;
+};
+
+// Splits a serialized message into its fields, without parsing them. Fails for the deprecated groups.
+bool ScanFields(gsl::span<const uint8_t> bytes, std::vector<Field>& fields) {
+  CodedInputStream input(bytes.data(), narrow<int>(bytes.size()));
+  while (true) {
+    const auto begin = static_cast<size_t>(input.CurrentPosition());
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      // the end of the message, unless the tag is invalid
+      return begin == bytes.size();
+    }
+
+    Field field{tag >> 3, tag & 7, {}, {}};
+    switch (field.wire_type) {
+      case kWireTypeVarint: {
+        uint64_t value;
+        if (!input.ReadVarint64(&value)) {
+          return false;
+        }
+        break;
+      }
+      case kWireTypeFixed64:
+        if (!input.Skip(8)) {
+          return false;
+        }
+        break;
+      case kWireTypeLengthDelimited: {
+        uint32_t length;
+        if (!input.ReadVarint32(&length)) {
+          return false;
+        }
+        field.payload = bytes.subspan(static_cast<size_t>(input.CurrentPosition()));
+        if (!input.Skip(static_cast<int>(length))) {
+          return false;
+        }
+        field.payload = field.payload.first(length);
+        break;
+      }
+      case kWireTypeFixed32:
+        if (!input.Skip(4)) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+
+    field.bytes = bytes.subspan(begin, static_cast<size_t>(input.CurrentPosition()) - begin);
+    fields.push_back(field);
+  }
+}
+
+bool IsLengthDelimitedField(const Field& field, uint32_t number) {
+  return field.number == number && field.wire_type == kWireTypeLengthDelimited;
+}
+
+void Append(std::string& message, const Field& field) {
+  message.append(reinterpret_cast<const char*>(field.bytes.data()), field.bytes.size());
+}
+
+bool ParseFromSpan(gsl::span<const uint8_t> bytes, ::google::protobuf::MessageLite& message) {
+  return message.ParseFromArray(bytes.data(), narrow<int>(bytes.size()));
+}
+
+// Parses an initializer, referencing its raw data in place if it is large enough and aligned for its element type.
+bool ParseInitializer(gsl::span<const uint8_t> bytes, size_t min_referenced_data_size,
+                      ONNX_NAMESPACE::TensorProto& initializer) {
+  std::vector<Field> fields;
+  if (min_referenced_data_size == 0 || !ScanFields(bytes, fields)) {
+    return ParseFromSpan(bytes, initializer);
+  }
+
+  const Field* raw_data = nullptr;
+  std::string other_fields;
+  for (const auto& field : fields) {
+    if (IsLengthDelimitedField(field, kTensorProtoRawData)) {
+      raw_data = &field;
+    } else {
+      Append(other_fields, field);
+    }
+  }
+  if (raw_data == nullptr || raw_data->payload.size() < min_referenced_data_size ||
+      !initializer.ParseFromString(other_fields) ||
+      initializer.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL ||
+      !utils::HasDataType(initializer) || utils::HasString(initializer)) {
+    return ParseFromSpan(bytes, initializer);
+  }
+
+  const size_t element_size =
+      DataTypeImpl::TensorTypeFromONNXEnum(initializer.data_type())->GetElementType()->Size();
+  const auto address = reinterpret_cast<intptr_t>(raw_data->payload.data());
+  if (address % element_size != 0) {
+    return ParseFromSpan(bytes, initializer);
+  }
+
+  ExternalDataInfo::SetExternalLocationToProto(utils::kTensorProtoMemoryAddressTag,
+                                               narrow<ExternalDataInfo::OFFSET_TYPE>(address),
+                                               raw_data->payload.size(), initializer);
+  return true;
+}
+
+}  // namespace
+
+Status ParseModelProtoInParallel(gsl::span<const uint8_t> bytes, ONNX_NAMESPACE::ModelProto& model_proto,
+                                 concurrency::ThreadPool* thread_pool, size_t min_referenced_data_size) {
+  ORT_RETURN_IF(bytes.size() > static_cast<size_t>(std::numeric_limits<int>::max()),
+                "Protobuf parsing failed. The model is larger than the 2GB limit of protobuf.");
+
+  auto parse_sequentially = [&]() {
+    return ParseFromSpan(bytes, model_proto)
+               ? Status::OK()
+               : Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF, "Protobuf parsing failed.");
+  };
+
+  // a message repeated in the serialized data is merged, which is left to protobuf, as are invalid messages
+  std::vector<Field> model_fields;
+  if (!ScanFields(bytes, model_fields)) {
+    return parse_sequentially();
+  }
+  const Field* graph_field = nullptr;
+  std::string other_model_fields;
+  for (const auto& field : model_fields) {
+    if (IsLengthDelimitedField(field, kModelProtoGraph)) {
+      if (graph_field != nullptr) {
+        return parse_sequentially();
+      }
+      graph_field = &field;
+    } else {
+      Append(other_model_fields, field);
+    }
+  }
+
+  std::vector<Field> graph_fields;
+  if (graph_field == nullptr || !ScanFields(graph_field->payload, graph_fields)) {
+    return parse_sequentially();
+  }
+
+  std::vector<gsl::span<const uint8_t>> nodes;
+  std::vector<gsl::span<const uint8_t>> initializers;
+  std::string other_graph_fields;
+  for (const auto& field : graph_fields) {
+    if (IsLengthDelimitedField(field, kGraphProtoNode)) {
+      nodes.push_back(field.payload);
+    } else if (IsLengthDelimitedField(field, kGraphProtoInitializer)) {
+      initializers.push_back(field.payload);
+    } else {
+      Append(other_graph_fields, field);
+    }
+  }
+
+  ONNX_NAMESPACE::GraphProto graph;
+  if (!model_proto.ParseFromString(other_model_fields) || !graph.ParseFromString(other_graph_fields)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+  auto& graph_proto = *model_proto.mutable_graph();
+  graph_proto = std::move(graph);
+
+  auto& graph_nodes = *graph_proto.mutable_node();
+  graph_nodes.Reserve(narrow<int>(nodes.size()));
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    graph_nodes.Add();
+  }
+  auto& graph_initializers = *graph_proto.mutable_initializer();
+  graph_initializers.Reserve(narrow<int>(initializers.size()));
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    graph_initializers.Add();
+  }
+
+  // the initializers, which are usually the larger messages, are scheduled first
+  const size_t num_messages = initializers.size() + nodes.size();
+  std::vector<uint8_t> parsed(num_messages, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_messages),
+      [&](std::ptrdiff_t i) {
+        const auto index = static_cast<size_t>(i);
+        if (index < initializers.size()) {
+          parsed[index] = ParseInitializer(initializers[index], min_referenced_data_size,
+                                           graph_initializers[narrow<int>(index)]);
+        } else {
+          const size_t node_index = index - initializers.size();
+          parsed[index] = ParseFromSpan(nodes[node_index], graph_nodes[narrow<int>(node_index)]);
+        }
+      });
+
+  if (std::find(parsed.begin(), parsed.end(), uint8_t{0}) != parsed.end()) {
+    return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <cstdint>
+
+#include <gsl/gsl>
+
+#include "core/common/status.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+namespace concurrency {
+class ThreadPool;
+}
+
+/**
+ * Parses a serialized ModelProto like ModelProto::ParseFromArray, with the nodes and initializers of the main graph,
+ * which take most of the parsing time of large models, parsed in parallel over thread_pool.
+ *
+ * The top-level fields of the model and of its graph are scanned without being parsed, so that every node and
+ * initializer can be parsed on its own into the repeated fields of the graph, in their original order.
+ *
+ * If min_referenced_data_size is not 0, the raw data of the initializers of at least this size is not copied. The
+ * initializers reference it in `bytes` as external data in memory (utils::kTensorProtoMemoryAddressTag) instead, so
+ * `bytes` must outlive the model. The data is only referenced if it is aligned for its element type.
+ */
+common::Status ParseModelProtoInParallel(gsl::span<const uint8_t> bytes, ONNX_NAMESPACE::ModelProto& model_proto,
+                                         concurrency::ThreadPool* thread_pool, size_t min_referenced_data_size = 0);
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
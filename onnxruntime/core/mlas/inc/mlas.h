@@ -76,6 +76,9 @@ Abstract:
 #if defined(__loongarch64)
 #define MLAS_TARGET_LARCH64
 #endif
+#if defined(__riscv) && (__riscv_xlen == 64)
+#define MLAS_TARGET_RISCV64
+#endif
 //
 // Define the support levels for the target architecture.
 //
@@ -84,6 +87,10 @@ Abstract:
 #define MLAS_SUPPORTS_GEMM_DOUBLE
 #endif
 
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
 #if (!defined(_MSC_VER)) || (_MSC_VER >= 1930)
 #if defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_ARM64EC)
 #if !defined(__APPLE__)
@@ -203,6 +210,21 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Supply the operations applied to the output of a single precision
+ *        gemm while each block of the output is computed, so that they don't
+ *        need separate passes over the output matrix:
+ *
+ *        C = Residual + Scale * Activation(C + Bias)
+ */
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Bias = nullptr;                   /**< Supplies the optional bias vector of N elements */
+    const MLAS_ACTIVATION* Activation = nullptr;   /**< Supplies the optional activation */
+    float Scale = 1.0f;                            /**< Supplies the scale applied after the activation */
+    const float* Residual = nullptr;               /**< Supplies the optional M by N matrix added last */
+    size_t ldr = 0;                                /**< Supplies the first dimension of the residual matrix */
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -216,6 +238,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr; /**< Supplies the optional operations applied to C */
 };
 
 /**
@@ -245,6 +268,49 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Dimension of the output along which a SGEMM operation is split
+ *        across threads.
+ */
+enum MLAS_SGEMM_PARTITION {
+    MlasSgemmPartitionDefault,
+    MlasSgemmPartitionM,
+    MlasSgemmPartitionN,
+};
+
+/**
+ * @brief Thread partition of a SGEMM operation that replaces the default
+ *        heuristics, e.g. the fastest partition found by tuning a shape.
+ */
+struct MLAS_SGEMM_THREADING_PARAMS {
+    ptrdiff_t ThreadCount = 0;     ///< Number of threads, 0 to derive it from the complexity
+    MLAS_SGEMM_PARTITION Partition = MlasSgemmPartitionDefault;
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation (SGEMM)
+ *         with a supplied thread partition
+ *
+ * @param ThreadingParams  Supplies the thread partition, else nullptr to use
+ *                         the default heuristics. The thread count is
+ *                         limited to the size of the thread pool.
+ *
+ * See the MlasGemmBatch overload above for the other parameters.
+ */
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_THREADING_PARAMS* ThreadingParams
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -750,6 +816,303 @@ MlasSymmQgemmPackB(
     void* PackedB
     );
 
+//
+// Float8 weight matrix multiply routines.
+//
+
+enum MLAS_FP8_TYPE {
+    MlasFp8E4M3FN,
+    MlasFp8E5M2,
+};
+
+/**
+ * @brief  Returns the size of the buffer needed to pack a float8 matrix B
+ *         for MlasFp8GemmBatch
+ * @param N  Number of columns of matrix B
+ * @param K  Number of rows of matrix B
+ * @return  size of the packing buffer in bytes
+ */
+size_t
+MLASCALL
+MlasFp8GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Packs a float8 matrix B of shape [K, N]. The float8 encodings are kept,
+ *         so the packing is the same for all the float8 types.
+ * @param N        Number of columns of matrix B
+ * @param K        Number of rows of matrix B
+ * @param B        Address of matrix B, holding the float8 encodings
+ * @param ldb      First dimension of matrix B
+ * @param PackedB  Address of the packed buffer, sized by MlasFp8GemmPackBSize
+ */
+void
+MLASCALL
+MlasFp8GemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Supply matrices data information to float8 weight gemm functions
+ */
+struct MLAS_FP8_GEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of matrix B packed by MlasFp8GemmPackB */
+    const float* Scale = nullptr;   /**< Supplies the scale of matrix B, 1 or N values */
+    bool PerColumnScale = false;    /**< Whether Scale holds one value per column of matrix B */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief  Batched matrix/matrix multiply C = A * (B * Scale) of a single precision
+ *         matrix A with a float8 matrix B. Matrix B is decoded block by block and the
+ *         products are accumulated in single precision.
+ *
+ * @param BType      Supplies the float8 type of matrix B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasFp8GemmBatch(
+    MLAS_FP8_TYPE BType,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_FP8_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// 2:4 structured sparse matrix multiply routines.
+//
+
+/**
+ * @brief  Checks whether a matrix B has 2:4 structured sparsity, where every group of
+ *         four consecutive rows of a column holds at most two non-zero values
+ * @param TransB  Supplies the transpose operation for matrix B
+ * @param N       Number of columns of matrix B
+ * @param K       Number of rows of matrix B
+ * @param B       Address of matrix B
+ * @param ldb     First dimension of matrix B
+ * @return  true if matrix B can be packed by MlasSparse24GemmPackB
+ */
+bool
+MLASCALL
+MlasSparse24GemmCheckB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief  Returns the size of the buffer needed to pack a 2:4 sparse matrix B
+ * @param N  Number of columns of matrix B
+ * @param K  Number of rows of matrix B
+ * @return  size of the packing buffer in bytes, about half of the size of matrix B
+ */
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Compresses a 2:4 sparse matrix B to its non-zero values and their 2-bit
+ *         indices inside each group of four rows
+ * @param TransB   Supplies the transpose operation for matrix B
+ * @param N        Number of columns of matrix B
+ * @param K        Number of rows of matrix B
+ * @param B        Address of matrix B
+ * @param ldb      First dimension of matrix B
+ * @param PackedB  Address of the packed buffer, sized by MlasSparse24GemmPackBSize
+ */
+void
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Supply matrices data information to 2:4 sparse gemm functions
+ */
+struct MLAS_SPARSE24_GEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of matrix B packed by MlasSparse24GemmPackB */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;             /**< Supplies the scalar alpha multiplier */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply C = alpha * A * B with a
+ *         packed 2:4 sparse matrix B. Only the non-zero values of matrix B are multiplied.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparse24GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Sparse matrix/dense matrix multiply routines.
+//
+// The sparse matrix A is stored in a blocked CSR format. Its rows are grouped
+// in blocks of BlockM rows, 1, 2 or 4, and each row block stores the columns
+// where any of its rows holds a non-zero value, with the BlockM values of a
+// column stored together. A block size of 1 is the CSR format.
+//
+
+/**
+ * @brief  Counts the columns stored for the row blocks of a sparse matrix A
+ * @param TransA  Supplies the transpose operation for matrix A
+ * @param M       Number of rows of matrix A
+ * @param K       Number of columns of matrix A
+ * @param BlockM  Number of rows of a row block, 1, 2 or 4
+ * @param A       Address of matrix A
+ * @param lda     First dimension of matrix A
+ * @return  number of stored columns, each holding BlockM values
+ */
+size_t
+MLASCALL
+MlasSparseCsrGemmCountBlocks(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t K,
+    size_t BlockM,
+    const float* A,
+    size_t lda
+    );
+
+/**
+ * @brief  Returns the size of the buffer needed to pack a sparse matrix A
+ * @param M           Number of rows of matrix A
+ * @param BlockM      Number of rows of a row block
+ * @param BlockCount  Number of stored columns, from MlasSparseCsrGemmCountBlocks
+ * @return  size of the packing buffer in bytes
+ */
+size_t
+MLASCALL
+MlasSparseCsrGemmPackASize(
+    size_t M,
+    size_t BlockM,
+    size_t BlockCount
+    );
+
+/**
+ * @brief  Compresses a sparse matrix A to the blocked CSR format
+ * @param TransA   Supplies the transpose operation for matrix A
+ * @param M        Number of rows of matrix A
+ * @param K        Number of columns of matrix A
+ * @param BlockM   Number of rows of a row block, 1, 2 or 4
+ * @param A        Address of matrix A
+ * @param lda      First dimension of matrix A
+ * @param PackedA  Address of the packed buffer, sized by MlasSparseCsrGemmPackASize
+ */
+void
+MLASCALL
+MlasSparseCsrGemmPackA(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t K,
+    size_t BlockM,
+    const float* A,
+    size_t lda,
+    void* PackedA
+    );
+
+/**
+ * @brief Supply matrices data information to the sparse CSR gemm function
+ */
+struct MLAS_SPARSE_CSR_GEMM_DATA_PARAMS {
+    const int64_t* RowOffsets = nullptr;     /**< Supplies the offset of the first stored column of each row block, and the count of stored columns last */
+    const int64_t* ColumnIndices = nullptr;  /**< Supplies the column index of each stored column */
+    const float* Values = nullptr;           /**< Supplies the BlockM values of each stored column */
+    const float* B = nullptr;                /**< Supplies the address of matrix B */
+    size_t ldb = 0;                          /**< Supplies the first dimension of matrix B. */
+    float* C = nullptr;                      /**< Supplies the address of matrix C */
+    size_t ldc = 0;                          /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;                      /**< Supplies the scalar alpha multiplier */
+};
+
+/**
+ * @brief  Points the matrix A arrays of the data parameters to a buffer packed by MlasSparseCsrGemmPackA
+ * @param M           Number of rows of matrix A
+ * @param BlockM      Number of rows of a row block
+ * @param BlockCount  Number of stored columns
+ * @param PackedA     Address of the packed buffer
+ * @param Data        Data parameters to update
+ */
+void
+MLASCALL
+MlasSparseCsrGemmSetPackedA(
+    size_t M,
+    size_t BlockM,
+    size_t BlockCount,
+    const void* PackedA,
+    MLAS_SPARSE_CSR_GEMM_DATA_PARAMS* Data
+    );
+
+/**
+ * @brief  Single precision matrix/matrix multiply C = alpha * A * B with a sparse
+ *         matrix A in the blocked CSR format. The kernel is vectorized along N and
+ *         the row blocks are distributed over the threads by their count of stored columns.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param BlockM     Supplies the number of rows of a row block of matrix A, 1, 2 or 4.
+ * @param Data       Supplies the matrices data parameters
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparseCsrGemm(
+    size_t M,
+    size_t N,
+    size_t BlockM,
+    const MLAS_SPARSE_CSR_GEMM_DATA_PARAMS* Data,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Convolution routines.
 //
@@ -758,6 +1121,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -790,6 +1154,11 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCountH;
+            size_t TileCountW;
+            size_t TileBlockSize;
+        } Winograd;
     } u;
 };
 
@@ -809,7 +1178,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                bool WinogradFilterPacked = false);
 
 void
 MLASCALL
@@ -823,6 +1193,99 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Returns whether a convolution can be computed with the Winograd
+ *        F(4x4, 3x3) algorithm: 2D, a single group, 3x3 kernel, unit
+ *        strides and dilations and enough channels to benefit from it.
+ */
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+/**
+ * @brief Returns the number of elements of the filter packed by
+ *        MlasConvWinogradPackFilter
+ */
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+/**
+ * @brief Transforms a FilterCount x InputChannels x 3 x 3 filter for the
+ *        Winograd algorithm. The packed filter is passed to MlasConv in place
+ *        of the filter when MlasConvPrepare is called with
+ *        WinogradFilterPacked and selects MlasConvAlgorithmWinograd.
+ */
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+/**
+ * @brief Computes a 2D or 3D convolution of NHWC tensors as an implicit GEMM,
+ *        without an im2col buffer.
+ *
+ * @param Parameters  Supplies the parameters prepared by MlasConvPrepare
+ * @param Input       Supplies the NHWC input tensor
+ * @param Filter      Supplies the filter in HWIO format: KernelSize x
+ *                    InputChannels rows of GroupCount x FilterCount columns
+ * @param Bias        Supplies the optional bias, GroupCount x FilterCount
+ * @param Output      Supplies the NHWC output tensor
+ * @param ThreadPool  Supplies the thread pool object
+ */
+void
+MLASCALL
+MlasConvNhwc(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Indirect depthwise convolution for fp32 NHWC tensors
+ *
+ * @param Input        Supplies the indirection buffer to the input pixels
+ * @param Filter       Supplies the filter in HWC format
+ * @param Bias         Supplies the optional bias vector
+ * @param Output       Supplies the address of the output pixels
+ * @param Channels     # of channels
+ * @param OutputCount  # of output pixels
+ * @param KernelSize   # kernel size
+ * @param Beta         Supplies the scale of the existing output added to the result
+ * @param Activation   Supplies the activation applied to the result
+ */
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_ACTIVATION* Activation
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -981,6 +1444,43 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+/**
+ * @brief Max Pooling for fp32 NHWC
+ * @param Input         Indirect buffer to activations
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ */
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+/**
+ * @brief Avg Pooling for fp32 NHWC. The null entries of the indirect buffer
+ *        are padding excluded from the average.
+ * @param Input         Indirect buffer to activations
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ */
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -1023,6 +1523,44 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Options of MlasComputeAttentionSoftmax, applied to each score x of a row before the softmax function:
+ *        x = Softcap > 0 ? Softcap * tanh(x * Scale / Softcap) : x * Scale, then x += Bias + Mask.
+ */
+template <typename T>
+struct MLAS_ATTENTION_SOFTMAX_PARAMS {
+    float Scale = 1.0f;        /**< Scale applied to the scores. */
+    float Softcap = 0.0f;      /**< Soft cap applied to the scaled scores, 0 if none. */
+    const T* Bias = nullptr;   /**< Optional additive bias, of shape [N, D]. */
+    const T* Mask = nullptr;   /**< Optional additive mask, of shape [N, D]. */
+    bool Causal = false;       /**< If true, row n only attends to the columns [0, n + CausalOffset]. */
+    size_t CausalOffset = 0;   /**< Offset of the causal mask, usually the past sequence length. */
+};
+
+/**
+ * @brief Computes the softmax function of rows of attention scores in the pass that applies the scale,
+ *        the soft cap, the additive bias and mask, and the causal mask. The probabilities of the columns
+ *        past the causal limit are zero. fp16 rows are computed in fp32.
+ *
+ * @param Input       input scores, of shape [N, D]
+ * @param Output      output probabilities, of shape [N, D], can be the same buffer as Input
+ * @param N           number of rows
+ * @param D           number of columns per row
+ * @param Parameters  options applied to the scores
+ * @param ThreadPool  thread pool used to split the rows
+ */
+template <typename T>
+void
+MLASCALL
+MlasComputeAttentionSoftmax(
+    const T* Input,
+    T* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<T>& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 template <typename T>
 void
 MLASCALL
@@ -1101,6 +1639,43 @@ MlasTranspose(
     size_t N
     );
 
+/**
+ * @brief Transposes a M x N tile of a matrix with rows of InputStride elements
+ *        to a N x M tile of a matrix with rows of OutputStride elements.
+ */
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1222,6 +1797,56 @@ MlasNchwcUpsampleLinear(
     float* Output
     );
 
+//
+// Image resize routines.
+//
+
+/**
+ * @brief Resizes images with a separable filter. Output element (y, x, c) of an image is
+ *
+ *            sum(i < RowTaps, j < ColumnTaps) RowWeights[y * RowTaps + i] * ColumnWeights[x * ColumnTaps + j] *
+ *                Input(RowIndices[y * RowTaps + i], ColumnIndices[x * ColumnTaps + j], c)
+ *
+ *        The taps of an output row must be consecutive input rows, some of them repeated when
+ *        they are clamped to the image. The rows are filtered horizontally once and reused by
+ *        the output rows that share them, then combined vertically.
+ *
+ * @param Input          input images, of shape [ImageCount, InputHeight, InputWidth, Channels]
+ * @param ImageCount     number of images
+ * @param InputHeight    number of rows of an input image
+ * @param InputWidth     number of columns of an input image
+ * @param Channels       number of interleaved channels, 1 for the planes of a NCHW tensor
+ * @param Output         output images, of shape [ImageCount, OutputHeight, OutputWidth, Channels]
+ * @param OutputHeight   number of rows of an output image
+ * @param OutputWidth    number of columns of an output image
+ * @param RowTaps        number of input rows of an output row
+ * @param RowIndices     input rows of each output row, of shape [OutputHeight, RowTaps]
+ * @param RowWeights     weights of the input rows, of shape [OutputHeight, RowTaps]
+ * @param ColumnTaps     number of input columns of an output column
+ * @param ColumnIndices  input columns of each output column, of shape [OutputWidth, ColumnTaps]
+ * @param ColumnWeights  weights of the input columns, of shape [OutputWidth, ColumnTaps]
+ * @param ThreadPool     thread pool used to split the images and their rows
+ */
+void
+MLASCALL
+MlasResizeSeparable(
+    const float* Input,
+    size_t ImageCount,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t Channels,
+    float* Output,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    size_t RowTaps,
+    const int32_t* RowIndices,
+    const float* RowWeights,
+    size_t ColumnTaps,
+    const int32_t* ColumnIndices,
+    const float* ColumnWeights,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Linear quantization routines.
 //
@@ -1461,6 +2086,27 @@ MLAS_FP16* Destination,
 size_t Count
 );
 
+//
+// Brain floating-point routines. The elements are passed as the bits of the
+// bfloat16 values.
+//
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
 /**
  * @brief rotary embedding for one hidden state vector
  *
@@ -1484,6 +2130,81 @@ MlasRotaryEmbedOneRow(
     T* output
 );
 
+/**
+ * @brief layer normalization of one row, fused with the skip and bias addition of
+ *        SkipLayerNormalization
+ *
+ *   x = input + skip + bias
+ *   output = (x - mean(x)) / sqrt(variance(x) + epsilon) * scale + shift, or
+ *   output = x / sqrt(mean(x * x) + epsilon) * scale when simplified (RMS normalization)
+ *
+ * @tparam T: data type of input and output. Currently only float32/16 are supported.
+ * @param input:  input tensor, of shape [n]
+ * @param skip:   optional skip tensor, of shape [n]
+ * @param bias:   optional bias tensor, of shape [n]
+ * @param scale:  scale (gamma) tensor, of shape [n]
+ * @param shift:  optional shift (beta) tensor, of shape [n], not used when simplified
+ * @param n:      number of elements of the row
+ * @param epsilon:  value added to the variance
+ * @param simplified:  whether to compute the simplified (RMS) normalization
+ * @param output:  output tensor, of shape [n]
+ * @param input_skip_bias_sum:  optional output of x, of shape [n]
+ * @param mean:   optional output of the mean, 0 when simplified
+ * @param inv_std_dev:  optional output of the inverse standard deviation
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormOneRow(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+);
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceMean,
+    MlasReduceMax,
+    MlasReduceMin,
+    MlasReduceLogSumExp,
+};
+
+/**
+ * @brief Reduces the middle axis of a tensor of shape [outer_count, reduce_count, inner_count]
+ *        to produce a tensor of shape [outer_count, inner_count]. The values are accumulated
+ *        in fp32 for all the element types.
+ *
+ * @param kind  the kind of reduction
+ * @param input  input tensor, of shape [outer_count, reduce_count, inner_count]
+ * @param output  output tensor, of shape [outer_count, inner_count]
+ * @param outer_count  number of leading elements that are kept
+ * @param reduce_count  number of elements that are reduced
+ * @param inner_count  number of trailing elements that are kept
+ * @param thread_pool  thread pool used to split the output and, when the output is small,
+ *                     the reduced axis
+ */
+template <typename T>
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND kind,
+    const T* input,
+    T* output,
+    size_t outer_count,
+    size_t reduce_count,
+    size_t inner_count,
+    MLAS_THREADPOOL* thread_pool
+);
+
 /**
  * @brief Supply matrices data information to half precision gemm functions
  */
@@ -1601,6 +2322,14 @@ MlasGemm(
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether MlasHalfGemmBatch has an accelerated kernel on the
+ *        current CPU, i.e. FP16 vector support on ARM64, AVX512_FP16 or
+ *        AMX-FP16 on x64.
+*/
+bool MLASCALL
+MlasHalfGemmAccelerationSupported();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -1803,9 +2532,11 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
+ *        On ARM64 this requires the NEON BF16 instructions, on AMD64
+ *        AVX512_BF16 (the AMX-BF16 kernels are used when available).
  */
 bool MLASCALL
 MlasBf16AccelerationSupported();
@@ -1914,7 +2645,7 @@ MlasSBGemmPackBSize(size_t N, size_t K);
  */
 void MLASCALL
 MlasSBGemmConvertPackB(size_t N, size_t K, const float* B, size_t ldb, void* PackedB);
-#endif
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
 
 /**
  * @brief Indirect Depthwise convolution for fp16
@@ -2015,6 +2746,18 @@ struct MlasFlashAttentionThreadedArgs {
     const float* key;
     const float* value;
     float* output;
+
+    //
+    // Optional attributes. Q is BxNxSxH, K and V are Bx(kv_num_heads)x(kv_sequence_stride)xH,
+    // the output is BxSxNxH.
+    //
+    int kv_num_heads = 0;                       // # of heads of K and V for grouped query attention, 0 if num_heads
+    int kv_sequence_stride = 0;                 // # of rows allocated per head of K and V, 0 if kv_sequence_length
+    bool is_causal = false;                     // query i of batch b attends to keys [0, causal_offsets[b] + i]
+    int local_window_size = -1;                 // with is_causal, # of keys before the query in the window, -1 if none
+    float softcap = 0.0f;                       // scores are softcap * tanh(scores / softcap) if softcap > 0
+    const int* kv_sequence_lengths = nullptr;   // optional # of valid keys of each batch
+    const int* causal_offsets = nullptr;        // optional position of the first query in the keys of each batch
 };
 
 /**
@@ -0,0 +1,165 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activate_kernel_rvv.cpp
+
+Abstract:
+
+    This module implements the logistic and hyperbolic tangent kernels for the
+    RISC-V Vector extension (RVV 1.0).
+
+    The kernels use the same polynomial coefficients and algorithm as the
+    generic kernels in logistic.cpp and tanh.cpp and are strip mined with
+    vsetvl, so no scalar loop is needed for the trailing elements.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_USE_RVV)
+
+#include <riscv_vector.h>
+
+void
+MLASCALL
+MlasLogisticKernelRvv(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the RVV kernel for the logistic function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N > 0) {
+
+        const size_t vl = __riscv_vsetvl_e32m4(N);
+
+        //
+        // N.B. vfmax and vfmin return the other operand for a quiet NaN, so
+        // a NaN input is propagated explicitly with the merge below.
+        //
+
+        vfloat32m4_t Input0 = __riscv_vle32_v_f32m4(Input, vl);
+        vbool8_t IsNaN = __riscv_vmfne_vv_f32m4_b8(Input0, Input0, vl);
+
+        vfloat32m4_t Value = __riscv_vfmax_vf_f32m4(Input0, -18.0f, vl);
+        Value = __riscv_vfmin_vf_f32m4(Value, 18.0f, vl);
+
+        vfloat32m4_t ValueSquared = __riscv_vfmul_vv_f32m4(Value, Value, vl);
+
+        vfloat32m4_t p;
+        p = __riscv_vfmv_v_f_f32m4(1.15627324459942e-07f, vl);
+        p = __riscv_vfmacc_vf_f32m4(p, 4.37031012579801e-11f, ValueSquared, vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(6.08574864600143e-05f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(8.51377133304701e-03f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(2.48287947061529e-01f, vl), vl);
+        p = __riscv_vfmul_vv_f32m4(p, Value, vl);
+
+        vfloat32m4_t q;
+        q = __riscv_vfmv_v_f_f32m4(5.76102136993427e-09f, vl);
+        q = __riscv_vfmacc_vf_f32m4(q, 6.10247389755681e-13f, ValueSquared, vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(6.29106785017040e-06f, vl), vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(1.70198817374094e-03f, vl), vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(1.16817656904453e-01f, vl), vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(9.93151921023180e-01f, vl), vl);
+
+        vfloat32m4_t Result = __riscv_vfadd_vf_f32m4(__riscv_vfdiv_vv_f32m4(p, q, vl), 0.5f, vl);
+        Result = __riscv_vmerge_vvm_f32m4(Result, Input0, IsNaN, vl);
+
+        __riscv_vse32_v_f32m4(Output, Result, vl);
+
+        Input += vl;
+        Output += vl;
+        N -= vl;
+    }
+}
+
+void
+MLASCALL
+MlasTanhKernelRvv(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the RVV kernel for the hyperbolic tangent function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N > 0) {
+
+        const size_t vl = __riscv_vsetvl_e32m4(N);
+
+        vfloat32m4_t Input0 = __riscv_vle32_v_f32m4(Input, vl);
+        vbool8_t IsNaN = __riscv_vmfne_vv_f32m4_b8(Input0, Input0, vl);
+
+        vfloat32m4_t Value = __riscv_vfmax_vf_f32m4(Input0, -9.0f, vl);
+        Value = __riscv_vfmin_vf_f32m4(Value, 9.0f, vl);
+
+        vfloat32m4_t ValueSquared = __riscv_vfmul_vv_f32m4(Value, Value, vl);
+
+        vfloat32m4_t p;
+        p = __riscv_vfmv_v_f_f32m4(2.00018790482477e-13f, vl);
+        p = __riscv_vfmacc_vf_f32m4(p, -2.76076847742355e-16f, ValueSquared, vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(-8.60467152213735e-11f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(5.12229709037114e-08f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(1.48572235717979e-05f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(6.37261928875436e-04f, vl), vl);
+        p = __riscv_vfmadd_vv_f32m4(p, ValueSquared, __riscv_vfmv_v_f_f32m4(4.89352455891786e-03f, vl), vl);
+        p = __riscv_vfmul_vv_f32m4(p, Value, vl);
+
+        vfloat32m4_t q;
+        q = __riscv_vfmv_v_f_f32m4(1.18534705686654e-04f, vl);
+        q = __riscv_vfmacc_vf_f32m4(q, 1.19825839466702e-06f, ValueSquared, vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(2.26843463243900e-03f, vl), vl);
+        q = __riscv_vfmadd_vv_f32m4(q, ValueSquared, __riscv_vfmv_v_f_f32m4(4.89352518554385e-03f, vl), vl);
+
+        vfloat32m4_t Result = __riscv_vfdiv_vv_f32m4(p, q, vl);
+        Result = __riscv_vmerge_vvm_f32m4(Result, Input0, IsNaN, vl);
+
+        __riscv_vse32_v_f32m4(Output, Result, vl);
+
+        Input += vl;
+        Output += vl;
+        N -= vl;
+    }
+}
+
+#endif  // defined(MLAS_USE_RVV)
@@ -0,0 +1,151 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activate_kernel_sve.cpp
+
+Abstract:
+
+    This module implements the logistic and hyperbolic tangent kernels for
+    ARM SVE.
+
+    The kernels use the same polynomial coefficients and algorithm as the
+    generic kernels in logistic.cpp and tanh.cpp. The kernels are vector length
+    agnostic and process the trailing elements with a predicate instead of a
+    scalar loop.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_USE_SVE)
+
+#include <arm_sve.h>
+
+void
+MLASCALL
+MlasLogisticKernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the logistic function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t VectorLength = svcntw();
+
+    for (size_t n = 0; n < N; n += VectorLength) {
+
+        const svbool_t Predicate = svwhilelt_b32(uint64_t(n), uint64_t(N));
+
+        //
+        // N.B. FMAX and FMIN propagate a NaN input to the output.
+        //
+
+        svfloat32_t Value = svld1_f32(Predicate, Input + n);
+
+        Value = svmax_n_f32_x(Predicate, Value, -18.0f);
+        Value = svmin_n_f32_x(Predicate, Value, 18.0f);
+
+        svfloat32_t ValueSquared = svmul_f32_x(Predicate, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(4.37031012579801e-11f), 1.15627324459942e-07f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 6.08574864600143e-05f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 8.51377133304701e-03f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 2.48287947061529e-01f);
+        p = svmul_f32_x(Predicate, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(6.10247389755681e-13f), 5.76102136993427e-09f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 6.29106785017040e-06f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 1.70198817374094e-03f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 1.16817656904453e-01f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 9.93151921023180e-01f);
+
+        svfloat32_t Result = svadd_n_f32_x(Predicate, svdiv_f32_x(Predicate, p, q), 0.5f);
+
+        svst1_f32(Predicate, Output + n, Result);
+    }
+}
+
+void
+MLASCALL
+MlasTanhKernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the hyperbolic tangent function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t VectorLength = svcntw();
+
+    for (size_t n = 0; n < N; n += VectorLength) {
+
+        const svbool_t Predicate = svwhilelt_b32(uint64_t(n), uint64_t(N));
+
+        svfloat32_t Value = svld1_f32(Predicate, Input + n);
+
+        Value = svmax_n_f32_x(Predicate, Value, -9.0f);
+        Value = svmin_n_f32_x(Predicate, Value, 9.0f);
+
+        svfloat32_t ValueSquared = svmul_f32_x(Predicate, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(-2.76076847742355e-16f), 2.00018790482477e-13f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, -8.60467152213735e-11f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 5.12229709037114e-08f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 1.48572235717979e-05f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 6.37261928875436e-04f);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, 4.89352455891786e-03f);
+        p = svmul_f32_x(Predicate, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(1.19825839466702e-06f), 1.18534705686654e-04f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 2.26843463243900e-03f);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, 4.89352518554385e-03f);
+
+        svst1_f32(Predicate, Output + n, svdiv_f32_x(Predicate, p, q));
+    }
+}
+
+#endif  // defined(MLAS_USE_SVE)
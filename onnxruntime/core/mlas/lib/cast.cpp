@@ -12,9 +12,14 @@ Abstract:
 
     This module implements Half (F16) to Single (F32) precision casting.
 
+    This module also implements the Brain floating-point (BF16) to and from
+    Single (F32) precision casting.
+
 --*/
 #include "mlasi.h"
 
+#include <cstring>
+
 void
 MLASCALL
 MlasConvertHalfToFloatBuffer(
@@ -50,3 +55,196 @@ MlasConvertFloatToHalfBuffer(
         GetMlasPlatform().CastF32ToF16Kernel(Source, reinterpret_cast<unsigned short*>(Destination), Count);
     }
 }
+
+//
+// Brain floating-point (BF16) casting.
+//
+// The conversion from single precision rounds to nearest even and maps NaN to
+// a quiet NaN with the same sign, which matches the conversion done by Eigen
+// and required by the ONNX Cast operator. The conversion to single precision
+// is exact.
+//
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBFloat16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t(((Bits >> 16) & 0x8000) | 0x7FC0);
+    }
+
+    return uint16_t((Bits + ((Bits >> 16) & 1) + 0x7FFF) >> 16);
+}
+
+MLAS_FORCEINLINE
+float
+MlasBFloat16ToFloat(
+    uint16_t Value
+    )
+{
+    const uint32_t Bits = uint32_t(Value) << 16;
+    float Result;
+    std::memcpy(&Result, &Bits, sizeof(Result));
+    return Result;
+}
+
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+
+MLAS_FORCEINLINE
+MLAS_INT32X4
+MlasFloatToBFloat16x4(
+    const float* Source
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds four single precision elements to brain floating-point
+    precision. The result is returned in the upper 16 bits of each element.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    const uint32x4_t Bits = vreinterpretq_u32_f32(vld1q_f32(Source));
+    const uint32x4_t RoundingBias = vaddq_u32(vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1)), vdupq_n_u32(0x7FFF));
+    const uint32x4_t Rounded = vaddq_u32(Bits, RoundingBias);
+    const uint32x4_t NaNBits = vorrq_u32(vandq_u32(Bits, vdupq_n_u32(0x80000000)), vdupq_n_u32(0x7FC00000));
+    const uint32x4_t IsNaN = vmvnq_u32(vceqq_f32(vreinterpretq_f32_u32(Bits), vreinterpretq_f32_u32(Bits)));
+    return vreinterpretq_s32_u32(vbslq_u32(IsNaN, NaNBits, Rounded));
+#else
+    const __m128 Vector = _mm_loadu_ps(Source);
+    const __m128i Bits = _mm_castps_si128(Vector);
+    const __m128i RoundingBias = _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(Bits, 16), _mm_set1_epi32(1)),
+                                               _mm_set1_epi32(0x7FFF));
+    const __m128i Rounded = _mm_add_epi32(Bits, RoundingBias);
+    const __m128i NaNBits = _mm_or_si128(_mm_and_si128(Bits, _mm_set1_epi32(int32_t(0x80000000))),
+                                         _mm_set1_epi32(0x7FC00000));
+    const __m128i IsNaN = _mm_castps_si128(_mm_cmpunord_ps(Vector, Vector));
+    return MlasBlendInt32x4(Rounded, NaNBits, IsNaN);
+#endif
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision elements to brain
+    floating-point precision, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the single precision elements.
+
+    Destination - Supplies the buffer that receives the bits of the brain
+        floating-point elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+
+    while (Count >= 8) {
+
+        MLAS_INT32X4 Rounded0 = MlasFloatToBFloat16x4(Source);
+        MLAS_INT32X4 Rounded1 = MlasFloatToBFloat16x4(Source + 4);
+
+#if defined(MLAS_NEON_INTRINSICS)
+        uint16x8_t Packed = vcombine_u16(vshrn_n_u32(vreinterpretq_u32_s32(Rounded0), 16),
+                                         vshrn_n_u32(vreinterpretq_u32_s32(Rounded1), 16));
+        vst1q_u16(Destination, Packed);
+#else
+        //
+        // Sign extend the upper halves so that the signed saturating pack
+        // keeps the bits unchanged.
+        //
+
+        __m128i Packed = _mm_packs_epi32(_mm_srai_epi32(Rounded0, 16), _mm_srai_epi32(Rounded1, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Packed);
+#endif
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of brain floating-point elements to single
+    precision.
+
+Arguments:
+
+    Source - Supplies the bits of the brain floating-point elements.
+
+    Destination - Supplies the buffer that receives the single precision
+        elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+
+    while (Count >= 8) {
+
+#if defined(MLAS_NEON_INTRINSICS)
+        uint16x8_t Vector = vld1q_u16(Source);
+        vst1q_f32(Destination, vreinterpretq_f32_u32(vshll_n_u16(vget_low_u16(Vector), 16)));
+        vst1q_f32(Destination + 4, vreinterpretq_f32_u32(vshll_n_u16(vget_high_u16(Vector), 16)));
+#else
+        __m128i Vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        __m128i ZeroVector = _mm_setzero_si128();
+        _mm_storeu_ps(Destination, _mm_castsi128_ps(_mm_unpacklo_epi16(ZeroVector, Vector)));
+        _mm_storeu_ps(Destination + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(ZeroVector, Vector)));
+#endif
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBFloat16ToFloat(Source[i]);
+    }
+}
@@ -1113,6 +1113,385 @@ MlasComputeSoftmax<MLAS_FP16>(
     MLAS_THREADPOOL* ThreadPool
 );
 
+template <typename T>
+struct MLAS_ATTENTION_SOFTMAX_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const T* Input;
+    T* Output;
+    size_t N;
+    size_t D;
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<T>* Parameters;
+};
+
+void
+MlasComputeAttentionSoftmaxRow(
+    const float* Input,
+    float* Output,
+    size_t CountD,
+    float Scale,
+    float Softcap,
+    const float* Bias,
+    const float* Mask
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax function of one row of attention scores
+    after scaling and soft capping the scores and adding the bias and the mask.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    CountD - Supplies the number of columns of the row to process.
+
+    Scale - Supplies the scale applied to the input.
+
+    Softcap - Supplies the soft cap applied to the scaled input, else zero.
+
+    Bias - Supplies the optional bias added to the input.
+
+    Mask - Supplies the optional mask added to the input.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Soft capping computes Softcap * tanh(Input * Scale / Softcap), so compute
+    // the hyperbolic tangent in the output buffer and scale it by the soft cap
+    // in the next pass.
+    //
+
+    if (Softcap > 0.0f) {
+
+        const float TanhScale = Scale / Softcap;
+
+        for (size_t d = 0; d < CountD; d++) {
+            Output[d] = Input[d] * TanhScale;
+        }
+
+        MlasComputeTanh(Output, Output, CountD);
+
+        Input = Output;
+        Scale = Softcap;
+    }
+
+    //
+    // Apply the scale, the bias and the mask and find the maximum value of the
+    // row in the same pass.
+    //
+
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    size_t d = 0;
+
+    for (; d + 4 <= CountD; d += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input + d), ScaleVector);
+
+        if (Bias != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + d));
+        }
+
+        if (Mask != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Mask + d));
+        }
+
+        MlasStoreFloat32x4(Output + d, Vector);
+        MaximumVector = MlasMaximumFloat32x4(MaximumVector, Vector);
+    }
+
+    for (; d < CountD; d++) {
+
+        float Value = Input[d] * Scale;
+
+        if (Bias != nullptr) {
+            Value += Bias[d];
+        }
+
+        if (Mask != nullptr) {
+            Value += Mask[d];
+        }
+
+        Output[d] = Value;
+        Maximum = std::max(Maximum, Value);
+    }
+
+    Maximum = std::max(Maximum, MlasReduceMaximumFloat32x4(MaximumVector));
+
+    //
+    // Compute the exponential function for each element of the row in place
+    // and normalize the row.
+    //
+
+    float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+    float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Output, Output, CountD, &NegativeMaximum);
+#else
+    float Accumulation = MlasComputeSumExpF32Kernel(Output, Output, CountD, &NegativeMaximum);
+#endif
+
+    float Parameters[] = {1.0f / Accumulation};
+
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, CountD, Parameters);
+#else
+    MlasComputeSoftmaxOutputF32Kernel(Output, CountD, Parameters);
+#endif
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasAttentionSoftmaxValidCount(
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<float>& Parameters,
+    size_t n,
+    size_t D
+    )
+{
+    return Parameters.Causal ? std::min(D, n + Parameters.CausalOffset + 1) : D;
+}
+
+template <typename T>
+void
+MlasComputeAttentionSoftmaxThreaded(
+    void* Context,
+    ptrdiff_t Index
+);
+
+template <>
+void
+MlasComputeAttentionSoftmaxThreaded<float>(
+    void* Context,
+    ptrdiff_t Index
+)
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    attention softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_ATTENTION_SOFTMAX_WORK_BLOCK<float>*)Context;
+    const auto& Parameters = *WorkBlock->Parameters;
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    for (size_t EndN = n + CountN; n < EndN; n++) {
+
+        const size_t Offset = n * D;
+        const size_t CountD = MlasAttentionSoftmaxValidCount(Parameters, n, D);
+
+        MlasComputeAttentionSoftmaxRow(
+            WorkBlock->Input + Offset,
+            WorkBlock->Output + Offset,
+            CountD,
+            Parameters.Scale,
+            Parameters.Softcap,
+            Parameters.Bias != nullptr ? Parameters.Bias + Offset : nullptr,
+            Parameters.Mask != nullptr ? Parameters.Mask + Offset : nullptr);
+
+        //
+        // The columns past the causal limit get a zero probability.
+        //
+
+        std::fill_n(WorkBlock->Output + Offset + CountD, D - CountD, 0.0f);
+    }
+}
+
+template <>
+void
+MlasComputeAttentionSoftmaxThreaded<MLAS_FP16>(
+    void* Context,
+    ptrdiff_t Index
+)
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    attention softmax operation. The rows are converted to fp32 and the
+    softmax function is computed in fp32.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_ATTENTION_SOFTMAX_WORK_BLOCK<MLAS_FP16>*)Context;
+    const auto& Parameters = *WorkBlock->Parameters;
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    std::vector<float> Buffer(D * 3);
+    float* Row = Buffer.data();
+    float* Bias = Parameters.Bias != nullptr ? Row + D : nullptr;
+    float* Mask = Parameters.Mask != nullptr ? Row + 2 * D : nullptr;
+
+    MLAS_ATTENTION_SOFTMAX_PARAMS<float> RowParameters;
+    RowParameters.Causal = Parameters.Causal;
+    RowParameters.CausalOffset = Parameters.CausalOffset;
+
+    for (size_t EndN = n + CountN; n < EndN; n++) {
+
+        const size_t Offset = n * D;
+        const size_t CountD = MlasAttentionSoftmaxValidCount(RowParameters, n, D);
+
+        MlasConvertHalfToFloatBuffer(WorkBlock->Input + Offset, Row, CountD);
+
+        if (Bias != nullptr) {
+            MlasConvertHalfToFloatBuffer(Parameters.Bias + Offset, Bias, CountD);
+        }
+
+        if (Mask != nullptr) {
+            MlasConvertHalfToFloatBuffer(Parameters.Mask + Offset, Mask, CountD);
+        }
+
+        MlasComputeAttentionSoftmaxRow(Row, Row, CountD, Parameters.Scale, Parameters.Softcap, Bias, Mask);
+
+        MlasConvertFloatToHalfBuffer(Row, WorkBlock->Output + Offset, CountD);
+
+        std::fill_n(WorkBlock->Output + Offset + CountD, D - CountD, MLAS_FP16(0.0f));
+    }
+}
+
+template <typename T>
+void
+MLASCALL
+MlasComputeAttentionSoftmax(
+    const T* Input,
+    T* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<T>& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes the softmax function of rows of attention scores.
+    The scale, the soft cap, the bias, the mask and the causal mask are applied
+    in the pass that finds the maximum value of each row, so the scores are not
+    read and written by separate passes before the softmax function.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    Parameters - Supplies the options applied to the scores.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_ATTENTION_SOFTMAX_WORK_BLOCK<T> WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Parameters = &Parameters;
+
+    //
+    // Compute the number of target threads as for MlasComputeSoftmax.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeAttentionSoftmaxThreaded<T>, &WorkBlock, ThreadCountN, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasComputeAttentionSoftmax<float>(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<float>& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+template
+void
+MLASCALL
+MlasComputeAttentionSoftmax<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    size_t D,
+    const MLAS_ATTENTION_SOFTMAX_PARAMS<MLAS_FP16>& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+);
+
 template <>
 bool
 MLASCALL
@@ -0,0 +1,440 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convnhwc.cpp
+
+Abstract:
+
+    This module implements the single precision convolution of tensors in
+    NHWC format.
+
+    The convolution is computed as an implicit GEMM: for every kernel
+    position, the input pixels read by a run of output pixels of an output
+    row are evenly spaced in the NHWC input, so they are used in place as
+    the rows of the A matrix of a GEMM with the slice of the HWIO filter for
+    that kernel position. No im2col buffer is needed.
+
+    Depthwise convolutions are computed with an indirection buffer instead.
+
+--*/
+
+#include "mlasi.h"
+
+struct MLAS_CONV_NHWC_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* Output;
+    ptrdiff_t ThreadCount;
+};
+
+void
+MlasConvNhwcOutputRow(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t od,
+    size_t oh
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a row of the output of a convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the address of the input image.
+
+    Filter - Supplies the address of the filter in HWIO format.
+
+    Bias - Supplies the optional bias vector.
+
+    Output - Supplies the address of the output row.
+
+    od - Supplies the depth index of the output row.
+
+    oh - Supplies the height index of the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Dimensions = Parameters->Dimensions;
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t TotalInputChannels = GroupCount * InputChannels;
+    const size_t TotalFilterCount = GroupCount * FilterCount;
+
+    //
+    // A 2D convolution is computed as a 3D convolution with a depth of one.
+    //
+
+    const size_t DimOffset = Dimensions - 2;
+
+    const size_t InputDepth = (Dimensions == 3) ? Parameters->InputShape[0] : 1;
+    const size_t KernelDepth = (Dimensions == 3) ? Parameters->KernelShape[0] : 1;
+    const size_t DilationDepth = (Dimensions == 3) ? Parameters->DilationShape[0] : 1;
+    const size_t PaddingDepth = (Dimensions == 3) ? Parameters->Padding[0] : 0;
+    const size_t StrideDepth = (Dimensions == 3) ? Parameters->StrideShape[0] : 1;
+
+    const size_t InputHeight = Parameters->InputShape[DimOffset];
+    const size_t InputWidth = Parameters->InputShape[DimOffset + 1];
+    const size_t KernelHeight = Parameters->KernelShape[DimOffset];
+    const size_t KernelWidth = Parameters->KernelShape[DimOffset + 1];
+    const size_t DilationHeight = Parameters->DilationShape[DimOffset];
+    const size_t DilationWidth = Parameters->DilationShape[DimOffset + 1];
+    const size_t PaddingHeight = Parameters->Padding[DimOffset];
+    const size_t PaddingWidth = Parameters->Padding[DimOffset + 1];
+    const size_t StrideHeight = Parameters->StrideShape[DimOffset];
+    const size_t StrideWidth = Parameters->StrideShape[DimOffset + 1];
+    const size_t OutputWidth = Parameters->OutputShape[DimOffset + 1];
+
+    const size_t OutputRowElements = OutputWidth * TotalFilterCount;
+
+    //
+    // Apply the scaling of the existing output, then accumulate the products
+    // of every kernel position.
+    //
+
+    const float Beta = Parameters->Beta;
+
+    if (Beta == 0.0f) {
+        std::fill_n(Output, OutputRowElements, 0.0f);
+    } else if (Beta != 1.0f) {
+        for (size_t i = 0; i < OutputRowElements; i++) {
+            Output[i] *= Beta;
+        }
+    }
+
+    for (size_t kd = 0; kd < KernelDepth; kd++) {
+
+        const size_t id = od * StrideDepth + kd * DilationDepth - PaddingDepth;
+
+        if (id >= InputDepth) {
+            continue;
+        }
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            const size_t ih = oh * StrideHeight + kh * DilationHeight - PaddingHeight;
+
+            if (ih >= InputHeight) {
+                continue;
+            }
+
+            const float* InputRow = Input + (id * InputHeight + ih) * InputWidth * TotalInputChannels;
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                //
+                // Compute the range of output pixels that read an input pixel
+                // that is not padding for this kernel position.
+                //
+
+                const size_t KernelOffsetWidth = kw * DilationWidth;
+
+                size_t OutputStart = 0;
+
+                if (KernelOffsetWidth < PaddingWidth) {
+                    OutputStart = (PaddingWidth - KernelOffsetWidth + StrideWidth - 1) / StrideWidth;
+                }
+
+                if (InputWidth + PaddingWidth <= KernelOffsetWidth) {
+                    continue;
+                }
+
+                const size_t OutputEnd =
+                    std::min(OutputWidth, (InputWidth + PaddingWidth - KernelOffsetWidth - 1) / StrideWidth + 1);
+
+                if (OutputStart >= OutputEnd) {
+                    continue;
+                }
+
+                const size_t iw = OutputStart * StrideWidth + KernelOffsetWidth - PaddingWidth;
+                const size_t KernelIndex = (kd * KernelHeight + kh) * KernelWidth + kw;
+
+                for (size_t group = 0; group < GroupCount; group++) {
+
+                    MlasSgemmOperation(CblasNoTrans, CblasNoTrans, OutputEnd - OutputStart,
+                        FilterCount, InputChannels, 1.0f,
+                        InputRow + iw * TotalInputChannels + group * InputChannels,
+                        StrideWidth * TotalInputChannels,
+                        Filter + KernelIndex * InputChannels * TotalFilterCount + group * FilterCount,
+                        TotalFilterCount, 1.0f,
+                        Output + OutputStart * TotalFilterCount + group * FilterCount,
+                        TotalFilterCount, nullptr);
+                }
+            }
+        }
+    }
+
+    //
+    // Add the bias vector to every output pixel and apply the activation.
+    //
+
+    if (Bias != nullptr) {
+        for (size_t ow = 0; ow < OutputWidth; ow++) {
+            float* OutputPixel = Output + ow * TotalFilterCount;
+            MlasEltwiseAdd<float>(OutputPixel, Bias, OutputPixel, TotalFilterCount);
+        }
+    }
+
+    MlasActivation(Parameters->Activation, Output, nullptr, OutputWidth, TotalFilterCount, TotalFilterCount);
+}
+
+void
+MlasConvNhwcThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    NHWC convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_NHWC_WORK_BLOCK* WorkBlock = (const MLAS_CONV_NHWC_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t Dimensions = Parameters->Dimensions;
+    const size_t DimOffset = Dimensions - 2;
+
+    const size_t OutputDepth = (Dimensions == 3) ? Parameters->OutputShape[0] : 1;
+    const size_t OutputHeight = Parameters->OutputShape[DimOffset];
+    const size_t OutputWidth = Parameters->OutputShape[DimOffset + 1];
+
+    const size_t TotalInputChannels = Parameters->GroupCount * Parameters->InputChannels;
+    const size_t TotalFilterCount = Parameters->GroupCount * Parameters->FilterCount;
+
+    const size_t RowCount = OutputDepth * OutputHeight;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, Parameters->BatchCount * RowCount, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t bc = WorkIndex / RowCount;
+        const size_t od = (WorkIndex % RowCount) / OutputHeight;
+        const size_t oh = WorkIndex % OutputHeight;
+
+        MlasConvNhwcOutputRow(Parameters,
+            WorkBlock->Input + bc * Parameters->InputSize * TotalInputChannels,
+            WorkBlock->Filter,
+            WorkBlock->Bias,
+            WorkBlock->Output + WorkIndex * OutputWidth * TotalFilterCount,
+            od,
+            oh);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasConvNhwc(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation for tensors in NHWC
+    format.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters, prepared by MlasConvPrepare. The working buffer size and
+        the algorithm selected by MlasConvPrepare are not used.
+
+    Input - Supplies the input tensor in NHWC format.
+
+    Filter - Supplies the filter tensor in HWIO format: a matrix of
+        KernelSize * InputChannels rows and GroupCount * FilterCount columns,
+        where the columns of a group are contiguous.
+
+    Bias - Supplies the optional bias vector of GroupCount * FilterCount
+        elements.
+
+    Output - Supplies the output tensor in NHWC format. If the Beta parameter
+        is not zero, the output is accumulated to its existing contents.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Dimensions = Parameters->Dimensions;
+    const size_t DimOffset = Dimensions - 2;
+
+    const size_t RowCount =
+        ((Dimensions == 3) ? Parameters->OutputShape[0] : 1) * Parameters->OutputShape[DimOffset];
+    const size_t TotalRowCount = Parameters->BatchCount * RowCount;
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) >= TotalRowCount) {
+        TargetThreadCount = ptrdiff_t(TotalRowCount);
+    }
+
+    MLAS_CONV_NHWC_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasConvNhwcThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution of tensors in NHWC
+    format with an indirection buffer.
+
+Arguments:
+
+    Input - Supplies the indirection buffer: KernelSize pointers to the
+        input pixels of every output pixel. Padding is supplied as a pointer
+        to a vector of zeros.
+
+    Filter - Supplies the filter in HWC format: KernelSize rows of Channels
+        elements.
+
+    Bias - Supplies the optional bias vector.
+
+    Output - Supplies the address of the output pixels.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+    Beta - Supplies the scale of the existing output added to the result.
+
+    Activation - Supplies the activation applied to the result.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 4) {
+
+            MLAS_FLOAT32X4 Accumulator =
+                (Bias == nullptr) ? MlasZeroFloat32x4() : MlasLoadFloat32x4(&Bias[ChannelOffset]);
+
+            if (Beta != 0.0f) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(&Output[ChannelOffset]), Beta, Accumulator);
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 FilterVector = MlasLoadFloat32x4(&Filter[ChannelKernelOffset]);
+
+                Accumulator = MlasMultiplyAddFloat32x4(InputVector, FilterVector, Accumulator);
+                ChannelKernelOffset += Channels;
+            }
+
+            MlasStoreFloat32x4(&Output[ChannelOffset], Accumulator);
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float Accumulator = (Bias == nullptr) ? 0.0f : Bias[ChannelOffset];
+
+            if (Beta != 0.0f) {
+                Accumulator += Output[ChannelOffset] * Beta;
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator += Input[k][ChannelOffset] * Filter[ChannelKernelOffset];
+                ChannelKernelOffset += Channels;
+            }
+
+            Output[ChannelOffset] = Accumulator;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        MlasActivation(Activation, Output, nullptr, 1, Channels, Channels);
+
+        Input += KernelSize;
+        Output += Channels;
+        OutputCount -= 1;
+    }
+}
@@ -843,7 +843,8 @@ Arguments:
 
     Input - Supplies the input tensor.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter tensor, or the filter packed by
+        MlasConvWinogradPackFilter for MlasConvAlgorithmWinograd.
 
     Bias - Optionally supplies the bias vector.
 
@@ -874,6 +875,15 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // The Winograd algorithm processes all the batches with the packed filter.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -1041,7 +1051,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool WinogradFilterPacked
     )
 /*++
 
@@ -1088,6 +1099,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    WinogradFilterPacked - Supplies true if the caller has the filter packed
+        by MlasConvWinogradPackFilter, which allows the Winograd algorithm to
+        be selected.
+
 Return Value:
 
     None.
@@ -1168,6 +1183,23 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Use the Winograd algorithm for 3x3 convolutions with a packed filter if
+    // the output has at least one full tile in each dimension. A promoted 1D
+    // convolution has a kernel height of one, so the shapes supplied by the
+    // caller have two dimensions when they are checked.
+    //
+
+    if (WinogradFilterPacked && Parameters->KernelShape[0] == 3 &&
+        MlasConvWinogradIsSupported(Dimensions, GroupCount, InputChannels, FilterCount,
+            KernelShape, DilationShape, StrideShape) &&
+        Parameters->OutputShape[0] >= 4 && Parameters->OutputShape[1] >= 4) {
+
+        MlasConvWinogradPrepare(Parameters, WorkingBufferSize, ThreadPool);
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
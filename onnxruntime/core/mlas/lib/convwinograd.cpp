@@ -0,0 +1,578 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convwinograd.cpp
+
+Abstract:
+
+    This module implements the single precision 3x3 stride 1 convolution with
+    the Winograd F(4x4, 3x3) algorithm.
+
+    The output is computed in 4x4 tiles from 6x6 input tiles:
+
+        Y = AT * [(G * g * GT) . (BT * d * B)] * A
+
+    The filter transform U = G * g * GT is done once by
+    MlasConvWinogradPackFilter and stored as 36 matrices of FilterCount x
+    InputChannels. For a block of tiles, the input transform produces 36
+    matrices of InputChannels x TileCount, the element wise products are
+    summed over the input channels by 36 GEMMs and the output transform
+    writes the output tiles.
+
+    The interpolation points are 0, +-1, +-2 and infinity, which keep the
+    transforms small enough for the products to be accumulated in single
+    precision. Larger tiles are not supported for accuracy reasons.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the dimensions of the transformed tiles.
+//
+
+constexpr size_t MLAS_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_WINOGRAD_TILE_ELEMENTS = MLAS_WINOGRAD_INPUT_TILE * MLAS_WINOGRAD_INPUT_TILE;
+
+//
+// Define the minimum number of channels for which the Winograd algorithm is
+// faster than the GEMM based convolution.
+//
+
+constexpr size_t MLAS_WINOGRAD_MINIMUM_CHANNELS = 16;
+
+//
+// Define the number of elements of the per thread working buffer used to
+// size the blocks of tiles.
+//
+
+constexpr size_t MLAS_WINOGRAD_WORKING_BUFFER_ELEMENTS = 256 * 1024;
+
+constexpr size_t MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK = 64;
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* PackedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+};
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the Winograd algorithm can be used for the
+    convolution, independent of the input shape.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    KernelShape - Supplies the shape of the kernel.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns true if the Winograd algorithm can be used.
+
+--*/
+{
+    if (Dimensions != 2 || GroupCount != 1) {
+        return false;
+    }
+
+    if (InputChannels < MLAS_WINOGRAD_MINIMUM_CHANNELS || FilterCount < MLAS_WINOGRAD_MINIMUM_CHANNELS) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the packed filter for the
+    Winograd algorithm.
+
+Arguments:
+
+    FilterCount - Supplies the number of output channels.
+
+    InputChannels - Supplies the number of input channels.
+
+Return Value:
+
+    Returns the number of elements of the packed filter.
+
+--*/
+{
+    return MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filter to the Winograd domain.
+
+Arguments:
+
+    FilterCount - Supplies the number of output channels.
+
+    InputChannels - Supplies the number of input channels.
+
+    Filter - Supplies the filter tensor, FilterCount x InputChannels x 3 x 3.
+
+    PackedFilter - Receives the transformed filter, 36 x FilterCount x
+        InputChannels.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static constexpr float G[MLAS_WINOGRAD_INPUT_TILE][3] = {
+        {1.0f / 4, 0.0f, 0.0f},
+        {-1.0f / 6, -1.0f / 6, -1.0f / 6},
+        {-1.0f / 6, 1.0f / 6, -1.0f / 6},
+        {1.0f / 24, 1.0f / 12, 1.0f / 6},
+        {1.0f / 24, -1.0f / 12, 1.0f / 6},
+        {0.0f, 0.0f, 1.0f},
+    };
+
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t m = 0; m < FilterCount; m++) {
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (m * InputChannels + c) * 9;
+
+            //
+            // Compute G * g, then (G * g) * GT.
+            //
+
+            float Gg[MLAS_WINOGRAD_INPUT_TILE][3];
+
+            for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    Gg[i][j] = G[i][0] * g[j] + G[i][1] * g[3 + j] + G[i][2] * g[6 + j];
+                }
+            }
+
+            float* u = PackedFilter + m * InputChannels + c;
+
+            for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+                for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+                    u[(i * MLAS_WINOGRAD_INPUT_TILE + j) * MatrixSize] =
+                        Gg[i][0] * G[j][0] + Gg[i][1] * G[j][1] + Gg[i][2] * G[j][2];
+                }
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform(
+    const float d[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE],
+    float* v,
+    size_t Stride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes BT * d * B for one tile and stores the 36 elements
+    with the supplied stride.
+
+--*/
+{
+    float t[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+        t[0][j] = 4.0f * d[0][j] - 5.0f * d[2][j] + d[4][j];
+        t[1][j] = -4.0f * (d[1][j] + d[2][j]) + d[3][j] + d[4][j];
+        t[2][j] = 4.0f * (d[1][j] - d[2][j]) - d[3][j] + d[4][j];
+        t[3][j] = 2.0f * (d[3][j] - d[1][j]) - d[2][j] + d[4][j];
+        t[4][j] = 2.0f * (d[1][j] - d[3][j]) - d[2][j] + d[4][j];
+        t[5][j] = 4.0f * d[1][j] - 5.0f * d[3][j] + d[5][j];
+    }
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+        const float* r = t[i];
+        float* o = v + i * MLAS_WINOGRAD_INPUT_TILE * Stride;
+        o[0 * Stride] = 4.0f * r[0] - 5.0f * r[2] + r[4];
+        o[1 * Stride] = -4.0f * (r[1] + r[2]) + r[3] + r[4];
+        o[2 * Stride] = 4.0f * (r[1] - r[2]) - r[3] + r[4];
+        o[3 * Stride] = 2.0f * (r[3] - r[1]) - r[2] + r[4];
+        o[4 * Stride] = 2.0f * (r[1] - r[3]) - r[2] + r[4];
+        o[5 * Stride] = 4.0f * r[1] - 5.0f * r[3] + r[5];
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform(
+    const float* m,
+    size_t Stride,
+    float y[MLAS_WINOGRAD_OUTPUT_TILE][MLAS_WINOGRAD_OUTPUT_TILE]
+    )
+/*++
+
+Routine Description:
+
+    This routine computes AT * m * A for one tile from the 36 elements loaded
+    with the supplied stride.
+
+--*/
+{
+    float t[MLAS_WINOGRAD_OUTPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+        const float m0 = m[(0 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        const float m1 = m[(1 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        const float m2 = m[(2 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        const float m3 = m[(3 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        const float m4 = m[(4 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        const float m5 = m[(5 * MLAS_WINOGRAD_INPUT_TILE + j) * Stride];
+        t[0][j] = m0 + (m1 + m2) + (m3 + m4);
+        t[1][j] = (m1 - m2) + 2.0f * (m3 - m4);
+        t[2][j] = (m1 + m2) + 4.0f * (m3 + m4);
+        t[3][j] = (m1 - m2) + 8.0f * (m3 - m4) + m5;
+    }
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_OUTPUT_TILE; i++) {
+        const float* r = t[i];
+        y[i][0] = r[0] + (r[1] + r[2]) + (r[3] + r[4]);
+        y[i][1] = (r[1] - r[2]) + 2.0f * (r[3] - r[4]);
+        y[i][2] = (r[1] + r[2]) + 4.0f * (r[3] + r[4]);
+        y[i][3] = (r[1] - r[2]) + 8.0f * (r[3] - r[4]) + r[5];
+    }
+}
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the tile block size, the thread count and the
+    working buffer size of the Winograd algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileCountH = (Parameters->OutputShape[0] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    const size_t TileCountW = (Parameters->OutputShape[1] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+
+    //
+    // A block of tiles is a segment of a row of tiles. Size the block so that
+    // the transformed input and the products stay in the cache.
+    //
+
+    const size_t ElementsPerTile =
+        MLAS_WINOGRAD_TILE_ELEMENTS * (Parameters->InputChannels + Parameters->FilterCount);
+
+    size_t TileBlockSize = MLAS_WINOGRAD_WORKING_BUFFER_ELEMENTS / ElementsPerTile;
+    TileBlockSize = std::max(TileBlockSize, size_t(1));
+    TileBlockSize = std::min(TileBlockSize, MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK);
+    TileBlockSize = std::min(TileBlockSize, TileCountW);
+
+    const size_t TileBlockCountW = (TileCountW + TileBlockSize - 1) / TileBlockSize;
+    const size_t TaskCount = Parameters->BatchCount * TileCountH * TileBlockCountW;
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) >= TaskCount) {
+        TargetThreadCount = ptrdiff_t(TaskCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.TileCountH = TileCountH;
+    Parameters->u.Winograd.TileCountW = TileCountW;
+    Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * ElementsPerTile * TileBlockSize;
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (const MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const float Beta = Parameters->Beta;
+
+    const size_t TileCountH = Parameters->u.Winograd.TileCountH;
+    const size_t TileCountW = Parameters->u.Winograd.TileCountW;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TileBlockCountW = (TileCountW + TileBlockSize - 1) / TileBlockSize;
+
+    const size_t TaskCount = Parameters->BatchCount * TileCountH * TileBlockCountW;
+
+    size_t TaskStart;
+    size_t TaskRemaining;
+
+    MlasPartitionWork(Index, Parameters->ThreadCount, TaskCount, &TaskStart, &TaskRemaining);
+
+    float* TransformedInput = WorkBlock->WorkingBuffer +
+        size_t(Index) * MLAS_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount) * TileBlockSize;
+    float* Products = TransformedInput + MLAS_WINOGRAD_TILE_ELEMENTS * InputChannels * TileBlockSize;
+
+    for (size_t Task = TaskStart; Task < TaskStart + TaskRemaining; Task++) {
+
+        const size_t tw0 = (Task % TileBlockCountW) * TileBlockSize;
+        const size_t th = (Task / TileBlockCountW) % TileCountH;
+        const size_t n = Task / (TileBlockCountW * TileCountH);
+        const size_t TileCount = std::min(TileBlockSize, TileCountW - tw0);
+
+        const float* Input = WorkBlock->Input + n * InputChannels * InputSize;
+        float* Output = WorkBlock->Output + n * FilterCount * OutputSize;
+
+        //
+        // Transform the input tiles into 36 matrices of InputChannels x TileCount.
+        //
+
+        const ptrdiff_t ih0 = ptrdiff_t(th * MLAS_WINOGRAD_OUTPUT_TILE) - ptrdiff_t(PaddingTop);
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputSize;
+
+            for (size_t t = 0; t < TileCount; t++) {
+
+                const ptrdiff_t iw0 = ptrdiff_t((tw0 + t) * MLAS_WINOGRAD_OUTPUT_TILE) - ptrdiff_t(PaddingLeft);
+
+                float d[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+                for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+
+                    const ptrdiff_t ih = ih0 + ptrdiff_t(i);
+
+                    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+
+                        const ptrdiff_t iw = iw0 + ptrdiff_t(j);
+
+                        if (size_t(ih) < InputHeight && size_t(iw) < InputWidth) {
+                            d[i][j] = input[size_t(ih) * InputWidth + size_t(iw)];
+                        } else {
+                            d[i][j] = 0.0f;
+                        }
+                    }
+                }
+
+                MlasWinogradInputTransform(d, TransformedInput + c * TileCount + t, InputChannels * TileCount);
+            }
+        }
+
+        //
+        // Multiply the transformed filter and input, summing over the input
+        // channels.
+        //
+
+        for (size_t s = 0; s < MLAS_WINOGRAD_TILE_ELEMENTS; s++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels, 1.0f,
+                WorkBlock->PackedFilter + s * FilterCount * InputChannels, InputChannels,
+                TransformedInput + s * InputChannels * TileCount, TileCount, 0.0f,
+                Products + s * FilterCount * TileCount, TileCount);
+        }
+
+        //
+        // Transform the products into the output tiles.
+        //
+
+        const size_t oh0 = th * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t RowCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputHeight - oh0);
+        const size_t ow0 = tw0 * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t ColumnCount = std::min(TileCount * MLAS_WINOGRAD_OUTPUT_TILE, OutputWidth - ow0);
+
+        for (size_t m = 0; m < FilterCount; m++) {
+
+            float* output = Output + m * OutputSize + oh0 * OutputWidth + ow0;
+
+            for (size_t t = 0; t < TileCount; t++) {
+
+                float y[MLAS_WINOGRAD_OUTPUT_TILE][MLAS_WINOGRAD_OUTPUT_TILE];
+
+                MlasWinogradOutputTransform(Products + m * TileCount + t, FilterCount * TileCount, y);
+
+                const size_t ColumnStart = t * MLAS_WINOGRAD_OUTPUT_TILE;
+                const size_t TileColumnCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, ColumnCount - ColumnStart);
+
+                for (size_t i = 0; i < RowCount; i++) {
+
+                    float* row = output + i * OutputWidth + ColumnStart;
+
+                    for (size_t j = 0; j < TileColumnCount; j++) {
+                        row[j] = (Beta == 0.0f) ? y[i][j] : y[i][j] + Beta * row[j];
+                    }
+                }
+            }
+        }
+
+        //
+        // Apply the bias and the activation to each output row of the block.
+        //
+
+        for (size_t i = 0; i < RowCount; i++) {
+            MlasActivation(Parameters->Activation, Output + (oh0 + i) * OutputWidth + ow0, WorkBlock->Bias,
+                FilterCount, ColumnCount, OutputSize);
+        }
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation with the Winograd
+    algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter packed by MlasConvWinogradPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+}
@@ -2,6 +2,92 @@
 
 #include "mlasi.h"
 
+namespace
+{
+
+//
+// Multiplies N elements of the buffer by the scale.
+//
+MLAS_FORCEINLINE
+void
+MlasFlashAttentionScaleBuffer(
+    float* Buffer,
+    size_t N,
+    float Scale
+)
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 4) {
+        MlasStoreFloat32x4(Buffer, MlasMultiplyFloat32x4(MlasLoadFloat32x4(Buffer), ScaleVector));
+        Buffer += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        *Buffer++ *= Scale;
+        N--;
+    }
+}
+
+//
+// Computes Output = Input * Scale for N elements.
+//
+MLAS_FORCEINLINE
+void
+MlasFlashAttentionScaleBuffer(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale
+)
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 4) {
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input), ScaleVector));
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+        *Output++ = *Input++ * Scale;
+        N--;
+    }
+}
+
+//
+// Returns the range [first, last) of the keys that a query row attends to.
+//
+MLAS_FORCEINLINE
+void
+MlasFlashAttentionGetKeyRange(
+    const MlasFlashAttentionThreadedArgs* args,
+    ptrdiff_t kv_sequence_length,
+    ptrdiff_t causal_offset,
+    ptrdiff_t q_row,
+    ptrdiff_t* first,
+    ptrdiff_t* last
+)
+{
+    ptrdiff_t end = kv_sequence_length;
+    ptrdiff_t begin = 0;
+
+    if (args->is_causal) {
+        ptrdiff_t causal_length = causal_offset + q_row + 1;
+        end = std::min(end, causal_length);
+        if (args->local_window_size >= 0 && causal_length > args->local_window_size + 1) {
+            begin = causal_length - args->local_window_size - 1;
+        }
+    }
+
+    *first = begin;
+    *last = std::max(begin, end);
+}
+
+}  // namespace
+
 void
 MlasFlashAttentionThreaded(
     void* argptr,
@@ -13,8 +99,11 @@ MlasFlashAttentionThreaded(
     ptrdiff_t kv_block_size = static_cast<ptrdiff_t>(args->kv_block_size);
     ptrdiff_t batch_size = static_cast<ptrdiff_t>(args->batch_size);
     ptrdiff_t num_heads = static_cast<ptrdiff_t>(args->num_heads);
+    ptrdiff_t kv_num_heads = static_cast<ptrdiff_t>(args->kv_num_heads > 0 ? args->kv_num_heads : args->num_heads);
     ptrdiff_t q_sequence_length = static_cast<ptrdiff_t>(args->q_sequence_length);
     ptrdiff_t kv_sequence_length = static_cast<ptrdiff_t>(args->kv_sequence_length);
+    ptrdiff_t kv_sequence_stride =
+        static_cast<ptrdiff_t>(args->kv_sequence_stride > 0 ? args->kv_sequence_stride : args->kv_sequence_length);
     ptrdiff_t qk_head_size = static_cast<ptrdiff_t>(args->qk_head_size);
     ptrdiff_t v_head_size = static_cast<ptrdiff_t>(args->v_head_size);
     float* buffer = args->buffer;
@@ -24,12 +113,14 @@ MlasFlashAttentionThreaded(
     const float* key = args->key;
     const float* value = args->value;
     float* output = args->output;
+    const float softcap = args->softcap;
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
     auto&& mlas_platform = GetMlasPlatform();
 #endif
 
     ptrdiff_t q_chunk_count = (q_sequence_length + (q_block_size - 1)) / q_block_size;
+    ptrdiff_t head_group_size = num_heads / kv_num_heads;
 
     ptrdiff_t task_start = 0;
     ptrdiff_t task_end = 0;
@@ -55,29 +146,56 @@ MlasFlashAttentionThreaded(
         float* l = reinterpret_cast<float*>(buffer_current_thread);
         float* m = l + q_block_size;
         for (ptrdiff_t t = 0; t < q_block_size; ++t) {
+            l[t] = 0.0f;
             m[t] = std::numeric_limits<float>::lowest();
         }
         float* intermediate = m + q_block_size;
         float* temp_output = intermediate + q_block_size * kv_block_size;
         float negmax = 0;
 
-        for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+        size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
+
+        // The number of valid keys of this batch and the position of the first query in the keys.
+        ptrdiff_t kv_sequence_length_valid = kv_sequence_length;
+        if (args->kv_sequence_lengths != nullptr) {
+            kv_sequence_length_valid = std::min(kv_sequence_length, static_cast<ptrdiff_t>(args->kv_sequence_lengths[batch_idx]));
+        }
+        ptrdiff_t causal_offset = (args->causal_offsets != nullptr) ? static_cast<ptrdiff_t>(args->causal_offsets[batch_idx]) : 0;
+
+        // The keys attended to by the rows of this block. For a causal mask, the ranges of
+        // the rows are increasing, so blocks outside of [kv_first, kv_last) are skipped.
+        ptrdiff_t kv_first = 0;
+        ptrdiff_t kv_last = 0;
+        {
+            ptrdiff_t unused = 0;
+            MlasFlashAttentionGetKeyRange(args, kv_sequence_length_valid, causal_offset, q_idx, &kv_first, &unused);
+            MlasFlashAttentionGetKeyRange(args, kv_sequence_length_valid, causal_offset,
+                                          q_idx + static_cast<ptrdiff_t>(row_size_q_capped) - 1, &unused, &kv_last);
+        }
+        kv_first = (kv_first / kv_block_size) * kv_block_size;
+
+        ptrdiff_t h = batch_idx * num_heads + head_idx;
+        ptrdiff_t kv_h = batch_idx * kv_num_heads + head_idx / head_group_size;
+        const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
+
+        bool first_block = true;
+
+        for (ptrdiff_t ir = kv_first; ir < kv_last; ir += kv_block_size) {
             /*
-                S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
+                S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, kv_head_idx, ir:ir+kv_block_size, :]).T
+                S = softcap * tanh(S / softcap), if softcap > 0
+                S = masked(S)
                 old_m = m
                 m = max(m, rowmax(S))
                 diff = old_m - m
                 S = exp(S - m)
                 l = exp(diff) * l + rowsum(S)
-                O = diag(exp(diff)) * O + S * V[batch_idx, head_idx, ir:ir+kv_block_size, :]
+                O = diag(exp(diff)) * O + S * V[batch_idx, kv_head_idx, ir:ir+kv_block_size, :]
             */
-            ptrdiff_t h = batch_idx * num_heads + head_idx;
-            const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
-            const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
-            const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
+            const float* inputK = key + (kv_h * kv_sequence_stride + ir) * qk_head_size;
+            const float* inputV = value + (kv_h * kv_sequence_stride + ir) * v_head_size;
 
-            size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
-            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
+            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_last - ir));
 
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
                      CBLAS_TRANSPOSE::CblasTrans,
@@ -96,10 +214,34 @@ MlasFlashAttentionThreaded(
             for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
+                // Restrict the row to the keys that are not masked.
+                ptrdiff_t row_first = 0;
+                ptrdiff_t row_last = 0;
+                MlasFlashAttentionGetKeyRange(args, kv_sequence_length_valid, causal_offset, q_idx + irow, &row_first, &row_last);
+                row_first = std::clamp(row_first - ir, ptrdiff_t(0), static_cast<ptrdiff_t>(row_size_kv_capped));
+                row_last = std::clamp(row_last - ir, row_first, static_cast<ptrdiff_t>(row_size_kv_capped));
+                size_t row_count = static_cast<size_t>(row_last - row_first);
+
+                std::fill(p, p + row_first, 0.0f);
+                std::fill(p + row_last, p + row_size_kv_capped, 0.0f);
+
+                if (row_count == 0) {
+                    // The whole row is masked. The zero probabilities leave the output unchanged.
+                    continue;
+                }
+
+                p += row_first;
+
+                if (softcap > 0.0f) {
+                    MlasFlashAttentionScaleBuffer(p, row_count, 1.0f / softcap);
+                    MlasComputeTanh(p, p, row_count);
+                    MlasFlashAttentionScaleBuffer(p, row_count, softcap);
+                }
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_count);
 #else
-                float rowmax = MlasReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = MlasReduceMaximumF32Kernel(p, row_count);
 #endif
                 float m_diff = m[irow];
                 m[irow] = std::max(m[irow], rowmax);  // new m
@@ -107,22 +249,18 @@ MlasFlashAttentionThreaded(
                 m_diff -= m[irow];  // old - new (less than 0)
 
 #if defined(MLAS_TARGET_AMD64)
-                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_count, &negmax);
 #else
-                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_count, &negmax);
 #endif
 
-                // Note: for ir == 0, there is actually no need to calculate exp_diff
-                if (ir != 0) {
+                // Note: for the first block, there is no need to scale the old result because it is zero.
+                if (!first_block) {
                     float exp_diff = std::exp(m_diff);
                     l[irow] = exp_diff * l[irow] + rowsum;
-
-                    for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
-                        temp_output[irow * v_head_size + icol] = exp_diff * temp_output[irow * v_head_size + icol];
-                    }
+                    MlasFlashAttentionScaleBuffer(temp_output + irow * v_head_size, static_cast<size_t>(v_head_size), exp_diff);
                 } else {
                     l[irow] = rowsum;
-                    // When ir == 0, there is no need to scale the old result because it is zero.
                 }
             }
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
@@ -135,17 +273,20 @@ MlasFlashAttentionThreaded(
                      row_size_kv_capped,
                      inputV,
                      static_cast<size_t>(v_head_size),
-                     ir == 0 ? 0.0f : 1.0f,
+                     first_block ? 0.0f : 1.0f,
                      temp_output,
                      static_cast<size_t>(v_head_size));
+
+            first_block = false;
         }
 
         float* output_row = output + ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
-        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
-        // TODO: leverage advanced instruction sets
-        for (ptrdiff_t irow = 0; irow < row_size_q_valid; ++irow) {
-            for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
-                output_row[icol] = temp_output[irow * v_head_size + icol] / l[irow];
+        for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
+            if (first_block || l[irow] == 0.0f) {
+                // No key is attended to by this row.
+                std::fill_n(output_row, v_head_size, 0.0f);
+            } else {
+                MlasFlashAttentionScaleBuffer(temp_output + irow * v_head_size, output_row, static_cast<size_t>(v_head_size), 1.0f / l[irow]);
             }
             output_row += num_heads * v_head_size;
         }
@@ -0,0 +1,485 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    fp8gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a matrix B holding float8 (E4M3FN or E5M2) weights.
+
+    Matrix B is packed into panels of MLAS_FP8_GEMM_STRIDEN columns that keep
+    their float8 encoding. The kernel decodes a block of rows of a panel to
+    fp32 through a lookup table into a buffer that stays in the L1 cache, and
+    accumulates the products of all the rows of matrix A in fp32 registers.
+    The per-tensor or per-column scale of matrix B is applied once to the
+    accumulated output.
+
+--*/
+
+#include "mlasi.h"
+
+#include <limits>
+
+//
+// Number of columns of a packed panel of matrix B.
+//
+
+constexpr size_t MLAS_FP8_GEMM_STRIDEN = 16;
+
+//
+// Number of rows of a packed panel decoded at a time.
+//
+
+constexpr size_t MLAS_FP8_GEMM_STRIDEK = 256;
+
+//
+// Number of rows of matrix A processed by one unit of work.
+//
+
+constexpr size_t MLAS_FP8_GEMM_STRIDEM = 64;
+
+//
+// Lookup table that decodes all the values of a float8 type to fp32.
+//
+
+struct MLAS_FP8_DECODE_TABLE {
+    float Values[256];
+
+    constexpr MLAS_FP8_DECODE_TABLE(unsigned ExponentBits, int ExponentBias, bool HasInfinity) : Values{}
+    {
+        const unsigned MantissaBits = 7 - ExponentBits;
+        const unsigned MaximumExponent = (1u << ExponentBits) - 1;
+        const unsigned MaximumMantissa = (1u << MantissaBits) - 1;
+
+        for (unsigned Bits = 0; Bits < 256; Bits++) {
+
+            const unsigned Exponent = (Bits >> MantissaBits) & MaximumExponent;
+            const unsigned Mantissa = Bits & MaximumMantissa;
+            float Value = 0.0f;
+
+            //
+            // E5M2 reserves the largest exponent for infinities and NaNs as
+            // IEEE 754 does, while E4M3FN only reserves the largest encoding
+            // for NaN.
+            //
+
+            if (HasInfinity && Exponent == MaximumExponent) {
+                Value = (Mantissa == 0) ? std::numeric_limits<float>::infinity()
+                                        : std::numeric_limits<float>::quiet_NaN();
+            } else if (!HasInfinity && Exponent == MaximumExponent && Mantissa == MaximumMantissa) {
+                Value = std::numeric_limits<float>::quiet_NaN();
+            } else {
+                int Power = (Exponent == 0) ? 1 - ExponentBias : int(Exponent) - ExponentBias;
+                Value = float((Exponent == 0) ? 0 : 1) + float(Mantissa) / float(1u << MantissaBits);
+                for (; Power > 0; Power--) {
+                    Value *= 2.0f;
+                }
+                for (; Power < 0; Power++) {
+                    Value *= 0.5f;
+                }
+            }
+
+            Values[Bits] = (Bits & 0x80) ? -Value : Value;
+        }
+    }
+};
+
+static constexpr MLAS_FP8_DECODE_TABLE MlasFp8E4M3FNDecodeTable(4, 7, false);
+static constexpr MLAS_FP8_DECODE_TABLE MlasFp8E5M2DecodeTable(5, 15, true);
+
+size_t
+MLASCALL
+MlasFp8GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    const size_t PanelCount = (N + MLAS_FP8_GEMM_STRIDEN - 1) / MLAS_FP8_GEMM_STRIDEN;
+
+    return PanelCount * K * MLAS_FP8_GEMM_STRIDEN;
+}
+
+void
+MLASCALL
+MlasFp8GemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasFp8GemmPackBSize().
+
+    The columns are split into panels of MLAS_FP8_GEMM_STRIDEN columns, each
+    stored as K contiguous rows. The columns past N in the last panel are
+    padded with zero, which encodes 0.0 for both float8 types.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B, holding the float8 encodings.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    uint8_t* D = reinterpret_cast<uint8_t*>(PackedB);
+
+    for (size_t n = 0; n < N; n += MLAS_FP8_GEMM_STRIDEN) {
+
+        const size_t CountN = std::min(N - n, MLAS_FP8_GEMM_STRIDEN);
+        const uint8_t* b = B + n;
+
+        for (size_t k = 0; k < K; k++) {
+
+            std::copy_n(b, CountN, D);
+            std::fill_n(D + CountN, MLAS_FP8_GEMM_STRIDEN - CountN, uint8_t(0));
+
+            b += ldb;
+            D += MLAS_FP8_GEMM_STRIDEN;
+        }
+    }
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasFp8GemmKernel(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    bool ZeroMode,
+    const float* Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies RowCount rows of matrix A with a decoded block of
+    a panel of matrix B.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of the decoded block, stored as CountK rows of
+        MLAS_FP8_GEMM_STRIDEN values.
+
+    CountK - Supplies the number of rows of the decoded block.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of matrix C to update.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+    Scale - Supplies MLAS_FP8_GEMM_STRIDEN scales to apply to the output
+        matrix after the accumulation, else nullptr if the output matrix
+        holds partial sums.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulators[RowCount][4];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < 4; j++) {
+            Accumulators[r][j] = MlasZeroFloat32x4();
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        MLAS_FLOAT32X4 BElements0 = MlasLoadFloat32x4(B + 0);
+        MLAS_FLOAT32X4 BElements1 = MlasLoadFloat32x4(B + 4);
+        MLAS_FLOAT32X4 BElements2 = MlasLoadFloat32x4(B + 8);
+        MLAS_FLOAT32X4 BElements3 = MlasLoadFloat32x4(B + 12);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            MLAS_FLOAT32X4 AElement = MlasBroadcastFloat32x4(A + r * lda + k);
+            Accumulators[r][0] = MlasMultiplyAddFloat32x4(AElement, BElements0, Accumulators[r][0]);
+            Accumulators[r][1] = MlasMultiplyAddFloat32x4(AElement, BElements1, Accumulators[r][1]);
+            Accumulators[r][2] = MlasMultiplyAddFloat32x4(AElement, BElements2, Accumulators[r][2]);
+            Accumulators[r][3] = MlasMultiplyAddFloat32x4(AElement, BElements3, Accumulators[r][3]);
+        }
+
+        B += MLAS_FP8_GEMM_STRIDEN;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+
+        if (CountN == MLAS_FP8_GEMM_STRIDEN) {
+
+            for (size_t j = 0; j < 4; j++) {
+                MLAS_FLOAT32X4 Vector = Accumulators[r][j];
+                if (!ZeroMode) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(c + j * 4));
+                }
+                if (Scale != nullptr) {
+                    Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Scale + j * 4));
+                }
+                MlasStoreFloat32x4(c + j * 4, Vector);
+            }
+
+        } else {
+
+            float Row[MLAS_FP8_GEMM_STRIDEN];
+
+            for (size_t j = 0; j < 4; j++) {
+                MlasStoreFloat32x4(Row + j * 4, Accumulators[r][j]);
+            }
+
+            for (size_t n = 0; n < CountN; n++) {
+                float Value = Row[n];
+                if (!ZeroMode) {
+                    Value += c[n];
+                }
+                if (Scale != nullptr) {
+                    Value *= Scale[n];
+                }
+                c[n] = Value;
+            }
+        }
+    }
+}
+
+void
+MlasFp8GemmOperation(
+    const MLAS_FP8_DECODE_TABLE& DecodeTable,
+    size_t CountM,
+    size_t N,
+    size_t K,
+    size_t Panel,
+    const MLAS_FP8_GEMM_DATA_PARAMS* Data,
+    size_t RangeStartM
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of rows of matrix C for one packed panel of
+    matrix B.
+
+Arguments:
+
+    DecodeTable - Supplies the lookup table of the float8 type of matrix B.
+
+    CountM - Supplies the number of rows to compute.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Panel - Supplies the index of the packed panel of matrix B.
+
+    Data - Supplies the matrices data parameters.
+
+    RangeStartM - Supplies the first row to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float DecodedB[MLAS_FP8_GEMM_STRIDEK * MLAS_FP8_GEMM_STRIDEN], 64);
+    MLAS_DECLSPEC_ALIGN(float Scale[MLAS_FP8_GEMM_STRIDEN], 16);
+
+    const size_t n = Panel * MLAS_FP8_GEMM_STRIDEN;
+    const size_t CountN = std::min(N - n, MLAS_FP8_GEMM_STRIDEN);
+
+    for (size_t i = 0; i < MLAS_FP8_GEMM_STRIDEN; i++) {
+        Scale[i] = (i >= CountN) ? 0.0f : Data->PerColumnScale ? Data->Scale[n + i] : Data->Scale[0];
+    }
+
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(Data->PackedB) + Panel * K * MLAS_FP8_GEMM_STRIDEN;
+
+    for (size_t k = 0; k < K; k += MLAS_FP8_GEMM_STRIDEK) {
+
+        const size_t CountK = std::min(K - k, MLAS_FP8_GEMM_STRIDEK);
+        const size_t DecodeCount = CountK * MLAS_FP8_GEMM_STRIDEN;
+
+        for (size_t i = 0; i < DecodeCount; i++) {
+            DecodedB[i] = DecodeTable.Values[b[i]];
+        }
+
+        b += DecodeCount;
+
+        const bool ZeroMode = (k == 0);
+        const float* ScaleOrNull = (k + CountK == K) ? Scale : nullptr;
+
+        const float* a = Data->A + RangeStartM * Data->lda + k;
+        float* c = Data->C + RangeStartM * Data->ldc + n;
+        size_t RowsRemaining = CountM;
+
+        while (RowsRemaining >= 4) {
+            MlasFp8GemmKernel<4>(a, Data->lda, DecodedB, CountK, c, Data->ldc, CountN, ZeroMode, ScaleOrNull);
+            a += 4 * Data->lda;
+            c += 4 * Data->ldc;
+            RowsRemaining -= 4;
+        }
+
+        switch (RowsRemaining) {
+            case 3:
+                MlasFp8GemmKernel<3>(a, Data->lda, DecodedB, CountK, c, Data->ldc, CountN, ZeroMode, ScaleOrNull);
+                break;
+            case 2:
+                MlasFp8GemmKernel<2>(a, Data->lda, DecodedB, CountK, c, Data->ldc, CountN, ZeroMode, ScaleOrNull);
+                break;
+            case 1:
+                MlasFp8GemmKernel<1>(a, Data->lda, DecodedB, CountK, c, Data->ldc, CountN, ZeroMode, ScaleOrNull);
+                break;
+        }
+    }
+
+    //
+    // The output is only written by the loop above when K is not zero.
+    //
+
+    if (K == 0) {
+        for (size_t m = 0; m < CountM; m++) {
+            std::fill_n(Data->C + (RangeStartM + m) * Data->ldc + n, CountN, 0.0f);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasFp8GemmBatch(
+    MLAS_FP8_TYPE BType,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_FP8_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched single precision matrix/matrix
+    multiply operation with a packed float8 matrix B.
+
+Arguments:
+
+    BType - Supplies the float8 type of matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies an array of matrices data parameters.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const MLAS_FP8_DECODE_TABLE& DecodeTable =
+        (BType == MlasFp8E5M2) ? MlasFp8E5M2DecodeTable : MlasFp8E4M3FNDecodeTable;
+
+    //
+    // Each unit of work computes a block of rows for one packed panel, so the
+    // panel is decoded once for all the rows of the block.
+    //
+
+    const size_t BlockCountM = (M + MLAS_FP8_GEMM_STRIDEM - 1) / MLAS_FP8_GEMM_STRIDEM;
+    const size_t PanelCount = (N + MLAS_FP8_GEMM_STRIDEN - 1) / MLAS_FP8_GEMM_STRIDEN;
+    const size_t UnitsPerGemm = BlockCountM * PanelCount;
+    const size_t TotalUnits = UnitsPerGemm * BatchSize;
+
+    const double Complexity = double(M) * double(N) * double(std::max<size_t>(K, 1)) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > TotalUnits) {
+        TargetThreadCount = ptrdiff_t(TotalUnits);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, TargetThreadCount, TotalUnits, &WorkIndex, &WorkRemaining);
+
+        for (size_t Unit = WorkIndex; Unit < WorkIndex + WorkRemaining; Unit++) {
+
+            const size_t Batch = Unit / UnitsPerGemm;
+            const size_t Panel = (Unit % UnitsPerGemm) / BlockCountM;
+            const size_t RangeStartM = (Unit % BlockCountM) * MLAS_FP8_GEMM_STRIDEM;
+            const size_t CountM = std::min(M - RangeStartM, MLAS_FP8_GEMM_STRIDEM);
+
+            MlasFp8GemmOperation(DecodeTable, CountM, N, K, Panel, &Data[Batch], RangeStartM);
+        }
+    });
+}
@@ -32,6 +32,18 @@ MlasFp16AccelerationSupported()
 #endif
 }
 
+bool MLASCALL
+MlasHalfGemmAccelerationSupported()
+{
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+    return MlasFp16AccelerationSupported();
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch != nullptr;
+#else
+    return false;
+#endif
+}
+
 
 void
 MLASCALL
@@ -124,12 +136,14 @@ MlasHalfGemmPackBSize(
     const auto* dispatch = MlasHalfGemmGetDispatch();
     const auto padding = dispatch->BufOverRead;
     const auto PackedK = dispatch->PackededK;
+    const auto PackedN = dispatch->PackedN;
     if (!float2half && dispatch->CopyPackBRoutine == nullptr) {
         // No packing routine provided
         return 0;
     }
     const size_t AlignedK = (K + PackedK - 1) & ~(PackedK - 1);
-    const size_t BytesRequired = N * AlignedK * FP16_SIZE + padding;
+    const size_t AlignedN = (N + PackedN - 1) & ~(PackedN - 1);
+    const size_t BytesRequired = AlignedN * AlignedK * FP16_SIZE + padding;
     const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
     const size_t AlignedBytesRequired =
         (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
@@ -577,6 +591,7 @@ const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault = {
     nullptr,
     MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_DEFAULT>,
     MLAS_HALF_GEMM_KERNEL_DEFAULT::PackedK,
+    1,
     MLAS_HALF_GEMM_KERNEL_DEFAULT::KernelMaxM,
     0
 };
@@ -493,6 +493,7 @@ struct MLAS_HALFGEMM_DISPATCH {
     MLAS_HALFGEMM_COPYPACKB_ROUTINE* CopyPackBRoutine;  /**< Pack function for B */
     MLAS_HALFGEMM_CONVERTPACKB_ROUTINE* ConvertPackBRoutine; /**< Convert and pack function for B */
     size_t PackededK;
+    size_t PackedN;                       /**< Packed alignment on the N dim of B */
     size_t StrideM;
     size_t BufOverRead;
 };
@@ -509,6 +510,10 @@ MlasHalfGemmGetDispatch()
 {
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
     return &MlasHalfGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    // nullptr when the processor doesn't support AVX512_FP16
+    const MLAS_HALFGEMM_DISPATCH* dispatch = GetMlasPlatform().HalfGemmDispatch;
+    return (dispatch != nullptr) ? dispatch : &MlasHalfGemmDispatchDefault;
 #else
     return &MlasHalfGemmDispatchDefault;
 #endif
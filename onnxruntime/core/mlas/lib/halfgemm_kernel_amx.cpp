@@ -0,0 +1,341 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for AMX-FP16.
+
+    The products are accumulated in single precision in the tiles and
+    rounded to half precision once per slice of K. B is packed in panels of
+    16 columns, the rows of a panel are padded to a multiple of 32 and
+    stored as pairs, so that the 16 columns of two consecutive rows are
+    interleaved:
+
+        B[k][0] B[k+1][0] B[k][1] B[k+1][1] ... B[k][15] B[k+1][15]
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+#include "amx_common.h"
+
+#include <immintrin.h>
+
+#if defined(MLAS_TARGET_AMD64)
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+struct MLAS_HALF_GEMM_KERNEL_AMX {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 32;  // max # rows the tiles can process
+    static constexpr size_t PackedK = 32;     // # of fp16 values in a row of the A tiles
+    static constexpr size_t PackedN = 16;     // # of columns of a B tile
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{128, 256, 256};
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasHalfGemmAlignCountKAmx(size_t CountK)
+{
+    return (CountK + MLAS_HALF_GEMM_KERNEL_AMX::PackedK - 1) & ~(MLAS_HALF_GEMM_KERNEL_AMX::PackedK - 1);
+}
+
+MLAS_FORCEINLINE
+__mmask16
+MlasHalfGemmMaskAmx(size_t Count)
+{
+    return (Count >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Count) - 1);
+}
+
+/**
+ * @brief Pack pairs of rows of fp16 values in panels of 16 columns, RowRoutine
+ *        returns the 16 fp16 values of a row of a panel
+ */
+template <typename RowRoutine>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmPackPairsAmx(
+    _mlas_fp16_* D,
+    size_t CountN,
+    size_t CountK,
+    RowRoutine LoadRow
+    )
+{
+    //
+    // The two rows are concatenated, interleave them.
+    //
+
+    static const uint16_t InterleaveIndices[32] = {
+        0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23,
+        8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31,
+    };
+    const __m512i Interleave = _mm512_loadu_si512(InterleaveIndices);
+    const size_t PackedCountK = MlasHalfGemmAlignCountKAmx(CountK);
+
+    for (size_t n = 0; n < CountN; n += MLAS_HALF_GEMM_KERNEL_AMX::PackedN) {
+        const __mmask16 Mask = MlasHalfGemmMaskAmx(CountN - n);
+        for (size_t k = 0; k < PackedCountK; k += 2) {
+            const __m256i Row0 = (k < CountK) ? LoadRow(k, n, Mask) : _mm256_setzero_si256();
+            const __m256i Row1 = (k + 1 < CountK) ? LoadRow(k + 1, n, Mask) : _mm256_setzero_si256();
+            const __m512i Rows = _mm512_inserti64x4(_mm512_castsi256_si512(Row0), Row1, 1);
+            _mm512_storeu_si512(D, _mm512_permutexvar_epi16(Interleave, Rows));
+            D += 32;
+        }
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmCopyPackB<MLAS_HALF_GEMM_KERNEL_AMX>(
+    _mlas_fp16_* D,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    MlasHalfGemmPackPairsAmx(D, CountN, CountK, [=](size_t k, size_t n, __mmask16 Mask) {
+        return _mm256_maskz_loadu_epi16(Mask, B + k * ldb + n);
+    });
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AMX>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    MlasHalfGemmPackPairsAmx(D, CountN, CountK, [=](size_t k, size_t n, __mmask16 Mask) {
+        return _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, B + k * ldb + n), _MM_FROUND_TO_NEAREST_INT);
+    });
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AMX>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    //
+    // The driver steps through the rows with a leading dimension of PackedK
+    // aligned CountK.
+    //
+
+    const size_t PackedCountK = MlasHalfGemmAlignCountKAmx(CountK);
+
+    while (CountM-- > 0) {
+        for (size_t k = 0; k < PackedCountK; k += 16) {
+            const __mmask16 Mask = MlasHalfGemmMaskAmx((k < CountK) ? CountK - k : 0);
+            const __m256i Row = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, A + k), _MM_FROUND_TO_NEAREST_INT);
+            _mm256_mask_storeu_epi16(D + k, MlasHalfGemmMaskAmx(PackedCountK - k), Row);
+        }
+        A += lda;
+        D += PackedCountK;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+const _mlas_fp16_*
+MlasHalfGemmPackedBOffset<MLAS_HALF_GEMM_KERNEL_AMX>(
+    const _mlas_fp16_* PackedB,
+    size_t DimN,
+    size_t DimK,
+    size_t StartN,
+    size_t StartK)
+{
+    MLAS_UNREFERENCED_PARAMETER(DimN);
+    return PackedB + StartN * MlasHalfGemmAlignCountKAmx(DimK) + StartK * MLAS_HALF_GEMM_KERNEL_AMX::PackedN;
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasHalfGemmPackedBLeadingDim<MLAS_HALF_GEMM_KERNEL_AMX>(
+    size_t DimN,
+    size_t DimK)
+{
+    // # of rows of a panel
+    MLAS_UNREFERENCED_PARAMETER(DimN);
+    return MlasHalfGemmAlignCountKAmx(DimK);
+}
+
+//
+// Rounds a 16x16 tile of accumulators to half precision and stores the valid
+// elements to the output.
+//
+
+MLAS_FORCEINLINE
+void
+MlasHalfGemmStoreTileAmx(
+    const float* Tile,
+    _mlas_fp16_* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const _mlas_fp16_* Bias,
+    bool ZeroMode
+    )
+{
+    const __mmask16 Mask = MlasHalfGemmMaskAmx(CountN);
+    const __m512 BiasElements = (Bias != nullptr)
+        ? _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(Mask, Bias)) : _mm512_setzero_ps();
+
+    for (size_t m = 0; m < CountM; m++) {
+        __m512 Accumulator = _mm512_add_ps(_mm512_load_ps(Tile), BiasElements);
+        if (!ZeroMode) {
+            Accumulator = _mm512_add_ps(Accumulator, _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(Mask, C)));
+        }
+        _mm256_mask_storeu_epi16(C, Mask, _mm512_cvtps_ph(Accumulator, _MM_FROUND_TO_NEAREST_INT));
+        Tile += 16;
+        C += ldc;
+    }
+}
+
+/**
+ * @brief Compute up to 32 rows of the output with the tiles
+ *
+ *            B TMM6    B TMM7
+ *  A TMM4    C TMM0    C TMM1
+ *  A TMM5    C TMM2    C TMM3
+ *
+ * The rows of A are copied to a local buffer padded with zeros, so that
+ * the A tiles never read past the rows or the columns of A.
+ */
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AMX>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    constexpr size_t KernelMaxM = MLAS_HALF_GEMM_KERNEL_AMX::KernelMaxM;
+    constexpr MLAS_HALF_GEMM_STRIDES Strides = MLAS_HALF_GEMM_KERNEL_AMX::Strides;
+
+    MLAS_DECLSPEC_ALIGN(_mlas_fp16_ PanelA[KernelMaxM * Strides.K], 64);
+    MLAS_DECLSPEC_ALIGN(float Tiles[4][16 * 16], 64);
+    static const float ZeroTile[16 * 16] = {0};
+
+    MlasAmxLoadTileConfig();
+
+    //
+    // The K slices of the driver are at most Strides.K long, a prepacked B
+    // without K slices is stepped through here.
+    //
+
+    size_t CountSliceK;
+    for (size_t k = 0; k < CountK; k += CountSliceK) {
+        CountSliceK = std::min(CountK - k, Strides.K);
+        const size_t PackedCountK = MlasHalfGemmAlignCountKAmx(CountSliceK);
+        const size_t CountRows = std::min(CountM, KernelMaxM);
+        const bool SliceZeroMode = ZeroMode && (k == 0);
+        const _mlas_fp16_* SliceBias = SliceZeroMode ? Bias : nullptr;
+
+        for (size_t m = 0; m < KernelMaxM; m++) {
+            for (size_t kk = 0; kk < PackedCountK; kk += 16) {
+                const size_t CountColumns = (m < CountRows && kk < CountSliceK) ? CountSliceK - kk : 0;
+                const __m256i Row = _mm256_maskz_loadu_epi16(MlasHalfGemmMaskAmx(CountColumns), A + m * lda + k + kk);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(PanelA + m * PackedCountK + kk), Row);
+            }
+        }
+
+        const size_t StrideA = PackedCountK * sizeof(_mlas_fp16_);
+        const _mlas_fp16_* a1 = PanelA + 16 * PackedCountK;
+        const size_t CountM0 = std::min(CountRows, size_t(16));
+        const size_t CountM1 = CountRows - CountM0;
+
+        for (size_t n = 0; n < CountN; n += 32) {
+            const size_t CountN0 = std::min(CountN - n, size_t(16));
+            const size_t CountN1 = std::min(CountN - n - CountN0, size_t(16));
+            const _mlas_fp16_* b0 = B + n * ldb + k * MLAS_HALF_GEMM_KERNEL_AMX::PackedN;
+            const _mlas_fp16_* b1 = b0 + 16 * ldb;
+
+            tile_loadd(TMM0, ZeroTile, 16 * sizeof(float));
+            tile_loadd(TMM1, ZeroTile, 16 * sizeof(float));
+            tile_loadd(TMM2, ZeroTile, 16 * sizeof(float));
+            tile_loadd(TMM3, ZeroTile, 16 * sizeof(float));
+
+            for (size_t kk = 0; kk < PackedCountK; kk += 32) {
+                tile_loadd(TMM4, PanelA + kk, StrideA);
+                tile_loadd(TMM6, b0 + kk * 16, 64);
+                tile_dpfp16ps(TMM0, TMM4, TMM6);
+                if (CountN1 > 0) {
+                    tile_loadd(TMM7, b1 + kk * 16, 64);
+                    tile_dpfp16ps(TMM1, TMM4, TMM7);
+                }
+                if (CountM1 > 0) {
+                    tile_loadd(TMM5, a1 + kk, StrideA);
+                    tile_dpfp16ps(TMM2, TMM5, TMM6);
+                    if (CountN1 > 0) {
+                        tile_dpfp16ps(TMM3, TMM5, TMM7);
+                    }
+                }
+            }
+
+            const _mlas_fp16_* bias0 = (SliceBias != nullptr) ? SliceBias + n : nullptr;
+            tile_stored(TMM0, Tiles[0], 16 * sizeof(float));
+            MlasHalfGemmStoreTileAmx(Tiles[0], C + n, ldc, CountM0, CountN0, bias0, SliceZeroMode);
+            if (CountM1 > 0) {
+                tile_stored(TMM2, Tiles[2], 16 * sizeof(float));
+                MlasHalfGemmStoreTileAmx(Tiles[2], C + 16 * ldc + n, ldc, CountM1, CountN0, bias0, SliceZeroMode);
+            }
+            if (CountN1 > 0) {
+                const _mlas_fp16_* bias1 = (SliceBias != nullptr) ? SliceBias + n + 16 : nullptr;
+                tile_stored(TMM1, Tiles[1], 16 * sizeof(float));
+                MlasHalfGemmStoreTileAmx(Tiles[1], C + n + 16, ldc, CountM0, CountN1, bias1, SliceZeroMode);
+                if (CountM1 > 0) {
+                    tile_stored(TMM3, Tiles[3], 16 * sizeof(float));
+                    MlasHalfGemmStoreTileAmx(Tiles[3], C + 16 * ldc + n + 16, ldc, CountM1, CountN1, bias1,
+                                             SliceZeroMode);
+                }
+            }
+        }
+    }
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAmx = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AMX>,
+    MlasHalfGemmCopyPackB<MLAS_HALF_GEMM_KERNEL_AMX>,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AMX>,
+    MLAS_HALF_GEMM_KERNEL_AMX::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AMX::PackedN,
+    MLAS_HALF_GEMM_KERNEL_AMX::KernelMaxM,
+    0
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
@@ -0,0 +1,213 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for AVX512_FP16.
+
+    Like the NEON kernel, the products are accumulated in half precision
+    with VFMADD231PH, B is not packed.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+#if defined(MLAS_TARGET_AMD64)
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+//
+// Returns the mask of the first Count (at most 32) 16-bit elements of a vector.
+//
+
+MLAS_FORCEINLINE
+__mmask32
+MlasHalfGemmMaskAvx512Fp16(size_t Count)
+{
+    return (Count >= 32) ? __mmask32(0xFFFFFFFF) : __mmask32((1u << Count) - 1);
+}
+
+MLAS_FORCEINLINE
+__m512h
+MlasHalfGemmLoadAvx512Fp16(__mmask32 Mask, const _mlas_fp16_* Buffer)
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Buffer));
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx512(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    while (CntRow > 0) {
+        for (size_t c = 0; c < CntCol; c += 16) {
+            const __mmask16 Mask = (CntCol - c >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << (CntCol - c)) - 1);
+            const __m512 Row = _mm512_maskz_loadu_ps(Mask, src + c);
+            _mm256_mask_storeu_epi16(dest + c, Mask, _mm512_cvtps_ph(Row, _MM_FROUND_TO_NEAREST_INT));
+        }
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute RowCount rows of the output, 64 columns at a time
+ *
+ * In ZeroMode the accumulators start from the bias, otherwise the
+ * accumulated products are added to C.
+ */
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmComputeRowsAvx512Fp16(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    for (size_t n = 0; n < CountN; n += 64) {
+        const __mmask32 Mask0 = MlasHalfGemmMaskAvx512Fp16(CountN - n);
+        const __mmask32 Mask1 = MlasHalfGemmMaskAvx512Fp16((CountN - n > 32) ? CountN - n - 32 : 0);
+
+        __m512h Accumulators[RowCount][2];
+
+        const __m512h Bias0 = (Bias != nullptr) ? MlasHalfGemmLoadAvx512Fp16(Mask0, Bias + n) : _mm512_setzero_ph();
+        const __m512h Bias1 = (Bias != nullptr) ? MlasHalfGemmLoadAvx512Fp16(Mask1, Bias + n + 32) : _mm512_setzero_ph();
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = Bias0;
+            Accumulators[r][1] = Bias1;
+        }
+
+        const _mlas_fp16_* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m512h BElements0 = MlasHalfGemmLoadAvx512Fp16(Mask0, b);
+            const __m512h BElements1 = MlasHalfGemmLoadAvx512Fp16(Mask1, b + 32);
+            for (size_t r = 0; r < RowCount; r++) {
+                const __m512h ABroadcast = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+                Accumulators[r][0] = _mm512_fmadd_ph(ABroadcast, BElements0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm512_fmadd_ph(ABroadcast, BElements1, Accumulators[r][1]);
+            }
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            _mlas_fp16_* c = C + r * ldc + n;
+            if (!ZeroMode) {
+                Accumulators[r][0] = _mm512_add_ph(Accumulators[r][0], MlasHalfGemmLoadAvx512Fp16(Mask0, c));
+                Accumulators[r][1] = _mm512_add_ph(Accumulators[r][1], MlasHalfGemmLoadAvx512Fp16(Mask1, c + 32));
+            }
+            _mm512_mask_storeu_epi16(c, Mask0, _mm512_castph_si512(Accumulators[r][0]));
+            _mm512_mask_storeu_epi16(c + 32, Mask1, _mm512_castph_si512(Accumulators[r][1]));
+        }
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 6:
+            MlasHalfGemmComputeRowsAvx512Fp16<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmComputeRowsAvx512Fp16<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmComputeRowsAvx512Fp16<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmComputeRowsAvx512Fp16<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmComputeRowsAvx512Fp16<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmComputeRowsAvx512Fp16<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    1,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
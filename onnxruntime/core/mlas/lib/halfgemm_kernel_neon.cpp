@@ -182,6 +182,7 @@ const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchNeon = {
     nullptr,
     MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_NEON>,
     MLAS_HALF_GEMM_KERNEL_NEON::PackedK,
+    1,
     MLAS_HALF_GEMM_KERNEL_NEON::KernelMaxM,
     32 // kernel may read beyond buffer end by 32 bytes
 };
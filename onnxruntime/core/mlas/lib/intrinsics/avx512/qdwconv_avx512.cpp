@@ -0,0 +1,97 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_avx512.cpp
+
+Abstract:
+
+    This module implements the quantized integer depthwise convolution kernels.
+
+    This implementation uses AVX512 core (AVX512F/BW/DQ/VL) instructions.
+
+--*/
+
+#include "qdwconv_avx512.h"
+
+template<typename InputType, typename FilterType>
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    auto MultiplyAdd = [](__m512i Accumulator, __m512i InputPairs, __m512i FilterPairs) {
+        return _mm512_add_epi32(Accumulator, _mm512_madd_epi16(InputPairs, FilterPairs));
+    };
+
+    MlasConvDepthwiseKernelAvx512Dispatch(Input, InputZeroPoint, Filter, FilterZeroPoint, Output,
+        Channels, OutputCount, KernelSize, MultiplyAdd);
+}
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core<uint8_t, int8_t>(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const int8_t* Filter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core<uint8_t, uint8_t>(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core<int8_t, int8_t>(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const int8_t* Filter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core<int8_t, uint8_t>(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
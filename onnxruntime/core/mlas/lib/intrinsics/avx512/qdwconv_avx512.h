@@ -0,0 +1,208 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_avx512.h
+
+Abstract:
+
+    This module implements the common kernel for the quantized integer
+    depthwise convolution with AVX512 instructions.
+
+    The kernel processes blocks of 32 channels, which fill a 64-byte vector
+    once widened to 16 bits, and pairs of kernel elements: the two input and
+    filter vectors are interleaved so that a single VPMADDWD or VNNI VPDPWSSD
+    instruction multiplies and accumulates both kernel elements. The trailing
+    channels are processed with masked loads and stores.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+template<typename ElementType>
+MLAS_FORCEINLINE
+__m512i
+MlasConvDepthwiseLoadAvx512(
+    const ElementType* Buffer,
+    __mmask32 Mask,
+    __m512i ZeroPointVector
+    )
+{
+    const __m256i Elements = _mm256_maskz_loadu_epi8(Mask, Buffer);
+    __m512i Vector;
+
+    if (std::is_signed<ElementType>::value) {
+        Vector = _mm512_cvtepi8_epi16(Elements);
+    } else {
+        Vector = _mm512_cvtepu8_epi16(Elements);
+    }
+
+    return _mm512_sub_epi16(Vector, ZeroPointVector);
+}
+
+template<typename InputType, typename FilterType, size_t KernelSizeT, typename MultiplyAddType>
+MLAS_FORCEINLINE
+void
+MlasConvDepthwiseKernelAvx512(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    MultiplyAddType MultiplyAdd
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer depthwise convolution kernel.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    InputZeroPoint - Supplies the zero point offset of the input tensor.
+
+    Filter - Supplies the filter tensor in HW1O format.
+
+    FilterZeroPoint - Supplies the zero point offset of the filter tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume. This is ignored if KernelSizeT is not zero.
+
+    MultiplyAdd - Supplies the routine to accumulate the sums of the products
+        of the pairs of 16-bit elements to a vector of 32-bit elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if constexpr (KernelSizeT != 0) {
+        KernelSize = KernelSizeT;
+    }
+
+    const __m512i InputZeroPointVector = _mm512_set1_epi16(InputZeroPoint);
+    const __m512i FilterZeroPointVector = _mm512_set1_epi16(FilterZeroPoint);
+    const __m512i ZeroVector = _mm512_setzero_si512();
+
+    //
+    // Define the permutes that restore the channel order of the accumulators,
+    // which are interleaved per 128-bit lane by the unpack instructions.
+    //
+
+    const __m512i ReorderIndices0 = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+    const __m512i ReorderIndices1 = _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+
+    while (OutputCount > 0) {
+
+        for (size_t ChannelOffset = 0; ChannelOffset < Channels; ChannelOffset += 32) {
+
+            const size_t ChannelCount = std::min<size_t>(Channels - ChannelOffset, 32);
+            const __mmask32 LoadMask = (ChannelCount == 32) ? __mmask32(0xFFFFFFFF) :
+                __mmask32((uint32_t(1) << ChannelCount) - 1);
+
+            __m512i Accumulator0 = _mm512_setzero_si512();
+            __m512i Accumulator1 = _mm512_setzero_si512();
+            const FilterType* filter = Filter + ChannelOffset;
+
+            size_t k = 0;
+
+            for (; k + 2 <= KernelSize; k += 2) {
+
+                __m512i InputVector0 = MlasConvDepthwiseLoadAvx512(&Input[k][ChannelOffset], LoadMask, InputZeroPointVector);
+                __m512i InputVector1 = MlasConvDepthwiseLoadAvx512(&Input[k + 1][ChannelOffset], LoadMask, InputZeroPointVector);
+                __m512i FilterVector0 = MlasConvDepthwiseLoadAvx512(filter, LoadMask, FilterZeroPointVector);
+                __m512i FilterVector1 = MlasConvDepthwiseLoadAvx512(filter + Channels, LoadMask, FilterZeroPointVector);
+
+                Accumulator0 = MultiplyAdd(Accumulator0, _mm512_unpacklo_epi16(InputVector0, InputVector1),
+                    _mm512_unpacklo_epi16(FilterVector0, FilterVector1));
+                Accumulator1 = MultiplyAdd(Accumulator1, _mm512_unpackhi_epi16(InputVector0, InputVector1),
+                    _mm512_unpackhi_epi16(FilterVector0, FilterVector1));
+
+                filter += Channels * 2;
+            }
+
+            if (k < KernelSize) {
+
+                __m512i InputVector = MlasConvDepthwiseLoadAvx512(&Input[k][ChannelOffset], LoadMask, InputZeroPointVector);
+                __m512i FilterVector = MlasConvDepthwiseLoadAvx512(filter, LoadMask, FilterZeroPointVector);
+
+                Accumulator0 = MultiplyAdd(Accumulator0, _mm512_unpacklo_epi16(InputVector, ZeroVector),
+                    _mm512_unpacklo_epi16(FilterVector, ZeroVector));
+                Accumulator1 = MultiplyAdd(Accumulator1, _mm512_unpackhi_epi16(InputVector, ZeroVector),
+                    _mm512_unpackhi_epi16(FilterVector, ZeroVector));
+            }
+
+            __m512i Reorder0 = _mm512_permutex2var_epi64(Accumulator0, ReorderIndices0, Accumulator1);
+            __m512i Reorder1 = _mm512_permutex2var_epi64(Accumulator0, ReorderIndices1, Accumulator1);
+
+            if (ChannelCount == 32) {
+                _mm512_storeu_si512(&Output[0], Reorder0);
+                _mm512_storeu_si512(&Output[16], Reorder1);
+            } else {
+                const uint32_t StoreMask = uint32_t(LoadMask);
+                _mm512_mask_storeu_epi32(&Output[0], __mmask16(StoreMask), Reorder0);
+                _mm512_mask_storeu_epi32(&Output[16], __mmask16(StoreMask >> 16), Reorder1);
+            }
+
+            Output += ChannelCount;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+//
+// Dispatches to the specializations for the common 3x3 and 5x5 kernel sizes,
+// which fully unroll the loop over the kernel elements.
+//
+
+template<typename InputType, typename FilterType, typename MultiplyAddType>
+MLAS_FORCEINLINE
+void
+MlasConvDepthwiseKernelAvx512Dispatch(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    MultiplyAddType MultiplyAdd
+    )
+{
+    switch (KernelSize) {
+        case 9:
+            MlasConvDepthwiseKernelAvx512<InputType, FilterType, 9>(Input, InputZeroPoint, Filter,
+                FilterZeroPoint, Output, Channels, OutputCount, KernelSize, MultiplyAdd);
+            break;
+        case 25:
+            MlasConvDepthwiseKernelAvx512<InputType, FilterType, 25>(Input, InputZeroPoint, Filter,
+                FilterZeroPoint, Output, Channels, OutputCount, KernelSize, MultiplyAdd);
+            break;
+        default:
+            MlasConvDepthwiseKernelAvx512<InputType, FilterType, 0>(Input, InputZeroPoint, Filter,
+                FilterZeroPoint, Output, Channels, OutputCount, KernelSize, MultiplyAdd);
+            break;
+    }
+}
@@ -0,0 +1,174 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements layer normalization kernels for fp32/16.
+
+    The sum and the sum of squares of a row are accumulated in the same pass,
+    which also adds the optional skip and bias and writes their sum. A second
+    pass normalizes the row.
+
+--*/
+
+#include "layernorm.h"
+
+template <typename T>
+void
+MLASCALL
+MlasLayerNormOneRow_FallBack(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+) {
+    auto load = [&](size_t i) {
+        float value = static_cast<float>(input[i]);
+        if (skip != nullptr) {
+            value += skip[i];
+        }
+        if (bias != nullptr) {
+            value += bias[i];
+        }
+        return value;
+    };
+
+    float sum = 0.0f;
+    float sum_square = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        const float value = load(i);
+        if (input_skip_bias_sum != nullptr) {
+            input_skip_bias_sum[i] = static_cast<T>(value);
+        }
+        sum += value;
+        sum_square += value * value;
+    }
+
+    const float row_mean = simplified ? 0.0f : sum / n;
+    const float variance = sum_square / n - row_mean * row_mean;
+    const float row_inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+
+    for (size_t i = 0; i < n; i++) {
+        float value = (load(i) - row_mean) * row_inv_std_dev * scale[i];
+        if (!simplified && shift != nullptr) {
+            value += shift[i];
+        }
+        output[i] = static_cast<T>(value);
+    }
+
+    if (mean != nullptr) {
+        *mean = row_mean;
+    }
+    if (inv_std_dev != nullptr) {
+        *inv_std_dev = row_inv_std_dev;
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormOneRow<float>(
+    const float* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    float* output,
+    float* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+) {
+    const auto* dispatch = GetMlasPlatform().LayerNormDispatch;
+
+    if (dispatch == nullptr || dispatch->SLayerNorm == nullptr) {
+        MlasLayerNormOneRow_FallBack<float>(input, skip, bias, scale, shift, n, epsilon, simplified, output,
+                                            input_skip_bias_sum, mean, inv_std_dev);
+        return;
+    }
+
+    dispatch->SLayerNorm(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                         mean, inv_std_dev);
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormOneRow<MLAS_FP16>(
+    const MLAS_FP16* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    MLAS_FP16* output,
+    MLAS_FP16* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+) {
+    const auto* dispatch = GetMlasPlatform().LayerNormDispatch;
+
+    if (dispatch == nullptr || dispatch->HLayerNorm == nullptr) {
+        MlasLayerNormOneRow_FallBack<MLAS_FP16>(input, skip, bias, scale, shift, n, epsilon, simplified, output,
+                                                input_skip_bias_sum, mean, inv_std_dev);
+        return;
+    }
+
+    dispatch->HLayerNorm(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                         mean, inv_std_dev);
+}
+
+template
+void
+MLASCALL
+MlasLayerNormOneRow_FallBack<float>(
+    const float* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    float* output,
+    float* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+);
+
+template
+void
+MLASCALL
+MlasLayerNormOneRow_FallBack<MLAS_FP16>(
+    const MLAS_FP16* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    MLAS_FP16* output,
+    MLAS_FP16* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+);
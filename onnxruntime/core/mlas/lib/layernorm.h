@@ -0,0 +1,76 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module includes kernel function prototypes and helper functions for
+    implementing layer normalization, optionally fused with the skip and bias
+    addition of SkipLayerNormalization.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+struct MLAS_LAYERNORM_DISPATCH {
+    // layer normalization kernel for fp32
+    typedef void(SLayerNorm_Fn)(
+        const float* input,
+        const float* skip,
+        const float* bias,
+        const float* scale,
+        const float* shift,
+        size_t n,
+        float epsilon,
+        bool simplified,
+        float* output,
+        float* input_skip_bias_sum,
+        float* mean,
+        float* inv_std_dev
+    );
+
+    SLayerNorm_Fn* SLayerNorm = nullptr;
+
+    // layer normalization kernel for fp16, computed in fp32
+    typedef void(HLayerNorm_Fn)(
+        const MLAS_FP16* input,
+        const float* skip,
+        const float* bias,
+        const float* scale,
+        const float* shift,
+        size_t n,
+        float epsilon,
+        bool simplified,
+        MLAS_FP16* output,
+        MLAS_FP16* input_skip_bias_sum,
+        float* mean,
+        float* inv_std_dev
+    );
+
+    HLayerNorm_Fn* HLayerNorm = nullptr;
+};
+
+template <typename T>
+void MLASCALL
+MlasLayerNormOneRow_FallBack(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+);
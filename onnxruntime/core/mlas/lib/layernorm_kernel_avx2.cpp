@@ -0,0 +1,208 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for AVX2 supported
+    h/w.
+
+--*/
+
+#include "layernorm.h"
+
+namespace layernorm_avx2 {
+
+namespace {
+
+static constexpr int32_t mask_buffer[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+MLAS_FORCEINLINE
+__m256
+Load(const float* input, size_t count, __m256i mask)
+{
+    return (count >= 8) ? _mm256_loadu_ps(input) : _mm256_maskload_ps(input, mask);
+}
+
+MLAS_FORCEINLINE
+__m256
+Load(const MLAS_FP16* input, size_t count, __m256i mask)
+{
+    MLAS_UNREFERENCED_PARAMETER(mask);
+
+    if (count >= 8) {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+    }
+
+    uint16_t buffer[8] = {0};
+    std::copy_n(reinterpret_cast<const uint16_t*>(input), count, buffer);
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)));
+}
+
+MLAS_FORCEINLINE
+void
+Store(float* output, __m256 value, size_t count, __m256i mask)
+{
+    if (count >= 8) {
+        _mm256_storeu_ps(output, value);
+    } else {
+        _mm256_maskstore_ps(output, mask, value);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+Store(MLAS_FP16* output, __m256 value, size_t count, __m256i mask)
+{
+    MLAS_UNREFERENCED_PARAMETER(mask);
+
+    const __m128i half = _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT);
+    if (count >= 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), half);
+    } else {
+        uint16_t buffer[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), half);
+        std::copy_n(buffer, count, reinterpret_cast<uint16_t*>(output));
+    }
+}
+
+MLAS_FORCEINLINE
+float
+ReduceAdd(__m256 value)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+template <typename T>
+void
+LayerNormKernel_Avx2_Impl(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    // Loads eight elements of input + skip + bias. The masked out elements are zero.
+    auto load_sum = [&](size_t i, size_t count, __m256i mask) {
+        __m256 value = Load(input + i, count, mask);
+        if (skip != nullptr) {
+            value = _mm256_add_ps(value, Load(skip + i, count, mask));
+        }
+        if (bias != nullptr) {
+            value = _mm256_add_ps(value, Load(bias + i, count, mask));
+        }
+        return value;
+    };
+
+    __m256 sum = _mm256_setzero_ps();
+    __m256 sum_square = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < n; i += 8) {
+        const size_t count = std::min(n - i, size_t(8));
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask_buffer + 8 - count));
+        const __m256 value = load_sum(i, count, mask);
+        if (input_skip_bias_sum != nullptr) {
+            Store(input_skip_bias_sum + i, value, count, mask);
+        }
+        sum = _mm256_add_ps(sum, value);
+        sum_square = _mm256_fmadd_ps(value, value, sum_square);
+    }
+
+    const float row_mean = simplified ? 0.0f : ReduceAdd(sum) / n;
+    const float variance = ReduceAdd(sum_square) / n - row_mean * row_mean;
+    const float row_inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+
+    const __m256 mean_vector = _mm256_set1_ps(row_mean);
+    const __m256 inv_std_dev_vector = _mm256_set1_ps(row_inv_std_dev);
+    const bool has_shift = !simplified && shift != nullptr;
+
+    for (size_t i = 0; i < n; i += 8) {
+        const size_t count = std::min(n - i, size_t(8));
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask_buffer + 8 - count));
+        __m256 value = _mm256_mul_ps(_mm256_sub_ps(load_sum(i, count, mask), mean_vector), inv_std_dev_vector);
+        if (has_shift) {
+            value = _mm256_fmadd_ps(value, Load(scale + i, count, mask), Load(shift + i, count, mask));
+        } else {
+            value = _mm256_mul_ps(value, Load(scale + i, count, mask));
+        }
+        Store(output + i, value, count, mask);
+    }
+
+    if (mean != nullptr) {
+        *mean = row_mean;
+    }
+    if (inv_std_dev != nullptr) {
+        *inv_std_dev = row_inv_std_dev;
+    }
+}
+
+}  // namespace
+
+void
+LayerNormKernel_Avx2_fp32(
+    const float* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    float* output,
+    float* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Avx2_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                              mean, inv_std_dev);
+}
+
+void
+LayerNormKernel_Avx2_fp16(
+    const MLAS_FP16* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    MLAS_FP16* output,
+    MLAS_FP16* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Avx2_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                              mean, inv_std_dev);
+}
+
+}  // namespace layernorm_avx2
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx2 = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.SLayerNorm = layernorm_avx2::LayerNormKernel_Avx2_fp32;
+    d.HLayerNorm = layernorm_avx2::LayerNormKernel_Avx2_fp16;
+    return d;
+}();
@@ -0,0 +1,197 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for AVX512F
+    supported h/w.
+
+--*/
+
+#include "layernorm.h"
+
+namespace layernorm_avx512 {
+
+namespace {
+
+MLAS_FORCEINLINE
+__m512
+Load(const float* input, __mmask16 mask, size_t count)
+{
+    MLAS_UNREFERENCED_PARAMETER(count);
+
+    return _mm512_maskz_loadu_ps(mask, input);
+}
+
+MLAS_FORCEINLINE
+__m512
+Load(const MLAS_FP16* input, __mmask16 mask, size_t count)
+{
+    MLAS_UNREFERENCED_PARAMETER(mask);
+
+    // Without AVX512BW, the partial load of 16-bit elements is done by a copy.
+    if (count >= 16) {
+        return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)));
+    }
+
+    uint16_t buffer[16] = {0};
+    std::copy_n(reinterpret_cast<const uint16_t*>(input), count, buffer);
+    return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer)));
+}
+
+MLAS_FORCEINLINE
+void
+Store(float* output, __m512 value, __mmask16 mask, size_t count)
+{
+    MLAS_UNREFERENCED_PARAMETER(count);
+
+    _mm512_mask_storeu_ps(output, mask, value);
+}
+
+MLAS_FORCEINLINE
+void
+Store(MLAS_FP16* output, __m512 value, __mmask16 mask, size_t count)
+{
+    MLAS_UNREFERENCED_PARAMETER(mask);
+
+    const __m256i half = _mm512_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT);
+    if (count >= 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), half);
+    } else {
+        uint16_t buffer[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer), half);
+        std::copy_n(buffer, count, reinterpret_cast<uint16_t*>(output));
+    }
+}
+
+template <typename T>
+void
+LayerNormKernel_Avx512_Impl(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    // Loads sixteen elements of input + skip + bias. The masked out elements are zero.
+    auto load_sum = [&](size_t i, __mmask16 mask, size_t count) {
+        __m512 value = Load(input + i, mask, count);
+        if (skip != nullptr) {
+            value = _mm512_add_ps(value, Load(skip + i, mask, count));
+        }
+        if (bias != nullptr) {
+            value = _mm512_add_ps(value, Load(bias + i, mask, count));
+        }
+        return value;
+    };
+
+    __m512 sum = _mm512_setzero_ps();
+    __m512 sum_square = _mm512_setzero_ps();
+
+    for (size_t i = 0; i < n; i += 16) {
+        const size_t count = std::min(n - i, size_t(16));
+        const __mmask16 mask = __mmask16((1u << count) - 1);
+        const __m512 value = load_sum(i, mask, count);
+        if (input_skip_bias_sum != nullptr) {
+            Store(input_skip_bias_sum + i, value, mask, count);
+        }
+        sum = _mm512_add_ps(sum, value);
+        sum_square = _mm512_fmadd_ps(value, value, sum_square);
+    }
+
+    const float row_mean = simplified ? 0.0f : _mm512_reduce_add_ps(sum) / n;
+    const float variance = _mm512_reduce_add_ps(sum_square) / n - row_mean * row_mean;
+    const float row_inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+
+    const __m512 mean_vector = _mm512_set1_ps(row_mean);
+    const __m512 inv_std_dev_vector = _mm512_set1_ps(row_inv_std_dev);
+    const bool has_shift = !simplified && shift != nullptr;
+
+    for (size_t i = 0; i < n; i += 16) {
+        const size_t count = std::min(n - i, size_t(16));
+        const __mmask16 mask = __mmask16((1u << count) - 1);
+        __m512 value = _mm512_mul_ps(_mm512_sub_ps(load_sum(i, mask, count), mean_vector), inv_std_dev_vector);
+        if (has_shift) {
+            value = _mm512_fmadd_ps(value, Load(scale + i, mask, count), Load(shift + i, mask, count));
+        } else {
+            value = _mm512_mul_ps(value, Load(scale + i, mask, count));
+        }
+        Store(output + i, value, mask, count);
+    }
+
+    if (mean != nullptr) {
+        *mean = row_mean;
+    }
+    if (inv_std_dev != nullptr) {
+        *inv_std_dev = row_inv_std_dev;
+    }
+}
+
+}  // namespace
+
+void
+LayerNormKernel_Avx512_fp32(
+    const float* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    float* output,
+    float* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Avx512_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                                mean, inv_std_dev);
+}
+
+void
+LayerNormKernel_Avx512_fp16(
+    const MLAS_FP16* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    MLAS_FP16* output,
+    MLAS_FP16* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Avx512_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                                mean, inv_std_dev);
+}
+
+}  // namespace layernorm_avx512
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx512 = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.SLayerNorm = layernorm_avx512::LayerNormKernel_Avx512_fp32;
+    d.HLayerNorm = layernorm_avx512::LayerNormKernel_Avx512_fp16;
+    return d;
+}();
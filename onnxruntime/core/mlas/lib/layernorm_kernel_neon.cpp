@@ -0,0 +1,217 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for ARM NEON.
+
+--*/
+
+#include "layernorm.h"
+
+namespace layernorm_neon {
+
+namespace {
+
+MLAS_FORCEINLINE
+float32x4_t
+Load(const float* input, size_t count)
+{
+    if (count >= 4) {
+        return vld1q_f32(input);
+    }
+
+    float buffer[4] = {0.0f};
+    std::copy_n(input, count, buffer);
+    return vld1q_f32(buffer);
+}
+
+MLAS_FORCEINLINE
+void
+Store(float* output, float32x4_t value, size_t count)
+{
+    if (count >= 4) {
+        vst1q_f32(output, value);
+    } else {
+        float buffer[4];
+        vst1q_f32(buffer, value);
+        std::copy_n(buffer, count, output);
+    }
+}
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+MLAS_FORCEINLINE
+float32x4_t
+Load(const MLAS_FP16* input, size_t count)
+{
+    uint16_t buffer[4] = {0};
+    const uint16_t* source = reinterpret_cast<const uint16_t*>(input);
+    if (count < 4) {
+        std::copy_n(source, count, buffer);
+        source = buffer;
+    }
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source)));
+}
+
+MLAS_FORCEINLINE
+void
+Store(MLAS_FP16* output, float32x4_t value, size_t count)
+{
+    const uint16x4_t half = vreinterpret_u16_f16(vcvt_f16_f32(value));
+    if (count >= 4) {
+        vst1_u16(reinterpret_cast<uint16_t*>(output), half);
+    } else {
+        uint16_t buffer[4];
+        vst1_u16(buffer, half);
+        std::copy_n(buffer, count, reinterpret_cast<uint16_t*>(output));
+    }
+}
+
+#endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+template <typename T>
+void
+LayerNormKernel_Neon_Impl(
+    const T* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    T* output,
+    T* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    // Loads four elements of input + skip + bias. The elements past the end of the row are zero.
+    auto load_sum = [&](size_t i, size_t count) {
+        float32x4_t value = Load(input + i, count);
+        if (skip != nullptr) {
+            value = vaddq_f32(value, Load(skip + i, count));
+        }
+        if (bias != nullptr) {
+            value = vaddq_f32(value, Load(bias + i, count));
+        }
+        return value;
+    };
+
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    float32x4_t sum_square = vdupq_n_f32(0.0f);
+
+    for (size_t i = 0; i < n; i += 4) {
+        const size_t count = std::min(n - i, size_t(4));
+        const float32x4_t value = load_sum(i, count);
+        if (input_skip_bias_sum != nullptr) {
+            Store(input_skip_bias_sum + i, value, count);
+        }
+        sum = vaddq_f32(sum, value);
+        sum_square = vmlaq_f32(sum_square, value, value);
+    }
+
+#if defined(MLAS_TARGET_ARM64)
+    const float total = vaddvq_f32(sum);
+    const float total_square = vaddvq_f32(sum_square);
+#else
+    const float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    const float32x2_t pair_square = vadd_f32(vget_low_f32(sum_square), vget_high_f32(sum_square));
+    const float total = vget_lane_f32(vpadd_f32(pair, pair), 0);
+    const float total_square = vget_lane_f32(vpadd_f32(pair_square, pair_square), 0);
+#endif
+
+    const float row_mean = simplified ? 0.0f : total / n;
+    const float variance = total_square / n - row_mean * row_mean;
+    const float row_inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+
+    const float32x4_t mean_vector = vdupq_n_f32(row_mean);
+    const float32x4_t inv_std_dev_vector = vdupq_n_f32(row_inv_std_dev);
+    const bool has_shift = !simplified && shift != nullptr;
+
+    for (size_t i = 0; i < n; i += 4) {
+        const size_t count = std::min(n - i, size_t(4));
+        float32x4_t value = vmulq_f32(vsubq_f32(load_sum(i, count), mean_vector), inv_std_dev_vector);
+        if (has_shift) {
+            value = vmlaq_f32(Load(shift + i, count), value, Load(scale + i, count));
+        } else {
+            value = vmulq_f32(value, Load(scale + i, count));
+        }
+        Store(output + i, value, count);
+    }
+
+    if (mean != nullptr) {
+        *mean = row_mean;
+    }
+    if (inv_std_dev != nullptr) {
+        *inv_std_dev = row_inv_std_dev;
+    }
+}
+
+}  // namespace
+
+void
+LayerNormKernel_Neon_fp32(
+    const float* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    float* output,
+    float* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Neon_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                              mean, inv_std_dev);
+}
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+void
+LayerNormKernel_Neon_fp16(
+    const MLAS_FP16* input,
+    const float* skip,
+    const float* bias,
+    const float* scale,
+    const float* shift,
+    size_t n,
+    float epsilon,
+    bool simplified,
+    MLAS_FP16* output,
+    MLAS_FP16* input_skip_bias_sum,
+    float* mean,
+    float* inv_std_dev
+)
+{
+    LayerNormKernel_Neon_Impl(input, skip, bias, scale, shift, n, epsilon, simplified, output, input_skip_bias_sum,
+                              mean, inv_std_dev);
+}
+
+#endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+}  // namespace layernorm_neon
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchNeon = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.SLayerNorm = layernorm_neon::LayerNormKernel_Neon_fp32;
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+    d.HLayerNorm = layernorm_neon::LayerNormKernel_Neon_fp16;
+#endif
+    return d;
+}();
@@ -191,6 +191,10 @@ class MLASCPUIDInfo
 
     bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
 
+    bool HasArmSVE() const { return has_arm_sve_; }
+
+    bool HasArmSVE2() const { return has_arm_sve2_; }
+
     bool HasArmSVE_I8MM() const { return has_arm_sve_i8mm_; }
 
     bool HasArmNeon_BF16() const { return has_arm_neon_bf16_; }
@@ -201,6 +205,8 @@ class MLASCPUIDInfo
     bool has_arm_neon_dot_{false};
     bool has_fp16_{false};
     bool has_arm_neon_i8mm_{false};
+    bool has_arm_sve_{false};
+    bool has_arm_sve2_{false};
     bool has_arm_sve_i8mm_{false};
     bool has_arm_neon_bf16_{false};
 };
@@ -801,6 +807,14 @@ extern "C" {
 #if defined(__aarch64__) && defined(__linux__)
     MLAS_SBGEMM_FLOAT_KERNEL MlasSbgemmKernelZero;
     MLAS_SBGEMM_FLOAT_KERNEL MlasSbgemmKernelAdd;
+#endif
+#if defined(MLAS_TARGET_ARM64) && defined(MLAS_USE_SVE)
+    MLAS_GEMM_FLOAT_KERNEL MlasSgemmKernelZeroSve;
+    MLAS_GEMM_FLOAT_KERNEL MlasSgemmKernelAddSve;
+#endif
+#if defined(MLAS_TARGET_RISCV64) && defined(MLAS_USE_RVV)
+    MLAS_GEMM_FLOAT_KERNEL MlasSgemmKernelZeroRvv;
+    MLAS_GEMM_FLOAT_KERNEL MlasSgemmKernelAddRvv;
 #endif
     MLAS_GEMM_DOUBLE_KERNEL MlasDgemmKernelZero;
     MLAS_GEMM_DOUBLE_KERNEL MlasDgemmKernelAdd;
@@ -885,6 +899,14 @@ extern "C" {
     MLAS_QUANTIZE_LINEAR_U16_KERNEL MlasQuantizeLinearU16Kernel;
     MLAS_QUANTIZE_LINEAR_S4_KERNEL MlasQuantizeLinearS4Kernel;
     MLAS_QUANTIZE_LINEAR_U4_KERNEL MlasQuantizeLinearU4Kernel;
+#if defined(MLAS_TARGET_ARM64) && defined(MLAS_USE_SVE)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogisticKernelSve;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasTanhKernelSve;
+#endif
+#if defined(MLAS_TARGET_RISCV64) && defined(MLAS_USE_RVV)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogisticKernelRvv;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasTanhKernelRvv;
+#endif
 #if defined(MLAS_TARGET_AMD64)
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasErfKernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelFma3;
@@ -949,7 +971,7 @@ extern "C" {
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 #define MLAS_HGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -971,7 +993,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr
     );
 
 //
@@ -1061,6 +1084,8 @@ extern const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512;
 
 extern const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni;
 
+extern const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx;
+
 //
 // Rotary embedding dispatch structure.
 //
@@ -1068,12 +1093,34 @@ struct MLAS_ROPE_DISPATCH;
 extern const MLAS_ROPE_DISPATCH MlasRopeDispatchNeon;
 extern const MLAS_ROPE_DISPATCH MlasRopeDispatchAvx2;
 
+//
+// Layer normalization dispatch structure.
+//
+struct MLAS_LAYERNORM_DISPATCH;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchNeon;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx2;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx512;
+
 //
 // half gemm dispatch structure
 //
 struct MLAS_HGEMM_DISPATCH;
 extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchNeon;
 
+//
+// bfloat16 gemm dispatch structure
+//
+struct MLAS_SBGEMM_DISPATCH;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx;
+
+//
+// half precision gemm dispatch structure
+//
+struct MLAS_HALFGEMM_DISPATCH;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAmx;
+
 // softmax dispatch structure
 struct MLAS_SOFTMAX_DISPATCH;
 extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
@@ -1114,6 +1161,34 @@ MlasConvDepthwiseKernelAvx2(
     size_t KernelSize
     );
 
+template <typename InputType, typename FilterType>
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Core(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template <typename InputType, typename FilterType>
+void
+MLASCALL
+MlasConvDepthwiseKernelAvx512Vnni(
+    const InputType* const* Input,
+    InputType InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Define the kernel flags for conv sym
 //
@@ -1229,7 +1304,17 @@ struct MLAS_PLATFORM {
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
 #elif defined(MLAS_TARGET_ARM64)
+    MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernelZero;
+    MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernelAdd;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT * 4;
+#elif defined(MLAS_TARGET_RISCV64)
+    MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernelZero;
+    MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernelAdd;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
+    static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
 #else
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
 #endif
@@ -1243,7 +1328,10 @@ struct MLAS_PLATFORM {
     MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
 
     const MLAS_ROPE_DISPATCH* RopeDispatch{nullptr};
+    const MLAS_LAYERNORM_DISPATCH* LayerNormDispatch{nullptr};
     const MLAS_HGEMM_DISPATCH* HGemmDispatch{nullptr};
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
     const MLAS_SOFTMAX_DISPATCH* SoftmaxDispatch{nullptr};
     const MLAS_ELTWISE_DISPATCH* EltwiseDispatch{nullptr};
 };
@@ -1396,6 +1484,24 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -2122,6 +2228,8 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
     return _mm_add_ps(_mm_mul_ps(Vector1, Vector2), Vector3);
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
+#elif defined(MLAS_WASM_SIMD_INTRINSICS) && defined(MLAS_TARGET_WASM_RELAXED_SIMD)
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
 #elif defined(MLAS_LSX_INTRINSICS)
@@ -2251,7 +2359,12 @@ MLAS_FORCEINLINE
 MLAS_FLOAT32X4
 MlasBlendFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FLOAT32X4 Selection)
 {
+#if defined(MLAS_WASM_SIMD_INTRINSICS) && defined(MLAS_TARGET_WASM_RELAXED_SIMD)
+    // Selection is a comparison result, so each lane is all ones or all zeros as the relaxed select requires.
+    return wasm_i32x4_relaxed_laneselect(Vector2, Vector1, Selection);
+#else
     return MlasOrFloat32x4(MlasAndFloat32x4(Vector2, Selection), MlasAndNotFloat32x4(Selection, Vector1));
+#endif
 }
 
 MLAS_FORCEINLINE
@@ -59,6 +59,14 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
 
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1 << 1)
+#endif
+
 #ifndef HWCAP2_I8MM
 #define HWCAP2_I8MM (1 << 13)
 #endif
@@ -80,6 +88,8 @@ MLASCPUIDInfo::MLASCPUIDInfo()
     has_fp16_ = has_arm_neon_dot_;
 
     has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+    has_arm_sve_ = ((getauxval(AT_HWCAP) & HWCAP_SVE) != 0);
+    has_arm_sve2_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVE2) != 0);
     has_arm_sve_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVEI8MM) != 0);
 
     has_arm_neon_bf16_ = ((getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0);
@@ -198,6 +208,16 @@ MlasInitAMX()
 
 #endif // MLAS_TARGET_AMD64_IX86
 
+#if defined(MLAS_TARGET_RISCV64) && defined(__linux__)
+#include <sys/auxv.h>
+
+//
+// The single letter extensions are reported in AT_HWCAP with bit (letter - 'A').
+//
+
+#define MLAS_RISCV_HWCAP_ISA_V (1UL << ('V' - 'A'))
+#endif
+
 #ifdef MLAS_TARGET_LARCH64
 
 #if defined(__linux__)
@@ -402,6 +422,7 @@ Return Value:
                 this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelAvx2;
                 this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelAvx2;
                 this->RopeDispatch = &MlasRopeDispatchAvx2;
+                this->LayerNormDispatch = &MlasLayerNormDispatchAvx2;
 
 
                 //
@@ -455,6 +476,7 @@ Return Value:
                     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->LayerNormDispatch = &MlasLayerNormDispatchAvx512;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -469,6 +491,10 @@ Return Value:
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
+                        this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx512Core<uint8_t, int8_t>;
+                        this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx512Core<uint8_t, uint8_t>;
+                        this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx512Core<int8_t, int8_t>;
+                        this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx512Core<int8_t, uint8_t>;
                         this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx512;
                         this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512;
 
@@ -482,9 +508,31 @@ Return Value:
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
+                            this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx512Vnni<uint8_t, int8_t>;
+                            this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx512Vnni<uint8_t, uint8_t>;
+                            this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx512Vnni<int8_t, int8_t>;
+                            this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx512Vnni<int8_t, uint8_t>;
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
+
+                        //
+                        // Check if the processor supports AVX512_FP16.
+                        //
+
+                        if ((Cpuid7[3] & (0b1 << 23)) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
                     }
                 }
 
@@ -511,15 +559,37 @@ Return Value:
 
 
                 //
-                // Check if the processor supports AMX-TILE and AMX-INT8
-                // features.
+                // Check if the processor supports AMX-TILE and the AMX-INT8,
+                // AMX-BF16 and AMX-FP16 features.
                 //
                 if ((Cpuid7[3] & 0b1 << 24) != 0 &&
-                    (Cpuid7[3] & 0b1 << 25) != 0 &&
-                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE) {
-                    if (MlasInitAMX()) {
+                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE &&
+                    MlasInitAMX()) {
+                    if ((Cpuid7[3] & 0b1 << 25) != 0) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+
+                        //
+                        // The AMX-INT8 kernel reuses the B packing of the AVX512_VNNI
+                        // kernels and falls back to them when M is small.
+                        //
+                        if (this->QNBitGemmDispatch == &MlasSQNBitGemmDispatchAvx512vnni) {
+                            this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAmx;
+                        }
+                    }
+
+                    //
+                    // The AMX-BF16 kernel converts the inputs with AVX512_BF16.
+                    //
+                    if ((Cpuid7[3] & 0b1 << 22) != 0 && this->SBGemmDispatch != nullptr) {
+                        this->SBGemmDispatch = &MlasSBGemmDispatchAmx;
+                    }
+
+                    //
+                    // The AMX-FP16 kernel converts and packs with AVX512_FP16.
+                    //
+                    if ((Cpuid7_1[0] & (0b1 << 21)) != 0 && this->HalfGemmDispatch != nullptr) {
+                        this->HalfGemmDispatch = &MlasHalfGemmDispatchAmx;
                     }
                 }
 #endif // __APPLE__
@@ -544,9 +614,14 @@ Return Value:
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
     this->RopeDispatch = &MlasRopeDispatchNeon;
+    this->LayerNormDispatch = &MlasLayerNormDispatchNeon;
     this->HGemmDispatch = &MlasHGemmDispatchNeon;
     this->SoftmaxDispatch = &MlasSoftmaxDispatchNeon;
     this->EltwiseDispatch = &MlasEltwiseDispatchNeon;
+    this->GemmFloatKernelZero = MlasSgemmKernelZero;
+    this->GemmFloatKernelAdd = MlasSgemmKernelAdd;
+    this->LogisticKernelRoutine = MlasLogisticKernel;
+    this->TanhKernelRoutine = MlasTanhKernel;
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -585,6 +660,20 @@ Return Value:
     }
 #endif
 
+#if defined(MLAS_USE_SVE)
+    //
+    // Check if the processor supports SVE instructions. The SVE kernels are
+    // vector length agnostic, so they use the full width of processors with
+    // vectors wider than 128 bits.
+    //
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmSVE()) {
+        this->GemmFloatKernelZero = MlasSgemmKernelZeroSve;
+        this->GemmFloatKernelAdd = MlasSgemmKernelAddSve;
+        this->LogisticKernelRoutine = MlasLogisticKernelSve;
+        this->TanhKernelRoutine = MlasTanhKernelSve;
+    }
+#endif
+
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
     this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelNeon;
     this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelNeon;
@@ -688,6 +777,37 @@ Return Value:
 
 #endif // MLAS_TARGET_LARCH64
 
+#if defined(MLAS_TARGET_RISCV64)
+
+    this->GemmFloatKernelZero = MlasSgemmKernelZero;
+    this->GemmFloatKernelAdd = MlasSgemmKernelAdd;
+    this->LogisticKernelRoutine = MlasLogisticKernel;
+    this->TanhKernelRoutine = MlasTanhKernel;
+
+#if defined(MLAS_USE_RVV) && defined(__linux__)
+    //
+    // Check if the processor supports the V extension. The RVV kernels hold a
+    // packed SGEMM panel of 16 columns in a register group of LMUL=4, which
+    // requires a VLEN of at least 128 bits. The VLEN is read from the vlenb
+    // CSR by number, as this module is not built with the V extension.
+    //
+    const bool HasVectorInstructions = (getauxval(AT_HWCAP) & MLAS_RISCV_HWCAP_ISA_V) != 0;
+
+    if (HasVectorInstructions) {
+        unsigned long VectorLengthBytes;
+        __asm__ volatile("csrr %0, 0xc22" : "=r"(VectorLengthBytes));
+
+        if (VectorLengthBytes * 8 >= 128) {
+            this->GemmFloatKernelZero = MlasSgemmKernelZeroRvv;
+            this->GemmFloatKernelAdd = MlasSgemmKernelAddRvv;
+            this->LogisticKernelRoutine = MlasLogisticKernelRvv;
+            this->TanhKernelRoutine = MlasTanhKernelRvv;
+        }
+    }
+#endif
+
+#endif // MLAS_TARGET_RISCV64
+
 }
 
 size_t
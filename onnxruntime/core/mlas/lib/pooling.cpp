@@ -1701,3 +1701,147 @@ MlasMaximumPool<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+template<MLAS_POOLING_KIND PoolingKind>
+void
+MlasNhwcPoolFloat(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the maximum or average pooling of a single
+    precision tensor in NHWC format with an indirection buffer.
+
+Arguments:
+
+    Input - Supplies the indirection buffer: KernelSize pointers to the
+        input pixels of every output pixel. Null pointers are padding and are
+        excluded from the pooling.
+
+    Output - Supplies the address of the output pixels.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr bool IsMaximumPool = (PoolingKind == MlasMaximumPooling);
+
+    const float InitialValue = IsMaximumPool ? std::numeric_limits<float>::lowest() : 0.0f;
+
+    while (OutputCount > 0) {
+
+        size_t ValidCount = 0;
+
+        for (size_t k = 0; k < KernelSize; k++) {
+            ValidCount += (Input[k] != nullptr);
+        }
+
+        const float Scale = (IsMaximumPool || ValidCount == 0) ? 1.0f : 1.0f / float(ValidCount);
+        const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 Vector0 = MlasBroadcastFloat32x4(InitialValue);
+            MLAS_FLOAT32X4 Vector1 = Vector0;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][ChannelOffset + 4]);
+
+                if constexpr (IsMaximumPool) {
+                    Vector0 = MlasMaximumFloat32x4(Vector0, InputVector0);
+                    Vector1 = MlasMaximumFloat32x4(Vector1, InputVector1);
+                } else {
+                    Vector0 = MlasAddFloat32x4(Vector0, InputVector0);
+                    Vector1 = MlasAddFloat32x4(Vector1, InputVector1);
+                }
+            }
+
+            if constexpr (!IsMaximumPool) {
+                Vector0 = MlasMultiplyFloat32x4(Vector0, ScaleVector);
+                Vector1 = MlasMultiplyFloat32x4(Vector1, ScaleVector);
+            }
+
+            MlasStoreFloat32x4(&Output[0], Vector0);
+            MlasStoreFloat32x4(&Output[4], Vector1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        while (c > 0) {
+
+            float Value = InitialValue;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                if constexpr (IsMaximumPool) {
+                    Value = std::max(Value, Input[k][ChannelOffset]);
+                } else {
+                    Value += Input[k][ChannelOffset];
+                }
+            }
+
+            *Output++ = Value * Scale;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<MlasMaximumPooling>(Input, Output, Channels, OutputCount, KernelSize);
+}
+
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<MlasAveragePoolingExcludePad>(Input, Output, Channels, OutputCount, KernelSize);
+}
@@ -442,6 +442,10 @@ SQ4BitGemm_CompFp32(
             auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
                 a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f, true
             );
+#elif defined(MLAS_TARGET_ARM64)
+            auto RowsHandled = GetMlasPlatform().GemmFloatKernelZero(
+                a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f
+            );
 #else
             auto RowsHandled = MlasSgemmKernelZero(a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f);
 #endif
@@ -555,6 +559,12 @@ SQ4BitGemm_CompInt8(
         SQ4BitGemm(BlkLen, QuantA, DataParams->PackedQuantBData,
             DataParams->C, RangeStartM, RangeCountM, RangeStartN, RangeCountN, K,
             DataParams->ldc, DataParams->Bias);
+
+        if (DataParams->PostProcessor != nullptr) {
+            DataParams->PostProcessor->Process(
+                DataParams->C, RangeStartM, RangeStartN, RangeCountM, RangeCountN, DataParams->ldc
+            );
+        }
         return;
     }
 
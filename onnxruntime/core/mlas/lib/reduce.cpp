@@ -0,0 +1,835 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the reduction of the middle axis of a tensor viewed
+    as [OuterCount, ReduceCount, InnerCount], as used by the ReduceSum,
+    ReduceMean, ReduceMax, ReduceMin and ReduceLogSumExp operators.
+
+    Rows (InnerCount == 1) are reduced with horizontal vector kernels. Columns
+    (InnerCount > 1) are processed in strips of contiguous elements that are
+    accumulated across the reduced rows in vector registers.
+
+    When there are too few output strips to keep the thread pool busy, the
+    reduced axis is also split into chunks. Each chunk produces a partial state
+    and the partial states are combined once all the chunks are done.
+
+--*/
+
+#include "mlasi.h"
+
+#include <vector>
+
+//
+// Number of contiguous columns accumulated by one unit of work.
+//
+
+constexpr size_t MLAS_REDUCE_STRIP_WIDTH = 256;
+
+//
+// Number of elements of a fp16 row converted to fp32 at a time.
+//
+
+constexpr size_t MLAS_REDUCE_CONVERT_BLOCK = 256;
+
+//
+// Minimum number of input elements reduced by one thread.
+//
+
+constexpr size_t MLAS_REDUCE_ELEMENTS_PER_THREAD = 16384;
+
+//
+// Partial state of the reduction of a range of rows for one output element.
+// The first value holds the sum, minimum or maximum. For LogSumExp, the first
+// value holds the maximum and the second value holds the sum of exponentials
+// relative to the adjusted maximum.
+//
+
+struct MLAS_REDUCE_STATE {
+    float Value;
+    float SumExp;
+};
+
+struct MLAS_REDUCE_WORK_BLOCK {
+    MLAS_REDUCE_KIND Kind;
+    size_t OuterCount;
+    size_t ReduceCount;
+    size_t InnerCount;
+    size_t StripCount;
+    size_t ChunkCount;
+    size_t ChunkSize;
+};
+
+MLAS_FORCEINLINE
+float
+MlasReduceAdjustMaximum(
+    float Maximum
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the maximum used as the offset of the exponentials of
+    LogSumExp. An infinite maximum is replaced by zero so that the offset input
+    values stay defined.
+
+--*/
+{
+    return std::isinf(Maximum) ? 0.0f : Maximum;
+}
+
+//
+// Vector and scalar operations used to reduce a row of values. The reduction
+// is seeded with the first element of the row so that a row of infinities
+// reduces to an infinity.
+//
+
+struct MLAS_REDUCE_SUM_OPERATION {
+
+    static MLAS_FLOAT32X4 Seed(float Value) { MLAS_UNREFERENCED_PARAMETER(Value); return MlasZeroFloat32x4(); }
+
+    static MLAS_FLOAT32X4 Vector(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+
+    static float Scalar(float Value1, float Value2) { return Value1 + Value2; }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+struct MLAS_REDUCE_MAXIMUM_OPERATION {
+
+    static MLAS_FLOAT32X4 Seed(float Value) { return MlasBroadcastFloat32x4(Value); }
+
+    static MLAS_FLOAT32X4 Vector(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2) { return MlasMaximumFloat32x4(Vector1, Vector2); }
+
+    static float Scalar(float Value1, float Value2) { return std::max(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMaximumFloat32x4(Vector); }
+};
+
+struct MLAS_REDUCE_MINIMUM_OPERATION {
+
+    static MLAS_FLOAT32X4 Seed(float Value) { return MlasBroadcastFloat32x4(Value); }
+
+    static MLAS_FLOAT32X4 Vector(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2) { return MlasMinimumFloat32x4(Vector1, Vector2); }
+
+    static float Scalar(float Value1, float Value2) { return std::min(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMinimumFloat32x4(Vector); }
+};
+
+template<typename Operation>
+float
+MlasReduceF32RowWithOperation(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a row of values with the supplied operation.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process, at least one.
+
+Return Value:
+
+    Returns the reduction of the row.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulator0 = Operation::Seed(Input[0]);
+    MLAS_FLOAT32X4 Accumulator1 = Accumulator0;
+    MLAS_FLOAT32X4 Accumulator2 = Accumulator0;
+    MLAS_FLOAT32X4 Accumulator3 = Accumulator0;
+
+    while (N >= 16) {
+
+        Accumulator0 = Operation::Vector(Accumulator0, MlasLoadFloat32x4(Input));
+        Accumulator1 = Operation::Vector(Accumulator1, MlasLoadFloat32x4(Input + 4));
+        Accumulator2 = Operation::Vector(Accumulator2, MlasLoadFloat32x4(Input + 8));
+        Accumulator3 = Operation::Vector(Accumulator3, MlasLoadFloat32x4(Input + 12));
+
+        Input += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        Accumulator0 = Operation::Vector(Accumulator0, MlasLoadFloat32x4(Input));
+
+        Input += 4;
+        N -= 4;
+    }
+
+    Accumulator0 = Operation::Vector(Accumulator0, Accumulator1);
+    Accumulator2 = Operation::Vector(Accumulator2, Accumulator3);
+    Accumulator0 = Operation::Vector(Accumulator0, Accumulator2);
+
+    float Value = Operation::Reduce(Accumulator0);
+
+    while (N > 0) {
+
+        Value = Operation::Scalar(Value, *Input++);
+        N -= 1;
+    }
+
+    return Value;
+}
+
+void
+MlasReduceF32Row(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N,
+    MLAS_REDUCE_STATE* State
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the partial state of the reduction of a row of
+    values.
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    State - Returns the partial state of the reduction.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    State->SumExp = 0.0f;
+
+    switch (Kind) {
+
+        case MlasReduceSum:
+        case MlasReduceMean:
+        {
+            State->Value = MlasReduceF32RowWithOperation<MLAS_REDUCE_SUM_OPERATION>(Input, N);
+            break;
+        }
+
+        case MlasReduceMin:
+        {
+            State->Value = MlasReduceF32RowWithOperation<MLAS_REDUCE_MINIMUM_OPERATION>(Input, N);
+            break;
+        }
+
+        case MlasReduceMax:
+        {
+            State->Value = MlasReduceF32RowWithOperation<MLAS_REDUCE_MAXIMUM_OPERATION>(Input, N);
+            break;
+        }
+
+        case MlasReduceLogSumExp:
+        {
+            //
+            // The maximum only offsets the exponentials, so use the platform
+            // kernels for both passes over the row.
+            //
+
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+            State->Value = GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+            State->Value = MlasReduceMaximumF32Kernel(Input, N);
+#endif
+
+            const float NegativeMaximum = -MlasReduceAdjustMaximum(State->Value);
+#if defined(MLAS_TARGET_AMD64)
+            State->SumExp = GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+            State->SumExp = MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+            break;
+        }
+    }
+}
+
+void
+MlasReduceCombineState(
+    MLAS_REDUCE_KIND Kind,
+    MLAS_REDUCE_STATE* State,
+    const MLAS_REDUCE_STATE* Other
+    )
+/*++
+
+Routine Description:
+
+    This routine combines the partial state of the reduction of another range
+    of rows into the supplied partial state.
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    State - Supplies the partial state to update.
+
+    Other - Supplies the partial state to combine.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+        case MlasReduceMean:
+        {
+            State->Value += Other->Value;
+            break;
+        }
+
+        case MlasReduceMin:
+        {
+            State->Value = std::min(State->Value, Other->Value);
+            break;
+        }
+
+        case MlasReduceMax:
+        {
+            State->Value = std::max(State->Value, Other->Value);
+            break;
+        }
+
+        case MlasReduceLogSumExp:
+        {
+            const float Maximum = std::max(State->Value, Other->Value);
+            const float AdjustedMaximum = MlasReduceAdjustMaximum(Maximum);
+
+            float SumExp = 0.0f;
+
+            //
+            // Each sum of exponentials is relative to the adjusted maximum of
+            // its own range of rows, so rescale the sums to the new maximum.
+            //
+
+            if (State->SumExp != 0.0f) {
+                SumExp += State->SumExp * std::exp(MlasReduceAdjustMaximum(State->Value) - AdjustedMaximum);
+            }
+
+            if (Other->SumExp != 0.0f) {
+                SumExp += Other->SumExp * std::exp(MlasReduceAdjustMaximum(Other->Value) - AdjustedMaximum);
+            }
+
+            State->Value = Maximum;
+            State->SumExp = SumExp;
+            break;
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceFinalizeState(
+    MLAS_REDUCE_KIND Kind,
+    const MLAS_REDUCE_STATE* State,
+    size_t ReduceCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output value from the state of the reduction of
+    all the rows.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasReduceMean:
+            return State->Value / float(ReduceCount);
+
+        case MlasReduceLogSumExp:
+            return std::log(State->SumExp) + MlasReduceAdjustMaximum(State->Value);
+
+        default:
+            return State->Value;
+    }
+}
+
+template<typename T>
+void
+MlasReduceRows(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    size_t N,
+    MLAS_REDUCE_STATE* State
+    );
+
+template<>
+void
+MlasReduceRows<float>(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N,
+    MLAS_REDUCE_STATE* State
+    )
+{
+    MlasReduceF32Row(Kind, Input, N, State);
+}
+
+template<>
+void
+MlasReduceRows<MLAS_FP16>(
+    MLAS_REDUCE_KIND Kind,
+    const MLAS_FP16* Input,
+    size_t N,
+    MLAS_REDUCE_STATE* State
+    )
+{
+    //
+    // Convert the row to fp32 in blocks and combine the partial state of each
+    // block.
+    //
+
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_CONVERT_BLOCK], 64);
+
+    bool FirstBlock = true;
+
+    while (N > 0) {
+
+        const size_t CountN = std::min(N, MLAS_REDUCE_CONVERT_BLOCK);
+
+        MlasConvertHalfToFloatBuffer(Input, Buffer, CountN);
+
+        if (FirstBlock) {
+            MlasReduceF32Row(Kind, Buffer, CountN, State);
+            FirstBlock = false;
+        } else {
+            MLAS_REDUCE_STATE BlockState;
+            MlasReduceF32Row(Kind, Buffer, CountN, &BlockState);
+            MlasReduceCombineState(Kind, State, &BlockState);
+        }
+
+        Input += CountN;
+        N -= CountN;
+    }
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoadColumns(
+    const float* Input,
+    float* Buffer,
+    size_t CountN
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Buffer);
+    MLAS_UNREFERENCED_PARAMETER(CountN);
+
+    return Input;
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoadColumns(
+    const MLAS_FP16* Input,
+    float* Buffer,
+    size_t CountN
+    )
+{
+    MlasConvertHalfToFloatBuffer(Input, Buffer, CountN);
+
+    return Buffer;
+}
+
+template<typename T>
+void
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    size_t InnerCount,
+    size_t RowCount,
+    size_t CountN,
+    MLAS_REDUCE_STATE* State
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the partial state of the reduction of a strip of
+    columns over a range of rows.
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    Input - Supplies the address of the first column of the first row.
+
+    InnerCount - Supplies the distance between two rows.
+
+    RowCount - Supplies the number of rows to reduce.
+
+    CountN - Supplies the number of columns of the strip.
+
+    State - Returns the partial state of the reduction of each column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Accumulator[MLAS_REDUCE_STRIP_WIDTH], 64);
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_STRIP_WIDTH], 64);
+
+    const float* Row = MlasReduceLoadColumns(Input, Buffer, CountN);
+    std::copy_n(Row, CountN, Accumulator);
+
+    for (size_t r = 1; r < RowCount; r++) {
+
+        Row = MlasReduceLoadColumns(Input + r * InnerCount, Buffer, CountN);
+
+        size_t n = 0;
+
+        switch (Kind) {
+
+            case MlasReduceSum:
+            case MlasReduceMean:
+            {
+                for (; n + 4 <= CountN; n += 4) {
+                    MlasStoreFloat32x4(&Accumulator[n],
+                        MlasAddFloat32x4(MlasLoadFloat32x4(&Accumulator[n]), MlasLoadFloat32x4(&Row[n])));
+                }
+
+                for (; n < CountN; n++) {
+                    Accumulator[n] += Row[n];
+                }
+                break;
+            }
+
+            case MlasReduceMin:
+            {
+                for (; n + 4 <= CountN; n += 4) {
+                    MlasStoreFloat32x4(&Accumulator[n],
+                        MlasMinimumFloat32x4(MlasLoadFloat32x4(&Accumulator[n]), MlasLoadFloat32x4(&Row[n])));
+                }
+
+                for (; n < CountN; n++) {
+                    Accumulator[n] = std::min(Accumulator[n], Row[n]);
+                }
+                break;
+            }
+
+            case MlasReduceMax:
+            case MlasReduceLogSumExp:
+            {
+                for (; n + 4 <= CountN; n += 4) {
+                    MlasStoreFloat32x4(&Accumulator[n],
+                        MlasMaximumFloat32x4(MlasLoadFloat32x4(&Accumulator[n]), MlasLoadFloat32x4(&Row[n])));
+                }
+
+                for (; n < CountN; n++) {
+                    Accumulator[n] = std::max(Accumulator[n], Row[n]);
+                }
+                break;
+            }
+        }
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+        State[n].Value = Accumulator[n];
+        State[n].SumExp = 0.0f;
+    }
+
+    if (Kind != MlasReduceLogSumExp) {
+        return;
+    }
+
+    //
+    // Second pass for LogSumExp: accumulate the exponentials of the rows offset
+    // by the adjusted maximum of each column.
+    //
+
+    MLAS_DECLSPEC_ALIGN(float NegativeMaximum[MLAS_REDUCE_STRIP_WIDTH], 64);
+    MLAS_DECLSPEC_ALIGN(float Exponential[MLAS_REDUCE_STRIP_WIDTH], 64);
+
+    for (size_t n = 0; n < CountN; n++) {
+        NegativeMaximum[n] = -MlasReduceAdjustMaximum(Accumulator[n]);
+        Accumulator[n] = 0.0f;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        Row = MlasReduceLoadColumns(Input + r * InnerCount, Buffer, CountN);
+
+        size_t n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+            MlasStoreFloat32x4(&Exponential[n],
+                MlasAddFloat32x4(MlasLoadFloat32x4(&Row[n]), MlasLoadFloat32x4(&NegativeMaximum[n])));
+        }
+
+        for (; n < CountN; n++) {
+            Exponential[n] = Row[n] + NegativeMaximum[n];
+        }
+
+        MlasComputeExp(Exponential, Exponential, CountN);
+
+        n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+            MlasStoreFloat32x4(&Accumulator[n],
+                MlasAddFloat32x4(MlasLoadFloat32x4(&Accumulator[n]), MlasLoadFloat32x4(&Exponential[n])));
+        }
+
+        for (; n < CountN; n++) {
+            Accumulator[n] += Exponential[n];
+        }
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+        State[n].SumExp = Accumulator[n];
+    }
+}
+
+template<typename T>
+void
+MlasReduceUnit(
+    const MLAS_REDUCE_WORK_BLOCK* WorkBlock,
+    const T* Input,
+    size_t Unit,
+    size_t Chunk,
+    MLAS_REDUCE_STATE* State,
+    size_t* CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the partial state of the reduction of one strip of
+    columns over one chunk of the reduced axis.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that describes the reduction.
+
+    Input - Supplies the input tensor.
+
+    Unit - Supplies the index of the strip of columns.
+
+    Chunk - Supplies the index of the chunk of the reduced axis.
+
+    State - Returns the partial state of each column of the strip.
+
+    CountN - Returns the number of columns of the strip.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ReduceCount = WorkBlock->ReduceCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+
+    const size_t Outer = Unit / WorkBlock->StripCount;
+    const size_t Column = (Unit % WorkBlock->StripCount) * MLAS_REDUCE_STRIP_WIDTH;
+
+    const size_t RowStart = Chunk * WorkBlock->ChunkSize;
+    const size_t RowCount = std::min(WorkBlock->ChunkSize, ReduceCount - RowStart);
+
+    const T* input = Input + (Outer * ReduceCount + RowStart) * InnerCount + Column;
+
+    if (InnerCount == 1) {
+        MlasReduceRows(WorkBlock->Kind, input, RowCount, State);
+        *CountN = 1;
+    } else {
+        *CountN = std::min(InnerCount - Column, MLAS_REDUCE_STRIP_WIDTH);
+        MlasReduceColumns(WorkBlock->Kind, input, InnerCount, RowCount, *CountN, State);
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the middle axis of a tensor of shape
+    [OuterCount, ReduceCount, InnerCount] to produce a tensor of shape
+    [OuterCount, InnerCount].
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    Input - Supplies the input tensor.
+
+    Output - Returns the output tensor.
+
+    OuterCount - Supplies the number of leading elements that are kept.
+
+    ReduceCount - Supplies the number of elements that are reduced.
+
+    InnerCount - Supplies the number of trailing elements that are kept.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OuterCount == 0 || InnerCount == 0 || ReduceCount == 0) {
+        return;
+    }
+
+    MLAS_REDUCE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Kind = Kind;
+    WorkBlock.OuterCount = OuterCount;
+    WorkBlock.ReduceCount = ReduceCount;
+    WorkBlock.InnerCount = InnerCount;
+    WorkBlock.StripCount = (InnerCount + MLAS_REDUCE_STRIP_WIDTH - 1) / MLAS_REDUCE_STRIP_WIDTH;
+
+    const size_t UnitCount = OuterCount * WorkBlock.StripCount;
+
+    //
+    // Compute the number of threads to use based on the total amount of work.
+    //
+
+    const size_t TotalElements = OuterCount * ReduceCount * InnerCount;
+
+    size_t TargetThreadCount = std::max<size_t>(TotalElements / MLAS_REDUCE_ELEMENTS_PER_THREAD, 1);
+    TargetThreadCount = std::min(TargetThreadCount, size_t(MlasGetMaximumThreadCount(ThreadPool)));
+
+    //
+    // Split the reduced axis into chunks if there are too few strips of
+    // columns to keep the threads busy.
+    //
+
+    WorkBlock.ChunkCount = 1;
+
+    if (UnitCount < TargetThreadCount) {
+        WorkBlock.ChunkCount = std::min((TargetThreadCount + UnitCount - 1) / UnitCount, ReduceCount);
+    }
+
+    WorkBlock.ChunkSize = (ReduceCount + WorkBlock.ChunkCount - 1) / WorkBlock.ChunkCount;
+    WorkBlock.ChunkCount = (ReduceCount + WorkBlock.ChunkSize - 1) / WorkBlock.ChunkSize;
+
+    if (WorkBlock.ChunkCount == 1) {
+
+        const ptrdiff_t ThreadCount = ptrdiff_t(std::min(TargetThreadCount, UnitCount));
+
+        MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+            size_t UnitIndex;
+            size_t UnitRemaining;
+
+            MlasPartitionWork(tid, ThreadCount, UnitCount, &UnitIndex, &UnitRemaining);
+
+            MLAS_REDUCE_STATE State[MLAS_REDUCE_STRIP_WIDTH];
+
+            for (size_t Unit = UnitIndex; Unit < UnitIndex + UnitRemaining; Unit++) {
+
+                size_t CountN;
+                MlasReduceUnit(&WorkBlock, Input, Unit, 0, State, &CountN);
+
+                const size_t Outer = Unit / WorkBlock.StripCount;
+                const size_t Column = (Unit % WorkBlock.StripCount) * MLAS_REDUCE_STRIP_WIDTH;
+
+                T* output = Output + Outer * InnerCount + Column;
+
+                for (size_t n = 0; n < CountN; n++) {
+                    output[n] = T(MlasReduceFinalizeState(Kind, &State[n], ReduceCount));
+                }
+            }
+        });
+
+        return;
+    }
+
+    //
+    // Compute the partial state of each chunk of the reduced axis and then
+    // combine the partial states of every output element.
+    //
+
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    std::vector<MLAS_REDUCE_STATE> PartialStates(WorkBlock.ChunkCount * OutputCount);
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(WorkBlock.ChunkCount * UnitCount), [&](ptrdiff_t tid) {
+
+        const size_t Chunk = size_t(tid) / UnitCount;
+        const size_t Unit = size_t(tid) % UnitCount;
+
+        const size_t Outer = Unit / WorkBlock.StripCount;
+        const size_t Column = (Unit % WorkBlock.StripCount) * MLAS_REDUCE_STRIP_WIDTH;
+
+        size_t CountN;
+        MlasReduceUnit(&WorkBlock, Input, Unit, Chunk,
+            &PartialStates[Chunk * OutputCount + Outer * InnerCount + Column], &CountN);
+    });
+
+    for (size_t i = 0; i < OutputCount; i++) {
+
+        MLAS_REDUCE_STATE State = PartialStates[i];
+
+        for (size_t Chunk = 1; Chunk < WorkBlock.ChunkCount; Chunk++) {
+            MlasReduceCombineState(Kind, &State, &PartialStates[Chunk * OutputCount + i]);
+        }
+
+        Output[i] = T(MlasReduceFinalizeState(Kind, &State, ReduceCount));
+    }
+}
+
+template
+void
+MLASCALL
+MlasReduce<float>(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasReduce<MLAS_FP16>(
+    MLAS_REDUCE_KIND Kind,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -0,0 +1,433 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    resize.cpp
+
+Abstract:
+
+    This module implements the resizing of images with separable filters, as
+    used by the bilinear and bicubic modes of the Resize operator.
+
+    The interpolation of an output row is split in two passes. The input rows
+    that the output row depends on are first filtered horizontally to the
+    output width, then the filtered rows are combined with the row weights.
+    The filtered rows are kept in a ring buffer indexed by their input row, so
+    an input row is filtered once for all the output rows of a work block that
+    use it. When upsampling, this divides the horizontal work by the number of
+    output rows per input row.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of multiply/adds of interpolation that make a thread worth using.
+//
+
+constexpr double MLAS_RESIZE_THREAD_COMPLEXITY = 64 * 1024;
+
+struct MLAS_RESIZE_WORK_BLOCK {
+    const float* Input;
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t Channels;
+    float* Output;
+    size_t OutputHeight;
+    size_t OutputWidth;
+    size_t RowTaps;
+    const int32_t* RowIndices;
+    const float* RowWeights;
+    size_t ColumnTaps;
+    const int32_t* ColumnIndices;
+    const float* ColumnWeights;
+    size_t RowBlockCount;
+};
+
+template<size_t Taps>
+void
+MlasResizeHorizontalSingleChannel(
+    const float* Input,
+    float* Output,
+    size_t OutputWidth,
+    size_t ColumnTaps,
+    const int32_t* ColumnIndices,
+    const float* ColumnWeights
+    )
+/*++
+
+Routine Description:
+
+    This routine filters an input row of a single channel image to the output
+    width.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Output - Supplies the output row.
+
+    OutputWidth - Supplies the number of columns of the output row.
+
+    ColumnTaps - Supplies the number of input columns of an output column. This
+        is ignored when the template argument is not zero.
+
+    ColumnIndices - Supplies the input columns of each output column.
+
+    ColumnWeights - Supplies the weights of the input columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TapCount = (Taps != 0) ? Taps : ColumnTaps;
+
+    for (size_t x = 0; x < OutputWidth; x++) {
+
+        float Accumulator = 0.0f;
+
+        for (size_t t = 0; t < TapCount; t++) {
+            Accumulator += ColumnWeights[t] * Input[ColumnIndices[t]];
+        }
+
+        Output[x] = Accumulator;
+
+        ColumnIndices += TapCount;
+        ColumnWeights += TapCount;
+    }
+}
+
+void
+MlasResizeHorizontal(
+    const MLAS_RESIZE_WORK_BLOCK* WorkBlock,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine filters an input row of interleaved channels to the output
+    width.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the resize parameters.
+
+    Input - Supplies the input row.
+
+    Output - Supplies the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Channels = WorkBlock->Channels;
+    const size_t OutputWidth = WorkBlock->OutputWidth;
+    const size_t ColumnTaps = WorkBlock->ColumnTaps;
+    const int32_t* ColumnIndices = WorkBlock->ColumnIndices;
+    const float* ColumnWeights = WorkBlock->ColumnWeights;
+
+    if (Channels == 1) {
+
+        if (ColumnTaps == 2) {
+            MlasResizeHorizontalSingleChannel<2>(Input, Output, OutputWidth, ColumnTaps, ColumnIndices, ColumnWeights);
+        } else if (ColumnTaps == 4) {
+            MlasResizeHorizontalSingleChannel<4>(Input, Output, OutputWidth, ColumnTaps, ColumnIndices, ColumnWeights);
+        } else {
+            MlasResizeHorizontalSingleChannel<0>(Input, Output, OutputWidth, ColumnTaps, ColumnIndices, ColumnWeights);
+        }
+
+        return;
+    }
+
+    //
+    // The channels of a pixel are contiguous, so they are interpolated as
+    // vectors with the same weight.
+    //
+
+    for (size_t x = 0; x < OutputWidth; x++) {
+
+        size_t c = 0;
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+            for (size_t t = 0; t < ColumnTaps; t++) {
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + size_t(ColumnIndices[t]) * Channels + c);
+                Accumulator = MlasMultiplyAddFloat32x4(Vector, ColumnWeights[t], Accumulator);
+            }
+
+            MlasStoreFloat32x4(Output + c, Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t t = 0; t < ColumnTaps; t++) {
+                Accumulator += ColumnWeights[t] * Input[size_t(ColumnIndices[t]) * Channels + c];
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        Output += Channels;
+        ColumnIndices += ColumnTaps;
+        ColumnWeights += ColumnTaps;
+    }
+}
+
+void
+MlasResizeVertical(
+    const float* const* Rows,
+    const float* RowWeights,
+    size_t RowTaps,
+    float* Output,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine combines horizontally filtered rows into an output row.
+
+Arguments:
+
+    Rows - Supplies the horizontally filtered rows of each tap.
+
+    RowWeights - Supplies the weights of the rows.
+
+    RowTaps - Supplies the number of rows.
+
+    Output - Supplies the output row.
+
+    Count - Supplies the number of elements of a row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t i = 0;
+
+    for (; i + 8 <= Count; i += 8) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + i),
+            MlasBroadcastFloat32x4(RowWeights[0]));
+        MLAS_FLOAT32X4 Accumulator1 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + i + 4),
+            MlasBroadcastFloat32x4(RowWeights[0]));
+
+        for (size_t t = 1; t < RowTaps; t++) {
+            Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + i), RowWeights[t], Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + i + 4), RowWeights[t], Accumulator1);
+        }
+
+        MlasStoreFloat32x4(Output + i, Accumulator0);
+        MlasStoreFloat32x4(Output + i + 4, Accumulator1);
+    }
+
+    for (; i + 4 <= Count; i += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + i),
+            MlasBroadcastFloat32x4(RowWeights[0]));
+
+        for (size_t t = 1; t < RowTaps; t++) {
+            Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + i), RowWeights[t], Accumulator);
+        }
+
+        MlasStoreFloat32x4(Output + i, Accumulator);
+    }
+
+    for (; i < Count; i++) {
+
+        float Accumulator = Rows[0][i] * RowWeights[0];
+
+        for (size_t t = 1; t < RowTaps; t++) {
+            Accumulator += Rows[t][i] * RowWeights[t];
+        }
+
+        Output[i] = Accumulator;
+    }
+}
+
+void
+MlasResizeThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    resize operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<const MLAS_RESIZE_WORK_BLOCK*>(Context);
+
+    const size_t RowTaps = WorkBlock->RowTaps;
+    const size_t InputRowLength = WorkBlock->InputWidth * WorkBlock->Channels;
+    const size_t OutputRowLength = WorkBlock->OutputWidth * WorkBlock->Channels;
+
+    const size_t Image = size_t(Index) / WorkBlock->RowBlockCount;
+    const size_t RowBlock = size_t(Index) % WorkBlock->RowBlockCount;
+
+    size_t RowStart;
+    size_t RowCount;
+
+    MlasPartitionWork(ptrdiff_t(RowBlock), ptrdiff_t(WorkBlock->RowBlockCount), WorkBlock->OutputHeight,
+        &RowStart, &RowCount);
+
+    if (RowCount == 0) {
+        return;
+    }
+
+    const float* Input = WorkBlock->Input + Image * WorkBlock->InputHeight * InputRowLength;
+    float* Output = WorkBlock->Output + Image * WorkBlock->OutputHeight * OutputRowLength + RowStart * OutputRowLength;
+
+    //
+    // Allocate the ring of horizontally filtered rows, followed by the input
+    // row held by each slot and the row pointers of the taps.
+    //
+
+    const size_t RowBufferBytes = (RowTaps * OutputRowLength * sizeof(float) + 15) & ~size_t(15);
+    const size_t BufferBytes = RowBufferBytes + RowTaps * (sizeof(size_t) + sizeof(const float*));
+
+    MlasThreadedBufAlloc((BufferBytes + ThreadedBufAlignment - 1) & ~(ThreadedBufAlignment - 1));
+
+    float* RowBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    size_t* SlotRows = reinterpret_cast<size_t*>(ThreadedBufHolder.get() + RowBufferBytes);
+    const float** Rows = reinterpret_cast<const float**>(SlotRows + RowTaps);
+
+    std::fill_n(SlotRows, RowTaps, std::numeric_limits<size_t>::max());
+
+    const int32_t* RowIndices = WorkBlock->RowIndices + RowStart * RowTaps;
+    const float* RowWeights = WorkBlock->RowWeights + RowStart * RowTaps;
+
+    for (size_t y = 0; y < RowCount; y++) {
+
+        for (size_t t = 0; t < RowTaps; t++) {
+
+            const size_t InputRow = size_t(RowIndices[t]);
+            const size_t Slot = InputRow % RowTaps;
+            float* SlotBuffer = RowBuffer + Slot * OutputRowLength;
+
+            if (SlotRows[Slot] != InputRow) {
+                MlasResizeHorizontal(WorkBlock, Input + InputRow * InputRowLength, SlotBuffer);
+                SlotRows[Slot] = InputRow;
+            }
+
+            Rows[t] = SlotBuffer;
+        }
+
+        MlasResizeVertical(Rows, RowWeights, RowTaps, Output, OutputRowLength);
+
+        Output += OutputRowLength;
+        RowIndices += RowTaps;
+        RowWeights += RowTaps;
+    }
+}
+
+void
+MLASCALL
+MlasResizeSeparable(
+    const float* Input,
+    size_t ImageCount,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t Channels,
+    float* Output,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    size_t RowTaps,
+    const int32_t* RowIndices,
+    const float* RowWeights,
+    size_t ColumnTaps,
+    const int32_t* ColumnIndices,
+    const float* ColumnWeights,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine resizes images with a separable filter.
+
+Arguments:
+
+    See the description in mlas.h.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (ImageCount == 0 || OutputHeight == 0 || OutputWidth == 0 || Channels == 0) {
+        return;
+    }
+
+    MLAS_RESIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.InputHeight = InputHeight;
+    WorkBlock.InputWidth = InputWidth;
+    WorkBlock.Channels = Channels;
+    WorkBlock.Output = Output;
+    WorkBlock.OutputHeight = OutputHeight;
+    WorkBlock.OutputWidth = OutputWidth;
+    WorkBlock.RowTaps = RowTaps;
+    WorkBlock.RowIndices = RowIndices;
+    WorkBlock.RowWeights = RowWeights;
+    WorkBlock.ColumnTaps = ColumnTaps;
+    WorkBlock.ColumnIndices = ColumnIndices;
+    WorkBlock.ColumnWeights = ColumnWeights;
+
+    //
+    // Split the images first, then their rows when there are less images than
+    // threads. Every row block filters the input rows it needs, so the blocks
+    // are kept large.
+    //
+
+    const double Complexity = double(ImageCount) * double(OutputHeight) * double(OutputWidth) *
+        double(Channels) * double(RowTaps + ColumnTaps);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / MLAS_RESIZE_THREAD_COMPLEXITY) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    size_t RowBlockCount = 1;
+
+    if (size_t(TargetThreadCount) > ImageCount) {
+        RowBlockCount = std::min((size_t(TargetThreadCount) + ImageCount - 1) / ImageCount, OutputHeight);
+    }
+
+    WorkBlock.RowBlockCount = RowBlockCount;
+
+    MlasExecuteThreaded(MlasResizeThreaded, &WorkBlock, ptrdiff_t(ImageCount * RowBlockCount), ThreadPool);
+}
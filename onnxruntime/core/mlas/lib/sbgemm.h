@@ -18,6 +18,7 @@ Abstract:
        MlasSBGemmConvertPackB
        MlasSBGemmPackedBOffset
        MlasSBGemmPackedBLeadingDim
+       MlasSBGemmPackedBCountK
        MlasSBGemmKernel
 
     MlasSBGemmOperation is the shared kernel driver.
@@ -30,8 +31,6 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include <cassert>
@@ -39,6 +38,15 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+
+#if defined(MLAS_TARGET_AMD64)
+//
+// The AMD64 kernels handle bfloat16 values as their bit pattern.
+//
+typedef uint16_t bfloat16_t;
+#endif
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -106,6 +114,20 @@ MlasSBGemmPackedBLeadingDim(size_t DimN, size_t DimK)
     return DimN;
 }
 
+/**
+ * @brief # of rows of a slice of the packed B buffer holding CountK rows
+ *        of matrix B, the packing function may pad the rows of a slice
+ * @tparam KernelType
+ * @param CountK
+ * @return # of rows of the packed slice
+ */
+template <typename KernelType>
+MLAS_FORCEINLINE size_t
+MlasSBGemmPackedBCountK(size_t CountK)
+{
+    return CountK;
+}
+
 template <typename KernelType>
 void
 MlasSBGemmKernel(const size_t CountM, const size_t CountN, const size_t CountK, const float* A, const size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode);
@@ -134,7 +156,8 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k +
+                                   MlasSBGemmPackedBCountK<KernelType>(CountK) * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -162,7 +185,8 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     size_t StrideK = Strides.K;
 
     if (N >= K) {
-        while (StrideK / 2 >= K) {
+        // the K stride stays a multiple of the packed K alignment so that a padded panel fits the buffer
+        while (StrideK / 2 >= K && StrideK / 2 >= KernelType::PackedK) {
             StrideN *= 2;
             StrideK /= 2;
         }
@@ -291,109 +315,13 @@ MlasSBGemmGetDispatch()
 {
 #if defined(MLAS_TARGET_ARM64)
     return &MlasSBGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    // nullptr when the processor doesn't support AVX512_BF16
+    return GetMlasPlatform().SBGemmDispatch;
 #else
-    std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
+    std::cerr << "SBGemm Kernel is supported only on ARM64 and AMD64 platforms.";
     exit(1);
 #endif
 }
 
-size_t MLASCALL
-MlasSBGemmPackBSize(size_t N, size_t K)
-{
-    //
-    // Compute the number of bytes required to hold the packed buffer.
-    //
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return 0;
-
-    const auto padding = dispatch->BufOverRead;
-    const auto PackedK = dispatch->PackedK;
-    const auto PackedN = dispatch->PackedN;
-
-    const size_t AlignedK = (K + PackedK - 1) & ~(PackedK - 1);
-    const size_t AlignedN = (N + PackedN - 1) & ~(PackedN - 1);
-    const size_t BytesRequired = AlignedN * AlignedK * sizeof(bfloat16_t) + padding;
-    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
-    const size_t AlignedBytesRequired =
-        (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
-
-    return AlignedBytesRequired;
-}
-
-void MLASCALL
-MlasSBGemmConvertPackB(size_t N, size_t K, const float* B, size_t ldb, void* PackedB)
-{
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
-
-    dispatch->ConvertPackBRoutine((bfloat16_t*)PackedB, B, ldb, N, K);
-}
-
-void MLASCALL
-MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t BatchN, const MLAS_SBGEMM_DATA_PARAMS* Data, MLAS_THREADPOOL* ThreadPool)
-{
-    const MLAS_SBGEMM_DISPATCH* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
-
-    MLAS_SBGEMM_OPERATION* operation = dispatch->Operation;
-
-    //
-    // Compute the number of target threads given the complexity of the SGEMM
-    // operation. Small requests should run using the single threaded path.
-    //
-
-    const double Complexity = double(M) * double(N) * double(K);
-
-    ptrdiff_t TargetThreadCount;
-
-    if (Complexity < double(MLAS_SBGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-    } else {
-        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
-    }
-
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
-
-    if (TargetThreadCount >= MaximumThreadCount) {
-        TargetThreadCount = MaximumThreadCount;
-    }
-
-    //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
-    //
-    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchN - 1) / BatchN;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
-
-    if (N > M) {
-        const size_t BlockedN =
-            (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
-
-        if (size_t(ThreadsPerGemm) > BlockedN) {
-            ThreadsPerGemm = ptrdiff_t(BlockedN);
-        }
-
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
-
-    } else {
-        if (size_t(ThreadsPerGemm) > M) {
-            ThreadsPerGemm = ptrdiff_t(M);
-        }
-
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
-    }
-
-    MlasTrySimpleParallel(
-        ThreadPool, ThreadsPerGemm * static_cast<ptrdiff_t>(BatchN), [=](ptrdiff_t tid) {
-            ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
-            ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
-            operation(ThreadCountM, ThreadCountN, M, N, K, &(Data[GemmIdx]), ThreadIdx);
-        }
-    );
-}
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
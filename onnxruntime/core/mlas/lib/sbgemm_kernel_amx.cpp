@@ -0,0 +1,194 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernel for AMX.
+
+--*/
+
+#include "amx_common.h"
+#include "sbgemm_kernel_avx512bf16.h"
+
+#if defined(MLAS_TARGET_AMD64)
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+struct MLAS_SBGEMM_KERNEL_AMX {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 32;  // max # rows the tiles can process
+    static constexpr size_t PackedK = 32;     // # of bfloat16 values in a row of the A tiles
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 256, 256};  // M:N:K
+    static constexpr bool PadRowsA = true;  // the A tiles always load 16 rows
+};
+
+//
+// The output is computed with AVX512_BF16 for up to this many rows, the
+// tiles always compute 16 rows.
+//
+constexpr size_t MLAS_SBGEMM_AMX_MIN_ROWS = 4;
+
+template <>
+MLAS_FORCEINLINE size_t
+MlasSBGemmPackedBCountK<MLAS_SBGEMM_KERNEL_AMX>(size_t CountK)
+{
+    return MlasSBGemmAlignCountKAvx512<MLAS_SBGEMM_KERNEL_AMX::PackedK>(CountK);
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBAvx512Bf16<MLAS_SBGEMM_KERNEL_AMX>(PackedB, B, ldb, CountN, CountK);
+}
+
+//
+// Copies the valid elements of a 16x16 tile of accumulators to the output.
+//
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmStoreTileAmx(
+    const float* Tile,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    const __mmask16 Mask = MlasSBGemmMaskAvx512(CountN);
+    const __m512 BiasElements = (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias) : _mm512_setzero_ps();
+
+    for (size_t m = 0; m < CountM; m++) {
+        MlasSBGemmStoreAvx512(C, _mm512_load_ps(Tile), BiasElements, Mask, ZeroMode);
+        Tile += 16;
+        C += ldc;
+    }
+}
+
+/**
+ * @brief Compute up to 32 rows of the output with the tiles, the rows of A
+ *        after CountM are zeros
+ *
+ *            B TMM6    B TMM7
+ *  A TMM4    C TMM0    C TMM1
+ *  A TMM5    C TMM2    C TMM3
+ */
+static void
+MlasSBGemmComputeAmx(
+    const bfloat16_t* A,
+    size_t PackedCountK,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    if (CountM <= MLAS_SBGEMM_AMX_MIN_ROWS) {
+        MlasSBGemmComputeAvx512Bf16(A, PackedCountK, B, C, ldc, CountM, CountN, Bias, ZeroMode);
+        return;
+    }
+
+    MlasAmxLoadTileConfig();
+
+    static const float ZeroTile[16 * 16] = {0};
+    MLAS_DECLSPEC_ALIGN(float Tiles[4][16 * 16], 64);
+
+    const size_t StrideA = PackedCountK * sizeof(bfloat16_t);
+    const bfloat16_t* a1 = A + 16 * PackedCountK;
+    const size_t CountM0 = std::min(CountM, size_t(16));
+    const size_t CountM1 = CountM - CountM0;
+
+    for (size_t n = 0; n < CountN; n += 32) {
+        const size_t CountN0 = std::min(CountN - n, size_t(16));
+        const size_t CountN1 = std::min(CountN - n - CountN0, size_t(16));
+        const bfloat16_t* b0 = B + n * PackedCountK;
+        const bfloat16_t* b1 = b0 + 16 * PackedCountK;
+
+        tile_loadd(TMM0, ZeroTile, 16 * sizeof(float));
+        tile_loadd(TMM1, ZeroTile, 16 * sizeof(float));
+        tile_loadd(TMM2, ZeroTile, 16 * sizeof(float));
+        tile_loadd(TMM3, ZeroTile, 16 * sizeof(float));
+
+        //
+        // A tile holds 16 rows of 32 values of A, a B tile 16 pairs of rows
+        // of 16 columns of B.
+        //
+
+        for (size_t k = 0; k < PackedCountK; k += 32) {
+            tile_loadd(TMM4, A + k, StrideA);
+            tile_loadd(TMM6, b0 + k * 16, 64);
+            tile_dpbf16ps(TMM0, TMM4, TMM6);
+            if (CountN1 > 0) {
+                tile_loadd(TMM7, b1 + k * 16, 64);
+                tile_dpbf16ps(TMM1, TMM4, TMM7);
+            }
+            if (CountM1 > 0) {
+                tile_loadd(TMM5, a1 + k, StrideA);
+                tile_dpbf16ps(TMM2, TMM5, TMM6);
+                if (CountN1 > 0) {
+                    tile_dpbf16ps(TMM3, TMM5, TMM7);
+                }
+            }
+        }
+
+        const float* bias0 = (Bias != nullptr) ? Bias + n : nullptr;
+        tile_stored(TMM0, Tiles[0], 16 * sizeof(float));
+        MlasSBGemmStoreTileAmx(Tiles[0], C + n, ldc, CountM0, CountN0, bias0, ZeroMode);
+        if (CountM1 > 0) {
+            tile_stored(TMM2, Tiles[2], 16 * sizeof(float));
+            MlasSBGemmStoreTileAmx(Tiles[2], C + 16 * ldc + n, ldc, CountM1, CountN0, bias0, ZeroMode);
+        }
+        if (CountN1 > 0) {
+            const float* bias1 = (Bias != nullptr) ? Bias + n + 16 : nullptr;
+            tile_stored(TMM1, Tiles[1], 16 * sizeof(float));
+            MlasSBGemmStoreTileAmx(Tiles[1], C + n + 16, ldc, CountM0, CountN1, bias1, ZeroMode);
+            if (CountM1 > 0) {
+                tile_stored(TMM3, Tiles[3], 16 * sizeof(float));
+                MlasSBGemmStoreTileAmx(Tiles[3], C + 16 * ldc + n + 16, ldc, CountM1, CountN1, bias1, ZeroMode);
+            }
+        }
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AMX>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    MlasSBGemmKernelAvx512Bf16<MLAS_SBGEMM_KERNEL_AMX>(
+        CountM, CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode, MlasSBGemmComputeAmx
+    );
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AMX>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>,
+    MLAS_SBGEMM_KERNEL_AMX::PackedK,
+    MLAS_SBGEMM_KERNEL_AMX::PackedN,
+    MLAS_SBGEMM_KERNEL_AMX::KernelMaxM,
+    0
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
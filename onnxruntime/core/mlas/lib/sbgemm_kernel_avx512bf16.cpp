@@ -0,0 +1,64 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernel for AVX512_BF16.
+
+--*/
+
+#include "sbgemm_kernel_avx512bf16.h"
+
+#if defined(MLAS_TARGET_AMD64)
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 16;  // max # rows of A converted at a time
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+    static constexpr bool PadRowsA = false;
+};
+
+template <>
+MLAS_FORCEINLINE size_t
+MlasSBGemmPackedBCountK<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountK)
+{
+    return MlasSBGemmAlignCountKAvx512<MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK>(CountK);
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBAvx512Bf16<MLAS_SBGEMM_KERNEL_AVX512BF16>(PackedB, B, ldb, CountN, CountK);
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    MlasSBGemmKernelAvx512Bf16<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+        CountM, CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode, MlasSBGemmComputeAvx512Bf16
+    );
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
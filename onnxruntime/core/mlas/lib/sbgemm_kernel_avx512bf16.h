@@ -0,0 +1,334 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.h
+
+Abstract:
+
+    This module implements the routines shared by the AVX512_BF16 and AMX
+    bfloat16 precision GEMM kernels.
+
+    Both kernels use the same layout for the packed matrix B: each slice of
+    at most Strides.K rows is split into panels of 16 columns, the rows of
+    a panel are padded to PackedK and stored as pairs, so that the 16
+    columns of two consecutive rows are interleaved:
+
+        B[k][0] B[k+1][0] B[k][1] B[k+1][1] ... B[k][15] B[k+1][15]
+
+    This is the operand layout of VDPBF16PS and of the AMX B tiles. The rows
+    of matrix A are converted to bfloat16 in a local buffer as the kernels
+    run.
+
+--*/
+
+#pragma once
+
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "sbgemm.h"
+
+#if defined(MLAS_TARGET_AMD64)
+
+//
+// Returns the mask of the first Count (at most 16) 32-bit elements of a vector.
+//
+
+MLAS_FORCEINLINE
+__mmask16
+MlasSBGemmMaskAvx512(size_t Count)
+{
+    return (Count >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Count) - 1);
+}
+
+//
+// Returns the # of rows of a slice of CountK rows of the packed B buffer.
+//
+
+template <size_t PackedK>
+MLAS_FORCEINLINE
+size_t
+MlasSBGemmAlignCountKAvx512(size_t CountK)
+{
+    return (CountK + PackedK - 1) & ~(PackedK - 1);
+}
+
+/**
+ * @brief Convert a fp32 matrix B to bf16 pairs of rows in panels of 16 columns
+ * @tparam KernelType
+ * @param[out] D         Address of packing buffer
+ * @param[in]  B         Address of source matrix B in fp32
+ * @param[in]  ldb       Leading dimension of B
+ * @param[in]  CountN    # of column to pack
+ * @param[in]  CountK    # of rows to pack
+ */
+template <typename KernelType>
+void
+MlasSBGemmConvertPackBAvx512Bf16(
+    bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
+
+    //
+    // The conversion of two rows returns the 16 elements of the first row
+    // followed by the 16 elements of the second row, interleave them.
+    //
+
+    static const uint16_t InterleaveIndices[32] = {
+        0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23,
+        8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31,
+    };
+    const __m512i Interleave = _mm512_loadu_si512(InterleaveIndices);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+
+    size_t CountSliceK;
+    for (size_t k = 0; k < CountK; k += CountSliceK) {
+        CountSliceK = std::min(CountK - k, Strides.K);
+        const size_t PackedCountK = MlasSBGemmAlignCountKAvx512<KernelType::PackedK>(CountSliceK);
+        const float* b = B + k * ldb;
+
+        for (size_t n = 0; n < CountN; n += 16) {
+            const __mmask16 Mask = MlasSBGemmMaskAvx512(CountN - n);
+
+            for (size_t kk = 0; kk < PackedCountK; kk += 2) {
+                const __m512 Row0 = (kk < CountSliceK)
+                    ? _mm512_maskz_loadu_ps(Mask, b + kk * ldb + n) : _mm512_setzero_ps();
+                const __m512 Row1 = (kk + 1 < CountSliceK)
+                    ? _mm512_maskz_loadu_ps(Mask, b + (kk + 1) * ldb + n) : _mm512_setzero_ps();
+                const __m512i Rows = (__m512i)_mm512_cvtne2ps_pbh(Row1, Row0);
+                _mm512_storeu_si512(D, _mm512_permutexvar_epi16(Interleave, Rows));
+                D += 32;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Convert rows of a fp32 matrix A to bf16, the rows of the buffer are
+ *        padded with zeros to PackedCountK elements
+ * @param[out] D             Address of the conversion buffer
+ * @param[in]  A             Address of source matrix A in fp32
+ * @param[in]  lda           Leading dimension of A
+ * @param[in]  CountM        # of rows to convert
+ * @param[in]  CountK        # of columns to convert
+ * @param[in]  PackedCountK  Leading dimension of the buffer
+ * @param[in]  PaddedCountM  # of rows of the buffer, the rows after CountM are zeroed
+ */
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertAAvx512Bf16(
+    bfloat16_t* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    size_t PackedCountK,
+    size_t PaddedCountM
+)
+{
+    for (size_t m = 0; m < PaddedCountM; m++) {
+        for (size_t k = 0; k < PackedCountK; k += 16) {
+            const __m512 Row = (m < CountM && k < CountK)
+                ? _mm512_maskz_loadu_ps(MlasSBGemmMaskAvx512(CountK - k), A + k) : _mm512_setzero_ps();
+            _mm256_mask_storeu_epi16(D + k, MlasSBGemmMaskAvx512(PackedCountK - k),
+                                     (__m256i)_mm512_cvtneps_pbh(Row));
+        }
+        A += lda;
+        D += PackedCountK;
+    }
+}
+
+/**
+ * @brief Store a row of 16 columns of the output: C = Accumulator + Bias,
+ *        or C += Accumulator without ZeroMode
+ */
+MLAS_FORCEINLINE
+void
+MlasSBGemmStoreAvx512(float* C, __m512 Accumulator, __m512 Bias, __mmask16 Mask, bool ZeroMode)
+{
+    Accumulator = ZeroMode ? _mm512_add_ps(Accumulator, Bias)
+                           : _mm512_add_ps(Accumulator, _mm512_maskz_loadu_ps(Mask, C));
+    _mm512_mask_storeu_ps(C, Mask, Accumulator);
+}
+
+/**
+ * @brief Compute RowCount rows and PanelCount panels of 16 columns of the output
+ *        with VDPBF16PS
+ * @param A             Converted rows of A, PackedCountK elements per row
+ * @param PackedCountK  # of rows of the packed slice of B, a multiple of 2
+ * @param B             Packed panels of B
+ * @param CountN        # of columns of the last panel, 16 for the others
+ */
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeBlockAvx512Bf16(
+    const bfloat16_t* A,
+    size_t PackedCountK,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t k = 0; k < PackedCountK; k += 2) {
+        __m512bh BElements[PanelCount];
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = (__m512bh)_mm512_loadu_si512(B + p * 16 * PackedCountK + k * 16);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            int32_t APair;
+            std::memcpy(&APair, A + r * PackedCountK + k, sizeof(APair));
+            const __m512bh ABroadcast = (__m512bh)_mm512_set1_epi32(APair);
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], ABroadcast, BElements[p]);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < PanelCount; p++) {
+        const __mmask16 Mask = MlasSBGemmMaskAvx512(CountN - p * 16);
+        const __m512 BiasElements =
+            (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias + p * 16) : _mm512_setzero_ps();
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasSBGemmStoreAvx512(C + r * ldc + p * 16, Accumulators[r][p], BiasElements, Mask, ZeroMode);
+        }
+    }
+}
+
+template <size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeRowsAvx512Bf16(
+    const bfloat16_t* A,
+    size_t PackedCountK,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    while (CountM >= 4) {
+        MlasSBGemmComputeBlockAvx512Bf16<4, PanelCount>(A, PackedCountK, B, C, ldc, CountN, Bias, ZeroMode);
+        A += 4 * PackedCountK;
+        C += 4 * ldc;
+        CountM -= 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasSBGemmComputeBlockAvx512Bf16<3, PanelCount>(A, PackedCountK, B, C, ldc, CountN, Bias, ZeroMode);
+            break;
+        case 2:
+            MlasSBGemmComputeBlockAvx512Bf16<2, PanelCount>(A, PackedCountK, B, C, ldc, CountN, Bias, ZeroMode);
+            break;
+        case 1:
+            MlasSBGemmComputeBlockAvx512Bf16<1, PanelCount>(A, PackedCountK, B, C, ldc, CountN, Bias, ZeroMode);
+            break;
+    }
+}
+
+/**
+ * @brief Compute CountM rows of the output from converted rows of A with VDPBF16PS
+ */
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeAvx512Bf16(
+    const bfloat16_t* A,
+    size_t PackedCountK,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    //
+    // Step through 4 panels of B at a time, then through the remaining panels.
+    //
+
+    size_t n = 0;
+    for (; n + 64 <= CountN; n += 64) {
+        MlasSBGemmComputeRowsAvx512Bf16<4>(A, PackedCountK, B + n * PackedCountK, C + n, ldc, CountM, 64,
+                                           (Bias != nullptr) ? Bias + n : nullptr, ZeroMode);
+    }
+    for (; n < CountN; n += 16) {
+        MlasSBGemmComputeRowsAvx512Bf16<1>(A, PackedCountK, B + n * PackedCountK, C + n, ldc, CountM, CountN - n,
+                                           (Bias != nullptr) ? Bias + n : nullptr, ZeroMode);
+    }
+}
+
+/**
+ * @brief Shared driver of the kernels: steps through the slices of the packed
+ *        B buffer along the K dimension and through blocks of KernelMaxM rows
+ *        of A converted to bf16, and calls ComputeBlock for each of them
+ */
+template <typename KernelType, typename ComputeBlockType>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelAvx512Bf16(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode,
+    ComputeBlockType ComputeBlock
+)
+{
+    constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
+    constexpr size_t KernelMaxM = KernelType::KernelMaxM;
+
+    MLAS_DECLSPEC_ALIGN(bfloat16_t PanelA[KernelMaxM * Strides.K], 64);
+
+    const size_t AlignedN = (CountN + 15) & ~size_t(15);
+
+    size_t CountSliceK;
+    for (size_t k = 0; k < CountK; k += CountSliceK) {
+        CountSliceK = std::min(CountK - k, Strides.K);
+        const size_t PackedCountK = MlasSBGemmAlignCountKAvx512<KernelType::PackedK>(CountSliceK);
+        const bfloat16_t* b = B + AlignedN * k;
+        const bool SliceZeroMode = ZeroMode && (k == 0);
+        const float* SliceBias = SliceZeroMode ? Bias : nullptr;
+
+        size_t CountBlockM;
+        for (size_t m = 0; m < CountM; m += CountBlockM) {
+            CountBlockM = std::min(CountM - m, KernelMaxM);
+            MlasSBGemmConvertAAvx512Bf16(PanelA, A + m * lda + k, lda, CountBlockM, CountSliceK, PackedCountK,
+                                         KernelType::PadRowsA ? KernelMaxM : CountBlockM);
+            ComputeBlock(PanelA, PackedCountK, b, C + m * ldc, ldc, CountBlockM, CountN, SliceBias, SliceZeroMode);
+        }
+    }
+}
+
+#endif  // defined(MLAS_TARGET_AMD64)
@@ -26,6 +26,14 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the maximum M, N, and K dimensions of a SGEMM operation that is
+// computed by the small matrix kernels. These operations skip the packing of
+// matrix B and are threaded across the batch instead of within a matrix.
+//
+
+#define MLAS_SGEMM_SMALL_MAX_DIM            32
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
@@ -91,6 +99,108 @@ Return Value:
     }
 }
 
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue operations to a block of the output
+    matrix that has been fully accumulated.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue operations. The bias and the residual
+        matrix are relative to the first row and first column of the output
+        matrix supplied to the operation.
+
+    C - Supplies the address of the block of matrix C.
+
+    StartN - Supplies the first column of the block in the output matrix.
+
+    CountM - Supplies the number of rows from matrix C.
+
+    CountN - Supplies the number of columns from matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Bias = Epilogue->Bias;
+
+    if (Bias != nullptr) {
+
+        Bias += StartN;
+        float* c = C;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreFloat32x4(c + n, MlasAddFloat32x4(MlasLoadFloat32x4(c + n), MlasLoadFloat32x4(Bias + n)));
+            }
+
+            for (; n < CountN; n++) {
+                c[n] += Bias[n];
+            }
+
+            c += ldc;
+        }
+    }
+
+    if (Epilogue->Activation != nullptr &&
+        Epilogue->Activation->ActivationKind != MlasIdentityActivation) {
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+
+    const float Scale = Epilogue->Scale;
+    const float* Residual = Epilogue->Residual;
+
+    if (Scale != 1.0f || Residual != nullptr) {
+
+        const MLAS_FLOAT32X4 ScaleBroadcast = MlasBroadcastFloat32x4(Scale);
+        const MLAS_FLOAT32X4 ZeroBroadcast = MlasZeroFloat32x4();
+
+        if (Residual != nullptr) {
+            Residual += StartN;
+        }
+
+        float* c = C;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MLAS_FLOAT32X4 ResidualElements = (Residual != nullptr) ? MlasLoadFloat32x4(Residual + n) : ZeroBroadcast;
+                MlasStoreFloat32x4(c + n, MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(c + n), ScaleBroadcast, ResidualElements));
+            }
+
+            for (; n < CountN; n++) {
+                c[n] = c[n] * Scale + ((Residual != nullptr) ? Residual[n] : 0.0f);
+            }
+
+            c += ldc;
+
+            if (Residual != nullptr) {
+                Residual += Epilogue->ldr;
+            }
+        }
+    }
+}
+
 void
 MlasSgemmTransposeA(
     float* D,
@@ -1063,6 +1173,12 @@ Return Value:
 
 #if (defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER) || defined(MLAS_TARGET_LARCH64)) && !defined(FORCE_GENERIC_ALGORITHMS)
         RowsHandled = GetMlasPlatform().GemmFloatKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+#elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_RISCV64)
+        if (ZeroMode) {
+            RowsHandled = GetMlasPlatform().GemmFloatKernelZero(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+        } else {
+            RowsHandled = GetMlasPlatform().GemmFloatKernelAdd(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+        }
 #else
         if (ZeroMode) {
             RowsHandled = MlasSgemmKernelZero(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
@@ -1093,7 +1209,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1131,6 +1248,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the operations applied to each block of
+        matrix C after it is computed.
+
 Return Value:
 
     None.
@@ -1147,6 +1267,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, 0, M, N, ldc);
+        }
         return;
     }
 
@@ -1171,6 +1294,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1178,6 +1304,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1207,6 +1336,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1317,6 +1449,15 @@ Return Value:
 
             ZeroMode = false;
         }
+
+        //
+        // Apply the epilogue while the slice of the output matrix is still
+        // in the cache.
+        //
+
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C + n, n, M, CountN, ldc);
+        }
     }
 }
 
@@ -1334,7 +1475,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1374,6 +1516,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the operations applied to each block of
+        matrix C after it is computed.
+
 Return Value:
 
     None.
@@ -1452,6 +1597,10 @@ Return Value:
 
             ZeroMode = false;
         }
+
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C + n, n, M, CountN, ldc);
+        }
     }
 }
 
@@ -1538,11 +1687,33 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    //
+    // Offset the epilogue operands to the partitioned output.
+    //
+
+    MLAS_SGEMM_EPILOGUE PartitionEpilogue;
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr;
+
+    if (DataParams->Epilogue != nullptr) {
+
+        PartitionEpilogue = *DataParams->Epilogue;
+
+        if (PartitionEpilogue.Bias != nullptr) {
+            PartitionEpilogue.Bias += RangeStartN;
+        }
+
+        if (PartitionEpilogue.Residual != nullptr) {
+            PartitionEpilogue.Residual += RangeStartM * PartitionEpilogue.ldr + RangeStartN;
+        }
+
+        Epilogue = &PartitionEpilogue;
+    }
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc, Epilogue);
 
     } else {
 
@@ -1551,9 +1722,356 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, Epilogue);
     }
 }
+template<size_t RowCount, size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallKernel(
+    size_t CountK,
+    const float* A,
+    size_t StrideAM,
+    size_t StrideAK,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a RowCount by (4 * VectorCount) block of the output
+    matrix for the small SGEMM path. The accumulators are kept in registers
+    and matrix B is read directly from the source buffer.
+
+Arguments:
+
+    CountK - Supplies the number of columns of matrix A and the number of rows
+        of matrix B.
+
+    A - Supplies the address of matrix A.
+
+    StrideAM - Supplies the distance between two rows of matrix A.
+
+    StrideAK - Supplies the distance between two columns of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulators[RowCount][VectorCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            Accumulators[r][v] = MlasZeroFloat32x4();
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        MLAS_FLOAT32X4 BElements[VectorCount];
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            BElements[v] = MlasLoadFloat32x4(B + v * 4);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const MLAS_FLOAT32X4 ABroadcast = MlasBroadcastFloat32x4(A[r * StrideAM]);
+            for (size_t v = 0; v < VectorCount; v++) {
+                Accumulators[r][v] = MlasMultiplyAddFloat32x4(ABroadcast, BElements[v], Accumulators[r][v]);
+            }
+        }
+
+        A += StrideAK;
+        B += ldb;
+    }
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            MLAS_FLOAT32X4 Result = MlasMultiplyFloat32x4(Accumulators[r][v], AlphaBroadcast);
+            if (beta != 0.0f) {
+                Result = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(C + v * 4), beta, Result);
+            }
+            MlasStoreFloat32x4(C + v * 4, Result);
+        }
+        C += ldc;
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallKernelScalar(
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t StrideAM,
+    size_t StrideAK,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the RowCount by CountN block of the output matrix
+    for the columns that do not fill a vector (CountN < 4).
+
+Arguments:
+
+    See MlasSgemmSmallKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n++) {
+
+        float Accumulators[RowCount] = {};
+
+        const float* a = A;
+        const float* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] += a[r * StrideAM] * *b;
+            }
+            a += StrideAK;
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            *c = (beta != 0.0f) ? (*c * beta) + (Accumulators[r] * alpha) : Accumulators[r] * alpha;
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallRows(
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t StrideAM,
+    size_t StrideAK,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the columns of RowCount rows of the output
+    matrix using the widest register blocked kernel that fits.
+
+Arguments:
+
+    See MlasSgemmSmallKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    for (; n + 8 <= CountN; n += 8) {
+        MlasSgemmSmallKernel<RowCount, 2>(CountK, A, StrideAM, StrideAK, B + n, ldb, C + n, ldc, alpha, beta);
+    }
+
+    if (n + 4 <= CountN) {
+        MlasSgemmSmallKernel<RowCount, 1>(CountK, A, StrideAM, StrideAK, B + n, ldb, C + n, ldc, alpha, beta);
+        n += 4;
+    }
+
+    if (n < CountN) {
+        MlasSgemmSmallKernelScalar<RowCount>(CountN - n, CountK, A, StrideAM, StrideAK, B + n, ldb, C + n, ldc, alpha, beta);
+    }
+}
+
+void
+MlasSgemmSmallOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for matrices with all dimensions no larger than
+    MLAS_SGEMM_SMALL_MAX_DIM.
+
+    Matrix B is not packed. When matrix B is transposed, it is copied to a
+    local buffer so that the kernels can load vectors from the rows of B.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelB[MLAS_SGEMM_SMALL_MAX_DIM * MLAS_SGEMM_SMALL_MAX_DIM];
+
+    const float* A = DataParams->A;
+    const float* B = (const float*)DataParams->B;
+    float* C = DataParams->C;
+    const size_t lda = DataParams->lda;
+    size_t ldb = DataParams->ldb;
+    const size_t ldc = DataParams->ldc;
+    const float alpha = DataParams->alpha;
+    const float beta = DataParams->beta;
+
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (DataParams->Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(DataParams->Epilogue, C, 0, M, N, ldc);
+        }
+        return;
+    }
+
+    if (TransB != CblasNoTrans) {
+
+        for (size_t k = 0; k < K; k++) {
+            for (size_t n = 0; n < N; n++) {
+                PanelB[k * N + n] = B[n * ldb + k];
+            }
+        }
+
+        B = PanelB;
+        ldb = N;
+    }
+
+    const size_t StrideAM = (TransA == CblasNoTrans) ? lda : 1;
+    const size_t StrideAK = (TransA == CblasNoTrans) ? 1 : lda;
+
+    for (size_t m = 0; m < M; m += 4) {
+
+        const float* a = A + m * StrideAM;
+        float* c = C + m * ldc;
+
+        switch (std::min(M - m, size_t(4))) {
+            case 4:
+                MlasSgemmSmallRows<4>(N, K, a, StrideAM, StrideAK, B, ldb, c, ldc, alpha, beta);
+                break;
+            case 3:
+                MlasSgemmSmallRows<3>(N, K, a, StrideAM, StrideAK, B, ldb, c, ldc, alpha, beta);
+                break;
+            case 2:
+                MlasSgemmSmallRows<2>(N, K, a, StrideAM, StrideAK, B, ldb, c, ldc, alpha, beta);
+                break;
+            default:
+                MlasSgemmSmallRows<1>(N, K, a, StrideAM, StrideAK, B, ldb, c, ldc, alpha, beta);
+                break;
+        }
+    }
+
+    if (DataParams->Epilogue != nullptr) {
+        MlasSgemmApplyEpilogue(DataParams->Epilogue, C, 0, M, N, ldc);
+    }
+}
+
+void
+MlasSgemmSmallBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a batch of small SGEMM operations. Each operation
+    is computed by a single thread, the batch is partitioned across the
+    threads.
+
+Arguments:
+
+    See MlasGemmBatch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > BatchSize) {
+        TargetThreadCount = ptrdiff_t(BatchSize);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid)
+    {
+        size_t BatchStart;
+        size_t BatchCount;
+
+        MlasPartitionWork(tid, TargetThreadCount, BatchSize, &BatchStart, &BatchCount);
+
+        for (size_t batch = BatchStart; batch < BatchStart + BatchCount; batch++) {
+            MlasSgemmSmallOperation(TransA, TransB, M, N, K, &Data[batch]);
+        }
+    });
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // Chance of arithmetic overflow could be reduced
@@ -1572,6 +2090,45 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     )
 {
+    MlasGemmBatch(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool, nullptr);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_SGEMM_THREADING_PARAMS* ThreadingParams
+    )
+{
+
+    //
+    // Small matrices with an unpacked matrix B are computed by the register
+    // blocked kernels, where packing and partitioning each matrix across
+    // threads costs more than the multiplication. A supplied thread partition
+    // always uses the packed kernels.
+    //
+
+    if (ThreadingParams == nullptr &&
+        M <= MLAS_SGEMM_SMALL_MAX_DIM && N <= MLAS_SGEMM_SMALL_MAX_DIM && K <= MLAS_SGEMM_SMALL_MAX_DIM) {
+
+        bool BIsPacked = false;
+
+        for (size_t batch = 0; batch < BatchSize; batch++) {
+            BIsPacked |= Data[batch].BIsPacked;
+        }
+
+        if (!BIsPacked) {
+            MlasSgemmSmallBatch(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool);
+            return;
+        }
+    }
 
     //
     // Compute the number of target threads given the complexity of the SGEMM
@@ -1583,6 +2140,10 @@ MlasGemmBatch(
     ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
     ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
 
+    if (ThreadingParams != nullptr && ThreadingParams->ThreadCount > 0) {
+        TargetThreadCount = ThreadingParams->ThreadCount;
+    }
+
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
     }
@@ -1598,7 +2159,11 @@ MlasGemmBatch(
     ptrdiff_t ThreadCountM;
     ptrdiff_t ThreadCountN;
 
-    if (N > M) {
+    const bool PartitionN = (ThreadingParams != nullptr && ThreadingParams->Partition != MlasSgemmPartitionDefault)
+        ? ThreadingParams->Partition == MlasSgemmPartitionN
+        : N > M;
+
+    if (PartitionN) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
             MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
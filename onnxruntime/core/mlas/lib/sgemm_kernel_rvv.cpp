@@ -0,0 +1,251 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_kernel_rvv.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) kernel for the RISC-V Vector extension (RVV 1.0).
+
+    The kernel consumes the same packed matrix B as the other kernels: panels
+    of 16 columns, with each row of a panel stored contiguously and the last
+    panel padded with zeroes. A panel is held in a register group of LMUL=4,
+    which holds at least 16 elements for the minimum VLEN of 128 bits of the V
+    extension, so a panel is processed in a single strip for any VLEN.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_USE_RVV)
+
+#include <riscv_vector.h>
+
+namespace {
+
+//
+// Stores the number of columns of a panel of the packed matrix B.
+//
+
+constexpr size_t MlasSgemmRvvPanelColumns = 16;
+
+template <size_t RowCount, bool ZeroMode>
+void
+MlasSgemmRvvComputeRows(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of matrix C.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed using
+        MlasSgemmCopyPackB or MlasSgemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(RowCount >= 1 && RowCount <= 4, "unsupported row count");
+
+    while (CountN > 0) {
+
+        const size_t CountNPanel = std::min(CountN, MlasSgemmRvvPanelColumns);
+        const size_t vl = __riscv_vsetvl_e32m4(CountNPanel);
+
+        vfloat32m4_t Accumulator0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+        vfloat32m4_t Accumulator1 = Accumulator0;
+        vfloat32m4_t Accumulator2 = Accumulator0;
+        vfloat32m4_t Accumulator3 = Accumulator0;
+
+        const float* a = A;
+        const float* b = B;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            vfloat32m4_t BElements = __riscv_vle32_v_f32m4(b, vl);
+
+            Accumulator0 = __riscv_vfmacc_vf_f32m4(Accumulator0, a[0], BElements, vl);
+
+            if constexpr (RowCount > 1) {
+                Accumulator1 = __riscv_vfmacc_vf_f32m4(Accumulator1, a[lda], BElements, vl);
+            }
+
+            if constexpr (RowCount > 2) {
+                Accumulator2 = __riscv_vfmacc_vf_f32m4(Accumulator2, a[lda * 2], BElements, vl);
+            }
+
+            if constexpr (RowCount > 3) {
+                Accumulator3 = __riscv_vfmacc_vf_f32m4(Accumulator3, a[lda * 3], BElements, vl);
+            }
+
+            a += 1;
+            b += MlasSgemmRvvPanelColumns;
+        }
+
+        //
+        // Multiply by the alpha value and optionally accumulate the existing
+        // contents of matrix C.
+        //
+
+        auto StoreRow = [vl, alpha](float* c, vfloat32m4_t Accumulator) {
+            Accumulator = __riscv_vfmul_vf_f32m4(Accumulator, alpha, vl);
+            if constexpr (!ZeroMode) {
+                Accumulator = __riscv_vfadd_vv_f32m4(Accumulator, __riscv_vle32_v_f32m4(c, vl), vl);
+            }
+            __riscv_vse32_v_f32m4(c, Accumulator, vl);
+        };
+
+        StoreRow(C, Accumulator0);
+
+        if constexpr (RowCount > 1) {
+            StoreRow(C + ldc, Accumulator1);
+        }
+
+        if constexpr (RowCount > 2) {
+            StoreRow(C + ldc * 2, Accumulator2);
+        }
+
+        if constexpr (RowCount > 3) {
+            StoreRow(C + ldc * 3, Accumulator3);
+        }
+
+        B += MlasSgemmRvvPanelColumns * CountK;
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+template <bool ZeroMode>
+size_t
+MlasSgemmKernelRvv(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmRvvComputeRows<1, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 1;
+        case 2:
+            MlasSgemmRvvComputeRows<2, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 2;
+        case 3:
+            MlasSgemmRvvComputeRows<3, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 3;
+        default:
+            MlasSgemmRvvComputeRows<4, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 4;
+    }
+}
+
+}  // namespace
+
+size_t
+MLASCALL
+MlasSgemmKernelZeroRvv(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows, storing the results to matrix C.
+
+Arguments:
+
+    See MlasSgemmKernelZero.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    return MlasSgemmKernelRvv<true>(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+}
+
+size_t
+MLASCALL
+MlasSgemmKernelAddRvv(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows, accumulating the results into matrix C.
+
+Arguments:
+
+    See MlasSgemmKernelAdd.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    return MlasSgemmKernelRvv<false>(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+}
+
+#endif  // defined(MLAS_USE_RVV)
@@ -0,0 +1,367 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_kernel_sve.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) kernel for ARM SVE.
+
+    The kernel consumes the same packed matrix B as the NEON kernel: panels
+    of 16 columns, with each row of a panel stored contiguously and the last
+    panel padded with zeroes. The kernel is vector length agnostic: a panel is
+    processed as one or more column strips of the native vector length, so
+    processors with 256-bit or wider vectors need fewer instructions per
+    panel than the fixed 128-bit NEON kernel.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_USE_SVE)
+
+#include <arm_sve.h>
+
+namespace {
+
+//
+// Stores the number of columns of a panel of the packed matrix B.
+//
+
+constexpr size_t MlasSgemmSvePanelColumns = 16;
+
+//
+// Stores the maximum number of rows of matrix A processed per iteration.
+//
+
+constexpr size_t MlasSgemmSveRowCount = 4;
+
+template <size_t Lane>
+MLAS_FORCEINLINE
+void
+MlasSgemmSveMultiplyAddLane(
+    svfloat32_t& Accumulator,
+    svfloat32_t BElements,
+    svfloat32_t AElements
+    )
+{
+    Accumulator = svmla_lane_f32(Accumulator, BElements, AElements, Lane);
+}
+
+template <bool ZeroMode>
+MLAS_FORCEINLINE
+void
+MlasSgemmSveStoreRow(
+    float* C,
+    svfloat32_t Accumulator,
+    float alpha,
+    svbool_t ColumnPredicate
+    )
+{
+    const svbool_t AllLanes = svptrue_b32();
+
+    Accumulator = svmul_n_f32_x(AllLanes, Accumulator, alpha);
+
+    if constexpr (!ZeroMode) {
+        Accumulator = svadd_f32_x(AllLanes, Accumulator, svld1_f32(ColumnPredicate, C));
+    }
+
+    svst1_f32(ColumnPredicate, C, Accumulator);
+}
+
+template <size_t RowCount, bool ZeroMode>
+MLAS_FORCEINLINE
+void
+MlasSgemmSveComputeStrip(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    svbool_t ColumnPredicate
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a strip of up to one vector of columns of matrix C
+    for RowCount rows of matrix A.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of the strip in a panel of the packed matrix B.
+
+    C - Supplies the address of the strip of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    ColumnPredicate - Supplies the predicate of the columns of the strip.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(RowCount >= 1 && RowCount <= MlasSgemmSveRowCount, "unsupported row count");
+
+    const svbool_t AllLanes = svptrue_b32();
+
+    const float* a0 = A;
+    const float* a1 = A + lda * (RowCount > 1 ? 1 : 0);
+    const float* a2 = A + lda * (RowCount > 2 ? 2 : 0);
+    const float* a3 = A + lda * (RowCount > 3 ? 3 : 0);
+
+    svfloat32_t Accumulator0 = svdup_n_f32(0.0f);
+    svfloat32_t Accumulator1 = svdup_n_f32(0.0f);
+    svfloat32_t Accumulator2 = svdup_n_f32(0.0f);
+    svfloat32_t Accumulator3 = svdup_n_f32(0.0f);
+
+    //
+    // Load four elements from each row of matrix A replicated to every 128-bit
+    // segment, so that each row of matrix B is multiplied by an indexed lane.
+    //
+
+    size_t k = CountK;
+
+    while (k >= 4) {
+
+        svfloat32_t AElements0 = svld1rq_f32(AllLanes, a0);
+        svfloat32_t AElements1 = (RowCount > 1) ? svld1rq_f32(AllLanes, a1) : AElements0;
+        svfloat32_t AElements2 = (RowCount > 2) ? svld1rq_f32(AllLanes, a2) : AElements0;
+        svfloat32_t AElements3 = (RowCount > 3) ? svld1rq_f32(AllLanes, a3) : AElements0;
+
+        svfloat32_t BElements0 = svld1_f32(ColumnPredicate, B);
+        svfloat32_t BElements1 = svld1_f32(ColumnPredicate, B + MlasSgemmSvePanelColumns);
+        svfloat32_t BElements2 = svld1_f32(ColumnPredicate, B + MlasSgemmSvePanelColumns * 2);
+        svfloat32_t BElements3 = svld1_f32(ColumnPredicate, B + MlasSgemmSvePanelColumns * 3);
+
+        MlasSgemmSveMultiplyAddLane<0>(Accumulator0, BElements0, AElements0);
+        MlasSgemmSveMultiplyAddLane<1>(Accumulator0, BElements1, AElements0);
+        MlasSgemmSveMultiplyAddLane<2>(Accumulator0, BElements2, AElements0);
+        MlasSgemmSveMultiplyAddLane<3>(Accumulator0, BElements3, AElements0);
+
+        if constexpr (RowCount > 1) {
+            MlasSgemmSveMultiplyAddLane<0>(Accumulator1, BElements0, AElements1);
+            MlasSgemmSveMultiplyAddLane<1>(Accumulator1, BElements1, AElements1);
+            MlasSgemmSveMultiplyAddLane<2>(Accumulator1, BElements2, AElements1);
+            MlasSgemmSveMultiplyAddLane<3>(Accumulator1, BElements3, AElements1);
+        }
+
+        if constexpr (RowCount > 2) {
+            MlasSgemmSveMultiplyAddLane<0>(Accumulator2, BElements0, AElements2);
+            MlasSgemmSveMultiplyAddLane<1>(Accumulator2, BElements1, AElements2);
+            MlasSgemmSveMultiplyAddLane<2>(Accumulator2, BElements2, AElements2);
+            MlasSgemmSveMultiplyAddLane<3>(Accumulator2, BElements3, AElements2);
+        }
+
+        if constexpr (RowCount > 3) {
+            MlasSgemmSveMultiplyAddLane<0>(Accumulator3, BElements0, AElements3);
+            MlasSgemmSveMultiplyAddLane<1>(Accumulator3, BElements1, AElements3);
+            MlasSgemmSveMultiplyAddLane<2>(Accumulator3, BElements2, AElements3);
+            MlasSgemmSveMultiplyAddLane<3>(Accumulator3, BElements3, AElements3);
+        }
+
+        a0 += 4;
+        a1 += 4;
+        a2 += 4;
+        a3 += 4;
+        B += MlasSgemmSvePanelColumns * 4;
+        k -= 4;
+    }
+
+    while (k > 0) {
+
+        svfloat32_t BElements = svld1_f32(ColumnPredicate, B);
+
+        Accumulator0 = svmla_n_f32_x(AllLanes, Accumulator0, BElements, *a0++);
+
+        if constexpr (RowCount > 1) {
+            Accumulator1 = svmla_n_f32_x(AllLanes, Accumulator1, BElements, *a1++);
+        }
+
+        if constexpr (RowCount > 2) {
+            Accumulator2 = svmla_n_f32_x(AllLanes, Accumulator2, BElements, *a2++);
+        }
+
+        if constexpr (RowCount > 3) {
+            Accumulator3 = svmla_n_f32_x(AllLanes, Accumulator3, BElements, *a3++);
+        }
+
+        B += MlasSgemmSvePanelColumns;
+        k -= 1;
+    }
+
+    //
+    // Multiply by the alpha value and optionally accumulate the existing
+    // contents of matrix C.
+    //
+
+    MlasSgemmSveStoreRow<ZeroMode>(C, Accumulator0, alpha, ColumnPredicate);
+
+    if constexpr (RowCount > 1) {
+        MlasSgemmSveStoreRow<ZeroMode>(C + ldc, Accumulator1, alpha, ColumnPredicate);
+    }
+
+    if constexpr (RowCount > 2) {
+        MlasSgemmSveStoreRow<ZeroMode>(C + ldc * 2, Accumulator2, alpha, ColumnPredicate);
+    }
+
+    if constexpr (RowCount > 3) {
+        MlasSgemmSveStoreRow<ZeroMode>(C + ldc * 3, Accumulator3, alpha, ColumnPredicate);
+    }
+}
+
+template <size_t RowCount, bool ZeroMode>
+void
+MlasSgemmSveComputeRows(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+{
+    const size_t VectorLength = svcntw();
+
+    while (CountN > 0) {
+
+        const size_t CountNPanel = std::min(CountN, MlasSgemmSvePanelColumns);
+
+        for (size_t n = 0; n < CountNPanel; n += VectorLength) {
+
+            const svbool_t ColumnPredicate = svwhilelt_b32(uint64_t(n), uint64_t(CountNPanel));
+
+            MlasSgemmSveComputeStrip<RowCount, ZeroMode>(A, B + n, C + n, CountK, lda, ldc, alpha, ColumnPredicate);
+        }
+
+        B += MlasSgemmSvePanelColumns * CountK;
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+template <bool ZeroMode>
+size_t
+MlasSgemmKernelSve(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed using
+        MlasSgemmCopyPackB or MlasSgemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmSveComputeRows<1, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 1;
+        case 2:
+            MlasSgemmSveComputeRows<2, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 2;
+        case 3:
+            MlasSgemmSveComputeRows<3, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 3;
+        default:
+            MlasSgemmSveComputeRows<4, ZeroMode>(A, B, C, CountK, CountN, lda, ldc, alpha);
+            return 4;
+    }
+}
+
+}  // namespace
+
+size_t
+MLASCALL
+MlasSgemmKernelZeroSve(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+{
+    return MlasSgemmKernelSve<true>(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+}
+
+size_t
+MLASCALL
+MlasSgemmKernelAddSve(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha
+    )
+{
+    return MlasSgemmKernelSve<false>(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+}
+
+#endif  // defined(MLAS_USE_SVE)
@@ -0,0 +1,553 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse24gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a matrix B that has 2:4 structured sparsity: every group
+    of four consecutive rows of a column of matrix B holds at most two non-zero
+    values.
+
+    Matrix B is compressed to the two values of each group and their 2-bit
+    row indices inside the group, which halves the size of the weights. The
+    kernel transposes a block of rows of matrix A so that a row of the
+    transposed block can be loaded as a vector, then multiplies each stored
+    value with the transposed row that its index selects. The zero values of
+    matrix B are never multiplied.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of rows of a group of matrix B, of which at most two are non-zero.
+//
+
+constexpr size_t MLAS_SPARSE24_GROUP_SIZE = 4;
+
+//
+// Number of columns of a packed panel of matrix B.
+//
+
+constexpr size_t MLAS_SPARSE24_STRIDEN = 4;
+
+//
+// Number of rows of matrix A transposed at a time.
+//
+
+constexpr size_t MLAS_SPARSE24_STRIDEM = 8;
+
+//
+// Number of rows of matrix B processed for a transposed block of matrix A.
+// This is a multiple of MLAS_SPARSE24_GROUP_SIZE.
+//
+
+constexpr size_t MLAS_SPARSE24_STRIDEK = 256;
+
+//
+// Number of columns of matrix C computed by one unit of work.
+//
+
+constexpr size_t MLAS_SPARSE24_UNITN = 128;
+
+//
+// Layout of the packed matrix B. For each panel of MLAS_SPARSE24_STRIDEN
+// columns and each group, the values are stored as two floats per column,
+// followed in a separate array by one 16-bit word of indices per group that
+// holds for each column the 2-bit indices of the two values.
+//
+
+static
+size_t
+MlasSparse24GemmValueCount(
+    size_t N,
+    size_t K
+    )
+{
+    const size_t PanelCount = (N + MLAS_SPARSE24_STRIDEN - 1) / MLAS_SPARSE24_STRIDEN;
+    const size_t GroupCount = (K + MLAS_SPARSE24_GROUP_SIZE - 1) / MLAS_SPARSE24_GROUP_SIZE;
+
+    return PanelCount * GroupCount * MLAS_SPARSE24_STRIDEN * 2;
+}
+
+bool
+MLASCALL
+MlasSparse24GemmCheckB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine checks whether matrix B has 2:4 structured sparsity along
+    its rows. The rows past K in the last group are treated as zeros.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns true if matrix B can be packed by MlasSparse24GemmPackB.
+
+--*/
+{
+    for (size_t n = 0; n < N; n++) {
+
+        for (size_t k = 0; k < K; k += MLAS_SPARSE24_GROUP_SIZE) {
+
+            const size_t CountK = std::min(K - k, MLAS_SPARSE24_GROUP_SIZE);
+            size_t NonZeroCount = 0;
+
+            for (size_t i = 0; i < CountK; i++) {
+                const float Value = (TransB == CblasNoTrans) ? B[(k + i) * ldb + n] : B[n * ldb + k + i];
+                NonZeroCount += (Value != 0.0f) ? 1 : 0;
+            }
+
+            if (NonZeroCount > 2) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    const size_t ValueCount = MlasSparse24GemmValueCount(N, K);
+    const size_t IndexCount = ValueCount / (MLAS_SPARSE24_STRIDEN * 2);
+
+    return ValueCount * sizeof(float) + IndexCount * sizeof(uint16_t);
+}
+
+void
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine compresses matrix B to the destination buffer. The destination
+    buffer should be sized based on MlasSparse24GemmPackBSize(). Matrix B must
+    have 2:4 structured sparsity as checked by MlasSparse24GemmCheckB().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* Values = reinterpret_cast<float*>(PackedB);
+    uint16_t* Indices = reinterpret_cast<uint16_t*>(Values + MlasSparse24GemmValueCount(N, K));
+
+    for (size_t n = 0; n < N; n += MLAS_SPARSE24_STRIDEN) {
+
+        for (size_t k = 0; k < K; k += MLAS_SPARSE24_GROUP_SIZE) {
+
+            const size_t CountK = std::min(K - k, MLAS_SPARSE24_GROUP_SIZE);
+            uint16_t GroupIndices = 0;
+
+            for (size_t c = 0; c < MLAS_SPARSE24_STRIDEN; c++) {
+
+                //
+                // A group with fewer than two non-zero values is completed
+                // with zeros at distinct indices, which also covers the
+                // padding columns.
+                //
+
+                float GroupValues[2] = {0.0f, 0.0f};
+                unsigned ValueIndices[2] = {0, 1};
+                size_t ValueCount = 0;
+
+                if (n + c < N) {
+                    for (size_t i = 0; i < CountK && ValueCount < 2; i++) {
+                        const float Value = (TransB == CblasNoTrans) ? B[(k + i) * ldb + n + c]
+                                                                     : B[(n + c) * ldb + k + i];
+                        if (Value != 0.0f) {
+                            GroupValues[ValueCount] = Value;
+                            ValueIndices[ValueCount] = unsigned(i);
+                            ValueCount++;
+                        }
+                    }
+                }
+
+                if (ValueCount == 1) {
+                    ValueIndices[1] = (ValueIndices[0] == 0) ? 1 : 0;
+                }
+
+                Values[c * 2 + 0] = GroupValues[0];
+                Values[c * 2 + 1] = GroupValues[1];
+                GroupIndices |= uint16_t((ValueIndices[0] | (ValueIndices[1] << 2)) << (c * 4));
+            }
+
+            Values += MLAS_SPARSE24_STRIDEN * 2;
+            *Indices++ = GroupIndices;
+        }
+    }
+}
+
+template <size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasSparse24GemmKernel(
+    const float* TransposedA,
+    const float* Values,
+    const uint16_t* Indices,
+    size_t CountGroup,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a transposed block of matrix A with the groups of
+    a packed panel of matrix B.
+
+Arguments:
+
+    TransposedA - Supplies the address of the transposed block of matrix A,
+        stored as rows of MLAS_SPARSE24_STRIDEM values.
+
+    Values - Supplies the address of the values of the first group.
+
+    Indices - Supplies the address of the indices of the first group.
+
+    CountGroup - Supplies the number of groups to multiply.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of matrix C to update.
+
+    CountN - Supplies the number of columns of matrix C to update.
+
+    ZeroMode - Supplies true if the output matrix must be initialized, else
+        false if the output matrix is accumulated into.
+
+    alpha - Supplies the scalar multiplier, only applied when the output
+        matrix is initialized.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulators[MLAS_SPARSE24_STRIDEN][VectorCount];
+
+    for (size_t c = 0; c < MLAS_SPARSE24_STRIDEN; c++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            Accumulators[c][v] = MlasZeroFloat32x4();
+        }
+    }
+
+    for (size_t g = 0; g < CountGroup; g++) {
+
+        const unsigned GroupIndices = Indices[g];
+
+        for (size_t c = 0; c < MLAS_SPARSE24_STRIDEN; c++) {
+
+            const float* a0 = TransposedA + ((GroupIndices >> (c * 4)) & 3) * MLAS_SPARSE24_STRIDEM;
+            const float* a1 = TransposedA + ((GroupIndices >> (c * 4 + 2)) & 3) * MLAS_SPARSE24_STRIDEM;
+            MLAS_FLOAT32X4 BElement0 = MlasBroadcastFloat32x4(Values + c * 2 + 0);
+            MLAS_FLOAT32X4 BElement1 = MlasBroadcastFloat32x4(Values + c * 2 + 1);
+
+            for (size_t v = 0; v < VectorCount; v++) {
+                Accumulators[c][v] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a0 + v * 4), BElement0, Accumulators[c][v]);
+                Accumulators[c][v] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a1 + v * 4), BElement1, Accumulators[c][v]);
+            }
+        }
+
+        TransposedA += MLAS_SPARSE24_GROUP_SIZE * MLAS_SPARSE24_STRIDEM;
+        Values += MLAS_SPARSE24_STRIDEN * 2;
+    }
+
+    //
+    // The accumulators hold columns of matrix C, so they are transposed
+    // through a buffer to update the rows of matrix C.
+    //
+
+    float Tile[MLAS_SPARSE24_STRIDEN][MLAS_SPARSE24_STRIDEM];
+
+    for (size_t c = 0; c < MLAS_SPARSE24_STRIDEN; c++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            MlasStoreFloat32x4(&Tile[c][v * 4], Accumulators[c][v]);
+        }
+    }
+
+    for (size_t m = 0; m < CountM; m++) {
+        for (size_t c = 0; c < CountN; c++) {
+            if (ZeroMode) {
+                C[c] = Tile[c][m] * alpha;
+            } else {
+                C[c] += Tile[c][m] * alpha;
+            }
+        }
+        C += ldc;
+    }
+}
+
+void
+MlasSparse24GemmOperation(
+    size_t CountM,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t N,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* Data,
+    size_t RangeStartM
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of MLAS_SPARSE24_STRIDEM or fewer rows of a
+    range of columns of matrix C.
+
+Arguments:
+
+    CountM - Supplies the number of rows to compute.
+
+    RangeStartN - Supplies the first column to compute, a multiple of
+        MLAS_SPARSE24_STRIDEN.
+
+    RangeCountN - Supplies the number of columns to compute.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the matrices data parameters.
+
+    RangeStartM - Supplies the first row to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float TransposedA[MLAS_SPARSE24_STRIDEK * MLAS_SPARSE24_STRIDEM], 64);
+
+    const size_t GroupCount = (K + MLAS_SPARSE24_GROUP_SIZE - 1) / MLAS_SPARSE24_GROUP_SIZE;
+    const float* PackedValues = reinterpret_cast<const float*>(Data->PackedB);
+    const uint16_t* PackedIndices =
+        reinterpret_cast<const uint16_t*>(PackedValues + MlasSparse24GemmValueCount(N, K));
+
+    const float* A = Data->A + RangeStartM * Data->lda;
+    float* C = Data->C + RangeStartM * Data->ldc;
+
+    if (K == 0) {
+        for (size_t m = 0; m < CountM; m++) {
+            std::fill_n(C + m * Data->ldc + RangeStartN, RangeCountN, 0.0f);
+        }
+        return;
+    }
+
+    for (size_t k = 0; k < K; k += MLAS_SPARSE24_STRIDEK) {
+
+        const size_t CountK = std::min(K - k, MLAS_SPARSE24_STRIDEK);
+        const size_t CountGroup = (CountK + MLAS_SPARSE24_GROUP_SIZE - 1) / MLAS_SPARSE24_GROUP_SIZE;
+
+        //
+        // Transpose the block of matrix A, padding the rows past CountM and
+        // the columns past K with zeros.
+        //
+
+        for (size_t kk = 0; kk < CountGroup * MLAS_SPARSE24_GROUP_SIZE; kk++) {
+            float* t = TransposedA + kk * MLAS_SPARSE24_STRIDEM;
+            for (size_t m = 0; m < MLAS_SPARSE24_STRIDEM; m++) {
+                t[m] = (m < CountM && kk < CountK) ? A[m * Data->lda + k + kk] : 0.0f;
+            }
+        }
+
+        const size_t FirstGroup = k / MLAS_SPARSE24_GROUP_SIZE;
+
+        for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n += MLAS_SPARSE24_STRIDEN) {
+
+            const size_t Panel = n / MLAS_SPARSE24_STRIDEN;
+            const size_t CountN = std::min(RangeStartN + RangeCountN - n, MLAS_SPARSE24_STRIDEN);
+            const float* Values = PackedValues + (Panel * GroupCount + FirstGroup) * MLAS_SPARSE24_STRIDEN * 2;
+            const uint16_t* Indices = PackedIndices + Panel * GroupCount + FirstGroup;
+
+            if (CountM > 4) {
+                MlasSparse24GemmKernel<2>(TransposedA, Values, Indices, CountGroup, C + n, Data->ldc,
+                                          CountM, CountN, k == 0, Data->alpha);
+            } else {
+                MlasSparse24GemmKernel<1>(TransposedA, Values, Indices, CountGroup, C + n, Data->ldc,
+                                          CountM, CountN, k == 0, Data->alpha);
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparse24GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched single precision matrix/matrix
+    multiply operation with a 2:4 sparse matrix B packed by
+    MlasSparse24GemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies an array of matrices data parameters.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    //
+    // Each unit of work computes a block of rows for a range of columns. The
+    // units of a block of rows are consecutive so that a thread transposes
+    // the same rows of matrix A for all the columns that it computes.
+    //
+
+    const size_t BlockCountM = (M + MLAS_SPARSE24_STRIDEM - 1) / MLAS_SPARSE24_STRIDEM;
+    const size_t BlockCountN = (N + MLAS_SPARSE24_UNITN - 1) / MLAS_SPARSE24_UNITN;
+    const size_t UnitsPerGemm = BlockCountM * BlockCountN;
+    const size_t TotalUnits = UnitsPerGemm * BatchSize;
+
+    //
+    // The complexity only counts the non-zero values of matrix B.
+    //
+
+    const double Complexity = double(M) * double(N) * double(std::max<size_t>(K / 2, 1)) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > TotalUnits) {
+        TargetThreadCount = ptrdiff_t(TotalUnits);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, TargetThreadCount, TotalUnits, &WorkIndex, &WorkRemaining);
+
+        while (WorkRemaining > 0) {
+
+            //
+            // Merge the consecutive units of the same block of rows.
+            //
+
+            const size_t Batch = WorkIndex / UnitsPerGemm;
+            const size_t BlockM = (WorkIndex % UnitsPerGemm) / BlockCountN;
+            const size_t BlockN = WorkIndex % BlockCountN;
+            const size_t UnitCount = std::min(WorkRemaining, BlockCountN - BlockN);
+
+            const size_t RangeStartM = BlockM * MLAS_SPARSE24_STRIDEM;
+            const size_t CountM = std::min(M - RangeStartM, MLAS_SPARSE24_STRIDEM);
+            const size_t RangeStartN = BlockN * MLAS_SPARSE24_UNITN;
+            const size_t RangeCountN = std::min(N - RangeStartN, UnitCount * MLAS_SPARSE24_UNITN);
+
+            MlasSparse24GemmOperation(CountM, RangeStartN, RangeCountN, N, K, &Data[Batch], RangeStartM);
+
+            WorkIndex += UnitCount;
+            WorkRemaining -= UnitCount;
+        }
+    });
+}
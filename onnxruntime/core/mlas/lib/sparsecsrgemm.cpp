@@ -0,0 +1,619 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsecsrgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a sparse matrix A stored in a blocked compressed sparse row
+    (CSR) format and a dense matrix B.
+
+    The rows of matrix A are grouped in blocks of BlockM rows. Each row block
+    stores the columns where any of its rows holds a non-zero value, with the
+    BlockM values of the column stored together. A block size of one is the
+    CSR format. Larger blocks store some zeros, but each row of matrix B that
+    is loaded is multiplied with the values of several rows of matrix A.
+
+    The kernel vectorizes along N: each stored column of a row block loads a
+    strip of a row of matrix B and accumulates it, scaled by the values of the
+    column, into the strips of the rows of matrix C.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of columns of matrix C computed by one unit of work.
+//
+
+constexpr size_t MLAS_SPARSE_CSR_UNITN = 256;
+
+static
+size_t
+MlasSparseCsrGemmRowBlockCount(
+    size_t M,
+    size_t BlockM
+    )
+{
+    return (M + BlockM - 1) / BlockM;
+}
+
+static
+bool
+MlasSparseCsrGemmIsBlockSupported(
+    size_t BlockM
+    )
+{
+    return BlockM == 1 || BlockM == 2 || BlockM == 4;
+}
+
+size_t
+MLASCALL
+MlasSparseCsrGemmCountBlocks(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t K,
+    size_t BlockM,
+    const float* A,
+    size_t lda
+    )
+/*++
+
+Routine Description:
+
+    This routine counts the columns stored for the row blocks of matrix A,
+    which are the columns where any row of a row block holds a non-zero value.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A.
+
+    K - Supplies the number of columns of matrix A.
+
+    BlockM - Supplies the number of rows of a row block, 1, 2 or 4.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+Return Value:
+
+    Returns the number of stored columns, each holding BlockM values.
+
+--*/
+{
+    size_t BlockCount = 0;
+
+    for (size_t m = 0; m < M; m += BlockM) {
+
+        const size_t CountM = std::min(M - m, BlockM);
+
+        for (size_t k = 0; k < K; k++) {
+            for (size_t r = 0; r < CountM; r++) {
+                const float Value = (TransA == CblasNoTrans) ? A[(m + r) * lda + k] : A[k * lda + m + r];
+                if (Value != 0.0f) {
+                    BlockCount++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return BlockCount;
+}
+
+size_t
+MLASCALL
+MlasSparseCsrGemmPackASize(
+    size_t M,
+    size_t BlockM,
+    size_t BlockCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix A buffer.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A.
+
+    BlockM - Supplies the number of rows of a row block.
+
+    BlockCount - Supplies the number of stored columns, as counted by
+        MlasSparseCsrGemmCountBlocks.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix A buffer.
+
+--*/
+{
+    const size_t RowBlockCount = MlasSparseCsrGemmRowBlockCount(M, BlockM);
+
+    return (RowBlockCount + 1 + BlockCount) * sizeof(int64_t) + BlockCount * BlockM * sizeof(float);
+}
+
+void
+MLASCALL
+MlasSparseCsrGemmSetPackedA(
+    size_t M,
+    size_t BlockM,
+    size_t BlockCount,
+    const void* PackedA,
+    MLAS_SPARSE_CSR_GEMM_DATA_PARAMS* Data
+    )
+/*++
+
+Routine Description:
+
+    This routine sets the matrix A arrays of the data parameters to the arrays
+    of a buffer packed by MlasSparseCsrGemmPackA. The packed buffer stores the
+    row offsets, then the column indices and then the values.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A.
+
+    BlockM - Supplies the number of rows of a row block.
+
+    BlockCount - Supplies the number of stored columns.
+
+    PackedA - Supplies the address of packed matrix A.
+
+    Data - Supplies the data parameters to update.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int64_t* RowOffsets = reinterpret_cast<const int64_t*>(PackedA);
+    const int64_t* ColumnIndices = RowOffsets + MlasSparseCsrGemmRowBlockCount(M, BlockM) + 1;
+
+    Data->RowOffsets = RowOffsets;
+    Data->ColumnIndices = ColumnIndices;
+    Data->Values = reinterpret_cast<const float*>(ColumnIndices + BlockCount);
+}
+
+void
+MLASCALL
+MlasSparseCsrGemmPackA(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t K,
+    size_t BlockM,
+    const float* A,
+    size_t lda,
+    void* PackedA
+    )
+/*++
+
+Routine Description:
+
+    This routine compresses matrix A to the blocked CSR format in the
+    destination buffer. The destination buffer should be sized based on
+    MlasSparseCsrGemmPackASize() for the count of MlasSparseCsrGemmCountBlocks().
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A.
+
+    K - Supplies the number of columns of matrix A.
+
+    BlockM - Supplies the number of rows of a row block, 1, 2 or 4.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedA - Supplies the address of packed matrix A.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSparseCsrGemmIsBlockSupported(BlockM)) {
+        MLAS_THROW_EX(std::invalid_argument, "The row block size of the sparse matrix must be 1, 2 or 4.");
+    }
+
+    const size_t RowBlockCount = MlasSparseCsrGemmRowBlockCount(M, BlockM);
+    const size_t BlockCount = MlasSparseCsrGemmCountBlocks(TransA, M, K, BlockM, A, lda);
+
+    int64_t* RowOffsets = reinterpret_cast<int64_t*>(PackedA);
+    int64_t* ColumnIndices = RowOffsets + RowBlockCount + 1;
+    float* Values = reinterpret_cast<float*>(ColumnIndices + BlockCount);
+
+    size_t Block = 0;
+
+    for (size_t rb = 0; rb < RowBlockCount; rb++) {
+
+        const size_t m = rb * BlockM;
+        const size_t CountM = std::min(M - m, BlockM);
+
+        RowOffsets[rb] = int64_t(Block);
+
+        for (size_t k = 0; k < K; k++) {
+
+            //
+            // The rows of the last row block past M are stored as zeros.
+            //
+
+            float ColumnValues[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            bool NonZero = false;
+
+            for (size_t r = 0; r < CountM; r++) {
+                ColumnValues[r] = (TransA == CblasNoTrans) ? A[(m + r) * lda + k] : A[k * lda + m + r];
+                NonZero = NonZero || (ColumnValues[r] != 0.0f);
+            }
+
+            if (NonZero) {
+                ColumnIndices[Block] = int64_t(k);
+                std::copy_n(ColumnValues, BlockM, Values + Block * BlockM);
+                Block++;
+            }
+        }
+    }
+
+    RowOffsets[RowBlockCount] = int64_t(Block);
+}
+
+template <size_t BlockM, size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasSparseCsrGemmKernel(
+    const int64_t* ColumnIndices,
+    const float* Values,
+    size_t BlockCount,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a strip of VectorCount vectors of the rows of a row
+    block of matrix C.
+
+Arguments:
+
+    ColumnIndices - Supplies the column indices of the row block.
+
+    Values - Supplies the values of the row block.
+
+    BlockCount - Supplies the number of stored columns of the row block.
+
+    B - Supplies the address of the strip of the first row of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of the strip of the first row of the row block
+        of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of the row block to store.
+
+    alpha - Supplies the scalar multiplier.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulators[BlockM][VectorCount];
+
+    for (size_t r = 0; r < BlockM; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            Accumulators[r][v] = MlasZeroFloat32x4();
+        }
+    }
+
+    for (size_t j = 0; j < BlockCount; j++) {
+
+        const float* b = B + size_t(ColumnIndices[j]) * ldb;
+        MLAS_FLOAT32X4 BElements[VectorCount];
+
+        for (size_t v = 0; v < VectorCount; v++) {
+            BElements[v] = MlasLoadFloat32x4(b + v * 4);
+        }
+
+        for (size_t r = 0; r < BlockM; r++) {
+            MLAS_FLOAT32X4 AElement = MlasBroadcastFloat32x4(Values + j * BlockM + r);
+            for (size_t v = 0; v < VectorCount; v++) {
+                Accumulators[r][v] = MlasMultiplyAddFloat32x4(BElements[v], AElement, Accumulators[r][v]);
+            }
+        }
+    }
+
+    MLAS_FLOAT32X4 Alpha = MlasBroadcastFloat32x4(alpha);
+
+    for (size_t r = 0; r < CountM; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            MlasStoreFloat32x4(C + r * ldc + v * 4, MlasMultiplyFloat32x4(Accumulators[r][v], Alpha));
+        }
+    }
+}
+
+template <size_t BlockM>
+void
+MlasSparseCsrGemmRemainderKernel(
+    const int64_t* ColumnIndices,
+    const float* Values,
+    size_t BlockCount,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the last columns of the rows of a row block of
+    matrix C, fewer than a vector.
+
+Arguments:
+
+    See MlasSparseCsrGemmKernel.
+
+    CountN - Supplies the number of columns to compute, less than 4.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Accumulators[BlockM][4] = {};
+
+    for (size_t j = 0; j < BlockCount; j++) {
+
+        const float* b = B + size_t(ColumnIndices[j]) * ldb;
+
+        for (size_t r = 0; r < BlockM; r++) {
+            const float AElement = Values[j * BlockM + r];
+            for (size_t n = 0; n < CountN; n++) {
+                Accumulators[r][n] += AElement * b[n];
+            }
+        }
+    }
+
+    for (size_t r = 0; r < CountM; r++) {
+        for (size_t n = 0; n < CountN; n++) {
+            C[r * ldc + n] = Accumulators[r][n] * alpha;
+        }
+    }
+}
+
+template <size_t BlockM>
+void
+MlasSparseCsrGemmOperation(
+    size_t M,
+    size_t RowBlockStart,
+    size_t RowBlockEnd,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    const MLAS_SPARSE_CSR_GEMM_DATA_PARAMS* Data
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of columns of a range of row blocks of
+    matrix C.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    RowBlockStart - Supplies the first row block to compute.
+
+    RowBlockEnd - Supplies the end of the range of row blocks to compute.
+
+    RangeStartN - Supplies the first column to compute.
+
+    RangeCountN - Supplies the number of columns to compute.
+
+    Data - Supplies the matrices data parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Four accumulator vectors per row of the row block leave the registers of
+    // the strip of matrix B to the smaller row blocks.
+    //
+
+    constexpr size_t StripVectorCount = (BlockM >= 4) ? 2 : 4;
+    constexpr size_t StripN = StripVectorCount * 4;
+
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+    const float alpha = Data->alpha;
+
+    for (size_t rb = RowBlockStart; rb < RowBlockEnd; rb++) {
+
+        const size_t BlockStart = size_t(Data->RowOffsets[rb]);
+        const size_t BlockCount = size_t(Data->RowOffsets[rb + 1]) - BlockStart;
+        const int64_t* ColumnIndices = Data->ColumnIndices + BlockStart;
+        const float* Values = Data->Values + BlockStart * BlockM;
+        const size_t CountM = std::min(M - rb * BlockM, BlockM);
+
+        const float* B = Data->B + RangeStartN;
+        float* C = Data->C + rb * BlockM * ldc + RangeStartN;
+        size_t CountN = RangeCountN;
+
+        while (CountN >= StripN) {
+            MlasSparseCsrGemmKernel<BlockM, StripVectorCount>(ColumnIndices, Values, BlockCount, B, ldb,
+                                                              C, ldc, CountM, alpha);
+            B += StripN;
+            C += StripN;
+            CountN -= StripN;
+        }
+
+        while (CountN >= 4) {
+            MlasSparseCsrGemmKernel<BlockM, 1>(ColumnIndices, Values, BlockCount, B, ldb, C, ldc, CountM, alpha);
+            B += 4;
+            C += 4;
+            CountN -= 4;
+        }
+
+        if (CountN > 0) {
+            MlasSparseCsrGemmRemainderKernel<BlockM>(ColumnIndices, Values, BlockCount, B, ldb, C, ldc,
+                                                     CountM, CountN, alpha);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparseCsrGemm(
+    size_t M,
+    size_t N,
+    size_t BlockM,
+    const MLAS_SPARSE_CSR_GEMM_DATA_PARAMS* Data,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = alpha * A * B with a sparse matrix A in the blocked CSR
+    format and a dense matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    BlockM - Supplies the number of rows of a row block of matrix A, 1, 2 or
+        4.
+
+    Data - Supplies the matrices data parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSparseCsrGemmIsBlockSupported(BlockM)) {
+        MLAS_THROW_EX(std::invalid_argument, "The row block size of the sparse matrix must be 1, 2 or 4.");
+    }
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    const size_t RowBlockCount = MlasSparseCsrGemmRowBlockCount(M, BlockM);
+    const size_t BlockCount = size_t(Data->RowOffsets[RowBlockCount]);
+
+    //
+    // The complexity only counts the stored values of matrix A.
+    //
+
+    const double Complexity = double(std::max<size_t>(BlockCount, 1)) * double(BlockM) * double(N);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // The row blocks are partitioned by their count of stored columns, as the
+    // rows of a sparse matrix can be very unevenly filled. The columns are
+    // only split when there are threads left over for each partition.
+    //
+
+    const size_t BlockCountN = (N + MLAS_SPARSE_CSR_UNITN - 1) / MLAS_SPARSE_CSR_UNITN;
+    const size_t PartitionCountN = std::min(BlockCountN, size_t(TargetThreadCount));
+    const size_t PartitionCountM =
+        std::min(RowBlockCount, (size_t(TargetThreadCount) + PartitionCountN - 1) / PartitionCountN);
+    const size_t TotalUnits = PartitionCountM * PartitionCountN;
+
+    if (size_t(TargetThreadCount) > TotalUnits) {
+        TargetThreadCount = ptrdiff_t(TotalUnits);
+    }
+
+    auto PartitionStartM = [&](size_t Partition) -> size_t {
+        if (Partition == 0) {
+            return 0;
+        }
+        if (Partition >= PartitionCountM) {
+            return RowBlockCount;
+        }
+        const int64_t TargetOffset = int64_t(BlockCount * Partition / PartitionCountM);
+        return size_t(std::lower_bound(Data->RowOffsets, Data->RowOffsets + RowBlockCount, TargetOffset) -
+                      Data->RowOffsets);
+    };
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, TargetThreadCount, TotalUnits, &WorkIndex, &WorkRemaining);
+
+        for (; WorkRemaining > 0; WorkIndex++, WorkRemaining--) {
+
+            const size_t PartitionM = WorkIndex / PartitionCountN;
+            const size_t PartitionN = WorkIndex % PartitionCountN;
+
+            const size_t RowBlockStart = PartitionStartM(PartitionM);
+            const size_t RowBlockEnd = PartitionStartM(PartitionM + 1);
+
+            //
+            // The columns are split in units of MLAS_SPARSE_CSR_UNITN so the
+            // strips stay aligned to the vectors of matrix B.
+            //
+
+            const size_t UnitStartN = BlockCountN * PartitionN / PartitionCountN;
+            const size_t UnitEndN = BlockCountN * (PartitionN + 1) / PartitionCountN;
+            const size_t RangeStartN = UnitStartN * MLAS_SPARSE_CSR_UNITN;
+            const size_t RangeCountN = std::min(N, UnitEndN * MLAS_SPARSE_CSR_UNITN) - RangeStartN;
+
+            switch (BlockM) {
+                case 1:
+                    MlasSparseCsrGemmOperation<1>(M, RowBlockStart, RowBlockEnd, RangeStartN, RangeCountN, Data);
+                    break;
+                case 2:
+                    MlasSparseCsrGemmOperation<2>(M, RowBlockStart, RowBlockEnd, RangeStartN, RangeCountN, Data);
+                    break;
+                default:
+                    MlasSparseCsrGemmOperation<4>(M, RowBlockStart, RowBlockEnd, RangeStartN, RangeCountN, Data);
+                    break;
+            }
+        }
+    });
+}
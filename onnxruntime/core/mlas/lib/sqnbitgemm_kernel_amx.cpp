@@ -0,0 +1,206 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the AMX-INT8 kernel of the n-bit quantized
+    integer matrix multiplication with int8 activations (SQNBIT_CompInt8).
+
+    The kernel reads the quantized B data packed for the avx512vnni kernels
+    with a sub block length of 128, in which a byte of a sub block holds the
+    4-bit values v[i] and v[i + 64]. Sixteen columns of B are unpacked into
+    int8 values laid out as the B operand of TDPBSSD, so that a row of the
+    panel holds the 16 columns of four consecutive values of K:
+
+        B[k..k+3][0] B[k..k+3][1] ... B[k..k+3][15]
+
+    The products of a block are accumulated in int32 in a tile and scaled
+    into single precision accumulators once per block. The zero points are
+    applied by the caller through the block sums.
+
+--*/
+
+#include "qnbitgemm.h"
+#include "amx_common.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+
+#include <immintrin.h>
+
+#if defined(MLAS_TARGET_AMD64)
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+
+namespace
+{
+
+constexpr size_t SubBlkLen = 128;  // length of a packed sub block of B
+constexpr size_t TileK = 64;       // # of int8 values in a row of the A tile
+constexpr size_t TileN = 16;       // # of columns of the B panel
+
+//
+// Unpacks CountN (at most 16) columns of the quantized B data to int8 values
+// in the TDPBSSD layout and gathers the matching scales.
+//
+void
+MlasQ4Int8AmxUnpackB(
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    int8_t* PanelB,
+    float* PanelScale,
+    size_t N,
+    size_t n,
+    size_t CountN,
+    size_t BlkLen,
+    size_t BlockCountK
+    )
+{
+    const size_t SubBlkCountK = BlockCountK * BlkLen / SubBlkLen;
+    const __m512i RowIndex = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(int(TileN * 4))
+    );
+    const __m512i LowMask = _mm512_set1_epi8(0x0F);
+
+    if (CountN < TileN) {
+        std::fill_n(PanelB, SubBlkCountK * SubBlkLen * TileN, int8_t(0));
+        std::fill_n(PanelScale, BlockCountK * TileN, 0.0f);
+    }
+
+    for (size_t nn = 0; nn < CountN; nn++) {
+        for (size_t k_subblk = 0; k_subblk < SubBlkCountK; k_subblk++) {
+            const size_t Offset = GetContinueLayoutOffsetSubBlk(N, n + nn, SubBlkCountK, k_subblk);
+            const __m512i Bytes = _mm512_loadu_si512(QuantBData + Offset * (SubBlkLen / 2));
+            const __m512i Low = _mm512_and_si512(Bytes, LowMask);
+            const __m512i High = _mm512_and_si512(_mm512_srli_epi16(Bytes, 4), LowMask);
+
+            int8_t* Panel = PanelB + k_subblk * SubBlkLen * TileN + nn * 4;
+            _mm512_i32scatter_epi32(Panel, RowIndex, Low, 1);
+            _mm512_i32scatter_epi32(Panel + TileK * TileN, RowIndex, High, 1);
+        }
+
+        for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+            const size_t Offset = GetContinueLayoutOffsetSubBlk(N, n + nn, BlockCountK, k_blk);
+            PanelScale[k_blk * TileN + nn] = QuantBScale[Offset];
+        }
+    }
+}
+
+}  // namespace
+
+void
+MlasQ4Int8GemmKernelAmx(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine computes CountM rows of the output, without the block sum
+    terms, with AMX-INT8 tiles.
+
+Arguments:
+
+    BlkLen - Supplies the block length, a multiple of 128.
+
+    QuantA - Supplies the int8 quantized A, CountM x BlockCountK x BlkLen.
+
+    QuantAScale - Supplies the scales of A, CountM x BlockCountK.
+
+    QuantBData - Supplies the packed quantized B data.
+
+    QuantBScale - Supplies the packed scales of B.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the number of rows of A and C, a multiple of 16.
+
+    CountN - Supplies the number of columns of B and C.
+
+    BlockCountK - Supplies the number of blocks along the K dimension.
+
+    Bias - Supplies the optional bias vector.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    assert(BlkLen % SubBlkLen == 0);
+    assert(CountM % 16 == 0);
+
+    const size_t lda = BlockCountK * BlkLen;
+
+    MlasThreadedBufAlloc(lda * TileN + BlockCountK * TileN * sizeof(float));
+    int8_t* PanelB = reinterpret_cast<int8_t*>(ThreadedBufHolder.get());
+    float* PanelScale = reinterpret_cast<float*>(PanelB + lda * TileN);
+
+    MLAS_DECLSPEC_ALIGN(int32_t Tile[16 * TileN], 64);
+    static const int32_t ZeroTile[16 * TileN] = {0};
+
+    MlasAmxLoadTileConfig();
+
+    for (size_t n = 0; n < CountN; n += TileN) {
+        const size_t CountTileN = std::min(CountN - n, TileN);
+        const __mmask16 MaskN = __mmask16((1u << CountTileN) - 1);
+
+        MlasQ4Int8AmxUnpackB(QuantBData, QuantBScale, PanelB, PanelScale, CountN, n, CountTileN, BlkLen, BlockCountK);
+
+        const __m512 BiasVector = (Bias != nullptr) ? _mm512_maskz_loadu_ps(MaskN, Bias + n) : _mm512_setzero_ps();
+
+        for (size_t m = 0; m < CountM; m += 16) {
+            const std::byte* a = QuantA + m * lda;
+            const float* a_scale = QuantAScale + m * BlockCountK;
+
+            __m512 Accumulators[16];
+            for (size_t r = 0; r < 16; r++) {
+                Accumulators[r] = BiasVector;
+            }
+
+            for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+                tile_loadd(TMM0, ZeroTile, TileN * sizeof(int32_t));
+                for (size_t kk = 0; kk < BlkLen; kk += TileK) {
+                    const size_t k = k_blk * BlkLen + kk;
+                    tile_loadd(TMM1, a + k, lda);
+                    tile_loadd(TMM2, PanelB + k * TileN, TileN * 4);
+                    tile_dpbssd(TMM0, TMM1, TMM2);
+                }
+                tile_stored(TMM0, Tile, TileN * sizeof(int32_t));
+
+                const __m512 ScaleB = _mm512_load_ps(PanelScale + k_blk * TileN);
+                for (size_t r = 0; r < 16; r++) {
+                    const __m512 Scale = _mm512_mul_ps(ScaleB, _mm512_set1_ps(a_scale[r * BlockCountK + k_blk]));
+                    const __m512 Sum = _mm512_cvtepi32_ps(_mm512_load_si512(Tile + r * TileN));
+                    Accumulators[r] = _mm512_fmadd_ps(Sum, Scale, Accumulators[r]);
+                }
+            }
+
+            for (size_t r = 0; r < 16; r++) {
+                _mm512_mask_storeu_ps(C + (m + r) * ldc + n, MaskN, Accumulators[r]);
+            }
+        }
+    }
+}
+
+#endif  // defined(MLAS_TARGET_AMD64)
@@ -299,6 +299,85 @@ SQ4BitGemmKernel_BlkSum_CompInt8_avx512vnni(
     return CountM;
 }
 
+//
+// The AMX-INT8 kernel handles the groups of 16 rows of A for block lengths of
+// 128 or more, which share the sub block layout of B with the avx512vnni
+// kernel. Other shapes and the remaining rows use the avx512vnni kernel.
+//
+size_t
+SQ4BitGemmKernel_BlkSum_CompInt8_amx(
+    const size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias,
+    size_t ldc,
+    const float* ABlockSum,
+    const float* QuantBBlkSum
+)
+{
+    size_t AmxCountM = (BlkLen >= 128) ? (CountM & ~size_t{15}) : 0;
+
+    if (AmxCountM > 0) {
+        MlasQ4Int8GemmKernelAmx(
+            BlkLen,
+            QuantA,
+            QuantAScale,
+            QuantBData,
+            QuantBScale,
+            C,
+            AmxCountM,
+            CountN,
+            BlockCountK,
+            Bias,
+            ldc
+        );
+
+        float* c_blk = C;
+        const float* a_blksum_row = ABlockSum;
+        size_t RowsRemaining = AmxCountM;
+        while (RowsRemaining > 0) {
+            auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
+                a_blksum_row, QuantBBlkSum, c_blk, BlockCountK, RowsRemaining, CountN, BlockCountK, ldc, 1.f, false
+            );
+
+            c_blk += ldc * RowsHandled;
+            a_blksum_row += BlockCountK * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
+    }
+
+    if (AmxCountM < CountM) {
+        const size_t lda = BlockCountK * BlkLen;
+        SQ4BitGemmKernel_BlkSum_CompInt8_avx512vnni(
+            BlkLen,
+            QuantA + AmxCountM * lda,
+            QuantAScale + AmxCountM * BlockCountK,
+            QuantBData,
+            QuantBScale,
+            QuantBZeroPoint,
+            C + AmxCountM * ldc,
+            CountM - AmxCountM,
+            CountN,
+            CountK,
+            BlockCountK,
+            Bias,
+            ldc,
+            ABlockSum + AmxCountM * BlockCountK,
+            QuantBBlkSum
+        );
+    }
+
+    return CountM;
+}
+
 void MLASCALL
 QuantizeARow_CompInt8_avx512(
     size_t BlkLen,
@@ -356,3 +435,22 @@ const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni = []() {
 
     return d;
 }();
+
+const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx = []() {
+    MLAS_QNBIT_GEMM_DISPATCH d;
+
+    d.Q4BitGemmPackQuantBDataSize = Q4BitGemmPackQuantBDataSize;
+    d.SQ4BitGemmPackQuantBData = SQ4BitGemmPackQuantBData;
+    d.SQ4BitGemmPackQuantBDataAndBlkSum = SQ4BitGemmPackQuantBDataAndBlkSum512vnni;
+
+    d.Q4BitGemmPerGemmWorkspaceSize = Q4BitGemmPerGemmWorkspaceSize;
+    d.Q4BitGemmPerGemmWorkspaceAlignment = Q4BitGemmPerGemmWorkspaceAlignment;
+
+    d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32;
+    d.SQ4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
+
+    d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_amx;
+    d.QuantizeARowComputeBlkSum_CompInt8 = QuantizeARow_CompInt8_avx512;
+
+    return d;
+}();
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/broadcast_elimination.h"
+
+#include "core/common/logging/logging.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Elementwise operators that broadcast all their inputs to the shape of the output (multidirectional broadcasting).
+bool IsBroadcastingConsumer(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Pow", {7, 12, 13, 15}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Equal", {7, 11, 13, 19}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Less", {7, 9, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Greater", {7, 9, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "LessOrEqual", {12, 16}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "GreaterOrEqual", {12, 16}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "And", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Or", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Xor", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Where", {9, 16}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Max", {8, 12, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Min", {8, 12, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {8, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mean", {8, 13});
+}
+
+bool DimsAreEqual(const ONNX_NAMESPACE::TensorShapeProto_Dimension& a,
+                  const ONNX_NAMESPACE::TensorShapeProto_Dimension& b) {
+  return (utils::HasDimValue(a) && utils::HasDimValue(b) && a.dim_value() == b.dim_value()) ||
+         (utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param());
+}
+
+// Whether the output of consumer keeps its shape when it reads replacement instead of removed, i.e. every dim of the
+// output that is not 1 is also found at the same position in one of the inputs.
+bool OutputShapeIsKept(const Node& consumer, const NodeArg& removed, const NodeArg& replacement) {
+  const auto* output_shape = consumer.OutputDefs()[0]->Shape();
+  if (output_shape == nullptr) {
+    return false;
+  }
+
+  const int rank = output_shape->dim_size();
+  InlinedVector<const ONNX_NAMESPACE::TensorShapeProto*> input_shapes;
+  bool rank_is_kept = false;
+  for (const NodeArg* input : consumer.InputDefs()) {
+    const auto* shape = input->Name() == removed.Name() ? replacement.Shape() : input->Shape();
+    if (shape == nullptr || shape->dim_size() > rank) {
+      return false;
+    }
+    rank_is_kept = rank_is_kept || shape->dim_size() == rank;
+    input_shapes.push_back(shape);
+  }
+
+  if (!rank_is_kept) {
+    return false;
+  }
+
+  for (int i = 0; i < rank; ++i) {
+    const auto& dim = output_shape->dim(i);
+    if (utils::HasDimValue(dim) && dim.dim_value() == 1) {
+      continue;
+    }
+
+    bool is_covered = false;
+    for (const auto* shape : input_shapes) {
+      const int offset = rank - shape->dim_size();
+      if (i >= offset && DimsAreEqual(shape->dim(i - offset), dim)) {
+        is_covered = true;
+        break;
+      }
+    }
+    if (!is_covered) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Expand(X, Shape(Y)) broadcasts X to the shape of Y, which a consumer that also reads Y does anyway.
+// This holds without knowing the shapes, which are often dynamic in attention mask subgraphs.
+bool ExpandsToShapeOfSibling(const Node& expand, const Node& consumer) {
+  const Node* shape_node = graph_utils::GetInputNode(expand, 1);
+  if (shape_node == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*shape_node, "Shape", {1, 13, 15, 19, 21})) {
+    return false;
+  }
+
+  // since opset 15 Shape may only produce a slice of the shape
+  const auto& attributes = shape_node->GetAttributes();
+  const auto start = attributes.find("start");
+  if (attributes.find("end") != attributes.end() || (start != attributes.end() && start->second.i() != 0)) {
+    return false;
+  }
+
+  const std::string& source_name = shape_node->InputDefs()[0]->Name();
+  for (const NodeArg* input : consumer.InputDefs()) {
+    if (input->Name() == source_name) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Tile only repeats dims of size 1, so that it is an Expand.
+bool TileIsExpand(const Graph& graph, const Node& tile) {
+  const auto* input_shape = tile.InputDefs()[0]->Shape();
+  const ONNX_NAMESPACE::TensorProto* repeats_proto = graph_utils::GetConstantInitializer(graph,
+                                                                                          tile.InputDefs()[1]->Name());
+  if (input_shape == nullptr || repeats_proto == nullptr || repeats_proto->dims_size() != 1 ||
+      repeats_proto->dims(0) != input_shape->dim_size()) {
+    return false;
+  }
+
+  Initializer repeats{*repeats_proto, graph.ModelPath()};
+  if (repeats.data_type() != ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+    return false;
+  }
+
+  const int64_t* repeats_data = repeats.data<int64_t>();
+  for (int i = 0; i < input_shape->dim_size(); ++i) {
+    const auto& dim = input_shape->dim(i);
+    if (repeats_data[i] != 1 && !(utils::HasDimValue(dim) && dim.dim_value() == 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status BroadcastElimination::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                   const logging::Logger&) const {
+  NodeArg& input = *node.MutableInputDefs()[0];
+  const Node::EdgeEnd* input_edge = graph_utils::GetInputEdge(node, 0);
+  const NodeIndex producer_index = input_edge != nullptr ? input_edge->GetNode().Index() : 0;
+  const int producer_output_index = input_edge != nullptr ? input_edge->GetSrcArgIndex() : -1;
+
+  // The consumers read the input of the node instead of its output.
+  const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  for (const auto& output_edge : output_edges) {
+    Node& consumer = *graph.GetNode(output_edge.dst_node);
+    graph_utils::ReplaceNodeInput(consumer, output_edge.dst_arg_index, input);
+    if (input_edge != nullptr) {
+      graph.AddEdge(producer_index, output_edge.dst_node, producer_output_index, output_edge.dst_arg_index);
+    }
+  }
+
+  graph.RemoveNode(node.Index());
+  rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+
+  return Status::OK();
+}
+
+bool BroadcastElimination::SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger&) const {
+  const bool is_expand = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Expand", {8, 13});
+  if (!is_expand && !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tile", {6, 13})) {
+    return false;
+  }
+
+  if (node.GetOutputEdgesCount() == 0 || graph.NodeProducesGraphOutput(node)) {
+    return false;
+  }
+
+  if (!is_expand && !TileIsExpand(graph, node)) {
+    return false;
+  }
+
+  const NodeArg& input = *node.InputDefs()[0];
+  const NodeArg& output = *node.OutputDefs()[0];
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    const Node& consumer = *it;
+    if (!IsBroadcastingConsumer(consumer) || consumer.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      return false;
+    }
+    if (!(is_expand && ExpandsToShapeOfSibling(node, consumer)) && !OutputShapeIsKept(consumer, output, input)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace onnxruntime
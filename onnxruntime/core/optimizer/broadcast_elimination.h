@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+
+/**
+@Class BroadcastElimination
+
+Rewrite rule that eliminates Expand nodes, and Tile nodes that only repeat dims of size 1, when all their consumers
+are broadcasting elementwise nodes (e.g. Add or Where) that broadcast their input to the same shape anyway.
+The consumers then read the smaller input directly, e.g. an attention mask of shape [B, 1, 1, S] expanded to
+[B, H, S, S] before it is added to the attention scores is never materialized.
+
+It is attempted to be triggered only on nodes with op type "Expand" or "Tile".
+*/
+class BroadcastElimination : public RewriteRule {
+ public:
+  BroadcastElimination() noexcept : RewriteRule("BroadcastElimination") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Expand", "Tile"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
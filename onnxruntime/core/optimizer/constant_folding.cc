@@ -1,9 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <limits>
 
 #include "core/optimizer/constant_folding.h"
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
@@ -11,6 +15,7 @@
 #include "core/optimizer/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 using namespace onnxruntime::common;
 
@@ -20,8 +25,9 @@ ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const ConfigOptions& config_options,
                                  const InlinedHashSet<std::string_view>& compatible_execution_providers,
-                                 const InlinedHashSet<std::string>& excluded_initializers) noexcept
-    : ConstantFolding("ConstantFolding", execution_provider, skip_dequantize_linear, config_options, compatible_execution_providers, excluded_initializers) {
+                                 const InlinedHashSet<std::string>& excluded_initializers,
+                                 concurrency::ThreadPool* thread_pool) noexcept
+    : ConstantFolding("ConstantFolding", execution_provider, skip_dequantize_linear, config_options, compatible_execution_providers, excluded_initializers, thread_pool) {
 }
 
 ConstantFolding::ConstantFolding(const std::string& name,
@@ -29,12 +35,14 @@ ConstantFolding::ConstantFolding(const std::string& name,
                                  bool skip_dequantize_linear,
                                  const ConfigOptions& config_options,
                                  const InlinedHashSet<std::string_view>& compatible_execution_providers,
-                                 const InlinedHashSet<std::string>& excluded_initializers) noexcept
+                                 const InlinedHashSet<std::string>& excluded_initializers,
+                                 concurrency::ThreadPool* thread_pool) noexcept
     : GraphTransformer(name, compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       config_options_(config_options),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      thread_pool_(thread_pool) {
 }
 
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
@@ -101,6 +109,33 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
+// Like Shape, Size only depends on the shape of its input, so it can be folded when that shape is fully known.
+// This lets a condition computed from the input shapes be folded, so the If node consuming it can be inlined.
+static bool ConstantFoldSizeNode(Graph& graph, Node& node) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  int64_t size = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    size *= dim.dim_value();
+  }
+
+  ONNX_NAMESPACE::TensorProto size_constant;
+  auto* constant_arg_out = node.MutableOutputDefs()[0];
+  size_constant.set_name(constant_arg_out->Name());
+  size_constant.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  utils::SetRawDataInTensorProto(size_constant, &size, sizeof(int64_t));
+  constant_arg_out->SetShape(ONNX_NAMESPACE::TensorShapeProto());
+  graph.AddInitializedTensor(size_constant);
+
+  return true;
+}
+
 // This function inlines the appropriate subgraph. It does not literally fold it.
 static Status ConstantFoldIfNode(Graph& graph, Node& if_node, const logging::Logger& logger, bool& folded) {
   folded = false;
@@ -140,23 +175,213 @@ static Status ConstantFoldIfNode(Graph& graph, Node& if_node, const logging::Log
   return status;
 }
 
+namespace {
+// A node with constant inputs whose kernel is computed with the other nodes of its batch.
+struct FoldableNode {
+  Node* node = nullptr;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  std::vector<int> fetch_mlvalue_idxs;
+  std::vector<OrtValue> fetches;
+  Status status;
+};
+}  // namespace
+
+// The size of the outputs of the node that have a known shape, which is a lower bound of the size of its outputs.
+static size_t KnownOutputSizeInBytes(const Node& node) {
+  size_t size_in_bytes = 0;
+  for (const auto* output : node.OutputDefs()) {
+    const auto* type = output->TypeAsProto();
+    const auto* shape = output->Shape();
+    if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) ||
+        !utils::HasElemType(type->tensor_type()) ||
+        type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      continue;
+    }
+
+    const auto tensor_shape = utils::GetTensorShapeFromTensorShapeProto(*shape);
+    if (tensor_shape.Size() < 0) {
+      continue;
+    }
+    const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+    size_in_bytes += SafeInt<size_t>(tensor_shape.Size()) * element_type->Size();
+  }
+  return size_in_bytes;
+}
+
+// The size of the constant initializers that the node consumes.
+static size_t ConstantInputSizeInBytes(const Graph& graph, const Node& node) {
+  size_t size_in_bytes = 0;
+  for (const auto* input : node.InputDefs()) {
+    const auto* initializer = input->Exists() ? graph_utils::GetConstantInitializer(graph, input->Name()) : nullptr;
+    size_t initializer_size = 0;
+    if (initializer != nullptr && utils::GetSizeInBytesFromTensorProto<0>(*initializer, &initializer_size).IsOK()) {
+      size_in_bytes += initializer_size;
+    }
+  }
+  return size_in_bytes;
+}
+
+static Status ComputeFoldableNode(FoldableNode& foldable, const logging::Logger& logger) {
+  OptimizerExecutionFrame frame(*foldable.info, foldable.fetch_mlvalue_idxs);
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 6387)
+#endif
+  OpKernelContext op_kernel_context(&frame, foldable.kernel.get(), /*stream*/ nullptr, nullptr, logger);
+  // the kernels of a batch are computed on the thread pool so exceptions are converted here
+  Status status;
+  ORT_TRY {
+    status = foldable.kernel->Compute(&op_kernel_context);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Constant folding of node '", foldable.node->Name(),
+                               "' failed: ", ex.what());
+    });
+  }
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  ORT_RETURN_IF_ERROR(status);
+
+  return frame.GetOutputs(foldable.fetches);
+}
+
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   bool have_updated_nodes = false;
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
+  size_t max_output_size_in_bytes = 0;
+  const std::string max_output_size_str =
+      config_options_.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingMaxOutputSize, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_output_size_str, max_output_size_in_bytes),
+                    "Invalid value for ", kOrtSessionOptionsConstantFoldingMaxOutputSize, ": ", max_output_size_str);
+
+  // Unless optimizing for speed only, nodes whose outputs are larger than their inputs, e.g. an Expand, are not folded
+  // as their outputs are computed at run time in memory that is released after use instead of kept as initializers.
+  const bool skip_growing_nodes =
+      optimizer_utils::GetOptimizationObjective(config_options_) != optimizer_utils::OptimizationObjective::kSpeed;
+
+  // the execution frames of the batch refer to it
 #if !defined(DISABLE_SPARSE_TENSORS)
   std::function<bool(const std::string&)> is_sparse_initializer_check = [&graph](const std::string& name) -> bool {
     return graph.IsSparseInitializer(name);
   };
+#else
+  std::function<bool(const std::string&)> is_sparse_initializer_check = [](const std::string&) { return false; };
 #endif
 
+  // Remove the node converted to constant initializers, and the single-output node chain of its inputs.
+  auto remove_converted_node = [&graph, &modified, &have_updated_nodes](Node& node) {
+    auto p_ip_node = node.InputNodesBegin();
+    const auto p_ip_node_end = node.InputNodesEnd();
+    while (p_ip_node != p_ip_node_end) {
+      const auto& input_node = *p_ip_node;
+      // Update the node iterator before removing the corresponding node because removing
+      // the node will invalidate the node iterator
+      ++p_ip_node;
+      graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
+    }
+
+    // Remove the output edges of the constant node and then remove the node itself.
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+    modified = true;
+    have_updated_nodes = true;
+  };
+
+  // Substitute the output node args with the computed tensors, which are added to the graph as initializers.
+  auto convert_to_constant = [&graph, &logger, max_output_size_in_bytes, skip_growing_nodes](
+                                 Node& node, std::vector<OrtValue>& fetches) {
+    ORT_ENFORCE(fetches.size() == node.OutputDefs().size());
+    size_t output_size_in_bytes = 0;
+    for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+      const auto& constant_arg_out = *node.OutputDefs()[fetch_idx];
+      // XXX: Add support for SparseTensors outputs when we have sparse outputs
+      if (!utils::HasTensorType(*constant_arg_out.TypeAsProto())) {
+        LOGS(logger, INFO) << "Unsupported output type of " << constant_arg_out.Type()
+                           << ". Can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
+        return false;
+      }
+      output_size_in_bytes += fetches[fetch_idx].Get<Tensor>().SizeInBytes();
+    }
+
+    if (max_output_size_in_bytes != 0 && output_size_in_bytes > max_output_size_in_bytes) {
+      LOGS(logger, INFO) << "Not constant folding " << node.OpType() << " node '" << node.Name() << "' as its "
+                         << output_size_in_bytes << " bytes of outputs exceed the maximum of "
+                         << max_output_size_in_bytes;
+      return false;
+    }
+
+    if (skip_growing_nodes && output_size_in_bytes > ConstantInputSizeInBytes(graph, node)) {
+      LOGS(logger, INFO) << "Not constant folding " << node.OpType() << " node '" << node.Name() << "' as its "
+                         << output_size_in_bytes << " bytes of outputs are larger than its inputs";
+      return false;
+    }
+
+    for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+      OrtValue& ort_value = fetches[fetch_idx];
+      // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
+      auto* constant_arg_out = node.MutableOutputDefs()[fetch_idx];
+      const Tensor& out_tensor = ort_value.Get<Tensor>();
+      ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+
+      ONNX_NAMESPACE::TensorShapeProto result_shape;
+      for (auto& dim : out_tensor.Shape().GetDims()) {
+        result_shape.add_dim()->set_dim_value(dim);
+      }
+
+      constant_arg_out->SetShape(result_shape);
+      graph.AddInitializedTensor(out_tensorproto);
+    }
+    return true;
+  };
+
+  // The nodes with constant inputs are batched as they do not depend on each other, with up to one node per thread
+  // so that the memory used by the outputs of the batch stays bounded. The batch is completed before a node
+  // consuming one of its outputs is processed.
+  std::vector<FoldableNode> batch;
+  InlinedHashSet<NodeIndex> batch_node_indices;
+  const size_t max_batch_size =
+      static_cast<size_t>(std::max(1, concurrency::ThreadPool::DegreeOfParallelism(thread_pool_)));
+
+  auto complete_batch = [&]() -> Status {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(batch.size()),
+        [&batch, &logger](std::ptrdiff_t i) { batch[i].status = ComputeFoldableNode(batch[i], logger); });
+
+    // the graph is updated in the order of the nodes so that the result does not depend on the thread pool
+    for (auto& foldable : batch) {
+      ORT_RETURN_IF_ERROR(foldable.status);
+      if (convert_to_constant(*foldable.node, foldable.fetches)) {
+        remove_converted_node(*foldable.node);
+      }
+    }
+
+    batch.clear();
+    batch_node_indices.clear();
+    return Status::OK();
+  };
+
+  auto consumes_batch_output = [&batch_node_indices](const Node& node) {
+    return std::any_of(node.InputNodesBegin(), node.InputNodesEnd(), [&batch_node_indices](const Node& input_node) {
+      return batch_node_indices.count(input_node.Index()) != 0;
+    });
+  };
+
   for (NodeIndex i : order) {
     auto* node = graph.GetNode(i);
     if (!node || !AllowConstantFolding(*node)) {
       continue;
     }
 
+    // control flow nodes may also read the outputs of the batch in their subgraphs
+    if (!batch.empty() && (node->ContainsSubgraph() || consumes_batch_output(*node))) {
+      ORT_RETURN_IF_ERROR(complete_batch());
+    }
+
     ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
 
     // Updating a node may allow shape inferencing to infer output shapes of following nodes,
@@ -183,6 +408,8 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       }
     } else if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
+    } else if (node->OpType().compare("Size") == 0 && ConstantFoldSizeNode(graph, *node)) {
+      converted_to_constant = true;
     } else {
       InitializedTensorSet constant_inputs;
 
@@ -233,26 +460,33 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
-#if !defined(DISABLE_SPARSE_TENSORS)
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
-                                         is_sparse_initializer_check, logger);
-#else
+      // avoid computing outputs that are known to exceed the maximum size
+      if (max_output_size_in_bytes != 0 && KnownOutputSizeInBytes(*node) > max_output_size_in_bytes) {
+        LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                           << "' as its outputs exceed the maximum size of " << max_output_size_in_bytes << " bytes";
+        continue;
+      }
+      if (skip_growing_nodes && KnownOutputSizeInBytes(*node) > ConstantInputSizeInBytes(graph, *node)) {
+        LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                           << "' as its outputs are larger than its inputs";
+        continue;
+      }
+
+      FoldableNode foldable;
+      foldable.node = node;
+
       // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info(
-          {node}, constant_inputs, graph.ModelPath(), execution_provider_, [](const std::string&) { return false; },
-          logger);
-#endif
+      foldable.info = std::make_unique<OptimizerExecutionFrame::Info>(
+          std::vector<const Node*>{node}, constant_inputs, graph.ModelPath(), execution_provider_,
+          is_sparse_initializer_check, logger);
+      const auto& info = *foldable.info;
 
-      std::vector<int> fetch_mlvalue_idxs;
       for (const auto* node_out : node->OutputDefs()) {
-        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+        foldable.fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
       }
 
       const bool node_on_cpu_ep = node->GetExecutionProviderType() == kCpuExecutionProvider;
 
-      std::unique_ptr<const OpKernel> kernel;
-
       if (!node_on_cpu_ep) {
         // We need to copy the string here instead of taking a reference to it since node->SetExecutionProviderType
         // will change the value of the reference
@@ -261,12 +495,12 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         // override the EP assigned to the node so that it will use the CPU kernel for Compute.
         node->SetExecutionProviderType(kCpuExecutionProvider);
 
-        kernel = info.CreateKernel(node, config_options_);
+        foldable.kernel = info.CreateKernel(node, config_options_);
 
         // undo the EP change to the value that was assigned at graph partitioning time
         node->SetExecutionProviderType(ep_type);
       } else {
-        kernel = info.CreateKernel(node, config_options_);
+        foldable.kernel = info.CreateKernel(node, config_options_);
       }
 
       // We currently constant fold using the CPU EP only.
@@ -274,7 +508,7 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       //
       // TODO(adrianlizarraga): Support constant folding with other execution providers. For example, we may be able
       // to use a CUDA kernel to constant fold operators with data types not supported by the CPU EP kernel.
-      if (kernel == nullptr) {
+      if (foldable.kernel == nullptr) {
         LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
                               << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
 
@@ -282,74 +516,22 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
-      OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
-#ifdef _WIN32
-#pragma warning(push)
-#pragma warning(disable : 6387)
-#endif
-      OpKernelContext op_kernel_context(&frame, kernel.get(), /*stream*/ nullptr, nullptr, logger);
-      ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
-#ifdef _WIN32
-#pragma warning(pop)
-#endif
-
-      std::vector<OrtValue> fetches;
-      ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
-
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
-      ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-        const auto& constant_arg_out = *node->OutputDefs()[fetch_idx];
-        // XXX: Add support for SparseTensors outputs when we have sparse outputs
-        if (!utils::HasTensorType(*constant_arg_out.TypeAsProto())) {
-          LOGS(logger, INFO) << "Unsupported output type of " << constant_arg_out.Type()
-                             << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
-          break;
-        }
-      }
-
-      if (converted_to_constant) {
-        for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-          OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-          auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
-
-          ONNX_NAMESPACE::TensorShapeProto result_shape;
-          for (auto& dim : out_tensor.Shape().GetDims()) {
-            result_shape.add_dim()->set_dim_value(dim);
-          }
-
-          constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
-        }
+      batch_node_indices.insert(node->Index());
+      batch.push_back(std::move(foldable));
+      if (batch.size() >= max_batch_size) {
+        ORT_RETURN_IF_ERROR(complete_batch());
       }
     }
 
     if (converted_to_constant) {
-      // Remove single-output node chain for inputs of the node
-      auto p_ip_node = node->InputNodesBegin();
-      const auto p_ip_node_end = node->InputNodesEnd();
-      while (p_ip_node != p_ip_node_end) {
-        const auto& input_node = *p_ip_node;
-        // Update the node iterator before removing the corresponding node because removing
-        // the node will invalidate the node iterator
-        ++p_ip_node;
-        graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
-      }
-
-      // Remove the output edges of the constant node and then remove the node itself.
-      graph_utils::RemoveNodeOutputEdges(graph, *node);
-      graph.RemoveNode(node->Index());
-      modified = true;
-      have_updated_nodes = true;
+      remove_converted_node(*node);
     }
   }
 
+  if (!batch.empty()) {
+    ORT_RETURN_IF_ERROR(complete_batch());
+  }
+
   return Status::OK();
 }
 }  // namespace onnxruntime
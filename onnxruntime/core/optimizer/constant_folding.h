@@ -7,6 +7,7 @@
 #include "core/framework/ort_value.h"
 #include <memory>
 #include "core/framework/execution_provider.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -15,18 +16,24 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+
+The nodes whose inputs are all constant initializers do not depend on each other, so their kernels are computed in
+parallel on the thread pool if one is provided. Nodes with outputs larger than the size set with
+kOrtSessionOptionsConstantFoldingMaxOutputSize are not folded.
 */
 class ConstantFolding : public GraphTransformer {
  public:
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param thread_pool Optional thread pool to compute the kernels of independent nodes in parallel.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const ConfigOptions& config_options,
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
-                  const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
+                  const InlinedHashSet<std::string>& excluded_initializers = {},
+                  concurrency::ThreadPool* thread_pool = nullptr) noexcept;
 
  protected:
   /**
@@ -37,7 +44,8 @@ class ConstantFolding : public GraphTransformer {
                   bool skip_dequantize_linear,
                   const ConfigOptions& config_options,
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
-                  const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
+                  const InlinedHashSet<std::string>& excluded_initializers = {},
+                  concurrency::ThreadPool* thread_pool = nullptr) noexcept;
   /**
    * Derived class can implement this virtual function to limit the nodes that can be constant folded.
    */
@@ -53,6 +61,7 @@ class ConstantFolding : public GraphTransformer {
   const ConfigOptions& config_options_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  concurrency::ThreadPool* const thread_pool_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFusableBinary(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+}
+
+bool IsFusableUnary(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13});
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() && type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Whether the values of arg can be repeated over the values of main_arg the way FusedElementwise broadcasts:
+// arg is a single value, or once its leading 1s are dropped its dims are the trailing dims of main_arg.
+bool BroadcastsTo(const NodeArg& arg, const NodeArg& main_arg) {
+  if (arg.Name() == main_arg.Name()) {
+    return true;
+  }
+
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  const auto* main_shape = main_arg.Shape();
+  const int rank = shape->dim_size();
+  int first = 0;
+  while (first < rank && utils::HasDimValue(shape->dim(first)) && shape->dim(first).dim_value() == 1) {
+    ++first;
+  }
+
+  if (first == rank) {
+    // broadcasting must not raise the rank of the output
+    return rank == 0 || (main_shape != nullptr && rank <= main_shape->dim_size());
+  }
+
+  if (main_shape == nullptr || rank > main_shape->dim_size()) {
+    return false;
+  }
+
+  const int offset = main_shape->dim_size() - rank;
+  for (int i = first; i < rank; ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& main_dim = main_shape->dim(offset + i);
+    const bool equal =
+        (utils::HasDimValue(dim) && utils::HasDimValue(main_dim) && dim.dim_value() == main_dim.dim_value()) ||
+        (utils::HasDimParam(dim) && utils::HasDimParam(main_dim) && dim.dim_param() == main_dim.dim_param());
+    if (!equal) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+/**
+Rewrite a chain of elementwise nodes whose intermediate values have a single consumer to a FusedElementwise node.
+The first input of the fused node is the input of the chain that has the shape of the output, the other inputs are
+the remaining operands of the chain. Step i of the fused node reads two values, where 0..N-1 are the N inputs and
+N+j is the result of step j.
+*/
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const bool is_binary = IsFusableBinary(node);
+    if ((!is_binary && !IsFusableUnary(node)) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // The output of the chain has the shape of its main input.
+    NodeArg* main_arg = node.MutableInputDefs()[0];
+    if (is_binary && !BroadcastsTo(*node.InputDefs()[1], *main_arg)) {
+      if (!BroadcastsTo(*main_arg, *node.InputDefs()[1])) {
+        continue;
+      }
+      main_arg = node.MutableInputDefs()[1];
+    }
+    if (!IsFloatTensor(*main_arg)) {
+      continue;
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse{node};
+    Node* current = &node;
+    while (current->GetOutputEdgesCount() == 1 && !graph.NodeProducesGraphOutput(*current)) {
+      Node& next = *graph.GetNode(current->OutputNodesBegin()->Index());
+      const bool next_is_binary = IsFusableBinary(next);
+      if ((!next_is_binary && !IsFusableUnary(next)) ||
+          next.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        break;
+      }
+      if (next_is_binary) {
+        const int chain_index = optimizer_utils::IndexOfNodeInput(next, *current->OutputDefs()[0]);
+        if (!BroadcastsTo(*next.InputDefs()[(chain_index + 1) % 2], *main_arg)) {
+          break;
+        }
+      }
+      nodes_to_fuse.emplace_back(next);
+      current = &next;
+    }
+
+    if (nodes_to_fuse.size() < 2) {
+      continue;
+    }
+
+    // Collect the inputs of the fused node, the main input first.
+    InlinedVector<NodeArg*> fused_inputs{main_arg};
+    auto input_index = [&fused_inputs](const NodeArg* arg) {
+      for (size_t i = 0; i < fused_inputs.size(); ++i) {
+        if (fused_inputs[i]->Name() == arg->Name()) {
+          return static_cast<int64_t>(i);
+        }
+      }
+      return int64_t{-1};
+    };
+    for (size_t i = 0; i < nodes_to_fuse.size(); ++i) {
+      Node& chain_node = nodes_to_fuse[i];
+      for (NodeArg* arg : chain_node.MutableInputDefs()) {
+        const bool is_previous_result = i > 0 && arg == nodes_to_fuse[i - 1].get().OutputDefs()[0];
+        if (!is_previous_result && input_index(arg) == -1) {
+          fused_inputs.push_back(arg);
+        }
+      }
+    }
+
+    const int64_t num_inputs = static_cast<int64_t>(fused_inputs.size());
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    ops.reserve(nodes_to_fuse.size());
+    operands.reserve(2 * nodes_to_fuse.size());
+    for (size_t i = 0; i < nodes_to_fuse.size(); ++i) {
+      Node& chain_node = nodes_to_fuse[i];
+      ops.push_back(chain_node.OpType());
+      for (const NodeArg* arg : chain_node.InputDefs()) {
+        const bool is_previous_result = i > 0 && arg == nodes_to_fuse[i - 1].get().OutputDefs()[0];
+        operands.push_back(is_previous_result ? num_inputs + static_cast<int64_t>(i) - 1 : input_index(arg));
+      }
+      if (chain_node.InputDefs().size() == 1) {
+        operands.push_back(-1);
+      }
+    }
+
+    Node& last_node = nodes_to_fuse.back();
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(last_node.Name() + "/ElementwiseChainFusion/"),
+                                     "FusedElementwise", "Fused elementwise chain", fused_inputs,
+                                     std::array{last_node.MutableOutputDefs()[0]}, {}, kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // FinalizeNodeFusion only moves the input edges of the first node, the operands the later nodes get from other
+    // nodes are wired here.
+    for (size_t i = 1; i < nodes_to_fuse.size(); ++i) {
+      const Node& chain_node = nodes_to_fuse[i];
+      for (auto edge = chain_node.InputEdgesBegin(); edge != chain_node.InputEdgesEnd(); ++edge) {
+        if (edge->GetNode().Index() == nodes_to_fuse[i - 1].get().Index()) {
+          continue;
+        }
+        const NodeArg* arg = chain_node.InputDefs()[edge->GetDstArgIndex()];
+        graph.AddEdge(edge->GetNode().Index(), fused_node.Index(), edge->GetSrcArgIndex(),
+                      static_cast<int>(input_index(arg)));
+      }
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite chains of float elementwise operators, e.g. Mul -> Add -> Sigmoid -> Mul, to a FusedElementwise
+ * node, so that the chain is evaluated tile by tile instead of materializing every intermediate tensor.
+ * Only the values of the first node of the chain may have the full shape, the other operands must be scalars or
+ * broadcast along the leading dims, and every intermediate value must have a single consumer.
+ */
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
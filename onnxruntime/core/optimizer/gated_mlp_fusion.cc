@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gated_mlp_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsMatMul(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13});
+}
+
+bool IsGelu(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain)) {
+    return true;
+  }
+
+  const auto* approximate = graph_utils::GetNodeAttribute(node, "approximate");
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {20}) &&
+         (approximate == nullptr || approximate->s() == "none");
+}
+
+// The constant float weight with 2 dimensions of a MatMul node.
+const TensorProto* GetWeight(const Graph& graph, const Node& matmul) {
+  const TensorProto* weight = graph_utils::GetConstantInitializer(graph, matmul.InputDefs()[1]->Name());
+  if (weight == nullptr || weight->data_type() != TensorProto_DataType_FLOAT || weight->dims_size() != 2) {
+    return nullptr;
+  }
+  return weight;
+}
+
+// Whether the node only feeds the given number of nodes, which may then be removed with it.
+bool HasOnlyInternalConsumers(const Graph& graph, const Node& node, size_t consumer_count) {
+  return node.GetOutputEdgesCount() == consumer_count && !graph.NodeProducesGraphOutput(node);
+}
+
+// The node that produces the input_index input of node, if there is one.
+Node* GetInputNode(Graph& graph, const Node& node, size_t input_index) {
+  const auto input_defs = node.InputDefs();
+  return input_index < input_defs.size() ? graph.GetMutableProducerNode(input_defs[input_index]->Name()) : nullptr;
+}
+
+struct GatedMLPMatch {
+  Node* gate;
+  Node* sigmoid;  // nullptr for Gelu
+  Node* activation;
+  Node* up;
+};
+
+// Match activation(MatMul(X, W_gate)) and MatMul(X, W_up) as the inputs of the gating Mul node.
+std::optional<GatedMLPMatch> MatchGateAndUp(Graph& graph, const Node& mul, size_t activation_index) {
+  GatedMLPMatch match{};
+  match.activation = GetInputNode(graph, mul, activation_index);
+  match.up = GetInputNode(graph, mul, 1 - activation_index);
+  if (match.activation == nullptr || match.up == nullptr || !IsMatMul(*match.up)) {
+    return std::nullopt;
+  }
+
+  if (IsGelu(*match.activation)) {
+    match.gate = GetInputNode(graph, *match.activation, 0);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*match.activation, "Mul", {7, 13, 14})) {
+    // x * Sigmoid(x) in either order
+    for (size_t i = 0; i < 2 && match.sigmoid == nullptr; ++i) {
+      Node* sigmoid = GetInputNode(graph, *match.activation, i);
+      if (sigmoid != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*sigmoid, "Sigmoid", {6, 13}) &&
+          sigmoid->InputDefs()[0] == match.activation->InputDefs()[1 - i]) {
+        match.sigmoid = sigmoid;
+        match.gate = GetInputNode(graph, *sigmoid, 0);
+      }
+    }
+  }
+
+  if (match.gate == nullptr || match.gate == match.up || !IsMatMul(*match.gate) ||
+      match.gate->InputDefs()[0] != match.up->InputDefs()[0] ||
+      !HasOnlyInternalConsumers(graph, *match.gate, match.sigmoid != nullptr ? 2 : 1) ||
+      !HasOnlyInternalConsumers(graph, *match.activation, 1) || !HasOnlyInternalConsumers(graph, *match.up, 1) ||
+      (match.sigmoid != nullptr && !HasOnlyInternalConsumers(graph, *match.sigmoid, 1))) {
+    return std::nullopt;
+  }
+
+  return match;
+}
+
+}  // namespace
+
+/**
+Rewrite MatMul(activation(MatMul(X, W_gate)) * MatMul(X, W_up), W_down) to GatedMLP(X, W_gate_up, W_down), where
+W_gate_up is a new initializer with the columns of W_gate followed by the columns of W_up.
+*/
+Status GatedMLPFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& mul = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(mul, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul, "Mul", {7, 13, 14}) ||
+        !graph_utils::IsSupportedProvider(mul, GetCompatibleExecutionProviders()) ||
+        !HasOnlyInternalConsumers(graph, mul, 1)) {
+      continue;
+    }
+
+    Node& down = *graph.GetNode(mul.OutputNodesBegin()->Index());
+    if (!IsMatMul(down) || down.InputDefs()[0] != mul.OutputDefs()[0]) {
+      continue;
+    }
+
+    std::optional<GatedMLPMatch> match = MatchGateAndUp(graph, mul, 0);
+    if (!match.has_value()) {
+      match = MatchGateAndUp(graph, mul, 1);
+    }
+    if (!match.has_value()) {
+      continue;
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse{*match->gate};
+    if (match->sigmoid != nullptr) {
+      nodes_to_fuse.emplace_back(*match->sigmoid);
+    }
+    nodes_to_fuse.emplace_back(*match->activation);
+    nodes_to_fuse.emplace_back(*match->up);
+    nodes_to_fuse.emplace_back(mul);
+    nodes_to_fuse.emplace_back(down);
+    const bool same_provider = std::all_of(nodes_to_fuse.begin(), nodes_to_fuse.end(), [&mul](const Node& node) {
+      return node.GetExecutionProviderType() == mul.GetExecutionProviderType();
+    });
+    if (!same_provider) {
+      continue;
+    }
+
+    const TensorProto* gate_weight = GetWeight(graph, *match->gate);
+    const TensorProto* up_weight = GetWeight(graph, *match->up);
+    const TensorProto* down_weight = GetWeight(graph, down);
+    if (gate_weight == nullptr || up_weight == nullptr || down_weight == nullptr ||
+        gate_weight->dims(0) != up_weight->dims(0) || gate_weight->dims(1) != up_weight->dims(1) ||
+        gate_weight->dims(1) != down_weight->dims(0)) {
+      continue;
+    }
+
+    const int64_t K = gate_weight->dims(0);
+    const int64_t hidden_size = gate_weight->dims(1);
+    Initializer gate_initializer{*gate_weight, graph.ModelPath()};
+    Initializer up_initializer{*up_weight, graph.ModelPath()};
+    const std::array<int64_t, 2> gate_up_dims{K, 2 * hidden_size};
+    Initializer gate_up_initializer{TensorProto_DataType_FLOAT, graph.GenerateNodeArgName(gate_weight->name()),
+                                    gate_up_dims};
+    const float* gate_data = gate_initializer.data<float>();
+    const float* up_data = up_initializer.data<float>();
+    float* gate_up_data = gate_up_initializer.data<float>();
+    for (int64_t k = 0; k < K; ++k) {
+      std::copy_n(gate_data + k * hidden_size, hidden_size, gate_up_data + 2 * k * hidden_size);
+      std::copy_n(up_data + k * hidden_size, hidden_size, gate_up_data + (2 * k + 1) * hidden_size);
+    }
+
+    TensorProto gate_up_proto;
+    gate_up_initializer.ToProto(gate_up_proto);
+    NodeArg& gate_up_arg = graph_utils::AddInitializer(graph, gate_up_proto);
+
+    Node& gated_mlp = graph.AddNode(graph.GenerateNodeName(down.Name() + "/GatedMLPFusion/"), "GatedMLP",
+                                    "Fused gated MLP",
+                                    std::array{match->gate->MutableInputDefs()[0], &gate_up_arg,
+                                               down.MutableInputDefs()[1]},
+                                    std::array{down.MutableOutputDefs()[0]}, {}, kMSDomain);
+    gated_mlp.AddAttribute("activation", std::string(match->sigmoid != nullptr ? "Silu" : "Gelu"));
+    gated_mlp.SetExecutionProviderType(mul.GetExecutionProviderType());
+
+    // the input edge of X is moved from the gate MatMul, the first of the fused nodes
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, gated_mlp);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
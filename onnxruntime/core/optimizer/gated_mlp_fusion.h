@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite the gated MLP block of SwiGLU and GeGLU models,
+ * MatMul(activation(MatMul(X, W_gate)) * MatMul(X, W_up), W_down), to a GatedMLP node. The gate and up weights are
+ * concatenated into one initializer, so that both projections run as one GEMM and the gated activation is applied to
+ * a block of rows before the down projection, instead of materializing four tensors of the hidden size.
+ * The activation is Silu, as x * Sigmoid(x), or Gelu, and all the weights must be constant float initializers.
+ */
+class GatedMLPFusion : public GraphTransformer {
+ public:
+  GatedMLPFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GatedMLPFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
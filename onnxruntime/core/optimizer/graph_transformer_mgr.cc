@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <chrono>
+
+#include "core/framework/tensorprotoutils.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -9,6 +13,18 @@ using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+// The size of the initializers of the graph, as an estimate of the memory that a transformer adds or frees.
+static int64_t InitializerSizeInBytes(const Graph& graph) {
+  int64_t size_in_bytes = 0;
+  for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+    size_t initializer_size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*initializer, &initializer_size).IsOK()) {
+      size_in_bytes += static_cast<int64_t>(initializer_size);
+    }
+  }
+  return size_in_bytes;
+}
+
 common::Status GraphTransformerManager::SetSteps(unsigned steps) {
   steps_ = steps;
   return Status::OK();
@@ -26,21 +42,75 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // time spent in each transformer including the Graph::Resolve after it modifies the graph, for the summary below
+  struct TransformerStats {
+    std::chrono::steady_clock::duration duration{};
+    unsigned num_applied = 0;
+    unsigned num_modified = 0;
+    size_t num_nodes_inferred = 0;
+    size_t num_nodes_reused = 0;
+    int64_t initializer_bytes_delta = 0;
+  };
+  InlinedVector<TransformerStats> stats(transformers->second.size());
+  const bool log_stats = logger.OutputIsEnabled(logging::Severity::kINFO, logging::DataType::SYSTEM);
+
+  unsigned num_steps = 0;
   for (unsigned step = 0; step < steps_; ++step) {
+    ++num_steps;
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+#if !defined(ORT_MINIMAL_BUILD)
+      const Graph::ResolveStats resolve_stats_before = graph.GetResolveStats();
+#endif
+      const int64_t initializer_bytes_before = log_stats ? InitializerSizeInBytes(graph) : 0;
+      const auto start = std::chrono::steady_clock::now();
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      TransformerStats& transformer_stats = stats[i];
+      if (log_stats && modified) {
+        transformer_stats.initializer_bytes_delta += InitializerSizeInBytes(graph) - initializer_bytes_before;
+      }
+      const auto duration = std::chrono::steady_clock::now() - start;
+      transformer_stats.duration += duration;
+      if (initialization_stats_ != nullptr) {
+        initialization_stats_->Add("graph_transformer", transformer->Name(), duration);
+      }
+      ++transformer_stats.num_applied;
+      transformer_stats.num_modified += modified ? 1 : 0;
+#if !defined(ORT_MINIMAL_BUILD)
+      transformer_stats.num_nodes_inferred +=
+          graph.GetResolveStats().num_nodes_inferred - resolve_stats_before.num_nodes_inferred;
+      transformer_stats.num_nodes_reused +=
+          graph.GetResolveStats().num_nodes_reused - resolve_stats_before.num_nodes_reused;
+#endif
     }
     if (!graph_changed) {
       break;
     }
   }
 
+  LOGS(logger, INFO) << "Applied graph transformers of level " << static_cast<int>(level) << " in " << num_steps
+                     << " step(s):";
+  for (size_t i = 0; i < transformers->second.size(); ++i) {
+    const TransformerStats& transformer_stats = stats[i];
+    if (transformer_stats.num_applied == 0) {
+      continue;
+    }
+    LOGS(logger, INFO) << "  " << transformers->second[i]->Name() << ": "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(transformer_stats.duration).count()
+                       << " us, modified the graph " << transformer_stats.num_modified << "/"
+                       << transformer_stats.num_applied << " times, nodes inferred/reused by Graph::Resolve: "
+                       << transformer_stats.num_nodes_inferred << "/" << transformer_stats.num_nodes_reused
+                       << ", initializer bytes delta: " << transformer_stats.initializer_bytes_delta;
+  }
+
   return Status::OK();
 }
 
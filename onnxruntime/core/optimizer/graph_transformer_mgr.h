@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/initialization_stats.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/optimizer/graph_transformer.h"
@@ -30,6 +31,11 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Set the stats recording the time spent in each transformer. nullptr to not record it.
+  void SetInitializationStats(profiling::InitializationStats* initialization_stats) {
+    initialization_stats_ = initialization_stats;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -38,5 +44,6 @@ class GraphTransformerManager {
 
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
+  profiling::InitializationStats* initialization_stats_ = nullptr;
 };
 }  // namespace onnxruntime
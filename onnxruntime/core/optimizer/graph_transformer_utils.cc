@@ -23,6 +23,7 @@
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
+#include "core/optimizer/broadcast_elimination.h"
 #include "core/optimizer/cast_elimination.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/constant_folding.h"
@@ -35,10 +36,12 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
+#include "core/optimizer/gated_mlp_fusion.h"
 #include "core/optimizer/gather_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -49,6 +52,7 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/label_encoder_fusion.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
@@ -78,6 +82,7 @@
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/zipmap_columnar_output.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/bitmask_dropout_replacement.h"
@@ -92,6 +97,21 @@
 
 namespace onnxruntime::optimizer_utils {
 
+OptimizationObjective GetOptimizationObjective(const ConfigOptions& config_options) {
+  const std::string objective =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsGraphOptimizationObjective, "speed");
+  if (objective == "speed") {
+    return OptimizationObjective::kSpeed;
+  }
+  if (objective == "balanced") {
+    return OptimizationObjective::kBalanced;
+  }
+  if (objective == "memory") {
+    return OptimizationObjective::kMemory;
+  }
+  ORT_THROW("Unsupported value for ", kOrtSessionOptionsGraphOptimizationObjective, ": ", objective);
+}
+
 static void FilterTransformers(InlinedVector<std::unique_ptr<GraphTransformer>>& transformers,
                                const InlinedHashSet<std::string>& transformers_to_disable) {
   if (transformers_to_disable.empty()) return;
@@ -122,6 +142,7 @@ InlinedVector<std::unique_ptr<RewriteRule>> GenerateRewriteRules(
       rules.push_back(std::make_unique<UnsqueezeElimination>());
       rules.push_back(std::make_unique<EliminateDropout>());
       rules.push_back(std::make_unique<ExpandElimination>());
+      rules.push_back(std::make_unique<BroadcastElimination>());
       rules.push_back(std::make_unique<CastElimination>());
       rules.push_back(std::make_unique<PreShapeNodeElimination>());
       rules.push_back(std::make_unique<NoopElimination>());
@@ -232,9 +253,14 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
       const InlinedHashSet<std::string_view> no_limit_empty_ep_list = {};
       transformers.emplace_back(std::make_unique<ConstantSharing>(no_limit_empty_ep_list, excluded_initializers));
+      // Moving the loop invariant nodes out of the Loop bodies first lets CSE merge them with the same nodes outside.
+      transformers.emplace_back(std::make_unique<LoopInvariantCodeMotion>());
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
       transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
-                                                                  session_options.config_options));
+                                                                  session_options.config_options,
+                                                                  InlinedHashSet<std::string_view>{},
+                                                                  InlinedHashSet<std::string>{},
+                                                                  intra_op_thread_pool));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
@@ -243,6 +269,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<GeluFusion>());
       transformers.emplace_back(std::make_unique<LayerNormFusion>());
 
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsZipMapColumnarOutput, "0") == "1") {
+        transformers.emplace_back(std::make_unique<ZipMapColumnarOutput>());
+      }
+
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
         transformers.emplace_back(std::make_unique<WeightBiasQuantization>());
@@ -388,6 +418,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
 #endif
 
+      // GatedMLPFusion runs after GeluFusion so that the Erf form of the activation is matched as a Gelu node.
+      transformers.emplace_back(std::make_unique<GatedMLPFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
@@ -399,8 +431,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
-      // Register the NCHWc layout transformer if supported by the platform.
-      if (MlasNchwcGetBlockSize() > 1) {
+      // Register the NCHWc layout transformer if supported by the platform. The reorders it adds pad the channels to
+      // the block size, so it is skipped when optimizing for memory.
+      if (MlasNchwcGetBlockSize() > 1 &&
+          GetOptimizationObjective(session_options.config_options) != OptimizationObjective::kMemory) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
 
@@ -417,6 +451,13 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // ElementwiseChainFusion may change results slightly as FusedElementwise uses the MLAS approximations of the
+      // transcendental functions. It needs to be manually enabled.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") ==
+          "1") {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
 #endif
 
     } break;
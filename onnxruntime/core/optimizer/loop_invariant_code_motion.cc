@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Whether a value named `name` would shadow or clash with a value that the graph or its ancestors can already see.
+bool IsNameVisible(const Graph& graph, const std::string& name) {
+  for (const Graph* current = &graph; current != nullptr; current = current->ParentGraph()) {
+    if (current->GetNodeArg(name) != nullptr) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Whether the node of the Loop body can be computed once in the graph of the Loop node. The inputs must be missing,
+// outer scope values, constant initializers of the body or outputs of nodes that are moved as well.
+bool IsLoopInvariant(const Graph& graph, const Graph& body, const Node& node,
+                     const InlinedHashSet<std::string>& invariant_values) {
+  if (node.ContainsSubgraph() || !optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType())) {
+    return false;
+  }
+
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!input->Exists() || invariant_values.count(input->Name()) > 0 || body.IsOuterScopeValue(input->Name())) {
+      continue;
+    }
+
+    if (body.GetConstantInitializer(input->Name(), false) == nullptr) {
+      return false;
+    }
+  }
+
+  // The values of the body outputs are produced per iteration, and the moved values keep their names, so they must
+  // not be visible in the graph of the Loop node already.
+  const auto& body_outputs = body.GetOutputs();
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (!output->Exists()) {
+      continue;
+    }
+
+    if (std::find(body_outputs.begin(), body_outputs.end(), output) != body_outputs.end() ||
+        IsNameVisible(graph, output->Name())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    Node* loop_node = graph.GetNode(node_index);
+    if (loop_node == nullptr) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*loop_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(*loop_node, "Loop", {1, 11, 13, 16, 19, 21}) ||
+        !graph_utils::IsSupportedProvider(*loop_node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Graph* body = loop_node->GetMutableGraphAttribute("body");
+    if (body == nullptr) {
+      continue;
+    }
+
+    GraphViewer body_viewer(*body);
+    InlinedVector<NodeIndex> invariant_nodes;
+    InlinedHashSet<std::string> invariant_values;
+    for (auto body_node_index : body_viewer.GetNodesInTopologicalOrder()) {
+      const Node* body_node = body->GetNode(body_node_index);
+      if (body_node == nullptr || !IsLoopInvariant(graph, *body, *body_node, invariant_values)) {
+        continue;
+      }
+
+      invariant_nodes.push_back(body_node_index);
+      for (const NodeArg* output : body_node->OutputDefs()) {
+        if (output->Exists()) {
+          invariant_values.insert(output->Name());
+        }
+      }
+    }
+
+    for (auto body_node_index : invariant_nodes) {
+      Node& body_node = *body->GetNode(body_node_index);
+
+      InlinedVector<NodeArg*> inputs;
+      inputs.reserve(body_node.InputDefs().size());
+      for (const NodeArg* input : body_node.InputDefs()) {
+        const ONNX_NAMESPACE::TensorProto* initializer =
+            input->Exists() ? body->GetConstantInitializer(input->Name(), false) : nullptr;
+        if (initializer == nullptr) {
+          inputs.push_back(&graph.GetOrCreateNodeArg(input->Name(), input->TypeAsProto()));
+          continue;
+        }
+
+        // The initializer of the body is copied, as the other nodes of the body may still consume it.
+        Initializer body_initializer(*initializer, body->ModelPath());
+        ONNX_NAMESPACE::TensorProto new_initializer;
+        body_initializer.ToProto(new_initializer);
+        new_initializer.set_name(graph.GenerateNodeArgName(input->Name()));
+        inputs.push_back(&graph_utils::AddInitializer(graph, new_initializer));
+      }
+
+      InlinedVector<NodeArg*> outputs;
+      outputs.reserve(body_node.OutputDefs().size());
+      for (const NodeArg* output : body_node.OutputDefs()) {
+        outputs.push_back(&graph.GetOrCreateNodeArg(output->Name(), output->TypeAsProto()));
+      }
+
+      Node& new_node = graph.AddNode(graph.GenerateNodeName(body_node.Name()), body_node.OpType(),
+                                     "Moved out of the body of " + loop_node->Name(), inputs, outputs,
+                                     &body_node.GetAttributes(), body_node.Domain());
+      new_node.SetExecutionProviderType(body_node.GetExecutionProviderType());
+
+      // The consumers in the body keep the names of the outputs, which now come from outer scope.
+      graph_utils::RemoveNodeOutputEdges(*body, body_node);
+      body->RemoveNode(body_node_index);
+      modified = true;
+    }
+
+    if (!invariant_nodes.empty()) {
+      LOGS(logger, VERBOSE) << "Moved " << invariant_nodes.size() << " loop invariant nodes out of the body of "
+                            << loop_node->Name();
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
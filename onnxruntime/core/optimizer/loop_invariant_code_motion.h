@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopInvariantCodeMotion
+Move the nodes of a Loop body that only depend on outer scope values and constant initializers to the graph of the
+Loop node, so they run once instead of once per iteration. The moved values are consumed by the body as implicit
+inputs, and CommonSubexpressionElimination in the graph of the Loop node can then merge them with the same
+computations outside of the Loop.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -4,10 +4,11 @@
 #include "core/optimizer/matmul_nbits_fusion.h"
 
 #include "core/common/common.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+#include "core/graph/graph_utils.h"
 #include "core/optimizer/selectors_actions/actions.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
-#include "core/graph/graph_utils.h"
 #include "core/optimizer/utils.h"
 #include "core/framework/tensorprotoutils.h"
 #endif
@@ -16,17 +17,64 @@ namespace onnxruntime {
 
 namespace {
 
+bool HasInput(const Node& node, size_t index) {
+  const auto input_defs = node.InputDefs();
+  return input_defs.size() > index && input_defs[index]->Exists();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 namespace selectors {
 
+// Whether the MatMulNBits node already applies an activation, gate or skip after the bias.
+bool HasEpilogue(const Node& node) {
+  const auto* activation = graph_utils::GetNodeAttribute(node, "activation");
+  return (activation != nullptr && !activation->s().empty()) || HasInput(node, 6) || HasInput(node, 7);
+}
+
+// Whether `arg` is known to have the shape of the output of `node`, so it does not broadcast to it.
+bool HasOutputShape(const Node& node, const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  const auto* output_shape = node.OutputDefs()[0]->Shape();
+  if (shape == nullptr || output_shape == nullptr || shape->dim_size() != output_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& output_dim = output_shape->dim(i);
+    const bool same_value = utils::HasDimValue(dim) && utils::HasDimValue(output_dim) &&
+                            dim.dim_value() == output_dim.dim_value();
+    const bool same_param = utils::HasDimParam(dim) && utils::HasDimParam(output_dim) &&
+                            dim.dim_param() == output_dim.dim_param();
+    if (!same_value && !same_param) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The only node that consumes the output of the MatMulNBits node, if it runs on the same EP.
+const Node* GetOnlyConsumer(const GraphViewer& graph_viewer, const Node& node) {
+  if (!optimizer_utils::CheckOutputEdges(graph_viewer.GetGraph(), node, 1)) {
+    return nullptr;
+  }
+
+  const Node& next_node = node.OutputEdgesBegin()->GetNode();
+  if (node.GetExecutionProviderType() != next_node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+
+  return &next_node;
+}
+
 class BiasFusion : public NodeSelector {
  public:
   std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
                                                const Node& node) const override {
-    // check if MatMulNBits node already has a bias input
-    if (const auto input_defs = node.InputDefs();
-        input_defs.size() > 5 && input_defs[5]->Exists()) {
+    // check if MatMulNBits node already has a bias input, or applies the bias before an epilogue
+    if (HasInput(node, 5) || HasEpilogue(node)) {
       return std::nullopt;
     }
 
@@ -71,6 +119,161 @@ class BiasFusion : public NodeSelector {
   }
 };
 
+// Gelu -> activation "Gelu"
+// BiasGelu -> bias input and activation "Gelu"
+// x * Sigmoid(x) -> activation "Silu"
+// The output node 0 is the node that produces the activation result.
+class ActivationFusion : public NodeSelector {
+ public:
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
+                                               const Node& node) const override {
+    if (HasEpilogue(node)) {
+      return std::nullopt;
+    }
+
+    NodesToOptimizeIndicesBuilder builder{};
+    builder.target_node = node.Index();
+
+    if (const Node* next_node = GetOnlyConsumer(graph_viewer, node); next_node != nullptr) {
+      if (IsGelu(*next_node) ||
+          (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "BiasGelu", {1}, kMSDomain) &&
+           !HasInput(node, 5) && node.OutputEdgesBegin()->GetDstArgIndex() == 0 &&
+           IsBiasOfNode(node, *next_node->InputDefs()[1]))) {
+        builder.output_nodes = {next_node->Index()};
+        return builder.Build();
+      }
+
+      return std::nullopt;
+    }
+
+    // x * Sigmoid(x), where x is only consumed by the Sigmoid and the Mul
+    if (!optimizer_utils::CheckOutputEdges(graph_viewer.GetGraph(), node, 2)) {
+      return std::nullopt;
+    }
+
+    const Node* sigmoid = nullptr;
+    const Node* mul = nullptr;
+    for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Sigmoid", {6, 13})) {
+        sigmoid = &*it;
+      } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Mul", {7, 13, 14})) {
+        mul = &*it;
+      }
+    }
+
+    if (sigmoid == nullptr || mul == nullptr ||
+        sigmoid->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        mul->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph_viewer.GetGraph(), *sigmoid, 1) ||
+        sigmoid->OutputNodesBegin()->Index() != mul->Index()) {
+      return std::nullopt;
+    }
+
+    builder.output_nodes = {mul->Index(), sigmoid->Index()};
+    return builder.Build();
+  }
+
+ private:
+  static bool IsGelu(const Node& node) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain)) {
+      return true;
+    }
+
+    const auto* approximate = graph_utils::GetNodeAttribute(node, "approximate");
+    return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {20}) &&
+           (approximate == nullptr || approximate->s() == "none");
+  }
+
+  static bool IsBiasOfNode(const Node& node, const NodeArg& bias_arg) {
+    const auto* bias_shape = bias_arg.Shape();
+    const int64_t N = graph_utils::GetNodeAttribute(node, "N")->i();
+    return bias_shape != nullptr && bias_shape->dim_size() == 1 && utils::HasDimValue(bias_shape->dim(0)) &&
+           bias_shape->dim(0).dim_value() == N;
+  }
+};
+
+// Mul of the output with a tensor of the same shape, as in the gate of SwiGLU -> gate input
+// Add of the output with a tensor of the same shape, as in a residual add -> skip input
+class ElementwiseFusion : public NodeSelector {
+ public:
+  ElementwiseFusion(std::string op_type, size_t input_index) : op_type_{std::move(op_type)}, input_index_{input_index} {
+  }
+
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
+                                               const Node& node) const override {
+    // the gate is multiplied before the skip is added
+    if (HasInput(node, input_index_) || HasInput(node, 7)) {
+      return std::nullopt;
+    }
+
+    const Node* next_node = GetOnlyConsumer(graph_viewer, node);
+    if (next_node == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, op_type_, {7, 13, 14})) {
+      return std::nullopt;
+    }
+
+    const int other_index = node.OutputEdgesBegin()->GetDstArgIndex() == 0 ? 1 : 0;
+    if (!HasOutputShape(node, *next_node->InputDefs()[other_index])) {
+      return std::nullopt;
+    }
+
+    NodesToOptimizeIndicesBuilder builder{};
+    builder.target_node = node.Index();
+    builder.output_nodes = {next_node->Index()};
+    return builder.Build();
+  }
+
+ private:
+  const std::string op_type_;
+  const size_t input_index_;
+};
+
+// SkipLayerNormalization or SkipSimplifiedLayerNormalization of the output and a tensor of the same shape -> skip input
+// and LayerNormalization or SimplifiedLayerNormalization of the output
+class SkipLayerNormFusion : public NodeSelector {
+ public:
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
+                                               const Node& node) const override {
+    if (HasInput(node, 7)) {
+      return std::nullopt;
+    }
+
+    const Node* next_node = GetOnlyConsumer(graph_viewer, node);
+    if (next_node == nullptr) {
+      return std::nullopt;
+    }
+
+    // the bias of the skip node is added to the sum of input and skip, which is not supported
+    const bool is_simplified =
+        graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "SkipSimplifiedLayerNormalization", {1},
+                                                       kMSDomain);
+    if ((!is_simplified &&
+         !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "SkipLayerNormalization", {1}, kMSDomain)) ||
+        HasInput(*next_node, is_simplified ? 3 : 4)) {
+      return std::nullopt;
+    }
+
+    const int matmul_input_index = node.OutputEdgesBegin()->GetDstArgIndex();
+    if (matmul_input_index > 1 || !HasOutputShape(node, *next_node->InputDefs()[matmul_input_index == 0 ? 1 : 0])) {
+      return std::nullopt;
+    }
+
+    // the replacement node does not produce the mean and inv_std_var outputs
+    const auto output_defs = next_node->OutputDefs();
+    for (size_t i = 1; i < std::min<size_t>(output_defs.size(), 3); ++i) {
+      if (output_defs[i]->Exists() &&
+          (graph_viewer.GetGraph().IsOutput(output_defs[i]) ||
+           !graph_viewer.GetGraph().GetConsumerNodes(output_defs[i]->Name()).empty())) {
+        return std::nullopt;
+      }
+    }
+
+    NodesToOptimizeIndicesBuilder builder{};
+    builder.target_node = node.Index();
+    builder.output_nodes = {next_node->Index()};
+    return builder.Build();
+  }
+};
+
 }  // namespace selectors
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -98,6 +301,135 @@ struct BiasFusion : MergeIntoTarget {
   }
 };
 
+struct ActivationFusion : MergeIntoTarget {
+  Status Run(Graph& graph, const NodesToOptimize& selected_nodes) const override {
+    // the activation node is removed by MergeIntoTarget::Run
+    const Node& activation_node = *selected_nodes.Output(0);
+    const std::string activation = activation_node.OpType() == "Mul" ? "Silu" : "Gelu";
+    ORT_RETURN_IF_ERROR(MergeIntoTarget::Run(graph, selected_nodes));
+    selected_nodes.Target().AddAttribute("activation", activation);
+    return Status::OK();
+  }
+
+ private:
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& runtime_state) const override {
+    NTO::NodeLocation activation_location{NTO::NodeType::kOutput, 0};
+
+    std::vector<NodeAndMoveInfo> value_moves{
+        MoveToSlot(activation_location, ArgType::kOutput, 0, ArgType::kOutput, 0),  // move output from activation
+    };
+
+    if (runtime_state.selected_nodes.Output(0)->OpType() == "BiasGelu") {
+      value_moves.push_back(MoveToSlot(activation_location, ArgType::kInput, 1, ArgType::kInput, 5));
+    }
+
+    return value_moves;
+  }
+};
+
+struct ElementwiseFusion : MergeIntoTarget {
+  explicit ElementwiseFusion(int input_index) : input_index_{input_index} {}
+
+ private:
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& runtime_state) const override {
+    const Node& target = runtime_state.selected_nodes.Target();
+    ORT_ENFORCE(target.GetOutputEdgesCount() == 1);
+    const auto other_index = target.OutputEdgesBegin()->GetDstArgIndex() == 0 ? 1 : 0;
+
+    NTO::NodeLocation elementwise_location{NTO::NodeType::kOutput, 0};
+
+    std::vector<NodeAndMoveInfo> value_moves{
+        // move the other input of the Mul or Add to the gate or skip input
+        MoveToSlot(elementwise_location, ArgType::kInput, other_index, ArgType::kInput, input_index_),
+        MoveToSlot(elementwise_location, ArgType::kOutput, 0, ArgType::kOutput, 0),
+    };
+
+    return value_moves;
+  }
+
+  const int input_index_;
+};
+
+// The residual of the skip node becomes the skip input of the MatMulNBits node, whose output is then the sum of the
+// skip node, and the skip node is replaced with the normalization of that sum.
+struct SkipLayerNormFusion : Action {
+  Status Run(Graph& graph, const NodesToOptimize& selected_nodes) const override {
+    Node& matmul = selected_nodes.Target();
+    Node& skip_layer_norm = *selected_nodes.Output(0);
+    const bool is_simplified = skip_layer_norm.OpType() == "SkipSimplifiedLayerNormalization";
+    const int matmul_input_index = matmul.OutputEdgesBegin()->GetDstArgIndex();
+    const int residual_index = matmul_input_index == 0 ? 1 : 0;
+
+    ORT_RETURN_IF_ERROR(MoveInputOutput(graph, skip_layer_norm, matmul,
+                                        ValueMoveInfo{InOutDefSlot{ArgType::kInput, residual_index},
+                                                      InOutDefSlot{ArgType::kInput, 7}},
+                                        false));
+
+    // the MatMulNBits node produces input_skip_bias_sum if it is used
+    const auto skip_layer_norm_outputs = skip_layer_norm.OutputDefs();
+    if (skip_layer_norm_outputs.size() > 3 && skip_layer_norm_outputs[3]->Exists()) {
+      ORT_RETURN_IF_ERROR(MoveInputOutput(graph, skip_layer_norm, matmul,
+                                          ValueMoveInfo{InOutDefSlot{ArgType::kOutput, 3},
+                                                        InOutDefSlot{ArgType::kOutput, 0}},
+                                          false));
+    } else {
+      graph.RemoveEdge(matmul.Index(), skip_layer_norm.Index(), 0, matmul_input_index);
+    }
+
+    const bool has_beta = !is_simplified && HasInput(skip_layer_norm, 3);
+    InlinedVector<NodeArg*> norm_inputs{matmul.MutableOutputDefs()[0], skip_layer_norm.MutableInputDefs()[2]};
+    if (has_beta) {
+      norm_inputs.push_back(skip_layer_norm.MutableInputDefs()[3]);
+    }
+    InlinedVector<NodeArg*> norm_outputs{skip_layer_norm.MutableOutputDefs()[0]};
+
+    Node& norm = graph.AddNode(graph.GenerateNodeName(skip_layer_norm.Name()), NormOpType(skip_layer_norm),
+                               "normalization of the MatMulNBits output with the skip input",
+                               norm_inputs, norm_outputs, nullptr, kOnnxDomain);
+    const auto* epsilon = graph_utils::GetNodeAttribute(skip_layer_norm, "epsilon");
+    norm.AddAttribute("epsilon", epsilon != nullptr ? epsilon->f() : contrib::kDefaultSkipLayerNormEpsilon);
+    norm.SetExecutionProviderType(skip_layer_norm.GetExecutionProviderType());
+
+    graph.AddEdge(matmul.Index(), norm.Index(), 0, 0);
+    for (int i = 2; i < (has_beta ? 4 : 3); ++i) {
+      ORT_RETURN_IF_ERROR(MoveInputOutput(graph, skip_layer_norm, norm,
+                                          ValueMoveInfo{InOutDefSlot{ArgType::kInput, i},
+                                                        InOutDefSlot{ArgType::kInput, i - 1}},
+                                          false));
+    }
+    ORT_RETURN_IF_ERROR(MoveInputOutput(graph, skip_layer_norm, norm,
+                                        ValueMoveInfo{InOutDefSlot{ArgType::kOutput, 0},
+                                                      InOutDefSlot{ArgType::kOutput, 0}},
+                                        false));
+
+    graph_utils::RemoveNodeOutputEdges(graph, skip_layer_norm);
+    graph.RemoveNode(skip_layer_norm.Index());
+    return Status::OK();
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                    const SatRuntimeOptimizationSaveContext& /*save_context*/,
+                    SavedState& saved_state, bool& graph_modified) const override {
+    // make temporary node, save its op schema, remove temporary node
+    Node& norm = graph.AddNode(graph.GenerateNodeName("MatMulNBitsNorm"), NormOpType(*selected_nodes.Output(0)), "",
+                               {}, {}, nullptr, kOnnxDomain);
+    ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(norm), "Failed to set node op schema.");
+    saved_state.produced_node_op_schemas.push_back(norm.Op());
+    ORT_RETURN_IF_NOT(graph.RemoveNode(norm.Index()), "Failed to remove node.");
+
+    graph_modified = true;
+    return Status::OK();
+  }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+ private:
+  static const char* NormOpType(const Node& skip_layer_norm) {
+    return skip_layer_norm.OpType() == "SkipSimplifiedLayerNormalization" ? "SimplifiedLayerNormalization"
+                                                                          : "LayerNormalization";
+  }
+};
+
 }  // namespace actions
 
 void BiasFusionRule(SelectorActionRegistry& registry) {
@@ -121,12 +453,79 @@ void BiasFusionRule(SelectorActionRegistry& registry) {
 #endif
 }
 
+void ActivationFusionRule(SelectorActionRegistry& registry) {
+  constexpr const char* name = "FuseActivation";
+
+  auto action = std::make_unique<actions::ActivationFusion>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+  auto selector = std::make_unique<selectors::ActivationFusion>();
+
+  registry.RegisterSelectorAndAction(name,
+                                     {{SelectorActionRegistry::OpVersionsMapKey("MatMulNBits", kMSDomain), {}}},
+                                     std::move(selector),
+                                     std::move(action));
+
+#else
+
+  registry.RegisterAction(name, std::move(action));
+
+#endif
+}
+
+void ElementwiseFusionRule(SelectorActionRegistry& registry, const char* name, const char* op_type,
+                           int input_index) {
+  auto action = std::make_unique<actions::ElementwiseFusion>(input_index);
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+  auto selector = std::make_unique<selectors::ElementwiseFusion>(op_type, static_cast<size_t>(input_index));
+
+  registry.RegisterSelectorAndAction(name,
+                                     {{SelectorActionRegistry::OpVersionsMapKey("MatMulNBits", kMSDomain), {}}},
+                                     std::move(selector),
+                                     std::move(action));
+
+#else
+
+  ORT_UNUSED_PARAMETER(op_type);
+  registry.RegisterAction(name, std::move(action));
+
+#endif
+}
+
+void SkipLayerNormFusionRule(SelectorActionRegistry& registry) {
+  constexpr const char* name = "FuseSkipLayerNorm";
+
+  auto action = std::make_unique<actions::SkipLayerNormFusion>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+  auto selector = std::make_unique<selectors::SkipLayerNormFusion>();
+
+  registry.RegisterSelectorAndAction(name,
+                                     {{SelectorActionRegistry::OpVersionsMapKey("MatMulNBits", kMSDomain), {}}},
+                                     std::move(selector),
+                                     std::move(action));
+
+#else
+
+  registry.RegisterAction(name, std::move(action));
+
+#endif
+}
+
 }  // namespace
 
 SelectorActionRegistry MatMulNBitsFusion::CreateSelectorActionRegistry() const {
   SelectorActionRegistry registry{};
 
   BiasFusionRule(registry);
+  ActivationFusionRule(registry);
+  ElementwiseFusionRule(registry, "FuseGate", "Mul", 6);
+  ElementwiseFusionRule(registry, "FuseSkip", "Add", 7);
+  SkipLayerNormFusionRule(registry);
 
   return registry;
 }
@@ -10,6 +10,10 @@ namespace onnxruntime {
 // Performs node fusions with MatMulNBits.
 // Currently supports these fusions:
 // - MatMulNBits + Add -> MatMulNBits with bias input
+// - MatMulNBits + Gelu, BiasGelu or x * Sigmoid(x) -> MatMulNBits with activation attribute
+// - MatMulNBits + Mul with a tensor of the output shape, e.g. the SwiGLU gate -> MatMulNBits with gate input
+// - MatMulNBits + Add with a tensor of the output shape, e.g. a residual -> MatMulNBits with skip input
+// - MatMulNBits + SkipLayerNormalization -> MatMulNBits with skip input + LayerNormalization
 class MatMulNBitsFusion : public SelectorActionTransformer {
  public:
   MatMulNBitsFusion(const InlinedHashSet<std::string_view>& compatible_eps = {},
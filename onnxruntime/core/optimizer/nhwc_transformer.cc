@@ -167,6 +167,48 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  // The fp32 convolutions and pooling are converted to the NCHWc layout instead when the platform supports it, the
+  // NchwcTransformer runs first.
+  if (MlasNchwcGetBlockSize() <= 1) {
+    {
+      // fp32 conv -> fp32 nhwc conv
+      OpKernelRegistryId nhwc_conv_fp32{
+          "NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_,
+          nhwc_conv_fp32.version_, nhwc_conv_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("Conv", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+        conv_table_.emplace(
+            OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+      }
+    }
+
+    // fp32 MaxPool, AveragePool and GlobalAveragePool -> fp32 nhwc pooling
+    const std::pair<const char*, int> nhwc_pool_fp32_ops[] = {
+        {"MaxPool", 12}, {"AveragePool", 11}, {"GlobalAveragePool", 1}};
+    for (const auto& [op_type, version] : nhwc_pool_fp32_ops) {
+      OpKernelRegistryId nhwc_pool_fp32{
+          op_type, kMSInternalNHWCDomain, version, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_pool_fp32.op_type_, nhwc_pool_fp32.domain_,
+          nhwc_pool_fp32.version_, nhwc_pool_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        conv_table_.emplace(
+            OpIdInfo(op_type, kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_pool_fp32.op_type_, nhwc_pool_fp32.domain_, nhwc_pool_fp32.version_, false});
+      }
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -198,6 +240,14 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // The NHWC MaxPool kernels don't produce the optional Indices output.
+    if (node->OpType() == "MaxPool") {
+      const auto outputs = node->Outputs();
+      if (outputs.size() > 1 && !outputs[1].empty()) {
+        continue;
+      }
+    }
+
     // Skip if already transformed
     if (transform->has_channels_last_attrib_ &&
         node->GetAttributeIntDefault("channels_last", 0) == 1) {
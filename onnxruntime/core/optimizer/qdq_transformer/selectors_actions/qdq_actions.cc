@@ -477,6 +477,31 @@ Status DQMatMulToMatMulNBitsAction::ProcessNewNode(Graph& graph,
   return Status::OK();
 }
 
+DQMatMulToMatMulFloat8Action::DQMatMulToMatMulFloat8Action()
+    : ReplaceWithNewFixed(kMSDomain, "MatMulFloat8", []() {
+        NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+        NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+        return std::vector<NodeAndMoveInfo>{
+            MoveAndAppend(target, ArgType::kInput, 0, ArgType::kInput),  // A
+            MoveAndAppend(dq, ArgType::kInput, 0, ArgType::kInput),      // float8 weight
+            MoveAndAppend(dq, ArgType::kInput, 1, ArgType::kInput),      // scale. The zero point is 0 and dropped.
+            MoveAll(target, ArgType::kOutput)};
+      }()) {
+}
+
+NodeAttributes
+DQMatMulToMatMulFloat8Action::ExtraAttributes(const RuntimeState& runtime_state) const {
+  NodeAttributes extra_attributes;
+
+  const auto* dq_node = runtime_state.selected_nodes.Input(0);
+  const auto* weight_shape = dq_node->InputDefs()[0]->Shape();
+
+  utils::SetNodeAttribute(utils::MakeAttribute("K", weight_shape->dim(0).dim_value()), extra_attributes);
+  utils::SetNodeAttribute(utils::MakeAttribute("N", weight_shape->dim(1).dim_value()), extra_attributes);
+
+  return extra_attributes;
+}
+
 static std::vector<NodeAndMoveInfo> GetGemmMoveInfo(bool does_q_node_exist) {
   NTO::NodeLocation dq_A{NTO::NodeType::kInput, 0};
   NTO::NodeLocation dq_B{NTO::NodeType::kInput, 1};
@@ -539,5 +564,60 @@ Status GemmReplaceWithQuant::RunForSave(Graph& graph,
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+AttentionReplaceWithQAttention::AttentionReplaceWithQAttention()
+    : QDQReplaceWithNew(kMSDomain, "QAttention", []() {
+        NTO::NodeLocation dq_input{NTO::NodeType::kInput, 0};
+        NTO::NodeLocation dq_weight{NTO::NodeType::kInput, 1};
+        NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+        return std::vector<NodeAndMoveInfo>{
+            MoveAndAppend(dq_input, ArgType::kInput, 0, ArgType::kInput),   // input
+            MoveAndAppend(dq_weight, ArgType::kInput, 0, ArgType::kInput),  // weight
+            MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),     // bias
+            MoveAndAppend(dq_input, ArgType::kInput, 1, ArgType::kInput),   // input_scale
+            MoveAndAppend(dq_weight, ArgType::kInput, 1, ArgType::kInput),  // weight_scale
+            MoveAndAppend(target, ArgType::kInput, 3, ArgType::kInput),     // mask_index
+            MoveAndAppend(dq_input, ArgType::kInput, 2, ArgType::kInput),   // input_zero_point
+            MoveAndAppend(dq_weight, ArgType::kInput, 2, ArgType::kInput),  // weight_zero_point
+            MoveAndAppend(target, ArgType::kInput, 4, ArgType::kInput),     // past
+            MoveAll(target, ArgType::kOutput)};
+      }()) {
+}
+
+Status AttentionReplaceWithQAttention::AddMissingOptionalInputs(Graph& graph, const NodesToOptimize& selected_nodes) {
+  constexpr size_t num_inputs = 5;  // input, weights, bias, mask_index and past
+  Node& target = selected_nodes.Target();
+  auto& input_defs = target.MutableInputDefs();
+  if (input_defs.size() >= num_inputs) {
+    return Status::OK();
+  }
+
+  // the input arg counts of the missing optional inputs were set to 0 during Graph::Resolve()
+  auto& input_arg_counts = target.MutableInputArgsCount();
+  ORT_RETURN_IF(input_arg_counts.size() < num_inputs,
+                "Expected at least ", num_inputs, " input arg counts but there are only ", input_arg_counts.size());
+
+  NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+  for (size_t i = input_defs.size(); i < num_inputs; ++i) {
+    input_arg_counts[i] = 1;
+  }
+  input_defs.resize(num_inputs, &empty_arg);
+
+  return Status::OK();
+}
+
+Status AttentionReplaceWithQAttention::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  ORT_RETURN_IF_ERROR(AddMissingOptionalInputs(graph, selected_nodes));
+  return QDQReplaceWithNew::Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status AttentionReplaceWithQAttention::RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                                                  const SatRuntimeOptimizationSaveContext& save_context,
+                                                  SavedState& saved_state, bool& graph_modified) const {
+  ORT_RETURN_IF_ERROR(AddMissingOptionalInputs(graph, selected_nodes));
+  return QDQReplaceWithNew::RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -109,6 +109,15 @@ struct DQMatMulToMatMulNBitsAction : public ReplaceWithNew {
   std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors_;
 };
 
+// used together with DQMatMulFloat8NodeGroupSelector, which does the sanity check
+struct DQMatMulToMatMulFloat8Action : public ReplaceWithNewFixed {
+  DQMatMulToMatMulFloat8Action();
+
+ private:
+  // add K and N from the shape of the DQ's weight
+  NodeAttributes ExtraAttributes(const RuntimeState&) const override;
+};
+
 struct GemmReplaceWithQuant : public Action {
   GemmReplaceWithQuant();
 
@@ -129,5 +138,23 @@ struct GemmReplaceWithQuant : public Action {
   QDQReplaceWithNew qgemm_with_8bits_as_output_replacer_;
 };
 
+// used together with AttentionNodeGroupSelector, which does the sanity check
+struct AttentionReplaceWithQAttention : public QDQReplaceWithNew {
+  AttentionReplaceWithQAttention();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                    const SatRuntimeOptimizationSaveContext& save_context,
+                    SavedState& saved_state, bool& graph_modified) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+ private:
+  // fill the missing optional mask_index and past inputs of the Attention with the empty NodeArg,
+  // so every input of the QAttention can be appended in order
+  static Status AddMissingOptionalInputs(Graph& graph, const NodesToOptimize& selected_nodes);
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -307,6 +307,29 @@ void DQMatMulToMatMulNBitsRules(SelectorActionRegistry& qdq_selector_action_regi
 #endif
 }
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+void DQMatMulToMatMulFloat8Rules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 2 nodes. DQ -> MatMul. DQ is the second input to MatMul.
+  // DQ's weight is float8e4m3fn/float8e5m2. DQ's scale is float, per tensor or per column.
+  // Replace with MatMulFloat8, which computes with the float8 weight instead of a dequantized float weight.
+  const std::string action_name{"DQMatMulToMatMulFloat8"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::DQMatMulToMatMulFloat8Action>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::DQMatMulToMatMulFloat8Selector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"MatMul", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
+
 void GemmQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 to 5 nodes. 0=DQ A, 1=DQ B, 2=DQ C(optional), 3=Gemm, 4=Q Y(optional)
   // Replace with QGemm
@@ -350,6 +373,28 @@ void WhereQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void AttentionQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. 0=DQ input, 1=DQ weight, 2=com.microsoft Attention
+  // Replace with QAttention, which computes the QKV projection with the 8-bit input and weight.
+  // The float output keeps its consumers, so Q nodes after the Attention stay in the graph.
+  const std::string action_name{"Attention"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::AttentionReplaceWithQAttention>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::AttentionSelector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(
+      action_name,
+      {{SelectorActionRegistry::OpVersionsMapKey("Attention", kMSDomain), {}}},
+      std::move(selector),
+      std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 SelectorActionRegistry CreateSelectorActionRegistry(
     bool is_int8_allowed,
     int64_t qdq_matmulnbits_accuracy_level,
@@ -366,10 +411,14 @@ SelectorActionRegistry CreateSelectorActionRegistry(
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
+  AttentionQDQRules(qdq_selector_action_registry);
   DQMatMulToMatMulNBitsRules(qdq_selector_action_registry,
                              qdq_matmulnbits_accuracy_level,
                              intra_op_thread_pool,
                              p_buffered_tensors);
+#if !defined(DISABLE_FLOAT8_TYPES)
+  DQMatMulToMatMulFloat8Rules(qdq_selector_action_registry);
+#endif
 
   return qdq_selector_action_registry;
 }
@@ -25,6 +25,11 @@ constexpr bool Is4BitIntType(int32_t data_type) {
          (data_type == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT4);
 }
 
+constexpr bool IsFloat8Type(int32_t data_type) {
+  return (data_type == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT8E4M3FN) ||
+         (data_type == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT8E5M2);
+}
+
 // adjust for an optional input/output that has an entry but does not exist
 int NumActualValues(const Node& node, bool input) {
   const auto& defs = input ? node.InputDefs() : node.OutputDefs();
@@ -529,6 +534,95 @@ bool DQMatMulNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Nod
   return true;
 }
 
+bool DQMatMulFloat8NodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                            const Node* redundant_clip_node, const std::vector<const Node*>& dq_nodes,
+                                            const std::vector<const Node*>& q_nodes) const {
+  if (redundant_clip_node) {
+    return false;
+  }
+
+  // Should not have any Q nodes
+  if (!q_nodes.empty()) {
+    return false;
+  }
+
+  const auto& graph = graph_viewer.GetGraph();
+
+  // MatMul has only 1 DQ input and the DQ must have 1 output edge and not be a graph output
+  if (dq_nodes.size() != 1 || !optimizer_utils::CheckOutputEdges(graph, *dq_nodes[0], 1)) {
+    return false;
+  }
+
+  // DQ must be MatMul's the second input
+  if (node.InputDefs()[1] != dq_nodes[0]->OutputDefs()[0]) {
+    return false;
+  }
+
+  // DQ weight type is float8e4m3fn/float8e5m2, scale/output type is float
+  const auto* weight_arg = dq_nodes[0]->InputDefs()[0];
+  const auto* scale_arg = dq_nodes[0]->InputDefs()[1];
+  const auto* zero_point_arg = dq_nodes[0]->InputDefs().size() == 3 ? dq_nodes[0]->InputDefs()[2] : nullptr;
+  int32_t dt_weight = weight_arg->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_scales = scale_arg->TypeAsProto()->tensor_type().elem_type();
+  if (dt_scales != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT || !IsFloat8Type(dt_weight)) {
+    return false;
+  }
+
+  // DQ is not blockwise quantized
+  const auto& dq_attrs = dq_nodes[0]->GetAttributes();
+  if (const auto b_iter = dq_attrs.find("block_size"); b_iter != dq_attrs.end() && b_iter->second.i() != 0) {
+    return false;
+  }
+
+  // weight, scale and zero point (if exists) must be constants
+  const auto* weight_tensor_proto = graph.GetConstantInitializer(weight_arg->Name(), true);
+  const auto* scale_tensor_proto = graph.GetConstantInitializer(scale_arg->Name(), true);
+  const auto* zp_tensor_proto = zero_point_arg && zero_point_arg->Exists()
+                                    ? graph.GetConstantInitializer(zero_point_arg->Name(), true)
+                                    : nullptr;
+
+  if (!weight_tensor_proto || !scale_tensor_proto) {
+    return false;
+  }
+
+  if (zero_point_arg && zero_point_arg->Exists() && !zp_tensor_proto) {
+    return false;
+  }
+
+  // weight has the rank 2. The scale is per tensor, or per column when quantized along axis 1.
+  if (weight_tensor_proto->dims_size() != 2) {
+    return false;
+  }
+
+  int64_t scale_count = 1;
+  for (int i = 0; i < scale_tensor_proto->dims_size(); ++i) {
+    scale_count *= scale_tensor_proto->dims(i);
+  }
+
+  if (scale_count != 1) {
+    int64_t axis = 1;
+    if (const auto a_iter = dq_attrs.find("axis"); a_iter != dq_attrs.end()) {
+      axis = a_iter->second.i();
+    }
+
+    if ((axis != 1 && axis != -1) || scale_tensor_proto->dims_size() != 1 ||
+        scale_tensor_proto->dims(0) != weight_tensor_proto->dims(1)) {
+      return false;
+    }
+  }
+
+  // float8 zero points must be 0, so they can be dropped
+  if (zp_tensor_proto) {
+    Initializer zero_point(*zp_tensor_proto, graph.ModelPath());
+    const auto zero_point_bytes = zero_point.DataAsByteSpan();
+    if (std::any_of(zero_point_bytes.begin(), zero_point_bytes.end(), [](uint8_t v) { return (v & 0x7F) != 0; })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool GemmNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
                                   const std::vector<const Node*>& dq_nodes,
                                   const std::vector<const Node*>& q_nodes) const {
@@ -733,6 +827,101 @@ bool TopKNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& n
   return IsQDQPairSupported(q_node, dq_node, get_const_initializer, graph_viewer.ModelPath());
 }
 
+bool AttentionNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                       const Node* redundant_clip_node, const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& /*q_nodes*/) const {
+  if (redundant_clip_node) {
+    return false;
+  }
+
+  // Only the input and the weight come from DQ nodes. The Q nodes of the output stay after the QAttention.
+  if (!CheckQDQNodes(graph_viewer, node, nullptr, dq_nodes, {}, 2 /*num_dq_inputs*/,
+                     true /*is_empty_q_nodes_allowed*/)) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs[0] != dq_nodes[0]->OutputDefs()[0] || input_defs[1] != dq_nodes[1]->OutputDefs()[0]) {
+    return false;
+  }
+
+  // QAttention requires the bias, and has no attention_bias or past_sequence_length input
+  if (input_defs.size() < 3 || !input_defs[2]->Exists()) {
+    return false;
+  }
+
+  for (size_t i = 5; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists()) {
+      return false;
+    }
+  }
+
+  // the attributes are copied to the QAttention, which doesn't have these
+  const auto& attrs = node.GetAttributes();
+  if (attrs.find("qkv_hidden_sizes") != attrs.end() || attrs.find("rotary_embedding_dim") != attrs.end()) {
+    return false;
+  }
+
+  const Node& dq_input = *dq_nodes[0];
+  const Node& dq_weight = *dq_nodes[1];
+  int32_t dt_input = dq_input.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_weight = dq_weight.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 ||
+      (dt_weight != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 &&
+       dt_weight != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8)) {
+    return false;
+  }
+
+  auto get_const_initializer = [&graph_viewer](const std::string& initializer_name) {
+    return graph_viewer.GetConstantInitializer(initializer_name, true);
+  };
+
+  bool zero_point_exists = false;
+  if (!QOrDQNodeHasConstantScalarScaleAndZeroPoint(dq_input, get_const_initializer, zero_point_exists)) {
+    return false;
+  }
+
+  // The weight is a constant of rank 2, with a scale per tensor, or per column when quantized along axis 1.
+  const auto& dq_attrs = dq_weight.GetAttributes();
+  if (const auto b_iter = dq_attrs.find("block_size"); b_iter != dq_attrs.end() && b_iter->second.i() != 0) {
+    return false;
+  }
+
+  const auto* weight_tensor_proto = get_const_initializer(dq_weight.InputDefs()[0]->Name());
+  const auto* scale_tensor_proto = get_const_initializer(dq_weight.InputDefs()[1]->Name());
+  if (!weight_tensor_proto || !scale_tensor_proto || weight_tensor_proto->dims_size() != 2) {
+    return false;
+  }
+
+  const auto* zero_point_arg = dq_weight.InputDefs().size() == 3 ? dq_weight.InputDefs()[2] : nullptr;
+  if (zero_point_arg && zero_point_arg->Exists() && !get_const_initializer(zero_point_arg->Name())) {
+    return false;
+  }
+
+  int64_t scale_count = 1;
+  for (int i = 0; i < scale_tensor_proto->dims_size(); ++i) {
+    scale_count *= scale_tensor_proto->dims(i);
+  }
+
+  if (scale_count != 1) {
+    int64_t axis = 1;
+    if (const auto a_iter = dq_attrs.find("axis"); a_iter != dq_attrs.end()) {
+      axis = a_iter->second.i();
+    }
+
+    if ((axis != 1 && axis != -1) || scale_tensor_proto->dims_size() != 1 ||
+        scale_tensor_proto->dims(0) != weight_tensor_proto->dims(1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AttentionSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  builder.output_nodes.clear();
+}
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
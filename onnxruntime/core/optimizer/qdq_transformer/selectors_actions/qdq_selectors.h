@@ -214,6 +214,14 @@ class DQMatMulNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Convert "1 DQ node with a float8 weight for input B -> MatMul" to "MatMulFloat8"
+class DQMatMulFloat8NodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmNodeGroupSelector : public NodeGroupSelector {
@@ -269,6 +277,16 @@ class TopKNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Convert "DQ nodes for input and weight -> com.microsoft Attention" to "QAttention".
+// The input is uint8 and quantized per tensor. The weight is a constant 8-bit initializer quantized per tensor or
+// per column. The Q nodes of the output, if any, are left as is since QAttention produces a float output.
+class AttentionNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 /*
  * NodeSelector instances for use in the QDQ::SelectorActionTransformer.
  */
@@ -390,6 +408,12 @@ class DQMatMulToMatMulNBitsSelector : public BaseSelector {
       : BaseSelector(std::make_unique<DQMatMulNodeGroupSelector>(), compatible_providers) {}
 };
 
+class DQMatMulToMatMulFloat8Selector : public BaseSelector {
+ public:
+  explicit DQMatMulToMatMulFloat8Selector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<DQMatMulFloat8NodeGroupSelector>(), compatible_providers) {}
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmSelector : public BaseSelector {
@@ -401,6 +425,17 @@ class GemmSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// Input: DQ nodes for input and weight
+// Output: the float output of the Attention, which keeps its consumers
+class AttentionSelector : public BaseSelector {
+ public:
+  explicit AttentionSelector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<AttentionNodeGroupSelector>(), compatible_providers) {}
+
+  // the Q nodes of the output are not part of the replacement
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
@@ -1415,6 +1415,10 @@ void TransposeOutputs(OptimizerCtx& ctx, api::NodeRef& node, const std::vector<i
 //
 // A rank of 5 is used if rank cannot be determined since 5 is the largest rank we expect from something like a Conv
 // and an unknown rank likely corresponds to a data-carrying (non-weight) tensor, which will be large.
+//
+// When the shapes of all the values in a comparison are known, the number of elements is used instead. It accounts
+// for the bytes actually moved by the transposes, e.g. a large activation vs. a small broadcast input of the same
+// non-trivial rank.
 
 // Given a value, returns the rank of the value excluding dimensions of value 1. Returns 5 if the rank is unknown.
 static int EstimateValueRank(const api::GraphRef& graph, std::string_view input) {
@@ -1432,6 +1436,34 @@ static int EstimateValueRank(const api::GraphRef& graph, std::string_view input)
   return rank;
 }
 
+// Given a value, returns its number of elements. Returns nullopt if any dimension is unknown.
+static std::optional<int64_t> EstimateValueSize(const api::GraphRef& graph, std::string_view input) {
+  auto value_info = graph.GetValueInfo(input);
+  std::optional<std::vector<int64_t>> shape = value_info->Shape();
+  if (shape == std::nullopt) {
+    return std::nullopt;
+  }
+  int64_t size = 1;
+  for (int64_t d : *shape) {
+    if (d < 0) {
+      return std::nullopt;
+    }
+    size *= d;
+  }
+  return size;
+}
+
+// Estimates the cost of a value in the units of the comparison: elements if `use_size` is set, or rank otherwise.
+static int64_t EstimateValueCost(const api::GraphRef& graph, std::string_view input, bool use_size) {
+  if (use_size) {
+    std::optional<int64_t> size = EstimateValueSize(graph, input);
+    if (size != std::nullopt) {
+      return *size;
+    }
+  }
+  return EstimateValueRank(graph, input);
+}
+
 static const HandlerInfo* GetHandler(api::NodeRef& node, const HandlerMap& extended_handlers);
 
 // Returns true if the provided transpose node is only consumed by nodes we can likely push it through.
@@ -1483,10 +1515,11 @@ static bool IsConstant(const api::GraphRef& graph, std::string_view value_name)
   return false;
 }
 
-// Estimates the cost of transposing an input. Currently uses rank heuristic. Negative if transpose is removed.
-// Feel free to improve as needed.
-static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_view input,
-                                      const std::vector<int64_t>& perm_inv, const HandlerMap& extended_handlers) {
+// Estimates the cost of transposing an input. Uses the number of elements if `use_size` is set, otherwise the rank
+// heuristic. Negative if transpose is removed. Feel free to improve as needed.
+static int64_t EstimateTransposeValueCost(const api::GraphRef& graph, std::string_view input,
+                                          const std::vector<int64_t>& perm_inv, bool use_size,
+                                          const HandlerMap& extended_handlers) {
   // Case 1: Transposing constants probably costs nothing.
   if (IsConstant(graph, input)) {
     return 0;
@@ -1531,7 +1564,7 @@ static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_vi
       std::optional<std::vector<int64_t>> perm2 = GetPermAttrIfValid(*producer_node);
       if (perm2 != std::nullopt) {
         if (*perm2 == perm_inv && CanLikelyRemoveTranspose(graph, *producer_node, extended_handlers)) {
-          return -EstimateValueRank(graph, input);
+          return -EstimateValueCost(graph, input, use_size);
         } else {
           return 0;
         }
@@ -1539,18 +1572,18 @@ static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_vi
     }
   }
   // Case 3: We will likely need to add a transpose.
-  return EstimateValueRank(graph, input);
+  return EstimateValueCost(graph, input, use_size);
 }
 
 // Estimates total cost of transposing a node's inputs. Negative if transposing is beneficial.
-static int EstimateTransposeInputsCost(const api::GraphRef& graph, const api::NodeRef& node,
-                                       const std::vector<int64_t>& perm_inv,
-                                       const std::vector<size_t>& input_indices,
-                                       const HandlerMap& extended_handlers) {
+static int64_t EstimateTransposeInputsCost(const api::GraphRef& graph, const api::NodeRef& node,
+                                           const std::vector<int64_t>& perm_inv,
+                                           const std::vector<size_t>& input_indices, bool use_size,
+                                           const HandlerMap& extended_handlers) {
   auto inputs = node.Inputs();
-  int cost = 0;
+  int64_t cost = 0;
   for (size_t j : input_indices) {
-    cost += EstimateTransposeValueCost(graph, inputs[j], perm_inv, extended_handlers);
+    cost += EstimateTransposeValueCost(graph, inputs[j], perm_inv, use_size, extended_handlers);
   }
 
   return cost;
@@ -2616,27 +2649,38 @@ static const HandlerInfo* GetHandler(api::NodeRef& node, const HandlerMap& exten
   return nullptr;
 }
 
-static int CalculateCost(const api::GraphRef& graph, const api::NodeRef& node,
-                         const std::vector<int64_t>& perm,
-                         const std::unordered_set<std::string>& outputs_leading_to_transpose,
-                         const HandlerInfo& info,
-                         const std::vector<size_t>& input_indices,
-                         const HandlerMap& extended_handlers) {
+static int64_t CalculateCost(const api::GraphRef& graph, const api::NodeRef& node,
+                             const std::vector<int64_t>& perm,
+                             const std::unordered_set<std::string>& outputs_leading_to_transpose,
+                             const HandlerInfo& info,
+                             const std::vector<size_t>& input_indices,
+                             const HandlerMap& extended_handlers) {
+  // Compare sizes only if all of them are known, as sizes and ranks can't be compared with each other.
+  auto inputs = node.Inputs();
+  auto outputs = node.Outputs();
+  bool use_size = std::all_of(input_indices.begin(), input_indices.end(), [&](size_t j) {
+    return EstimateValueSize(graph, inputs[j]) != std::nullopt;
+  });
+  if (info.transposes_outputs) {
+    use_size = use_size && std::all_of(outputs.begin(), outputs.end(), [&](std::string_view out) {
+                 return EstimateValueSize(graph, out) != std::nullopt;
+               });
+  }
+
   // We require the input cost (number of transposes before the op) and the total cost to strictly decrease.
   // Strict decrease of the input cost ensures the optimization is stable, since the total cost decrease is just an
   // estimate (the transpose after the op may or may not cancel with a subsequent transpose). We don't want
   // repeated runs of the optimizer to have a transpose toggle between two inputs of a binary op.
-  int cost = EstimateTransposeInputsCost(graph, node, perm, input_indices, extended_handlers);
+  int64_t cost = EstimateTransposeInputsCost(graph, node, perm, input_indices, use_size, extended_handlers);
 
   if (cost < 0 && info.transposes_outputs) {
     // If the output will be transposed and won't ultimately cancel, factor in that cost.
     bool has_output_leading_to_transpose = false;
-    auto outputs = node.Outputs();
-    int out_cost = 0;
+    int64_t out_cost = 0;
     // Having multiple outputs is rare. When it happens (Split), the total size of the outputs isn't much larger
-    // than the largest input. Cost is rank currently, so just use the largest cost (rank) over all outputs.
+    // than the largest input, so just use the largest cost over all outputs.
     for (auto out : outputs) {
-      out_cost = std::max(out_cost, EstimateValueRank(graph, out));
+      out_cost = std::max(out_cost, EstimateValueCost(graph, out, use_size));
       if (outputs_leading_to_transpose.find(std::string(out)) != outputs_leading_to_transpose.end()) {
         has_output_leading_to_transpose = true;
       }
@@ -2661,8 +2705,8 @@ static bool DefaultCostCheck(const api::GraphRef& graph, const api::NodeRef& nod
     return true;
   }
 
-  int cost = CalculateCost(graph, node, perm, outputs_leading_to_transpose, info, transposable_input_indices,
-                           extended_handlers);
+  int64_t cost = CalculateCost(graph, node, perm, outputs_leading_to_transpose, info, transposable_input_indices,
+                               extended_handlers);
   return cost < 0;
 }
 
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_columnar_output.h"
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+Status ZipMapColumnarOutput::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                       const logging::Logger& logger) const {
+  // the output types of a subgraph are defined by its parent node, and the ZipMap is replaced by an Identity node.
+  if (graph.IsSubgraph() || graph.DomainToVersionMap().count(kOnnxDomain) == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<NodeIndex> zipmap_nodes;
+  for (const auto& node : graph.Nodes()) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ZipMap", {1}, kMLDomain) &&
+        node.GetOutputEdgesCount() == 0 && graph.IsOutput(node.OutputDefs()[0])) {
+      zipmap_nodes.push_back(node.Index());
+    }
+  }
+
+  if (zipmap_nodes.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<const NodeArg*> graph_outputs = graph.GetOutputs();
+
+  for (NodeIndex node_index : zipmap_nodes) {
+    Node& zipmap = *graph.GetNode(node_index);
+    NodeArg* input = zipmap.MutableInputDefs()[0];
+    NodeArg* output = zipmap.MutableOutputDefs()[0];
+    if (input->TypeAsProto() == nullptr) {
+      continue;
+    }
+
+    const auto& attributes = zipmap.GetAttributes();
+    const auto strings_attr = attributes.find("classlabels_strings");
+    const auto int64s_attr = attributes.find("classlabels_int64s");
+
+    TensorProto labels;
+    labels.set_name(graph.GenerateNodeArgName(output->Name() + "_labels"));
+    if (strings_attr != attributes.end() && strings_attr->second.strings_size() > 0) {
+      labels.set_data_type(TensorProto_DataType_STRING);
+      labels.add_dims(strings_attr->second.strings_size());
+      *labels.mutable_string_data() = strings_attr->second.strings();
+    } else if (int64s_attr != attributes.end() && int64s_attr->second.ints_size() > 0) {
+      labels.set_data_type(TensorProto_DataType_INT64);
+      labels.add_dims(int64s_attr->second.ints_size());
+      *labels.mutable_int64_data() = int64s_attr->second.ints();
+    } else {
+      continue;
+    }
+
+    const std::string zipmap_name = zipmap.Name();
+    const std::string provider_type = zipmap.GetExecutionProviderType();
+    graph.RemoveNode(node_index);
+
+    // the graph output keeps its name and now holds the dense input of the ZipMap.
+    graph.SetNodeArgType(*output, *input->TypeAsProto());
+    Node& identity = graph.AddNode(graph.GenerateNodeName(zipmap_name + "_columnar"), "Identity",
+                                   "Columnar output of ZipMap " + zipmap_name, {input}, {output});
+    identity.SetExecutionProviderType(provider_type);
+
+    graph_outputs.push_back(&graph_utils::AddInitializer(graph, labels));
+
+    LOGS(logger, INFO) << "ZipMap node '" << zipmap_name << "' was replaced by the columnar outputs '"
+                       << output->Name() << "' and '" << labels.name() << "'.";
+    modified = true;
+  }
+
+  graph.SetOutputs(graph_outputs);
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapColumnarOutput
+
+Transformer that replaces a ZipMap node producing a graph output with its dense input tensor. The graph output
+keeps its name but becomes the [N, C] float tensor the ZipMap reads, and a new graph output named
+"<output name>_labels" holds the class labels of the ZipMap as a 1D string or int64 tensor, so the value of class
+labels[j] in row i is output[i, j]. This avoids allocating a map per row, which usually costs more than the
+classifier itself for large batches.
+
+It is only enabled by kOrtSessionOptionsZipMapColumnarOutput, as it changes the types of the graph outputs.
+*/
+class ZipMapColumnarOutput : public GraphTransformer {
+ public:
+  ZipMapColumnarOutput() noexcept : GraphTransformer("ZipMapColumnarOutput") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -84,6 +84,11 @@ struct ThreadOptions {
   // The process that owns the thread may consider setting its affinity.
   std::vector<LogicalProcessors> affinities;
 
+  // NUMA node of each thread, with the same indexing as affinities, or -1 if it is unknown.
+  // If the vector is not empty, the thread pool schedules work on, and steals work from, the threads of the NUMA node
+  // of the calling thread first. The affinity of each thread is expected to be within its NUMA node.
+  std::vector<int> numa_nodes;
+
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
 
@@ -149,6 +154,19 @@ class Env {
 
   virtual int GetL2CacheSize() const = 0;
 
+  /// <summary>
+  /// Returns the logical processors of each NUMA node, restricted to the processors the process can run on.
+  /// Nodes without such processors are omitted, so the index of a node in the result may differ from its OS id.
+  /// </summary>
+  /// <returns>The logical processors of each NUMA node, or an empty vector if the topology is unknown.</returns>
+  virtual std::vector<LogicalProcessors> GetNumaNodes() const { return {}; }
+
+  /// <summary>
+  /// Returns the NUMA node of the logical processor the calling thread is running on, as an index in the result of
+  /// GetNumaNodes(), or -1 if it is unknown.
+  /// </summary>
+  virtual int GetCurrentNumaNode() const { return -1; }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -17,9 +17,11 @@ limitations under the License.
 #include "core/platform/env.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
+#include <sched.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <stdio.h>
@@ -31,8 +33,11 @@ limitations under the License.
 #endif
 #include <unistd.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -124,6 +129,89 @@ struct Freer {
 
 using MallocdStringPtr = std::unique_ptr<char, Freer<char> >;
 
+#if defined(__linux__) && !defined(__ANDROID__)
+struct NumaTopology {
+  // logical processors of each node
+  std::vector<LogicalProcessors> nodes;
+  // index in nodes of the node of each logical processor, -1 for the processors the process can not run on
+  std::vector<int> processor_nodes;
+};
+
+// Parses a sysfs cpu list such as "0-3,8-11". Returns false if it is malformed.
+bool ParseCpuList(const std::string& cpu_list, LogicalProcessors& processors) {
+  std::istringstream in(cpu_list);
+  std::string range;
+  while (std::getline(in, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    const auto dash = range.find('-');
+    char* end = nullptr;
+    const long first = strtol(range.c_str(), &end, 10);
+    const long last = dash == std::string::npos ? first : strtol(range.c_str() + dash + 1, &end, 10);
+    if (first < 0 || last < first) {
+      return false;
+    }
+    for (long id = first; id <= last; ++id) {
+      processors.push_back(static_cast<int>(id));
+    }
+  }
+  return true;
+}
+
+NumaTopology ReadNumaTopology() {
+  NumaTopology topology;
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return topology;
+  }
+
+  std::vector<int> node_ids;
+  if (DIR* dir = opendir("/sys/devices/system/node")) {
+    while (const dirent* entry = readdir(dir)) {
+      int node_id = -1;
+      if (strncmp(entry->d_name, "node", 4) == 0 && sscanf(entry->d_name + 4, "%d", &node_id) == 1) {
+        node_ids.push_back(node_id);
+      }
+    }
+    closedir(dir);
+  }
+  std::sort(node_ids.begin(), node_ids.end());
+
+  for (const int node_id : node_ids) {
+    std::ifstream in("/sys/devices/system/node/node" + std::to_string(node_id) + "/cpulist");
+    std::string cpu_list;
+    LogicalProcessors processors;
+    if (!std::getline(in, cpu_list) || !ParseCpuList(cpu_list, processors)) {
+      return NumaTopology();
+    }
+    LogicalProcessors allowed_processors;
+    for (const int id : processors) {
+      if (id < CPU_SETSIZE && CPU_ISSET(id, &allowed)) {
+        allowed_processors.push_back(id);
+      }
+    }
+    if (allowed_processors.empty()) {
+      continue;
+    }
+    for (const int id : allowed_processors) {
+      if (static_cast<size_t>(id) >= topology.processor_nodes.size()) {
+        topology.processor_nodes.resize(static_cast<size_t>(id) + 1, -1);
+      }
+      topology.processor_nodes[id] = static_cast<int>(topology.nodes.size());
+    }
+    topology.nodes.push_back(std::move(allowed_processors));
+  }
+  return topology;
+}
+
+const NumaTopology& GetNumaTopology() {
+  static const NumaTopology topology = ReadNumaTopology();
+  return topology;
+}
+#endif  // defined(__linux__) && !defined(__ANDROID__)
+
 class PosixThread : public EnvThread {
  private:
   struct Param {
@@ -308,6 +396,18 @@ class PosixEnv : public Env {
     return ret;
   }
 
+#if defined(__linux__) && !defined(__ANDROID__)
+  std::vector<LogicalProcessors> GetNumaNodes() const override {
+    return GetNumaTopology().nodes;
+  }
+
+  int GetCurrentNumaNode() const override {
+    const auto& processor_nodes = GetNumaTopology().processor_nodes;
+    const int cpu = sched_getcpu();
+    return cpu >= 0 && static_cast<size_t>(cpu) < processor_nodes.size() ? processor_nodes[cpu] : -1;
+  }
+#endif
+
   int GetL2CacheSize() const override {
 #ifdef _SC_LEVEL2_CACHE_SIZE
     return static_cast<int>(sysconf(_SC_LEVEL2_CACHE_SIZE));
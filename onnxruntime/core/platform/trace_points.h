@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// Static trace points of the runtime, for system-wide tracers to correlate the activity of onnxruntime with the rest
+// of the process and the system. Their arguments must be cheap to evaluate, e.g. integers and existing C strings.
+//
+// Backends:
+// - Linux and Android builds with ORT_USE_USDT_TRACE_POINTS: USDT probes of the "onnxruntime" provider, from
+//   <sys/sdt.h>. A probe is a single nop until a tracer attaches to it, e.g. `perf probe sdt_onnxruntime:node_start`,
+//   bpftrace `usdt:libonnxruntime.so:onnxruntime:node_start` or LTTng's userspace probes.
+//   List them with `readelf -n libonnxruntime.so`.
+// - Windows builds with ONNXRUNTIME_ENABLE_INSTRUMENT: TraceLogging events of the ETW provider of core/platform/tracing.h.
+// - Otherwise the trace points compile to nothing.
+//
+// Trace points:
+//   node_start(node_index, op_type, node_name) / node_end(node_index, op_type): a kernel is computed.
+//   parallel_section_start(thread_pool) / parallel_section_end(thread_pool): a thread pool parallel section.
+//   arena_extend(arena_name, bytes, total_allocated_bytes): a BFC arena allocates a new region.
+//   memcpy(src_device_type, dst_device_type, bytes): a tensor is copied by the data transfer manager.
+
+#if defined(ORT_USE_USDT_TRACE_POINTS) && (defined(__linux__) || defined(__ANDROID__)) && __has_include(<sys/sdt.h>)
+
+#include <sys/sdt.h>
+
+#define ORT_TRACE_NODE_START(node_index, op_type, node_name)                                                           \
+  DTRACE_PROBE3(onnxruntime, node_start, node_index, op_type, node_name)
+#define ORT_TRACE_NODE_END(node_index, op_type) DTRACE_PROBE2(onnxruntime, node_end, node_index, op_type)
+#define ORT_TRACE_PARALLEL_SECTION_START(thread_pool) DTRACE_PROBE1(onnxruntime, parallel_section_start, thread_pool)
+#define ORT_TRACE_PARALLEL_SECTION_END(thread_pool) DTRACE_PROBE1(onnxruntime, parallel_section_end, thread_pool)
+#define ORT_TRACE_ARENA_EXTEND(arena_name, bytes, total_allocated_bytes)                                               \
+  DTRACE_PROBE3(onnxruntime, arena_extend, arena_name, bytes, total_allocated_bytes)
+#define ORT_TRACE_MEMCPY(src_device_type, dst_device_type, bytes)                                                      \
+  DTRACE_PROBE3(onnxruntime, memcpy, src_device_type, dst_device_type, bytes)
+
+#elif defined(_WIN32) && defined(ONNXRUNTIME_ENABLE_INSTRUMENT)
+
+#include "core/platform/tracing.h"
+
+#define ORT_TRACE_NODE_START(node_index, op_type, node_name)                                                           \
+  TraceLoggingWrite(telemetry_provider_handle, "NodeStart", TraceLoggingValue(node_index, "node_index"),               \
+                    TraceLoggingValue(op_type, "op_type"), TraceLoggingValue(node_name, "node_name"))
+#define ORT_TRACE_NODE_END(node_index, op_type)                                                                        \
+  TraceLoggingWrite(telemetry_provider_handle, "NodeEnd", TraceLoggingValue(node_index, "node_index"),                 \
+                    TraceLoggingValue(op_type, "op_type"))
+#define ORT_TRACE_PARALLEL_SECTION_START(thread_pool)                                                                  \
+  TraceLoggingWrite(telemetry_provider_handle, "ParallelSectionStart", TraceLoggingPointer(thread_pool, "thread_pool"))
+#define ORT_TRACE_PARALLEL_SECTION_END(thread_pool)                                                                    \
+  TraceLoggingWrite(telemetry_provider_handle, "ParallelSectionEnd", TraceLoggingPointer(thread_pool, "thread_pool"))
+#define ORT_TRACE_ARENA_EXTEND(arena_name, bytes, total_allocated_bytes)                                               \
+  TraceLoggingWrite(telemetry_provider_handle, "ArenaExtend", TraceLoggingValue(arena_name, "arena_name"),             \
+                    TraceLoggingValue(static_cast<uint64_t>(bytes), "bytes"),                                          \
+                    TraceLoggingValue(static_cast<int64_t>(total_allocated_bytes), "total_allocated_bytes"))
+#define ORT_TRACE_MEMCPY(src_device_type, dst_device_type, bytes)                                                      \
+  TraceLoggingWrite(telemetry_provider_handle, "Memcpy", TraceLoggingValue(src_device_type, "src_device_type"),        \
+                    TraceLoggingValue(dst_device_type, "dst_device_type"),                                             \
+                    TraceLoggingValue(static_cast<uint64_t>(bytes), "bytes"))
+
+#else
+
+#define ORT_TRACE_NODE_START(node_index, op_type, node_name)
+#define ORT_TRACE_NODE_END(node_index, op_type)
+#define ORT_TRACE_PARALLEL_SECTION_START(thread_pool)
+#define ORT_TRACE_PARALLEL_SECTION_END(thread_pool)
+#define ORT_TRACE_ARENA_EXTEND(arena_name, bytes, total_allocated_bytes)
+#define ORT_TRACE_MEMCPY(src_device_type, dst_device_type, bytes)
+
+#endif
@@ -17,6 +17,7 @@ class CoreMLOptions {
   std::string strategy_;
   bool profile_compute_plan_{false};
   bool allow_low_precision_accumulation_on_gpu_{false};
+  bool load_model_in_background_{false};
   // path to store the converted coreml model
   // we may run DisableModelCache() to disable model caching
   mutable std::string model_cache_directory_;
@@ -34,6 +35,7 @@ class CoreMLOptions {
   bool AllowLowPrecisionAccumulationOnGPU() const { return allow_low_precision_accumulation_on_gpu_; }
   bool UseStrategy(std::string_view strategy) const { return strategy_ == strategy; }
   bool ProfileComputePlan() const { return profile_compute_plan_ && create_mlprogram_; }
+  bool LoadModelInBackground() const { return load_model_in_background_; }
 
   std::string_view ModelCacheDirectory() const { return model_cache_directory_; }
   // The options specified by the user are const, but if there's an error setting up caching we disable it
@@ -455,11 +455,17 @@ class Execution {
 
  private:
   void cleanup();
+  void LoadModelInBackground(MLModelConfiguration* config);
   NSString* coreml_model_path_{nil};
   NSURL* compiled_model_url_{nil};
   const logging::Logger& logger_;
   CoreMLOptions coreml_options_;
   MLModel* model_{nil};
+
+  // The model loaded on a background queue, which replaces model_ in the next Predict.
+  dispatch_group_t background_load_group_{nil};
+  std::mutex background_model_mutex_;
+  MLModel* background_model_{nil};
 };
 
 Execution::Execution(const std::string& path, const logging::Logger& logger, const CoreMLOptions& coreml_options)
@@ -472,6 +478,10 @@ Execution::Execution(const std::string& path, const logging::Logger& logger, con
 
 Execution::~Execution() {
   @autoreleasepool {
+    // the background load reads the compiled model that cleanup removes
+    if (background_load_group_ != nil) {
+      dispatch_group_wait(background_load_group_, DISPATCH_TIME_FOREVER);
+    }
     cleanup();
   }
 }
@@ -560,13 +570,26 @@ Status Execution::LoadModel() {
         }
       }
 
-      model_ = [MLModel modelWithContentsOfURL:compiled_model_url_ configuration:config error:&error];
+      MLModelConfiguration* load_config = config;
+      const bool load_in_background = coreml_options_.LoadModelInBackground() &&
+                                      config.computeUnits != MLComputeUnitsCPUOnly;
+      if (load_in_background) {
+        // the CPU only model loads quickly and runs until the model for the configured compute units is loaded
+        load_config = [config copy];
+        load_config.computeUnits = MLComputeUnitsCPUOnly;
+      }
+
+      model_ = [MLModel modelWithContentsOfURL:compiled_model_url_ configuration:load_config error:&error];
 
       if (error != nil || model_ == nil) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create MLModel",
                                (error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String]) : "");
       }
 
+      if (load_in_background) {
+        LoadModelInBackground(config);
+      }
+
       return Status::OK();
     }
   }
@@ -574,6 +597,26 @@ Status Execution::LoadModel() {
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+");
 }
 
+void Execution::LoadModelInBackground(MLModelConfiguration* config) {
+  background_load_group_ = dispatch_group_create();
+  NSURL* compiled_model_url = compiled_model_url_;
+  dispatch_group_async(background_load_group_, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    @autoreleasepool {
+      NSError* error = nil;
+      MLModel* model = [MLModel modelWithContentsOfURL:compiled_model_url configuration:config error:&error];
+      if (error != nil || model == nil) {
+        LOGS(logger_, WARNING) << "Failed to load the CoreML model in the background, it keeps running on the CPU"
+                               << ((error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String])
+                                                  : "");
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(background_model_mutex_);
+      background_model_ = model;
+    }
+  });
+}
+
 Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>& inputs,
                           const std::unordered_map<std::string, OnnxTensorInfo>& outputs,
                           const GetOutputTensorMutableRawDataFn& get_output_tensor_mutable_raw_data_fn) {
@@ -581,6 +624,15 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
     @autoreleasepool {
       Status status = Status::OK();
       ORT_TRY {
+        if (background_load_group_ != nil) {
+          std::lock_guard<std::mutex> lock(background_model_mutex_);
+          if (background_model_ != nil) {
+            LOGS(logger_, VERBOSE) << "Switching to the CoreML model loaded in the background";
+            model_ = background_model_;
+            background_model_ = nil;
+          }
+        }
+
         if (model_ == nil) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Model is not loaded");
         }
@@ -12,6 +12,8 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include "core/common/inlined_containers.h"
+#include "core/common/safeint.h"
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -193,6 +195,20 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // 'cond' can be passed through directly or with an Identity node
+  const auto& condition_input_name = subgraph_input_names[1];
+  const auto* condition_producer = subgraph.GetProducerNode(subgraph_output_names[0]);
+  condition_is_loop_invariant = subgraph_output_names[0] == condition_input_name ||
+                                (condition_producer != nullptr && condition_producer->OpType() == "Identity" &&
+                                 condition_producer->InputDefs()[0]->Name() == condition_input_name);
+
+  InlinedHashSet<std::string_view> output_names;
+  outputs_can_be_preallocated = true;
+  for (int i = 1; i < num_subgraph_outputs && outputs_can_be_preallocated; ++i) {
+    const auto& name = subgraph_output_names[i];
+    outputs_can_be_preallocated = output_names.insert(name).second && subgraph.GetProducerNode(name) != nullptr;
+  }
 }
 
 class LoopImpl {
@@ -216,6 +232,15 @@ class LoopImpl {
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // allocate the Loop outputs for the scan outputs of all the iterations, using the shapes of the first iteration,
+  // and copy in the first iteration values
+  Status AllocateScanOutputs(const std::vector<OrtValue>& first_outputs, int64_t num_iterations);
+
+  // add the slices of the Loop outputs for the scan outputs of an iteration to its fetches
+  void AddScanOutputFetches(int64_t iteration, std::vector<OrtValue>& fetches) const;
+
+  Status CopyTensor(const Tensor& src, Tensor& dst);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -232,6 +257,11 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // when the number of iterations is known up front the scan outputs are written directly into the Loop outputs.
+  // Loop output tensor and size of an iteration slice in bytes, for each scan output.
+  bool scan_outputs_preallocated_ = false;
+  std::vector<std::pair<Tensor*, size_t>> scan_outputs_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -465,6 +495,10 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
     next_inputs[i] = last_outputs[i - 1];
   }
 
+  if (scan_outputs_preallocated_) {
+    return;
+  }
+
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
@@ -492,6 +526,59 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+Status LoopImpl::CopyTensor(const Tensor& src, Tensor& dst) {
+  // Safely use the IDataTransfer abstraction as we only allow using
+  // Loop on CUDA if the copy stream is the same as the compute stream.
+  // So there is no explicit sync required between the compute and copy streams
+  // to avoid data races.
+  auto* data_transfer = session_state_.GetDataTransferMgr().GetDataTransfer(src.Location().device,
+                                                                           dst.Location().device);
+  if (context_.GetComputeStream()) {
+    return data_transfer->CopyTensorAsync(src, dst, *context_.GetComputeStream());
+  }
+
+  return data_transfer->CopyTensor(src, dst);
+}
+
+Status LoopImpl::AllocateScanOutputs(const std::vector<OrtValue>& first_outputs, int64_t num_iterations) {
+  scan_outputs_.reserve(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    const auto& first_output = first_outputs[static_cast<ptrdiff_t>(i) + 1];  // skip cond
+    ORT_RETURN_IF_NOT(first_output.IsTensor(), "All scan outputs MUST be tensors");
+    const auto& first_tensor = first_output.Get<Tensor>();
+    const auto per_iteration_dims = first_tensor.Shape().GetDims();
+
+    TensorShapeVector dims;
+    dims.reserve(1 + per_iteration_dims.size());
+    dims.push_back(num_iterations);
+    dims.insert(dims.end(), per_iteration_dims.begin(), per_iteration_dims.end());
+
+    Tensor* output = context_.Output(i, TensorShape(dims));
+    const size_t bytes_per_iteration = first_tensor.SizeInBytes();
+    scan_outputs_.emplace_back(output, bytes_per_iteration);
+
+    Tensor first_slice(first_tensor.DataType(), first_tensor.Shape(), output->MutableDataRaw(), output->Location());
+    ORT_RETURN_IF_ERROR(CopyTensor(first_tensor, first_slice));
+  }
+
+  scan_outputs_preallocated_ = true;
+  return Status::OK();
+}
+
+void LoopImpl::AddScanOutputFetches(int64_t iteration, std::vector<OrtValue>& fetches) const {
+  // cond and the loop carried vars are allocated by the subgraph
+  fetches.resize(static_cast<size_t>(info_.num_loop_carried_vars) + 1);
+
+  for (const auto& [output, bytes_per_iteration] : scan_outputs_) {
+    // the slice has the shape of the output without the iterations dim
+    const auto dims = output->Shape().GetDims();
+    OrtValue slice;
+    Tensor::InitOrtValue(output->DataType(), TensorShape(dims.subspan(1)), output->MutableDataRaw(),
+                         output->Location(), slice, SafeInt<ptrdiff_t>(iteration) * bytes_per_iteration);
+    fetches.push_back(std::move(slice));
+  }
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
@@ -502,13 +589,43 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  // If the subgraph can't change the condition the last iteration is known up front. The scan outputs are allocated
+  // after the first iteration, which gives their shape, and the following iterations write directly into their
+  // slice of the Loop outputs. The last iteration writes the loop carried vars directly into the Loop outputs.
+  const bool write_outputs_in_place = info_.condition_is_loop_invariant && info_.outputs_can_be_preallocated &&
+                                      context_.Input<Tensor>(0) != nullptr;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  std::vector<bool> loop_carried_var_in_output(info_.num_loop_carried_vars, false);
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    if (scan_outputs_preallocated_) {
+      AddScanOutputFetches(iter_num_value, fetches);
+    }
+
+    if (write_outputs_in_place && iter_num_value == max_trip_count_ - 1) {
+      for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+        fetch_allocators[static_cast<size_t>(i) + 1] = [this, i, &loop_carried_var_in_output](
+                                                           const TensorShape& shape, const OrtDevice& location,
+                                                           OrtValue& ort_value, bool& allocated) {
+          Tensor* output = context_.Output(i, shape);
+          ORT_RETURN_IF(output == nullptr, "Failed to allocate output ", i, " of Loop.");
+          // if the output is on a different device the subgraph allocates the value and it is copied at the end
+          if (output->Location().device == location) {
+            ort_value = *context_.GetOutputMLValue(i);
+            allocated = true;
+            loop_carried_var_in_output[i] = true;
+          }
+          return Status::OK();
+        };
+      }
+    }
+
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
@@ -518,6 +635,10 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
     condition_mlvalue_ = fetches[0];
 
+    if (write_outputs_in_place && iter_num_value == 0) {
+      ORT_RETURN_IF_ERROR(AllocateScanOutputs(fetches, max_trip_count_));
+    }
+
     ++iter_num_value;
   }
 
@@ -589,11 +710,15 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   // copy to Loop output
   if (iter_num_value != 0) {
     for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+      if (loop_carried_var_in_output[i]) {
+        continue;
+      }
+
       // need to allocate Loop output and copy OrtValue from fetches
       ORT_RETURN_IF_ERROR(copy_mlvalue_to_output(fetches[static_cast<ptrdiff_t>(i) + 1], i, iter_num_value, *info_.loop_carried_vars_types[static_cast<ptrdiff_t>(i)]));  // skip cond
     }
 
-    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs && !scan_outputs_preallocated_; ++i) {
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -38,6 +38,13 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // the subgraph passes 'cond' through unchanged, so when 'M' is provided the number of iterations is known up front
+    bool condition_is_loop_invariant;
+
+    // every subgraph output other than 'cond' is a distinct value produced by a node of the subgraph, so it can be
+    // written into a buffer provided by the Loop
+    bool outputs_can_be_preallocated;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -11,12 +11,16 @@
 
 #include "core/providers/cpu/controlflow/scan_utils.h"
 
+#include <algorithm>
+
+#include "core/common/narrow.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/framework/session_options.h"
 
@@ -208,6 +212,18 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     feeds[num_variadic_inputs + i] = *implicit_inputs[i];
   }
 
+  // Without loop state variables the iterations are independent. Once the first iteration has allocated the outputs,
+  // the remaining iterations run in parallel, each executing the subgraph with its own slices of the inputs and
+  // outputs. This is limited to CPU as the iterations would otherwise share the compute stream.
+  concurrency::ThreadPool* iteration_thread_pool = nullptr;
+  if (num_loop_state_variables == 0 && seq_length > 2 && context.GetComputeStream() == nullptr) {
+    iteration_thread_pool = session_state.GetInterOpThreadPool();
+    if (iteration_thread_pool == nullptr) {
+      // nested parallel loops of the subgraph kernels share the workers, so the intra-op pool can be used as well
+      iteration_thread_pool = context.GetOperatorThreadPool();
+    }
+  }
+
   int64_t seq_no = 0;
   for (; seq_no < seq_length; ++seq_no) {
     for (int input = 0; input < num_variadic_inputs; ++input) {
@@ -287,6 +303,49 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     if (seq_no == 0) {
       // we only ever use custom allocators on the first iteration as the final output is always allocated during that
       fetch_allocators.clear();
+
+      if (concurrency::ThreadPool::DegreeOfParallelism(iteration_thread_pool) > 1 &&
+          std::all_of(output_iterators.begin(), output_iterators.end(),
+                      [](const std::unique_ptr<OutputIterator>& iterator) {
+                        return iterator->FinalOutputAllocated();
+                      })) {
+        ++seq_no;
+        break;
+      }
+    }
+  }
+
+  if (seq_no < seq_length) {
+    const auto num_iterations = onnxruntime::narrow<size_t>(seq_length - seq_no);
+    std::vector<std::vector<OrtValue>> iteration_feeds(num_iterations, feeds);
+    std::vector<std::vector<OrtValue>> iteration_fetches(num_iterations);
+
+    // the input and output slices of each iteration
+    for (size_t iteration = 0; iteration < num_iterations; ++iteration) {
+      for (int input = 0; input < num_variadic_inputs; ++input) {
+        auto& iterator = scan_input_stream_iterators[input];
+        iteration_feeds[iteration][input] = *iterator;
+        ++iterator;
+      }
+
+      iteration_fetches[iteration].reserve(num_variadic_outputs);
+      for (int output = 0; output < num_variadic_outputs; ++output) {
+        auto& iterator = *output_iterators[output];
+        iteration_fetches[iteration].push_back(*iterator);
+        ++iterator;
+      }
+    }
+
+    std::vector<Status> iteration_statuses(num_iterations);
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        iteration_thread_pool, onnxruntime::narrow<std::ptrdiff_t>(num_iterations), [&](std::ptrdiff_t iteration) {
+          iteration_statuses[iteration] = utils::ExecuteSubgraph(
+              session_state, ffm, iteration_feeds[iteration], iteration_fetches[iteration], {},
+              ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger(), nullptr);
+        });
+
+    for (const auto& iteration_status : iteration_statuses) {
+      ORT_RETURN_IF_ERROR(iteration_status);
     }
   }
 
@@ -4,10 +4,13 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 
 #include "core/framework/allocator_utils.h"
+#include "core/framework/numa_arena.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/large_page_allocator.h"
 #include "core/framework/int4.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
 
 #ifndef DISABLE_CONTRIB_OPS
 #include "contrib_ops/cpu/cpu_contrib_kernels.h"
@@ -28,13 +31,36 @@ struct KernelRegistryAndStatus {
 
 namespace onnxruntime {
 CPUExecutionProvider::CPUExecutionProvider(const CPUExecutionProviderInfo& info)
-    : IExecutionProvider{onnxruntime::kCpuExecutionProvider}, info_{info} {}
+    : IExecutionProvider{onnxruntime::kCpuExecutionProvider}, info_{info}, tuning_context_(this, &info_.tunable_op) {}
+
+ITuningContext* CPUExecutionProvider::GetTuningContext() const {
+  return static_cast<ITuningContext*>(&tuning_context_);
+}
 
 std::vector<AllocatorPtr> CPUExecutionProvider::CreatePreferredAllocators() {
   const bool create_arena = DoesCpuAllocatorSupportArenaUsage() ? info_.create_arena : false;
-  AllocatorCreationInfo device_info{[](int) { return std::make_unique<CPUAllocator>(); },
+  const bool use_large_pages = info_.use_large_pages;
+  AllocatorCreationInfo device_info{[use_large_pages](int) -> std::unique_ptr<IAllocator> {
+                                      if (use_large_pages) {
+                                        return std::make_unique<LargePageCPUAllocator>();
+                                      }
+                                      return std::make_unique<CPUAllocator>();
+                                    },
                                     DEFAULT_CPU_ALLOCATOR_DEVICE_ID, create_arena};
 
+  if (create_arena && info_.numa_aware_arena) {
+    const size_t num_numa_nodes = Env::Default().GetNumaNodes().size();
+    if (num_numa_nodes > 1) {
+      std::vector<AllocatorPtr> node_arenas;
+      node_arenas.reserve(num_numa_nodes);
+      for (size_t i = 0; i < num_numa_nodes; ++i) {
+        node_arenas.push_back(CreateAllocator(device_info));
+      }
+      return std::vector<AllocatorPtr>{std::make_shared<NumaArena>(
+          std::move(node_arenas), []() { return Env::Default().GetCurrentNumaNode(); })};
+    }
+  }
+
   return std::vector<AllocatorPtr>{CreateAllocator(device_info)};
 }
 
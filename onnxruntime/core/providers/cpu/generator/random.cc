@@ -28,7 +28,9 @@ limitations under the License.
 #include "core/common/eigen_common_wrapper.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math_cpuonly.h"
 
 using namespace ONNX_NAMESPACE;
@@ -132,12 +134,31 @@ void GenerateData(std::default_random_engine& generator, TDistribution distribut
 static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
 static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
 
+static Status RandomNormalCounterBasedCompute(float mean, float scale, PhiloxGenerator& generator,
+                                              concurrency::ThreadPool* thread_pool,
+                                              TensorProto::DataType dtype, Tensor& Y);
+static Status RandomUniformCounterBasedCompute(float low, float high, PhiloxGenerator& generator,
+                                               concurrency::ThreadPool* thread_pool,
+                                               TensorProto::DataType dtype, Tensor& Y);
+
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
 
+std::unique_ptr<PhiloxGenerator> CreateCounterBasedGenerator(const OpKernelInfo& info, uint32_t seed) {
+  if (info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCpuRandomCounterBased, "0") != "1") {
+    return nullptr;
+  }
+
+  return std::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
+}
+
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
+  if (philox_generator_) {
+    return RandomNormalCounterBasedCompute(mean_, scale_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype_, Y);
+  }
+
   std::lock_guard<std::mutex> l(generator_mutex_);
   auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
 
@@ -147,6 +168,10 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
+  if (philox_generator_) {
+    return RandomUniformCounterBasedCompute(low_, high_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype_, Y);
+  }
+
   std::lock_guard<std::mutex> l(generator_mutex_);
   auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
 
@@ -169,6 +194,10 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
+  if (philox_generator_) {
+    return RandomNormalCounterBasedCompute(mean_, scale_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype, *Y);
+  }
+
   std::lock_guard<std::mutex> l(generator_mutex_);
   status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
 
@@ -190,6 +219,11 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
+
+  if (philox_generator_) {
+    return RandomUniformCounterBasedCompute(low_, high_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype, *Y);
+  }
+
   std::lock_guard<std::mutex> l(generator_mutex_);
   status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
 
@@ -269,6 +303,81 @@ Status MultinomialComputeShared(AllocatorPtr& alloc,
   return Status::OK();
 }
 
+// Samples with the counter-based generator. Each batch row is sampled in parallel, and sample i of the output uses
+// one half of the random values of counter offset + i / 2, so the samples do not depend on the number of threads.
+template <typename OutputType>
+static Status MultinomialCounterBasedCompute(OpKernelContext* ctx,
+                                             const Tensor& X,
+                                             const int64_t batch_size,
+                                             const int64_t num_classes,
+                                             const int64_t num_samples,
+                                             PhiloxGenerator& generator,
+                                             Tensor& Y) {
+  if (!utils::HasType<EnabledMultinomialOutputTypes, OutputType>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build.");
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto cdf_data = static_cast<double*>(alloc->Alloc(SafeInt<size_t>(sizeof(double)) * batch_size * num_classes));
+  BufferUniquePtr cdf_buffer(cdf_data, BufferDeleter(std::move(alloc)));
+
+  const uint64_t total_samples = SafeInt<uint64_t>(batch_size) * num_samples;
+  const auto seeds = generator.NextPhiloxSeeds((total_samples + 1) / 2);
+  const PhiloxEngine engine(seeds.first);
+  const uint64_t offset = seeds.second;
+
+  const float* logits = X.Data<float>();
+  OutputType* output = Y.MutableData<OutputType>();
+
+  const TensorOpCost cost{static_cast<double>(num_classes * sizeof(float)),
+                          static_cast<double>(num_samples * sizeof(OutputType)),
+                          static_cast<double>(num_classes * 20 + num_samples * 40)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const float* logits_row = logits + b * num_classes;
+          double* cdf = cdf_data + b * num_classes;
+
+          // Takes an along-class maximum (for numerical stability).
+          float maxx = std::numeric_limits<float>::lowest();
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (Eigen::numext::isfinite(logits_row[j])) {
+              maxx = std::max(maxx, logits_row[j]);
+            }
+          }
+          const auto max_logit = static_cast<double>(maxx);
+
+          // Precompute cumulative probability distribution across classes.
+          // Note: This isn't normalized.
+          double running_total = 0;
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (Eigen::numext::isfinite(logits_row[j])) {
+              running_total += std::exp(static_cast<double>(logits_row[j]) - max_logit);
+            }
+            cdf[j] = running_total;
+          }
+
+          // Generate each sample.
+          PhiloxEngine::ResultType values{};
+          for (int64_t j = 0; j < num_samples; ++j) {
+            const uint64_t sample_index = static_cast<uint64_t>(b * num_samples + j);
+            if (j == 0 || sample_index % 2 == 0) {
+              values = engine(offset + sample_index / 2);
+            }
+            const size_t lane = static_cast<size_t>(sample_index % 2) * 2;
+            const double to_find = PhiloxEngine::ToUniformDouble(values[lane], values[lane + 1]) * running_total;
+            auto found_iter = std::upper_bound(cdf, cdf + num_classes, to_find);
+            output[b * num_samples + j] = static_cast<OutputType>(std::distance(cdf, found_iter));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
 template <typename OutputType>
 static Status MultinomialCompute(OpKernelContext* ctx,
                                  const Tensor& X,
@@ -310,6 +419,20 @@ Status Multinomial::Compute(OpKernelContext* ctx) const {
   Tensor* Y = ctx->Output(0, {batch_size, num_samples_});
 
   Status status = Status::OK();
+
+  if (philox_generator_) {
+    switch (output_dtype_) {
+      case TensorProto::INT32:
+        return MultinomialCounterBasedCompute<int32_t>(ctx, X, batch_size, num_classes, num_samples_,
+                                                       *philox_generator_, *Y);
+      case TensorProto::INT64:
+        return MultinomialCounterBasedCompute<int64_t>(ctx, X, batch_size, num_classes, num_samples_,
+                                                       *philox_generator_, *Y);
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid data type of ", output_dtype_);
+    }
+  }
+
   std::lock_guard<std::mutex> l(generator_mutex_);
   switch (output_dtype_) {
     case TensorProto::INT32: {
@@ -420,6 +543,164 @@ void GenerateData(std::default_random_engine& generator, TDistribution distribut
   }
 }
 
+// Generates the values of the tensor with the counter-based generator. The four random values of counter
+// offset + i are transformed to the values [i * N, (i + 1) * N) of the tensor, with N = 4 for float and N = 2 for
+// double, so the counters are generated in parallel and the values do not depend on the number of threads.
+template <typename T, typename TTransform>
+static void GenerateCounterBasedData(PhiloxGenerator& generator, concurrency::ThreadPool* thread_pool,
+                                     double cost_per_counter, TTransform transform, Tensor& tensor) {
+  constexpr int64_t kValuesPerCounter = sizeof(PhiloxEngine::ResultType) / sizeof(T);
+
+  const int64_t size = tensor.Shape().Size();
+  const int64_t counter_count = (size + kValuesPerCounter - 1) / kValuesPerCounter;
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(counter_count));
+  const PhiloxEngine engine(seeds.first);
+  const uint64_t offset = seeds.second;
+  T* out = tensor.MutableData<T>();
+
+  const TensorOpCost cost{0, static_cast<double>(sizeof(PhiloxEngine::ResultType)), cost_per_counter};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(counter_count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          T values[kValuesPerCounter];
+          transform(engine(offset + static_cast<uint64_t>(i)), values);
+
+          const int64_t begin = i * kValuesPerCounter;
+          std::copy_n(values, std::min(kValuesPerCounter, size - begin), out + begin);
+        }
+      });
+}
+
+// Transforms the random values of a counter to uniformly distributed values in [low, high).
+template <typename T>
+struct CounterBasedUniformTransform;
+
+template <>
+struct CounterBasedUniformTransform<float> {
+  float low;
+  float range;
+
+  void operator()(const PhiloxEngine::ResultType& bits, float* values) const {
+    for (size_t i = 0; i < 4; ++i) {
+      values[i] = low + range * PhiloxEngine::ToUniformFloat(bits[i]);
+    }
+  }
+};
+
+template <>
+struct CounterBasedUniformTransform<double> {
+  double low;
+  double range;
+
+  void operator()(const PhiloxEngine::ResultType& bits, double* values) const {
+    values[0] = low + range * PhiloxEngine::ToUniformDouble(bits[0], bits[1]);
+    values[1] = low + range * PhiloxEngine::ToUniformDouble(bits[2], bits[3]);
+  }
+};
+
+// Transforms the random values of a counter to normally distributed values with the Box-Muller transform.
+// The first uniform value of each pair is mapped to (0, 1] so that its logarithm is finite.
+template <typename T>
+struct CounterBasedNormalTransform;
+
+template <>
+struct CounterBasedNormalTransform<float> {
+  float mean;
+  float scale;
+
+  void operator()(const PhiloxEngine::ResultType& bits, float* values) const {
+    for (size_t i = 0; i < 4; i += 2) {
+      const float radius = std::sqrt(-2.0f * std::log(1.0f - PhiloxEngine::ToUniformFloat(bits[i])));
+      const float angle = 6.28318530717958647692f * PhiloxEngine::ToUniformFloat(bits[i + 1]);
+      values[i] = mean + scale * radius * std::cos(angle);
+      values[i + 1] = mean + scale * radius * std::sin(angle);
+    }
+  }
+};
+
+template <>
+struct CounterBasedNormalTransform<double> {
+  double mean;
+  double scale;
+
+  void operator()(const PhiloxEngine::ResultType& bits, double* values) const {
+    const double radius = std::sqrt(-2.0 * std::log(1.0 - PhiloxEngine::ToUniformDouble(bits[0], bits[1])));
+    const double angle = 6.28318530717958647692 * PhiloxEngine::ToUniformDouble(bits[2], bits[3]);
+    values[0] = mean + scale * radius * std::cos(angle);
+    values[1] = mean + scale * radius * std::sin(angle);
+  }
+};
+
+// approximate number of cycles to generate and transform the values of a counter.
+constexpr double kCounterBasedUniformCost = 64.0;
+constexpr double kCounterBasedNormalCost = 256.0;
+
+static Status RandomNormalCounterBasedCompute(float mean, float scale, PhiloxGenerator& generator,
+                                              concurrency::ThreadPool* thread_pool,
+                                              TensorProto::DataType dtype, Tensor& Y) {
+  bool handled = false;
+  switch (dtype) {
+    case TensorProto::FLOAT: {
+      if (utils::HasType<EnabledRandomNormalComputeOutputTypes, float>()) {
+        GenerateCounterBasedData<float>(generator, thread_pool, kCounterBasedNormalCost,
+                                        CounterBasedNormalTransform<float>{mean, scale}, Y);
+        handled = true;
+      }
+      break;
+    }
+    case TensorProto::DOUBLE: {
+      if (utils::HasType<EnabledRandomNormalComputeOutputTypes, double>()) {
+        GenerateCounterBasedData<double>(generator, thread_pool, kCounterBasedNormalCost,
+                                         CounterBasedNormalTransform<double>{mean, scale}, Y);
+        handled = true;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!handled) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build: ", dtype);
+  }
+
+  return Status::OK();
+}
+
+static Status RandomUniformCounterBasedCompute(float low, float high, PhiloxGenerator& generator,
+                                               concurrency::ThreadPool* thread_pool,
+                                               TensorProto::DataType dtype, Tensor& Y) {
+  bool handled = false;
+  switch (dtype) {
+    case TensorProto::FLOAT: {
+      if (utils::HasType<EnabledRandomUniformComputeOutputTypes, float>()) {
+        GenerateCounterBasedData<float>(generator, thread_pool, kCounterBasedUniformCost,
+                                        CounterBasedUniformTransform<float>{low, high - low}, Y);
+        handled = true;
+      }
+      break;
+    }
+    case TensorProto::DOUBLE: {
+      if (utils::HasType<EnabledRandomUniformComputeOutputTypes, double>()) {
+        GenerateCounterBasedData<double>(generator, thread_pool, kCounterBasedUniformCost,
+                                         CounterBasedUniformTransform<double>{low, double(high) - double(low)}, Y);
+        handled = true;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!handled) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build: ", dtype);
+  }
+
+  return Status::OK();
+}
+
 template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
                                                   const Tensor& X,
                                                   const int64_t batch_size,
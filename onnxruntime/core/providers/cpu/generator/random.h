@@ -3,16 +3,22 @@
 
 #pragma once
 
+#include <memory>
 #include <random>
 #include <gsl/gsl>
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/random_generator.h"
 #include "core/framework/random_seed.h"
 #include <mutex>
 
 namespace onnxruntime {
 
+// Creates the counter-based generator that replaces std::default_random_engine if
+// kOrtSessionOptionsCpuRandomCounterBased is enabled in the session options, or returns nullptr.
+std::unique_ptr<PhiloxGenerator> CreateCounterBasedGenerator(const OpKernelInfo& info, uint32_t seed);
+
 template <typename OutputType>
 Status MultinomialComputeShared(AllocatorPtr& alloc,
                                 const Tensor& X,
@@ -30,12 +36,15 @@ class RandomNormal final : public OpKernel {
 
     // read optional seed attribute and generate if not provided
     float seed = 0.f;
+    uint32_t engine_seed;
     if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+      engine_seed = gsl::narrow_cast<uint32_t>(seed);
     } else {
       // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+      engine_seed = gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
     }
+    generator_ = std::default_random_engine{engine_seed};
+    philox_generator_ = CreateCounterBasedGenerator(info, engine_seed);
 
     int64_t dtype;
     ORT_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -59,6 +68,9 @@ class RandomNormal final : public OpKernel {
   // this is to ensure that a model with random generators is deterministic and still can be executed in parallel.
   mutable std::default_random_engine generator_;
   mutable std::mutex generator_mutex_;
+  // philox_generator_ replaces generator_ if the counter-based generator is enabled in the session options.
+  // it only reserves a range of counters per call to Compute(), and the values are generated in parallel without a lock.
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -71,12 +83,15 @@ class RandomNormalLike final : public OpKernel {
 
     // read optional seed attribute and generate if not provided
     float seed = 0.f;
+    uint32_t engine_seed;
     if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+      engine_seed = gsl::narrow_cast<uint32_t>(seed);
     } else {
       // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+      engine_seed = gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
     }
+    generator_ = std::default_random_engine{engine_seed};
+    philox_generator_ = CreateCounterBasedGenerator(info, engine_seed);
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -92,9 +107,10 @@ class RandomNormalLike final : public OpKernel {
   float mean_;
   float scale_;
 
-  // see comments for generator_ and generator_mutex_ in RandomNormal class.
+  // see comments for generator_, generator_mutex_ and philox_generator_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable std::mutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  // optional and may be inferred
 };
 
@@ -106,12 +122,15 @@ class RandomUniform final : public OpKernel {
 
     // read optional seed attribute and generate if not provided
     float seed = 0.f;
+    uint32_t engine_seed;
     if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+      engine_seed = gsl::narrow_cast<uint32_t>(seed);
     } else {
       // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+      engine_seed = gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
     }
+    generator_ = std::default_random_engine{engine_seed};
+    philox_generator_ = CreateCounterBasedGenerator(info, engine_seed);
 
     int64_t dtype;
     ORT_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -130,9 +149,10 @@ class RandomUniform final : public OpKernel {
   float high_;
   float low_;
 
-  // see comments for generator_ and generator_mutex_ in RandomNormal class.
+  // see comments for generator_, generator_mutex_ and philox_generator_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable std::mutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -144,12 +164,15 @@ class RandomUniformLike final : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("low", &low_).IsOK());
     // read optional seed attribute and generate if not provided
     float seed = 0.f;
+    uint32_t engine_seed;
     if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+      engine_seed = gsl::narrow_cast<uint32_t>(seed);
     } else {
       // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+      engine_seed = gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
     }
+    generator_ = std::default_random_engine{engine_seed};
+    philox_generator_ = CreateCounterBasedGenerator(info, engine_seed);
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -165,9 +188,10 @@ class RandomUniformLike final : public OpKernel {
   float high_;
   float low_;
 
-  // see comments for generator_ and generator_mutex_ in RandomNormal class.
+  // see comments for generator_, generator_mutex_ and philox_generator_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable std::mutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  // optional and may be inferred
 };
 
@@ -177,12 +201,15 @@ class Multinomial final : public OpKernel {
     ORT_ENFORCE(info.GetAttr<int64_t>("sample_size", &num_samples_).IsOK());
 
     float seed = 0.f;
+    uint32_t engine_seed;
     if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+      engine_seed = gsl::narrow_cast<uint32_t>(seed);
     } else {
       // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+      engine_seed = gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
     }
+    generator_ = std::default_random_engine{engine_seed};
+    philox_generator_ = CreateCounterBasedGenerator(info, engine_seed);
 
     int64_t output_dtype_tmp;
     if (!info.GetAttr<int64_t>("dtype", &output_dtype_tmp).IsOK()) {
@@ -199,9 +226,10 @@ class Multinomial final : public OpKernel {
  private:
   int64_t num_samples_;
 
-  // see comments for generator_ and generator_mutex_ in RandomNormal class.
+  // see comments for generator_, generator_mutex_ and philox_generator_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable std::mutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType output_dtype_;
 };
 }  // namespace onnxruntime
@@ -1,13 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <numeric>
 
 #include "cumsum.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
@@ -143,6 +147,46 @@ CumSum<T>::CumSum(const OpKernelInfo& info) : OpKernel(info), exclusive_(), reve
   }
 }
 
+namespace {
+// The columns of a slice are scanned in blocks, with the running sums of a block kept in a local buffer.
+constexpr int64_t kColumnBlockSize = 256;
+
+// Updates the running sums of the columns [first_column, first_column + num_columns) of a [dim, lower_dim_size] slice
+// with the rows [first_row, last_row) in scan order, writing them to the output.
+template <typename T>
+void ScanRows(const T* input, T* output, int64_t dim, int64_t lower_dim_size, int64_t first_row, int64_t last_row,
+              int64_t first_column, int64_t num_columns, bool exclusive, bool reverse, T* sums) {
+  for (int64_t k = first_row; k < last_row; ++k) {
+    const int64_t offset = (reverse ? dim - 1 - k : k) * lower_dim_size + first_column;
+    const T* input_row = input + offset;
+    T* output_row = output + offset;
+    if (exclusive) {
+      for (int64_t c = 0; c < num_columns; ++c) {
+        output_row[c] = sums[c];
+        sums[c] += input_row[c];
+      }
+    } else {
+      for (int64_t c = 0; c < num_columns; ++c) {
+        sums[c] += input_row[c];
+        output_row[c] = sums[c];
+      }
+    }
+  }
+}
+
+// Adds the rows [first_row, last_row) in scan order of the columns of a [dim, lower_dim_size] slice to 'sums'.
+template <typename T>
+void SumRows(const T* input, int64_t dim, int64_t lower_dim_size, int64_t first_row, int64_t last_row,
+             int64_t first_column, int64_t num_columns, bool reverse, T* sums) {
+  for (int64_t k = first_row; k < last_row; ++k) {
+    const T* input_row = input + (reverse ? dim - 1 - k : k) * lower_dim_size + first_column;
+    for (int64_t c = 0; c < num_columns; ++c) {
+      sums[c] += input_row[c];
+    }
+  }
+}
+}  // namespace
+
 template <typename T>
 Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const Tensor* input = ctx->Input<Tensor>(0);   // input tensor
@@ -166,8 +210,10 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   // 1) out[upper_dims...][0][lower_dims...] = 0
   // 2) out[upper_dims...][i][lower_dims...] =
   //      in[upper_dims...][i-1][lower_dims...] + out[upper_dims...][i-1][lower_dims...]
-  // we loop through the [upper_dims...] and start applying the identity in each slice
-  // since the [lower_dims...] are adjecent in memory, so we can add them like vectors
+  // the [upper_dims...] slices and blocks of the [lower_dims...] columns are independent so they are scanned in
+  // parallel. since the [lower_dims...] are adjacent in memory, the rows of a block are added like vectors.
+  // if there are fewer independent blocks than threads, the axis is also split: the sums of each part of the axis
+  // are computed first, so each part knows the sums it starts from and the parts can be scanned in parallel.
 
   const auto input_shape = input->Shape().GetDims();
   const size_t axis = onnxruntime::narrow<size_t>(axis_input);
@@ -177,70 +223,77 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const int64_t lower_dim_size =  // sizes of the slices we can treat as 1D arrays
       std::accumulate(input_shape.begin() + axis + 1, input_shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
 
-  if (!reverse_) {
-    const auto* input_iter = input->Data<T>();
-    auto* output_iter = output_tensor.MutableData<T>();
-    const auto* prev_output_iter = output_iter;
+  const T* input_data = input->Data<T>();
+  T* output_data = output_tensor.MutableData<T>();
+  const bool exclusive = exclusive_ != 0;
+  const bool reverse = reverse_ != 0;
 
-    if (exclusive_) {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = 0;
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-        input_iter += lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = *(input_iter++);
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
+  const int64_t slice_size = dim * lower_dim_size;
+  const int64_t num_column_blocks = (lower_dim_size + kColumnBlockSize - 1) / kColumnBlockSize;
+  const int64_t num_blocks = upper_dim_count * num_column_blocks;
+  const int64_t block_columns = std::min(lower_dim_size, kColumnBlockSize);
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(tp);
+
+  // parts of the axis of at least this many elements are worth scanning on another thread
+  constexpr int64_t kMinPartSize = 16 * 1024;
+  const int64_t num_axis_parts = num_blocks >= degree_of_parallelism
+                                     ? 1
+                                     : std::max<int64_t>(1, std::min(degree_of_parallelism / num_blocks,
+                                                                     dim * block_columns / kMinPartSize));
+  const auto part_begin = [dim, num_axis_parts](int64_t part) { return dim * part / num_axis_parts; };
+
+  // the running sums each part of the axis of each block starts from
+  std::vector<T> start_sums;
+  if (num_axis_parts > 1) {
+    start_sums.resize(onnxruntime::narrow<size_t>(num_blocks * num_axis_parts * block_columns), T{});
+    // the sums of the last part are not needed
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks * (num_axis_parts - 1)), [&](std::ptrdiff_t item) {
+          const int64_t block = item / (num_axis_parts - 1);
+          const int64_t part = item % (num_axis_parts - 1);
+          const int64_t first_column = (block % num_column_blocks) * kColumnBlockSize;
+          SumRows(input_data + (block / num_column_blocks) * slice_size, dim, lower_dim_size,
+                  part_begin(part), part_begin(part + 1), first_column,
+                  std::min(kColumnBlockSize, lower_dim_size - first_column), reverse,
+                  start_sums.data() + (block * num_axis_parts + part + 1) * block_columns);
+        });
+
+    for (int64_t block = 0; block < num_blocks; ++block) {
+      T* block_sums = start_sums.data() + block * num_axis_parts * block_columns;
+      for (int64_t part = 2; part < num_axis_parts; ++part) {
+        for (int64_t c = 0; c < block_columns; ++c) {
+          block_sums[part * block_columns + c] += block_sums[(part - 1) * block_columns + c];
         }
       }
     }
-  } else {
-    // in this case the logic is mostly the same, but we start from the end
-    const auto* input_iter = input->Data<T>() + input->Shape().Size();
-    auto* output_iter = output_tensor.MutableData<T>() + output_shape.Size();
-    const auto* prev_output_iter = output_iter;
-
-    if (exclusive_) {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = 0;
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-        input_iter -= lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = *(--input_iter);
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
+  }
+
+  const double bytes_per_item = static_cast<double>(dim / num_axis_parts * block_columns * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks * num_axis_parts),
+      TensorOpCost{bytes_per_item, bytes_per_item, bytes_per_item / sizeof(T)},
+      [&](std::ptrdiff_t first_item, std::ptrdiff_t last_item) {
+        std::array<T, kColumnBlockSize> sums;
+        for (std::ptrdiff_t item = first_item; item < last_item; ++item) {
+          const int64_t block = item / num_axis_parts;
+          const int64_t part = item % num_axis_parts;
+          const int64_t first_column = (block % num_column_blocks) * kColumnBlockSize;
+          const int64_t num_columns = std::min(kColumnBlockSize, lower_dim_size - first_column);
+          if (num_axis_parts > 1) {
+            std::copy_n(start_sums.data() + (block * num_axis_parts + part) * block_columns, num_columns,
+                        sums.begin());
+          } else {
+            std::fill_n(sums.begin(), num_columns, T{});
           }
+
+          const int64_t slice_offset = (block / num_column_blocks) * slice_size;
+          ScanRows(input_data + slice_offset, output_data + slice_offset, dim, lower_dim_size,
+                   part_begin(part), part_begin(part + 1), first_column, num_columns, exclusive, reverse,
+                   sums.data());
         }
-      }
-    }
-  }
+      });
 
   return Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::common;
 
@@ -34,14 +35,36 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
               size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+#ifdef MLAS_SUPPORTS_GEMM_DOUBLE
+  constexpr bool use_gemm_batch = std::is_same_v<T, float> || std::is_same_v<T, double>;
+#else
+  constexpr bool use_gemm_batch = std::is_same_v<T, float>;
+#endif
+  if constexpr (use_gemm_batch) {
+    // One batched call so that MLAS spreads the batches over the threads as well as the rows of each product
+    using DataParams = std::conditional_t<std::is_same_v<T, float>, MLAS_SGEMM_DATA_PARAMS, MLAS_DGEMM_DATA_PARAMS>;
+    InlinedVector<DataParams> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+      data[i].alpha = T(1);
+      data[i].beta = T(0);
+    }
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), num_batches, tp);
+  } else {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::MatMul<T>(
+          static_cast<int>(M),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          output_data + i * output_stride, tp);
+    }
   }
 
   return Status::OK();
@@ -5,6 +5,8 @@
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 
+#include <limits>
+
 namespace onnxruntime {
 
 template <typename T>
@@ -332,6 +334,57 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::GetContractionReducedDims(const std::vector<ContractionOperand>& operands,
+                                                               size_t left, size_t right,
+                                                               TensorShapeVector& reduced_dims) const {
+  const std::vector<int64_t>& subscript_indices_to_output_indices =
+      einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  const auto left_dims = operands[left].shape.GetDims();
+  const auto right_dims = operands[right].shape.GetDims();
+
+  // A dimension is summed over by the contraction if it is not in the op's output and is trivial
+  // in all the operands that are still to be contracted
+  reduced_dims.clear();
+  for (size_t dim = 0; dim < left_dims.size(); ++dim) {
+    if (subscript_indices_to_output_indices[dim] != -1 || (left_dims[dim] <= 1 && right_dims[dim] <= 1)) {
+      continue;
+    }
+    bool used_elsewhere = false;
+    for (size_t other = 0; other < operands.size() && !used_elsewhere; ++other) {
+      used_elsewhere = other != left && other != right && operands[other].shape[dim] > 1;
+    }
+    if (!used_elsewhere) {
+      reduced_dims.push_back(static_cast<int64_t>(dim));
+    }
+  }
+}
+
+template <typename T>
+void EinsumTypedComputeProcessor<T>::EstimateContraction(const std::vector<ContractionOperand>& operands,
+                                                         size_t left, size_t right,
+                                                         double& cost, double& output_size) const {
+  TensorShapeVector reduced_dims;
+  GetContractionReducedDims(operands, left, right, reduced_dims);
+
+  const auto left_dims = operands[left].shape.GetDims();
+  const auto right_dims = operands[right].shape.GetDims();
+
+  // The MatMul runs over every dimension of either operand, the output keeps the ones that are not reduced
+  cost = 1.0;
+  output_size = 1.0;
+  auto reduced_iter = reduced_dims.begin();
+  for (size_t dim = 0; dim < left_dims.size(); ++dim) {
+    const double dim_value = static_cast<double>(std::max(left_dims[dim], right_dims[dim]));
+    cost *= dim_value;
+    if (reduced_iter != reduced_dims.end() && *reduced_iter == static_cast<int64_t>(dim)) {
+      ++reduced_iter;
+    } else {
+      output_size *= dim_value;
+    }
+  }
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -398,27 +451,78 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   }
 
   // Process the operands in a pair-wise fashion
-  {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
-      TensorShapeVector reduced_dims;
-      reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
-      for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
-        }
+  if (num_inputs == 2) {
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
+    for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
+      if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == 1) {
+        // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
+        reduced_dims.push_back(dim);
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+    }
+    // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+    PairwiseOperandProcess(result ? *result : *raw_inputs[0],
+                           result ? result->Shape() : homogenized_input_dims[0],
+                           preprocessed_inputs[1] ? *preprocessed_inputs[1] : *raw_inputs[1],
+                           homogenized_input_dims[1],
+                           reduced_dims, true);
+    return Status::OK();
+  }
+
+  // With more operands the order of the pair-wise contractions decides the size of the intermediate results
+  // and the total cost, which can differ by orders of magnitude. Pick the pairs greedily, the cheapest
+  // contraction first, like the greedy path of opt_einsum.
+  ContractionOperand first_operand;
+  first_operand.shape = result ? result->Shape() : homogenized_input_dims[0];
+  first_operand.tensor = result ? result.get() : raw_inputs[0];
+  first_operand.owned = std::move(result);
+
+  std::vector<ContractionOperand> operands;
+  operands.reserve(static_cast<size_t>(num_inputs));
+  operands.push_back(std::move(first_operand));
+  for (int input = 1; input < num_inputs; ++input) {
+    ContractionOperand& operand = operands.emplace_back();
+    operand.tensor = preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input];
+    operand.shape = homogenized_input_dims[input];
+  }
+
+  while (operands.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 1;
+    if (operands.size() > 2) {
+      double best_cost = std::numeric_limits<double>::max();
+      double best_output_size = std::numeric_limits<double>::max();
+      for (size_t left = 0; left < operands.size(); ++left) {
+        for (size_t right = left + 1; right < operands.size(); ++right) {
+          double cost = 0.0;
+          double output_size = 0.0;
+          EstimateContraction(operands, left, right, cost, output_size);
+          if (cost < best_cost || (cost == best_cost && output_size < best_output_size)) {
+            best_cost = cost;
+            best_output_size = output_size;
+            best_left = left;
+            best_right = right;
+          }
+        }
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
+    }
+
+    TensorShapeVector reduced_dims;
+    GetContractionReducedDims(operands, best_left, best_right, reduced_dims);
+
+    const bool is_final_pair = operands.size() == 2;
+    std::unique_ptr<Tensor> output = PairwiseOperandProcess(*operands[best_left].tensor, operands[best_left].shape,
+                                                            *operands[best_right].tensor, operands[best_right].shape,
+                                                            reduced_dims, is_final_pair);
+
+    // right > left so erasing it first keeps the position of left
+    operands.erase(operands.begin() + best_right);
+    operands.erase(operands.begin() + best_left);
+    if (!is_final_pair) {
+      ContractionOperand& operand = operands.emplace_back();
+      operand.shape = output->Shape();
+      operand.tensor = output.get();
+      operand.owned = std::move(output);
     }
   }
 
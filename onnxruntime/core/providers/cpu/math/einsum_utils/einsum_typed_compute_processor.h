@@ -36,8 +36,24 @@ class EinsumTypedComputeProcessor {
   Status Run();
 
  private:
+  // An operand that is still to be contracted: a (pre-processed) input or an intermediate result,
+  // with its dims homogenized to the subscript indices of the equation
+  struct ContractionOperand {
+    const Tensor* tensor = nullptr;
+    TensorShape shape;
+    std::unique_ptr<const Tensor> owned;
+  };
+
   // Private methods -
 
+  // Dims reduced when contracting operands[left] with operands[right]
+  void GetContractionReducedDims(const std::vector<ContractionOperand>& operands, size_t left, size_t right,
+                                 TensorShapeVector& reduced_dims) const;
+
+  // Number of multiply-adds of contracting operands[left] with operands[right] and the size of the result
+  void EstimateContraction(const std::vector<ContractionOperand>& operands, size_t left, size_t right,
+                           double& cost, double& output_size) const;
+
   // Processes Einsum operands in a pair-wise fashion
   // Employs Transpose, ReduceSum, and MatMul under the hood
   // to achieve MatMul(a, b) and reduces (by summing) along specified axes
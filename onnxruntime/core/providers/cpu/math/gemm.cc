@@ -199,7 +199,7 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 
   if (c_data == nullptr)
     beta = onnxruntime::MLFloat16::Zero;
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_TARGET_AMD64)
   bool support_mlas = false;
   if (c_shape == nullptr) {
     support_mlas = true;
@@ -208,7 +208,8 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
   } else if (c_shape->NumDimensions() == 2 && (((*c_shape)[0] == 1 && (*c_shape)[1] == N) || ((*c_shape)[0] == N && (*c_shape)[1] == 1))) {
     support_mlas = true;
   }
-  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0) {
+  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0 &&
+      MlasHalfGemmAccelerationSupported()) {
     MLAS_HALF_GEMM_DATA_PARAMS data;
     data.A = a_data;
     data.lda = K;
@@ -418,6 +419,43 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
+  if (K > 0 && (mlas_activation_.has_value() || IsGemmBiasVector(N, beta_, c_shape))) {
+    // Add a bias vector and apply the fused activation to each block of the output as MLAS computes it,
+    // instead of broadcasting the bias and running the activation as separate passes over the output.
+    MLAS_SGEMM_EPILOGUE epilogue;
+    float beta = c_data != nullptr ? beta_ : 0.0f;
+    if (IsGemmBiasVector(N, beta_, c_shape)) {
+      epilogue.Bias = c_data;
+      beta = 0.0f;
+    } else {
+      GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    }
+    if (mlas_activation_.has_value()) {
+      epilogue.Activation = &*mlas_activation_;
+    }
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    if (B) {
+      data.B = B->Data<float>();
+      data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+    } else {
+      data.B = static_cast<const float*>(packed_b_.get());
+      data.BIsPacked = true;
+    }
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = beta;
+    data.Epilogue = &epilogue;
+    MlasGemmBatch(trans_A_, B ? trans_B_ : CblasNoTrans, static_cast<size_t>(M), static_cast<size_t>(N),
+                  static_cast<size_t>(K), &data, 1, thread_pool);
+
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
+  }
+
   if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
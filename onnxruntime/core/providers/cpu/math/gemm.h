@@ -9,6 +9,9 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <optional>
 
 namespace onnxruntime {
 
@@ -44,6 +47,9 @@ class Gemm : protected GemmBase, public OpKernel {
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // For fused gemm + activation that MLAS applies to the output blocks, only used by Gemm<float>
+  std::optional<MLAS_ACTIVATION> mlas_activation_;
+
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
 
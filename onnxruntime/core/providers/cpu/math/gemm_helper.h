@@ -88,6 +88,13 @@ class GemmHelper {
   Status status_;
 };
 
+// Whether C is a (N,) or (1, N) bias vector that is added to each row of the output as is.
+template <typename T>
+bool IsGemmBiasVector(ptrdiff_t N, T beta, _In_opt_ const TensorShape* c_shape) {
+  return beta == static_cast<T>(1) && c_shape != nullptr && c_shape->Size() == N &&
+         (c_shape->NumDimensions() == 1 || (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1));
+}
+
 template <typename T>
 void GemmBroadcastBias(ptrdiff_t M, ptrdiff_t N, T beta,
                        _In_opt_ const T* c_data, _In_opt_ const TensorShape* c_shape,
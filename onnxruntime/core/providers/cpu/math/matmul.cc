@@ -4,6 +4,7 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/sgemm.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -133,7 +134,7 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -172,6 +173,82 @@ bool GemmPackBBfloat16(AllocatorPtr& alloc,
 }
 #endif
 
+// Compresses a 2D weight matrix that has 2:4 structured sparsity along K.
+// Returns false, without allocating, if the weight is not 2:4 sparse.
+static bool GemmPackBSparse24(AllocatorPtr& alloc,
+                              const Tensor& tensor_b,
+                              bool trans_b,
+                              IAllocatorUniquePtr<void>& packed_b,
+                              size_t& packed_b_size,
+                              TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(tensor_b.Shape()[1]) : static_cast<size_t>(tensor_b.Shape()[0]);
+  const size_t N = trans_b ? static_cast<size_t>(tensor_b.Shape()[0]) : static_cast<size_t>(tensor_b.Shape()[1]);
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+
+  if (!MlasSparse24GemmCheckB(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N)) {
+    return false;
+  }
+
+  b_shape = tensor_b.Shape();
+  packed_b_size = MlasSparse24GemmPackBSize(N, K);
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  MlasSparse24GemmPackB(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N, packed_b.get());
+  return true;
+}
+
+// Compresses the transpose of a 2D weight matrix whose density is at most max_density to the blocked CSR format, so
+// that the sparse kernel computes Y^T = B^T * A^T. Rows of the transposed weight are grouped in blocks of 4 or 2 when
+// the blocks are at least half or three quarters full. Returns false, without allocating, if the weight is too dense.
+static bool GemmPackBSparseCsr(AllocatorPtr& alloc,
+                               const Tensor& tensor_b,
+                               bool trans_b,
+                               float max_density,
+                               IAllocatorUniquePtr<void>& packed_b,
+                               size_t& packed_b_size,
+                               size_t& block_m,
+                               size_t& block_count,
+                               TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(tensor_b.Shape()[1]) : static_cast<size_t>(tensor_b.Shape()[0]);
+  const size_t N = trans_b ? static_cast<size_t>(tensor_b.Shape()[0]) : static_cast<size_t>(tensor_b.Shape()[1]);
+  // the transposed weight is N x K
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasNoTrans : CblasTrans;
+  const float* b_data = tensor_b.Data<float>();
+  const size_t ldb = trans_b ? K : N;
+
+  const size_t non_zero_count = MlasSparseCsrGemmCountBlocks(trans, N, K, 1, b_data, ldb);
+  if (static_cast<double>(non_zero_count) > static_cast<double>(max_density) * static_cast<double>(N * K)) {
+    return false;
+  }
+
+  block_m = 1;
+  block_count = non_zero_count;
+  const size_t block_count_4 = MlasSparseCsrGemmCountBlocks(trans, N, K, 4, b_data, ldb);
+  if (block_count_4 * 4 <= non_zero_count * 2) {
+    block_m = 4;
+    block_count = block_count_4;
+  } else {
+    const size_t block_count_2 = MlasSparseCsrGemmCountBlocks(trans, N, K, 2, b_data, ldb);
+    if (block_count_2 * 4 <= non_zero_count * 3) {
+      block_m = 2;
+      block_count = block_count_2;
+    }
+  }
+
+  b_shape = tensor_b.Shape();
+  packed_b_size = MlasSparseCsrGemmPackASize(N, block_m, block_count);
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  MlasSparseCsrGemmPackA(trans, N, K, block_m, b_data, ldb, packed_b.get());
+  return true;
+}
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -180,22 +257,37 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
-    size_t dim1 = 0;
-    size_t dim2 = 0;
-    TensorShape b_shape = tensor.Shape();
-
-    if (b_shape.NumDimensions() == 2) {
-      dim1 = static_cast<size_t>(b_shape[0]);
-      dim2 = static_cast<size_t>(b_shape[1]);
+    // a very sparse weight is compressed to its non-zero values
+    if (use_sparse_csr_ && static_cast<size_t>(tensor.Shape().Size()) >= kSparse24KernelsizeThreshold) {
+      b_is_sparse_csr_ = GemmPackBSparseCsr(alloc, tensor, trans_b_attr_ != 0, sparse_csr_max_density_, packed_b_,
+                                            packed_b_size, sparse_csr_block_m_, sparse_csr_block_count_, b_shape_);
+      is_packed = b_is_sparse_csr_;
+    }
+
+    // a weight with 2:4 structured sparsity is compressed instead of being packed as dense
+    if (!is_packed && use_sparse24_ && static_cast<size_t>(tensor.Shape().Size()) >= kSparse24KernelsizeThreshold) {
+      b_is_sparse24_ = GemmPackBSparse24(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      is_packed = b_is_sparse24_;
     }
 
-    if (use_fastmath_mode_ && (trans_b_attr_ == 0) && ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
-      is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
-    } else
+    if (!is_packed) {
+#if defined(MLAS_SBGEMM_SUPPORTED)
+      size_t dim1 = 0;
+      size_t dim2 = 0;
+      TensorShape b_shape = tensor.Shape();
+
+      if (b_shape.NumDimensions() == 2) {
+        dim1 = static_cast<size_t>(b_shape[0]);
+        dim2 = static_cast<size_t>(b_shape[1]);
+      }
+
+      if (use_fastmath_mode_ && (trans_b_attr_ == 0) && ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
+        is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      } else
 #endif
-    {
-      is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      {
+        is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      }
     }
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
@@ -258,7 +350,59 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
+
+  if (b_is_sparse24_) {
+    // B is a 2D weight, so all the batches share the compressed weight
+    std::vector<MLAS_SPARSE24_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].PackedB = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+    }
+    MlasSparse24GemmBatch(M, N, K, data.data(), max_len, thread_pool);
+    return Status::OK();
+  }
+
+  if (b_is_sparse_csr_) {
+    // the sparse kernel computes Y^T = B^T * A^T, vectorized along M. A and Y are transposed through buffers unless
+    // they are vectors.
+    IAllocatorUniquePtr<float> a_transposed;
+    IAllocatorUniquePtr<float> y_transposed;
+    if (M > 1) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+      a_transposed = IAllocator::MakeUniquePtr<float>(alloc, K * M);
+      y_transposed = IAllocator::MakeUniquePtr<float>(alloc, N * M);
+    }
+
+    MLAS_SPARSE_CSR_GEMM_DATA_PARAMS data;
+    MlasSparseCsrGemmSetPackedA(N, sparse_csr_block_m_, sparse_csr_block_count_, packed_b_.get(), &data);
+    data.ldb = M;
+    data.ldc = M;
+    data.alpha = alpha_attr_;
+    for (size_t i = 0; i < max_len; i++) {
+      const float* a_batch = a_data + helper.LeftOffsets()[i];
+      float* y_batch = y_data + helper.OutputOffsets()[i];
+      if (M > 1) {
+        MlasTranspose(a_batch, a_transposed.get(), M, K);
+        data.B = a_transposed.get();
+        data.C = y_transposed.get();
+      } else {
+        data.B = a_batch;
+        data.C = y_batch;
+      }
+      MlasSparseCsrGemm(N, M, sparse_csr_block_m_, &data, thread_pool);
+      if (M > 1) {
+        MlasTranspose(y_transposed.get(), y_batch, N, M);
+      }
+    }
+    return Status::OK();
+  }
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
   if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
@@ -289,6 +433,23 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
+
+    const IExecutionProvider* ep = Info().GetExecutionProvider();
+    ITuningContext* tuning_ctx = ep->Type() == kCpuExecutionProvider ? ep->GetTuningContext() : nullptr;
+    if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+      cpu::tunable::SgemmParams params;
+      params.tuning_ctx = static_cast<cpu::tunable::CpuTuningContext*>(tuning_ctx);
+      params.trans_a = trans_a ? CblasTrans : CblasNoTrans;
+      params.trans_b = trans_b ? CblasTrans : CblasNoTrans;
+      params.m = M;
+      params.n = N;
+      params.k = K;
+      params.data = data.data();
+      params.batch = max_len;
+      params.thread_pool = thread_pool;
+      return cpu::tunable::SgemmBatch(&params);
+    }
+
     MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                   M, N, K, data.data(), max_len, thread_pool);
   }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/parse_string.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -30,9 +31,26 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
-#if defined(__aarch64__) && defined(__linux__)
+    // the sparse kernel doesn't transpose A
+    auto disable_sparse24 = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasDisableGemmSparse24, "0");
+    use_sparse24_ = (disable_sparse24 != "1") && trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_;
+
+    auto sparse_csr_max_density =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasGemmSparseCsrMaxDensity, "0.1");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(sparse_csr_max_density, sparse_csr_max_density_) &&
+                    sparse_csr_max_density_ >= 0.0f && sparse_csr_max_density_ <= 1.0f,
+                "Invalid value for ", kOrtSessionOptionsMlasGemmSparseCsrMaxDensity, ": ", sparse_csr_max_density);
+    use_sparse_csr_ = sparse_csr_max_density_ > 0.0f && trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_;
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+#if defined(MLAS_TARGET_AMD64)
+    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathAmd64Bfloat16);
+#else
     auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
-    use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
+#endif
+    // the sbgemm kernels don't transpose A or scale the output
+    use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported() &&
+                         trans_a_attr_ == 0 && alpha_attr_ == 1.0f;
 #endif
   }
 
@@ -56,10 +74,24 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
-#if defined(__aarch64__) && defined(__linux__)
+  // 2:4 sparse weight state
+  bool use_sparse24_;
+  bool b_is_sparse24_{false};
+  // checking and compressing the weight is only worth it for larger weights
+  const size_t kSparse24KernelsizeThreshold = 4096;
+
+  // unstructured sparse weight state. The packed weight is the transposed weight in the blocked CSR format, with
+  // row blocks of sparse_csr_block_m_ columns of the weight.
+  float sparse_csr_max_density_;
+  bool use_sparse_csr_;
+  bool b_is_sparse_csr_{false};
+  size_t sparse_csr_block_m_{1};
+  size_t sparse_csr_block_count_{0};
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
   // fastmath mode state
   bool use_fastmath_mode_;
-  // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
+  // the neon sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
   // so a minimum of 32 elements is defined to outweigh the additional prepacking overhead
   const size_t kFastMathModeKernelsizeThreshold = 32;
 #endif
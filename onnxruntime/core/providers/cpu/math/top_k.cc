@@ -140,6 +140,93 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Selects the top k elements of [start, end) into 'heap' using a heap of size k. 'end - start' must be at least k.
+// Blocks of values that can't replace the worst of the current top k are skipped with a branch free check
+// that the compiler can vectorize, which is the common case once the heap holds good values.
+template <class Comparator>
+static void SelectTopKInSlice(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                              int64_t start, int64_t end, const unsigned k, int64_t* heap) {
+  constexpr int64_t kFilterBlockSize = 16;
+
+  int64_t cur_idx = start;
+  for (size_t l = 0; l < k; ++l) {
+    heap[k - l - 1] = cur_idx++;
+    HeapifyIthPosition(heap, k - l - 1, k, comparer);
+  }
+
+  auto top = input_data[heap[0]];
+  for (; cur_idx + kFilterBlockSize <= end; cur_idx += kFilterBlockSize) {
+    const auto* block = input_data + cur_idx;
+    int replaces_top = 0;
+    for (int64_t l = 0; l < kFilterBlockSize; ++l) {
+      replaces_top |= static_cast<int>(comparer.CompareValueOnly(block[l], top));
+    }
+
+    if (replaces_top != 0) {
+      for (int64_t l = 0; l < kFilterBlockSize; ++l) {
+        if (comparer.CompareValueOnly(block[l], top)) {
+          heap[0] = cur_idx + l;
+          HeapifyIthPosition(heap, 0, k, comparer);
+          top = input_data[heap[0]];
+        }
+      }
+    }
+  }
+
+  for (; cur_idx < end; ++cur_idx) {
+    if (comparer.CompareValueOnly(input_data[cur_idx], top)) {
+      heap[0] = cur_idx;
+      HeapifyIthPosition(heap, 0, k, comparer);
+      top = input_data[heap[0]];
+    }
+  }
+}
+
+// Selects the top k elements of a few long rows along the innermost axis, e.g. the logits over a large vocabulary
+// when sampling. Splitting on rows would leave most of the threads idle, so each row is split into slices instead.
+// The top k of each slice are selected in parallel and the candidates of every row are then merged.
+template <class Comparator>
+static void FindTopKElementsInSlices(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                                     const unsigned k, bool sorted, int64_t slices_per_row,
+                                     EigenMatrixMapRowMajor<typename Comparator::DataType>& values_map,
+                                     EigenMatrixMapRowMajor<int64_t>& indices_map,
+                                     concurrency::ThreadPool* threadpool) {
+  std::vector<int64_t> candidates(SafeInt<size_t>(rows) * onnxruntime::narrow<size_t>(slices_per_row) * k);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<ptrdiff_t>(rows * slices_per_row),
+      [&](std::ptrdiff_t slice) {
+        const int64_t row = slice / slices_per_row;
+        auto work = concurrency::ThreadPool::PartitionWork(slice % slices_per_row,
+                                                           onnxruntime::narrow<size_t>(slices_per_row),
+                                                           onnxruntime::narrow<size_t>(cols));
+        Comparator comparer(input_data);
+        SelectTopKInSlice(comparer, input_data, row * cols + work.start, row * cols + work.end, k,
+                          candidates.data() + slice * k);
+      });
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<ptrdiff_t>(rows),
+      [&](std::ptrdiff_t row) {
+        Comparator comparer(input_data);
+        const int64_t row_offset = row * cols;
+        auto begin = candidates.begin() + row * slices_per_row * k;
+        auto end = begin + slices_per_row * k;
+
+        // the comparer breaks ties on the index, so the merge picks the same elements as a single pass over the row
+        std::nth_element(begin, begin + (k - 1), end, comparer);
+        if (sorted) {
+          std::sort(begin, begin + k, comparer);
+        }
+
+        for (size_t l = 0; l < k; ++l) {
+          const int64_t idx = begin[l];
+          values_map(row, l) = input_data[idx];
+          indices_map(row, l) = idx - row_offset;
+        }
+      });
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +252,18 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // a slice needs enough elements to amortize selecting k candidates from it and merging them
+  constexpr int64_t kMinSliceSize = 16 * 1024;
+  if (block_slice == 1 && rows < tp_threads) {
+    const int64_t slices_per_row = std::min((tp_threads + rows - 1) / rows,
+                                            num_blocks / std::max(kMinSliceSize, static_cast<int64_t>(4) * k));
+    if (slices_per_row > 1) {
+      FindTopKElementsInSlices<Comparator>(input_data, rows, cols, k, sorted, slices_per_row,
+                                           values_map, indices_map, threadpool);
+      return;
+    }
+  }
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
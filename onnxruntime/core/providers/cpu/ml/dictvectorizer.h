@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <numeric>
 #include <string>
 #include <vector>
 #include "core/common/common.h"
@@ -16,11 +18,35 @@ class DictVectorizerOp final : public OpKernel {
     // In some stupid models, the vocabulary could have duplicated elements.
     // We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+    sorted_vocabulary_indices_.resize(vocabulary_.size());
+    std::iota(sorted_vocabulary_indices_.begin(), sorted_vocabulary_indices_.end(), size_t{0});
+    std::stable_sort(sorted_vocabulary_indices_.begin(), sorted_vocabulary_indices_.end(),
+                     [this](size_t lhs, size_t rhs) { return vocabulary_[lhs] < vocabulary_[rhs]; });
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     const auto* map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto* Y = ctx->Output(0, {1, static_cast<int64_t>(vocabulary_.size())});
     auto* y_data = Y->MutableData<TargetType>();
+    if (map->size() <= 4 * vocabulary_.size()) {
+      // Walk the sorted map and the sorted vocabulary together instead of searching the map for every entry
+      // of the vocabulary. Any keys not present in the input dictionary, will be zero in the output array.
+      std::fill_n(y_data, vocabulary_.size(), TargetType());
+      auto entry = map->begin();
+      for (size_t index : sorted_vocabulary_indices_) {
+        const auto& key = vocabulary_[index];
+        while (entry != map->end() && entry->first < key) {
+          ++entry;
+        }
+        if (entry == map->end()) {
+          break;
+        }
+        if (!(key < entry->first)) {
+          y_data[index] = entry->second;
+        }
+      }
+      return Status::OK();
+    }
+
     for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
       auto index = map->find(vocabulary_[i]);
       if (index != map->end()) {
@@ -34,6 +60,7 @@ class DictVectorizerOp final : public OpKernel {
   }
 
   std::vector<AttrType> vocabulary_;
+  std::vector<size_t> sorted_vocabulary_indices_;
 };
 
 }  // namespace ml
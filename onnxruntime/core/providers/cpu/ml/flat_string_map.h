@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// Hash table from strings to values, built once when the kernel is created and only read afterwards.
+// The keys are copied into one contiguous buffer and the table uses open addressing with linear probing.
+// Every slot keeps bits of the hash of its key, so a probe almost never compares strings that differ and
+// finding a key touches a couple of cache lines instead of following the nodes of std::unordered_map.
+template <typename TValue>
+class FlatStringMap {
+ public:
+  FlatStringMap() = default;
+
+  // When a key is repeated, the first value is kept unless keep_last is true.
+  void Build(gsl::span<const std::string> keys, gsl::span<const TValue> values, bool keep_last = false) {
+    ORT_ENFORCE(keys.size() == values.size(), "FlatStringMap needs as many keys as values.");
+    ORT_ENFORCE(keys.size() < kEmpty, "FlatStringMap cannot hold ", keys.size(), " keys.");
+
+    arena_.clear();
+    offsets_.assign(1, 0);
+    values_.clear();
+    slots_.clear();
+    if (keys.empty()) {
+      return;
+    }
+
+    size_t arena_size = 0;
+    for (const auto& key : keys) {
+      arena_size += key.size();
+    }
+    arena_.reserve(arena_size);
+    offsets_.reserve(keys.size() + 1);
+    values_.reserve(keys.size());
+
+    // at most half full so the probe sequences stay short
+    size_t capacity = 8;
+    while (capacity < 2 * keys.size()) {
+      capacity *= 2;
+    }
+    slots_.assign(capacity, Slot{0, kEmpty});
+    mask_ = capacity - 1;
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const std::string_view key(keys[i]);
+      const size_t hash = Hash(key);
+      const uint32_t tag = Tag(hash);
+      size_t position = hash & mask_;
+      while (slots_[position].entry != kEmpty &&
+             !(slots_[position].tag == tag && KeyEquals(slots_[position].entry, key))) {
+        position = (position + 1) & mask_;
+      }
+      if (slots_[position].entry != kEmpty) {
+        if (keep_last) {
+          values_[slots_[position].entry] = values[i];
+        }
+        continue;
+      }
+      slots_[position] = Slot{tag, static_cast<uint32_t>(values_.size())};
+      arena_.append(key.data(), key.size());
+      offsets_.push_back(arena_.size());
+      values_.push_back(values[i]);
+    }
+  }
+
+  // Returns nullptr if the key is not in the map.
+  const TValue* Find(std::string_view key) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    const size_t hash = Hash(key);
+    const uint32_t tag = Tag(hash);
+    for (size_t position = hash & mask_;; position = (position + 1) & mask_) {
+      const Slot slot = slots_[position];
+      if (slot.entry == kEmpty) {
+        return nullptr;
+      }
+      if (slot.tag == tag && KeyEquals(slot.entry, key)) {
+        return &values_[slot.entry];
+      }
+    }
+  }
+
+  size_t size() const { return values_.size(); }
+
+  // Maps every input to its value or to default_value, the lookups are split between threads for large inputs.
+  template <typename TOutput>
+  void FindAll(gsl::span<const std::string> input, gsl::span<TOutput> output, const TOutput& default_value,
+               concurrency::ThreadPool* thread_pool) const {
+    ORT_ENFORCE(input.size() == output.size());
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, narrow<std::ptrdiff_t>(input.size()),
+        TensorOpCost{static_cast<double>(sizeof(std::string)) * 2, static_cast<double>(sizeof(TOutput)), 64.0},
+        [this, input, output, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const TValue* found = Find(input[i]);
+            output[i] = found == nullptr ? default_value : static_cast<TOutput>(*found);
+          }
+        });
+  }
+
+ private:
+  struct Slot {
+    uint32_t tag;
+    uint32_t entry;  // position in values_ and offsets_, kEmpty if the slot is free
+  };
+
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+
+  static size_t Hash(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+  // The low bits of the hash select the slot, the tag comes from the high bits.
+  static uint32_t Tag(size_t hash) {
+    return static_cast<uint32_t>(hash >> (sizeof(size_t) * 8 - 32));
+  }
+
+  bool KeyEquals(uint32_t entry, std::string_view key) const {
+    const size_t begin = offsets_[entry];
+    const size_t length = offsets_[entry + 1] - begin;
+    return length == key.size() && (length == 0 || std::memcmp(arena_.data() + begin, key.data(), length) == 0);
+  }
+
+  std::string arena_;
+  std::vector<size_t> offsets_{0};
+  std::vector<TValue> values_;
+  std::vector<Slot> slots_;
+  size_t mask_{0};
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
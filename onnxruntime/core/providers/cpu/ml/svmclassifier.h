@@ -30,6 +30,19 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // The RBF kernel is computed with a GEMM as ||x - s||^2 = ||x||^2 + ||s||^2 - 2 x.s,
+  // the squared norms of the support vectors are computed once.
+  void set_support_vectors(gsl::span<const float> support_vectors, ptrdiff_t feature_count) {
+    support_vector_norms_.clear();
+    if (kernel_type_ != KERNEL::RBF || feature_count == 0) {
+      return;
+    }
+    const auto vector_count = support_vectors.size() / static_cast<size_t>(feature_count);
+    support_vector_norms_.resize(vector_count);
+    auto norms = EigenVectorMap<float>(support_vector_norms_.data(), vector_count);
+    norms = ConstEigenMatrixMapRowMajor<float>(support_vectors.data(), vector_count, feature_count).rowwise().squaredNorm();
+  }
+
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
@@ -39,28 +52,31 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
-
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
-
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+      assert(support_vector_norms_.size() == size_t(n));
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+      // out = 2 * gamma * a.b'
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        2 * gamma_, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-        cur_batch += k;  // move to start of next batch
-      }
+      // out = exp(-gamma * (||a||^2 + ||b||^2) + out), the squared distance is clipped to 0 against rounding errors.
+      const float* norms = support_vector_norms_.data();
+      const float gamma = gamma_;
+      concurrency::ThreadPool::TryParallelFor(
+          threadpool, m, TensorOpCost{static_cast<double>(n + k) * sizeof(T), static_cast<double>(n) * sizeof(T), static_cast<double>(n + k) * 4},
+          [&a, &out, norms, gamma, n, k](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t batch = first; batch < last; ++batch) {
+              const T input_norm = ConstEigenVectorMap<T>(a.data() + batch * k, k).squaredNorm();
+              T* cur_out = out.data() + batch * n;
+              for (ptrdiff_t support_vector = 0; support_vector < n; ++support_vector) {
+                cur_out[support_vector] = std::min(cur_out[support_vector] - gamma * (input_norm + norms[support_vector]), T(0));
+              }
+              MlasComputeExp(cur_out, cur_out, static_cast<size_t>(n));
+            }
+          });
     } else {
       float alpha = 1.f;
       float beta = 1.f;
@@ -97,6 +113,7 @@ class SVMCommon {
 
  private:
   KERNEL kernel_type_;
+  std::vector<float> support_vector_norms_;
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
@@ -106,6 +123,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
+  using SVMCommon::set_support_vectors;
 
  public:
   SVMClassifier(const OpKernelInfo& info);
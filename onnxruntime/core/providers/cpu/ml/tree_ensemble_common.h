@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <limits>
 #include <mutex>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #include "core/platform/threadpool.h"
 #include "tree_ensemble_helper.h"
 #include "tree_ensemble_attribute.h"
@@ -54,6 +58,43 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // QuickScorer layout, only built when every tree has at most 64 leaves and all nodes use the same
+  // comparison (see BuildQuickScorer). Leaves are numbered per tree with the true subtree before the false one.
+  // Every node is stored with the mask clearing the leaves of its true subtree, sorted by feature and then by
+  // threshold so that the nodes whose condition is false for a feature value come first. The exit leaf
+  // of a tree is the lowest bit left in its bitvector once the masks of all false nodes are applied.
+  struct QuickScorerFeature {
+    int64_t feature_id;
+    size_t begin;
+    size_t end;
+  };
+  NODE_MODE_ORT qs_mode_;
+  std::vector<QuickScorerFeature> qs_features_;
+  std::vector<ThresholdType> qs_thresholds_;
+  std::vector<uint32_t> qs_tree_ids_;
+  std::vector<uint64_t> qs_masks_;
+  std::vector<uint8_t> qs_missing_tracks_true_;
+  std::vector<size_t> qs_leaf_offsets_;
+  std::vector<const TreeNodeElement<ThresholdType>*> qs_leaves_;
+
+  // Below this number of trees, walking the trees is as fast as the bitvectors.
+  static constexpr int64_t kQuickScorerMinTrees = 64;
+
+  // Compact copy of nodes_ (same positions, the false branch is still the next node) used to walk a block of rows
+  // through one tree in lockstep, built when all nodes share a comparison other than BRANCH_MEMBER and the feature
+  // ids fit in 16 bits. A node takes 10 or 14 bytes instead of sizeof(TreeNodeElement). Each entry of
+  // compact_truenodes_ is the position of the true branch, or kCompactLeaf for a leaf, and kCompactMissingTrue
+  // if missing values follow the true branch.
+  static constexpr uint32_t kCompactLeaf = 0x80000000;
+  static constexpr uint32_t kCompactMissingTrue = 0x40000000;
+  static constexpr uint32_t kCompactIndexMask = 0x3FFFFFFF;
+  // Enough independent walks to hide the latency of the loads of each step.
+  static constexpr int64_t kCompactRowBlock = 16;
+  NODE_MODE_ORT compact_mode_;
+  std::vector<uint16_t> compact_feature_ids_;
+  std::vector<ThresholdType> compact_thresholds_;
+  std::vector<uint32_t> compact_truenodes_;
+
  public:
   TreeEnsembleCommon() {}
 
@@ -69,10 +110,41 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Finds the leaves of tree j reached by n_rows <= kCompactRowBlock rows starting at x_data.
+  void ProcessTreeNodeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                             const TreeNodeElement<ThresholdType>** leaves) const;
+
+  template <typename Compare>
+  void ProcessCompactTreeNodeLeaves(uint32_t root, const InputType* x_data, int64_t stride, int64_t n_rows,
+                                    const TreeNodeElement<ThresholdType>** leaves, Compare cmp) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
+  template <typename AGG>
+  void ComputeAggQuickScorer(concurrency::ThreadPool* ttp, int64_t N, int64_t stride, const InputType* x_data,
+                             OutputType* z_data, int64_t* label_data, const AGG& agg) const;
+
+  void QuickScorerFindLeaves(const InputType* x_data, uint64_t* tree_masks) const;
+
+  template <typename Compare>
+  void QuickScorerApplyMasks(const InputType* x_data, uint64_t* tree_masks, Compare cmp) const;
+
+  const TreeNodeElement<ThresholdType>* QuickScorerLeaf(size_t tree_id, uint64_t tree_mask) const;
+
  private:
+  struct QuickScorerNode {
+    int64_t feature_id;
+    ThresholdType threshold;
+    uint32_t tree_id;
+    uint64_t mask;
+    bool missing_track_true;
+  };
+
+  void BuildQuickScorer();
+  void BuildCompactNodes();
+  bool AddQuickScorerNodes(const TreeNodeElement<ThresholdType>* node, uint32_t tree_id, std::vector<bool>& visited,
+                           std::vector<QuickScorerNode>& qs_nodes);
   bool CheckIfSubtreesAreEqual(const size_t left_id, const size_t right_id, const int64_t tree_id, const InlinedVector<NODE_MODE_ONNX>& cmodes,
                                const InlinedVector<size_t>& truenode_ids, const InlinedVector<size_t>& falsenode_ids, gsl::span<const int64_t> nodes_featureids,
                                gsl::span<const ThresholdType> nodes_values_as_tensor, gsl::span<const float> node_values,
@@ -288,6 +360,8 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  BuildQuickScorer();
+  BuildCompactNodes();
   return Status::OK();
 }
 
@@ -422,6 +496,326 @@ size_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddNodes(
   return node_pos;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildQuickScorer() {
+  qs_features_.clear();
+  qs_thresholds_.clear();
+  qs_tree_ids_.clear();
+  qs_masks_.clear();
+  qs_missing_tracks_true_.clear();
+  qs_leaf_offsets_.clear();
+  qs_leaves_.clear();
+
+  if (n_trees_ < kQuickScorerMinTrees || !same_mode_) {
+    return;
+  }
+
+  // The nodes of one feature can only be sorted by their condition if they all compare the same way.
+  qs_mode_ = NODE_MODE_ORT::BRANCH_LEQ;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      qs_mode_ = node.mode();
+      break;
+    }
+  }
+  if (qs_mode_ != NODE_MODE_ORT::BRANCH_LEQ && qs_mode_ != NODE_MODE_ORT::BRANCH_LT &&
+      qs_mode_ != NODE_MODE_ORT::BRANCH_GTE && qs_mode_ != NODE_MODE_ORT::BRANCH_GT) {
+    return;
+  }
+
+  std::vector<QuickScorerNode> qs_nodes;
+  qs_nodes.reserve(nodes_.size());
+  std::vector<bool> visited(nodes_.size(), false);
+  qs_leaf_offsets_.reserve(roots_.size() + 1);
+  qs_leaf_offsets_.push_back(0);
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    if (!AddQuickScorerNodes(roots_[j], static_cast<uint32_t>(j), visited, qs_nodes)) {
+      qs_leaf_offsets_.clear();
+      qs_leaves_.clear();
+      return;
+    }
+    qs_leaf_offsets_.push_back(qs_leaves_.size());
+  }
+
+  // The condition `x <= t` or `x < t` is false for the lowest thresholds, `x >= t` or `x > t` for the highest ones.
+  const bool ascending = qs_mode_ == NODE_MODE_ORT::BRANCH_LEQ || qs_mode_ == NODE_MODE_ORT::BRANCH_LT;
+  std::stable_sort(qs_nodes.begin(), qs_nodes.end(), [ascending](const QuickScorerNode& a, const QuickScorerNode& b) {
+    if (a.feature_id != b.feature_id) {
+      return a.feature_id < b.feature_id;
+    }
+    return ascending ? a.threshold < b.threshold : b.threshold < a.threshold;
+  });
+
+  qs_thresholds_.reserve(qs_nodes.size());
+  qs_tree_ids_.reserve(qs_nodes.size());
+  qs_masks_.reserve(qs_nodes.size());
+  qs_missing_tracks_true_.reserve(qs_nodes.size());
+  for (size_t k = 0; k < qs_nodes.size(); ++k) {
+    if (qs_features_.empty() || qs_features_.back().feature_id != qs_nodes[k].feature_id) {
+      qs_features_.push_back({qs_nodes[k].feature_id, k, k});
+    }
+    ++qs_features_.back().end;
+    qs_thresholds_.push_back(qs_nodes[k].threshold);
+    qs_tree_ids_.push_back(qs_nodes[k].tree_id);
+    qs_masks_.push_back(qs_nodes[k].mask);
+    qs_missing_tracks_true_.push_back(static_cast<uint8_t>(qs_nodes[k].missing_track_true));
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+bool TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddQuickScorerNodes(
+    const TreeNodeElement<ThresholdType>* node, uint32_t tree_id, std::vector<bool>& visited,
+    std::vector<QuickScorerNode>& qs_nodes) {
+  // A node reached twice means the tree shares a subtree, its leaves cannot be numbered.
+  const size_t position = static_cast<size_t>(node - nodes_.data());
+  if (visited[position]) {
+    return false;
+  }
+  visited[position] = true;
+
+  const size_t tree_offset = qs_leaf_offsets_.back();
+  if (!node->is_not_leaf()) {
+    if (qs_leaves_.size() - tree_offset >= 64) {
+      return false;
+    }
+    qs_leaves_.push_back(node);
+    return true;
+  }
+
+  const size_t first_true_leaf = qs_leaves_.size() - tree_offset;
+  if (!AddQuickScorerNodes(node->truenode_or_weight.ptr, tree_id, visited, qs_nodes)) {
+    return false;
+  }
+  // The false subtree holds at least one leaf so the true subtree must have at most 63.
+  const size_t n_true_leaves = qs_leaves_.size() - tree_offset - first_true_leaf;
+  if (n_true_leaves >= 64) {
+    return false;
+  }
+  const uint64_t true_leaves = ((uint64_t(1) << n_true_leaves) - 1) << first_true_leaf;
+  qs_nodes.push_back({node->feature_id, node->value_or_unique_weight, tree_id, ~true_leaves,
+                      node->is_missing_track_true()});
+  return AddQuickScorerNodes(node + 1, tree_id, visited, qs_nodes);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::QuickScorerApplyMasks(
+    const InputType* x_data, uint64_t* tree_masks, Compare cmp) const {
+  for (const auto& feature : qs_features_) {
+    const InputType val = x_data[feature.feature_id];
+    if (has_missing_tracks_ && _isnan_(val)) {
+      // Missing values follow the true branch of the nodes tracking them, the false branch otherwise.
+      for (size_t k = feature.begin; k < feature.end; ++k) {
+        if (!qs_missing_tracks_true_[k]) {
+          tree_masks[qs_tree_ids_[k]] &= qs_masks_[k];
+        }
+      }
+      continue;
+    }
+    // Stops at the first true condition, a NaN makes every condition false as it does when walking the trees.
+    for (size_t k = feature.begin; k < feature.end && !cmp(val, qs_thresholds_[k]); ++k) {
+      tree_masks[qs_tree_ids_[k]] &= qs_masks_[k];
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::QuickScorerFindLeaves(
+    const InputType* x_data, uint64_t* tree_masks) const {
+  std::fill_n(tree_masks, roots_.size(), ~uint64_t(0));
+  switch (qs_mode_) {
+    case NODE_MODE_ORT::BRANCH_LEQ:
+      QuickScorerApplyMasks(x_data, tree_masks, [](InputType val, ThresholdType threshold) { return val <= threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_LT:
+      QuickScorerApplyMasks(x_data, tree_masks, [](InputType val, ThresholdType threshold) { return val < threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_GTE:
+      QuickScorerApplyMasks(x_data, tree_masks, [](InputType val, ThresholdType threshold) { return val >= threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_GT:
+      QuickScorerApplyMasks(x_data, tree_masks, [](InputType val, ThresholdType threshold) { return val > threshold; });
+      break;
+    default:
+      ORT_THROW("Unexpected mode ", static_cast<int>(qs_mode_), " for the bitvector evaluation of TreeEnsemble.");
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+const TreeNodeElement<ThresholdType>* TreeEnsembleCommon<InputType, ThresholdType, OutputType>::QuickScorerLeaf(
+    size_t tree_id, uint64_t tree_mask) const {
+  // The exit leaf is never masked so tree_mask is not null.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long leaf;
+  _BitScanForward64(&leaf, tree_mask);
+#elif defined(__GNUC__) || defined(__clang__)
+  const int leaf = __builtin_ctzll(tree_mask);
+#else
+  int leaf = 0;
+  while ((tree_mask & 1) == 0) {
+    tree_mask >>= 1;
+    ++leaf;
+  }
+#endif
+  return qs_leaves_[qs_leaf_offsets_[tree_id] + static_cast<size_t>(leaf)];
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggQuickScorer(
+    concurrency::ThreadPool* ttp, int64_t N, int64_t stride, const InputType* x_data, OutputType* z_data,
+    int64_t* label_data, const AGG& agg) const {
+  // Every row goes through the sorted thresholds of all trees at once, that is why the rows are
+  // parallelized and the trees are not. The trees are still aggregated in their order.
+  auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
+  auto num_threads = N <= parallel_N_ ? 1 : std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      ttp,
+      num_threads,
+      [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+        std::vector<uint64_t> tree_masks(roots_.size());
+        InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+        auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads), onnxruntime::narrow<ptrdiff_t>(N));
+
+        for (auto i = work.start; i < work.end; ++i) {
+          QuickScorerFindLeaves(x_data + i * stride, tree_masks.data());
+          if (n_targets_or_classes_ == 1) {
+            ScoreValue<ThresholdType> score = {0, 0};
+            for (size_t j = 0, limit = roots_.size(); j < limit; ++j) {
+              agg.ProcessTreeNodePrediction1(score, *QuickScorerLeaf(j, tree_masks[j]));
+            }
+            agg.FinalizeScores1(z_data + i, score,
+                                label_data == nullptr ? nullptr : (label_data + i));
+          } else {
+            std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+            for (size_t j = 0, limit = roots_.size(); j < limit; ++j) {
+              agg.ProcessTreeNodePrediction(scores, *QuickScorerLeaf(j, tree_masks[j]), weights_);
+            }
+            agg.FinalizeScores(scores,
+                               z_data + i * n_targets_or_classes_, -1,
+                               label_data == nullptr ? nullptr : (label_data + i));
+          }
+        }
+      });
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildCompactNodes() {
+  compact_feature_ids_.clear();
+  compact_thresholds_.clear();
+  compact_truenodes_.clear();
+
+  if (max_feature_id_ > std::numeric_limits<uint16_t>::max() || nodes_.size() > kCompactIndexMask) {
+    return;
+  }
+
+  // Categorical chains folded into BRANCH_MEMBER may differ from the onnx modes, so same_mode_ is not enough.
+  bool found = false;
+  for (const auto& node : nodes_) {
+    if (!node.is_not_leaf()) {
+      continue;
+    }
+    if (!found) {
+      compact_mode_ = node.mode();
+      found = true;
+    } else if (node.mode() != compact_mode_) {
+      return;
+    }
+  }
+  if (!found || compact_mode_ == NODE_MODE_ORT::BRANCH_MEMBER) {
+    return;
+  }
+
+  compact_feature_ids_.reserve(nodes_.size());
+  compact_thresholds_.reserve(nodes_.size());
+  compact_truenodes_.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      compact_feature_ids_.push_back(static_cast<uint16_t>(node.feature_id));
+      compact_thresholds_.push_back(node.value_or_unique_weight);
+      compact_truenodes_.push_back(static_cast<uint32_t>(node.truenode_or_weight.ptr - nodes_.data()) |
+                                   (node.is_missing_track_true() ? kCompactMissingTrue : 0));
+    } else {
+      compact_feature_ids_.push_back(0);
+      compact_thresholds_.push_back(0);
+      compact_truenodes_.push_back(kCompactLeaf);
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompactTreeNodeLeaves(
+    uint32_t root, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves, Compare cmp) const {
+  // Every row moves one level down at each step, the rows which reached a leaf stay there.
+  uint32_t positions[kCompactRowBlock];
+  for (int64_t r = 0; r < n_rows; ++r) {
+    positions[r] = root;
+  }
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      const uint32_t position = positions[r];
+      const uint32_t truenode = compact_truenodes_[position];
+      if (truenode & kCompactLeaf) {
+        continue;
+      }
+      const InputType val = x_data[r * stride + compact_feature_ids_[position]];
+      const bool is_true = cmp(val, compact_thresholds_[position]) ||
+                           ((truenode & kCompactMissingTrue) && _isnan_(val));
+      positions[r] = is_true ? (truenode & kCompactIndexMask) : position + 1;
+      moved = true;
+    }
+  }
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = &nodes_[positions[r]];
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (compact_truenodes_.empty()) {
+    for (int64_t r = 0; r < n_rows; ++r) {
+      leaves[r] = ProcessTreeNodeLeave(roots_[j], x_data + r * stride);
+    }
+    return;
+  }
+
+  const uint32_t root = static_cast<uint32_t>(roots_[j] - nodes_.data());
+  switch (compact_mode_) {
+    case NODE_MODE_ORT::BRANCH_LEQ:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val <= threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_LT:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val < threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_GTE:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val >= threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_GT:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val > threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_EQ:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val == threshold; });
+      break;
+    case NODE_MODE_ORT::BRANCH_NEQ:
+      ProcessCompactTreeNodeLeaves(root, x_data, stride, n_rows, leaves,
+                                   [](InputType val, ThresholdType threshold) { return val != threshold; });
+      break;
+    default:
+      ORT_THROW("Unexpected mode ", static_cast<int>(compact_mode_), " for the compact nodes of TreeEnsemble.");
+  }
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKernelContext* ctx,
                                                                          const Tensor* X,
@@ -481,6 +875,11 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
+  if (N > 1 && !qs_leaf_offsets_.empty()) {
+    ComputeAggQuickScorer(ttp, N, stride, x_data, z_data, label_data, agg);
+    return;
+  }
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
@@ -515,8 +914,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       // split into batch so that every batch holds on caches, then loop on trees and finally loop
       // on the batch rows.
       std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
+      const TreeNodeElement<ThresholdType>* leaves[kCompactRowBlock];
       size_t j;
-      int64_t i, batch, batch_end;
+      int64_t i, batch, batch_end, r, n_rows;
 
       for (batch = 0; batch < N; batch += parallel_tree_N_) {
         batch_end = std::min(N, batch + parallel_tree_N_);
@@ -524,8 +924,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          for (i = batch; i < batch_end; i += kCompactRowBlock) {
+            n_rows = std::min(kCompactRowBlock, batch_end - i);
+            ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+            for (r = 0; r < n_rows; ++r) {
+              agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch + r)], *leaves[r]);
+            }
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -547,10 +951,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
+              const TreeNodeElement<ThresholdType>* leaves[kCompactRowBlock];
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                for (int64_t i = begin_n; i < end_n; i += kCompactRowBlock) {
+                  int64_t n_rows = std::min(kCompactRowBlock, end_n - i);
+                  ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                  for (int64_t r = 0; r < n_rows; ++r) {
+                    agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + r], *leaves[r]);
+                  }
                 }
               }
             });
@@ -612,8 +1020,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
     } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
+      const TreeNodeElement<ThresholdType>* leaves[kCompactRowBlock];
       size_t j, limit;
-      int64_t i, batch, batch_end;
+      int64_t i, batch, batch_end, r, n_rows;
       batch_end = std::min(N, static_cast<int64_t>(parallel_tree_N_));
       for (i = 0; i < batch_end; ++i) {
         scores[SafeInt<ptrdiff_t>(i)].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_));
@@ -624,8 +1033,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+          for (i = batch; i < batch_end; i += kCompactRowBlock) {
+            n_rows = std::min(kCompactRowBlock, batch_end - i);
+            ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+            for (r = 0; r < n_rows; ++r) {
+              agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch + r)], *leaves[r], weights_);
+            }
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -648,10 +1061,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
+              const TreeNodeElement<ThresholdType>* leaves[kCompactRowBlock];
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                for (int64_t i = begin_n; i < end_n; i += kCompactRowBlock) {
+                  int64_t n_rows = std::min(kCompactRowBlock, end_n - i);
+                  ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                  for (int64_t r = 0; r < n_rows; ++r) {
+                    agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + r], *leaves[r], weights_);
+                  }
                 }
               }
             });
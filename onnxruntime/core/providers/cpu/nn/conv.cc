@@ -153,7 +153,253 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+void Conv<float>::ReorderFilter(const float* input, float* output, size_t output_channels, size_t input_channels,
+                                size_t kernel_size) {
+  for (size_t k = 0; k < kernel_size; k++) {
+    for (size_t ic = 0; ic < input_channels; ic++) {
+      for (size_t oc = 0; oc < output_channels; oc++) {
+        *output++ = input[(oc * input_channels + ic) * kernel_size + k];
+      }
+    }
+  }
+}
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (input_idx != 1 || tensor.Shape().NumDimensions() <= 2) {
+    return Status::OK();
+  }
+
+  if (channels_last_) {
+    // The channels last convolution reads the filter in the HWIO format only, so the original filter is released.
+    W_shape_ = tensor.Shape();
+    const size_t output_channels = narrow<size_t>(W_shape_[0]);
+    const size_t input_channels = narrow<size_t>(W_shape_[1]);
+    const size_t kernel_size = narrow<size_t>(W_shape_.SizeFromDimension(2));
+    const size_t reordered_W_size = SafeInt<size_t>(sizeof(float)) * output_channels * input_channels * kernel_size;
+
+    reordered_W_buffer_ = IAllocator::MakeUniquePtr<void>(alloc, reordered_W_size, true);
+    ReorderFilter(tensor.Data<float>(), static_cast<float*>(reordered_W_buffer_.get()),
+                  output_channels, input_channels, kernel_size);
+
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(reordered_W_buffer_));
+      prepacked_weights->buffer_sizes_.push_back(reordered_W_size);
+    }
+
+    is_packed = true;
+    return Status::OK();
+  }
+
+  // only the filter of a 2D convolution can be transformed for the Winograd algorithm
+  if (!use_winograd_ || tensor.Shape().NumDimensions() != 4) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape));
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  const size_t group = narrow<size_t>(conv_attrs_.group);
+  const size_t M = narrow<size_t>(tensor.Shape()[0]);
+  const size_t C = narrow<size_t>(tensor.Shape()[1]) * group;
+
+  if (!MlasConvWinogradIsSupported(kernel_shape.size(), group, C / group, M / group,
+                                   kernel_shape.data(), dilations.data(), strides.data())) {
+    return Status::OK();
+  }
+
+  // The original filter is still used by the outputs too small for the Winograd algorithm, so the filter is not
+  // reported as packed.
+  winograd_packed_filter_ = IAllocator::MakeUniquePtr<float>(alloc, MlasConvWinogradPackFilterSize(M, C), true);
+  MlasConvWinogradPackFilter(M, C, tensor.Data<float>(), winograd_packed_filter_.get());
+
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  // only the reordered filter of the channels last convolution is reported as packed
+  if (input_idx == 1 && channels_last_) {
+    used_shared_buffers = true;
+    reordered_W_buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status Conv<float>::ComputeChannelsLast(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = reordered_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+  const int64_t N = X->Shape()[0];
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const size_t kernel_rank = kernel_shape.size();
+  ORT_RETURN_IF_NOT(kernel_rank >= 1 && kernel_rank <= 3, "Channels last Conv supports 1D, 2D and 3D kernels only.");
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t C = X->Shape()[1 + kernel_rank];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  // Handle the case of a dynamic filter.
+  IAllocatorUniquePtr<float> reordered_W;
+  const float* Wdata = static_cast<const float*>(reordered_W_buffer_.get());
+  if (Wdata == nullptr) {
+    reordered_W = IAllocator::MakeUniquePtr<float>(alloc, narrow<size_t>(W_shape.Size()));
+    ReorderFilter(W->Data<float>(), reordered_W.get(), narrow<size_t>(M), narrow<size_t>(W_shape[1]),
+                  narrow<size_t>(kernel_size));
+    Wdata = reordered_W.get();
+  }
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  auto Ydata = Y->MutableDataAsSpan<float>();
+  // Check for the optional Conv/Sum fusion.
+  float Beta = 0.0f;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Y->Shape() == Sum->Shape(), "output and sum shape must match");
+    // If the output was not allocated inplace with the sum tensor, then copy here.
+    auto sum_data = Sum->DataAsSpan<float>();
+    if (Ydata.data() != sum_data.data()) {
+      gsl::copy(sum_data, Ydata);
+    }
+    Beta = 1.0f;
+  }
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / group_count;
+
+  if (group_input_channels == 1 && group_output_channels == 1) {
+    // Depthwise convolutions read the input through an indirection buffer.
+    const int64_t input_image_size = input_shape.Size();
+    const int64_t output_image_size = output_shape.Size();
+    const int64_t output_stride = 16;
+    const int64_t task_count = (output_image_size + output_stride - 1) / output_stride;
+
+    auto indirection_buffer = IAllocator::MakeUniquePtr<const float*>(
+        alloc, SafeInt<size_t>(kernel_size) * output_image_size);
+    std::vector<float> padding_data(narrow<size_t>(C), 0.0f);
+
+    for (int64_t image_id = 0; image_id < N; ++image_id) {
+      const float* input_data = Xdata + image_id * input_image_size * C;
+      float* output_data = Ydata.data() + image_id * output_image_size * M;
+
+      auto depthwise_worker = [&](ptrdiff_t batch) {
+        const int64_t output_start = static_cast<int64_t>(batch) * output_stride;
+        const int64_t output_count = std::min(output_stride, output_image_size - output_start);
+        const float** worker_indirection_buffer = indirection_buffer.get() + output_start * kernel_size;
+
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            worker_indirection_buffer,
+            padding_data.data());
+
+        MlasConvDepthwise(worker_indirection_buffer,
+                          Wdata,
+                          Bdata,
+                          output_data + output_start * M,
+                          narrow<size_t>(M),
+                          narrow<size_t>(output_count),
+                          narrow<size_t>(kernel_size),
+                          Beta,
+                          &activation_);
+      };
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, narrow<ptrdiff_t>(task_count), depthwise_worker);
+    }
+
+    return Status::OK();
+  }
+
+  MLAS_CONV_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+  MlasConvPrepare(&Parameters,
+                  kernel_rank,
+                  narrow<size_t>(N),
+                  narrow<size_t>(group_count),
+                  narrow<size_t>(group_input_channels),
+                  input_shape.GetDims().data(),
+                  kernel_shape.data(),
+                  dilations.data(),
+                  pads.data(),
+                  strides.data(),
+                  output_shape.GetDims().data(),
+                  narrow<size_t>(group_output_channels),
+                  &activation_,
+                  &WorkingBufferSize,
+                  Beta,
+                  thread_pool);
+
+  MlasConvNhwc(&Parameters, Xdata, Wdata, Bdata, Ydata.data(), thread_pool);
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
+  if (channels_last_) {
+    return ComputeChannelsLast(context);
+  }
+
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
@@ -231,15 +477,21 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    winograd_packed_filter_ != nullptr);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
 
+    const float* filter_data = W->Data<float>();
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+      filter_data = winograd_packed_filter_.get();
+    }
+
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             filter_data,
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
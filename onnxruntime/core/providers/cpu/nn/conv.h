@@ -6,6 +6,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -26,14 +27,43 @@ class Conv<float> : public OpKernel {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     activation_.ActivationKind = MlasIdentityActivation;
+    // NhwcFusedConv shares this kernel, with the input and output in channels last format.
+    channels_last_ = (info.GetKernelDef().OpName() == "NhwcFusedConv");
+    use_winograd_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasDisableConvWinograd, "0") != "1";
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+  bool channels_last_{false};
+
+ private:
+  Status ComputeChannelsLast(OpKernelContext* context) const;
+
+  // Reorders the filter from (M x C/group x kH x kW) to the HWIO format: a matrix of (kH x kW x C/group) rows and
+  // M columns, used by the channels last convolution.
+  static void ReorderFilter(const float* input, float* output, size_t output_channels, size_t input_channels,
+                            size_t kernel_size);
+
+  // The filter reordered by PrePack for the channels last convolution.
+  TensorShape W_shape_;
+  IAllocatorUniquePtr<void> reordered_W_buffer_;
+
+  // The filter transformed for the Winograd algorithm. The original filter is kept, the Winograd algorithm is only
+  // selected for outputs large enough to be tiled.
+  bool use_winograd_{true};
+  IAllocatorUniquePtr<float> winograd_packed_filter_;
 };
 
 }  // namespace onnxruntime
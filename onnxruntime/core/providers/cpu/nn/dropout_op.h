@@ -8,6 +8,8 @@
 #include "core/framework/random_generator.h"
 #include <chrono>
 #include <random>
+#include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -16,9 +18,15 @@ template <typename T1, typename T2>
 class Dropout final : public OpKernel {
  public:
   Dropout(const OpKernelInfo& info) : OpKernel{info} {
+    use_counter_based_generator_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCpuRandomCounterBased, "0") == "1";
     int64_t seed = 0;
     if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
-      generator_ = std::make_unique<RandomGenerator>(seed);
+      if (use_counter_based_generator_) {
+        philox_generator_ = std::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
+      } else {
+        generator_ = std::make_unique<RandomGenerator>(seed);
+      }
     }
   }
 
@@ -26,6 +34,9 @@ class Dropout final : public OpKernel {
 
  private:
   mutable std::unique_ptr<RandomGenerator> generator_;
+  // used instead of generator_ if the counter-based generator is enabled in the session options.
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
+  bool use_counter_based_generator_;
 };
 
 namespace {
@@ -83,7 +94,27 @@ Status Dropout<T1, T2>::Compute(OpKernelContext* context) const {
     EigenVectorArrayMap<bool> mask_arr(mask_span.data(), mask_span.size());
 
     // generate mask
-    {
+    if (use_counter_based_generator_) {
+      // the four random values of counter offset + i generate the mask values [i * 4, (i + 1) * 4), so the
+      // counters are generated in parallel and the mask does not depend on the number of threads.
+      PhiloxGenerator& generator = philox_generator_ != nullptr ? *philox_generator_ : PhiloxGenerator::Default();
+      const std::ptrdiff_t mask_size = static_cast<std::ptrdiff_t>(mask_span.size());
+      const std::ptrdiff_t counter_count = (mask_size + 3) / 4;
+      const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(counter_count));
+      const PhiloxEngine engine(seeds.first);
+      bool* mask_data = mask_span.data();
+
+      concurrency::ThreadPool::TryParallelFor(
+          context->GetOperatorThreadPool(), counter_count, TensorOpCost{0, 4.0, 64.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              const auto values = engine(seeds.second + static_cast<uint64_t>(i));
+              for (std::ptrdiff_t j = i * 4, end = std::min(j + 4, mask_size); j < end; ++j) {
+                mask_data[j] = PhiloxEngine::ToUniformFloat(values[j - i * 4]) >= ratio_value;
+              }
+            }
+          });
+    } else {
       RandomGenerator& generator = generator_ != nullptr ? *generator_.get() : RandomGenerator::Default();
       std::default_random_engine rng(gsl::narrow_cast<std::default_random_engine::result_type>(generator.NextSeed()));
       std::uniform_real_distribution<float> dist{0.0f, 1.0f};
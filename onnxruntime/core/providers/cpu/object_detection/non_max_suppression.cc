@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -148,55 +150,143 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+  const int64_t num_boxes = pc.num_boxes_;
+  const int64_t num_batch_boxes = pc.num_batches_ * num_boxes;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // The corners and the area of every box are computed once, as SuppressByIOU does, instead of for every pair of
+  // boxes that are compared. They are stored as separate arrays so the IOU checks vectorize.
+  std::vector<float> corners(narrow<size_t>(num_batch_boxes * 5));
+  float* const x_mins = corners.data();
+  float* const y_mins = x_mins + num_batch_boxes;
+  float* const x_maxs = y_mins + num_batch_boxes;
+  float* const y_maxs = x_maxs + num_batch_boxes;
+  float* const areas = y_maxs + num_batch_boxes;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_batch_boxes), TensorOpCost{16.0, 20.0, 8.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const float* box = boxes_data + 4 * i;
+          if (0 == center_point_box) {
+            // boxes data format [y1, x1, y2, x2],
+            MaxMin(box[1], box[3], x_mins[i], x_maxs[i]);
+            MaxMin(box[0], box[2], y_mins[i], y_maxs[i]);
+          } else {
+            // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+            const float width_half = box[2] / 2;
+            const float height_half = box[3] / 2;
+            x_mins[i] = box[0] - width_half;
+            x_maxs[i] = box[0] + width_half;
+            y_mins[i] = box[1] - height_half;
+            y_maxs[i] = box[1] + height_half;
           }
+          areas[i] = (x_maxs[i] - x_mins[i]) * (y_maxs[i] - y_mins[i]);
         }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+      });
+
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class),
+                                               static_cast<size_t>(num_boxes));
+
+  // Every (batch, class) pair is independent, the boxes selected for each pair are concatenated in order afterwards.
+  const int64_t num_pairs = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_per_pair(narrow<size_t>(num_pairs));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_pairs),
+      TensorOpCost{static_cast<double>(num_boxes * sizeof(float)), static_cast<double>(max_selected * sizeof(int64_t)),
+                   static_cast<double>(num_boxes) * 16.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(narrow<size_t>(num_boxes));
+
+        // the corners of the boxes selected so far, only boxes with a positive area can suppress another box
+        std::vector<float> selected_corners(max_selected * 5);
+        float* const selected_x_mins = selected_corners.data();
+        float* const selected_y_mins = selected_x_mins + max_selected;
+        float* const selected_x_maxs = selected_y_mins + max_selected;
+        float* const selected_y_maxs = selected_x_maxs + max_selected;
+        float* const selected_areas = selected_y_maxs + max_selected;
+
+        for (std::ptrdiff_t pair = first; pair < last; ++pair) {
+          const int64_t batch_index = pair / pc.num_classes_;
+          const int64_t box_offset = batch_index * num_boxes;
+          const float* class_scores = scores_data + pair * num_boxes;
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+              if (class_scores[box_index] > score_threshold) {
+                candidate_boxes.emplace_back(class_scores[box_index], box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+              candidate_boxes.emplace_back(class_scores[box_index], box_index);
+            }
           }
-        }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+          // The candidates are taken from a heap in score order, which stops as soon as enough boxes are selected
+          // instead of sorting all of them.
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+          auto heap_end = candidate_boxes.end();
+
+          std::vector<int64_t>& selected = selected_per_pair[pair];
+          size_t num_selected_corners = 0;
+          // Get the next box with top score, filter by iou_threshold
+          while (heap_end != candidate_boxes.begin() && selected.size() < max_selected) {
+            std::pop_heap(candidate_boxes.begin(), heap_end);
+            --heap_end;
+            const int64_t box = box_offset + heap_end->index_;
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union)
+            // threshold. A box without a positive area is never suppressed.
+            const float x_min = x_mins[box];
+            const float y_min = y_mins[box];
+            const float x_max = x_maxs[box];
+            const float y_max = y_maxs[box];
+            const float area = areas[box];
+            bool suppressed = false;
+            if (area > .0f) {
+              constexpr size_t kBlockSize = 16;
+              for (size_t block = 0; block < num_selected_corners && !suppressed; block += kBlockSize) {
+                const size_t block_end = std::min(block + kBlockSize, num_selected_corners);
+                for (size_t j = block; j < block_end; ++j) {
+                  const float intersection_x_min = std::max(x_min, selected_x_mins[j]);
+                  const float intersection_x_max = std::min(x_max, selected_x_maxs[j]);
+                  const float intersection_y_min = std::max(y_min, selected_y_mins[j]);
+                  const float intersection_y_max = std::min(y_max, selected_y_maxs[j]);
+                  const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                                  (intersection_y_max - intersection_y_min);
+                  const float union_area = area + selected_areas[j] - intersection_area;
+                  suppressed |= (intersection_x_max > intersection_x_min) &
+                                (intersection_y_max > intersection_y_min) &
+                                (intersection_area > .0f) & (union_area > .0f) &
+                                (intersection_area / union_area > iou_threshold);
+                }
+              }
+            }
+
+            if (!suppressed) {
+              selected.push_back(heap_end->index_);
+              if (area > .0f) {
+                selected_x_mins[num_selected_corners] = x_min;
+                selected_y_mins[num_selected_corners] = y_min;
+                selected_x_maxs[num_selected_corners] = x_max;
+                selected_y_maxs[num_selected_corners] = y_max;
+                selected_areas[num_selected_corners] = area;
+                ++num_selected_corners;
+              }
+            }
+          }  // while
+        }  // for pair
+      });
+
+  std::vector<SelectedIndex> selected_indices;
+  for (int64_t pair = 0; pair < num_pairs; ++pair) {
+    for (int64_t box_index : selected_per_pair[pair]) {
+      selected_indices.emplace_back(pair / pc.num_classes_, pair % pc.num_classes_, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -776,6 +777,79 @@ bool CommonFastReduceCopy(OpKernelContext* ctx, TensorShapeVector& input_axes, b
 typedef void fast_reduce_fct(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                              Tensor& output, concurrency::ThreadPool* tp);
 
+// Aggregators whose reduction is implemented by MlasReduce.
+template <typename AGG>
+struct MlasReduceKindOf {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = std::nullopt;
+};
+
+template <>
+struct MlasReduceKindOf<ReduceAggregatorSum<float>> {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = MlasReduceSum;
+};
+
+template <>
+struct MlasReduceKindOf<ReduceAggregatorMean<float>> {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = MlasReduceMean;
+};
+
+template <>
+struct MlasReduceKindOf<ReduceAggregatorMax<float>> {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = MlasReduceMax;
+};
+
+template <>
+struct MlasReduceKindOf<ReduceAggregatorMin<float>> {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = MlasReduceMin;
+};
+
+template <>
+struct MlasReduceKindOf<ReduceAggregatorLogSumExp<float>> {
+  static constexpr std::optional<MLAS_REDUCE_KIND> value = MlasReduceLogSumExp;
+};
+
+// Reduces a float tensor with MLAS when the reduced axes form a single block of the fast shape,
+// which then maps to [outer, reduce, inner]. Returns false for the other fast reduce kinds.
+static bool MlasFastReduce(MLAS_REDUCE_KIND kind, FastReduceKind fast_kind, gsl::span<const int64_t> fast_shape,
+                           const Tensor& input, Tensor& output, concurrency::ThreadPool* tp) {
+  size_t outer_count, reduce_count, inner_count;
+  switch (fast_kind) {
+    case FastReduceKind::kR:
+      outer_count = 1;
+      reduce_count = narrow<size_t>(fast_shape[0]);
+      inner_count = 1;
+      break;
+    case FastReduceKind::kKR:
+      ValidateFastReduceKR(fast_shape, output);
+      outer_count = narrow<size_t>(fast_shape[0]);
+      reduce_count = narrow<size_t>(fast_shape[1]);
+      inner_count = 1;
+      break;
+    case FastReduceKind::kRK:
+      ValidateFastReduceRK(fast_shape, output);
+      outer_count = 1;
+      reduce_count = narrow<size_t>(fast_shape[0]);
+      inner_count = narrow<size_t>(fast_shape[1]);
+      break;
+    case FastReduceKind::kKRK:
+      ValidateFastReduceKRK(fast_shape, output);
+      outer_count = narrow<size_t>(fast_shape[0]);
+      reduce_count = narrow<size_t>(fast_shape[1]);
+      inner_count = narrow<size_t>(fast_shape[2]);
+      break;
+    default:
+      return false;
+  }
+
+  MlasReduce(kind, input.Data<float>(), output.MutableData<float>(), outer_count, reduce_count, inner_count, tp);
+  return true;
+}
+
+static bool IsMlasFastReduceKind(FastReduceKind fast_kind) {
+  return fast_kind == FastReduceKind::kR || fast_kind == FastReduceKind::kKR ||
+         fast_kind == FastReduceKind::kRK || fast_kind == FastReduceKind::kKRK;
+}
+
 bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             const gsl::span<const int64_t>& axes_,
                             int64_t keepdims_,
@@ -788,7 +862,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
-                            fast_reduce_fct* case_rkr) {
+                            fast_reduce_fct* case_rkr,
+                            std::optional<MLAS_REDUCE_KIND> mlas_reduce_kind) {
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
   TensorShapeVector input_axes;
@@ -801,6 +876,13 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
       reduced_dims, input_axes.empty() ? axes_ : input_axes,
       fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
 
+  if (mlas_reduce_kind.has_value() && IsMlasFastReduceKind(fast_kind)) {
+    // MLAS splits the reduced axis among the threads when the output is small,
+    // so it handles every shape without the heuristics below.
+    Tensor* output = ctx->Output(0, output_shape);
+    return MlasFastReduce(*mlas_reduce_kind, fast_kind, fast_shape, *input, *output, ctx->GetOperatorThreadPool());
+  }
+
   if (which_fast_reduce != FastReduceKind::kNone) {
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
       Tensor* output = ctx->Output(0, output_shape);
@@ -863,7 +945,7 @@ bool CommonFastReduce(OpKernelContext* ctx,
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
                                 AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
-                                &AGG::FastReduceKRK, &AGG::FastReduceRKR);
+                                &AGG::FastReduceKRK, &AGG::FastReduceRKR, MlasReduceKindOf<AGG>::value);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -1074,6 +1156,13 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     return output;
   }
 
+  if constexpr (std::is_same_v<T, float>) {
+    if (IsMlasFastReduceKind(fast_kind)) {
+      MlasFastReduce(MlasReduceSum, fast_kind, fast_shape, input, *output, tp);
+      return output;
+    }
+  }
+
   if (IsFastReduceKindAvailable(fast_kind, ReduceAggregatorSum<T>::WhichFastReduce())) {
     switch (fast_kind) {
       case FastReduceKind::kKR: {
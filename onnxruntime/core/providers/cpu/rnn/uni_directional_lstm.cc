@@ -103,10 +103,13 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    // one buffer with the same iofc layout as a row of output_iofc_ so the bias of all the gates
+    // can be added in a single pass
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -497,6 +500,30 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+    if (!use_peepholes_ && !input_forget_) {
+      // None of the gates depends on another gate or on C_prev, so the bias and clip are applied to the
+      // whole iofc row at once and f() runs once over the contiguous i, o and f gates.
+      const float* pB = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, hidden_size_x4) : nullptr;
+      clip_with_bias_ptr_(clip_, pB, pi, hidden_size_x4);
+      activation_f_.func(pi, 3 * hidden_size_, activation_f_.alpha, activation_f_.beta);
+      activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+
+      float* pC_cur = pCprev_hidden_size;
+      deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
+
+      if (training_mode_) {
+        float* pC = SafeRawPointer<T>(batched_cell_states + row * hidden_size_ + b * hidden_size_,
+                                      batched_cell_states_end, hidden_size_);
+        std::copy_n(pC_cur, hidden_size_, pC);
+      }
+
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
+      activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
+      continue;
+    }
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
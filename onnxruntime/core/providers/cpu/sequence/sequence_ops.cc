@@ -192,6 +192,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     SequenceInsert,
     11,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes())
         .TypeConstraint("I", std::vector<MLDataType>{
                                  DataTypeImpl::GetTensorType<int32_t>(),
@@ -234,6 +235,17 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+
+  // The allocation planner reuses the input sequence for the output when nothing else consumes it.
+  // Insert into it directly instead of rebuilding the sequence, which makes growing a sequence in a Loop
+  // amortized constant time per iteration.
+  if (Y == S) {
+    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
+    Y->Insert(static_cast<size_t>(input_seq_idx), CloneTensor(*X, context, Info().GetDataTransferManager()));
+    return Status::OK();
+  }
+
+  // The elements are shared with the input sequence, so only the OrtValue references are copied.
   Y->SetType(S->DataType());
   Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) + 1);
 
@@ -259,6 +271,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     SequenceErase,
     11,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes())
         .TypeConstraint("I", std::vector<MLDataType>{
                                  DataTypeImpl::GetTensorType<int32_t>(),
@@ -284,6 +297,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+
+  // The input sequence is reused for the output when nothing else consumes it
+  if (Y == S) {
+    Y->Erase(static_cast<size_t>(input_seq_idx));
+    return Status::OK();
+  }
+
   Y->SetType(S->DataType());
   Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) - 1);
 
@@ -0,0 +1,348 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace signal {
+
+// Complex FFT of a fixed length.
+// Lengths whose only prime factors are 2, 3 and 5 are computed with a mixed-radix (4, 2, 3, 5) decimation in time
+// FFT. Other lengths are computed with Bluestein's algorithm, as a circular convolution whose length is the next
+// such number. The twiddle factors are computed once when the plan is created so a plan should be reused for all the
+// transforms of a given length.
+template <typename T>
+class ComplexFft {
+ public:
+  ComplexFft(size_t length, bool inverse) : length_(length), inverse_(inverse) {
+    ORT_ENFORCE(length > 0, "The FFT length must be greater than zero.");
+    if (Factorize(length, factors_)) {
+      twiddles_.resize(length);
+      for (size_t i = 0; i < length; i++) {
+        twiddles_[i] = Exponential(static_cast<double>(i) / static_cast<double>(length));
+      }
+      return;
+    }
+
+    // Bluestein: a chirp multiplies the input and the output of the circular convolution with the conjugate chirp.
+    size_t convolution_length = 2 * length - 1;
+    std::vector<size_t> factors;
+    while (!Factorize(convolution_length, factors)) {
+      convolution_length++;
+    }
+    convolution_ = std::make_unique<ComplexFft<T>>(convolution_length, false);
+
+    chirp_.resize(length);
+    for (size_t n = 0; n < length; n++) {
+      // exp(+-i * pi * n^2 / length), n^2 is reduced modulo 2 * length to keep the angle accurate
+      const size_t n2 = static_cast<size_t>((static_cast<uint64_t>(n) * n) % (2 * static_cast<uint64_t>(length)));
+      chirp_[n] = Exponential(static_cast<double>(n2) / (2.0 * static_cast<double>(length)));
+    }
+
+    std::vector<std::complex<T>> b(convolution_length);
+    b[0] = std::conj(chirp_[0]);
+    for (size_t n = 1; n < length; n++) {
+      b[n] = b[convolution_length - n] = std::conj(chirp_[n]);
+    }
+    chirp_fft_.resize(convolution_length);
+    convolution_->Transform(b.data(), chirp_fft_.data(), nullptr);
+
+    // fold the normalization of the inverse transform of the convolution into its kernel
+    const T scale = static_cast<T>(1) / static_cast<T>(convolution_length);
+    for (auto& value : chirp_fft_) {
+      value *= scale;
+    }
+  }
+
+  size_t Length() const { return length_; }
+
+  // Number of complex values of the scratch buffer Transform needs.
+  size_t ScratchSize() const { return convolution_ ? 2 * convolution_->Length() : 0; }
+
+  // output = DFT(input). Both hold Length() values and must not overlap, input is left unchanged.
+  // The inverse transform is not normalized.
+  void Transform(const std::complex<T>* input, std::complex<T>* output, std::complex<T>* scratch) const {
+    if (!convolution_) {
+      Work(output, input, 1, factors_.data());
+      return;
+    }
+
+    const size_t convolution_length = convolution_->Length();
+    std::complex<T>* a = scratch;
+    std::complex<T>* a_fft = scratch + convolution_length;
+    for (size_t n = 0; n < length_; n++) {
+      a[n] = Multiply(input[n], chirp_[n]);
+    }
+    std::fill(a + length_, a + convolution_length, std::complex<T>{});
+    convolution_->Transform(a, a_fft, nullptr);
+
+    // inverse transform of the product through the forward one: ifft(x) = conj(fft(conj(x)))
+    for (size_t k = 0; k < convolution_length; k++) {
+      a_fft[k] = std::conj(Multiply(a_fft[k], chirp_fft_[k]));
+    }
+    convolution_->Transform(a_fft, a, nullptr);
+    for (size_t k = 0; k < length_; k++) {
+      output[k] = Multiply(std::conj(a[k]), chirp_[k]);
+    }
+  }
+
+ private:
+  // Splits length into the radices of the stages followed by the length of the sub-transforms of each stage.
+  static bool Factorize(size_t length, std::vector<size_t>& factors) {
+    factors.clear();
+    while (length > 1) {
+      static constexpr size_t kRadices[] = {4, 2, 3, 5};
+      size_t radix = 0;
+      for (size_t candidate : kRadices) {
+        if (length % candidate == 0) {
+          radix = candidate;
+          break;
+        }
+      }
+      if (radix == 0) {
+        return false;
+      }
+      length /= radix;
+      factors.push_back(radix);
+      factors.push_back(length);
+    }
+    if (factors.empty()) {
+      factors = {1, 1};
+    }
+    return true;
+  }
+
+  // exp(-+2 * pi * i * fraction)
+  std::complex<T> Exponential(double fraction) const {
+    constexpr double tau = 6.283185307179586476925286766559;
+    const double angle = (inverse_ ? tau : -tau) * fraction;
+    return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+  }
+
+  // std::complex multiplication checks for NaN and infinity, which keeps it from being inlined and vectorized.
+  static std::complex<T> Multiply(const std::complex<T>& a, const std::complex<T>& b) {
+    return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+  }
+
+  // Computes the transform of the input values spaced by stride into output, recursing on the sub-transforms.
+  void Work(std::complex<T>* output, const std::complex<T>* input, size_t stride, const size_t* factors) const {
+    const size_t radix = factors[0];
+    const size_t m = factors[1];
+
+    if (m == 1) {
+      for (size_t i = 0; i < radix; i++) {
+        output[i] = input[i * stride];
+      }
+    } else {
+      for (size_t i = 0; i < radix; i++) {
+        Work(output + i * m, input + i * stride, stride * radix, factors + 2);
+      }
+    }
+
+    switch (radix) {
+      case 2:
+        Butterfly2(output, stride, m);
+        break;
+      case 3:
+        Butterfly3(output, stride, m);
+        break;
+      case 4:
+        Butterfly4(output, stride, m);
+        break;
+      case 5:
+        Butterfly5(output, stride, m);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void Butterfly2(std::complex<T>* output, size_t stride, size_t m) const {
+    std::complex<T>* output1 = output + m;
+    for (size_t k = 0; k < m; k++) {
+      const std::complex<T> t = Multiply(output1[k], twiddles_[k * stride]);
+      output1[k] = output[k] - t;
+      output[k] += t;
+    }
+  }
+
+  void Butterfly3(std::complex<T>* output, size_t stride, size_t m) const {
+    const T sin_third = twiddles_[stride * m].imag();
+    for (size_t k = 0; k < m; k++) {
+      const std::complex<T> s1 = Multiply(output[k + m], twiddles_[k * stride]);
+      const std::complex<T> s2 = Multiply(output[k + 2 * m], twiddles_[2 * k * stride]);
+      const std::complex<T> sum = s1 + s2;
+      const std::complex<T> difference = (s1 - s2) * sin_third;
+      const std::complex<T> middle = output[k] - sum * static_cast<T>(0.5);
+      output[k] += sum;
+      output[k + m] = std::complex<T>(middle.real() - difference.imag(), middle.imag() + difference.real());
+      output[k + 2 * m] = std::complex<T>(middle.real() + difference.imag(), middle.imag() - difference.real());
+    }
+  }
+
+  void Butterfly4(std::complex<T>* output, size_t stride, size_t m) const {
+    for (size_t k = 0; k < m; k++) {
+      const std::complex<T> s0 = Multiply(output[k + m], twiddles_[k * stride]);
+      const std::complex<T> s1 = Multiply(output[k + 2 * m], twiddles_[2 * k * stride]);
+      const std::complex<T> s2 = Multiply(output[k + 3 * m], twiddles_[3 * k * stride]);
+      const std::complex<T> s5 = output[k] - s1;
+      const std::complex<T> s4 = s0 - s2;
+      const std::complex<T> even = output[k] + s1;
+      const std::complex<T> s3 = s0 + s2;
+      output[k + 2 * m] = even - s3;
+      output[k] = even + s3;
+      if (inverse_) {
+        output[k + m] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+        output[k + 3 * m] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+      } else {
+        output[k + m] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+        output[k + 3 * m] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+      }
+    }
+  }
+
+  void Butterfly5(std::complex<T>* output, size_t stride, size_t m) const {
+    const std::complex<T> ya = twiddles_[stride * m];
+    const std::complex<T> yb = twiddles_[2 * stride * m];
+    for (size_t k = 0; k < m; k++) {
+      const std::complex<T> s0 = output[k];
+      const std::complex<T> s1 = Multiply(output[k + m], twiddles_[k * stride]);
+      const std::complex<T> s2 = Multiply(output[k + 2 * m], twiddles_[2 * k * stride]);
+      const std::complex<T> s3 = Multiply(output[k + 3 * m], twiddles_[3 * k * stride]);
+      const std::complex<T> s4 = Multiply(output[k + 4 * m], twiddles_[4 * k * stride]);
+
+      const std::complex<T> s7 = s1 + s4;
+      const std::complex<T> s10 = s1 - s4;
+      const std::complex<T> s8 = s2 + s3;
+      const std::complex<T> s9 = s2 - s3;
+
+      output[k] = s0 + s7 + s8;
+
+      const std::complex<T> s5 = s0 + s7 * ya.real() + s8 * yb.real();
+      const std::complex<T> s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                               -s10.real() * ya.imag() - s9.real() * yb.imag());
+      output[k + m] = s5 - s6;
+      output[k + 4 * m] = s5 + s6;
+
+      const std::complex<T> s11 = s0 + s7 * yb.real() + s8 * ya.real();
+      const std::complex<T> s12(-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                                s10.real() * yb.imag() - s9.real() * ya.imag());
+      output[k + 2 * m] = s11 + s12;
+      output[k + 3 * m] = s11 - s12;
+    }
+  }
+
+  size_t length_;
+  bool inverse_;
+  std::vector<size_t> factors_;
+  std::vector<std::complex<T>> twiddles_;
+
+  // Bluestein
+  std::unique_ptr<ComplexFft<T>> convolution_;
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_fft_;
+};
+
+// DFT of a (windowed, truncated or zero padded) real or complex signal, built on a ComplexFft.
+// A real signal of even length is packed into a complex signal of half its length, whose transform is then split
+// into the spectrum of the real signal, so real inputs cost about half of a complex transform.
+// The plan only holds constant tables, a single plan can be used from several threads with their own scratch buffers.
+template <typename T>
+class DftPlan {
+ public:
+  DftPlan(size_t dft_length, bool inverse, bool is_real_input)
+      : dft_length_(dft_length),
+        inverse_(inverse),
+        packed_(is_real_input && dft_length % 2 == 0),
+        fft_(packed_ ? dft_length / 2 : dft_length, inverse) {
+    if (packed_) {
+      constexpr double tau = 6.283185307179586476925286766559;
+      const size_t half = dft_length / 2;
+      split_twiddles_.resize(half + 1);
+      for (size_t k = 0; k <= half; k++) {
+        const double angle = (inverse ? tau : -tau) * static_cast<double>(k) / static_cast<double>(dft_length);
+        split_twiddles_[k] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+      }
+    }
+  }
+
+  // Number of complex values of the scratch buffer Transform needs.
+  size_t ScratchSize() const { return 2 * fft_.Length() + fft_.ScratchSize(); }
+
+  // Writes the first output_size values of the DFT of x * window to y.
+  // x has number_of_samples values spaced by x_stride, which are truncated or zero padded to the DFT length.
+  // window is optional and holds DFT length values. The inverse transform is normalized.
+  template <typename U>
+  void Transform(const U* x, size_t x_stride, size_t number_of_samples, const T* window, std::complex<T>* y,
+                 size_t y_stride, size_t output_size, std::complex<T>* scratch) const {
+    const size_t count = std::min(number_of_samples, dft_length_);
+    const size_t fft_length = fft_.Length();
+    std::complex<T>* input = scratch;
+    std::complex<T>* output = scratch + fft_length;
+    std::complex<T>* fft_scratch = output + fft_length;
+    const T scale = inverse_ ? static_cast<T>(1) / static_cast<T>(dft_length_) : static_cast<T>(1);
+
+    if constexpr (std::is_same_v<U, T>) {
+      if (packed_) {
+        auto sample = [x, x_stride, count, window](size_t i) {
+          if (i >= count) {
+            return T{};
+          }
+          return window ? x[i * x_stride] * window[i] : x[i * x_stride];
+        };
+        for (size_t n = 0; n < fft_length; n++) {
+          input[n] = std::complex<T>(sample(2 * n), sample(2 * n + 1));
+        }
+        fft_.Transform(input, output, fft_scratch);
+
+        // z = fft(even + i * odd): fft(even)[k] = (z[k] + conj(z[-k])) / 2, fft(odd)[k] = (z[k] - conj(z[-k])) / 2i
+        const size_t split_size = std::min(output_size, fft_length + 1);
+        for (size_t k = 0; k < split_size; k++) {
+          const std::complex<T> z = output[k == fft_length ? 0 : k];
+          const std::complex<T> z_mirror = std::conj(output[k == 0 ? 0 : fft_length - k]);
+          const std::complex<T> even = (z + z_mirror) * static_cast<T>(0.5);
+          const std::complex<T> difference = z - z_mirror;
+          const std::complex<T> odd(difference.imag() * static_cast<T>(0.5), -difference.real() * static_cast<T>(0.5));
+          const std::complex<T>& w = split_twiddles_[k];
+          const std::complex<T> w_odd(w.real() * odd.real() - w.imag() * odd.imag(),
+                                      w.real() * odd.imag() + w.imag() * odd.real());
+          y[k * y_stride] = (even + w_odd) * scale;
+        }
+        // the spectrum of a real signal is conjugate symmetric
+        for (size_t k = split_size; k < output_size; k++) {
+          y[k * y_stride] = std::conj(y[(dft_length_ - k) * y_stride]);
+        }
+        return;
+      }
+    }
+
+    for (size_t n = 0; n < count; n++) {
+      const std::complex<T> value(x[n * x_stride]);
+      input[n] = window ? value * window[n] : value;
+    }
+    std::fill(input + count, input + fft_length, std::complex<T>{});
+    fft_.Transform(input, output, fft_scratch);
+    for (size_t k = 0; k < output_size; k++) {
+      y[k * y_stride] = output[k] * scale;
+    }
+  }
+
+ private:
+  size_t dft_length_;
+  bool inverse_;
+  bool packed_;
+  ComplexFft<T> fft_;
+  std::vector<std::complex<T>> split_twiddles_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
@@ -177,19 +177,34 @@ template <>
 struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
+// Splits the elements across the operator thread pool. The cost model keeps small tensors on the calling thread.
+// convert(in, out, count) converts a contiguous span of the elements.
+template <typename SrcType, typename DstType, typename ConvertFn>
+void ParallelConvert(const OpKernelContext& ctx, const SrcType* in_data, DstType* out_data, std::ptrdiff_t shape_size,
+                     ConvertFn convert) {
+  concurrency::ThreadPool::TryParallelFor(
+      ctx.GetOperatorThreadPool(), shape_size,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      [in_data, out_data, &convert](std::ptrdiff_t first, std::ptrdiff_t last) {
+        convert(in_data + first, out_data + first, last - first);
+      });
+}
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& ctx, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    ParallelConvert(ctx, reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()),
+                    reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size,
+                    [](const SrcEigenCastType* in_data, DstEigenCastType* out_data, std::ptrdiff_t count) {
+                      const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(in_data, count);
+                      auto out_vector = EigenVectorMap<DstEigenCastType>(out_data, count);
+                      out_vector = in_vector.template cast<DstEigenCastType>();
+                    });
   }
 };
 
@@ -224,13 +239,14 @@ struct TensorCaster<std::string, DstType> {
 // tensor X -> float 8
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCasterNoSat {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& ctx, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto* in_data = in.Data<SrcType>();
-    auto* out_data = out.MutableData<DstType>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      out_data[i] = DstType(static_cast<float>(in_data[i]), false);
-    }
+    ParallelConvert(ctx, in.Data<SrcType>(), out.MutableData<DstType>(), shape_size,
+                    [](const SrcType* in_data, DstType* out_data, std::ptrdiff_t count) {
+                      for (std::ptrdiff_t i = 0; i < count; ++i) {
+                        out_data[i] = DstType(static_cast<float>(in_data[i]), false);
+                      }
+                    });
   }
 };
 
@@ -283,6 +299,41 @@ struct TensorCaster<MLFloat16, float> {
   }
 };
 
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& ctx, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelConvert(ctx, in.Data<float>(), out.MutableData<MLFloat16>(), narrow<std::ptrdiff_t>(shape.Size()),
+                    [](const float* in_data, MLFloat16* out_data, std::ptrdiff_t count) {
+                      MlasConvertFloatToHalfBuffer(in_data, out_data, static_cast<size_t>(count));
+                    });
+  }
+};
+
+// tensor float -> BFloat16, rounding to nearest even
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& ctx, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelConvert(ctx, in.Data<float>(), out.MutableData<BFloat16>(), narrow<std::ptrdiff_t>(shape.Size()),
+                    [](const float* in_data, BFloat16* out_data, std::ptrdiff_t count) {
+                      MlasConvertFloatToBFloat16Buffer(in_data, reinterpret_cast<uint16_t*>(out_data),
+                                                       static_cast<size_t>(count));
+                    });
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& ctx, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelConvert(ctx, in.Data<BFloat16>(), out.MutableData<float>(), narrow<std::ptrdiff_t>(shape.Size()),
+                    [](const BFloat16* in_data, float* out_data, std::ptrdiff_t count) {
+                      MlasConvertBFloat16ToFloatBuffer(reinterpret_cast<const uint16_t*>(in_data), out_data,
+                                                       static_cast<size_t>(count));
+                    });
+  }
+};
+
 #if defined(_M_AMD64) && !defined(_M_ARM64EC)
 // specializations to use optimized and Windows x64-specific
 
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 using namespace ::onnxruntime::common;
 
@@ -38,17 +43,29 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // The condition is split in blocks and the positive entries of each block are counted first, so that each block
+  // knows where its entries go in the output and the blocks can be copied in parallel.
+  constexpr std::ptrdiff_t kMinBlockSize = 16 * 1024;
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  onnxruntime::narrow<std::ptrdiff_t>(valid_condition_length) / kMinBlockSize));
+  const auto block_begin = [valid_condition_length, num_blocks](std::ptrdiff_t block) {
+    return static_cast<int64_t>(valid_condition_length * block / num_blocks);
+  };
+
+  std::vector<int64_t> block_offsets(onnxruntime::narrow<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    block_offsets[block + 1] = std::count(condition_data + block_begin(block),
+                                          condition_data + block_begin(block + 1), true);
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+  const int64_t positive_condition_count = block_offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,11 +85,11 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
+  // The flattened input is compressed like an input of shape [1, compress_input_length, 1] on axis 1.
+  int64_t axes_left_stride = 1;
+  int64_t axes_right_stride = 1;
   if (has_axis_) {
-    int64_t axes_left_stride = 1;
-    int64_t axes_right_stride = 1;
     for (int i = 0; i < axis; ++i) {
       axes_left_stride *= input_dimensions[i];
     }
@@ -80,44 +97,57 @@ Status Compress::Compute(OpKernelContext* ctx) const {
     for (auto i = static_cast<size_t>(axis + 1); i < rank; ++i) {
       axes_right_stride *= input_dimensions[i];
     }
-    int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
-    ORT_ENFORCE(axes_right_stride >= 0 &&
-                static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
-    size_t axes_right_stride_bytes = 0;
-    if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
-                                         &axes_right_stride_bytes))
-      return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
+  }
+  ORT_ENFORCE(axes_right_stride >= 0 &&
+              static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
+  size_t axes_right_stride_bytes = 0;
+  if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
+                                       &axes_right_stride_bytes))
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+
+  const int64_t axes_included_right_stride = axes_right_stride * compress_input_length;
+  const int64_t output_axes_included_right_stride = axes_right_stride * positive_condition_count;
+
+  // copies the entries [first, last) of the condition, which are all positive, for the left index i
+  const auto copy_entries = [&](int64_t i, int64_t first, int64_t last, int64_t output_entry) {
+    const int64_t input_offset = i * axes_included_right_stride + first * axes_right_stride;
+    const int64_t output_offset = i * output_axes_included_right_stride + output_entry * axes_right_stride;
+    const int64_t count = (last - first) * axes_right_stride;
+    if (is_string_type) {
+      std::copy_n(reinterpret_cast<const std::string*>(input_data) + input_offset, onnxruntime::narrow<size_t>(count),
+                  reinterpret_cast<std::string*>(output_data) + output_offset);
+    } else {
+      memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+             onnxruntime::narrow<size_t>(count) * element_bytes);
+    }
+  };
+
+  const std::ptrdiff_t num_work_items = onnxruntime::narrow<std::ptrdiff_t>(axes_left_stride) * num_blocks;
+  const double bytes_per_work_item =
+      static_cast<double>(positive_condition_count) / static_cast<double>(num_blocks) * axes_right_stride_bytes;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_work_items, TensorOpCost{bytes_per_work_item, bytes_per_work_item, 0.0},
+      [&](std::ptrdiff_t first_item, std::ptrdiff_t last_item) {
+        for (std::ptrdiff_t item = first_item; item < last_item; ++item) {
+          const int64_t i = item / num_blocks;
+          const std::ptrdiff_t block = item % num_blocks;
+          int64_t output_entry = block_offsets[block];
+
+          // runs of consecutive positive entries are copied together
+          for (int64_t j = block_begin(block), end = block_begin(block + 1); j < end;) {
+            if (!condition_data[j]) {
+              ++j;
+              continue;
+            }
+            const int64_t run_begin = j;
+            while (j < end && condition_data[j]) {
+              ++j;
+            }
+            copy_entries(i, run_begin, j, output_entry);
+            output_entry += j - run_begin;
           }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
         }
-      }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
-  }
+      });
 
   return Status::OK();
 }
@@ -3,9 +3,13 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 
+#include <cstring>
+
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/copy.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -245,10 +249,62 @@ TensorShapeVector StridesForStack(const TensorShapeVector& full_strides, uint64_
   }
   return strides;
 }
+
+// Copies contiguous inputs of a non-string type into the output, which has been allocated with its final size.
+// The output is viewed as [outer, output_axis_pitch] and each input as [outer, input_axis_pitch], so every
+// (row, input) pair is a single memcpy to a precomputed offset. Unlike copying the inputs one at a time, this
+// parallelizes across all the inputs at once, which matters for ConcatFromSequence with many small tensors.
+void ConcatContiguousInputs(const Prepare& p, concurrency::ThreadPool* thread_pool) {
+  const size_t element_size = p.output_tensor->DataType()->Size();
+  const size_t input_count = p.inputs.size();
+  const size_t output_row_bytes = SafeInt<size_t>(p.output_axis_pitch) * element_size;
+  const size_t outer_count = onnxruntime::narrow<size_t>(p.output_num_elements / p.output_axis_pitch);
+
+  InlinedVector<size_t, Prepare::kExpectedNumberOfInputs> row_offsets;
+  row_offsets.reserve(input_count);
+  size_t row_offset = 0;
+  for (const auto& prep : p.inputs) {
+    row_offsets.push_back(row_offset);
+    row_offset += onnxruntime::narrow<size_t>(prep.num_elements == 0 ? 0 : prep.axis_pitch) * element_size;
+  }
+
+  auto* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+  const double average_bytes = static_cast<double>(output_row_bytes) / static_cast<double>(input_count);
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(outer_count * input_count),
+      TensorOpCost{average_bytes, average_bytes, 0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const size_t row = static_cast<size_t>(i) / input_count;
+          const size_t input_index = static_cast<size_t>(i) % input_count;
+          const auto& prep = p.inputs[input_index];
+          if (prep.num_elements == 0)
+            continue;
+
+          const size_t input_row_bytes = static_cast<size_t>(prep.axis_pitch) * element_size;
+          const auto* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
+          std::memcpy(output + row * output_row_bytes + row_offsets[input_index],
+                      input + row * input_row_bytes, input_row_bytes);
+        }
+      });
+}
 }  // namespace
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
 Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
+  bool inputs_are_contiguous = !p.is_string_type;
+#ifdef ENABLE_STRIDED_TENSORS
+  for (const auto& prep : p.inputs) {
+    inputs_are_contiguous = inputs_are_contiguous && prep.tensor->IsContiguous();
+  }
+#endif
+
+  if (inputs_are_contiguous) {
+    ConcatContiguousInputs(p, ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   int input_count = static_cast<int>(p.inputs.size());
   int64_t initial_output_offset = 0;  // initial offset for each input
 
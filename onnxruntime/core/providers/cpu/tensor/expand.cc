@@ -4,22 +4,33 @@
 #include "expand.h"
 #include <cmath>
 #include <core/common/safeint.h>
+#ifdef ENABLE_STRIDED_TENSORS
+#include "core/framework/copy.h"
+#include "core/framework/element_type_lists.h"
+#endif
 
 namespace onnxruntime {
 
-#define REG_EXPAND_KERNEL(TYPE)                                                    \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                        \
-      Expand,                                                                      \
-      8,                                                                           \
-      12,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
-      Expand<TYPE>);                                                               \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      Expand,                                                                      \
-      13,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+// The expanded tensor can be a view of the input with a stride of 0 along the expanded dims.
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder()
+#endif
+
+#define REG_EXPAND_KERNEL(TYPE)                                                          \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                              \
+      Expand,                                                                            \
+      8,                                                                                 \
+      12,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      Expand<TYPE>);                                                                     \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                        \
+      Expand,                                                                            \
+      13,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       Expand<TYPE>);
 
 REG_EXPAND_KERNEL(float)
@@ -35,6 +46,24 @@ REG_EXPAND_KERNEL(uint64_t)
 REG_EXPAND_KERNEL(bool)
 REG_EXPAND_KERNEL(MLFloat16)
 
+#ifdef ENABLE_STRIDED_TENSORS
+namespace {
+// Strides of the view of the input as the expanded output.
+TensorShapeVector ComputeExpandedStrides(const TensorShape& input_shape, gsl::span<const int64_t> input_strides,
+                                         const TensorShape& output_shape) {
+  const size_t rank = output_shape.NumDimensions();
+  const size_t offset = rank - input_shape.NumDimensions();
+  TensorShapeVector output_strides(rank, 0);
+  for (size_t dim = offset; dim < rank; ++dim) {
+    if (input_shape[dim - offset] == output_shape[dim]) {
+      output_strides[dim] = input_strides[dim - offset];
+    }
+  }
+  return output_strides;
+}
+}  // namespace
+#endif
+
 template <typename T>
 Status Expand<T>::Compute(OpKernelContext* context) const {
   const auto* input_tensor = context->Input<Tensor>(0);
@@ -69,6 +98,28 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
+
+#ifdef ENABLE_STRIDED_TENSORS
+  if (!output_shape.empty() &&
+      (output_tensor->DataRaw() == input_tensor->DataRaw() || !input_tensor->IsContiguous())) {
+    TensorShapeVector output_strides =
+        ComputeExpandedStrides(input_tensor->Shape(), input_tensor->Strides(), output_tensor_shape);
+
+    // Strided output, the planner let the output share the buffer of the input.
+    if (output_tensor->DataRaw() == input_tensor->DataRaw()) {
+      output_tensor->SetShapeAndStrides(output_tensor_shape, output_strides);
+      return Status::OK();
+    }
+
+    // Strided input, copy the expanded view into the contiguous output.
+    const auto contiguous_strides = output_tensor->Strides();
+    return DispatchStridedCopy<element_type_lists::All>(context->GetOperatorThreadPool(), *output_tensor, 0,
+                                                        TensorShapeVector(contiguous_strides.begin(),
+                                                                          contiguous_strides.end()),
+                                                        output_tensor_shape, *input_tensor, 0, output_strides);
+  }
+#endif
+
   auto* output_data = output_tensor->MutableData<T>();
   auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
@@ -5,6 +5,7 @@
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
 #include "core/common/narrow.h"
+#include "core/common/prefetch.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -102,15 +103,18 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
+  auto get_src_offset = [&](int64_t index) {
+    Tin idx = indices_data[index % N];
+    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+    return index / N * data_batch_bytes + idx * block_size;
+  };
+
   auto lambda = [&](int64_t index) {
     int64_t batch = index / N;
     int64_t i = index % N;
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
     const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
+    const int64_t src_offset = get_src_offset(index);
     const int64_t dst_offset = dst_offset_batch + i * block_size;
 
     if (is_string_type) {
@@ -120,9 +124,19 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
       memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
     }
   };
+  // the rows of an embedding lookup are scattered over a table much larger than the cache. prefetch the row a few
+  // indices ahead so its load overlaps with the copy of the current rows.
+  constexpr int64_t kPrefetchDistance = 4;
+  constexpr int64_t kMaxPrefetchBytes = 4096;
+  const bool prefetch = !is_string_type && block_size <= kMaxPrefetchBytes;
+
   concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
+                                          [&](ptrdiff_t first, ptrdiff_t last) {
+                                            for (int64_t index = first, end = last; index < end; ++index) {
+                                              if (prefetch && index + kPrefetchDistance < end) {
+                                                PrefetchForRead(src_base + get_src_offset(index + kPrefetchDistance),
+                                                                narrow<size_t>(block_size));
+                                              }
                                               lambda(index);
                                             }
                                           });
@@ -1,5 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <atomic>
 #include <core/common/safeint.h>
 #include "gather_nd.h"
 #include "core/platform/threadpool.h"
@@ -73,7 +74,8 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
     sizes_from_slice_dims[onnxruntime::narrow<size_t>(i)] = input_shape.SizeFromDimension(SafeInt<size_t>(batch_dims_) + i + 1);
   }
 
-  int64_t err_index = 0;
+  std::atomic<bool> found_err_index{false};
+  std::atomic<int64_t> err_index{0};
   p.element_bytes = bytes_per_value;
   p.element_count_per_slice = slice_size;
   p.bytes_per_slice = p.element_bytes * p.element_count_per_slice;
@@ -81,7 +83,7 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
   p.slice_offsets.assign(onnxruntime::narrow<size_t>(num_slices), 0LL);
 
   // Compute the element_offset
-  auto lambda = [&](int64_t slice_idx) {
+  auto lambda = [&](std::ptrdiff_t slice_idx) {
     const size_t batch_idx = onnxruntime::narrow<size_t>(slice_idx / num_slices_per_batch);
     const size_t input_base_offset = batch_idx * SafeInt<size_t>(input_batch_stride);
 
@@ -92,7 +94,8 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
       const auto upper_limit = input_shape[SafeInt<size_t>(batch_dims_) + dim_idx];
       const auto lower_limit = -upper_limit;
       if (index < lower_limit || index >= upper_limit) {
-        err_index = index;
+        err_index.store(index, std::memory_order_relaxed);
+        found_err_index.store(true, std::memory_order_relaxed);
         break;
       }
       if (index < 0) index += upper_limit;
@@ -106,13 +109,14 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
   concurrency::ThreadPool::TryParallelFor(
       tp, onnxruntime::narrow<size_t>(num_slices), static_cast<double>(num_slice_dims),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (std::ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
 
-  return err_index == 0 ? Status::OK()
-                        : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ", err_index);
+  return !found_err_index ? Status::OK()
+                          : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ",
+                                            err_index.load());
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(const TensorShape&,
@@ -176,16 +180,51 @@ Status GatherND::Compute(OpKernelContext* context) const {
   return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
+namespace {
+// Small slices are copied with a fixed size memcpy, which compiles to a single load and store, instead of calling
+// memcpy for every slice.
+template <size_t BytesPerSlice>
+void GatherSmallSlices(const uint8_t* input_base, uint8_t* output_base, const uint64_t* slice_offsets,
+                       uint64_t element_bytes, std::ptrdiff_t first, std::ptrdiff_t last) {
+  for (std::ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
+    memcpy(output_base + slice_idx * BytesPerSlice, input_base + slice_offsets[slice_idx] * element_bytes,
+           BytesPerSlice);
+  }
+}
+}  // namespace
+
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
-  };
+  const uint64_t* slice_offsets = p.slice_offsets.data();
+  const size_t bytes_per_slice = onnxruntime::narrow<size_t>(p.bytes_per_slice);
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        switch (bytes_per_slice) {
+          case 1:
+            GatherSmallSlices<1>(p.input_base, p.output_base, slice_offsets, p.element_bytes, first, last);
+            return;
+          case 2:
+            GatherSmallSlices<2>(p.input_base, p.output_base, slice_offsets, p.element_bytes, first, last);
+            return;
+          case 4:
+            GatherSmallSlices<4>(p.input_base, p.output_base, slice_offsets, p.element_bytes, first, last);
+            return;
+          case 8:
+            GatherSmallSlices<8>(p.input_base, p.output_base, slice_offsets, p.element_bytes, first, last);
+            return;
+          default:
+            break;
+        }
+
+        // Consecutive slices that are also consecutive in the input are copied with a single memcpy.
+        for (std::ptrdiff_t slice_idx = first; slice_idx < last;) {
+          std::ptrdiff_t end = slice_idx + 1;
+          while (end < last && slice_offsets[end] == slice_offsets[end - 1] + p.element_count_per_slice) {
+            ++end;
+          }
+          memcpy(p.output_base + slice_idx * bytes_per_slice, p.input_base + slice_offsets[slice_idx] * p.element_bytes,
+                 (end - slice_idx) * bytes_per_slice);
+          slice_idx = end;
         }
       });
   return Status::OK();
@@ -201,7 +240,7 @@ Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) con
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.element_count_per_slice),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (std::ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
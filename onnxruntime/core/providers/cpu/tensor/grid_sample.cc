@@ -97,55 +97,65 @@ void GsGetCubicCoeffs(T x, T coeffs[4]) {
 }
 
 template <typename T>
-T GsBicubicInterpolate(T p[4][4], T x, T y) {
+T GsBicubicInterpolate(T p[4][4], const T coeffs_x[4], const T coeffs_y[4]) {
   T v[4] = {};
-  T coeffs[4] = {};
-  GsGetCubicCoeffs(x, coeffs);
   for (int64_t i = 0; i < 4; i++) {
-    v[i] = coeffs[0] * p[i][0] + coeffs[1] * p[i][1] + coeffs[2] * p[i][2] + coeffs[3] * p[i][3];
+    v[i] = coeffs_x[0] * p[i][0] + coeffs_x[1] * p[i][1] + coeffs_x[2] * p[i][2] + coeffs_x[3] * p[i][3];
   }
-  GsGetCubicCoeffs(y, coeffs);
-  return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
+  return static_cast<T>(coeffs_y[0] * v[0] + coeffs_y[1] * v[1] + coeffs_y[2] * v[2] + coeffs_y[3] * v[3]);
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
-  T pixel = {};  // default 0
+T GsPixelAt(const T* image, int64_t offset) {
+  return offset < 0 ? T{} : image[offset];
+}
+
+// The output pixels are sampled in blocks. The input pixel offsets and the interpolation weights of a block are
+// computed once and then reused for every channel, so the coordinate math is not repeated C times.
+constexpr int64_t kGsBlockSize = 256;
+
+// The channels are only split across tasks when there are too few pixel blocks to keep the threads busy,
+// as each task computes the sampling locations of its block again.
+static int64_t GsChannelGroupCount(concurrency::ThreadPool* tp, int64_t block_count, int64_t C) {
+  const int64_t task_count = static_cast<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(tp)) * 4;
+  return std::clamp<int64_t>(task_count / block_count, 1, C);
+}
+
+template <typename T>
+int64_t GridSample<T>::PixelOffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const T border[/* 4 */]) const {
   if (padding_mode_ == Zeros) {
     if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+      return r * W + c;
     }
+    return -1;
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
+  return r * W + c;
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::PixelOffsetAtGrid3D(int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W,
+                                           const T border[/* 6 */]) const {
   if (padding_mode_ == Zeros) {
     if (w >= 0 && w < W && h >= 0 && h < H && d >= 0 && d < D) {
-      pixel = image[d * H * W + h * W + w];
+      return d * H * W + h * W + w;
     }
+    return -1;
   } else if (padding_mode_ == Border) {
     w = std::clamp<int64_t>(w, 0, W - 1);
     h = std::clamp<int64_t>(h, 0, H - 1);
     d = std::clamp<int64_t>(d, 0, D - 1);
-    pixel = image[d * H * W + h * W + w];
   } else {  // (padding_mode_ == Reflection)
     w = static_cast<int64_t>(GsReflect(static_cast<T>(w), border[0], border[3]));
     h = static_cast<int64_t>(GsReflect(static_cast<T>(h), border[1], border[4]));
     d = static_cast<int64_t>(GsReflect(static_cast<T>(d), border[2], border[5]));
-    pixel = image[d * H * W + h * W + w];
   }
-  return pixel;
+  return d * H * W + h * W + w;
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -210,62 +220,114 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
     concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-            for (int64_t oy = 0; oy < H_out; oy++) {
-              for (int64_t ox = 0; ox < W_out; ox++) {
-                const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-                T* Y_gridpoint = Y_data + oy * W_out + ox;
-                auto nx = gridpoint[0];  // normalized location
-                auto ny = gridpoint[1];
-                auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-                if (mode_ == Nearest) {
-                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                  // x, y are integers in all padding modes
-                  *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
-
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-                } else if (mode_ == Cubic) {
-                  int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                  int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-
-                  T p[4][4] = {};  // [H][W]
-                  for (int64_t h = 0; h < 4; h++) {
-                    for (int64_t w = 0; w < 4; w++) {
-                      p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                    }
+    const int64_t in_size = H_in * W_in;
+    const int64_t out_size = H_out * W_out;
+    const int64_t block_count = (out_size + kGsBlockSize - 1) / kGsBlockSize;
+    const int64_t channel_group_count = GsChannelGroupCount(tp, N * block_count, C);
+
+    // Number of input pixels and interpolation weights for each output pixel
+    const int64_t pixel_count = mode_ == Cubic ? 16 : (mode_ == Linear ? 4 : 1);
+    const int64_t weight_count = mode_ == Cubic ? 8 : (mode_ == Linear ? 4 : 0);
+
+    const T* input_data = input->Data<T>();
+    T* output_data = Y.MutableData<T>();
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N * block_count * channel_group_count),
+        [&](std::ptrdiff_t task) {
+          const int64_t channel_group = task % channel_group_count;
+          const int64_t block = (task / channel_group_count) % block_count;
+          const int64_t n = task / (channel_group_count * block_count);
+          const int64_t block_begin = block * kGsBlockSize;
+          const int64_t block_size = std::min(kGsBlockSize, out_size - block_begin);
+
+          std::vector<int64_t> offsets(onnxruntime::narrow<size_t>(block_size * pixel_count));
+          std::vector<T> weights(onnxruntime::narrow<size_t>(block_size * weight_count));
+
+          const T* grid_data = grid->Data<T>() + (n * out_size + block_begin) * 2;
+          for (int64_t i = 0; i < block_size; i++) {
+            const T* gridpoint = grid_data + i * 2;
+            int64_t* pixel_offsets = offsets.data() + i * pixel_count;
+            T* pixel_weights = weights.data() + i * weight_count;
+            auto nx = gridpoint[0];  // normalized location
+            auto ny = gridpoint[1];
+            auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+            auto y = GsDenormalize<T>(ny, H_in, align_corners_);
+
+            if (mode_ == Nearest) {
+              x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+              y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+              // x, y are integers in all padding modes
+              pixel_offsets[0] = PixelOffsetAtGrid(static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
+            } else if (mode_ == Linear) {
+              int64_t x1 = static_cast<int64_t>(std::floor(x));
+              int64_t y1 = static_cast<int64_t>(std::floor(y));
+              int64_t x2 = x1 + 1;
+              int64_t y2 = y1 + 1;
+
+              pixel_offsets[0] = PixelOffsetAtGrid(y1, x1, H_in, W_in, border);
+              pixel_offsets[1] = PixelOffsetAtGrid(y1, x2, H_in, W_in, border);
+              pixel_offsets[2] = PixelOffsetAtGrid(y2, x1, H_in, W_in, border);
+              pixel_offsets[3] = PixelOffsetAtGrid(y2, x2, H_in, W_in, border);
+
+              pixel_weights[0] = static_cast<T>(x2) - x;  // dx2
+              pixel_weights[1] = x - static_cast<T>(x1);  // dx1
+              pixel_weights[2] = static_cast<T>(y2) - y;  // dy2
+              pixel_weights[3] = y - static_cast<T>(y1);  // dy1
+            } else if (mode_ == Cubic) {
+              int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+              int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+
+              for (int64_t h = 0; h < 4; h++) {
+                for (int64_t w = 0; w < 4; w++) {
+                  pixel_offsets[h * 4 + w] = PixelOffsetAtGrid(h + y0, w + x0, H_in, W_in, border);
+                }
+              }
+              GsGetCubicCoeffs(static_cast<T>(x - x0 - 1), pixel_weights);
+              GsGetCubicCoeffs(static_cast<T>(y - y0 - 1), pixel_weights + 4);
+            }
+          }
+
+          const int64_t c_begin = C * channel_group / channel_group_count;
+          const int64_t c_end = C * (channel_group + 1) / channel_group_count;
+          for (int64_t c = c_begin; c < c_end; c++) {
+            const T* X_data = input_data + (n * C + c) * in_size;
+            T* Y_data = output_data + (n * C + c) * out_size + block_begin;
+
+            if (mode_ == Nearest) {
+              for (int64_t i = 0; i < block_size; i++) {
+                Y_data[i] = GsPixelAt(X_data, offsets[i]);
+              }
+            } else if (mode_ == Linear) {
+              for (int64_t i = 0; i < block_size; i++) {
+                const int64_t* pixel_offsets = offsets.data() + i * 4;
+                const T* pixel_weights = weights.data() + i * 4;
+                T p11 = GsPixelAt(X_data, pixel_offsets[0]);
+                T p12 = GsPixelAt(X_data, pixel_offsets[1]);
+                T p21 = GsPixelAt(X_data, pixel_offsets[2]);
+                T p22 = GsPixelAt(X_data, pixel_offsets[3]);
+
+                T dx2 = pixel_weights[0];
+                T dx1 = pixel_weights[1];
+                T dy2 = pixel_weights[2];
+                T dy1 = pixel_weights[3];
+                Y_data[i] = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
+              }
+            } else if (mode_ == Cubic) {
+              for (int64_t i = 0; i < block_size; i++) {
+                const int64_t* pixel_offsets = offsets.data() + i * 16;
+                const T* pixel_weights = weights.data() + i * 8;
+                T p[4][4] = {};  // [H][W]
+                for (int64_t h = 0; h < 4; h++) {
+                  for (int64_t w = 0; w < 4; w++) {
+                    p[h][w] = GsPixelAt(X_data, pixel_offsets[h * 4 + w]);
                   }
-                  T dx = static_cast<T>(x - x0 - 1);
-                  T dy = static_cast<T>(y - y0 - 1);
-                  *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
                 }
+                Y_data[i] = GsBicubicInterpolate(p, pixel_weights, pixel_weights + 4);
               }
             }
-          });
-    }
+          }
+        });
   } else if (data_dims == 3) {
     // sample 3d;
     auto D_in = input_dims[2];
@@ -299,67 +361,113 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     T border[] = {x_min, y_min, z_min, x_max, y_max, z_max};
 
     concurrency::ThreadPool* tp = D_out * H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (D_out * H_out * W_out) * 3;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (D_in * H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (D_out * H_out * W_out);
-
-            for (int64_t oz = 0; oz < D_out; oz++) {
-              for (int64_t oy = 0; oy < H_out; oy++) {
-                for (int64_t ox = 0; ox < W_out; ox++) {
-                  const T* gridpoint = grid_data + (oz * H_out * W_out + oy * W_out + ox) * 3;
-                  T* Y_gridpoint = Y_data + oz * H_out * W_out + oy * W_out + ox;
-                  auto nx = gridpoint[0];  // normalized location
-                  auto ny = gridpoint[1];
-                  auto nz = gridpoint[2];
-                  auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                  auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-                  auto z = GsDenormalize<T>(nz, D_in, align_corners_);
-
-                  if (mode_ == Nearest) {
-                    x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                    y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                    z = static_cast<T>(std::nearbyint(static_cast<T>(z)));
-
-                    // x, y are integers in all padding modes
-                    *Y_gridpoint = PixelAtGrid3D(X_data, static_cast<int64_t>(z), static_cast<int64_t>(y), static_cast<int64_t>(x),
-                                                 D_in, H_in, W_in, border);
-                  } else if (mode_ == Linear) {
-                    int64_t x1 = static_cast<int64_t>(std::floor(x));
-                    int64_t y1 = static_cast<int64_t>(std::floor(y));
-                    int64_t z1 = static_cast<int64_t>(std::floor(z));
-                    int64_t x2 = x1 + 1;
-                    int64_t y2 = y1 + 1;
-                    int64_t z2 = z1 + 1;
-
-                    T dx2 = static_cast<T>(x2) - x;
-                    T dx1 = x - static_cast<T>(x1);
-                    T dy2 = static_cast<T>(y2) - y;
-                    T dy1 = y - static_cast<T>(y1);
-                    T dz2 = static_cast<T>(z2) - z;
-                    T dz1 = z - static_cast<T>(z1);
-
-                    T p111 = PixelAtGrid3D(X_data, z1, y1, x1, D_in, H_in, W_in, border);
-                    T p112 = PixelAtGrid3D(X_data, z1, y1, x2, D_in, H_in, W_in, border);
-                    T p121 = PixelAtGrid3D(X_data, z1, y2, x1, D_in, H_in, W_in, border);
-                    T p122 = PixelAtGrid3D(X_data, z1, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z1 = dy2 * (dx2 * p111 + dx1 * p112) + dy1 * (dx2 * p121 + dx1 * p122);
-
-                    T p211 = PixelAtGrid3D(X_data, z2, y1, x1, D_in, H_in, W_in, border);
-                    T p212 = PixelAtGrid3D(X_data, z2, y1, x2, D_in, H_in, W_in, border);
-                    T p221 = PixelAtGrid3D(X_data, z2, y2, x1, D_in, H_in, W_in, border);
-                    T p222 = PixelAtGrid3D(X_data, z2, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z2 = dy2 * (dx2 * p211 + dx1 * p212) + dy1 * (dx2 * p221 + dx1 * p222);
-                    *Y_gridpoint = dz2 * Y_gridpoint_z1 + dz1 * Y_gridpoint_z2;
-                  }
-                }
+    const int64_t in_size = D_in * H_in * W_in;
+    const int64_t out_size = D_out * H_out * W_out;
+    const int64_t block_count = (out_size + kGsBlockSize - 1) / kGsBlockSize;
+    const int64_t channel_group_count = GsChannelGroupCount(tp, N * block_count, C);
+
+    // Number of input pixels and interpolation weights for each output pixel
+    const int64_t pixel_count = mode_ == Linear ? 8 : 1;
+    const int64_t weight_count = mode_ == Linear ? 6 : 0;
+
+    const T* input_data = input->Data<T>();
+    T* output_data = Y.MutableData<T>();
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N * block_count * channel_group_count),
+        [&](std::ptrdiff_t task) {
+          const int64_t channel_group = task % channel_group_count;
+          const int64_t block = (task / channel_group_count) % block_count;
+          const int64_t n = task / (channel_group_count * block_count);
+          const int64_t block_begin = block * kGsBlockSize;
+          const int64_t block_size = std::min(kGsBlockSize, out_size - block_begin);
+
+          std::vector<int64_t> offsets(onnxruntime::narrow<size_t>(block_size * pixel_count));
+          std::vector<T> weights(onnxruntime::narrow<size_t>(block_size * weight_count));
+
+          const T* grid_data = grid->Data<T>() + (n * out_size + block_begin) * 3;
+          for (int64_t i = 0; i < block_size; i++) {
+            const T* gridpoint = grid_data + i * 3;
+            int64_t* pixel_offsets = offsets.data() + i * pixel_count;
+            T* pixel_weights = weights.data() + i * weight_count;
+            auto nx = gridpoint[0];  // normalized location
+            auto ny = gridpoint[1];
+            auto nz = gridpoint[2];
+            auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+            auto y = GsDenormalize<T>(ny, H_in, align_corners_);
+            auto z = GsDenormalize<T>(nz, D_in, align_corners_);
+
+            if (mode_ == Nearest) {
+              x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+              y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+              z = static_cast<T>(std::nearbyint(static_cast<T>(z)));
+
+              // x, y are integers in all padding modes
+              pixel_offsets[0] = PixelOffsetAtGrid3D(static_cast<int64_t>(z), static_cast<int64_t>(y),
+                                                     static_cast<int64_t>(x), D_in, H_in, W_in, border);
+            } else if (mode_ == Linear) {
+              int64_t x1 = static_cast<int64_t>(std::floor(x));
+              int64_t y1 = static_cast<int64_t>(std::floor(y));
+              int64_t z1 = static_cast<int64_t>(std::floor(z));
+              int64_t x2 = x1 + 1;
+              int64_t y2 = y1 + 1;
+              int64_t z2 = z1 + 1;
+
+              pixel_weights[0] = static_cast<T>(x2) - x;  // dx2
+              pixel_weights[1] = x - static_cast<T>(x1);  // dx1
+              pixel_weights[2] = static_cast<T>(y2) - y;  // dy2
+              pixel_weights[3] = y - static_cast<T>(y1);  // dy1
+              pixel_weights[4] = static_cast<T>(z2) - z;  // dz2
+              pixel_weights[5] = z - static_cast<T>(z1);  // dz1
+
+              pixel_offsets[0] = PixelOffsetAtGrid3D(z1, y1, x1, D_in, H_in, W_in, border);
+              pixel_offsets[1] = PixelOffsetAtGrid3D(z1, y1, x2, D_in, H_in, W_in, border);
+              pixel_offsets[2] = PixelOffsetAtGrid3D(z1, y2, x1, D_in, H_in, W_in, border);
+              pixel_offsets[3] = PixelOffsetAtGrid3D(z1, y2, x2, D_in, H_in, W_in, border);
+              pixel_offsets[4] = PixelOffsetAtGrid3D(z2, y1, x1, D_in, H_in, W_in, border);
+              pixel_offsets[5] = PixelOffsetAtGrid3D(z2, y1, x2, D_in, H_in, W_in, border);
+              pixel_offsets[6] = PixelOffsetAtGrid3D(z2, y2, x1, D_in, H_in, W_in, border);
+              pixel_offsets[7] = PixelOffsetAtGrid3D(z2, y2, x2, D_in, H_in, W_in, border);
+            }
+          }
+
+          const int64_t c_begin = C * channel_group / channel_group_count;
+          const int64_t c_end = C * (channel_group + 1) / channel_group_count;
+          for (int64_t c = c_begin; c < c_end; c++) {
+            const T* X_data = input_data + (n * C + c) * in_size;
+            T* Y_data = output_data + (n * C + c) * out_size + block_begin;
+
+            if (mode_ == Nearest) {
+              for (int64_t i = 0; i < block_size; i++) {
+                Y_data[i] = GsPixelAt(X_data, offsets[i]);
+              }
+            } else if (mode_ == Linear) {
+              for (int64_t i = 0; i < block_size; i++) {
+                const int64_t* pixel_offsets = offsets.data() + i * 8;
+                const T* pixel_weights = weights.data() + i * 6;
+                T dx2 = pixel_weights[0];
+                T dx1 = pixel_weights[1];
+                T dy2 = pixel_weights[2];
+                T dy1 = pixel_weights[3];
+                T dz2 = pixel_weights[4];
+                T dz1 = pixel_weights[5];
+
+                T p111 = GsPixelAt(X_data, pixel_offsets[0]);
+                T p112 = GsPixelAt(X_data, pixel_offsets[1]);
+                T p121 = GsPixelAt(X_data, pixel_offsets[2]);
+                T p122 = GsPixelAt(X_data, pixel_offsets[3]);
+                T Y_gridpoint_z1 = dy2 * (dx2 * p111 + dx1 * p112) + dy1 * (dx2 * p121 + dx1 * p122);
+
+                T p211 = GsPixelAt(X_data, pixel_offsets[4]);
+                T p212 = GsPixelAt(X_data, pixel_offsets[5]);
+                T p221 = GsPixelAt(X_data, pixel_offsets[6]);
+                T p222 = GsPixelAt(X_data, pixel_offsets[7]);
+                T Y_gridpoint_z2 = dy2 * (dx2 * p211 + dx1 * p212) + dy1 * (dx2 * p221 + dx1 * p222);
+                Y_data[i] = dz2 * Y_gridpoint_z1 + dz1 * Y_gridpoint_z2;
               }
             }
-          });
-    }
+          }
+        });
   } else {
     // shall not reach here due to above checks
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Only support GirdSample in 4-D or 5-D cases.");
@@ -68,8 +68,10 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
-  T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
-  T PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const;
+  // Return the offset of the input pixel at the location after padding, or -1 for a zero padded pixel
+  int64_t PixelOffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const T border[/* 4 */]) const;
+  int64_t PixelOffsetAtGrid3D(int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W,
+                              const T border[/* 6 */]) const;
 
   GridSampleInterpolationMode mode_{Linear};
   GridSamplePaddingMode padding_mode_{Zeros};
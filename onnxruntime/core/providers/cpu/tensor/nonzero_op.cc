@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -59,59 +62,76 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const int64_t num_non_zero_values = *data != T{} ? 1 : 0;
+    Tensor* const Y = context->Output(0, {1, num_non_zero_values});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (num_non_zero_values != 0) {
+      *Y->MutableData<int64_t>() = 0;
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
+    return Status::OK();
+  }
+
+  const auto dims = X_shape.GetDims();
+  const size_t rank = dims.size();
+  const std::ptrdiff_t size = onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size());
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // the non-zero values of each block of X are counted first, so that each block knows where its coordinates go
+  // in the output and the blocks can be written in parallel
+  constexpr std::ptrdiff_t kMinBlockSize = 16 * 1024;
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), size / kMinBlockSize));
+  const auto block_begin = [size, num_blocks](std::ptrdiff_t block) { return size * block / num_blocks; };
+
+  std::vector<int64_t> block_offsets(onnxruntime::narrow<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    block_offsets[block + 1] = std::count_if(data + block_begin(block), data + block_begin(block + 1),
+                                             [](const T& value) { return value != T{}; });
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+  const int64_t num_non_zero_values = block_offsets.back();
+  Tensor* const Y = context->Output(0, {static_cast<int64_t>(rank), num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  // the output is [rank, num_non_zero_values] so each coordinate is written directly to its column
+  int64_t* y_data = Y->MutableData<int64_t>();
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const std::ptrdiff_t begin = block_begin(block);
+    const std::ptrdiff_t end = block_begin(block + 1);
 
     // as we iterate the entries, increment the coordinate for the current entry
     // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
+    TensorShapeVector coordinate(rank);
+    for (size_t idx = rank, remaining = static_cast<size_t>(begin); idx-- > 0;) {
+      const size_t dim = static_cast<size_t>(dims[idx]);
+      coordinate[idx] = static_cast<int64_t>(remaining % dim);
+      remaining /= dim;
+    }
+
+    int64_t output_idx = block_offsets[block];
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      if (data[i] != T{}) {
+        for (size_t idx = 0; idx < rank; ++idx) {
+          y_data[static_cast<int64_t>(idx) * num_non_zero_values + output_idx] = coordinate[idx];
         }
-        cur_coord = 0;
+        ++output_idx;
       }
-    };
 
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
+      for (size_t idx = rank; idx-- > 0;) {
+        if (++coordinate[idx] != dims[idx]) {
+          break;
+        }
+        coordinate[idx] = 0;
       }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Scatter
+#include <algorithm>
 #include <type_traits>
 #include <core/common/safeint.h>
 
@@ -10,6 +11,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #if defined(ENABLE_TRAINING_OPS)
@@ -266,7 +268,7 @@ template <class Tdata, typename FuncT>
 Status ScatterData(
     const FuncT& func,
     const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-    Tensor* data_output) {
+    Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
 
   const auto input_elements = input_data_shape.Size();
@@ -296,18 +298,6 @@ Status ScatterData(
   const auto num_dims = input_data_shape.NumDimensions();
   ORT_RETURN_IF_NOT(num_dims > 0, "ScatterElements op: input tensor must have at least one dimension");
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
-
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
   // would contain [6, 3, 1] since for each count of dim 1 it
@@ -335,64 +325,102 @@ Status ScatterData(
     }
   }
 
-  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const auto axis_idx = indices_data[narrow<size_t>(index)];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += narrow<size_t>(axis_idx * dim_block_size[narrow<size_t>(i)]);
-      } else {
-        dst_offset += narrow<size_t>(dim_counters[narrow<size_t>(i)] * dim_block_size[narrow<size_t>(i)]);
+  if (num_indices == 0) {
+    return Status::OK();
+  }
+
+  // Two updates can only write the same output element if their positions differ in the axis dimension only. So the
+  // updates are split into lines along the axis, [outer dims][axis][inner dims]: different lines write disjoint output
+  // elements and are processed in parallel, while the updates of a line are applied in order, which keeps the
+  // reductions deterministic. A work item is a block of consecutive inner positions of an outer position, so the
+  // updates and the indices are read contiguously.
+  const size_t axis_dim = narrow<size_t>(axis);
+  const int64_t outer_size = upd_shape.SizeToDimension(axis_dim);
+  const int64_t axis_size = upd_shape[axis_dim];
+  const int64_t inner_size = upd_shape.SizeFromDimension(axis_dim + 1);
+  const int64_t axis_block_size = dim_block_size[axis_dim];
+
+  // Offsets in the output of the inner positions, the same for every outer position and index.
+  // The input/output is of the same rank as indices/updates but the actual dimensions of indices/updates
+  // must be less or equal than that of input/output, so we walk through the inner positions with
+  // counters of the upd_shape dimensions and compute the offset with the input/output dim values.
+  // As each counter reaches its max (upd_shape) it resets to zero and we carry to the more
+  // significant dim (right to left)
+  std::vector<int64_t> inner_offsets(narrow<size_t>(inner_size));
+  {
+    std::vector<int64_t> dim_counters(num_dims);
+    int64_t offset = 0;
+    for (int64_t j = 0; j < inner_size; ++j) {
+      inner_offsets[narrow<size_t>(j)] = offset;
+      // Increment counters, the carry goes from the last dimension towards the axis
+      for (size_t i = num_dims - 1; i > axis_dim; --i) {
+        offset += dim_block_size[i];
+        if (++dim_counters[i] < upd_shape[i]) {
+          break;
+        }
+        offset -= dim_counters[i] * dim_block_size[i];
+        dim_counters[i] = 0;
       }
     }
+  }
 
-    func(dst_base + dst_offset, update_data + index);
+  constexpr int64_t kInnerBlockSize = 256;
+  const int64_t num_inner_blocks = (inner_size + kInnerBlockSize - 1) / kInnerBlockSize;
+  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(outer_size * num_inner_blocks),
+      static_cast<double>(axis_size * std::min(inner_size, kInnerBlockSize)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t item = first; item < last; ++item) {
+          const int64_t outer = item / num_inner_blocks;
+          const int64_t inner_begin = (item % num_inner_blocks) * kInnerBlockSize;
+          const int64_t inner_end = std::min(inner_begin + kInnerBlockSize, inner_size);
+
+          // See comments above for dim_block_size
+          int64_t outer_offset = 0;
+          for (int64_t i = static_cast<int64_t>(axis_dim) - 1, remainder = outer; i >= 0; --i) {
+            const int64_t dim = upd_shape[narrow<size_t>(i)];
+            outer_offset += (remainder % dim) * dim_block_size[narrow<size_t>(i)];
+            remainder /= dim;
+          }
+
+          for (int64_t k = 0; k < axis_size; ++k) {
+            const int64_t line_start = (outer * axis_size + k) * inner_size;
+            for (int64_t j = inner_begin; j < inner_end; ++j) {
+              const int64_t index = line_start + j;
+              // replace the counter with the update index for the axis
+              const int64_t dst_offset = outer_offset + indices_data[narrow<size_t>(index)] * axis_block_size +
+                                         inner_offsets[narrow<size_t>(j)];
+              func(dst_base + dst_offset, update_data + index);
+            }
+          }
+        }
+      });
 
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[narrow<size_t>(i)];
-      assert(v <= upd_shape[narrow<size_t>(i)]);
-      if (v < upd_shape[narrow<size_t>(i)]) {
-        // No carry, done
-        break;
-      }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[narrow<size_t>(i)] = 0;
-    }
-  }
   return Status::OK();
 }
 
 template <typename TData>
 struct ScatterDataDispatchTarget {
   Status operator()(const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-                    const std::string& reduction, Tensor* data_output) const {
+                    const std::string& reduction, Tensor* data_output,
+                    concurrency::ThreadPool* tp) const {
     if (reduction == "add")
       return ScatterData<TData>(
-          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "mul")
       return ScatterData<TData>(
-          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "min")
       return ScatterData<TData>(
-          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "max")
       return ScatterData<TData>(
-          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else  // if (reduction == "none")
       return ScatterData<TData>(
-          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
   }
 };
 
@@ -462,7 +490,7 @@ Status Scatter<EnabledDataTypes>::Compute(OpKernelContext* context) const {
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledDataTypes> dispatcher{data_type};
   status = dispatcher.template InvokeRet<Status, ScatterDataDispatchTarget>(
-      data_input, indices_data, updates_input, axis, this->reduction_, data_output);
+      data_input, indices_data, updates_input, axis, this->reduction_, data_output, context->GetOperatorThreadPool());
 
   return status;
 }
@@ -483,7 +511,7 @@ Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates
                               const int64_t axis, Tensor* data_output) {
   std::vector<int64_t> indices_data{};
   ORT_RETURN_IF_ERROR(GetIndices<Tin>(*data_output, *indices_input, axis, indices_data));
-  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output);
+  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output, nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata) \
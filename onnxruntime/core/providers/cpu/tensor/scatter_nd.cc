@@ -3,6 +3,11 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -25,6 +30,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     11,
     12,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T",
                         BuildKernelDefConstraintsFromTypeList<EnabledScatterNDDataTypes>()),
     ScatterND);
@@ -34,6 +40,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     13,
     15,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T",
                         BuildKernelDefConstraintsFromTypeList<EnabledScatterNDDataTypes>()),
     ScatterND);
@@ -43,6 +50,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     16,
     17,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T",
                         BuildKernelDefConstraintsFromTypeList<EnabledScatterNDDataTypes>()),
     ScatterND);
@@ -51,6 +59,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     ScatterND,
     18,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T",
                         BuildKernelDefConstraintsFromTypeList<EnabledScatterNDDataTypes>()),
     ScatterND);
@@ -122,7 +131,7 @@ struct Prepare {
 };  // struct Prepare
 
 template <typename TData>
-Status PrepareForCompute(OpKernelContext* context, Prepare<TData>& p) {
+Status PrepareForCompute(OpKernelContext* context, Prepare<TData>& p, concurrency::ThreadPool* tp) {
   const auto* input_tensor = context->Input<Tensor>(0);
   const auto* indice_tensor = context->Input<Tensor>(1);
   const auto* update_tensor = context->Input<Tensor>(2);
@@ -168,24 +177,33 @@ Status PrepareForCompute(OpKernelContext* context, Prepare<TData>& p) {
   p.input_base = update_tensor->Data<TData>();
   p.output_base = output_tensor->MutableData<TData>();
 
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indice_dimension; ++j) {
-      auto indice = *(indice_offset + i * last_indice_dimension + j);
-
-      if (indice >= 0) {
-        if (indice >= input_shape[onnxruntime::narrow<size_t>(j)]) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", indice);
-        }
-      } else {
-        if (indice < -input_shape[onnxruntime::narrow<size_t>(j)]) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", indice);
-        } else {
-          indice += input_shape[onnxruntime::narrow<size_t>(j)];
+  std::atomic<bool> found_invalid_indice{false};
+  std::atomic<int64_t> invalid_indice{0};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(offset_count), static_cast<double>(last_indice_dimension),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t* slice_indices = indice_offset + i * last_indice_dimension;
+          uint64_t element_offset = 0;
+          for (int64_t j = 0; j < last_indice_dimension; ++j) {
+            auto indice = slice_indices[j];
+            const auto dim = input_shape[onnxruntime::narrow<size_t>(j)];
+            if (indice < -dim || indice >= dim) {
+              invalid_indice.store(indice, std::memory_order_relaxed);
+              found_invalid_indice.store(true, std::memory_order_relaxed);
+              return;
+            }
+            if (indice < 0) {
+              indice += dim;
+            }
+            element_offset += indice * element_counts[onnxruntime::narrow<size_t>(j)];
+          }
+          p.element_offsets[onnxruntime::narrow<size_t>(i)] = element_offset;
         }
-      }
+      });
 
-      p.element_offsets[onnxruntime::narrow<size_t>(i)] += indice * element_counts[onnxruntime::narrow<size_t>(j)];
-    }
+  if (found_invalid_indice) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", invalid_indice.load());
   }
   return Status::OK();
 }
@@ -350,59 +368,96 @@ struct Func_Max_ND<BFloat16> {
   }
 };
 
+// Without a reduction every slice is written independently, with duplicate indices any of the updates may win as
+// allowed by the spec. Consecutive slices that are also consecutive in the output are written with a single copy.
+template <typename TData>
+void ScatterNDCopySlices(const Prepare<TData>& p, concurrency::ThreadPool* tp) {
+  const auto& offsets = p.element_offsets;
+  const uint64_t slice_size = p.element_to_copy;
+  const auto func = Func_Copy_ND<TData>();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, offsets.size(), static_cast<double>(slice_size),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last;) {
+          std::ptrdiff_t end = i + 1;
+          while (end < last && offsets[end] == offsets[end - 1] + slice_size) {
+            ++end;
+          }
+          func(p.output_base + offsets[i], p.input_base + i * slice_size, (end - i) * slice_size);
+          i = end;
+        }
+      });
+}
+
+// With a reduction the updates of the slices with the same index must be applied one after the other, in the order
+// of the indices. Slices with different indices don't overlap, so the slices are ordered by their offset in the output
+// and the groups of slices with the same offset are reduced in parallel.
+template <typename TData, typename FuncT>
+void ScatterNDReduceSlices(const FuncT& func, const Prepare<TData>& p, concurrency::ThreadPool* tp) {
+  const auto& offsets = p.element_offsets;
+  const size_t num_slices = offsets.size();
+  const uint64_t slice_size = p.element_to_copy;
+  auto reduce_slice = [&](size_t i) {
+    func(p.output_base + offsets[i], p.input_base + i * slice_size, slice_size);
+  };
+
+  // Ordering the slices only pays off when reducing a slice costs more than the sort does per slice.
+  if (num_slices < 2 || concurrency::ThreadPool::DegreeOfParallelism(tp) == 1 ||
+      static_cast<double>(slice_size) <= std::log2(static_cast<double>(num_slices))) {
+    for (size_t i = 0; i < num_slices; ++i) {
+      reduce_slice(i);
+    }
+    return;
+  }
+
+  std::vector<size_t> order(num_slices);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&offsets](size_t a, size_t b) { return offsets[a] < offsets[b]; });
+
+  std::vector<size_t> group_starts;
+  for (size_t i = 0; i < num_slices; ++i) {
+    if (i == 0 || offsets[order[i]] != offsets[order[i - 1]]) {
+      group_starts.push_back(i);
+    }
+  }
+  const size_t num_groups = group_starts.size();
+  group_starts.push_back(num_slices);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_groups, static_cast<double>(slice_size) * num_slices / num_groups,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t group = first; group < last; ++group) {
+          for (size_t i = group_starts[group], end = group_starts[group + 1]; i < end; ++i) {
+            reduce_slice(order[i]);
+          }
+        }
+      });
+}
+
 template <typename TData>
 struct ScatterNDDispatchTarget {
   Status operator()(OpKernelContext* context, concurrency::ThreadPool* tp, ScatterND::Reduction reduction) const {
     Prepare<TData> prepare;
-    ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
-
-    auto lambda = [&](int64_t i) {
-      switch (reduction) {
-        case ScatterND::Reduction::Add: {
-          auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Mul: {
-          auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Min: {
-          auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Max: {
-          auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        default:
-        case ScatterND::Reduction::None: {
-          auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-      }
-    };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+    ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare, tp));
+
+    switch (reduction) {
+      case ScatterND::Reduction::Add:
+        ScatterNDReduceSlices(Func_Add_ND<TData>(), prepare, tp);
+        break;
+      case ScatterND::Reduction::Mul:
+        ScatterNDReduceSlices(Func_Mul_ND<TData>(), prepare, tp);
+        break;
+      case ScatterND::Reduction::Min:
+        ScatterNDReduceSlices(Func_Min_ND<TData>(), prepare, tp);
+        break;
+      case ScatterND::Reduction::Max:
+        ScatterNDReduceSlices(Func_Max_ND<TData>(), prepare, tp);
+        break;
+      default:
+      case ScatterND::Reduction::None:
+        ScatterNDCopySlices(prepare, tp);
+        break;
+    }
     return Status::OK();
   }
 };
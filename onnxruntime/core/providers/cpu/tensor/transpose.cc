@@ -4,6 +4,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 
 #include <memory>
+#ifdef ENABLE_STRIDED_TENSORS
+#include "core/framework/copy.h"
+#endif
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/transpose_helper.h"
@@ -154,22 +157,6 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeImpl(int64_t num_axes, gsl::span<const int64_t> target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const gsl::span<const size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  MultiIndex mindex;
-  IncrementIndexAndComputeOffsetSetup(mindex, onnxruntime::narrow<size_t>(num_axes), target_dims, stride, element_size);
-
-  const uint8_t* local_source = source;
-  for (size_t i = 0; i < num_blocks; ++i) {
-    ORT_ENFORCE((local_source >= source) && (local_source < source + num_blocks * blocksize));
-    memcpy(target, local_source, blocksize);
-    IncrementIndexAndComputeOffset(mindex, local_source);
-    target += blocksize;
-  }
-}
-
 static void DoTransposeImpl(int64_t num_axes, gsl::span<const int64_t> target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const gsl::span<const size_t>& stride,
                             const std::string* source, std::string* target) {
@@ -261,7 +248,8 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
 
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -321,13 +309,9 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
     auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
-    } else if (1 == suffix_blocksize) {
-      // this may return a failed status if the data size is not supported in this build
-      status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                                  input_data, output_data, element_size);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+      // tiles the innermost axes moved by the permutation and partitions the tiles among the threads
+      BlockedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 
@@ -368,7 +352,7 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
   }
 
   // fall back to default implementation
-  return DoUntypedTranspose(permutations, input, output, input_shape_override);
+  return DoUntypedTranspose(permutations, input, output, input_shape_override, tp);
 }
 
 template <typename Int4Type>
@@ -450,21 +434,53 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+#ifdef ENABLE_STRIDED_TENSORS
+  if (rank > 0 && (Y.DataRaw() == X.DataRaw() || !X.IsContiguous())) {
+    // the output is the input with its strides permuted
+    const auto input_strides = X.Strides();
+    TensorShapeVector output_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      output_strides[i] = input_strides[(*p_perm)[i]];
+    }
+
+    // Strided output, the planner let the output share the buffer of the input.
+    if (Y.DataRaw() == X.DataRaw()) {
+      Y.SetShapeAndStrides(output_shape, output_strides);
+      return Status::OK();
+    }
+
+    // Strided input, gather it into the contiguous output.
+    const auto contiguous_strides = Y.Strides();
+    return DispatchStridedCopy<EnabledDataTypesAllOpsets>(ctx->GetOperatorThreadPool(), Y, 0,
+                                                          TensorShapeVector(contiguous_strides.begin(),
+                                                                            contiguous_strides.end()),
+                                                          output_shape, X, 0, output_strides);
+  }
+#endif
+
   return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
+// A transposed tensor can be a view of the input with permuted strides. Opset 21 adds the 4 bit types, which cannot be
+// strided, so its kernel always writes a contiguous output.
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     1,
     12,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
     Transpose);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     13,
     20,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
     Transpose);
 
 // Opset 21 added support for float8e4m3fnuz, float8e5m2, float8e5m2fnuz, int4 and uint4.
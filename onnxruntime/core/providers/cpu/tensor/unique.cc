@@ -2,10 +2,17 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <map>
 #include <core/common/safeint.h>
 #include <gsl/gsl>
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -144,62 +151,192 @@ class Subtensor {
   std::vector<T> items_;
 };
 
-template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-  Tensor& Y = *context.Output(0, {num_unique});
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
+namespace {
+// The first occurrence of a unique value in the flattened input, the number of its occurrences and its index in Y.
+struct UniqueEntry {
+  int64_t first;
+  int64_t count;
+  int64_t output_idx;
+};
 
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
+// The key of a value in the hash tables. Floating point values are keyed by their bits, with the zeros and the NaNs
+// made canonical so that +0 and -0 are the same value, and so are all the NaNs.
+template <typename T>
+const T& ToUniqueKey(const T& value) {
+  return value;
+}
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+template <typename T, typename Bits>
+Bits FloatToUniqueKey(T value) {
+  if (value == T{0}) {
+    value = T{0};
+  } else if (std::isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  }
+  Bits bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
 
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
+inline uint32_t ToUniqueKey(float value) { return FloatToUniqueKey<float, uint32_t>(value); }
+inline uint64_t ToUniqueKey(double value) { return FloatToUniqueKey<double, uint64_t>(value); }
 
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+// Order for the sorted output, with NaN after all the other values.
+template <typename T>
+bool UniqueValueLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point<T>::value) {
+    if (std::isnan(lhs)) {
+      return false;
     }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+    if (std::isnan(rhs)) {
+      return true;
     }
   }
+  return lhs < rhs;
+}
 
-  if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
+// Sorts a block per thread and then merges the pairs of adjacent sorted blocks in parallel.
+template <typename Iter, typename Compare>
+void ParallelSort(concurrency::ThreadPool* tp, Iter begin, Iter end, Compare comp) {
+  constexpr std::ptrdiff_t kMinBlockSize = 16 * 1024;
+  const std::ptrdiff_t n = end - begin;
+  const std::ptrdiff_t num_blocks =
+      std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), n / kMinBlockSize);
+  if (num_blocks <= 1) {
+    std::sort(begin, end, comp);
+    return;
+  }
 
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
+  const auto block_begin = [begin, n, num_blocks](std::ptrdiff_t block) { return begin + n * block / num_blocks; };
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    std::sort(block_begin(block), block_begin(block + 1), comp);
+  });
+
+  for (std::ptrdiff_t width = 1; width < num_blocks; width *= 2) {
+    const std::ptrdiff_t num_merges = (num_blocks + 2 * width - 1) / (2 * width);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_merges, [&](std::ptrdiff_t merge) {
+      const std::ptrdiff_t first = merge * 2 * width;
+      const std::ptrdiff_t middle = std::min(first + width, num_blocks);
+      const std::ptrdiff_t last = std::min(first + 2 * width, num_blocks);
+      if (middle < last) {
+        std::inplace_merge(block_begin(first), block_begin(middle), block_begin(last), comp);
       }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
+    });
+  }
+}
+}  // namespace
+
+// Unique of the flattened input. Each thread counts the values of a block of the input in its own hash tables, one
+// per partition of the values by their hash, then the tables of each partition are merged in parallel. The unique
+// values are put in the order of their first occurrence, or sorted, and the inverse indices are looked up in parallel.
+template <typename T>
+static void ComputeFlattenedOutput(OpKernelContext& context, gsl::span<const T> input, bool sorted) {
+  using Key = std::decay_t<decltype(ToUniqueKey(std::declval<const T&>()))>;
+  using Table = InlinedHashMap<Key, UniqueEntry>;
+
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+  constexpr std::ptrdiff_t kMinBlockSize = 16 * 1024;
+  const T* data = input.data();
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(input.size());
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), n / kMinBlockSize));
+  const size_t num_partitions = static_cast<size_t>(num_blocks);
+
+  const auto partition_of = [num_partitions](const Key& key) -> size_t {
+    if (num_partitions == 1) {
+      return 0;
+    }
+    // mix the hash as std::hash of integers is the identity
+    const uint64_t hash = static_cast<uint64_t>(std::hash<Key>{}(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>((hash >> 32) % num_partitions);
+  };
+
+  std::vector<std::vector<Table>> block_tables(num_partitions, std::vector<Table>(num_partitions));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    auto& tables = block_tables[onnxruntime::narrow<size_t>(block)];
+    for (std::ptrdiff_t i = n * block / num_blocks, end = n * (block + 1) / num_blocks; i < end; ++i) {
+      const auto& key = ToUniqueKey(data[i]);
+      auto result = tables[partition_of(key)].try_emplace(key, UniqueEntry{i, 0, 0});
+      ++result.first->second.count;
+    }
+  });
+
+  // the blocks are merged in order so the first occurrence comes from the first block containing the value
+  std::vector<Table> tables(num_partitions);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t partition) {
+    auto& table = tables[onnxruntime::narrow<size_t>(partition)];
+    table = std::move(block_tables[0][onnxruntime::narrow<size_t>(partition)]);
+    for (size_t block = 1; block < num_partitions; ++block) {
+      for (const auto& entry : block_tables[block][onnxruntime::narrow<size_t>(partition)]) {
+        auto result = table.try_emplace(entry.first, entry.second);
+        if (!result.second) {
+          result.first->second.count += entry.second.count;
+        }
       }
+      block_tables[block][onnxruntime::narrow<size_t>(partition)] = Table();
     }
+  });
+
+  // the tables are not modified from here on, so the pointers to their entries stay valid
+  std::vector<UniqueEntry*> entries;
+  size_t num_unique = 0;
+  for (const auto& table : tables) {
+    num_unique += table.size();
+  }
+  entries.reserve(num_unique);
+  for (auto& table : tables) {
+    for (auto& entry : table) {
+      entries.push_back(&entry.second);
+    }
+  }
+
+  if (sorted) {
+    ParallelSort(tp, entries.begin(), entries.end(), [data](const UniqueEntry* lhs, const UniqueEntry* rhs) {
+      return UniqueValueLess(data[lhs->first], data[rhs->first]);
+    });
+  } else {
+    ParallelSort(tp, entries.begin(), entries.end(),
+                 [](const UniqueEntry* lhs, const UniqueEntry* rhs) { return lhs->first < rhs->first; });
+  }
+
+  const int64_t num_unique_values = static_cast<int64_t>(num_unique);
+  Tensor& Y = *context.Output(0, {num_unique_values});
+  Tensor* indices_out = context.Output(1, {num_unique_values});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(n)});
+  Tensor* counts = context.Output(3, {num_unique_values});
+
+  T* Y_data = Y.MutableData<T>();
+  int64_t* indices_data = indices_out != nullptr ? indices_out->MutableData<int64_t>() : nullptr;
+  int64_t* counts_data = counts != nullptr ? counts->MutableData<int64_t>() : nullptr;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_unique), TensorOpCost{static_cast<double>(sizeof(T)),
+                                                                static_cast<double>(sizeof(T) + 2 * sizeof(int64_t)),
+                                                                4.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          UniqueEntry& entry = *entries[i];
+          entry.output_idx = i;
+          Y_data[i] = data[entry.first];
+          if (indices_data) {
+            indices_data[i] = entry.first;
+          }
+          if (counts_data) {
+            counts_data[i] = entry.count;
+          }
+        }
+      });
+
+  if (inverse_indices) {
+    int64_t* inverse_indices_data = inverse_indices->MutableData<int64_t>();
+    concurrency::ThreadPool::TryParallelFor(
+        tp, n, TensorOpCost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(int64_t)), 32.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const auto& key = ToUniqueKey(data[i]);
+            inverse_indices_data[i] = tables[partition_of(key)].find(key)->second.output_idx;
+          }
+        });
   }
 }
 
@@ -308,30 +445,7 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    ComputeFlattenedOutput<T>(context, data, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
@@ -7,6 +7,7 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample_antialias.h"
 
@@ -1110,6 +1111,133 @@ void ResizeBiCubic(int64_t batch_size,
 #pragma warning(pop)
 #endif
 
+// Input indices and weights of the taps of each output index of an axis, in the layout of MlasResizeSeparable.
+struct ResizeAxisTable {
+  size_t taps;
+  std::vector<int32_t> indices;
+  std::vector<float> weights;
+};
+
+// Bilinear resize of float images without extrapolation, split by MLAS in a horizontal and a vertical pass.
+static void ResizeBilinearSeparable(int32_t batch_size,
+                                    int32_t num_channels,
+                                    int32_t input_height,
+                                    int32_t input_width,
+                                    int32_t output_height,
+                                    int32_t output_width,
+                                    float height_scale,
+                                    float width_scale,
+                                    gsl::span<const float> roi,
+                                    bool is_nchw,
+                                    const float* Xdata,
+                                    float* Ydata,
+                                    AllocatorPtr& alloc,
+                                    const GetOriginalCoordinateFunc& get_original_coordinate,
+                                    concurrency::ThreadPool* tp) {
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi,
+                                           alloc, get_original_coordinate, is_nchw);
+
+  ResizeAxisTable rows{2, std::vector<int32_t>(SafeInt<size_t>(output_height) * 2),
+                       std::vector<float>(SafeInt<size_t>(output_height) * 2)};
+  for (size_t y = 0; y < static_cast<size_t>(output_height); ++y) {
+    rows.indices[2 * y] = p.input_width_mul_y1[y] / input_width;
+    rows.indices[2 * y + 1] = p.input_width_mul_y2[y] / input_width;
+    rows.weights[2 * y] = p.dy2[y];
+    rows.weights[2 * y + 1] = p.dy1[y];
+  }
+
+  ResizeAxisTable columns{2, std::vector<int32_t>(SafeInt<size_t>(output_width) * 2),
+                          std::vector<float>(SafeInt<size_t>(output_width) * 2)};
+  for (size_t x = 0; x < static_cast<size_t>(output_width); ++x) {
+    columns.indices[2 * x] = p.in_x1[x];
+    columns.indices[2 * x + 1] = p.in_x2[x];
+    columns.weights[2 * x] = p.dx2[x];
+    columns.weights[2 * x + 1] = p.dx1[x];
+  }
+
+  const size_t image_count = static_cast<size_t>(batch_size) * (is_nchw ? static_cast<size_t>(num_channels) : 1);
+  MlasResizeSeparable(Xdata, image_count, static_cast<size_t>(input_height), static_cast<size_t>(input_width),
+                      is_nchw ? 1 : static_cast<size_t>(num_channels), Ydata,
+                      static_cast<size_t>(output_height), static_cast<size_t>(output_width),
+                      rows.taps, rows.indices.data(), rows.weights.data(),
+                      columns.taps, columns.indices.data(), columns.weights.data(), tp);
+}
+
+// The 4 taps of the cubic convolution of each output index of an axis, with the same coordinates and
+// coefficients as ResizeBiCubic.
+static ResizeAxisTable SetupCubicAxisTable(int64_t input_size,
+                                           int64_t output_size,
+                                           float scale,
+                                           float roi_start,
+                                           float roi_end,
+                                           float cubic_coeff_a,
+                                           bool exclude_outside,
+                                           const GetOriginalCoordinateFunc& get_original_coordinate) {
+  ResizeAxisTable table{CubicModeGridLength, std::vector<int32_t>(SafeInt<size_t>(output_size) * CubicModeGridLength),
+                        std::vector<float>(SafeInt<size_t>(output_size) * CubicModeGridLength)};
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    const float in = scale == 1 ? static_cast<float>(o)
+                                : get_original_coordinate(static_cast<float>(o), scale,
+                                                          static_cast<float>(output_size),
+                                                          static_cast<float>(input_size),
+                                                          roi_start, roi_end);
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    const auto coeffs = GetCubicCoeffs(in - static_cast<float>(in_int), cubic_coeff_a);
+
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      // the weights of the sampling locations outside the input are 0 and the others are renormalized
+      coeff_sum = 0;
+      for (int64_t i = 0; i < static_cast<int64_t>(CubicModeGridLength); ++i) {
+        const int64_t index = in_int - 1 + i;
+        coeff_sum += (index < 0 || index >= input_size) ? 0.0f : coeffs[narrow<size_t>(i)];
+      }
+    }
+
+    for (int64_t i = 0; i < static_cast<int64_t>(CubicModeGridLength); ++i) {
+      const int64_t index = in_int - 1 + i;
+      const bool outside = index < 0 || index >= input_size;
+      const size_t tap = narrow<size_t>(o) * CubicModeGridLength + narrow<size_t>(i);
+      table.indices[tap] = static_cast<int32_t>(std::clamp(index, static_cast<int64_t>(0), input_size - 1));
+      table.weights[tap] = (exclude_outside && outside) ? 0.0f : coeffs[narrow<size_t>(i)] / coeff_sum;
+    }
+  }
+
+  return table;
+}
+
+// Bicubic resize of NCHW float images without extrapolation, split by MLAS in a horizontal and a vertical pass.
+static void ResizeBiCubicSeparable(int64_t batch_size,
+                                   int64_t num_channels,
+                                   int64_t input_height,
+                                   int64_t input_width,
+                                   int64_t output_height,
+                                   int64_t output_width,
+                                   float height_scale,
+                                   float width_scale,
+                                   float cubic_coeff_a,
+                                   bool exclude_outside,
+                                   gsl::span<const float> roi,
+                                   const float* Xdata,
+                                   float* Ydata,
+                                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                                   concurrency::ThreadPool* tp) {
+  const auto rows = SetupCubicAxisTable(input_height, output_height, height_scale,
+                                        roi[roi.size() / 2 - 2], roi[roi.size() - 2],
+                                        cubic_coeff_a, exclude_outside, get_original_coordinate);
+  const auto columns = SetupCubicAxisTable(input_width, output_width, width_scale,
+                                           roi[roi.size() / 2 - 1], roi[roi.size() - 1],
+                                           cubic_coeff_a, exclude_outside, get_original_coordinate);
+
+  MlasResizeSeparable(Xdata, narrow<size_t>(batch_size * num_channels),
+                      narrow<size_t>(input_height), narrow<size_t>(input_width), 1, Ydata,
+                      narrow<size_t>(output_height), narrow<size_t>(output_width),
+                      rows.taps, rows.indices.data(), rows.weights.data(),
+                      columns.taps, columns.indices.data(), columns.weights.data(), tp);
+}
+
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                 gsl::span<const float> roi,
@@ -1211,6 +1339,16 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
           }
         }
 
+        if constexpr (std::is_same_v<T, float>) {
+          if (!antialias_ && !use_extrapolation_) {
+            ResizeBilinearSeparable(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                                    height_scale, width_scale, roi, is_nchw, X->Data<float>(),
+                                    Y->MutableData<float>(), alloc, get_original_coordinate_,
+                                    context->GetOperatorThreadPool());
+            return Status::OK();
+          }
+        }
+
         if (is_nchw) {
           if (antialias_) {
             UpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
@@ -1348,6 +1486,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                  Y->MutableData<T>(), alloc, get_original_coordinate_,
                                  output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
+      } else if (is_nchw && !use_extrapolation_) {
+        ResizeBiCubicSeparable(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                               height_scale, width_scale, cubic_coeff_a_, exclude_outside_, roi, X->Data<float>(),
+                               Y->MutableData<float>(), get_original_coordinate_, context->GetOperatorThreadPool());
       } else {
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
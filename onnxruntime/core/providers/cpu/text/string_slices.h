@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include <gsl/gsl>
+
+namespace onnxruntime {
+
+/// Substrings of the strings of an input tensor, grouped by row.
+/// All the views are kept in one buffer together with the offsets where every row starts, so that collecting the
+/// tokens of many strings costs a couple of allocations instead of a container per string. The views point into the
+/// input strings, which must outlive this object. The slices are only copied into std::string when the output tensor
+/// is written.
+class StringSlices {
+ public:
+  StringSlices() = default;
+
+  void Reserve(size_t num_rows, size_t num_slices) {
+    offsets_.reserve(num_rows + 1);
+    slices_.reserve(num_slices);
+  }
+
+  /// Appends a slice to the current row.
+  void Add(std::string_view slice) { slices_.push_back(slice); }
+
+  /// Closes the current row, the following slices go into a new row.
+  void EndRow() {
+    max_row_size_ = std::max(max_row_size_, slices_.size() - offsets_.back());
+    offsets_.push_back(slices_.size());
+  }
+
+  size_t NumRows() const { return offsets_.size() - 1; }
+
+  size_t MaxRowSize() const { return max_row_size_; }
+
+  gsl::span<const std::string_view> Row(size_t row) const {
+    return gsl::make_span(slices_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+  }
+
+ private:
+  std::vector<std::string_view> slices_;
+  std::vector<size_t> offsets_{0};
+  size_t max_row_size_{0};
+};
+
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <limits>
 #include <string>
 #include "core/common/common.h"
+#include "core/providers/cpu/text/string_slices.h"
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
@@ -16,9 +17,9 @@ ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
                          StringSplit);
 
 /// Calculate substrings in ``str`` delimited by ``delimiter``. A maximum of ``max_splits`` splits are permitted.
-/// Returns a vector of string slices into ``str`` representing the substrings as string views. The user must ensure
-/// the returned views' lifetime does not exceed ``str``'s.
-void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, InlinedVector<std::string_view>& out) {
+/// Appends the substrings to the current row of ``out`` as string views into ``str``. The user must ensure
+/// the views' lifetime does not exceed ``str``'s.
+void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, StringSlices& out) {
   if (str.empty()) {
     return;
   }
@@ -33,11 +34,11 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
         while (str[next_pos] == ' ') {
           next_pos--;
         }
-        out.push_back(str.substr(pos, next_pos - pos + 1));
+        out.Add(str.substr(pos, next_pos - pos + 1));
         break;
       } else {
         auto next_pos = str.find_first_of(" ", pos);
-        out.push_back(str.substr(pos, next_pos - pos));
+        out.Add(str.substr(pos, next_pos - pos));
         pos = str.find_first_not_of(" ", next_pos);
       }
     }
@@ -47,10 +48,10 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
     while (pos != std::string::npos) {
       auto next_pos = str.find(delimiter, pos);
       if (token_count++ == max_splits || next_pos == std::string::npos) {
-        out.push_back(str.substr(pos));
+        out.Add(str.substr(pos));
         break;
       }
-      out.push_back(str.substr(pos, next_pos - pos));
+      out.Add(str.substr(pos, next_pos - pos));
       pos = next_pos + delimiter.size();
     }
   }
@@ -69,27 +70,29 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
-  size_t last_dim = 0;
+  // The substrings of all the inputs share one buffer of views
+  StringSlices input_slices;
+  input_slices.Reserve(input_data.size(), input_data.size());
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
-    ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
-    last_dim = std::max(last_dim, substr_count);
-    *num_tokens_iter = static_cast<int64_t>(substr_count);
+    ComputeSubstrings(s, delimiter_, maxsplit_, input_slices);
+    input_slices.EndRow();
+    *num_tokens_iter = static_cast<int64_t>(input_slices.Row(input_slices.NumRows() - 1).size());
     ++num_tokens_iter;
   }
+  const size_t last_dim = input_slices.MaxRowSize();
 
   // Set up splits output
   auto splits_shape = input->Shape().AsShapeVector();
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  size_t row = 0;
+  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++row) {
+    const auto substrs = input_slices.Row(row);
+    for (size_t i = 0; i < substrs.size(); ++i) {
+      output_splits_iter[i].assign(substrs[i].data(), substrs[i].size());
+    }
   }
 
   return Status::OK();
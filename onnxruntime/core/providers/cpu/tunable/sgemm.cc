@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/sgemm.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+namespace {
+
+ptrdiff_t MaxThreadCount(const SgemmParams* params) {
+  return static_cast<ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool));
+}
+
+Status SgemmDefault(const SgemmParams* params) {
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                params->data, params->batch, params->thread_pool);
+  return Status::OK();
+}
+
+// Splits the work over max_threads / divisor threads along the given dimension.
+class SgemmThreading {
+ public:
+  SgemmThreading(ptrdiff_t divisor, MLAS_SGEMM_PARTITION partition) : divisor_(divisor), partition_(partition) {}
+
+  Status operator()(const SgemmParams* params) const {
+    const ptrdiff_t max_threads = MaxThreadCount(params);
+    const ptrdiff_t thread_count = std::max<ptrdiff_t>(max_threads / divisor_, 1);
+    // skip the candidates that repeat the thread count of a smaller divisor
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+        divisor_ > 1 && thread_count == std::max<ptrdiff_t>(max_threads / (divisor_ / 2), 1),
+        "thread count ", thread_count, " is already a candidate");
+
+    MLAS_SGEMM_THREADING_PARAMS threading;
+    threading.ThreadCount = thread_count;
+    threading.Partition = partition_;
+    MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                  params->data, params->batch, params->thread_pool, &threading);
+    return Status::OK();
+  }
+
+ private:
+  ptrdiff_t divisor_;
+  MLAS_SGEMM_PARTITION partition_;
+};
+
+class SgemmTunableOp : public TunableOp<SgemmParams> {
+ public:
+  SgemmTunableOp() {
+    this->RegisterOp(SgemmDefault);
+    for (MLAS_SGEMM_PARTITION partition : {MlasSgemmPartitionM, MlasSgemmPartitionN}) {
+      for (ptrdiff_t divisor : {1, 2, 4, 8, 16}) {
+        this->RegisterOp(SgemmThreading{divisor, partition});
+      }
+    }
+    this->SetDefaultId(0);
+  }
+};
+
+}  // namespace
+
+std::string SgemmParams::Signature() const {
+  auto op = [](CBLAS_TRANSPOSE trans) { return trans == CblasTrans ? "T" : "N"; };
+  return MakeString(op(trans_a), op(trans_b), "_", m, "_", n, "_", k, "_B", batch,
+                    "_threads", MaxThreadCount(this));
+}
+
+Status SgemmBatch(const SgemmParams* params) {
+  static SgemmTunableOp op;
+  return op(params);
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
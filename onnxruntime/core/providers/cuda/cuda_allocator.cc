@@ -2,11 +2,70 @@
 // Licensed under the MIT License.
 
 #include "cuda_allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include "core/framework/stream_handles.h"
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
 
 namespace onnxruntime {
 
+// The memory pool of a device, destroyed with the last allocator using it.
+class CudaMemPool {
+ public:
+  explicit CudaMemPool(OrtDevice::DeviceId device_id) {
+    cudaMemPoolProps props{};
+    props.allocType = cudaMemAllocationTypePinned;
+    props.handleTypes = cudaMemHandleTypeNone;
+    props.location.type = cudaMemLocationTypeDevice;
+    props.location.id = device_id;
+    CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+  }
+
+  ~CudaMemPool() {
+    // The pool is released once the memory still allocated from it is freed.
+    ORT_IGNORE_RETURN_VALUE(cudaMemPoolDestroy(pool_));
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaMemPool);
+
+  cudaMemPool_t Get() const { return pool_; }
+
+  // The allocators sharing the pool may ask for different thresholds, the pool keeps the largest one.
+  void RaiseReleaseThreshold(size_t release_threshold) {
+    uint64_t threshold = 0;
+    CUDA_CALL_THROW(cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+    if (static_cast<uint64_t>(release_threshold) > threshold) {
+      threshold = static_cast<uint64_t>(release_threshold);
+      CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+    }
+  }
+
+ private:
+  cudaMemPool_t pool_ = nullptr;
+};
+
+namespace {
+
+std::shared_ptr<CudaMemPool> GetCudaMemPool(OrtDevice::DeviceId device_id, size_t release_threshold) {
+  static std::mutex mutex;
+  static std::unordered_map<OrtDevice::DeviceId, std::weak_ptr<CudaMemPool>> pools;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<CudaMemPool> pool = pools[device_id].lock();
+  if (!pool) {
+    pool = std::make_shared<CudaMemPool>(device_id);
+    pools[device_id] = pool;
+  }
+  pool->RaiseReleaseThreshold(release_threshold);
+  return pool;
+}
+
+}  // namespace
+
 void CUDAAllocator::CheckDevice(bool throw_when_fail) const {
 #ifndef NDEBUG
   // check device to match at debug build
@@ -55,6 +114,113 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t gpu_mem_limit,
+                                           size_t release_threshold)
+    : CUDAAllocator(device_id, name), gpu_mem_limit_(gpu_mem_limit) {
+  SetDevice(true);
+  pool_ = GetCudaMemPool(device_id, release_threshold);
+  stats_.bytes_limit = static_cast<int64_t>(std::min<size_t>(gpu_mem_limit, std::numeric_limits<int64_t>::max()));
+}
+
+void* CUDAMemPoolAllocator::AllocOnCudaStream(size_t size, cudaStream_t stream) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  SetDevice(true);
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    const size_t bytes_in_use = static_cast<size_t>(stats_.bytes_in_use);
+    ORT_ENFORCE(size <= gpu_mem_limit_ - bytes_in_use, "Failed to allocate ", size,
+                " bytes from the CUDA memory pool, ", bytes_in_use, " bytes are in use out of the limit of ",
+                gpu_mem_limit_);
+    stats_.bytes_in_use += size;
+  }
+
+  void* p = nullptr;
+  const cudaError_t cuda_err = cudaMallocFromPoolAsync(&p, size, pool_->Get(), stream);
+
+  std::lock_guard<std::mutex> lock(lock_);
+  if (cuda_err != cudaSuccess) {
+    stats_.bytes_in_use -= size;
+    CUDA_CALL_THROW(cuda_err);
+  }
+  allocations_.emplace(p, Allocation{size, stream});
+  stats_.num_allocs++;
+  stats_.total_allocated_bytes += size;
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  return p;
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  // Without a stream, the memory is allocated on the legacy default stream and waited for, so that the work of any
+  // stream can use it.
+  void* p = AllocOnCudaStream(size, nullptr);
+  if (p != nullptr) {
+    CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+  }
+  return p;
+}
+
+void* CUDAMemPoolAllocator::AllocOnStream(size_t size, Stream* stream) {
+  cudaStream_t cuda_stream = stream != nullptr ? static_cast<cudaStream_t>(stream->GetHandle()) : nullptr;
+  return cuda_stream != nullptr ? AllocOnCudaStream(size, cuda_stream) : Alloc(size);
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  Allocation allocation;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = allocations_.find(p);
+    ORT_ENFORCE(it != allocations_.end(), "Freeing memory that was not allocated from the CUDA memory pool");
+    allocation = it->second;
+    allocations_.erase(it);
+    stats_.bytes_in_use -= allocation.size;
+  }
+
+  // The memory goes back to the pool once the work queued on its stream so far is done.
+  SetDevice(false);
+  cudaFreeAsync(p, allocation.stream);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+}
+
+void CUDAMemPoolAllocator::ReleaseStreamAllocations(Stream* stream) {
+  cudaStream_t cuda_stream = stream != nullptr ? static_cast<cudaStream_t>(stream->GetHandle()) : nullptr;
+  if (cuda_stream == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  bool has_allocations = false;
+  for (const auto& it : allocations_) {
+    if (it.second.stream == cuda_stream) {
+      has_allocations = true;
+      break;
+    }
+  }
+  if (!has_allocations) {
+    return;
+  }
+
+  // The allocations still in use, e.g. the outputs of a run, may outlive the stream. Once its work is done they can
+  // be used and freed on the legacy default stream instead.
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  for (auto& it : allocations_) {
+    if (it.second.stream == cuda_stream) {
+      it.second.stream = nullptr;
+    }
+  }
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<std::mutex> lock(lock_);
+  *stats = stats_;
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
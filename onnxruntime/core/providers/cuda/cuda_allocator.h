@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
-#include <mutex>
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -19,11 +22,47 @@ class CUDAAllocator : public IAllocator {
   void* Alloc(size_t size) override;
   void Free(void* p) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
 
+class CudaMemPool;
+
+// An allocator backed by a CUDA memory pool (cudaMallocFromPoolAsync) which orders the allocations on the streams of
+// the kernels instead of sub-allocating an arena. The pool of a device is shared by the allocators of all the sessions
+// on the device, so the driver reuses the memory freed by one for the others, and the idle memory of the pool above
+// the release threshold goes back to the system when a stream or the device is synchronized.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t gpu_mem_limit,
+                       size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  bool IsStreamAware() const override { return true; }
+  void* AllocOnStream(size_t size, Stream* stream) override;
+  void ReleaseStreamAllocations(Stream* stream) override;
+
+ private:
+  struct Allocation {
+    size_t size;
+    // The stream the memory is freed on, nullptr for the legacy default stream.
+    cudaStream_t stream;
+  };
+
+  void* AllocOnCudaStream(size_t size, cudaStream_t stream);
+
+  std::shared_ptr<CudaMemPool> pool_;
+  const size_t gpu_mem_limit_;
+
+  std::mutex lock_;
+  InlinedHashMap<void*, Allocation> allocations_;
+  AllocatorStats stats_;
+};
+
 class CUDAExternalAllocator : public CUDAAllocator {
   typedef void* (*ExternalAlloc)(size_t size);
   typedef void (*ExternalFree)(void* p);
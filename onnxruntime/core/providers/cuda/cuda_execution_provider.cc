@@ -172,7 +172,8 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
 
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t /*gpu_mem_limit*/,
                                                           ArenaExtendStrategy /*arena_extend_strategy*/, CUDAExecutionProviderExternalAllocatorInfo /*external_allocator_info*/,
-                                                          OrtArenaCfg* /*default_memory_arena_cfg*/) {
+                                                          OrtArenaCfg* /*default_memory_arena_cfg*/,
+                                                          int max_num_cuda_graphs) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
 #ifndef USE_CUDA_MINIMAL
   CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
@@ -184,6 +185,7 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   LOGS_DEFAULT(INFO) << "cuDNN version: " << cudnnGetVersion();
 #endif
   cuda_graph_.SetStream(stream);
+  cuda_graph_.SetMaxNumGraphs(static_cast<size_t>(std::max(max_num_cuda_graphs, 0)));
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -230,7 +232,9 @@ void CUDAExecutionProvider::PerThreadContext::CaptureBegin(CudaGraphAnnotation_t
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id) {
-  cuda_graph_.CaptureEnd(cuda_graph_annotation_id);
+  if (auto evicted_annotation_id = cuda_graph_.CaptureEnd(cuda_graph_annotation_id)) {
+    graph_id_to_run_count_.erase(*evicted_annotation_id);
+  }
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured(CudaGraphAnnotation_t graph_annotation_id) const {
@@ -303,6 +307,9 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
       use_ep_level_unified_stream_ = true;
     } else {
       stream_ = nullptr;
+      if (info.compute_stream_pool_size > 0) {
+        stream_pool_ = std::make_unique<CudaStreamPool>(static_cast<size_t>(info.compute_stream_pool_size));
+      }
     }
   }
 
@@ -374,7 +381,8 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
       context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                                   info_.max_num_cuda_graphs);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -2822,7 +2830,8 @@ void CUDAExecutionProvider::RegisterStreamHandlers(IStreamCommandHandleRegistry&
                             use_ep_level_unified_stream_,
                             GetPerThreadContext().CudnnHandle(),
                             GetPerThreadContext().CublasHandle(),
-                            info_);
+                            info_,
+                            stream_pool_.get());
 }
 
 OrtDevice CUDAExecutionProvider::GetOrtDeviceByMemType(OrtMemType mem_type) const {
@@ -2844,9 +2853,21 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
       // correct to use the GPU device id, unless we wanted to share the pinned memory allocator across devices,
       // at the risk the lifetime isn't managed correctly if one of those devices go away.
       0);
+  // Graph capture relies on the memory allocated by the regular runs staying in the arena, so a memory pool is only
+  // used without it.
+  AllocatorPtr cuda_allocator;
+  if (info_.use_cuda_mem_pool && !info_.external_allocator_info.UseExternalAllocator() && !info_.enable_cuda_graph) {
+    cuda_allocator = std::make_shared<CUDAMemPoolAllocator>(info_.device_id, CUDA, info_.gpu_mem_limit,
+                                                            info_.cuda_mem_pool_release_threshold);
+  } else {
+    if (info_.use_cuda_mem_pool) {
+      LOGS_DEFAULT(WARNING) << "use_cuda_mem_pool is ignored with an external allocator or enable_cuda_graph.";
+    }
+    cuda_allocator = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                         info_.external_allocator_info, info_.default_memory_arena_cfg);
+  }
   return std::vector<AllocatorPtr>{
-      CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                          info_.external_allocator_info, info_.default_memory_arena_cfg),
+      cuda_allocator,
       CreateAllocator(pinned_memory_info),
   };
 }
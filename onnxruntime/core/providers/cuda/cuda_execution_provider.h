@@ -25,6 +25,8 @@ namespace onnxruntime {
 
 void RunOnUnload(std::function<void()> function);
 
+class CudaStreamPool;
+
 // Logical device representation.
 class CUDAExecutionProvider : public IExecutionProvider {
  public:
@@ -76,6 +78,9 @@ class CUDAExecutionProvider : public IExecutionProvider {
       const GraphOptimizerRegistry& /* graph_optimizer_registry */,
       IResourceAccountant* resource_accountant) const override;
 
+  // GetCapability only depends on the graph and the provider options.
+  bool CanCacheCapabilities() const override { return true; }
+
   int GetDeviceId() const override { return info_.device_id; }
   const cudaDeviceProp& GetDeviceProp() const { return device_prop_; };
   int GetCudnnConvAlgo() const { return info_.cudnn_conv_algo_search; }
@@ -122,6 +127,9 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   bool use_ep_level_unified_stream_ = false;
 
+  // the compute streams shared by the runs when compute_stream_pool_size is set
+  std::unique_ptr<CudaStreamPool> stream_pool_;
+
   // the tuning context might be altered when calling into a TunableOp
   mutable cuda::tunable::CudaTuningContext tuning_context_;
 
@@ -133,7 +141,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                     int max_num_cuda_graphs);
     ~PerThreadContext();
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerThreadContext);
 
@@ -214,7 +223,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
     // Cuda graph with multi threads will be supported in the future, so cuda_graph_
     // is put under PerThreadContext.
     CUDAGraph cuda_graph_;
-    // Map of graph id to regular_run_count_before_graph_capture
+    // Map of graph id to regular_run_count_before_graph_capture.
+    // The count of an evicted graph is removed so that the graph is captured again after the regular runs.
     std::unordered_map<CudaGraphAnnotation_t, int> graph_id_to_run_count_;
 
     // There is chance that the second regular run allocates GPU memory for causes like:
@@ -60,11 +60,20 @@ struct CUDAExecutionProviderInfo {
   OrtArenaCfg* default_memory_arena_cfg{nullptr};
   CUDAExecutionProviderExternalAllocatorInfo external_allocator_info{};
 
+  // Allocate the device memory from a CUDA memory pool shared by the sessions on the device, with stream-ordered
+  // allocations and frees, instead of an arena. The arena config does not apply then. The pool keeps up to
+  // cuda_mem_pool_release_threshold bytes of idle memory when a stream or the device is synchronized.
+  bool use_cuda_mem_pool{false};
+  size_t cuda_mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
+
   // By default, try to use as much as possible memory for algo search.
   // If set to false, use fix workspace size (32M) for Conv algo search, the final algo might not be the best.
   bool cudnn_conv_use_max_workspace{true};
 
   bool enable_cuda_graph{false};
+  // The maximum number of captured CUDA graphs kept per thread, 0 for no limit. Capturing one more graph evicts the
+  // least recently replayed one.
+  int max_num_cuda_graphs{0};
 
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
@@ -75,6 +84,11 @@ struct CUDAExecutionProviderInfo {
   bool prefer_nhwc{false};
 
   bool use_ep_level_unified_stream{false};
+  // The number of compute streams shared by the runs of the sessions using this EP, each with its own cuBLAS and
+  // cuDNN handles. The streams are created on first use and handed out round-robin, so concurrent runs overlap on the
+  // GPU on up to this many streams. 0 creates a stream for every set of streams of a run instead. It does not apply
+  // with the EP level unified stream.
+  int compute_stream_pool_size{0};
 
   // By default, enable TF32 to speed up float GEMM/MatMul or cuDNN convolution of float matrices.
   bool use_tf32{true};
@@ -115,6 +129,10 @@ struct std::hash<::onnxruntime::CUDAExecutionProviderInfo> {
     onnxruntime::HashCombine(info.gpu_mem_limit, value);
     onnxruntime::HashCombine(info.tunable_op.max_tuning_duration_ms, value);
     onnxruntime::HashCombine(info.sdpa_kernel, value);
+    onnxruntime::HashCombine(info.max_num_cuda_graphs, value);
+    onnxruntime::HashCombine(info.use_cuda_mem_pool, value);
+    onnxruntime::HashCombine(info.cuda_mem_pool_release_threshold, value);
+    onnxruntime::HashCombine(info.compute_stream_pool_size, value);
 
     // Memory pointers
     onnxruntime::HashCombine(reinterpret_cast<size_t>(info.user_compute_stream), value);
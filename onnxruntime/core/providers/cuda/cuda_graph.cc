@@ -15,9 +15,10 @@ CudaGraphSet::~CudaGraphSet() {
 
 void CudaGraphSet::Clear() {
   for (auto& it : cuda_graphs_) {
-    CUDA_CALL_THROW(cudaGraphExecDestroy(it.second));
+    CUDA_CALL_THROW(cudaGraphExecDestroy(it.second.first));
   }
   cuda_graphs_.clear();
+  use_order_.clear();
 }
 
 bool CudaGraphSet::Contains(CudaGraphAnnotation_t cuda_graph_annotation_id) const {
@@ -26,12 +27,32 @@ bool CudaGraphSet::Contains(CudaGraphAnnotation_t cuda_graph_annotation_id) cons
 
 void CudaGraphSet::Put(CudaGraphAnnotation_t cuda_graph_annotation_id, cudaGraphExec_t graph_exec) {
   ORT_ENFORCE(!Contains(cuda_graph_annotation_id));
-  cuda_graphs_.emplace(cuda_graph_annotation_id, graph_exec);
+  use_order_.push_front(cuda_graph_annotation_id);
+  cuda_graphs_.emplace(cuda_graph_annotation_id, std::make_pair(graph_exec, use_order_.begin()));
 }
 
-cudaGraphExec_t CudaGraphSet::Get(CudaGraphAnnotation_t cuda_graph_annotation_id) const {
-  ORT_ENFORCE(Contains(cuda_graph_annotation_id));
-  return cuda_graphs_.at(cuda_graph_annotation_id);
+cudaGraphExec_t CudaGraphSet::Get(CudaGraphAnnotation_t cuda_graph_annotation_id) {
+  auto it = cuda_graphs_.find(cuda_graph_annotation_id);
+  ORT_ENFORCE(it != cuda_graphs_.end());
+  use_order_.splice(use_order_.begin(), use_order_, it->second.second);
+  return it->second.first;
+}
+
+void CudaGraphSet::SetMaxSize(size_t max_size) {
+  max_size_ = max_size;
+}
+
+std::optional<std::pair<CudaGraphAnnotation_t, cudaGraphExec_t>> CudaGraphSet::RemoveLeastRecentlyUsedIfFull() {
+  if (max_size_ == 0 || cuda_graphs_.size() < max_size_) {
+    return std::nullopt;
+  }
+
+  const CudaGraphAnnotation_t cuda_graph_annotation_id = use_order_.back();
+  auto it = cuda_graphs_.find(cuda_graph_annotation_id);
+  const cudaGraphExec_t graph_exec = it->second.first;
+  cuda_graphs_.erase(it);
+  use_order_.pop_back();
+  return std::make_pair(cuda_graph_annotation_id, graph_exec);
 }
 
 CUDAGraphManager::CUDAGraphManager(cudaStream_t stream) : stream_(stream) {
@@ -41,6 +62,10 @@ void CUDAGraphManager::SetStream(cudaStream_t stream) {
   stream_ = stream;
 }
 
+void CUDAGraphManager::SetMaxNumGraphs(size_t max_num_graphs) {
+  cuda_graph_set_.SetMaxSize(max_num_graphs);
+}
+
 void CUDAGraphManager::CaptureBegin(CudaGraphAnnotation_t cuda_graph_annotation_id) {
   ORT_ENFORCE(IsGraphCaptureAllowedOnRun(cuda_graph_annotation_id));
 
@@ -56,7 +81,7 @@ void CUDAGraphManager::CaptureBegin(CudaGraphAnnotation_t cuda_graph_annotation_
   CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeGlobal));
 }
 
-void CUDAGraphManager::CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id) {
+std::optional<CudaGraphAnnotation_t> CUDAGraphManager::CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id) {
   cudaGraph_t graph = NULL;
   CUDA_CALL_THROW(cudaStreamEndCapture(stream_, &graph));
   if (graph == NULL) {
@@ -64,12 +89,38 @@ void CUDAGraphManager::CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id
   }
 
   cudaGraphExec_t graph_exec = NULL;
-  CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec, graph, NULL, NULL, 0));
+  std::optional<CudaGraphAnnotation_t> evicted_annotation_id;
+  if (auto evicted = cuda_graph_set_.RemoveLeastRecentlyUsedIfFull()) {
+    evicted_annotation_id = evicted->first;
+    // The graphs of a model captured with other shapes or addresses usually only differ in the node parameters,
+    // and updating the executable graph of the evicted one for them is much cheaper than instantiating a new one.
+#if CUDART_VERSION >= 12000
+    cudaGraphExecUpdateResultInfo update_result_info;
+    const cudaError_t update_result = cudaGraphExecUpdate(evicted->second, graph, &update_result_info);
+#else
+    cudaGraphNode_t error_node = NULL;
+    cudaGraphExecUpdateResult update_result_info;
+    const cudaError_t update_result = cudaGraphExecUpdate(evicted->second, graph, &error_node, &update_result_info);
+#endif
+    if (update_result == cudaSuccess) {
+      graph_exec = evicted->second;
+    } else {
+      // Clear the error of the failed update, which leaves the executable graph unchanged.
+      ORT_IGNORE_RETURN_VALUE(cudaGetLastError());
+      CUDA_CALL_THROW(cudaGraphExecDestroy(evicted->second));
+    }
+    LOGS_DEFAULT(INFO) << "Evicted the CUDA graph with cuda_graph_annotation_id " << *evicted_annotation_id
+                       << (graph_exec != NULL ? ", reusing its executable graph" : "");
+  }
+
+  if (graph_exec == NULL) {
+    CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec, graph, NULL, NULL, 0));
+  }
   CUDA_CALL_THROW(cudaGraphDestroy(graph));
 
-  // Currently all the captured graphs will be tied to the session's lifecycle
-  // TODO(wy): Addd an interface to free captured graphs
+  // The captured graphs are tied to the session's lifecycle unless their number is limited
   cuda_graph_set_.Put(cuda_graph_annotation_id, graph_exec);
+  return evicted_annotation_id;
 }
 
 Status CUDAGraphManager::Replay(CudaGraphAnnotation_t cuda_graph_annotation_id) {
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <list>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include "core/common/common.h"
 #include <mutex>
@@ -12,7 +15,9 @@
 namespace onnxruntime {
 
 using CudaGraphAnnotation_t = int;
-using CudaGraphSet_t = std::unordered_map<CudaGraphAnnotation_t, cudaGraphExec_t>;
+// The captured graphs with the position of their annotation id in the use order.
+using CudaGraphSet_t =
+    std::unordered_map<CudaGraphAnnotation_t, std::pair<cudaGraphExec_t, std::list<CudaGraphAnnotation_t>::iterator>>;
 
 constexpr CudaGraphAnnotation_t kCudaGraphAnnotationSkip = -1;
 constexpr CudaGraphAnnotation_t kCudaGraphAnnotationDefault = 0;
@@ -24,10 +29,19 @@ struct CudaGraphSet {
   void Clear();
   bool Contains(CudaGraphAnnotation_t cuda_graph_annotation_id) const;
   void Put(CudaGraphAnnotation_t cuda_graph_annotation_id, cudaGraphExec_t graph_exec);
-  cudaGraphExec_t Get(CudaGraphAnnotation_t cuda_graph_annotation_id) const;
+  // Returns the graph and makes it the most recently used one.
+  cudaGraphExec_t Get(CudaGraphAnnotation_t cuda_graph_annotation_id);
+
+  // Limits the number of graphs, 0 for no limit.
+  void SetMaxSize(size_t max_size);
+  // Removes the least recently used graph if the set is full, handing over the ownership of its executable graph.
+  std::optional<std::pair<CudaGraphAnnotation_t, cudaGraphExec_t>> RemoveLeastRecentlyUsedIfFull();
 
  private:
   CudaGraphSet_t cuda_graphs_;
+  // The annotation ids from the most to the least recently used graph.
+  std::list<CudaGraphAnnotation_t> use_order_;
+  size_t max_size_ = 0;
 };
 
 struct CUDAGraphManager {
@@ -36,8 +50,11 @@ struct CUDAGraphManager {
   ~CUDAGraphManager();
 
   void SetStream(cudaStream_t stream);
+  // Limits the number of captured graphs, 0 for no limit. Capturing one more graph evicts the least recently used.
+  void SetMaxNumGraphs(size_t max_num_graphs);
   void CaptureBegin(CudaGraphAnnotation_t cuda_graph_annotation_id);
-  void CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id);
+  // Returns the annotation id of the graph evicted to make room for the new one, if any.
+  std::optional<CudaGraphAnnotation_t> CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id);
   Status Replay(CudaGraphAnnotation_t cuda_graph_annotation_id);
 
   void Reset();
@@ -3,9 +3,12 @@
 
 #include <map>
 #include <string>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #include "cuda_profiler.h"
+#include "core/common/logging/logging.h"
 
 namespace onnxruntime {
 namespace profiling {
@@ -22,6 +25,72 @@ CudaProfiler::~CudaProfiler() {
   manager.DeregisterClient(client_handle_);
 }
 
+void CudaProfiler::EndProfiling(TimePoint start_time, Events& events) {
+  GPUProfilerBase<CUPTIManager>::EndProfiling(start_time, events);
+
+  std::map<uint64_t, KernelMetrics> kernel_metrics;
+  {
+    std::lock_guard<std::mutex> lock(kernel_metrics_mutex_);
+    kernel_metrics.swap(kernel_metrics_);
+  }
+  if (kernel_metrics.empty()) {
+    return;
+  }
+
+  // the metrics are attached to the event of their node, which began when the range of the node did
+  std::map<std::string, KernelMetrics> op_type_metrics;
+  for (auto& event : events) {
+    if (event.cat != NODE_EVENT) {
+      continue;
+    }
+    auto metrics = kernel_metrics.find(static_cast<uint64_t>(event.ts));
+    if (metrics == kernel_metrics.end()) {
+      continue;
+    }
+    event.args["gpu_kernel_metrics"] = metrics->second.ToJson();
+    auto op_name = event.args.find("op_name");
+    if (op_name != event.args.end()) {
+      op_type_metrics[op_name->second].Merge(metrics->second);
+    }
+  }
+
+  std::ostringstream summary;
+  summary << "GPU kernel metrics per op type, in percent of the peak:\n"
+          << std::left << std::setw(32) << "op type" << std::right << std::setw(10) << "kernels" << std::setw(16)
+          << "gpu time (us)" << std::setw(12) << "occupancy" << std::setw(12) << "sm eff." << std::setw(12) << "dram"
+          << std::setw(14) << "tensor core" << "\n"
+          << std::fixed << std::setprecision(1);
+  const long long ts = TimeDiffMicroSeconds(start_time);
+  for (const auto& [op_type, metrics] : op_type_metrics) {
+    events.emplace_back(SESSION_EVENT, logging::GetProcessId(), logging::GetThreadId(),
+                        op_type + "_gpu_kernel_metrics", ts, 0,
+                        std::unordered_map<std::string, std::string>{{"op_type", op_type},
+                                                                     {"gpu_kernel_metrics", metrics.ToJson()}});
+    summary << std::left << std::setw(32) << op_type << std::right << std::setw(10) << metrics.kernel_count
+            << std::setw(16) << metrics.gpu_time_ns / 1000.0 << std::setw(12) << metrics.achieved_occupancy
+            << std::setw(12) << metrics.sm_efficiency << std::setw(12) << metrics.dram_throughput << std::setw(14)
+            << metrics.tensor_core_utilization << "\n";
+  }
+  LOGS_DEFAULT(INFO) << summary.str();
+}
+
+void CudaProfiler::Start(uint64_t id) {
+  GPUProfilerBase<CUPTIManager>::Start(id);
+  if (kernel_metrics_enabled_) {
+    CUPTIRangeProfiler::GetInstance().BeginRange(id);
+  }
+}
+
+void CudaProfiler::Stop(uint64_t id) {
+  KernelMetrics metrics;
+  if (kernel_metrics_enabled_ && CUPTIRangeProfiler::GetInstance().EndRange(id, metrics) &&
+      metrics.kernel_count > 0) {
+    std::lock_guard<std::mutex> lock(kernel_metrics_mutex_);
+    kernel_metrics_[id].Merge(metrics);
+  }
+  GPUProfilerBase<CUPTIManager>::Stop(id);
+}
+
 #endif /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
 
 }  // namespace profiling
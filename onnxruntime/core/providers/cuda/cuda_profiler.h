@@ -4,11 +4,13 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <mutex>
 #include <vector>
 
 #include "core/common/gpu_profiler_common.h"
 #include "cupti_manager.h"
+#include "cupti_range_profiler.h"
 
 namespace onnxruntime {
 namespace profiling {
@@ -23,6 +25,16 @@ class CudaProfiler final : public GPUProfilerBase<CUPTIManager> {
   CudaProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaProfiler);
   ~CudaProfiler();
+  void EnableKernelMetrics() override { kernel_metrics_enabled_ = true; }
+  void EndProfiling(TimePoint start_time, Events& events) override;
+  void Start(uint64_t id) override;
+  void Stop(uint64_t id) override;
+
+ private:
+  bool kernel_metrics_enabled_ = false;
+  std::mutex kernel_metrics_mutex_;
+  // the metrics of the kernels of the ops profiled since profiling started, by the id of their event
+  std::map<uint64_t, KernelMetrics> kernel_metrics_;
 };
 
 #else /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
@@ -180,6 +180,32 @@ struct ProviderInfo_CUDA_Impl final : ProviderInfo_CUDA {
   std::shared_ptr<IAllocator> CreateCudaAllocator(int16_t device_id, size_t gpu_mem_limit, onnxruntime::ArenaExtendStrategy arena_extend_strategy, onnxruntime::CUDAExecutionProviderExternalAllocatorInfo& external_allocator_info, const OrtArenaCfg* default_memory_arena_cfg) override {
     return CUDAExecutionProvider::CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg);
   }
+
+  Status EnablePeerAccess(int device_id, int peer_device_id) override {
+    int current_device_id = 0;
+    CUDA_RETURN_IF_ERROR(cudaGetDevice(&current_device_id));
+    auto enable_peer_access = [](int device, int peer_device) -> Status {
+      int can_access_peer = 0;
+      CUDA_RETURN_IF_ERROR(cudaDeviceCanAccessPeer(&can_access_peer, device, peer_device));
+      if (!can_access_peer) {
+        return Status::OK();
+      }
+      CUDA_RETURN_IF_ERROR(cudaSetDevice(device));
+      const cudaError_t result = cudaDeviceEnablePeerAccess(peer_device, 0);
+      if (result == cudaErrorPeerAccessAlreadyEnabled) {
+        // clear the error so it is not reported by a later call
+        cudaGetLastError();
+        return Status::OK();
+      }
+      return CUDA_CALL(result);
+    };
+    Status status = enable_peer_access(device_id, peer_device_id);
+    if (status.IsOK()) {
+      status = enable_peer_access(peer_device_id, device_id);
+    }
+    CUDA_RETURN_IF_ERROR(cudaSetDevice(current_device_id));
+    return status;
+  }
 } g_info;
 
 struct CUDA_Provider : Provider {
@@ -228,6 +254,10 @@ struct CUDA_Provider : Provider {
     info.use_ep_level_unified_stream = params->use_ep_level_unified_stream != 0;
     info.use_tf32 = params->use_tf32 != 0;
     info.sdpa_kernel = params->sdpa_kernel;
+    info.max_num_cuda_graphs = params->max_num_cuda_graphs;
+    info.use_cuda_mem_pool = params->use_cuda_mem_pool != 0;
+    info.cuda_mem_pool_release_threshold = params->cuda_mem_pool_release_threshold;
+    info.compute_stream_pool_size = params->compute_stream_pool_size;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -264,6 +294,10 @@ struct CUDA_Provider : Provider {
     cuda_options.use_tf32 = internal_options.use_tf32;
     cuda_options.sdpa_kernel = internal_options.sdpa_kernel;
     cuda_options.fuse_conv_bias = internal_options.fuse_conv_bias;
+    cuda_options.max_num_cuda_graphs = internal_options.max_num_cuda_graphs;
+    cuda_options.use_cuda_mem_pool = internal_options.use_cuda_mem_pool;
+    cuda_options.cuda_mem_pool_release_threshold = internal_options.cuda_mem_pool_release_threshold;
+    cuda_options.compute_stream_pool_size = internal_options.compute_stream_pool_size;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -53,6 +53,8 @@ struct ProviderInfo_CUDA {
 
   virtual std::shared_ptr<onnxruntime::IExecutionProviderFactory> CreateExecutionProviderFactory(const onnxruntime::CUDAExecutionProviderInfo& info) = 0;
   virtual std::shared_ptr<onnxruntime::IAllocator> CreateCudaAllocator(int16_t device_id, size_t gpu_mem_limit, onnxruntime::ArenaExtendStrategy arena_extend_strategy, onnxruntime::CUDAExecutionProviderExternalAllocatorInfo& external_allocator_info, const OrtArenaCfg* default_memory_arena_cfg) = 0;
+  // Lets each of the two devices access the memory of the other, if they support peer access.
+  virtual Status EnablePeerAccess(int device_id, int peer_device_id) = 0;
 
   // This function is the entry point to CUDA EP's UT cases.
   // All tests ared only called from onnxruntime_test_all.
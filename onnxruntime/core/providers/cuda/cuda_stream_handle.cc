@@ -107,7 +107,7 @@ std::unique_ptr<synchronize::Notification> CudaStream::CreateNotification(size_t
 void CudaStream::Flush() {
   // A temp fix: when use cuda graph, we can't flush it before cuda graph capture end
   // only flush when we own the stream (not external, not EP unified stream)
-  if (own_stream_)
+  if (own_stream_ || from_stream_pool_)
     CUDA_CALL_THROW(cudaStreamSynchronize(static_cast<cudaStream_t>(GetHandle())));
 }
 
@@ -227,6 +227,36 @@ void* CudaStream::GetResource(int version, int id) const {
   return resource;
 }
 
+CudaStreamPool::~CudaStreamPool() {
+  for (auto& entry : entries_) {
+#ifndef USE_CUDA_MINIMAL
+    cublasDestroy(entry.cublas_handle);
+    cudnnDestroy(entry.cudnn_handle);
+#endif
+    cudaStreamDestroy(entry.stream);
+  }
+}
+
+CudaStreamPool::Entry CudaStreamPool::Next() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.size() < size_) {
+    Entry entry;
+    CUDA_CALL_THROW(cudaStreamCreateWithFlags(&entry.stream, cudaStreamNonBlocking));
+#ifndef USE_CUDA_MINIMAL
+    CUBLAS_CALL_THROW(cublasCreate(&entry.cublas_handle));
+    CUBLAS_CALL_THROW(cublasSetStream(entry.cublas_handle, entry.stream));
+    CUDNN_CALL_THROW(cudnnCreate(&entry.cudnn_handle));
+    CUDNN_CALL_THROW(cudnnSetStream(entry.cudnn_handle, entry.stream));
+#endif
+    entries_.push_back(entry);
+    return entry;
+  }
+
+  const auto& entry = entries_[next_];
+  next_ = (next_ + 1) % size_;
+  return entry;
+}
+
 // CPU Stream command handles
 void WaitCudaNotificationOnDevice(Stream& stream, synchronize::Notification& notification) {
   static_cast<CudaNotification*>(&notification)->wait_on_device(stream);
@@ -244,12 +274,21 @@ void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_regis
                                bool use_existing_stream,
                                cudnnHandle_t external_cudnn_handle,
                                cublasHandle_t external_cublas_handle,
-                               const CUDAExecutionProviderInfo& ep_info) {
+                               const CUDAExecutionProviderInfo& ep_info,
+                               CudaStreamPool* stream_pool) {
   // wait cuda notification on cuda ep
   stream_handle_registry.RegisterWaitFn(device_type, device_type, WaitCudaNotificationOnDevice);
   // wait cuda notification on cpu ep
   stream_handle_registry.RegisterWaitFn(device_type, OrtDevice::CPU, WaitCudaNotificationOnHost);
-  if (!use_existing_stream)
+  if (!use_existing_stream && stream_pool != nullptr)
+    stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator, release_cpu_buffer_on_cuda_stream, ep_info, stream_pool](const OrtDevice& device) {
+      CUDA_CALL_THROW(cudaSetDevice(device.Id()));
+      const auto entry = stream_pool->Next();
+      auto stream = std::make_unique<CudaStream>(entry.stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, false, entry.cudnn_handle, entry.cublas_handle, ep_info);
+      stream->from_stream_pool_ = true;
+      return stream;
+    });
+  else if (!use_existing_stream)
     stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator, release_cpu_buffer_on_cuda_stream, ep_info](const OrtDevice& device) {
       CUDA_CALL_THROW(cudaSetDevice(device.Id()));
       cudaStream_t stream = nullptr;
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <mutex>
+#include <vector>
+
 #include "core/providers/cuda/cuda_pch.h"
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
@@ -40,6 +43,9 @@ struct CudaStream : Stream {
 
   bool own_stream_{true};
 
+  // The stream is borrowed from a CudaStreamPool, so it is synchronized on Flush although it is not owned.
+  bool from_stream_pool_{false};
+
   cudnnHandle_t cudnn_handle_{};
 
   cublasHandle_t cublas_handle_{};
@@ -58,6 +64,31 @@ struct CudaStream : Stream {
   const CUDAExecutionProviderInfo ep_info_;
 };
 
+// A fixed number of CUDA streams, each with its own cuBLAS and cuDNN handles, shared round-robin by the stream
+// collections of concurrent runs instead of one stream and set of handles created per collection.
+class CudaStreamPool {
+ public:
+  struct Entry {
+    cudaStream_t stream{};
+    cudnnHandle_t cudnn_handle{};
+    cublasHandle_t cublas_handle{};
+  };
+
+  explicit CudaStreamPool(size_t size) : size_(size) {}
+  ~CudaStreamPool();
+
+  // Returns the next stream, creating it on the current device if the pool is not full yet.
+  Entry Next();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaStreamPool);
+
+  const size_t size_;
+  std::mutex mutex_;
+  std::vector<Entry> entries_;
+  size_t next_{0};
+};
+
 void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_registry,
                                const OrtDevice::DeviceType device_type,
                                AllocatorPtr cpu_allocator,
@@ -66,5 +97,6 @@ void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_regis
                                bool use_existing_stream,
                                cudnnHandle_t external_cudnn_handle,
                                cublasHandle_t external_cublass_handle,
-                               const CUDAExecutionProviderInfo& ep_info);
+                               const CUDAExecutionProviderInfo& ep_info,
+                               CudaStreamPool* stream_pool = nullptr);
 }  // namespace onnxruntime
@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "cupti_range_profiler.h"
+
+#if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING)
+
+#include <iomanip>
+#include <sstream>
+
+#include <cuda_runtime_api.h>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+void KernelMetrics::Merge(const KernelMetrics& other) {
+  const double total_time_ns = gpu_time_ns + other.gpu_time_ns;
+  if (total_time_ns > 0.0) {
+    auto weighted_average = [&](double value, double other_value) {
+      return (value * gpu_time_ns + other_value * other.gpu_time_ns) / total_time_ns;
+    };
+    achieved_occupancy = weighted_average(achieved_occupancy, other.achieved_occupancy);
+    sm_efficiency = weighted_average(sm_efficiency, other.sm_efficiency);
+    dram_throughput = weighted_average(dram_throughput, other.dram_throughput);
+    tensor_core_utilization = weighted_average(tensor_core_utilization, other.tensor_core_utilization);
+  }
+  kernel_count += other.kernel_count;
+  gpu_time_ns = total_time_ns;
+}
+
+std::string KernelMetrics::ToJson() const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3) << "{\"kernel_count\": " << kernel_count
+      << ", \"gpu_time_us\": " << gpu_time_ns / 1000.0 << ", \"achieved_occupancy\": " << achieved_occupancy
+      << ", \"sm_efficiency\": " << sm_efficiency << ", \"dram_throughput\": " << dram_throughput
+      << ", \"tensor_core_utilization\": " << tensor_core_utilization << "}";
+  return out.str();
+}
+
+CUPTIRangeProfiler& CUPTIRangeProfiler::GetInstance() {
+  static CUPTIRangeProfiler instance;
+  return instance;
+}
+
+#if CUDA_VERSION >= 12060
+
+namespace {
+
+// The metrics collected for every kernel, in the order of the fields of KernelMetrics
+const char* kMetricNames[] = {
+    "gpu__time_duration.sum",
+    "sm__warps_active.avg.pct_of_peak_sustained_active",
+    "smsp__cycles_active.avg.pct_of_peak_sustained_elapsed",
+    "dram__throughput.avg.pct_of_peak_sustained_elapsed",
+    "sm__pipe_tensor_cycles_active.avg.pct_of_peak_sustained_active",
+};
+
+constexpr size_t kNumMetrics = sizeof(kMetricNames) / sizeof(kMetricNames[0]);
+
+// The maximum number of kernels of a range whose metrics are collected
+constexpr size_t kMaxKernelsPerRange = 256;
+
+bool CuptiSucceeded(CUptiResult result, const char* api) {
+  if (result == CUPTI_SUCCESS) {
+    return true;
+  }
+  const char* message = nullptr;
+  cuptiGetResultString(result, &message);
+  LOGS_DEFAULT(WARNING) << api << " failed: " << (message != nullptr ? message : "unknown error");
+  return false;
+}
+
+}  // namespace
+
+#define CUPTI_RETURN_FALSE_IF_ERROR(api, params) \
+  do {                                           \
+    if (!CuptiSucceeded(api(&params), #api)) {   \
+      return false;                              \
+    }                                            \
+  } while (0)
+
+bool CUPTIRangeProfiler::Initialize(int device_id) {
+  CUpti_Profiler_Initialize_Params initialize_params{CUpti_Profiler_Initialize_Params_STRUCT_SIZE};
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerInitialize, initialize_params);
+
+  CUpti_Device_GetChipName_Params chip_name_params{CUpti_Device_GetChipName_Params_STRUCT_SIZE};
+  chip_name_params.deviceIndex = static_cast<size_t>(device_id);
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiDeviceGetChipName, chip_name_params);
+
+  // the driver API is not linked, the current context is queried through its entry point in the runtime,
+  // after making sure the primary context of the device is current
+  void* get_current_context = nullptr;
+  cudaDriverEntryPointQueryResult query_result;
+  CUcontext context = nullptr;
+  if (cudaFree(nullptr) != cudaSuccess ||
+      cudaGetDriverEntryPointByVersion("cuCtxGetCurrent", &get_current_context, 12000, cudaEnableDefault,
+                                       &query_result) != cudaSuccess ||
+      get_current_context == nullptr ||
+      reinterpret_cast<CUresult (*)(CUcontext*)>(get_current_context)(&context) != CUDA_SUCCESS ||
+      context == nullptr) {
+    LOGS_DEFAULT(WARNING) << "The CUDA context of device " << device_id << " is not available.";
+    return false;
+  }
+
+  CUpti_RangeProfiler_GetCounterAvailability_Params availability_params{
+      CUpti_RangeProfiler_GetCounterAvailability_Params_STRUCT_SIZE};
+  availability_params.ctx = context;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerGetCounterAvailability, availability_params);
+  std::vector<uint8_t> counter_availability_image(availability_params.counterAvailabilityImageSize);
+  availability_params.pCounterAvailabilityImage = counter_availability_image.data();
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerGetCounterAvailability, availability_params);
+
+  CUpti_Profiler_Host_Initialize_Params host_params{CUpti_Profiler_Host_Initialize_Params_STRUCT_SIZE};
+  host_params.profilerType = CUPTI_PROFILER_TYPE_RANGE_PROFILER;
+  host_params.pChipName = chip_name_params.pChipName;
+  host_params.pCounterAvailabilityImage = counter_availability_image.data();
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerHostInitialize, host_params);
+  host_object_ = host_params.pHostObject;
+
+  // fails if one of the metrics is not supported by the GPU
+  CUpti_Profiler_Host_ConfigAddMetrics_Params add_metrics_params{CUpti_Profiler_Host_ConfigAddMetrics_Params_STRUCT_SIZE};
+  add_metrics_params.pHostObject = host_object_;
+  add_metrics_params.ppMetricNames = kMetricNames;
+  add_metrics_params.numMetrics = kNumMetrics;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerHostConfigAddMetrics, add_metrics_params);
+
+  CUpti_Profiler_Host_GetConfigImageSize_Params config_size_params{
+      CUpti_Profiler_Host_GetConfigImageSize_Params_STRUCT_SIZE};
+  config_size_params.pHostObject = host_object_;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerHostGetConfigImageSize, config_size_params);
+  config_image_.resize(config_size_params.configImageSize);
+
+  CUpti_Profiler_Host_GetConfigImage_Params config_params{CUpti_Profiler_Host_GetConfigImage_Params_STRUCT_SIZE};
+  config_params.pHostObject = host_object_;
+  config_params.configImageSize = config_image_.size();
+  config_params.pConfigImage = config_image_.data();
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerHostGetConfigImage, config_params);
+
+  CUpti_RangeProfiler_Enable_Params enable_params{CUpti_RangeProfiler_Enable_Params_STRUCT_SIZE};
+  enable_params.ctx = context;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerEnable, enable_params);
+  range_profiler_object_ = enable_params.pRangeProfilerObject;
+
+  CUpti_RangeProfiler_GetCounterDataSize_Params counter_data_size_params{
+      CUpti_RangeProfiler_GetCounterDataSize_Params_STRUCT_SIZE};
+  counter_data_size_params.pRangeProfilerObject = range_profiler_object_;
+  counter_data_size_params.pMetricNames = kMetricNames;
+  counter_data_size_params.numMetrics = kNumMetrics;
+  counter_data_size_params.maxNumOfRanges = kMaxKernelsPerRange;
+  counter_data_size_params.maxNumRangeTreeNodes = kMaxKernelsPerRange;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerGetCounterDataSize, counter_data_size_params);
+  counter_data_image_.resize(counter_data_size_params.counterDataSize);
+
+  return true;
+}
+
+bool CUPTIRangeProfiler::StopRange(KernelMetrics* metrics) {
+  range_active_ = false;
+
+  CUpti_RangeProfiler_Stop_Params stop_params{CUpti_RangeProfiler_Stop_Params_STRUCT_SIZE};
+  stop_params.pRangeProfilerObject = range_profiler_object_;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerStop, stop_params);
+
+  CUpti_RangeProfiler_DecodeData_Params decode_params{CUpti_RangeProfiler_DecodeData_Params_STRUCT_SIZE};
+  decode_params.pRangeProfilerObject = range_profiler_object_;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerDecodeData, decode_params);
+  if (metrics == nullptr) {
+    return true;
+  }
+  if (decode_params.numOfRangeDropped > 0) {
+    LOGS_DEFAULT(WARNING) << "The metrics of " << decode_params.numOfRangeDropped << " kernels are not collected, "
+                          << "only the first " << kMaxKernelsPerRange << " kernels of an op are.";
+  }
+
+  CUpti_RangeProfiler_GetCounterDataInfo_Params info_params{CUpti_RangeProfiler_GetCounterDataInfo_Params_STRUCT_SIZE};
+  info_params.pCounterDataImage = counter_data_image_.data();
+  info_params.counterDataImageSize = counter_data_image_.size();
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerGetCounterDataInfo, info_params);
+
+  *metrics = KernelMetrics{};
+  for (size_t range_index = 0; range_index < info_params.numTotalRanges; ++range_index) {
+    double values[kNumMetrics] = {};
+    CUpti_Profiler_Host_EvaluateToGpuValues_Params evaluate_params{
+        CUpti_Profiler_Host_EvaluateToGpuValues_Params_STRUCT_SIZE};
+    evaluate_params.pHostObject = host_object_;
+    evaluate_params.pCounterDataImage = counter_data_image_.data();
+    evaluate_params.counterDataImageSize = counter_data_image_.size();
+    evaluate_params.rangeIndex = range_index;
+    evaluate_params.ppMetricNames = kMetricNames;
+    evaluate_params.numMetrics = kNumMetrics;
+    evaluate_params.pMetricValues = values;
+    CUPTI_RETURN_FALSE_IF_ERROR(cuptiProfilerHostEvaluateToGpuValues, evaluate_params);
+
+    metrics->Merge(KernelMetrics{1, values[0], values[1], values[2], values[3], values[4]});
+  }
+  return true;
+}
+
+bool CUPTIRangeProfiler::BeginRange(uint64_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (range_active_) {
+    if (range_thread_id_ != std::this_thread::get_id()) {
+      return false;
+    }
+    // an event nested in the one of the active range began, the metrics of the active range are dropped
+    StopRange(nullptr);
+  }
+
+  int device_id = -1;
+  if (cudaGetDevice(&device_id) != cudaSuccess) {
+    return false;
+  }
+  if (!initialized_) {
+    initialized_ = true;
+    device_id_ = device_id;
+    available_ = Initialize(device_id);
+    if (!available_) {
+      LOGS_DEFAULT(WARNING) << "The GPU kernel metrics are not collected.";
+    }
+  }
+  if (!available_ || device_id != device_id_) {
+    return false;
+  }
+
+  CUpti_RangeProfiler_CounterDataImage_Initialize_Params counter_data_params{
+      CUpti_RangeProfiler_CounterDataImage_Initialize_Params_STRUCT_SIZE};
+  counter_data_params.pRangeProfilerObject = range_profiler_object_;
+  counter_data_params.counterDataSize = counter_data_image_.size();
+  counter_data_params.pCounterData = counter_data_image_.data();
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerCounterDataImageInitialize, counter_data_params);
+
+  // every kernel is a range of its own, replayed until all the metrics are collected
+  CUpti_RangeProfiler_SetConfig_Params set_config_params{CUpti_RangeProfiler_SetConfig_Params_STRUCT_SIZE};
+  set_config_params.pRangeProfilerObject = range_profiler_object_;
+  set_config_params.configSize = config_image_.size();
+  set_config_params.pConfig = config_image_.data();
+  set_config_params.counterDataImageSize = counter_data_image_.size();
+  set_config_params.pCounterDataImage = counter_data_image_.data();
+  set_config_params.range = CUPTI_AutoRange;
+  set_config_params.replayMode = CUPTI_KernelReplay;
+  set_config_params.maxRangesPerPass = kMaxKernelsPerRange;
+  set_config_params.numNestingLevels = 1;
+  set_config_params.minNestingLevel = 1;
+  set_config_params.passIndex = 0;
+  set_config_params.targetNestingLevel = 1;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerSetConfig, set_config_params);
+
+  CUpti_RangeProfiler_Start_Params start_params{CUpti_RangeProfiler_Start_Params_STRUCT_SIZE};
+  start_params.pRangeProfilerObject = range_profiler_object_;
+  CUPTI_RETURN_FALSE_IF_ERROR(cuptiRangeProfilerStart, start_params);
+
+  range_active_ = true;
+  range_id_ = id;
+  range_thread_id_ = std::this_thread::get_id();
+  return true;
+}
+
+#undef CUPTI_RETURN_FALSE_IF_ERROR
+
+#else /* #if CUDA_VERSION >= 12060 */
+
+bool CUPTIRangeProfiler::Initialize(int /*device_id*/) {
+  LOGS_DEFAULT(WARNING) << "Collecting GPU kernel metrics requires the range profiler of CUPTI from CUDA 12.6.";
+  return false;
+}
+
+bool CUPTIRangeProfiler::StopRange(KernelMetrics* /*metrics*/) {
+  range_active_ = false;
+  return false;
+}
+
+bool CUPTIRangeProfiler::BeginRange(uint64_t /*id*/) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!initialized_) {
+    initialized_ = true;
+    available_ = Initialize(device_id_);
+  }
+  return false;
+}
+
+#endif /* #if CUDA_VERSION >= 12060 */
+
+bool CUPTIRangeProfiler::EndRange(uint64_t id, KernelMetrics& metrics) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!range_active_ || range_id_ != id || range_thread_id_ != std::this_thread::get_id()) {
+    return false;
+  }
+  return StopRange(&metrics);
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
+
+#endif /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING)
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cupti.h>
+
+#include "core/common/common.h"
+
+// Do not move the check for CUDA_VERSION above #include <cupti.h>
+// the macros are defined in cupti.h
+#if CUDA_VERSION >= 12060
+#include <cupti_profiler_host.h>
+#include <cupti_range_profiler.h>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+// The hardware metrics of the kernels launched by an op.
+struct KernelMetrics {
+  size_t kernel_count = 0;
+  double gpu_time_ns = 0.0;
+  // Averages over the kernels weighted by their GPU time, in percent of the peak
+  double achieved_occupancy = 0.0;
+  double sm_efficiency = 0.0;
+  double dram_throughput = 0.0;
+  double tensor_core_utilization = 0.0;
+
+  // Adds the kernels of other to these kernels.
+  void Merge(const KernelMetrics& other);
+
+  // Returns the metrics as a JSON object, e.g. {"kernel_count": 2, "gpu_time_us": 10.500, ...}.
+  std::string ToJson() const;
+};
+
+/**
+ * Collects the hardware metrics of every kernel launched between BeginRange and EndRange with the range profiler of
+ * CUPTI. Requires CUDA 12.6 or later, and the permission to access the GPU performance counters.
+ *
+ * Each kernel is replayed as many times as needed to collect all the metrics, so the kernels run much slower while a
+ * range is active. The counters are collected for a single context, the one of the device that is current when the
+ * first range begins, and a single range can be active at a time: ranges that begin on another thread meanwhile are
+ * not collected. A range that begins on the thread of the active range replaces it, so that the innermost event of
+ * nested profiler events, i.e. the node event, is collected.
+ */
+class CUPTIRangeProfiler {
+ public:
+  static CUPTIRangeProfiler& GetInstance();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CUPTIRangeProfiler);
+
+  // Starts collecting the metrics of the kernels of the range with the given id on the current device.
+  // Returns false if they can't be collected.
+  bool BeginRange(uint64_t id);
+
+  // Stops collecting the metrics of the range with the given id, if it is active on the calling thread, and sets
+  // metrics to the metrics of its kernels. Returns false if the range wasn't active or its metrics are not available.
+  bool EndRange(uint64_t id, KernelMetrics& metrics);
+
+ private:
+  CUPTIRangeProfiler() = default;
+
+  // Sets up the range profiler for the current context. Returns false, after logging the reason, on failure.
+  bool Initialize(int device_id);
+
+  // Stops the active range and reads the metrics of its kernels. Requires mutex_.
+  bool StopRange(KernelMetrics* metrics);
+
+  std::mutex mutex_;
+  bool initialized_ = false;
+  bool available_ = false;
+  int device_id_ = -1;
+
+  bool range_active_ = false;
+  uint64_t range_id_ = 0;
+  std::thread::id range_thread_id_;
+
+#if CUDA_VERSION >= 12060
+  CUpti_Profiler_Host_Object* host_object_ = nullptr;
+  CUpti_RangeProfiler_Object* range_profiler_object_ = nullptr;
+#endif
+  std::vector<uint8_t> config_image_;
+  std::vector<uint8_t> counter_data_image_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
+
+#endif /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
@@ -3,10 +3,60 @@
 
 #include "core/providers/shared_library/provider_api.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
 #include "core/providers/cuda/gpu_data_transfer.h"
 #include "cuda_common.h"
 
 namespace onnxruntime {
+namespace {
+// copies of tensors up to this size are coalesced by CopyTensors
+constexpr size_t kMaxCoalescedCopySize = 64 * 1024;
+// alignment of the tensors in the staging buffers
+constexpr size_t kCoalescedCopyAlignment = 256;
+// size of the pinned ring for the copies of pageable host memory, and the largest copy made through it
+constexpr size_t kPinnedRingSize = 64 * 1024 * 1024;
+constexpr size_t kMaxPinnedRingCopySize = kPinnedRingSize / 4;
+
+// A copy from the pinned ring to pageable host memory, made by the stream once the transfer to the ring completed.
+struct PinnedRingToHostCopy {
+  void* dst;
+  const void* src;
+  size_t bytes;
+};
+
+void CUDART_CB CopyFromPinnedRing(void* user_data) {
+  std::unique_ptr<PinnedRingToHostCopy> copy{static_cast<PinnedRingToHostCopy*>(user_data)};
+  memcpy(copy->dst, copy->src, copy->bytes);
+}
+}  // namespace
+
+GPUDataTransfer::~GPUDataTransfer() {
+  // errors are ignored as the CUDA runtime may already be shut down
+  for (const auto& region : ring_regions_) {
+    cudaEventSynchronize(region.event);
+    cudaEventDestroy(region.event);
+  }
+  for (cudaEvent_t event : free_ring_events_) {
+    cudaEventDestroy(event);
+  }
+  if (pinned_ring_ != nullptr) {
+    cudaFreeHost(pinned_ring_);
+  }
+  if (staging_event_ != nullptr) {
+    cudaEventDestroy(staging_event_);
+  }
+  if (pinned_staging_ != nullptr) {
+    cudaFreeHost(pinned_staging_);
+  }
+  if (device_staging_ != nullptr) {
+    cudaFree(device_staging_);
+  }
+}
+
 bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const {
   return src_device.Type() == OrtDevice::GPU || src_device.MemType() == OrtDevice::MemType::CUDA_PINNED ||
          dst_device.Type() == OrtDevice::GPU || dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED;
@@ -59,6 +109,12 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
   auto& src_device = src.Location().device;
   auto& dst_device = dst.Location().device;
 
+  bool handled = false;
+  ORT_RETURN_IF_ERROR(CopyThroughPinnedRing(src, dst, static_cast<cudaStream_t>(stream.GetHandle()), handled));
+  if (handled) {
+    return Status::OK();
+  }
+
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU) {
       // copy from pinned or non-pinned CPU memory to GPU
@@ -87,4 +143,222 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
   return Status::OK();
 }
 
+common::Status GPUDataTransfer::CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const {
+  int current_device = 0;
+  CUDA_RETURN_IF_ERROR(cudaGetDevice(&current_device));
+
+  struct Batch {
+    bool to_device;
+    Stream* stream;
+    std::vector<const SrcDstPair*> pairs;
+  };
+  std::vector<Batch> batches;
+
+  for (const auto& pair : src_dst_pairs) {
+    const Tensor& src = pair.src;
+    Tensor& dst = pair.dst;
+    const auto& src_device = src.Location().device;
+    const auto& dst_device = dst.Location().device;
+    const bool to_device = src_device.Type() == OrtDevice::CPU && dst_device.Type() == OrtDevice::GPU;
+    const bool to_host = src_device.Type() == OrtDevice::GPU && dst_device.Type() == OrtDevice::CPU;
+    const size_t bytes = src.SizeInBytes();
+
+    if ((to_device || to_host) && (to_device ? dst_device : src_device).Id() == current_device && bytes > 0 &&
+        bytes <= kMaxCoalescedCopySize && bytes == dst.SizeInBytes()) {
+      auto batch = std::find_if(batches.begin(), batches.end(), [&](const Batch& b) {
+        return b.to_device == to_device && b.stream == pair.src_stream;
+      });
+      if (batch == batches.end()) {
+        batches.push_back({to_device, pair.src_stream, {}});
+        batch = std::prev(batches.end());
+      }
+      batch->pairs.push_back(&pair);
+    } else {
+      ORT_RETURN_IF_ERROR(pair.src_stream ? CopyTensorAsync(src, dst, *pair.src_stream) : CopyTensor(src, dst));
+    }
+  }
+
+  for (const auto& batch : batches) {
+    if (batch.pairs.size() == 1) {
+      const SrcDstPair& pair = *batch.pairs.front();
+      ORT_RETURN_IF_ERROR(pair.src_stream ? CopyTensorAsync(pair.src, pair.dst, *pair.src_stream)
+                                          : CopyTensor(pair.src, pair.dst));
+    } else {
+      ORT_RETURN_IF_ERROR(CopyCoalesced(batch.to_device, batch.stream, batch.pairs));
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::CopyCoalesced(bool to_device, Stream* stream,
+                                              const std::vector<const SrcDstPair*>& pairs) const {
+  std::vector<size_t> offsets;
+  offsets.reserve(pairs.size());
+  size_t total_size = 0;
+  for (const auto* pair : pairs) {
+    offsets.push_back(total_size);
+    const size_t bytes = pair->src.get().SizeInBytes();
+    total_size += (bytes + kCoalescedCopyAlignment - 1) / kCoalescedCopyAlignment * kCoalescedCopyAlignment;
+  }
+
+  std::lock_guard<std::mutex> lock(staging_mutex_);
+  if (staging_event_ == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&staging_event_, cudaEventDisableTiming));
+  } else {
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(staging_event_));
+  }
+  ORT_RETURN_IF_ERROR(ReserveStaging(total_size));
+
+  cudaStream_t cuda_stream = stream ? static_cast<cudaStream_t>(stream->GetHandle()) : nullptr;
+  char* pinned_staging = static_cast<char*>(pinned_staging_);
+  char* device_staging = static_cast<char*>(device_staging_);
+
+  if (to_device) {
+    // gather on the host, transfer, then scatter on the device
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      const Tensor& src = pairs[i]->src;
+      memcpy(pinned_staging + offsets[i], src.DataRaw(), src.SizeInBytes());
+    }
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(device_staging, pinned_staging, total_size, cudaMemcpyHostToDevice,
+                                         cuda_stream));
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      Tensor& dst = pairs[i]->dst;
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst.MutableDataRaw(), device_staging + offsets[i], dst.SizeInBytes(),
+                                           cudaMemcpyDeviceToDevice, cuda_stream));
+    }
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(staging_event_, cuda_stream));
+    if (stream == nullptr) {
+      // like CopyTensor, the data has arrived on return
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+    }
+  } else {
+    // gather on the device, transfer, then scatter on the host once the transfer completed, so unlike
+    // CopyTensorAsync this waits for the stream
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      const Tensor& src = pairs[i]->src;
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(device_staging + offsets[i], src.DataRaw(), src.SizeInBytes(),
+                                           cudaMemcpyDeviceToDevice, cuda_stream));
+    }
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(pinned_staging, device_staging, total_size, cudaMemcpyDeviceToHost,
+                                         cuda_stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(staging_event_, cuda_stream));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      Tensor& dst = pairs[i]->dst;
+      memcpy(dst.MutableDataRaw(), pinned_staging + offsets[i], dst.SizeInBytes());
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::CopyThroughPinnedRing(const Tensor& src, Tensor& dst, cudaStream_t stream,
+                                                      bool& handled) const {
+  handled = false;
+  const auto& src_device = src.Location().device;
+  const auto& dst_device = dst.Location().device;
+  const bool to_device = src_device.Type() == OrtDevice::CPU && dst_device.Type() == OrtDevice::GPU &&
+                         src_device.MemType() != OrtDevice::MemType::CUDA_PINNED;
+  const bool to_host = src_device.Type() == OrtDevice::GPU && dst_device.Type() == OrtDevice::CPU &&
+                       dst_device.MemType() != OrtDevice::MemType::CUDA_PINNED;
+  const size_t bytes = src.SizeInBytes();
+  if ((!to_device && !to_host) || stream == nullptr || bytes == 0 || bytes > kMaxPinnedRingCopySize ||
+      bytes != dst.SizeInBytes()) {
+    return Status::OK();
+  }
+
+  // a captured graph would replay the copies without the host side
+  cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+  CUDA_RETURN_IF_ERROR(cudaStreamIsCapturing(stream, &capture_status));
+  if (capture_status != cudaStreamCaptureStatusNone) {
+    return Status::OK();
+  }
+
+  std::lock_guard<std::mutex> lock(ring_mutex_);
+  char* pinned = nullptr;
+  cudaEvent_t event = nullptr;
+  ORT_RETURN_IF_ERROR(AcquirePinnedRing(bytes, pinned, event));
+
+  if (to_device) {
+    // the host copy runs while the stream may still be busy with earlier work, and the transfer from pinned memory
+    // is queued without waiting for it
+    memcpy(pinned, src.DataRaw(), bytes);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst.MutableDataRaw(), pinned, bytes, cudaMemcpyHostToDevice, stream));
+  } else {
+    // the host copy is made by the stream after the transfer, so it is complete once the stream is synchronized
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(pinned, src.DataRaw(), bytes, cudaMemcpyDeviceToHost, stream));
+    auto copy = std::make_unique<PinnedRingToHostCopy>(PinnedRingToHostCopy{dst.MutableDataRaw(), pinned, bytes});
+    CUDA_RETURN_IF_ERROR(cudaLaunchHostFunc(stream, CopyFromPinnedRing, copy.get()));
+    copy.release();
+  }
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(event, stream));
+
+  handled = true;
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::AcquirePinnedRing(size_t size, char*& data, cudaEvent_t& event) const {
+  if (pinned_ring_ == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaMallocHost(reinterpret_cast<void**>(&pinned_ring_), kPinnedRingSize));
+  }
+
+  size = (size + kCoalescedCopyAlignment - 1) / kCoalescedCopyAlignment * kCoalescedCopyAlignment;
+  size_t offset = ring_head_;
+  size_t length = size;
+  if (offset + size > kPinnedRingSize) {
+    // skip the end of the ring
+    length += kPinnedRingSize - offset;
+    offset = 0;
+  }
+
+  // the ring is used in order, so the bytes after the head are the ones of the oldest copies
+  while (ring_bytes_in_flight_ + length > kPinnedRingSize) {
+    const RingRegion& oldest = ring_regions_.front();
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(oldest.event));
+    ring_bytes_in_flight_ -= oldest.length;
+    free_ring_events_.push_back(oldest.event);
+    ring_regions_.pop_front();
+  }
+
+  if (free_ring_events_.empty()) {
+    cudaEvent_t new_event = nullptr;
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&new_event, cudaEventDisableTiming));
+    free_ring_events_.push_back(new_event);
+  }
+  event = free_ring_events_.back();
+  free_ring_events_.pop_back();
+
+  // an event that is not recorded because the copy failed to be queued is complete when waited for
+  ring_regions_.push_back(RingRegion{length, event});
+  ring_bytes_in_flight_ += length;
+  ring_head_ = (offset + size) % kPinnedRingSize;
+  data = pinned_ring_ + offset;
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::ReserveStaging(size_t size) const {
+  if (size <= staging_size_) {
+    return Status::OK();
+  }
+
+  // grow geometrically so that the buffers are seldom reallocated
+  const size_t reserved_size = std::max(size, 2 * staging_size_);
+
+  if (pinned_staging_ != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaFreeHost(pinned_staging_));
+    pinned_staging_ = nullptr;
+  }
+  if (device_staging_ != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaFree(device_staging_));
+    device_staging_ = nullptr;
+  }
+  staging_size_ = 0;
+
+  CUDA_RETURN_IF_ERROR(cudaMallocHost(&pinned_staging_, reserved_size));
+  CUDA_RETURN_IF_ERROR(cudaMalloc(&device_staging_, reserved_size));
+  staging_size_ = reserved_size;
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <deque>
+#include <mutex>
+#include <vector>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
 
@@ -11,7 +15,7 @@ namespace onnxruntime {
 class GPUDataTransfer : public IDataTransfer {
  public:
   GPUDataTransfer() = default;
-  ~GPUDataTransfer() = default;
+  ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
 
@@ -19,6 +23,45 @@ class GPUDataTransfer : public IDataTransfer {
   using IDataTransfer::CopyTensor;
   common::Status CopyTensor(const Tensor& src, Tensor& dst) const override;
   common::Status CopyTensorAsync(const Tensor& src, Tensor& dst, Stream& stream) const override;
+
+  // Small copies between the host and the current device in the same direction and on the same stream are gathered
+  // in a staging buffer and transferred at once, the others are copied one at a time.
+  common::Status CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GPUDataTransfer);
+
+  common::Status CopyCoalesced(bool to_device, Stream* stream, const std::vector<const SrcDstPair*>& pairs) const;
+  // Grows the staging buffers to size bytes. Requires staging_mutex_.
+  common::Status ReserveStaging(size_t size) const;
+
+  // Copies between pageable host memory and the device through the pinned ring, so that the transfer is queued on
+  // the stream instead of blocking the host. Returns false in handled if the copy should be made directly.
+  common::Status CopyThroughPinnedRing(const Tensor& src, Tensor& dst, cudaStream_t stream, bool& handled) const;
+  // Takes size bytes of the pinned ring, after waiting for the oldest copies using them. Requires ring_mutex_.
+  common::Status AcquirePinnedRing(size_t size, char*& data, cudaEvent_t& event) const;
+
+  mutable std::mutex staging_mutex_;
+  mutable void* pinned_staging_ = nullptr;
+  mutable void* device_staging_ = nullptr;
+  mutable size_t staging_size_ = 0;
+  // recorded after the last coalesced copy, which must complete before the staging buffers are reused
+  mutable cudaEvent_t staging_event_ = nullptr;
+
+  // A region of the pinned ring used by a copy that may still be running, with the event recorded after the copy.
+  struct RingRegion {
+    // the bytes of the ring taken by the copy, including the end of the ring skipped when it wrapped around
+    size_t length;
+    cudaEvent_t event;
+  };
+
+  mutable std::mutex ring_mutex_;
+  mutable char* pinned_ring_ = nullptr;
+  mutable size_t ring_head_ = 0;
+  mutable size_t ring_bytes_in_flight_ = 0;
+  // from the oldest to the newest copy
+  mutable std::deque<RingRegion> ring_regions_;
+  mutable std::vector<cudaEvent_t> free_ring_events_;
 };
 
 }  // namespace onnxruntime
@@ -92,11 +92,15 @@ namespace Dml
             ORT_THROW_HR_IF(E_UNEXPECTED, static_cast<ptrdiff_t>(m_subgraphInputs.size()) != kernelContext->InputCount());
 
             bool recompileNeeded = m_compiledExecutionPlanOperator == nullptr;
+            bool cpuInputsChanged = false;
+            std::vector<onnxruntime::TensorShape> inputShapes;
+            inputShapes.reserve(kernelContext->InputCount());
 
             for (int inputIndex = 0; inputIndex < kernelContext->InputCount(); ++inputIndex)
             {
                 const auto& input = kernelContext->RequiredInput<onnxruntime::Tensor>(inputIndex);
                 const std::string& inputName = m_subgraphInputs[inputIndex]->Name();
+                inputShapes.push_back(input.Shape());
                 auto shapeIter = m_inferredInputShapes.find(inputName);
 
                 if (shapeIter == m_inferredInputShapes.end())
@@ -126,19 +130,19 @@ namespace Dml
                             {
                                 if (initializerIter->second.first->raw_data()[i] != inputProto.raw_data()[i])
                                 {
-                                    recompileNeeded = true;
+                                    cpuInputsChanged = true;
                                     break;
                                 }
                             }
                         }
                         else
                         {
-                            recompileNeeded = true;
+                            cpuInputsChanged = true;
                         }
                     }
                     else
                     {
-                        recompileNeeded = true;
+                        cpuInputsChanged = true;
                     }
 
                     m_ownedCpuInputs.push_back(std::make_unique<ONNX_NAMESPACE::TensorProto>(std::move(inputProto)));
@@ -146,6 +150,19 @@ namespace Dml
                 }
             }
 
+            recompileNeeded = recompileNeeded || cpuInputsChanged;
+
+            // The values of CPU inputs are compiled into the graph, so the graphs compiled for other shapes can only
+            // be reused while they don't change.
+            if (cpuInputsChanged)
+            {
+                m_compiledGraphCache.clear();
+            }
+            else if (recompileNeeded)
+            {
+                recompileNeeded = !RestoreCompiledGraph(inputShapes);
+            }
+
             if (recompileNeeded)
             {
                 // Go through all the node args and replace their shapes with the real ones
@@ -233,6 +250,7 @@ namespace Dml
                 std::vector<DML_BINDING_DESC> inputBindingDescs(kernelContext->InputCount());
 
                 m_reusedCommandLists.clear();
+                m_compiledInputShapes = std::move(inputShapes);
             }
 
             // When we are capturing a graph, we don't pool the command list and instead transfer it to the execution provider. Captured graph
@@ -309,6 +327,75 @@ namespace Dml
         }
 
     private:
+        // A graph compiled for a set of input shapes, along with the command lists recorded for it
+        struct CompiledGraph
+        {
+            std::vector<onnxruntime::TensorShape> inputShapes;
+            ComPtr<IDMLCompiledOperator> compiledExecutionPlanOperator;
+            std::vector<bool> inputsUsed;
+            ComPtr<ID3D12Resource> persistentResource;
+            ComPtr<IUnknown> persistentResourceAllocatorUnknown;
+            std::optional<DML_BUFFER_BINDING> persistentResourceBinding;
+            Windows::AI::MachineLearning::Adapter::EdgeShapes outputShapes;
+            std::deque<std::unique_ptr<DmlReusedCommandListState>> reusedCommandLists;
+            std::vector<uint8_t> isInputsUploadedByDmlEP;
+            std::vector<ComPtr<ID3D12Resource>> nonOwnedGraphInputsFromInitializers;
+        };
+
+        // Maximum number of graphs compiled for other input shapes kept alive, so that models alternating between
+        // a few shapes don't compile and initialize the graph and record its command lists on every shape change
+        static constexpr size_t c_maxCachedCompiledGraphs = 8;
+
+        void SwapCompiledGraph(CompiledGraph& compiledGraph) const
+        {
+            std::swap(compiledGraph.inputShapes, m_compiledInputShapes);
+            std::swap(compiledGraph.compiledExecutionPlanOperator, m_compiledExecutionPlanOperator);
+            std::swap(compiledGraph.inputsUsed, m_inputsUsed);
+            std::swap(compiledGraph.persistentResource, m_persistentResource);
+            std::swap(compiledGraph.persistentResourceAllocatorUnknown, m_persistentResourceAllocatorUnknown);
+            std::swap(compiledGraph.persistentResourceBinding, m_persistentResourceBinding);
+            std::swap(compiledGraph.outputShapes, m_outputShapes);
+            std::swap(compiledGraph.reusedCommandLists, m_reusedCommandLists);
+            std::swap(compiledGraph.isInputsUploadedByDmlEP, m_isInputsUploadedByDmlEP);
+            std::swap(compiledGraph.nonOwnedGraphInputsFromInitializers, m_nonOwnedGraphInputsFromInitializers);
+        }
+
+        // Moves the current graph to the cache and restores the graph compiled for the input shapes if there is one.
+        // The most recently used graphs are at the front of the cache.
+        bool RestoreCompiledGraph(const std::vector<onnxruntime::TensorShape>& inputShapes) const
+        {
+            auto iter = std::find_if(m_compiledGraphCache.begin(), m_compiledGraphCache.end(), [&](const CompiledGraph& compiledGraph) {
+                return compiledGraph.inputShapes == inputShapes;
+            });
+
+            CompiledGraph cachedGraph;
+            const bool found = iter != m_compiledGraphCache.end();
+            if (found)
+            {
+                cachedGraph = std::move(*iter);
+                m_compiledGraphCache.erase(iter);
+            }
+
+            if (m_compiledExecutionPlanOperator)
+            {
+                CompiledGraph currentGraph;
+                SwapCompiledGraph(currentGraph);
+                m_compiledGraphCache.push_front(std::move(currentGraph));
+
+                if (m_compiledGraphCache.size() > c_maxCachedCompiledGraphs)
+                {
+                    m_compiledGraphCache.pop_back();
+                }
+            }
+
+            if (found)
+            {
+                SwapCompiledGraph(cachedGraph);
+            }
+
+            return found;
+        }
+
         ComPtr<IWinmlExecutionProvider> m_winmlProvider;
         ComPtr<Dml::IExecutionProvider> m_provider;
 
@@ -336,6 +423,8 @@ namespace Dml
         mutable std::deque<std::unique_ptr<DmlReusedCommandListState>> m_reusedCommandLists;
         mutable std::vector<uint8_t> m_isInputsUploadedByDmlEP;
         mutable std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
+        mutable std::vector<onnxruntime::TensorShape> m_compiledInputShapes;
+        mutable std::list<CompiledGraph> m_compiledGraphCache;
     };
 
     onnxruntime::OpKernel* CreateRuntimeFusedGraphKernel(
@@ -298,7 +298,8 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
     }
 
     // subgraph primitive
-    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get());
+    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(
+        *subgraphs_[fused_node.Name()].get(), static_cast<size_t>(info_.primitive_cache_capacity));
     {
       const auto& input_defs = fused_node.InputDefs();
       std::vector<std::string> onnx_input_names(input_defs.size());
@@ -392,4 +393,8 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
   return Status::OK();
 }
 
+std::unique_ptr<profiling::EpProfiler> DnnlExecutionProvider::GetProfiler() {
+  return std::make_unique<profiling::DnnlProfiler>(subgraph_primitives_);
+}
+
 }  // namespace onnxruntime
@@ -11,6 +11,7 @@
 #include "core/providers/dnnl/dnnl_execution_provider_info.h"
 #include "core/providers/dnnl/dnnl_threadpool.h"
 #include "core/providers/dnnl/dnnl_op_manager.h"
+#include "core/providers/dnnl/dnnl_profiler.h"
 #include "core/providers/dnnl/subgraph/dnnl_subgraph.h"
 #include "core/providers/dnnl/subgraph/dnnl_subgraph_primitive.h"
 
@@ -31,6 +32,8 @@ class DnnlExecutionProvider : public IExecutionProvider {
   common::Status Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                          std::vector<NodeComputeInfo>& node_compute_funcs) override;
 
+  std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
+
  private:
   DnnlExecutionProviderInfo info_;
   // DnnlOpManager contains information about supported Dnnl Operators
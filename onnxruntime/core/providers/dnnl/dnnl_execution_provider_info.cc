@@ -9,6 +9,7 @@
 namespace onnxruntime::dnnl::provider_option_names {
 constexpr const char* kUseArena = "use_arena";
 constexpr const char* kThreadpoolArgs = "threadpool_args";
+constexpr const char* kPrimitiveCacheCapacity = "primitive_cache_capacity";
 }  // namespace onnxruntime::dnnl::provider_option_names
 
 namespace onnxruntime {
@@ -26,7 +27,10 @@ DnnlExecutionProviderInfo DnnlExecutionProviderInfo::FromProviderOptions(const P
                 return Status::OK();
               })
           .AddAssignmentToReference(dnnl::provider_option_names::kUseArena, info.use_arena)
+          .AddAssignmentToReference(dnnl::provider_option_names::kPrimitiveCacheCapacity, info.primitive_cache_capacity)
           .Parse(options));
+  ORT_ENFORCE(info.primitive_cache_capacity > 0, "The DNNL primitive cache capacity must be positive, got ",
+              info.primitive_cache_capacity);
   return info;
 }
 
@@ -34,6 +38,7 @@ ProviderOptions DnnlExecutionProviderInfo::ToProviderOptions(const DnnlExecution
   const ProviderOptions options{
       {dnnl::provider_option_names::kUseArena, MakeStringWithClassicLocale(info.use_arena)},
       {dnnl::provider_option_names::kThreadpoolArgs, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.threadpool_args))},
+      {dnnl::provider_option_names::kPrimitiveCacheCapacity, MakeStringWithClassicLocale(info.primitive_cache_capacity)},
   };
 
   return options;
@@ -10,6 +10,7 @@ namespace onnxruntime {
 struct DnnlExecutionProviderInfo {
   int use_arena{true};             // If arena is used, use_arena 0 = not used, nonzero = used
   void* threadpool_args{nullptr};  // Used to enable ORT threadpool when using the test runner
+  int primitive_cache_capacity{1};  // Number of input shapes whose primitives are kept compiled per dynamic subgraph
 
   static DnnlExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const DnnlExecutionProviderInfo& info);
@@ -0,0 +1,65 @@
+// Copyright(C) 2022 Intel Corporation
+// Licensed under the MIT License
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/dnnl/dnnl_profiler.h"
+
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace onnxruntime {
+namespace profiling {
+
+bool DnnlProfiler::StartProfiling(TimePoint /*profiling_start_time*/) {
+  start_counts_.clear();
+  for (const auto& [name, subgraph_primitive] : subgraph_primitives_) {
+    std::lock_guard<std::mutex> lock(subgraph_primitive->GetMutex());
+    start_counts_[name] = {subgraph_primitive->GetPrimitiveCacheHits(), subgraph_primitive->GetPrimitiveCacheMisses()};
+  }
+
+  return true;
+}
+
+void DnnlProfiler::EndProfiling(TimePoint start_time, Events& events) {
+  const auto time_stamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::high_resolution_clock::now() - start_time)
+                              .count();
+
+  for (const auto& [name, subgraph_primitive] : subgraph_primitives_) {
+    size_t hits = 0;
+    size_t misses = 0;
+    {
+      std::lock_guard<std::mutex> lock(subgraph_primitive->GetMutex());
+      hits = subgraph_primitive->GetPrimitiveCacheHits();
+      misses = subgraph_primitive->GetPrimitiveCacheMisses();
+    }
+
+    if (auto it = start_counts_.find(name); it != start_counts_.end()) {
+      hits -= it->second.first;
+      misses -= it->second.second;
+    }
+
+    if (hits + misses == 0) {
+      continue;
+    }
+
+    std::ostringstream hit_rate;
+    hit_rate << std::fixed << std::setprecision(3) << static_cast<double>(hits) / static_cast<double>(hits + misses);
+
+    events.emplace_back(EventCategory::SESSION_EVENT,
+                        static_cast<int>(logging::GetProcessId()),
+                        static_cast<int>(logging::GetThreadId()),
+                        name + "_primitive_cache",
+                        time_stamp,
+                        0,
+                        std::unordered_map<std::string, std::string>{
+                            {"hits", std::to_string(hits)},
+                            {"misses", std::to_string(misses)},
+                            {"hit_rate", hit_rate.str()},
+                        });
+  }
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright(C) 2022 Intel Corporation
+// Licensed under the MIT License
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/common/profiler_common.h"
+#include "core/providers/dnnl/subgraph/dnnl_subgraph_primitive.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+// Reports the primitive cache hits and misses of each subgraph since profiling started when it ends.
+class DnnlProfiler final : public EpProfiler {
+ public:
+  using SubgraphPrimitives = std::unordered_map<std::string, std::unique_ptr<ort_dnnl::DnnlSubgraphPrimitive>>;
+
+  explicit DnnlProfiler(const SubgraphPrimitives& subgraph_primitives) : subgraph_primitives_(subgraph_primitives) {}
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DnnlProfiler);
+  ~DnnlProfiler() override = default;
+
+  bool StartProfiling(TimePoint profiling_start_time) override;
+  void EndProfiling(TimePoint start_time, Events& events) override;
+
+ private:
+  const SubgraphPrimitives& subgraph_primitives_;
+  // The primitive cache hits and misses of each subgraph when profiling started.
+  std::unordered_map<std::string, std::pair<size_t, size_t>> start_counts_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
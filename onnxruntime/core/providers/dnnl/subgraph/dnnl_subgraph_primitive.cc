@@ -37,6 +37,7 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -240,7 +241,8 @@ void DnnlSubgraphPrimitive::AddKernels() {
   }
 }
 
-DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph) {
+DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t primitive_cache_capacity)
+    : primitive_cache_capacity_(std::max<size_t>(primitive_cache_capacity, 1)) {
   subgraph_ = &dnnl_subgraph;
   if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)) {
     cpu_engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
@@ -262,11 +264,14 @@ bool DnnlSubgraphPrimitive::IsScalar(const DnnlTensor& tensor) {
 void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTensorData>& inputs) {
   // if already compiled once and is not dynamic, then don't compile again
   if (!shape_key_.empty() && !IsDynamic()) {
+    ++primitive_cache_hits_;
     return;
   }
 
   std::string key;
   for (auto input : inputs) {
+    key += std::to_string(input.second.tensor_info.data_type);
+    key += ":";
     for (auto dim : input.second.tensor_info.shape) {
       std::ostringstream o;
       o << dim;
@@ -275,12 +280,37 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     }
     key += "|";
   }
-  // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  // the primitives of the current shape key are compiled already
+  if (key == shape_key_) {
+    ++primitive_cache_hits_;
+    return;
+  }
+
+  // keep the primitives of the previous shape key, so they don't need to be compiled again if it comes back
+  if (!shape_key_.empty() && primitive_cache_capacity_ > 1) {
+    CompiledState state;
+    SaveCompiledState(state);
+    compiled_states_.emplace_front(std::move(shape_key_), std::move(state));
+  }
+
+  shape_key_ = key;
+
+  auto cached = std::find_if(compiled_states_.begin(), compiled_states_.end(),
+                             [&key](const auto& entry) { return entry.first == key; });
+  if (cached != compiled_states_.end()) {
+    RestoreCompiledState(cached->second);
+    compiled_states_.erase(cached);
+    ++primitive_cache_hits_;
     return;
   }
+
+  ++primitive_cache_misses_;
+
+  // evict the least recently used shape keys, the current one included in the capacity
+  while (!compiled_states_.empty() && compiled_states_.size() + 1 > primitive_cache_capacity_) {
+    compiled_states_.pop_back();
+  }
+
   if (IsDynamic()) {
     LOGS_DEFAULT(INFO) << "Dynamic Compile";
   } else {
@@ -288,6 +318,7 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   }
 
   inputs_.clear();
+  input_is_scalar_.clear();
   intermediates_.clear();
   outputs_.clear();
   outputs_are_always_copied_.clear();
@@ -297,6 +328,7 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   net_args_.clear();
   reshapes_.clear();
   scalar_outputs_.clear();
+  items_to_print_.clear();
   // initializer should not be cleared upon recompile
   // initializers_.clear();
 
@@ -321,6 +353,36 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   AddOutputs();
 }
 
+void DnnlSubgraphPrimitive::SaveCompiledState(CompiledState& state) {
+  state.intermediates = std::move(intermediates_);
+  state.inputs = std::move(inputs_);
+  state.inputs_md = std::move(inputs_md_);
+  state.input_is_scalar = std::move(input_is_scalar_);
+  state.outputs = std::move(outputs_);
+  state.outputs_md = std::move(outputs_md_);
+  state.outputs_are_always_copied = std::move(outputs_are_always_copied_);
+  state.net = std::move(net_);
+  state.net_args = std::move(net_args_);
+  state.reshapes = std::move(reshapes_);
+  state.scalar_outputs = std::move(scalar_outputs_);
+  state.items_to_print = std::move(items_to_print_);
+}
+
+void DnnlSubgraphPrimitive::RestoreCompiledState(CompiledState& state) {
+  intermediates_ = std::move(state.intermediates);
+  inputs_ = std::move(state.inputs);
+  inputs_md_ = std::move(state.inputs_md);
+  input_is_scalar_ = std::move(state.input_is_scalar);
+  outputs_ = std::move(state.outputs);
+  outputs_md_ = std::move(state.outputs_md);
+  outputs_are_always_copied_ = std::move(state.outputs_are_always_copied);
+  net_ = std::move(state.net);
+  net_args_ = std::move(state.net_args);
+  reshapes_ = std::move(state.reshapes);
+  scalar_outputs_ = std::move(state.scalar_outputs);
+  items_to_print_ = std::move(state.items_to_print);
+}
+
 dnnl::memory::format_tag DnnlSubgraphPrimitive::GetDnnlFormat(size_t dim_size) {
   dnnl::memory::format_tag source_format = dnnl::memory::format_tag::any;
   switch (dim_size) {
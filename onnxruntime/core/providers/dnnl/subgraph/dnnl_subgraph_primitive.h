@@ -4,6 +4,7 @@
 #pragma once
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
+#include <list>
 #include <mutex>
 
 namespace onnxruntime {
@@ -22,7 +23,8 @@ struct OnnxTensorData {
 
 class DnnlSubgraphPrimitive {
  public:
-  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph);
+  // primitive_cache_capacity is the number of input shapes of a dynamic subgraph whose primitives are kept compiled
+  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t primitive_cache_capacity = 1);
   ~DnnlSubgraphPrimitive() = default;
 
   // compile subgraph primitive with runtime input information
@@ -71,6 +73,11 @@ class DnnlSubgraphPrimitive {
   bool IsScalar(const DnnlTensor& tensor);
   std::mutex& GetMutex() { return mutex_; }
 
+  // The number of Compile calls whose input shapes had compiled primitives, and of the ones that compiled them.
+  // Requires the mutex.
+  size_t GetPrimitiveCacheHits() const { return primitive_cache_hits_; }
+  size_t GetPrimitiveCacheMisses() const { return primitive_cache_misses_; }
+
   // GetMemory in OrtFormat if the memory is not in the OrtFormat this will reorder the memory.
   // All memory will be moved to the dnnl_engine even if it is already in OrtFormat.
   dnnl::memory GetMemoryInOrtFormat(const DnnlTensor& tensor, const dnnl::engine& eng);
@@ -96,8 +103,35 @@ class DnnlSubgraphPrimitive {
   }
 
  private:
+  // The primitives and memories compiled for the input shapes of a shape key.
+  // The initializers are not part of it, so their reordered memories are shared by all the shapes.
+  struct CompiledState {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_set<std::string> input_is_scalar;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+    std::vector<std::pair<int, int>> items_to_print;
+  };
+
+  // Moves the compiled primitives and memories of the current shape key to state, and back.
+  void SaveCompiledState(CompiledState& state);
+  void RestoreCompiledState(CompiledState& state);
+
   std::string shape_key_;
 
+  // The compiled states of the previous shape keys of a dynamic subgraph, most recently used first.
+  size_t primitive_cache_capacity_;
+  std::list<std::pair<std::string, CompiledState>> compiled_states_;
+  size_t primitive_cache_hits_ = 0;
+  size_t primitive_cache_misses_ = 0;
+
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
   std::unordered_map<std::string, dnnl::memory> inputs_;
@@ -12,12 +12,16 @@
 #include "core/session/onnxruntime_cxx_api.h"
 #include "core/common/safeint.h"
 #include "core/common/logging/severity.h"
+#include "core/framework/murmurhash3.h"
 #include "migraphx_execution_provider.h"
 #include "migraphx_execution_provider_utils.h"
 #include "migraphx_allocator.h"
 #include "gpu_data_transfer.h"
 #include "migraphx_inc.h"
 #include <hip/hip_version.h>
+#if __has_include(<migraphx/version.h>)
+#include <migraphx/version.h>
+#endif
 
 #include "migraphx_stream_handle.h"
 
@@ -190,6 +194,16 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
     exhaustive_tune_ = (std::stoi(exhaustive_tune_env) == 0 ? false : true);
   }
 
+  // Number of programs compiled for different input shapes kept per fused node
+  const std::string max_cached_programs_env = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kMaxCachedPrograms);
+  if (!max_cached_programs_env.empty()) {
+    max_cached_programs_ = static_cast<size_t>(std::max(std::stoi(max_cached_programs_env), 1));
+  }
+
+  hipDeviceProp_t device_prop;
+  HIP_CALL_THROW(hipGetDeviceProperties(&device_prop, info_.device_id));
+  gpu_arch_ = device_prop.gcnArchName;
+
   metadef_id_generator_ = ModelMetadefIdGenerator::Create();
 
   LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] MIGraphX provider options: "
@@ -199,6 +213,7 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
                         << ", migraphx_int8_enable: " << int8_enable_
                         << ", dump_model_ops: " << dump_model_ops_
                         << ", exhaustive_tune: " << exhaustive_tune_
+                        << ", max_cached_programs: " << max_cached_programs_
                         << ", migraphx_int8_calibration_cache_name: " << int8_calibration_cache_name_
                         << ", int8_calibration_cache_available: " << int8_calibration_cache_available_
                         << ", use_native_migraphx_calibration_table: " << int8_use_native_migraphx_calibration_table_
@@ -1122,6 +1137,80 @@ void save_compiled_model(migraphx::program& prog, bool save_enable, std::string
   }
 }
 
+// Returns whether the parameter shapes of the program match the shapes of the inputs. The shapes of the mismatched
+// inputs are set in the parse options if given, to compile a program for them.
+static bool InputShapesMatch(migraphx::program& prog, Ort::KernelContext& ctx,
+                             std::unordered_map<std::string, std::size_t>& map_input_name_index,
+                             migraphx::onnx_options* cmp_options) {
+  bool input_shape_match = true;
+  auto param_shapes = prog.get_parameter_shapes();
+  if (param_shapes.size() > 0) {
+    for (auto&& name : param_shapes.names()) {
+      if (map_input_name_index.count(name) > 0) {
+        auto input_tensor = ctx.GetInput(map_input_name_index[name]);
+        auto tensor_info = input_tensor.GetTensorTypeAndShapeInfo();
+        const auto tensor_shape = tensor_info.GetShape();
+        std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
+
+        auto mgx_s = param_shapes[name];
+        auto mgx_lens = mgx_s.lengths();
+        auto mgx_strides = mgx_s.strides();
+        if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
+            mgx_strides.size() == 1 and mgx_strides[0] == 0) {
+          mgx_lens.clear();
+        }
+
+        if (mgx_lens != ort_lens) {
+          if (cmp_options == nullptr) {
+            return false;
+          }
+          cmp_options->set_input_parameter_shape(name, ort_lens);
+          input_shape_match = false;
+        }
+      }
+    }
+  }
+  return input_shape_match;
+}
+
+// Returns the path of the program compiled for the current input shapes, next to the given path. The file name is
+// keyed by the model, the input shapes, the GPU architecture and the MIGraphX version, so that a program saved by
+// another process is only loaded where it is valid.
+static std::string GetCompiledProgramPath(const std::string& path, const std::string& onnx_string,
+                                          const std::string& gpu_arch, Ort::KernelContext& ctx,
+                                          const std::unordered_map<std::string, std::size_t>& map_input_name_index) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto hash_str = [&hash](const std::string& str) {
+    MurmurHash3::x86_128(str.data(), str.size(), hash[0], &hash);
+  };
+
+  hash_str(onnx_string);
+  hash_str(gpu_arch);
+#ifdef MIGRAPHX_VERSION_MAJOR
+  hash_str(std::to_string(MIGRAPHX_VERSION_MAJOR) + "." + std::to_string(MIGRAPHX_VERSION_MINOR) + "." +
+           std::to_string(MIGRAPHX_VERSION_PATCH));
+#endif
+
+  std::vector<std::pair<std::size_t, std::string>> inputs;
+  for (const auto& [name, index] : map_input_name_index) {
+    inputs.emplace_back(index, name);
+  }
+  std::sort(inputs.begin(), inputs.end());
+  for (const auto& [index, name] : inputs) {
+    std::string shape_str = name;
+    for (auto dim : ctx.GetInput(index).GetTensorTypeAndShapeInfo().GetShape()) {
+      shape_str += "_" + std::to_string(dim);
+    }
+    hash_str(shape_str);
+  }
+
+  const uint64_t program_hash = hash[0] | (uint64_t(hash[1]) << 32);
+  std::filesystem::path program_path{path};
+  program_path.replace_filename(program_path.stem().string() + "_" + std::to_string(program_hash) +
+                                program_path.extension().string());
+  return program_path.string();
+}
+
 Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes,
                                           std::vector<NodeComputeInfo>& node_compute_funcs) {
   migraphx::onnx_options options;
@@ -1225,6 +1314,9 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
             int8_calibration_cache_available_, dynamic_range_map_,
             save_compiled_model_, save_compiled_path_,
             load_compiled_model_, load_compiled_path_, dump_model_ops_};
+      if (!p->no_input_shape) {
+        p->cached_progs.push_front(p->prog);
+      }
       *state = p.release();
       return 0;
     };
@@ -1268,39 +1360,42 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
       } else {
         LOGS_DEFAULT(VERBOSE) << "Assigning inputs, and parameters from compiled model" << std::endl;
         param_shapes = prog.get_parameter_shapes();
-        auto prog_output_shapes = prog.get_output_shapes();
 
         // check whether input shapes match with shapes of program inputs
-        // migraphx::onnx_options cmp_options;
-        if (param_shapes.size() > 0) {
-          for (auto&& name : param_shapes.names()) {
-            if (map_input_name_index.count(name) > 0) {
-              auto input_tensor = ctx.GetInput(map_input_name_index[name]);
-              auto tensor_info = input_tensor.GetTensorTypeAndShapeInfo();
-              const auto tensor_shape = tensor_info.GetShape();
-              std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
-
-              auto mgx_s = param_shapes[name];
-              auto mgx_lens = mgx_s.lengths();
-              auto mgx_strides = mgx_s.strides();
-              if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
-                  mgx_strides.size() == 1 and mgx_strides[0] == 0) {
-                mgx_lens.clear();
-              }
+        input_shape_match = InputShapesMatch(prog, ctx, map_input_name_index, &cmp_options);
+      }
 
-              if (mgx_lens != ort_lens) {
-                cmp_options.set_input_parameter_shape(name, ort_lens);
-                input_shape_match = false;
-              }
-            }
-          }
+      // input shapes are different, reuse a program compiled for them before
+      // or re-parse onnx and re-compile the program
+      bool cached_prog_found = false;
+      if (!input_shape_match) {
+        std::lock_guard<std::mutex> lock(*(mgx_state->mgx_mu_ptr));
+        auto& cached_progs = mgx_state->cached_progs;
+        auto it = std::find_if(cached_progs.begin(), cached_progs.end(), [&](migraphx::program& cached_prog) {
+          return InputShapesMatch(cached_prog, ctx, map_input_name_index, nullptr);
+        });
+        if (it != cached_progs.end()) {
+          LOGS_DEFAULT(VERBOSE) << "Input shape mismatch detected. Using the program compiled for the input shapes" << std::endl;
+          cached_progs.splice(cached_progs.begin(), cached_progs, it);
+          prog = cached_progs.front();
+          param_shapes = prog.get_parameter_shapes();
+          no_input_shape = false;
+          cached_prog_found = true;
         }
       }
 
-      // input shapes are different, needs to re-parse onnx and
-      // re-compile the program
-      if (!input_shape_match) {
-        if (!load_precompiled_model(prog, load_compiled_model_, std::string{load_compiled_path_})) {
+      if (!input_shape_match && !cached_prog_found) {
+        // the current program may come from the cache, so set the shapes of all the inputs
+        for (auto& [name, index] : map_input_name_index) {
+          const auto tensor_shape = ctx.GetInput(index).GetTensorTypeAndShapeInfo().GetShape();
+          cmp_options.set_input_parameter_shape(name, std::vector<std::size_t>(tensor_shape.begin(), tensor_shape.end()));
+        }
+
+        const std::string load_program_path = load_compiled_model_
+                                                  ? GetCompiledProgramPath(load_compiled_path_, onnx_string, gpu_arch_,
+                                                                           ctx, map_input_name_index)
+                                                  : std::string{};
+        if (!load_precompiled_model(prog, load_compiled_model_, load_program_path)) {
           LOGS_DEFAULT(VERBOSE) << "Input shape mismatch detected. Recompiling" << std::endl;
 #ifndef ENABLE_TRAINING_CORE
 #if HIP_VERSION_MAJOR > 6 || (HIP_VERSION_MAJOR == 6 && HIP_VERSION_MINOR >= 2)
@@ -1363,12 +1458,22 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
           co.set_exhaustive_tune_flag(exhaustive_tune_);
           prog.compile(t, co);
 
-          save_compiled_model(prog, mgx_state->save_compiled_mode, mgx_state->save_compiled_path);
+          if (mgx_state->save_compiled_mode) {
+            save_compiled_model(prog, true,
+                                GetCompiledProgramPath(mgx_state->save_compiled_path, onnx_string, gpu_arch_,
+                                                       ctx, map_input_name_index));
+          }
         }
 
         mgx_state->prog = prog;
         param_shapes = prog.get_parameter_shapes();
         no_input_shape = false;
+
+        std::lock_guard<std::mutex> lock(*(mgx_state->mgx_mu_ptr));
+        mgx_state->cached_progs.push_front(prog);
+        if (mgx_state->cached_progs.size() > max_cached_programs_) {
+          mgx_state->cached_progs.pop_back();
+        }
       }
 
       migraphx::program_parameters m;
@@ -9,6 +9,7 @@
 #include "core/providers/migraphx/migraphx_execution_provider_info.h"
 #include "core/providers/migraphx/migraphx_inc.h"
 
+#include <list>
 #include <map>
 #include <unordered_map>
 #include <filesystem>
@@ -27,6 +28,7 @@ static const char kSavedModelPath[] = "ORT_MIGRAPHX_SAVE_COMPILE_PATH";
 static const char kLoadCompiledModel[] = "ORT_MIGRAPHX_LOAD_COMPILED_MODEL";
 static const char kLoadModelPath[] = "ORT_MIGRAPHX_LOAD_COMPILE_PATH";
 static const char kExhaustiveTune[] = "ORT_MIGRAPHX_EXHAUSTIVE_TUNE";
+static const char kMaxCachedPrograms[] = "ORT_MIGRAPHX_MAX_CACHED_PROGRAMS";
 
 };  // namespace migraphx_env_vars
 
@@ -52,6 +54,8 @@ struct MIGraphXFuncState {
   std::string load_compiled_path;
   bool dump_model_ops = false;
   bool exhaustive_tune = false;
+  // programs compiled for the input shapes seen so far, the most recently used first
+  std::list<migraphx::program> cached_progs;
 };
 
 // Logical device representation.
@@ -106,6 +110,8 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
   std::mutex mgx_mu_;
   hipStream_t stream_ = nullptr;
   bool exhaustive_tune_ = false;
+  size_t max_cached_programs_ = 1;
+  std::string gpu_arch_;
   mutable std::filesystem::path model_path_;
 
   std::unordered_map<std::string, migraphx::program> map_progs_;
@@ -1,6 +1,7 @@
 // Copyright (C) Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -125,7 +126,18 @@ BasicBackend::BasicBackend(std::unique_ptr<ONNX_NAMESPACE::ModelProto>& model_pr
     ORT_THROW(msg);
   }
 
-  int num_infer_req = (session_context_.num_of_threads > 0) ? session_context_.num_of_threads : 1;
+  // Without an explicit number of threads, size the pool for the parallelism the compiled model reports,
+  // which is more than one request with the THROUGHPUT performance hint.
+  uint32_t num_infer_req = session_context_.num_of_threads;
+  if (num_infer_req == 0) {
+    try {
+      num_infer_req = exe_network_.Get().get_property(ov::optimal_number_of_infer_requests);
+    } catch (const std::exception&) {
+      num_infer_req = 1;
+    }
+    num_infer_req = std::max(num_infer_req, 1u);
+  }
+  LOGS_DEFAULT(INFO) << log_tag << "Number of infer requests in the pool: " << num_infer_req;
   std::function<void(OVInferRequestPtr)> initializer = [](OVInferRequestPtr) {};
   auto metadata = shared_context_.shared_weights.metadata;
   if (session_context_.so_share_ep_contexts) {
@@ -401,8 +413,18 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
           ORT_THROW(msg);
         }
       } else {
-        if ((session_context_.device_type.find("CPU") != std::string::npos ||
-             session_context_.device_type.find("GPU") != std::string::npos)) {
+        if (session_context_.device_type.find("CPU") != std::string::npos) {
+          // avoid input copies on the CPU device, the infer request reads the ORT buffer directly
+          auto tensor = context.GetInput(subgraph_context_.input_names.at(input_name));
+          const auto& input = ov_input_info.at(input_idx);
+          OVTensorPtr tensor_ptr = std::make_shared<ov::Tensor>(input.get_element_type(), input.get_shape(),
+                                                                const_cast<void*>(tensor.GetTensorRawData()));
+          try {
+            infer_request->SetTensor(std::move(input_name), tensor_ptr);
+          } catch (const char* msg) {
+            ORT_THROW(msg);
+          }
+        } else if (session_context_.device_type.find("GPU") != std::string::npos) {
           OVTensorPtr graph_input_blob;
           try {
             graph_input_blob = infer_request->GetTensor(input_name);
@@ -412,7 +434,8 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
           FillInputBlob(std::move(graph_input_blob), batch_slice_idx, std::move(input_name), context, subgraph_context_);
         } else {
           auto tensor = context.GetInput(subgraph_context_.input_names.at(input_name));
-          ort_tensor_key_t ort_tensor_key{input_name};
+          ort_tensor_key_t ort_tensor_key{infer_request.get(), input_name};
+          std::unique_lock<std::mutex> lock(ort_ov_tensor_map_mutex_);
           auto it = ort_ov_tensor_map.find(ort_tensor_key);
           if ((it == ort_ov_tensor_map.end()) ||
               (it != ort_ov_tensor_map.end() && (it->second.ort_ptr != tensor.GetTensorRawData()))) {
@@ -423,6 +446,7 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
 
             ov_tensor_data.ort_ptr = tensor.GetTensorRawData();
             ort_ov_tensor_map[ort_tensor_key] = ov_tensor_data;
+            lock.unlock();
 
             try {
               infer_request->SetTensor(std::move(input_name), ov_tensor_data.tensor_ptr);
@@ -434,12 +458,19 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
       }
     }  // Loop subgraph original input names
 
-    if (session_context_.device_type.find("NPU") != std::string::npos) {
+    // On the CPU device the outputs of static shape are also written directly into the ORT buffers
+    const bool bind_cpu_outputs = session_context_.device_type.find("CPU") != std::string::npos &&
+                                  !subgraph_context_.has_dynamic_input_shape;
+    if (session_context_.device_type.find("NPU") != std::string::npos || bind_cpu_outputs) {
       // Set the output blob as remote blob
       auto graph_output_info = exe_network_.Get().outputs();
       auto output_idx = 0;
       for (auto output_info_iter = graph_output_info.begin();
            output_info_iter != graph_output_info.end(); ++output_info_iter) {
+        if (bind_cpu_outputs && output_info_iter->get_partial_shape().is_dynamic()) {
+          output_idx++;
+          continue;
+        }
         auto output_names = output_info_iter->get_names();
         std::string onnx_output_name;
         std::string output_name;
@@ -458,7 +489,8 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
                                                    infer_request,
                                                    output_name,
                                                    subgraph_context_.output_names);
-        ort_tensor_key_t ort_tensor_key{output_name};
+        ort_tensor_key_t ort_tensor_key{infer_request.get(), output_name};
+        std::unique_lock<std::mutex> lock(ort_ov_tensor_map_mutex_);
         const auto& it = ort_ov_tensor_map.find(ort_tensor_key);
         if ((it == ort_ov_tensor_map.end()) ||
             (it != ort_ov_tensor_map.end() && (it->second.ort_ptr != tensor.GetTensorRawData()))) {
@@ -468,6 +500,7 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
           ov_tensor_data.tensor_ptr = std::make_shared<ov::Tensor>(output.get_element_type(), output.get_shape(),
                                                                    const_cast<void*>(tensor.GetTensorRawData()));
           ort_ov_tensor_map[ort_tensor_key] = ov_tensor_data;
+          lock.unlock();
 
           try {
             infer_request->SetTensor(std::move(output_name), ov_tensor_data.tensor_ptr);
@@ -641,7 +674,7 @@ void BasicBackend::CompleteAsyncInference(Ort::KernelContext& context, OVInferRe
         auto mem_info = output_tensor.GetTensorMemoryInfo();
         if (mem_info.GetAllocatorName() == OpenVINO_GPU) {
           return;
-        } else {
+        } else if (graph_output_blob->data() != output_tensor.GetTensorRawData()) {
           size_t batch_slice = 0;
           FillOutputBlob(std::move(graph_output_blob), output_tensor, batch_slice);
         }
@@ -13,6 +13,7 @@
 #include <mutex>
 #include <map>
 #include <functional>
+#include <utility>
 
 #include "core/session/onnxruntime_cxx_api.h"
 #include "core/providers/openvino/contexts.h"
@@ -69,8 +70,10 @@ class BasicBackend : public IBackend {
   OVRemoteContextPtr remote_context_;
 #endif
 
-  using ort_tensor_key_t = const std::string;
+  // The ORT buffers bound to the tensors of each infer request of the pool, which Infer calls share concurrently
+  using ort_tensor_key_t = std::pair<const OVInferRequest*, std::string>;
   std::map<ort_tensor_key_t, ov_tensor_data_t> ort_ov_tensor_map;
+  std::mutex ort_ov_tensor_map_mutex_;
 };
 
 class InferRequestsQueue {
@@ -86,21 +86,15 @@ Status CreateNodeArgs(const std::vector<std::string>& names,
   return Status::OK();
 }
 
-Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
-                                const onnxruntime::PathString& ctx_onnx_model_path,
-                                QnnBackendManager* qnn_backend_manager,
-                                QnnModelLookupTable& qnn_models,
-                                int64_t max_spill_fill_size) {
+Status ReadEpContextBinary(const onnxruntime::Node& main_context_node,
+                           const onnxruntime::PathString& ctx_onnx_model_path,
+                           std::string& context_binary) {
   ORT_RETURN_IF_NOT(EPCONTEXT_OP == main_context_node.OpType(), "Should only filter in the EPContext node.");
   NodeAttrHelper node_helper(main_context_node);
   bool is_embed_mode = node_helper.Get(EMBED_MODE, true);
   if (is_embed_mode) {
-    const std::string& context_binary = node_helper.Get(EP_CACHE_CONTEXT, "");
-    return qnn_backend_manager->LoadCachedQnnContextFromBuffer(const_cast<char*>(context_binary.c_str()),
-                                                               static_cast<uint64_t>(context_binary.length()),
-                                                               main_context_node.Name(),
-                                                               qnn_models,
-                                                               max_spill_fill_size);
+    context_binary = node_helper.Get(EP_CACHE_CONTEXT, "");
+    return Status::OK();
   }
 
   std::filesystem::path folder_path = std::filesystem::path(ctx_onnx_model_path).parent_path();
@@ -140,14 +134,35 @@ Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
   ORT_RETURN_IF(0 == buffer_size, "Empty cache file encountered.");
 
   cache_file.seekg(0, cache_file.beg);
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(buffer_size);
-  ORT_RETURN_IF(nullptr == buffer, "Failed to allocate memory for cache file.");
+  context_binary.resize(buffer_size);
   // Load file into buffer
-  const auto& read_result = cache_file.read(buffer.get(), buffer_size);
+  const auto& read_result = cache_file.read(context_binary.data(), buffer_size);
   ORT_RETURN_IF(!read_result, "Failed to read contents from cached context file.");
   cache_file.close();
-  return qnn_backend_manager->LoadCachedQnnContextFromBuffer(buffer.get(),
-                                                             static_cast<uint64_t>(buffer_size),
+  return Status::OK();
+}
+
+Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
+                                const onnxruntime::PathString& ctx_onnx_model_path,
+                                QnnBackendManager* qnn_backend_manager,
+                                QnnModelLookupTable& qnn_models,
+                                int64_t max_spill_fill_size) {
+  ORT_RETURN_IF_NOT(EPCONTEXT_OP == main_context_node.OpType(), "Should only filter in the EPContext node.");
+  NodeAttrHelper node_helper(main_context_node);
+  bool is_embed_mode = node_helper.Get(EMBED_MODE, true);
+  if (is_embed_mode) {
+    const std::string& context_binary = node_helper.Get(EP_CACHE_CONTEXT, "");
+    return qnn_backend_manager->LoadCachedQnnContextFromBuffer(const_cast<char*>(context_binary.c_str()),
+                                                               static_cast<uint64_t>(context_binary.length()),
+                                                               main_context_node.Name(),
+                                                               qnn_models,
+                                                               max_spill_fill_size);
+  }
+
+  std::string context_binary;
+  ORT_RETURN_IF_ERROR(ReadEpContextBinary(main_context_node, ctx_onnx_model_path, context_binary));
+  return qnn_backend_manager->LoadCachedQnnContextFromBuffer(context_binary.data(),
+                                                             static_cast<uint64_t>(context_binary.size()),
                                                              main_context_node.Name(),
                                                              qnn_models,
                                                              max_spill_fill_size);
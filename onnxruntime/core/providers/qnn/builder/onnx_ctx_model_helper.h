@@ -38,6 +38,11 @@ Status CreateNodeArgs(const std::vector<std::string>& names,
                       std::vector<NodeArg*>& node_args,
                       onnxruntime::Graph& graph);
 
+// Reads the QNN context binary of the main EPContext node, from the node in embed mode or from the external file.
+Status ReadEpContextBinary(const onnxruntime::Node& main_context_node,
+                           const onnxruntime::PathString& ctx_onnx_model_path,
+                           std::string& context_binary);
+
 Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
                                 const onnxruntime::PathString& ctx_onnx_model_path,
                                 QnnBackendManager* qnn_backend_manager,
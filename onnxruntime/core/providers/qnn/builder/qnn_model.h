@@ -102,6 +102,10 @@ class QnnModel {
 
   const std::string& Name() const { return graph_info_->Name(); }
 
+  // Moves the QNN graph that was deserialized into other from a context binary to this model. Used when the context is
+  // loaded after the graph input and output info of this model was set, i.e. by the deferred context loading.
+  void TakeGraphInfo(QnnModel& other) { graph_info_ = std::move(other.graph_info_); }
+
  private:
   const NodeUnit& GetNodeUnit(const Node* node,
                               const std::unordered_map<const Node*, const NodeUnit*>& node_unit_map) const;
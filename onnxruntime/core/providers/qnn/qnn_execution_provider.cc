@@ -4,6 +4,7 @@
 #include "qnn_execution_provider.h"
 
 #include <filesystem>
+#include <future>
 #include <optional>
 #include <string_view>
 #include <unordered_set>
@@ -424,6 +425,28 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
   // Add this option because this feature requires QnnSystem lib and it's no supported for Windows x86_64 platform
   enable_spill_fill_buffer_ = ParseBoolOption("enable_htp_spill_fill_buffer", false, provider_options_map);
 
+  static const std::string QNN_CONTEXT_LOAD_MODE = "context_load_mode";
+  auto context_load_mode_pos = provider_options_map.find(QNN_CONTEXT_LOAD_MODE);
+  if (context_load_mode_pos != provider_options_map.end()) {
+    if ("eager" == context_load_mode_pos->second) {
+      context_load_mode_ = ContextLoadMode::kEager;
+    } else if ("lazy" == context_load_mode_pos->second) {
+      context_load_mode_ = ContextLoadMode::kLazy;
+    } else if ("background" == context_load_mode_pos->second) {
+      context_load_mode_ = ContextLoadMode::kBackground;
+    } else {
+      LOGS_DEFAULT(WARNING) << "Invalid context_load_mode: " << context_load_mode_pos->second
+                            << ", only eager, lazy or background allowed. Set to eager.";
+    }
+    LOGS_DEFAULT(VERBOSE) << "User specified context_load_mode: " << context_load_mode_pos->second;
+  }
+
+  if (context_load_mode_ != ContextLoadMode::kEager && share_ep_contexts_) {
+    // the QNN models of the graphs not used by this session are shared with the other sessions at Compile
+    LOGS_DEFAULT(WARNING) << "context_load_mode is ignored when EP contexts are shared across sessions. Set to eager.";
+    context_load_mode_ = ContextLoadMode::kEager;
+  }
+
   model_settings_.offload_graph_io_quantization = ParseBoolOption("offload_graph_io_quantization", true,
                                                                   provider_options_map);
 
@@ -529,6 +552,11 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
 }
 
 QNNExecutionProvider::~QNNExecutionProvider() {
+  // wait for the QNN contexts loading on a background thread, which uses the backend manager
+  if (deferred_context_load_ && deferred_context_load_->background_load.valid()) {
+    deferred_context_load_->background_load.wait();
+  }
+
   // clean up thread local context caches
   std::lock_guard<std::mutex> lock(context_state_.mutex);
   for (const auto& cache_weak : context_state_.caches_to_update_on_destruction) {
@@ -908,7 +936,11 @@ Status QNNExecutionProvider::CreateComputeFunc(std::vector<NodeComputeInfo>& nod
     ORT_UNUSED_PARAMETER(state);
   };
 
-  compute_info.compute_func = [&logger](FunctionState state, const OrtApi*, OrtKernelContext* context) {
+  compute_info.compute_func = [this, &logger](FunctionState state, const OrtApi*, OrtKernelContext* context) {
+    if (deferred_context_load_) {
+      ORT_RETURN_IF_ERROR(FinishContextLoad(logger));
+    }
+
     Ort::KernelContext ctx(context);
     qnn::QnnModel* model = reinterpret_cast<qnn::QnnModel*>(state);
     Status result = model->ExecuteGraph(ctx, logger);
@@ -989,6 +1021,99 @@ Status QNNExecutionProvider::CompileFromOrtGraph(const std::vector<FusedNodeAndG
   return Status::OK();
 }
 
+Status QNNExecutionProvider::DeferContextLoad(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                                              const std::vector<int>& main_context_pos_list,
+                                              const onnxruntime::PathString& context_model_path,
+                                              int64_t max_spill_fill_size,
+                                              std::vector<NodeComputeInfo>& node_compute_funcs,
+                                              const logging::Logger& logger) {
+  ORT_RETURN_IF(deferred_context_load_ != nullptr, "The QNN contexts of an EPContext model are already deferred.");
+  auto deferred = std::make_unique<DeferredContextLoad>();
+
+  // Read the context binaries now, the EPContext nodes are only valid during Compile.
+  // <main EPContext node name, context binary>
+  auto context_binaries = std::make_shared<std::vector<std::pair<std::string, std::string>>>();
+  for (auto main_context_pos : main_context_pos_list) {
+    const onnxruntime::GraphViewer& main_ctx_graph_viewer(fused_nodes_and_graphs[main_context_pos].filtered_graph);
+    const Node& main_context_node = *main_ctx_graph_viewer.Nodes().begin();
+    std::string context_binary;
+    Status status = qnn::ReadEpContextBinary(main_context_node, context_model_path, context_binary);
+    // This is the protocol with customer that status with INVALID_GRAPH will be generated if failed to load context model
+    if (!status.IsOK()) {
+      LOGS(logger, ERROR) << "Failed to load from EpContext model. " << status.ErrorMessage();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "Failed to load from EpContext model. ", status.ErrorMessage());
+    }
+
+    context_binaries->emplace_back(main_context_node.Name(), std::move(context_binary));
+  }
+
+  // The QNN models of the fused nodes get their graph input and output info now, and their QNN graph from the
+  // models deserialized from the contexts once they are loaded.
+  for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+    const onnxruntime::GraphViewer& graph_viewer(fused_node_and_graph.filtered_graph);
+    const Node& ep_context_node = *graph_viewer.Nodes().begin();
+    const Node& fused_node = fused_node_and_graph.fused_node;
+    auto qnn_model = std::make_unique<qnn::QnnModel>(qnn_backend_manager_.get());
+    ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(graph_viewer, fused_node, logger));
+
+    deferred->models.emplace_back(ep_context_node.Name(), qnn_model.get());
+    qnn_models_.emplace(fused_node.Name(), std::move(qnn_model));
+
+    ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+  }
+
+  deferred->load = [this, context_binaries, max_spill_fill_size,
+                    &loaded_models = deferred->loaded_models, &logger]() -> Status {
+    for (auto& [node_name, context_binary] : *context_binaries) {
+      Status status = qnn_backend_manager_->LoadCachedQnnContextFromBuffer(context_binary.data(),
+                                                                           static_cast<uint64_t>(context_binary.size()),
+                                                                           node_name,
+                                                                           loaded_models,
+                                                                           max_spill_fill_size);
+      if (!status.IsOK()) {
+        LOGS(logger, ERROR) << "Failed to load from EpContext model. " << status.ErrorMessage();
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "Failed to load from EpContext model. ", status.ErrorMessage());
+      }
+    }
+
+    return Status::OK();
+  };
+
+  deferred_context_load_ = std::move(deferred);
+  if (context_load_mode_ == ContextLoadMode::kBackground) {
+    LOGS(logger, VERBOSE) << "Loading " << context_binaries->size() << " QNN context(s) on a background thread.";
+    deferred_context_load_->background_load = std::async(std::launch::async,
+                                                         [deferred = deferred_context_load_.get()]() {
+                                                           return deferred->load();
+                                                         });
+  }
+
+  return Status::OK();
+}
+
+Status QNNExecutionProvider::FinishContextLoad(const logging::Logger& logger) {
+  DeferredContextLoad& deferred = *deferred_context_load_;
+  std::call_once(deferred.once, [&deferred, &logger]() {
+    deferred.status = [&]() -> Status {
+      ORT_RETURN_IF_ERROR(deferred.background_load.valid() ? deferred.background_load.get() : deferred.load());
+      for (auto& [key, qnn_model] : deferred.models) {
+        auto it = deferred.loaded_models.find(key);
+        ORT_RETURN_IF(it == deferred.loaded_models.end(), key + " key name not exist in table qnn_models.");
+        qnn_model->TakeGraphInfo(*it->second);
+        ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput(logger));
+      }
+
+      return Status::OK();
+    }();
+
+    // release the context binaries and the QNN models of the graphs no fused node runs
+    deferred.load = nullptr;
+    deferred.loaded_models.clear();
+  });
+
+  return deferred.status;
+}
+
 // Figure out the context cache Onnx file path to decide the folder location
 static void GetContextOnnxModelFilePath(const std::string& customer_context_cache_path,
                                         const onnxruntime::PathString& model_path_string,
@@ -1054,6 +1179,11 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
                                                       max_spill_fill_size, main_context_pos_list));
     }
 
+    if (context_load_mode_ != ContextLoadMode::kEager) {
+      return DeferContextLoad(fused_nodes_and_graphs, main_context_pos_list, context_model_path, max_spill_fill_size,
+                              node_compute_funcs, logger);
+    }
+
     for (auto main_context_pos : main_context_pos_list) {
       const onnxruntime::GraphViewer& main_ctx_graph_viewer(fused_nodes_and_graphs[main_context_pos].filtered_graph);
       // Create QNN context from the cached binary, deserialize the QNN graph from the binary
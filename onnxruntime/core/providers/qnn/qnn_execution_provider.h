@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -64,6 +67,19 @@ class QNNExecutionProvider : public IExecutionProvider {
                              std::vector<NodeComputeInfo>& node_compute_funcs,
                              const logging::Logger& logger);
 
+  // Reads the QNN context binaries of an EPContext model and creates the compute functions of its fused nodes, and
+  // loads the contexts on a background thread or on the first Run, depending on context_load_mode_.
+  Status DeferContextLoad(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                          const std::vector<int>& main_context_pos_list,
+                          const onnxruntime::PathString& context_model_path,
+                          int64_t max_spill_fill_size,
+                          std::vector<NodeComputeInfo>& node_compute_funcs,
+                          const logging::Logger& logger);
+
+  // Waits for the deferred QNN contexts to be loaded, or loads them, and sets up the QNN models of the fused nodes.
+  // Only the first call does it, the other calls return its status.
+  Status FinishContextLoad(const logging::Logger& logger);
+
   void ParseHtpGraphFinalizationOptimizationMode(const std::string& htp_graph_finalization_opt_mode_string);
 
   void InitQnnGraphConfigs(qnn::QnnConfigsBuilder<QnnGraph_Config_t, QnnHtpGraph_CustomConfig_t>& configs_builder) const;
@@ -93,6 +109,28 @@ class QNNExecutionProvider : public IExecutionProvider {
   bool share_ep_contexts_ = false;
   bool stop_share_ep_contexts_ = false;
   bool enable_spill_fill_buffer_ = false;
+
+  // When the QNN contexts of an EPContext model are loaded: at Compile (eager), on the first Run (lazy), or on a
+  // background thread started at Compile that the first Run waits for (background).
+  enum class ContextLoadMode {
+    kEager,
+    kLazy,
+    kBackground,
+  };
+  ContextLoadMode context_load_mode_ = ContextLoadMode::kEager;
+
+  struct DeferredContextLoad {
+    std::once_flag once;
+    Status status;
+    // Loads the contexts into loaded_models.
+    std::function<Status()> load;
+    std::future<Status> background_load;
+    // Table<EPContext node name, QnnModel>
+    std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>> loaded_models;
+    // <EPContext node name, QnnModel of the fused node in qnn_models_>
+    std::vector<std::pair<std::string, qnn::QnnModel*>> models;
+  };
+  std::unique_ptr<DeferredContextLoad> deferred_context_load_;
 #if defined(_WIN32)
   onnxruntime::logging::EtwRegistrationManager::EtwInternalCallback callback_ETWSink_provider_ = nullptr;
 #endif
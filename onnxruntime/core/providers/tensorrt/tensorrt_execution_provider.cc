@@ -25,6 +25,8 @@
 #include <map>
 #include <memory>
 #include <filesystem>
+#include <atomic>
+#include <thread>
 // TODO: find a better way to share this
 #include "core/providers/cuda/cuda_stream_handle.h"
 
@@ -248,6 +250,55 @@ inline void saveTimingCacheFile(const std::string outFileName, const nvinfer1::I
   oFile.write((char*)blob->data(), blob->size());
   oFile.close();
 }
+
+// At most this many engines are built at the same time by a TRT EP instance, as each build uses its own GPU memory.
+constexpr size_t kMaxConcurrentEngineBuilds = 4;
+
+// An engine in the process-wide engine cache, with the runtime it was deserialized with, which must outlive it.
+struct SharedEngine {
+  std::shared_ptr<nvinfer1::IRuntime> runtime;
+  std::shared_ptr<nvinfer1::ICudaEngine> engine;
+};
+
+// The engines shared by the sessions of the process, by TensorrtExecutionProvider::GetSharedEngineKey().
+// An engine is released with the last execution provider that uses it.
+struct SharedEngineCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<nvinfer1::ICudaEngine>> engines;
+};
+
+SharedEngineCache& GetSharedEngineCache() {
+  static SharedEngineCache cache;
+  return cache;
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> FindSharedEngine(const std::string& key) {
+  SharedEngineCache& cache = GetSharedEngineCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto it = cache.engines.find(key);
+  return it != cache.engines.end() ? it->second.lock() : nullptr;
+}
+
+// Add the engine to the process-wide engine cache and return the cached engine, which is the one of another
+// execution provider if it added an engine for the same key meanwhile.
+std::shared_ptr<nvinfer1::ICudaEngine> AddSharedEngine(const std::string& key,
+                                                       std::shared_ptr<nvinfer1::ICudaEngine> engine,
+                                                       std::shared_ptr<nvinfer1::IRuntime> runtime) {
+  SharedEngineCache& cache = GetSharedEngineCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  for (auto it = cache.engines.begin(); it != cache.engines.end();) {
+    it = it->second.expired() ? cache.engines.erase(it) : std::next(it);
+  }
+
+  auto& cached_engine = cache.engines[key];
+  if (auto shared_engine = cached_engine.lock()) {
+    return shared_engine;
+  }
+  auto holder = std::make_shared<SharedEngine>(SharedEngine{std::move(runtime), std::move(engine)});
+  std::shared_ptr<nvinfer1::ICudaEngine> shared_engine(holder, holder->engine.get());
+  cached_engine = shared_engine;
+  return shared_engine;
+}
 }  // namespace
 
 namespace google {
@@ -585,6 +636,28 @@ bool ApplyProfileShapesFromProviderOptions(std::vector<nvinfer1::IOptimizationPr
   return true;
 }
 
+// Returns the smallest power of two not less than `value`, clamped to the int32 range of the profile dimensions.
+int64_t ExpandProfileUpperBound(int64_t value) {
+  constexpr int64_t max_value = std::numeric_limits<int32_t>::max();
+  int64_t result = 1;
+  while (result < value && result <= max_value / 2) {
+    result *= 2;
+  }
+  return std::min(std::max(result, value), max_value);
+}
+
+// Returns the largest power of two not greater than `value`, or `value` itself when it is less than one.
+int64_t ExpandProfileLowerBound(int64_t value) {
+  if (value < 1) {
+    return value;
+  }
+  int64_t result = 1;
+  while (result <= value / 2) {
+    result *= 2;
+  }
+  return result;
+}
+
 /*
  * Apply TensorRT optimization profile shapes from input tensor value.
  *
@@ -593,6 +666,8 @@ bool ApplyProfileShapesFromProviderOptions(std::vector<nvinfer1::IOptimizationPr
  *
  * @param shape_tensor_values holds "shape tensor -> shape values" for the INT32 shape tensor input across this inference run
  * @param shape_tensor_values_int64 holds "shape tensor -> shape values" for the INT64 shape tensor input across this inference run
+ * @param profile_auto_expand widens an out-of-range dimension of an execution tensor to power-of-two bounds, so that the
+ *        next shapes of growing traffic still fit in the rebuilt engine's profile
  */
 Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizationProfile*>& trt_profiles,
                                               Ort::KernelContext ctx,
@@ -602,6 +677,7 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
                                               std::unordered_map<std::string, std::vector<int32_t>>& shape_tensor_values,
                                               std::unordered_map<std::string, std::vector<int64_t>>& shape_tensor_values_int64,
                                               cudaStream_t stream,
+                                              bool profile_auto_expand,
                                               bool* engine_update) {
   for (size_t i = 0; i < trt_profiles.size(); i++) {
     const std::string& input_name = input->getName();
@@ -749,15 +825,15 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
 
           // Update minimum dimension
           if (tensor_shape < shape_range[0]) {
-            shape_range[0] = tensor_shape;
-            dims_min.d[j] = static_cast<int32_t>(tensor_shape);
+            shape_range[0] = profile_auto_expand ? ExpandProfileLowerBound(tensor_shape) : tensor_shape;
+            dims_min.d[j] = static_cast<int32_t>(shape_range[0]);
             *engine_update = true;
           }
           // Update maximum dimension
           if (tensor_shape > shape_range[1]) {
-            shape_range[1] = tensor_shape;
+            shape_range[1] = profile_auto_expand ? ExpandProfileUpperBound(tensor_shape) : tensor_shape;
             shape_range[2] = tensor_shape;
-            dims_max.d[j] = static_cast<int32_t>(tensor_shape);
+            dims_max.d[j] = static_cast<int32_t>(shape_range[1]);
             dims_opt.d[j] = static_cast<int32_t>(tensor_shape);
             *engine_update = true;
           }
@@ -1380,6 +1456,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     cuda_graph_enable_ = info.cuda_graph_enable;
     engine_hw_compatible_ = info.engine_hw_compatible;
     op_types_to_exclude_ = info.op_types_to_exclude;
+    engine_sharing_enable_ = info.engine_sharing_enable;
+    profile_auto_expand_ = info.profile_auto_expand;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -1571,6 +1649,16 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
         op_types_to_exclude_ = op_types_to_exclude_env;
       }
 
+      const std::string engine_sharing_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineSharingEnable);
+      if (!engine_sharing_enable_env.empty()) {
+        engine_sharing_enable_ = (std::stoi(engine_sharing_enable_env) == 0 ? false : true);
+      }
+
+      const std::string profile_auto_expand_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileAutoExpand);
+      if (!profile_auto_expand_env.empty()) {
+        profile_auto_expand_ = (std::stoi(profile_auto_expand_env) == 0 ? false : true);
+      }
+
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -1775,7 +1863,9 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_cache_prefix: " << cache_prefix_
                         << ", trt_engine_hw_compatible: " << engine_hw_compatible_
                         << ", trt_onnx_model_bytestream_size_: " << onnx_model_bytestream_size_
-                        << ", trt_op_types_to_exclude: " << op_types_to_exclude_;
+                        << ", trt_op_types_to_exclude: " << op_types_to_exclude_
+                        << ", trt_engine_sharing_enable: " << engine_sharing_enable_
+                        << ", trt_profile_auto_expand: " << profile_auto_expand_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
@@ -1888,6 +1978,92 @@ nvinfer1::IBuilder* TensorrtExecutionProvider::GetBuilder(TensorrtLogger& trt_lo
   return builder_.get();
 }
 
+void TensorrtExecutionProvider::DisableUnsupportedPlatformFeatures(nvinfer1::IBuilder& trt_builder) {
+  // Check platform availability for low precision
+  if (fp16_enable_) {
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    if (!trt_builder.platformHasFastFp16()) {
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+      fp16_enable_ = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_FP16_ENABLE is set, but platform doesn't support fast native fp16";
+    }
+  }
+
+  if (int8_enable_) {
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    if (!trt_builder.platformHasFastInt8()) {
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+      int8_enable_ = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_INT8_ENABLE is set, but platform doesn't support fast native int8";
+    }
+  }
+
+  // DLA can only run with FP16 and INT8
+  if ((fp16_enable_ || int8_enable_) && dla_enable_ && dla_core_ >= 0) {
+    int number_of_dla_core = trt_builder.getNbDLACores();
+    if (number_of_dla_core == 0) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core, but platform doesn't have any DLA core";
+      dla_enable_ = false;
+    } else if (dla_core_ >= number_of_dla_core) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core #" << dla_core_ << ", but it exceeds platform's maximum DLA core number " << number_of_dla_core << ". Use DLA core 0 instead.";
+      dla_core_ = 0;
+    }
+  }
+}
+
+std::string TensorrtExecutionProvider::GetSharedEngineKey(const std::string& serialized_model,
+                                                          const std::string& trt_node_name_with_precision,
+                                                          const std::string& cache_hw_compat) const {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto hash_str = [&hash](const std::string& str) {
+    MurmurHash3::x86_128(str.data(), str.size(), hash[0], &hash);
+  };
+
+  hash_str(serialized_model);
+  // The external data of the subgraph is relative to the model path
+  hash_str(model_path_);
+
+  std::ostringstream options;
+  options << trt_node_name_with_precision << cache_hw_compat << "_device" << device_id_ << "_sm" << compute_capability_
+          << "_" << max_workspace_size_ << "_" << layer_norm_fp32_fallback_ << "_" << build_heuristics_enable_
+          << "_" << sparsity_enable_ << "_" << builder_optimization_level_ << "_" << auxiliary_streams_
+          << "_" << tactic_sources_;
+  if (int8_enable_ && int8_calibration_cache_available_) {
+    options << "_" << GetCachePath(cache_path_, int8_calibration_cache_name_) << "_"
+            << int8_use_native_tensorrt_calibration_table_;
+  }
+  // The explicit profiles, by input name
+  for (const auto* profile_shapes : {&profile_min_shapes_, &profile_max_shapes_, &profile_opt_shapes_}) {
+    const std::map<std::string, std::vector<std::vector<int64_t>>> ordered_shapes(profile_shapes->begin(),
+                                                                                  profile_shapes->end());
+    options << "|";
+    for (const auto& [input_name, shapes] : ordered_shapes) {
+      options << "_" << input_name;
+      for (const auto& shape : shapes) {
+        options << ":";
+        for (int64_t dim : shape) {
+          options << dim << ",";
+        }
+      }
+    }
+  }
+  hash_str(options.str());
+
+  std::ostringstream key;
+  key << std::hex << hash[0] << "_" << hash[1] << "_" << hash[2] << "_" << hash[3];
+  return key.str();
+}
+
 void TensorrtExecutionProvider::GetCustomOpDomainList(std::vector<OrtCustomOpDomain*>& custom_op_domain_list) const {
   std::string extra_plugin_lib_paths{""};
   if (info_.has_trt_options) {
@@ -2825,9 +3001,12 @@ common::Status TensorrtExecutionProvider::RefitEngine(std::string onnx_model_fil
 
 common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
-  for (auto& fused_node_graph : fused_nodes_and_graphs) {
-    const GraphViewer& graph_body_viewer = fused_node_graph.filtered_graph;
-    const Node& fused_node = fused_node_graph.fused_node;
+  const size_t num_fused_nodes = fused_nodes_and_graphs.size();
+  std::vector<std::vector<NodeComputeInfo>> fused_node_compute_funcs(num_fused_nodes);
+  std::vector<Status> statuses(num_fused_nodes);
+  auto compile_fused_node = [&](size_t i) {
+    const GraphViewer& graph_body_viewer = fused_nodes_and_graphs[i].filtered_graph;
+    const Node& fused_node = fused_nodes_and_graphs[i].fused_node;
     // Build map from input name to its index in input definitions
     std::unordered_map<std::string, size_t> input_map;
     const auto& input_defs = fused_node.InputDefs();
@@ -2844,19 +3023,86 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       output_map[output_defs[i]->Name()] = i;
     }
 
-    Status status;
-    if (GraphHasCtxNode(graph_body_viewer)) {
-      status = CreateNodeComputeInfoFromPrecompiledEngine(graph_body_viewer,
-                                                          fused_node,
-                                                          input_map,
-                                                          output_map,
-                                                          node_compute_funcs);
+    ORT_TRY {
+      if (GraphHasCtxNode(graph_body_viewer)) {
+        statuses[i] = CreateNodeComputeInfoFromPrecompiledEngine(graph_body_viewer,
+                                                                 fused_node,
+                                                                 input_map,
+                                                                 output_map,
+                                                                 fused_node_compute_funcs[i]);
+      } else {
+        statuses[i] = CreateNodeComputeInfoFromGraph(graph_body_viewer, fused_node, input_map, output_map,
+                                                     fused_node_compute_funcs[i]);
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, ex.what());
+      });
+    }
+  };
+
+  // The fused nodes with precompiled engines are compiled first, then the ones whose engines are built from graphs.
+  std::vector<size_t> fused_nodes_to_build;
+  for (size_t i = 0; i < num_fused_nodes; ++i) {
+    if (GraphHasCtxNode(fused_nodes_and_graphs[i].filtered_graph)) {
+      compile_fused_node(i);
+    } else {
+      fused_nodes_to_build.push_back(i);
+    }
+  }
+
+  if (!fused_nodes_to_build.empty()) {
+    TensorrtLogger& trt_logger = GetTensorrtLogger(detailed_build_log_);
+    DisableUnsupportedPlatformFeatures(*GetBuilder(trt_logger));
+
+    // The engines are built concurrently, each fused node with its own builder as a builder can only be used by one
+    // thread at a time, unless the fused nodes update the EP context model or refit their engines, which is done
+    // in order.
+    const bool build_concurrently = !force_sequential_engine_build_ && !dump_ep_context_model_ &&
+                                    !weight_stripped_engine_enable_ && fused_nodes_to_build.size() > 1;
+    if (build_concurrently) {
+      {
+        auto lock = GetApiLock();
+        for (size_t i : fused_nodes_to_build) {
+          builders_[fused_nodes_and_graphs[i].fused_node.get().Name()] =
+              std::unique_ptr<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
+        }
+      }
+
+      // Each thread compiles the next fused node that is not taken yet until none is left.
+      std::atomic<size_t> next_fused_node{0};
+      std::vector<std::thread> threads;
+      const size_t num_threads = std::min(fused_nodes_to_build.size(), kMaxConcurrentEngineBuilds);
+      for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+          // New threads are on device 0 by default
+          const Status device_status = CUDA_CALL(cudaSetDevice(device_id_));
+          for (size_t j = next_fused_node++; j < fused_nodes_to_build.size(); j = next_fused_node++) {
+            if (device_status.IsOK()) {
+              compile_fused_node(fused_nodes_to_build[j]);
+            } else {
+              statuses[fused_nodes_to_build[j]] = device_status;
+            }
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
     } else {
-      status = CreateNodeComputeInfoFromGraph(graph_body_viewer, fused_node, input_map, output_map, node_compute_funcs);
+      for (size_t i : fused_nodes_to_build) {
+        compile_fused_node(i);
+      }
     }
-    if (status != Status::OK()) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, status.ErrorMessage());
+  }
+
+  for (size_t i = 0; i < num_fused_nodes; ++i) {
+    if (statuses[i] != Status::OK()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, statuses[i].ErrorMessage());
     }
+    node_compute_funcs.insert(node_compute_funcs.end(), fused_node_compute_funcs[i].begin(),
+                              fused_node_compute_funcs[i].end());
   }
   return Status::OK();
 }
@@ -2886,7 +3132,10 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
   }
 
   TensorrtLogger& trt_logger = GetTensorrtLogger(detailed_build_log_);
-  auto trt_builder = GetBuilder(trt_logger);
+  // The fused nodes whose engines are built concurrently have their own builder, see Compile()
+  const auto builder_it = builders_.find(fused_node.Name());
+  const bool has_own_builder = builder_it != builders_.end();
+  auto trt_builder = has_own_builder ? builder_it->second.get() : GetBuilder(trt_logger);
   auto network_flags = 0;
 #if NV_TENSORRT_MAJOR > 8
   network_flags |= fp16_enable_ || int8_enable_ ? 0 : 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kSTRONGLY_TYPED);
@@ -3049,35 +3298,6 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     trt_profiles.push_back(trt_builder->createOptimizationProfile());
   }
 
-  // Check platform availability for low precision
-  if (fp16_enable_) {
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-    if (!trt_builder->platformHasFastFp16()) {
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-      fp16_enable_ = false;
-      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_FP16_ENABLE is set, but platform doesn't support fast native fp16";
-    }
-  }
-
-  if (int8_enable_) {
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-    if (!trt_builder->platformHasFastInt8()) {
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-      int8_enable_ = false;
-      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_INT8_ENABLE is set, but platform doesn't support fast native int8";
-    }
-  }
-
   // Load INT8 calibration table
   std::unordered_map<std::string, float> dynamic_range_map;
   if (int8_enable_ && int8_calibration_cache_available_) {
@@ -3103,24 +3323,14 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
   }
 
-  // Set DLA
+  // Set DLA. The platform support of DLA is checked by DisableUnsupportedPlatformFeatures()
   if (fp16_enable_ || int8_enable_) {
     if (dla_enable_ && dla_core_ >= 0) {  // DLA can only run with FP16 and INT8
-      int number_of_dla_core = trt_builder->getNbDLACores();
-      if (number_of_dla_core == 0) {
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core, but platform doesn't have any DLA core";
-        dla_enable_ = false;
-      } else {
-        if (dla_core_ >= number_of_dla_core) {
-          LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core #" << dla_core_ << ", but it exceeds platform's maximum DLA core number " << number_of_dla_core << ". Use DLA core 0 instead.";
-          dla_core_ = 0;
-        }
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << dla_core_;
-        trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
-        trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
-        trt_config->setDLACore(dla_core_);
-        trt_node_name_with_precision += "_dlacore" + std::to_string(dla_core_);
-      }
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << dla_core_;
+      trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
+      trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
+      trt_config->setDLACore(dla_core_);
+      trt_node_name_with_precision += "_dlacore" + std::to_string(dla_core_);
     }
   }
 
@@ -3191,7 +3401,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
   //   (2) All the dynamic shape inputs have associated explicit profiles specified by user
   //
   // Otherwise engine will be handled at inference time.
-  std::unique_ptr<nvinfer1::ICudaEngine> trt_engine;
+  std::shared_ptr<nvinfer1::ICudaEngine> trt_engine;
   std::unique_ptr<nvinfer1::IExecutionContext> trt_context;
 
   std::string cache_path = "";
@@ -3241,6 +3451,14 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     if (timing_cache_enable_) {
       timing_cache_path = GetTimingCachePath(global_cache_path_, compute_capability_);
     }
+
+    // Share the engine with the other sessions of the process that build the same subgraph with the same options.
+    // Engines that are refitted or dumped to an EP context model are built by each session.
+    std::string shared_engine_key;
+    if (engine_sharing_enable_ && !weight_stripped_engine_enable_ && !dump_ep_context_model_) {
+      shared_engine_key = GetSharedEngineKey(string_buf, trt_node_name_with_precision, cache_hw_compat);
+      trt_engine = FindSharedEngine(shared_engine_key);
+    }
     {
       // ifstream file check, engine serialization/deserialization and engine build are in critical section. It needs lock protection to prevent race condition when inferencing with multithreading.
       auto lock = GetApiLock();
@@ -3257,7 +3475,9 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       }
 
       std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
-      if (engine_cache_enable_ && !engine_decryption_enable_ && engine_file && !engine_update) {
+      if (trt_engine != nullptr) {
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Shared the engine of " + trt_node_name_with_precision + " with other sessions";
+      } else if (engine_cache_enable_ && !engine_decryption_enable_ && engine_file && !engine_update) {
         engine_file.seekg(0, std::ios::end);
         size_t engine_size = engine_file.tellg();
         engine_file.seekg(0, std::ios::beg);
@@ -3326,7 +3546,15 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
         if (detailed_build_log_) {
           engine_build_start = std::chrono::steady_clock::now();
         }
+        // A builder that is not shared with the other fused nodes builds its engine outside of the critical section,
+        // concurrently with the other builders.
+        if (has_own_builder) {
+          lock.unlock();
+        }
         std::unique_ptr<nvinfer1::IHostMemory> serialized_engine{trt_builder->buildSerializedNetwork(*trt_network, *trt_config)};
+        if (has_own_builder) {
+          lock.lock();
+        }
         if (serialized_engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                  "TensorRT EP failed to create engine from network for fused node: " + fused_node.Name());
@@ -3419,6 +3647,10 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       }
     }
 
+    if (!shared_engine_key.empty()) {
+      trt_engine = AddSharedEngine(shared_engine_key, std::move(trt_engine), runtime_);
+    }
+
     // Build context
     // Note: Creating an execution context from an engine is thread safe per TRT doc
     // https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#threading
@@ -3431,8 +3663,11 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
-      if (mem_size > max_ctx_mem_size_) {
-        max_ctx_mem_size_ = mem_size;
+      {
+        std::lock_guard<std::mutex> lock(tensorrt_mu_);
+        if (mem_size > max_ctx_mem_size_) {
+          max_ctx_mem_size_ = mem_size;
+        }
       }
 #if NV_TENSORRT_MAJOR < 10
       trt_context = std::unique_ptr<nvinfer1::IExecutionContext>(trt_engine->createExecutionContextWithoutDeviceMemory());
@@ -3470,16 +3705,20 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     output_types[output_name] = tensor_type.elem_type();
   }
 
-  // Save TRT engine, other TRT objects and input/output info to map
-  parsers_.emplace(fused_node.Name(), std::move(trt_parser));
-  engines_.emplace(fused_node.Name(), std::move(trt_engine));
-  contexts_.emplace(fused_node.Name(), std::move(trt_context));
-  networks_.emplace(fused_node.Name(), std::move(trt_network));
-  input_info_[fused_node.Name()].push_back(input_indexes);
-  output_info_[fused_node.Name()].push_back(output_indexes);
-  output_info_[fused_node.Name()].push_back(output_types);
-  input_shape_ranges_[fused_node.Name()] = input_implicit_shape_ranges;
-  profiles_.emplace(fused_node.Name(), std::move(trt_profiles));
+  // Save TRT engine, other TRT objects and input/output info to map.
+  // The engines of the fused nodes may be built concurrently, see Compile().
+  {
+    std::lock_guard<std::mutex> lock(tensorrt_mu_);
+    parsers_.emplace(fused_node.Name(), std::move(trt_parser));
+    engines_.emplace(fused_node.Name(), std::move(trt_engine));
+    contexts_.emplace(fused_node.Name(), std::move(trt_context));
+    networks_.emplace(fused_node.Name(), std::move(trt_network));
+    input_info_[fused_node.Name()].push_back(input_indexes);
+    output_info_[fused_node.Name()].push_back(output_indexes);
+    output_info_[fused_node.Name()].push_back(output_types);
+    input_shape_ranges_[fused_node.Name()] = input_implicit_shape_ranges;
+    profiles_.emplace(fused_node.Name(), std::move(trt_profiles));
+  }
 
   // For dynamic shape input model, firstly TRT EP creates a model proto which includes inputs, outputs and empty engine.
   // TRT EP will serialize the model at inference time due to engine can be updated and the updated engine should be included in the model.
@@ -3517,7 +3756,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     if (!tactic_sources_.empty()) {
       tactics = GetTacticSourceFromString(tactic_sources_);
     }
-    *p = {context->allocate_func, context->release_func, context->allocator_handle, context->node_name, builder_.get(),
+    *p = {context->allocate_func, context->release_func, context->allocator_handle, context->node_name, trt_builder,
           &parsers_[context->node_name], &engines_[context->node_name], &contexts_[context->node_name],
           &networks_[context->node_name], input_info_[context->node_name], output_info_[context->node_name],
           input_shape_ranges_[context->node_name], &tensorrt_mu_, fp16_enable_, int8_enable_, int8_calibration_cache_available_,
@@ -3526,7 +3765,8 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
           context_memory_sharing_enable_, &max_ctx_mem_size_, dynamic_range_map, engine_decryption_enable_,
           engine_decryption_, engine_encryption_, timing_cache_enable_, global_cache_path_, force_timing_cache_match_,
           detailed_build_log_, build_heuristics_enable_, sparsity_enable_, builder_optimization_level_,
-          auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_, cache_prefix_, cache_suffix, engine_hw_compatible_};
+          auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_, cache_prefix_, cache_suffix, engine_hw_compatible_,
+          profile_auto_expand_};
     *state = p.release();
     return 0;
   };
@@ -3694,7 +3934,8 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       // If there is any input tensor in shape_ranges, it means this input tensor has dynamic shape and its profile shape values have not yet resolved.
       // TRT EP will help determine the min/max/opt profile values based on current input tensor value.
       if (shape_ranges.find(input_name) != shape_ranges.end()) {
-        auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, shape_tensor_values, shape_tensor_values_int64, stream, &engine_update);
+        auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, shape_tensor_values, shape_tensor_values_int64, stream,
+                                                             trt_state->profile_auto_expand, &engine_update);
         if (status != Status::OK()) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to parse input tensor and generate optimization profiles.");
         }
@@ -58,6 +58,8 @@ static const std::string kEpContextEmbedMode = "ORT_EP_CONTEXT_EMBED_MODE";
 static const std::string kEpContextComputeCapabilityEnable = "ORT_EP_CONTEXT_COMPUTE_CAPABILITY_ENABLE";
 static const std::string kEngineCachePrefix = "ORT_TENSORRT_CACHE_PREFIX";
 static const std::string kOpTypesToExclude = "ORT_TENSORRT_OP_TYPES_TO_EXCLUDE";
+static const std::string kEngineSharingEnable = "ORT_TENSORRT_ENGINE_SHARING_ENABLE";
+static const std::string kProfileAutoExpand = "ORT_TENSORRT_PROFILE_AUTO_EXPAND";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -164,7 +166,7 @@ struct TensorrtFuncState {
   std::string fused_node_name;
   nvinfer1::IBuilder* builder;
   tensorrt_ptr::unique_pointer<nvonnxparser::IParser>* parser = nullptr;
-  std::unique_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
   std::unique_ptr<nvinfer1::IExecutionContext>* context = nullptr;
   std::unique_ptr<nvinfer1::INetworkDefinition>* network = nullptr;
   std::vector<std::unordered_map<std::string, size_t>> input_info;
@@ -201,6 +203,7 @@ struct TensorrtFuncState {
   std::string cache_prefix;
   std::string cache_suffix;
   bool engine_hw_compatible = false;
+  bool profile_auto_expand = false;
 };
 
 // Minimum information to construct kernel function state for direct engine load code path
@@ -209,7 +212,7 @@ struct TensorrtShortFuncState {
   DestroyFunc test_release_func = nullptr;
   AllocatorHandle allocator = nullptr;
   std::string fused_node_name;
-  std::unique_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
   std::unique_ptr<nvinfer1::IExecutionContext>* context = nullptr;
   std::vector<std::unordered_map<std::string, size_t>> input_info;
   std::vector<std::unordered_map<std::string, size_t>> output_info;
@@ -314,7 +317,8 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   int auxiliary_streams_ = -1;
   std::string tactic_sources_;
   std::string global_cache_path_, cache_path_, engine_decryption_lib_path_;
-  std::unique_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
+  // Shared with the engines that are shared across the sessions of the process, which must not outlive it.
+  std::shared_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
   std::mutex tensorrt_mu_;
   int device_id_;
   std::string compute_capability_;
@@ -333,6 +337,8 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::string cache_prefix_;
   bool engine_hw_compatible_ = false;
   std::string op_types_to_exclude_;
+  bool engine_sharing_enable_ = false;
+  bool profile_auto_expand_ = false;
 
   // The format is as for TENSORRT_VERSION: (MAJOR * 100 + MINOR) * 100 + PATCH
   int32_t trt_version_;
@@ -361,8 +367,9 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   // But there are still some thread safe operations, please see here https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#threading
   // For those non thread safe operations, TRT EP uses (1) lock_guard or (2) PerThreadContext to make sure synchronization.
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvonnxparser::IParser>> parsers_;
-  std::unordered_map<std::string, std::unique_ptr<nvinfer1::ICudaEngine>> engines_;
+  std::unordered_map<std::string, std::shared_ptr<nvinfer1::ICudaEngine>> engines_;
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::IExecutionContext>> contexts_;
+  // The builders of the fused nodes whose engines are built concurrently, see Compile().
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::IBuilder>> builders_;
   std::unordered_map<std::string, std::unique_ptr<nvinfer1::INetworkDefinition>> networks_;
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> input_info_;
@@ -594,6 +601,18 @@ class TensorrtExecutionProvider : public IExecutionProvider {
    */
   nvinfer1::IBuilder* GetBuilder(TensorrtLogger& trt_logger) const;
 
+  /**
+   * Turn off FP16, INT8 and DLA when the platform doesn't support them, before any engine is built.
+   */
+  void DisableUnsupportedPlatformFeatures(nvinfer1::IBuilder& trt_builder);
+
+  /**
+   * Get the key of the engine of a fused node in the process-wide engine cache, which identifies the subgraph,
+   * the options the engine is built with and the GPU.
+   */
+  std::string GetSharedEngineKey(const std::string& serialized_model, const std::string& trt_node_name_with_precision,
+                                 const std::string& cache_hw_compat) const;
+
   /**
    *  This is the helper function for ConstantFoldingDQ graph transformer.
    *
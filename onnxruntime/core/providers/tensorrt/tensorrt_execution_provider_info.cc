@@ -57,6 +57,8 @@ constexpr const char* kEngineHwCompatible = "trt_engine_hw_compatible";
 constexpr const char* kONNXBytestream = "trt_onnx_bytestream";
 constexpr const char* kONNXBytestreamSize = "trt_onnx_bytestream_size";
 constexpr const char* kOpTypesToExclude = "trt_op_types_to_exclude";
+constexpr const char* kEngineSharingEnable = "trt_engine_sharing_enable";
+constexpr const char* kProfileAutoExpand = "trt_profile_auto_expand";
 
 }  // namespace provider_option_names
 }  // namespace tensorrt
@@ -136,6 +138,8 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
               })
           .AddAssignmentToReference(tensorrt::provider_option_names::kONNXBytestreamSize, info.onnx_bytestream_size)
           .AddAssignmentToReference(tensorrt::provider_option_names::kOpTypesToExclude, info.op_types_to_exclude)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kEngineSharingEnable, info.engine_sharing_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileAutoExpand, info.profile_auto_expand)
           .Parse(options));  // add new provider option here.
 
   info.user_compute_stream = user_compute_stream;
@@ -191,6 +195,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       {tensorrt::provider_option_names::kONNXBytestream, MakeStringWithClassicLocale(info.onnx_bytestream)},
       {tensorrt::provider_option_names::kONNXBytestreamSize, MakeStringWithClassicLocale(info.onnx_bytestream_size)},
       {tensorrt::provider_option_names::kOpTypesToExclude, MakeStringWithClassicLocale(info.op_types_to_exclude)},
+      {tensorrt::provider_option_names::kEngineSharingEnable, MakeStringWithClassicLocale(info.engine_sharing_enable)},
+      {tensorrt::provider_option_names::kProfileAutoExpand, MakeStringWithClassicLocale(info.profile_auto_expand)},
   };
   return options;
 }
@@ -256,6 +262,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
       {tensorrt::provider_option_names::kONNXBytestream, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.trt_onnx_bytestream))},
       {tensorrt::provider_option_names::kONNXBytestreamSize, MakeStringWithClassicLocale(info.trt_onnx_bytestream_size)},
       {tensorrt::provider_option_names::kOpTypesToExclude, kOpTypesToExclude_},
+      {tensorrt::provider_option_names::kEngineSharingEnable, MakeStringWithClassicLocale(info.trt_engine_sharing_enable)},
+      {tensorrt::provider_option_names::kProfileAutoExpand, MakeStringWithClassicLocale(info.trt_profile_auto_expand)},
   };
   return options;
 }
@@ -361,5 +369,7 @@ void TensorrtExecutionProviderInfo::UpdateProviderOptions(void* provider_options
   trt_provider_options_v2.trt_onnx_bytestream = internal_options.onnx_bytestream;
   trt_provider_options_v2.trt_onnx_bytestream_size = internal_options.onnx_bytestream_size;
   trt_provider_options_v2.trt_op_types_to_exclude = copy_string_if_needed(internal_options.op_types_to_exclude);
+  trt_provider_options_v2.trt_engine_sharing_enable = internal_options.engine_sharing_enable;
+  trt_provider_options_v2.trt_profile_auto_expand = internal_options.profile_auto_expand;
 }
 }  // namespace onnxruntime
@@ -61,6 +61,8 @@ struct TensorrtExecutionProviderInfo {
   std::string engine_cache_prefix{""};
   bool engine_hw_compatible{false};
   std::string op_types_to_exclude{""};
+  bool engine_sharing_enable{false};
+  bool profile_auto_expand{false};
 
   static TensorrtExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const TensorrtExecutionProviderInfo& info);
@@ -119,6 +119,8 @@ struct Tensorrt_Provider : Provider {
     info.onnx_bytestream = options.trt_onnx_bytestream;
     info.onnx_bytestream_size = options.trt_onnx_bytestream_size;
     info.op_types_to_exclude = options.trt_op_types_to_exclude == nullptr ? "" : options.trt_op_types_to_exclude;
+    info.engine_sharing_enable = options.trt_engine_sharing_enable != 0;
+    info.profile_auto_expand = options.trt_profile_auto_expand != 0;
 
     return std::make_shared<TensorrtProviderFactory>(info);
   }
@@ -210,7 +210,97 @@ class BucketCacheManager : public IBufferCacheManager {
   std::vector<size_t> buckets_keys_;
 };
 
-std::unique_ptr<IBufferCacheManager> CreateBufferCacheManager(BufferCacheMode cache_mode) {
+// the number of refreshes after which a cached buffer that was not reused is released
+constexpr uint64_t GENERATIONAL_MAX_IDLE_GENERATIONS = 1024;
+// the default maximum total size of the buffers kept by the generational cache
+constexpr size_t GENERATIONAL_DEFAULT_BUDGET = size_t{512} * 1024 * 1024;
+
+class GenerationalCacheManager : public IBufferCacheManager {
+ public:
+  explicit GenerationalCacheManager(size_t budget) : budget_{budget == 0 ? GENERATIONAL_DEFAULT_BUDGET : budget} {}
+
+  size_t CalculateBufferSize(size_t request_size) override {
+    // sizes up to 256 bytes are only rounded up to 16 bytes. larger sizes are rounded up to the next size class,
+    // with 4 size classes between 2 consecutive powers of 2, which wastes at most 25% of the buffer.
+    auto size = NormalizeBufferSize(request_size);
+    if (size <= 256) {
+      return size;
+    }
+    size_t step = 64;
+    while (step * 8 < size) {
+      step <<= 1;
+    }
+    return (size + step - 1) / step * step;
+  }
+
+  WGPUBuffer TryAcquireCachedBuffer(size_t buffer_size) override {
+    auto it = buffers_.find(buffer_size);
+    if (it != buffers_.end() && !it->second.empty()) {
+      // reuse the most recently released buffer
+      auto buffer = it->second.back().buffer.MoveToCHandle();
+      it->second.pop_back();
+      cached_size_ -= buffer_size;
+      return buffer;
+    }
+    return nullptr;
+  }
+
+  void RegisterBuffer(WGPUBuffer /*buffer*/, size_t /*request_size*/) override {
+    // no-op
+  }
+
+  void ReleaseBuffer(WGPUBuffer buffer) override {
+    pending_buffers_.emplace_back(wgpu::Buffer::Acquire(buffer));
+  }
+
+  void OnRefresh() override {
+    ++generation_;
+
+    for (auto& buffer : pending_buffers_) {
+      auto buffer_size = static_cast<size_t>(buffer.GetSize());
+      buffers_[buffer_size].push_back({std::move(buffer), generation_});
+      cached_size_ += buffer_size;
+    }
+    pending_buffers_.clear();
+
+    // the buffers of each size class are ordered by their release generation, so the oldest buffer is always the
+    // first buffer of one of the size classes.
+    for (auto& [buffer_size, buffers] : buffers_) {
+      size_t num_expired = 0;
+      while (num_expired < buffers.size() &&
+             generation_ - buffers[num_expired].generation > GENERATIONAL_MAX_IDLE_GENERATIONS) {
+        ++num_expired;
+      }
+      buffers.erase(buffers.begin(), buffers.begin() + num_expired);
+      cached_size_ -= num_expired * buffer_size;
+    }
+
+    while (cached_size_ > budget_) {
+      std::vector<CachedBuffer>* oldest = nullptr;
+      for (auto& [buffer_size, buffers] : buffers_) {
+        if (!buffers.empty() && (oldest == nullptr || buffers.front().generation < oldest->front().generation)) {
+          oldest = &buffers;
+        }
+      }
+      cached_size_ -= static_cast<size_t>(oldest->front().buffer.GetSize());
+      oldest->erase(oldest->begin());
+    }
+  }
+
+ private:
+  struct CachedBuffer {
+    wgpu::Buffer buffer;
+    uint64_t generation;
+  };
+
+  const size_t budget_;
+  uint64_t generation_ = 0;
+  size_t cached_size_ = 0;
+  std::unordered_map<size_t, std::vector<CachedBuffer>> buffers_;
+  std::vector<wgpu::Buffer> pending_buffers_;
+};
+
+std::unique_ptr<IBufferCacheManager> CreateBufferCacheManager(BufferCacheMode cache_mode, size_t budget = 0) {
   switch (cache_mode) {
     case BufferCacheMode::Disabled:
       return std::make_unique<DisabledCacheManager>();
@@ -220,6 +310,8 @@ std::unique_ptr<IBufferCacheManager> CreateBufferCacheManager(BufferCacheMode ca
       return std::make_unique<SimpleCacheManager>();
     case BufferCacheMode::Bucket:
       return std::make_unique<BucketCacheManager>();
+    case BufferCacheMode::Generational:
+      return std::make_unique<GenerationalCacheManager>(budget);
     default:
       ORT_NOT_IMPLEMENTED("Unsupported buffer cache mode");
   }
@@ -239,15 +331,18 @@ std::ostream& operator<<(std::ostream& os, BufferCacheMode mode) {
     case BufferCacheMode::Bucket:
       os << "Bucket";
       break;
+    case BufferCacheMode::Generational:
+      os << "Generational";
+      break;
     default:
       os << "Unknown(" << static_cast<int>(mode) << ")";
   }
   return os;
 }
 
-BufferManager::BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode)
+BufferManager::BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode, size_t storage_buffer_cache_budget)
     : context_{context},
-      storage_cache_{CreateBufferCacheManager(storage_buffer_cache_mode)},
+      storage_cache_{CreateBufferCacheManager(storage_buffer_cache_mode, storage_buffer_cache_budget)},
       uniform_cache_{CreateBufferCacheManager(uniform_buffer_cache_mode)},
       query_resolve_cache_{CreateBufferCacheManager(query_resolve_buffer_cache_mode)},
       default_cache_{CreateBufferCacheManager(BufferCacheMode::Disabled)} {
@@ -276,6 +371,12 @@ void BufferManager::Upload(void* src, WGPUBuffer dst, size_t size) {
   memcpy(mapped_data, src, size);
   staging_buffer.Unmap();
 
+  if (IsCapturing()) {
+    // the captured copy keeps the staging buffer alive
+    context_.CaptureCopy(staging_buffer, dst, buffer_size);
+    return;
+  }
+
   auto& command_encoder = context_.GetCommandEncoder();
   context_.EndComputePass();
   command_encoder.CopyBufferToBuffer(staging_buffer, 0, dst, 0, buffer_size);
@@ -292,6 +393,11 @@ void BufferManager::MemCpy(WGPUBuffer src, WGPUBuffer dst, size_t size) {
               "Source and destination buffers must have enough space for the copy operation. src_size=",
               wgpuBufferGetSize(src), ", dst_size=", wgpuBufferGetSize(dst), ", copy_size=", buffer_size, ".");
 
+  if (IsCapturing()) {
+    context_.CaptureCopy(src, dst, buffer_size);
+    return;
+  }
+
   auto& command_encoder = context_.GetCommandEncoder();
   context_.EndComputePass();
   command_encoder.CopyBufferToBuffer(src, 0, dst, 0, buffer_size);
@@ -339,10 +445,15 @@ WGPUBuffer BufferManager::CreateUMA(size_t size, wgpu::BufferUsage usage) {
 
 void BufferManager::Release(WGPUBuffer buffer) {
   EnforceBufferUnmapped(context_, buffer);
+  if (IsCapturing() && (wgpuBufferGetUsage(buffer) & (WGPUBufferUsage_Storage | WGPUBufferUsage_Uniform))) {
+    captured_buffers_->emplace_back(wgpu::Buffer::Acquire(buffer));
+    return;
+  }
   GetCacheManager(buffer).ReleaseBuffer(buffer);
 }
 
 void BufferManager::Download(WGPUBuffer src, void* dst, size_t size) {
+  ORT_ENFORCE(!IsCapturing(), "Downloading a buffer is not supported while a graph is captured.");
   EnforceBufferUnmapped(context_, src);
   auto buffer_size = NormalizeBufferSize(size);
 
@@ -373,6 +484,15 @@ void BufferManager::RefreshPendingBuffers() {
   default_cache_->OnRefresh();
 }
 
+void BufferManager::BeginCapture(std::vector<wgpu::Buffer>* captured_buffers) {
+  ORT_ENFORCE(captured_buffers != nullptr && !IsCapturing(), "A graph is already captured.");
+  captured_buffers_ = captured_buffers;
+}
+
+void BufferManager::EndCapture() {
+  captured_buffers_ = nullptr;
+}
+
 IBufferCacheManager& BufferManager::GetCacheManager(WGPUBufferUsage usage) const {
   if (usage & WGPUBufferUsage_Storage) {
     return *storage_cache_;
@@ -389,8 +509,8 @@ IBufferCacheManager& BufferManager::GetCacheManager(WGPUBuffer buffer) const {
   return GetCacheManager(wgpuBufferGetUsage(buffer));
 }
 
-std::unique_ptr<BufferManager> BufferManagerFactory::Create(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode) {
-  return std::make_unique<BufferManager>(context, storage_buffer_cache_mode, uniform_buffer_cache_mode, query_resolve_buffer_cache_mode);
+std::unique_ptr<BufferManager> BufferManagerFactory::Create(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode, size_t storage_buffer_cache_budget) {
+  return std::make_unique<BufferManager>(context, storage_buffer_cache_mode, uniform_buffer_cache_mode, query_resolve_buffer_cache_mode, storage_buffer_cache_budget);
 }
 
 }  // namespace webgpu
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <vector>
 
 #include "core/providers/webgpu/webgpu_external_header.h"
 
@@ -18,7 +19,8 @@ enum class BufferCacheMode {
   Disabled,
   LazyRelease,
   Simple,
-  Bucket
+  Bucket,
+  Generational
 };
 std::ostream& operator<<(std::ostream& os, BufferCacheMode mode);
 
@@ -26,11 +28,14 @@ std::ostream& operator<<(std::ostream& os, BufferCacheMode mode);
 // IBufferCacheManager is an interface for buffer cache management.
 //
 // By implementing this interface, we can have different buffer cache management strategies.
-// Currently, we have 3 strategies:
+// Currently, we have 5 strategies:
 // - Disabled: no cache. always allocate a new buffer and release it immediately after use.
 // - LazyRelease: no cache. the difference from Disabled is that it delays the release of buffers until the next refresh.
 // - Simple: a simple cache that always keeps buffers. when a buffer is requested, it tries to find a buffer in the cache.
 // - Bucket: a cache that keeps buffers in different buckets based on the buffer size, with a maximum number of buffers in each bucket.
+// - Generational: a cache that rounds the buffer sizes up to size classes, 4 per power of 2, so that buffers of similar
+//   sizes are reused across runs with different shapes. Buffers that are not reused for a number of refreshes are
+//   released, and the oldest buffers are released first when the total size of the cached buffers exceeds a budget.
 //
 class IBufferCacheManager {
  public:
@@ -57,7 +62,7 @@ class IBufferCacheManager {
 //
 class BufferManager {
  public:
-  BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode);
+  BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode, size_t storage_buffer_cache_budget);
 
   void Upload(void* src, WGPUBuffer dst, size_t size);
   void MemCpy(WGPUBuffer src, WGPUBuffer dst, size_t size);
@@ -69,6 +74,12 @@ class BufferManager {
   void Download(WGPUBuffer src, void* dst, size_t size);
   void RefreshPendingBuffers();
 
+  // While a graph is captured, the storage and uniform buffers released are kept alive in captured_buffers instead of
+  // being returned to the cache, since the captured commands keep using them when the graph is replayed.
+  void BeginCapture(std::vector<wgpu::Buffer>* captured_buffers);
+  void EndCapture();
+  bool IsCapturing() const { return captured_buffers_ != nullptr; }
+
  private:
   IBufferCacheManager& GetCacheManager(WGPUBufferUsage usage) const;
   IBufferCacheManager& GetCacheManager(WGPUBuffer buffer) const;
@@ -78,11 +89,12 @@ class BufferManager {
   std::unique_ptr<IBufferCacheManager> uniform_cache_;
   std::unique_ptr<IBufferCacheManager> query_resolve_cache_;
   std::unique_ptr<IBufferCacheManager> default_cache_;
+  std::vector<wgpu::Buffer>* captured_buffers_ = nullptr;
 };
 
 class BufferManagerFactory {
  public:
-  static std::unique_ptr<BufferManager> Create(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode);
+  static std::unique_ptr<BufferManager> Create(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode, size_t storage_buffer_cache_budget);
 
  private:
   BufferManagerFactory() {}
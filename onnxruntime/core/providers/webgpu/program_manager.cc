@@ -2,11 +2,13 @@
 // Licensed under the MIT License.
 
 #include <algorithm>
+#include <cstring>
 
 #include "core/common/common.h"
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/framework/binary_buffer.h"
 
 #include "core/providers/webgpu/program_manager.h"
 #include "core/providers/webgpu/shader_helper.h"
@@ -14,6 +16,66 @@
 namespace onnxruntime {
 namespace webgpu {
 
+namespace {
+
+constexpr char kPipelineCacheMagic[] = "ORTWGPC1";
+
+wgpu::ShaderModule CreateShaderModule(const wgpu::Device& device, const std::string& code) {
+  wgpu::ShaderModuleWGSLDescriptor wgsl_descriptor{};
+  wgsl_descriptor.code = code.c_str();
+
+  wgpu::ShaderModuleDescriptor descriptor{};
+  descriptor.nextInChain = &wgsl_descriptor;
+
+  return device.CreateShaderModule(&descriptor);
+}
+
+// The descriptor refers to constant_entries and label, which must outlive it.
+wgpu::ComputePipelineDescriptor MakePipelineDescriptor(const wgpu::ShaderModule& shader_module,
+                                                       const std::vector<wgpu::ConstantEntry>& constant_entries,
+                                                       [[maybe_unused]] const std::string& label) {
+  wgpu::ComputeState compute_state{};
+  compute_state.module = shader_module;
+  compute_state.entryPoint = "main";
+  if (!constant_entries.empty()) {
+    compute_state.constants = constant_entries.data();
+    compute_state.constantCount = constant_entries.size();
+  }
+
+  wgpu::ComputePipelineDescriptor pipeline_descriptor{};
+  pipeline_descriptor.compute = compute_state;
+#ifndef NDEBUG  // if debug build
+  pipeline_descriptor.label = label.c_str();
+#endif
+  return pipeline_descriptor;
+}
+
+std::vector<wgpu::ConstantEntry> MakeConstantEntries(const PipelineCacheEntry& entry) {
+  std::vector<wgpu::ConstantEntry> constant_entries;
+  constant_entries.reserve(entry.constants.size());
+  for (const auto& [name, value] : entry.constants) {
+    wgpu::ConstantEntry constant_entry{};
+    constant_entry.key = name.c_str();
+    constant_entry.value = value;
+    constant_entries.push_back(std::move(constant_entry));
+  }
+  return constant_entries;
+}
+
+uint64_t DoubleToBits(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double BitsToDouble(uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
 ProgramArtifact::ProgramArtifact(const ProgramBase& program, wgpu::ComputePipeline&& compute_pipeline, std::vector<int>&& shape_uniform_ranks)
     : name{program.Name()},
       compute_pipeline{compute_pipeline},
@@ -40,14 +102,12 @@ Status ProgramManager::NormalizeDispatchGroupSize(uint32_t& x, uint32_t& y, uint
 
 Status ProgramManager::Build(const ProgramBase& program,
                              const ProgramMetadata& program_metadata,
-#ifndef NDEBUG  // if debug build
                              const std::string& program_key,
-#endif
                              uint32_t normalized_dispatch_x,
                              uint32_t normalized_dispatch_y,
                              uint32_t normalized_dispatch_z,
                              wgpu::ComputePipeline& compute_pipeline,
-                             std::vector<int>& shape_uniform_ranks) const {
+                             std::vector<int>& shape_uniform_ranks) {
   ShaderHelper shader_helper{program,
                              program_metadata,
                              device_,
@@ -79,13 +139,7 @@ Status ProgramManager::Build(const ProgramBase& program,
 #endif
                         << "] End ===\n";
 
-  wgpu::ShaderModuleWGSLDescriptor wgsl_descriptor{};
-  wgsl_descriptor.code = code.c_str();
-
-  wgpu::ShaderModuleDescriptor descriptor{};
-  descriptor.nextInChain = &wgsl_descriptor;
-
-  auto shader_module = device_.CreateShaderModule(&descriptor);
+  auto shader_module = CreateShaderModule(device_, code);
 
   // TODO: a new cache hierarchy for constants.
   //
@@ -147,22 +201,20 @@ Status ProgramManager::Build(const ProgramBase& program,
     }
   }
 
-  wgpu::ComputeState compute_state{};
-  compute_state.module = shader_module;
-  compute_state.entryPoint = "main";
-  if (!constant_entries.empty()) {
-    compute_state.constants = constant_entries.data();
-    compute_state.constantCount = constant_entries.size();
-  }
-
-  wgpu::ComputePipelineDescriptor pipeline_descriptor{};
-  pipeline_descriptor.compute = compute_state;
-#ifndef NDEBUG  // if debug build
-  pipeline_descriptor.label = program.Name().c_str();
-#endif
-
+  auto pipeline_descriptor = MakePipelineDescriptor(shader_module, constant_entries, program.Name());
   compute_pipeline = device_.CreateComputePipeline(&pipeline_descriptor);
 
+  if (pipeline_cache_enabled_) {
+    auto entry = std::make_shared<PipelineCacheEntry>();
+    entry->name = program.Name();
+    entry->code = std::move(code);
+    for (size_t i = 0; i < constant_entries.size(); ++i) {
+      entry->constants.emplace_back(constant_names[i], constant_entries[i].value);
+    }
+    entry->shape_uniform_ranks = shape_uniform_ranks;
+    pipeline_cache_.insert_or_assign(program_key, std::move(entry));
+  }
+
   return Status();
 }
 
@@ -179,5 +231,128 @@ const ProgramArtifact* ProgramManager::Set(const std::string& key, ProgramArtifa
   return &(programs_.emplace(key, std::move(program)).first->second);
 }
 
+Status ProgramManager::ImportPipelineCache(const std::string& data) {
+  pipeline_cache_enabled_ = true;
+  if (data.empty()) {
+    return Status::OK();
+  }
+
+  BinaryBufferReader reader(data);
+  std::string magic, adapter_identity;
+  uint64_t num_entries = 0;
+  if (!reader.Read(magic) || magic != kPipelineCacheMagic ||
+      !reader.Read(adapter_identity) || adapter_identity != adapter_identity_) {
+    LOGS_DEFAULT(INFO) << "The WebGPU pipeline cache was exported for another adapter or version and is ignored.";
+    return Status::OK();
+  }
+  ORT_RETURN_IF_NOT(reader.ReadCount(num_entries), "The WebGPU pipeline cache is corrupted.");
+
+  std::vector<std::pair<std::string, std::shared_ptr<PipelineCacheEntry>>> entries;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    std::string key;
+    auto entry = std::make_shared<PipelineCacheEntry>();
+    uint64_t num_ranks = 0, num_constants = 0;
+    ORT_RETURN_IF_NOT(reader.Read(key) && reader.Read(entry->name) && reader.Read(entry->code) &&
+                          reader.ReadCount(num_ranks),
+                      "The WebGPU pipeline cache is corrupted.");
+    for (uint64_t j = 0; j < num_ranks; ++j) {
+      uint64_t rank = 0;
+      ORT_RETURN_IF_NOT(reader.Read(rank), "The WebGPU pipeline cache is corrupted.");
+      entry->shape_uniform_ranks.push_back(static_cast<int>(static_cast<int64_t>(rank)));
+    }
+    ORT_RETURN_IF_NOT(reader.ReadCount(num_constants), "The WebGPU pipeline cache is corrupted.");
+    for (uint64_t j = 0; j < num_constants; ++j) {
+      std::string name;
+      uint64_t value = 0;
+      ORT_RETURN_IF_NOT(reader.Read(name) && reader.Read(value), "The WebGPU pipeline cache is corrupted.");
+      entry->constants.emplace_back(std::move(name), BitsToDouble(value));
+    }
+    entries.emplace_back(std::move(key), std::move(entry));
+  }
+  ORT_RETURN_IF_NOT(reader.AtEnd(), "The WebGPU pipeline cache is corrupted.");
+
+  // the programs that are built or imported already are kept
+  size_t num_imported = 0;
+  for (auto& [key, entry] : entries) {
+    if (programs_.count(key) == 0 && pipeline_cache_.emplace(key, entry).second) {
+      CompileInBackground(entry);
+      ++num_imported;
+    }
+  }
+  LOGS_DEFAULT(VERBOSE) << "Imported " << num_imported << " programs from the WebGPU pipeline cache.";
+  return Status::OK();
+}
+
+Status ProgramManager::ExportPipelineCache(std::string& data) const {
+  ORT_RETURN_IF_NOT(pipeline_cache_enabled_, "The WebGPU pipeline cache is not enabled.");
+
+  BinaryBufferWriter writer;
+  writer.Write(std::string(kPipelineCacheMagic));
+  writer.Write(adapter_identity_);
+  writer.Write(static_cast<uint64_t>(pipeline_cache_.size()));
+  for (const auto& [key, entry] : pipeline_cache_) {
+    writer.Write(key);
+    writer.Write(entry->name);
+    writer.Write(entry->code);
+    writer.Write(static_cast<uint64_t>(entry->shape_uniform_ranks.size()));
+    for (int rank : entry->shape_uniform_ranks) {
+      writer.Write(static_cast<uint64_t>(static_cast<int64_t>(rank)));
+    }
+    writer.Write(static_cast<uint64_t>(entry->constants.size()));
+    for (const auto& [name, value] : entry->constants) {
+      writer.Write(name);
+      writer.Write(DoubleToBits(value));
+    }
+  }
+  data = writer.Buffer();
+  return Status::OK();
+}
+
+bool ProgramManager::BuildFromPipelineCache(const std::string& key,
+                                            wgpu::ComputePipeline& compute_pipeline,
+                                            std::vector<int>& shape_uniform_ranks) const {
+  auto it = pipeline_cache_.find(key);
+  if (it == pipeline_cache_.end()) {
+    return false;
+  }
+
+  const auto& entry = *it->second;
+  {
+    std::lock_guard<std::mutex> lock(it->second->mutex);
+    compute_pipeline = entry.compute_pipeline;
+  }
+  if (compute_pipeline == nullptr) {
+    // the background compilation is not done, the pipeline is created from the cached shader meanwhile
+    auto constant_entries = MakeConstantEntries(entry);
+    auto pipeline_descriptor = MakePipelineDescriptor(CreateShaderModule(device_, entry.code), constant_entries,
+                                                      entry.name);
+    compute_pipeline = device_.CreateComputePipeline(&pipeline_descriptor);
+  }
+  shape_uniform_ranks = entry.shape_uniform_ranks;
+  return true;
+}
+
+void ProgramManager::CompileInBackground(const std::shared_ptr<PipelineCacheEntry>& entry) const {
+  auto constant_entries = MakeConstantEntries(*entry);
+  auto pipeline_descriptor = MakePipelineDescriptor(CreateShaderModule(device_, entry->code), constant_entries,
+                                                    entry->name);
+  // the callback owns a reference to the entry, as it may be called after the program manager is released
+  device_.CreateComputePipelineAsync(
+      &pipeline_descriptor,
+      wgpu::CallbackMode::AllowSpontaneous,
+      [](wgpu::CreatePipelineAsyncStatus status, wgpu::ComputePipeline pipeline, wgpu::StringView message,
+         std::shared_ptr<PipelineCacheEntry>* entry_ptr) {
+        std::unique_ptr<std::shared_ptr<PipelineCacheEntry>> entry{entry_ptr};
+        if (status == wgpu::CreatePipelineAsyncStatus::Success) {
+          std::lock_guard<std::mutex> lock((*entry)->mutex);
+          (*entry)->compute_pipeline = std::move(pipeline);
+        } else {
+          LOGS_DEFAULT(WARNING) << "Failed to compile the pipeline of program \"" << (*entry)->name
+                                << "\" in the background: " << std::string_view{message};
+        }
+      },
+      new std::shared_ptr<PipelineCacheEntry>(entry));
+}
+
 }  // namespace webgpu
 }  // namespace onnxruntime
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "core/providers/webgpu/webgpu_external_header.h"
 
@@ -32,29 +36,65 @@ class ProgramArtifact {
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ProgramArtifact);
 };
 
+// The shader of a program in the pipeline cache, from which its compute pipeline is created without generating the
+// shader code again.
+struct PipelineCacheEntry {
+  std::string name;
+  std::string code;
+  // the values of the overridable constants of the shader, by name
+  std::vector<std::pair<std::string, double>> constants;
+  std::vector<int> shape_uniform_ranks;
+
+  // the pipeline compiled in the background after the entry was imported, if it is done
+  std::mutex mutex;
+  wgpu::ComputePipeline compute_pipeline;
+};
+
 class ProgramManager {
  public:
-  ProgramManager(const wgpu::Device& device, const wgpu::Limits& limits) : device_(device), limits_(limits) {}
+  // adapter_identity identifies the adapter and the version of onnxruntime, the pipeline cache of another adapter or
+  // version is not imported.
+  ProgramManager(const wgpu::Device& device, const wgpu::Limits& limits, std::string adapter_identity)
+      : device_(device), limits_(limits), adapter_identity_(std::move(adapter_identity)) {}
 
   Status NormalizeDispatchGroupSize(uint32_t& x, uint32_t& y, uint32_t& z) const;
 
   Status Build(const ProgramBase& program,
                const ProgramMetadata& metadata,
-#ifndef NDEBUG  // if debug build
                const std::string& program_key,
-#endif
                uint32_t normalized_dispatch_x,
                uint32_t normalized_dispatch_y,
                uint32_t normalized_dispatch_z,
                wgpu::ComputePipeline& compute_pipeline,
-               std::vector<int>& shape_uniform_ranks) const;
+               std::vector<int>& shape_uniform_ranks);
   const ProgramArtifact* Get(const std::string& key) const;
   const ProgramArtifact* Set(const std::string& key, ProgramArtifact&& program);
 
+  // The pipeline cache holds the shaders of the programs built since it was enabled, by program key. It is exported
+  // so that a later session, e.g. after a page load, imports it and creates the pipelines without generating the
+  // shaders. The pipelines of the imported shaders are compiled in the background.
+  //
+  // Imports the entries of a pipeline cache exported for the same adapter, and enables the cache. The data of
+  // another adapter or version is ignored.
+  Status ImportPipelineCache(const std::string& data);
+  Status ExportPipelineCache(std::string& data) const;
+
+  // Sets compute_pipeline and shape_uniform_ranks from the pipeline cache. Returns false if it has no entry for key.
+  bool BuildFromPipelineCache(const std::string& key,
+                              wgpu::ComputePipeline& compute_pipeline,
+                              std::vector<int>& shape_uniform_ranks) const;
+
  private:
+  // Starts compiling the pipeline of an imported entry in the background.
+  void CompileInBackground(const std::shared_ptr<PipelineCacheEntry>& entry) const;
+
   std::unordered_map<std::string, ProgramArtifact> programs_;
   const wgpu::Device& device_;
   const wgpu::Limits& limits_;
+  const std::string adapter_identity_;
+
+  bool pipeline_cache_enabled_ = false;
+  std::unordered_map<std::string, std::shared_ptr<PipelineCacheEntry>> pipeline_cache_;
 };
 
 }  // namespace webgpu
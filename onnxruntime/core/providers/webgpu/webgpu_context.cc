@@ -21,7 +21,9 @@
 
 #include "core/common/common.h"
 #include "core/common/path_string.h"
+#include "core/framework/binary_buffer.h"
 #include "core/platform/env.h"
+#include "onnxruntime_config.h"
 
 #include "core/providers/webgpu/compute_context.h"
 #include "core/providers/webgpu/webgpu_context.h"
@@ -149,10 +151,16 @@ void WebGpuContext::Initialize(const WebGpuBufferCacheConfig& buffer_cache_confi
     buffer_mgr_ = BufferManagerFactory::Create(*this,
                                                buffer_cache_config.storage.mode,
                                                buffer_cache_config.uniform.mode,
-                                               buffer_cache_config.query_resolve.mode);
+                                               buffer_cache_config.query_resolve.mode,
+                                               buffer_cache_config.storage.budget);
 
-    // create program manager
-    program_mgr_ = std::make_unique<ProgramManager>(Device(), DeviceLimits());
+    // create program manager, whose pipeline cache is only valid for the same adapter, driver and version
+    program_mgr_ = std::make_unique<ProgramManager>(
+        Device(), DeviceLimits(),
+        MakeString(ORT_VERSION, "|", std::string_view{adapter_info_.vendor}, "|",
+                   std::string_view{adapter_info_.architecture}, "|", std::string_view{adapter_info_.device}, "|",
+                   std::string_view{adapter_info_.description}, "|", static_cast<uint32_t>(adapter_info_.backendType),
+                   "|", adapter_info_.vendorID, "|", adapter_info_.deviceID));
 
     // set query type
 #if !defined(__wasm__)
@@ -177,6 +185,21 @@ void WebGpuContext::Initialize(const WebGpuBufferCacheConfig& buffer_cache_confi
   });
 }
 
+Status WebGpuContext::ImportPipelineCache(const std::string& file_path) {
+  std::string data;
+  // a missing file only enables the pipeline cache, so that it is exported for the next session
+  if (!ReadBinaryFile(ToPathString(file_path), data)) {
+    data.clear();
+  }
+  return program_mgr_->ImportPipelineCache(data);
+}
+
+Status WebGpuContext::ExportPipelineCache(const std::string& file_path) const {
+  std::string data;
+  ORT_RETURN_IF_ERROR(program_mgr_->ExportPipelineCache(data));
+  return WriteBinaryFileAtomically(ToPathString(file_path), data);
+}
+
 Status WebGpuContext::Wait(wgpu::Future f) {
   auto status = instance_.WaitAny(f, UINT64_MAX);
   if (status == wgpu::WaitStatus::Success) {
@@ -268,7 +291,7 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
 
   auto key = CalculateProgramCacheKey(program, is_1d_dispatch);
 
-  if (is_profiling_) {
+  if (is_profiling_ && !IsCapturing()) {
     PendingKernelInfo pending_kernel_info(context.KernelContext().GetNodeName(),
                                           context.KernelContext().GetOpType(),
                                           program.Name(),
@@ -284,17 +307,18 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
   if (program_artifact == nullptr) {
     wgpu::ComputePipeline compute_pipeline;
     std::vector<int> shape_uniform_ranks;
-    auto status = program_mgr_->Build(program,
-                                      metadata,
-#ifndef NDEBUG  // if debug build
-                                      key,
-#endif
-                                      x,
-                                      y,
-                                      z,
-                                      compute_pipeline,
-                                      shape_uniform_ranks);
-    ORT_RETURN_IF_ERROR(status);
+    // the programs of an imported pipeline cache skip generating their shader
+    if (!program_mgr_->BuildFromPipelineCache(key, compute_pipeline, shape_uniform_ranks)) {
+      auto status = program_mgr_->Build(program,
+                                        metadata,
+                                        key,
+                                        x,
+                                        y,
+                                        z,
+                                        compute_pipeline,
+                                        shape_uniform_ranks);
+      ORT_RETURN_IF_ERROR(status);
+    }
     program_artifact = program_mgr_->Set(key, ProgramArtifact{program,
                                                               std::move(compute_pipeline),
                                                               std::move(shape_uniform_ranks)});
@@ -401,10 +425,6 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
     device_.GetQueue().WriteBuffer(uniform_buffer, 0, uniform_data_buffer.data(), uniform_buffer_total_size);
   }
 
-  const auto& compute_pass_encoder = GetComputePassEncoder();
-
-  WriteTimestamp(num_pending_dispatches_ * 2);
-
   uint32_t entry_index = 0;
   std::vector<wgpu::BindGroupEntry> bind_group_entries;
   for (const auto& input : inputs) {
@@ -425,7 +445,18 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
 
   auto bind_group = Device().CreateBindGroup(&bind_group_desc);
 
-  // TODO support graph capture
+  if (IsCapturing()) {
+    // the uniform buffer is kept alive by the captured graph once released
+    captured_graph_->commands.push_back({program_artifact->compute_pipeline, bind_group, {x, y, z}, nullptr, nullptr, 0});
+    if (uniform_buffer) {
+      buffer_mgr_->Release(uniform_buffer);
+    }
+    return Status::OK();
+  }
+
+  const auto& compute_pass_encoder = GetComputePassEncoder();
+
+  WriteTimestamp(num_pending_dispatches_ * 2);
 
   compute_pass_encoder.SetPipeline(program_artifact->compute_pipeline);
   compute_pass_encoder.SetBindGroup(0, bind_group);
@@ -696,6 +727,47 @@ void WebGpuContext::Flush() {
   num_pending_dispatches_ = 0;
 }
 
+void WebGpuContext::CaptureBegin(CapturedGraph* captured_graph) {
+  ORT_ENFORCE(captured_graph != nullptr && !IsCapturing(), "A graph is already captured.");
+
+  // submit the commands of the previous runs, which are not part of the graph
+  Flush();
+
+  captured_graph_ = captured_graph;
+  buffer_mgr_->BeginCapture(&captured_graph->buffers);
+}
+
+void WebGpuContext::CaptureEnd() {
+  ORT_ENFORCE(IsCapturing(), "No graph is captured.");
+  buffer_mgr_->EndCapture();
+  captured_graph_ = nullptr;
+}
+
+void WebGpuContext::CaptureCopy(const wgpu::Buffer& src, WGPUBuffer dst, uint64_t size) {
+  ORT_ENFORCE(IsCapturing(), "No graph is captured.");
+  captured_graph_->commands.push_back({nullptr, nullptr, {0, 0, 0}, src, dst, size});
+}
+
+void WebGpuContext::Replay(const CapturedGraph& captured_graph) {
+  ORT_ENFORCE(!IsCapturing(), "A graph can't be replayed while a graph is captured.");
+
+  // the commands are encoded in a single command buffer, in which consecutive dispatches share a compute pass
+  for (const auto& command : captured_graph.commands) {
+    if (command.compute_pipeline) {
+      const auto& compute_pass_encoder = GetComputePassEncoder();
+      compute_pass_encoder.SetPipeline(command.compute_pipeline);
+      compute_pass_encoder.SetBindGroup(0, command.bind_group);
+      compute_pass_encoder.DispatchWorkgroups(command.dispatch_group[0], command.dispatch_group[1], command.dispatch_group[2]);
+    } else {
+      auto& command_encoder = GetCommandEncoder();
+      EndComputePass();
+      command_encoder.CopyBufferToBuffer(command.copy_src, 0, command.copy_dst, 0, command.copy_size);
+    }
+  }
+
+  Flush();
+}
+
 void WebGpuContext::OnRunEnd() {
 #if defined(ENABLE_PIX_FOR_WEBGPU_EP)
   if (pix_frame_generator_) {
@@ -39,6 +39,8 @@ struct WebGpuBufferCacheConfig {
   struct ConfigEntry {
     BufferCacheMode mode;
     std::string config_string;
+    // the maximum total size in bytes of the cached buffers for the generational mode. 0 for the default.
+    size_t budget = 0;
   };
   ConfigEntry storage;
   ConfigEntry uniform;
@@ -46,6 +48,24 @@ struct WebGpuBufferCacheConfig {
   ConfigEntry default_entry;
 };
 
+// A command recorded while a graph is captured: a dispatch of compute_pipeline, or a copy of copy_size bytes from
+// copy_src to copy_dst if compute_pipeline is null.
+struct CapturedCommandInfo {
+  wgpu::ComputePipeline compute_pipeline;
+  wgpu::BindGroup bind_group;
+  uint32_t dispatch_group[3];
+  wgpu::Buffer copy_src;
+  wgpu::Buffer copy_dst;
+  uint64_t copy_size;
+};
+
+// The commands of the runs of a graph, which are replayed as is as long as the inputs and outputs stay in the same
+// buffers, and the buffers released while the graph was captured, which they may use.
+struct CapturedGraph {
+  std::vector<CapturedCommandInfo> commands;
+  std::vector<wgpu::Buffer> buffers;
+};
+
 class WebGpuContextFactory {
  public:
   struct WebGpuContextInfo {
@@ -76,6 +96,11 @@ class WebGpuContext final {
 
   Status Wait(wgpu::Future f);
 
+  // Imports the pipeline cache of the program manager from a file, if it exists, and compiles its pipelines in the
+  // background. The cache records the programs built from then on, and is written back by ExportPipelineCache.
+  Status ImportPipelineCache(const std::string& file_path);
+  Status ExportPipelineCache(const std::string& file_path) const;
+
   const wgpu::Device& Device() const { return device_; }
 
   const wgpu::AdapterInfo& AdapterInfo() const { return adapter_info_; }
@@ -144,6 +169,19 @@ class WebGpuContext final {
   Status Run(ComputeContext& context, const ProgramBase& program);
   void OnRunEnd();
 
+  //
+  // Capture graph.
+  //
+  // While a graph is captured, the dispatches of the programs and the copies between buffers are recorded in
+  // captured_graph instead of being submitted, and are submitted by Replay. This skips the kernels, the programs
+  // lookup, the uniforms upload and the bind groups creation when the graph is replayed.
+  //
+  void CaptureBegin(CapturedGraph* captured_graph);
+  void CaptureEnd();
+  bool IsCapturing() const { return captured_graph_ != nullptr; }
+  void CaptureCopy(const wgpu::Buffer& src, WGPUBuffer dst, uint64_t size);
+  void Replay(const CapturedGraph& captured_graph);
+
   bool SupportsBufferMapExtendedUsages() const { return supports_buffer_map_extended_usages_; }
 
  private:
@@ -218,6 +256,8 @@ class WebGpuContext final {
   uint32_t num_pending_dispatches_ = 0;
   const uint32_t max_num_pending_dispatches_ = 16;
 
+  CapturedGraph* captured_graph_ = nullptr;
+
   // profiling
   TimestampQueryType query_type_;
   wgpu::QuerySet query_set_;
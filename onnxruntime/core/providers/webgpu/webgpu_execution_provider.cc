@@ -14,12 +14,15 @@
 #endif
 
 #include "allocator.h"
+#include "core/common/parse_string.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/fallback_cpu_capability.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/run_options.h"
 #include "core/graph/function_utils.h"
 #include "core/graph/indexed_sub_graph.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
 
 #include "core/providers/webgpu/webgpu_context.h"
 #include "core/providers/webgpu/data_transfer.h"
@@ -758,6 +761,7 @@ WebGpuExecutionProvider::WebGpuExecutionProvider(int context_id,
       context_{context},
       preferred_data_layout_{config.data_layout},
       force_cpu_node_names_{std::move(config.force_cpu_node_names)},
+      pipeline_cache_file_{std::move(config.pipeline_cache_file)},
       enable_graph_capture_{config.enable_graph_capture} {}
 
 std::vector<AllocatorPtr> WebGpuExecutionProvider::CreatePreferredAllocators() {
@@ -842,6 +846,15 @@ std::unique_ptr<onnxruntime::IExternalDataLoader> WebGpuExecutionProvider::GetEx
 #endif
 
 WebGpuExecutionProvider::~WebGpuExecutionProvider() {
+  if (!pipeline_cache_file_.empty()) {
+    auto status = context_.ExportPipelineCache(pipeline_cache_file_);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to export the WebGPU pipeline cache to " << pipeline_cache_file_ << ": "
+                            << status.ErrorMessage();
+    }
+  }
+  // the captured graphs hold buffers of the context
+  captured_graphs_.clear();
   WebGpuContextFactory::ReleaseContext(context_id_);
 }
 
@@ -858,7 +871,7 @@ Status WebGpuExecutionProvider::OnSessionInitializationEnd() {
   return Status::OK();
 }
 
-Status WebGpuExecutionProvider::OnRunStart(const onnxruntime::RunOptions& /*run_options*/) {
+Status WebGpuExecutionProvider::OnRunStart(const onnxruntime::RunOptions& run_options) {
   if (context_.ValidationMode() >= ValidationMode::Basic) {
     context_.PushErrorScope();
   }
@@ -867,20 +880,26 @@ Status WebGpuExecutionProvider::OnRunStart(const onnxruntime::RunOptions& /*run_
     context_.StartProfiling();
   }
 
-  if (IsGraphCaptureEnabled() && IsGraphCaptureAllowed() && !IsGraphCaptured(0)) {
-    ORT_NOT_IMPLEMENTED("graph capture not implemented");
+  const int graph_annotation_id = GetGraphAnnotationId(run_options);
+  if (IsGraphCaptureEnabled() && IsGraphCaptureAllowed(graph_annotation_id) && !IsGraphCaptured(graph_annotation_id)) {
+    LOGS(*GetLogger(), INFO) << "Capturing the WebGPU graph with annotation id: " << graph_annotation_id;
+    auto& captured_graph = captured_graphs_[graph_annotation_id];
+    captured_graph = std::make_unique<CapturedGraph>();
+    context_.CaptureBegin(captured_graph.get());
   }
   return Status::OK();
 }
 
-Status WebGpuExecutionProvider::OnRunEnd(bool /* sync_stream */, const onnxruntime::RunOptions& /*run_options*/) {
-  if (IsGraphCaptureEnabled() && !IsGraphCaptured(0)) {
-    if (IsGraphCaptureAllowed()) {
-      ORT_NOT_IMPLEMENTED("graph capture not implemented");
-      // is_graph_captured_ = true;
-    } else {
-      IncrementRegularRunCountBeforeGraphCapture();
-    }
+Status WebGpuExecutionProvider::OnRunEnd(bool /* sync_stream */, const onnxruntime::RunOptions& run_options) {
+  const int graph_annotation_id = GetGraphAnnotationId(run_options);
+  if (IsGraphCaptureEnabled() && context_.IsCapturing()) {
+    context_.CaptureEnd();
+    LOGS(*GetLogger(), INFO) << "Captured " << captured_graphs_[graph_annotation_id]->commands.size()
+                             << " WebGPU commands for the graph with annotation id: " << graph_annotation_id;
+    // the commands of the run were only recorded, so submit them now
+    context_.Replay(*captured_graphs_[graph_annotation_id]);
+  } else if (IsGraphCaptureEnabled() && !IsGraphCaptured(graph_annotation_id)) {
+    IncrementRegularRunCountBeforeGraphCapture(graph_annotation_id);
   }
 
   context_.Flush();
@@ -902,21 +921,47 @@ bool WebGpuExecutionProvider::IsGraphCaptureEnabled() const {
   return enable_graph_capture_;
 }
 
-bool WebGpuExecutionProvider::IsGraphCaptured(int) const {
-  return is_graph_captured_;
+bool WebGpuExecutionProvider::IsGraphCaptured(int graph_annotation_id) const {
+  // the graph being captured is only captured once the capture ends
+  return captured_graphs_.find(graph_annotation_id) != captured_graphs_.end() && !context_.IsCapturing();
 }
 
-Status WebGpuExecutionProvider::ReplayGraph(int) {
-  ORT_ENFORCE(IsGraphCaptured(0));
-  ORT_ENFORCE(false);
-  return Status::OK();
+Status WebGpuExecutionProvider::ReplayGraph(int graph_annotation_id) {
+  ORT_ENFORCE(IsGraphCaptured(graph_annotation_id));
+  if (context_.ValidationMode() >= ValidationMode::Basic) {
+    context_.PushErrorScope();
+  }
+
+  context_.Replay(*captured_graphs_.at(graph_annotation_id));
+
+  if (context_.ValidationMode() >= ValidationMode::Basic) {
+    return context_.PopErrorScope();
+  } else {
+    return Status::OK();
+  }
 }
 
-bool WebGpuExecutionProvider::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+int WebGpuExecutionProvider::GetGraphAnnotationId(const onnxruntime::RunOptions& run_options) const {
+  // If graph annotation is not provided, fall back to the one graph per session behavior
+  int graph_annotation_id = 0;
+  auto graph_annotation_str = run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation);
+  if (graph_annotation_str.has_value()) {
+    ORT_ENFORCE(TryParseStringWithClassicLocale<int>(*graph_annotation_str, graph_annotation_id),
+                "Failed to parse the graph annotation id: ", *graph_annotation_str);
+  }
+  return graph_annotation_id;
+}
+
+bool WebGpuExecutionProvider::IsGraphCaptureAllowed(int graph_annotation_id) const {
+  // the runs with the annotation id -1 are never captured
+  if (graph_annotation_id == -1) {
+    return false;
+  }
+  auto it = graph_id_to_run_count_.find(graph_annotation_id);
+  return it != graph_id_to_run_count_.end() && it->second >= min_num_runs_before_cuda_graph_capture_;
 }
 
-void WebGpuExecutionProvider::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+void WebGpuExecutionProvider::IncrementRegularRunCountBeforeGraphCapture(int graph_annotation_id) {
+  ++graph_id_to_run_count_[graph_annotation_id];
 }
 }  // namespace onnxruntime
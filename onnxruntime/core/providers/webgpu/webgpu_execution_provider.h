@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+
 #include "core/framework/execution_provider.h"
 #include "core/framework/session_options.h"
 #include "core/graph/constants.h"
@@ -21,6 +24,7 @@ class WebGpuContext;
 enum class BufferCacheMode;
 class WebGpuProfiler;
 class GpuBufferAllocator;
+struct CapturedGraph;
 }  // namespace webgpu
 
 struct WebGpuExecutionProviderConfig {
@@ -36,6 +40,8 @@ struct WebGpuExecutionProviderConfig {
   bool enable_graph_capture;
   bool enable_pix_capture;
   std::vector<std::string> force_cpu_node_names;
+  // the file the pipeline cache is imported from and exported to, if not empty
+  std::string pipeline_cache_file;
 };
 
 class WebGpuExecutionProvider : public IExecutionProvider {
@@ -79,16 +85,19 @@ class WebGpuExecutionProvider : public IExecutionProvider {
   Status ReplayGraph(int graph_annotation_id) override;
 
  private:
-  bool IsGraphCaptureAllowed() const;
-  void IncrementRegularRunCountBeforeGraphCapture();
+  int GetGraphAnnotationId(const onnxruntime::RunOptions& run_options) const;
+  bool IsGraphCaptureAllowed(int graph_annotation_id) const;
+  void IncrementRegularRunCountBeforeGraphCapture(int graph_annotation_id);
   int context_id_;
   webgpu::WebGpuContext& context_;
   webgpu::WebGpuProfiler* profiler_ = nullptr;
   DataLayout preferred_data_layout_;
   std::vector<std::string> force_cpu_node_names_;
+  std::string pipeline_cache_file_;
   bool enable_graph_capture_ = false;
-  bool is_graph_captured_ = false;
-  int regular_run_count_before_graph_capture_ = 0;
+  // the captured graphs and the number of regular runs before their capture, by graph annotation id
+  std::unordered_map<int, std::unique_ptr<webgpu::CapturedGraph>> captured_graphs_;
+  std::unordered_map<int, int> graph_id_to_run_count_;
   const int min_num_runs_before_cuda_graph_capture_ = 1;  // required min regular runs before graph capture for the necessary memory allocations.
   webgpu::GpuBufferAllocator* allocator_ = nullptr;
 };
@@ -88,6 +88,9 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
   }
   LOGS_DEFAULT(VERBOSE) << "WebGPU EP force CPU node count: " << webgpu_ep_config.force_cpu_node_names.size();
 
+  config_options.TryGetConfigEntry(kPipelineCacheFile, webgpu_ep_config.pipeline_cache_file);
+  LOGS_DEFAULT(VERBOSE) << "WebGPU EP pipeline cache file: " << webgpu_ep_config.pipeline_cache_file;
+
   //
   // STEP.2 - prepare WebGpuContextConfig
   //
@@ -210,6 +213,8 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
         return webgpu::BufferCacheMode::Simple;
       } else if (buffer_cache_mode_str == kBufferCacheMode_Bucket) {
         return webgpu::BufferCacheMode::Bucket;
+      } else if (buffer_cache_mode_str == kBufferCacheMode_Generational) {
+        return webgpu::BufferCacheMode::Generational;
       } else {
         ORT_THROW("Invalid buffer cache mode: ", config_entry_str);
       }
@@ -223,6 +228,17 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
   buffer_cache_config.storage.mode = parse_buffer_cache_mode(kStorageBufferCacheMode, webgpu::BufferCacheMode::Bucket);
   LOGS_DEFAULT(VERBOSE) << "WebGPU EP storage buffer cache mode: " << buffer_cache_config.storage.mode;
 
+  std::string storage_buffer_cache_budget_str;
+  if (config_options.TryGetConfigEntry(kStorageBufferCacheBudget, storage_buffer_cache_budget_str)) {
+    ORT_ENFORCE(std::errc{} ==
+                    std::from_chars(storage_buffer_cache_budget_str.data(),
+                                    storage_buffer_cache_budget_str.data() + storage_buffer_cache_budget_str.size(),
+                                    buffer_cache_config.storage.budget)
+                        .ec,
+                "Invalid storage buffer cache budget: ", storage_buffer_cache_budget_str);
+  }
+  LOGS_DEFAULT(VERBOSE) << "WebGPU EP storage buffer cache budget: " << buffer_cache_config.storage.budget;
+
   buffer_cache_config.uniform.mode = parse_buffer_cache_mode(kUniformBufferCacheMode, webgpu::BufferCacheMode::Simple);
   LOGS_DEFAULT(VERBOSE) << "WebGPU EP uniform buffer cache mode: " << buffer_cache_config.uniform.mode;
 
@@ -255,6 +271,15 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
   // Create WebGPU device and initialize the context.
   context.Initialize(buffer_cache_config, backend_type, enable_pix_capture);
 
+  // Start compiling the pipelines of the programs used by the earlier sessions.
+  if (!webgpu_ep_config.pipeline_cache_file.empty()) {
+    auto status = context.ImportPipelineCache(webgpu_ep_config.pipeline_cache_file);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to import the WebGPU pipeline cache from "
+                            << webgpu_ep_config.pipeline_cache_file << ": " << status.ErrorMessage();
+    }
+  }
+
   // Create WebGPU EP factory.
   return std::make_shared<WebGpuProviderFactory>(context_id, context, std::move(webgpu_ep_config));
 }
@@ -24,6 +24,8 @@ constexpr const char* kStorageBufferCacheMode = "WebGPU:storageBufferCacheMode";
 constexpr const char* kUniformBufferCacheMode = "WebGPU:uniformBufferCacheMode";
 constexpr const char* kQueryResolveBufferCacheMode = "WebGPU:queryResolveBufferCacheMode";
 constexpr const char* kDefaultBufferCacheMode = "WebGPU:defaultBufferCacheMode";
+// The maximum total size in bytes of the storage buffers kept by the generational buffer cache mode.
+constexpr const char* kStorageBufferCacheBudget = "WebGPU:storageBufferCacheBudget";
 
 constexpr const char* kValidationMode = "WebGPU:validationMode";
 
@@ -32,6 +34,10 @@ constexpr const char* kEnablePIXCapture = "WebGPU:enablePIXCapture";
 
 constexpr const char* kPreserveDevice = "WebGPU:preserveDevice";
 
+// The file of the pipeline cache: the shaders of the programs of the sessions, keyed by program and adapter. It is
+// imported when the session is created, compiling its pipelines in the background, and exported when it is released.
+constexpr const char* kPipelineCacheFile = "WebGPU:pipelineCacheFile";
+
 // The following are the possible values for the provider options.
 
 constexpr const char* kDawnBackendType_D3D12 = "D3D12";
@@ -53,6 +59,7 @@ constexpr const char* kBufferCacheMode_Disabled = "disabled";
 constexpr const char* kBufferCacheMode_LazyRelease = "lazyRelease";
 constexpr const char* kBufferCacheMode_Simple = "simple";
 constexpr const char* kBufferCacheMode_Bucket = "bucket";
+constexpr const char* kBufferCacheMode_Generational = "generational";
 
 constexpr const char* kValidationMode_Disabled = "disabled";
 constexpr const char* kValidationMode_wgpuOnly = "wgpuOnly";
@@ -0,0 +1,377 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+
+#include "core/providers/xnnpack/detail/ort_threadpool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include <pthreadpool.h>
+
+#include "core/platform/threadpool.h"
+
+// The pthreadpool API that XNNPACK calls, implemented on an ORT thread pool so that the XNNPACK kernels don't spin up
+// a second pool of threads that contends with the intra-op thread pool of the session. The flags are ignored: the
+// denormal handling is the one that the session sets up for the threads of its pool.
+struct pthreadpool {
+  std::atomic<onnxruntime::concurrency::ThreadPool*> ort_thread_pool{nullptr};
+};
+
+namespace onnxruntime {
+namespace xnnpack {
+
+void SetOrtThreadPool(pthreadpool* threadpool, concurrency::ThreadPool* ort_thread_pool) {
+  if (threadpool != nullptr) {
+    threadpool->ort_thread_pool.store(ort_thread_pool, std::memory_order_release);
+  }
+}
+
+namespace {
+
+template <size_t N>
+using Index = std::array<size_t, N>;
+
+concurrency::ThreadPool* GetOrtThreadPool(pthreadpool_t threadpool) {
+  return threadpool != nullptr ? threadpool->ort_thread_pool.load(std::memory_order_acquire) : nullptr;
+}
+
+template <size_t N>
+size_t NumTiles(const Index<N>& range, const Index<N>& tile) {
+  size_t num_tiles = 1;
+  for (size_t d = 0; d < N; ++d) {
+    num_tiles *= (range[d] + tile[d] - 1) / tile[d];
+  }
+  return num_tiles;
+}
+
+// Sets start and size to the start and the size in each dimension of the tile with the given index, the tiles being
+// ordered like pthreadpool does, with the last dimension varying the fastest.
+template <size_t N>
+void GetTile(size_t tile_index, const Index<N>& range, const Index<N>& tile, Index<N>& start, Index<N>& size) {
+  for (size_t d = N; d-- > 0;) {
+    const size_t num_tiles = (range[d] + tile[d] - 1) / tile[d];
+    start[d] = (tile_index % num_tiles) * tile[d];
+    size[d] = std::min(tile[d], range[d] - start[d]);
+    tile_index /= num_tiles;
+  }
+}
+
+// Calls fn(start, size) for each tile of the range, with a task per tile on the ORT thread pool.
+template <size_t N, typename Fn>
+void ParallelizeTiles(pthreadpool_t threadpool, const Index<N>& range, const Index<N>& tile, const Fn& fn) {
+  const size_t num_tiles = NumTiles(range, tile);
+  if (num_tiles == 0) {
+    return;
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      GetOrtThreadPool(threadpool), static_cast<std::ptrdiff_t>(num_tiles), [&](std::ptrdiff_t tile_index) {
+        Index<N> start, size;
+        GetTile(static_cast<size_t>(tile_index), range, tile, start, size);
+        fn(start, size);
+      });
+}
+
+// Calls fn(thread_index, start, size) for each tile of the range. The tasks that take a thread index use it to pick
+// their scratch buffers, which XNNPACK allocates for pthreadpool_get_threads_count threads, so each task of the ORT
+// thread pool runs a contiguous share of the tiles with its own index.
+template <size_t N, typename Fn>
+void ParallelizeTilesWithThread(pthreadpool_t threadpool, const Index<N>& range, const Index<N>& tile, const Fn& fn) {
+  const size_t num_tiles = NumTiles(range, tile);
+  if (num_tiles == 0) {
+    return;
+  }
+
+  const size_t num_threads = std::min(pthreadpool_get_threads_count(threadpool), num_tiles);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      GetOrtThreadPool(threadpool), static_cast<std::ptrdiff_t>(num_threads), [&](std::ptrdiff_t thread_index) {
+        const size_t thread = static_cast<size_t>(thread_index);
+        const size_t end = num_tiles * (thread + 1) / num_threads;
+        for (size_t tile_index = num_tiles * thread / num_threads; tile_index < end; ++tile_index) {
+          Index<N> start, size;
+          GetTile(tile_index, range, tile, start, size);
+          fn(thread, start, size);
+        }
+      });
+}
+
+}  // namespace
+}  // namespace xnnpack
+}  // namespace onnxruntime
+
+using onnxruntime::xnnpack::Index;
+using onnxruntime::xnnpack::ParallelizeTiles;
+using onnxruntime::xnnpack::ParallelizeTilesWithThread;
+
+pthreadpool_t pthreadpool_create(size_t /*threads_count*/) {
+  return new pthreadpool();
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t threadpool) {
+  return static_cast<size_t>(onnxruntime::concurrency::ThreadPool::DegreeOfParallelism(
+      onnxruntime::xnnpack::GetOrtThreadPool(threadpool)));
+}
+
+void pthreadpool_destroy(pthreadpool_t threadpool) {
+  delete threadpool;
+}
+
+void pthreadpool_parallelize_1d(pthreadpool_t threadpool, pthreadpool_task_1d_t function, void* context,
+                                size_t range, uint32_t /*flags*/) {
+  ParallelizeTiles<1>(threadpool, {range}, {1}, [&](const Index<1>& start, const Index<1>&) {
+    function(context, start[0]);
+  });
+}
+
+void pthreadpool_parallelize_1d_with_thread(pthreadpool_t threadpool, pthreadpool_task_1d_with_thread_t function,
+                                            void* context, size_t range, uint32_t /*flags*/) {
+  ParallelizeTilesWithThread<1>(threadpool, {range}, {1},
+                                [&](size_t thread, const Index<1>& start, const Index<1>&) {
+                                  function(context, thread, start[0]);
+                                });
+}
+
+void pthreadpool_parallelize_1d_with_uarch(pthreadpool_t threadpool, pthreadpool_task_1d_with_id_t function,
+                                           void* context, uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                           size_t range, uint32_t /*flags*/) {
+  ParallelizeTiles<1>(threadpool, {range}, {1}, [&](const Index<1>& start, const Index<1>&) {
+    function(context, default_uarch_index, start[0]);
+  });
+}
+
+void pthreadpool_parallelize_1d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_1d_tile_1d_t function,
+                                        void* context, size_t range, size_t tile, uint32_t /*flags*/) {
+  ParallelizeTiles<1>(threadpool, {range}, {tile}, [&](const Index<1>& start, const Index<1>& size) {
+    function(context, start[0], size[0]);
+  });
+}
+
+void pthreadpool_parallelize_2d(pthreadpool_t threadpool, pthreadpool_task_2d_t function, void* context,
+                                size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiles<2>(threadpool, {range_i, range_j}, {1, 1}, [&](const Index<2>& start, const Index<2>&) {
+    function(context, start[0], start[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_with_thread(pthreadpool_t threadpool, pthreadpool_task_2d_with_thread_t function,
+                                            void* context, size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTilesWithThread<2>(threadpool, {range_i, range_j}, {1, 1},
+                                [&](size_t thread, const Index<2>& start, const Index<2>&) {
+                                  function(context, thread, start[0], start[1]);
+                                });
+}
+
+void pthreadpool_parallelize_2d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiles<2>(threadpool, {range_i, range_j}, {1, tile_j}, [&](const Index<2>& start, const Index<2>& size) {
+    function(context, start[0], start[1], size[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_2d_tile_1d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_j, uint32_t /*flags*/) {
+  ParallelizeTiles<2>(threadpool, {range_i, range_j}, {1, tile_j}, [&](const Index<2>& start, const Index<2>& size) {
+    function(context, default_uarch_index, start[0], start[1], size[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t threadpool, pthreadpool_task_2d_tile_1d_with_id_with_thread_t function, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t tile_j,
+    uint32_t /*flags*/) {
+  ParallelizeTilesWithThread<2>(threadpool, {range_i, range_j}, {1, tile_j},
+                                [&](size_t thread, const Index<2>& start, const Index<2>& size) {
+                                  function(context, default_uarch_index, thread, start[0], start[1], size[1]);
+                                });
+}
+
+void pthreadpool_parallelize_2d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiles<2>(threadpool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](const Index<2>& start, const Index<2>& size) {
+                        function(context, start[0], start[1], size[0], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_2d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiles<2>(threadpool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](const Index<2>& start, const Index<2>& size) {
+                        function(context, default_uarch_index, start[0], start[1], size[0], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_3d(pthreadpool_t threadpool, pthreadpool_task_3d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, uint32_t /*flags*/) {
+  ParallelizeTiles<3>(threadpool, {range_i, range_j, range_k}, {1, 1, 1},
+                      [&](const Index<3>& start, const Index<3>&) {
+                        function(context, start[0], start[1], start[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiles<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](const Index<3>& start, const Index<3>& size) {
+                        function(context, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_thread(pthreadpool_t threadpool,
+                                                    pthreadpool_task_3d_tile_1d_with_thread_t function, void* context,
+                                                    size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                                    uint32_t /*flags*/) {
+  ParallelizeTilesWithThread<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                                [&](size_t thread, const Index<3>& start, const Index<3>& size) {
+                                  function(context, thread, start[0], start[1], start[2], size[2]);
+                                });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_3d_tile_1d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiles<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](const Index<3>& start, const Index<3>& size) {
+                        function(context, default_uarch_index, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t threadpool, pthreadpool_task_3d_tile_1d_with_id_with_thread_t function, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t range_k,
+    size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTilesWithThread<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                                [&](size_t thread, const Index<3>& start, const Index<3>& size) {
+                                  function(context, default_uarch_index, thread, start[0], start[1], start[2],
+                                           size[2]);
+                                });
+}
+
+void pthreadpool_parallelize_3d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                        size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiles<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](const Index<3>& start, const Index<3>& size) {
+                        function(context, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_3d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                                   size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiles<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](const Index<3>& start, const Index<3>& size) {
+                        function(context, default_uarch_index, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_4d(pthreadpool_t threadpool, pthreadpool_task_4d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, uint32_t /*flags*/) {
+  ParallelizeTiles<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, 1},
+                      [&](const Index<4>& start, const Index<4>&) {
+                        function(context, start[0], start[1], start[2], start[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiles<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, tile_l},
+                      [&](const Index<4>& start, const Index<4>& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiles<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](const Index<4>& start, const Index<4>& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[2], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_4d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                                   size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiles<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](const Index<4>& start, const Index<4>& size) {
+                        function(context, default_uarch_index, start[0], start[1], start[2], start[3], size[2],
+                                 size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_5d(pthreadpool_t threadpool, pthreadpool_task_5d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                uint32_t /*flags*/) {
+  ParallelizeTiles<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, 1},
+                      [&](const Index<5>& start, const Index<5>&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiles<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, tile_m},
+                      [&](const Index<5>& start, const Index<5>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_l, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiles<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, tile_l, tile_m},
+                      [&](const Index<5>& start, const Index<5>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[3], size[4]);
+                      });
+}
+
+void pthreadpool_parallelize_6d(pthreadpool_t threadpool, pthreadpool_task_6d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                size_t range_n, uint32_t /*flags*/) {
+  ParallelizeTiles<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, 1},
+                      [&](const Index<6>& start, const Index<6>&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_n, uint32_t /*flags*/) {
+  ParallelizeTiles<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, tile_n},
+                      [&](const Index<6>& start, const Index<6>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5], size[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_m, size_t tile_n,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiles<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n},
+                      {1, 1, 1, 1, tile_m, tile_n}, [&](const Index<6>& start, const Index<6>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5], size[4],
+                                 size[5]);
+                      });
+}
+
+#endif  // defined(XNNPACK_USE_ORT_THREADPOOL)
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+
+struct pthreadpool;
+
+namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
+
+namespace xnnpack {
+
+// When XNNPACK_USE_ORT_THREADPOOL is defined, the pthreadpool API that XNNPACK calls is implemented by
+// ort_threadpool.cc, in place of the pthreadpool library, and runs the parallelize calls on an ORT thread pool.
+// This sets the ORT thread pool that runs the parallelize calls on threadpool, which run on the calling thread when
+// it's null. The number of threads of threadpool is the degree of parallelism of the ORT thread pool.
+void SetOrtThreadPool(pthreadpool* threadpool, concurrency::ThreadPool* ort_thread_pool);
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
+
+#endif  // defined(XNNPACK_USE_ORT_THREADPOOL)
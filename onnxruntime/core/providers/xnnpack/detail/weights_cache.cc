@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/detail/weights_cache.h"
+
+#include <unordered_map>
+
+#include "core/framework/murmurhash3.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+
+// The published weights caches by the key of the weights they hold.
+struct PublishedWeightsCaches {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, std::weak_ptr<WeightsCache>> caches;
+};
+
+PublishedWeightsCaches& GetPublishedWeightsCaches() {
+  static PublishedWeightsCaches published;
+  return published;
+}
+
+uint64_t ComputeWeightsKey(std::initializer_list<const Tensor*> weights) {
+  uint64_t key = 0;
+  for (const Tensor* tensor : weights) {
+    if (tensor == nullptr) {
+      continue;
+    }
+
+    uint64_t hash[2];
+    MurmurHash3::x86_128(tensor->DataRaw(), tensor->SizeInBytes(), static_cast<uint32_t>(key), hash);
+    key ^= hash[0] + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  }
+
+  return key;
+}
+
+}  // namespace
+
+Status WeightsCache::Create(std::shared_ptr<WeightsCache>& cache) {
+  xnn_weights_cache_t weights_cache = nullptr;
+  xnn_status status = xnn_create_weights_cache(&weights_cache);
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_create_weights_cache returned ", status);
+
+  cache.reset(new WeightsCache(weights_cache));
+  return Status::OK();
+}
+
+WeightsCache::~WeightsCache() {
+  xnn_delete_weights_cache(cache_);
+}
+
+Status WeightsCache::Finalize() {
+  // a soft finalization keeps room for the weights that are looked up, so the later sessions can use the cache
+  xnn_status status = xnn_finalize_weights_cache(cache_, xnn_weights_cache_finalization_kind_soft);
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_finalize_weights_cache returned ", status);
+
+  finalized_ = true;
+  return Status::OK();
+}
+
+Status SharedWeightsCache::CreateOperator(std::initializer_list<const Tensor*> weights,
+                                          const CreateOperatorFn& create, std::shared_ptr<WeightsCache>& cache) {
+  const uint64_t key = ComputeWeightsKey(weights);
+
+  std::shared_ptr<WeightsCache> published_cache;
+  {
+    auto& published = GetPublishedWeightsCaches();
+    std::lock_guard<std::mutex> lock(published.mutex);
+    if (auto it = published.caches.find(key); it != published.caches.end()) {
+      published_cache = it->second.lock();
+    }
+  }
+
+  if (published_cache && create(published_cache->Get()).IsOK()) {
+    cache = std::move(published_cache);
+    return Status::OK();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the cache is finalized if the EP instance is used by another session too
+  if (!session_cache_ || session_cache_->IsFinalized()) {
+    ORT_RETURN_IF_ERROR(WeightsCache::Create(session_cache_));
+  }
+
+  ORT_RETURN_IF_ERROR(create(session_cache_->Get()));
+
+  session_keys_.push_back(key);
+  cache = session_cache_;
+  return Status::OK();
+}
+
+Status SharedWeightsCache::Finalize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!session_cache_ || session_cache_->IsFinalized()) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(session_cache_->Finalize());
+
+  auto& published = GetPublishedWeightsCaches();
+  std::lock_guard<std::mutex> published_lock(published.mutex);
+  for (auto it = published.caches.begin(); it != published.caches.end();) {
+    it = it->second.expired() ? published.caches.erase(it) : std::next(it);
+  }
+
+  for (uint64_t key : session_keys_) {
+    // keep the cache published earlier, which the operators of the other sessions use
+    published.caches.emplace(key, session_cache_);
+  }
+
+  session_keys_.clear();
+  return Status::OK();
+}
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/tensor.h"
+
+#include "xnnpack.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+// An XNNPACK weights cache, which holds the packed weights of the operators created with it.
+class WeightsCache {
+ public:
+  static Status Create(std::shared_ptr<WeightsCache>& cache);
+
+  ~WeightsCache();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WeightsCache);
+
+  xnn_weights_cache_t Get() const { return cache_; }
+
+  // The operators created with the cache can only run once it's finalized. The cache can still be looked up
+  // afterwards, but the weights it doesn't hold are not added to it.
+  Status Finalize();
+  bool IsFinalized() const { return finalized_; }
+
+ private:
+  explicit WeightsCache(xnn_weights_cache_t cache) : cache_{cache} {}
+
+  xnn_weights_cache_t cache_;
+  bool finalized_ = false;
+};
+
+/**
+ * Shares the packed weights of the XNNPACK operators across the sessions of the process.
+ *
+ * The operators of a session are created with the weights cache of the session, which is finalized when the
+ * initialization of the session ends and is then published, keyed by the content of the weights of each of its
+ * operators. The operators of the later sessions with the same weights are created with the published cache instead,
+ * so they don't hold another copy of the packed weights. XNNPACK compares the packed weights when it looks them up,
+ * so an operator whose weights are not in the published cache, e.g. after a key collision, is created again with the
+ * cache of its session.
+ */
+class SharedWeightsCache {
+ public:
+  // Creates the operator with the given weights cache.
+  using CreateOperatorFn = std::function<Status(xnn_weights_cache_t weights_cache)>;
+
+  // Creates an operator whose weights are the given tensors with create, and sets cache to the weights cache that
+  // holds its packed weights, which must outlive the operator.
+  Status CreateOperator(std::initializer_list<const Tensor*> weights, const CreateOperatorFn& create,
+                        std::shared_ptr<WeightsCache>& cache);
+
+  // Finalizes the weights cache of the session and publishes it.
+  Status Finalize();
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<WeightsCache> session_cache_;
+  // The keys of the weights added to session_cache_.
+  std::vector<uint64_t> session_keys_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -140,56 +140,56 @@ Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
   // flags - 1 - for no transpose - 0 for transpose
   uint32_t flags = trans_B_ == CblasTrans ? 0 : XNN_FLAG_TRANSPOSE_WEIGHTS;
   auto code_cache = GetCodeCache();
-  auto weights_cache = GetWeightsCache();
-  xnn_status status = xnn_status::xnn_status_uninitialized;
-  struct xnn_operator* p = nullptr;
   float foutput_min = clip_min_max_ ? clip_min_max_->first : -std::numeric_limits<float>::infinity();
   float foutput_max = clip_min_max_ ? clip_min_max_->second : std::numeric_limits<float>::infinity();
-  if (op_compute_type_ == OpComputeType::op_compute_type_fp32) {
-    const float* bias_data = nullptr;
-    if (C_matrix_exists_) {
-      bias_data = tensor.Data<float>();
-    }
-    status = xnn_create_fully_connected_nc_f32(
-        trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_channels,
-        trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_channels,
-        trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_stride,
-        trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_stride,
-        B_->Data<float>(),                                           // const float* kernel,
-        bias_data,                                                   // const float* bias,
-        foutput_min, foutput_max,
-        flags,
-        code_cache, weights_cache,
-        &p);
-  } else if (op_compute_type_ == OpComputeType::op_compute_type_fp16) {
-    const MLFloat16* bias_data = nullptr;
-    if (C_matrix_exists_) {
-      bias_data = tensor.Data<MLFloat16>();
+  return CreateOperator({B_, C_matrix_exists_ ? &tensor : nullptr}, [&](xnn_weights_cache_t weights_cache) {
+    xnn_status status = xnn_status::xnn_status_uninitialized;
+    struct xnn_operator* p = nullptr;
+    if (op_compute_type_ == OpComputeType::op_compute_type_fp32) {
+      const float* bias_data = nullptr;
+      if (C_matrix_exists_) {
+        bias_data = tensor.Data<float>();
+      }
+      status = xnn_create_fully_connected_nc_f32(
+          trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_channels,
+          trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_channels,
+          trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_stride,
+          trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_stride,
+          B_->Data<float>(),                                           // const float* kernel,
+          bias_data,                                                   // const float* bias,
+          foutput_min, foutput_max,
+          flags,
+          code_cache, weights_cache,
+          &p);
+    } else if (op_compute_type_ == OpComputeType::op_compute_type_fp16) {
+      const MLFloat16* bias_data = nullptr;
+      if (C_matrix_exists_) {
+        bias_data = tensor.Data<MLFloat16>();
+      }
+      status = xnn_create_fully_connected_nc_f16(
+          trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_channels,
+          trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_channels,
+          trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_stride,
+          trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_stride,
+          B_->Data<MLFloat16>(),                                       // const MLFloat16* kernel,
+          bias_data,                                                   // const float* bias,
+          foutput_min, foutput_max,
+          flags,
+          code_cache, weights_cache,
+          &p);
     }
-    status = xnn_create_fully_connected_nc_f16(
-        trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_channels,
-        trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_channels,
-        trans_B_ == CblasNoTrans ? B_->Shape()[0] : B_->Shape()[1],  // size_t input_stride,
-        trans_B_ == CblasNoTrans ? B_->Shape()[1] : B_->Shape()[0],  // size_t output_stride,
-        B_->Data<MLFloat16>(),                                       // const MLFloat16* kernel,
-        bias_data,                                                   // const float* bias,
-        foutput_min, foutput_max,
-        flags,
-        code_cache, weights_cache,
-        &p);
-  }
-
-  if (status != xnn_status_success) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_create_fully_connected_nc_",
-                           OpTypeToString(op_compute_type_), " returned ", status);
-  }
-  op0_.reset(p);
 
-  return Status::OK();
+    if (status != xnn_status_success) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_create_fully_connected_nc_",
+                             OpTypeToString(op_compute_type_), " returned ", status);
+    }
+    op0_.reset(p);
+    return Status::OK();
+  });
 }
 
 Status Gemm::Compute(OpKernelContext* context) const {
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(context);
   const auto* A = context->Input<Tensor>(0);
   auto Y = context->Output(0, {M_, N_});
 
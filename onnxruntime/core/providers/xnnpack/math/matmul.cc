@@ -93,62 +93,55 @@ Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
 
   uint32_t flags = XNN_FLAG_TRANSPOSE_WEIGHTS;
 
-  xnn_status status = xnn_status::xnn_status_uninitialized;
-
-  struct xnn_operator* p = nullptr;
   b_shape_ = tensor.Shape();
   auto shape_broadcast = b_shape_.AsShapeVector();
   if (b_shape_.NumDimensions() == 1) {
     shape_broadcast.push_back(1);
   }
 
-#ifdef XNN_CACHE_ENABLE
   xnn_code_cache_t code_cache = GetCodeCache();
-  xnn_weights_cache_t weight_cache = GetWeightsCache();
-#else
-  xnn_code_cache_t code_cache = nullptr;
-  xnn_weights_cache_t weight_cache = nullptr;
-#endif
-
   float foutput_min = -std::numeric_limits<float>::infinity();
   float foutput_max = std::numeric_limits<float>::infinity();
-  if (op_type_ == OpComputeType::op_compute_type_fp32) {
-    status = xnn_create_fully_connected_nc_f32(
-        shape_broadcast[0],    // size_t input_channels,
-        shape_broadcast[1],    // size_t output_channels,
-        shape_broadcast[0],    // size_t input_stride,
-        shape_broadcast[1],    // size_t output_stride,
-        tensor.Data<float>(),  // const float* kernel,
-        nullptr,               // const float* bias,
-        foutput_min,
-        foutput_max,
-        flags,
-        code_cache,
-        weight_cache,
-        &p);
-  } else if (op_type_ == OpComputeType::op_compute_type_fp16) {
-    status = xnn_create_fully_connected_nc_f16(
-        shape_broadcast[0],        // size_t input_channels,
-        shape_broadcast[1],        // size_t output_channels,
-        shape_broadcast[0],        // size_t input_stride,
-        shape_broadcast[1],        // size_t output_stride,
-        tensor.Data<MLFloat16>(),  // const MLFloat16* kernel,
-        nullptr,                   // const MLFloat16* bias,
-        foutput_min,
-        foutput_max,
-        flags,
-        code_cache,
-        weight_cache,
-        &p);
-  }
-
-  if (status != xnn_status_success) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_create_fully_connected_nc_", op_type_str_, " returned ", status);
-  }
+  return CreateOperator({&tensor}, [&](xnn_weights_cache_t weights_cache) {
+    xnn_status status = xnn_status::xnn_status_uninitialized;
+    struct xnn_operator* p = nullptr;
+    if (op_type_ == OpComputeType::op_compute_type_fp32) {
+      status = xnn_create_fully_connected_nc_f32(
+          shape_broadcast[0],    // size_t input_channels,
+          shape_broadcast[1],    // size_t output_channels,
+          shape_broadcast[0],    // size_t input_stride,
+          shape_broadcast[1],    // size_t output_stride,
+          tensor.Data<float>(),  // const float* kernel,
+          nullptr,               // const float* bias,
+          foutput_min,
+          foutput_max,
+          flags,
+          code_cache,
+          weights_cache,
+          &p);
+    } else if (op_type_ == OpComputeType::op_compute_type_fp16) {
+      status = xnn_create_fully_connected_nc_f16(
+          shape_broadcast[0],        // size_t input_channels,
+          shape_broadcast[1],        // size_t output_channels,
+          shape_broadcast[0],        // size_t input_stride,
+          shape_broadcast[1],        // size_t output_stride,
+          tensor.Data<MLFloat16>(),  // const MLFloat16* kernel,
+          nullptr,                   // const MLFloat16* bias,
+          foutput_min,
+          foutput_max,
+          flags,
+          code_cache,
+          weights_cache,
+          &p);
+    }
 
-  op0_.reset(p);
+    if (status != xnn_status_success) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_create_fully_connected_nc_", op_type_str_, " returned ", status);
+    }
 
-  return Status::OK();
+    op0_.reset(p);
+    return Status::OK();
+  });
 }
 
 Status MatMul::Compute(OpKernelContext* ctx) const {
@@ -161,7 +154,7 @@ Status MatMul::Compute(OpKernelContext* ctx) const {
 
   xnn_status status = xnn_status_success;
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(ctx);
   if (op_type_ == OpComputeType::op_compute_type_fp32) {
     status = xnn_reshape_fully_connected_nc_f32(op0_.get(), a->Shape()[0], threadpool);
   } else if (op_type_ == OpComputeType::op_compute_type_fp16) {
@@ -87,7 +87,7 @@ Status Conv::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(context);
 
   // setup allocator/automated dellocate for workspace
   size_t workspace_size = 0;
@@ -519,11 +519,12 @@ ConvBase::ConvBase(const OpKernelInfo& info, bool is_transpose)
 }
 
 Status ConvBase::CreateKernel() {
-  auto ret = CreateXnnpackKernel(convbase_attrs_ref_, C_, M_, kernel_shape_, clip_min_max_, packed_w_,
-                                 B_, op0_,
-                                 GetCodeCache(), GetWeightsCache(),
-                                 quant_param_, conv_type_, is_transpose_);
-  return ret;
+  return CreateOperator({&packed_w_, B_}, [this](xnn_weights_cache_t weights_cache) {
+    return CreateXnnpackKernel(convbase_attrs_ref_, C_, M_, kernel_shape_, clip_min_max_, packed_w_,
+                               B_, op0_,
+                               GetCodeCache(), weights_cache,
+                               quant_param_, conv_type_, is_transpose_);
+  });
 }
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -237,7 +237,7 @@ Status MaxPool::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(context);
 
   auto reshape_fn = xnn_reshape_max_pooling2d_nhwc_f32;
   if (maxpool_type_ == OpComputeType::op_compute_type_qu8) {
@@ -253,7 +253,7 @@ Status Resize::ComputeInternal(OpKernelContext* ctx, const Tensor* input,
   auto C = X_shape[3];
   Tensor* output = ctx->Output(0, TensorShape(output_dims));
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(ctx);
 
   // setup allocator/automated dellocate for workspace
   size_t workspace_size = 0;
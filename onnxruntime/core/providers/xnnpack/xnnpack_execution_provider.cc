@@ -16,6 +16,7 @@
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
 #include "core/providers/xnnpack/detail/utils.h"
 #include "core/providers/xnnpack/detail/node_support_checker.h"
+#include "core/providers/xnnpack/detail/weights_cache.h"
 #include "core/providers/xnnpack/xnnpack_init.h"
 
 namespace onnxruntime {
@@ -156,6 +157,19 @@ using namespace xnnpack;
 
 XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProviderInfo& info)
     : IExecutionProvider{kXnnpackExecutionProvider} {
+  if (info.shared_weights_cache) {
+    shared_weights_cache_ = std::make_unique<SharedWeightsCache>();
+  }
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  // the XNNPACK kernels run on the intra-op thread pool of the session, which sets the number of threads.
+  if (info.xnn_thread_pool_size > 0) {
+    LOGS_DEFAULT(INFO) << "The XNNPACK EP runs on the ORT intra-op thread pool, so intra_op_num_threads is ignored. "
+                          "Set the intra-op thread pool size in the SessionOptions instead.";
+  }
+
+  xnnpack_thread_pool_ = pthreadpool_create(0);
+#else
   int xnn_thread_pool_size = info.xnn_thread_pool_size;
   int ort_thread_pool_size = info.session_options ? info.session_options->intra_op_param.thread_pool_size : 1;
   bool allow_intra_op_spinning = (info.session_options == nullptr) ||
@@ -179,6 +193,7 @@ XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProvide
     // pthreadpool is independent of ort-threadpoool, so we had better disable cpu spinning for ort-threadpool.
     xnnpack_thread_pool_ = pthreadpool_create(static_cast<size_t>(xnn_thread_pool_size));
   }
+#endif
 }
 
 std::vector<AllocatorPtr> XnnpackExecutionProvider::CreatePreferredAllocators() {
@@ -356,6 +371,15 @@ std::shared_ptr<KernelRegistry> XnnpackExecutionProvider::GetKernelRegistry() co
   return registry;
 }
 
+Status XnnpackExecutionProvider::OnSessionInitializationEnd() {
+  // the kernels were created and their weights packed, so the operators can use the weights cache from now on
+  if (shared_weights_cache_) {
+    ORT_RETURN_IF_ERROR(shared_weights_cache_->Finalize());
+  }
+
+  return Status::OK();
+}
+
 XnnpackExecutionProvider::~XnnpackExecutionProvider() {
   xnn_deinitialize();
   pthreadpool_destroy(xnnpack_thread_pool_);
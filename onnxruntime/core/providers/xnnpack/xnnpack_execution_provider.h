@@ -11,9 +11,14 @@
 
 struct pthreadpool;
 namespace onnxruntime {
+namespace xnnpack {
+class SharedWeightsCache;
+}
+
 // placeholder for future use. no options currently
 struct XnnpackExecutionProviderInfo {
   int xnn_thread_pool_size{0};
+  bool shared_weights_cache{false};
   const SessionOptions* session_options{nullptr};
   XnnpackExecutionProviderInfo() = default;
 
@@ -22,6 +27,10 @@ struct XnnpackExecutionProviderInfo {
     if (auto it = po.find("intra_op_num_threads"); it != po.end()) {
       xnn_thread_pool_size = std::stoi(it->second);
     }
+
+    if (auto it = po.find("shared_weights_cache"); it != po.end()) {
+      shared_weights_cache = it->second == "1";
+    }
   }
 };
 
@@ -49,10 +58,18 @@ class XnnpackExecutionProvider : public IExecutionProvider {
     return xnnpack_thread_pool_;
   }
 
+  // Returns the cache that shares the packed weights of the kernels across sessions, or null if it's disabled.
+  xnnpack::SharedWeightsCache* GetSharedWeightsCache() const {
+    return shared_weights_cache_.get();
+  }
+
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
+  Status OnSessionInitializationEnd() override;
+
  private:
   pthreadpool* xnnpack_thread_pool_{nullptr};
+  std::unique_ptr<xnnpack::SharedWeightsCache> shared_weights_cache_;
 };
 
 }  // namespace onnxruntime
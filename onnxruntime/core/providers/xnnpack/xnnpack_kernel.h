@@ -4,6 +4,8 @@
 #pragma once
 #include "core/framework/op_kernel.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
+#include "core/providers/xnnpack/detail/ort_threadpool.h"
+#include "core/providers/xnnpack/detail/weights_cache.h"
 #include "xnnpack.h"
 
 struct pthreadpool;
@@ -17,55 +19,43 @@ class XnnpackKernel : public OpKernel {
       : OpKernel{info},
         xnnpack_threadpool_{
             static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())->GetPrivateThreadPool()},
-        caches_{enable_caches} {
+        shared_weights_cache_{
+            enable_caches
+                ? static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())->GetSharedWeightsCache()
+                : nullptr} {
   }
-  [[nodiscard]] pthreadpool* GetThreadPool() const {
+  // Returns the thread pool to pass to the XNNPACK operators run by the Compute call with the given context.
+  [[nodiscard]] pthreadpool* GetThreadPool(OpKernelContext* context) const {
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+    SetOrtThreadPool(xnnpack_threadpool_, context->GetOperatorThreadPool());
+#else
+    ORT_UNUSED_PARAMETER(context);
+#endif
     return xnnpack_threadpool_;
   }
 
-  // see comment below about enabling code cache
-  // xnn_code_cache_t GetCodeCache() { return caches_.auto_code_cache.get();}
+  // NOTE: Currently creating/freeing the code cache is not exposed via the public xnnpack.h header so it's not used.
+  // If we need to use it, we'll need to add the 'src' directory of XNNPACK to the include path
+  // and #include "xnnpack/cache.h"
   xnn_code_cache_t GetCodeCache() { return nullptr; }
-  xnn_weights_cache_t GetWeightsCache() { return caches_.auto_weights_cache.get(); }
-
- private:
-  pthreadpool* xnnpack_threadpool_;
 
-  // Helper class to wrap usage of the XNNPACK weights and code caches.
-  // NOTE: Currently creating/freeing the code cache is not exposed via the public xnnpack.h header so usage is
-  // commented out. If we need to use it, we'll need to add the 'src' directory of XNNPACK to the include path
-  // and #include "xnnpack/cache.h"
-  struct Caches {
-    Caches(bool enable)
-        :  // auto_code_cache(nullptr, xnn_release_code_cache),
-          auto_weights_cache(nullptr, xnn_delete_weights_cache) {
-      if (enable) {
-#ifdef XNN_CACHE_ENABLE
-        xnn_status status = xnn_status_success;
-#if XNN_PLATFORM_JIT
-        // status = xnn_init_code_cache(&code_cache_);
-        // ORT_ENFORCE(status == xnn_status_success, "Failed to initialize XNNPACK code cache");)
-        // auto_code_cache.reset(&code_cache_);
-#endif
-        // status = xnn_init_weights_cache(&weights_cache_);
-        xnn_weights_cache_t weights_cache_provider = nullptr;
-        status = xnn_create_weights_cache(&weights_cache, 0);
-        ORT_ENFORCE(status == xnn_status_success, "Failed to create XNNPACK weights cache");
-        auto_weights_cache.reset(weights_cache);
-#endif
-      }
+  // Creates an XNNPACK operator whose weights are the given tensors with create. If the kernel enables the caches and
+  // the shared weights cache of the EP is enabled, the weights cache passed to create shares the packed weights with
+  // the operators with the same weights in the other sessions. Otherwise it's null.
+  Status CreateOperator(std::initializer_list<const Tensor*> weights,
+                        const SharedWeightsCache::CreateOperatorFn& create) {
+    if (shared_weights_cache_ == nullptr) {
+      return create(nullptr);
     }
 
-    // std::unique_ptr<xnn_code_cache, decltype(&xnn_release_code_cache)> auto_code_cache;
-    std::unique_ptr<xnn_weights_cache_provider, decltype(&xnn_delete_weights_cache)> auto_weights_cache;
-
-    // private:
-    // #if defined(XNN_CACHE_ENABLE) && XNN_PLATFORM_JIT
-    //   xnn_code_cache code_cache_;
-    // #endif
-  };
+    return shared_weights_cache_->CreateOperator(weights, create, weights_cache_);
+  }
 
-  Caches caches_;
+ private:
+  pthreadpool* xnnpack_threadpool_;
+  SharedWeightsCache* shared_weights_cache_;
+  // The weights cache that holds the packed weights of the operator, which must outlive it.
+  std::shared_ptr<WeightsCache> weights_cache_;
 };
 }  // namespace xnnpack
 }  // namespace onnxruntime
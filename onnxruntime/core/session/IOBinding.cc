@@ -2,15 +2,123 @@
 // Licensed under the MIT License.
 
 #include "core/session/IOBinding.h"
+
+#include <algorithm>
+#include <mutex>
+
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
 #include "core/framework/utils.h"
 
 namespace onnxruntime {
-IOBinding::IOBinding(const SessionState& session_state) : session_state_(session_state) {
+
+// Free output buffers of an IOBinding. Buffers are handed out as the storage of output tensors and come back when the
+// last reference to the tensor is released, which may happen on any thread and after the IOBinding is gone.
+class IOBinding::OutputBufferPool : public std::enable_shared_from_this<IOBinding::OutputBufferPool> {
+ public:
+  struct Buffer {
+    void* data;
+    size_t size_in_bytes;
+    AllocatorPtr allocator;
+  };
+
+  ~OutputBufferPool() {
+    for (auto& buffer : free_buffers_) {
+      buffer.allocator->Free(buffer.data);
+    }
+  }
+
+  // Sets the maximum number of free buffers kept by the pool.
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    Trim();
+  }
+
+  // Allocates a free buffer of size_in_bytes with allocator unless the pool already has one for the same device.
+  void Reserve(const AllocatorPtr& allocator, size_t size_in_bytes) {
+    const auto& device = allocator->Info().device;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& buffer : free_buffers_) {
+        if (buffer.size_in_bytes == size_in_bytes && buffer.allocator->Info().device == device) {
+          return;
+        }
+      }
+    }
+    void* data = allocator->Alloc(size_in_bytes);
+    if (data != nullptr) {
+      Release(Buffer{data, size_in_bytes, allocator});
+    }
+  }
+
+  // Creates a tensor in ort_value using a free buffer of the given size on device. Returns false if there is none.
+  bool TryCreateTensor(MLDataType element_type, const TensorShape& shape, const OrtDevice& device,
+                       size_t size_in_bytes, OrtValue& ort_value) {
+    Buffer buffer{};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = std::find_if(free_buffers_.begin(), free_buffers_.end(), [&](const Buffer& free_buffer) {
+        return free_buffer.size_in_bytes == size_in_bytes && free_buffer.allocator->Info().device == device;
+      });
+      if (it == free_buffers_.end()) {
+        return false;
+      }
+      buffer = std::move(*it);
+      free_buffers_.erase(it);
+    }
+
+    auto tensor = std::make_unique<Tensor>(element_type, shape, buffer.data, buffer.allocator->Info());
+    std::weak_ptr<OutputBufferPool> weak_pool = weak_from_this();
+    ort_value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+                   [weak_pool, buffer = std::move(buffer)](void* p) mutable {
+                     delete static_cast<Tensor*>(p);
+                     if (auto pool = weak_pool.lock()) {
+                       pool->Release(std::move(buffer));
+                     } else {
+                       buffer.allocator->Free(buffer.data);
+                     }
+                   });
+    return true;
+  }
+
+ private:
+  void Release(Buffer&& buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_buffers_.push_back(std::move(buffer));
+    Trim();
+  }
+
+  // frees the least recently released buffers above capacity. mutex_ must be held.
+  void Trim() {
+    while (free_buffers_.size() > capacity_) {
+      free_buffers_.front().allocator->Free(free_buffers_.front().data);
+      free_buffers_.pop_front();
+    }
+  }
+
+  std::mutex mutex_;
+  std::deque<Buffer> free_buffers_;
+  size_t capacity_ = 0;
+};
+
+namespace {
+// Maximum number of input shape combinations with an output shape history
+constexpr size_t kMaxOutputShapeHistories = 32;
+}  // namespace
+
+IOBinding::IOBinding(const SessionState& session_state, size_t output_prediction_history)
+    : session_state_(session_state),
+      output_prediction_history_(output_prediction_history) {
+  if (output_prediction_history_ > 0) {
+    output_buffer_pool_ = std::make_shared<OutputBufferPool>();
+  }
 }
 
+IOBinding::~IOBinding() = default;
+
 common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_value) {
   auto it = mapped_feed_names_.emplace(name, feed_names_.size());
 
@@ -94,9 +202,13 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    outputs_bound_to_device_.push_back(!ml_value.IsAllocated());
+    // the recorded output shapes are for the previous set of outputs
+    output_shape_history_.clear();
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    outputs_bound_to_device_[index] = !ml_value.IsAllocated();
   }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
@@ -108,6 +220,115 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  outputs_bound_to_device_.clear();
+  output_shape_history_.clear();
+  output_element_types_.clear();
+}
+
+common::Status IOBinding::PrepareOutputsForRun(
+    std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  current_input_shapes_.clear();
+  for (const auto& feed : feeds_) {
+    if (feed.IsTensor()) {
+      const auto dims = feed.Get<Tensor>().Shape().GetDims();
+      current_input_shapes_.push_back(static_cast<int64_t>(dims.size()));
+      current_input_shapes_.insert(current_input_shapes_.end(), dims.begin(), dims.end());
+    } else {
+      current_input_shapes_.push_back(-1);
+    }
+  }
+
+  const auto history = output_shape_history_.find(current_input_shapes_);
+  output_element_types_.resize(outputs_.size(), nullptr);
+  const auto num_outputs_bound_to_device = static_cast<size_t>(
+      std::count(outputs_bound_to_device_.begin(), outputs_bound_to_device_.end(), true));
+  output_buffer_pool_->SetCapacity(std::max<size_t>(output_prediction_history_ * num_outputs_bound_to_device, 1));
+
+  for (size_t i = 0, end = outputs_.size(); i < end; ++i) {
+    if (!outputs_bound_to_device_[i]) {
+      continue;
+    }
+
+    // the output of the previous run is not used as a pre-allocated output. if the caller released it, its buffer
+    // is back in the pool.
+    outputs_[i] = OrtValue();
+
+    MLDataType element_type = output_element_types_[i];
+    if (element_type == nullptr) {
+      continue;
+    }
+
+    if (history != output_shape_history_.end()) {
+      // predict the most frequent shape of the history, preferring the most recent one
+      const std::optional<TensorShape>* predicted_shape = nullptr;
+      size_t predicted_count = 0;
+      const auto& runs = history->second;
+      for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+        const auto& shape = (*run)[i];
+        if (!shape.has_value()) {
+          continue;
+        }
+        const auto count = static_cast<size_t>(std::count_if(runs.begin(), runs.end(), [&](const auto& other) {
+          return other[i] == shape;
+        }));
+        if (count > predicted_count) {
+          predicted_shape = &shape;
+          predicted_count = count;
+        }
+      }
+
+      const auto allocator = session_state_.GetAllocator(outputs_device_info_[i]);
+      if (predicted_shape != nullptr && allocator != nullptr) {
+        size_t size_in_bytes = 0;
+        ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(element_type, **predicted_shape, 0, size_in_bytes));
+        if (size_in_bytes > 0) {
+          output_buffer_pool_->Reserve(allocator, size_in_bytes);
+        }
+      }
+    }
+
+    fetch_allocators[i] = [pool = output_buffer_pool_, element_type](const TensorShape& shape,
+                                                                     const OrtDevice& location,
+                                                                     OrtValue& ort_value, bool& allocated) {
+      size_t size_in_bytes = 0;
+      ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(element_type, shape, 0, size_in_bytes));
+      // if no free buffer matches, 'allocated' stays false and the execution frame allocates the output
+      allocated = size_in_bytes > 0 &&
+                  pool->TryCreateTensor(element_type, shape, location, size_in_bytes, ort_value);
+      return Status::OK();
+    };
+  }
+
+  return Status::OK();
+}
+
+void IOBinding::RecordOutputShapes() {
+  std::vector<std::optional<TensorShape>> output_shapes(outputs_.size());
+  for (size_t i = 0, end = outputs_.size(); i < end; ++i) {
+    if (outputs_bound_to_device_[i] && outputs_[i].IsTensor()) {
+      const auto& tensor = outputs_[i].Get<Tensor>();
+      // string tensors own their elements so they can not use raw pooled buffers
+      if (!tensor.IsDataTypeString()) {
+        output_shapes[i] = tensor.Shape();
+        output_element_types_[i] = tensor.DataType();
+      }
+    }
+  }
+
+  auto history = output_shape_history_.find(current_input_shapes_);
+  if (history == output_shape_history_.end()) {
+    if (output_shape_history_.size() >= kMaxOutputShapeHistories) {
+      output_shape_history_.erase(output_shape_history_.begin());
+    }
+    history = output_shape_history_.emplace(current_input_shapes_, std::deque<std::vector<std::optional<TensorShape>>>{})
+                  .first;
+  }
+
+  auto& runs = history->second;
+  runs.push_back(std::move(output_shapes));
+  while (runs.size() > output_prediction_history_) {
+    runs.pop_front();
+  }
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -35,6 +39,11 @@ class SessionState;
  * session.Run(io_binding);
  *
  * vector<OrtValue>& outputs = io_binding->GetOutputs();
+ *
+ * If output prediction is enabled (see kOrtSessionOptionsIOBindingOutputPredictionHistory), the outputs bound to a
+ * device are allocated from a pool of buffers owned by the IOBinding instead of being kept from the previous Run().
+ * The pool is prepared from the output shapes of the last runs with the same input shapes, and a buffer goes back to
+ * the pool when the last reference to the output value using it is released.
  */
 class IOBinding {
  public:
@@ -93,7 +102,13 @@ class IOBinding {
    */
   void ClearOutputs();
   void ClearInputs();
-  IOBinding(const SessionState& session_state);
+
+  /**
+   * @param output_prediction_history Number of runs per input shapes whose output shapes are used to predict the
+   *        output buffers. 0 disables output prediction.
+   */
+  IOBinding(const SessionState& session_state, size_t output_prediction_history = 0);
+  ~IOBinding();
 
  private:
   friend InferenceSession;
@@ -106,9 +121,31 @@ class IOBinding {
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  // true for the outputs bound to a device rather than to a pre-allocated OrtValue
+  std::vector<bool> outputs_bound_to_device_;
+
+  // output prediction state. see PrepareOutputsForRun.
+  class OutputBufferPool;
+  const size_t output_prediction_history_;
+  std::shared_ptr<OutputBufferPool> output_buffer_pool_;
+  // output shapes of the last runs keyed by input shapes. nullopt for outputs that are not bound to a device or
+  // are not tensors.
+  std::map<std::vector<int64_t>, std::deque<std::vector<std::optional<TensorShape>>>> output_shape_history_;
+  std::vector<MLDataType> output_element_types_;
+  std::vector<int64_t> current_input_shapes_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
+  bool IsOutputPredictionEnabled() const { return output_prediction_history_ > 0; }
+
+  // Used by InferenceSession::Run when output prediction is enabled. Releases the outputs of the previous run that are
+  // bound to a device, prepares pooled buffers for their predicted shapes and adds the allocators serving them from the
+  // pool to fetch_allocators. An output whose actual shape has no free buffer in the pool is allocated as usual.
+  common::Status PrepareOutputsForRun(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // Adds the output shapes of a successful run to the history of the current input shapes.
+  void RecordOutputShapes();
+
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <future>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -19,6 +20,7 @@
 #include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
+#include "core/framework/arena_trimmer.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_frame.h"
@@ -40,11 +42,13 @@
 #include "core/graph/model.h"
 #include "core/graph/model_editor_api_types.h"
 #include "core/graph/model_saving_options.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/graph_optimizer_registry.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/selectors_actions/selector_action_transformer_apply_contexts.h"
@@ -71,6 +75,9 @@
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/micro_batcher.h"
+#include "core/session/shape_specializer.h"
+#include "core/session/pipeline_executor.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/session/user_logging_sink.h"
@@ -93,10 +100,19 @@
 #include "orttraining/core/optimizer/memory_optimizer/memory_optimizer.h"
 #endif
 
+#ifdef USE_CUDA
+#include "core/providers/cuda/cuda_provider_factory.h"
+#include "core/providers/cuda/cuda_execution_provider_info.h"
+#endif
+
 using namespace ONNX_NAMESPACE;
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
+#ifdef USE_CUDA
+ProviderInfo_CUDA& GetProviderInfo_CUDA();
+#endif  // USE_CUDA
+
 namespace {
 template <typename T>
 const T* GetDateFormatString();
@@ -153,7 +169,7 @@ static bool HasMemcpyNodes(const Graph& graph) {
   return false;
 }
 
-static bool AreAllComputeNodesAssignedToCudaOrJsOrDmlEp(const Graph& graph) {
+static bool AreAllComputeNodesAssignedToCudaOrJsOrDmlOrWebGpuEp(const Graph& graph) {
   bool nodes_on_cpu_and_cuda_and_js_and_dml_eps_only = true;
 
   for (const auto& node : graph.Nodes()) {
@@ -164,7 +180,8 @@ static bool AreAllComputeNodesAssignedToCudaOrJsOrDmlEp(const Graph& graph) {
         !(node_provider == kCudaExecutionProvider ||
           node_provider == kRocmExecutionProvider ||
           node_provider == kJsExecutionProvider ||
-          node_provider == kDmlExecutionProvider) &&
+          node_provider == kDmlExecutionProvider ||
+          node_provider == kWebGpuExecutionProvider) &&
         node_provider != kCpuExecutionProvider) {
       nodes_on_cpu_and_cuda_and_js_and_dml_eps_only = false;
       break;
@@ -380,9 +397,15 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   InitLogger(logging_manager_);  // this sets session_logger_ so that it can be used for logging after this point.
   TraceSessionOptions(session_options, false, *session_logger_);
 
+  initialization_stats_ = std::make_unique<profiling::InitializationStats>(
+      ParseStringWithClassicLocale<size_t>(session_options_.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsInitializationStatsMinInitializerBytes,
+          std::to_string(profiling::InitializationStats::kDefaultMinInitializerBytes))));
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_THROW_IF_ERROR(graph_transformer_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps));
+  graph_transformer_mgr_.SetInitializationStats(initialization_stats_.get());
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -415,6 +438,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
+  prefork_safe_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPreforkSafe, "0") == "1";
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -434,6 +458,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.numa_aware =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -715,7 +741,325 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+InferenceSession::InferenceSession(const InferenceSession& source_session, const SessionOptions& session_options)
+    :
+#if !defined(ORT_MINIMAL_BUILD)
+      graph_transformer_mgr_(session_options.max_num_graph_transformation_steps),
+#endif
+      external_intra_op_thread_pool_(source_session.GetIntraOpThreadPoolToUse()),
+      external_inter_op_thread_pool_(source_session.GetInterOpThreadPoolToUse()),
+      environment_(source_session.environment_) {
+  ConstructorCommon(session_options, environment_);
+
+  // everything produced by Load and Initialize is shared with, or copied from, the source session
+  execution_providers_ = source_session.execution_providers_;
+  model_ = source_session.model_;
+  model_location_ = source_session.model_location_;
+  session_state_ = source_session.session_state_;
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
+  custom_registries_ = source_session.custom_registries_;
+#endif
+  model_metadata_ = source_session.model_metadata_;
+  input_def_map_ = source_session.input_def_map_;
+  output_def_map_ = source_session.output_def_map_;
+  is_concurrent_run_supported_ = source_session.is_concurrent_run_supported_;
+  prepacked_weights_container_ = source_session.prepacked_weights_container_;
+#if !defined(ORT_MINIMAL_BUILD)
+  shared_initializers_ = source_session.shared_initializers_;
+#endif
+  cached_execution_provider_for_graph_replay_ = source_session.cached_execution_provider_for_graph_replay_;
+  is_model_loaded_ = true;
+  is_inited_ = true;
+
+  CreateArenaTrimmer();
+  CreateMicroBatcher();
+}
+
+void InferenceSession::CreateMicroBatcher() {
+  const size_t max_batch_size = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMicroBatchingMaxBatchSize, "0"));
+  if (max_batch_size <= 1) {
+    return;
+  }
+  const int64_t max_delay_us = ParseStringWithClassicLocale<int64_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMicroBatchingMaxDelayMicroseconds, "1000"));
+  auto* batching_thread_pool = GetIntraOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(batching_thread_pool) < 2) {
+    batching_thread_pool = nullptr;
+  }
+  micro_batcher_ = std::make_unique<MicroBatcher>(*this, max_batch_size, std::chrono::microseconds(max_delay_us),
+                                                  batching_thread_pool);
+}
+
+void InferenceSession::CreateArenaTrimmer() {
+  ArenaTrimPolicy policy;
+  policy.idle_timeout = std::chrono::milliseconds(ParseStringWithClassicLocale<int64_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsArenaTrimIdleTimeoutMs, "0")));
+  policy.max_reserved_to_in_use_ratio = ParseStringWithClassicLocale<double>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsArenaTrimMaxReservedRatio, "0"));
+  if (!policy.IsEnabled() || !session_state_) {
+    return;
+  }
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    LOGS(*session_logger_, WARNING) << "The arenas are not trimmed when graph capture is enabled.";
+    return;
+  }
+
+  std::vector<AllocatorPtr> arenas;
+  for (const auto& [device, allocator] : session_state_->GetAllocators()) {
+    if (allocator->Info().alloc_type == OrtArenaAllocator &&
+        std::find(arenas.begin(), arenas.end(), allocator) == arenas.end()) {
+      arenas.push_back(allocator);
+    }
+  }
+  if (arenas.empty()) {
+    return;
+  }
+  arena_trimmer_ = std::make_unique<ArenaTrimmer>(std::move(arenas), policy, current_num_runs_, *session_logger_);
+}
+
+void InferenceSession::CreateShapeSpecializer() {
+#if !defined(ORT_MINIMAL_BUILD)
+  const size_t min_runs = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShapeSpecializationMinRuns, "0"));
+  if (min_runs == 0 || !shape_specialization_supported_) {
+    return;
+  }
+  // The execution providers of the specialized session are created by Initialize, which only adds the CPU one.
+  if (execution_providers_.NumProviders() != 1 || execution_providers_.Get(kCpuExecutionProvider) == nullptr) {
+    LOGS(*session_logger_, INFO) << "Shape specialization is only supported with the CPU execution provider.";
+    return;
+  }
+
+  auto create_session = [this](const std::vector<FreeDimensionOverride>& overrides,
+                               std::unique_ptr<InferenceSession>& session) -> Status {
+    SessionOptions options = session_options_;
+    options.config_options.configurations.erase(kOrtSessionOptionsShapeSpecializationMinRuns);
+    options.free_dimension_overrides.insert(options.free_dimension_overrides.end(), overrides.begin(),
+                                            overrides.end());
+    // the specialized session runs on the thread pools of this session and reports to no profiler
+    options.use_per_session_threads = true;
+    options.enable_profiling = false;
+    session = std::make_unique<InferenceSession>(options, environment_, GetIntraOpThreadPoolToUse(),
+                                                 GetInterOpThreadPoolToUse());
+    if (!model_location_.empty()) {
+      ORT_RETURN_IF_ERROR(session->Load(model_location_));
+    } else {
+      ORT_RETURN_IF_ERROR(session->Load(shape_specialization_model_bytes_.data(),
+                                        static_cast<int>(shape_specialization_model_bytes_.size())));
+    }
+    return session->Initialize();
+  };
+  shape_specializer_ = std::make_unique<ShapeSpecializer>(model_->MainGraph().GetInputs(), min_runs,
+                                                          std::move(create_session), *session_logger_);
+#endif
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+common::Status InferenceSession::ShareInitializersAcrossSessions(const Graph& graph) {
+  const size_t min_bytes = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersMinBytes, "0"));
+  if (min_bytes == 0) {
+    return Status::OK();
+  }
+
+  auto& cache = environment_.GetSharedInitializerCache();
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  size_t shared_bytes = 0;
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (session_options_.initializers_to_share_map.count(name) > 0 ||
+        tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+#if !defined(DISABLE_SPARSE_TENSORS)
+        graph.IsSparseInitializer(name) ||
+#endif
+        graph.GetConstantInitializer(name, false) == nullptr) {
+      continue;
+    }
+    size_t size_in_bytes = 0;
+    if (!utils::GetSizeInBytesFromTensorProto<0>(*tensor_proto, &size_in_bytes).IsOK() || size_in_bytes < min_bytes) {
+      continue;
+    }
+    // the shared values are on CPU, and a copy to another device could not be shared
+    const auto consumers = graph.GetConsumerNodes(name);
+    if (consumers.empty() || !std::all_of(consumers.begin(), consumers.end(), [](const Node* node) {
+          return node->GetExecutionProviderType() == kCpuExecutionProvider;
+        })) {
+      continue;
+    }
+
+    OrtValue value;
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToOrtValue(Env::Default(), model_location_, *tensor_proto, cpu_allocator,
+                                                     value));
+    auto shared_value = cache.GetOrInsert(std::move(value));
+    ORT_RETURN_IF_ERROR(session_options_.AddInitializer(name.c_str(), shared_value.get()));
+    shared_initializers_.push_back(std::move(shared_value));
+    shared_bytes += size_in_bytes;
+  }
+
+  LOGS(*session_logger_, INFO) << shared_initializers_.size() << " initializers with " << shared_bytes
+                               << " bytes are shared with the other sessions of the environment.";
+  return Status::OK();
+}
+#endif
+
+Status InferenceSession::CreatePipelineExecutor() {
+#if !defined(ORT_MINIMAL_BUILD)
+  const std::string device_ids =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPipelineDeviceIds, "");
+  if (device_ids.empty()) {
+    return Status::OK();
+  }
+
+#if defined(USE_CUDA)
+  // the execution providers of the stages are created from the CUDA one, and Initialize adds the CPU one
+  const IExecutionProvider* cuda_ep = execution_providers_.Get(kCudaExecutionProvider);
+  if (cuda_ep == nullptr || execution_providers_.NumProviders() != 2) {
+    LOGS(*session_logger_, WARNING) << "Pipeline parallel execution is only supported with the CUDA execution "
+                                    << "provider.";
+    return Status::OK();
+  }
+
+  std::vector<OrtDevice> devices;
+  for (const auto& device_id_str : utils::SplitString(device_ids, ",")) {
+    OrtDevice::DeviceId device_id = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(std::string(device_id_str), device_id) && device_id >= 0,
+                      "Invalid value for ", kOrtSessionOptionsPipelineDeviceIds, ": ", device_ids);
+    devices.emplace_back(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, device_id);
+  }
+  const std::string num_micro_batches_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPipelineNumMicroBatches, "1");
+  size_t num_micro_batches = 1;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(num_micro_batches_str, num_micro_batches),
+                    "Invalid value for ", kOrtSessionOptionsPipelineNumMicroBatches, ": ", num_micro_batches_str);
+  if (devices.size() < 2) {
+    LOGS(*session_logger_, WARNING) << "Pipeline parallel execution needs at least 2 devices.";
+    return Status::OK();
+  }
+
+  auto& cuda_provider_info = GetProviderInfo_CUDA();
+  for (size_t i = 1; i < devices.size(); ++i) {
+    const Status status = cuda_provider_info.EnablePeerAccess(devices[i - 1].Id(), devices[i].Id());
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to enable peer access between CUDA devices " << devices[i - 1].Id()
+                                      << " and " << devices[i].Id() << ": " << status.ErrorMessage();
+    }
+  }
+
+  SessionOptions stage_options = session_options_;
+  for (const char* key : {kOrtSessionOptionsPipelineDeviceIds, kOrtSessionOptionsPipelineNumMicroBatches,
+                          kOrtSessionOptionsMicroBatchingMaxBatchSize, kOrtSessionOptionsShapeSpecializationMinRuns}) {
+    stage_options.config_options.configurations.erase(key);
+  }
+  // the stage sessions run on the thread pools of this session and report to no profiler
+  stage_options.use_per_session_threads = true;
+  stage_options.enable_profiling = false;
+  // the stage models are loaded from memory, with the external data of the initializers next to the model file
+  if (!model_location_.empty() &&
+      !stage_options.config_options.GetConfigEntry(kOrtSessionOptionsModelExternalInitializersFileFolderPath)) {
+    ORT_RETURN_IF_ERROR(stage_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsModelExternalInitializersFileFolderPath,
+        PathToUTF8String(std::filesystem::path(model_location_).parent_path().native()).c_str()));
+  }
+
+  const ProviderOptions cuda_options = cuda_ep->GetProviderOptions();
+  auto create_session = [&](size_t stage_index, const std::string& model_data,
+                            std::unique_ptr<InferenceSession>& session) -> Status {
+    ORT_RETURN_IF(model_data.size() > static_cast<size_t>(std::numeric_limits<int>::max()),
+                  "The model of pipeline stage ", stage_index, " is too large.");
+    ProviderOptions options = cuda_options;
+    options["device_id"] = std::to_string(devices[stage_index].Id());
+    CUDAExecutionProviderInfo info;
+    cuda_provider_info.CUDAExecutionProviderInfo__FromProviderOptions(options, info);
+
+    session = std::make_unique<InferenceSession>(stage_options, environment_, GetIntraOpThreadPoolToUse(),
+                                                 GetInterOpThreadPoolToUse());
+    ORT_RETURN_IF_ERROR(session->RegisterExecutionProvider(
+        cuda_provider_info.CreateExecutionProviderFactory(info)->CreateProvider()));
+    ORT_RETURN_IF_ERROR(session->Load(model_data.data(), static_cast<int>(model_data.size())));
+    return session->Initialize();
+  };
+  return PipelineExecutor::Create(*model_, devices, num_micro_batches, create_session, data_transfer_mgr_,
+                                  *session_logger_, pipeline_executor_);
+#else
+  LOGS(*session_logger_, WARNING) << "Pipeline parallel execution requires a build with the CUDA execution provider.";
+#endif  // defined(USE_CUDA)
+#endif  // !defined(ORT_MINIMAL_BUILD)
+  return Status::OK();
+}
+
+void InferenceSession::CreateSamplingProfiler() {
+  const uint32_t sampling_interval = ParseStringWithClassicLocale<uint32_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSamplingProfilerInterval, "0"));
+  if (sampling_interval == 0) {
+    return;
+  }
+  const auto& graph_viewer = session_state_->GetGraphViewer();
+  std::vector<profiling::SamplingProfiler::NodeInfo> nodes(graph_viewer.MaxNodeIndex());
+  for (const auto& node : graph_viewer.Nodes()) {
+    auto& info = nodes[node.Index()];
+    info.name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+    info.op_type = node.OpType();
+  }
+  session_state_->SetSamplingProfiler(
+      std::make_unique<profiling::SamplingProfiler>(std::move(nodes), sampling_interval));
+}
+
+common::Status InferenceSession::Clone(const std::string& session_logid,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<std::mutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session must be initialized to be cloned.");
+    }
+  }
+  if (pipeline_executor_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Sessions with pipeline parallel execution can't be cloned.");
+  }
+
+  SessionOptions clone_session_options = session_options_;
+  if (!session_logid.empty()) {
+    clone_session_options.session_logid = session_logid;
+  }
+  // the thread pools of this session are passed to the clone as external thread pools
+  clone_session_options.use_per_session_threads = true;
+  // the profiler the kernels report to is the one of this session
+  clone_session_options.enable_profiling = false;
+
+  clone.reset(new InferenceSession(*this, clone_session_options));
+  return Status::OK();
+}
+
 InferenceSession::~InferenceSession() {
+  // run the pending batches while the session is still complete
+  micro_batcher_.reset();
+  // wait for the specialized session to be created, as it uses this session
+  shape_specializer_.reset();
+  // the stage sessions run on the thread pools of this session
+  pipeline_executor_.reset();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // share the results tuned by this session with the later sessions and processes
+  const std::string tuning_results_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsTuningResultsFile, "");
+  if (is_inited_ && !tuning_results_file.empty()) {
+    std::vector<TuningResults> tuning_results;
+    for (const auto& provider : execution_providers_) {
+      const auto* tuning_ctx = provider->GetTuningContext();
+      if (tuning_ctx != nullptr && tuning_ctx->IsTuningEnabled()) {
+        tuning_results.emplace_back(tuning_ctx->GetTuningResults());
+      }
+    }
+    if (!tuning_results.empty()) {
+      auto status = inference_session_utils::MergeTuningResultsIntoFile(ToPathString(tuning_results_file),
+                                                                        tuning_results);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to save the tuning results to " << tuning_results_file << ": "
+                                        << status.ErrorMessage();
+      }
+    }
+  }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -855,7 +1199,12 @@ common::Status InferenceSession::RegisterExecutionProvider(const std::shared_ptr
   }
 
   p_exec_provider->SetLogger(session_logger_);
-  session_profiler_.AddEpProfilers(p_exec_provider->GetProfiler());
+  auto ep_profiler = p_exec_provider->GetProfiler();
+  if (ep_profiler &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingGpuKernelMetrics, "0") == "1") {
+    ep_profiler->EnableKernelMetrics();
+  }
+  session_profiler_.AddEpProfilers(std::move(ep_profiler));
   return execution_providers_.Add(provider_type, p_exec_provider);
 }
 
@@ -955,6 +1304,7 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  profiling::InitializationStats::ScopedPhase load_phase(initialization_stats_.get(), "model_load", event_name);
   ORT_TRY {
     std::lock_guard<std::mutex> l(session_mutex_);
     if (is_model_loaded_) {  // already loaded
@@ -1006,6 +1356,12 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 #endif
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelModelParsing, "0") == "1") {
+      return onnxruntime::Model::LoadInParallel(model_location_, model,
+                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                                *session_logger_, ModelOptions(true, strict_shape_type_inference),
+                                                GetIntraOpThreadPoolToUse());
+    }
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_,
                                     ModelOptions(true, strict_shape_type_inference));
@@ -1283,7 +1639,8 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   auto graph_optimizer_registry = std::make_unique<GraphOptimizerRegistry>(&session_options_,
                                                                            execution_providers_.Get(onnxruntime::kCpuExecutionProvider),
                                                                            session_logger_);
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, std::move(graph_optimizer_registry));
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, std::move(graph_optimizer_registry),
+                               initialization_stats_.get());
 
   // Run Ahead Of time function inlining
   if (const bool disable_aot_function_inlining =
@@ -1382,9 +1739,12 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   }
 
   // Do partitioning based on execution providers' capabilities.
-  ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(), transform_layout_fn,
-                                                       session_options_.config_options, *session_logger_,
-                                                       mode, debug_graph_fn));
+  {
+    profiling::InitializationStats::ScopedPhase partitioning_phase(initialization_stats_.get(), "partitioning");
+    ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(),
+                                                         transform_layout_fn, session_options_.config_options,
+                                                         *session_logger_, mode, debug_graph_fn));
+  }
 
   // apply Level2 and higher transformers.
   // we do not run Level 1 again as those transformers assume partitioning will run later to do node assignment.
@@ -1402,7 +1762,22 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
       cpu_regs = kernel_regs[0];
     }
     InsertCastTransformer insert_cast_transformer{"CastFloat16Transformer", cpu_regs};
-    ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(insert_cast_transformer, *session_logger_, graph));
+    bool casts_inserted = false;
+    ORT_RETURN_IF_ERROR_SESSIONID_(insert_cast_transformer.Apply(graph, casts_inserted, *session_logger_));
+
+#if !defined(DISABLE_CONTRIB_OPS)
+    // The float16 nodes without a CPU kernel now run in float32 between casts, which happens after the level 3
+    // transformers. Apply the NCHWc transformer again so that float16 convolutional networks use the blocked layout.
+    if (casts_inserted &&
+        session_options_.graph_optimization_level >= TransformerLevel::Level3 &&
+        optimizers_to_disable_.find("NchwcTransformer") == optimizers_to_disable_.cend() &&
+        MlasNchwcGetBlockSize() > 1 &&
+        optimizer_utils::GetOptimizationObjective(session_options_.config_options) !=
+            optimizer_utils::OptimizationObjective::kMemory) {
+      NchwcTransformer nchwc_transformer;
+      ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(nchwc_transformer, *session_logger_, graph));
+    }
+#endif
   }
 
   // Insert copy node/s.
@@ -1711,7 +2086,10 @@ Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
                                                                            providers.Get(onnxruntime::kCpuExecutionProvider),
                                                                            &logger);
 
-  GraphPartitioner partitioner(kernel_registry_manager, providers, std::move(graph_optimizer_registry));
+  GraphPartitioner partitioner(kernel_registry_manager, providers, std::move(graph_optimizer_registry),
+                               session_state.GetInitializationStats());
+  profiling::InitializationStats::ScopedPhase partitioning_phase(session_state.GetInitializationStats(),
+                                                                 "partitioning");
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph,
                                             session_state.GetMutableFuncMgr(),
                                             transform_layout_fn,
@@ -1789,6 +2167,7 @@ common::Status InferenceSession::Initialize() {
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  const auto initialization_start = profiling::InitializationStats::Clock::now();
 
   ORT_TRY {
     LOGS(*session_logger_, INFO) << "Initializing session.";
@@ -1830,6 +2209,10 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.numa_aware_arena =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
+      epi.use_large_pages =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseLargePages, "0") == "1";
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -1843,6 +2226,21 @@ common::Status InferenceSession::Initialize() {
     // re-acquire mutex
     std::lock_guard<std::mutex> l(session_mutex_);
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // The specialized session of CreateShapeSpecializer loads the model before it is optimized, without the
+    // initializers given in memory.
+    shape_specialization_supported_ =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShapeSpecializationMinRuns, "0") != "0";
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+    shape_specialization_supported_ = shape_specialization_supported_ &&
+                                      session_options_.external_initializers.empty() &&
+                                      session_options_.external_initializer_files_mmap.empty();
+#endif
+    if (shape_specialization_supported_ && model_location_.empty()) {
+      shape_specialization_supported_ = model_->ToProto().SerializeToString(&shape_specialization_model_bytes_);
+    }
+#endif
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
@@ -1857,11 +2255,29 @@ common::Status InferenceSession::Initialize() {
     }
 #endif
 
+    // a pipelined session runs the model in its stage sessions and needs no session state of its own
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreatePipelineExecutor());
+    if (pipeline_executor_) {
+      is_inited_ = true;
+      CreateMicroBatcher();
+      LOGS(*session_logger_, INFO) << "Session successfully initialized with " << pipeline_executor_->NumStages()
+                                   << " pipeline stages.";
+      return Status::OK();
+    }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
     session_activity_started_ = true;
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // the pre-packed forms of the initializers shared with other sessions are shared through the environment
+    if (prepacked_weights_container_ == nullptr &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersMinBytes, "0") != "0") {
+      prepacked_weights_container_ = &environment_.GetSharedInitializerCache().GetPrepackedWeightsContainer();
+    }
+#endif
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1874,6 +2290,7 @@ common::Status InferenceSession::Initialize() {
         session_profiler_,
         session_options_,
         prepacked_weights_container_);
+    session_state_->SetInitializationStats(initialization_stats_.get());
 
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
@@ -1889,6 +2306,26 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    if (auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider); cpu_ep != nullptr) {
+      auto* tuning_ctx = cpu_ep->GetTuningContext();
+      const auto& config_options = session_options_.config_options;
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+        tuning_ctx->EnableTunableOp();
+      }
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+        tuning_ctx->EnableTuning();
+      }
+      const std::string max_duration_ms =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "0");
+      int max_duration_ms_value = 0;
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_duration_ms, max_duration_ms_value),
+                        "Invalid value for ", kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, ": ",
+                        max_duration_ms);
+      if (max_duration_ms_value > 0) {
+        tuning_ctx->SetMaxTuningDurationMs(max_duration_ms_value);
+      }
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     const std::string node_stats_file = session_options_.config_options.GetConfigOrDefault(
         kOrtSessionOptionsCollectNodeMemoryStatsToFile, "");
@@ -2041,7 +2478,8 @@ common::Status InferenceSession::Initialize() {
           onnxruntime::kCudaExecutionProvider,
           onnxruntime::kRocmExecutionProvider,
           onnxruntime::kJsExecutionProvider,
-          onnxruntime::kDmlExecutionProvider};
+          onnxruntime::kDmlExecutionProvider,
+          onnxruntime::kWebGpuExecutionProvider};
 
       for (auto& it : graph_support_ep_list) {
         auto* target_ep = execution_providers_.Get(it);
@@ -2063,12 +2501,13 @@ common::Status InferenceSession::Initialize() {
           if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0 ||
               strcmp(target_ep->Type().c_str(), onnxruntime::kRocmExecutionProvider) == 0 ||
               strcmp(target_ep->Type().c_str(), onnxruntime::kJsExecutionProvider) == 0 ||
-              strcmp(target_ep->Type().c_str(), onnxruntime::kDmlExecutionProvider) == 0) {
+              strcmp(target_ep->Type().c_str(), onnxruntime::kDmlExecutionProvider) == 0 ||
+              strcmp(target_ep->Type().c_str(), onnxruntime::kWebGpuExecutionProvider) == 0) {
             // Ensure that all nodes have been partitioned to CUDA/JS or CPU EP && there are no memcpy nodes
             // The reasoning behind this logic is that certain shape nodes will be forced onto CPU
             // and as long as there are no memcpy nodes this is confirmation that no compute nodes have been placed on the CPU EP
             // which is all we care about.
-            if (!AreAllComputeNodesAssignedToCudaOrJsOrDmlEp(graph)) {
+            if (!AreAllComputeNodesAssignedToCudaOrJsOrDmlOrWebGpuEp(graph)) {
               LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature as requested by the user "
                                             << " as all compute graph nodes have not been partitioned to the "
                                             << target_ep->Type();
@@ -2169,6 +2608,10 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    ORT_RETURN_IF_ERROR_SESSIONID_(ShareInitializersAcrossSessions(graph));
+#endif
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
@@ -2222,13 +2665,65 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    const std::string tuning_results_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsTuningResultsFile, "");
+    if (!tuning_results_file.empty()) {
+      std::vector<TuningResults> file_tuning_results;
+      auto status = inference_session_utils::ParseTuningResultsFromFile(ToPathString(tuning_results_file),
+                                                                        file_tuning_results);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << status.ErrorMessage() << ". Ignoring...";
+      }
+
+      // the file holds the results of other devices and library versions, which are skipped silently
+      std::vector<TuningResults> valid_tuning_results;
+      for (auto& tr : file_tuning_results) {
+        const auto* provider = execution_providers_.Get(tr.ep);
+        const auto* tuning_ctx = provider != nullptr ? provider->GetTuningContext() : nullptr;
+        if (tuning_ctx != nullptr && tuning_ctx->GetTuningResultsValidator().ValidateAll(tr.validators).IsOK()) {
+          valid_tuning_results.push_back(std::move(tr));
+        }
+      }
+      LOGS(*session_logger_, INFO) << "Loading " << valid_tuning_results.size() << " of the "
+                                   << file_tuning_results.size() << " tuning results of " << tuning_results_file;
+      ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(valid_tuning_results, /*error_on_invalid*/ false,
+                                                      /*auto_enable*/ false));
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    CreateSamplingProfiler();
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingHardwareCounters, "0") == "1") {
+      session_state_->SetHardwareCounters(profiling::HardwareCounters::Create(*session_logger_));
+    }
+
+    const size_t memory_snapshot_interval = ParseStringWithClassicLocale<size_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingMemoryTimeline, "0"));
+    if (memory_snapshot_interval > 0) {
+      session_state_->SetMemoryTimeline(
+          std::make_unique<MemoryTimeline>(session_profiler_, memory_snapshot_interval));
+    }
+
+    if (execution_providers_.NumProviders() > 1) {
+      const auto& nodes = session_state_->GetGraphViewer().Nodes();
+      metrics_.SetNumCpuFallbackNodes(static_cast<size_t>(
+          std::count_if(nodes.begin(), nodes.end(), [](const Node& node) {
+            return node.GetExecutionProviderType() == kCpuExecutionProvider;
+          })));
+    }
+
     is_inited_ = true;
 
+    CreateShapeSpecializer();
+    CreateArenaTrimmer();
+    CreateMicroBatcher();
+    graph_capture_by_input_shapes_ =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsGraphCaptureByInputShapes, "0") == "1";
+
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
@@ -2237,6 +2732,14 @@ common::Status InferenceSession::Initialize() {
     // once the model is saved, we may remove unnecessary attributes for inference
     session_state_->PruneRemovableAttributes();
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+    // the graph is not modified after this point
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCompactGraphAfterInitialization,
+                                                           "0") == "1") {
+      graph.CompactForExecution();
+    }
+#endif
+
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
     env.GetTelemetryProvider().LogSessionCreation(
@@ -2266,6 +2769,8 @@ common::Status InferenceSession::Initialize() {
   if (session_profiler_.IsEnabled()) {
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp);
   }
+  initialization_stats_->Add("session_initialization", "",
+                             profiling::InitializationStats::Clock::now() - initialization_start);
 
   if (status.IsOK()) {
     for (auto& xp : execution_providers_) {
@@ -2591,6 +3096,14 @@ Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
 }
 #endif
 
+void InferenceSession::RecreateThreadPoolsAfterFork() const {
+  for (auto* tp : {GetIntraOpThreadPoolToUse(), GetInterOpThreadPoolToUse()}) {
+    if (tp != nullptr) {
+      tp->RecreateThreadsAfterFork();
+    }
+  }
+}
+
 namespace {
 // Concurrent runs counting and thread-pool spin control
 struct ThreadPoolSpinningSwitch {
@@ -2638,10 +3151,95 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, {});
+}
+
+int InferenceSession::GetGraphAnnotationIdForInputShapes(gsl::span<const std::string> feed_names,
+                                                        gsl::span<const OrtValue> feeds,
+                                                        gsl::span<const std::string> output_names,
+                                                        const std::vector<OrtValue>* p_fetches) {
+  // The ids given here start far from the small ids users pick in the run options.
+  constexpr int kFirstGraphAnnotationId = 1 << 24;
+  // Bounds the ids of the runs that bind new buffers for every run, which capture graphs that are never replayed.
+  constexpr size_t kMaxGraphAnnotationIds = 4096;
+  constexpr int kSkip = CachedExecutionProviderForGraphReplay::kGraphAnnotationSkip;
+
+  if (feed_names.size() != feeds.size() || p_fetches == nullptr || p_fetches->size() != output_names.size()) {
+    return kSkip;
+  }
+
+  std::string key;
+  const auto append_value = [&key](const std::string& name, const OrtValue& value) {
+    if (!value.IsAllocated() || !value.IsTensor()) {
+      return false;
+    }
+    const Tensor& tensor = value.Get<Tensor>();
+    const auto dims = tensor.Shape().GetDims();
+    const auto address = reinterpret_cast<uintptr_t>(tensor.DataRaw());
+    const size_t rank = dims.size();
+    key.append(name).push_back('\0');
+    key.append(reinterpret_cast<const char*>(&address), sizeof(address));
+    key.append(reinterpret_cast<const char*>(&rank), sizeof(rank));
+    key.append(reinterpret_cast<const char*>(dims.data()), dims.size_bytes());
+    return true;
+  };
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!append_value(feed_names[i], feeds[i])) {
+      return kSkip;
+    }
+  }
+  key.push_back('\0');
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (!append_value(output_names[i], (*p_fetches)[i])) {
+      return kSkip;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(graph_annotation_ids_mutex_);
+  auto it = graph_annotation_ids_.find(key);
+  if (it == graph_annotation_ids_.end()) {
+    if (graph_annotation_ids_.size() >= kMaxGraphAnnotationIds) {
+      return kSkip;
+    }
+    const int id = kFirstGraphAnnotationId + static_cast<int>(graph_annotation_ids_.size());
+    it = graph_annotation_ids_.emplace(std::move(key), id).first;
+  }
+  return it->second;
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  if (pipeline_executor_) {
+    return pipeline_executor_->Run(run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
+  if (shape_specializer_) {
+    if (InferenceSession* specialized_session = shape_specializer_->GetSession(feed_names, feeds)) {
+      return specialized_session->RunImpl(run_options, feed_names, feeds, output_names, p_fetches,
+                                          p_fetches_device_info, fetch_allocators);
+    }
+  }
+
+  // The graph annotation id is read from the run options, by the execution provider as well, so the run is made
+  // with a copy of them that holds the id for its shapes.
+  if (graph_capture_by_input_shapes_ && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
+      !run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation).has_value()) {
+    const int id = GetGraphAnnotationIdForInputShapes(feed_names, feeds, output_names, p_fetches);
+    RunOptions annotated_run_options = run_options;
+    ORT_RETURN_IF_ERROR(annotated_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation,
+                                                                            std::to_string(id).c_str()));
+    return RunImpl(annotated_run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                   fetch_allocators);
+  }
+
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  const auto run_start = std::chrono::steady_clock::now();
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
@@ -2661,6 +3259,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
   }
 
+  if (prefork_safe_) {
+    RecreateThreadPoolsAfterFork();
+  }
+
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
   const bool control_spinning = use_per_session_threads_ &&
@@ -2669,6 +3271,21 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* intra_tp = (control_spinning) ? thread_pool_.get() : nullptr;
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
+  metrics_.RecordConcurrentRuns(current_num_runs_.load(std::memory_order_relaxed));
+
+  concurrency::ThreadPool::RunPriority run_priority = concurrency::ThreadPool::RunPriority::kNormal;
+  const std::string run_priority_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigRunPriority, "normal");
+  if (run_priority_str == "low") {
+    run_priority = concurrency::ThreadPool::RunPriority::kLow;
+  } else if (run_priority_str == "high") {
+    run_priority = concurrency::ThreadPool::RunPriority::kHigh;
+  } else if (run_priority_str != "normal") {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for the run option ",
+                           kOrtRunOptionsConfigRunPriority, ": ", run_priority_str,
+                           ". It must be one of \"low\", \"normal\" and \"high\".");
+  }
+  concurrency::ThreadPool::RunPriorityScope run_priority_scope(GetIntraOpThreadPoolToUse(), run_priority);
 
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
@@ -2676,6 +3293,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
                                  << cached_execution_provider_for_graph_replay_.Type()
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag
                                  << " with graph annotation id: " << graph_annotation_id;
+    metrics_.RecordGraphReplay();
     ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph(graph_annotation_id));
   } else {
     InlinedVector<IExecutionProvider*> exec_providers_to_stop;
@@ -2765,6 +3383,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
       if (retval.IsOK()) {
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+                                     fetch_allocators,
                                      session_options_.execution_mode,
                                      run_options,
 #ifdef ORT_ENABLE_STREAM
@@ -2803,8 +3422,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!arenas_to_shrink.empty()) {
       ShrinkMemoryArenas(arenas_to_shrink);
     }
+
+    if (arena_trimmer_) {
+      arena_trimmer_->NotifyRunEnd();
+    }
   }
 
+  metrics_.RecordRun(retval.IsOK(), static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - run_start)
+                                        .count()));
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -2859,6 +3486,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const OrtValue* const> feeds,
                              gsl::span<const char* const> fetch_names,
                              gsl::span<OrtValue*> fetches) {
+  if (micro_batcher_ && MicroBatcher::CanBatch(&run_options, feeds, fetches)) {
+    std::promise<Status> batched_run;
+    auto batched_run_status = batched_run.get_future();
+    micro_batcher_->Submit(&run_options, feed_names, feeds, fetch_names, fetches,
+                           [&batched_run](const Status& status) { batched_run.set_value(status); });
+    return batched_run_status.get();
+  }
+
   size_t num_feeds = feed_names.size();
   size_t num_fetches = fetch_names.size();
   InlinedVector<std::string> feed_name_vec;
@@ -2933,12 +3568,26 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           RunAsyncCallbackFn callback,
                                           void* user_data) {
   size_t num_fetches = fetch_names.size();
+  if (prefork_safe_) {
+    RecreateThreadPoolsAfterFork();
+  }
   auto* tp = GetIntraOpThreadPoolToUse();
   if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
   }
+  if (micro_batcher_ && MicroBatcher::CanBatch(run_options, feeds, fetches)) {
+    micro_batcher_->Submit(run_options, feed_names, feeds, fetch_names, fetches,
+                           [fetches, num_fetches, callback, user_data](const Status& status) {
+                             callback(user_data, fetches.data(), status.IsOK() ? num_fetches : 0, ToOrtStatus(status));
+                           });
+    return Status::OK();
+  }
+  const auto scheduled = std::chrono::steady_clock::now();
   std::function<void()> run_fn = [run_options, feed_names, feeds, fetch_names, fetches, num_fetches,
-                                  callback, user_data, this]() {
+                                  callback, user_data, scheduled, this]() {
+    metrics_.RecordQueueWait(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                                       std::chrono::steady_clock::now() - scheduled)
+                                                       .count()));
     Status status = Status::OK();
     ORT_TRY {
       if (run_options) {
@@ -2958,7 +3607,39 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
     }
     callback(user_data, fetches.data(), status.IsOK() ? num_fetches : 0, ToOrtStatus(status));
   };  // run_fn
-  concurrency::ThreadPool::Schedule(tp, run_fn);
+
+  const size_t max_concurrent_runs = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsRunAsyncMaxConcurrentRuns, "0"));
+  if (max_concurrent_runs == 0) {
+    concurrency::ThreadPool::Schedule(tp, run_fn);
+    return Status::OK();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(async_runs_mutex_);
+    if (num_active_async_runs_ >= max_concurrent_runs) {
+      pending_async_runs_.push_back(std::move(run_fn));
+      return Status::OK();
+    }
+    ++num_active_async_runs_;
+  }
+  concurrency::ThreadPool::Schedule(tp, [this, run_fn = std::move(run_fn)]() {
+    run_fn();
+    // continue with the calls that queued up meanwhile rather than releasing the thread
+    for (;;) {
+      std::function<void()> next_run_fn;
+      {
+        std::lock_guard<std::mutex> lock(async_runs_mutex_);
+        if (pending_async_runs_.empty()) {
+          --num_active_async_runs_;
+          return;
+        }
+        next_run_fn = std::move(pending_async_runs_.front());
+        pending_async_runs_.pop_front();
+      }
+      next_run_fn();
+    }
+  });
   return Status::OK();
 }
 
@@ -2984,6 +3665,36 @@ common::Status InferenceSession::Run(const RunOptions& run_options, const NameML
   return Run(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
 }
 
+common::Status InferenceSession::RunMany(const RunOptions& run_options, gsl::span<const NameMLValMap> feeds,
+                                         gsl::span<const std::string> output_names,
+                                         std::vector<std::vector<OrtValue>>* p_fetches) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  const auto num_runs = feeds.size();
+  p_fetches->clear();
+  p_fetches->resize(num_runs);
+  std::vector<Status> statuses(num_runs);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      GetIntraOpThreadPoolToUse(), static_cast<std::ptrdiff_t>(num_runs), [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = Run(run_options, feeds[i], output_names, &(*p_fetches)[i]);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
+        ORT_CATCH(...) {
+          statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+        }
+      });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   {
     std::lock_guard<std::mutex> l(session_mutex_);
@@ -3042,16 +3753,38 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
       return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
     }
   }
+  if (pipeline_executor_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "IOBinding is not supported with pipeline parallel execution.");
+  }
+
+  size_t output_prediction_history = 0;
+  const std::string output_prediction_history_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsIOBindingOutputPredictionHistory, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(output_prediction_history_str, output_prediction_history),
+                    "Invalid value for ", kOrtSessionOptionsIOBindingOutputPredictionHistory, ": ",
+                    output_prediction_history_str);
 
-  *io_binding = std::make_unique<IOBinding>(*session_state_);
+  *io_binding = std::make_unique<IOBinding>(*session_state_, output_prediction_history);
   return Status::OK();
 }
 
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  if (!io_binding.IsOutputPredictionEnabled()) {
+    return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+               &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  }
+
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  ORT_RETURN_IF_ERROR(io_binding.PrepareOutputsForRun(fetch_allocators));
+  auto status = RunImpl(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                        &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(), fetch_allocators);
+  if (status.IsOK()) {
+    io_binding.RecordOutputShapes();
+  }
+  return status;
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -3064,6 +3797,7 @@ void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
   ss << file_prefix << "_" << GetCurrentTimeString<T>() << ".json";
   session_profiler_.StartProfiling(ss.str());
+  AttachHardwareCountersToNewThreads();
 }
 
 void InferenceSession::StartProfiling(const std::string& file_prefix) {
@@ -3078,11 +3812,35 @@ void InferenceSession::StartProfiling(const std::wstring& file_prefix) {
 
 void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
   session_profiler_.StartProfiling(logger_ptr);
+  AttachHardwareCountersToNewThreads();
+}
+
+void InferenceSession::AttachHardwareCountersToNewThreads() {
+  auto* hardware_counters = session_state_ ? session_state_->GetHardwareCounters() : nullptr;
+  if (hardware_counters != nullptr) {
+    hardware_counters->AttachToNewThreads();
+  }
+}
+
+void InferenceSession::RecordHardwareCountersSummary() {
+  auto* hardware_counters = session_state_ ? session_state_->GetHardwareCounters() : nullptr;
+  if (hardware_counters == nullptr) {
+    return;
+  }
+  for (const auto& [op_type, values] : hardware_counters->TakeOpTypeTotals()) {
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, op_type + "_hardware_counters",
+                                            session_profiler_.Start(),
+                                            {{"op_type", op_type},
+                                             {"hardware_counters",
+                                              values.ToJson(hardware_counters->HasCacheCounters(),
+                                                            hardware_counters->HasTlbCounter())}});
+  }
 }
 
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
+      RecordHardwareCountersSummary();
       return session_profiler_.EndProfiling();
     } else {
       LOGS(*session_logger_, VERBOSE) << "Profiler is disabled.";
@@ -3097,6 +3855,327 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::GetSampledLatencyStats(std::string& stats_json) const {
+  auto* sampling_profiler = session_state_ ? session_state_->GetSamplingProfiler() : nullptr;
+  if (sampling_profiler == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The sampling profiler is not enabled. Set the session config entry ",
+                           kOrtSessionOptionsSamplingProfilerInterval, " before initializing the session.");
+  }
+  stats_json = sampling_profiler->GetStatsJson();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetThreadPoolStats(std::string& stats_json) const {
+  const auto to_json = [](const concurrency::ThreadPool* tp) {
+    return tp ? concurrency::ThreadPool::GetStatistics(tp).ToJson() : std::string("null");
+  };
+  stats_json = "{\"intra_op\": " + to_json(GetIntraOpThreadPoolToUse()) +
+               ", \"inter_op\": " + to_json(GetInterOpThreadPoolToUse()) + "}";
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetInitializationStats(std::string& stats_json) const {
+  stats_json = initialization_stats_->GetStatsJson();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetAllocatorStats(std::string& stats_json) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session is not initialized.");
+  }
+
+  std::ostringstream ss;
+  ss << "[";
+  const char* separator = "";
+  for (const auto& [device, allocator] : session_state_->GetAllocators()) {
+    AllocatorStats stats;
+    allocator->GetStats(&stats);
+    ss << separator << "{\"name\": \"" << allocator->Info().name << "\""
+       << ", \"device_type\": " << static_cast<int>(device.Type())
+       << ", \"memory_type\": " << static_cast<int>(device.MemType())
+       << ", \"device_id\": " << device.Id()
+       << ", \"num_allocs\": " << stats.num_allocs
+       << ", \"num_reserves\": " << stats.num_reserves
+       << ", \"num_arena_extensions\": " << stats.num_arena_extensions
+       << ", \"num_arena_shrinkages\": " << stats.num_arena_shrinkages
+       << ", \"bytes_in_use\": " << stats.bytes_in_use
+       << ", \"total_allocated_bytes\": " << stats.total_allocated_bytes
+       << ", \"max_bytes_in_use\": " << stats.max_bytes_in_use
+       << ", \"max_alloc_size\": " << stats.max_alloc_size
+       << ", \"bytes_limit\": " << stats.bytes_limit
+       << ", \"num_chunk_cache_hits\": " << stats.num_chunk_cache_hits
+       << ", \"num_chunk_cache_misses\": " << stats.num_chunk_cache_misses
+       << ", \"large_page_bytes\": " << stats.large_page_bytes
+       << ", \"num_large_page_fallbacks\": " << stats.num_large_page_fallbacks << "}";
+    separator = ", ";
+  }
+  ss << "]";
+
+  stats_json = ss.str();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetMetrics(std::string& metrics_text) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session is not initialized.");
+  }
+
+  using profiling::SessionMetrics;
+  const std::string session_label = MakeString("session_id=\"", session_id_, "\"");
+  std::ostringstream ss;
+  metrics_.WriteOpenMetrics(ss, session_label);
+
+  SessionMetrics::WriteFamily(ss, "onnxruntime_session_concurrent_runs", "gauge",
+                              "Number of runs of the session in progress.");
+  ss << "onnxruntime_session_concurrent_runs{" << session_label << "} "
+     << current_num_runs_.load(std::memory_order_relaxed) << "\n";
+
+  if (session_state_) {
+    SessionMetrics::WriteFamily(ss, "onnxruntime_memory_patterns_cache_hits", "counter",
+                                "Number of runs that found the memory patterns of their input shapes in the cache.");
+    ss << "onnxruntime_memory_patterns_cache_hits_total{" << session_label << "} "
+       << session_state_->GetMemoryPatternsCacheHits() << "\n";
+    SessionMetrics::WriteFamily(ss, "onnxruntime_memory_patterns_cache_misses", "counter",
+                                "Number of runs that did not find the memory patterns of their input shapes in the cache.");
+    ss << "onnxruntime_memory_patterns_cache_misses_total{" << session_label << "} "
+       << session_state_->GetMemoryPatternsCacheMisses() << "\n";
+
+    struct AllocatorMetric {
+      const char* name;
+      const char* type;
+      const char* help;
+      int64_t AllocatorStats::*value;
+    };
+    static constexpr AllocatorMetric allocator_metrics[] = {
+        {"onnxruntime_allocator_bytes_in_use", "gauge", "Bytes allocated by the allocator and in use.",
+         &AllocatorStats::bytes_in_use},
+        {"onnxruntime_allocator_reserved_bytes", "gauge", "Bytes reserved by the allocator, e.g. by the arena regions.",
+         &AllocatorStats::total_allocated_bytes},
+        {"onnxruntime_allocator_max_bytes_in_use", "gauge", "Largest number of bytes in use by the allocator.",
+         &AllocatorStats::max_bytes_in_use},
+        {"onnxruntime_allocator_chunk_cache_hits", "counter", "Allocations served from the chunk cache of the arena.",
+         &AllocatorStats::num_chunk_cache_hits},
+        {"onnxruntime_allocator_chunk_cache_misses", "counter", "Allocations not found in the chunk cache of the arena.",
+         &AllocatorStats::num_chunk_cache_misses},
+        {"onnxruntime_allocator_large_page_bytes", "gauge", "Bytes allocated by the allocator on large pages.",
+         &AllocatorStats::large_page_bytes},
+        {"onnxruntime_allocator_large_page_fallbacks", "counter",
+         "Allocations that were to use large pages but used regular pages.",
+         &AllocatorStats::num_large_page_fallbacks},
+    };
+
+    std::vector<std::pair<std::string, AllocatorStats>> allocator_stats;
+    for (const auto& [device, allocator] : session_state_->GetAllocators()) {
+      AllocatorStats stats;
+      allocator->GetStats(&stats);
+      allocator_stats.emplace_back(
+          MakeString(session_label, ",allocator=\"", allocator->Info().name, "\",device_type=\"",
+                     static_cast<int>(device.Type()), "\",device_id=\"", device.Id(), "\""),
+          stats);
+    }
+    for (const auto& metric : allocator_metrics) {
+      SessionMetrics::WriteFamily(ss, metric.name, metric.type, metric.help);
+      const char* suffix = std::string_view(metric.type) == "counter" ? "_total" : "";
+      for (const auto& [labels, stats] : allocator_stats) {
+        ss << metric.name << suffix << "{" << labels << "} " << stats.*metric.value << "\n";
+      }
+    }
+  }
+
+  std::vector<std::pair<std::string, concurrency::ThreadPoolStatistics>> thread_pool_stats;
+  const std::pair<const char*, const concurrency::ThreadPool*> thread_pools[] = {
+      {"intra_op", GetIntraOpThreadPoolToUse()}, {"inter_op", GetInterOpThreadPoolToUse()}};
+  for (const auto& [pool_name, tp] : thread_pools) {
+    if (tp != nullptr) {
+      thread_pool_stats.emplace_back(MakeString(session_label, ",thread_pool=\"", pool_name, "\""),
+                                     concurrency::ThreadPool::GetStatistics(tp));
+    }
+  }
+
+  // the worker statistics are summed over the workers of each thread pool, the times are in nanoseconds
+  using Worker = concurrency::ThreadPoolStatistics::Worker;
+  struct WorkerMetric {
+    const char* name;
+    const char* type;
+    const char* help;
+    uint64_t (*value)(const Worker&);
+    bool is_time;
+  };
+  static constexpr WorkerMetric worker_metrics[] = {
+      {"onnxruntime_thread_pool_tasks", "counter", "Number of tasks run by the workers of the thread pool.",
+       [](const Worker& w) -> uint64_t { return w.tasks_run; }, false},
+      {"onnxruntime_thread_pool_queue_depth", "gauge",
+       "Number of tasks in the queues of the workers of the thread pool.",
+       [](const Worker& w) -> uint64_t { return w.queue_depth; }, false},
+      {"onnxruntime_thread_pool_steals", "counter", "Number of tasks stolen from the queues of the other workers.",
+       [](const Worker& w) -> uint64_t { return w.steals; }, false},
+      {"onnxruntime_thread_pool_spin_seconds", "counter",
+       "Time the workers of the thread pool spent spinning waiting for work.",
+       [](const Worker& w) -> uint64_t { return w.spin_ns; }, true},
+      {"onnxruntime_thread_pool_blocked_seconds", "counter",
+       "Time the workers of the thread pool spent blocked waiting for work.",
+       [](const Worker& w) -> uint64_t { return w.blocked_ns; }, true},
+  };
+  for (const auto& metric : worker_metrics) {
+    SessionMetrics::WriteFamily(ss, metric.name, metric.type, metric.help);
+    const char* suffix = std::string_view(metric.type) == "counter" ? "_total" : "";
+    for (const auto& [labels, stats] : thread_pool_stats) {
+      uint64_t sum = 0;
+      for (const auto& worker : stats.workers) {
+        sum += metric.value(worker);
+      }
+      ss << metric.name << suffix << "{" << labels << "} "
+         << (metric.is_time ? std::to_string(static_cast<double>(sum) / 1e9) : std::to_string(sum)) << "\n";
+    }
+  }
+  SessionMetrics::WriteFamily(ss, "onnxruntime_thread_pool_rejected_pushes", "counter",
+                              "Number of tasks rejected by a full queue of the thread pool.");
+  for (const auto& [labels, stats] : thread_pool_stats) {
+    ss << "onnxruntime_thread_pool_rejected_pushes_total{" << labels << "} " << stats.rejected_pushes << "\n";
+  }
+
+  ss << "# EOF\n";
+  metrics_text = ss.str();
+  return Status::OK();
+}
+
+namespace {
+
+using WarmUpShapes = std::unordered_map<std::string, TensorShapeVector>;
+
+// Parses "name:d0xd1x...,name:d0x...;..." into the shapes of the inputs of each warm-up.
+Status ParseWarmUpShapes(std::string_view shape_specs, std::vector<WarmUpShapes>& shape_sets) {
+  for (const auto set_spec : utils::SplitString(shape_specs, ";")) {
+    auto& shapes = shape_sets.emplace_back();
+    for (const auto input_spec : utils::SplitString(set_spec, ",")) {
+      const auto separator = input_spec.rfind(':');
+      ORT_RETURN_IF(separator == std::string_view::npos || separator == 0,
+                    "Invalid warm-up input shape '", input_spec, "', expected name:d0xd1x...");
+      TensorShapeVector dims;
+      for (const auto dim : utils::SplitString(input_spec.substr(separator + 1), "x")) {
+        int64_t value = 0;
+        ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(dim, value) && value >= 0,
+                          "Invalid dimension '", dim, "' in the warm-up input shape '", input_spec, "'");
+        dims.push_back(value);
+      }
+      shapes[std::string(input_spec.substr(0, separator))] = std::move(dims);
+    }
+  }
+
+  if (shape_sets.empty()) {
+    shape_sets.emplace_back();
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+common::Status InferenceSession::WarmUp(std::string_view shape_specs, std::string& report_json) {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session is not initialized.");
+  }
+
+  std::vector<WarmUpShapes> shape_sets;
+  ORT_RETURN_IF_ERROR(ParseWarmUpShapes(shape_specs, shape_sets));
+
+  // The initializers may be memory mapped or paged out since they were loaded.
+  constexpr size_t kPageSize = 4096;
+  size_t initializer_bytes = 0;
+  for (const auto& [idx, value] : session_state_->GetInitializedTensors()) {
+    if (!value.IsTensor()) {
+      continue;
+    }
+    const Tensor& tensor = value.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.IsDataTypeString()) {
+      continue;
+    }
+    const volatile char* data = static_cast<const char*>(tensor.DataRaw());
+    const size_t bytes = tensor.SizeInBytes();
+    for (size_t offset = 0; offset < bytes; offset += kPageSize) {
+      static_cast<void>(data[offset]);
+    }
+    initializer_bytes += bytes;
+  }
+
+  const auto& inputs = *GetModelInputs().second;
+  std::vector<std::string> output_names;
+  for (const auto* output : *GetModelOutputs().second) {
+    output_names.push_back(output->Name());
+  }
+  for (const auto& shapes : shape_sets) {
+    for (const auto& [name, dims] : shapes) {
+      ORT_RETURN_IF(std::none_of(inputs.begin(), inputs.end(), [&name = name](const NodeArg* input) {
+                      return input->Name() == name;
+                    }),
+                    "The warm-up shapes are given for '", name, "', which is not an input of the model.");
+    }
+  }
+  AllocatorPtr cpu_allocator = session_state_->GetAllocator(OrtDevice());
+
+  std::ostringstream ss;
+  ss << "{\"initializer_bytes_read\": " << initializer_bytes << ", \"runs\": [";
+  const char* separator = "";
+  for (const auto& shapes : shape_sets) {
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    std::string shapes_description;
+    for (const auto* input : inputs) {
+      const MLDataType type = utils::GetMLDataType(*input);
+      ORT_RETURN_IF_NOT(type->IsTensorType(), "Warm-up only supports tensor inputs, but input '", input->Name(),
+                        "' is not a tensor.");
+
+      TensorShapeVector dims;
+      const auto it = shapes.find(input->Name());
+      if (it != shapes.end()) {
+        dims = it->second;
+      } else {
+        const auto* shape = input->Shape();
+        ORT_RETURN_IF(shape == nullptr, "The shape of input '", input->Name(), "' shall be given for the warm-up.");
+        for (const auto& dim : shape->dim()) {
+          dims.push_back(dim.has_dim_value() ? dim.dim_value() : 1);
+        }
+      }
+
+      OrtValue feed;
+      Tensor::InitOrtValue(type->AsTensorType()->GetElementType(), TensorShape(dims), cpu_allocator, feed);
+      Tensor& feed_tensor = *feed.GetMutable<Tensor>();
+      if (!feed_tensor.IsDataTypeString()) {
+        memset(feed_tensor.MutableDataRaw(), 0, feed_tensor.SizeInBytes());
+      }
+      shapes_description += MakeString(shapes_description.empty() ? "" : ",", input->Name(), ":");
+      for (size_t i = 0; i < dims.size(); ++i) {
+        shapes_description += MakeString(i == 0 ? "" : "x", dims[i]);
+      }
+      feed_names.push_back(input->Name());
+      feeds.push_back(std::move(feed));
+    }
+
+    // The first run allocates the outputs. The second one reuses them, as runs with outputs bound by IOBinding do.
+    RunOptions run_options;
+    run_options.run_tag = "warm_up";
+    std::vector<OrtValue> fetches;
+    const auto first_start = std::chrono::steady_clock::now();
+    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, &fetches));
+    const auto second_start = std::chrono::steady_clock::now();
+    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, &fetches));
+    const auto end = std::chrono::steady_clock::now();
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    ss << separator << "{\"inputs\": \"" << shapes_description << "\""
+       << ", \"first_run_us\": " << duration_cast<microseconds>(second_start - first_start).count()
+       << ", \"second_run_us\": " << duration_cast<microseconds>(end - second_start).count() << "}";
+    separator = ", ";
+  }
+
+  std::string allocator_stats;
+  ORT_RETURN_IF_ERROR(GetAllocatorStats(allocator_stats));
+  ss << "], \"allocators\": " << allocator_stats << ", \"ready\": true}";
+
+  report_json = ss.str();
+  return Status::OK();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -3151,6 +4230,9 @@ Status InferenceSession::SetTuningResults(
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const {
+  if (!session_state_) {
+    return nullptr;
+  }
   return session_state_->GetAllocator(mem_info);
 }
 
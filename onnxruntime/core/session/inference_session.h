@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <map>
 #include <optional>
 #include <string>
@@ -10,10 +12,12 @@
 #include <filesystem>
 
 #include "core/common/common.h"
+#include "core/common/initialization_stats.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
+#include "core/common/session_metrics.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
@@ -51,11 +55,15 @@ class ModelProto;
 struct OrtModel;
 
 namespace onnxruntime {  // forward declarations
+class ArenaTrimmer;
 class CustomRegistry;
 class Environment;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
+class MicroBatcher;
+class ShapeSpecializer;
+class PipelineExecutor;
 struct Notification;
 
 #ifdef ENABLE_TRAINING
@@ -399,6 +407,20 @@ class InferenceSession {
                                    gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches);
 
+  /**
+   * Run a pre-loaded and pre-intialized model once for every element of feeds.
+   * The runs are tasks of the intra op thread pool so that they are executed concurrently, the parallel loops of
+   * their kernels share the threads of the pool.
+   * @param feeds named inputs of every run, owned by client code and should not be changed during execution of
+   *        this function.
+   * @param output_names output names
+   * @param p_fetches output values of every run in the order specified by output_names.
+   * @return OK if every run succeeded, the status of the first run that failed otherwise.
+   */
+  [[nodiscard]] common::Status RunMany(const RunOptions& run_options, gsl::span<const NameMLValMap> feeds,
+                                       gsl::span<const std::string> output_names,
+                                       std::vector<std::vector<OrtValue>>* p_fetches);
+
   /**
    * Creates a new binding object for binding inputs and outputs.
    * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -520,6 +542,58 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Get the kernel latency statistics gathered by the sampling profiler enabled with
+    * kOrtSessionOptionsSamplingProfilerInterval. Sessions created by Clone share the statistics of their source.
+    @param stats_json receives the statistics as a JSON object.
+    @return a failure status if the sampling profiler is not enabled.
+    */
+  [[nodiscard]] common::Status GetSampledLatencyStats(std::string& stats_json) const;
+
+  /**
+    * Get the queue and work stealing statistics of the intra-op and inter-op thread pools used by the session.
+    @param stats_json receives the statistics as a JSON object, see concurrency::ThreadPoolStatistics.
+    */
+  [[nodiscard]] common::Status GetThreadPoolStats(std::string& stats_json) const;
+
+  /**
+    * Get the statistics of the allocators used by the session, e.g. the number of allocations and arena extensions.
+    @param stats_json receives the statistics as a JSON array with an element per allocator.
+    @return a failure status if the session is not initialized.
+    */
+  [[nodiscard]] common::Status GetAllocatorStats(std::string& stats_json) const;
+
+  /**
+    * Get the time spent in the phases of loading and initializing the session, e.g. in each graph transformer and in
+    * the GetCapability and Compile calls of each execution provider.
+    @param stats_json receives the phases as a JSON array, see profiling::InitializationStats.
+    */
+  [[nodiscard]] common::Status GetInitializationStats(std::string& stats_json) const;
+
+  /**
+    * Get the metrics of the session for production monitoring: the number and latency of the runs, the queue wait of
+    * RunAsync, the usage of the allocators and thread pools, the nodes falling back to the CPU execution provider and
+    * the hit rates of the caches. The run counters are read without taking a lock.
+    @param metrics_text receives the metrics in OpenMetrics text format, labelled with the session id.
+    @return a failure status if the session is not initialized.
+    */
+  [[nodiscard]] common::Status GetMetrics(std::string& metrics_text) const;
+
+  /**
+    * Warm up the session before it serves requests, so that the first requests do not pay for the arena growth, the
+    * memory patterns, TunableOp tuning, graph capture, lazy compilation of execution providers and page faults on the
+    * weights. A byte of every page of the initializers in CPU memory is read, then the model runs twice with zeroed
+    * inputs of each set of shapes, the second time with the outputs pre-allocated so that graphs can be captured. The
+    * arenas keep the regions they grew to during the runs.
+    @param shape_specs the shapes of the inputs of each warm-up, e.g. "input_ids:1x128,mask:1x128;input_ids:8x512,..."
+           with sets separated by ';'. The dimensions that are not given are the ones of the model, with 1 for the
+           symbolic dimensions. An empty string warms up once with these default shapes.
+    @param report_json receives the bytes of initializers read, the duration of the runs per set of shapes and the
+           statistics of the allocators after the warm-up, as a JSON object.
+    @return a failure status if the session is not initialized, a shape is invalid or a run fails.
+    */
+  [[nodiscard]] common::Status WarmUp(std::string_view shape_specs, std::string& report_json);
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -570,6 +644,19 @@ class InferenceSession {
    */
   Status AddPrePackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container);
 
+  /**
+   * Create a session sharing the initialized model of this session: the optimized graph, the initializers, the
+   * pre-packed weights, the kernels, the execution providers and the thread pools. The clone only gets its own
+   * session id, logger and run statistics, so creating it repeats neither graph optimization, partitioning nor
+   * pre-packing. Node level profiling events of the clone are recorded by the profiler of this session.
+   * This session must be initialized and must outlive the clone.
+   * @param session_logid log id of the clone. The log id of this session is used if empty.
+   * @param clone the new session, ready to Run.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status Clone(const std::string& session_logid,
+                                     std::unique_ptr<InferenceSession>& clone) const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * CreateNodeStats recorder and enable collection of node statistics that is useful
@@ -650,6 +737,9 @@ class InferenceSession {
     }
   }
 
+  // Gives the thread pools new threads in a process forked after they were created. See kOrtSessionOptionsPreforkSafe.
+  void RecreateThreadPoolsAfterFork() const;
+
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
@@ -671,6 +761,50 @@ class InferenceSession {
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
+
+  // Used by Clone. Creates a session sharing the initialized state of source_session.
+  InferenceSession(const InferenceSession& source_session, const SessionOptions& session_options);
+
+  // Creates micro_batcher_ if micro batching is enabled in the session options.
+  void CreateMicroBatcher();
+
+  // Creates arena_trimmer_ if an arena trimming policy is set in the session options.
+  void CreateArenaTrimmer();
+
+  // Creates shape_specializer_ if shape specialization is enabled in the session options and supported.
+  void CreateShapeSpecializer();
+
+  // Creates pipeline_executor_ if pipeline parallel execution is enabled in the session options and supported.
+  [[nodiscard]] common::Status CreatePipelineExecutor();
+
+  // The graph annotation id of a run for the shapes and addresses of its feeds and fetches when
+  // session.graph_capture_by_input_shapes is enabled, or the id that disables graph capture for the run.
+  int GetGraphAnnotationIdForInputShapes(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                         gsl::span<const std::string> output_names,
+                                         const std::vector<OrtValue>* p_fetches);
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Replaces the large constant initializers of the CPU nodes of graph with the values shared by content with the
+  // other sessions of the environment, if enabled by kOrtSessionOptionsShareInitializersMinBytes.
+  [[nodiscard]] common::Status ShareInitializersAcrossSessions(const Graph& graph);
+#endif
+
+  // Creates the sampling profiler of session_state_ if it is enabled in the session options.
+  void CreateSamplingProfiler();
+
+  // Opens the hardware counters of the threads started since the counters were created, if they are enabled.
+  void AttachHardwareCountersToNewThreads();
+
+  // Records the hardware counter totals per op type as profiler events, if the counters are enabled.
+  void RecordHardwareCountersSummary();
+
+  // Implementation of Run. fetch_allocators are custom allocators for some of the fetches, keyed by fetch index.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   void SetLoggingManager(const SessionOptions& session_options,
                          const Environment& session_env);
   void ConstructorCommon(const SessionOptions& session_options,
@@ -793,13 +927,19 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Time spent in the phases of the loading and initialization of this session. Always recorded.
+  std::unique_ptr<profiling::InitializationStats> initialization_stats_;
+
+  // Counters of the runs of this session, see GetMetrics. Always recorded.
+  profiling::SessionMetrics metrics_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
 
   // Immutable state for each op in the model. Shared by all executors.
-  // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  // It has a dependency on execution_providers_. Shared with the sessions created by Clone.
+  std::shared_ptr<SessionState> session_state_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
@@ -812,6 +952,9 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // The session can be used in processes forked after it was initialized. See kOrtSessionOptionsPreforkSafe.
+  bool prefork_safe_ = false;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -856,6 +999,12 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // RunAsync calls waiting for one of the session.run_async_max_concurrent_runs threads of the intra-op thread pool
+  // running them. A thread finishing a run continues with the next waiting one.
+  std::mutex async_runs_mutex_;
+  std::deque<std::function<void()>> pending_async_runs_;  // GUARDED_BY(async_runs_mutex_)
+  size_t num_active_async_runs_ = 0;                       // GUARDED_BY(async_runs_mutex_)
+
   mutable std::mutex session_mutex_;         // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;             // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                   // GUARDED_BY(session_mutex_)
@@ -967,10 +1116,43 @@ class InferenceSession {
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
 
+  // Set when session.graph_capture_by_input_shapes is enabled. The annotation ids given to the runs, keyed by the
+  // names, shapes and data addresses of their feeds and fetches.
+  bool graph_capture_by_input_shapes_ = false;
+  std::mutex graph_annotation_ids_mutex_;
+  std::unordered_map<std::string, int> graph_annotation_ids_;
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Enable nodestats collection
   std::optional<NodeStatsRecorder> node_stats_recorder_;
 #endif
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The initializers shared with the other sessions of the environment, referenced by
+  // session_options_.initializers_to_share_map.
+  std::vector<std::shared_ptr<const OrtValue>> shared_initializers_;
+
+  // The model before it was optimized, serialized for the session of shape_specializer_ to load when the model
+  // was not loaded from a file. Empty otherwise.
+  std::string shape_specialization_model_bytes_;
+  bool shape_specialization_supported_ = false;
+#endif
+
+  // Routes the runs with the dominating input shapes to a specialized session when
+  // session.shape_specialization_min_runs is set.
+  std::unique_ptr<ShapeSpecializer> shape_specializer_;
+
+  // Runs the model as a pipeline of stage sessions on several devices when session.pipeline_device_ids is set. The
+  // session then has no session state of its own.
+  std::unique_ptr<PipelineExecutor> pipeline_executor_;
+
+  // Shrinks the arenas between runs when session.arena_trim_idle_timeout_ms or session.arena_trim_max_reserved_ratio
+  // is set.
+  std::unique_ptr<ArenaTrimmer> arena_trimmer_;
+
+  // Gathers concurrent Run/RunAsync calls into batched runs when session.micro_batching_max_batch_size is set.
+  // Declared last so it is destroyed, and its pending batches are run, before the rest of the session state.
+  std::unique_ptr<MicroBatcher> micro_batcher_;
 };
 
 struct SessionIOBinding {
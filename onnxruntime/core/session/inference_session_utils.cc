@@ -5,6 +5,10 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <algorithm>
+
+#include "core/framework/binary_buffer.h"
+
 namespace onnxruntime {
 
 //---------------------
@@ -110,6 +114,10 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -265,6 +273,63 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+Status ParseTuningResultsFromFile(const std::filesystem::path& file_path, std::vector<TuningResults>& results) {
+  results.clear();
+  std::string contents;
+  if (!ReadBinaryFile(file_path, contents)) {
+    return Status::OK();
+  }
+
+  Status status;
+  ORT_TRY {
+    results = json::parse(contents).get<std::vector<TuningResults>>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Tuning results file ", file_path.string(),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
+Status MergeTuningResultsIntoFile(const std::filesystem::path& file_path, const std::vector<TuningResults>& results) {
+  // read the file again right before replacing it, to keep the results written by other processes meanwhile
+  std::vector<TuningResults> merged;
+  if (!ParseTuningResultsFromFile(file_path, merged).IsOK()) {
+    // a corrupted file is replaced
+    merged.clear();
+  }
+
+  for (const auto& tr : results) {
+    auto it = std::find_if(merged.begin(), merged.end(), [&tr](const TuningResults& existing) {
+      return existing.ep == tr.ep && existing.validators == tr.validators;
+    });
+    if (it == merged.end()) {
+      merged.push_back(tr);
+      continue;
+    }
+    for (const auto& [op_signature, kernel_map] : tr.results) {
+      for (const auto& [params_signature, best_id] : kernel_map) {
+        it->results[op_signature][params_signature] = best_id;
+      }
+    }
+  }
+
+  std::string contents;
+  ORT_TRY {
+    contents = json(merged).dump();
+  }
+  ORT_CATCH(const std::exception& e) {
+    Status status;
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Tuning results cannot be serialized. Error message: ", e.what());
+    });
+    return status;
+  }
+  return WriteBinaryFileAtomically(file_path, contents);
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -9,6 +9,8 @@
 //
 // Includes to parse json session config from onnx model file
 //
+#include <filesystem>
+
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 #include "core/framework/session_options.h"
@@ -65,6 +67,14 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ bool& key_found,
                                            const logging::Logger& logger);
 
+// Reads the tuning results of a file written by MergeTuningResultsIntoFile. A missing file has no results.
+Status ParseTuningResultsFromFile(const std::filesystem::path& file_path,
+                                  /*out*/ std::vector<TuningResults>& results);
+
+// Merges results into the tuning results of the file, and replaces the file atomically. The results of the same EP
+// with the same validators are merged, with results taking precedence, and the others are added.
+Status MergeTuningResultsIntoFile(const std::filesystem::path& file_path, const std::vector<TuningResults>& results);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -31,18 +31,26 @@ LoraAdapter::Param::Param(OrtValue ort_value_mapped, OrtValue ort_value_device)
     : ort_value_mapped_(std::move(ort_value_mapped)), ort_value_device_(std::move(ort_value_device)) {
 }
 
+LoraAdapter::DeviceCopy::~DeviceCopy() {
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
 void LoraAdapter::Load(const std::filesystem::path& file_path) {
-  auto buffer = adapters::utils::LoadLoraAdapterBytes(file_path);
-  Load(std::move(buffer));
+  MemoryMap(file_path);
 }
 
 void LoraAdapter::Load(std::vector<uint8_t> buffer) {
+  // a copy in flight still reads the previous buffer
+  device_copy_.reset();
   adapter_ = adapters::utils::ValidateAndGetAdapterFromBytes(buffer);
   buffer_.emplace<BufferHolder>(std::move(buffer));
   InitializeParamsValues();
 }
 
 void LoraAdapter::MemoryMap(const std::filesystem::path& file_path) {
+  device_copy_.reset();
   auto [mapped_memory, file_size] = adapters::utils::MemoryMapAdapterFile(file_path);
   auto u8_span = ReinterpretAsSpan<const uint8_t>(gsl::make_span(mapped_memory.get(), file_size));
   adapter_ = adapters::utils::ValidateAndGetAdapterFromBytes(u8_span);
@@ -100,7 +108,32 @@ void LoraAdapter::InitializeParamsValues() {
   std::unordered_map<std::string, Param> params_values;
   params_values.reserve(params->size());
   // Re-work in two separate loops due to compiler issues
-  if (data_transfer) {
+  if (data_transfer && copy_to_device_async_) {
+    auto device_copy = std::make_unique<DeviceCopy>();
+    device_copy->src_dst_pairs.reserve(params->size());
+    for (const auto* param : *params) {
+      auto [name, ort_value] = adapters::utils::CreateOrtValueOverLoraParameter(*param);
+      const auto& src = ort_value.Get<Tensor>();
+      OrtValue ort_value_ondevice;
+      Tensor::InitOrtValue(src.DataType(), src.Shape(), device_allocator_, ort_value_ondevice);
+      device_copy->src_dst_pairs.emplace_back(&src, ort_value_ondevice.GetMutable<Tensor>());
+      Param lora_param(std::move(ort_value), std::move(ort_value_ondevice));
+      params_values.emplace(std::move(name), std::move(lora_param));
+    }
+
+    device_copy->data_transfer = std::move(data_transfer);
+    DeviceCopy* copy = device_copy.get();
+    // the status is read once the thread is joined
+    device_copy->thread = std::thread([copy]() {
+      for (const auto& [src, dst] : copy->src_dst_pairs) {
+        copy->status = copy->data_transfer->CopyTensor(*src, *dst);
+        if (!copy->status.IsOK()) {
+          break;
+        }
+      }
+    });
+    device_copy_ = std::move(device_copy);
+  } else if (data_transfer) {
     for (const auto* param : *params) {
       auto [name, ort_value] = adapters::utils::CreateOrtValueOverLoraParameter(*param);
       OrtValue ort_value_ondevice;
@@ -120,6 +153,18 @@ void LoraAdapter::InitializeParamsValues() {
   params_values_.swap(params_values);
 }
 
+Status LoraAdapter::WaitForDeviceCopy() const {
+  if (device_copy_ == nullptr) {
+    return Status::OK();
+  }
+
+  std::lock_guard<std::mutex> lock(device_copy_->mutex);
+  if (device_copy_->thread.joinable()) {
+    device_copy_->thread.join();
+  }
+  return device_copy_->status;
+}
+
 }  // namespace lora
 }  // namespace onnxruntime
 
@@ -130,7 +175,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapter, _In_ const ORTCHAR_T* adapter_fi
   std::unique_ptr<onnxruntime::lora::LoraAdapter> lora_adapter;
   if (allocator != nullptr) {
     auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
-    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr));
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr),
+                                                                    /*copy_to_device_async*/ true);
   } else {
     lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>();
   }
@@ -148,7 +194,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterFromArray, _In_ const void* bytes,
   std::unique_ptr<onnxruntime::lora::LoraAdapter> lora_adapter;
   if (allocator != nullptr) {
     auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
-    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr));
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr),
+                                                                    /*copy_to_device_async*/ true);
   } else {
     lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>();
   }
@@ -6,13 +6,17 @@
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
+#include "core/framework/data_transfer.h"
 #include "core/framework/ort_value.h"
 #include "core/platform/env.h"
 
 #include "lora/adapter_format_utils.h"
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <variant>
 #include <vector>
 #include <unordered_map>
@@ -21,13 +25,19 @@ namespace onnxruntime {
 namespace lora {
 
 /// <summary>
-/// Container to hold and access Lora Parameters
+/// Container to hold and access Lora Parameters.
+/// On CPU the parameters reference the tensors of the flatbuffer in place, with no copy.
 /// </summary>
 class LoraAdapter {
  public:
   LoraAdapter() = default;
-  explicit LoraAdapter(AllocatorPtr device_allocator)
-      : device_allocator_(std::move(device_allocator)) {}
+  /// <summary>
+  /// The parameters are also copied to the device of device_allocator. With copy_to_device_async the device
+  /// buffers are allocated when the adapter is loaded, and the data is copied on a background thread
+  /// so that loading does not block on the transfer. The copy completes before the parameters are output for a Run.
+  /// </summary>
+  explicit LoraAdapter(AllocatorPtr device_allocator, bool copy_to_device_async = false)
+      : device_allocator_(std::move(device_allocator)), copy_to_device_async_(copy_to_device_async) {}
   ~LoraAdapter() = default;
   LoraAdapter(const LoraAdapter&) = delete;
   LoraAdapter& operator=(const LoraAdapter&) = delete;
@@ -81,7 +91,8 @@ class LoraAdapter {
   }
 
   /// <summary>
-  /// Load parameters into memory from an adapter file and validates its format.
+  /// Load parameters from an adapter file and validates its format.
+  /// The file is memory mapped rather than read into a buffer.
   /// </summary>
   /// <param name="file_name">file name that can be opened</param>
   void Load(const std::filesystem::path& file_path);
@@ -142,6 +153,7 @@ class LoraAdapter {
   template <class NamesOutputIter, class TensorOutputIter>
   void OutputAdapterParameters(NamesOutputIter names_out,
                                TensorOutputIter tensor_out) const {
+    ORT_THROW_IF_ERROR(WaitForDeviceCopy());
     for (const auto& [name, param] : params_values_) {
       *names_out = name.c_str();
       ++names_out;
@@ -150,9 +162,27 @@ class LoraAdapter {
     }
   }
 
+  /// <summary>
+  /// Waits for the device copy started when the adapter was loaded with copy_to_device_async.
+  /// Returns immediately otherwise, or once the copy has completed.
+  /// </summary>
+  /// <returns>status of the copy</returns>
+  Status WaitForDeviceCopy() const;
+
  private:
   void InitializeParamsValues();
 
+  // The copy of the parameters to the device that runs on a background thread.
+  struct DeviceCopy {
+    ~DeviceCopy();
+    std::unique_ptr<IDataTransfer> data_transfer;
+    // Both tensors are owned by the OrtValues of the params, so they stay in place when the adapter is moved.
+    std::vector<std::pair<const Tensor*, Tensor*>> src_dst_pairs;
+    std::thread thread;
+    std::mutex mutex;  // serializes the waits for the thread
+    Status status;
+  };
+
   struct BufferHolder {
     explicit BufferHolder(std::vector<uint8_t> buffer) : buffer_(std::move(buffer)) {}
     std::vector<uint8_t> buffer_;
@@ -168,8 +198,10 @@ class LoraAdapter {
   std::variant<std::monostate, MemMapHolder, BufferHolder> buffer_;
 
   AllocatorPtr device_allocator_;
+  bool copy_to_device_async_{false};
   const adapters::Adapter* adapter_{nullptr};
   std::unordered_map<std::string, Param> params_values_;
+  std::unique_ptr<DeviceCopy> device_copy_;
 };
 
 }  // namespace lora
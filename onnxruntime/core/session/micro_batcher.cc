@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/micro_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/run_options.h"
+#include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+bool IsBatchableTensor(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString() &&
+         tensor.Shape().NumDimensions() > 0;
+}
+
+// Size in bytes of one row of tensor along its first dimension
+size_t RowSizeInBytes(const Tensor& tensor) {
+  return SafeInt<size_t>(tensor.Shape().SizeFromDimension(1)) * tensor.DataType()->Size();
+}
+}  // namespace
+
+MicroBatcher::MicroBatcher(InferenceSession& session, size_t max_batch_size, std::chrono::microseconds max_delay,
+                           concurrency::ThreadPool* thread_pool)
+    : session_(session),
+      max_batch_size_(max_batch_size),
+      max_delay_(max_delay),
+      thread_pool_(thread_pool),
+      cpu_allocator_(std::make_shared<CPUAllocator>()) {
+  batching_thread_ = std::thread([this]() { BatchingLoop(); });
+}
+
+MicroBatcher::~MicroBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  batching_thread_.join();
+}
+
+bool MicroBatcher::CanBatch(const RunOptions* run_options, gsl::span<const OrtValue* const> feeds,
+                            gsl::span<OrtValue* const> fetches) {
+  if (run_options != nullptr &&
+      (run_options->terminate || !run_options->config_options.configurations.empty() ||
+       !run_options->active_adapters.empty())) {
+    return false;
+  }
+  if (feeds.empty()) {
+    return false;
+  }
+  int64_t batch_size = -1;
+  for (const auto* feed : feeds) {
+    if (feed == nullptr || !IsBatchableTensor(*feed)) {
+      return false;
+    }
+    const int64_t feed_batch_size = feed->Get<Tensor>().Shape()[0];
+    if (feed_batch_size <= 0 || (batch_size != -1 && feed_batch_size != batch_size)) {
+      return false;
+    }
+    batch_size = feed_batch_size;
+  }
+  return std::all_of(fetches.begin(), fetches.end(), [](const OrtValue* fetch) { return fetch == nullptr; });
+}
+
+bool MicroBatcher::IsCompatible(const Request& request, const Request& other) {
+  const auto& run_options = request.run_options;
+  const auto& other_run_options = other.run_options;
+  if (run_options.run_tag != other_run_options.run_tag ||
+      run_options.run_log_severity_level != other_run_options.run_log_severity_level ||
+      run_options.run_log_verbosity_level != other_run_options.run_log_verbosity_level ||
+      run_options.only_execute_path_to_fetches != other_run_options.only_execute_path_to_fetches ||
+      request.feed_names != other.feed_names || request.fetch_names != other.fetch_names) {
+    return false;
+  }
+  for (size_t i = 0; i < request.feeds.size(); ++i) {
+    const auto& tensor = request.feeds[i].Get<Tensor>();
+    const auto& other_tensor = other.feeds[i].Get<Tensor>();
+    if (tensor.DataType() != other_tensor.DataType() ||
+        tensor.Shape().NumDimensions() != other_tensor.Shape().NumDimensions() ||
+        tensor.Shape().Slice(1) != other_tensor.Shape().Slice(1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MicroBatcher::Submit(const RunOptions* run_options,
+                          gsl::span<const char* const> feed_names,
+                          gsl::span<const OrtValue* const> feeds,
+                          gsl::span<const char* const> fetch_names,
+                          gsl::span<OrtValue*> fetches,
+                          CompletionFn on_done) {
+  Request request{{}, {}, {}, {}, fetches, std::move(on_done), feeds[0]->Get<Tensor>().Shape()[0]};
+  if (run_options != nullptr) {
+    request.run_options.run_log_severity_level = run_options->run_log_severity_level;
+    request.run_options.run_log_verbosity_level = run_options->run_log_verbosity_level;
+    request.run_options.run_tag = run_options->run_tag;
+    request.run_options.only_execute_path_to_fetches = run_options->only_execute_path_to_fetches;
+#ifdef ENABLE_TRAINING
+    request.run_options.training_mode = run_options->training_mode;
+#endif
+  }
+  request.feed_names.assign(feed_names.begin(), feed_names.end());
+  request.fetch_names.assign(fetch_names.begin(), fetch_names.end());
+  request.feeds.reserve(feeds.size());
+  for (const auto* feed : feeds) {
+    request.feeds.push_back(*feed);
+  }
+
+  const size_t num_rows = narrow<size_t>(request.batch_size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto batch = std::find_if(pending_batches_.begin(), pending_batches_.end(), [&](const Batch& pending) {
+      return !pending.full && IsCompatible(pending.requests.front(), request);
+    });
+    if (batch != pending_batches_.end() && batch->num_rows + num_rows > max_batch_size_) {
+      // the request does not fit, let the pending batch run as is
+      batch->full = true;
+      batch = pending_batches_.end();
+    }
+    if (batch == pending_batches_.end()) {
+      batch = pending_batches_.emplace(pending_batches_.end());
+      batch->deadline = std::chrono::steady_clock::now() + max_delay_;
+    }
+    batch->requests.push_back(std::move(request));
+    batch->num_rows += num_rows;
+    batch->full = batch->full || batch->num_rows >= max_batch_size_;
+  }
+  cv_.notify_all();
+}
+
+void MicroBatcher::BatchingLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    const auto now = std::chrono::steady_clock::now();
+    auto next_deadline = std::chrono::steady_clock::time_point::max();
+    for (auto it = pending_batches_.begin(); it != pending_batches_.end();) {
+      if (shutdown_ || it->full || it->deadline <= now) {
+        std::vector<Request> requests = std::move(it->requests);
+        it = pending_batches_.erase(it);
+        ++num_running_batches_;
+        lock.unlock();
+        ScheduleBatch(std::move(requests));
+        lock.lock();
+        // the list may have changed while unlocked
+        it = pending_batches_.begin();
+        next_deadline = std::chrono::steady_clock::time_point::max();
+      } else {
+        next_deadline = std::min(next_deadline, it->deadline);
+        ++it;
+      }
+    }
+
+    if (shutdown_) {
+      // wait for the batches in flight, the requests submitted meanwhile are run by the next iteration
+      cv_.wait(lock, [this]() { return num_running_batches_ == 0 || !pending_batches_.empty(); });
+      if (num_running_batches_ == 0 && pending_batches_.empty()) {
+        return;
+      }
+    } else if (next_deadline == std::chrono::steady_clock::time_point::max()) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_until(lock, next_deadline);
+    }
+  }
+}
+
+void MicroBatcher::ScheduleBatch(std::vector<Request>&& requests) {
+  auto run_fn = [this, requests = std::move(requests)]() mutable {
+    RunBatch(requests);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_running_batches_;
+    }
+    cv_.notify_all();
+  };
+
+  if (thread_pool_ != nullptr) {
+    concurrency::ThreadPool::Schedule(thread_pool_, std::move(run_fn));
+  } else {
+    run_fn();
+  }
+}
+
+void MicroBatcher::RunBatch(std::vector<Request>& requests) {
+  if (requests.size() > 1) {
+    Status status;
+    ORT_TRY {
+      status = RunConcatenated(requests);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (status.IsOK()) {
+      return;
+    }
+    LOGS(*session_.GetLogger(), VERBOSE) << "Running " << requests.size()
+                                         << " batched requests one by one: " << status.ErrorMessage();
+  }
+
+  for (auto& request : requests) {
+    RunSingle(request);
+  }
+}
+
+void MicroBatcher::RunSingle(Request& request) {
+  Status status;
+  ORT_TRY {
+    std::vector<OrtValue> fetches;
+    status = session_.Run(request.run_options, request.feed_names, request.feeds, request.fetch_names, &fetches);
+    if (status.IsOK()) {
+      for (size_t i = 0; i < fetches.size(); ++i) {
+        request.fetches[i] = new OrtValue(std::move(fetches[i]));
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  request.on_done(status);
+}
+
+Status MicroBatcher::RunConcatenated(std::vector<Request>& requests) {
+  const auto& first = requests.front();
+  int64_t num_rows = 0;
+  for (const auto& request : requests) {
+    num_rows += request.batch_size;
+  }
+
+  // concatenate the feeds along the batch dimension
+  InlinedVector<OrtValue> feeds(first.feeds.size());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& first_tensor = first.feeds[i].Get<Tensor>();
+    TensorShape shape = first_tensor.Shape();
+    shape[0] = num_rows;
+    Tensor::InitOrtValue(first_tensor.DataType(), shape, cpu_allocator_, feeds[i]);
+
+    const size_t row_size = RowSizeInBytes(first_tensor);
+    auto* dst = static_cast<uint8_t*>(feeds[i].GetMutable<Tensor>()->MutableDataRaw());
+    for (const auto& request : requests) {
+      const size_t num_bytes = SafeInt<size_t>(request.batch_size) * row_size;
+      if (num_bytes > 0) {
+        std::memcpy(dst, request.feeds[i].Get<Tensor>().DataRaw(), num_bytes);
+      }
+      dst += num_bytes;
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(first.run_options, first.feed_names, feeds, first.fetch_names, &fetches));
+
+  for (const auto& fetch : fetches) {
+    ORT_RETURN_IF_NOT(IsBatchableTensor(fetch) && fetch.Get<Tensor>().Shape()[0] == num_rows,
+                      "Outputs can not be split along the batch dimension");
+  }
+
+  // split the outputs back to the requests. all of them are allocated before completing any request so a failure
+  // can still fall back to running the requests one by one.
+  std::vector<InlinedVector<std::unique_ptr<OrtValue>>> outputs(requests.size());
+  InlinedVector<size_t> offsets(fetches.size(), 0);
+  for (size_t r = 0; r < requests.size(); ++r) {
+    const int64_t batch_size = requests[r].batch_size;
+    outputs[r].reserve(fetches.size());
+    for (size_t i = 0; i < fetches.size(); ++i) {
+      const auto& tensor = fetches[i].Get<Tensor>();
+      TensorShape shape = tensor.Shape();
+      shape[0] = batch_size;
+      auto output = std::make_unique<OrtValue>();
+      Tensor::InitOrtValue(tensor.DataType(), shape, cpu_allocator_, *output);
+
+      const size_t num_bytes = SafeInt<size_t>(batch_size) * RowSizeInBytes(tensor);
+      if (num_bytes > 0) {
+        std::memcpy(output->GetMutable<Tensor>()->MutableDataRaw(),
+                    static_cast<const uint8_t*>(tensor.DataRaw()) + offsets[i], num_bytes);
+      }
+      offsets[i] += num_bytes;
+      outputs[r].push_back(std::move(output));
+    }
+  }
+
+  for (size_t r = 0; r < requests.size(); ++r) {
+    for (size_t i = 0; i < outputs[r].size(); ++i) {
+      requests[r].fetches[i] = outputs[r][i].release();
+    }
+    requests[r].on_done(Status::OK());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
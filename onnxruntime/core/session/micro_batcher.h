@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+namespace concurrency {
+class ThreadPool;
+}
+
+/**
+ * Gathers concurrent runs of a session whose inputs only differ in their first (batch) dimension, concatenates their
+ * inputs, runs the session once and splits the outputs back to the callers.
+ *
+ * A batch is run when it reaches max_batch_size rows or when its first request has waited max_delay. Batches are run
+ * on the given thread pool, or on the batching thread when none is given. Runs are only batched together if they have
+ * the same run tag and log levels, the same input and output names, and pass CPU tensors with at least one dimension
+ * for all inputs and no pre-allocated outputs. RunOptions with run config entries, active adapters or terminate set
+ * are not batched, and RunOptions::terminate is not observed once a run is queued. If the batched run fails or its
+ * outputs cannot be split along the batch dimension, the requests of the batch are run one by one.
+ */
+class MicroBatcher {
+ public:
+  // Called when the request completed. On success the fetches of the request were set to newly allocated OrtValues.
+  using CompletionFn = std::function<void(const Status& status)>;
+
+  MicroBatcher(InferenceSession& session, size_t max_batch_size, std::chrono::microseconds max_delay,
+               concurrency::ThreadPool* thread_pool);
+  ~MicroBatcher();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MicroBatcher);
+
+  // Returns true if a run with these options, feeds and outputs can be batched.
+  static bool CanBatch(const RunOptions* run_options, gsl::span<const OrtValue* const> feeds,
+                       gsl::span<OrtValue* const> fetches);
+
+  // Queues a run. CanBatch(run_options, feeds, fetches) must be true. run_options and feeds are copied, while fetches
+  // must stay valid until on_done is called.
+  void Submit(const RunOptions* run_options,
+              gsl::span<const char* const> feed_names,
+              gsl::span<const OrtValue* const> feeds,
+              gsl::span<const char* const> fetch_names,
+              gsl::span<OrtValue*> fetches,
+              CompletionFn on_done);
+
+ private:
+  struct Request {
+    RunOptions run_options;
+    InlinedVector<std::string> feed_names;
+    InlinedVector<OrtValue> feeds;
+    InlinedVector<std::string> fetch_names;
+    gsl::span<OrtValue*> fetches;
+    CompletionFn on_done;
+    int64_t batch_size;
+  };
+
+  struct Batch {
+    std::vector<Request> requests;
+    std::chrono::steady_clock::time_point deadline;
+    size_t num_rows = 0;
+    bool full = false;
+  };
+
+  static bool IsCompatible(const Request& request, const Request& other);
+
+  void BatchingLoop();
+  void ScheduleBatch(std::vector<Request>&& requests);
+  void RunBatch(std::vector<Request>& requests);
+  void RunSingle(Request& request);
+  Status RunConcatenated(std::vector<Request>& requests);
+
+  InferenceSession& session_;
+  const size_t max_batch_size_;
+  const std::chrono::microseconds max_delay_;
+  concurrency::ThreadPool* const thread_pool_;
+  AllocatorPtr cpu_allocator_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::list<Batch> pending_batches_;
+  size_t num_running_batches_ = 0;
+  bool shutdown_ = false;
+  std::thread batching_thread_;
+};
+
+}  // namespace onnxruntime
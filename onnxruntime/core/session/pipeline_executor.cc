@@ -0,0 +1,445 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/pipeline_executor.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Initializers with inline data larger than this are passed to the stage models by the address of their data, the
+// same threshold TensorToTensorProto uses to reference a tensor buffer.
+constexpr size_t kMaxCopiedInitializerSize = 127;
+
+size_t GetNodeArgSize(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  size_t size = 0;
+  if (type == nullptr || !type->has_tensor_type() ||
+      !utils::GetSizeInBytesFromTensorTypeProto<0>(type->tensor_type(), &size).IsOK()) {
+    return 0;
+  }
+  return size;
+}
+
+// Adds the initializer to the graph of a stage model, referencing its data when it is held inline.
+void AddStageInitializer(const ONNX_NAMESPACE::TensorProto& initializer, ONNX_NAMESPACE::GraphProto& graph_proto) {
+  auto& stage_initializer = *graph_proto.add_initializer();
+  if (!utils::HasRawData(initializer) || initializer.raw_data().size() <= kMaxCopiedInitializerSize) {
+    stage_initializer = initializer;
+    return;
+  }
+
+  stage_initializer.set_name(initializer.name());
+  stage_initializer.set_data_type(initializer.data_type());
+  *stage_initializer.mutable_dims() = initializer.dims();
+  // read back in GetExtDataFromTensorProto, the data stays owned by the graph of the pipelined session
+  const auto offset = narrow<ExternalDataInfo::OFFSET_TYPE>(reinterpret_cast<intptr_t>(initializer.raw_data().data()));
+  ExternalDataInfo::SetExternalLocationToProto(utils::kTensorProtoMemoryAddressTag, offset,
+                                               initializer.raw_data().size(), stage_initializer);
+}
+}  // namespace
+
+PipelineExecutor::PipelineExecutor(const DataTransferManager& data_transfer_mgr, const logging::Logger& logger)
+    : data_transfer_mgr_(data_transfer_mgr), logger_(logger), cpu_allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+PipelineExecutor::~PipelineExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  for (auto& stage : stages_) {
+    stage->cv.notify_all();
+  }
+  // the workers run all the queued micro-batches before they exit, so the stages are joined in order
+  for (auto& stage : stages_) {
+    if (stage->worker.joinable()) {
+      stage->worker.join();
+    }
+  }
+}
+
+InlinedVector<size_t> PipelineExecutor::SplitIntoStages(gsl::span<const size_t> node_weights, size_t num_stages) {
+  InlinedVector<size_t> stage_starts;
+  if (node_weights.empty() || num_stages == 0) {
+    return stage_starts;
+  }
+  num_stages = std::min(num_stages, node_weights.size());
+  const double total_weight = std::accumulate(node_weights.begin(), node_weights.end(), 0.0);
+
+  stage_starts.push_back(0);
+  double weight = 0.0;
+  for (size_t i = 0; i < node_weights.size(); ++i) {
+    const size_t stage = stage_starts.size();
+    if (stage < num_stages && i > stage_starts.back()) {
+      // the node goes to the next stage if most of its weight lies past the end of the current one, or if the
+      // remaining nodes are needed to give every remaining stage one
+      const double stage_end = total_weight * static_cast<double>(stage) / static_cast<double>(num_stages);
+      if (weight + static_cast<double>(node_weights[i]) / 2.0 > stage_end ||
+          node_weights.size() - i == num_stages - stage) {
+        stage_starts.push_back(i);
+      }
+    }
+    weight += static_cast<double>(node_weights[i]);
+  }
+  return stage_starts;
+}
+
+Status PipelineExecutor::Create(const Model& model, gsl::span<const OrtDevice> devices, size_t num_micro_batches,
+                                const CreateStageSessionFn& create_session,
+                                const DataTransferManager& data_transfer_mgr, const logging::Logger& logger,
+                                std::unique_ptr<PipelineExecutor>& executor) {
+  const Graph& graph = model.MainGraph();
+  ORT_RETURN_IF_NOT(model.GetModelLocalFunctionTemplates().empty(),
+                    "Models with local functions are not supported by pipeline parallel execution.");
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_order = graph_viewer.GetNodesInTopologicalOrder();
+
+  // the weight of the nodes is the size of the initializers first consumed by them and of their outputs
+  std::vector<size_t> node_weights;
+  node_weights.reserve(node_order.size());
+  InlinedHashSet<std::string> weighed_initializers;
+  for (NodeIndex node_index : node_order) {
+    const Node& node = *graph.GetNode(node_index);
+    SafeInt<size_t> weight = 1;
+    node.ForEachDef([&](const NodeArg& node_arg, bool is_input) {
+      const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+      if (!is_input) {
+        weight += GetNodeArgSize(node_arg);
+      } else if (graph.GetInitializedTensor(node_arg.Name(), initializer) &&
+                 weighed_initializers.insert(node_arg.Name()).second) {
+        size_t size = 0;
+        if (utils::GetSizeInBytesFromTensorProto<0>(*initializer, &size).IsOK()) {
+          weight += size;
+        }
+      }
+    });
+    node_weights.push_back(weight);
+  }
+
+  const InlinedVector<size_t> stage_starts = SplitIntoStages(node_weights, devices.size());
+  const size_t num_stages = stage_starts.size();
+  ORT_RETURN_IF(num_stages < 2, "The graph has too few nodes to be split into pipeline stages.");
+
+  // the stage that produces each value, and the last stage that consumes it
+  InlinedHashMap<std::string, size_t> producer_stages;
+  InlinedHashMap<std::string, size_t> last_consumer_stages;
+  for (size_t stage = 0; stage < num_stages; ++stage) {
+    const size_t end = stage + 1 < num_stages ? stage_starts[stage + 1] : node_order.size();
+    for (size_t i = stage_starts[stage]; i < end; ++i) {
+      graph.GetNode(node_order[i])->ForEachDef([&](const NodeArg& node_arg, bool is_input) {
+        (is_input ? last_consumer_stages : producer_stages)[node_arg.Name()] = stage;
+      });
+    }
+  }
+
+  auto pipeline = std::unique_ptr<PipelineExecutor>(new PipelineExecutor(data_transfer_mgr, logger));
+  pipeline->num_micro_batches_ = std::max<size_t>(num_micro_batches, 1);
+  for (const auto* output : graph.GetOutputs()) {
+    ORT_RETURN_IF(producer_stages.count(output->Name()) == 0, "The graph output ", output->Name(),
+                  " is not produced by a node, which is not supported by pipeline parallel execution.");
+    pipeline->graph_outputs_.insert(output->Name());
+  }
+
+  for (size_t stage_index = 0; stage_index < num_stages; ++stage_index) {
+    auto stage = std::make_unique<Stage>();
+    ONNX_NAMESPACE::ModelProto model_proto;
+    model_proto.set_ir_version(model.IrVersion());
+    model_proto.set_producer_name(model.ProducerName());
+    for (const auto& [domain, version] : graph.DomainToVersionMap()) {
+      auto* opset_import = model_proto.add_opset_import();
+      opset_import->set_domain(domain);
+      opset_import->set_version(version);
+    }
+    auto& graph_proto = *model_proto.mutable_graph();
+    graph_proto.set_name(MakeString(graph.Name(), "_stage_", stage_index));
+
+    InlinedHashSet<std::string> stage_values;
+    const size_t end = stage_index + 1 < num_stages ? stage_starts[stage_index + 1] : node_order.size();
+    for (size_t i = stage_starts[stage_index]; i < end; ++i) {
+      const Node& node = *graph.GetNode(node_order[i]);
+      node.ToProto(*graph_proto.add_node(), /*update_subgraphs*/ true);
+
+      Status status;
+      node.ForEachDef([&](const NodeArg& node_arg, bool is_input) {
+        const std::string& name = node_arg.Name();
+        if (!status.IsOK() || !stage_values.insert(name).second) {
+          return;
+        }
+        const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+        if (!is_input) {
+          if (last_consumer_stages[name] > stage_index || pipeline->graph_outputs_.count(name) > 0) {
+            stage->output_names.push_back(name);
+            *graph_proto.add_output() = node_arg.ToProto();
+          }
+        } else if (graph.GetInitializedTensor(name, initializer)) {
+          AddStageInitializer(*initializer, graph_proto);
+        } else {
+          const auto producer = producer_stages.find(name);
+          if (producer == producer_stages.end() && !graph.IsInputsIncludingInitializers(&node_arg)) {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The value ", name,
+                                     " is not a graph input or produced by a node of the graph.");
+            return;
+          }
+          stage->input_names.push_back(name);
+          *graph_proto.add_input() = node_arg.ToProto();
+          if (last_consumer_stages[name] == stage_index && pipeline->graph_outputs_.count(name) == 0) {
+            stage->released_values.push_back(name);
+          }
+        }
+      });
+      ORT_RETURN_IF_ERROR(status);
+    }
+
+    std::string model_data;
+    ORT_RETURN_IF_NOT(model_proto.SerializeToString(&model_data),
+                      "Failed to serialize the model of pipeline stage ", stage_index);
+    ORT_RETURN_IF_ERROR(create_session(stage_index, model_data, stage->session));
+    stage->output_devices.assign(stage->output_names.size(), devices[stage_index]);
+
+    LOGS(logger, INFO) << "Pipeline stage " << stage_index << " runs " << end - stage_starts[stage_index]
+                       << " nodes on " << devices[stage_index].ToString() << ".";
+    pipeline->stages_.push_back(std::move(stage));
+  }
+
+  for (size_t stage_index = 0; stage_index < num_stages; ++stage_index) {
+    pipeline->stages_[stage_index]->worker = std::thread([pipeline = pipeline.get(), stage_index]() {
+      pipeline->WorkerLoop(stage_index);
+    });
+  }
+
+  executor = std::move(pipeline);
+  return Status::OK();
+}
+
+Status PipelineExecutor::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                             gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                             std::vector<OrtValue>* p_fetches) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "The number of feed names and feeds differ.");
+  ORT_RETURN_IF_NOT(p_fetches->empty() || p_fetches->size() == output_names.size(),
+                    "The number of output names and pre-allocated outputs differ.");
+  for (const auto& name : output_names) {
+    if (graph_outputs_.count(name) == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid output name: ", name);
+    }
+  }
+
+  // the run is split along the first dimension if all the feeds share it
+  int64_t batch_size = -1;
+  bool can_split = num_micro_batches_ > 1 && !feeds.empty();
+  for (size_t i = 0; i < feeds.size() && can_split; ++i) {
+    can_split = feeds[i].IsTensor() && feeds[i].Get<Tensor>().Shape().NumDimensions() > 0 &&
+                (batch_size < 0 || feeds[i].Get<Tensor>().Shape()[0] == batch_size);
+    if (can_split) {
+      batch_size = feeds[i].Get<Tensor>().Shape()[0];
+    }
+  }
+  const size_t num_micro_batches =
+      can_split ? std::clamp<size_t>(narrow<size_t>(batch_size), 1, num_micro_batches_) : 1;
+
+  Request request{run_options};
+  request.num_pending = num_micro_batches;
+  std::vector<MicroBatch> micro_batches(num_micro_batches);
+  for (size_t m = 0; m < num_micro_batches; ++m) {
+    auto& micro_batch = micro_batches[m];
+    micro_batch.request = &request;
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      if (num_micro_batches == 1) {
+        micro_batch.values.insert_or_assign(feed_names[i], feeds[i]);
+        continue;
+      }
+      // the micro-batch inputs are views of the rows of the feeds
+      const auto& tensor = feeds[i].Get<Tensor>();
+      const int64_t first_row = batch_size * static_cast<int64_t>(m) / static_cast<int64_t>(num_micro_batches);
+      const int64_t end_row = batch_size * static_cast<int64_t>(m + 1) / static_cast<int64_t>(num_micro_batches);
+      TensorShape shape = tensor.Shape();
+      shape[0] = end_row - first_row;
+      const size_t row_size = SafeInt<size_t>(tensor.Shape().SizeFromDimension(1)) * tensor.DataType()->Size();
+      OrtValue slice;
+      Tensor::InitOrtValue(tensor.DataType(), shape, const_cast<void*>(tensor.DataRaw()), tensor.Location(), slice,
+                           SafeInt<ptrdiff_t>(first_row) * row_size);
+      micro_batch.values.insert_or_assign(feed_names[i], std::move(slice));
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& micro_batch : micro_batches) {
+      stages_.front()->queue.push_back(&micro_batch);
+    }
+  }
+  stages_.front()->cv.notify_one();
+
+  {
+    std::unique_lock<std::mutex> lock(request.mutex);
+    request.cv.wait(lock, [&request]() { return request.num_pending == 0; });
+  }
+  ORT_RETURN_IF_ERROR(request.status);
+
+  p_fetches->resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR(GatherOutput(output_names[i], micro_batches, (*p_fetches)[i]));
+  }
+  return Status::OK();
+}
+
+void PipelineExecutor::WorkerLoop(size_t stage_index) {
+  Stage& stage = *stages_[stage_index];
+  const bool is_last_stage = stage_index + 1 == stages_.size();
+  for (;;) {
+    MicroBatch* micro_batch = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stage.cv.wait(lock, [this, &stage]() { return shutdown_ || !stage.queue.empty(); });
+      if (stage.queue.empty()) {
+        return;
+      }
+      micro_batch = stage.queue.front();
+      stage.queue.pop_front();
+    }
+
+    Request& request = *micro_batch->request;
+    bool failed = false;
+    {
+      std::lock_guard<std::mutex> lock(request.mutex);
+      failed = !request.status.IsOK();
+    }
+
+    Status status;
+    if (!failed) {
+      ORT_TRY {
+        status = RunStage(stage, *micro_batch);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+        });
+      }
+    }
+
+    if (failed || !status.IsOK() || is_last_stage) {
+      // the request and its micro-batches may be gone once num_pending is 0 and the lock is released
+      std::lock_guard<std::mutex> lock(request.mutex);
+      if (!status.IsOK() && request.status.IsOK()) {
+        request.status = status;
+      }
+      if (--request.num_pending == 0) {
+        request.cv.notify_all();
+      }
+      continue;
+    }
+
+    Stage& next_stage = *stages_[stage_index + 1];
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      next_stage.queue.push_back(micro_batch);
+    }
+    next_stage.cv.notify_one();
+  }
+}
+
+Status PipelineExecutor::RunStage(Stage& stage, MicroBatch& micro_batch) {
+  // the missing graph inputs are reported by the session of the stage
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  feed_names.reserve(stage.input_names.size());
+  feeds.reserve(stage.input_names.size());
+  for (const auto& name : stage.input_names) {
+    const auto entry = micro_batch.values.find(name);
+    if (entry != micro_batch.values.end()) {
+      feed_names.push_back(name);
+      feeds.push_back(entry->second);
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(stage.session->Run(micro_batch.request->run_options, feed_names, feeds, stage.output_names,
+                                         &fetches, &stage.output_devices));
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    micro_batch.values.insert_or_assign(stage.output_names[i], std::move(fetches[i]));
+  }
+  for (const auto& name : stage.released_values) {
+    micro_batch.values.erase(name);
+  }
+  return Status::OK();
+}
+
+Status PipelineExecutor::GatherOutput(const std::string& name, gsl::span<const MicroBatch> micro_batches,
+                                      OrtValue& fetch) const {
+  InlinedVector<const OrtValue*> values;
+  values.reserve(micro_batches.size());
+  for (const auto& micro_batch : micro_batches) {
+    const auto entry = micro_batch.values.find(name);
+    ORT_RETURN_IF(entry == micro_batch.values.end(), "The output ", name, " was not produced by its stage.");
+    values.push_back(&entry->second);
+  }
+
+  const OrtValue& first = *values.front();
+  if (!first.IsTensor()) {
+    ORT_RETURN_IF_NOT(values.size() == 1 && !fetch.IsAllocated(), "The output ", name,
+                      " is not a tensor, so it can't be concatenated over micro-batches or copied to a pre-allocated "
+                      "output.");
+    fetch = first;
+    return Status::OK();
+  }
+
+  const Tensor& first_tensor = first.Get<Tensor>();
+  TensorShape shape = first_tensor.Shape();
+  if (values.size() > 1) {
+    ORT_RETURN_IF(shape.NumDimensions() == 0, "The output ", name, " can't be concatenated over micro-batches.");
+    int64_t num_rows = 0;
+    for (const auto* value : values) {
+      ORT_RETURN_IF_NOT(value->IsTensor() && value->Get<Tensor>().Shape().Slice(1) == shape.Slice(1),
+                        "The output ", name, " has different shapes after the first dimension over micro-batches.");
+      num_rows += value->Get<Tensor>().Shape()[0];
+    }
+    shape[0] = num_rows;
+  }
+
+  if (!fetch.IsAllocated()) {
+    // outputs are returned on the host, like the outputs of a session that are not pre-allocated
+    if (values.size() == 1 && first_tensor.Location().device.Type() == OrtDevice::CPU) {
+      fetch = first;
+      return Status::OK();
+    }
+    Tensor::InitOrtValue(first_tensor.DataType(), shape, cpu_allocator_, fetch);
+  }
+
+  Tensor& output = *fetch.GetMutable<Tensor>();
+  ORT_RETURN_IF_NOT(output.DataType() == first_tensor.DataType() && output.Shape() == shape,
+                    "The pre-allocated output ", name, " has shape ", output.Shape(), " while the output has shape ",
+                    shape);
+  ptrdiff_t offset = 0;
+  for (const auto* value : values) {
+    const Tensor& src = value->Get<Tensor>();
+    if (src.Shape().Size() == 0) {
+      continue;
+    }
+    Tensor dst(src.DataType(), src.Shape(), output.MutableDataRaw(), output.Location(), offset);
+    ORT_RETURN_IF_ERROR(data_transfer_mgr_.CopyTensor(src, dst));
+    offset += src.SizeInBytes();
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
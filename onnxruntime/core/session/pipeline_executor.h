@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+class DataTransferManager;
+class InferenceSession;
+class Model;
+
+namespace logging {
+class Logger;
+}
+
+/**
+ * Runs a model as a pipeline of stages, each one a session on its own device.
+ *
+ * The nodes of the main graph are split in topological order into contiguous stages that hold about the same share
+ * of the weight of the graph, where the weight of a node is the size of the initializers it is the first consumer of
+ * plus the size of its outputs when their shapes are known. Each stage is a model with the nodes and initializers of
+ * the stage, whose inputs are the graph inputs and the outputs of the earlier stages it consumes, and whose outputs
+ * are the values consumed by the later stages or the graph outputs. The initializers are passed to the stage models
+ * by reference and are only loaded by their sessions.
+ *
+ * Every stage has a worker thread that runs the micro-batches queued to it and hands them to the next stage, so the
+ * stages work on different micro-batches, and on the micro-batches of different runs, at the same time. The values
+ * passed between the stages stay on the device of the stage that produced them and are copied to the device of the
+ * next stage by its session. A run is split into up to num_micro_batches micro-batches along the first dimension of
+ * its inputs if all of them are tensors with the same first dimension, and the outputs are then concatenated along
+ * their first dimension, which requires the model to be batch-major.
+ */
+class PipelineExecutor {
+ public:
+  // Creates and initializes the session that runs the model of the stage with the given index.
+  using CreateStageSessionFn = std::function<Status(size_t stage_index, const std::string& model_data,
+                                                    std::unique_ptr<InferenceSession>& session)>;
+
+  // Splits the main graph of model into one stage per device and creates the sessions of the stages.
+  // data_transfer_mgr is used to copy the outputs to the host or to the pre-allocated fetches.
+  static Status Create(const Model& model, gsl::span<const OrtDevice> devices, size_t num_micro_batches,
+                       const CreateStageSessionFn& create_session, const DataTransferManager& data_transfer_mgr,
+                       const logging::Logger& logger, std::unique_ptr<PipelineExecutor>& executor);
+
+  // Returns the index of the first node of each stage in order, when the nodes with the given weights are split
+  // into at most num_stages contiguous stages of about the same total weight.
+  static InlinedVector<size_t> SplitIntoStages(gsl::span<const size_t> node_weights, size_t num_stages);
+
+  ~PipelineExecutor();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineExecutor);
+
+  size_t NumStages() const { return stages_.size(); }
+
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches);
+
+ private:
+  // A Run call, which completes when none of its micro-batches is pending.
+  struct Request {
+    const RunOptions& run_options;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t num_pending = 0;
+    Status status;
+  };
+
+  struct MicroBatch {
+    Request* request;
+    // The graph inputs and the outputs of the stages that ran, by name.
+    InlinedHashMap<std::string, OrtValue> values;
+  };
+
+  struct Stage {
+    std::unique_ptr<InferenceSession> session;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    std::vector<OrtDevice> output_devices;
+    // The values that no later stage consumes once this stage ran, other than the graph outputs.
+    std::vector<std::string> released_values;
+    // The micro-batches waiting for this stage, guarded by mutex_.
+    std::deque<MicroBatch*> queue;
+    std::condition_variable cv;
+    std::thread worker;
+  };
+
+  PipelineExecutor(const DataTransferManager& data_transfer_mgr, const logging::Logger& logger);
+
+  void WorkerLoop(size_t stage_index);
+  Status RunStage(Stage& stage, MicroBatch& micro_batch);
+
+  // Sets fetch to the concatenation of the value along the first dimension over the micro-batches.
+  Status GatherOutput(const std::string& name, gsl::span<const MicroBatch> micro_batches, OrtValue& fetch) const;
+
+  const DataTransferManager& data_transfer_mgr_;
+  const logging::Logger& logger_;
+  AllocatorPtr cpu_allocator_;
+  size_t num_micro_batches_ = 1;
+  InlinedHashSet<std::string> graph_outputs_;
+
+  std::mutex mutex_;
+  bool shutdown_ = false;
+  std::vector<std::unique_ptr<Stage>> stages_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
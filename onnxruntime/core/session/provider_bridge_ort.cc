@@ -1944,6 +1944,8 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_ep_context_embed_mode = 0;
   trt_options_converted.trt_engine_cache_prefix = "";
   trt_options_converted.trt_engine_hw_compatible = 0;
+  trt_options_converted.trt_engine_sharing_enable = 0;
+  trt_options_converted.trt_profile_auto_expand = 0;
 
   return trt_options_converted;
 }
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/shape_specializer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/tensor.h"
+#include "core/graph/node_arg.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Bounds the memory used to count the dimension values of sessions whose runs rarely repeat them.
+constexpr size_t kMaxCountedDimValues = 64;
+}  // namespace
+
+ShapeSpecializer::ShapeSpecializer(gsl::span<const NodeArg* const> graph_inputs, size_t min_runs,
+                                   CreateSessionFn create_session, const logging::Logger& logger)
+    : min_runs_(min_runs), create_session_(std::move(create_session)), logger_(logger) {
+  for (const auto* input : graph_inputs) {
+    const auto* shape = input->Shape();
+    if (shape == nullptr) {
+      continue;
+    }
+    InlinedVector<std::string> dim_params;
+    bool has_dim_param = false;
+    for (const auto& dim : shape->dim()) {
+      dim_params.push_back(dim.has_dim_param() ? dim.dim_param() : std::string());
+      has_dim_param = has_dim_param || dim.has_dim_param();
+    }
+    if (has_dim_param) {
+      input_dim_params_.emplace(input->Name(), std::move(dim_params));
+    }
+  }
+}
+
+ShapeSpecializer::~ShapeSpecializer() {
+  if (build_thread_.joinable()) {
+    build_thread_.join();
+  }
+}
+
+std::string ShapeSpecializer::GetDimValuesKey(gsl::span<const std::string> feed_names,
+                                              gsl::span<const OrtValue> feeds,
+                                              std::map<std::string, int64_t>* dim_values) const {
+  std::map<std::string, int64_t> values;
+  for (size_t i = 0, end = std::min(feed_names.size(), feeds.size()); i < end; ++i) {
+    const auto entry = input_dim_params_.find(feed_names[i]);
+    if (entry == input_dim_params_.end()) {
+      continue;
+    }
+    if (!feeds[i].IsTensor()) {
+      return {};
+    }
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    const auto& dim_params = entry->second;
+    if (shape.NumDimensions() != dim_params.size()) {
+      return {};
+    }
+    for (size_t d = 0; d < dim_params.size(); ++d) {
+      if (dim_params[d].empty()) {
+        continue;
+      }
+      const auto inserted = values.emplace(dim_params[d], shape[d]);
+      if (!inserted.second && inserted.first->second != shape[d]) {
+        return {};
+      }
+    }
+  }
+
+  std::string key;
+  for (const auto& [dim_param, value] : values) {
+    key += (key.empty() ? "" : ",") + dim_param + "=" + std::to_string(value);
+  }
+  if (dim_values != nullptr) {
+    *dim_values = std::move(values);
+  }
+  return key;
+}
+
+InferenceSession* ShapeSpecializer::GetSession(gsl::span<const std::string> feed_names,
+                                               gsl::span<const OrtValue> feeds) {
+  if (session_ready_.load(std::memory_order_acquire)) {
+    return GetDimValuesKey(feed_names, feeds) == specialized_key_ ? specialized_session_.get() : nullptr;
+  }
+
+  std::map<std::string, int64_t> dim_values;
+  std::string key = GetDimValuesKey(feed_names, feeds, &dim_values);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (build_started_) {
+    return nullptr;
+  }
+  ++total_runs_;
+  if (key.empty()) {
+    return nullptr;
+  }
+  auto entry = run_counts_.find(key);
+  if (entry == run_counts_.end()) {
+    if (run_counts_.size() >= kMaxCountedDimValues) {
+      return nullptr;
+    }
+    entry = run_counts_.emplace(key, 0).first;
+  }
+
+  const size_t count = ++entry->second;
+  if (count >= min_runs_ && 2 * count > total_runs_) {
+    build_started_ = true;
+    specialized_key_ = std::move(key);
+    InlinedHashMap<std::string, size_t>().swap(run_counts_);
+    build_thread_ = std::thread([this, dim_values = std::move(dim_values)]() { BuildSession(dim_values); });
+  }
+  return nullptr;
+}
+
+void ShapeSpecializer::BuildSession(std::map<std::string, int64_t> dim_values) {
+  std::vector<FreeDimensionOverride> overrides;
+  overrides.reserve(dim_values.size());
+  for (const auto& [dim_param, value] : dim_values) {
+    overrides.push_back(FreeDimensionOverride{dim_param, FreeDimensionOverrideType::Name, value});
+  }
+
+  std::unique_ptr<InferenceSession> session;
+  Status status;
+  ORT_TRY {
+    status = create_session_(overrides, session);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Failed to create the session specialized for the input dimensions "
+                           << specialized_key_ << ": " << status.ErrorMessage();
+    return;
+  }
+
+  specialized_session_ = std::move(session);
+  session_ready_.store(true, std::memory_order_release);
+  LOGS(logger_, INFO) << "Runs with the input dimensions " << specialized_key_ << " use a specialized session.";
+}
+
+}  // namespace onnxruntime
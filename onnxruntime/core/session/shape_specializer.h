@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+class NodeArg;
+
+namespace logging {
+class Logger;
+}
+
+/**
+ * Counts the values that the runs of a session give to the symbolic dimensions of the graph inputs. Once the same
+ * values were seen in min_runs runs, and in more than half of all the runs, a session with those values as free
+ * dimension overrides is created on a background thread. The runs with the same values are then routed to it.
+ *
+ * Only one specialized session is built over the lifetime of the session. Runs with feeds that are not tensors, or
+ * that give different values to the same symbolic dimension, are neither counted nor routed.
+ */
+class ShapeSpecializer {
+ public:
+  // Creates and initializes a session with the given free dimension overrides.
+  using CreateSessionFn = std::function<Status(const std::vector<FreeDimensionOverride>& overrides,
+                                               std::unique_ptr<InferenceSession>& session)>;
+
+  ShapeSpecializer(gsl::span<const NodeArg* const> graph_inputs, size_t min_runs, CreateSessionFn create_session,
+                   const logging::Logger& logger);
+  ~ShapeSpecializer();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ShapeSpecializer);
+
+  // Records the dimension values of a run, and returns the specialized session to run it with if it was built for
+  // them. Returns nullptr otherwise.
+  InferenceSession* GetSession(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds);
+
+ private:
+  // The values of the symbolic dimensions as a string, empty if the feeds have no consistent values for them.
+  std::string GetDimValuesKey(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                              std::map<std::string, int64_t>* dim_values = nullptr) const;
+
+  void BuildSession(std::map<std::string, int64_t> dim_values);
+
+  // The names of the symbolic dimensions of each graph input, empty for the fixed dimensions.
+  InlinedHashMap<std::string, InlinedVector<std::string>> input_dim_params_;
+  const size_t min_runs_;
+  CreateSessionFn create_session_;
+  const logging::Logger& logger_;
+
+  std::mutex mutex_;
+  InlinedHashMap<std::string, size_t> run_counts_;
+  size_t total_runs_ = 0;
+  bool build_started_ = false;
+
+  // Set by the build thread before session_ready_.
+  std::string specialized_key_;
+  std::unique_ptr<InferenceSession> specialized_session_;
+  std::atomic<bool> session_ready_{false};
+  std::thread build_thread_;
+};
+
+}  // namespace onnxruntime
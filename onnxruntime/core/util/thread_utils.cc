@@ -4,6 +4,7 @@
 #include "core/util/thread_utils.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -19,6 +20,7 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " thread_pool_size: " << params.thread_pool_size;
   os << " auto_set_affinity: " << params.auto_set_affinity;
   os << " allow_spinning: " << params.allow_spinning;
+  os << " numa_aware: " << params.numa_aware;
   os << " dynamic_block_base_: " << params.dynamic_block_base_;
   os << " stack_size: " << params.stack_size;
   os << " affinity_str: " << params.affinity_str;
@@ -89,6 +91,55 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 }
 #endif
 
+// Sets the NUMA node of each thread of the pool, including the placeholder for the main thread at index 0.
+// If the affinities are set, the node of a thread is the node of its processors, or -1 if they span several nodes.
+// Otherwise the threads are distributed across the nodes in proportion to their number of processors and bound to the
+// processors of their node.
+static void SetNumaNodes(const std::vector<LogicalProcessors>& numa_nodes, int thread_pool_size, ThreadOptions& to) {
+  if (!to.affinities.empty()) {
+    std::unordered_map<int, int> processor_nodes;
+    for (size_t node = 0; node < numa_nodes.size(); ++node) {
+      for (const int processor : numa_nodes[node]) {
+        processor_nodes[processor] = static_cast<int>(node);
+      }
+    }
+    to.numa_nodes.reserve(to.affinities.size());
+    for (const auto& affinity : to.affinities) {
+      int node = -1;
+      for (size_t i = 0; i < affinity.size(); ++i) {
+        auto it = processor_nodes.find(affinity[i]);
+        const int processor_node = it == processor_nodes.end() ? -1 : it->second;
+        if (i > 0 && processor_node != node) {
+          node = -1;
+          break;
+        }
+        node = processor_node;
+      }
+      to.numa_nodes.push_back(node);
+    }
+    return;
+  }
+
+  size_t num_processors = 0;
+  for (const auto& node : numa_nodes) {
+    num_processors += node.size();
+  }
+  const size_t num_threads = static_cast<size_t>(thread_pool_size) - 1;
+  to.affinities.assign(1, LogicalProcessors{});
+  to.numa_nodes.assign(1, -1);
+  size_t node = 0;
+  size_t node_end = numa_nodes[0].size();
+  for (size_t i = 0; i < num_threads; ++i) {
+    // the i-th thread gets the node of the processor at the same relative position
+    const size_t position = i * num_processors / num_threads;
+    while (position >= node_end) {
+      node_end += numa_nodes[++node].size();
+    }
+    to.affinities.push_back(numa_nodes[node]);
+    to.numa_nodes.push_back(static_cast<int>(node));
+  }
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
@@ -145,6 +196,13 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
 #endif
   }
 
+  if (options.numa_aware) {
+    const auto numa_nodes = env->GetNumaNodes();
+    if (numa_nodes.size() > 1) {
+      SetNumaNodes(numa_nodes, options.thread_pool_size, to);
+    }
+  }
+
   to.set_denormal_as_zero = options.set_denormal_as_zero;
   // set custom thread management members
   to.custom_create_thread_fn = options.custom_create_thread_fn;
@@ -21,6 +21,11 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If it is true and the process can run on more than one NUMA node, the threads are distributed across the nodes
+  // in proportion to their number of logical processors, and the work of a thread is kept on its node first.
+  // Unless affinity_str is set or auto_set_affinity applies, each thread is bound to the processors of its node.
+  bool numa_aware = false;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
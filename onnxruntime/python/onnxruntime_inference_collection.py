@@ -257,10 +257,13 @@ class Session:
         Compute the predictions.
 
         :param output_names: name of the outputs
-        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param input_feed: dictionary ``{ input_name: input_value }``, contiguous numpy arrays,
+            objects implementing ``__dlpack__`` (e.g. torch tensors) or ``__array_interface__``
+            are used without a copy and must not be modified while the model runs
         :param run_options: See :class:`onnxruntime.RunOptions`.
         :return: list of results, every result is either a numpy array,
-            a sparse tensor, a list or a dictionary.
+            a sparse tensor, a list or a dictionary. The numpy arrays of the tensors on CPU
+            share the memory of the outputs.
 
         ::
 
@@ -281,6 +284,26 @@ class Session:
                 return self._sess.run(output_names, input_feed, run_options)
             raise
 
+    def run_many(self, output_names, input_feeds, run_options=None) -> Sequence[Sequence[np.ndarray | SparseTensor | list | dict]]:
+        """
+        Compute the predictions of several requests at once. The feeds of all the requests are converted
+        first, then the GIL is released while the requests run concurrently on the ort intra-op threadpool.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per request
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list of the results of every request, see :meth:`run`.
+
+        ::
+
+            sess.run_many([output_name], [{input_name: x1}, {input_name: x2}])
+        """
+        for input_feed in input_feeds:
+            self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_many(output_names, input_feeds, run_options)
+
     def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
         """
         Compute the predictions asynchronously in a separate cxx thread from ort intra-op threadpool.
@@ -949,6 +949,23 @@ static void CreateGenericIterableMLValue(PyObject* iterator, AllocatorPtr alloc,
 // Setting `use_numpy_data_memory` to `true` will ensure that the underlying numpy array buffer is directly used
 // as the backing data buffer for the ORT Tensor where applicable (for numeric tensors)
 // The numpy object owns the memory and needs to be alive until the corresponding OrtValue is in scope
+#if defined(ENABLE_DLPACK)
+// DLPack producers may describe bool tensors as uint8, the graph input tells which one it is.
+static bool IsBoolTensorInput(const std::string& name_input, const InputDefList* input_def_list) {
+  if (input_def_list == nullptr) {
+    return false;
+  }
+  auto it = std::find_if(input_def_list->begin(), input_def_list->end(),
+                         [&name_input](const NodeArg* node_arg) { return name_input == node_arg->Name(); });
+  if (it == input_def_list->end() || (*it)->TypeAsProto() == nullptr) {
+    return false;
+  }
+  const auto& type_proto = *(*it)->TypeAsProto();
+  return type_proto.has_tensor_type() &&
+         type_proto.tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+}
+#endif
+
 void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const AllocatorPtr& alloc, const std::string& name_input,
                           const py::object& value, OrtValue* p_mlvalue, bool accept_only_numpy_array,
                           bool use_numpy_data_memory, MemCpyFunc mem_cpy_to_device) {
@@ -997,6 +1014,22 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
     // This should just increase the ref counts of the underlying shared_ptrs in the native OrtValue
     // and the ref count will be decreased when the OrtValue used for Run() is destroyed upon exit.
     *p_mlvalue = *value.attr(PYTHON_ORTVALUE_NATIVE_OBJECT_ATTR).cast<OrtValue*>();
+#if defined(ENABLE_DLPACK)
+  } else if (!accept_only_numpy_array && PyObject_HasAttrString(value.ptr(), "__dlpack__")) {
+    // A tensor from another framework, e.g. a torch tensor on CPU or GPU. The OrtValue uses its memory directly
+    // and keeps it alive until the DLPack deleter is called when the OrtValue is released.
+    py::object dlpack_tensor = value.attr("__dlpack__")();
+    *p_mlvalue = FromDlpack(dlpack_tensor.ptr(), IsBoolTensorInput(name_input, input_def_list));
+#endif
+  } else if (!accept_only_numpy_array && PyObject_HasAttrString(value.ptr(), "__array_interface__")) {
+    // A buffer exposed through the numpy array interface. Wrapping it in a numpy array doesn't copy it if it is
+    // contiguous, and the allocator holds the new array so the buffer stays alive as long as the tensor.
+    PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(PyArray_FromAny(value.ptr(), nullptr, 0, 0, 0, nullptr));
+    if (!arr) {
+      throw std::runtime_error("Could not create tensor from the array interface of input '" + name_input + "'");
+    }
+    auto pybind_alloc = std::make_shared<OrtPybindSingleUseAllocator>(arr, name_input, alloc->Info());
+    CreateTensorMLValueOwned(pybind_alloc, alloc, p_mlvalue);
   } else if (!accept_only_numpy_array) {
     auto iterator = PyObject_GetIter(value.ptr());
     if (iterator == NULL) {
@@ -184,6 +184,35 @@ void AppendLoraParametersAsInputs(const RunOptions& run_options,
   }
 }
 
+// Converts the python feeds of a run, the 'None's of the optional inputs are skipped.
+static NameMLValMap CreateFeeds(PyInferenceSession* sess, const std::map<std::string, const py::object>& pyfeeds,
+                                const RunOptions* run_options) {
+  NameMLValMap feeds;
+  if (run_options != nullptr && !run_options->active_adapters.empty()) {
+    AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
+  } else {
+    feeds.reserve(pyfeeds.size());
+  }
+
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
+    }
+  }
+  return feeds;
+}
+
 template <typename T>
 static py::object AddNonTensor(const OrtValue& val,
                                const DataTransferManager* /*data_transfer_manager*/,
@@ -402,6 +431,27 @@ py::object AddTensorAsPyObj(const OrtValue& val, const DataTransferManager* data
   return GetPyObjFromTensor(val, data_transfer_manager, mem_cpy_to_host_functions);
 }
 
+// Converts the fetches of a run into python objects.
+static py::list FetchesToPyList(const std::vector<OrtValue>& fetches) {
+  py::list result;
+  size_t pos = 0;
+  for (const auto& fet : fetches) {
+    if (fet.IsAllocated()) {
+      if (fet.IsTensor()) {
+        result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
+      } else if (fet.IsSparseTensor()) {
+        result.append(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        result.append(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      result.append(py::none());
+    }
+    ++pos;
+  }
+  return result;
+}
+
 static std::unique_ptr<onnxruntime::IExecutionProvider> LoadExecutionProvider(
     const std::string& ep_shared_lib_path,
     const ProviderOptions& provider_options = {},
@@ -827,6 +877,22 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
           } else if (option.first == "trt_op_types_to_exclude") {
             trt_op_types_to_exclude = option.second;
             params.trt_op_types_to_exclude = trt_op_types_to_exclude.c_str();
+          } else if (option.first == "trt_engine_sharing_enable") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_engine_sharing_enable = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_engine_sharing_enable = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_sharing_enable' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
+          } else if (option.first == "trt_profile_auto_expand") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_profile_auto_expand = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_profile_auto_expand = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_auto_expand' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -1611,6 +1677,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "max_cached_chunk_size_bytes") {
+            ort_arena_cfg->max_cached_chunk_size_bytes = kvp.second.cast<int64_t>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1622,7 +1690,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("max_cached_chunk_size_bytes", &OrtArenaCfg::max_cached_chunk_size_bytes);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -2046,29 +2115,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
               const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options = nullptr)
                -> py::list {
-             NameMLValMap feeds;
-             if (run_options != nullptr && !run_options->active_adapters.empty()) {
-               AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
-             } else {
-               feeds.reserve(pyfeeds.size());
-             }
-
-             for (const auto& feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
-               }
-             }
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds, run_options);
 
              std::vector<OrtValue> fetches;
              fetches.reserve(output_names.size());
@@ -2084,21 +2131,31 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
+             return FetchesToPyList(fetches);
+           })
+      .def("run_many",
+           [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
+              const std::vector<std::map<std::string, const py::object>>& pyfeeds_list,
+              RunOptions* run_options = nullptr) -> py::list {
+             // all the feeds are converted before the GIL is released for the whole batch
+             std::vector<NameMLValMap> feeds_list;
+             feeds_list.reserve(pyfeeds_list.size());
+             for (const auto& pyfeeds : pyfeeds_list) {
+               feeds_list.push_back(CreateFeeds(sess, pyfeeds, run_options));
+             }
+
+             std::vector<std::vector<OrtValue>> fetches_list;
+             {
+               py::gil_scoped_release release;
+               RunOptions default_run_options;
+               OrtPybindThrowIfError(sess->GetSessionHandle()->RunMany(
+                   run_options != nullptr ? *run_options : default_run_options, feeds_list, output_names,
+                   &fetches_list));
+             }
+
              py::list result;
-             size_t pos = 0;
-             for (const auto& fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   result.append(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   result.append(AddNonTensorAsPyObj(fet, nullptr, nullptr));
-                 }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 result.append(py::none());
-               }
-               ++pos;
+             for (const auto& fetches : fetches_list) {
+               result.append(FetchesToPyList(fetches));
              }
              return result;
            })
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+
+namespace onnxruntime::test {
+
+using profiling::HardwareCounters;
+using profiling::HardwareCounterValues;
+
+TEST(HardwareCountersTest, ValuesArithmetic) {
+  HardwareCounterValues begin;
+  begin.cycles = 100;
+  begin.instructions = 200;
+  HardwareCounterValues end = begin;
+  end.cycles = 300;
+  end.instructions = 600;
+  end.llc_misses = 3;
+  end.llc_read_misses = 2;
+  end.dtlb_misses = 5;
+
+  const HardwareCounterValues diff = end - begin;
+  EXPECT_EQ(diff.cycles, 200u);
+  EXPECT_EQ(diff.instructions, 400u);
+  EXPECT_EQ(diff.BytesRead(), 2 * HardwareCounterValues::kCacheLineSize);
+  // counters that went backwards, e.g. because a thread was attached between the reads, are clamped
+  EXPECT_EQ((begin - end).cycles, 0u);
+
+  EXPECT_EQ(diff.ToJson(false), "{\"cycles\": 200, \"instructions\": 400, \"ipc\": 2.000}");
+  EXPECT_EQ(diff.ToJson(true),
+            "{\"cycles\": 200, \"instructions\": 400, \"ipc\": 2.000, \"llc_misses\": 3, \"bytes_read\": 128}");
+  EXPECT_EQ(diff.ToJson(true, true),
+            "{\"cycles\": 200, \"instructions\": 400, \"ipc\": 2.000, \"llc_misses\": 3, \"bytes_read\": 128, "
+            "\"dtlb_misses\": 5}");
+
+  HardwareCounterValues total;
+  total += diff;
+  total += diff;
+  EXPECT_EQ(total.instructions, 800u);
+}
+
+TEST(HardwareCountersTest, CountsWork) {
+  auto counters = HardwareCounters::Create(DefaultLoggingManager().DefaultLogger());
+  if (!counters) {
+    GTEST_SKIP() << "Hardware performance counters are not available.";
+  }
+
+  const auto begin = counters->Read();
+  std::vector<double> values(1 << 20);
+  std::iota(values.begin(), values.end(), 0.0);
+  volatile double sum = std::accumulate(values.begin(), values.end(), 0.0);
+  (void)sum;
+  const auto work = counters->Read() - begin;
+
+  EXPECT_GT(work.cycles, 0u);
+  EXPECT_GT(work.instructions, values.size());
+
+  counters->RecordOpType("Add", work);
+  counters->RecordOpType("Add", work);
+  auto totals = counters->TakeOpTypeTotals();
+  ASSERT_EQ(totals.size(), 1u);
+  EXPECT_EQ(totals["Add"].instructions, 2 * work.instructions);
+  EXPECT_TRUE(counters->TakeOpTypeTotals().empty());
+}
+
+}  // namespace onnxruntime::test
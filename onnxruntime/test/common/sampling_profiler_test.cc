@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime::test {
+
+using profiling::LatencyHistogram;
+using profiling::SamplingProfiler;
+
+TEST(LatencyHistogramTest, BucketsCoverAllValues) {
+  for (uint64_t value = 0; value < 100000; ++value) {
+    const size_t index = LatencyHistogram::BucketIndex(value);
+    ASSERT_LE(value, LatencyHistogram::BucketUpperBound(index));
+    if (index > 0) {
+      ASSERT_GT(value, LatencyHistogram::BucketUpperBound(index - 1));
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::BucketIndex(uint64_t{1} << 50), LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, Quantiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Quantile(0.5), 0u);
+
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Add(value * 1000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_EQ(histogram.Min(), 1000u);
+  EXPECT_EQ(histogram.Max(), 1000000u);
+  EXPECT_DOUBLE_EQ(histogram.Mean(), 500500.0);
+
+  // values are within 1/kSubBuckets of the exact quantiles
+  const double tolerance = 1.0 / LatencyHistogram::kSubBuckets;
+  EXPECT_NEAR(static_cast<double>(histogram.Quantile(0.5)), 500000.0, 500000.0 * tolerance);
+  EXPECT_NEAR(static_cast<double>(histogram.Quantile(0.99)), 990000.0, 990000.0 * tolerance);
+  EXPECT_EQ(histogram.Quantile(1.0), 1000000u);
+
+  LatencyHistogram other;
+  other.Add(10);
+  histogram.Merge(other);
+  EXPECT_EQ(histogram.Count(), 1001u);
+  EXPECT_EQ(histogram.Min(), 10u);
+  EXPECT_EQ(histogram.Quantile(0.0), 10u);
+}
+
+TEST(SamplingProfilerTest, SamplesOneRunOutOfInterval) {
+  SamplingProfiler profiler({{"node_0", "Add"}, {"node_1", "Mul"}, {"node_2", "Add"}}, 4);
+  for (int run = 0; run < 20; ++run) {
+    if (profiler.ShouldSampleRun()) {
+      for (size_t node_index = 0; node_index < 3; ++node_index) {
+        profiler.RecordNode(node_index, std::chrono::microseconds(node_index + 1));
+      }
+      profiler.EndSampledRun();
+    }
+  }
+
+  EXPECT_EQ(profiler.GetNodeHistogram(0).Count(), 5u);
+  EXPECT_EQ(profiler.GetNodeHistogram(1).Max(), 2000u);
+  EXPECT_EQ(profiler.GetNodeHistogram(3).Count(), 0u);
+
+  const std::string stats = profiler.GetStatsJson();
+  EXPECT_NE(stats.find("\"sampled_runs\": 5"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("\"dropped_samples\": 0"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("{\"op_type\": \"Add\", \"count\": 10"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("{\"op_type\": \"Mul\", \"count\": 5"), std::string::npos) << stats;
+
+  profiler.Reset();
+  EXPECT_EQ(profiler.GetNodeHistogram(0).Count(), 0u);
+}
+
+TEST(SamplingProfilerTest, ConcurrentRecording) {
+  constexpr size_t kNumThreads = 4;
+  constexpr size_t kSamplesPerThread = 10000;
+  SamplingProfiler profiler({{"node_0", "Relu"}}, 1, 64);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&profiler]() {
+      for (size_t i = 0; i < kSamplesPerThread; ++i) {
+        profiler.RecordNode(0, std::chrono::nanoseconds(100));
+        if (i % 16 == 0) {
+          profiler.EndSampledRun();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // every sample is either recorded or counted as dropped
+  const auto histogram = profiler.GetNodeHistogram(0);
+  const std::string stats = profiler.GetStatsJson();
+  const size_t dropped_pos = stats.find("\"dropped_samples\": ");
+  ASSERT_NE(dropped_pos, std::string::npos);
+  const uint64_t dropped = std::stoull(stats.substr(dropped_pos + 19));
+  EXPECT_EQ(histogram.Count() + dropped, kNumThreads * kSamplesPerThread);
+  EXPECT_EQ(histogram.Max(), 100u);
+}
+
+}  // namespace onnxruntime::test
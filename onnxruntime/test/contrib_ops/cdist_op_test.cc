@@ -51,6 +51,29 @@ TEST(CDistOpTest, Sqeuclidean) {
   test.Run();
 }
 
+TEST(CDistOpTest, Cosine) {
+  OpTester test("CDist", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("metric", "cosine");
+
+  test.AddInput<float>("A", {4, 2},
+                       {-1.0856307f, 0.99734545f,
+                        0.2829785f, -1.5062947f,
+                        -0.5786002f, 1.6514366f,
+                        -2.4266791f, -0.42891264f});
+  test.AddInput<float>("B", {3, 2},
+                       {1.2659363f, -0.8667404f,
+                        -0.6788862f, -0.09470897f,
+                        1.4913896f, -0.638902f});
+
+  test.AddOutput<float>("y", {4, 3},
+                        {1.989838f, 0.3641223f, 1.943321f,
+                         0.2924266f, 1.04707f, 0.4432724f,
+                         1.805996f, 0.8029135f, 1.675571f,
+                         1.714211f, 0.0006598694f, 1.836636f});
+  test.SetOutputTolerance(1e-5f);
+  test.Run();
+}
+
 TEST(CDistOpTest, DoubleEuclidean) {
   OpTester test("CDist", 1, onnxruntime::kMSDomain);
   test.AddAttribute("metric", "euclidean");
@@ -99,5 +99,41 @@ TEST(CropAndResizeTest, CropAndResize_1133) {
   test3.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// many ROIs and channels so that the work of a ROI is split between threads
+TEST(CropAndResizeTest, CropAndResize_ManyRoisAndChannels) {
+  constexpr int64_t kChannels = 64;
+  constexpr int64_t kRois = 40;
+  std::vector<float> X(2 * kChannels * 3 * 3);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i % 97);
+  }
+
+  // the ROIs alternate between the whole image of batch 0, and the whole image of batch 1 flipped vertically,
+  // so each output channel is a copy of an input channel
+  std::vector<float> rois;
+  std::vector<int32_t> batch_indices;
+  std::vector<float> output;
+  for (int64_t n = 0; n < kRois; ++n) {
+    const bool flip = n % 2 == 1;
+    rois.insert(rois.end(), {flip ? 1.0f : 0.0f, 0.0f, flip ? 0.0f : 1.0f, 1.0f});
+    batch_indices.push_back(flip ? 1 : 0);
+    for (int64_t c = 0; c < kChannels; ++c) {
+      const float* channel = X.data() + ((flip ? kChannels : 0) + c) * 9;
+      for (int64_t h = 0; h < 3; ++h) {
+        const float* row = channel + (flip ? 2 - h : h) * 3;
+        output.insert(output.end(), row, row + 3);
+      }
+    }
+  }
+
+  OpTester test("CropAndResize", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {2, kChannels, 3, 3}, X);
+  test.AddInput<float>("rois", {kRois, 4}, rois);
+  test.AddInput<int32_t>("batch_indices", {kRois}, batch_indices);
+  test.AddInput<int32_t>("crop_size", {2}, {3, 3});
+  test.AddOutput<float>("output", {kRois, kChannels, 3, 3}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
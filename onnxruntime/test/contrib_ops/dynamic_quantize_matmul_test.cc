@@ -12,6 +12,7 @@
 #include "core/util/qmath.h"
 
 #include <chrono>
+#include <cmath>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -280,5 +281,56 @@ TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   test_case({15, 14, 13}, {15, 13, 27}, {15, 1, 27});
 }
 
+TEST(DynamicQuantizeMatMul, PerRowQuantization) {
+  constexpr int64_t batch = 2;
+  constexpr int64_t M = 3;
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+  RandomValueGenerator random{1668426375};
+
+  // The rows have very different ranges, which a single scale for A can't represent well.
+  std::vector<float> A_data = random.Uniform<float>(AsSpan({batch * M, K}), -1.0f, 1.0f);
+  for (int64_t row = 0; row < batch * M; row++) {
+    const float row_range = std::pow(4.0f, static_cast<float>(row));
+    std::transform(A_data.begin() + row * K, A_data.begin() + (row + 1) * K, A_data.begin() + row * K,
+                   [row_range](float v) { return v * row_range; });
+  }
+  std::vector<int8_t> B_data = random.Uniform<int8_t>(AsSpan({K, N}), -64, 64);
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan({N}), 0.01f, 0.1f);
+  std::vector<float> Bias = random.Uniform<float>(AsSpan({N}), -0.1f, 0.1f);
+
+  // Each row is quantized symmetrically with the zero point 128.
+  std::vector<float> Y_data(batch * M * N);
+  for (int64_t row = 0; row < batch * M; row++) {
+    const float* a_row = A_data.data() + row * K;
+    float abs_max = 0.0f;
+    for (int64_t k = 0; k < K; k++) {
+      abs_max = std::max(abs_max, std::abs(a_row[k]));
+    }
+    const float scale = abs_max / 127.0f;
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        const float quantized = std::clamp(std::nearbyint(a_row[k] / scale) + 128.0f, 0.0f, 255.0f);
+        sum += (static_cast<int32_t>(quantized) - 128) * B_data[k * N + n];
+      }
+      Y_data[row * N + n] = static_cast<float>(sum) * scale * B_scale[n] + Bias[n];
+    }
+  }
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("per_row_quantization", 1);
+  test.AddInput<float>("A", {batch, M, K}, A_data);
+  test.AddInput<int8_t>("B", {K, N}, B_data, true);
+  test.AddInput<float>("b_scale", {N}, B_scale);
+  test.AddOptionalInputEdge<int8_t>();
+  test.AddInput<float>("bias", {N}, Bias);
+  test.AddOutput<float>("Y", {batch, M, N}, Y_data, /*sort*/ false, 0.0001f, 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = (activation(X * W_gate) * (X * W_up)) * W_down, with the gate and up columns of w_gate_up, computed row by row.
+std::vector<float> ReferenceGatedMLP(const std::vector<float>& x, const std::vector<float>& w_gate_up,
+                                     const std::vector<float>& w_down, bool is_gelu, int M, int K, int hidden_size,
+                                     int N) {
+  std::vector<float> y(static_cast<size_t>(M) * N);
+  std::vector<float> h(hidden_size);
+  for (int m = 0; m < M; m++) {
+    for (int i = 0; i < hidden_size; i++) {
+      float gate = 0.0f;
+      float up = 0.0f;
+      for (int k = 0; k < K; k++) {
+        gate += x[m * K + k] * w_gate_up[k * 2 * hidden_size + i];
+        up += x[m * K + k] * w_gate_up[k * 2 * hidden_size + hidden_size + i];
+      }
+      const float activation = is_gelu ? 0.5f * gate * (1.0f + std::erf(gate / std::sqrt(2.0f)))
+                                       : gate / (1.0f + std::exp(-gate));
+      h[i] = activation * up;
+    }
+    for (int n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int i = 0; i < hidden_size; i++) {
+        sum += h[i] * w_down[i * N + n];
+      }
+      y[m * N + n] = sum;
+    }
+  }
+  return y;
+}
+
+void RunGatedMLPTest(const std::string& activation, int batch_size, int sequence_length) {
+  constexpr int K = 24;
+  constexpr int hidden_size = 72;
+  constexpr int N = 20;
+  const int M = batch_size * sequence_length;
+
+  std::vector<float> x(static_cast<size_t>(M) * K);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.1f;
+  }
+  std::vector<float> w_gate_up(K * 2 * hidden_size);
+  for (size_t i = 0; i < w_gate_up.size(); i++) {
+    w_gate_up[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.05f;
+  }
+  std::vector<float> w_down(hidden_size * N);
+  for (size_t i = 0; i < w_down.size(); i++) {
+    w_down[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.1f;
+  }
+
+  const std::vector<float> y = ReferenceGatedMLP(x, w_gate_up, w_down, activation == "Gelu", M, K, hidden_size, N);
+
+  OpTester tester("GatedMLP", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<std::string>("activation", activation);
+  tester.AddInput<float>("X", {batch_size, sequence_length, K}, x);
+  tester.AddInput<float>("W_gate_up", {K, 2 * hidden_size}, w_gate_up, true);
+  tester.AddInput<float>("W_down", {hidden_size, N}, w_down, true);
+  tester.AddOutput<float>("Y", {batch_size, sequence_length, N}, y, /*sort*/ false, 0.0001f, 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(GatedMLPTest, Silu) {
+  RunGatedMLPTest("Silu", 1, 1);
+  // more rows than a block of the kernel, with a partial last block
+  RunGatedMLPTest("Silu", 3, 50);
+}
+
+TEST(GatedMLPTest, Gelu) {
+  RunGatedMLPTest("Gelu", 2, 3);
+}
+
+TEST(GatedMLPTest, InvalidGateUpShape) {
+  OpTester tester("GatedMLP", 1, onnxruntime::kMSDomain);
+  tester.AddInput<float>("X", {1, 2}, {1.0f, 2.0f});
+  tester.AddInput<float>("W_gate_up", {2, 3}, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f});
+  tester.AddInput<float>("W_down", {1, 1}, {1.0f});
+  tester.AddOutput<float>("Y", {1, 1}, {0.0f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "2 * hidden_size", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -464,5 +464,76 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis2) {
   Test_GatherAxis2_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
 }
 
+// gathers whole rows of a table that is quantized along its rows, e.g. an embedding table.
+template <typename T1, typename T2, typename Tind>
+void Test_GatherRows_WithZeroPoints(const std::vector<int64_t>& data_shape, const std::vector<int>& indices,
+                                    const std::vector<int64_t>& indices_shape) {
+  constexpr int64_t block_size = 16;
+  const size_t rank = data_shape.size();
+  const int64_t row_size = data_shape[rank - 1];
+  const int64_t axis_dim = data_shape[rank - 2];
+  const int64_t blocks_per_row = (row_size + block_size - 1) / block_size;
+  int64_t table_count = 1;
+  for (size_t i = 0; i + 2 < rank; ++i) {
+    table_count *= data_shape[i];
+  }
+
+  std::vector<int> data(table_count * axis_dim * row_size);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int>((i * 7 + i / 5) % 16) - 8;
+  }
+
+  std::vector<int64_t> scales_shape(data_shape);
+  scales_shape[rank - 1] = blocks_per_row;
+  std::vector<float> scales(table_count * axis_dim * blocks_per_row);
+  std::vector<int> zero_points(scales.size());
+  for (size_t i = 0; i < scales.size(); ++i) {
+    scales[i] = 0.5f * static_cast<float>(i % 3 + 1);
+    zero_points[i] = static_cast<int>(i % 5) - 2;
+  }
+
+  std::vector<float> output;
+  for (int64_t t = 0; t < table_count; ++t) {
+    for (int index : indices) {
+      const int64_t row = t * axis_dim + (index < 0 ? index + axis_dim : index);
+      for (int64_t j = 0; j < row_size; ++j) {
+        const size_t scale_idx = static_cast<size_t>(row * blocks_per_row + j / block_size);
+        output.push_back(static_cast<float>(data[row * row_size + j] - zero_points[scale_idx]) * scales[scale_idx]);
+      }
+    }
+  }
+
+  std::vector<int64_t> output_shape(data_shape.begin(), data_shape.end() - 2);
+  output_shape.insert(output_shape.end(), indices_shape.begin(), indices_shape.end());
+  output_shape.push_back(row_size);
+
+  RunGatherBlockQuantized(ToType<T1>(data),
+                          data_shape,
+                          ToType<Tind>(indices),
+                          indices_shape,
+                          ToType<T2>(scales),
+                          scales_shape,
+                          ToType<T1>(zero_points),
+                          static_cast<int64_t>(rank) - 2,
+                          static_cast<int64_t>(rank) - 1,
+                          block_size,
+                          ToType<T2>(output),
+                          output_shape,
+                          OpTester::ExpectResult::kExpectSuccess);
+}
+
+template <typename T1, typename T2, typename Tind>
+void Test_GatherRows() {
+  Test_GatherRows_WithZeroPoints<T1, T2, Tind>({10, 40}, {3, 9, -1, 0, 3, 5}, {2, 3});
+  Test_GatherRows_WithZeroPoints<T1, T2, Tind>({2, 6, 48}, {5, -6, 2, 2, 1, 4, 0, 3, 5}, {9});
+}
+
+TEST(GatherBlockQuantizedOpTest, GatherRows) {
+  Test_GatherRows<UInt4x2, float, int32_t>();
+  Test_GatherRows<Int4x2, float, int32_t>();
+  Test_GatherRows<UInt4x2, MLFloat16, int32_t>();
+  Test_GatherRows<Int4x2, MLFloat16, int64_t>();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -7,6 +7,9 @@
 #include <gsl/gsl>
 #include "core/session/onnxruntime_cxx_api.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "core/graph/model.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 #ifdef USE_CUDA
 #include "core/providers/cuda/cuda_provider_options.h"
@@ -183,5 +186,148 @@ TEST(GreedySearchTest, GptGreedySearchFp32) {
   }
 }
 
+// Creates a GPT-2 like decoder with one layer for vocab_size = next_tokens.size(). Its past state holds the tokens,
+// and the logits after a token select next_tokens[(2 * sum of the tokens up to it) % vocab_size], so that the
+// selected tokens depend on the whole past state.
+static ONNX_NAMESPACE::GraphProto CreateTokenSumDecoder(const std::vector<float>& next_tokens) {
+  using namespace ONNX_NAMESPACE;
+  const int64_t vocab_size = static_cast<int64_t>(next_tokens.size());
+
+  Model model("TokenSumDecoder", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  // dims of -1 are symbolic
+  auto make_type = [](TensorProto_DataType elem_type, const std::vector<int64_t>& dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(elem_type);
+    auto* shape = type.mutable_tensor_type()->mutable_shape();
+    for (int64_t dim : dims) {
+      auto* shape_dim = shape->add_dim();
+      if (dim >= 0) {
+        shape_dim->set_dim_value(dim);
+      }
+    }
+    return type;
+  };
+
+  auto add_initializer = [&](const std::string& name, TensorProto_DataType elem_type, const std::vector<int64_t>& dims,
+                             const std::vector<float>& values) -> NodeArg& {
+    TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(elem_type);
+    for (int64_t dim : dims) {
+      tensor.add_dims(dim);
+    }
+    for (float value : values) {
+      if (elem_type == TensorProto_DataType_INT64) {
+        tensor.add_int64_data(static_cast<int64_t>(value));
+      } else {
+        tensor.add_float_data(value);
+      }
+    }
+    graph.AddInitializedTensor(tensor);
+    TypeProto type = make_type(elem_type, dims);
+    return graph.GetOrCreateNodeArg(name, &type);
+  };
+
+  TypeProto ids_type = make_type(TensorProto_DataType_INT32, {-1, -1});
+  TypeProto past_type = make_type(TensorProto_DataType_FLOAT, {2, -1, 1, -1, 1});
+  TypeProto logits_type = make_type(TensorProto_DataType_FLOAT, {-1, -1, vocab_size});
+  auto& input_ids = graph.GetOrCreateNodeArg("input_ids", &ids_type);
+  auto& position_ids = graph.GetOrCreateNodeArg("position_ids", &ids_type);
+  auto& attention_mask = graph.GetOrCreateNodeArg("attention_mask", &ids_type);
+  auto& past = graph.GetOrCreateNodeArg("past_0", &past_type);
+  auto& logits = graph.GetOrCreateNodeArg("logits", &logits_type);
+  auto& present = graph.GetOrCreateNodeArg("present_0", &past_type);
+
+  std::vector<float> table(static_cast<size_t>(vocab_size * vocab_size), 0.0f);
+  for (size_t i = 0; i < next_tokens.size(); i++) {
+    table[i * next_tokens.size() + static_cast<size_t>(next_tokens[i])] = 1.0f;
+  }
+  auto& logits_table = add_initializer("logits_table", TensorProto_DataType_FLOAT, {vocab_size, vocab_size}, table);
+  auto& state_axes = add_initializer("state_axes", TensorProto_DataType_INT64, {3}, {0, 2, 4});
+  auto& past_axes = add_initializer("past_axes", TensorProto_DataType_INT64, {4}, {0, 2, 3, 4});
+  auto& sum_axes = add_initializer("sum_axes", TensorProto_DataType_INT64, {1}, {1});
+  auto& sum_axis = add_initializer("sum_axis", TensorProto_DataType_INT64, {}, {1});
+  auto& vocab = add_initializer("vocab", TensorProto_DataType_FLOAT, {}, {static_cast<float>(vocab_size)});
+
+  auto new_arg = [&graph](const std::string& name) { return &graph.GetOrCreateNodeArg(name, nullptr); };
+  NodeArg* tokens = new_arg("tokens");
+  NodeArg* unsqueezed_tokens = new_arg("unsqueezed_tokens");
+  NodeArg* state = new_arg("state");
+  NodeArg* past_sum = new_arg("past_sum");
+  NodeArg* unsqueezed_past_sum = new_arg("unsqueezed_past_sum");
+  NodeArg* token_sum = new_arg("token_sum");
+  NodeArg* double_token_sum = new_arg("double_token_sum");
+  NodeArg* total_sum = new_arg("total_sum");
+  NodeArg* float_index = new_arg("float_index");
+  NodeArg* index = new_arg("index");
+
+  graph.AddNode("cast_tokens", "Cast", "", {&input_ids}, {tokens})
+      .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+  graph.AddNode("unsqueeze_tokens", "Unsqueeze", "", {tokens, &state_axes}, {unsqueezed_tokens});
+  graph.AddNode("concat_state", "Concat", "", {unsqueezed_tokens, unsqueezed_tokens}, {state})
+      .AddAttribute("axis", int64_t{0});
+  graph.AddNode("concat_present", "Concat", "", {&past, state}, {&present}).AddAttribute("axis", int64_t{3});
+
+  // the past state holds each token twice
+  graph.AddNode("sum_past", "ReduceSum", "", {&past, &past_axes}, {past_sum}).AddAttribute("keepdims", int64_t{0});
+  graph.AddNode("unsqueeze_past_sum", "Unsqueeze", "", {past_sum, &sum_axes}, {unsqueezed_past_sum});
+  graph.AddNode("sum_tokens", "CumSum", "", {tokens, &sum_axis}, {token_sum});
+  graph.AddNode("double_token_sum", "Add", "", {token_sum, token_sum}, {double_token_sum});
+  graph.AddNode("add_past_sum", "Add", "", {double_token_sum, unsqueezed_past_sum}, {total_sum});
+  graph.AddNode("mod_vocab_size", "Mod", "", {total_sum, &vocab}, {float_index}).AddAttribute("fmod", int64_t{1});
+  graph.AddNode("cast_index", "Cast", "", {float_index}, {index})
+      .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_INT64));
+  graph.AddNode("gather_logits", "Gather", "", {&logits_table, index}, {&logits});
+
+  graph.SetInputs({&input_ids, &position_ids, &attention_mask, &past});
+  graph.SetOutputs({&logits, &present});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  return graph.ToGraphProto();
+}
+
+TEST(GreedySearchTest, GptSpeculativeDecoding) {
+  const std::vector<float> next_tokens{3, 5, 0, 6, 2, 1, 4};
+  // The draft decoder selects other tokens after some of the sums, so some of its proposals are rejected.
+  const std::vector<float> draft_next_tokens{3, 5, 1, 6, 2, 1, 0};
+
+  constexpr int64_t batch_size = 2;
+  constexpr int64_t sequence_length = 3;
+  constexpr int32_t max_length = 16;
+  const std::vector<int32_t> input_ids{1, 2, 3, 4, 5, 6};
+
+  // The sequences of greedy search without a draft decoder.
+  std::vector<int32_t> expected_output;
+  for (size_t i = 0; i < static_cast<size_t>(batch_size); i++) {
+    size_t sum = 0;
+    for (size_t j = 0; j < static_cast<size_t>(max_length); j++) {
+      const int32_t token = j < static_cast<size_t>(sequence_length)
+                                ? input_ids[i * sequence_length + j]
+                                : static_cast<int32_t>(next_tokens[(2 * sum) % next_tokens.size()]);
+      expected_output.push_back(token);
+      sum += static_cast<size_t>(token);
+    }
+  }
+
+  OpTester test("GreedySearch", 1, kMSDomain);
+  test.AddAttribute<int64_t>("eos_token_id", -1);
+  test.AddAttribute<int64_t>("pad_token_id", 0);
+  test.AddAttribute<int64_t>("num_speculative_tokens", 3);
+  test.AddAttribute("decoder", CreateTokenSumDecoder(next_tokens));
+  test.AddAttribute("draft_decoder", CreateTokenSumDecoder(draft_next_tokens));
+
+  test.AddInput<int32_t>("input_ids", {batch_size, sequence_length}, input_ids);
+  test.AddInput<int32_t>("max_length", {1}, {max_length});
+  test.AddOutput<int32_t>("sequences", {batch_size, max_length}, expected_output);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
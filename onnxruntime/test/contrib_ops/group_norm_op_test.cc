@@ -731,13 +731,17 @@ TEST(GroupNormTest, GroupNorm_128) {
   int min_cuda_architecture = 530;
   bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
   bool enable_rocm = (nullptr != DefaultRocmExecutionProvider().get());
+  bool enable_cpu = (nullptr != DefaultCpuExecutionProvider().get());
   bool enable_dml = (nullptr != DefaultDmlExecutionProvider().get());
 
   std::array<int, 3> channels_last_values = {-1, 0, 1};
 
   for (const int channels_last : channels_last_values) {
-    if (enable_cuda || enable_rocm || enable_dml) {
+    if (enable_cpu || enable_cuda || enable_rocm || enable_dml) {
       std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      if (enable_cpu) {
+        execution_providers.push_back(DefaultCpuExecutionProvider());
+      }
       if (enable_cuda && channels_last != 0) {
         execution_providers.push_back(DefaultCudaExecutionProvider());
       }
@@ -784,8 +788,11 @@ TEST(GroupNormTest, GroupNorm_128) {
 
     // Test float32, with activation
     enable_cuda = HasCudaEnvironment(0);
-    if (enable_cuda || enable_rocm || enable_dml) {
+    if (enable_cpu || enable_cuda || enable_rocm || enable_dml) {
       std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      if (enable_cpu) {
+        execution_providers.push_back(DefaultCpuExecutionProvider());
+      }
       if (enable_cuda && channels_last != 0) {
         execution_providers.push_back(DefaultCudaExecutionProvider());
       }
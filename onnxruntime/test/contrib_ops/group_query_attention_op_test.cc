@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GroupQueryAttentionTest, QuantizedKVCache) {
+  // One decoding step of two heads of Q sharing one kv head, with an int8 KV cache that has two scales per token.
+  constexpr int num_heads = 2;
+  constexpr int kv_num_heads = 1;
+  constexpr int head_size = 4;
+  constexpr int num_scale_blocks = 2;
+  constexpr int block_size = head_size / num_scale_blocks;
+  constexpr int past_sequence_length = 2;
+  constexpr int total_sequence_length = past_sequence_length + 1;
+
+  std::vector<int8_t> past_key = {10, -20, 30, -40, 127, 0, -64, 5};
+  std::vector<float> past_key_scale = {0.1f, 0.05f, 0.02f, 0.2f};
+  std::vector<int8_t> past_value = {1, 2, 3, 4, -5, 6, -7, 8};
+  std::vector<float> past_value_scale = {0.5f, 0.25f, 1.0f, 0.125f};
+
+  // The new token is exactly representable, so its quantized values and scales are known.
+  std::vector<float> query = {0.1f, 0.2f, -0.1f, 0.05f, 0.0f, -0.05f, 0.02f, 0.1f};
+  std::vector<float> key = {63.5f, -1.0f, 0.5f, -63.5f};
+  std::vector<float> value = {2.0f, -127.0f, 0.25f, -31.75f};
+
+  std::vector<int8_t> present_key = past_key;
+  present_key.insert(present_key.end(), {127, -2, 1, -127});
+  std::vector<float> present_key_scale = past_key_scale;
+  present_key_scale.insert(present_key_scale.end(), {0.5f, 0.5f});
+  std::vector<int8_t> present_value = past_value;
+  present_value.insert(present_value.end(), {2, -127, 1, -127});
+  std::vector<float> present_value_scale = past_value_scale;
+  present_value_scale.insert(present_value_scale.end(), {1.0f, 0.25f});
+
+  auto dequantize = [](const std::vector<int8_t>& data, const std::vector<float>& scales) {
+    std::vector<float> result(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      result[i] = static_cast<float>(data[i]) * scales[i / block_size];
+    }
+    return result;
+  };
+  const std::vector<float> k = dequantize(present_key, present_key_scale);
+  const std::vector<float> v = dequantize(present_value, present_value_scale);
+
+  std::vector<float> output(query.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int n = 0; n < num_heads; n++) {
+    const float* q = query.data() + n * head_size;
+    std::vector<float> probs(total_sequence_length);
+    float sum = 0.0f;
+    for (int j = 0; j < total_sequence_length; j++) {
+      float score = 0.0f;
+      for (int h = 0; h < head_size; h++) {
+        score += q[h] * k[j * head_size + h];
+      }
+      probs[j] = std::exp(score * scale);
+      sum += probs[j];
+    }
+    for (int h = 0; h < head_size; h++) {
+      float result = 0.0f;
+      for (int j = 0; j < total_sequence_length; j++) {
+        result += probs[j] / sum * v[j * head_size + h];
+      }
+      output[n * head_size + h] = result;
+    }
+  }
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddAttribute<int64_t>("kv_num_heads", static_cast<int64_t>(kv_num_heads));
+  tester.AddInput<float>("query", {1, 1, num_heads * head_size}, query);
+  tester.AddInput<float>("key", {1, 1, kv_num_heads * head_size}, key);
+  tester.AddInput<float>("value", {1, 1, kv_num_heads * head_size}, value);
+  tester.AddInput<int8_t>("past_key", {1, kv_num_heads, past_sequence_length, head_size}, past_key);
+  tester.AddInput<int8_t>("past_value", {1, kv_num_heads, past_sequence_length, head_size}, past_value);
+  tester.AddInput<int32_t>("seqlens_k", {1}, {total_sequence_length - 1});
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {total_sequence_length});
+  tester.AddOptionalInputEdge<float>();    // cos_cache
+  tester.AddOptionalInputEdge<float>();    // sin_cache
+  tester.AddOptionalInputEdge<int64_t>();  // position_ids
+  tester.AddOptionalInputEdge<float>();    // attention_bias
+  tester.AddOptionalInputEdge<int32_t>();  // block_table
+  tester.AddInput<float>("past_key_scale", {1, kv_num_heads, past_sequence_length, num_scale_blocks},
+                         past_key_scale);
+  tester.AddInput<float>("past_value_scale", {1, kv_num_heads, past_sequence_length, num_scale_blocks},
+                         past_value_scale);
+
+  tester.AddOutput<float>("output", {1, 1, num_heads * head_size}, output, /*sort*/ false, 0.0001f, 0.0001f);
+  tester.AddOutput<int8_t>("present_key", {1, kv_num_heads, total_sequence_length, head_size}, present_key);
+  tester.AddOutput<int8_t>("present_value", {1, kv_num_heads, total_sequence_length, head_size}, present_value);
+  tester.AddOutput<float>("present_key_scale", {1, kv_num_heads, total_sequence_length, num_scale_blocks},
+                          present_key_scale);
+  tester.AddOutput<float>("present_value_scale", {1, kv_num_heads, total_sequence_length, num_scale_blocks},
+                          present_value_scale);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GroupQueryAttentionTest, RotaryKVCache) {
+  // One decoding step with rotary embedding, where the rotated K and the new V are appended to the past KV cache.
+  constexpr int num_heads = 2;
+  constexpr int kv_num_heads = 1;
+  constexpr int head_size = 4;
+  constexpr int half_head_size = head_size / 2;
+  constexpr int past_sequence_length = 2;
+  constexpr int total_sequence_length = past_sequence_length + 1;
+  constexpr int max_sequence_length = 4;
+
+  std::vector<float> past_key = {0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f, 0.7f, -0.8f};
+  std::vector<float> past_value = {1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f};
+  std::vector<float> query = {0.5f, -0.25f, 0.75f, 1.0f, -0.5f, 0.25f, 0.125f, -1.0f};
+  std::vector<float> key = {0.2f, 0.4f, -0.6f, 0.8f};
+  std::vector<float> value = {0.5f, -0.5f, 1.5f, -1.5f};
+
+  std::vector<float> cos_cache(max_sequence_length * half_head_size);
+  std::vector<float> sin_cache(max_sequence_length * half_head_size);
+  for (int position = 0; position < max_sequence_length; position++) {
+    for (int i = 0; i < half_head_size; i++) {
+      const float angle = static_cast<float>(position) / std::pow(10000.0f, 2.0f * i / head_size);
+      cos_cache[position * half_head_size + i] = std::cos(angle);
+      sin_cache[position * half_head_size + i] = std::sin(angle);
+    }
+  }
+
+  // The new token is at position past_sequence_length, and rotates the two halves of each head.
+  auto rotate = [&](const float* x, float* y) {
+    const float* cos_data = cos_cache.data() + past_sequence_length * half_head_size;
+    const float* sin_data = sin_cache.data() + past_sequence_length * half_head_size;
+    for (int i = 0; i < half_head_size; i++) {
+      y[i] = x[i] * cos_data[i] - x[i + half_head_size] * sin_data[i];
+      y[i + half_head_size] = x[i + half_head_size] * cos_data[i] + x[i] * sin_data[i];
+    }
+  };
+  std::vector<float> rotated_query(query.size());
+  for (int n = 0; n < num_heads; n++) {
+    rotate(query.data() + n * head_size, rotated_query.data() + n * head_size);
+  }
+  std::vector<float> present_key = past_key;
+  present_key.resize(total_sequence_length * head_size);
+  rotate(key.data(), present_key.data() + past_sequence_length * head_size);
+  std::vector<float> present_value = past_value;
+  present_value.insert(present_value.end(), value.begin(), value.end());
+
+  std::vector<float> output(query.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int n = 0; n < num_heads; n++) {
+    const float* q = rotated_query.data() + n * head_size;
+    std::vector<float> probs(total_sequence_length);
+    float sum = 0.0f;
+    for (int j = 0; j < total_sequence_length; j++) {
+      float score = 0.0f;
+      for (int h = 0; h < head_size; h++) {
+        score += q[h] * present_key[j * head_size + h];
+      }
+      probs[j] = std::exp(score * scale);
+      sum += probs[j];
+    }
+    for (int h = 0; h < head_size; h++) {
+      float result = 0.0f;
+      for (int j = 0; j < total_sequence_length; j++) {
+        result += probs[j] / sum * present_value[j * head_size + h];
+      }
+      output[n * head_size + h] = result;
+    }
+  }
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddAttribute<int64_t>("kv_num_heads", static_cast<int64_t>(kv_num_heads));
+  tester.AddAttribute<int64_t>("do_rotary", 1);
+  tester.AddInput<float>("query", {1, 1, num_heads * head_size}, query);
+  tester.AddInput<float>("key", {1, 1, kv_num_heads * head_size}, key);
+  tester.AddInput<float>("value", {1, 1, kv_num_heads * head_size}, value);
+  tester.AddInput<float>("past_key", {1, kv_num_heads, past_sequence_length, head_size}, past_key);
+  tester.AddInput<float>("past_value", {1, kv_num_heads, past_sequence_length, head_size}, past_value);
+  tester.AddInput<int32_t>("seqlens_k", {1}, {total_sequence_length - 1});
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {total_sequence_length});
+  tester.AddInput<float>("cos_cache", {max_sequence_length, half_head_size}, cos_cache);
+  tester.AddInput<float>("sin_cache", {max_sequence_length, half_head_size}, sin_cache);
+
+  tester.AddOutput<float>("output", {1, 1, num_heads * head_size}, output, /*sort*/ false, 0.0001f, 0.0001f);
+  tester.AddOutput<float>("present_key", {1, kv_num_heads, total_sequence_length, head_size}, present_key,
+                          /*sort*/ false, 0.0001f, 0.0001f);
+  tester.AddOutput<float>("present_value", {1, kv_num_heads, total_sequence_length, head_size}, present_value);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
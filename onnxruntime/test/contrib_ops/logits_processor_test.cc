@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::NextTokenScores;
+using contrib::transformers::NoRepeatNGramLogitsProcessor;
+using contrib::transformers::Sequences;
+
+namespace {
+
+constexpr int kVocabSize = 4;
+
+// The tokens banned after a sequence by scanning all of its n-grams.
+std::vector<bool> BannedTokens(gsl::span<const int32_t> sequence, int ngram_size) {
+  std::vector<bool> banned(kVocabSize, false);
+  const int length = static_cast<int>(sequence.size());
+  for (int j = 0; j + ngram_size <= length; j++) {
+    bool match = true;
+    for (int k = 0; k < ngram_size - 1; k++) {
+      match = match && sequence[j + k] == sequence[length - ngram_size + 1 + k];
+    }
+    if (match) {
+      banned[sequence[j + ngram_size - 1]] = true;
+    }
+  }
+  return banned;
+}
+
+void VerifyProcess(NoRepeatNGramLogitsProcessor<float>& processor, const Sequences& sequences, int batch_beam_size,
+                   int ngram_size) {
+  std::vector<float> scores_data(batch_beam_size * kVocabSize, 0.0f);
+  gsl::span<float> scores(scores_data);
+  NextTokenScores<float> next_token_scores{scores, batch_beam_size, kVocabSize};
+  processor.Process(&sequences, next_token_scores);
+
+  for (int i = 0; i < batch_beam_size; i++) {
+    const std::vector<bool> banned = BannedTokens(sequences.GetSequence(i), ngram_size);
+    for (int token = 0; token < kVocabSize; token++) {
+      EXPECT_EQ(banned[token], scores_data[i * kVocabSize + token] == std::numeric_limits<float>::lowest())
+          << "beam " << i << " token " << token << " at length " << sequences.GetSequenceLength();
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LogitsProcessorTest, NoRepeatNGramAcrossSteps) {
+  constexpr int batch_beam_size = 2;
+  constexpr int prompt_length = 3;
+  constexpr int max_length = 12;
+  constexpr int ngram_size = 2;
+
+  std::vector<int32_t> buffer(2 * batch_beam_size * max_length, 0);
+  const std::vector<int32_t> prompt = {0, 1, 2, 3, 1, 0};
+  std::copy(prompt.begin(), prompt.begin() + prompt_length, buffer.begin());
+  std::copy(prompt.begin() + prompt_length, prompt.end(), buffer.begin() + max_length);
+
+  Sequences sequences;
+  sequences.Init(buffer, batch_beam_size, prompt_length, max_length);
+  NoRepeatNGramLogitsProcessor<float> processor(ngram_size);
+  VerifyProcess(processor, sequences, batch_beam_size, ngram_size);
+
+  // Greedy steps extend every sequence in place, then beam steps select and swap the beams.
+  const std::vector<std::vector<int32_t>> tokens = {{1, 3}, {2, 1}, {1, 0}, {3, 1}, {1, 2}, {2, 0}};
+  const std::vector<std::vector<int32_t>> beam_indices = {{0, 0}, {1, 0}, {1, 1}};
+  for (size_t step = 0; step < tokens.size(); step++) {
+    std::vector<int32_t> next_tokens = tokens[step];
+    gsl::span<int32_t> next_tokens_span(next_tokens);
+    if (step < tokens.size() - beam_indices.size()) {
+      sequences.AppendNextTokenToSequences(next_tokens_span);
+    } else {
+      std::vector<int32_t> indices = beam_indices[step + beam_indices.size() - tokens.size()];
+      gsl::span<int32_t> indices_span(indices);
+      sequences.AppendNextTokenToSequences(indices_span, next_tokens_span);
+    }
+    VerifyProcess(processor, sequences, batch_beam_size, ngram_size);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,7 +3,9 @@
 
 #ifndef ORT_MINIMAL_BUILD
 
+#include <cmath>
 #include <optional>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -81,6 +83,11 @@ struct TestOptions {
   bool has_g_idx{false};
   bool has_bias{false};
 
+  // the epilogue, Y = activation(A * B + bias) * gate + skip
+  std::string activation{};
+  bool has_gate{false};
+  bool has_skip{false};
+
   std::optional<float> output_abs_error{};
   std::optional<float> output_rel_error{};
 };
@@ -92,7 +99,10 @@ struct TestOptions {
             << ", has_zero_point:" << opts.has_zero_point
             << ", zp_is_4bit:" << opts.zp_is_4bit
             << ", has_g_idx:" << opts.has_g_idx
-            << ", has_bias:" << opts.has_bias;
+            << ", has_bias:" << opts.has_bias
+            << ", activation:" << opts.activation
+            << ", has_gate:" << opts.has_gate
+            << ", has_skip:" << opts.has_skip;
 }
 
 template <typename T1>
@@ -160,6 +170,10 @@ void RunTest(const TestOptions& opts,
     return std::nullopt;
   }();
 
+  const std::vector<int64_t> output_shape = {M, N};
+  const std::vector<float> gate = opts.has_gate ? random.Uniform(output_shape, -2.0f, 2.0f) : std::vector<float>{};
+  const std::vector<float> skip = opts.has_skip ? random.Uniform(output_shape, -2.0f, 2.0f) : std::vector<float>{};
+
   std::vector<float> expected_vals(M * N);
   for (int64_t m = 0; m < M; m++) {
     for (int64_t n = 0; n < N; n++) {
@@ -167,7 +181,19 @@ void RunTest(const TestOptions& opts,
       for (int64_t k = 0; k < K; k++) {
         sum += input0_vals[m * K + k] * input1_f_vals[n * K + k];
       }
-      expected_vals[m * N + n] = sum + (bias.has_value() ? (*bias)[n] : 0.0f);
+      sum += bias.has_value() ? (*bias)[n] : 0.0f;
+      if (opts.activation == "Gelu") {
+        sum = 0.5f * sum * (1.0f + std::erf(sum * static_cast<float>(M_SQRT1_2)));
+      } else if (opts.activation == "Silu") {
+        sum = sum / (1.0f + std::exp(-sum));
+      }
+      if (opts.has_gate) {
+        sum *= gate[m * N + n];
+      }
+      if (opts.has_skip) {
+        sum += skip[m * N + n];
+      }
+      expected_vals[m * N + n] = sum;
     }
   }
 
@@ -177,6 +203,9 @@ void RunTest(const TestOptions& opts,
   test.AddAttribute<int64_t>("block_size", opts.block_size);
   test.AddAttribute<int64_t>("bits", QBits);
   test.AddAttribute<int64_t>("accuracy_level", opts.accuracy_level);
+  if (!opts.activation.empty()) {
+    test.AddAttribute<std::string>("activation", opts.activation);
+  }
 
   if constexpr (use_float16) {
     test.AddInput<T1>("A", {M, K}, ToFloat16(input0_vals), false);
@@ -244,6 +273,24 @@ void RunTest(const TestOptions& opts,
     test.AddOptionalInputEdge<T1>();
   }
 
+  if (opts.has_gate) {
+    if constexpr (use_float16) {
+      test.AddInput<T1>("gate", output_shape, ToFloat16(gate));
+    } else {
+      test.AddInput<T1>("gate", output_shape, gate);
+    }
+  } else if (opts.has_skip) {
+    test.AddOptionalInputEdge<T1>();
+  }
+
+  if (opts.has_skip) {
+    if constexpr (use_float16) {
+      test.AddInput<T1>("skip", output_shape, ToFloat16(skip));
+    } else {
+      test.AddInput<T1>("skip", output_shape, skip);
+    }
+  }
+
   if constexpr (use_float16) {
     test.AddOutput<T1>("Y", {M, N}, ToFloat16(expected_vals));
   } else {
@@ -395,6 +442,145 @@ TEST(MatMulNBits, Float32_Accuracy4) {
   TestMatMulNBitsTyped<float, 100, 288, 1234, 16, 4>();
 }
 
+// The epilogue that MatMulNBitsFusion folds into the node is only implemented by the CPU EP.
+template <typename AType>
+void TestMatMulNBitsEpilogue(int64_t accuracy_level) {
+  for (int64_t M : {1, 5}) {
+    for (const char* activation : {"", "Gelu", "Silu"}) {
+      for (bool has_gate : {false, true}) {
+        for (bool has_skip : {false, true}) {
+          TestOptions opts{};
+          opts.M = M, opts.N = 96, opts.K = 64;
+          opts.block_size = 32;
+          opts.accuracy_level = accuracy_level;
+          opts.has_bias = true;
+          opts.activation = activation;
+          opts.has_gate = has_gate;
+          opts.has_skip = has_skip;
+          if (accuracy_level == 4) {
+            opts.output_abs_error = 0.1f;
+            opts.output_rel_error = 0.02f;
+          } else if constexpr (std::is_same<AType, MLFloat16>::value) {
+            opts.output_abs_error = 0.055f;
+            opts.output_rel_error = 0.02f;
+          } else {
+            opts.output_abs_error = 0.0001f;
+          }
+
+          for (bool has_g_idx : {false, true}) {
+            // g_idx goes through the dequantized B and the float GEMM, which apply the epilogue afterwards
+            opts.has_g_idx = has_g_idx;
+            std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+            explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+            RunTest<AType>(opts, std::move(explicit_eps));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(MatMulNBits, Float32_Epilogue) {
+  TestMatMulNBitsEpilogue<float>(0);
+  TestMatMulNBitsEpilogue<float>(4);
+}
+
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
+TEST(MatMulNBits, Float16_Epilogue) {
+  TestMatMulNBitsEpilogue<MLFloat16>(0);
+}
+#endif
+
+namespace {
+
+// Packs `values` of `bits` bits each into a little-endian bit stream starting at `dst`.
+void PackBits(const uint8_t* values, size_t count, int64_t bits, uint8_t* dst) {
+  for (size_t i = 0; i < count; i++) {
+    for (int64_t b = 0; b < bits; b++) {
+      const size_t bit_offset = i * bits + b;
+      dst[bit_offset / 8] |= static_cast<uint8_t>(((values[i] >> b) & 1) << (bit_offset % 8));
+    }
+  }
+}
+
+// 2b and 3b weights are only supported by the CPU EP, which dequantizes B before the float GEMM.
+void RunLowBitTest(int64_t bits, int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zero_point) {
+  SCOPED_TRACE(::testing::Message() << "bits:" << bits << ", M:" << M << ", N:" << N << ", K:" << K
+                                    << ", block_size:" << block_size << ", has_zero_point:" << has_zero_point);
+
+  const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+  const int64_t blob_size = (block_size * bits + 7) / 8;
+  const int64_t zp_bytes_per_col = (blocks_per_col * bits + 7) / 8;
+  const uint8_t q_range = static_cast<uint8_t>(1 << bits);
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  std::vector<float> scales(random.Uniform<float>(AsSpan({N, blocks_per_col}), 0.01f, 0.1f));
+  std::vector<uint8_t> q_vals(random.Uniform<uint8_t>(AsSpan({N, blocks_per_col * block_size}), uint8_t{0}, q_range));
+  std::vector<uint8_t> zp_vals(random.Uniform<uint8_t>(AsSpan({N, blocks_per_col}), uint8_t{0}, q_range));
+
+  std::vector<uint8_t> b_data(static_cast<size_t>(N * blocks_per_col * blob_size), 0);
+  std::vector<uint8_t> zp_data(static_cast<size_t>(N * zp_bytes_per_col), 0);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t blk = 0; blk < blocks_per_col; blk++) {
+      PackBits(q_vals.data() + (n * blocks_per_col + blk) * block_size, static_cast<size_t>(block_size), bits,
+               b_data.data() + (n * blocks_per_col + blk) * blob_size);
+    }
+    PackBits(zp_vals.data() + n * blocks_per_col, static_cast<size_t>(blocks_per_col), bits,
+             zp_data.data() + n * zp_bytes_per_col);
+  }
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t blk = k / block_size;
+        const float zp = has_zero_point ? zp_vals[n * blocks_per_col + blk] : static_cast<float>(1 << (bits - 1));
+        const float b = (q_vals[n * blocks_per_col * block_size + k] - zp) * scales[n * blocks_per_col + blk];
+        sum += a_vals[m * K + k] * b;
+      }
+      expected_vals[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", 0);
+
+  test.AddInput<float>("A", {M, K}, a_vals, false);
+  test.AddInput<uint8_t>("B", {N, blocks_per_col, blob_size}, b_data, true);
+  test.AddInput<float>("scales", {N * blocks_per_col}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zp_bytes_per_col}, zp_data, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+  test.SetOutputAbsErr("Y", 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers));
+  test.RunWithConfig();
+}
+
+}  // namespace
+
+TEST(MatMulNBits, Float32_LowBits) {
+  for (int64_t bits : {2, 3}) {
+    for (bool has_zero_point : {false, true}) {
+      RunLowBitTest(bits, 1, 1, 16, 16, has_zero_point);
+      RunLowBitTest(bits, 1, 288, 93, 32, has_zero_point);
+      RunLowBitTest(bits, 2, 32, 1024, 128, has_zero_point);
+      RunLowBitTest(bits, 100, 288, 1234, 16, has_zero_point);
+    }
+  }
+}
+
 #if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
 #if !defined(USE_DML)
 // Actual and expected difference is over 0.01 with DmlExecutionProvider.
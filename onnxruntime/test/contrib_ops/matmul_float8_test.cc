@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+#include "core/framework/float8.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename T8>
+void RunMatMulFloat8Test(const std::vector<int64_t>& a_dims, int64_t K, int64_t N, bool per_column_scale,
+                         bool b_is_initializer) {
+  const int64_t M = std::accumulate(a_dims.begin(), a_dims.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+
+  std::vector<float> a(static_cast<size_t>(M * K));
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<float>(static_cast<int64_t>(i % 13) - 6) / 4.0f;
+  }
+
+  std::vector<T8> b;
+  b.reserve(static_cast<size_t>(K * N));
+  for (int64_t i = 0; i < K * N; i++) {
+    b.push_back(T8(static_cast<float>(static_cast<int64_t>((i * 7) % 23) - 11) / 8.0f, true));
+  }
+
+  std::vector<float> scale(per_column_scale ? static_cast<size_t>(N) : 1);
+  for (size_t i = 0; i < scale.size(); i++) {
+    scale[i] = 0.5f + static_cast<float>(i % 5) / 8.0f;
+  }
+
+  std::vector<float> y(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * b[k * N + n].ToFloat();
+      }
+      y[m * N + n] = sum * scale[per_column_scale ? n : 0];
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims);
+  y_dims.back() = N;
+
+  OpTester test("MatMulFloat8", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddInput<float>("A", a_dims, a);
+  test.AddInput<T8>("B", {K, N}, b, b_is_initializer);
+  if (per_column_scale) {
+    test.AddInput<float>("B_scale", {N}, scale, true);
+  } else {
+    test.AddInput<float>("B_scale", {}, scale, true);
+  }
+  test.AddOutput<float>("Y", y_dims, y);
+  test.SetOutputRelErr("Y", 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MatMulFloat8OpTest, E4M3FN) {
+  for (bool per_column_scale : {false, true}) {
+    RunMatMulFloat8Test<Float8E4M3FN>({1, 32}, 32, 16, per_column_scale, true);
+    RunMatMulFloat8Test<Float8E4M3FN>({3, 5, 70}, 70, 37, per_column_scale, true);
+    RunMatMulFloat8Test<Float8E4M3FN>({2, 300}, 300, 20, per_column_scale, false);
+  }
+}
+
+TEST(MatMulFloat8OpTest, E5M2) {
+  for (bool per_column_scale : {false, true}) {
+    RunMatMulFloat8Test<Float8E5M2>({1, 32}, 32, 16, per_column_scale, true);
+    RunMatMulFloat8Test<Float8E5M2>({3, 5, 70}, 70, 37, per_column_scale, true);
+    RunMatMulFloat8Test<Float8E5M2>({2, 300}, 300, 20, per_column_scale, false);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y[b] = X[b] * W + (X[b] * lora_a[i]) * lora_b[i] with i = adapter_indices[b], computed row by row.
+std::vector<float> ReferenceMultiLoRAMatMul(const std::vector<float>& x, const std::vector<float>& w,
+                                            const std::vector<float>& lora_a, const std::vector<float>& lora_b,
+                                            const std::vector<int32_t>& adapter_indices,
+                                            int sequence_length, int K, int N, int rank) {
+  const int batch_size = static_cast<int>(adapter_indices.size());
+  std::vector<float> y(static_cast<size_t>(batch_size) * sequence_length * N);
+  for (int b = 0; b < batch_size; b++) {
+    const int adapter = adapter_indices[b];
+    for (int s = 0; s < sequence_length; s++) {
+      const float* x_row = x.data() + (b * sequence_length + s) * K;
+      float* y_row = y.data() + (b * sequence_length + s) * N;
+      std::vector<float> xa(rank);
+      if (adapter >= 0) {
+        for (int r = 0; r < rank; r++) {
+          for (int k = 0; k < K; k++) {
+            xa[r] += x_row[k] * lora_a[(adapter * K + k) * rank + r];
+          }
+        }
+      }
+      for (int n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int k = 0; k < K; k++) {
+          sum += x_row[k] * w[k * N + n];
+        }
+        if (adapter >= 0) {
+          for (int r = 0; r < rank; r++) {
+            sum += xa[r] * lora_b[(adapter * rank + r) * N + n];
+          }
+        }
+        y_row[n] = sum;
+      }
+    }
+  }
+  return y;
+}
+
+}  // namespace
+
+TEST(MultiLoRAMatMulTest, AdapterPerBatchEntry) {
+  constexpr int batch_size = 5;
+  constexpr int sequence_length = 2;
+  constexpr int K = 4;
+  constexpr int N = 3;
+  constexpr int num_adapters = 3;
+  constexpr int rank = 2;
+
+  std::vector<float> x(batch_size * sequence_length * K);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  std::vector<float> w(K * N);
+  for (size_t i = 0; i < w.size(); i++) {
+    w[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  }
+  std::vector<float> lora_a(num_adapters * K * rank);
+  for (size_t i = 0; i < lora_a.size(); i++) {
+    lora_a[i] = static_cast<float>(static_cast<int>(i % 3) - 1) * 0.125f * static_cast<float>(i / (K * rank) + 1);
+  }
+  std::vector<float> lora_b(num_adapters * rank * N);
+  for (size_t i = 0; i < lora_b.size(); i++) {
+    lora_b[i] = static_cast<float>(static_cast<int>(i % 4) - 1) * 0.5f;
+  }
+
+  // Entries 1 and 2 share a segment, entry 3 has no adapter and entry 4 goes back to adapter 0.
+  const std::vector<int32_t> adapter_indices = {0, 2, 2, -1, 0};
+  const std::vector<float> y = ReferenceMultiLoRAMatMul(x, w, lora_a, lora_b, adapter_indices,
+                                                        sequence_length, K, N, rank);
+
+  OpTester tester("MultiLoRAMatMul", 1, onnxruntime::kMSDomain);
+  tester.AddInput<float>("X", {batch_size, sequence_length, K}, x);
+  tester.AddInput<float>("W", {K, N}, w);
+  tester.AddInput<float>("lora_a", {num_adapters, K, rank}, lora_a);
+  tester.AddInput<float>("lora_b", {num_adapters, rank, N}, lora_b);
+  tester.AddInput<int32_t>("adapter_indices", {batch_size}, adapter_indices);
+  tester.AddOutput<float>("Y", {batch_size, sequence_length, N}, y, /*sort*/ false, 0.0001f, 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MultiLoRAMatMulTest, AdapterIndexOutOfRange) {
+  OpTester tester("MultiLoRAMatMul", 1, onnxruntime::kMSDomain);
+  tester.AddInput<float>("X", {1, 1, 2}, {1.0f, 2.0f});
+  tester.AddInput<float>("W", {2, 1}, {1.0f, 1.0f});
+  tester.AddInput<float>("lora_a", {1, 2, 1}, {1.0f, 1.0f});
+  tester.AddInput<float>("lora_b", {1, 1, 1}, {1.0f});
+  tester.AddInput<int32_t>("adapter_indices", {1}, {1});
+  tester.AddOutput<float>("Y", {1, 1, 1}, {0.0f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "is out of range", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -756,5 +756,65 @@ TEST(MultiHeadAttentionTest, CrossAttention_DiffSequenceLengths_UsingDMMHAInside
   RunMultiHeadAttentionTests(data, DISABLE_CPU | DISABLE_ROCM_MHA | DISABLE_WEBGPU | DISABLE_DML);
 }
 
+TEST(MultiHeadAttentionTest, CrossAttention_KVSharedByBeams) {
+  // Whisper decoder cross attention in beam search, where K and V in BNSH format are not expanded for the beams.
+  constexpr int batch_size = 2;
+  constexpr int beam_width = 2;
+  constexpr int num_heads = 2;
+  constexpr int head_size = 2;
+  constexpr int kv_sequence_length = 3;
+  constexpr int hidden_size = num_heads * head_size;
+
+  std::vector<float> query(batch_size * beam_width * hidden_size);
+  std::vector<float> key(batch_size * num_heads * kv_sequence_length * head_size);
+  std::vector<float> value(key.size());
+  for (size_t i = 0; i < query.size(); i++) {
+    query[i] = static_cast<float>(i % 5) * 0.25f - 0.5f;
+  }
+  for (size_t i = 0; i < key.size(); i++) {
+    key[i] = static_cast<float>(i % 7) * 0.125f - 0.375f;
+    value[i] = static_cast<float>(i % 3) - 1.0f + static_cast<float>(i) * 0.0625f;
+  }
+
+  // Row b of the query attends to the K and V of batch b / beam_width.
+  std::vector<float> output(query.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size * beam_width; b++) {
+    for (int n = 0; n < num_heads; n++) {
+      const float* q = query.data() + b * hidden_size + n * head_size;
+      const size_t kv_offset = static_cast<size_t>(((b / beam_width) * num_heads + n) * kv_sequence_length * head_size);
+      std::vector<float> probs(kv_sequence_length);
+      float sum = 0.0f;
+      for (int j = 0; j < kv_sequence_length; j++) {
+        float score = 0.0f;
+        for (int h = 0; h < head_size; h++) {
+          score += q[h] * key[kv_offset + j * head_size + h];
+        }
+        probs[j] = std::exp(score * scale);
+        sum += probs[j];
+      }
+      for (int h = 0; h < head_size; h++) {
+        float result = 0.0f;
+        for (int j = 0; j < kv_sequence_length; j++) {
+          result += probs[j] / sum * value[kv_offset + j * head_size + h];
+        }
+        output[b * hidden_size + n * head_size + h] = result;
+      }
+    }
+  }
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddInput<float>("query", {batch_size * beam_width, 1, hidden_size}, query);
+  tester.AddInput<float>("key", {batch_size, num_heads, kv_sequence_length, head_size}, key);
+  tester.AddInput<float>("value", {batch_size, num_heads, kv_sequence_length, head_size}, value);
+  tester.AddOutput<float>("output", {batch_size * beam_width, 1, hidden_size}, output,
+                          /*sort*/ false, 0.0001f, 0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
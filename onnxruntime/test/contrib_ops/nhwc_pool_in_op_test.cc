@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 
 //
-// Test module for NWHC fp16 internal operators
+// Test module for NWHC fp16 and fp32 internal operators
 //
 
 #include <algorithm>
@@ -512,5 +512,67 @@ TEST(NhwcFp16PoolOpTest, GlobalAveragePool) {
 }
 
 #endif
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(NhwcFp32PoolOpTest, MaxPool2D) {
+  OpTester test("MaxPool", 12, onnxruntime::kMSInternalNHWCDomain);
+
+  test.AddAttribute("strides", std::vector<int64_t>{1, 1});
+  test.AddAttribute("pads", std::vector<int64_t>{0, 0, 1, 1});
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+
+  std::vector<float> x_vals = {1.0f, -1.0f, 2.0f, -2.0f, 3.0f, -3.0f,
+                               4.0f, -4.0f, 5.0f, -5.0f, 6.0f, -6.0f,
+                               7.0f, -7.0f, 8.0f, -8.0f, 9.0f, -9.0f};
+  std::vector<int64_t> x_dims = {1, 3, 3, 2};
+  std::vector<int64_t> expected_dims = {1, 3, 3, 2};
+  std::vector<float> expected_vals = {5.0f, -1.0f, 6.0f, -2.0f, 6.0f, -3.0f,
+                                      8.0f, -4.0f, 9.0f, -5.0f, 9.0f, -6.0f,
+                                      8.0f, -7.0f, 9.0f, -8.0f, 9.0f, -9.0f};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
+TEST(NhwcFp32PoolOpTest, AvgPoolIncludePadPixel) {
+  OpTester test("AveragePool", 11, onnxruntime::kMSInternalNHWCDomain);
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", std::vector<int64_t>{1, 1});
+  test.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  test.AddAttribute("count_include_pad", (int64_t)1);
+  std::vector<float> x_vals = {0.3337f, 0.8794f, 0.3375f,
+                               0.6666f, 0.4426f, 0.6474f,
+                               0.7675f, 0.8823f, 0.8852f};
+
+  std::vector<int64_t> x_dims = {1, 3, 3, 1};
+  std::vector<int64_t> expected_dims = {1, 4, 4, 1};
+  std::vector<float> expected_vals = {0.083425f, 0.303275f, 0.304225f, 0.084375f,
+                                      0.250075f, 0.580575f, 0.576725f, 0.246225f,
+                                      0.358525f, 0.689750f, 0.714375f, 0.383150f,
+                                      0.191875f, 0.412450f, 0.441875f, 0.221300f};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
+TEST(NhwcFp32PoolOpTest, GlobalAveragePool) {
+  OpTester test("GlobalAveragePool", 1, onnxruntime::kMSInternalNHWCDomain);
+
+  std::vector<float> x_vals = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+  std::vector<int64_t> x_dims = {1, 2, 2, 2};
+  std::vector<int64_t> expected_dims = {1, 1, 1, 2};
+  std::vector<float> expected_vals = {4.0f, 5.0f};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
+#endif  // DISABLE_CONTRIB_OPS
 }  // namespace test
 }  // namespace onnxruntime
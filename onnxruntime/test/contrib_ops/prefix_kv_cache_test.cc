@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::PrefixKVCache;
+
+namespace {
+
+constexpr int64_t kNumHeads = 2;
+constexpr int64_t kHeadSize = 3;
+constexpr size_t kBlockSize = 4;
+
+// The present state of a layer for `length` tokens, where the value at each position is unique to the token id
+// at that position, so that a lookup returns the values of the tokens it matched.
+OrtValue MakePresent(gsl::span<const int32_t> tokens, int layer, AllocatorPtr allocator) {
+  const int64_t length = static_cast<int64_t>(tokens.size());
+  OrtValue present;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({2, 1, kNumHeads, length, kHeadSize}), allocator,
+                       present);
+  float* data = present.GetMutable<Tensor>()->MutableData<float>();
+  for (int64_t row = 0; row < 2 * kNumHeads; ++row) {
+    for (int64_t step = 0; step < length; ++step) {
+      for (int64_t i = 0; i < kHeadSize; ++i) {
+        *data++ = static_cast<float>(((layer * 4 + row) * 1000 + tokens[step]) * 10 + i);
+      }
+    }
+  }
+  return present;
+}
+
+std::vector<OrtValue> MakePresents(gsl::span<const int32_t> tokens, AllocatorPtr allocator) {
+  return {MakePresent(tokens, 0, allocator), MakePresent(tokens, 1, allocator)};
+}
+
+std::vector<int32_t> Tokens(int32_t first, size_t count) {
+  std::vector<int32_t> tokens(count);
+  std::iota(tokens.begin(), tokens.end(), first);
+  return tokens;
+}
+
+}  // namespace
+
+TEST(PrefixKVCacheTest, LookupReturnsPastOfWholeBlocks) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  PrefixKVCache cache(kBlockSize, 1 << 20);
+
+  const std::vector<int32_t> prompt = Tokens(1, 10);
+  cache.Insert(prompt, MakePresents(prompt, allocator), allocator);
+  EXPECT_EQ(cache.NumBlocks(), 2u);
+
+  // A prompt which shares the first 9 tokens matches the 2 whole blocks.
+  std::vector<int32_t> other_prompt = prompt;
+  other_prompt[9] = 100;
+  std::vector<OrtValue> past;
+  ASSERT_EQ(cache.Lookup(other_prompt, other_prompt.size() - 1, allocator, past), 8u);
+  ASSERT_EQ(past.size(), 2u);
+
+  const auto expected = MakePresents(gsl::make_span(prompt).first(8), allocator);
+  for (size_t layer = 0; layer < past.size(); ++layer) {
+    const Tensor& past_tensor = past[layer].Get<Tensor>();
+    ASSERT_EQ(past_tensor.Shape(), TensorShape({2, 1, kNumHeads, 8, kHeadSize}));
+    auto actual_values = past_tensor.DataAsSpan<float>();
+    auto expected_values = expected[layer].Get<Tensor>().DataAsSpan<float>();
+    EXPECT_TRUE(std::equal(actual_values.begin(), actual_values.end(), expected_values.begin()));
+  }
+
+  // The match is limited to max_length, and to the blocks before the first difference.
+  EXPECT_EQ(cache.Lookup(prompt, 7, allocator, past), 4u);
+  other_prompt[5] = 100;
+  EXPECT_EQ(cache.Lookup(other_prompt, other_prompt.size(), allocator, past), 4u);
+  other_prompt[0] = 100;
+  EXPECT_EQ(cache.Lookup(other_prompt, other_prompt.size(), allocator, past), 0u);
+}
+
+TEST(PrefixKVCacheTest, PromptsShareTheBlocksOfTheirCommonPrefix) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  PrefixKVCache cache(kBlockSize, 1 << 20);
+
+  std::vector<int32_t> first_prompt = Tokens(1, 8);
+  std::vector<int32_t> second_prompt = first_prompt;
+  second_prompt[6] = 100;
+  cache.Insert(first_prompt, MakePresents(first_prompt, allocator), allocator);
+  const size_t block_bytes = cache.SizeInBytes() / 2;
+  cache.Insert(second_prompt, MakePresents(second_prompt, allocator), allocator);
+
+  EXPECT_EQ(cache.NumBlocks(), 3u);
+  EXPECT_EQ(cache.SizeInBytes(), 3 * block_bytes);
+
+  std::vector<OrtValue> past;
+  EXPECT_EQ(cache.Lookup(first_prompt, first_prompt.size(), allocator, past), 8u);
+  EXPECT_EQ(cache.Lookup(second_prompt, second_prompt.size(), allocator, past), 8u);
+}
+
+TEST(PrefixKVCacheTest, EvictsLeastRecentlyUsedBlocks) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  const std::vector<int32_t> first_prompt = Tokens(1, 8);
+  const std::vector<int32_t> second_prompt = Tokens(100, 8);
+  const std::vector<int32_t> third_prompt = Tokens(200, 8);
+
+  size_t block_bytes = 0;
+  {
+    PrefixKVCache probe(kBlockSize, 1 << 20);
+    probe.Insert(first_prompt, MakePresents(first_prompt, allocator), allocator);
+    block_bytes = probe.SizeInBytes() / 2;
+  }
+
+  PrefixKVCache cache(kBlockSize, 4 * block_bytes);
+  cache.Insert(first_prompt, MakePresents(first_prompt, allocator), allocator);
+  cache.Insert(second_prompt, MakePresents(second_prompt, allocator), allocator);
+  EXPECT_EQ(cache.NumBlocks(), 4u);
+
+  // The use of the first prompt makes the second one the least recently used, whose last block and then first block
+  // are evicted.
+  std::vector<OrtValue> past;
+  EXPECT_EQ(cache.Lookup(first_prompt, first_prompt.size(), allocator, past), 8u);
+  cache.Insert(third_prompt, MakePresents(third_prompt, allocator), allocator);
+  EXPECT_EQ(cache.NumBlocks(), 4u);
+  EXPECT_LE(cache.SizeInBytes(), 4 * block_bytes);
+
+  EXPECT_EQ(cache.Lookup(first_prompt, first_prompt.size(), allocator, past), 8u);
+  EXPECT_EQ(cache.Lookup(second_prompt, second_prompt.size(), allocator, past), 0u);
+  EXPECT_EQ(cache.Lookup(third_prompt, third_prompt.size(), allocator, past), 8u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
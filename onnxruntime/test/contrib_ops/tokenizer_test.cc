@@ -677,6 +677,54 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_SingleCharSeparatorsNC) {
+  // Separators of one ASCII character split on all of them at once
+  {
+    OpTester test("Tokenizer", opset_ver, domain);
+    InitTestAttr(test, true, {" ", ",", "\\."}, 2);
+
+    std::vector<int64_t> dims{2, 2};
+    std::vector<std::string> input{"ab,c d.中文", "x", "Абсу, ñó..pq", " ,. "};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<int64_t> output_dims(dims);
+    output_dims.push_back(int64_t(5));
+    std::vector<std::string> output{
+        start_mark, "ab", "中文", end_mark, padval,
+        start_mark, end_mark, padval, padval, padval,
+        start_mark, "Абсу", "ñó", "pq", end_mark,
+        start_mark, end_mark, padval, padval, padval};
+
+    test.AddOutput<std::string>("Y", output_dims, output);
+
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+  // Large enough to be tokenized in several blocks
+  {
+    OpTester test("Tokenizer", opset_ver, domain);
+    InitTestAttr(test, false, {" ", ","}, 1);
+
+    constexpr int64_t rows = 2048;
+    std::vector<int64_t> dims{rows};
+    std::vector<std::string> input;
+    std::vector<std::string> output;
+    for (int64_t i = 0; i < rows; ++i) {
+      const std::string word = "w" + std::to_string(i);
+      if (i % 3 == 0) {
+        input.push_back(word + " and,more text");
+        output.insert(output.end(), {word, "and", "more", "text"});
+      } else {
+        input.push_back(word + ",,only");
+        output.insert(output.end(), {word, "only", padval, padval});
+      }
+    }
+    test.AddInput<std::string>("T", dims, input);
+    test.AddOutput<std::string>("Y", {rows, 4}, output);
+
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp("a.");
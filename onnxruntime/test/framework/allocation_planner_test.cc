@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -716,6 +717,41 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// A freed buffer of known size is reused for a smaller output of another shape, unless it is more than twice as large.
+TEST_F(PlannerTest, ReuseLargerBufferTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X2: temporary, freed after X3 is computed
+  AddNormalNode(X2, X3);  // X3: temporary, freed after X4 is computed
+  AddNormalNode(X3, X4);  // X4: temporary smaller than X2, reuses it
+  AddNormalNode(X4, X5);  // X5: temporary much smaller than X3
+  AddNormalNode(X5, X6);  // X6: output
+
+  // simulate shape-inference results:
+  Shape shape1w{4, 8};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{2, 12};
+  auto shape2 = &shape2w.value;
+  Shape shape3w{1, 2};
+  auto shape3 = &shape3w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape3}, {X6, shape3}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocate);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+
+  int x2_idx, x4_idx;
+  index(X2, x2_idx);
+  index(X4, x4_idx);
+  EXPECT_EQ(plan_->allocation_plan[x4_idx].reused_buffer, x2_idx);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -2001,8 +2037,69 @@ TEST_F(PlannerTest, TestMultiStreamMismatchDevice) {
   status = sess.Initialize();
   ASSERT_TRUE(!status.IsOK());
 }
+
+// The long Relu chain is the critical path, so it stays on one stream and the short Neg leg goes to the other one.
+TEST_F(PlannerTest, TestCriticalPathPartitioner) {
+  const char* config_file_path = "./critical_path_partitioner_config.json";
+  {
+    std::ofstream of_stream(config_file_path);
+    ASSERT_TRUE(of_stream.is_open());
+    of_stream << R"({"type":"CriticalPathPartitioner","streams_per_device":2,)"
+              << R"("node_costs":{"relu_0":10,"relu_1":10,"relu_2":10,"relu_3":10,"neg_0":1,"add_0":1}})";
+  }
+
+  auto graph_partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                                     ORT_TSTR("./critical_path_partitioner_config.json"));
+  ASSERT_TRUE(graph_partitioner && strcmp(graph_partitioner->Type(), "CriticalPathPartitioner") == 0);
+
+  onnxruntime::Model model("critical_path", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  auto* chain_out = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& graph_in = *chain_out;
+  for (int i = 0; i < 4; ++i) {
+    auto& relu_out = graph.GetOrCreateNodeArg("relu_" + std::to_string(i) + "_out", &float_tensor);
+    graph.AddNode("relu_" + std::to_string(i), "Relu", "", {chain_out}, {&relu_out});
+    chain_out = &relu_out;
+  }
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_0_out", &float_tensor);
+  graph.AddNode("neg_0", "Neg", "", {&graph_in}, {&neg_out});
+  auto& graph_out = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add_0", "Add", "", {chain_out, &neg_out}, {&graph_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+  std::stringstream sstr(model_data);
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+  ASSERT_STATUS_OK(sess.Load(sstr));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& session_state = sess.GetSessionState();
+  const auto* exe_plan = session_state.GetExecutionPlan();
+  ASSERT_EQ(exe_plan->execution_plan.size(), 2u);
+
+  InlinedHashMap<std::string, size_t> node_stream;
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    node_stream[node.Name()] = exe_plan->node_stream_map_[node.Index()];
+  }
+  for (int i = 1; i < 4; ++i) {
+    EXPECT_EQ(node_stream["relu_" + std::to_string(i)], node_stream["relu_0"]);
+  }
+  EXPECT_EQ(node_stream["add_0"], node_stream["relu_0"]);
+  EXPECT_NE(node_stream["neg_0"], node_stream["relu_0"]);
+}
 #endif
 
+
 #if defined(USE_CUDA) && defined(ORT_ENABLE_STREAM)
 TEST_F(PlannerTest, TestCpuIf) {
   SessionOptions sess_opt;
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/arena_trimmer.h"
+
+#include <thread>
+
+#include "core/framework/bfc_arena.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+std::shared_ptr<BFCArena> CreateArena() {
+  return std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+}
+
+int64_t ReservedBytes(IAllocator& arena) {
+  AllocatorStats stats;
+  arena.GetStats(&stats);
+  return stats.total_allocated_bytes;
+}
+}  // namespace
+
+TEST(ArenaTrimmerTest, ShrinksAfterIdleTimeout) {
+  auto arena = CreateArena();
+  std::atomic<int> num_active_runs{0};
+  ArenaTrimPolicy policy;
+  policy.idle_timeout = std::chrono::hours(1);
+  policy.check_interval = std::chrono::hours(1);
+  ArenaTrimmer trimmer({arena}, policy, num_active_runs, DefaultLoggingManager().DefaultLogger());
+
+  void* kept = arena->Alloc(1024);
+  arena->Free(arena->Alloc(10 * 1024 * 1024));
+  const auto now = std::chrono::steady_clock::now();
+  // nothing to trim before the first run
+  EXPECT_EQ(trimmer.TrimIfNeeded(now + std::chrono::hours(2)), 0u);
+
+  trimmer.NotifyRunEnd();
+  EXPECT_EQ(trimmer.TrimIfNeeded(now), 0u);
+
+  // not while a run is in progress
+  num_active_runs = 1;
+  EXPECT_EQ(trimmer.TrimIfNeeded(now + std::chrono::hours(2)), 0u);
+  num_active_runs = 0;
+
+  EXPECT_EQ(trimmer.TrimIfNeeded(now + std::chrono::hours(2)), 1u);
+  EXPECT_EQ(ReservedBytes(*arena), 1024);
+  EXPECT_EQ(trimmer.NumTrims(), 1u);
+
+  // at most once between two runs
+  EXPECT_EQ(trimmer.TrimIfNeeded(now + std::chrono::hours(3)), 0u);
+  arena->Free(kept);
+}
+
+TEST(ArenaTrimmerTest, ShrinksAboveReservedRatio) {
+  auto arena = CreateArena();
+  std::atomic<int> num_active_runs{0};
+  ArenaTrimPolicy policy;
+  policy.max_reserved_to_in_use_ratio = 4.0;
+  policy.check_interval = std::chrono::hours(1);
+  ArenaTrimmer trimmer({arena}, policy, num_active_runs, DefaultLoggingManager().DefaultLogger());
+
+  void* kept = arena->Alloc(1024 * 1024);
+  void* p = arena->Alloc(2 * 1024 * 1024);
+  trimmer.NotifyRunEnd();
+  // 3 MB reserved for 3 MB in use
+  EXPECT_EQ(trimmer.TrimIfNeeded(std::chrono::steady_clock::now()), 0u);
+
+  arena->Free(p);
+  trimmer.NotifyRunEnd();
+  // 3 MB reserved for 1 MB in use
+  EXPECT_EQ(trimmer.TrimIfNeeded(std::chrono::steady_clock::now()), 0u);
+
+  void* large = arena->Alloc(8 * 1024 * 1024);
+  arena->Free(large);
+  trimmer.NotifyRunEnd();
+  // 11 MB reserved for 1 MB in use
+  EXPECT_EQ(trimmer.TrimIfNeeded(std::chrono::steady_clock::now()), 1u);
+  EXPECT_EQ(ReservedBytes(*arena), 1024 * 1024);
+  arena->Free(kept);
+}
+
+TEST(ArenaTrimmerTest, BackgroundThreadShrinksIdleArenas) {
+  auto arena = CreateArena();
+  std::atomic<int> num_active_runs{0};
+  ArenaTrimPolicy policy;
+  policy.idle_timeout = std::chrono::milliseconds(20);
+  ArenaTrimmer trimmer({arena}, policy, num_active_runs, DefaultLoggingManager().DefaultLogger());
+
+  arena->Free(arena->Alloc(10 * 1024 * 1024));
+  trimmer.NotifyRunEnd();
+  for (int i = 0; i < 500 && trimmer.NumTrims() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(trimmer.NumTrims(), 1u);
+  EXPECT_EQ(ReservedBytes(*arena), 0);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +308,113 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestFragmentationStats) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  void* p1 = a.Alloc(1024);
+  void* p2 = a.Alloc(2048);
+  void* p3 = a.Alloc(1024);
+  // leave a hole between p1 and p3
+  a.Free(p2);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  const auto fragmentation = a.GetFragmentationStats();
+  EXPECT_EQ(fragmentation.bytes_in_use, 2048u);
+  EXPECT_EQ(fragmentation.bytes_in_use + fragmentation.free_bytes, static_cast<size_t>(stats.total_allocated_bytes));
+  // the free bytes are split between the hole and the rest of the region
+  EXPECT_EQ(fragmentation.largest_free_chunk, fragmentation.free_bytes - 2048);
+
+  size_t bin_bytes_in_use = 0;
+  size_t bin_free_bytes = 0;
+  size_t free_chunks = 0;
+  for (const auto& bin : fragmentation.bins) {
+    EXPECT_GT(bin.chunks_in_use + bin.free_chunks, 0u);
+    bin_bytes_in_use += bin.bytes_in_use;
+    bin_free_bytes += bin.free_bytes;
+    free_chunks += bin.free_chunks;
+  }
+  EXPECT_EQ(bin_bytes_in_use, fragmentation.bytes_in_use);
+  EXPECT_EQ(bin_free_bytes, fragmentation.free_bytes);
+  EXPECT_EQ(free_chunks, 2u);
+
+  a.Free(p1);
+  a.Free(p3);
+}
+
+TEST(BFCArenaTest, TestChunkCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096);
+
+  void* p1k = a.Alloc(1024);
+  a.Free(p1k);
+  // the freed chunk is served again from the cache
+  void* p1k_again = a.Alloc(1000);
+  EXPECT_EQ(p1k_again, p1k);
+  EXPECT_EQ(a.AllocatedSize(p1k_again), 1024u);
+
+  // requests larger than the cache limit bypass the cache
+  void* p1m = a.Alloc(1024 * 1024);
+  a.Free(p1m);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_chunk_cache_hits, 1);
+  EXPECT_EQ(stats.num_chunk_cache_misses, 1);
+  EXPECT_EQ(stats.num_allocs, 3);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+
+  // cached chunks stay in use in the arena until Shrink returns them
+  a.Free(p1k_again);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, TestChunkCacheMultiThreaded) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024);
+
+  // chunks are allocated on one thread and freed on another to exercise the cross-shard paths
+  std::vector<void*> ptrs(256);
+  auto alloc_fn = [&a, &ptrs](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      ptrs[i] = a.Alloc(128 * (i + 1));
+    }
+  };
+  auto free_fn = [&a, &ptrs](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      a.Free(ptrs[i]);
+    }
+  };
+
+  for (int iter = 0; iter < 4; ++iter) {
+    std::thread t1(alloc_fn, 0, 128), t2(alloc_fn, 128, 256);
+    t1.join();
+    t2.join();
+
+    std::vector<void*> sorted_ptrs(ptrs);
+    std::sort(sorted_ptrs.begin(), sorted_ptrs.end());
+    ASSERT_EQ(std::adjacent_find(sorted_ptrs.begin(), sorted_ptrs.end()), sorted_ptrs.end()) << "No dups";
+
+    std::thread t3(free_fn, 128, 256), t4(free_fn, 0, 128);
+    t3.join();
+    t4.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_chunk_cache_hits + stats.num_chunk_cache_misses, 4 * 256);
+  EXPECT_EQ(stats.num_allocs, 4 * 256);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
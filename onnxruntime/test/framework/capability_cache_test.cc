@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/capability_cache.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "core/framework/execution_provider.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Fuses all the nodes of the graph.
+class FuseAllExecutionProvider : public IExecutionProvider {
+ public:
+  FuseAllExecutionProvider() : IExecutionProvider{"FuseAllExecutionProvider"} {}
+
+  std::vector<std::unique_ptr<ComputeCapability>> GetCapabilities(const GraphViewer& graph_viewer) const {
+    ++num_calls;
+    auto sub_graph = std::make_unique<IndexedSubGraph>();
+    for (const auto& node : graph_viewer.Nodes()) {
+      sub_graph->nodes.push_back(node.Index());
+    }
+    auto meta_def = std::make_unique<IndexedSubGraph::MetaDef>();
+    meta_def->name = "FuseAll";
+    meta_def->domain = "FuseTest";
+    meta_def->since_version = 1;
+    meta_def->inputs = {"Input3"};
+    meta_def->outputs = {"Plus214_Output_0"};
+    ONNX_NAMESPACE::AttributeProto attribute;
+    attribute.set_name("precision");
+    attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+    attribute.set_s("fp16");
+    meta_def->attributes.emplace("precision", attribute);
+    sub_graph->SetMetaDef(std::move(meta_def));
+
+    std::vector<std::unique_ptr<ComputeCapability>> result;
+    result.push_back(std::make_unique<ComputeCapability>(std::move(sub_graph)));
+    return result;
+  }
+
+  bool CanCacheCapabilities() const override { return true; }
+
+  mutable int num_calls = 0;
+};
+
+std::filesystem::path CreateCacheDirectory() {
+  const auto directory = std::filesystem::temp_directory_path() / "ort_capability_cache_test";
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+}  // namespace
+
+TEST(CapabilityCacheTest, StoresCapabilities) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mnist.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  const GraphViewer graph_viewer(model->MainGraph());
+
+  std::unique_ptr<CapabilityCache> cache;
+  const auto directory = CreateCacheDirectory();
+  ASSERT_STATUS_OK(CapabilityCache::Create(directory, DefaultLoggingManager().DefaultLogger(), cache));
+
+  FuseAllExecutionProvider ep;
+  const auto get_capabilities = [&]() { return ep.GetCapabilities(graph_viewer); };
+  const auto expected = cache->GetCapabilities(graph_viewer, ep, get_capabilities);
+  ASSERT_EQ(ep.num_calls, 1);
+
+  // the second query is served from the file written by the first one
+  const auto capabilities = cache->GetCapabilities(graph_viewer, ep, get_capabilities);
+  ASSERT_EQ(ep.num_calls, 1);
+  ASSERT_EQ(capabilities.size(), 1u);
+  EXPECT_EQ(capabilities[0]->sub_graph->nodes, expected[0]->sub_graph->nodes);
+  const auto* meta_def = capabilities[0]->sub_graph->GetMetaDef();
+  ASSERT_NE(meta_def, nullptr);
+  EXPECT_EQ(meta_def->name, "FuseAll");
+  EXPECT_EQ(meta_def->domain, "FuseTest");
+  EXPECT_EQ(meta_def->since_version, 1);
+  EXPECT_EQ(meta_def->inputs, expected[0]->sub_graph->GetMetaDef()->inputs);
+  EXPECT_EQ(meta_def->outputs, expected[0]->sub_graph->GetMetaDef()->outputs);
+  ASSERT_EQ(meta_def->attributes.count("precision"), 1u);
+  EXPECT_EQ(meta_def->attributes.at("precision").s(), "fp16");
+
+  // a corrupted file is ignored and rewritten
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    std::ofstream(entry.path(), std::ios::binary | std::ios::trunc) << "not a cache file";
+  }
+  EXPECT_EQ(cache->GetCapabilities(graph_viewer, ep, get_capabilities).size(), 1u);
+  EXPECT_EQ(ep.num_calls, 2);
+  EXPECT_EQ(cache->GetCapabilities(graph_viewer, ep, get_capabilities).size(), 1u);
+  EXPECT_EQ(ep.num_calls, 2);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(CapabilityCacheTest, KeyDependsOnAssignments) {
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mnist.onnx"), model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+  FuseAllExecutionProvider ep;
+
+  const std::string key = CapabilityCache::ComputeKey(GraphViewer(graph), ep);
+  EXPECT_EQ(key.size(), 32u);
+  EXPECT_EQ(CapabilityCache::ComputeKey(GraphViewer(graph), ep), key);
+
+  // the capabilities of an EP depend on the nodes assigned to the EPs before it
+  graph.Nodes().begin()->SetExecutionProviderType(kCpuExecutionProvider);
+  EXPECT_NE(CapabilityCache::ComputeKey(GraphViewer(graph), ep), key);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/data_transfer_manager.h"
+
+#include <cstring>
+
+#include "core/framework/tensor.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Copies between CPU and a device whose memory is host memory, and counts the batches.
+class CountingDataTransfer : public IDataTransfer {
+ public:
+  explicit CountingDataTransfer(OrtDevice::DeviceType device_type) : device_type_{device_type} {}
+
+  bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override {
+    return src_device.Type() == device_type_ || dst_device.Type() == device_type_;
+  }
+
+  using IDataTransfer::CopyTensor;
+  Status CopyTensor(const Tensor& src, Tensor& dst) const override {
+    memcpy(dst.MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    return Status::OK();
+  }
+
+  Status CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const override {
+    batch_sizes.push_back(src_dst_pairs.size());
+    return IDataTransfer::CopyTensors(src_dst_pairs);
+  }
+
+  mutable std::vector<size_t> batch_sizes;
+
+ private:
+  const OrtDevice::DeviceType device_type_;
+};
+}  // namespace
+
+TEST(DataTransferManagerTest, CopyTensorsBatchesPerDataTransfer) {
+  DataTransferManager manager;
+  auto gpu_transfer = std::make_unique<CountingDataTransfer>(OrtDevice::GPU);
+  auto fpga_transfer = std::make_unique<CountingDataTransfer>(OrtDevice::FPGA);
+  const auto* gpu = gpu_transfer.get();
+  const auto* fpga = fpga_transfer.get();
+  ASSERT_STATUS_OK(manager.RegisterDataTransfer(std::move(gpu_transfer)));
+  ASSERT_STATUS_OK(manager.RegisterDataTransfer(std::move(fpga_transfer)));
+
+  const OrtMemoryInfo cpu_info(CPU, OrtDeviceAllocator);
+  const OrtMemoryInfo gpu_info("FakeGpu", OrtDeviceAllocator,
+                               OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0));
+  const OrtMemoryInfo fpga_info("FakeFpga", OrtDeviceAllocator,
+                                OrtDevice(OrtDevice::FPGA, OrtDevice::MemType::DEFAULT, 0));
+  const TensorShape shape{4};
+  const auto type = DataTypeImpl::GetType<float>();
+
+  std::vector<std::vector<float>> src_data{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+  std::vector<std::vector<float>> dst_data(src_data.size(), std::vector<float>(4));
+  std::vector<Tensor> src;
+  std::vector<Tensor> dst;
+  src.emplace_back(type, shape, src_data[0].data(), cpu_info);
+  dst.emplace_back(type, shape, dst_data[0].data(), gpu_info);
+  src.emplace_back(type, shape, src_data[1].data(), cpu_info);
+  dst.emplace_back(type, shape, dst_data[1].data(), fpga_info);
+  src.emplace_back(type, shape, src_data[2].data(), gpu_info);
+  dst.emplace_back(type, shape, dst_data[2].data(), cpu_info);
+
+  std::vector<IDataTransfer::SrcDstPair> pairs;
+  for (size_t i = 0; i < src.size(); ++i) {
+    pairs.push_back({src[i], dst[i], nullptr});
+  }
+  ASSERT_STATUS_OK(manager.CopyTensors(pairs));
+
+  EXPECT_EQ(gpu->batch_sizes, std::vector<size_t>{2});
+  EXPECT_EQ(fpga->batch_sizes, std::vector<size_t>{1});
+  EXPECT_EQ(dst_data, src_data);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include <cfloat>
 #include <functional>
 #include <iterator>
+#include <numeric>
 #include <thread>
 #include <fstream>
 #include <random>
@@ -48,6 +49,8 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/pipeline_executor.h"
+#include "core/session/shape_specializer.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -56,10 +59,16 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace ONNX_NAMESPACE;
 using namespace onnxruntime::logging;
 using namespace onnxruntime::concurrency;
@@ -405,6 +414,38 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+#ifndef _WIN32
+TEST(InferenceSessionTests, PreforkSafe) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.PreforkSafe";
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsPreforkSafe, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+
+  // the session initialized in the parent process runs in the forked one
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    RunModel(session_object, run_options);
+    _exit(::testing::Test::HasFailure() ? 1 : 0);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  RunModel(session_object, run_options);
+}
+#endif
+
 TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   SessionOptions so;
 
@@ -421,6 +462,598 @@ TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   RunModel(session_object, run_options);
 }
 
+// Concurrent runs with different batch sizes are batched together and each caller gets its own rows back.
+TEST(InferenceSessionTests, MicroBatchingConcurrentRuns) {
+  onnxruntime::Model model("micro_batching", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("mul", "Mul", "", {&x, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MicroBatchingConcurrentRuns";
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMicroBatchingMaxBatchSize, "8"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMicroBatchingMaxDelayMicroseconds, "50000"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  constexpr int num_callers = 4;
+  std::vector<Status> statuses(num_callers);
+  std::vector<std::vector<float>> outputs(num_callers);
+  std::vector<std::vector<int64_t>> output_dims(num_callers);
+  std::vector<std::thread> callers;
+  for (int caller = 0; caller < num_callers; ++caller) {
+    callers.emplace_back([&, caller]() {
+      // caller i sends i + 1 rows filled with i + 1
+      const int64_t num_rows = caller + 1;
+      std::vector<int64_t> dims{num_rows, 2};
+      std::vector<float> values(static_cast<size_t>(num_rows * 2), static_cast<float>(caller + 1));
+      OrtValue feed;
+      CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &feed);
+      const char* feed_names[] = {"X"};
+      const OrtValue* feeds[] = {&feed};
+      const char* fetch_names[] = {"Y"};
+      OrtValue* fetches[] = {nullptr};
+
+      RunOptions run_options;
+      statuses[caller] = session_object.Run(run_options, feed_names, feeds, fetch_names, fetches);
+      if (statuses[caller].IsOK()) {
+        std::unique_ptr<OrtValue> fetch{fetches[0]};
+        const auto& tensor = fetch->Get<Tensor>();
+        const auto dims = tensor.Shape().GetDims();
+        output_dims[caller].assign(dims.begin(), dims.end());
+        outputs[caller].assign(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  for (int caller = 0; caller < num_callers; ++caller) {
+    ASSERT_STATUS_OK(statuses[caller]);
+    const float expected = static_cast<float>((caller + 1) * (caller + 1));
+    EXPECT_EQ(output_dims[caller], (std::vector<int64_t>{caller + 1, 2}));
+    EXPECT_EQ(outputs[caller], std::vector<float>(static_cast<size_t>((caller + 1) * 2), expected));
+  }
+}
+
+// A session with the batch dimension fixed is built once one batch size dominates the runs, and only serves it.
+TEST(InferenceSessionTests, ShapeSpecialization) {
+  onnxruntime::Model model("shape_specialization", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("mul", "Mul", "", {&x, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  std::vector<FreeDimensionOverride> specialized_overrides;
+  InferenceSessionWrapper* specialized_session = nullptr;
+  auto create_session = [&](const std::vector<FreeDimensionOverride>& overrides,
+                            std::unique_ptr<InferenceSession>& session) -> Status {
+    SessionOptions so;
+    so.free_dimension_overrides = overrides;
+    auto wrapper = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    ORT_RETURN_IF_ERROR(wrapper->Load(model_data.data(), static_cast<int>(model_data.size())));
+    ORT_RETURN_IF_ERROR(wrapper->Initialize());
+    specialized_overrides = overrides;
+    specialized_session = wrapper.get();
+    session = std::move(wrapper);
+    return Status::OK();
+  };
+  ShapeSpecializer specializer(graph.GetInputs(), 2, create_session, DefaultLoggingManager().DefaultLogger());
+
+  auto make_feed = [](int64_t batch) {
+    OrtValue feed;
+    std::vector<float> values(static_cast<size_t>(batch * 2), 3.0f);
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {batch, 2}, values, &feed);
+    return feed;
+  };
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<OrtValue> batch_3{make_feed(3)};
+  const std::vector<OrtValue> batch_1{make_feed(1)};
+
+  // batch 3 is seen in 2 of the 3 runs, which starts the build on the third one
+  EXPECT_EQ(specializer.GetSession(feed_names, batch_3), nullptr);
+  EXPECT_EQ(specializer.GetSession(feed_names, batch_1), nullptr);
+  EXPECT_EQ(specializer.GetSession(feed_names, batch_3), nullptr);
+
+  InferenceSession* session = nullptr;
+  for (int i = 0; i < 1000 && session == nullptr; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    session = specializer.GetSession(feed_names, batch_3);
+  }
+  ASSERT_NE(session, nullptr);
+  EXPECT_EQ(session, specialized_session);
+  EXPECT_EQ(specializer.GetSession(feed_names, batch_1), nullptr);
+
+  ASSERT_EQ(specialized_overrides.size(), 1u);
+  EXPECT_EQ(specialized_overrides[0].dim_identifier, "batch");
+  EXPECT_EQ(specialized_overrides[0].dim_value, 3);
+  const auto* input_shape = specialized_session->GetGraph().GetInputs()[0]->Shape();
+  ASSERT_NE(input_shape, nullptr);
+  EXPECT_EQ(input_shape->dim(0).dim_value(), 3);
+
+  // The session routes the runs with the dominating batch size without changing their results.
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecialization";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeSpecializationMinRuns, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const std::vector<std::string> output_names{"Y"};
+  for (int run = 0; run < 8; ++run) {
+    const auto& feeds = run % 4 == 1 ? batch_1 : batch_3;
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), feed_names, feeds, output_names, &fetches, nullptr));
+    const auto& output = fetches[0].Get<Tensor>();
+    EXPECT_EQ(output.Shape(), feeds[0].Get<Tensor>().Shape());
+    for (const float value : output.DataAsSpan<float>()) {
+      EXPECT_EQ(value, 9.0f);
+    }
+  }
+}
+
+// The stages get about the same weight, and each one at least a node.
+TEST(InferenceSessionTests, PipelineStageSplit) {
+  EXPECT_THAT(PipelineExecutor::SplitIntoStages(std::vector<size_t>{1, 10, 1, 1, 10, 1}, 3),
+              ::testing::ElementsAre(0, 2, 4));
+  EXPECT_THAT(PipelineExecutor::SplitIntoStages(std::vector<size_t>{100, 1, 1}, 3), ::testing::ElementsAre(0, 1, 2));
+  EXPECT_THAT(PipelineExecutor::SplitIntoStages(std::vector<size_t>{1, 1}, 4), ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(PipelineExecutor::SplitIntoStages(std::vector<size_t>{5}, 2), ::testing::ElementsAre(0));
+}
+
+// Concurrent runs split into micro-batches go through two stage sessions and get the results of the whole model.
+TEST(InferenceSessionTests, PipelineExecutorRuns) {
+  constexpr int64_t kWidth = 64;
+  onnxruntime::Model model("pipeline", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(kWidth);
+  ONNX_NAMESPACE::TypeProto weight_type;
+  weight_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(kWidth);
+  // large enough to be passed to the stage by address
+  std::vector<float> weight_values(kWidth);
+  std::iota(weight_values.begin(), weight_values.end(), 0.0f);
+  ONNX_NAMESPACE::TensorProto weight;
+  weight.set_name("W");
+  weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weight.add_dims(kWidth);
+  weight.set_raw_data(weight_values.data(), weight_values.size() * sizeof(float));
+  graph.AddInitializedTensor(weight);
+
+  // Y = (X + W) * X + (X + W), where X + W is computed by the first stage and used by both nodes of the second one
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("W", &weight_type);
+  auto& a = graph.GetOrCreateNodeArg("A", &float_tensor);
+  auto& b = graph.GetOrCreateNodeArg("B", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add_weight", "Add", "", {&x, &w}, {&a});
+  graph.AddNode("mul", "Mul", "", {&a, &x}, {&b});
+  graph.AddNode("add", "Add", "", {&b, &a}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::vector<size_t> stage_node_counts;
+  auto create_session = [&](size_t, const std::string& model_data, std::unique_ptr<InferenceSession>& session) {
+    SessionOptions so;
+    session = std::make_unique<InferenceSession>(so, GetEnvironment());
+    ORT_RETURN_IF_ERROR(session->Load(model_data.data(), static_cast<int>(model_data.size())));
+    ONNX_NAMESPACE::ModelProto model_proto;
+    ORT_RETURN_IF_NOT(model_proto.ParseFromString(model_data), "Invalid stage model");
+    stage_node_counts.push_back(static_cast<size_t>(model_proto.graph().node_size()));
+    return session->Initialize();
+  };
+  DataTransferManager data_transfer_mgr;
+  ASSERT_STATUS_OK(data_transfer_mgr.RegisterDataTransfer(std::make_unique<CPUDataTransfer>()));
+  const std::vector<OrtDevice> devices(2);
+  std::unique_ptr<PipelineExecutor> executor;
+  ASSERT_STATUS_OK(PipelineExecutor::Create(model, devices, 2, create_session, data_transfer_mgr,
+                                            DefaultLoggingManager().DefaultLogger(), executor));
+  ASSERT_EQ(executor->NumStages(), 2u);
+  EXPECT_THAT(stage_node_counts, ::testing::ElementsAre(1, 2));
+
+  auto run = [&](int64_t batch) {
+    std::vector<float> values(static_cast<size_t>(batch * kWidth));
+    std::iota(values.begin(), values.end(), 1.0f);
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {batch, kWidth}, values, &feed);
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(executor->Run(RunOptions(), std::vector<std::string>{"X"}, std::vector<OrtValue>{feed},
+                                   std::vector<std::string>{"Y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape(), TensorShape({batch, kWidth}));
+    const auto output_values = output.DataAsSpan<float>();
+    for (size_t i = 0; i < values.size(); ++i) {
+      const float sum = values[i] + weight_values[i % kWidth];
+      EXPECT_EQ(output_values[i], sum * values[i] + sum);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int64_t batch = 1; batch <= 4; ++batch) {
+    threads.emplace_back(run, batch);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<OrtValue> fetches;
+  EXPECT_FALSE(executor->Run(RunOptions(), {}, {}, std::vector<std::string>{"A"}, &fetches).IsOK());
+}
+
+// Sessions of a model with the same large initializer use a single copy of it, which is freed with the last session.
+TEST(InferenceSessionTests, ShareInitializersAcrossSessions) {
+  onnxruntime::Model model("share_initializers", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+  ONNX_NAMESPACE::TensorProto weight;
+  weight.set_name("W");
+  weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weight.add_dims(16);
+  for (int i = 0; i < 16; ++i) {
+    weight.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(weight);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &w}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShareInitializersAcrossSessions";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShareInitializersMinBytes, "64"));
+  const auto& cache = GetEnvironment().GetSharedInitializerCache();
+  const size_t num_values = cache.NumberOfValues();
+
+  auto create_session = [&]() {
+    auto session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    EXPECT_STATUS_OK(session->Load(model_data.data(), static_cast<int>(model_data.size())));
+    EXPECT_STATUS_OK(session->Initialize());
+    return session;
+  };
+  auto weight_data = [](const InferenceSessionWrapper& session) -> const void* {
+    int w_idx = -1;
+    EXPECT_STATUS_OK(session.GetSessionState().GetOrtValueNameIdxMap().GetIdx("W", w_idx));
+    return session.GetSessionState().GetConstantInitializedTensors().at(w_idx).Get<Tensor>().DataRaw();
+  };
+
+  auto session_1 = create_session();
+  auto session_2 = create_session();
+  EXPECT_EQ(cache.NumberOfValues(), num_values + 1);
+  EXPECT_EQ(weight_data(*session_1), weight_data(*session_2));
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {16},
+                       std::vector<float>(16, 1.0f), &feed);
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<OrtValue> feeds{feed};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_2->Run(RunOptions(), feed_names, feeds, output_names, &fetches, nullptr));
+  const auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  for (size_t i = 0; i < y_values.size(); ++i) {
+    EXPECT_EQ(y_values[i], static_cast<float>(i) + 1.0f);
+  }
+
+  session_1.reset();
+  EXPECT_EQ(cache.NumberOfValues(), num_values + 1);
+  session_2.reset();
+  EXPECT_EQ(cache.NumberOfValues(), num_values);
+}
+
+TEST(InferenceSessionTests, RunMany) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunMany";
+  so.intra_op_param.thread_pool_size = 4;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // run i multiplies X filled with i + 1 by itself
+  constexpr int num_runs = 16;
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<NameMLValMap> feeds(num_runs);
+  for (int run = 0; run < num_runs; ++run) {
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x,
+                         std::vector<float>(6, static_cast<float>(run + 1)), &ml_value);
+    feeds[run].insert(std::make_pair("X", ml_value));
+  }
+
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::vector<OrtValue>> fetches;
+  ASSERT_STATUS_OK(session_object.RunMany(RunOptions(), feeds, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), static_cast<size_t>(num_runs));
+  for (int run = 0; run < num_runs; ++run) {
+    VerifyOutputs(fetches[run], dims_mul_x, std::vector<float>(6, static_cast<float>((run + 1) * (run + 1))));
+  }
+
+  // the status of a failed run is returned
+  feeds[num_runs / 2].clear();
+  ASSERT_STATUS_NOT_OK(session_object.RunMany(RunOptions(), feeds, output_names, &fetches));
+}
+
+TEST(InferenceSessionTests, CloneSharesSessionState) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CloneSharesSessionState";
+
+  std::unique_ptr<InferenceSession> clone;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_NOT_OK(session_object.Clone("", clone));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  ASSERT_STATUS_OK(session_object.Clone("InferenceSessionTests.CloneSharesSessionState.Clone", clone));
+  ASSERT_NE(clone, nullptr);
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+  EXPECT_EQ(clone->GetSessionOptions().session_logid, "InferenceSessionTests.CloneSharesSessionState.Clone");
+
+  RunOptions run_options;
+  run_options.run_tag = "clone";
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, IOBindingOutputPrediction) {
+  onnxruntime::Model model("io_binding_output_prediction", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.IOBindingOutputPrediction";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsIOBindingOutputPredictionHistory, "4"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+
+  auto run = [&](const std::vector<float>& values) -> const Tensor& {
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                         std::vector<int64_t>{static_cast<int64_t>(values.size())}, values, &feed);
+    EXPECT_STATUS_OK(io_binding->BindInput("X", feed));
+    EXPECT_STATUS_OK(session_object.Run(*io_binding));
+    return io_binding->GetOutputs()[0].Get<Tensor>();
+  };
+  auto output_values = [](const Tensor& tensor) {
+    return std::vector<float>(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+  };
+
+  // the first run has no history, the next ones use the buffer released by the previous run
+  run({1.f, 2.f});
+  const void* buffer = run({2.f, 3.f}).DataRaw();
+  const auto& output = run({3.f, 4.f});
+  EXPECT_EQ(output.DataRaw(), buffer);
+  EXPECT_EQ(output_values(output), (std::vector<float>{6.f, 8.f}));
+
+  // an output still referenced by the caller is not reused
+  OrtValue previous_output = io_binding->GetOutputs()[0];
+  const auto& next_output = run({4.f, 5.f});
+  EXPECT_NE(next_output.DataRaw(), previous_output.Get<Tensor>().DataRaw());
+  EXPECT_EQ(output_values(previous_output.Get<Tensor>()), (std::vector<float>{6.f, 8.f}));
+  EXPECT_EQ(output_values(next_output), (std::vector<float>{8.f, 10.f}));
+
+  // new input shapes fall back to a regular allocation
+  const auto& resized_output = run({1.f, 2.f, 3.f});
+  EXPECT_EQ(resized_output.Shape(), TensorShape({3}));
+  EXPECT_EQ(output_values(resized_output), (std::vector<float>{2.f, 4.f, 6.f}));
+}
+
+TEST(InferenceSessionTests, ExecutionFramePool) {
+  // Add followed by Mul so the intermediate value is planned in the memory pattern buffer
+  onnxruntime::Model model("execution_frame_pool", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& sum = graph.GetOrCreateNodeArg("sum", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&sum});
+  graph.AddNode("mul", "Mul", "", {&sum, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ExecutionFramePool";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsExecutionFramePoolSize, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const std::vector<std::string> output_names{"Y"};
+  // alternate input shapes so that frames are reused both for the same and for other shapes
+  for (const std::vector<float>& values : std::vector<std::vector<float>>{
+           {1.f, 2.f}, {2.f, 3.f}, {1.f, 2.f, 3.f}, {3.f, 4.f}, {4.f}, {2.f, 3.f, 4.f}, {5.f, 6.f}}) {
+    OrtValue feed;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                         std::vector<int64_t>{static_cast<int64_t>(values.size())}, values, &feed);
+    NameMLValMap feeds{{"X", feed}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &fetches));
+
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape(), TensorShape({static_cast<int64_t>(values.size())}));
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(output.Data<float>()[i], 2.f * values[i] * values[i]);
+    }
+  }
+}
+
+TEST(InferenceSessionTests, SamplingProfiler) {
+  onnxruntime::Model model("sampling_profiler", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& sum = graph.GetOrCreateNodeArg("sum", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&sum});
+  graph.AddNode("mul", "Mul", "", {&sum, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SamplingProfiler";
+  {
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    std::string stats;
+    ASSERT_FALSE(session_object.GetSampledLatencyStats(stats).IsOK());
+  }
+
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSamplingProfilerInterval, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2}, {1.f, 2.f}, &feed);
+  NameMLValMap feeds{{"X", feed}};
+  const std::vector<std::string> output_names{"Y"};
+  for (int i = 0; i < 10; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &fetches));
+  }
+
+  std::string stats;
+  ASSERT_STATUS_OK(session_object.GetSampledLatencyStats(stats));
+  EXPECT_NE(stats.find("\"sampling_interval\": 2"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("\"sampled_runs\": 5"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("\"name\": \"add\", \"op_type\": \"Add\", \"count\": 5"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("\"name\": \"mul\", \"op_type\": \"Mul\", \"count\": 5"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("\"op_types\": [{\"op_type\": \"Add\", \"count\": 5"), std::string::npos) << stats;
+}
+
+TEST(InferenceSessionTests, GetAllocatorStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.GetAllocatorStats";
+  InferenceSession session_object{so, GetEnvironment()};
+  std::string stats;
+  ASSERT_FALSE(session_object.GetAllocatorStats(stats).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/one tag";
+  RunModel(session_object, run_options);
+
+  ASSERT_STATUS_OK(session_object.GetAllocatorStats(stats));
+  EXPECT_NE(stats.find("\"name\": \"Cpu\""), std::string::npos) << stats;
+  // the CPU arena is enabled by default, so it counts the allocations of the run
+  EXPECT_EQ(stats.find("\"num_allocs\": 0,"), std::string::npos) << stats;
+}
+
+TEST(InferenceSessionTests, GetInitializationStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.GetInitializationStats";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::string stats;
+  ASSERT_STATUS_OK(session_object.GetInitializationStats(stats));
+  for (const char* phase : {"model_load", "graph_transformer", "partitioning", "get_capability", "allocation_planning",
+                            "initializer_load", "kernel_creation", "session_initialization"}) {
+    EXPECT_NE(stats.find(std::string("\"phase\": \"") + phase + "\""), std::string::npos) << phase << ": " << stats;
+  }
+  EXPECT_NE(stats.find("\"name\": \"CPUExecutionProvider\""), std::string::npos) << stats;
+}
+
+TEST(InferenceSessionTests, GetMetrics) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.GetMetrics";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  std::string metrics;
+  ASSERT_FALSE(session_object.GetMetrics(metrics).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.GetMetrics";
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  ASSERT_STATUS_OK(session_object.GetMetrics(metrics));
+  EXPECT_NE(metrics.find("# TYPE onnxruntime_session_runs counter\n"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("onnxruntime_session_runs_total{session_id=\""), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("\"} 2\n"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("onnxruntime_session_run_duration_seconds_bucket{"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("le=\"+Inf\"} 2\n"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("onnxruntime_allocator_bytes_in_use{"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("onnxruntime_memory_patterns_cache_hits_total{"), std::string::npos) << metrics;
+  EXPECT_EQ(metrics.substr(metrics.size() - 6), "# EOF\n");
+}
+
+TEST(InferenceSessionTests, WarmUp) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.WarmUp";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  std::string report;
+  ASSERT_FALSE(session_object.WarmUp("", report).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // The shapes of the model are used when none are given.
+  ASSERT_STATUS_OK(session_object.WarmUp("", report));
+  EXPECT_NE(report.find("\"inputs\": \"X:3x2\""), std::string::npos) << report;
+  EXPECT_NE(report.find("\"ready\": true"), std::string::npos) << report;
+
+  ASSERT_STATUS_OK(session_object.WarmUp("X:3x2;X:3x2", report));
+  EXPECT_NE(report.find("\"second_run_us\""), std::string::npos) << report;
+  EXPECT_NE(report.find("\"allocators\": ["), std::string::npos) << report;
+
+  EXPECT_FALSE(session_object.WarmUp("Y:3x2", report).IsOK());
+  EXPECT_FALSE(session_object.WarmUp("X:3xa", report).IsOK());
+  EXPECT_FALSE(session_object.WarmUp("X", report).IsOK());
+
+  // The session runs as usual after the warm-up.
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, DisableCPUArena) {
   SessionOptions so;
 
@@ -748,6 +1381,45 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions2) {
 #endif
 }
 
+#if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING)
+// The GPU kernel metrics are only collected with the permission to access the GPU performance counters, so the test
+// checks that the node events that have them match the summary of their op type.
+TEST(InferenceSessionTests, CheckRunProfilerWithGpuKernelMetrics) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_gpu_kernel_metrics_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingGpuKernelMetrics, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_node_metrics = false;
+  bool has_op_type_metrics = false;
+  while (std::getline(profile, line)) {
+    if (line.find("gpu_kernel_metrics") == std::string::npos) {
+      continue;
+    }
+    ASSERT_NE(line.find("achieved_occupancy"), std::string::npos);
+    ASSERT_NE(line.find("tensor_core_utilization"), std::string::npos);
+    has_node_metrics = has_node_metrics || line.find("\"Node\"") != std::string::npos;
+    has_op_type_metrics = has_op_type_metrics || line.find("Mul_gpu_kernel_metrics") != std::string::npos;
+  }
+
+  ASSERT_EQ(has_node_metrics, has_op_type_metrics);
+}
+#endif
+
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
 
@@ -3059,5 +3731,41 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
 }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, MergeTuningResultsIntoFile) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("tuning_results_file_test_tmp_dir")};
+  const auto file_path = std::filesystem::path{tmp_dir.Path()} / ORT_TSTR("tuning_results.json");
+
+  std::vector<TuningResults> results;
+  ASSERT_STATUS_OK(inference_session_utils::ParseTuningResultsFromFile(file_path, results));
+  ASSERT_TRUE(results.empty());
+
+  TuningResults device_a;
+  device_a.ep = "TestEP";
+  device_a.validators = {{"DEVICE_MODEL", "A"}};
+  device_a.results = {{"GemmTunableOp", {{"128x128", 1}, {"256x256", 2}}}};
+  TuningResults device_b = device_a;
+  device_b.validators = {{"DEVICE_MODEL", "B"}};
+  ASSERT_STATUS_OK(inference_session_utils::MergeTuningResultsIntoFile(file_path, {device_a, device_b}));
+
+  // a later session on device A adds a result and retunes another
+  TuningResults device_a_update = device_a;
+  device_a_update.results = {{"GemmTunableOp", {{"256x256", 3}}}, {"SoftmaxTunableOp", {{"1x1024", 0}}}};
+  ASSERT_STATUS_OK(inference_session_utils::MergeTuningResultsIntoFile(file_path, {device_a_update}));
+
+  ASSERT_STATUS_OK(inference_session_utils::ParseTuningResultsFromFile(file_path, results));
+  ASSERT_EQ(results.size(), 2u);
+  for (const auto& tr : results) {
+    ASSERT_EQ(tr.ep, "TestEP");
+    if (tr.validators.at("DEVICE_MODEL") == "A") {
+      EXPECT_EQ(tr.results.at("GemmTunableOp"), (KernelMap{{"128x128", 1}, {"256x256", 3}}));
+      EXPECT_EQ(tr.results.at("SoftmaxTunableOp"), (KernelMap{{"1x1024", 0}}));
+    } else {
+      EXPECT_EQ(tr.results, device_b.results);
+    }
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -6,7 +6,10 @@
 #include <gtest/gtest.h>
 
 #include "asserts.h"
+#include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
 
 namespace onnxruntime::test {
 
@@ -101,4 +104,48 @@ TEST(KernelRegistryTests, two_versions4) {
   ASSERT_STATUS_NOT_OK(RegKernels(r, function_table, CreateFakeKernel));
 }
 
+TEST(KernelRegistryTests, LookupCache) {
+  KernelRegistry r;
+  std::vector<std::unique_ptr<KernelDef>> function_table;
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 10}},
+              {}, logger);
+  Graph& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor, double_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  double_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_DOUBLE);
+  auto& float_elu_1 = graph.AddNode("float_elu_1", "Elu", "", {&graph.GetOrCreateNodeArg("X", &float_tensor)},
+                                    {&graph.GetOrCreateNodeArg("Y", &float_tensor)});
+  auto& float_elu_2 = graph.AddNode("float_elu_2", "Elu", "", {&graph.GetOrCreateNodeArg("Y", &float_tensor)},
+                                    {&graph.GetOrCreateNodeArg("Z", &float_tensor)});
+  auto& double_elu = graph.AddNode("double_elu", "Elu", "", {&graph.GetOrCreateNodeArg("A", &double_tensor)},
+                                   {&graph.GetOrCreateNodeArg("B", &double_tensor)});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const OpSchemaKernelTypeStrResolver kernel_type_str_resolver{};
+  const KernelCreateInfo* info_1 = nullptr;
+  const KernelCreateInfo* info_2 = nullptr;
+  const KernelCreateInfo* double_info = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(float_elu_1, kCpuExecutionProvider, kernel_type_str_resolver, logger, &info_1));
+  // matched from the cache
+  ASSERT_STATUS_OK(r.TryFindKernel(float_elu_2, kCpuExecutionProvider, kernel_type_str_resolver, logger, &info_2));
+  EXPECT_EQ(info_1, info_2);
+  // a node with other types is not
+  ASSERT_STATUS_NOT_OK(r.TryFindKernel(double_elu, kCpuExecutionProvider, kernel_type_str_resolver, logger,
+                                       &double_info));
+
+  // a kernel registered later is found, and the cached ones are still valid
+  function_table.clear();
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+  ASSERT_STATUS_OK(r.TryFindKernel(double_elu, kCpuExecutionProvider, kernel_type_str_resolver, logger,
+                                   &double_info));
+  EXPECT_NE(double_info, info_1);
+  ASSERT_STATUS_OK(r.TryFindKernel(float_elu_2, kCpuExecutionProvider, kernel_type_str_resolver, logger, &info_2));
+  EXPECT_EQ(info_1, info_2);
+}
+
 }  // namespace onnxruntime::test
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/large_page_allocator.h"
+
+#include <cstring>
+
+#include "core/framework/bfc_arena.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(LargePageCPUAllocatorTest, SmallAllocationsUseRegularPages) {
+  LargePageCPUAllocator allocator;
+  void* p = allocator.Alloc(1024);
+  ASSERT_NE(p, nullptr);
+  std::memset(p, 1, 1024);
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.large_page_bytes, 0);
+  EXPECT_EQ(stats.num_large_page_fallbacks, 0);
+  allocator.Free(p);
+}
+
+TEST(LargePageCPUAllocatorTest, LargeAllocationsUseLargePagesOrFallBack) {
+  LargePageCPUAllocator allocator;
+  const size_t large_page_size = allocator.LargePageSize();
+  if (large_page_size == 0) {
+    GTEST_SKIP() << "Large pages are not supported on this platform.";
+  }
+
+  // less than two pages with the overrun allowance
+  const size_t size = 2 * large_page_size - 64;
+  void* p = allocator.Alloc(size);
+  ASSERT_NE(p, nullptr);
+  std::memset(p, 1, size);
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  if (stats.num_large_page_fallbacks == 0) {
+    EXPECT_EQ(stats.large_page_bytes, static_cast<int64_t>(2 * large_page_size));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % large_page_size, 0u);
+  } else {
+    EXPECT_EQ(stats.num_large_page_fallbacks, 1);
+    EXPECT_EQ(stats.large_page_bytes, 0);
+  }
+
+  allocator.Free(p);
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.large_page_bytes, 0);
+}
+
+TEST(LargePageCPUAllocatorTest, ArenaReportsLargePageStats) {
+  auto device_allocator = std::make_unique<LargePageCPUAllocator>();
+  const size_t large_page_size = device_allocator->LargePageSize();
+  if (large_page_size == 0) {
+    GTEST_SKIP() << "Large pages are not supported on this platform.";
+  }
+
+  BFCArena arena(std::move(device_allocator), 1 << 30);
+  void* p = arena.Reserve(4 * large_page_size);
+  ASSERT_NE(p, nullptr);
+
+  AllocatorStats stats;
+  arena.GetStats(&stats);
+  EXPECT_EQ(stats.num_reserves, 1);
+  EXPECT_TRUE(stats.large_page_bytes > 0 || stats.num_large_page_fallbacks == 1);
+  arena.Free(p);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
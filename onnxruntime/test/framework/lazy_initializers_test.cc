@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/lazy_initializers.h"
+
+#include <filesystem>
+
+#include "core/framework/session_state.h"
+#include "core/graph/model.h"
+#include "core/graph/model_saving_options.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/inference_session_wrapper.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Saves mnist with all its initializers in an external data file.
+std::filesystem::path SaveModelWithExternalData() {
+  std::shared_ptr<Model> model;
+  ORT_THROW_IF_ERROR(Model::Load(ORT_TSTR("testdata/mnist.onnx"), model, nullptr,
+                                 DefaultLoggingManager().DefaultLogger()));
+  const auto model_path = std::filesystem::temp_directory_path() / "ort_lazy_initializers_test.onnx";
+  ORT_THROW_IF_ERROR(Model::SaveWithExternalInitializers(*model, model_path, "ort_lazy_initializers_test.bin",
+                                                         ModelSavingOptions{0}));
+  return model_path;
+}
+
+std::vector<float> Run(InferenceSessionWrapper& session) {
+  std::vector<float> input(28 * 28);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 17) / 17.f;
+  }
+  const std::vector<int64_t> dims{1, 1, 28, 28};
+  OrtValue input_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, input, &input_value);
+
+  const std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> fetches;
+  ORT_THROW_IF_ERROR(session.Run(NameMLValMap{{"Input3", input_value}}, output_names, &fetches));
+  const auto output = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  return std::vector<float>(output.begin(), output.end());
+}
+
+std::unique_ptr<InferenceSessionWrapper> CreateSession(const std::filesystem::path& model_path, bool lazy,
+                                                       const char* memory_budget,
+                                                       const char* prefetch_distance = "0") {
+  SessionOptions so;
+  // the optimizers would replace the external initializers with new ones
+  so.graph_optimization_level = TransformerLevel::Default;
+  if (lazy) {
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializerLoading, "1"));
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializersMinSize, "0"));
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializersMemoryBudget,
+                                                        memory_budget));
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializersPrefetchDistance,
+                                                        prefetch_distance));
+  }
+  auto session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+  ORT_THROW_IF_ERROR(session->Load(model_path.native()));
+  ORT_THROW_IF_ERROR(session->Initialize());
+  return session;
+}
+}  // namespace
+
+TEST(LazyInitializersTest, LoadsOnFirstUse) {
+  const auto model_path = SaveModelWithExternalData();
+  const auto expected = Run(*CreateSession(model_path, false, "0"));
+
+  auto session = CreateSession(model_path, true, "0");
+  const LazyInitializers* lazy_initializers = session->GetSessionState().GetLazyInitializers();
+  ASSERT_NE(lazy_initializers, nullptr);
+  EXPECT_EQ(lazy_initializers->LoadedSizeInBytes(), 0u);
+
+  EXPECT_EQ(Run(*session), expected);
+  // the initializers are kept without a budget
+  const size_t loaded_size = lazy_initializers->LoadedSizeInBytes();
+  EXPECT_GT(loaded_size, 0u);
+  EXPECT_EQ(Run(*session), expected);
+  EXPECT_EQ(lazy_initializers->LoadedSizeInBytes(), loaded_size);
+
+  std::filesystem::remove(model_path);
+  std::filesystem::remove(model_path.parent_path() / "ort_lazy_initializers_test.bin");
+}
+
+TEST(LazyInitializersTest, ReleasesOverBudget) {
+  const auto model_path = SaveModelWithExternalData();
+  const auto expected = Run(*CreateSession(model_path, false, "0"));
+
+  // every initializer is released once the node consuming it completes and reloaded by the next run
+  auto session = CreateSession(model_path, true, "1");
+  const LazyInitializers* lazy_initializers = session->GetSessionState().GetLazyInitializers();
+  ASSERT_NE(lazy_initializers, nullptr);
+  EXPECT_EQ(Run(*session), expected);
+  EXPECT_EQ(lazy_initializers->LoadedSizeInBytes(), 0u);
+  EXPECT_EQ(Run(*session), expected);
+  EXPECT_EQ(lazy_initializers->LoadedSizeInBytes(), 0u);
+
+  std::filesystem::remove(model_path);
+  std::filesystem::remove(model_path.parent_path() / "ort_lazy_initializers_test.bin");
+}
+
+TEST(LazyInitializersTest, StreamsInitializers) {
+  const auto model_path = SaveModelWithExternalData();
+  const auto expected = Run(*CreateSession(model_path, false, "0"));
+
+  // the initializers of the next two consumers are prefetched while a node runs and released once used
+  auto session = CreateSession(model_path, true, "1", "2");
+  const LazyInitializers* lazy_initializers = session->GetSessionState().GetLazyInitializers();
+  ASSERT_NE(lazy_initializers, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(Run(*session), expected);
+    EXPECT_EQ(lazy_initializers->LoadedSizeInBytes(), 0u);
+  }
+
+  std::filesystem::remove(model_path);
+  std::filesystem::remove(model_path.parent_path() / "ort_lazy_initializers_test.bin");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
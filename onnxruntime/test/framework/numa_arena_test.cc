@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_arena.h"
+
+#include <thread>
+
+#include "core/framework/allocator_utils.h"
+#include "core/framework/bfc_arena.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+std::vector<AllocatorPtr> CreateNodeArenas(size_t num_nodes) {
+  std::vector<AllocatorPtr> node_arenas;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    node_arenas.push_back(std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30));
+  }
+  return node_arenas;
+}
+
+thread_local int current_node = -1;
+}  // namespace
+
+TEST(NumaArenaTest, AllocatesFromTheArenaOfTheCurrentNode) {
+  auto node_arenas = CreateNodeArenas(2);
+  NumaArena arena(node_arenas, []() { return current_node; });
+  EXPECT_EQ(arena.Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_EQ(arena.NumNodes(), 2u);
+
+  current_node = 1;
+  void* p1 = arena.Alloc(1024);
+  current_node = -1;
+  // unknown nodes use the first arena
+  void* p0 = arena.Alloc(2048);
+
+  AllocatorStats stats;
+  node_arenas[0]->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.bytes_in_use, 2048);
+  node_arenas[1]->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  arena.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, 3072);
+
+  // memory is returned to the arena it was allocated from, whatever the node of the thread freeing it
+  std::thread([&]() {
+    current_node = 0;
+    arena.Free(p1);
+  }).join();
+  node_arenas[1]->GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  arena.Free(p0);
+  arena.Free(nullptr);
+  arena.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
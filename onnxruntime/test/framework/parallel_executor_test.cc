@@ -5,7 +5,11 @@
 #include "core/framework/op_kernel.h"
 #include "test/providers/provider_test_utils.h"
 #include "test_utils.h"
+#include "core/graph/model.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/test_environment.h"
 
 #include "gtest/gtest.h"
 
@@ -143,6 +147,93 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
   tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
 }
 
+TEST(ParallelExecutor, TestDynamicSchedulingStatusPropagation) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{TestOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, TestOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) { out = std::make_unique<typename TestOp::OpKernelImpl>(info); return Status::OK(); };
+  auto kernel_def = TestOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "TestDynamicSchedulingStatusPropagation";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDynamicInterOpScheduling, "1"));
+
+  for (int64_t action : {0, 1, 2}) {
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {action});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    if (action == 0) {
+      tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
+    } else {
+      tester.Run(so, OpTester::ExpectResult::kExpectFailure,
+                 action == 1 ? "Action was 1" : "Throwing as action was 2", {kTensorrtExecutionProvider},
+                 nullptr, nullptr);
+    }
+  }
+}
+
+// X fans out to independent Neg -> Abs chains that are joined by a Sum, so the result is num_branches * |X|.
+TEST(ParallelExecutor, TestDynamicSchedulingFanOutFanIn) {
+  constexpr int num_branches = 8;
+  onnxruntime::Model model("fan_out_fan_in", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  std::vector<onnxruntime::NodeArg*> sum_inputs;
+  for (int i = 0; i < num_branches; ++i) {
+    auto& neg_out = graph.GetOrCreateNodeArg("neg_" + std::to_string(i), &float_tensor);
+    auto& abs_out = graph.GetOrCreateNodeArg("abs_" + std::to_string(i), &float_tensor);
+    graph.AddNode("neg_node_" + std::to_string(i), "Neg", "", {&input_arg}, {&neg_out});
+    graph.AddNode("abs_node_" + std::to_string(i), "Abs", "", {&neg_out}, {&abs_out});
+    sum_inputs.push_back(&abs_out);
+  }
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("sum_node", "Sum", "", sum_inputs, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "TestDynamicSchedulingFanOutFanIn";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDynamicInterOpScheduling, "1"));
+
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4}, {1.0f, -2.0f, 3.0f, -4.0f},
+                       &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<std::string> output_names{"Y"};
+
+  RunOptions run_options;
+  for (int run = 0; run < 10; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(run_options, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y.size(), 4u);
+    EXPECT_EQ(y[0], 8.0f);
+    EXPECT_EQ(y[1], 16.0f);
+    EXPECT_EQ(y[2], 24.0f);
+    EXPECT_EQ(y[3], 32.0f);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                          testing::Values(1, 0));
 }  // namespace test
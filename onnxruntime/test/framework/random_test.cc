@@ -54,5 +54,23 @@ TEST(RandomTest, PhiloxGeneratorTest) {
   ASSERT_EQ(seeds.second, 0u);
 }
 
+TEST(RandomTest, PhiloxEngineTest) {
+  // known answer of the Philox4x32-10 reference implementation for a zero key and counter.
+  const PhiloxEngine engine(0);
+  const PhiloxEngine::ResultType expected{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+  ASSERT_EQ(engine(0), expected);
+
+  // the values only depend on the seed and the counter.
+  const PhiloxEngine other_engine(17);
+  ASSERT_EQ(other_engine(5), PhiloxEngine(17)(5));
+  ASSERT_NE(other_engine(5), other_engine(6));
+  ASSERT_NE(other_engine(5), PhiloxEngine(18)(5));
+
+  ASSERT_EQ(PhiloxEngine::ToUniformFloat(0u), 0.0f);
+  ASSERT_LT(PhiloxEngine::ToUniformFloat(0xffffffffu), 1.0f);
+  ASSERT_EQ(PhiloxEngine::ToUniformDouble(0u, 0u), 0.0);
+  ASSERT_LT(PhiloxEngine::ToUniformDouble(0xffffffffu, 0xffffffffu), 1.0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
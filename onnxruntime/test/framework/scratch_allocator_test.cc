@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/scratch_allocator.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "core/framework/bfc_arena.h"
+#include "core/mlas/inc/mlas.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ScratchAllocatorTest, ReusesTheBlockOnceAllBuffersAreFreed) {
+  auto arena = std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30);
+  ScratchAllocator allocator(arena, 4096);
+  EXPECT_EQ(allocator.Info().alloc_type, OrtDeviceAllocator);
+
+  char* p0 = static_cast<char*>(allocator.Alloc(100));
+  char* p1 = static_cast<char*>(allocator.Alloc(200));
+  ASSERT_NE(p0, nullptr);
+  ASSERT_NE(p1, nullptr);
+  EXPECT_GT(p1, p0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p1) % MlasGetPreferredBufferAlignment(), 0u);
+  std::memset(p0, 1, 100);
+  std::memset(p1, 2, 200);
+
+  // the block is only reset when the last buffer is freed
+  allocator.Free(p0);
+  char* p2 = static_cast<char*>(allocator.Alloc(100));
+  EXPECT_GT(p2, p1);
+  allocator.Free(p1);
+  allocator.Free(p2);
+
+  EXPECT_EQ(allocator.Alloc(100), p0);
+  allocator.Free(p0);
+
+  AllocatorStats arena_stats;
+  arena->GetStats(&arena_stats);
+  // only the block was allocated from the arena
+  EXPECT_EQ(arena_stats.num_allocs, 1);
+}
+
+TEST(ScratchAllocatorTest, FallsBackWhenTheBlockIsFull) {
+  auto arena = std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30);
+  ScratchAllocator allocator(arena, 1024);
+  AllocatorStats arena_stats;
+  arena->GetStats(&arena_stats);
+  const int64_t block_bytes = arena_stats.bytes_in_use;
+
+  void* in_block = allocator.Alloc(512);
+  void* fallback = allocator.Alloc(2048);
+  ASSERT_NE(fallback, nullptr);
+  std::memset(fallback, 1, 2048);
+  EXPECT_GE(allocator.HighWaterMark(), 512u + 2048u);
+
+  arena->GetStats(&arena_stats);
+  EXPECT_EQ(arena_stats.num_allocs, 2);
+
+  allocator.Free(fallback);
+  allocator.Free(in_block);
+  arena->GetStats(&arena_stats);
+  EXPECT_EQ(arena_stats.bytes_in_use, block_bytes);
+}
+
+TEST(ScratchAllocatorTest, WithoutBlockAllAllocationsFallBack) {
+  auto arena = std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30);
+  ScratchAllocator allocator(arena, 0);
+
+  void* p = allocator.Alloc(256);
+  ASSERT_NE(p, nullptr);
+  allocator.Free(p);
+  // the next block can be sized from the high water mark
+  EXPECT_GE(allocator.HighWaterMark(), 256u);
+  EXPECT_EQ(allocator.Capacity(), 0u);
+}
+
+TEST(ScratchAllocatorTest, ConcurrentAllocations) {
+  ScratchAllocator allocator(std::make_shared<CPUAllocator>(), 64 * 1024);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&allocator, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        const size_t size = 64 + static_cast<size_t>(i % 7) * 128;
+        auto* p = static_cast<unsigned char*>(allocator.Alloc(size));
+        ASSERT_NE(p, nullptr);
+        std::memset(p, t, size);
+        for (size_t j = 0; j < size; ++j) {
+          ASSERT_EQ(p[j], t);
+        }
+        allocator.Free(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 4000);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
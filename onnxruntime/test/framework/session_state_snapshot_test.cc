@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_state_snapshot.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+SessionStateSnapshot CreateSnapshot() {
+  MemoryPatternGroup group;
+  InlinedHashMap<int, MemoryBlock> blocks;
+  blocks.emplace(3, MemoryBlock(0, 256));
+  blocks.emplace(7, MemoryBlock(256, 64));
+  group.locations.push_back(OrtDevice());
+  group.patterns.emplace_back(std::move(blocks), 320);
+
+  SessionStateSnapshot snapshot;
+  snapshot.memory_patterns.push_back({{2, 1, 16}, std::make_shared<const MemoryPatternGroup>(std::move(group))});
+  return snapshot;
+}
+}  // namespace
+
+TEST(SessionStateSnapshotTest, SaveAndLoad) {
+  const auto file_path = std::filesystem::temp_directory_path() / "ort_session_state_snapshot_test.bin";
+  ASSERT_STATUS_OK(CreateSnapshot().Save(file_path, "fingerprint"));
+
+  SessionStateSnapshot snapshot;
+  ASSERT_TRUE(snapshot.Load(file_path, "fingerprint"));
+  ASSERT_EQ(snapshot.memory_patterns.size(), 1u);
+  const auto& entry = snapshot.memory_patterns[0];
+  EXPECT_EQ(entry.key, (InlinedVector<int64_t>{2, 1, 16}));
+  ASSERT_EQ(entry.patterns->locations.size(), 1u);
+  EXPECT_EQ(entry.patterns->locations[0], OrtDevice());
+  const MemoryPattern& pattern = entry.patterns->patterns[0];
+  EXPECT_EQ(pattern.PeakSize(), 320u);
+  ASSERT_NE(pattern.GetBlock(7), nullptr);
+  EXPECT_EQ(pattern.GetBlock(7)->offset_, 256u);
+  EXPECT_EQ(pattern.GetBlock(7)->size_, 64u);
+  EXPECT_EQ(pattern.GetBlock(5), nullptr);
+
+  // a snapshot of another execution plan is not loaded
+  EXPECT_FALSE(snapshot.Load(file_path, "other fingerprint"));
+  EXPECT_TRUE(snapshot.memory_patterns.empty());
+
+  // nor is a truncated file
+  std::string contents;
+  {
+    std::ifstream file(file_path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  std::ofstream(file_path, std::ios::binary | std::ios::trunc) << contents.substr(0, contents.size() - 4);
+  EXPECT_FALSE(snapshot.Load(file_path, "fingerprint"));
+  EXPECT_TRUE(snapshot.memory_patterns.empty());
+
+  std::filesystem::remove(file_path);
+  EXPECT_FALSE(snapshot.Load(file_path, "fingerprint"));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <absl/base/config.h>
 
@@ -22,10 +24,12 @@
 #include "core/util/thread_utils.h"
 #include "gtest/gtest.h"
 #include "test/test_environment.h"
+#include "test/framework/test_utils.h"
 #include "test/optimizer/graph_transform_test_builder.h"
 #include "test/util/include/test_environment.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/file_util.h"
+#include "test/util/include/inference_session_wrapper.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 #include "core/optimizer/graph_optimizer_registry.h"
 
@@ -207,6 +211,192 @@ TEST_P(SessionStateAddGetKernelTest, AddGetKernelTest) {
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateAddGetKernelTest, testing::Values(0, 1));
 
+#ifndef ENABLE_TRAINING
+// Memory patterns are keyed by the full input shape signature and evicted in LRU order when the cache is bounded.
+TEST(SessionStateTest, MemoryPatternCacheIsShapeKeyedAndBounded) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsMemoryPatternCacheCapacity, "2"));
+
+  SessionState s(graph, execution_providers, nullptr, nullptr, dtm, edlm,
+                 DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  auto make_feed = [&](std::vector<int64_t> dims) {
+    OrtValue value;
+    CreateMLValue<float>(cpu_allocator, dims, std::vector<float>(static_cast<size_t>(TensorShape(dims).Size())),
+                         &value);
+    return value;
+  };
+
+  // {2, 2} and {3, 3} must not share an entry.
+  std::vector<OrtValue> feeds_a{make_feed({2, 2})};
+  std::vector<OrtValue> feeds_b{make_feed({3, 3})};
+  std::vector<OrtValue> feeds_c{make_feed({4, 1})};
+
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+  ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache(feeds_a, MemoryPatternGroup{}));
+  EXPECT_EQ(s.GetMemoryPatternGroup(feeds_b, {}, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache(feeds_b, MemoryPatternGroup{}));
+
+  // Looking up feeds_a makes feeds_b the least recently used entry, which is evicted when feeds_c is inserted.
+  auto patterns_a = s.GetMemoryPatternGroup(feeds_a, {}, inferred_shapes);
+  ASSERT_NE(patterns_a, nullptr);
+  ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache(feeds_c, MemoryPatternGroup{}));
+
+  EXPECT_NE(s.GetMemoryPatternGroup(feeds_a, {}, inferred_shapes), nullptr);
+  EXPECT_EQ(s.GetMemoryPatternGroup(feeds_b, {}, inferred_shapes), nullptr);
+  EXPECT_NE(s.GetMemoryPatternGroup(feeds_c, {}, inferred_shapes), nullptr);
+}
+#endif
+
+// The memory patterns of a model with a symbolic sequence length are generated for every length without a run.
+TEST(SessionStateTest, SymbolicMemoryPatterns) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  // both activations are alive while Sub runs
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& sum = graph.GetOrCreateNodeArg("sum", nullptr);
+  auto& product = graph.GetOrCreateNodeArg("product", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&sum});
+  graph.AddNode("mul", "Mul", "", {&sum, &x}, {&product});
+  graph.AddNode("sub", "Sub", "", {&product, &sum}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSymbolicMemoryPatterns, "1"));
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const SessionState& session_state = session.GetSessionState();
+  const SymbolicMemoryPattern* symbolic_mem_pattern = session_state.GetSymbolicMemoryPattern();
+  ASSERT_NE(symbolic_mem_pattern, nullptr);
+  EXPECT_EQ(symbolic_mem_pattern->NumPlannedValues(), 2u);
+
+  int x_idx = -1;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("X", x_idx));
+  const std::vector<int> feed_mlvalue_idxs{x_idx};
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  auto make_feed = [&](int64_t seq) {
+    std::vector<float> values(static_cast<size_t>(seq * 16));
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i % 7);
+    }
+    OrtValue value;
+    CreateMLValue<float>(cpu_allocator, {seq, 16}, values, &value);
+    return value;
+  };
+
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+  for (const int64_t seq : {4, 8}) {
+    const std::vector<OrtValue> feeds{make_feed(seq)};
+    auto patterns = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes);
+    ASSERT_NE(patterns, nullptr);
+    const MemoryPattern* pattern = patterns->GetPatterns(OrtDevice());
+    ASSERT_NE(pattern, nullptr);
+    // seq * 16 floats per activation, aligned to kAllocAlignment
+    EXPECT_EQ(pattern->PeakSize(), static_cast<size_t>(2 * seq * 16 * sizeof(float)));
+    EXPECT_EQ(session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes), patterns);
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(NameMLValMap{{"X", feeds[0]}}, {"Y"}, &fetches));
+    const auto x_values = feeds[0].Get<Tensor>().DataAsSpan<float>();
+    const auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y_values.size(), x_values.size());
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      EXPECT_EQ(y_values[i], 2 * x_values[i] * x_values[i] - 2 * x_values[i]);
+    }
+  }
+}
+
+// The nodes that the profile recorded as shorter than the threshold are given no intra-op thread pool.
+TEST(SessionStateTest, ProfileGuidedNodeTimings) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& sum = graph.GetOrCreateNodeArg("sum", nullptr);
+  auto& product = graph.GetOrCreateNodeArg("product", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&sum});
+  graph.AddNode("mul", "Mul", "", {&sum, &x}, {&product});
+  graph.AddNode("sub", "Sub", "", {&product, &sum}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  // "add" averages 5us over two runs, "mul" is above the threshold and "sub" was not profiled.
+  const std::string profile_file = "profile_guided_node_timings.json";
+  {
+    std::ofstream profile(profile_file);
+    profile << R"([{"cat": "Session", "name": "model_run", "dur": 500},
+                   {"cat": "Node", "name": "add_kernel_time", "dur": 4},
+                   {"cat": "Node", "name": "add_kernel_time", "dur": 6},
+                   {"cat": "Node", "name": "add_fence_before", "dur": 0},
+                   {"cat": "Node", "name": "mul_kernel_time", "dur": 300}])";
+  }
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfileGuidedNodeTimingsFile,
+                                                    profile_file.c_str()));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfileGuidedSingleThreadThresholdUs, "10"));
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+  std::remove(profile_file.c_str());
+
+  const SessionState& session_state = session.GetSessionState();
+  ASSERT_NE(session_state.GetThreadPool(), nullptr);
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    if (node.Name() == "add") {
+      EXPECT_EQ(session_state.GetThreadPool(node.Index()), nullptr);
+    } else {
+      EXPECT_EQ(session_state.GetThreadPool(node.Index()), session_state.GetThreadPool()) << node.Name();
+    }
+  }
+
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  std::vector<float> values(16);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i % 7);
+  }
+  OrtValue feed;
+  CreateMLValue<float>(cpu_allocator, {16}, values, &feed);
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(NameMLValMap{{"X", feed}}, {"Y"}, &fetches));
+  const auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(y_values[i], 2 * values[i] * values[i] - 2 * values[i]);
+  }
+}
+
 class TestParam {
  public:
   int ir_version;
@@ -942,6 +1132,66 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test1) {
   ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
 }
 
+// Pre-packing enabled + initializers loaded and pre-packed in parallel over the intra-op thread pool
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, LoadInitializersInParallel) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsLoadInitializersInParallel] = "1";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+
+  // a chain of nodes, each using its own initializer
+  constexpr int num_nodes = 8;
+  Graph& graph = model.MainGraph();
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto& input = graph.GetOrCreateNodeArg(i == 0 ? "input" : "output_" + std::to_string(i - 1), &type);
+    auto& weight = graph.GetOrCreateNodeArg("weight_" + suffix, &type);
+    auto& output = graph.GetOrCreateNodeArg("output_" + suffix, &type);
+    graph.AddNode("node_" + suffix, "PrePackingTest", "node " + suffix, {&input, &weight}, {&output});
+
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(1);
+    tensor.add_float_data(static_cast<float>(i));
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name("weight_" + suffix);
+    graph.AddInitializedTensor(tensor);
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  PlaceAllNodesToCPUEP(graph);
+  SessionState session_state(graph,
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             edlm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  // every node is pre-packed exactly once and the pre-packed initializers are released
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(num_nodes));
+  for (const auto& node : graph.Nodes()) {
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(node.Index()));
+    ASSERT_EQ(kernel->prepack_calls_count, 1);
+    ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+  }
+  ASSERT_TRUE(session_state.GetConstantInitializedTensors().empty());
+}
+
 // Pre-packing enabled + shared initializers + no pre-packed weights container = no pre-packed weights caching
 TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test2) {
   SessionOptions sess_options;
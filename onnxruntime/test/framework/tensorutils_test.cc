@@ -7,11 +7,14 @@
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
+#include "core/util/thread_utils.h"
 #include "test/util/include/asserts.h"
 #include "file_util.h"
 
 #include <cstdint>
 #include <limits>
+#include <numeric>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -19,6 +22,9 @@
 #ifdef _WIN32
 #include <Windows.h>
 #endif
+#if defined(USE_LZ4)
+#include <lz4.h>
+#endif
 
 using namespace ::onnxruntime::utils;
 using namespace ONNX_NAMESPACE;
@@ -164,6 +170,33 @@ TEST(TensorProtoUtilsTest, SetExternalDataInformation) {
   ASSERT_EQ(final_offset, external_offset);
 }
 
+TEST(TensorProtoUtilsTest, SetExternalDataCompressionInformation) {
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  ExternalDataInfo::SetExternalLocationToProto("test.bin", 0, 30, tensor_proto);
+
+  ExternalDataInfo::CompressionInfo compression_info;
+  compression_info.compression = ExternalDataInfo::Compression::kZstd;
+  compression_info.chunk_size = 1024;
+  compression_info.chunk_lengths = {10, 20};
+  ExternalDataInfo::SetCompressionInfoToProto(compression_info, tensor_proto);
+
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  ASSERT_STATUS_OK(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
+  ASSERT_TRUE(external_data_info->IsCompressed());
+  EXPECT_EQ(external_data_info->GetLength(), 30u);
+  EXPECT_EQ(external_data_info->GetCompressionInfo().compression, ExternalDataInfo::Compression::kZstd);
+  EXPECT_EQ(external_data_info->GetCompressionInfo().chunk_size, 1024u);
+  EXPECT_EQ(external_data_info->GetCompressionInfo().chunk_lengths, compression_info.chunk_lengths);
+
+  // the length must be the total size of the chunks
+  tensor_proto.mutable_external_data(2)->set_value("31");
+  EXPECT_FALSE(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK());
+
+  tensor_proto.mutable_external_data(2)->set_value("30");
+  tensor_proto.mutable_external_data(3)->set_value("gzip");
+  EXPECT_FALSE(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK());
+}
+
 // T must be float for double, and it must match with the 'type' argument
 template <typename T>
 void TestUnpackFloatTensor(TensorProto_DataType type, const std::filesystem::path& model_path) {
@@ -356,6 +389,115 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+#if !defined(__wasm__)
+TEST(TensorProtoUtilsTest, GetExtDataFromTensorProtoWithSharedMapping) {
+  if constexpr (endian::native != endian::little) {
+    GTEST_SKIP() << "Shared mappings are not used on big endian platforms.";
+  }
+
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  auto test_data = CreateValues<float>();
+  CreateTensorWithExternalData<float>(TensorProto_DataType_FLOAT, test_data, filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  auto get_ext_data = [&tensor_proto](bool use_shared_mapping, void*& buf, OrtCallback& deleter) {
+    SafeInt<size_t> len = 0;
+    ASSERT_STATUS_OK(GetExtDataFromTensorProto(Env::Default(), {}, tensor_proto, buf, len, deleter,
+                                               nullptr, nullptr, use_shared_mapping));
+    ASSERT_EQ(static_cast<size_t>(len), 4 * sizeof(float));
+  };
+
+  void* first = nullptr;
+  void* second = nullptr;
+  void* unshared = nullptr;
+  OrtCallback first_deleter, second_deleter, unshared_deleter;
+  get_ext_data(true, first, first_deleter);
+  get_ext_data(true, second, second_deleter);
+  get_ext_data(false, unshared, unshared_deleter);
+
+  // both shared requests are served by the same mapping
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, unshared);
+  EXPECT_EQ(0, memcmp(first, test_data.data(), test_data.size() * sizeof(float)));
+
+  unshared_deleter.f(unshared_deleter.param);
+  first_deleter.f(first_deleter.param);
+  // the mapping is still referenced by the second request
+  EXPECT_EQ(0, memcmp(second, test_data.data(), test_data.size() * sizeof(float)));
+  second_deleter.f(second_deleter.param);
+
+  // once released the data can be mapped again
+  void* third = nullptr;
+  OrtCallback third_deleter;
+  get_ext_data(true, third, third_deleter);
+  ScopedOrtCallbackInvoker third_invoker(third_deleter);
+  EXPECT_EQ(0, memcmp(third, test_data.data(), test_data.size() * sizeof(float)));
+}
+
+TEST(TensorProtoUtilsTest, GetExtDataFromTensorProtoWithCompression) {
+  std::vector<float> test_data(1000);
+  std::iota(test_data.begin(), test_data.end(), 0.f);
+  const char* raw_data = reinterpret_cast<const char*>(test_data.data());
+  const size_t raw_data_size = test_data.size() * sizeof(float);
+
+  ExternalDataInfo::CompressionInfo compression_info;
+  compression_info.compression = ExternalDataInfo::Compression::kLz4;
+  compression_info.chunk_size = 1024;
+  std::vector<char> compressed_data;
+#if defined(USE_LZ4)
+  for (size_t begin = 0; begin < raw_data_size; begin += compression_info.chunk_size) {
+    const int chunk_size = static_cast<int>(std::min(compression_info.chunk_size, raw_data_size - begin));
+    std::vector<char> chunk(LZ4_compressBound(chunk_size));
+    const int chunk_length = LZ4_compress_default(raw_data + begin, chunk.data(), chunk_size,
+                                                  static_cast<int>(chunk.size()));
+    ASSERT_GT(chunk_length, 0);
+    compressed_data.insert(compressed_data.end(), chunk.begin(), chunk.begin() + chunk_length);
+    compression_info.chunk_lengths.push_back(static_cast<size_t>(chunk_length));
+  }
+#else
+  // the chunks are never decompressed without the codec
+  compression_info.chunk_lengths.assign(4, 4);
+  compressed_data.resize(16);
+#endif
+
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  FILE* fp;
+  CreateTestFile(fp, filename);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+  ASSERT_EQ(compressed_data.size(), fwrite(compressed_data.data(), 1, compressed_data.size(), fp));
+  ASSERT_EQ(0, fclose(fp));
+
+  TensorProto tensor_proto;
+  ExternalDataInfo::SetExternalLocationToProto(filename, 0, compressed_data.size(), tensor_proto);
+  ExternalDataInfo::SetCompressionInfoToProto(compression_info, tensor_proto);
+  tensor_proto.add_dims(static_cast<int64_t>(test_data.size()));
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+
+  OrtThreadPoolParams thread_pool_params;
+  thread_pool_params.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  void* buf = nullptr;
+  SafeInt<size_t> len = 0;
+  OrtCallback deleter;
+  const auto status = GetExtDataFromTensorProto(Env::Default(), {}, tensor_proto, buf, len, deleter,
+                                                nullptr, nullptr, false, thread_pool.get());
+#if defined(USE_LZ4)
+  ASSERT_STATUS_OK(status);
+  ScopedOrtCallbackInvoker invoker(deleter);
+  ASSERT_EQ(static_cast<size_t>(len), raw_data_size);
+  EXPECT_EQ(0, memcmp(buf, raw_data, raw_data_size));
+#else
+  ORT_UNUSED_PARAMETER(raw_data);
+  EXPECT_FALSE(status.IsOK());
+#endif
+}
+#endif
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
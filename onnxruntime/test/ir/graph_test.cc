@@ -681,6 +681,39 @@ TEST_F(GraphTest, GraphConstruction_VerifyNoDuplicateName) {
   EXPECT_TRUE(duplicate_error_found);
 }
 
+TEST_F(GraphTest, CompactForExecution) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_type);
+  auto& a = graph.GetOrCreateNodeArg("a", &float_type);
+  auto& b = graph.GetOrCreateNodeArg("b", &float_type);
+  auto& c = graph.GetOrCreateNodeArg("c", &float_type);
+  auto& relu = graph.AddNode("relu", "Relu", "a = relu(x)", {&x}, {&a});
+  auto& neg = graph.AddNode("neg", "Neg", "b = neg(a)", {&a}, {&b});
+  auto& add = graph.AddNode("add", "Add", "c = a + b", {&a, &b}, {&c});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  graph.CompactForExecution();
+  ASSERT_TRUE(graph.IsCompacted());
+
+  // the lookups by name give the same nodes
+  EXPECT_EQ(graph.GetProducerNode("a"), &relu);
+  EXPECT_EQ(graph.GetProducerNode("c"), &add);
+  EXPECT_EQ(graph.GetProducerNode("x"), nullptr);
+  EXPECT_EQ(graph.GetProducerNode("unknown"), nullptr);
+  EXPECT_EQ(graph.GetConsumerNodes("a"), (std::vector<const Node*>{&neg, &add}));
+  EXPECT_EQ(graph.GetConsumerNodes("x"), (std::vector<const Node*>{&relu}));
+  EXPECT_TRUE(graph.GetConsumerNodes("c").empty());
+
+  EXPECT_TRUE(relu.Description().empty());
+  EXPECT_FALSE(graph.Resolve().IsOK());
+}
+
 TEST_F(GraphTest, GraphConstruction_VerifyNodeAndOpMatch) {
   Model model("graph_1", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1490,6 +1523,70 @@ TEST_F(GraphTest, GraphConstruction_TypeInference) {
   EXPECT_EQ("node_4_out_1", graph_proto.output(0).name());
 }
 
+TEST_F(GraphTest, ResolveOnlyInfersAffectedNodes) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  ONNX_NAMESPACE::TensorProto shape;
+  shape.set_name("shape");
+  shape.set_data_type(TensorProto_DataType_INT64);
+  shape.add_dims(2);
+  shape.add_int64_data(3);
+  shape.add_int64_data(2);
+  graph.AddInitializedTensor(shape);
+
+  // X -> Relu -> Reshape(shape) -> Relu -> Y
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& relu_1_out = graph.GetOrCreateNodeArg("relu_1_out", nullptr);
+  auto& reshape_out = graph.GetOrCreateNodeArg("reshape_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("relu_1", "Relu", "", {&x}, {&relu_1_out});
+  graph.AddNode("reshape", "Reshape", "", {&relu_1_out, graph.GetNodeArg("shape")}, {&reshape_out});
+  graph.AddNode("relu_2", "Relu", "", {&reshape_out}, {&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_inferred, 3u);
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_reused, 0u);
+
+  // nothing changed
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_inferred, 3u);
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_reused, 3u);
+
+  // the consumer of a replaced initializer is inferred again
+  ASSERT_STATUS_OK(graph.ReplaceInitializedTensor(shape));
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_inferred, 4u);
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_reused, 5u);
+
+  // so is a new node
+  auto& z = graph.GetOrCreateNodeArg("Z", nullptr);
+  graph.AddNode("identity", "Identity", "", {&y}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_inferred, 5u);
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_reused, 8u);
+
+  ASSERT_NE(z.Shape(), nullptr);
+  ASSERT_EQ(z.Shape()->dim_size(), 2);
+  EXPECT_EQ(z.Shape()->dim(0).dim_value(), 3);
+  EXPECT_EQ(z.Shape()->dim(1).dim_value(), 2);
+
+  // as are all the nodes when the types are overridden
+  graph.SetGraphResolveNeeded();
+  Graph::ResolveOptions options;
+  options.override_types = true;
+  ASSERT_STATUS_OK(graph.Resolve(options));
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_inferred, 9u);
+  EXPECT_EQ(graph.GetResolveStats().num_nodes_reused, 8u);
+}
+
 TEST_F(GraphTest, ShapeInferenceErrorHandling) {
   Model model("graph", false, *logger_);
   auto& graph = model.MainGraph();
@@ -2,11 +2,16 @@
 // Licensed under the MIT License.
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <fstream>
 #include <memory>
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/graph/parallel_model_proto_parser.h"
+#include "core/util/thread_utils.h"
 #include "core/session/onnxruntime_c_api.h"
 #include "test/providers/provider_test_utils.h"  //For ASSERT_STATUS_OK
 #include "test/test_environment.h"
@@ -423,5 +428,129 @@ agraph (float[N] x, float[N] y) => (float[N] zp)
   RunFunctionTests(std::move(model_proto));
 }
 
+// chain of Add nodes adding a large and a small initializer to the input
+static ModelProto BuildAddChainModel(int num_nodes, int64_t size) {
+  ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  model_proto.set_producer_name("parallel parsing test");
+  auto* opset = model_proto.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(13);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("add_chain");
+  auto add_value_info = [size](ValueInfoProto& value_info, const std::string& name) {
+    value_info.set_name(name);
+    auto* tensor_type = value_info.mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(size);
+  };
+  add_value_info(*graph->add_input(), "X");
+
+  std::vector<float> data(static_cast<size_t>(size));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  auto* large = graph->add_initializer();
+  large->set_name("W");
+  large->set_data_type(TensorProto_DataType_FLOAT);
+  large->add_dims(size);
+  large->set_raw_data(data.data(), data.size() * sizeof(float));
+  auto* small = graph->add_initializer();
+  small->set_name("B");
+  small->set_data_type(TensorProto_DataType_FLOAT);
+  small->add_dims(1);
+  small->set_raw_data(data.data(), sizeof(float));
+
+  std::string input = "X";
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string output = i == num_nodes - 1 ? "Y" : "T" + std::to_string(i);
+    auto* node = graph->add_node();
+    node->set_name("add_" + std::to_string(i));
+    node->set_op_type("Add");
+    node->add_input(input);
+    node->add_input(i % 2 == 0 ? "W" : "B");
+    node->add_output(output);
+    input = output;
+  }
+  add_value_info(*graph->add_output(), "Y");
+  return model_proto;
+}
+
+TEST(ParallelModelProtoParser, MatchesSequentialParsing) {
+  const std::string bytes = BuildAddChainModel(64, 4096).SerializeAsString();
+  const auto span = gsl::make_span(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  ModelProto expected;
+  ASSERT_TRUE(expected.ParseFromString(bytes));
+
+  // without referenced data, the parsed model is the same as the sequentially parsed one
+  ModelProto parsed;
+  ASSERT_STATUS_OK(ParseModelProtoInParallel(span, parsed, thread_pool.get()));
+  EXPECT_EQ(parsed.SerializeAsString(), expected.SerializeAsString());
+
+  ModelProto referenced;
+  ASSERT_STATUS_OK(ParseModelProtoInParallel(span, referenced, thread_pool.get(), 1024));
+  ASSERT_EQ(referenced.graph().node_size(), expected.graph().node_size());
+  for (int i = 0; i < expected.graph().node_size(); ++i) {
+    EXPECT_EQ(referenced.graph().node(i).SerializeAsString(), expected.graph().node(i).SerializeAsString());
+  }
+
+  ASSERT_EQ(referenced.graph().initializer_size(), 2);
+  const auto& large = referenced.graph().initializer(0);
+  if (utils::HasExternalData(large)) {
+    // the data is only referenced if it is aligned
+    EXPECT_EQ(large.raw_data().size(), 0u);
+    std::vector<uint8_t> unpacked;
+    ASSERT_STATUS_OK(utils::UnpackInitializerData(large, std::filesystem::path(), unpacked));
+    EXPECT_EQ(std::string(unpacked.begin(), unpacked.end()), expected.graph().initializer(0).raw_data());
+  } else {
+    EXPECT_EQ(large.SerializeAsString(), expected.graph().initializer(0).SerializeAsString());
+  }
+  // the small initializer is always copied
+  EXPECT_EQ(referenced.graph().initializer(1).SerializeAsString(),
+            expected.graph().initializer(1).SerializeAsString());
+}
+
+TEST(ParallelModelProtoParser, InvalidProtobuf) {
+  std::string bytes = BuildAddChainModel(4, 16).SerializeAsString();
+  bytes.resize(bytes.size() / 2);
+  const auto span = gsl::make_span(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+  ModelProto parsed;
+  auto status = ParseModelProtoInParallel(span, parsed, nullptr, 1024);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_EQ(status.Code(), common::INVALID_PROTOBUF);
+}
+
+TEST_F(ONNXModelsTest, LoadInParallel) {
+  const PathString model_path = ORT_TSTR("parallel_model_parsing_test.onnx");
+  {
+    std::ofstream file(model_path, std::ios::binary);
+    ASSERT_TRUE(BuildAddChainModel(16, 4096).SerializeToOstream(&file));
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::LoadInParallel(model_path, model, nullptr, *logger_, {}, thread_pool.get()));
+  EXPECT_EQ(model->MainGraph().NumberOfNodes(), 16);
+  const TensorProto* weights = nullptr;
+  ASSERT_TRUE(model->MainGraph().GetInitializedTensor("W", weights));
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(*weights, model->ModelPath(), unpacked));
+  ASSERT_EQ(unpacked.size(), 4096 * sizeof(float));
+  EXPECT_EQ(reinterpret_cast<const float*>(unpacked.data())[4095], 4095.f);
+
+  model.reset();
+  std::filesystem::remove(model_path);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -232,6 +232,32 @@ TEST(LoraAdapterTest, VerifyDeviceCopy) {
     ASSERT_EQ(expected_span, copy_span);
   }
 }
+
+TEST(LoraAdapterTest, VerifyAsyncDeviceCopy) {
+  auto cpu_ep = DefaultCpuExecutionProvider();
+  auto cpu_allocator = cpu_ep->CreatePreferredAllocators()[0];
+  auto cuda_ep = DefaultCudaExecutionProvider();
+  auto cuda_allocator = cuda_ep->CreatePreferredAllocators()[0];
+
+  auto gpu_transfer = cuda_ep->GetDataTransfer();
+
+  auto test_params = GenerateTestParameters<float>()();
+  lora::LoraAdapter adapter(std::move(cuda_allocator), /*copy_to_device_async*/ true);
+  adapter.Load(std::move(test_params));
+  ASSERT_STATUS_OK(adapter.WaitForDeviceCopy());
+
+  auto [begin, end] = adapter.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto& [_, param] = *begin;
+    const auto& tensor_device = param.GetDeviceOrMapped().Get<Tensor>();
+    ASSERT_EQ(0, strcmp(tensor_device.Location().name, onnxruntime::CUDA));
+
+    const auto& tensor_cpu = param.GetMapped().Get<Tensor>();
+    Tensor copy(tensor_cpu.DataType(), tensor_cpu.Shape(), cpu_allocator);
+    ASSERT_STATUS_OK(gpu_transfer->CopyTensor(tensor_device, copy));
+    ASSERT_EQ(tensor_cpu.DataAsSpan<float>(), copy.DataAsSpan<float>());
+  }
+}
 #endif
 }  // namespace test
 }  // namespace onnxruntime
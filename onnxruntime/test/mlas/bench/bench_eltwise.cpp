@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+template <void (*Kernel)(const float*, float*, size_t)>
+void UNARY_FLOAT(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  if (count == 0) {
+    throw std::invalid_argument("count must be greater than 0!");
+  }
+
+  auto input = RandomVectorUniform(count, -5.0f, 5.0f);
+  std::vector<float> output(count);
+
+  // warming up run
+  Kernel(input.data(), output.data(), count);
+
+  for (auto _ : state) {
+    Kernel(input.data(), output.data(), count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+// MLASCALL may not be the default calling convention, so the kernels are wrapped.
+static void ComputeErf(const float* input, float* output, size_t count) {
+  MlasComputeErf(input, output, count);
+}
+
+static void ComputeTanh(const float* input, float* output, size_t count) {
+  MlasComputeTanh(input, output, count);
+}
+
+static void ComputeLogistic(const float* input, float* output, size_t count) {
+  MlasComputeLogistic(input, output, count);
+}
+
+static void ELTWISE_ADD(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  if (count == 0) {
+    throw std::invalid_argument("count must be greater than 0!");
+  }
+
+  auto left = RandomVectorUniform(count, -1.0f, 1.0f);
+  auto right = RandomVectorUniform(count, -1.0f, 1.0f);
+  std::vector<float> output(count);
+
+  // warming up run
+  MlasEltwiseAdd(left.data(), right.data(), output.data(), count);
+
+  for (auto _ : state) {
+    MlasEltwiseAdd(left.data(), right.data(), output.data(), count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+template <typename T>
+void TRANSPOSE(benchmark::State& state) {
+  const auto M = static_cast<size_t>(state.range(0));
+  const auto N = static_cast<size_t>(state.range(1));
+  if (M == 0 || N == 0) {
+    throw std::invalid_argument("M and N must be greater than 0!");
+  }
+
+  std::vector<T> input(M * N);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<T>(i);
+  }
+  std::vector<T> output(M * N);
+
+  // warming up run
+  MlasTranspose(input.data(), output.data(), M, N);
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), M, N);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * M * N * sizeof(T)));
+}
+
+// Activation sizes of BERT-base (128 x 768 and 128 x 3072) and of a MobileNet feature map (112 x 112 x 32)
+static const std::vector<int64_t> kEltwiseCounts = {1000, 128 * 768, 128 * 3072, 112 * 112 * 32};
+
+BENCHMARK(UNARY_FLOAT<ComputeErf>)->ArgNames({"Count"})->ArgsProduct({kEltwiseCounts})->UseRealTime();
+BENCHMARK(UNARY_FLOAT<ComputeTanh>)->ArgNames({"Count"})->ArgsProduct({kEltwiseCounts})->UseRealTime();
+BENCHMARK(UNARY_FLOAT<ComputeLogistic>)->ArgNames({"Count"})->ArgsProduct({kEltwiseCounts})->UseRealTime();
+BENCHMARK(ELTWISE_ADD)->ArgNames({"Count"})->ArgsProduct({kEltwiseCounts})->UseRealTime();
+
+// Sequence x hidden planes of BERT-base and NCHW <-> NHWC planes of ResNet50 feature maps.
+static void TransposeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+  b->Args({128, 768});
+  b->Args({768, 128});
+  b->Args({64, 3136});
+  b->Args({3136, 64});
+  b->Args({2048, 49});
+  b->Args({1000, 1000});
+}
+
+BENCHMARK(TRANSPOSE<uint8_t>)->Apply(TransposeArgs)->UseRealTime();
+BENCHMARK(TRANSPOSE<uint16_t>)->Apply(TransposeArgs)->UseRealTime();
+BENCHMARK(TRANSPOSE<float>)->Apply(TransposeArgs)->UseRealTime();
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static void FLASHATTENTION(benchmark::State& state) {
+  const auto batch_size = static_cast<int>(state.range(0));
+  const auto num_heads = static_cast<int>(state.range(1));
+  const auto q_sequence_length = static_cast<int>(state.range(2));
+  const auto kv_sequence_length = static_cast<int>(state.range(3));
+  const auto head_size = static_cast<int>(state.range(4));
+  const bool is_causal = state.range(5) != 0;
+  const auto threads = static_cast<int>(state.range(6));
+
+  if (batch_size <= 0 || num_heads <= 0 || q_sequence_length <= 0 || kv_sequence_length <= 0 || head_size <= 0) {
+    throw std::invalid_argument("all dims must be greater than 0!");
+  }
+
+  auto tp = CreateBenchThreadPool(threads);
+
+  // Block sizes picked the same way as the MultiHeadAttention kernel, for a 1MB L2 cache.
+  constexpr int l2_cache_size = 1 << 20;
+  MlasFlashAttentionThreadedArgs args;
+  args.batch_size = batch_size;
+  args.num_heads = num_heads;
+  args.q_sequence_length = q_sequence_length;
+  args.kv_sequence_length = kv_sequence_length;
+  args.qk_head_size = head_size;
+  args.v_head_size = head_size;
+  args.kv_block_size = std::max(l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * (2 * head_size)), 1);
+  args.q_block_size = std::min(args.kv_block_size, 2 * head_size);
+  args.kv_block_size = std::min(args.kv_block_size, kv_sequence_length);
+  args.q_block_size = std::min(args.q_block_size, q_sequence_length);
+  args.scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  args.thread_count = threads;
+  args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.kv_block_size) +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.v_head_size)) *
+                                sizeof(float);
+  args.is_causal = is_causal;
+
+  // the queries are the last ones of the sequence, as with a past key and value cache
+  std::vector<int> causal_offsets(batch_size, std::max(kv_sequence_length - q_sequence_length, 0));
+  args.causal_offsets = causal_offsets.data();
+
+  const size_t q_elements = static_cast<size_t>(batch_size) * num_heads * q_sequence_length * head_size;
+  const size_t kv_elements = static_cast<size_t>(batch_size) * num_heads * kv_sequence_length * head_size;
+  auto query = RandomVectorUniform(q_elements, -1.0f, 1.0f);
+  auto key = RandomVectorUniform(kv_elements, -1.0f, 1.0f);
+  auto value = RandomVectorUniform(kv_elements, -1.0f, 1.0f);
+  std::vector<float> buffer(args.buffer_size_per_thread * threads / sizeof(float));
+  std::vector<float> output(q_elements);
+  args.buffer = buffer.data();
+  args.query = query.data();
+  args.key = key.data();
+  args.value = value.data();
+  args.output = output.data();
+
+  // warming up run
+  MlasFlashAttention(&args, tp.get());
+
+  for (auto _ : state) {
+    MlasFlashAttention(&args, tp.get());
+  }
+}
+
+static void FlashAttentionArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"B", "N", "Sq", "Skv", "H", "Causal", "Threads"});
+  for (int64_t threads : {1, 8}) {
+    b->Args({1, 12, 128, 128, 64, 0, threads});   // BERT-base
+    b->Args({1, 12, 512, 512, 64, 0, threads});   // BERT-base, long sequence
+    b->Args({1, 32, 512, 512, 128, 1, threads});  // LLaMA-7B prompt
+    b->Args({1, 32, 1, 1024, 128, 1, threads});   // LLaMA-7B token generation
+    b->Args({4, 8, 197, 197, 64, 0, threads});    // ViT-S/16, batched
+  }
+}
+
+BENCHMARK(FLASHATTENTION)->Apply(FlashAttentionArgs)->UseRealTime();
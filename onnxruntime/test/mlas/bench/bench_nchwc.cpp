@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static int64_t AlignToBlock(int64_t value, int64_t block_size) {
+  return (value + block_size - 1) / block_size * block_size;
+}
+
+static void NCHWC_CONV2D(benchmark::State& state) {
+  const int64_t batch_size = state.range(0);                 // N
+  const int64_t groups = state.range(1);                     // G
+  const int64_t input_channels_per_group = state.range(2);   // Cpg
+  const int64_t output_channels_per_group = state.range(3);  // Fpg
+  const int64_t height = state.range(4);                     // H
+  const int64_t width = state.range(5);                      // W
+  const int64_t kernel = state.range(6);                     // K
+  const int64_t stride = state.range(7);                     // S
+  const int64_t pad = state.range(8);                        // P
+  const int threads = static_cast<int>(state.range(9));
+
+  if (batch_size <= 0 || groups <= 0 || input_channels_per_group <= 0 || output_channels_per_group <= 0) {
+    throw std::invalid_argument("batch, group and channel counts must be greater than 0!");
+  }
+  if (height <= 0 || width <= 0 || kernel <= 0 || stride <= 0 || pad < 0) {
+    throw std::invalid_argument("invalid image, kernel, stride or pad size!");
+  }
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t input_channels = groups * input_channels_per_group;
+  const int64_t output_channels = groups * output_channels_per_group;
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+
+  // Select the filter layout the same way as the NCHWc transformer: depthwise convolutions and convolutions of
+  // inputs with less channels than a block use the NCHW input, the others use the NCHWc input.
+  const bool depthwise = groups > 1 && input_channels_per_group == 1 && output_channels_per_group == 1;
+  const bool nchwc_input = depthwise || input_channels_per_group >= block_size;
+  const int64_t conv_input_channels = nchwc_input ? AlignToBlock(input_channels, block_size) : input_channels;
+  const int64_t nchwc_output_channels = AlignToBlock(output_channels, block_size);
+
+  const int64_t filter_shape[] = {output_channels, input_channels_per_group, kernel, kernel};
+  auto filter = RandomVectorUniform(std::vector<int64_t>(filter_shape, filter_shape + 4), -1.0f, 1.0f);
+  std::vector<float> reordered_filter;
+  if (depthwise || !nchwc_input) {
+    reordered_filter.resize(static_cast<size_t>(nchwc_output_channels * input_channels_per_group * kernel * kernel));
+    MlasReorderFilterOIHWBo(filter_shape, filter.data(), reordered_filter.data());
+  } else {
+    reordered_filter.resize(static_cast<size_t>(nchwc_output_channels * AlignToBlock(input_channels_per_group, block_size) *
+                                                kernel * kernel));
+    MlasReorderFilterOIHWBiBo(filter_shape, filter.data(), reordered_filter.data());
+  }
+  auto bias = RandomVectorUniform(static_cast<size_t>(nchwc_output_channels), -1.0f, 1.0f);
+
+  const int64_t input_shape[] = {batch_size, conv_input_channels, height, width};
+  const int64_t output_shape[] = {batch_size, nchwc_output_channels, output_height, output_width};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+
+  auto input = RandomVectorUniform(std::vector<int64_t>(input_shape, input_shape + 4), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(batch_size * nchwc_output_channels * output_height * output_width));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  auto tp = CreateBenchThreadPool(threads);
+
+  // warming up run
+  MlasNchwcConv(input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                static_cast<size_t>(groups), input.data(), reordered_filter.data(), bias.data(), output.data(),
+                &activation, true, tp.get());
+
+  for (auto _ : state) {
+    MlasNchwcConv(input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                  static_cast<size_t>(groups), input.data(), reordered_filter.data(), bias.data(), output.data(),
+                  &activation, true, tp.get());
+  }
+}
+
+static void NCHWC_REORDER_OUTPUT(benchmark::State& state) {
+  const int64_t batch_size = state.range(0);  // N
+  const int64_t channels = state.range(1);    // C
+  const int64_t height = state.range(2);      // H
+  const int64_t width = state.range(3);       // W
+  const int threads = static_cast<int>(state.range(4));
+
+  if (batch_size <= 0 || channels <= 0 || height <= 0 || width <= 0) {
+    throw std::invalid_argument("all dims must be greater than 0!");
+  }
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t output_shape[] = {batch_size, channels, height, width};
+  auto input = RandomVectorUniform(static_cast<size_t>(batch_size * AlignToBlock(channels, block_size) * height * width),
+                                   -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(batch_size * channels * height * width));
+
+  auto tp = CreateBenchThreadPool(threads);
+
+  // warming up run
+  MlasReorderOutputNchw(output_shape, input.data(), output.data(), tp.get());
+
+  for (auto _ : state) {
+    MlasReorderOutputNchw(output_shape, input.data(), output.data(), tp.get());
+  }
+}
+
+static void NchwcConvArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "G", "Cpg", "Fpg", "H", "W", "K", "S", "P", "Threads"});
+  for (int64_t threads : {1, 8}) {
+    b->Args({1, 1, 3, 64, 224, 224, 7, 2, 3, threads});    // ResNet50 stem, NCHW input
+    b->Args({1, 1, 64, 64, 56, 56, 3, 1, 1, threads});     // ResNet50 3x3
+    b->Args({1, 1, 256, 64, 56, 56, 1, 1, 0, threads});    // ResNet50 pointwise
+    b->Args({1, 1, 512, 1024, 28, 28, 1, 2, 0, threads});  // ResNet50 strided pointwise
+    b->Args({1, 32, 1, 1, 112, 112, 3, 1, 1, threads});    // MobileNet depthwise
+    b->Args({1, 512, 1, 1, 14, 14, 3, 1, 1, threads});     // MobileNet depthwise
+  }
+}
+
+BENCHMARK(NCHWC_CONV2D)->Apply(NchwcConvArgs)->UseRealTime();
+
+BENCHMARK(NCHWC_REORDER_OUTPUT)
+    ->ArgNames({"N", "C", "H", "W", "Threads"})
+    ->ArgsProduct({{1}, {64, 255, 1024}, {56}, {56}, {1, 8}})
+    ->UseRealTime();
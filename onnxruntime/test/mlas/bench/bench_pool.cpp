@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static void POOL2D(benchmark::State& state, MLAS_POOLING_KIND kind, bool nchwc) {
+  const int64_t batch_size = state.range(0);  // N
+  int64_t channels = state.range(1);          // C
+  const int64_t height = state.range(2);      // H
+  const int64_t width = state.range(3);       // W
+  const int64_t kernel = state.range(4);      // K
+  const int64_t stride = state.range(5);      // S
+  const int64_t pad = state.range(6);         // P
+  const int threads = static_cast<int>(state.range(7));
+
+  if (batch_size <= 0 || channels <= 0 || height <= 0 || width <= 0) {
+    throw std::invalid_argument("all input dims must be greater than 0!");
+  }
+  if (kernel <= 0 || stride <= 0 || pad < 0) {
+    throw std::invalid_argument("kernel and stride must be greater than 0, pad must not be negative!");
+  }
+
+  if (nchwc) {
+    const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+    if (block_size <= 1) {
+      state.SkipWithError("NCHWc is not supported on this platform");
+      return;
+    }
+    channels = (channels + block_size - 1) / block_size * block_size;
+  }
+
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+
+  const int64_t input_shape[] = {batch_size, channels, height, width};
+  const int64_t output_shape[] = {batch_size, channels, output_height, output_width};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+
+  auto tp = CreateBenchThreadPool(threads);
+  auto input = RandomVectorUniform(std::vector<int64_t>(input_shape, input_shape + 4), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(batch_size * channels * output_height * output_width));
+
+  auto run = [&]() {
+    if (nchwc) {
+      MlasNchwcPool(kind, input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                    input.data(), output.data(), tp.get());
+    } else {
+      MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape,
+               input.data(), output.data(), tp.get());
+    }
+  };
+
+  // warming up run
+  run();
+
+  for (auto _ : state) {
+    run();
+  }
+}
+
+static void PoolArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "H", "W", "K", "S", "P", "Threads"});
+  for (int64_t threads : {1, 8}) {
+    b->Args({1, 64, 112, 112, 3, 2, 1, threads});  // ResNet50 stem max pool
+    b->Args({1, 192, 28, 28, 3, 1, 1, threads});   // Inception branch pool
+    b->Args({1, 256, 56, 56, 2, 2, 0, threads});   // VGG max pool
+    b->Args({1, 2048, 7, 7, 7, 1, 0, threads});    // ResNet50 global average pool
+    b->Args({8, 512, 14, 14, 3, 2, 1, threads});   // batched
+  }
+}
+
+BENCHMARK_CAPTURE(POOL2D, MaxPool, MlasMaximumPooling, false)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, AveragePool, MlasAveragePoolingExcludePad, false)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, NchwcMaxPool, MlasMaximumPooling, true)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, NchwcAveragePool, MlasAveragePoolingExcludePad, true)->Apply(PoolArgs)->UseRealTime();
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+template <typename OutputType>
+void QUANTIZELINEAR(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  if (count == 0) {
+    throw std::invalid_argument("count must be greater than 0!");
+  }
+
+  auto input = RandomVectorUniform(count, -8.0f, 8.0f);
+  std::vector<OutputType> output(count);
+  const float scale = 16.0f / 255.0f;
+  const OutputType zero_point = std::is_signed_v<OutputType> ? OutputType(0) : OutputType(128);
+
+  // warming up run
+  MlasQuantizeLinear(input.data(), output.data(), count, scale, zero_point);
+
+  for (auto _ : state) {
+    MlasQuantizeLinear(input.data(), output.data(), count, scale, zero_point);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+template <typename OutputType>
+void REQUANTIZEOUTPUT(benchmark::State& state) {
+  const auto M = static_cast<size_t>(state.range(0));
+  const auto N = static_cast<size_t>(state.range(1));
+  const bool per_column_scale = state.range(2) != 0;
+  if (M == 0 || N == 0) {
+    throw std::invalid_argument("M and N must be greater than 0!");
+  }
+
+  auto input = RandomVectorUniform<int32_t>(M * N, -65536, 65536);
+  auto bias = RandomVectorUniform<int32_t>(N, -1024, 1024);
+  auto scale = RandomVectorUniform(N, 1.0f / 1024.0f, 1.0f / 256.0f);
+  std::vector<OutputType> output(M * N);
+  const OutputType zero_point = std::is_signed_v<OutputType> ? OutputType(0) : OutputType(128);
+
+  // warming up run
+  MlasRequantizeOutput(input.data(), N, output.data(), N, bias.data(), scale.data(), per_column_scale,
+                       zero_point, 0, 0, M, N);
+
+  for (auto _ : state) {
+    MlasRequantizeOutput(input.data(), N, output.data(), N, bias.data(), scale.data(), per_column_scale,
+                         zero_point, 0, 0, M, N);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * M * N));
+}
+
+template <typename DataType>
+void QLINEARADD(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const bool is_scalar_b = state.range(1) != 0;
+  if (count == 0) {
+    throw std::invalid_argument("count must be greater than 0!");
+  }
+
+  const float low = static_cast<float>(std::numeric_limits<DataType>::lowest());
+  const float high = static_cast<float>(std::numeric_limits<DataType>::max());
+  auto a = RandomVectorUniform<DataType>(count, static_cast<DataType>(low), static_cast<DataType>(high));
+  auto b = RandomVectorUniform<DataType>(is_scalar_b ? 1 : count, static_cast<DataType>(low),
+                                         static_cast<DataType>(high));
+  std::vector<DataType> c(count);
+  const int32_t zero_point = std::is_signed_v<DataType> ? 0 : 128;
+
+  // warming up run
+  MlasQLinearAdd(a.data(), 0.05f, zero_point, b.data(), 0.04f, zero_point, 0.08f, zero_point, c.data(), count,
+                 is_scalar_b);
+
+  for (auto _ : state) {
+    MlasQLinearAdd(a.data(), 0.05f, zero_point, b.data(), 0.04f, zero_point, 0.08f, zero_point, c.data(), count,
+                   is_scalar_b);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+// Activation sizes of BERT-base (128 x 768 and 128 x 3072) and of ResNet50 (56 x 56 x 256)
+static const std::vector<int64_t> kQuantizeCounts = {768, 128 * 768, 128 * 3072, 56 * 56 * 256};
+
+BENCHMARK(QUANTIZELINEAR<uint8_t>)->ArgNames({"Count"})->ArgsProduct({kQuantizeCounts})->UseRealTime();
+BENCHMARK(QUANTIZELINEAR<int8_t>)->ArgNames({"Count"})->ArgsProduct({kQuantizeCounts})->UseRealTime();
+
+BENCHMARK(REQUANTIZEOUTPUT<uint8_t>)
+    ->ArgNames({"M", "N", "PerColumn"})
+    ->ArgsProduct({{1, 128}, {768, 3072}, {0, 1}})
+    ->UseRealTime();
+BENCHMARK(REQUANTIZEOUTPUT<int8_t>)
+    ->ArgNames({"M", "N", "PerColumn"})
+    ->ArgsProduct({{1, 128}, {768, 3072}, {0, 1}})
+    ->UseRealTime();
+
+BENCHMARK(QLINEARADD<uint8_t>)->ArgNames({"Count", "ScalarB"})->ArgsProduct({kQuantizeCounts, {0, 1}})->UseRealTime();
+BENCHMARK(QLINEARADD<int8_t>)->ArgNames({"Count", "ScalarB"})->ArgsProduct({kQuantizeCounts, {0, 1}})->UseRealTime();
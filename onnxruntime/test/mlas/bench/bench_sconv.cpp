@@ -38,8 +38,7 @@ static const std::vector<std::string>& ArgNamesForConv(size_t rank) {
   return rank_to_args_name[rank];
 }
 
-// dummy for some strange build error when using Bench capture
-void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+static void SconvNchw(benchmark::State& state, bool winograd) {
   const int64_t rank = state.range(0);                       // Rank
   const int64_t batch_size = state.range(1);                 // N
   const int64_t groups = state.range(2);                     // G
@@ -110,10 +109,25 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
                   &activation,
                   &WorkingBufferSize,
                   0.0f,
-                  nullptr);
+                  nullptr,
+                  winograd);
+
+  if (winograd && Parameters.Algorithm != MlasConvAlgorithmWinograd) {
+    state.SkipWithError("the convolution is not supported by the Winograd algorithm");
+    return;
+  }
 
   auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
   auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
+  if (winograd) {
+    std::vector<float> packed_filter(MlasConvWinogradPackFilterSize(static_cast<size_t>(output_channels_per_group),
+                                                                    static_cast<size_t>(input_channels_per_group)));
+    MlasConvWinogradPackFilter(static_cast<size_t>(output_channels_per_group),
+                               static_cast<size_t>(input_channels_per_group),
+                               F.data(),
+                               packed_filter.data());
+    F = std::move(packed_filter);
+  }
   int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
   std::vector<float> Y(static_cast<size_t>(y_size));
   std::vector<float> working_buffer(WorkingBufferSize);
@@ -138,6 +152,15 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   }
 }
 
+// dummy for some strange build error when using Bench capture
+void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+  SconvNchw(state, false);
+}
+
+void SCONV_NCHW_WINOGRAD(benchmark::State& state, const char* /*dummy*/) {
+  SconvNchw(state, true);
+}
+
 static void ResNet50(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
 
@@ -245,3 +268,17 @@ static void General_Conv2d(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, 2d, "")->Apply(General_Conv2d)->UseRealTime();
+
+static void Winograd_Conv2d(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+
+  // The 3x3 stride 1 convolutions of ResNet50, computed directly and with the Winograd algorithm.
+  //    Rank, N, G,Cpg,Fpg,  I,   , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 256, 256, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 512, 512, 7, 7, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, Winograd, "")->Apply(Winograd_Conv2d)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHW_WINOGRAD, Winograd, "")->Apply(Winograd_Conv2d)->UseRealTime();
@@ -5,6 +5,8 @@
 #include <numeric>
 #include <stdexcept>
 
+#include "core/util/thread_utils.h"
+
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count) {
   std::vector<int64_t> shape;
   shape.reserve(count);
@@ -22,3 +24,15 @@ std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_val
   }
   return RandomVectorUniform(static_cast<size_t>(sz), min_value, max_value);
 }
+
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(int threads) {
+  if (threads <= 0) {
+    throw std::invalid_argument("threads must be greater than 0!");
+  }
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo,
+                                                 onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
@@ -6,10 +6,12 @@
 #include <benchmark/benchmark.h>
 
 #include <functional>
+#include <memory>
 #include <random>
 
 #include "core/framework/float16.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 template <typename ElementType>
 typename std::enable_if_t<!std::is_same_v<ElementType, MLAS_FP16>, std::vector<ElementType>>
@@ -52,3 +54,6 @@ RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Creates an intra op thread pool of the given size, with the thread affinity set.
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(int threads);
@@ -0,0 +1,93 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""Compares two runs of onnxruntime_mlas_benchmark saved in the Google Benchmark JSON format.
+
+Record a baseline and a run with the change, on the same host:
+
+    onnxruntime_mlas_benchmark --benchmark_out=baseline.json --benchmark_out_format=json --benchmark_repetitions=5
+    onnxruntime_mlas_benchmark --benchmark_out=current.json --benchmark_out_format=json --benchmark_repetitions=5
+    python compare_bench.py baseline.json current.json --threshold 5
+
+The medians of the repetitions are compared when they are present. The script exits with 1 when a benchmark
+is slower than the baseline by more than the threshold, so it can gate kernel changes on each host.
+"""
+
+import argparse
+import json
+import sys
+
+_TIME_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path):
+    with open(path, encoding="utf-8") as f:
+        report = json.load(f)
+
+    times = {}
+    medians = {}
+    for benchmark in report.get("benchmarks", []):
+        if benchmark.get("error_occurred"):
+            continue
+        time_ns = benchmark["real_time"] * _TIME_UNIT_TO_NS[benchmark.get("time_unit", "ns")]
+        aggregate = benchmark.get("aggregate_name")
+        if aggregate == "median":
+            medians[benchmark["run_name"]] = time_ns
+        elif aggregate is None:
+            # keep the fastest repetition when the aggregates were not reported
+            name = benchmark.get("run_name", benchmark["name"])
+            times[name] = min(time_ns, times.get(name, time_ns))
+
+    times.update(medians)
+    return report.get("context", {}), times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="JSON output of the baseline run")
+    parser.add_argument("current", help="JSON output of the run to check")
+    parser.add_argument(
+        "--threshold", type=float, default=5.0, help="slowdown in percent reported as a regression (default: 5)"
+    )
+    parser.add_argument("--filter", default="", help="only compare the benchmarks whose name contains this string")
+    args = parser.parse_args()
+
+    baseline_context, baseline = load_times(args.baseline)
+    current_context, current = load_times(args.current)
+
+    if baseline_context.get("host_name") != current_context.get("host_name"):
+        print(
+            f"warning: the runs come from different hosts "
+            f"({baseline_context.get('host_name')} and {current_context.get('host_name')})"
+        )
+
+    names = sorted(name for name in baseline.keys() & current.keys() if args.filter in name)
+    if not names:
+        print("no benchmark is present in both runs")
+        return 1
+
+    regressions = []
+    width = max(len("benchmark"), *(len(name) for name in names))
+    print(f"{'benchmark':<{width}}  {'baseline (ns)':>14}  {'current (ns)':>14}  {'change':>8}")
+    for name in names:
+        change = (current[name] / baseline[name] - 1.0) * 100.0
+        mark = ""
+        if change > args.threshold:
+            regressions.append(name)
+            mark = "  <-- regression"
+        print(f"{name:<{width}}  {baseline[name]:>14.1f}  {current[name]:>14.1f}  {change:>+7.1f}%{mark}")
+
+    only_in_baseline = sorted(name for name in baseline.keys() - current.keys() if args.filter in name)
+    if only_in_baseline:
+        print("\nmissing from the current run: " + ", ".join(only_in_baseline))
+
+    if regressions:
+        print(f"\n{len(regressions)} of {len(names)} benchmarks are more than {args.threshold}% slower than the baseline")
+        return 1
+
+    print(f"\nno benchmark is more than {args.threshold}% slower than the baseline")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
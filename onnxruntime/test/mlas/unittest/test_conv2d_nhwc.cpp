@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConv2DNhwcTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // The filter is in HWIO format: KernelHeight x KernelWidth x InputChannels
+  // rows of GroupCount x FilterCount columns.
+  //
+  void ReferenceConv2D(size_t BatchCount,
+                       size_t GroupCount,
+                       size_t InputChannels,
+                       size_t InputHeight,
+                       size_t InputWidth,
+                       size_t FilterCount,
+                       size_t KernelHeight,
+                       size_t KernelWidth,
+                       size_t PaddingTop,
+                       size_t PaddingLeft,
+                       size_t DilationHeight,
+                       size_t DilationWidth,
+                       size_t StrideHeight,
+                       size_t StrideWidth,
+                       size_t OutputHeight,
+                       size_t OutputWidth,
+                       const float* Input,
+                       const float* Filter,
+                       const float* Bias,
+                       float Beta,
+                       float* Output) {
+    const size_t TotalInputChannels = GroupCount * InputChannels;
+    const size_t TotalFilterCount = GroupCount * FilterCount;
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t oh = 0; oh < OutputHeight; oh++) {
+        for (size_t ow = 0; ow < OutputWidth; ow++) {
+          for (size_t g = 0; g < GroupCount; g++) {
+            for (size_t f = 0; f < FilterCount; f++) {
+              const size_t oc = g * FilterCount + f;
+              double sum = 0.0;
+              for (size_t kh = 0; kh < KernelHeight; kh++) {
+                size_t ih = oh * StrideHeight + kh * DilationHeight - PaddingTop;
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+                  size_t iw = ow * StrideWidth + kw * DilationWidth - PaddingLeft;
+                  if (ih >= InputHeight || iw >= InputWidth) {
+                    continue;
+                  }
+                  const float* input = Input + ((b * InputHeight + ih) * InputWidth + iw) * TotalInputChannels +
+                                       g * InputChannels;
+                  const float* filter = Filter + (kh * KernelWidth + kw) * InputChannels * TotalFilterCount + oc;
+                  for (size_t c = 0; c < InputChannels; c++) {
+                    sum += double(input[c]) * double(filter[c * TotalFilterCount]);
+                  }
+                }
+              }
+              float& output = Output[((b * OutputHeight + oh) * OutputWidth + ow) * TotalFilterCount + oc];
+              output = std::max(float(sum) + Beta * output + Bias[oc], 0.0f);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t KernelHeight,
+            size_t KernelWidth,
+            size_t PaddingTop,
+            size_t PaddingLeft,
+            size_t PaddingBottom,
+            size_t PaddingRight,
+            size_t DilationHeight,
+            size_t DilationWidth,
+            size_t StrideHeight,
+            size_t StrideWidth,
+            float Beta) {
+    const size_t OutputHeight = (InputHeight + PaddingTop + PaddingBottom - DilationHeight * (KernelHeight - 1) - 1) /
+                                    StrideHeight +
+                                1;
+    const size_t OutputWidth = (InputWidth + PaddingLeft + PaddingRight - DilationWidth * (KernelWidth - 1) - 1) /
+                                   StrideWidth +
+                               1;
+
+    const size_t OutputElements = BatchCount * OutputHeight * OutputWidth * GroupCount * FilterCount;
+
+    const float* Input = BufferInput.GetBuffer(BatchCount * InputHeight * InputWidth * GroupCount * InputChannels);
+    const float* Filter = BufferFilter.GetBuffer(KernelHeight * KernelWidth * InputChannels * GroupCount * FilterCount);
+    const float* Bias = BufferBias.GetBuffer(GroupCount * FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = OutputReference[i] = float(i % 7) - 3.0f;
+    }
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {int64_t(KernelHeight), int64_t(KernelWidth)};
+    int64_t DilationShape[] = {int64_t(DilationHeight), int64_t(DilationWidth)};
+    int64_t Pads[] = {int64_t(PaddingTop), int64_t(PaddingLeft), int64_t(PaddingBottom), int64_t(PaddingRight)};
+    int64_t StrideShape[] = {int64_t(StrideHeight), int64_t(StrideWidth)};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters,
+                    2,
+                    BatchCount,
+                    GroupCount,
+                    InputChannels,
+                    InputShape,
+                    KernelShape,
+                    DilationShape,
+                    Pads,
+                    StrideShape,
+                    OutputShape,
+                    FilterCount,
+                    &Activation,
+                    &WorkingBufferSize,
+                    Beta,
+                    threadpool_);
+
+    MlasConvNhwc(&Parameters, Input, Filter, Bias, Output, threadpool_);
+
+    ReferenceConv2D(BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                    KernelHeight, KernelWidth, PaddingTop, PaddingLeft, DilationHeight, DilationWidth,
+                    StrideHeight, StrideWidth, OutputHeight, OutputWidth, Input, Filter, Bias, Beta,
+                    OutputReference);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), 1e-4f * (1.0f + std::abs(OutputReference[i])))
+          << " @" << i << " B" << BatchCount << "/G" << GroupCount << "/C" << InputChannels
+          << "/H" << InputHeight << "/W" << InputWidth << "/F" << FilterCount
+          << "/K" << KernelHeight << "x" << KernelWidth << "/Pad" << PaddingTop << "," << PaddingLeft
+          << "/Dilation" << DilationHeight << "x" << DilationWidth << "/Stride" << StrideHeight << "x" << StrideWidth
+          << "/Beta" << Beta << ", got:" << Output[i] << ", expecting:" << OutputReference[i];
+    }
+  }
+
+ public:
+  MlasConv2DNhwcTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dNhwc");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t g : {size_t(1), size_t(3)}) {
+      for (size_t c : {size_t(1), size_t(8), size_t(19)}) {
+        for (size_t f : {size_t(1), size_t(16), size_t(21)}) {
+          for (size_t k : {size_t(1), size_t(3), size_t(5)}) {
+            Test(1, g, c, 11, 13, f, k, k, 0, 0, 0, 0, 1, 1, 1, 1, 0.0f);
+            Test(2, g, c, 11, 13, f, k, k, k / 2, k / 2, k / 2, k / 2, 1, 1, 1, 1, 1.0f);
+            Test(1, g, c, 11, 13, f, k, k, 1, 2, 0, 1, 1, 1, 2, 2, 0.0f);
+            Test(1, g, c, 16, 15, f, k, k, 2, 1, 2, 1, 2, 2, 1, 3, 0.5f);
+          }
+        }
+      }
+    }
+    Test(1, 1, 7, 9, 17, 5, 1, 7, 0, 3, 0, 3, 1, 1, 1, 1, 0.0f);
+    Test(1, 2, 3, 17, 9, 6, 7, 1, 3, 0, 3, 0, 1, 1, 1, 1, 0.0f);
+  }
+};
+
+class MlasConvDepthwiseNhwcTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  std::vector<const float*> BufferIndirection;
+
+  void Test(size_t Channels, size_t OutputCount, size_t KernelSize, bool UseBias, float Beta) {
+    const float* Input = BufferInput.GetBuffer(OutputCount * KernelSize * Channels);
+    const float* Filter = BufferFilter.GetBuffer(KernelSize * Channels);
+    const float* Bias = UseBias ? BufferBias.GetBuffer(Channels) : nullptr;
+    float* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount * Channels);
+    BufferIndirection.resize(OutputCount * KernelSize);
+    const float** Indirection = BufferIndirection.data();
+
+    for (size_t i = 0; i < OutputCount * KernelSize; i++) {
+      Indirection[i] = Input + ((i * 7) % (OutputCount * KernelSize)) * Channels;
+    }
+
+    for (size_t i = 0; i < OutputCount * Channels; i++) {
+      Output[i] = OutputReference[i] = float(i % 5) - 2.0f;
+    }
+
+    for (size_t p = 0; p < OutputCount; p++) {
+      for (size_t c = 0; c < Channels; c++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < KernelSize; k++) {
+          sum += Indirection[p * KernelSize + k][c] * Filter[k * Channels + c];
+        }
+        float& output = OutputReference[p * Channels + c];
+        output = std::max(sum + Beta * output + (UseBias ? Bias[c] : 0.0f), 0.0f);
+      }
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MlasConvDepthwise(Indirection, Filter, Bias, Output, Channels, OutputCount, KernelSize, Beta, &Activation);
+
+    for (size_t i = 0; i < OutputCount * Channels; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), 1e-5f * (1.0f + std::abs(OutputReference[i])))
+          << " @" << i << " C" << Channels << "/P" << OutputCount << "/K" << KernelSize << "/Beta" << Beta
+          << ", got:" << Output[i] << ", expecting:" << OutputReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ConvDepthwiseNhwc");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t c = 1; c < 40; c++) {
+      for (size_t k : {size_t(1), size_t(9), size_t(25)}) {
+        Test(c, 7, k, true, 0.0f);
+        Test(c, 3, k, false, 1.0f);
+      }
+    }
+  }
+};
+
+template <bool IsMaxPool>
+class MlasNhwcPoolTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  std::vector<const float*> BufferIndirection;
+
+  void Test(size_t Channels, size_t OutputCount, size_t KernelSize) {
+    const float* Input = BufferInput.GetBuffer(OutputCount * KernelSize * Channels);
+    float* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount * Channels);
+    BufferIndirection.resize(OutputCount * KernelSize);
+    const float** Indirection = BufferIndirection.data();
+
+    //
+    // Every third entry of the indirection buffer is padding, except for the
+    // first entry of each output pixel.
+    //
+
+    for (size_t i = 0; i < OutputCount * KernelSize; i++) {
+      Indirection[i] = (i % KernelSize != 0 && i % 3 == 0) ? nullptr : Input + i * Channels;
+    }
+
+    for (size_t p = 0; p < OutputCount; p++) {
+      for (size_t c = 0; c < Channels; c++) {
+        float acc = IsMaxPool ? std::numeric_limits<float>::lowest() : 0.0f;
+        size_t count = 0;
+        for (size_t k = 0; k < KernelSize; k++) {
+          const float* input = Indirection[p * KernelSize + k];
+          if (input == nullptr) {
+            continue;
+          }
+          acc = IsMaxPool ? std::max(acc, input[c]) : acc + input[c];
+          count++;
+        }
+        OutputReference[p * Channels + c] = IsMaxPool ? acc : acc / float(count);
+      }
+    }
+
+    if (IsMaxPool) {
+      MlasNhwcMaxPool(Indirection, Output, Channels, OutputCount, KernelSize);
+    } else {
+      MlasNhwcAvgPool(Indirection, Output, Channels, OutputCount, KernelSize);
+    }
+
+    for (size_t i = 0; i < OutputCount * Channels; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), 1e-6f * (1.0f + std::abs(OutputReference[i])))
+          << " @" << i << " C" << Channels << "/P" << OutputCount << "/K" << KernelSize
+          << ", got:" << Output[i] << ", expecting:" << OutputReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(IsMaxPool ? "NhwcMaxPool" : "NhwcAvgPool");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t c = 1; c < 40; c++) {
+      for (size_t k : {size_t(1), size_t(4), size_t(9)}) {
+        Test(c, 5, k);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DNhwcTest>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasConvDepthwiseNhwcTest>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasNhwcPoolTest<true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasNhwcPoolTest<false>>::RegisterShortExecute();
+  }
+  return count;
+});
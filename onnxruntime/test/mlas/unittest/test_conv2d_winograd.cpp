@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceConv2D(size_t BatchCount,
+                       size_t InputChannels,
+                       size_t InputHeight,
+                       size_t InputWidth,
+                       size_t FilterCount,
+                       size_t Padding,
+                       size_t OutputHeight,
+                       size_t OutputWidth,
+                       const float* Input,
+                       const float* Filter,
+                       const float* Bias,
+                       float Beta,
+                       float* Output) {
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t f = 0; f < FilterCount; f++) {
+        for (size_t oh = 0; oh < OutputHeight; oh++) {
+          for (size_t ow = 0; ow < OutputWidth; ow++) {
+            double sum = 0.0;
+            for (size_t c = 0; c < InputChannels; c++) {
+              for (size_t kh = 0; kh < 3; kh++) {
+                for (size_t kw = 0; kw < 3; kw++) {
+                  size_t ih = oh + kh - Padding;
+                  size_t iw = ow + kw - Padding;
+                  if (ih < InputHeight && iw < InputWidth) {
+                    sum += double(Input[((b * InputChannels + c) * InputHeight + ih) * InputWidth + iw]) *
+                           double(Filter[(f * InputChannels + c) * 9 + kh * 3 + kw]);
+                  }
+                }
+              }
+            }
+            float& output = Output[((b * FilterCount + f) * OutputHeight + oh) * OutputWidth + ow];
+            output = std::max(float(sum) + Beta * output + Bias[f], 0.0f);
+          }
+        }
+      }
+    }
+  }
+
+  void Test(size_t BatchCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t Padding,
+            float Beta) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+
+    const size_t OutputElements = BatchCount * FilterCount * OutputHeight * OutputWidth;
+
+    const float* Input = BufferInput.GetBuffer(BatchCount * InputChannels * InputHeight * InputWidth);
+    const float* Filter = BufferFilter.GetBuffer(FilterCount * InputChannels * 9);
+    const float* Bias = BufferBias.GetBuffer(FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = OutputReference[i] = float(i % 7) - 3.0f;
+    }
+
+    float* PackedFilter = BufferPackedFilter.GetBuffer(MlasConvWinogradPackFilterSize(FilterCount, InputChannels));
+    MlasConvWinogradPackFilter(FilterCount, InputChannels, Filter, PackedFilter);
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Pads[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters,
+                    2,
+                    BatchCount,
+                    1,
+                    InputChannels,
+                    InputShape,
+                    KernelShape,
+                    DilationShape,
+                    Pads,
+                    StrideShape,
+                    OutputShape,
+                    FilterCount,
+                    &Activation,
+                    &WorkingBufferSize,
+                    Beta,
+                    threadpool_,
+                    true);
+
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters,
+             Input,
+             PackedFilter,
+             Bias,
+             BufferWorking.GetBuffer(WorkingBufferSize),
+             Output,
+             threadpool_);
+
+    ReferenceConv2D(BatchCount, InputChannels, InputHeight, InputWidth, FilterCount, Padding,
+                    OutputHeight, OutputWidth, Input, Filter, Bias, Beta, OutputReference);
+
+    // The Winograd transforms add rounding errors proportional to the magnitude of the output.
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), 1e-4f * (1.0f + std::abs(OutputReference[i])))
+          << " @" << i << " B" << BatchCount << "/C" << InputChannels << "/H" << InputHeight << "/W" << InputWidth
+          << "/F" << FilterCount << "/Pad" << Padding << "/Beta" << Beta << ", got:" << Output[i]
+          << ", expecting:" << OutputReference[i];
+    }
+  }
+
+ public:
+  MlasConv2DWinogradTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dWinograd");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t b : {size_t(1), size_t(2)}) {
+      for (size_t c : {size_t(16), size_t(19)}) {
+        for (size_t f : {size_t(16), size_t(33)}) {
+          for (size_t h : {size_t(4), size_t(7), size_t(13)}) {
+            for (size_t w : {size_t(6), size_t(9), size_t(30)}) {
+              for (size_t p : {size_t(0), size_t(1), size_t(2)}) {
+                if (h + 2 * p - 2 < 4) {
+                  continue;
+                }
+                Test(b, c, h, w, f, p, 0.0f);
+                Test(b, c, h, w, f, p, 1.0f);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConv2DWinogradTest>::RegisterShortExecute() : 0;
+});
@@ -70,6 +70,9 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(5, 7, 3, 17, 0.5f, -1.0f);
+    test_registered += RegisterTestTransposeABProduct(29, 31, 17, 64, -0.5f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(32, 32, 32, 13, 1.0f, 0.5f);
     return test_registered;
   }
 
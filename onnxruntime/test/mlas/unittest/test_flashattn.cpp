@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  // Fill with small values so that the softmax is not dominated by a single score.
+  static void SignedFill(float* start, size_t size) {
+    size_t offset = size % 23;
+    for (size_t i = 0; i < size; i++) {
+      offset = (offset + 21) % 23;
+      start[i] = (float(offset) - 11.0f) / 8.0f;
+    }
+  }
+
+  MatrixGuardBuffer<float> BufferQ;
+  MatrixGuardBuffer<float> BufferK;
+  MatrixGuardBuffer<float> BufferV;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorkspace;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceAttention(const MlasFlashAttentionThreadedArgs& args, float* output) {
+    const int kv_num_heads = args.kv_num_heads > 0 ? args.kv_num_heads : args.num_heads;
+    const int stride = args.kv_sequence_stride > 0 ? args.kv_sequence_stride : args.kv_sequence_length;
+    std::vector<float> scores(args.kv_sequence_length);
+
+    for (int b = 0; b < args.batch_size; b++) {
+      const int kv_length = args.kv_sequence_lengths != nullptr ? args.kv_sequence_lengths[b] : args.kv_sequence_length;
+      const int offset = args.causal_offsets != nullptr ? args.causal_offsets[b] : 0;
+      for (int n = 0; n < args.num_heads; n++) {
+        const int kv_n = n / (args.num_heads / kv_num_heads);
+        const float* k = args.key + (b * kv_num_heads + kv_n) * stride * args.qk_head_size;
+        const float* v = args.value + (b * kv_num_heads + kv_n) * stride * args.v_head_size;
+        for (int s = 0; s < args.q_sequence_length; s++) {
+          const float* q = args.query + ((b * args.num_heads + n) * args.q_sequence_length + s) * args.qk_head_size;
+          int first = 0;
+          int last = kv_length;
+          if (args.is_causal) {
+            const int causal_length = offset + s + 1;
+            last = std::min(last, causal_length);
+            if (args.local_window_size >= 0 && causal_length > args.local_window_size + 1) {
+              first = causal_length - args.local_window_size - 1;
+            }
+          }
+
+          float max_score = std::numeric_limits<float>::lowest();
+          for (int t = first; t < last; t++) {
+            float score = 0.0f;
+            for (int h = 0; h < args.qk_head_size; h++) {
+              score += q[h] * k[t * args.qk_head_size + h];
+            }
+            score *= args.scale;
+            if (args.softcap > 0.0f) {
+              score = args.softcap * std::tanh(score / args.softcap);
+            }
+            scores[t] = score;
+            max_score = std::max(max_score, score);
+          }
+
+          float sum = 0.0f;
+          for (int t = first; t < last; t++) {
+            scores[t] = std::exp(scores[t] - max_score);
+            sum += scores[t];
+          }
+
+          float* o = output + ((b * args.q_sequence_length + s) * args.num_heads + n) * args.v_head_size;
+          for (int h = 0; h < args.v_head_size; h++) {
+            float value = 0.0f;
+            for (int t = first; t < last; t++) {
+              value += scores[t] * v[t * args.v_head_size + h];
+            }
+            o[h] = (last > first) ? value / sum : 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+  void Test(int batch_size, int num_heads, int kv_num_heads, int q_sequence_length, int kv_sequence_length,
+            int head_size, int q_block_size, int kv_block_size, bool is_causal, int local_window_size,
+            float softcap, bool variable_lengths) {
+    const int stride = kv_sequence_length + 3;
+    const size_t q_elements = size_t(batch_size) * num_heads * q_sequence_length * head_size;
+    const size_t kv_elements = size_t(batch_size) * kv_num_heads * stride * head_size;
+    const size_t output_elements = size_t(batch_size) * q_sequence_length * num_heads * head_size;
+
+    std::vector<int> kv_sequence_lengths(batch_size);
+    std::vector<int> causal_offsets(batch_size);
+    for (int b = 0; b < batch_size; b++) {
+      kv_sequence_lengths[b] = variable_lengths ? std::max(1, kv_sequence_length - 3 * b) : kv_sequence_length;
+      causal_offsets[b] = variable_lengths ? std::max(0, kv_sequence_lengths[b] - q_sequence_length) : 0;
+    }
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = batch_size;
+    args.num_heads = num_heads;
+    args.q_sequence_length = q_sequence_length;
+    args.kv_sequence_length = kv_sequence_length;
+    args.qk_head_size = head_size;
+    args.v_head_size = head_size;
+    args.q_block_size = q_block_size;
+    args.kv_block_size = kv_block_size;
+    args.scale = 1.0f / std::sqrt(float(head_size));
+    args.thread_count = 4;
+    args.buffer_size_per_thread =
+        (size_t(q_block_size) * 2 + size_t(q_block_size) * kv_block_size + size_t(q_block_size) * head_size) * sizeof(float);
+    args.buffer = BufferWorkspace.GetBuffer(args.buffer_size_per_thread * args.thread_count / sizeof(float));
+    args.query = BufferQ.GetFilledBuffer(q_elements, SignedFill);
+    args.key = BufferK.GetFilledBuffer(kv_elements, SignedFill);
+    args.value = BufferV.GetFilledBuffer(kv_elements, SignedFill);
+    args.output = BufferOutput.GetBuffer(output_elements, true);
+    args.kv_num_heads = kv_num_heads;
+    args.kv_sequence_stride = stride;
+    args.is_causal = is_causal;
+    args.local_window_size = local_window_size;
+    args.softcap = softcap;
+    args.kv_sequence_lengths = variable_lengths ? kv_sequence_lengths.data() : nullptr;
+    args.causal_offsets = variable_lengths ? causal_offsets.data() : nullptr;
+
+    float* output_reference = BufferOutputReference.GetBuffer(output_elements, true);
+    ReferenceAttention(args, output_reference);
+
+    MlasFlashAttention(&args, threadpool_);
+
+    for (size_t i = 0; i < output_elements; i++) {
+      ASSERT_TRUE(CloseEnough(args.output[i], output_reference[i]))
+          << " @" << i << " batch:" << batch_size << " heads:" << num_heads << "/" << kv_num_heads
+          << " seq:" << q_sequence_length << "/" << kv_sequence_length << " blocks:" << q_block_size << "/"
+          << kv_block_size << " causal:" << is_causal << " window:" << local_window_size << " softcap:" << softcap
+          << ", got:" << args.output[i] << ", expecting:" << output_reference[i];
+    }
+  }
+
+ public:
+  MlasFlashAttentionTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("FlashAttention");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (int kv_num_heads : {4, 2, 1}) {
+      for (int q_sequence_length : {1, 7, 33}) {
+        for (int kv_sequence_length : {q_sequence_length, 40}) {
+          Test(2, 4, kv_num_heads, q_sequence_length, kv_sequence_length, 16, 8, 16, false, -1, 0.0f, false);
+          Test(2, 4, kv_num_heads, q_sequence_length, kv_sequence_length, 16, 8, 5, true, -1, 0.0f, false);
+          Test(2, 4, kv_num_heads, q_sequence_length, kv_sequence_length, 16, 4, 8, true, 5, 0.0f, true);
+          Test(2, 4, kv_num_heads, q_sequence_length, kv_sequence_length, 24, 16, 16, true, -1, 2.0f, true);
+          Test(1, 4, kv_num_heads, q_sequence_length, kv_sequence_length, 8, 3, 7, false, -1, 4.0f, true);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasFlashAttentionTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,128 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_fp8gemm.cpp
+
+Abstract:
+
+    Tests for MLAS matrix multiply with a float8 matrix B.
+
+--*/
+
+#include "test_util.h"
+#include "mlas.h"
+#include "core/framework/float8.h"
+
+using namespace onnxruntime;
+
+template <MLAS_FP8_TYPE BType, bool Threaded>
+class MlasFp8GemmTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  static float DecodeFp8(uint8_t bits) {
+    if constexpr (BType == MlasFp8E5M2) {
+      return Float8E5M2(bits, Float8E5M2::FromBits()).ToFloat();
+    } else {
+      return Float8E4M3FN(bits, Float8E4M3FN::FromBits()).ToFloat();
+    }
+  }
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, bool PerColumnScale) {
+    const float* A = BufferA.GetBuffer(K * M * BatchSize);
+    uint8_t* B = BufferB.GetBuffer(N * K * BatchSize);
+    float* Scale = BufferScale.GetBuffer(N * BatchSize);
+    float* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    // Use finite encodings, the largest exponents hold infinities and NaNs.
+    for (size_t i = 0; i < N * K * BatchSize; i++) {
+      B[i] = static_cast<uint8_t>(((i * 37 + i / 11) % 0x60) | ((i & 4) << 5));
+    }
+    for (size_t i = 0; i < N * BatchSize; i++) {
+      Scale[i] = 0.25f + float(i % 7) / 16.0f;
+    }
+
+    const size_t PackedBSize = MlasFp8GemmPackBSize(N, K);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize * BatchSize, true);
+
+    std::vector<MLAS_FP8_GEMM_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      MlasFp8GemmPackB(N, K, B + N * K * b, N, PackedB + PackedBSize * b);
+      Data[b].A = A + K * M * b;
+      Data[b].lda = K;
+      Data[b].PackedB = PackedB + PackedBSize * b;
+      Data[b].Scale = Scale + N * b;
+      Data[b].PerColumnScale = PerColumnScale;
+      Data[b].C = C + N * M * b;
+      Data[b].ldc = N;
+    }
+
+    std::fill_n(C, N * M * BatchSize, -0.5f);
+    MlasFp8GemmBatch(BType, M, N, K, Data.data(), BatchSize, threadpool_);
+
+    for (size_t b = 0; b < BatchSize; b++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            sum += double(A[K * M * b + K * m + k]) * double(DecodeFp8(B[N * K * b + N * k + n]));
+          }
+          const float scale = PerColumnScale ? Scale[N * b + n] : Scale[N * b];
+          CReference[N * M * b + N * m + n] = float(sum * scale);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < N * M * BatchSize; i++) {
+      ASSERT_LE(std::abs(C[i] - CReference[i]), 1e-4f * (1.0f + std::abs(CReference[i])))
+          << "@" << i << " of B=" << BatchSize << " M=" << M << " N=" << N << " K=" << K
+          << " PerColumnScale=" << PerColumnScale << ", got:" << C[i] << ", expecting:" << CReference[i];
+    }
+  }
+
+ public:
+  MlasFp8GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string(BType == MlasFp8E5M2 ? "Fp8Gemm_E5M2" : "Fp8Gemm_E4M3FN") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool PerColumnScale : {false, true}) {
+      for (size_t M : {1, 3, 4, 7, 70}) {
+        for (size_t N : {1, 15, 16, 33}) {
+          for (size_t K : {1, 5, 16, 300}) {
+            Test(1, M, N, K, PerColumnScale);
+          }
+        }
+      }
+      Test(3, 5, 40, 257, PerColumnScale);
+      Test(1, 2, 512, 1024, PerColumnScale);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFp8GemmTest<MlasFp8E4M3FN, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFp8GemmTest<MlasFp8E4M3FN, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFp8GemmTest<MlasFp8E5M2, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasFp8GemmTest<MlasFp8E5M2, true>>::RegisterShortExecute();
+  }
+  return count;
+});
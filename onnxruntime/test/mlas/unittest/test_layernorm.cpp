@@ -0,0 +1,99 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_layernorm.cpp
+
+Abstract:
+
+    Tests for MLAS LayerNorm, SkipLayerNorm and SimplifiedLayerNorm.
+
+--*/
+
+#include "test_util.h"
+#include "mlas.h"
+#include "core/framework/float16.h"
+#include "core/mlas/lib/layernorm.h"
+
+using namespace onnxruntime;
+
+template <typename T>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  static void SignedFill(float* start, size_t size) {
+    size_t offset = size % 23;
+    for (size_t i = 0; i < size; i++) {
+      offset = (offset + 21) % 23;
+      start[i] = (float(offset) - 11.0f) / 8.0f;
+    }
+  }
+
+  void Test(size_t n, bool with_skip, bool with_bias, bool with_shift, bool simplified) {
+    std::vector<float> input_fp32(n), skip(n), bias(n), scale(n), shift(n);
+    SignedFill(input_fp32.data(), n);
+    SignedFill(skip.data(), n);
+    std::reverse(skip.begin(), skip.end());
+    SignedFill(bias.data(), n);
+    std::rotate(bias.begin(), bias.begin() + n / 2, bias.end());
+    SignedFill(scale.data(), n);
+    SignedFill(shift.data(), n);
+    std::reverse(shift.begin(), shift.end());
+
+    std::vector<T> input(n), output_ref(n), output_impl(n), sum_ref(n), sum_impl(n);
+    for (size_t i = 0; i < n; i++) {
+      input[i] = static_cast<T>(input_fp32[i]);
+    }
+
+    const float* skip_data = with_skip ? skip.data() : nullptr;
+    const float* bias_data = with_bias ? bias.data() : nullptr;
+    const float* shift_data = with_shift ? shift.data() : nullptr;
+    float mean_ref = 0.0f, mean_impl = 0.0f, inv_std_dev_ref = 0.0f, inv_std_dev_impl = 0.0f;
+
+    MlasLayerNormOneRow_FallBack<T>(input.data(), skip_data, bias_data, scale.data(), shift_data, n, 1e-5f, simplified,
+                                    output_ref.data(), sum_ref.data(), &mean_ref, &inv_std_dev_ref);
+    MlasLayerNormOneRow<T>(input.data(), skip_data, bias_data, scale.data(), shift_data, n, 1e-5f, simplified,
+                           output_impl.data(), sum_impl.data(), &mean_impl, &inv_std_dev_impl);
+
+    ASSERT_TRUE(CloseEnough(mean_impl, mean_ref) || std::abs(mean_impl - mean_ref) < 1e-5f)
+        << "Expected mean: " << mean_ref << " Actual: " << mean_impl << ", n=" << n;
+    ASSERT_TRUE(CloseEnough(inv_std_dev_impl, inv_std_dev_ref))
+        << "Expected inv_std_dev: " << inv_std_dev_ref << " Actual: " << inv_std_dev_impl << ", n=" << n;
+
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_TRUE(CloseEnough(sum_impl[i], sum_ref[i]))
+          << "Expected sum: " << sum_ref[i] << " Actual: " << sum_impl[i] << "@[" << i << "], n=" << n;
+      ASSERT_TRUE(CloseEnough(output_impl[i], output_ref[i]) ||
+                  std::abs(static_cast<float>(output_impl[i]) - static_cast<float>(output_ref[i])) < 1e-3f)
+          << "Expected: " << output_ref[i] << " Actual: " << output_impl[i] << "@[" << i << "], n=" << n
+          << ", skip=" << with_skip << ", bias=" << with_bias << ", shift=" << with_shift
+          << ", simplified=" << simplified;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_same_v<T, float> ? "LayerNorm_fp32" : "LayerNorm_fp16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n : {1, 3, 4, 7, 8, 15, 16, 17, 33, 64, 100, 768}) {
+      for (int flags = 0; flags < 16; flags++) {
+        Test(n, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0, (flags & 8) != 0);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLFloat16>>::RegisterShortExecute();
+  }
+  return count;
+});
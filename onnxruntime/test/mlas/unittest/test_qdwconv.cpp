@@ -0,0 +1,94 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_qdwconv.cpp
+
+Abstract:
+
+    Tests for MLAS quantized integer depthwise convolution.
+
+--*/
+
+#include "test_util.h"
+
+template <typename InputType, typename FilterType>
+class MlasQDwConvTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<InputType> BufferInput;
+  MatrixGuardBuffer<FilterType> BufferFilter;
+  MatrixGuardBuffer<int32_t> BufferOutput;
+  std::vector<const InputType*> Indirection;
+
+  void Test(size_t Channels, size_t OutputCount, size_t KernelSize) {
+    const size_t InputCount = OutputCount * KernelSize;
+    InputType* Input = BufferInput.GetBuffer(InputCount * Channels);
+    FilterType* Filter = BufferFilter.GetBuffer(KernelSize * Channels);
+    int32_t* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+
+    for (size_t i = 0; i < InputCount * Channels; i++) {
+      Input[i] = static_cast<InputType>((i * 37 + 11) % 256);
+    }
+    for (size_t i = 0; i < KernelSize * Channels; i++) {
+      Filter[i] = static_cast<FilterType>((i * 53 + 7) % 256);
+    }
+
+    // Reference the input vectors out of order, as an indirection buffer of a convolution would.
+    Indirection.resize(InputCount);
+    for (size_t i = 0; i < InputCount; i++) {
+      Indirection[i] = Input + ((i * 7) % InputCount) * Channels;
+    }
+
+    const InputType InputZeroPoint = static_cast<InputType>(std::is_signed<InputType>::value ? -3 : 131);
+    const FilterType FilterZeroPoint = static_cast<FilterType>(std::is_signed<FilterType>::value ? 5 : 121);
+
+    MlasConvDepthwise(reinterpret_cast<const void* const*>(Indirection.data()), InputZeroPoint,
+                      std::is_signed<InputType>::value, Filter, FilterZeroPoint, std::is_signed<FilterType>::value,
+                      Output, Channels, OutputCount, KernelSize);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t c = 0; c < Channels; c++) {
+        int32_t Reference = 0;
+        for (size_t k = 0; k < KernelSize; k++) {
+          Reference += (int32_t(Indirection[o * KernelSize + k][c]) - int32_t(InputZeroPoint)) *
+                       (int32_t(Filter[k * Channels + c]) - int32_t(FilterZeroPoint));
+        }
+        ASSERT_EQ(Output[o * Channels + c], Reference)
+            << "@[" << o << "," << c << "] of Channels=" << Channels << " OutputCount=" << OutputCount
+            << " KernelSize=" << KernelSize;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("QDwConv") +
+                                          (std::is_signed<InputType>::value ? "S8" : "U8") +
+                                          (std::is_signed<FilterType>::value ? "S8" : "U8");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Channels : {1, 7, 8, 16, 31, 32, 33, 64, 100}) {
+      for (size_t KernelSize : {1, 2, 3, 9, 25}) {
+        Test(Channels, 1, KernelSize);
+        Test(Channels, 5, KernelSize);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQDwConvTest<uint8_t, int8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQDwConvTest<uint8_t, uint8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQDwConvTest<int8_t, int8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQDwConvTest<int8_t, uint8_t>>::RegisterShortExecute();
+  }
+  return count;
+});
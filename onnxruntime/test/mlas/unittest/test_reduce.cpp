@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_reduce.cpp
+
+Abstract:
+
+    Tests for MLAS reductions of the middle axis of a tensor.
+
+--*/
+
+#include "test_util.h"
+#include "mlas.h"
+#include "core/framework/float16.h"
+
+using namespace onnxruntime;
+
+template <typename T, bool Threaded>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  static void ReferenceReduce(MLAS_REDUCE_KIND kind, const float* input, float* output,
+                              size_t outer_count, size_t reduce_count, size_t inner_count) {
+    for (size_t o = 0; o < outer_count; o++) {
+      for (size_t i = 0; i < inner_count; i++) {
+        const float* x = input + o * reduce_count * inner_count + i;
+        double result = x[0];
+        if (kind == MlasReduceLogSumExp) {
+          for (size_t r = 1; r < reduce_count; r++) {
+            result = std::max(result, double(x[r * inner_count]));
+          }
+          double sum = 0.0;
+          for (size_t r = 0; r < reduce_count; r++) {
+            sum += std::exp(double(x[r * inner_count]) - result);
+          }
+          result = std::log(sum) + result;
+        } else {
+          for (size_t r = 1; r < reduce_count; r++) {
+            double value = x[r * inner_count];
+            if (kind == MlasReduceMax) {
+              result = std::max(result, value);
+            } else if (kind == MlasReduceMin) {
+              result = std::min(result, value);
+            } else {
+              result += value;
+            }
+          }
+          if (kind == MlasReduceMean) {
+            result /= double(reduce_count);
+          }
+        }
+        output[o * inner_count + i] = float(result);
+      }
+    }
+  }
+
+  void Test(MLAS_REDUCE_KIND kind, size_t outer_count, size_t reduce_count, size_t inner_count) {
+    const size_t input_size = outer_count * reduce_count * inner_count;
+    const size_t output_size = outer_count * inner_count;
+
+    std::vector<T> input(input_size);
+    std::vector<float> input_fp32(input_size);
+    for (size_t i = 0; i < input_size; i++) {
+      input[i] = T(float((i * 7 + i / 13) % 29) / 8.0f - 1.75f);
+      input_fp32[i] = float(input[i]);
+    }
+
+    std::vector<T> output(output_size);
+    std::vector<float> output_ref(output_size);
+
+    MlasReduce(kind, input.data(), output.data(), outer_count, reduce_count, inner_count, threadpool_);
+    ReferenceReduce(kind, input_fp32.data(), output_ref.data(), outer_count, reduce_count, inner_count);
+
+    for (size_t i = 0; i < output_size; i++) {
+      float tolerance = std::is_same_v<T, float> ? 1e-5f : 2e-3f;
+      ASSERT_LE(std::abs(float(output[i]) - output_ref[i]), tolerance * (1.0f + std::abs(output_ref[i])))
+          << "kind=" << int(kind) << " @" << i << " of [" << outer_count << "," << reduce_count << ","
+          << inner_count << "], got:" << float(output[i]) << ", expecting:" << output_ref[i];
+    }
+  }
+
+ public:
+  MlasReduceTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string(std::is_same_v<T, float> ? "Reduce_fp32" : "Reduce_fp16") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_REDUCE_KIND kind : {MlasReduceSum, MlasReduceMean, MlasReduceMax, MlasReduceMin, MlasReduceLogSumExp}) {
+      for (size_t outer : {1, 3}) {
+        for (size_t reduce : {1, 2, 15, 16, 33, 300, 4097}) {
+          for (size_t inner : {1, 3, 4, 17, 300}) {
+            if (reduce * inner <= 100000) {
+              Test(kind, outer, reduce, inner);
+            }
+          }
+        }
+      }
+      // A large reduced axis with a small output is split among the threads.
+      Test(kind, 1, 100000, 1);
+      Test(kind, 2, 50000, 3);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<float, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MLFloat16, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MLFloat16, true>>::RegisterShortExecute();
+  }
+  return count;
+});
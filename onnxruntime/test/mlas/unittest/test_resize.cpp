@@ -0,0 +1,121 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_resize.cpp
+
+Abstract:
+
+    Tests for MLAS separable image resize.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasResizeSeparableTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  // Builds the taps of each output index: consecutive input indices around the scaled position,
+  // clamped to the input, with arbitrary weights.
+  static void SetupAxis(size_t InputSize, size_t OutputSize, size_t Taps,
+                        std::vector<int32_t>& Indices, std::vector<float>& Weights) {
+    Indices.resize(OutputSize * Taps);
+    Weights.resize(OutputSize * Taps);
+    for (size_t o = 0; o < OutputSize; o++) {
+      const int64_t first = int64_t(o * InputSize / OutputSize) - int64_t(Taps / 2) + 1;
+      for (size_t t = 0; t < Taps; t++) {
+        const int64_t index = std::min(std::max(first + int64_t(t), int64_t(0)), int64_t(InputSize) - 1);
+        Indices[o * Taps + t] = int32_t(index);
+        Weights[o * Taps + t] = float(int64_t((o * 7 + t * 3) % 11) - 3) / 8.0f;
+      }
+    }
+  }
+
+  void Test(size_t ImageCount, size_t InputHeight, size_t InputWidth, size_t Channels,
+            size_t OutputHeight, size_t OutputWidth, size_t RowTaps, size_t ColumnTaps) {
+    const float* Input = BufferInput.GetFilledBuffer(ImageCount * InputHeight * InputWidth * Channels,
+                                                     [](float* start, size_t size) {
+                                                       for (size_t i = 0; i < size; i++) {
+                                                         start[i] = float(int64_t(i % 23) - 11) / 4.0f;
+                                                       }
+                                                     });
+    const size_t OutputElements = ImageCount * OutputHeight * OutputWidth * Channels;
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    std::vector<int32_t> RowIndices, ColumnIndices;
+    std::vector<float> RowWeights, ColumnWeights;
+    SetupAxis(InputHeight, OutputHeight, RowTaps, RowIndices, RowWeights);
+    SetupAxis(InputWidth, OutputWidth, ColumnTaps, ColumnIndices, ColumnWeights);
+
+    MlasResizeSeparable(Input, ImageCount, InputHeight, InputWidth, Channels, Output, OutputHeight, OutputWidth,
+                        RowTaps, RowIndices.data(), RowWeights.data(),
+                        ColumnTaps, ColumnIndices.data(), ColumnWeights.data(), threadpool_);
+
+    for (size_t n = 0; n < ImageCount; n++) {
+      for (size_t y = 0; y < OutputHeight; y++) {
+        for (size_t x = 0; x < OutputWidth; x++) {
+          for (size_t c = 0; c < Channels; c++) {
+            double sum = 0.0;
+            for (size_t i = 0; i < RowTaps; i++) {
+              for (size_t j = 0; j < ColumnTaps; j++) {
+                const size_t row = size_t(RowIndices[y * RowTaps + i]);
+                const size_t column = size_t(ColumnIndices[x * ColumnTaps + j]);
+                sum += double(RowWeights[y * RowTaps + i]) * double(ColumnWeights[x * ColumnTaps + j]) *
+                       double(Input[((n * InputHeight + row) * InputWidth + column) * Channels + c]);
+              }
+            }
+            OutputReference[((n * OutputHeight + y) * OutputWidth + x) * Channels + c] = float(sum);
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_LE(std::abs(Output[i] - OutputReference[i]), 1e-4f * (1.0f + std::abs(OutputReference[i])))
+          << "@" << i << " of N=" << ImageCount << " H=" << InputHeight << " W=" << InputWidth
+          << " C=" << Channels << " OH=" << OutputHeight << " OW=" << OutputWidth << " taps=" << RowTaps << "x"
+          << ColumnTaps << ", got:" << Output[i] << ", expecting:" << OutputReference[i];
+    }
+  }
+
+ public:
+  MlasResizeSeparableTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "ResizeSeparable_Threaded" : "ResizeSeparable_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Taps : {2, 3, 4}) {
+      for (size_t Channels : {1, 3, 4, 9}) {
+        for (size_t InputSize : {1, 2, 5, 17}) {
+          for (size_t OutputSize : {1, 4, 11, 40}) {
+            Test(2, InputSize, InputSize + 3, Channels, OutputSize, OutputSize + 5, Taps, Taps);
+          }
+        }
+      }
+      Test(1, 64, 64, 1, 256, 256, Taps, Taps);
+      Test(3, 100, 30, 3, 37, 80, Taps, 2);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasResizeSeparableTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasResizeSeparableTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
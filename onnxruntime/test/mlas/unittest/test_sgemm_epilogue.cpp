@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  // Fill with small positive and negative values so that the activation is exercised.
+  static void SignedFill(float* start, size_t size) {
+    size_t offset = size % 23;
+    for (size_t i = 0; i < size; i++) {
+      offset = (offset + 21) % 23;
+      start[i] = (float(offset) - 11.0f) / 16.0f;
+    }
+  }
+
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M, size_t N, size_t K, bool WithBias, bool WithResidual, float Scale) {
+    const float* A = BufferA.GetFilledBuffer(M * K, SignedFill);
+    const float* B = BufferB.GetFilledBuffer(K * N, SignedFill);
+    const float* Bias = BufferBias.GetFilledBuffer(N, SignedFill);
+    const float* Residual = BufferResidual.GetFilledBuffer(M * N, SignedFill);
+    float* C = BufferC.GetBuffer(M * N, true);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasLeakyReluActivation;
+    Activation.Parameters.LeakyRelu.alpha = 0.25f;
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * B[k * N + n];
+        }
+        if (WithBias) {
+          sum += Bias[n];
+        }
+        if (sum < 0.0f) {
+          sum *= Activation.Parameters.LeakyRelu.alpha;
+        }
+        sum *= Scale;
+        if (WithResidual) {
+          sum += Residual[m * N + n];
+        }
+        CReference[m * N + n] = sum;
+      }
+    }
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    Epilogue.Bias = WithBias ? Bias : nullptr;
+    Epilogue.Activation = &Activation;
+    Epilogue.Scale = Scale;
+    Epilogue.Residual = WithResidual ? Residual : nullptr;
+    Epilogue.ldr = N;
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.B = B;
+    Data.ldb = N;
+    Data.C = C;
+    Data.ldc = N;
+    Data.Epilogue = &Epilogue;
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, &Data, 1, threadpool_);
+
+    for (size_t f = 0; f < M * N; f++) {
+      ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+          << " @[" << f / N << "," << f % N << "], total:[" << M << "," << N << "," << K << "], got:"
+          << C[f] << ", expecting:" << CReference[f];
+    }
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmEpilogue");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 3, 16, 31, 33, 130};
+    for (size_t m : sizes) {
+      for (size_t n : sizes) {
+        for (size_t k : {size_t(7), size_t(64), size_t(300)}) {
+          Test(m, n, k, true, false, 1.0f);
+          Test(m, n, k, false, true, 0.5f);
+          Test(m, n, k, true, true, -2.0f);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSgemmEpilogueTest>::RegisterShortExecute() : 0;
+});
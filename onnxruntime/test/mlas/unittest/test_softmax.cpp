@@ -308,11 +308,100 @@ class MlasSoftmaxTest : public MlasTestBase {
   }
 };
 
+template <typename T>
+class MlasAttentionSoftmaxTest : public MlasTestBase {
+ private:
+  void Test(size_t N, size_t D, float Scale, float Softcap, bool WithBias, bool WithMask, bool Causal,
+            size_t CausalOffset) {
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+    std::vector<T> Input(N * D), Bias(N * D), Mask(N * D), Output(N * D);
+    std::vector<float> OutputReference(N * D);
+
+    for (size_t i = 0; i < N * D; i++) {
+      Input[i] = T(distribution(generator));
+      Bias[i] = T(distribution(generator));
+      Mask[i] = T((i % 5) == 0 ? -10000.0f : 0.0f);
+    }
+
+    for (size_t n = 0; n < N; n++) {
+      const size_t CountD = Causal ? std::min(D, n + CausalOffset + 1) : D;
+      std::vector<double> Scores(CountD);
+      double Maximum = -std::numeric_limits<double>::infinity();
+      for (size_t d = 0; d < CountD; d++) {
+        double x = double(float(Input[n * D + d])) * Scale;
+        if (Softcap > 0.0f) {
+          x = Softcap * std::tanh(x / Softcap);
+        }
+        if (WithBias) {
+          x += float(Bias[n * D + d]);
+        }
+        if (WithMask) {
+          x += float(Mask[n * D + d]);
+        }
+        Scores[d] = x;
+        Maximum = std::max(Maximum, x);
+      }
+      double Sum = 0.0;
+      for (size_t d = 0; d < CountD; d++) {
+        Scores[d] = std::exp(Scores[d] - Maximum);
+        Sum += Scores[d];
+      }
+      for (size_t d = 0; d < D; d++) {
+        OutputReference[n * D + d] = d < CountD ? float(Scores[d] / Sum) : 0.0f;
+      }
+    }
+
+    MLAS_ATTENTION_SOFTMAX_PARAMS<T> Parameters;
+    Parameters.Scale = Scale;
+    Parameters.Softcap = Softcap;
+    Parameters.Bias = WithBias ? Bias.data() : nullptr;
+    Parameters.Mask = WithMask ? Mask.data() : nullptr;
+    Parameters.Causal = Causal;
+    Parameters.CausalOffset = CausalOffset;
+
+    // The softmax is computed in place, as in the attention operators.
+    Output = Input;
+    MlasComputeAttentionSoftmax(Output.data(), Output.data(), N, D, Parameters, GetMlasThreadPool());
+
+    const float Tolerance = std::is_same_v<T, float> ? 1e-6f : 1e-3f;
+
+    for (size_t i = 0; i < N * D; i++) {
+      ASSERT_LE(std::fabs(float(Output[i]) - OutputReference[i]), Tolerance)
+          << " @" << i << " of " << N << "x" << D << ", scale=" << Scale << ", softcap=" << Softcap
+          << ", bias=" << WithBias << ", mask=" << WithMask << ", causal=" << Causal << "/" << CausalOffset
+          << ", got: " << float(Output[i]) << ", expecting: " << OutputReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_same_v<T, float> ? "AttentionSoftmax_fp32" : "AttentionSoftmax_fp16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t D : {1, 3, 16, 67, 256}) {
+      for (int flags = 0; flags < 16; flags++) {
+        const float Softcap = (flags & 1) ? 5.0f : 0.0f;
+        const bool WithBias = (flags & 2) != 0;
+        const bool WithMask = (flags & 4) != 0;
+        const bool Causal = (flags & 8) != 0;
+        Test(13, D, 0.125f, Softcap, WithBias, WithMask, Causal, 0);
+        Test(7, D, 1.0f, Softcap, WithBias, WithMask, Causal, D > 7 ? D - 7 : 0);
+      }
+    }
+  }
+};
+
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
     count += MlasDirectShortExecuteTests<MlasSoftmaxTest<false>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasComputeExpTest>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasAttentionSoftmaxTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasAttentionSoftmaxTest<MLAS_FP16>>::RegisterShortExecute();
     if (GetMlasThreadPool() != nullptr) {
       count += MlasDirectShortExecuteTests<MlasSoftmaxTest<true>>::RegisterShortExecute();
     }
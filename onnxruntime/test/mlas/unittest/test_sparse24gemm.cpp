@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sparse24gemm.cpp
+
+Abstract:
+
+    Tests for MLAS matrix multiply with a 2:4 structured sparse matrix B.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparse24GemmTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K, bool TransB, float alpha) {
+    const float* A = BufferA.GetBuffer(K * M * BatchSize);
+    float* B = BufferB.GetBuffer(N * K * BatchSize);
+    float* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(N * M * BatchSize);
+
+    // Keep 0, 1 or 2 values of each group of 4 rows, at varying positions.
+    const size_t ldb = TransB ? K : N;
+    for (size_t b = 0; b < BatchSize; b++) {
+      for (size_t k = 0; k < K; k++) {
+        for (size_t n = 0; n < N; n++) {
+          const size_t group = (k / 4) * 7 + n * 3 + b;
+          const size_t kept0 = group % 4;
+          const size_t kept1 = (group % 5 == 0) ? kept0 : (kept0 + 1 + group % 3) % 4;
+          const bool kept = (group % 11 != 0) && (k % 4 == kept0 || k % 4 == kept1);
+          const float value = kept ? float((k * 5 + n * 3) % 13) / 4.0f - 1.5f : 0.0f;
+          B[N * K * b + (TransB ? n * ldb + k : k * ldb + n)] = value;
+        }
+      }
+    }
+
+    ASSERT_TRUE(MlasSparse24GemmCheckB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb));
+
+    const size_t PackedBSize = MlasSparse24GemmPackBSize(N, K);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize * BatchSize, true);
+
+    std::vector<MLAS_SPARSE24_GEMM_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      MlasSparse24GemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B + N * K * b, ldb,
+                            PackedB + PackedBSize * b);
+      Data[b].A = A + K * M * b;
+      Data[b].lda = K;
+      Data[b].PackedB = PackedB + PackedBSize * b;
+      Data[b].C = C + N * M * b;
+      Data[b].ldc = N;
+      Data[b].alpha = alpha;
+    }
+
+    std::fill_n(C, N * M * BatchSize, -0.5f);
+    MlasSparse24GemmBatch(M, N, K, Data.data(), BatchSize, threadpool_);
+
+    for (size_t b = 0; b < BatchSize; b++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            const float value = B[N * K * b + (TransB ? n * ldb + k : k * ldb + n)];
+            sum += double(A[K * M * b + K * m + k]) * double(value);
+          }
+          CReference[N * M * b + N * m + n] = float(sum * alpha);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < N * M * BatchSize; i++) {
+      ASSERT_LE(std::abs(C[i] - CReference[i]), 1e-4f * (1.0f + std::abs(CReference[i])))
+          << "@" << i << " of B=" << BatchSize << " M=" << M << " N=" << N << " K=" << K
+          << " TransB=" << TransB << ", got:" << C[i] << ", expecting:" << CReference[i];
+    }
+  }
+
+ public:
+  MlasSparse24GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Sparse24Gemm_Threaded" : "Sparse24Gemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool TransB : {false, true}) {
+      for (size_t M : {1, 3, 5, 8, 19}) {
+        for (size_t N : {1, 4, 7, 130}) {
+          for (size_t K : {1, 4, 6, 259}) {
+            Test(1, M, N, K, TransB, 1.0f);
+          }
+        }
+      }
+      Test(3, 9, 40, 600, TransB, 0.5f);
+    }
+
+    // A dense matrix does not have 2:4 sparsity.
+    std::vector<float> Dense{1.0f, 2.0f, 3.0f, 0.0f, 5.0f, 6.0f, 0.0f, 0.0f};
+    ASSERT_FALSE(MlasSparse24GemmCheckB(CblasTrans, 2, 4, Dense.data(), 4));
+    ASSERT_TRUE(MlasSparse24GemmCheckB(CblasTrans, 1, 4, Dense.data() + 4, 4));
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparse24GemmTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSparse24GemmTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,116 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sparsecsrgemm.cpp
+
+Abstract:
+
+    Tests for MLAS matrix multiply with a sparse matrix A in the blocked CSR
+    format.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseCsrGemmTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedA;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  void Test(size_t M, size_t N, size_t K, size_t BlockM, bool TransA, float alpha) {
+    float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    // Keep about one value in seven, with some empty rows.
+    const size_t lda = TransA ? M : K;
+    size_t NonZeroCount = 0;
+    for (size_t m = 0; m < M; m++) {
+      for (size_t k = 0; k < K; k++) {
+        const bool kept = (m % 5 != 3) && ((m * 3 + k * 5) % 7 == 0);
+        const float value = kept ? float((m * 5 + k * 3) % 13) / 4.0f - 1.5f : 0.0f;
+        A[TransA ? k * lda + m : m * lda + k] = value;
+        NonZeroCount += (value != 0.0f) ? 1 : 0;
+      }
+    }
+
+    const CBLAS_TRANSPOSE Trans = TransA ? CblasTrans : CblasNoTrans;
+    const size_t BlockCount = MlasSparseCsrGemmCountBlocks(Trans, M, K, BlockM, A, lda);
+    if (BlockM == 1) {
+      ASSERT_EQ(BlockCount, NonZeroCount);
+    }
+
+    uint8_t* PackedA = BufferPackedA.GetBuffer(MlasSparseCsrGemmPackASize(M, BlockM, BlockCount), true);
+    MlasSparseCsrGemmPackA(Trans, M, K, BlockM, A, lda, PackedA);
+
+    MLAS_SPARSE_CSR_GEMM_DATA_PARAMS Data;
+    MlasSparseCsrGemmSetPackedA(M, BlockM, BlockCount, PackedA, &Data);
+    Data.B = B;
+    Data.ldb = N;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+
+    std::fill_n(C, N * M, -0.5f);
+    MlasSparseCsrGemm(M, N, BlockM, &Data, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          sum += double(A[TransA ? k * lda + m : m * lda + k]) * double(B[k * N + n]);
+        }
+        CReference[N * m + n] = float(sum * alpha);
+      }
+    }
+
+    for (size_t i = 0; i < N * M; i++) {
+      ASSERT_LE(std::abs(C[i] - CReference[i]), 1e-4f * (1.0f + std::abs(CReference[i])))
+          << "@" << i << " of M=" << M << " N=" << N << " K=" << K << " BlockM=" << BlockM
+          << " TransA=" << TransA << ", got:" << C[i] << ", expecting:" << CReference[i];
+    }
+  }
+
+ public:
+  MlasSparseCsrGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseCsrGemm_Threaded" : "SparseCsrGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BlockM : {1, 2, 4}) {
+      for (bool TransA : {false, true}) {
+        for (size_t M : {1, 3, 5, 8, 19}) {
+          for (size_t N : {1, 3, 4, 9, 17, 300}) {
+            for (size_t K : {1, 7, 64}) {
+              Test(M, N, K, BlockM, TransA, 1.0f);
+            }
+          }
+        }
+      }
+      Test(157, 530, 211, BlockM, false, 0.5f);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseCsrGemmTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSparseCsrGemmTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
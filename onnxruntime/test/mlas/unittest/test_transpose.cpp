@@ -22,6 +22,34 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  //
+  // Transposes a tile of a larger matrix and checks that the elements outside
+  // the tile are not modified.
+  //
+  void
+  TestStrided(size_t M, size_t N) {
+    const size_t InputStride = N + 5;
+    const size_t OutputStride = M + 3;
+
+    ElementType* Input = BufferInput.GetBuffer(M * InputStride);
+    ElementType* Output = BufferOutput.GetBuffer(N * OutputStride);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(N * OutputStride);
+
+    std::fill_n(Output, N * OutputStride, ElementType(0x5A));
+    std::fill_n(OutputReference, N * OutputStride, ElementType(0x5A));
+
+    MlasTranspose(Input, InputStride, Output, OutputStride, M, N);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        OutputReference[n * OutputStride + m] = Input[m * InputStride + n];
+      }
+    }
+
+    ASSERT_EQ(memcmp(Output, OutputReference, N * OutputStride * sizeof(ElementType)), 0)
+        << " strided [" << M << "," << N << "]";
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
@@ -40,6 +68,7 @@ class MlasTransposeTest : public MlasTestBase {
     for (size_t m = 1; m <= 32; m++) {
       for (size_t n = 1; n <= 32; n++) {
         Test(m, n);
+        TestStrided(m, n);
       }
     }
   }
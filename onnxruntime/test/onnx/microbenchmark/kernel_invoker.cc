@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks the kernel of a single op, run by the eager kernel invoker, so the kernel can be studied over many
+// shapes without an ONNX model per shape. The kernels are given with
+//   --kernel=<JSON object>      e.g. --kernel='{"op": "MatMul", "inputs": [{"shape": [256, 512]}, {"shape": [512, 64]}],
+//                                               "threads": [1, 4], "flops": 16777216}'
+//   --kernel_sweep=<JSON file>  a JSON array of such objects
+// Each object holds
+//   "op", and optionally "domain" and "version": the op to run.
+//   "attributes": the attributes of the node, e.g. {"transB": 1, "alpha": 0.5, "axes": [0, 1], "mode": "linear"}.
+//   "inputs": an object per input with its "shape", its "type" (float, double, float16, int8, uint8, int32, int64 or
+//             bool, float by default) and optionally its "values", which are random otherwise.
+//   "outputs": the number of outputs, 1 by default.
+//   "ep": the execution provider, only "cpu" is supported.
+//   "threads": the sizes of the intra-op thread pool to run the kernel with, [1] by default.
+//   "cold_cache": whether to also run the kernel with the caches flushed before each run.
+//   "flops": the floating point operations of a run, to report the FLOP/s.
+// Only the Compute call of the kernel is timed. The bytes of the inputs and outputs of a run are reported as bytes/s.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#include "core/eager/ort_kernel_invoker.h"
+#include "core/framework/data_types_internal.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/session/ort_env.h"
+#include "core/util/thread_utils.h"
+#include "nlohmann/json.hpp"
+
+using namespace onnxruntime;
+extern OrtEnv* env;
+
+namespace {
+
+struct KernelBenchmark {
+  std::string op;
+  std::string domain;
+  int version{-1};
+  NodeAttributes attributes;
+  std::vector<OrtValue> inputs;
+  size_t num_outputs{1};
+  double flops{0};
+  size_t input_bytes{0};
+};
+
+ONNX_NAMESPACE::AttributeProto MakeAttributeFromJson(const std::string& name, const nlohmann::json& value) {
+  if (value.is_boolean() || value.is_number_integer()) {
+    return utils::MakeAttribute(name, value.get<int64_t>());
+  }
+  if (value.is_number_float()) {
+    return utils::MakeAttribute(name, value.get<float>());
+  }
+  if (value.is_string()) {
+    return utils::MakeAttribute(name, value.get<std::string>());
+  }
+  if (value.is_array() && !value.empty()) {
+    if (std::all_of(value.begin(), value.end(), [](const nlohmann::json& v) { return v.is_number_integer(); })) {
+      const auto values = value.get<std::vector<int64_t>>();
+      return utils::MakeAttribute(name, gsl::span<const int64_t>(values));
+    }
+    if (std::all_of(value.begin(), value.end(), [](const nlohmann::json& v) { return v.is_number(); })) {
+      const auto values = value.get<std::vector<float>>();
+      return utils::MakeAttribute(name, gsl::span<const float>(values));
+    }
+    if (std::all_of(value.begin(), value.end(), [](const nlohmann::json& v) { return v.is_string(); })) {
+      const auto values = value.get<std::vector<std::string>>();
+      return utils::MakeAttribute(name, gsl::span<const std::string>(values));
+    }
+  }
+  ORT_THROW("Unsupported value of the attribute ", name, ": ", value.dump());
+}
+
+int32_t ParseElementType(const std::string& type) {
+  static const std::unordered_map<std::string, int32_t> element_types{
+      {"float", ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"double", ONNX_NAMESPACE::TensorProto_DataType_DOUBLE},
+      {"float16", ONNX_NAMESPACE::TensorProto_DataType_FLOAT16},
+      {"int8", ONNX_NAMESPACE::TensorProto_DataType_INT8},
+      {"uint8", ONNX_NAMESPACE::TensorProto_DataType_UINT8},
+      {"int32", ONNX_NAMESPACE::TensorProto_DataType_INT32},
+      {"int64", ONNX_NAMESPACE::TensorProto_DataType_INT64},
+      {"bool", ONNX_NAMESPACE::TensorProto_DataType_BOOL},
+  };
+  auto it = element_types.find(type);
+  ORT_ENFORCE(it != element_types.end(), "Unsupported input type: ", type);
+  return it->second;
+}
+
+template <typename T>
+struct FillTensor {
+  void operator()(Tensor& tensor, const nlohmann::json* values, std::mt19937& generator) const {
+    auto data = tensor.MutableDataAsSpan<T>();
+    if (values) {
+      ORT_ENFORCE(values->size() == data.size(), "The input has ", data.size(), " elements but ", values->size(),
+                  " values.");
+      for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<T>(values->at(i).get<float>());
+      }
+    } else if constexpr (std::is_integral_v<T>) {
+      std::uniform_int_distribution<int> distribution(0, std::is_same_v<T, bool> ? 1 : 9);
+      for (auto& element : data) {
+        element = static_cast<T>(distribution(generator));
+      }
+    } else {
+      std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+      for (auto& element : data) {
+        element = static_cast<T>(distribution(generator));
+      }
+    }
+  }
+};
+
+OrtValue MakeInput(const nlohmann::json& input, const AllocatorPtr& allocator, std::mt19937& generator) {
+  const TensorShape shape(input.at("shape").get<std::vector<int64_t>>());
+  const int32_t element_type = ParseElementType(input.value("type", "float"));
+
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::TensorTypeFromONNXEnum(element_type)->GetElementType(), shape, allocator, value);
+  const auto values = input.find("values");
+  utils::MLTypeCallDispatcher<float, double, MLFloat16, int8_t, uint8_t, int32_t, int64_t, bool> dispatcher(
+      element_type);
+  dispatcher.Invoke<FillTensor>(*value.GetMutable<Tensor>(), values != input.end() ? &*values : nullptr, generator);
+  return value;
+}
+
+// Flushes the caches by writing a buffer larger than the last level cache.
+void FlushCaches() {
+  static std::vector<char> buffer(64 * 1024 * 1024);
+  for (size_t i = 0; i < buffer.size(); i += 64) {
+    buffer[i] = static_cast<char>(buffer[i] + 1);
+  }
+  benchmark::ClobberMemory();
+}
+
+void RunKernelBenchmark(benchmark::State& state, std::shared_ptr<const KernelBenchmark> spec,
+                        std::shared_ptr<IExecutionProvider> execution_provider, int threads, bool cold_cache) {
+  auto logger = env->GetLoggingManager()->CreateLogger("kernel_benchmark");
+  IOnnxRuntimeOpSchemaRegistryList custom_op_registries;
+  ORTInvoker invoker(execution_provider, *logger, custom_op_registries);
+  std::unique_ptr<ORTInvokerKernel> kernel;
+  ORT_THROW_IF_ERROR(invoker.CreateKernel(spec->op, spec->inputs, spec->num_outputs, &spec->attributes, kernel,
+                                          spec->domain, spec->version));
+
+  OrtThreadPoolParams thread_pool_params;
+  thread_pool_params.thread_pool_size = threads;
+  thread_pool_params.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool;
+  if (threads > 1) {
+    thread_pool = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                                concurrency::ThreadPoolType::INTRA_OP);
+  }
+
+  size_t output_bytes = 0;
+  for (auto _ : state) {
+    if (cold_cache) {
+      FlushCaches();
+    }
+
+    std::vector<OrtValue> outputs(spec->num_outputs);
+    std::chrono::nanoseconds compute_duration;
+    ORT_THROW_IF_ERROR(kernel->Run(outputs, thread_pool.get(), &compute_duration));
+    state.SetIterationTime(std::chrono::duration<double>(compute_duration).count());
+
+    output_bytes = 0;
+    for (const auto& output : outputs) {
+      output_bytes += output.IsTensor() ? output.Get<Tensor>().SizeInBytes() : 0;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (spec->input_bytes + output_bytes)));
+  if (spec->flops > 0) {
+    state.counters["FLOP/s"] = benchmark::Counter(spec->flops, benchmark::Counter::kIsIterationInvariantRate);
+  }
+}
+
+void RegisterKernelBenchmark(const nlohmann::json& config, const AllocatorPtr& allocator, std::mt19937& generator) {
+  ORT_ENFORCE(config.value("ep", "cpu") == "cpu", "Only the cpu execution provider is supported.");
+
+  auto spec = std::make_shared<KernelBenchmark>();
+  spec->op = config.at("op").get<std::string>();
+  spec->domain = config.value("domain", kOnnxDomain);
+  spec->version = config.value("version", -1);
+  spec->num_outputs = config.value("outputs", size_t{1});
+  spec->flops = config.value("flops", 0.0);
+  for (const auto& [name, value] : config.value("attributes", nlohmann::json::object()).items()) {
+    utils::SetNodeAttribute(MakeAttributeFromJson(name, value), spec->attributes);
+  }
+
+  std::string shapes;
+  for (const auto& input : config.at("inputs")) {
+    spec->inputs.push_back(MakeInput(input, allocator, generator));
+    const Tensor& tensor = spec->inputs.back().Get<Tensor>();
+    spec->input_bytes += tensor.SizeInBytes();
+    shapes += (shapes.empty() ? "" : ",") + tensor.Shape().ToString();
+  }
+
+  std::shared_ptr<IExecutionProvider> execution_provider =
+      std::make_shared<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  const auto thread_counts = config.value("threads", std::vector<int>{1});
+  const bool cold_cache = config.value("cold_cache", false);
+  for (int threads : thread_counts) {
+    for (bool cold : {false, true}) {
+      if (cold && !cold_cache) {
+        continue;
+      }
+
+      const std::string name = "BM_Kernel/" + spec->op + "/" + shapes + "/threads:" + std::to_string(threads) +
+                               (cold ? "/cold" : "/warm");
+      benchmark::RegisterBenchmark(name.c_str(), RunKernelBenchmark, spec, execution_provider, threads, cold)
+          ->UseManualTime()
+          ->Unit(benchmark::TimeUnit::kMicrosecond);
+    }
+  }
+}
+
+}  // namespace
+
+// Registers the kernel benchmarks given with --kernel and --kernel_sweep and removes these arguments.
+bool RegisterKernelBenchmarks(int& argc, char** argv) {
+  const std::string kernel_flag = "--kernel=";
+  const std::string sweep_flag = "--kernel_sweep=";
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  std::mt19937 generator(0);
+
+  int remaining = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    nlohmann::json configs;
+    if (arg.rfind(kernel_flag, 0) == 0) {
+      configs = nlohmann::json::parse(arg.substr(kernel_flag.size()), nullptr, /*allow_exceptions*/ false);
+    } else if (arg.rfind(sweep_flag, 0) == 0) {
+      std::ifstream sweep_file(arg.substr(sweep_flag.size()));
+      if (!sweep_file.good()) {
+        std::cerr << "Failed to open " << arg.substr(sweep_flag.size()) << std::endl;
+        return false;
+      }
+      configs = nlohmann::json::parse(sweep_file, nullptr, /*allow_exceptions*/ false);
+    } else {
+      argv[remaining++] = argv[i];
+      continue;
+    }
+
+    if (configs.is_discarded()) {
+      std::cerr << "Failed to parse " << arg << std::endl;
+      return false;
+    }
+
+    ORT_TRY {
+      for (const auto& config : configs.is_array() ? configs : nlohmann::json::array({configs})) {
+        RegisterKernelBenchmark(config, allocator, generator);
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        std::cerr << "Invalid kernel benchmark " << arg << ": " << ex.what() << std::endl;
+      });
+      return false;
+    }
+  }
+
+  argc = remaining;
+  return true;
+}
@@ -24,6 +24,9 @@
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
+// defined in kernel_invoker.cc
+bool RegisterKernelBenchmarks(int& argc, char** argv);
+
 using namespace onnxruntime;
 
 static void BM_CPUAllocator(benchmark::State& state) {
@@ -76,6 +79,8 @@ BENCHMARK(BM_ResolveGraph);
 
 int main(int argc, char** argv) {
   ::benchmark::Initialize(&argc, argv);
+  if (!RegisterKernelBenchmarks(argc, argv))
+    return -1;
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
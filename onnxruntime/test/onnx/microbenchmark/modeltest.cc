@@ -6,6 +6,7 @@
 #include <core/platform/path_lib.h>
 #include <core/session/onnxruntime_c_api.h>
 #include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/onnxruntime_session_options_config_keys.h>
 #include <core/session/ort_env.h>
 
 #include "providers.h"
@@ -69,3 +70,64 @@ static void BM_CreateSession(benchmark::State& state) {
   g_ort->ReleaseSessionOptions(session_option);
 }
 BENCHMARK(BM_CreateSession);
+
+// Per-Run framework overhead: a single Add of two 1-element tensors, so the time is dominated by the session.
+// The argument is the value of kOrtSessionOptionsExecutionFramePoolSize.
+static void BM_RunTrivialAddGraph(benchmark::State& state) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  onnxruntime::Model model("trivial_add", false, *logger);
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  auto& a = graph.GetOrCreateNodeArg("A", &float_tensor);
+  auto& b = graph.GetOrCreateNodeArg("B", &float_tensor);
+  auto& c = graph.GetOrCreateNodeArg("C", &float_tensor);
+  graph.AddNode("add", "Add", "", {&a, &b}, {&c});
+  auto st = graph.Resolve();
+  if (!st.IsOK()) {
+    state.SkipWithError(st.ErrorMessage().c_str());
+    return;
+  }
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  OrtSessionOptions* session_option;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_option));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_option, 1));
+  const std::string pool_size = std::to_string(state.range(0));
+  ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_option, kOrtSessionOptionsExecutionFramePoolSize,
+                                                  pool_size.c_str()));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_option,
+                                                   &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  float input_data[2] = {1.f, 2.f};
+  const int64_t shape[] = {1};
+  OrtValue* inputs[2] = {nullptr, nullptr};
+  for (size_t i = 0; i < 2; ++i) {
+    ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &input_data[i], sizeof(float), shape, 1,
+                                                             ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &inputs[i]));
+  }
+  const char* input_names[] = {"A", "B"};
+  const char* output_names[] = {"C"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, inputs, 2, output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+
+  for (auto* input : inputs) {
+    g_ort->ReleaseValue(input);
+  }
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_option);
+}
+BENCHMARK(BM_RunTrivialAddGraph)
+    ->Arg(0)
+    ->Arg(4)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
@@ -4,6 +4,9 @@
 #include <core/session/onnxruntime_c_api.h>
 #include <core/platform/Barrier.h>
 
+#include <chrono>
+#include <thread>
+
 #ifdef _WIN32
 #include <Windows.h>
 #endif
@@ -188,6 +191,167 @@ BENCHMARK(BM_SimpleScheduleWait)
     ->Arg(80000)
     ->Arg(160000);
 
+// Thread pool scaling and overhead benchmarks. The thread counts range from 2 to 128 regardless of the host, the
+// "hw_threads" counter records the number of hardware threads so that oversubscribed runs can be told apart when the
+// results of different hosts are compared.
+static std::unique_ptr<ThreadPool> CreateBenchmarkThreadPool(int num_threads, bool allow_spinning) {
+  return std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                      num_threads, allow_spinning);
+}
+
+static void SetThreadPoolCounters(benchmark::State& state, int num_threads) {
+  state.counters["threads"] = static_cast<double>(num_threads);
+  state.counters["hw_threads"] = static_cast<double>(std::thread::hardware_concurrency());
+}
+
+static void ThreadPoolScalingArgs(benchmark::internal::Benchmark* b) {
+  for (int num_threads = 2; num_threads <= 128; num_threads *= 2) {
+    b->Arg(num_threads);
+  }
+}
+
+// Latency of dispatching an empty loop with one work item per thread.
+static void BM_ThreadPoolEmptyParallelFor(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  auto tp = CreateBenchmarkThreadPool(num_threads, ALLOW_SPINNING);
+  for (auto _ : state) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_threads, [](std::ptrdiff_t) {});
+  }
+  SetThreadPoolCounters(state, num_threads);
+}
+BENCHMARK(BM_ThreadPoolEmptyParallelFor)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Apply(ThreadPoolScalingArgs);
+
+// Fork-join overhead of a loop whose work items are too small to be worth running in parallel, compared with
+// BM_SimpleForLoop.
+static void BM_ThreadPoolForkJoin(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  auto tp = CreateBenchmarkThreadPool(num_threads, ALLOW_SPINNING);
+  const std::ptrdiff_t len = 100 * static_cast<std::ptrdiff_t>(num_threads);
+  for (auto _ : state) {
+    ThreadPool::TryBatchParallelFor(
+        tp.get(), len, [](std::ptrdiff_t i) { SimpleForLoop(i, i + 1); }, 0);
+  }
+  SetThreadPoolCounters(state, num_threads);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_ThreadPoolForkJoin)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Apply(ThreadPoolScalingArgs);
+
+// Loops run one after the other, within one parallel section (range(2) == 1) or each in its own.
+// The parallel section keeps the workers of the first loop for the next ones.
+static void BM_ThreadPoolParallelSectionReuse(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  const int64_t num_loops = state.range(1);
+  const bool use_parallel_section = state.range(2) != 0;
+  auto tp = CreateBenchmarkThreadPool(num_threads, ALLOW_SPINNING);
+  const auto run_loops = [&]() {
+    for (int64_t i = 0; i < num_loops; ++i) {
+      ThreadPool::TrySimpleParallelFor(tp.get(), num_threads, [](std::ptrdiff_t n) { SimpleForLoop(0, 100 + n); });
+    }
+  };
+  for (auto _ : state) {
+    if (use_parallel_section) {
+      ThreadPool::ParallelSection ps(tp.get());
+      run_loops();
+    } else {
+      run_loops();
+    }
+  }
+  SetThreadPoolCounters(state, num_threads);
+  state.SetItemsProcessed(state.iterations() * num_loops);
+}
+BENCHMARK(BM_ThreadPoolParallelSectionReuse)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{4, 8, 16}, {1, 4, 16}, {0, 1}});
+
+// Throughput of Schedule: range(1) tasks are scheduled, then waited for.
+static void BM_ThreadPoolScheduleThroughput(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  const auto num_tasks = static_cast<unsigned int>(state.range(1));
+  auto tp = CreateBenchmarkThreadPool(num_threads, ALLOW_SPINNING);
+  for (auto _ : state) {
+    onnxruntime::Barrier barrier(num_tasks);
+    for (unsigned int i = 0; i < num_tasks; ++i) {
+      ThreadPool::Schedule(tp.get(), [&barrier]() { barrier.Notify(); });
+    }
+    barrier.Wait();
+  }
+  SetThreadPoolCounters(state, num_threads);
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+BENCHMARK(BM_ThreadPoolScheduleThroughput)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{2, 4, 8, 16, 32, 64, 128}, {64, 1024}});
+
+// A loop whose first items cost range(1) times more than the others, so that the threads done with their own items
+// steal from the others. The steals and steal attempts of the workers are reported per iteration.
+static void BM_ThreadPoolImbalancedWork(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  const std::ptrdiff_t imbalance = static_cast<std::ptrdiff_t>(state.range(1));
+  auto tp = CreateBenchmarkThreadPool(num_threads, ALLOW_SPINNING);
+  const std::ptrdiff_t len = 64 * static_cast<std::ptrdiff_t>(num_threads);
+  const std::ptrdiff_t num_heavy_items = len / 8;
+  const auto before = ThreadPool::GetStatistics(tp.get());
+  for (auto _ : state) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), len, [num_heavy_items, imbalance](std::ptrdiff_t i) {
+      SimpleForLoop(0, i < num_heavy_items ? 1000 * imbalance : 1000);
+    });
+  }
+  const auto after = ThreadPool::GetStatistics(tp.get());
+  double steals = 0;
+  double steal_attempts = 0;
+  for (size_t i = 0; i < after.workers.size(); ++i) {
+    steals += static_cast<double>(after.workers[i].steals - before.workers[i].steals);
+    steal_attempts += static_cast<double>(after.workers[i].steal_attempts - before.workers[i].steal_attempts);
+  }
+  SetThreadPoolCounters(state, num_threads);
+  state.counters["steals"] = benchmark::Counter(steals, benchmark::Counter::kAvgIterations);
+  state.counters["steal_attempts"] = benchmark::Counter(steal_attempts, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_ThreadPoolImbalancedWork)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{4, 8, 16, 32}, {1, 4, 16}});
+
+// Latency of a loop run after the pool was idle for range(2) microseconds, with spinning (range(1) == 1) or without.
+// Only the loops are timed. The time the workers spent spinning and blocked is reported per iteration, as a proxy of
+// the CPU usage and power that spinning trades for latency.
+static void BM_ThreadPoolSpinVersusBlock(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  const bool allow_spinning = state.range(1) != 0;
+  const auto idle_time = std::chrono::microseconds(state.range(2));
+  auto tp = CreateBenchmarkThreadPool(num_threads, allow_spinning);
+  const auto before = ThreadPool::GetStatistics(tp.get());
+  for (auto _ : state) {
+    std::this_thread::sleep_for(idle_time);
+    const auto start = std::chrono::steady_clock::now();
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_threads, [](std::ptrdiff_t) { SimpleForLoop(0, 1000); });
+    state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  const auto after = ThreadPool::GetStatistics(tp.get());
+  double spin_us = 0;
+  double blocked_us = 0;
+  for (size_t i = 0; i < after.workers.size(); ++i) {
+    spin_us += static_cast<double>(after.workers[i].spin_ns - before.workers[i].spin_ns) / 1000.0;
+    blocked_us += static_cast<double>(after.workers[i].blocked_ns - before.workers[i].blocked_ns) / 1000.0;
+  }
+  SetThreadPoolCounters(state, num_threads);
+  state.counters["spin_us"] = benchmark::Counter(spin_us, benchmark::Counter::kAvgIterations);
+  state.counters["blocked_us"] = benchmark::Counter(blocked_us, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ThreadPoolSpinVersusBlock)
+    ->UseManualTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{4, 16}, {0, 1}, {0, 100, 10000}});
+
 #ifdef _WIN32
 struct Param {
   std::atomic<int> id = 0;
@@ -4,6 +4,7 @@
 #include "core/graph/model.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "test/framework/test_utils.h"
 #include "test/test_environment.h"
 #include "test/util/include/asserts.h"
@@ -295,5 +296,73 @@ TEST(CseTests, MergeConstants) {
   ASSERT_EQ(op_count["Add"], 2);
 }
 
+TEST(CseTests, LoopInvariantMergedWithOuterScope) {
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  ONNX_NAMESPACE::TypeProto int64_scalar;
+  int64_scalar.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  int64_scalar.mutable_tensor_type()->mutable_shape();
+  ONNX_NAMESPACE::TypeProto bool_scalar;
+  bool_scalar.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_scalar.mutable_tensor_type()->mutable_shape();
+
+  // The body adds x * x, which only depends on the outer scope value x, to the loop carried value.
+  ONNX_NAMESPACE::GraphProto body_proto;
+  {
+    Model body_model("loop body", false, DefaultLoggingManager().DefaultLogger());
+    Graph& body = body_model.MainGraph();
+    auto& iter_num = body.GetOrCreateNodeArg("iter_num", &int64_scalar);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& v_in = body.GetOrCreateNodeArg("v_in", &float_tensor);
+    auto& x = body.GetOrCreateNodeArg("x", &float_tensor);
+    body.AddOuterScopeNodeArg("x");
+    auto& square = body.GetOrCreateNodeArg("square", &float_tensor);
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& v_out = body.GetOrCreateNodeArg("v_out", &float_tensor);
+    body.AddNode("body_mul", "Mul", "", {&x, &x}, {&square});
+    body.AddNode("body_add", "Add", "", {&v_in, &square}, {&v_out});
+    body.AddNode("body_identity", "Identity", "", {&cond_in}, {&cond_out});
+    body.SetInputs({&iter_num, &cond_in, &v_in});
+    body.SetOutputs({&cond_out, &v_out});
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("loop invariant", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& trip_count = graph.GetOrCreateNodeArg("trip_count", &int64_scalar);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar);
+  auto& outer_square = graph.GetOrCreateNodeArg("outer_square", &float_tensor);
+  auto& v_final = graph.GetOrCreateNodeArg("v_final", &float_tensor);
+  graph.AddNode("outer_mul", "Mul", "", {&x, &x}, {&outer_square});
+  Node& loop_node = graph.AddNode("loop", "Loop", "", {&trip_count, &cond, &outer_square}, {&v_final});
+  loop_node.AddAttribute("body", body_proto);
+  graph.SetInputs({&x, &trip_count, &cond});
+  graph.SetOutputs({&v_final});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  GraphTransformerManager graph_transformation_mgr(1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<CommonSubexpressionElimination>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  // The Mul of the body is moved out of the Loop and merged with the same Mul outside of it.
+  ASSERT_EQ(CountOpsInGraph(graph, false)["Mul"], 1);
+  const Graph* body = graph.GetNode(loop_node.Index())->GetGraphAttribute("body");
+  ASSERT_NE(body, nullptr);
+  auto body_op_count = CountOpsInGraph(*body);
+  ASSERT_EQ(body_op_count["Mul"], 0);
+  ASSERT_EQ(body_op_count["Add"], 1);
+
+  const auto& implicit_inputs = graph.GetNode(loop_node.Index())->ImplicitInputDefs();
+  ASSERT_EQ(implicit_inputs.size(), 1U);
+  ASSERT_EQ(implicit_inputs[0]->Name(), "outer_square");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
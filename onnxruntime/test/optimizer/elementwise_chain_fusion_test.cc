@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void EnableElementwiseChainFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseChainFusion, "1"));
+}
+
+static void TestElementwiseChain(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                                 int expected_fused_count) {
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], expected_fused_count);
+  };
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level3, 13, 0.0001, 0.0001,
+                    0, EnableElementwiseChainFusion);
+}
+
+TEST(ElementwiseChainFusionTests, ScaleBiasSigmoidMul) {
+  // x * sigmoid(x * scale + bias) with the bias broadcast along the last dim
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 40, 16}, -3.f, 3.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(1.5f);
+    auto* bias_arg = builder.MakeInitializer<float>({16}, -1.f, 1.f);
+    auto* mul_out_arg = builder.MakeIntermediate();
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* sigmoid_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Mul", {input_arg, scale_arg}, {mul_out_arg});
+    builder.AddNode("Add", {bias_arg, mul_out_arg}, {add_out_arg});
+    builder.AddNode("Sigmoid", {add_out_arg}, {sigmoid_out_arg});
+    builder.AddNode("Mul", {sigmoid_out_arg, input_arg}, {output_arg});
+  };
+
+  TestElementwiseChain(build_test_case, 1);
+}
+
+TEST(ElementwiseChainFusionTests, BroadcastInputFirst) {
+  // the first node has the broadcast operand as its first input, the order of the operands must be kept
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({5, 7, 9}, -2.f, 2.f);
+    auto* offset_arg = builder.MakeInitializer<float>({1, 7, 9}, -2.f, 2.f);
+    auto* scale_arg = builder.MakeInput<float>({1}, 1.f, 2.f);
+    auto* sub_out_arg = builder.MakeIntermediate();
+    auto* tanh_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sub", {offset_arg, input_arg}, {sub_out_arg});
+    builder.AddNode("Tanh", {sub_out_arg}, {tanh_out_arg});
+    builder.AddNode("Mul", {scale_arg, tanh_out_arg}, {output_arg});
+  };
+
+  TestElementwiseChain(build_test_case, 1);
+}
+
+TEST(ElementwiseChainFusionTests, OperandFromOtherNode) {
+  // relu(x) has two consumers, so the chain starts after it and reads it from the Relu node twice
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 300}, -2.f, 2.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(-0.5f);
+    auto* relu_out_arg = builder.MakeIntermediate();
+    auto* mul_out_arg = builder.MakeIntermediate();
+    auto* exp_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Relu", {input_arg}, {relu_out_arg});
+    builder.AddNode("Mul", {relu_out_arg, scale_arg}, {mul_out_arg});
+    builder.AddNode("Exp", {mul_out_arg}, {exp_out_arg});
+    builder.AddNode("Mul", {exp_out_arg, relu_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level3, 13, 0.0001, 0.0001,
+                    0, EnableElementwiseChainFusion);
+}
+
+TEST(ElementwiseChainFusionTests, IntermediateIsGraphOutput) {
+  // the chain stops at an intermediate value used outside of it
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({3, 64}, -2.f, 2.f);
+    auto* abs_out_arg = builder.MakeOutput();
+    auto* neg_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Neg", {input_arg}, {neg_out_arg});
+    builder.AddNode("Abs", {neg_out_arg}, {abs_out_arg});
+    builder.AddNode("Sqrt", {abs_out_arg}, {output_arg});
+  };
+
+  TestElementwiseChain(build_test_case, 1);
+}
+
+TEST(ElementwiseChainFusionTests, UnsupportedBroadcast) {
+  // the bias is broadcast along a middle dim, which FusedElementwise does not support
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 8}, -2.f, 2.f);
+    auto* bias_arg = builder.MakeInitializer<float>({3, 1}, -1.f, 1.f);
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out_arg});
+    builder.AddNode("Relu", {add_out_arg}, {output_arg});
+  };
+
+  TestElementwiseChain(build_test_case, 0);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void TestGatedMLP(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                         int expected_fused_count) {
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GatedMLP"], expected_fused_count);
+    if (expected_fused_count > 0) {
+      EXPECT_EQ(op_to_count["MatMul"], 0);
+    }
+  };
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level2, 13, 0.0001, 0.0001);
+}
+
+// MatMul(activation(MatMul(X, W_gate)) * MatMul(X, W_up), W_down) with the activation built by add_activation.
+static void BuildGatedMLP(ModelTestBuilder& builder, bool up_is_first_mul_input,
+                          const std::function<NodeArg*(ModelTestBuilder&, NodeArg*)>& add_activation) {
+  constexpr int64_t K = 16, hidden_size = 40, N = 12;
+  auto* input_arg = builder.MakeInput<float>({2, 5, K}, -1.f, 1.f);
+  auto* gate_weight_arg = builder.MakeInitializer<float>({K, hidden_size}, -0.5f, 0.5f);
+  auto* up_weight_arg = builder.MakeInitializer<float>({K, hidden_size}, -0.5f, 0.5f);
+  auto* down_weight_arg = builder.MakeInitializer<float>({hidden_size, N}, -0.5f, 0.5f);
+  auto* gate_out_arg = builder.MakeIntermediate();
+  auto* up_out_arg = builder.MakeIntermediate();
+  auto* mul_out_arg = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+
+  builder.AddNode("MatMul", {input_arg, gate_weight_arg}, {gate_out_arg});
+  builder.AddNode("MatMul", {input_arg, up_weight_arg}, {up_out_arg});
+  auto* activation_out_arg = add_activation(builder, gate_out_arg);
+  if (up_is_first_mul_input) {
+    builder.AddNode("Mul", {up_out_arg, activation_out_arg}, {mul_out_arg});
+  } else {
+    builder.AddNode("Mul", {activation_out_arg, up_out_arg}, {mul_out_arg});
+  }
+  builder.AddNode("MatMul", {mul_out_arg, down_weight_arg}, {output_arg});
+}
+
+static NodeArg* AddSilu(ModelTestBuilder& builder, NodeArg* input_arg) {
+  auto* sigmoid_out_arg = builder.MakeIntermediate();
+  auto* silu_out_arg = builder.MakeIntermediate();
+  builder.AddNode("Sigmoid", {input_arg}, {sigmoid_out_arg});
+  builder.AddNode("Mul", {input_arg, sigmoid_out_arg}, {silu_out_arg});
+  return silu_out_arg;
+}
+
+TEST(GatedMLPFusionTests, SwiGLU) {
+  for (bool up_is_first_mul_input : {false, true}) {
+    TestGatedMLP([&](ModelTestBuilder& builder) { BuildGatedMLP(builder, up_is_first_mul_input, AddSilu); }, 1);
+  }
+}
+
+TEST(GatedMLPFusionTests, GeGLU) {
+  auto add_gelu = [](ModelTestBuilder& builder, NodeArg* input_arg) {
+    auto* gelu_out_arg = builder.MakeIntermediate();
+    builder.AddNode("Gelu", {input_arg}, {gelu_out_arg}, kMSDomain);
+    return gelu_out_arg;
+  };
+  TestGatedMLP([&](ModelTestBuilder& builder) { BuildGatedMLP(builder, false, add_gelu); }, 1);
+}
+
+TEST(GatedMLPFusionTests, ActivationUsedElsewhere) {
+  // the Silu output is also a graph output, so the intermediate value must be kept
+  auto add_silu_output = [](ModelTestBuilder& builder, NodeArg* input_arg) {
+    auto* silu_out_arg = AddSilu(builder, input_arg);
+    builder.AddNode("Identity", {silu_out_arg}, {builder.MakeOutput()});
+    return silu_out_arg;
+  };
+  TestGatedMLP([&](ModelTestBuilder& builder) { BuildGatedMLP(builder, false, add_silu_output); }, 0);
+}
+
+#endif  // !DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
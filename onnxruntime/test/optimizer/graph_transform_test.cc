@@ -24,6 +24,7 @@
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
+#include "core/optimizer/broadcast_elimination.h"
 #include "core/optimizer/cast_elimination.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/concat_slice_elimination.h"
@@ -73,10 +74,12 @@
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
+#include "core/optimizer/zipmap_columnar_output.h"
 #include "core/platform/env.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
+#include "core/util/thread_utils.h"
 #include "test/capturing_sink.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/compare_ortvalue.h"
@@ -628,6 +631,122 @@ TEST_F(GraphTransformationTests, ConstantFoldingNodesOnDifferentEP) {
   }
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingInParallel) {
+  // c1 and c2 are folded in the same batch, c3 once it completes
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 4}});
+    auto* a = builder.MakeInitializer<float>({4}, {1.0f, 2.0f, 3.0f, 4.0f});
+    auto* b = builder.MakeInitializer<float>({4}, {5.0f, 6.0f, 7.0f, 8.0f});
+    auto* c1 = builder.MakeIntermediate();
+    auto* c2 = builder.MakeIntermediate();
+    auto* c3 = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {a, b}, {c1});
+    builder.AddNode("Mul", {a, b}, {c2});
+    builder.AddNode("Sub", {c2, c1}, {c3});
+    builder.AddNode("Add", {input_arg, c3}, {output_arg});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Sub"] == 0);
+
+    const auto& add_node = *graph.Nodes().begin();
+    const auto* folded = graph.GetConstantInitializer(add_node.InputDefs()[1]->Name(), false);
+    TEST_RETURN_IF_NOT(folded != nullptr);
+    Initializer values{*folded, graph.ModelPath()};
+    const std::vector<float> expected{-1.0f, 4.0f, 11.0f, 20.0f};
+    TEST_RETURN_IF_NOT(std::vector<float>(values.data<float>(), values.data<float>() + values.size()) == expected);
+    return Status::OK();
+  };
+
+  OrtThreadPoolParams thread_pool_params;
+  thread_pool_params.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  const ConfigOptions empty_config_options;
+  for (concurrency::ThreadPool* tp : {static_cast<concurrency::ThreadPool*>(nullptr), thread_pool.get()}) {
+    auto transformer = std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                                         empty_config_options, InlinedHashSet<std::string_view>{},
+                                                         InlinedHashSet<std::string>{}, tp);
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputSize) {
+  // the output of the Expand is 64 KB
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{128, 128}});
+    auto* value = builder.MakeInitializer<float>({1}, {1.0f});
+    auto* shape = builder.MakeInitializer<int64_t>({2}, {128, 128});
+    auto* expand_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Expand", {value, shape}, {expand_out});
+    builder.AddNode("Mul", {input_arg, expand_out}, {output_arg});
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  for (const char* max_output_size : {"0", "65536", "65535"}) {
+    ConfigOptions config_options;
+    ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingMaxOutputSize, max_output_size));
+    const int expected_expand_count = std::string(max_output_size) == "65535" ? 1 : 0;
+
+    auto post_graph_checker = [expected_expand_count](Graph& graph) {
+      TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Expand"] == expected_expand_count);
+      return Status::OK();
+    };
+
+    auto transformer = std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, config_options);
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingOptimizationObjective) {
+  // the Expand grows its inputs to 64 KB, the Add of two initializers does not grow them
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{128, 128}});
+    auto* value = builder.MakeInitializer<float>({1}, {1.0f});
+    auto* shape = builder.MakeInitializer<int64_t>({2}, {128, 128});
+    auto* lhs = builder.MakeInitializer<float>({128}, -1.0f, 1.0f);
+    auto* rhs = builder.MakeInitializer<float>({128}, -1.0f, 1.0f);
+    auto* expand_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Expand", {value, shape}, {expand_out});
+    builder.AddNode("Add", {lhs, rhs}, {add_out});
+    builder.AddNode("Mul", {input_arg, expand_out}, {mul_out});
+    builder.AddNode("Sub", {mul_out, add_out}, {output_arg});
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  for (const char* objective : {"speed", "balanced", "memory"}) {
+    ConfigOptions config_options;
+    ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsGraphOptimizationObjective, objective));
+    const int expected_expand_count = std::string(objective) == "speed" ? 0 : 1;
+
+    auto post_graph_checker = [expected_expand_count](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Expand"] == expected_expand_count);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+      return Status::OK();
+    };
+
+    auto transformer = std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, config_options);
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+  }
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingUnsupportedFloat16) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "constant_float16_mul.onnx";
   std::shared_ptr<Model> model;
@@ -1057,9 +1176,8 @@ TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInlining) {
   // Constant nodes and initializers are promoted to the outer graph.
   // The initializer or a constant node is the output of the subgraph being inlined.
   // Nested subgraphs names are renamed as appropriate.
-  // In all If node is constant folded twice. The last If node is not constant
-  // folded because the input is indirectly dependent on the size of the input.
-  // XXX: Can we constant fold Size() if the graph input shape is fixed?
+  // All three If nodes are constant folded. The condition of the last one depends on the size of
+  // the input, which is constant folded as the graph input shape is fixed.
 
   const char* code = R"(
   <
@@ -1145,38 +1263,23 @@ TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInlining) {
   // std::cout << printed_model << std::endl;
 
   // This is the resulting model proto.
-  // The remaining If node is not constant foldable because Size() does not constant fold
-  // although the shape is fixed.
   /*
     <
        ir_version: 8,
-       opset_import: ["" : 16, "local" : 1,
-         "com.microsoft.nchwc" : 1,
-          "ai.onnx.ml" : 4,
-          "com.ms.internal.nhwc" : 20,
-          "ai.onnx.training" : 1,
-          "ai.onnx.preview.training" : 1,
-          "com.microsoft" : 1,
-          "com.microsoft.experimental" : 1,
-          "org.pytorch.aten" : 1]
+       opset_import: ["" : 16, "local" : 1, ...]
     >
     agraph (float[128] x, float[128] x1) => (float[128] y) {
-       _if_elseGraph_10__inlfunc_aten_gather_tmp_9 = Size (x1)
-       _if_elseGraph_10__inlfunc_aten_gather_cond_11 =
-                                  Equal (_if_elseGraph_10__inlfunc_aten_gather_tmp_9, ortshared_7_0_1_0_token_10)
-       y = If (_if_elseGraph_10__inlfunc_aten_gather_cond_11) <then_branch: graph = thenGraph_15 () => (float[128] _inlfunc_aten_gather_result_12) {
-          _inlfunc_aten_gather_result_12 = Cast <to: int = 1> (x1)
-       }, else_branch: graph = elseGraph_15 () => (float[128] _inlfunc_aten_gather_result_14) {
-          _inlfunc_aten_gather_index_13 = Cast <to: int = 7> (x1)
-          _inlfunc_aten_gather_result_14 = GatherElements <axis: int = 1> (x, _inlfunc_aten_gather_index_13)
-       }>
+       _inlfunc_aten_gather_index_13 = Cast <to: int = 7> (x1)
+       y = GatherElements <axis: int = 1> (x, _inlfunc_aten_gather_index_13)
     }
   */
 
   auto& graph = session_object.GetModel().MainGraph();
   auto op_to_count = CountOpsInGraph(graph);
   ASSERT_EQ(op_to_count["local.aten_gather"], 0);
-  ASSERT_EQ(op_to_count["If"], 1);
+  ASSERT_EQ(op_to_count["If"], 0);
+  ASSERT_EQ(op_to_count["Size"], 0);
+  ASSERT_EQ(op_to_count["GatherElements"], 1);
 }
 
 TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInliningRebuildEdges) {
@@ -1209,13 +1312,14 @@ TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInliningEdgesWithMiddl
   // during If constant folding
   // This test is only valid if Resize() node resides in the nested subgraph which gets inlined
   // however, the destination graph must not be the main graph. Then we test that the edges are rebuild
-  // properly. Also Resize() should not be the first node in the resulting subgraph, so it has edges
+  // properly. Also Resize() should not be the first node in the resulting subgraph, so it has edges.
+  // x1 has a symbolic dimension so that the If nodes whose condition depends on its size are not folded.
   const char* code = R"(
   <
   ir_version: 8,
   opset_import: [ "" : 16, "local" : 1 ]
   >
-  agraph (float[128] x, float[128] x1) => (float[N] y)
+  agraph (float[128] x, float[M] x1) => (float[N] y)
   {
       y = local.aten_gather <dim: int = 1, sparse_grad: int = 0> (x, x1)
   }
@@ -1273,7 +1377,7 @@ TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInliningEdgesWithMiddl
      "com.microsoft" : 1,
      "com.microsoft.experimental" : 1, "org.pytorch.aten" : 1]
   >
-  agraph (float[128] x, float[128] x1) => (float[128] y)
+  agraph (float[128] x, float[M] x1) => (float[128] y)
      <float[1] _inlfunc_aten_gather_resize_scales =  {1.5}, int64 ortshared_7_0_1_0_token_8 =  {0}>
   {
      _inlfunc_aten_gather_tmp_0 = Size (x1)
@@ -4325,6 +4429,160 @@ TEST_F(GraphTransformationTests, ExpandElimination) {
   ASSERT_TRUE(op_to_count["Expand"] == 3);
 }
 
+TEST_F(GraphTransformationTests, BroadcastElimination) {
+  auto test = [&](const std::function<void(ModelTestBuilder&)>& build_test_case, const char* op_type,
+                  bool expect_removed) {
+    auto pre_graph_checker = [op_type](Graph& graph) {
+      TEST_RETURN_IF_NOT(CountOpsInGraph(graph)[op_type] == 1);
+      return Status::OK();
+    };
+    auto post_graph_checker = [op_type, expect_removed](Graph& graph) {
+      TEST_RETURN_IF_NOT(CountOpsInGraph(graph)[op_type] == (expect_removed ? 0 : 1));
+      return Status::OK();
+    };
+
+    auto rule_transformer = std::make_unique<RuleBasedGraphTransformer>("RuleTransformer");
+    ASSERT_STATUS_OK(rule_transformer->Register(std::make_unique<BroadcastElimination>()));
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(rule_transformer),
+                                          TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+  };
+
+  // The mask is expanded to the shape of the scores it is added to.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* scores_arg = builder.MakeInput<float>({{2, 4, 8, 8}});
+      auto* mask_arg = builder.MakeInput<float>({{2, 1, 1, 8}});
+      auto* shape_arg = builder.MakeInitializer<int64_t>({4}, {2, 4, 8, 8});
+      auto* expand_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Expand", {mask_arg, shape_arg}, {expand_out});
+      builder.AddNode("Add", {scores_arg, expand_out}, {output_arg});
+    };
+    test(build_test_case, "Expand", true);
+  }
+
+  // Same with symbolic dims, the mask is expanded to the shape of the other input of the consumer.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* cond_arg = builder.MakeSymbolicInput<bool>({"batch", 4, "seq", "seq"});
+      auto* scores_arg = builder.MakeSymbolicInput<float>({"batch", 4, "seq", "seq"});
+      auto* mask_arg = builder.MakeSymbolicInput<float>({"batch", 1, 1, "seq"});
+      auto* shape_out = builder.MakeIntermediate();
+      auto* expand_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Shape", {scores_arg}, {shape_out});
+      builder.AddNode("Expand", {mask_arg, shape_out}, {expand_out});
+      builder.AddNode("Where", {cond_arg, expand_out, scores_arg}, {output_arg});
+    };
+    test(build_test_case, "Expand", true);
+  }
+
+  // The Expand makes the output of the consumer larger, so it must be kept.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* input1_arg = builder.MakeInput<float>({{1, 8}});
+      auto* input2_arg = builder.MakeInput<float>({{8}});
+      auto* shape_arg = builder.MakeInitializer<int64_t>({2}, {4, 8});
+      auto* expand_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Expand", {input1_arg, shape_arg}, {expand_out});
+      builder.AddNode("Add", {input2_arg, expand_out}, {output_arg});
+    };
+    test(build_test_case, "Expand", false);
+  }
+
+  // A Tile of a dim of size 1 is a broadcast.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* input1_arg = builder.MakeInput<float>({{2, 1, 8}});
+      auto* input2_arg = builder.MakeInput<float>({{2, 4, 8}});
+      auto* repeats_arg = builder.MakeInitializer<int64_t>({3}, {1, 4, 1});
+      auto* tile_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Tile", {input1_arg, repeats_arg}, {tile_out});
+      builder.AddNode("Mul", {tile_out, input2_arg}, {output_arg});
+    };
+    test(build_test_case, "Tile", true);
+  }
+
+  // A Tile of a dim of size 2 repeats the data, which broadcasting does not.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* input1_arg = builder.MakeInput<float>({{2, 1, 4}});
+      auto* input2_arg = builder.MakeInput<float>({{2, 1, 8}});
+      auto* repeats_arg = builder.MakeInitializer<int64_t>({3}, {1, 1, 2});
+      auto* tile_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Tile", {input1_arg, repeats_arg}, {tile_out});
+      builder.AddNode("Mul", {tile_out, input2_arg}, {output_arg});
+    };
+    test(build_test_case, "Tile", false);
+  }
+}
+
+TEST_F(GraphTransformationTests, ZipMapColumnarOutput) {
+  Model model("ZipMapColumnarOutput", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto input_tensor_type;
+  input_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  input_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& input = graph.GetOrCreateNodeArg("probabilities", &input_tensor_type);
+  auto& string_output = graph.GetOrCreateNodeArg("string_zipmap", nullptr);
+  auto& int64_output = graph.GetOrCreateNodeArg("int64_zipmap", nullptr);
+
+  auto& string_zipmap = graph.AddNode("string_zipmap", "ZipMap", "", {&input}, {&string_output}, nullptr, kMLDomain);
+  string_zipmap.AddAttribute("classlabels_strings", std::vector<std::string>{"b", "a", "c"});
+  auto& int64_zipmap = graph.AddNode("int64_zipmap", "ZipMap", "", {&input}, {&int64_output}, nullptr, kMLDomain);
+  int64_zipmap.AddAttribute("classlabels_int64s", std::vector<int64_t>{7, 3, 5});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ZipMapColumnarOutput>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.ZipMap"], 0);
+  ASSERT_EQ(op_to_count["Identity"], 2);
+
+  // the ZipMap outputs keep their names and become the dense tensor, followed by the outputs of the labels.
+  const auto& outputs = graph.GetOutputs();
+  ASSERT_EQ(outputs.size(), 4u);
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_TRUE(outputs[i]->Name() == "string_zipmap" || outputs[i]->Name() == "int64_zipmap");
+    ASSERT_TRUE(outputs[i]->TypeAsProto()->has_tensor_type());
+    ASSERT_EQ(outputs[i]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT);
+  }
+
+  for (size_t i = 2; i < 4; ++i) {
+    const TensorProto* labels = nullptr;
+    ASSERT_TRUE(graph.GetInitializedTensor(outputs[i]->Name(), labels));
+    ASSERT_EQ(labels->dims_size(), 1);
+    ASSERT_EQ(labels->dims(0), 3);
+    if (outputs[i]->Name() == "string_zipmap_labels") {
+      ASSERT_EQ(labels->data_type(), TensorProto_DataType_STRING);
+      ASSERT_EQ(labels->string_data(0), "b");
+      ASSERT_EQ(labels->string_data(1), "a");
+      ASSERT_EQ(labels->string_data(2), "c");
+    } else {
+      ASSERT_EQ(outputs[i]->Name(), "int64_zipmap_labels");
+      ASSERT_EQ(labels->data_type(), TensorProto_DataType_INT64);
+      ASSERT_EQ(labels->int64_data(0), 7);
+      ASSERT_EQ(labels->int64_data(1), 3);
+      ASSERT_EQ(labels->int64_data(2), 5);
+    }
+  }
+}
+
 TEST_F(GraphTransformationTests, CastElimination) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "cast_elimination.onnx";
   std::shared_ptr<Model> model;
@@ -8138,6 +8396,120 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+// Adds a MatMulNBits node of A with shape {M, K}, with N outputs, and returns its output.
+static NodeArg* AddMatMulNBitsNode(ModelTestBuilder& builder, NodeArg* A, int64_t K, int64_t N) {
+  constexpr size_t qbits = 4;
+  constexpr size_t block_size = 32;
+
+  int q_rows, q_cols;
+  MlasBlockwiseQuantizedShape<float, qbits>(block_size, /* columnwise */ true,
+                                            static_cast<int>(K), static_cast<int>(N),
+                                            q_rows, q_cols);
+
+  size_t q_data_size_in_bytes, q_scale_size, q_zp_size_in_bytes;
+  MlasBlockwiseQuantizedBufferSizes(qbits, block_size, /* columnwise */ true,
+                                    static_cast<int>(K), static_cast<int>(N),
+                                    q_data_size_in_bytes, q_scale_size, &q_zp_size_in_bytes);
+
+  auto* B_data = builder.MakeInitializer<uint8_t>({int64_t{q_rows}, int64_t{q_cols}},
+                                                  uint8_t{0}, uint8_t{255});
+  auto* B_scales = builder.MakeInitializer<float>({static_cast<int64_t>(q_scale_size)},
+                                                  1.0f, 2.0f);
+
+  auto* matmul_output = builder.MakeIntermediate();
+  auto& matmul = builder.AddNode("MatMulNBits", {A, B_data, B_scales}, {matmul_output}, kMSDomain);
+  matmul.AddAttribute("N", N);
+  matmul.AddAttribute("K", K);
+  matmul.AddAttribute("block_size", static_cast<int64_t>(block_size));
+  matmul.AddAttribute("bits", static_cast<int64_t>(qbits));
+  return matmul_output;
+}
+
+TEST_F(GraphTransformationTests, MatMulNBitsEpilogueFusion) {
+  // Silu(A * B) * gate + residual, as in the gated MLP of a decoder layer
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    constexpr int64_t M = 2, K = 32, N = 8;
+
+    auto* A = builder.MakeInput<float>(std::vector{M, K}, "A");
+    auto* gate = builder.MakeInput<float>(std::vector{M, N}, "gate");
+    auto* residual = builder.MakeInput<float>(std::vector{M, N}, "residual");
+    auto* matmul_output = AddMatMulNBitsNode(builder, A, K, N);
+
+    auto* sigmoid_output = builder.MakeIntermediate();
+    auto* silu_output = builder.MakeIntermediate();
+    auto* gate_output = builder.MakeIntermediate();
+    builder.AddNode("Sigmoid", {matmul_output}, {sigmoid_output});
+    builder.AddNode("Mul", {matmul_output, sigmoid_output}, {silu_output});
+    builder.AddNode("Mul", {gate, silu_output}, {gate_output});
+    builder.AddNode("Add", {gate_output, residual}, {builder.MakeOutput()});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["Mul"], 2);
+    EXPECT_EQ(op_count["Add"], 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["com.microsoft.MatMulNBits"], 1);
+    EXPECT_EQ(op_count["Sigmoid"], 0);
+    EXPECT_EQ(op_count["Mul"], 0);
+    EXPECT_EQ(op_count["Add"], 0);
+    for (const Node& node : graph.Nodes()) {
+      EXPECT_EQ(node.GetAttributes().at("activation").s(), "Silu");
+      EXPECT_EQ(node.InputDefs().size(), size_t{8});
+      EXPECT_EQ(node.InputDefs()[6]->Name(), "gate");
+      EXPECT_EQ(node.InputDefs()[7]->Name(), "residual");
+    }
+    return Status::OK();
+  };
+
+  // the activation, the gate and the residual are fused one at a time
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, *logger_, std::make_unique<MatMulNBitsFusion>(),
+                                        TransformerLevel::Level2, 3, pre_graph_checker, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, MatMulNBitsSkipLayerNormFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    constexpr int64_t M = 2, K = 32, N = 8;
+
+    auto* A = builder.MakeInput<float>(std::vector{M, K}, "A");
+    auto* residual = builder.MakeInput<float>(std::vector{M, N}, "residual");
+    auto* gamma = builder.MakeInitializer<float>({N}, 1.0f, 2.0f);
+    auto* beta = builder.MakeInitializer<float>({N}, -1.0f, 1.0f);
+    auto* matmul_output = AddMatMulNBitsNode(builder, A, K, N);
+
+    auto& skip_layer_norm = builder.AddNode("SkipLayerNormalization", {residual, matmul_output, gamma, beta},
+                                            {builder.MakeOutput()}, kMSDomain);
+    skip_layer_norm.AddAttribute("epsilon", 1e-5f);
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["com.microsoft.SkipLayerNormalization"], 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["com.microsoft.SkipLayerNormalization"], 0);
+    EXPECT_EQ(op_count["LayerNormalization"], 1);
+    for (const Node& node : graph.Nodes()) {
+      if (node.OpType() == "MatMulNBits") {
+        EXPECT_EQ(node.InputDefs()[7]->Name(), "residual");
+      } else {
+        EXPECT_EQ(node.GetAttributes().at("epsilon").f(), 1e-5f);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, *logger_, std::make_unique<MatMulNBitsFusion>(),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
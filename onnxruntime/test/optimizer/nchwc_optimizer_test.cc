@@ -144,7 +144,11 @@ struct NchwcTestHelper {
     std::vector<T> random_data;
     random_data.resize(count);
     for (size_t n = 0; n < count; n++) {
-      random_data[n] = static_cast<T>(fill_value_);
+      if constexpr (std::is_same_v<T, MLFloat16>) {
+        random_data[n] = MLFloat16(static_cast<float>(fill_value_));
+      } else {
+        random_data[n] = static_cast<T>(fill_value_);
+      }
       fill_value_++;
       if (fill_value_ == max_fill_value) {
         fill_value_ = min_fill_value;
@@ -1402,6 +1406,45 @@ TEST(NchwcOptimizerTests, MaxPoolTypeCheck) {
   NchwcOptimizerTester(build_test_case, check_nchwc_graph, 12);
 }
 
+#ifndef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+TEST(NchwcOptimizerTests, ConvFloat16) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<MLFloat16>({1, 32, 14, 14});
+    auto* conv1_output_arg = helper.MakeIntermediate();
+    auto* relu_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    // Scale the weights down so that the outputs stay in the range of float16.
+    auto make_weights = [&](const std::vector<int64_t>& shape) {
+      std::vector<MLFloat16> data;
+      for (float value : helper.FillRandomData<float>(shape)) {
+        data.push_back(MLFloat16(value / 512.0f));
+      }
+      return helper.MakeInitializer<MLFloat16>(shape, data);
+    };
+
+    helper.AddNode("Conv", {input_arg, make_weights({32, 32, 3, 3})}, {conv1_output_arg})
+        .AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    helper.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+    helper.AddNode("Conv", {relu_output_arg, make_weights({16, 32, 1, 1})}, {output_arg});
+    helper.per_sample_tolerance_ = 0.5;
+  };
+
+  auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  // Verify that float16 convolutions without a CPU kernel run in float32 with the NCHWc layout.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 #endif
 
 }  // namespace test
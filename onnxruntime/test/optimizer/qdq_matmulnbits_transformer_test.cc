@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "core/common/span_utils.h"
+#include "core/framework/float8.h"
 #include "core/framework/int4.h"
 #include "core/graph/node_attr_utils.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
@@ -511,6 +512,85 @@ TEST(QDQTransformerTests, DQMatMulConvertedToMatMulNBits_Cuda) {
   RunDQMatMulConverted<UInt4x2, false>({12, 12}, {12, 37}, {37, 12}, 0, 16, 1, DefaultCudaExecutionProvider());
 }
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+// Input1
+//   |      DQ (float8 weight)
+//    \    /
+//    MatMul
+//      |
+//    output
+template <typename T>
+void RunDQMatMulFloat8(const std::vector<int64_t>& input1_shape,
+                       const std::vector<int64_t>& weight_shape,
+                       const std::vector<int64_t>& scale_shape,
+                       const int64_t axis,
+                       bool use_zp,
+                       bool expect_converted) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput(input1_shape, -1.0f, 1.0f);
+    auto* output_arg = builder.MakeOutput();
+
+    NodeAttributes attrs;
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", axis), attrs);
+
+    std::vector<T> weight;
+    const int64_t weight_size = weight_shape[0] * weight_shape[1];
+    for (int64_t i = 0; i < weight_size; i++) {
+      weight.push_back(T(static_cast<float>((i * 5) % 17 - 8) / 4.0f, true));
+    }
+
+    int64_t scale_size = 1;
+    for (auto dim : scale_shape) {
+      scale_size *= dim;
+    }
+
+    auto* weight_arg = builder.MakeInitializer<T>(weight_shape, weight);
+    auto* scale_arg = builder.MakeInitializer<float>(scale_shape, 0.5f, 2.0f);
+    auto* dq_output = builder.MakeIntermediate();
+    if (use_zp) {
+      auto* zp_arg = builder.MakeInitializer<T>(scale_shape, std::vector<T>(scale_size, T(0.0f, true)));
+      builder.AddNode("DequantizeLinear", {weight_arg, scale_arg, zp_arg}, {dq_output}, "", &attrs);
+    } else {
+      builder.AddNode("DequantizeLinear", {weight_arg, scale_arg}, {dq_output}, "", &attrs);
+    }
+
+    builder.AddNode("MatMul", {input_arg, dq_output}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    const QDQOpKeys qdq_keys = GetQDQOpKeys(false);
+    EXPECT_EQ(op_to_count["MatMul"], expect_converted ? 0 : 1);
+    EXPECT_EQ(op_to_count["com.microsoft.MatMulFloat8"], expect_converted ? 1 : 0);
+    EXPECT_EQ(op_to_count[qdq_keys.dequantize_linear], expect_converted ? 0 : 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    21 /*opset_version*/,
+                    1e-4 /*per_sample_tolerance*/,
+                    1e-4 /*relative_per_sample_tolerance*/);
+}
+
+TEST(QDQTransformerTests, DQMatMulConvertedToMatMulFloat8) {
+  // per tensor scale
+  RunDQMatMulFloat8<Float8E4M3FN>({12, 37}, {37, 20}, {}, 1, false, true);
+  RunDQMatMulFloat8<Float8E5M2>({2, 3, 37}, {37, 20}, {}, 1, true, true);
+  // per column scale
+  RunDQMatMulFloat8<Float8E4M3FN>({12, 37}, {37, 20}, {20}, 1, true, true);
+  RunDQMatMulFloat8<Float8E5M2>({12, 37}, {37, 20}, {20}, -1, false, true);
+}
+
+TEST(QDQTransformerTests, DQMatMulNotConvertedToMatMulFloat8_PerRowScale) {
+  // a scale along the reduced axis can't be applied to the output
+  RunDQMatMulFloat8<Float8E4M3FN>({12, 37}, {37, 20}, {37}, 0, false, false);
+}
+
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
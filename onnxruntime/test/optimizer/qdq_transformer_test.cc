@@ -1871,6 +1871,79 @@ TEST(QDQTransformerTests, Where) {
   test_case({1}, {1}, {1}, true /*use_contrib_qdq*/);
 }
 
+TEST(QDQTransformerTests, AttentionConvertedToQAttention) {
+  constexpr int64_t batch_size = 2;
+  constexpr int64_t sequence_length = 3;
+  constexpr int64_t input_hidden_size = 8;
+  constexpr int64_t hidden_size = 8;
+
+  // DQ(input) and DQ(weight) -> Attention -> optional Q -> DQ -> output
+  auto test_case = [&](bool per_column, bool has_mask, bool has_output_q) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>({batch_size, sequence_length, input_hidden_size},
+                                                   std::numeric_limits<uint8_t>::min(),
+                                                   std::numeric_limits<uint8_t>::max());
+      auto* output_arg = builder.MakeOutput();
+
+      auto* dq_input_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .02f, 128, dq_input_output);
+
+      auto* weight = builder.MakeInitializer<int8_t>({input_hidden_size, 3 * hidden_size}, -64, 64);
+      auto* dq_weight_output = builder.MakeIntermediate();
+      if (per_column) {
+        std::vector<float> scales(3 * hidden_size);
+        for (size_t i = 0; i < scales.size(); i++) {
+          scales[i] = .005f * static_cast<float>(i % 4 + 1);
+        }
+        NodeAttributes attrs;
+        utils::SetNodeAttribute(utils::MakeAttribute("axis", int64_t(1)), attrs);
+        builder.AddDequantizeLinearNode<int8_t>(weight, scales, std::vector<int8_t>(scales.size(), 0),
+                                                dq_weight_output, &attrs);
+      } else {
+        builder.AddDequantizeLinearNode<int8_t>(weight, .01f, 0, dq_weight_output);
+      }
+
+      auto* bias = builder.MakeInitializer<float>({3 * hidden_size}, -.5f, .5f);
+      std::vector<NodeArg*> attention_inputs{dq_input_output, dq_weight_output, bias};
+      if (has_mask) {
+        attention_inputs.push_back(builder.MakeInitializer<int32_t>({batch_size}, {2, 3}));
+      }
+
+      auto* attention_output = has_output_q ? builder.MakeIntermediate() : output_arg;
+      Node& attention_node = builder.AddNode("Attention", attention_inputs, {attention_output}, kMSDomain);
+      attention_node.AddAttribute("num_heads", int64_t(2));
+
+      if (has_output_q) {
+        auto* q_output = builder.MakeIntermediate();
+        builder.AddQuantizeLinearNode<uint8_t>(attention_output, .05f, 128, q_output);
+        builder.AddDequantizeLinearNode<uint8_t>(q_output, .05f, 128, output_arg);
+      }
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      const QDQOpKeys qdq_keys = GetQDQOpKeys(false);
+      EXPECT_EQ(op_to_count["com.microsoft.QAttention"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.Attention"], 0);
+      EXPECT_EQ(op_to_count[qdq_keys.quantize_linear], has_output_q ? 1 : 0);
+      EXPECT_EQ(op_to_count[qdq_keys.dequantize_linear], has_output_q ? 1 : 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      1e-4 /*per_sample_tolerance*/,
+                      1e-4 /*relative_per_sample_tolerance*/);
+  };
+
+  test_case(false /*per_column*/, false /*has_mask*/, false /*has_output_q*/);
+  test_case(true /*per_column*/, false /*has_mask*/, false /*has_output_q*/);
+  test_case(false /*per_column*/, true /*has_mask*/, false /*has_output_q*/);
+  test_case(true /*per_column*/, true /*has_mask*/, true /*has_output_q*/);
+}
+
 template <typename QuantType>
 static void RunDropQDQTransposeTestCase(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perms,
                                         bool use_contrib_qdq = false,
@@ -4312,6 +4312,36 @@ TEST(TransposeOptimizerTests, TestOnlyOptimizeTowardsTranspose) {
                     /*opset_version*/ {15, 18});
 }
 
+TEST(TransposeOptimizerTests, TestOptimizeTowardsTransposeBySize) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInputBool(builder, {{10, 4}}, {10, 4});
+    auto* input1_arg = builder.MakeInput<float>({4, 6, 10}, 0.0, 1.0);
+    auto* input2_arg = builder.MakeInput<float>({10, 4}, 0.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* where_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input1_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{1, 2, 0});
+    builder.AddNode("Where", {input0_arg, transpose_1_out_0, input2_arg}, {where_1_out_0});
+    auto& transpose_2 = builder.AddNode("Transpose", {where_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    // By rank, the transposes added on the two rank 2 inputs cost more than the rank 3 transpose that is removed.
+    // By size, they move 80 elements instead of 480, so the Transpose is pushed. Cost 6 -> 4.
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 4);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
 TEST(TransposeOptimizerTests, TestDontOptimizeWrongInput) {
   auto build_test_case_1 = [&](ModelTestBuilder& builder) {
     auto* input0_arg = MakeInput<int32_t>(builder, {{-1, 4, -1, 5}}, {2, 4, 6, 5}, -1, 5);
@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "benchmark_suite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+#include <core/common/common.h>
+#include <core/common/path_string.h>
+#include "nlohmann/json.hpp"
+#include "performance_runner.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+struct SuiteMetric {
+  const char* name;
+  bool higher_is_better;
+};
+
+constexpr SuiteMetric kSuiteMetrics[] = {
+    {"throughput_per_s", true},
+    {"p50_latency_ms", false},
+    {"p99_latency_ms", false},
+    {"peak_working_set_bytes", false},
+    {"session_creation_ms", false},
+};
+
+// The median of the values and their spread, the difference of the largest and smallest ones in percent of the median.
+nlohmann::json Summarize(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  const size_t count = values.size();
+  const double median = count % 2 == 1 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+  const double spread = median > 0 ? (values.back() - values.front()) / median * 100 : 0;
+  return {{"median", median}, {"spread_percent", spread}};
+}
+
+Status BenchmarkModel(Ort::Env& env, const PerformanceTestConfig& config, size_t repeats, std::random_device& rd,
+                      std::map<std::string, std::vector<double>>& samples) {
+  for (size_t i = 0; i < repeats; ++i) {
+    PerformanceRunner perf_runner(env, config, rd);
+    ORT_RETURN_IF_ERROR(perf_runner.Run());
+
+    const PerformanceResult& result = perf_runner.GetResult();
+    ORT_RETURN_IF(result.time_costs.empty(), "no inference was run");
+    std::vector<double> latencies = result.time_costs;
+    std::sort(latencies.begin(), latencies.end());
+    const size_t total = latencies.size();
+    const std::chrono::duration<double> run_time = result.end - result.start;
+
+    samples["throughput_per_s"].push_back(static_cast<double>(total) / run_time.count());
+    samples["p50_latency_ms"].push_back(latencies[static_cast<size_t>(total * 0.5)] * 1000);
+    samples["p99_latency_ms"].push_back(latencies[static_cast<size_t>(total * 0.99)] * 1000);
+    samples["peak_working_set_bytes"].push_back(static_cast<double>(result.peak_workingset_size));
+    samples["session_creation_ms"].push_back(perf_runner.GetSessionCreationDuration().count() * 1000);
+  }
+  return Status::OK();
+}
+
+Status CompareWithBaseline(const std::basic_string<ORTCHAR_T>& baseline_file, const nlohmann::json& results,
+                           double regression_threshold_percent, std::ostream& out, bool& has_regression) {
+  std::ifstream file(baseline_file);
+  ORT_RETURN_IF_NOT(file.good(), "failed to open the suite baseline ", ToUTF8String(baseline_file));
+  const auto baseline = nlohmann::json::parse(file, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(baseline.is_discarded() || !baseline.contains("results") || !baseline["results"].is_array(),
+                "failed to parse the suite baseline ", ToUTF8String(baseline_file));
+
+  std::map<std::pair<std::string, std::string>, const nlohmann::json*> baseline_results;
+  for (const auto& entry : baseline["results"]) {
+    baseline_results[{entry.value("model", ""), entry.value("provider", "")}] = &entry;
+  }
+
+  out << "\nComparison with the baseline " << ToUTF8String(baseline_file) << ":\n";
+  for (const auto& entry : results) {
+    const std::string model = entry["model"];
+    const std::string provider = entry["provider"];
+    const auto it = baseline_results.find({model, provider});
+    if (it == baseline_results.end()) {
+      out << model << " " << provider << ": not in the baseline\n";
+      continue;
+    }
+
+    const nlohmann::json& baseline_entry = *it->second;
+    for (const auto& metric : kSuiteMetrics) {
+      if (!baseline_entry.contains(metric.name)) {
+        continue;
+      }
+      const double baseline_median = baseline_entry[metric.name].value("median", 0.0);
+      const double median = entry[metric.name]["median"];
+      if (baseline_median <= 0) {
+        continue;
+      }
+
+      const double change_percent = (median - baseline_median) / baseline_median * 100;
+      const double regression_percent = metric.higher_is_better ? -change_percent : change_percent;
+      // a change within the noise of the two runs is not significant
+      const double noise_percent = baseline_entry[metric.name].value("spread_percent", 0.0) +
+                                   entry[metric.name].value("spread_percent", 0.0);
+      const bool regressed = regression_percent > std::max(regression_threshold_percent, noise_percent);
+      has_regression = has_regression || regressed;
+
+      out << model << " " << provider << " " << metric.name << ": " << baseline_median << " -> " << median << " ("
+          << (change_percent >= 0 ? "+" : "") << change_percent << "%, noise " << noise_percent << "%)"
+          << (regressed ? " REGRESSION" : "") << "\n";
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+int RunBenchmarkSuite(Ort::Env& env, const PerformanceTestConfig& test_config,
+                      const std::vector<BenchmarkSuiteModel>& models) {
+  const auto available_providers = Ort::GetAvailableProviders();
+  std::random_device rd;
+
+  nlohmann::json results = nlohmann::json::array();
+  for (const auto& model : models) {
+    for (const auto& provider_type : model.provider_types) {
+      if (std::find(available_providers.begin(), available_providers.end(), provider_type) ==
+          available_providers.end()) {
+        std::cout << "Skipping " << model.name << " on " << provider_type << ", which is not available.\n";
+        continue;
+      }
+
+      std::cout << "\nModel: " << model.name << " on " << provider_type << std::endl;
+      PerformanceTestConfig config = model.config;
+      config.machine_config.provider_type_name = provider_type;
+      std::map<std::string, std::vector<double>> samples;
+      const auto status = BenchmarkModel(env, config, test_config.run_config.suite_repeats, rd, samples);
+      if (!status.IsOK()) {
+        fprintf(stderr, "Benchmarking %s on %s failed: %s\n", model.name.c_str(), provider_type.c_str(),
+                status.ErrorMessage().c_str());
+        return -1;
+      }
+
+      nlohmann::json entry = {{"model", model.name},
+                              {"provider", provider_type},
+                              {"repeats", test_config.run_config.suite_repeats}};
+      for (const auto& metric : kSuiteMetrics) {
+        entry[metric.name] = Summarize(samples[metric.name]);
+      }
+      results.push_back(std::move(entry));
+    }
+  }
+
+  const std::string results_json = nlohmann::json{{"results", results}}.dump(2);
+  const auto& result_file_path = test_config.model_info.result_file_path;
+  if (result_file_path.empty()) {
+    std::cout << "\n" << results_json << std::endl;
+  } else {
+    std::ofstream result_file(result_file_path);
+    if (!result_file.good()) {
+      fprintf(stderr, "failed to open the result file '%s'\n", ToUTF8String(result_file_path).c_str());
+      return -1;
+    }
+    result_file << results_json << std::endl;
+  }
+
+  if (test_config.run_config.suite_baseline_file.empty()) {
+    return 0;
+  }
+
+  bool has_regression = false;
+  const auto status = CompareWithBaseline(test_config.run_config.suite_baseline_file, results,
+                                          test_config.run_config.profile_regression_threshold, std::cout,
+                                          has_regression);
+  if (!status.IsOK()) {
+    fprintf(stderr, "%s\n", status.ErrorMessage().c_str());
+    return -1;
+  }
+  return has_regression ? 1 : 0;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+/**
+ * Benchmarks the models of a suite given with -W one after the other, on each of their execution providers available
+ * in the build, test_config.run_config.suite_repeats times each.
+ *
+ * The median over the repeats of the throughput, the p50 and p99 latencies, the peak working set and the session
+ * creation time of each model and execution provider are written as JSON to the result file of test_config, or to
+ * the output, with the spread of the repeats, in percent of the median, as an estimate of their noise. The peak
+ * working set is the one of the process, which includes the models benchmarked before.
+ *
+ * If test_config.run_config.suite_baseline_file is set, the results are compared with those of the baseline file. A
+ * result regresses if it worsens by more than the regression threshold or, if larger, the sum of the spreads of the
+ * result and of its baseline.
+ *
+ * @return 0 on success, 1 if a result regressed, -1 on failure.
+ */
+int RunBenchmarkSuite(Ort::Env& env, const PerformanceTestConfig& test_config,
+                      const std::vector<BenchmarkSuiteModel>& models);
+
+}  // namespace perftest
+}  // namespace onnxruntime
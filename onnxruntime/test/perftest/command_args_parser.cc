@@ -6,6 +6,8 @@
 #include "command_args_parser.h"
 
 #include <string.h>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string_view>
@@ -20,6 +22,7 @@
 #endif
 
 #include <core/graph/constants.h>
+#include <core/common/path_string.h>
 #include <core/platform/path_lib.h>
 #include <core/optimizer/graph_transformer_level.h>
 
@@ -39,6 +42,18 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding. Free dimensions are treated as 1 unless overridden using -f.\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [target_qps]: Run open-loop, issuing requests at the given rate whether or not the previous ones completed,\n"
+      "\t\tfor 'duration' seconds or 'times' requests. The latency of a request includes its queueing, and the -c workers\n"
+      "\t\trun the requests. A comma separated list of rates runs a sweep, e.g. -Q 50,100,200.\n"
+      "\t-a [fixed|poisson]: Arrival process of the open-loop requests. Default:fixed.\n"
+      "\t-L [co-location config file]: Runs the models listed in the file together, in place of the model given on\n"
+      "\t\tthe command line, and reports the latency distribution and the thread pool and allocator statistics of each.\n"
+      "\t\tEach line holds a model path followed by its options, which override the command line ones:\n"
+      "\t\t'qps|<target_qps>' 'intra_op_num_threads|<n>' 'inter_op_num_threads|<n>' 'concurrent_runs|<n>'\n"
+      "\t\t'thread_pool|shared' to use the global thread pools of the environment, sized by -x and -y, in place of\n"
+      "\t\tthread pools of its own, 'result_file|<path>', and any other 'key|value' is a session config entry.\n"
+      "\t\t[Example] model_a.onnx qps|100 thread_pool|shared\n"
+      "\t\t          model_b.onnx qps|20 intra_op_num_threads|4 session.intra_op.allow_spinning|0\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|qnn|snpe|rocm|migraphx|xnnpack|vitisai|webgpu]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'qnn', 'snpe', 'rocm', 'migraphx', 'xnnpack', 'vitisai' or 'webgpu'. "
       "Default:'cpu'.\n"
@@ -46,6 +61,19 @@ namespace perftest {
       "\t-r [repeated_times]: Specifies the repeated times if running in 'times' test mode.Default:1000.\n"
       "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode. Default:600.\n"
       "\t-p [profile_file]: Specifies the profile name to enable profiling and dump the profile data to the file.\n"
+      "\t-B [baseline_profile_file]: Compares the profile of the run, given with -p, with a profile of another build\n"
+      "\t\tor other options, and reports the significant per-node and per-op type latency changes and the kernel\n"
+      "\t\tselection and size changes. Exits with 1 if a latency regresses by more than the -G threshold.\n"
+      "\t-G [regression_threshold]: The latency regression threshold of -B and -K, in percent. Default:10.\n"
+      "\t-W [benchmark suite file]: Benchmarks the models listed in the file one after the other, with the options of\n"
+      "\t\tthe command line, in place of the model given on the command line, and writes their throughput, latency,\n"
+      "\t\tpeak working set and session creation time as JSON to the result file, or to the output without one.\n"
+      "\t\tEach line holds a name, a model path relative to the file and the options of the model: those of -L and\n"
+      "\t\t'providers|<cpu,cuda,...>', the execution providers to benchmark it on, skipped if not available. Default:-e.\n"
+      "\t\t[Example] resnet50 resnet50-v1-12/resnet50-v1-12.onnx providers|cpu,cuda\n"
+      "\t-N [repeats]: The number of times each model of -W is benchmarked, the median is reported. Default:3.\n"
+      "\t-K [suite baseline file]: Compares the results of -W with those of a previous run. Exits with 1 if a result\n"
+      "\t\tregresses by more than the -G threshold or, if larger, by more than the spread of the repeats.\n"
       "\t-s: Show statistics result, like P75, P90. If no result_file provided this defaults to on.\n"
       "\t-S: Given random seed, to produce the same input data. This defaults to -1(no initialize).\n"
       "\t-v: Show verbose information.\n"
@@ -105,6 +133,8 @@ namespace perftest {
       "\t    [QNN only] [enable_htp_spill_fill_buffer]: Enable HTP spill fill buffer, used while generating QNN context binary.\n"
       "\t    [QNN only] [enable_htp_shared_memory_allocator]: Enable the QNN HTP shared memory allocator and use it for inputs and outputs. Requires libcdsprpc.so/dll to be available.\n"
       "\t    Defaults to '0' (disabled).\n"
+      "\t    [QNN only] [context_load_mode]: When the QNN contexts of an EPContext model are loaded: 'eager' (session initialization), \n"
+      "\t    'lazy' (first Run) or 'background' (background thread the first Run waits for). Defaults to 'eager'.\n"
       "\t    [Example] [For QNN EP] -e qnn -i \"backend_type|cpu\" \n"
       "\n"
       "\t    [TensorRT only] [trt_max_partition_iterations]: Maximum iterations for TensorRT parser to get capability.\n"
@@ -121,6 +151,8 @@ namespace perftest {
       "\t    [TensorRT only] [trt_engine_cache_path]: Specify engine cache path.\n"
       "\t    [TensorRT only] [trt_engine_cache_prefix]: Customize engine cache prefix when trt_engine_cache_enable is true.\n"
       "\t    [TensorRT only] [trt_engine_hw_compatible]: Enable hardware compatibility. Engines ending with '_sm80+' can be re-used across all Ampere+ GPU (a hardware-compatible engine may have lower throughput and/or higher latency than its non-hardware-compatible counterpart).\n"
+      "\t    [TensorRT only] [trt_engine_sharing_enable]: Share the engines built for the same subgraph and options on the same GPU across the sessions of the process.\n"
+      "\t    [TensorRT only] [trt_profile_auto_expand]: Widen the implicit optimization profile to power-of-two bounds around the observed input shapes when an engine has to be rebuilt.\n"
       "\t    [TensorRT only] [trt_weight_stripped_engine_enable]: Enable weight-stripped engine build.\n"
       "\t    [TensorRT only] [trt_onnx_model_folder_path]: Folder path for the ONNX model with weights.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
@@ -142,6 +174,7 @@ namespace perftest {
       "\t    [CoreML only] [ProfileComputePlan]:[0 1].\n"
       "\t    [CoreML only] [AllowLowPrecisionAccumulationOnGPU]:[0 1].\n"
       "\t    [CoreML only] [ModelCacheDirectory]:[path../a/b/c].\n"
+      "\t    [CoreML only] [LoadModelInBackground]:[0 1].\n"
       "\t    [Example] [For CoreML EP] -e coreml -i \"ModelFormat|MLProgram MLComputeUnits|CPUAndGPU\"\n"
       "\n"
       "\t    [SNPE only] [runtime]: SNPE runtime, options: 'CPU', 'GPU', 'GPU_FLOAT16', 'DSP', 'AIP_FIXED_TF'. \n"
@@ -187,9 +220,65 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   return true;
 }
 
+static bool ParseTargetQps(const std::string& qps_string, std::vector<double>& target_qps) {
+  std::istringstream ss(qps_string);
+  std::string rate;
+  while (std::getline(ss, rate, ',')) {
+    const double qps = std::strtod(rate.c_str(), nullptr);
+    if (qps <= 0) {
+      return false;
+    }
+    target_qps.push_back(qps);
+  }
+  return !target_qps.empty();
+}
+
+static bool ParseProviderName(const ORTCHAR_T* name, std::string& provider_type_name) {
+  if (!CompareCString(name, ORT_TSTR("cpu"))) {
+    provider_type_name = onnxruntime::kCpuExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("cuda"))) {
+    provider_type_name = onnxruntime::kCudaExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("dnnl"))) {
+    provider_type_name = onnxruntime::kDnnlExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("openvino"))) {
+    provider_type_name = onnxruntime::kOpenVINOExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("tensorrt"))) {
+    provider_type_name = onnxruntime::kTensorrtExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("qnn"))) {
+    provider_type_name = onnxruntime::kQnnExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("snpe"))) {
+    provider_type_name = onnxruntime::kSnpeExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("nnapi"))) {
+    provider_type_name = onnxruntime::kNnapiExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("vsinpu"))) {
+    provider_type_name = onnxruntime::kVSINPUExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("coreml"))) {
+    provider_type_name = onnxruntime::kCoreMLExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("dml"))) {
+    provider_type_name = onnxruntime::kDmlExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("acl"))) {
+    provider_type_name = onnxruntime::kAclExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("armnn"))) {
+    provider_type_name = onnxruntime::kArmNNExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("rocm"))) {
+    provider_type_name = onnxruntime::kRocmExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("migraphx"))) {
+    provider_type_name = onnxruntime::kMIGraphXExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("xnnpack"))) {
+    provider_type_name = onnxruntime::kXnnpackExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("vitisai"))) {
+    provider_type_name = onnxruntime::kVitisAIExecutionProvider;
+  } else if (!CompareCString(name, ORT_TSTR("webgpu"))) {
+    provider_type_name = onnxruntime::kWebGpuExecutionProvider;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlR:"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:Q:a:L:B:G:W:N:K:AMPIDZvhsqznlR:"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -228,43 +317,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
         test_config.run_config.enable_cpu_mem_arena = false;
         break;
       case 'e':
-        if (!CompareCString(optarg, ORT_TSTR("cpu"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kCpuExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("cuda"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kCudaExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("dnnl"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kDnnlExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("openvino"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kOpenVINOExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("tensorrt"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kTensorrtExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("qnn"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kQnnExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("snpe"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kSnpeExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("nnapi"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kNnapiExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("vsinpu"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kVSINPUExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("coreml"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kCoreMLExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("dml"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kDmlExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("acl"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kAclExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("armnn"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kArmNNExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("rocm"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kRocmExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("migraphx"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kMIGraphXExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("xnnpack"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kXnnpackExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("vitisai"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kVitisAIExecutionProvider;
-        } else if (!CompareCString(optarg, ORT_TSTR("webgpu"))) {
-          test_config.machine_config.provider_type_name = onnxruntime::kWebGpuExecutionProvider;
-        } else {
+        if (!ParseProviderName(optarg, test_config.machine_config.provider_type_name)) {
           return false;
         }
         break;
@@ -314,6 +367,44 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           return false;
         }
         break;
+      case 'Q':
+        if (!ParseTargetQps(ToUTF8String(optarg), test_config.run_config.target_qps)) {
+          return false;
+        }
+        break;
+      case 'L':
+        test_config.run_config.co_location_config_path = optarg;
+        break;
+      case 'B':
+        test_config.run_config.baseline_profile_file = optarg;
+        break;
+      case 'W':
+        test_config.run_config.benchmark_suite_path = optarg;
+        break;
+      case 'N':
+        test_config.run_config.suite_repeats = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.suite_repeats == 0) {
+          return false;
+        }
+        break;
+      case 'K':
+        test_config.run_config.suite_baseline_file = optarg;
+        break;
+      case 'G':
+        test_config.run_config.profile_regression_threshold = std::strtod(ToUTF8String(optarg).c_str(), nullptr);
+        if (test_config.run_config.profile_regression_threshold < 0) {
+          return false;
+        }
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("fixed"))) {
+          test_config.run_config.poisson_arrivals = false;
+        } else if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.poisson_arrivals = true;
+        } else {
+          return false;
+        }
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
@@ -398,6 +489,19 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   argc -= optind;
   argv += optind;
 
+  // the co-located models are listed in the config file
+  if (!test_config.run_config.co_location_config_path.empty()) {
+    return argc == 0;
+  }
+
+  // the benchmarked models are listed in the suite file, which may be followed by the result file
+  if (!test_config.run_config.benchmark_suite_path.empty()) {
+    if (argc == 1) {
+      test_config.model_info.result_file_path = argv[0];
+    }
+    return argc <= 1;
+  }
+
   switch (argc) {
     case 2:
       test_config.model_info.result_file_path = argv[1];
@@ -414,5 +518,158 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   return true;
 }
 
+// Applies the options of a model of a co-location config or of a benchmark suite to its config.
+static bool ApplyModelOptions(const std::string& model_path, const std::unordered_map<std::string, std::string>& options,
+                              PerformanceTestConfig& model_config) {
+  for (const auto& [key, value] : options) {
+    auto& run_config = model_config.run_config;
+    if (key == "qps") {
+      run_config.target_qps.clear();
+      if (!ParseTargetQps(value, run_config.target_qps)) {
+        return false;
+      }
+    } else if (key == "intra_op_num_threads") {
+      run_config.intra_op_num_threads = std::stoi(value);
+    } else if (key == "inter_op_num_threads") {
+      run_config.inter_op_num_threads = std::stoi(value);
+    } else if (key == "concurrent_runs") {
+      run_config.concurrent_session_runs = static_cast<size_t>(std::stoi(value));
+      if (run_config.concurrent_session_runs == 0) {
+        return false;
+      }
+    } else if (key == "thread_pool") {
+      if (value != "shared" && value != "separate") {
+        fprintf(stderr, "thread_pool of %s must be 'shared' or 'separate'\n", model_path.c_str());
+        return false;
+      }
+      run_config.use_global_thread_pools = value == "shared";
+    } else if (key == "result_file") {
+      model_config.model_info.result_file_path = ToPathString(value);
+    } else {
+      run_config.session_config_entries[key] = value;
+    }
+  }
+  return true;
+}
+
+/*static*/ bool CommandLineParser::ParseCoLocationConfig(const PerformanceTestConfig& test_config,
+                                                        std::vector<PerformanceTestConfig>& model_configs) {
+  std::ifstream config_file(test_config.run_config.co_location_config_path);
+  if (!config_file.good()) {
+    fprintf(stderr, "failed to open the co-location config file '%s'\n",
+            ToUTF8String(test_config.run_config.co_location_config_path).c_str());
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(config_file, line)) {
+    std::istringstream ss(line);
+    std::string model_path;
+    if (!(ss >> model_path) || model_path[0] == '#') {
+      continue;
+    }
+
+    std::string options_string;
+    std::getline(ss, options_string);
+    std::unordered_map<std::string, std::string> options;
+    ORT_TRY {
+      ParseSessionConfigs(options_string, options);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        fprintf(stderr, "Error parsing the options of %s: %s\n", model_path.c_str(), ex.what());
+      });
+      return false;
+    }
+
+    PerformanceTestConfig model_config = test_config;
+    model_config.model_info.model_file_path = ToPathString(model_path);
+    model_config.run_config.f_dump_statistics = true;
+    if (!ApplyModelOptions(model_path, options, model_config)) {
+      return false;
+    }
+
+    model_configs.push_back(std::move(model_config));
+  }
+
+  if (model_configs.empty()) {
+    fprintf(stderr, "the co-location config file lists no model\n");
+    return false;
+  }
+
+  return true;
+}
+
+/*static*/ bool CommandLineParser::ParseBenchmarkSuite(const PerformanceTestConfig& test_config,
+                                                      std::vector<BenchmarkSuiteModel>& models) {
+  const std::filesystem::path suite_path(test_config.run_config.benchmark_suite_path);
+  std::ifstream suite_file(suite_path);
+  if (!suite_file.good()) {
+    fprintf(stderr, "failed to open the benchmark suite file '%s'\n", suite_path.string().c_str());
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(suite_file, line)) {
+    std::istringstream ss(line);
+    std::string name;
+    std::string model_path;
+    if (!(ss >> name) || name[0] == '#') {
+      continue;
+    }
+    if (!(ss >> model_path)) {
+      fprintf(stderr, "the model %s of the benchmark suite has no model path\n", name.c_str());
+      return false;
+    }
+
+    std::string options_string;
+    std::getline(ss, options_string);
+    std::unordered_map<std::string, std::string> options;
+    ORT_TRY {
+      ParseSessionConfigs(options_string, options);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        fprintf(stderr, "Error parsing the options of %s: %s\n", name.c_str(), ex.what());
+      });
+      return false;
+    }
+
+    BenchmarkSuiteModel& model = models.emplace_back();
+    model.name = name;
+    model.config = test_config;
+    model.config.model_info.model_file_path = (suite_path.parent_path() / model_path).native();
+    model.config.model_info.result_file_path.clear();
+    model.config.run_config.f_dump_statistics = false;
+
+    const auto providers = options.find("providers");
+    if (providers != options.end()) {
+      std::istringstream providers_ss(providers->second);
+      std::string provider;
+      while (std::getline(providers_ss, provider, ',')) {
+        if (!ParseProviderName(ToPathString(provider).c_str(), model.provider_types.emplace_back())) {
+          fprintf(stderr, "unknown execution provider %s of %s\n", provider.c_str(), name.c_str());
+          return false;
+        }
+      }
+      options.erase(providers);
+    }
+    if (model.provider_types.empty()) {
+      model.provider_types.push_back(test_config.machine_config.provider_type_name);
+    }
+
+    if (!ApplyModelOptions(name, options, model.config)) {
+      return false;
+    }
+  }
+
+  if (models.empty()) {
+    fprintf(stderr, "the benchmark suite file lists no model\n");
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace perftest
 }  // namespace onnxruntime
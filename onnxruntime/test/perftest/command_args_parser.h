@@ -2,17 +2,24 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <vector>
 #include <core/session/onnxruntime_c_api.h>
 
 namespace onnxruntime {
 namespace perftest {
 
 struct PerformanceTestConfig;
+struct BenchmarkSuiteModel;
 
 class CommandLineParser {
  public:
   static void ShowUsage();
   static bool ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]);
+  // Parses the config file given with -L into the config of each co-located model, based on test_config.
+  static bool ParseCoLocationConfig(const PerformanceTestConfig& test_config,
+                                    std::vector<PerformanceTestConfig>& model_configs);
+  // Parses the benchmark suite file given with -W into the config of each model, based on test_config.
+  static bool ParseBenchmarkSuite(const PerformanceTestConfig& test_config, std::vector<BenchmarkSuiteModel>& models);
 };
 
 }  // namespace perftest
@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 // onnxruntime dependencies
+#include <core/common/path_string.h>
 #include <core/session/onnxruntime_c_api.h>
+#include <algorithm>
 #include <random>
+#include <thread>
+#include "benchmark_suite.h"
 #include "command_args_parser.h"
 #include "performance_runner.h"
 #include <google/protobuf/stubs/common.h>
@@ -11,6 +15,41 @@
 using namespace onnxruntime;
 const OrtApi* g_ort = NULL;
 
+// Runs the models of the co-location config together, in the same process, and reports the results of each.
+static int RunCoLocatedModels(Ort::Env& env, const std::vector<perftest::PerformanceTestConfig>& model_configs) {
+  std::random_device rd;
+  std::vector<std::unique_ptr<perftest::PerformanceRunner>> perf_runners;
+  for (const auto& model_config : model_configs) {
+    perf_runners.push_back(std::make_unique<perftest::PerformanceRunner>(env, model_config, rd));
+  }
+
+  std::vector<Status> statuses(perf_runners.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < perf_runners.size(); ++i) {
+    threads.emplace_back([&perf_runners, &statuses, i]() { statuses[i] = perf_runners[i]->Run(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int retval = 0;
+  for (size_t i = 0; i < perf_runners.size(); ++i) {
+    std::cout << "\nModel: " << ToUTF8String(model_configs[i].model_info.model_file_path) << std::endl;
+    if (!statuses[i].IsOK()) {
+      printf("Run failed:%s\n", statuses[i].ErrorMessage().c_str());
+      retval = -1;
+      continue;
+    }
+
+    perf_runners[i]->SerializeResult();
+    // the models sharing the global thread pools or the allocators of the environment report the same ones
+    std::cout << "Thread pool stats: " << perf_runners[i]->GetThreadPoolStats() << "\n"
+              << "Allocator stats: " << perf_runners[i]->GetAllocatorStats() << std::endl;
+  }
+
+  return retval;
+}
+
 #ifdef _WIN32
 int real_main(int argc, wchar_t* argv[]) {
 #else
@@ -22,6 +61,21 @@ int real_main(int argc, char* argv[]) {
     perftest::CommandLineParser::ShowUsage();
     return -1;
   }
+  std::vector<perftest::PerformanceTestConfig> model_configs;
+  if (!test_config.run_config.co_location_config_path.empty() &&
+      !perftest::CommandLineParser::ParseCoLocationConfig(test_config, model_configs)) {
+    return -1;
+  }
+  std::vector<perftest::BenchmarkSuiteModel> suite_models;
+  if (!test_config.run_config.benchmark_suite_path.empty() &&
+      !perftest::CommandLineParser::ParseBenchmarkSuite(test_config, suite_models)) {
+    return -1;
+  }
+  const bool use_global_thread_pools =
+      std::any_of(model_configs.begin(), model_configs.end(), [](const perftest::PerformanceTestConfig& config) {
+        return config.run_config.use_global_thread_pools;
+      });
+
   Ort::Env env{nullptr};
   {
     bool failed = false;
@@ -29,7 +83,15 @@ int real_main(int argc, char* argv[]) {
       OrtLoggingLevel logging_level = test_config.run_config.f_verbose
                                           ? ORT_LOGGING_LEVEL_VERBOSE
                                           : ORT_LOGGING_LEVEL_WARNING;
-      env = Ort::Env(logging_level, "Default");
+      if (use_global_thread_pools) {
+        Ort::ThreadingOptions threading_options;
+        threading_options.SetGlobalIntraOpNumThreads(test_config.run_config.intra_op_num_threads);
+        threading_options.SetGlobalInterOpNumThreads(test_config.run_config.inter_op_num_threads);
+        threading_options.SetGlobalSpinControl(test_config.run_config.disable_spinning ? 0 : 1);
+        env = Ort::Env(threading_options, logging_level, "Default");
+      } else {
+        env = Ort::Env(logging_level, "Default");
+      }
     }
     ORT_CATCH(const Ort::Exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -41,6 +103,13 @@ int real_main(int argc, char* argv[]) {
     if (failed)
       return -1;
   }
+  if (!model_configs.empty()) {
+    return RunCoLocatedModels(env, model_configs);
+  }
+  if (!suite_models.empty()) {
+    return perftest::RunBenchmarkSuite(env, test_config, suite_models);
+  }
+
   std::random_device rd;
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
 
@@ -58,6 +127,11 @@ int real_main(int argc, char* argv[]) {
 
   perf_runner.SerializeResult();
 
+  if (perf_runner.HasProfileRegression()) {
+    printf("The profile regressed compared with the baseline profile\n");
+    return 1;
+  }
+
   return 0;
 }
 
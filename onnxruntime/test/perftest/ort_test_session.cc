@@ -52,6 +52,10 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
   return duration_seconds;
 }
 
+std::basic_string<ORTCHAR_T> OnnxRuntimeTestSession::EndProfiling() {
+  return ToPathString(std::string(session_.EndProfilingAllocated(allocator_).get()));
+}
+
 OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device& rd,
                                                const PerformanceTestConfig& performance_test_config,
                                                const TestModelInfo& m)
@@ -204,7 +208,7 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
                          "qnn_saver_path", "htp_graph_finalization_optimization_mode", "qnn_context_priority",
                          "htp_arch", "enable_htp_fp16_precision", "offload_graph_io_quantization",
                          "enable_htp_spill_fill_buffer", "enable_htp_shared_memory_allocator", "dump_json_qnn_graph",
-                         "json_qnn_graph_dir"});
+                         "json_qnn_graph_dir", "context_load_mode"});
     for (const auto& provider_option : provider_options) {
       const std::string& key = provider_option.first;
       const std::string& value = provider_option.second;
@@ -247,6 +251,11 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         if (supported_qnn_context_priority.find(value) == supported_qnn_context_priority.end()) {
           ORT_THROW("Supported qnn_context_priority: low, normal, normal_high, high");
         }
+      } else if (key == "context_load_mode") {
+        std::set<std::string> supported_context_load_modes = {"eager", "lazy", "background"};
+        if (supported_context_load_modes.find(value) == supported_context_load_modes.end()) {
+          ORT_THROW("Supported context_load_mode: eager, lazy, background");
+        }
       } else if (key == "htp_arch") {
         std::set<std::string> supported_htp_archs = {"0", "68", "69", "73", "75"};
         if (supported_htp_archs.find(value) == supported_htp_archs.end()) {
@@ -362,7 +371,8 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
                                                                    kCoremlProviderOption_SpecializationStrategy,
                                                                    kCoremlProviderOption_ProfileComputePlan,
                                                                    kCoremlProviderOption_AllowLowPrecisionAccumulationOnGPU,
-                                                                   kCoremlProviderOption_ModelCacheDirectory};
+                                                                   kCoremlProviderOption_ModelCacheDirectory,
+                                                                   kCoremlProviderOption_LoadModelInBackground};
     ParseSessionConfigs(ov_string, provider_options, available_keys);
 
     std::unordered_map<std::string, std::string> available_options = {
@@ -387,6 +397,8 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
       } else if (provider_option.first == kCoremlProviderOption_AllowLowPrecisionAccumulationOnGPU &&
                  (provider_option.second == "0" || provider_option.second == "1")) {
       } else if (provider_option.first == kCoremlProviderOption_ModelCacheDirectory) {
+      } else if (provider_option.first == kCoremlProviderOption_LoadModelInBackground &&
+                 (provider_option.second == "0" || provider_option.second == "1")) {
       } else {
         ORT_THROW("Invalid value for option ", provider_option.first, ": ", provider_option.second);
       }
@@ -582,7 +594,10 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
     }
   };
 
-  if (performance_test_config.run_config.intra_op_num_threads > 0) {
+  if (performance_test_config.run_config.use_global_thread_pools) {
+    fprintf(stdout, "Using the global thread pools\n");
+    session_options.DisablePerSessionThreads();
+  } else if (performance_test_config.run_config.intra_op_num_threads > 0) {
     fprintf(stdout, "Setting intra_op_num_threads to %d\n", performance_test_config.run_config.intra_op_num_threads);
     session_options.SetIntraOpNumThreads(performance_test_config.run_config.intra_op_num_threads);
   }
@@ -31,6 +31,16 @@ class OnnxRuntimeTestSession : public TestSession {
 
   std::chrono::duration<double> Run() override;
 
+  std::string GetThreadPoolStats() const override {
+    return session_.GetThreadPoolStatsAllocated(allocator_).get();
+  }
+
+  std::string GetAllocatorStats() const override {
+    return session_.GetAllocatorStatsAllocated(allocator_).get();
+  }
+
+  std::basic_string<ORTCHAR_T> EndProfiling() override;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
@@ -7,11 +7,16 @@
 #endif
 
 #include "performance_runner.h"
+#include <algorithm>
+#include <condition_variable>
 #include <iostream>
+#include <random>
+#include <thread>
 
 #include "TestCase.h"
 #include "utils.h"
 #include "ort_test_session.h"
+#include "profile_diff.h"
 using onnxruntime::Status;
 
 // TODO: Temporary, while we bring up the threadpool impl...
@@ -131,15 +136,19 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (!performance_test_config_.run_config.target_qps.empty()) {
+    ORT_RETURN_IF_ERROR(OpenLoopTest());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -147,8 +156,10 @@ Status PerformanceRunner::Run() {
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
 
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
-  // TODO: end profiling
-  // if (!performance_test_config_.run_config.profile_file.empty()) session_object->EndProfiling();
+  std::basic_string<ORTCHAR_T> profile;
+  if (!performance_test_config_.run_config.profile_file.empty()) {
+    profile = session_->EndProfiling();
+  }
   auto first_inference_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(initial_inference_result_.end - initial_inference_result_.start).count();
   std::chrono::duration<double> inference_duration = performance_result_.end - performance_result_.start;
@@ -165,6 +176,14 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (!performance_test_config_.run_config.baseline_profile_file.empty()) {
+    ORT_RETURN_IF(profile.empty(), "comparing with a baseline profile requires profiling the run with -p.");
+    ProfileDiffOptions options;
+    options.regression_threshold_percent = performance_test_config_.run_config.profile_regression_threshold;
+    ORT_RETURN_IF_ERROR(CompareProfiles(performance_test_config_.run_config.baseline_profile_file, profile, options,
+                                        std::cout, has_profile_regression_));
+  }
+
   return Status::OK();
 }
 
@@ -255,6 +274,100 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::OpenLoopTest() {
+  const auto& run_config = performance_test_config_.run_config;
+
+  std::cout << "Open-loop test with " << (run_config.poisson_arrivals ? "poisson" : "fixed rate") << " arrivals and "
+            << run_config.concurrent_session_runs << " worker(s)\n"
+            << "target_qps,achieved_qps,requests,p50_latency_ms,p90_latency_ms,p99_latency_ms,p999_latency_ms"
+            << std::endl;
+
+  for (double target_qps : run_config.target_qps) {
+    std::vector<double> latencies;
+    const auto start = std::chrono::high_resolution_clock::now();
+    ORT_RETURN_IF_ERROR(RunOpenLoop(target_qps, latencies));
+    const std::chrono::duration<double> run_time = std::chrono::high_resolution_clock::now() - start;
+
+    std::vector<double> sorted_latencies = latencies;
+    std::sort(sorted_latencies.begin(), sorted_latencies.end());
+    auto percentile_ms = [&sorted_latencies](double percentile) {
+      if (sorted_latencies.empty()) {
+        return 0.0;
+      }
+      const auto index = static_cast<size_t>(sorted_latencies.size() * percentile);
+      return sorted_latencies[std::min(index, sorted_latencies.size() - 1)] * 1000;
+    };
+
+    std::cout << target_qps << "," << latencies.size() / run_time.count() << "," << latencies.size() << ","
+              << percentile_ms(0.5) << "," << percentile_ms(0.9) << "," << percentile_ms(0.99) << ","
+              << percentile_ms(0.999) << std::endl;
+
+    // the result holds the latencies of all the rates of a sweep
+    for (double latency : latencies) {
+      performance_result_.time_costs.push_back(latency);
+      performance_result_.total_time_cost += latency;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop(double target_qps, std::vector<double>& latencies) {
+  const auto& run_config = performance_test_config_.run_config;
+  using clock = std::chrono::high_resolution_clock;
+
+  // the workers run the requests, which queue up when they are all busy
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  std::mutex m;
+  std::condition_variable cv;
+  size_t pending = 0;
+
+  std::mt19937 generator(run_config.random_seed_for_input_data >= 0
+                             ? static_cast<std::mt19937::result_type>(run_config.random_seed_for_input_data)
+                             : std::random_device{}());
+  std::exponential_distribution<double> poisson_interval(target_qps);
+  const std::chrono::duration<double> fixed_interval(1.0 / target_qps);
+  const std::chrono::duration<double> duration(static_cast<double>(run_config.duration_in_seconds));
+
+  const auto start = clock::now();
+  auto arrival = start;
+  for (size_t requests = 0;; ++requests) {
+    if (run_config.test_mode == TestMode::KFixRepeatedTimesMode ? requests >= run_config.repeated_times
+                                                                 : arrival - start >= duration) {
+      break;
+    }
+
+    std::this_thread::sleep_until(arrival);
+    {
+      std::lock_guard<std::mutex> lg(m);
+      ++pending;
+    }
+
+    // the latency is measured from the time the request was due, so a late issue doesn't hide queueing
+    tpool->Schedule([this, arrival, &latencies, &m, &cv, &pending]() {
+      std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+      auto status = RunSession(duration_seconds);
+      if (!status.IsOK())
+        std::cerr << status.ErrorMessage();
+      const std::chrono::duration<double> latency = clock::now() - arrival;
+
+      std::lock_guard<std::mutex> lg(m);
+      latencies.push_back(latency.count());
+      --pending;
+      cv.notify_all();
+    });
+
+    arrival += std::chrono::duration_cast<clock::duration>(
+        run_config.poisson_arrivals ? std::chrono::duration<double>(poisson_interval(generator)) : fixed_interval);
+  }
+
+  // Join
+  std::unique_lock<std::mutex> lock(m);
+  cv.wait(lock, [&pending]() { return pending == 0; });
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
@@ -48,8 +48,18 @@ class PerformanceRunner {
 
   void LogSessionCreationTime();
 
+  inline std::chrono::duration<double> GetSessionCreationDuration() const {
+    return session_create_end_ - session_create_start_;
+  }
+
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
+  // Whether the profile of the run regressed compared with the baseline profile.
+  inline bool HasProfileRegression() const { return has_profile_regression_; }
+
+  inline std::string GetThreadPoolStats() const { return session_->GetThreadPoolStats(); }
+  inline std::string GetAllocatorStats() const { return session_->GetAllocatorStats(); }
+
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
@@ -59,10 +69,7 @@ class PerformanceRunner {
  private:
   bool Initialize();
 
-  template <bool isWarmup>
-  Status RunOneIteration() {
-    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
-
+  Status RunSession(std::chrono::duration<double>& duration_seconds) {
     auto status = Status::OK();
     ORT_TRY {
       duration_seconds = session_->Run();
@@ -72,7 +79,13 @@ class PerformanceRunner {
         status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
       });
     }
-    ORT_RETURN_IF_ERROR(status);
+    return status;
+  }
+
+  template <bool isWarmup>
+  Status RunOneIteration() {
+    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+    ORT_RETURN_IF_ERROR(RunSession(duration_seconds));
 
     if (!isWarmup) {
       std::lock_guard<std::mutex> guard(results_mutex_);
@@ -90,6 +103,9 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status OpenLoopTest();
+  // Issues the requests at target_qps and records the latency of each request, from the time it was due to be issued.
+  Status RunOpenLoop(double target_qps, std::vector<double>& latencies);
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -117,6 +133,7 @@ class PerformanceRunner {
   std::unique_ptr<ITestCase> test_case_;
 
   std::mutex results_mutex_;
+  bool has_profile_regression_{false};
 };
 }  // namespace perftest
 }  // namespace onnxruntime
@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "profile_diff.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string_view>
+
+#include <core/common/common.h>
+#include <core/common/path_string.h>
+#include "nlohmann/json.hpp"
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+constexpr const char* kKernelTimeSuffix = "_kernel_time";
+
+struct LatencySamples {
+  double sum{0};
+  double sum_of_squares{0};
+  size_t count{0};
+
+  void Add(double latency) {
+    sum += latency;
+    sum_of_squares += latency * latency;
+    ++count;
+  }
+
+  double Mean() const { return count > 0 ? sum / count : 0; }
+
+  double Variance() const {
+    return count > 1 ? std::max(0.0, (sum_of_squares - sum * sum / count) / (count - 1)) : 0;
+  }
+};
+
+struct NodeProfile {
+  std::string op_type;
+  std::string provider;
+  LatencySamples latency;
+  // the largest sizes over the runs, in bytes, which vary with the input shapes
+  int64_t activation_size{0};
+  int64_t parameter_size{0};
+  int64_t output_size{0};
+};
+
+struct Profile {
+  std::map<std::string, NodeProfile> nodes;
+  std::map<std::string, LatencySamples> op_types;
+};
+
+int64_t GetSizeArg(const nlohmann::json& args, const char* name) {
+  const auto it = args.find(name);
+  return it != args.end() && it->is_string() ? std::strtoll(it->get<std::string>().c_str(), nullptr, 10) : 0;
+}
+
+std::string GetStringArg(const nlohmann::json& args, const char* name) {
+  const auto it = args.find(name);
+  return it != args.end() && it->is_string() ? it->get<std::string>() : std::string();
+}
+
+Status LoadProfile(const std::basic_string<ORTCHAR_T>& path, Profile& profile) {
+  std::ifstream file(path);
+  ORT_RETURN_IF_NOT(file.good(), "failed to open the profile ", ToUTF8String(path));
+
+  const auto events = nlohmann::json::parse(file, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(events.is_discarded() || !events.is_array(), "failed to parse the profile ", ToUTF8String(path));
+
+  const std::string_view suffix(kKernelTimeSuffix);
+  for (const auto& event : events) {
+    if (!event.is_object() || event.value("cat", "") != "Node") {
+      continue;
+    }
+
+    const std::string name = event.value("name", "");
+    if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+      continue;
+    }
+
+    const auto args = event.value("args", nlohmann::json::object());
+    auto& node = profile.nodes[name.substr(0, name.size() - suffix.size())];
+    node.op_type = GetStringArg(args, "op_name");
+    node.provider = GetStringArg(args, "provider");
+    node.activation_size = std::max(node.activation_size, GetSizeArg(args, "activation_size"));
+    node.parameter_size = std::max(node.parameter_size, GetSizeArg(args, "parameter_size"));
+    node.output_size = std::max(node.output_size, GetSizeArg(args, "output_size"));
+
+    const double latency = event.value("dur", 0.0);
+    node.latency.Add(latency);
+    profile.op_types[node.op_type].Add(latency);
+  }
+
+  ORT_RETURN_IF(profile.nodes.empty(), "the profile ", ToUTF8String(path), " holds no kernel event");
+  return Status::OK();
+}
+
+// Welch's t-test of the difference of the mean latencies, with the normal approximation of the t distribution.
+bool IsSignificant(const LatencySamples& baseline, const LatencySamples& current, double significance_z) {
+  if (baseline.count < 2 || current.count < 2) {
+    return false;
+  }
+
+  const double difference = std::abs(current.Mean() - baseline.Mean());
+  const double standard_error = std::sqrt(baseline.Variance() / baseline.count + current.Variance() / current.count);
+  return standard_error > 0 ? difference / standard_error > significance_z : difference > 0;
+}
+
+// Writes a significant latency change and returns whether it's a regression.
+bool ReportLatencyChange(const char* kind, const std::string& name, const LatencySamples& baseline,
+                         const LatencySamples& current, const ProfileDiffOptions& options, std::ostream& out) {
+  const double change_us = current.Mean() - baseline.Mean();
+  if (std::abs(change_us) < options.min_latency_change_us ||
+      !IsSignificant(baseline, current, options.significance_z)) {
+    return false;
+  }
+
+  const double change_percent = baseline.Mean() > 0 ? change_us / baseline.Mean() * 100 : 100;
+  const bool is_regression = change_percent > options.regression_threshold_percent;
+  out << "  " << kind << " " << name << ": " << baseline.Mean() << " us -> " << current.Mean() << " us ("
+      << (change_percent > 0 ? "+" : "") << change_percent << "%)" << (is_regression ? " REGRESSION" : "") << "\n";
+  return is_regression;
+}
+
+void ReportSizeChange(const std::string& node_name, const char* size_name, int64_t baseline, int64_t current,
+                      std::ostream& out) {
+  if (baseline != current) {
+    out << "  " << node_name << " " << size_name << ": " << baseline << " -> " << current << " bytes\n";
+  }
+}
+
+}  // namespace
+
+Status CompareProfiles(const std::basic_string<ORTCHAR_T>& baseline_profile,
+                       const std::basic_string<ORTCHAR_T>& profile, const ProfileDiffOptions& options,
+                       std::ostream& out, bool& has_regression) {
+  Profile baseline;
+  Profile current;
+  ORT_RETURN_IF_ERROR(LoadProfile(baseline_profile, baseline));
+  ORT_RETURN_IF_ERROR(LoadProfile(profile, current));
+
+  has_regression = false;
+  out << "Profile diff of " << ToUTF8String(profile) << " against " << ToUTF8String(baseline_profile) << "\n";
+
+  out << "Node latency changes:\n";
+  for (const auto& [name, node] : current.nodes) {
+    if (auto it = baseline.nodes.find(name); it != baseline.nodes.end()) {
+      has_regression |= ReportLatencyChange("node", name, it->second.latency, node.latency, options, out);
+    }
+  }
+
+  out << "Op type latency changes:\n";
+  for (const auto& [op_type, latency] : current.op_types) {
+    if (auto it = baseline.op_types.find(op_type); it != baseline.op_types.end()) {
+      has_regression |= ReportLatencyChange("op type", op_type, it->second, latency, options, out);
+    }
+  }
+
+  out << "Kernel selection changes:\n";
+  for (const auto& [name, node] : current.nodes) {
+    auto it = baseline.nodes.find(name);
+    if (it == baseline.nodes.end()) {
+      out << "  " << name << ": added, " << node.op_type << " on " << node.provider << "\n";
+    } else if (it->second.op_type != node.op_type || it->second.provider != node.provider) {
+      out << "  " << name << ": " << it->second.op_type << " on " << it->second.provider << " -> "
+          << node.op_type << " on " << node.provider << "\n";
+    }
+  }
+  for (const auto& [name, node] : baseline.nodes) {
+    if (current.nodes.count(name) == 0) {
+      out << "  " << name << ": removed, " << node.op_type << " on " << node.provider << "\n";
+    }
+  }
+
+  out << "Size changes:\n";
+  for (const auto& [name, node] : current.nodes) {
+    if (auto it = baseline.nodes.find(name); it != baseline.nodes.end()) {
+      ReportSizeChange(name, "activation_size", it->second.activation_size, node.activation_size, out);
+      ReportSizeChange(name, "parameter_size", it->second.parameter_size, node.parameter_size, out);
+      ReportSizeChange(name, "output_size", it->second.output_size, node.output_size, out);
+    }
+  }
+
+  out << (has_regression ? "Latency regressions over " : "No latency regression over ")
+      << options.regression_threshold_percent << "%" << std::endl;
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
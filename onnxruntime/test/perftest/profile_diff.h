@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include <core/common/status.h>
+#include <core/session/onnxruntime_c_api.h>
+
+namespace onnxruntime {
+namespace perftest {
+
+struct ProfileDiffOptions {
+  // The relative latency increase of a node or an op type, in percent, over which a significant change is a
+  // regression.
+  double regression_threshold_percent{10.0};
+  // Latency changes smaller than this, in microseconds, are ignored as noise.
+  double min_latency_change_us{5.0};
+  // The z score over which the difference of the mean latencies is significant (Welch's t-test, normal approximation).
+  double significance_z{2.576};
+};
+
+/**
+ * Compares the profile written by the session profiler (see core/common/profiler.cc) with a baseline profile, e.g.
+ * of another build or of other session options.
+ *
+ * The kernel events of each profile are aligned by node name and compared for the significant changes of the latency
+ * of each node and op type, the changes of the op type and execution provider of the kernel selected for a node, and
+ * the changes of the input and output sizes of a node. The changes are written to out.
+ *
+ * @param has_regression is set if a latency regression exceeds the threshold of options.
+ */
+Status CompareProfiles(const std::basic_string<ORTCHAR_T>& baseline_profile,
+                       const std::basic_string<ORTCHAR_T>& profile, const ProfileDiffOptions& options,
+                       std::ostream& out, bool& has_regression);
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -43,6 +44,22 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // Request rates of the open-loop test, which runs once per rate. Requests are issued closed-loop when empty.
+  std::vector<double> target_qps;
+  bool poisson_arrivals{false};
+  // The models to run together, each with its own options, in place of the model given on the command line.
+  std::basic_string<ORTCHAR_T> co_location_config_path;
+  // Run on the global thread pools of the environment in place of the thread pools of the session.
+  bool use_global_thread_pools{false};
+  // The profile to compare the profile of the run given with -p with.
+  std::basic_string<ORTCHAR_T> baseline_profile_file;
+  double profile_regression_threshold{10.0};
+  // The models to benchmark one after the other with the options of the command line, in place of the model given on
+  // the command line, their results are compared with suite_baseline_file if given.
+  std::basic_string<ORTCHAR_T> benchmark_suite_path;
+  std::basic_string<ORTCHAR_T> suite_baseline_file;
+  // Number of times each model of the suite is benchmarked, to estimate the noise of its results.
+  size_t suite_repeats{3};
   bool f_dump_statistics{false};
   int random_seed_for_input_data{-1};
   bool f_verbose{false};
@@ -74,5 +91,13 @@ struct PerformanceTestConfig {
   RunConfig run_config;
 };
 
+// A model of the benchmark suite given with -W.
+struct BenchmarkSuiteModel {
+  std::string name;
+  PerformanceTestConfig config;
+  // The execution providers to benchmark the model on. Those not available in the build are skipped.
+  std::vector<std::string> provider_types;
+};
+
 }  // namespace perftest
 }  // namespace onnxruntime
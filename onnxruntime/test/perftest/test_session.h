@@ -3,6 +3,7 @@
 
 #pragma once
 #include <stdlib.h>
+#include <string>
 
 #include "OrtValueList.h"
 
@@ -16,6 +17,11 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
+  // The statistics of the thread pools and of the allocators used by the session, as JSON, empty if not collected.
+  virtual std::string GetThreadPoolStats() const { return {}; }
+  virtual std::string GetAllocatorStats() const { return {}; }
+  // Ends the profiling of the session and returns the path of the profile, empty if not profiling.
+  virtual std::basic_string<ORTCHAR_T> EndProfiling() { return {}; }
 
   virtual ~TestSession() = default;
 };
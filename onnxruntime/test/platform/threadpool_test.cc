@@ -12,11 +12,18 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
+#include <atomic>
 #include <memory>
 #include <functional>
+#include <optional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace onnxruntime::concurrency;
@@ -510,6 +517,236 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+// Test parallel loops started from within the body of other parallel loops on the same pool, with and without
+// (nested) parallel sections
+void TestNestedParallelFor(int num_threads, bool use_sections) {
+  constexpr int num_outer_tasks = 16;
+  constexpr int num_inner_tasks = 256;
+  for (int rep = 0; rep < 5; rep++) {
+    auto test_data = CreateTestData(num_outer_tasks * num_inner_tasks);
+    CreateThreadPoolAndTest("TestNestedParallelFor", num_threads, [&](ThreadPool* tp) {
+      std::optional<ThreadPool::ParallelSection> ps;
+      if (use_sections) {
+        ps.emplace(tp);
+      }
+      ThreadPool::TrySimpleParallelFor(tp, num_outer_tasks, [&](std::ptrdiff_t outer) {
+        std::optional<ThreadPool::ParallelSection> inner_ps;
+        if (use_sections) {
+          inner_ps.emplace(tp);
+        }
+        ThreadPool::TrySimpleParallelFor(tp, num_inner_tasks, [&](std::ptrdiff_t inner) {
+          IncrementElement(*test_data, outer * num_inner_tasks + inner);
+        });
+      });
+    });
+    ValidateTestData(*test_data);
+  }
+}
+
+// Test concurrent tasks, as run by the inter-op thread pool, that each run nested parallel loops on the same pool
+void TestConcurrentNestedParallelFor(int num_threads) {
+  constexpr int num_concurrent = 4;
+  constexpr int num_tasks = 64;
+  auto test_data = CreateTestData(num_concurrent * num_tasks * num_tasks);
+  CreateThreadPoolAndTest("TestConcurrentNestedParallelFor", num_threads, [&](ThreadPool* tp) {
+    onnxruntime::Barrier barrier(num_concurrent, true);
+    for (int c = 0; c < num_concurrent; c++) {
+      ThreadPool::Schedule(tp, [&, c]() {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t outer) {
+          ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t inner) {
+            IncrementElement(*test_data, (c * num_tasks + outer) * num_tasks + inner);
+          });
+        });
+        barrier.Notify();
+      });
+    }
+    barrier.Wait();
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelFor_0Thread) {
+  TestNestedParallelFor(0, false);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelFor_2Thread) {
+  TestNestedParallelFor(2, false);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelFor_4Thread) {
+  TestNestedParallelFor(4, false);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelSections_4Thread) {
+  TestNestedParallelFor(4, true);
+}
+
+TEST(ThreadPoolTest, TestConcurrentNestedParallelFor_4Thread) {
+  TestConcurrentNestedParallelFor(4);
+}
+
+TEST(ThreadPoolTest, TestHybridParallelForWithPerformanceCoresOnlySection) {
+  // the loops measure the speed of the threads in hybrid mode, later loops size their blocks by it
+  constexpr int num_tasks = 4096;
+  constexpr int num_loops = 50;
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(
+      "TestHybridParallelForWithPerformanceCoresOnlySection", 4, [&](ThreadPool* tp) {
+        for (int l = 0; l < num_loops; l++) {
+          ThreadPool::TryParallelFor(tp, num_tasks, 100.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              IncrementElement(*test_data, i);
+            }
+          });
+        }
+        ThreadPool::ParallelSection ps(tp, true);
+        for (int l = 0; l < num_loops; l++) {
+          ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+        }
+      },
+      0, true);
+  ValidateTestData(*test_data, 2 * num_loops);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithNumaNodes) {
+  // the threads are not bound to the nodes, so this only checks the scheduling of the work with NUMA partitions
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_nodes = {-1, 0, 0, 1, 1};
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 5, true);
+
+  constexpr int num_tasks = 1000;
+  for (int iteration = 0; iteration < 10; ++iteration) {
+    auto test_data = CreateTestData(num_tasks);
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        IncrementElement(*test_data, i);
+      }
+    });
+    ValidateTestData(*test_data);
+
+    std::atomic<int> scheduled{0};
+    for (int i = 0; i < 16; ++i) {
+      ThreadPool::Schedule(tp.get(), [&scheduled]() { ++scheduled; });
+    }
+    ThreadPool::TryBatchParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); }, 0);
+    ValidateTestData(*test_data, 2);
+    while (scheduled.load() < 16) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestStatistics) {
+  EXPECT_TRUE(ThreadPool::GetStatistics(nullptr).workers.empty());
+
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  constexpr int num_tasks = 100;
+  auto test_data = CreateTestData(num_tasks);
+  ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+
+  std::atomic<int> scheduled{0};
+  for (int i = 0; i < num_tasks; ++i) {
+    ThreadPool::Schedule(tp.get(), [&scheduled]() { ++scheduled; });
+  }
+
+  // the tasks are counted once they have run, so wait until all of them are accounted for
+  ThreadPoolStatistics stats;
+  for (;;) {
+    stats = ThreadPool::GetStatistics(tp.get());
+    uint64_t tasks_run = 0;
+    for (const auto& worker : stats.workers) {
+      tasks_run += worker.tasks_run;
+      EXPECT_LE(worker.steals, worker.steal_attempts);
+    }
+    if (scheduled.load() == num_tasks && tasks_run + stats.rejected_pushes >= num_tasks) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  // the thread creating the pool is the fourth thread of its parallel loops
+  ASSERT_EQ(stats.workers.size(), 3u);
+
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("\"rejected_pushes\": "), std::string::npos) << json;
+  EXPECT_NE(json.find("\"tasks_run\": "), std::string::npos) << json;
+  EXPECT_NE(json.find("\"blocked_ns\": "), std::string::npos) << json;
+}
+
+TEST(ThreadPoolTest, TestRunPriority) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  const int degree_of_parallelism = ThreadPool::DegreeOfParallelism(tp.get());
+  ASSERT_GT(degree_of_parallelism, 1);
+
+  constexpr int num_tasks = 1000;
+  const auto caller_id = std::this_thread::get_id();
+  {
+    ThreadPool::RunPriorityScope high_priority_run(tp.get(), ThreadPool::RunPriority::kHigh);
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), degree_of_parallelism);
+    {
+      // the loops of a lower priority run leave the threads of the pool to the high priority run
+      ThreadPool::RunPriorityScope low_priority_run(tp.get(), ThreadPool::RunPriority::kLow);
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 1);
+      auto test_data = CreateTestData(num_tasks);
+      std::atomic<bool> ran_on_other_thread{false};
+      ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e6}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        if (std::this_thread::get_id() != caller_id) {
+          ran_on_other_thread = true;
+        }
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          IncrementElement(*test_data, i);
+        }
+      });
+      ValidateTestData(*test_data);
+      EXPECT_FALSE(ran_on_other_thread.load());
+    }
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), degree_of_parallelism);
+  }
+
+  // a low priority run alone uses the whole pool
+  ThreadPool::RunPriorityScope low_priority_run(tp.get(), ThreadPool::RunPriority::kLow);
+  EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), degree_of_parallelism);
+}
+
+#ifndef _WIN32
+TEST(ThreadPoolTest, TestRecreateThreadsAfterFork) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  constexpr int num_tasks = 1000;
+  auto run_loop = [&tp]() {
+    auto test_data = CreateTestData(num_tasks);
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e6}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        IncrementElement(*test_data, i);
+      }
+    });
+    return std::all_of(test_data->data.begin(), test_data->data.end(), [](int v) { return v == 1; });
+  };
+  ASSERT_TRUE(run_loop());
+
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // the child only has the forking thread, the pool needs new threads to run the scheduled work
+    tp->RecreateThreadsAfterFork();
+    std::atomic<bool> scheduled_work_ran{false};
+    ThreadPool::Schedule(tp.get(), [&scheduled_work_ran]() { scheduled_work_ran = true; });
+    for (int i = 0; i < 1000 && !scheduled_work_ran; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    _exit(scheduled_work_ran && run_loop() ? 0 : 1);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  // the threads of the pool are kept in the process that started them
+  tp->RecreateThreadsAfterFork();
+  EXPECT_TRUE(run_loop());
+}
+#endif
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
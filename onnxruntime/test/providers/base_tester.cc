@@ -754,6 +754,10 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
           std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
           if (provider_type == onnxruntime::kRocmExecutionProvider) {
             execution_providers.emplace_back(DefaultRocmExecutionProvider(/*test_tunable_op=*/true));
+          } else if (provider_type == onnxruntime::kCpuExecutionProvider) {
+            auto cpu_ep = DefaultCpuExecutionProvider();
+            cpu_ep->GetTuningContext()->EnableTunableOpAndTuning();
+            execution_providers.emplace_back(std::move(cpu_ep));
           }
 
           if (!execution_providers.empty()) {
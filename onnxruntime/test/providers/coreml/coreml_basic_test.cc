@@ -104,6 +104,38 @@ TEST(CoreMLExecutionProviderTest, FunctionTest) {
 #endif
 }
 
+// The model runs on the CPU until the model for all the compute units is loaded in the background
+TEST(CoreMLExecutionProviderTest, LoadModelInBackgroundTest) {
+  const ORTCHAR_T* model_file_name = ORT_TSTR("testdata/coreml_argmax_cast_test.onnx");
+  auto make_coreml_ep = []() {
+    std::unordered_map<std::string, std::string> provider_options = {{kCoremlProviderOption_MLComputeUnits, "ALL"},
+                                                                     {kCoremlProviderOption_ModelFormat, "MLProgram"},
+                                                                     {kCoremlProviderOption_LoadModelInBackground, "1"}};
+    return CoreMLProviderFactoryCreator::Create(provider_options)->CreateProvider();
+  };
+
+#if defined(__APPLE__)
+  std::vector<int64_t> dims_mul_x = {3, 2, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f};
+  OrtValue ml_value_x;
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  CreateMLValue<float>(allocator, dims_mul_x, values_mul_x, &ml_value_x);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  EPVerificationParams verification_params{};
+  verification_params.ep_node_assignment = ExpectedEPNodeAssignment::All;
+
+  RunAndVerifyOutputsWithEP(model_file_name, CurrentTestName(),
+                            make_coreml_ep(),
+                            feeds,
+                            verification_params);
+#else
+  TestModelLoad(model_file_name, make_coreml_ep(), ExpectedEPNodeAssignment::All);
+#endif
+}
+
 // CoreML EP currently handles a special case for supporting ArgMax op:
 // An ArgMax followed by a Cast to int32 type.
 // Please see in <repo_root>/onnxruntime/core/providers/coreml/builders/impl/argmax_op_builder.cc
@@ -907,6 +907,57 @@ TEST(Scan9, TransposeOutputDim2) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
 }
 
+// Without loop state variables the iterations are independent and may run in parallel; every iteration must still
+// write to its own slice of the outputs, including the reversed one.
+TEST(Scan9, NoLoopStateVarsManyIterations) {
+  // Construct scan body subgraph with 1 scan input, 2 scan outputs
+  // scan-in-1 => Mul(scan-in-1, scan-in-1) => scan-out-1
+  //           => Add(scan-in-1, scan-in-1) => scan-out-2
+  Model model("ScanBody", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &float_tensor);
+  auto& scan_out_1 = graph.GetOrCreateNodeArg("scan_out_1", &float_tensor);
+  auto& scan_out_2 = graph.GetOrCreateNodeArg("scan_out_2", &float_tensor);
+
+  graph.AddNode("square", "Mul", "Square scan_in_1", {&scan_in_1, &scan_in_1}, {&scan_out_1});
+  graph.AddNode("double", "Add", "Double scan_in_1", {&scan_in_1, &scan_in_1}, {&scan_out_2});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  constexpr int64_t sequence_len = 16;
+  std::vector<float> input(sequence_len * 3);
+  std::vector<float> squared(input.size());
+  std::vector<float> doubled_reversed(input.size());
+  for (int64_t i = 0; i < sequence_len; ++i) {
+    for (int64_t j = 0; j < 3; ++j) {
+      const float value = static_cast<float>(i * 3 + j);
+      input[i * 3 + j] = value;
+      squared[i * 3 + j] = value * value;
+      doubled_reversed[(sequence_len - 1 - i) * 3 + j] = value + value;
+    }
+  }
+
+  ScanOpTester test{9};
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+  test.AddAttribute<std::vector<int64_t>>("scan_output_directions", {0, 1});
+
+  test.AddInput<float>("scan_input_1", {sequence_len, 3}, input);
+  test.AddOutput<float>("scan_output_1", {sequence_len, 3}, squared);
+  test.AddOutput<float>("scan_output_2", {sequence_len, 3}, doubled_reversed);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
+}
+
 static void InvalidInput(bool is_v8) {
   constexpr int64_t batch_size = 1;
   constexpr int64_t sequence_len = 2;
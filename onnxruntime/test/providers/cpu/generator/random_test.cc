@@ -2,9 +2,13 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/framework/random_generator.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
@@ -333,6 +337,132 @@ TEST(Random, MultinomialInvalidDtype) {
   test.Run(OpTester::ExpectResult::kExpectFailure, "Output type must be int32 or int64");
 }
 
+static SessionOptions CounterBasedSessionOptions(int num_threads) {
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = num_threads;
+  ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuRandomCounterBased, "1"));
+  return so;
+}
+
+TEST(Random, RandomUniformCounterBased) {
+  std::vector<int64_t> dims{37, 129};
+
+  constexpr float low = -2.f;
+  constexpr float high = 3.f;
+  constexpr float seed = 123.f;
+
+  // the four random values of counter i generate the values [i * 4, (i + 1) * 4) of the output.
+  const PhiloxEngine engine(static_cast<uint64_t>(seed));
+  std::vector<float> expected_output(TensorShape(dims).Size());
+  for (size_t i = 0; i < expected_output.size(); ++i) {
+    const auto values = engine(i / 4);
+    expected_output[i] = low + (high - low) * PhiloxEngine::ToUniformFloat(values[i % 4]);
+  }
+
+  // the output does not depend on the number of threads.
+  for (int num_threads : {1, 4}) {
+    OpTester test("RandomUniform");
+    test.AddAttribute("low", low);
+    test.AddAttribute("high", high);
+    test.AddAttribute("seed", seed);
+    test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
+    test.AddAttribute("shape", dims);
+    test.AddOutput<float>("Y", dims, expected_output);
+    test.ConfigEp(DefaultCpuExecutionProvider())
+        .Config(CounterBasedSessionOptions(num_threads))
+        .RunWithConfig();
+  }
+}
+
+TEST(Random, RandomNormalLikeCounterBased) {
+  std::vector<int64_t> dims{65, 63};
+
+  constexpr float scale = 2.f;
+  constexpr float mean = 1.f;
+  constexpr float seed = 231.f;
+
+  // the four random values of counter i generate the values [i * 2, (i + 1) * 2) of the output.
+  const PhiloxEngine engine(static_cast<uint64_t>(seed));
+  std::vector<double> expected_output(TensorShape(dims).Size());
+  for (size_t i = 0; i < expected_output.size(); i += 2) {
+    const auto values = engine(i / 2);
+    const double radius = std::sqrt(-2.0 * std::log(1.0 - PhiloxEngine::ToUniformDouble(values[0], values[1])));
+    const double angle = 6.28318530717958647692 * PhiloxEngine::ToUniformDouble(values[2], values[3]);
+    expected_output[i] = mean + scale * radius * std::cos(angle);
+    if (i + 1 < expected_output.size()) {
+      expected_output[i + 1] = mean + scale * radius * std::sin(angle);
+    }
+  }
+
+  double sum = std::accumulate(expected_output.begin(), expected_output.end(), 0.);
+  ASSERT_NEAR(sum / static_cast<double>(expected_output.size()), static_cast<double>(mean), 0.2);
+
+  for (int num_threads : {1, 4}) {
+    OpTester test("RandomNormalLike");
+    test.AddAttribute("mean", mean);
+    test.AddAttribute("scale", scale);
+    test.AddAttribute("seed", seed);
+    test.AddInput<double>("X", dims, std::vector<double>(expected_output.size(), 0.));
+    test.AddOutput<double>("Y", dims, expected_output);
+    test.ConfigEp(DefaultCpuExecutionProvider())
+        .Config(CounterBasedSessionOptions(num_threads))
+        .RunWithConfig();
+  }
+}
+
+TEST(Random, MultinomialCounterBased) {
+  constexpr int64_t num_samples = 1000;
+  constexpr int64_t batch_size = 8;
+  constexpr int64_t num_classes = 4;
+  constexpr float seed = 1618.f;
+
+  // class 3 is never sampled, and class 1 is about twice as likely as class 0 and class 2.
+  const std::vector<int64_t> input_dims{batch_size, num_classes};
+  std::vector<float> input;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    input.insert(input.end(), {0.f, std::log(2.f), 0.f, -std::numeric_limits<float>::infinity()});
+  }
+
+  std::vector<int64_t> single_thread_output;
+
+  for (int num_threads : {1, 4}) {
+    OpTester test("Multinomial");
+    test.AddInput<float>("X", input_dims, input);
+    test.AddAttribute("sample_size", num_samples);
+    test.AddAttribute("seed", seed);
+    test.AddAttribute<int64_t>("dtype", TensorProto::INT64);
+    test.AddOutput<int64_t>("Y", {batch_size, num_samples}, std::vector<int64_t>(batch_size * num_samples, 0));
+
+    test.SetCustomOutputVerifier([&](const std::vector<OrtValue>& fetches, const std::string& /*provider_type*/) {
+      ASSERT_EQ(fetches.size(), 1u);
+      auto output_span = fetches[0].Get<Tensor>().DataAsSpan<int64_t>();
+
+      std::vector<int64_t> counts(num_classes, 0);
+      for (auto value : output_span) {
+        ASSERT_GE(value, 0);
+        ASSERT_LT(value, num_classes);
+        ++counts[value];
+      }
+      const double total = static_cast<double>(output_span.size());
+      ASSERT_NEAR(counts[0] / total, 0.25, 0.02);
+      ASSERT_NEAR(counts[1] / total, 0.5, 0.02);
+      ASSERT_NEAR(counts[2] / total, 0.25, 0.02);
+      ASSERT_EQ(counts[3], 0);
+
+      // the output does not depend on the number of threads.
+      if (single_thread_output.empty()) {
+        single_thread_output.assign(output_span.begin(), output_span.end());
+      } else {
+        ASSERT_TRUE(std::equal(output_span.begin(), output_span.end(), single_thread_output.begin()));
+      }
+    });
+
+    test.ConfigEp(DefaultCpuExecutionProvider())
+        .Config(CounterBasedSessionOptions(num_threads))
+        .RunWithConfig();
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // We cannot call CUDA lib from UT, so just do some simple verification on output tensor.
 void RunRandomNormalGpuTest(const std::vector<int64_t> dims, const float mean, const float scale, const float seed,
@@ -257,5 +257,29 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongAxisExclusiveReverse) {
+  // long enough for the axis to be split between threads
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  test.AddAttribute<int64_t>("reverse", 1);
+  constexpr int64_t N = 100000;
+  constexpr int64_t C = 3;
+  std::vector<int64_t> input_value(N * C);
+  std::vector<int64_t> output_value(N * C);
+  for (int64_t i = 0; i < N * C; ++i) {
+    input_value[i] = i % 7 - 3;
+  }
+  for (int64_t c = 0; c < C; ++c) {
+    int64_t sum = 0;
+    for (int64_t i = N - 1; i >= 0; --i) {
+      output_value[i * C + c] = sum;
+      sum += input_value[i * C + c];
+    }
+  }
+  test.AddInput<int64_t>("x", {N, C}, input_value);
+  test.AddInput<int32_t>("axis", {}, {0});
+  test.AddOutput<int64_t>("y", {N, C}, output_value);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -237,6 +237,35 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+// The first two operands share no label, so they should not be contracted first.
+// The operands are contracted in an order picked on their shapes, the output must not depend on it.
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder) {
+  constexpr int64_t a = 3, b = 4, c = 5, d = 2, e = 6;
+  std::vector<float> x(a * b), y(c * d), z(b * c), w(d * e);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i % 7) - 3.f;
+  for (size_t i = 0; i < y.size(); ++i) y[i] = static_cast<float>(i % 5) - 2.f;
+  for (size_t i = 0; i < z.size(); ++i) z[i] = static_cast<float>(i % 3) + 1.f;
+  for (size_t i = 0; i < w.size(); ++i) w[i] = static_cast<float>(i % 4) - 1.f;
+
+  // o[a][e] = sum over b, c, d of x[a][b] * y[c][d] * z[b][c] * w[d][e]
+  std::vector<float> o(a * e, 0.f);
+  for (int64_t i = 0; i < a; ++i)
+    for (int64_t j = 0; j < b; ++j)
+      for (int64_t k = 0; k < c; ++k)
+        for (int64_t l = 0; l < d; ++l)
+          for (int64_t m = 0; m < e; ++m)
+            o[i * e + m] += x[i * b + j] * y[k * d + l] * z[j * c + k] * w[l * e + m];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ab,cd,bc,de->ae");
+  test.AddInput<float>("x", {a, b}, x);
+  test.AddInput<float>("y", {c, d}, y);
+  test.AddInput<float>("z", {b, c}, z);
+  test.AddInput<float>("w", {d, e}, w);
+  test.AddOutput<float>("o", {a, e}, o);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
@@ -10,14 +10,21 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#include "core/mlas/inc/mlas.h"
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 
 namespace onnxruntime {
 namespace test {
 
 namespace {
 
+#if defined(MLAS_TARGET_AMD64)
+const char* const kFastMathConfigKey = kOrtSessionOptionsMlasGemmFastMathAmd64Bfloat16;
+#else
+const char* const kFastMathConfigKey = kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16;
+#endif
+
 const onnxruntime::RunOptions run_options = []() {
   onnxruntime::RunOptions options{};
   ORT_THROW_IF_ERROR(options.config_options.AddConfigEntry(kOpTesterRunOptionsConfigTestTunableOp, "true"));
@@ -144,8 +151,7 @@ void RunMatMulTest(int32_t opset_version, bool is_a_constant, bool is_b_constant
     }
 
     SessionOptions so;
-    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(
-        kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kFastMathConfigKey, "1"));
 
     test.ConfigExcludeEps(excluded_providers)
         .Config(run_with_tunable_op)
@@ -153,8 +159,7 @@ void RunMatMulTest(int32_t opset_version, bool is_a_constant, bool is_b_constant
         .RunWithConfig();
 
     if (disable_fastmath) {
-      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(
-          kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "0"));
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kFastMathConfigKey, "0"));
 
       test.ConfigExcludeEps(excluded_providers)
           .Config(run_with_tunable_op)
@@ -236,8 +241,7 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights_FastMath) {
   SessionOptions so;
   // Set up B as a shared initializer to be shared between sessions
   ASSERT_EQ(so.AddInitializer("B", &b), Status::OK());
-  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(
-      kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kFastMathConfigKey, "1"));
 
   // We want all sessions running using this OpTester to be able to share pre-packed weights if applicable
   test.EnableSharingOfPrePackedWeightsAcrossSessions();
@@ -302,4 +306,4 @@ TEST(MathOpTest, MatMulUint64Type_DisableFastMath) {
 
 }  // namespace test
 }  // namespace onnxruntime
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
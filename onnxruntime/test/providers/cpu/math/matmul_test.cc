@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -483,6 +484,107 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+// B is an initializer with 2:4 structured sparsity along K, so the CPU EP compresses it unless disabled.
+TEST(MathOpTest, MatMulSparse24Weight) {
+  constexpr int64_t M = 5;
+  constexpr int64_t K = 96;
+  constexpr int64_t N = 70;
+
+  std::vector<float> a(M * K);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<float>(static_cast<int64_t>(i % 11) - 5) / 4.0f;
+  }
+
+  // keep two values at varying positions of each group of 4 rows
+  std::vector<float> b(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      const int64_t kept = (k / 4 + n) % 4;
+      if (k % 4 == kept || k % 4 == (kept + 1 + n % 3) % 4) {
+        b[k * N + n] = static_cast<float>((k * 3 + n) % 9) / 2.0f - 2.0f;
+      }
+    }
+  }
+
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * b[k * N + n];
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  for (const char* disable_sparse24 : {"0", "1"}) {
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {M, K}, a);
+    test.AddInput<float>("B", {K, N}, b, true);
+    test.AddOutput<float>("Y", {M, N}, y);
+    test.SetOutputRelErr("Y", 1e-4f);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasDisableGemmSparse24, disable_sparse24));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+// B is an initializer with about 5% non-zero values, so the CPU EP compresses it to the blocked CSR format unless
+// the maximum density is 0.
+TEST(MathOpTest, MatMulSparseCsrWeight) {
+  constexpr int64_t M = 6;
+  constexpr int64_t K = 120;
+  constexpr int64_t N = 90;
+
+  std::vector<float> a(M * K);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<float>(static_cast<int64_t>(i % 11) - 5) / 4.0f;
+  }
+
+  std::vector<float> b(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      if ((k * 7 + n * 3) % 19 == 0) {
+        b[k * N + n] = static_cast<float>((k * 3 + n) % 9) / 2.0f - 2.0f;
+      }
+    }
+  }
+
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * b[k * N + n];
+      }
+      y[m * N + n] = sum;
+    }
+  }
+
+  for (const char* max_density : {"0.1", "0"}) {
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {M, K}, a);
+    test.AddInput<float>("B", {K, N}, b, true);
+    test.AddOutput<float>("Y", {M, N}, y);
+    test.SetOutputRelErr("Y", 1e-4f);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasGemmSparseCsrMaxDensity, max_density));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
@@ -861,5 +861,46 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// a few rows that are long enough to be split into slices which are selected in parallel.
+// every value is repeated many times so the merge of the slices must keep the lowest indices.
+template <typename T>
+static void TestLargeRows(int64_t k, int64_t n, int64_t batch_size, int64_t largest) {
+  std::vector<T> input_vals(n * batch_size);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>((i * 37) % 1000);
+  }
+
+  std::vector<int64_t> input_dimensions = {n, batch_size};
+
+  std::vector<T> expected_vals;
+  std::vector<int64_t> expected_indices;
+  std::vector<int64_t> expected_dimensions = {n, k};
+
+  for (int64_t i = 0; i < n; ++i) {
+    const T* row = input_vals.data() + i * batch_size;
+    std::vector<int64_t> order(batch_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+
+    for (int64_t j = 0; j < k; ++j) {
+      expected_vals.push_back(row[order[j]]);
+      expected_indices.push_back(order[j]);
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+TEST(TopKOperator, LargeRowsThreaded) {
+  TestLargeRows<float>(50, 1, 131072, 1);
+  TestLargeRows<float>(50, 1, 131072, 0);
+  TestLargeRows<float>(1, 2, 100000, 1);
+  TestLargeRows<double>(20, 3, 70000, 1);
+  TestLargeRows<int64_t>(50, 1, 131072, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
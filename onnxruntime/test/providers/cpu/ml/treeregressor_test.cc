@@ -844,5 +844,77 @@ TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorBitvectorEvaluation) {
+  // Enough small trees with the same comparison for the ensemble to be evaluated with bitvectors.
+  // Inputs are equal to some thresholds or missing, the expected values come from walking the trees.
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  constexpr int64_t n_trees = 80, n_features = 4, n_rows = 16;
+  constexpr int64_t n_branches = 7, n_tree_nodes = 15;
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<int64_t> nodes_missing_value_tracks_true, target_treeids, target_nodeids, target_ids;
+  std::vector<float> nodes_values, target_weights;
+  std::vector<std::string> nodes_modes;
+  for (int64_t t = 0; t < n_trees; ++t) {
+    for (int64_t k = 0; k < n_tree_nodes; ++k) {
+      const bool is_leaf = k >= n_branches;
+      nodes_treeids.push_back(t);
+      nodes_nodeids.push_back(k);
+      nodes_featureids.push_back(is_leaf ? 0 : (t + k) % n_features);
+      nodes_values.push_back(is_leaf ? 0.f : static_cast<float>((t * 7 + k * 3) % 9 - 4) * 0.5f);
+      nodes_modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+      nodes_truenodeids.push_back(is_leaf ? 0 : 2 * k + 1);
+      nodes_falsenodeids.push_back(is_leaf ? 0 : 2 * k + 2);
+      nodes_missing_value_tracks_true.push_back(!is_leaf && (t + k) % 3 == 0 ? 1 : 0);
+      if (is_leaf) {
+        target_treeids.push_back(t);
+        target_nodeids.push_back(k);
+        target_ids.push_back(0);
+        target_weights.push_back(static_cast<float>(t % 5) + static_cast<float>(k - n_branches) * 0.25f);
+      }
+    }
+  }
+
+  std::vector<float> X(n_rows * n_features);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    for (int64_t f = 0; f < n_features; ++f) {
+      X[i * n_features + f] = (i + f) % 7 == 0 ? std::numeric_limits<float>::quiet_NaN()
+                                               : static_cast<float>((i * 5 + f * 3) % 11 - 5) * 0.5f;
+    }
+  }
+
+  std::vector<float> Y(n_rows, 0.f);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    for (int64_t t = 0; t < n_trees; ++t) {
+      int64_t k = 0;
+      while (k < n_branches) {
+        const size_t node = static_cast<size_t>(t * n_tree_nodes + k);
+        const float val = X[i * n_features + nodes_featureids[node]];
+        const bool is_true = val <= nodes_values[node] || (nodes_missing_value_tracks_true[node] && std::isnan(val));
+        k = is_true ? nodes_truenodeids[node] : nodes_falsenodeids[node];
+      }
+      Y[i] += target_weights[static_cast<size_t>(t * (n_tree_nodes - n_branches) + k - n_branches)];
+    }
+  }
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", nodes_missing_value_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", static_cast<int64_t>(1));
+
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
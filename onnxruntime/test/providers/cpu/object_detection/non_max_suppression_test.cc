@@ -154,6 +154,50 @@ TEST(NonMaxSuppressionOpTest, TwoBatches_TwoClasses) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // 40 disjoint boxes followed by a shifted copy of each of them with a lower score, which is suppressed
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t num_classes = 5;
+  constexpr int64_t num_disjoint_boxes = 40;
+  constexpr int64_t num_boxes = 2 * num_disjoint_boxes;
+
+  std::vector<float> boxes;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t copy = 0; copy < 2; ++copy) {
+      for (int64_t i = 0; i < num_disjoint_boxes; ++i) {
+        const float x = static_cast<float>(2 * i + batch) + 0.1f * static_cast<float>(copy);
+        boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+      }
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected_indices;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t class_index = 0; class_index < num_classes; ++class_index) {
+      for (int64_t box = 0; box < num_boxes; ++box) {
+        const int64_t i = box % num_disjoint_boxes;
+        // the disjoint boxes are selected in reverse order for odd classes
+        const int64_t rank = class_index % 2 == 0 ? i : num_disjoint_boxes - 1 - i;
+        scores.push_back((box < num_disjoint_boxes ? 1.0f : 0.5f) - 0.01f * static_cast<float>(rank));
+      }
+      for (int64_t rank = 0; rank < num_disjoint_boxes; ++rank) {
+        const int64_t i = class_index % 2 == 0 ? rank : num_disjoint_boxes - 1 - rank;
+        expected_indices.insert(expected_indices.end(), {batch, class_index, i});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {100L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_batches * num_classes * num_disjoint_boxes, 3}, expected_indices);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithScoreThreshold) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -5023,6 +5023,44 @@ TEST(ReductionOpTest, ReduceMax_KRK_keepdims) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceMinMax_KR_infinity) {
+  // A row made only of the identity of the reduction reduces to it.
+  const std::vector<std::pair<const char*, float>> cases{{"ReduceMax", FLOAT_NINF}, {"ReduceMin", FLOAT_INF}};
+  for (const auto& [op, inf] : cases) {
+    OpTester test(op);
+    test.AddAttribute("axes", std::vector<int64_t>{1});
+    test.AddAttribute("keepdims", (int64_t)0);
+    std::vector<float> in_data(2 * 37, inf);
+    in_data[37 + 20] = 1.0f;
+    test.AddInput<float>("data", {2, 37}, in_data);
+    test.AddOutput<float>("reduced", {2}, {inf, 1.0f});
+    test.Run();
+  }
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_KRK_parallel) {
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  constexpr int64_t K0 = 2, R = 4099, K1 = 5;
+  std::vector<float> in_data(K0 * R * K1);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 23) / 4.f - 2.f;
+  test.AddInput<float>("data", {K0, R, K1}, in_data);
+  std::vector<float> expected(K0 * K1);
+  for (int64_t k0 = 0; k0 < K0; ++k0) {
+    for (int64_t k1 = 0; k1 < K1; ++k1) {
+      double sum = 0;
+      for (int64_t r = 0; r < R; ++r) {
+        sum += std::exp((double)in_data[(k0 * R + r) * K1 + k1]);
+      }
+      expected[k0 * K1 + k1] = (float)std::log(sum);
+    }
+  }
+  test.AddOutput<float>("reduced", {K0, K1}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceMax_RKR) {
   OpTester test("ReduceMax");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
@@ -328,6 +328,54 @@ TEST(SequenceOpsTest, SequenceConstructPositive) {
   test.Run();
 }
 
+// The intermediate sequences have a single consumer, so SequenceInsert and SequenceErase update them in place
+class SequenceInPlaceUpdateTester : public OpTester {
+ public:
+  SequenceInPlaceUpdateTester() : OpTester("SequenceInsert", 11) {}
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    /*
+      SequenceConstruct(A) -> SequenceInsert(B) -> SequenceInsert(B, I) -> SequenceErase -> ConcatFromSequence
+    */
+    onnx::TypeProto tensor_type_proto;
+    tensor_type_proto.mutable_tensor_type()->set_elem_type(onnx::TensorProto_DataType::TensorProto_DataType_FLOAT);
+
+    onnx::TypeProto seq_tensor_type_proto;
+    seq_tensor_type_proto.mutable_sequence_type()->mutable_elem_type()->CopyFrom(tensor_type_proto);
+
+    auto* a = graph_input_defs[0];
+    auto* b = graph_input_defs[1];
+    auto* i = graph_input_defs[2];
+
+    auto& s0 = graph.GetOrCreateNodeArg("s0", &seq_tensor_type_proto);
+    auto& s1 = graph.GetOrCreateNodeArg("s1", &seq_tensor_type_proto);
+    auto& s2 = graph.GetOrCreateNodeArg("s2", &seq_tensor_type_proto);
+    auto& s3 = graph.GetOrCreateNodeArg("s3", &seq_tensor_type_proto);
+
+    graph.AddNode("construct", "SequenceConstruct", "", {a}, {&s0});
+    graph.AddNode("append", "SequenceInsert", "", {&s0, b}, {&s1});
+    graph.AddNode("insert", "SequenceInsert", "", {&s1, b, i}, {&s2});
+    graph.AddNode("erase", "SequenceErase", "", {&s2}, {&s3});
+    auto& concat = graph.AddNode("concat", "ConcatFromSequence", "", {&s3}, {graph_output_defs[0]});
+    concat.AddAttribute("axis", static_cast<int64_t>(0));
+  }
+};
+
+TEST(SequenceOpsTest, SequenceInPlaceUpdate) {
+  SequenceInPlaceUpdateTester test;
+  test.AddInput<float>("A", {1, 2}, {1.f, 2.f});
+  test.AddInput<float>("B", {2, 2}, {3.f, 4.f, 5.f, 6.f});
+  test.AddInput<int64_t>("I", {}, {0});
+
+  // [A] -> [A, B] -> [B, A, B] -> [B, A]
+  test.AddOutput<float>("Y", {3, 2}, {3.f, 4.f, 5.f, 6.f, 1.f, 2.f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 // SplitToSequence
 template <typename T>
 static std::vector<T> GetConsecutiveVector(T start, size_t num) {
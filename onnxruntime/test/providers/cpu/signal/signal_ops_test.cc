@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <complex>
 #include <functional>
 #include <vector>
 
@@ -206,6 +208,54 @@ TEST(SignalOpsTest, DFT20_invertible_complex) {
   TestDFTInvertible(true, kOpsetVersion20);
 }
 
+// Compares non power of 2 lengths, computed with mixed radix FFTs or Bluestein's algorithm, with a naive DFT.
+static void TestDFTLengths(bool complex, bool onesided) {
+  constexpr double pi = 3.14159265358979323846;
+  RandomValueGenerator random(GetTestRandomSeed());
+  for (int64_t length : {6, 7, 12, 15, 30, 49, 400}) {
+    OpTester test("DFT", kOpsetVersion20);
+    const int64_t num_components = complex ? 2 : 1;
+    const int64_t output_length = onesided ? (length >> 1) + 1 : length;
+    vector<int64_t> input_shape{2, length, num_components};
+    vector<float> input_data = random.Uniform<float>(input_shape, -1.f, 1.f);
+
+    vector<float> expected_output;
+    for (int64_t batch = 0; batch < 2; batch++) {
+      for (int64_t k = 0; k < output_length; k++) {
+        std::complex<double> sum;
+        for (int64_t n = 0; n < length; n++) {
+          const float* sample = input_data.data() + (batch * length + n) * num_components;
+          const double angle = -2.0 * pi * static_cast<double>((n * k) % length) / static_cast<double>(length);
+          sum += std::complex<double>(sample[0], complex ? sample[1] : 0.0) *
+                 std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        expected_output.push_back(static_cast<float>(sum.real()));
+        expected_output.push_back(static_cast<float>(sum.imag()));
+      }
+    }
+
+    test.AddInput<float>("input", input_shape, input_data);
+    test.AddInput<int64_t>("dft_length", {}, {length});
+    test.AddInput<int64_t>("axis", {}, {1});
+    test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+    test.AddOutput<float>("output", {2, output_length, 2}, expected_output);
+    test.SetOutputAbsErr("output", 0.001f);
+    test.Run();
+  }
+}
+
+TEST(SignalOpsTest, DFT20_Float_lengths_real) {
+  TestDFTLengths(false, false);
+}
+
+TEST(SignalOpsTest, DFT20_Float_lengths_real_onesided) {
+  TestDFTLengths(false, true);
+}
+
+TEST(SignalOpsTest, DFT20_Float_lengths_complex) {
+  TestDFTLengths(true, false);
+}
+
 TEST(SignalOpsTest, STFTFloat) {
   OpTester test("STFT", kMinOpsetVersion);
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstring>
 #include <type_traits>
 
 #include "boost/mp11.hpp"
@@ -153,6 +154,41 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// The float -> bfloat16 conversion rounds to nearest even. Use enough elements to cover both the vectorized
+// loop and the remainder.
+TEST(CastOpTest, FloatToBFloat16RoundToNearestEven) {
+  auto from_bits = [](uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  };
+
+  const std::vector<float> input{
+      1.0f, from_bits(0x3F808000), from_bits(0x3F818000), from_bits(0x3F808001),
+      -2.0f, from_bits(0xBF818000), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::max(), from_bits(0x00018000), 0.0f, -0.0f,
+      3.0f, from_bits(0x3F7FFFFF), from_bits(0x40490FDB), from_bits(0x3DCCCCCD),
+      from_bits(0x3F808000), from_bits(0x3F818000), 65504.0f};
+  const std::vector<uint16_t> expected_bits{
+      0x3F80, 0x3F80, 0x3F82, 0x3F81,
+      0xC000, 0xBF82, 0x7F80, 0xFF80,
+      0x7F80, 0x0002, 0x0000, 0x8000,
+      0x4040, 0x3F80, 0x4049, 0x3DCD,
+      0x3F80, 0x3F82, 0x4780};
+
+  std::vector<BFloat16> output;
+  for (auto bits : expected_bits) {
+    output.push_back(BFloat16::FromBits(bits));
+  }
+
+  OpTester test("Cast", 13);
+  test.AddAttribute<int64_t>("to", utils::ToTensorProtoElementType<BFloat16>());
+  test.AddInput<float>("input", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<BFloat16>("output", {static_cast<int64_t>(output.size())}, output);
+  test.SetOutputTolerance(0.0f, 0.0f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -115,6 +117,63 @@ TEST(CompressTest, Compress_default_axis_issue_9247_cumulative_sum_overflow) {
   test.Run();
 }
 
+// condition large enough to be split between threads
+TEST(CompressTest, Compress_default_axis_large) {
+  OpTester test("Compress", 11);
+
+  constexpr int64_t elements = 100000;
+  std::vector<float> input(elements);
+  std::unique_ptr<bool[]> condition = std::make_unique<bool[]>(elements);
+  std::vector<float> output;
+  for (int64_t i = 0; i < elements; ++i) {
+    input[i] = static_cast<float>(i);
+    // runs of selected and skipped entries of various lengths
+    condition[i] = (i / 3) % 5 != 0 && (i / 1000) % 4 != 1;
+    if (condition[i]) {
+      output.push_back(input[i]);
+    }
+  }
+
+  test.AddInput<float>("input", {elements / 10, 10}, input);
+  test.AddInput<bool>("condition", {elements}, condition.get(), elements);
+  test.AddOutput<float>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
+TEST(CompressTest, Compress_axis1_large) {
+  OpTester test("Compress", 11);
+
+  test.AddAttribute("axis", int64_t(1));
+
+  constexpr int64_t dim0 = 3;
+  constexpr int64_t dim1 = 40000;
+  constexpr int64_t dim2 = 2;
+  std::vector<int64_t> input(dim0 * dim1 * dim2);
+  std::iota(input.begin(), input.end(), int64_t{0});
+  std::unique_ptr<bool[]> condition = std::make_unique<bool[]>(dim1);
+  int64_t num_selected = 0;
+  for (int64_t j = 0; j < dim1; ++j) {
+    condition[j] = j % 3 != 1;
+    num_selected += condition[j] ? 1 : 0;
+  }
+
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < dim0; ++i) {
+    for (int64_t j = 0; j < dim1; ++j) {
+      if (condition[j]) {
+        for (int64_t k = 0; k < dim2; ++k) {
+          output.push_back(input[(i * dim1 + j) * dim2 + k]);
+        }
+      }
+    }
+  }
+
+  test.AddInput<int64_t>("input", {dim0, dim1, dim2}, input);
+  test.AddInput<bool>("condition", {dim1}, condition.get(), dim1);
+  test.AddOutput<int64_t>("output", {dim0, num_selected, dim2}, output);
+  test.Run();
+}
+
 TEST(CompressTest, Compress0_string) {
   OpTester test("Compress", 9);
 
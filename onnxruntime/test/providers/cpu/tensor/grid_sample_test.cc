@@ -1007,5 +1007,43 @@ TYPED_TEST(GridSampleTest, test_grid_sample_20_4D_bicubic_reflection_no_align_co
   RunTests(test, GetExecutionProviders(20));
 }
 
+// The sampling locations are computed once for each block of output pixels and reused for every channel.
+// Use enough output pixels for several blocks and check each channel is shifted by one pixel.
+TEST(GridSampleCpuTest, LinearShiftManyPixelsAndChannels) {
+  constexpr int64_t C = 5, H = 24, W = 20;
+  std::vector<float> X_data(C * H * W);
+  for (size_t i = 0; i < X_data.size(); i++) {
+    X_data[i] = static_cast<float>(i % 97) * 0.25f - 3.0f;
+  }
+
+  // With align_corners, the normalized location -1 + 2 * i / (length - 1) is the input pixel i
+  std::vector<float> Grid_data;
+  for (int64_t y = 0; y < H; y++) {
+    for (int64_t x = 0; x < W; x++) {
+      Grid_data.push_back(-1.0f + 2.0f * static_cast<float>(x + 1) / static_cast<float>(W - 1));
+      Grid_data.push_back(-1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(H - 1));
+    }
+  }
+
+  std::vector<float> Y_data(C * H * W, 0.0f);
+  for (int64_t c = 0; c < C; c++) {
+    for (int64_t y = 0; y < H; y++) {
+      for (int64_t x = 0; x + 1 < W; x++) {
+        Y_data[(c * H + y) * W + x] = X_data[(c * H + y) * W + x + 1];
+      }
+    }
+  }
+
+  OpTester test("GridSample", 16);
+  test.AddInput<float>("X", {1, C, H, W}, X_data);
+  test.AddInput<float>("Grid", {1, H, W, 2}, Grid_data);
+  test.AddAttribute("mode", std::string("bilinear"));
+  test.AddAttribute("padding_mode", std::string("zeros"));
+  test.AddAttribute("align_corners", int64_t{1});
+  test.AddOutput<float>("Y", {1, C, H, W}, Y_data);
+  test.SetOutputTolerance(1e-4f);
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -98,6 +98,32 @@ TEST(NonZeroOpTest, Scalar) {
   }
 }
 
+// input large enough to be split between threads
+TEST(NonZeroOpTest, LargeInput) {
+  constexpr int64_t kRows = 300;
+  constexpr int64_t kCols = 1000;
+  std::vector<int32_t> X(kRows * kCols, 0);
+  std::vector<int64_t> rows;
+  std::vector<int64_t> cols;
+  for (int64_t r = 0; r < kRows; ++r) {
+    for (int64_t c = 0; c < kCols; ++c) {
+      if ((r * kCols + c) % 7 == 0 || (r % 50 == 0 && c < 100)) {
+        X[r * kCols + c] = static_cast<int32_t>(c + 1);
+        rows.push_back(r);
+        cols.push_back(c);
+      }
+    }
+  }
+
+  std::vector<int64_t> Y(rows);
+  Y.insert(Y.end(), cols.begin(), cols.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<int32_t>("X", {kRows, kCols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(rows.size())}, Y);
+  test.Run();
+}
+
 TEST(NonZeroOpTest, EmptyInput) {
   OpTester test{kOpName, kOpVersion};
   test.AddInput<int32_t>(
@@ -526,6 +526,58 @@ TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_4DBilinear_align_corners_sizes)
 #endif
 }
 
+// Bilinear interpolation reproduces a linear ramp exactly, which checks larger images with several channels,
+// where output rows share input rows and the rows are split between threads.
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_LinearRamp) {
+  auto run_test = [](bool is_nchw) {
+    constexpr int64_t N = 2, C = 5, H = 12, W = 20;
+    constexpr int64_t OH = 29, OW = 47;
+    auto ramp = [](int64_t n, int64_t c, float y, float x) {
+      return static_cast<float>(n * 100 + c * 10) + 0.5f * y + 0.25f * x;
+    };
+
+    std::vector<float> X(N * C * H * W);
+    std::vector<float> Y(N * C * OH * OW);
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t c = 0; c < C; c++) {
+        for (int64_t y = 0; y < H; y++) {
+          for (int64_t x = 0; x < W; x++) {
+            const int64_t i = is_nchw ? ((n * C + c) * H + y) * W + x : ((n * H + y) * W + x) * C + c;
+            X[i] = ramp(n, c, static_cast<float>(y), static_cast<float>(x));
+          }
+        }
+        for (int64_t y = 0; y < OH; y++) {
+          for (int64_t x = 0; x < OW; x++) {
+            const int64_t i = is_nchw ? ((n * C + c) * OH + y) * OW + x : ((n * OH + y) * OW + x) * C + c;
+            Y[i] = ramp(n, c, static_cast<float>(y * (H - 1)) / (OH - 1), static_cast<float>(x * (W - 1)) / (OW - 1));
+          }
+        }
+      }
+    }
+
+    OpTester test("Resize", 13);
+    test.AddAttribute("mode", "linear");
+    test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+    const std::vector<int64_t> x_dims = is_nchw ? std::vector<int64_t>{N, C, H, W} : std::vector<int64_t>{N, H, W, C};
+    const std::vector<int64_t> y_dims = is_nchw ? std::vector<int64_t>{N, C, OH, OW}
+                                                : std::vector<int64_t>{N, OH, OW, C};
+    test.AddInput<float>("X", x_dims, X);
+    test.AddInput<float>("roi", {0}, {});
+    test.AddInput<float>("", {0}, {});
+    test.AddInput<int64_t>("sizes", {4}, y_dims);
+    test.AddOutput<float>("Y", y_dims, Y);
+    test.SetOutputAbsErr("Y", 1e-4f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  run_test(true);
+  run_test(false);
+}
+
 TEST(ResizeOpTest, NhwcResizeOpLinearDownSampleTest_4DBilinear_align_corners_uint8) {
   // To test NNAPI EP, we need the scales/sizes to be in initializers
   auto run_test = [](bool scales_in_initializer) {
@@ -235,5 +235,43 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Many slices with repeated indices, large enough for the CPU kernel to reduce the slices in parallel.
+TEST(ScatterNDOpTest, ScatterND_18_add_many_duplicate_indices) {
+  constexpr int64_t num_rows = 8;
+  constexpr int64_t row_size = 64;
+  constexpr int64_t num_indices = 100;
+
+  std::vector<int64_t> data(num_rows * row_size, 1);
+  std::vector<int64_t> indices(num_indices);
+  std::vector<int64_t> updates(num_indices * row_size);
+  std::vector<int64_t> output = data;
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 5) % num_rows - (i % 2 == 0 ? 0 : num_rows);
+    const int64_t row = (indices[i] + num_rows) % num_rows;
+    for (int64_t j = 0; j < row_size; ++j) {
+      updates[i * row_size + j] = i + j;
+      output[row * row_size + j] += i + j;
+    }
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddAttribute("reduction", "add");
+  test.AddInput<int64_t>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_indices, 1}, indices);
+  test.AddInput<int64_t>("updates", {num_indices, row_size}, updates);
+  test.AddOutput<int64_t>("output", {num_rows, row_size}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// Runs of consecutive indices write consecutive slices of the output.
+TEST(ScatterNDOpTest, ScatterND_consecutive_indices) {
+  OpTester test("ScatterND", 11);
+  test.AddInput<float>("data", {6, 2}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  test.AddInput<int64_t>("indices", {5, 1}, {1, 2, 3, 5, 0});
+  test.AddInput<float>("updates", {5, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f});
+  test.AddOutput<float>("output", {6, 2}, {9.f, 10.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 0.f, 0.f, 7.f, 8.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
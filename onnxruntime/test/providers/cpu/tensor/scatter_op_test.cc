@@ -452,5 +452,38 @@ TEST(ScatterElements, MinReduction_Double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Updates that don't cover the whole data along the non-axis dims, with enough inner positions to be split in blocks.
+TEST(ScatterElements, AddReductionAxis1Partial) {
+  const std::vector<int64_t> data_dims{3, 4, 300};
+  const std::vector<int64_t> updates_dims{2, 6, 270};
+
+  std::vector<int64_t> data(3 * 4 * 300);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int64_t>(i % 7);
+  }
+  std::vector<int64_t> indices(2 * 6 * 270);
+  std::vector<int64_t> updates(indices.size());
+  std::vector<int64_t> output = data;
+  for (int64_t i = 0; i < 2; ++i) {
+    for (int64_t j = 0; j < 6; ++j) {
+      for (int64_t k = 0; k < 270; ++k) {
+        const size_t pos = static_cast<size_t>((i * 6 + j) * 270 + k);
+        indices[pos] = (i + j * 3 + k) % 4;
+        updates[pos] = static_cast<int64_t>(pos % 11);
+        output[static_cast<size_t>((i * 4 + indices[pos]) * 300 + k)] += updates[pos];
+      }
+    }
+  }
+
+  OpTester test("ScatterElements", 18);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<int64_t>("data", data_dims, data);
+  test.AddInput<int64_t>("indices", updates_dims, indices);
+  test.AddInput<int64_t>("updates", updates_dims, updates);
+  test.AddOutput<int64_t>("y", data_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
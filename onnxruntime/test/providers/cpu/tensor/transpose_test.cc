@@ -8,6 +8,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -769,6 +772,71 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Computes the expected output of a transpose element by element.
+template <typename T>
+static std::vector<T> ReferenceTranspose(const std::vector<int64_t>& input_shape, const std::vector<T>& input_vals,
+                                         const std::vector<int64_t>& perm, std::vector<int64_t>& expected_shape) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> input_pitches(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_pitches[i - 1] = input_pitches[i] * input_shape[i];
+  }
+
+  expected_shape.resize(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals(input_vals.size());
+  for (size_t n = 0; n < expected_vals.size(); ++n) {
+    int64_t index = static_cast<int64_t>(n);
+    int64_t offset = 0;
+    for (size_t i = rank; i-- > 0;) {
+      offset += (index % expected_shape[i]) * input_pitches[perm[i]];
+      index /= expected_shape[i];
+    }
+    expected_vals[n] = input_vals[offset];
+  }
+  return expected_vals;
+}
+
+template <typename T>
+static void TestBlockedTranspose(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  std::vector<T> input_vals(static_cast<size_t>(TensorShape(input_shape).Size()));
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>((i * 7) % 101);
+  }
+
+  std::vector<int64_t> expected_shape;
+  std::vector<T> expected_vals = ReferenceTranspose(input_shape, input_vals, perm, expected_shape);
+
+  OpTester test("Transpose", 13);
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// Permutations handled by the blocked transpose, with shapes that are not multiples of the tiles.
+TEST(TransposeOpTest, BlockedTranspose) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> cases = {
+      {{2, 67, 5, 33}, {0, 2, 1, 3}},
+      {{2, 67, 5, 33}, {0, 3, 1, 2}},
+      {{2, 67, 5, 33}, {3, 2, 1, 0}},
+      {{2, 67, 5, 33}, {1, 3, 0, 2}},
+      {{3, 1, 130, 70}, {0, 3, 1, 2}},
+      {{4, 3, 2, 5, 7}, {4, 0, 3, 1, 2}},
+      {{200, 150}, {1, 0}},
+  };
+
+  for (const auto& c : cases) {
+    TestBlockedTranspose<uint8_t>(c.first, c.second);
+    TestBlockedTranspose<int16_t>(c.first, c.second);
+    TestBlockedTranspose<float>(c.first, c.second);
+    TestBlockedTranspose<double>(c.first, c.second);
+  }
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
@@ -869,5 +937,45 @@ TEST(TransposeOpTest, TransposeBigMLFloat16) {  // Exercises CanUse_cublasTransp
 }
 #endif  // defined(USE_CUDA) || defined(USE_ROCM)
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, Strided) {
+  // Strided output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("output", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 3});
+    test.Run({0});
+  }
+
+  // Strided 3D output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    test.AddInput<float>("input", {2, 1, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("output", {3, 2, 1}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 3, 3});
+    test.Run({0});
+  }
+
+  // Strided input, contiguous output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("input", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 3});
+    test.AddOutput<float>("output", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.Run();
+  }
+
+  // Broadcast input, contiguous output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f}, {0, 1});
+    test.AddOutput<float>("output", {3, 2}, {1.f, 1.f, 2.f, 2.f, 3.f, 3.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -370,6 +370,49 @@ TEST(Unique, InvalidAxis) {
   test.Run(OpTester::ExpectResult::kExpectFailure, "[ShapeInferenceError] Invalid value for attribute axis");
 }
 
+// input large enough to be split between threads, with the values repeating every 1000 entries
+static void RunUniqueFlattenLargeTest(bool sorted) {
+  constexpr int64_t kNumValues = 1000;
+  constexpr int64_t kNumEntries = 100 * kNumValues;
+  std::vector<int64_t> X(kNumEntries);
+  for (int64_t i = 0; i < kNumEntries; ++i) {
+    X[i] = (i * 7919) % kNumValues - kNumValues / 2;
+  }
+
+  // the first kNumValues entries are the unique values in the order they occur
+  std::vector<int64_t> Y(X.begin(), X.begin() + kNumValues);
+  std::vector<int64_t> indices(kNumValues);
+  std::vector<int64_t> inverse_indices(kNumEntries);
+  const std::vector<int64_t> counts(kNumValues, kNumEntries / kNumValues);
+  if (sorted) {
+    for (int64_t i = 0; i < kNumValues; ++i) {
+      Y[i] = i - kNumValues / 2;
+      indices[X[i] + kNumValues / 2] = i;
+    }
+    for (int64_t i = 0; i < kNumEntries; ++i) {
+      inverse_indices[i] = X[i] + kNumValues / 2;
+    }
+  } else {
+    for (int64_t i = 0; i < kNumValues; ++i) {
+      indices[i] = i;
+    }
+    for (int64_t i = 0; i < kNumEntries; ++i) {
+      inverse_indices[i] = i % kNumValues;
+    }
+  }
+
+  RunUniqueTest<int64_t>({kNumEntries}, X, nullptr, sorted, {kNumValues}, Y, {kNumValues}, indices,
+                         {kNumEntries}, inverse_indices, {kNumValues}, counts);
+}
+
+TEST(Unique, Flatten_Unsorted_Large) {
+  RunUniqueFlattenLargeTest(false);
+}
+
+TEST(Unique, Flatten_Sorted_Large) {
+  RunUniqueFlattenLargeTest(true);
+}
+
 // check empty input is gracefully handled
 TEST(Unique, EmptyInput) {
   const std::vector<int64_t> X_dims{0};
@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
+#include "core/framework/stream_handles.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
 
@@ -113,5 +114,50 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+TEST(AllocatorTest, CUDAMemPoolAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  constexpr size_t size = 1024;
+  CUDAMemPoolAllocator allocator(cuda_device_id, CUDA, 4 * size, 0);
+  EXPECT_TRUE(allocator.IsStreamAware());
+  EXPECT_EQ(allocator.Info().alloc_type, OrtDeviceAllocator);
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, allocator.Info().device);
+
+  // memory ordered on the stream is ready for its work, the other allocation for any stream
+  void* stream_addr = allocator.AllocOnStream(size, &stream);
+  void* addr = allocator.Alloc(size);
+  ASSERT_NE(stream_addr, nullptr);
+  ASSERT_NE(addr, nullptr);
+  CUDA_CALL_THROW(cudaMemsetAsync(stream_addr, -1, size, cuda_stream));
+  CUDA_CALL_THROW(cudaMemcpyAsync(addr, stream_addr, size, cudaMemcpyDeviceToDevice, cuda_stream));
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(2 * size));
+
+  // the limit is enforced on the memory in use
+  EXPECT_THROW(allocator.Alloc(3 * size), OnnxRuntimeException);
+
+  // the allocations still in use once the stream is released can be used past its lifetime
+  allocator.ReleaseStreamAllocations(&stream);
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+
+  int value = 0;
+  CUDA_CALL_THROW(cudaMemcpy(&value, addr, sizeof(value), cudaMemcpyDeviceToHost));
+  EXPECT_EQ(value, -1);
+
+  allocator.Free(stream_addr);
+  allocator.Free(addr);
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.max_bytes_in_use, static_cast<int64_t>(2 * size));
+  CUDA_CALL_THROW(cudaDeviceSynchronize());
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -105,6 +105,8 @@ struct ProviderInfo_CUDA_TestImpl : ProviderInfo_CUDA {
     return nullptr;
   }
 
+  Status EnablePeerAccess(int, int) override { return Status::OK(); }
+
   void TestAll() override {
     // TestAll is the entry point of CUDA EP's internal tests.
     // Those internal tests are not directly callable from onnxruntime_test_all
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <vector>
+
+#include "core/framework/stream_handles.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/gpu_data_transfer.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace test {
+
+// Copies between pageable host memory and the device are queued on the stream through the pinned ring, which wraps
+// around and is reused once its oldest copies are complete.
+TEST(GPUDataTransferTest, PageableCopiesThroughPinnedRing) {
+  CUDA_CALL_THROW(cudaSetDevice(0));
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+
+  const OrtMemoryInfo cpu_info(CPU, OrtDeviceAllocator);
+  const OrtMemoryInfo gpu_info(CUDA, OrtDeviceAllocator, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0));
+  Stream stream(cuda_stream, gpu_info.device);
+  GPUDataTransfer data_transfer;
+
+  // 4 MB per copy, so 6 round trips take more than the whole ring
+  constexpr int64_t num_elements = 1024 * 1024;
+  void* device_data = nullptr;
+  CUDA_CALL_THROW(cudaMalloc(&device_data, num_elements * sizeof(float)));
+  auto device_tensor = Tensor::Create(DataTypeImpl::GetType<float>(), {num_elements}, device_data, gpu_info);
+
+  for (int i = 0; i < 6; ++i) {
+    std::vector<float> input(num_elements);
+    std::iota(input.begin(), input.end(), static_cast<float>(i));
+    std::vector<float> output(num_elements, -1.0f);
+    auto input_tensor = Tensor::Create(DataTypeImpl::GetType<float>(), {num_elements}, input.data(), cpu_info);
+    auto output_tensor = Tensor::Create(DataTypeImpl::GetType<float>(), {num_elements}, output.data(), cpu_info);
+
+    ASSERT_STATUS_OK(data_transfer.CopyTensorAsync(*input_tensor, *device_tensor, stream));
+    // the pageable input may be reused as soon as the copy is queued
+    std::fill(input.begin(), input.end(), 0.0f);
+    ASSERT_STATUS_OK(data_transfer.CopyTensorAsync(*device_tensor, *output_tensor, stream));
+    CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+
+    EXPECT_EQ(output.front(), static_cast<float>(i));
+    EXPECT_EQ(output.back(), static_cast<float>(i + num_elements - 1));
+  }
+
+  CUDA_CALL_THROW(cudaFree(device_data));
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+}
+
+}  // namespace test
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -624,6 +624,58 @@ TEST_F(QnnHTPBackendTests, QnnContextBinaryCacheEmbedModeTest) {
   CleanUpCtxFile(context_model_file);
 }
 
+// 1st run will generate the Qnn context cache onnx file
+// Then run from the Qnn context cache model with the context loaded on the first Run and on a background thread
+TEST_F(QnnHTPBackendTests, QnnContextBinaryCacheDeferredLoadTest) {
+  ProviderOptions provider_options;
+#if defined(_WIN32)
+  provider_options["backend_path"] = "QnnHtp.dll";
+#else
+  provider_options["backend_path"] = "libQnnHtp.so";
+#endif
+  provider_options["offload_graph_io_quantization"] = "0";
+  const std::string context_model_file = "./qnn_context_binary_deferred_load_test.onnx";
+  std::remove(context_model_file.c_str());
+
+  std::unordered_map<std::string, std::string> session_option_pairs;
+  session_option_pairs.emplace(kOrtSessionOptionEpContextEnable, "1");
+  session_option_pairs.emplace(kOrtSessionOptionEpContextFilePath, context_model_file);
+
+  const TestInputDef<float> input_def({1, 2, 3}, false, -10.0f, 10.0f);
+  const std::string op_type = "Atan";
+
+  // 1st run will generate the Qnn context cache binary file
+  TestQDQModelAccuracy(BuildOpTestCase<float>(op_type, {input_def}, {}, {}),
+                       BuildQDQOpTestCase<uint8_t>(op_type, {input_def}, {}, {}),
+                       provider_options,
+                       14,
+                       ExpectedEPNodeAssignment::All,
+                       QDQTolerance(),
+                       logging::Severity::kERROR,
+                       "",  // context model file path, not required for this inference
+                       session_option_pairs);
+
+  EXPECT_TRUE(std::filesystem::exists(context_model_file.c_str()));
+
+  std::unordered_map<std::string, std::string> session_option_pairs2;
+  session_option_pairs2.emplace(kOrtSessionOptionEpContextFilePath, context_model_file);
+  for (const char* context_load_mode : {"lazy", "background"}) {
+    provider_options["context_load_mode"] = context_load_mode;
+    TestQDQModelAccuracy(BuildOpTestCase<float>(op_type, {input_def}, {}, {}),
+                         BuildQDQOpTestCase<uint8_t>(op_type, {input_def}, {}, {}),
+                         provider_options,
+                         14,
+                         ExpectedEPNodeAssignment::All,
+                         QDQTolerance(),
+                         logging::Severity::kERROR,
+                         context_model_file,
+                         session_option_pairs2);
+  }
+
+  // Clean up
+  CleanUpCtxFile(context_model_file);
+}
+
 // Run QDQ model on HTP 3 times
 // 1st run will generate the Onnx skeleton file + Qnn context cache binary file
 // 2nd run directly loads and run from Onnx skeleton file + Qnn context cache binary file
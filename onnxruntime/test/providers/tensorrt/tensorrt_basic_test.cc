@@ -676,6 +676,105 @@ TEST(TensorrtExecutionProviderTest, ExcludeOpsTest) {
   ASSERT_EQ(engine_files.size(), 3);
 }
 
+// The mnist model is partitioned into 3 TRT subgraphs when MaxPool is excluded, whose engines are built concurrently.
+// The engines are shared by the sessions with engine sharing enabled and built again by the one that builds them
+// sequentially.
+TEST(TensorrtExecutionProviderTest, ConcurrentBuildAndEngineSharingTest) {
+  PathString model_name = ORT_TSTR("testdata/mnist.onnx");
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+  std::vector<int64_t> dims_op_x = {1, 1, 28, 28};
+  std::vector<float> values_op_x(784);  // 784=1*1*28*28
+  for (size_t i = 0; i < values_op_x.size(); ++i) {
+    values_op_x[i] = static_cast<float>(i % 17) / 17.0f;
+  }
+  OrtValue ml_value_x;
+  CreateMLValue<float>(cpu_allocator, dims_op_x, values_op_x, &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("Input3", ml_value_x));
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  auto create_session = [&](bool engine_sharing_enable, bool force_sequential_engine_build) {
+    SessionOptions so;
+    so.session_logid = "TensorrtExecutionProviderConcurrentBuildAndEngineSharingTest";
+    auto session_object = std::make_unique<InferenceSession>(so, GetEnvironment());
+    OrtTensorRTProviderOptionsV2 params;
+    params.trt_op_types_to_exclude = "MaxPool";
+    params.trt_engine_sharing_enable = engine_sharing_enable;
+    params.trt_force_sequential_engine_build = force_sequential_engine_build;
+    EXPECT_TRUE(session_object->RegisterExecutionProvider(TensorrtExecutionProviderWithOptions(&params)).IsOK());
+    EXPECT_TRUE(session_object->Load(model_name).IsOK());
+    EXPECT_TRUE(session_object->Initialize().IsOK());
+    return session_object;
+  };
+
+  auto run_session = [&](InferenceSession& session_object) {
+    RunOptions run_options;
+    std::vector<OrtValue> fetches;
+    EXPECT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+    EXPECT_EQ(fetches.size(), 1u);
+    const auto& output = fetches[0].Get<Tensor>();
+    return std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size());
+  };
+
+  auto shared_session_1 = create_session(true, false);
+  auto shared_session_2 = create_session(true, false);
+  auto sequential_session = create_session(false, true);
+
+  const std::vector<float> expected = run_session(*sequential_session);
+  ASSERT_EQ(expected.size(), 10u);
+  const std::vector<float> shared_output_1 = run_session(*shared_session_1);
+  // Release one of the sessions sharing the engines before the other runs
+  shared_session_1.reset();
+  const std::vector<float> shared_output_2 = run_session(*shared_session_2);
+  ASSERT_EQ(shared_output_1.size(), expected.size());
+  ASSERT_EQ(shared_output_2.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(shared_output_1[i], shared_output_2[i]);
+    EXPECT_NEAR(shared_output_1[i], expected[i], 1e-3f);
+  }
+}
+
+TEST(TensorrtExecutionProviderTest, ProfileAutoExpandTest) {
+  PathString model_name = ORT_TSTR("trt_execution_provider_profile_auto_expand_test.onnx");
+  std::string graph_name = "profile_auto_expand_test";
+  std::vector<int> dims = {1, -1, 2};
+  CreateBaseModel(model_name, graph_name, dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderProfileAutoExpandTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+  OrtTensorRTProviderOptionsV2 params;
+  params.trt_profile_auto_expand = 1;
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(TensorrtExecutionProviderWithOptions(&params)).IsOK());
+  ASSERT_TRUE(session_object.Load(model_name).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  auto cpu_allocator = DefaultCudaExecutionProvider()->CreatePreferredAllocators()[1];
+  std::vector<std::string> output_names{"M"};
+
+  // The profile is widened to power-of-two bounds whenever a shape falls outside of it,
+  // so every run has to produce the same results as with the exact profile.
+  for (int64_t rows : {3, 5, 4, 9, 1}) {
+    std::vector<int64_t> dims_x = {1, rows, 2};
+    std::vector<float> values_x(static_cast<size_t>(rows * 2));
+    std::vector<float> expected_values(values_x.size());
+    for (size_t i = 0; i < values_x.size(); ++i) {
+      values_x[i] = static_cast<float>(i);
+      expected_values[i] = 3.0f * values_x[i];
+    }
+    OrtValue ml_value_x;
+    CreateMLValue<float>(cpu_allocator, dims_x, values_x, &ml_value_x);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value_x));
+    feeds.insert(std::make_pair("Y", ml_value_x));
+    feeds.insert(std::make_pair("Z", ml_value_x));
+    RunSession(session_object, run_options, feeds, output_names, dims_x, expected_values);
+  }
+}
+
 TEST(TensorrtExecutionProviderTest, TRTPluginsCustomOpTest) {
   PathString model_name = ORT_TSTR("testdata/trt_plugin_custom_op_test.onnx");
   SessionOptions so;
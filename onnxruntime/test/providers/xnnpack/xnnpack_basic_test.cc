@@ -125,6 +125,58 @@ TEST(XnnpackEP, TestAllocatorSharing) {
   // TODO(leca): should also check there is only 1 allocator in session1.GetSessionState().GetAllocators() which is used by both xnnpack EP and CPU EP
 }
 
+// test the sessions of the same model share the packed weights, and produce the same outputs as a session that
+// doesn't share them, also once the session that packed the weights is released.
+TEST(XnnpackEP, TestSharedWeightsCache) {
+  const ORTCHAR_T* ort_model_path = ORT_MODEL_FOLDER "nhwc_conv_clip_relu.onnx";
+
+  RandomValueGenerator generator;
+  TensorShape input_shape_x{1, 16, 16, 192};
+  std::vector<float> input_x = generator.Uniform<float>(input_shape_x.GetDims(), -128, 128);
+
+  OrtValue ml_value_x;
+  CreateMLValue<float>(input_shape_x.GetDims(), input_x.data(), OrtMemoryInfo(), &ml_value_x);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("model_input", ml_value_x));
+
+  auto create_session = [&](bool shared_weights_cache, std::unique_ptr<InferenceSessionWrapper>& session) {
+    XnnpackExecutionProviderInfo info;
+    info.shared_weights_cache = shared_weights_cache;
+
+    SessionOptions so;
+    session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    ASSERT_STATUS_OK(session->RegisterExecutionProvider(std::make_unique<XnnpackExecutionProvider>(info)));
+    ASSERT_STATUS_OK(session->Load(ort_model_path));
+    ASSERT_STATUS_OK(session->Initialize());
+  };
+
+  auto run_session = [&](InferenceSessionWrapper& session, std::vector<float>& output) {
+    auto [status, outputs] = session.GetModelOutputs();
+    ASSERT_STATUS_OK(status);
+    std::vector<std::string> output_names{outputs->at(0)->Name()};
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+    auto data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    output.assign(data.begin(), data.end());
+  };
+
+  std::unique_ptr<InferenceSessionWrapper> expected_session, session1, session2;
+  create_session(false, expected_session);
+  create_session(true, session1);
+  create_session(true, session2);
+
+  std::vector<float> expected_output, output1, output2;
+  run_session(*expected_session, expected_output);
+  run_session(*session1, output1);
+  session1.reset();
+  run_session(*session2, output2);
+
+  ASSERT_EQ(output1, expected_output);
+  ASSERT_EQ(output2, expected_output);
+}
+
 TEST(XnnpackEP, TestAddEpUsingPublicApi) {
   {
     // C++ API test
@@ -2698,6 +2698,85 @@ TEST(CApiTest, basic_cuda_graph_with_annotation) {
 }
 #endif
 
+#if defined(USE_CUDA)
+TEST(CApiTest, cuda_graph_by_input_shapes) {
+  const auto& api = Ort::GetApi();
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsGraphCaptureByInputShapes, "1");
+
+  // Keep two graphs to evict the graph of the first shape when the third one is captured.
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"enable_cuda_graph", "max_num_cuda_graphs"};
+  std::vector<const char*> values{"1", "2"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 2) == nullptr);
+
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+  Ort::MemoryInfo info_mem("Cuda", OrtAllocatorType::OrtArenaAllocator, 0, OrtMemTypeDefault);
+
+  Ort::Session session(*ort_env, CUDA_GRAPH_ANNOTATION_MODEL_URI, session_options);
+
+  Ort::Allocator allocator(session, info_mem);
+  auto input_data = allocator.GetAllocation(6 * sizeof(float));
+  auto output_data = allocator.GetAllocation(6 * sizeof(float));
+  ASSERT_NE(input_data.get(), nullptr);
+  ASSERT_NE(output_data.get(), nullptr);
+
+  // Every input shape gets its own graph without an annotation in the run options.
+  RunWithCudaGraphAnnotation(cg_data_0, session, info_mem, input_data, output_data, nullptr);
+  RunWithCudaGraphAnnotation(cg_data_1, session, info_mem, input_data, output_data, nullptr);
+  RunWithCudaGraphAnnotation(cg_data_2, session, info_mem, input_data, output_data, nullptr);
+  RunWithCudaGraphAnnotation(cg_data_0, session, info_mem, input_data, output_data, nullptr);
+  RunWithCudaGraphAnnotation(cg_data_2, session, info_mem, input_data, output_data, nullptr);
+}
+
+TEST(CApiTest, cuda_compute_stream_pool) {
+  const auto& api = Ort::GetApi();
+
+  // More concurrent runs than streams in the pool, so some of the runs share a stream.
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"compute_stream_pool_size"};
+  std::vector<const char*> values{"2"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 1) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  auto run_fn = [&session]() {
+    const char* input_names[] = {"X"};
+    const char* output_names[] = {"Y"};
+    float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    int64_t x_dim[] = {3, 2};
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::Value input_tensor = Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2);
+
+    for (int i = 0; i < 10; ++i) {
+      auto output_tensors = session.Run(Ort::RunOptions{}, input_names, &input_tensor, 1, output_names, 1);
+      ASSERT_EQ(output_tensors.size(), 1u);
+      EXPECT_EQ(output_tensors[0].At<float>({1, 0}), 9.f);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(run_fn);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+#endif
+
 // The following test uses some ops not supported in the reduced ops build
 #ifndef REDUCED_OPS_BUILD
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
@@ -4530,6 +4609,62 @@ TEST(CApiTest, RunAsync) {
   EXPECT_EQ(atomic_wait.load(), true);
 }
 
+void CallbackCount(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status_ptr) {
+  Ort::Status status(status_ptr);
+  EXPECT_TRUE(status.IsOK());
+  EXPECT_EQ(num_outputs, 1UL);
+  Ort::Value output_value(outputs[0]);
+  EXPECT_EQ(output_value.At<float>({1, 0}), 9.f);
+  output_value.release();
+  reinterpret_cast<std::atomic_int*>(user_data)->fetch_add(1);
+}
+
+TEST(CApiTest, RunAsyncMaxConcurrentRuns) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(4);
+  session_options.AddConfigEntry(kOrtSessionOptionsRunAsyncMaxConcurrentRuns, "1");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  int64_t x_dim[] = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2),
+  };
+
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+
+  // the calls beyond the first one queue up in the session and run one after the other
+  constexpr int num_runs = 8;
+  std::vector<Ort::Value> output_values;
+  for (int i = 0; i < num_runs; ++i) {
+    output_values.emplace_back(nullptr);
+  }
+  std::atomic_int num_completed{0};
+  for (int i = 0; i < num_runs; ++i) {
+    EXPECT_NO_THROW(session.RunAsync(run_options,
+                                     input_names,
+                                     input_tensors,
+                                     1,
+                                     output_names,
+                                     &output_values[i],
+                                     1,
+                                     CallbackCount,
+                                     &num_completed));
+  }
+
+  std::chrono::duration<double, std::milli> dur{100};
+  // timeout in about 10 secs
+  for (int i = 0; i < 100 && num_completed.load() < num_runs; ++i) {
+    std::this_thread::sleep_for(dur);
+  }
+
+  EXPECT_EQ(num_completed.load(), num_runs);
+}
+
 void CallbackFail(void*, OrtValue**, size_t, OrtStatusPtr) {
   EXPECT_TRUE(false);  // the callback is not supposed to be invoked
 }
@@ -8,6 +8,7 @@
 #include "core/framework/framework_common.h"
 #include "core/graph/graph_flatbuffers_utils.h"
 #include "core/framework/tensor_external_data_info.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime::training::api {
 
@@ -626,6 +627,65 @@ Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& check
   return Status::OK();
 }
 
+/**
+ * @brief Map a file of a checkpoint into memory.
+ *        The read-only mapping is backed by the file, so unlike reading the file into a buffer, it doesn't add
+ *        the size of the file to the peak memory usage of the load, and only the pages read are loaded.
+ * @param path Path to the file.
+ * @param mapped_memory The mapped contents of the file.
+ * @param num_bytes Size of the file in bytes.
+ * @return Status of the operation.
+ */
+Status MapFile(const PathString& path, Env::MappedMemoryPtr& mapped_memory, size_t& num_bytes) {
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(path.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Cannot map the empty file ", ToUTF8String(path));
+  return Env::Default().MapFileIntoMemory(path.c_str(), 0, num_bytes, mapped_memory);
+}
+
+/**
+ * @brief The external data file of a checkpoint, mapped into memory if possible and read otherwise.
+ */
+struct ExternalDataFile {
+  Env::MappedMemoryPtr mapped_memory;
+  size_t num_bytes = 0;
+  std::optional<std::ifstream> stream;
+
+  /**
+   * @brief Open the external data file of a checkpoint and create the delegate to read initializer data from it.
+   * @param checkpoint_path Path to the checkpoint file.
+   * @param external_data_reader Delegate to read from the file, valid as long as this object.
+   * @return Status of the operation.
+   */
+  Status Open(const PathString& checkpoint_path, fbs::utils::ExternalDataReader& external_data_reader) {
+    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
+    if (MapFile(data_path, mapped_memory, num_bytes).IsOK()) {
+      external_data_reader = [this](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+        ORT_RETURN_IF(offset > num_bytes || output_buffer.size() > num_bytes - offset,
+                      "Failed reading external checkpoint data. Offset: ", offset, " Size: ", output_buffer.size(),
+                      " is outside of the external data file of size ", num_bytes);
+        std::memcpy(output_buffer.data(), mapped_memory.get() + offset, output_buffer.size());
+        return Status::OK();
+      };
+
+      return Status::OK();
+    }
+
+    stream = std::ifstream(data_path, std::ios::binary);
+    if (stream->fail()) {
+      const auto [err, errmsg] = GetErrnoInfo();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
+                             " error:", errmsg, " errno:", err);
+    }
+
+    external_data_reader = [this](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+      return ReadFromExternalFileHelper(stream.value(), offset, output_buffer);
+    };
+
+    return Status::OK();
+  }
+};
+
 /**
  * @brief Load from a flatbuffer checkpoint module state to a module state.
  *
@@ -806,17 +866,10 @@ Status ToModelProto(gsl::span<const uint8_t> checkpoint_bytes,
                 "Expected: Complete checkpoint. Actual: Nominal checkpoint.");
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  ExternalDataFile external_data_file;
 
   if (module_state->has_external_data()) {
-    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-    ORT_RETURN_IF(external_data_stream->fail(),
-                  "Failed to open checkpoint's external data file: ", ToUTF8String(data_path));
-
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
-    };
+    ORT_RETURN_IF_ERROR(external_data_file.Open(checkpoint_path, external_data_reader));
   }
 
   InlinedHashMap<std::string, ONNX_NAMESPACE::TensorProto> param_tensor_protos;
@@ -876,26 +929,14 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   const auto* fbs_module_state = fbs_checkpoint->module_state();
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  ExternalDataFile external_data_file;
 
   state.has_external_data = false;
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
     state.has_external_data = true;
     ORT_RETURN_IF_NOT(checkpoint_path.has_value(),
                       "External data is present in the checkpoint but the checkpoint path is not provided. External data with loading from buffer is not supported yet.");
-    auto data_path = ExternalCheckpointDataPath(*checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-
-    if (external_data_stream.value().fail()) {
-      const auto [err, errmsg] = GetErrnoInfo();
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
-                             " error:", errmsg, " errno:", err);
-    }
-
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
-    };
+    ORT_RETURN_IF_ERROR(external_data_file.Open(*checkpoint_path, external_data_reader));
   }
 
   if (nullptr != fbs_module_state) {
@@ -957,6 +998,13 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
+  Env::MappedMemoryPtr mapped_checkpoint;
+  size_t num_bytes = 0;
+  if (load::MapFile(checkpoint_path, mapped_checkpoint, num_bytes).IsOK()) {
+    const auto checkpoint_bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_checkpoint.get()), num_bytes);
+    return load::ToCheckpointState(checkpoint_bytes, checkpoint_states, checkpoint_path);
+  }
+
   InlinedVector<uint8_t> checkpoint_bytes;
   ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
   return load::ToCheckpointState(checkpoint_bytes, checkpoint_states, checkpoint_path);
@@ -973,6 +1021,13 @@ Status LoadCheckpointToModel(const PathString& checkpoint_path,
                              ONNX_NAMESPACE::ModelProto& model_proto) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
+  Env::MappedMemoryPtr mapped_checkpoint;
+  size_t num_bytes = 0;
+  if (load::MapFile(checkpoint_path, mapped_checkpoint, num_bytes).IsOK()) {
+    const auto checkpoint_bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_checkpoint.get()), num_bytes);
+    return load::ToModelProto(checkpoint_bytes, model_proto, checkpoint_path);
+  }
+
   InlinedVector<uint8_t> checkpoint_bytes;
   ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
   return load::ToModelProto(checkpoint_bytes, model_proto, checkpoint_path);
@@ -5,7 +5,10 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -19,6 +22,32 @@ TC compute_bias_correction_coefficient(const TC momentum_update_coefficient, con
   }
 }
 
+// Runs fn on blocks of the elements of the tensors of a multi-tensor optimizer in parallel, as if the tensors were
+// flattened into one buffer, so the small tensors don't leave threads idle and the large ones are split across them.
+// fn(tensor_index, begin, end) updates the elements [begin, end) of the tensors at tensor_index.
+template <typename Fn>
+void MultiTensorParallelFor(concurrency::ThreadPool* tp, const std::vector<int>& tensor_sizes, double cost_per_element,
+                            const Fn& fn) {
+  static constexpr std::ptrdiff_t kBlockSize = 16384;
+
+  // <tensor index, begin>
+  std::vector<std::pair<size_t, std::ptrdiff_t>> blocks;
+  for (size_t i = 0; i < tensor_sizes.size(); ++i) {
+    for (std::ptrdiff_t begin = 0; begin < tensor_sizes[i]; begin += kBlockSize) {
+      blocks.emplace_back(i, begin);
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(blocks.size()), cost_per_element * kBlockSize,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b != last; ++b) {
+          const auto [i, begin] = blocks[b];
+          fn(i, begin, std::min<std::ptrdiff_t>(begin + kBlockSize, tensor_sizes[i]));
+        }
+      });
+}
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values, const TensorSeq* src_values,
                               TensorSeq* dest_values);
 
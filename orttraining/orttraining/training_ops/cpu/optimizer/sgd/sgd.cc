@@ -64,14 +64,19 @@ Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
     const float lr = *p.learning_rate->template Data<float>();
 
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-
-      // new_weight = weight - lr * gradient
-      const auto& delta = -lr * MakeEigenArrayMap<T>(gradient);
-      MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) + delta;
-    }
+    // All the weights are updated in one parallel pass over their elements.
+    static constexpr double cost_per_element = 2.0;
+    MultiTensorParallelFor(
+        ctx->GetOperatorThreadPool(), p.grouped_tensor_sizes, cost_per_element,
+        [&p, lr](size_t i, std::ptrdiff_t begin, std::ptrdiff_t end) {
+          T* weight = static_cast<T*>(p.grouped_tensor_pointers[i][0]);
+          const T* gradient = static_cast<const T*>(p.grouped_tensor_pointers[i][1]);
+
+          // new_weight = weight - lr * gradient
+          for (std::ptrdiff_t j = begin; j < end; ++j) {
+            weight[j] += -lr * gradient[j];
+          }
+        });
 
     *updated_flag_ptr = true;
   } else {